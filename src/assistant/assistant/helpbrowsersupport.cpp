@@ -71,19 +71,58 @@ public:
     void abort() override;
 
     qint64 bytesAvailable() const override
-        { return data.length() + QNetworkReply::bytesAvailable(); }
+        { return endPos - readPos + QNetworkReply::bytesAvailable(); }
 
 protected:
     qint64 readData(char *data, qint64 maxlen) override;
 
 private:
-    QByteArray data;
-    const qint64 origLen;
+    // Stays shared with the help engine's cache, only the read position
+    // moves, so that large files are not copied before they are read.
+    const QByteArray data;
+    qint64 readPos = 0;
+    qint64 endPos = 0;
 };
 
+// Parses a Range header asking for a single range of bytes of data of
+// length size. Returns false if there is no such range, then all of the
+// data is sent. A range starting beyond the data gives first > last.
+static bool parseByteRange(const QByteArray &header, qint64 size, qint64 *first, qint64 *last)
+{
+    const QByteArray range = header.trimmed();
+    if (!range.startsWith("bytes=") || range.contains(','))
+        return false;
+    const qsizetype dash = range.indexOf('-');
+    if (dash < 0)
+        return false;
+    const QByteArray from = range.mid(6, dash - 6).trimmed();
+    const QByteArray to = range.mid(dash + 1).trimmed();
+    bool ok = false;
+    if (from.isEmpty()) {
+        // The last bytes of the data
+        const qint64 suffixLength = to.toLongLong(&ok);
+        if (!ok || suffixLength <= 0)
+            return false;
+        *first = size - qMin(suffixLength, size);
+        *last = size - 1;
+        return true;
+    }
+    *first = from.toLongLong(&ok);
+    if (!ok || *first < 0)
+        return false;
+    *last = size - 1;
+    if (!to.isEmpty()) {
+        const qint64 requestedLast = to.toLongLong(&ok);
+        if (!ok || requestedLast < *first)
+            return false;
+        *last = qMin(requestedLast, size - 1);
+    }
+    return true;
+}
+
 HelpNetworkReply::HelpNetworkReply(const QNetworkRequest &request,
         const QByteArray &fileData, const QString& mimeType)
-    : data(fileData), origLen(fileData.length())
+    : data(fileData), endPos(fileData.size())
 {
     TRACE_OBJ
     setRequest(request);
@@ -91,7 +130,23 @@ HelpNetworkReply::HelpNetworkReply(const QNetworkRequest &request,
     setOpenMode(QIODevice::ReadOnly);
 
     setHeader(QNetworkRequest::ContentTypeHeader, mimeType);
-    setHeader(QNetworkRequest::ContentLengthHeader, QByteArray::number(origLen));
+    setRawHeader("Accept-Ranges", "bytes");
+    qint64 first = 0;
+    qint64 last = 0;
+    if (parseByteRange(request.rawHeader("Range"), data.size(), &first, &last)) {
+        if (first > last) {
+            setAttribute(QNetworkRequest::HttpStatusCodeAttribute, 416);
+            setRawHeader("Content-Range", "bytes */" + QByteArray::number(data.size()));
+            endPos = 0;
+        } else {
+            setAttribute(QNetworkRequest::HttpStatusCodeAttribute, 206);
+            setRawHeader("Content-Range", "bytes " + QByteArray::number(first) + '-'
+                         + QByteArray::number(last) + '/' + QByteArray::number(data.size()));
+            readPos = first;
+            endPos = last + 1;
+        }
+    }
+    setHeader(QNetworkRequest::ContentLengthHeader, QByteArray::number(endPos - readPos));
     QTimer::singleShot(0, this, &QNetworkReply::metaDataChanged);
     QTimer::singleShot(0, this, &QNetworkReply::readyRead);
     QTimer::singleShot(0, this, &QNetworkReply::finished);
@@ -105,12 +160,12 @@ void HelpNetworkReply::abort()
 qint64 HelpNetworkReply::readData(char *buffer, qint64 maxlen)
 {
     TRACE_OBJ
-    qint64 len = qMin(qint64(data.length()), maxlen);
+    const qint64 len = qMin(endPos - readPos, maxlen);
     if (len) {
-        memcpy(buffer, data.constData(), len);
-        data.remove(0, len);
+        memcpy(buffer, data.constData() + readPos, len);
+        readPos += len;
     }
-    if (!data.length())
+    if (readPos == endPos)
         QTimer::singleShot(0, this, &QNetworkReply::finished);
     return len;
 }
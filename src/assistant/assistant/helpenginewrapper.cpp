@@ -206,6 +206,17 @@ bool HelpEngineWrapper::registerDocumentation(const QString &docFile)
     return true;
 }
 
+bool HelpEngineWrapper::registerDocumentations(const QStringList &docFiles)
+{
+    TRACE_OBJ
+    d->checkDocFilesWatched();
+    if (!d->m_helpEngine->registerDocumentations(docFiles))
+        return false;
+    d->m_qchWatcher->addPaths(docFiles);
+    d->checkDocFilesWatched();
+    return true;
+}
+
 bool HelpEngineWrapper::unregisterDocumentation(const QString &namespaceName)
 {
     TRACE_OBJ
@@ -280,6 +291,18 @@ void HelpEngineWrapper::setLastShownPages(const QStringList &lastShownPages)
     CollectionConfiguration::setLastShownPages(*d->m_helpEngine, lastShownPages);
 }
 
+const QStringList HelpEngineWrapper::lastShownPageTitles() const
+{
+    TRACE_OBJ
+    return CollectionConfiguration::lastShownPageTitles(*d->m_helpEngine);
+}
+
+void HelpEngineWrapper::setLastShownPageTitles(const QStringList &lastShownPageTitles)
+{
+    TRACE_OBJ
+    CollectionConfiguration::setLastShownPageTitles(*d->m_helpEngine, lastShownPageTitles);
+}
+
 const QStringList HelpEngineWrapper::lastZoomFactors() const
 {
     TRACE_OBJ
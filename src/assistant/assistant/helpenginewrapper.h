@@ -54,6 +54,7 @@ public:
     QString documentationFileName(const QString &namespaceName) const;
     const QString collectionFile() const;
     bool registerDocumentation(const QString &docFile);
+    bool registerDocumentations(const QStringList &docFiles);
     bool unregisterDocumentation(const QString &namespaceName);
     QUrl findFile(const QUrl &url) const;
     QByteArray fileData(const QUrl &url) const;
@@ -83,6 +84,8 @@ public:
     //       Perhaps also fill up missing elements automatically or assert.
     const QStringList lastShownPages() const;
     void setLastShownPages(const QStringList &lastShownPages);
+    const QStringList lastShownPageTitles() const;
+    void setLastShownPageTitles(const QStringList &lastShownPageTitles);
     const QStringList lastZoomFactors() const;
     void setLastZoomFactors(const QStringList &lastZoomFactors);
 
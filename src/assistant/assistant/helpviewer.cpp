@@ -105,6 +105,9 @@ public:
     QLiteHtmlWidget *m_viewer = nullptr;
     std::vector<HistoryItem> m_backItems;
     std::vector<HistoryItem> m_forwardItems;
+    // Set until the page is shown for the first time
+    QUrl m_pendingUrl;
+    QString m_pendingTitle;
     int m_fontZoom = 100; // zoom percentage
 };
 
@@ -225,16 +228,23 @@ qreal HelpViewer::scale() const
 
 QString HelpViewer::title() const
 {
+    if (d->m_pendingUrl.isValid())
+        return d->m_pendingTitle.isEmpty() ? d->m_pendingUrl.fileName() : d->m_pendingTitle;
     return d->m_viewer->title();
 }
 
 QUrl HelpViewer::source() const
 {
+    if (d->m_pendingUrl.isValid())
+        return d->m_pendingUrl;
     return d->m_viewer->url();
 }
 
 void HelpViewer::reload()
 {
+    // A pending page gets loaded afresh anyway
+    if (d->m_pendingUrl.isValid())
+        return;
     doSetSource(source(), true);
 }
 
@@ -243,11 +253,35 @@ void HelpViewer::setSource(const QUrl &url)
     doSetSource(url, false);
 }
 
+/*
+    Makes \a url the source of the viewer without loading it before the
+    viewer is shown. Until then \a title is reported as the page title.
+*/
+void HelpViewer::setPendingSource(const QUrl &url, const QString &title)
+{
+    d->m_pendingUrl = url;
+    d->m_pendingTitle = title;
+    emit titleChanged();
+}
+
+void HelpViewer::showEvent(QShowEvent *event)
+{
+    QWidget::showEvent(event);
+    if (d->m_pendingUrl.isValid()) {
+        const QUrl url = d->m_pendingUrl;
+        d->m_pendingUrl.clear();
+        d->m_pendingTitle.clear();
+        setSource(url);
+    }
+}
+
 void HelpViewer::doSetSource(const QUrl &url, bool reload)
 {
     if (launchWithExternalApp(url))
         return;
 
+    d->m_pendingUrl.clear();
+    d->m_pendingTitle.clear();
     d->m_forwardItems.clear();
     emit forwardAvailable(false);
     if (d->m_viewer->url().isValid()) {
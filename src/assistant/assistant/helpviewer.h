@@ -43,6 +43,7 @@ public:
     QUrl source() const;
     void reload();
     void setSource(const QUrl &url);
+    void setPendingSource(const QUrl &url, const QString &title);
 
     void print(QPagedPaintDevice *printer);
 
@@ -78,6 +79,10 @@ signals:
     void highlighted(const QUrl &link);
     void printRequested();
     void loadFinished();
+
+protected:
+    void showEvent(QShowEvent *event) override;
+
 private:
     void doSetSource(const QUrl &url, bool reload);
 
@@ -45,10 +45,14 @@ updateLastPagesOnUnregister(QHelpEngineCore& helpEngine, const QString& nsName)
         QStringList zoomList = CollectionConfiguration::lastZoomFactors(helpEngine);
         while (zoomList.count() < currentPages.count())
             zoomList.append(CollectionConfiguration::DefaultZoomFactor);
+        QStringList titleList = CollectionConfiguration::lastShownPageTitles(helpEngine);
+        while (titleList.count() < currentPages.count())
+            titleList.append(QString());
 
         for (int i = currentPages.count(); --i >= 0;) {
             if (QUrl(currentPages.at(i)).host() == nsName) {
                 zoomList.removeAt(i);
+                titleList.removeAt(i);
                 currentPages.removeAt(i);
                 lastPage = (lastPage == (i + 1)) ? 1 : lastPage;
             }
@@ -57,6 +61,7 @@ updateLastPagesOnUnregister(QHelpEngineCore& helpEngine, const QString& nsName)
         CollectionConfiguration::setLastShownPages(helpEngine, currentPages);
         CollectionConfiguration::setLastTabPage(helpEngine, lastPage);
         CollectionConfiguration::setLastZoomFactors(helpEngine, zoomList);
+        CollectionConfiguration::setLastShownPageTitles(helpEngine, titleList);
     }
 }
 
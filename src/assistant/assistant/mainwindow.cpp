@@ -396,8 +396,8 @@ void MainWindow::lookForNewQtDocumentation()
             this, &MainWindow::qtDocumentationInstalled);
     connect(m_qtDocInstaller, &QtDocInstaller::qchFileNotFound,
             this, &MainWindow::resetQtDocInfo);
-    connect(m_qtDocInstaller, &QtDocInstaller::registerDocumentation,
-            this, &MainWindow::registerDocumentation);
+    connect(m_qtDocInstaller, &QtDocInstaller::registerDocumentations,
+            this, &MainWindow::registerDocumentations);
     if (helpEngine.qtDocInfo(QLatin1String("qt")).count() != 2)
         statusBar()->showMessage(tr("Looking for Qt Documentation..."));
     m_qtDocInstaller->installDocs();
@@ -1122,26 +1122,41 @@ void MainWindow::resetQtDocInfo(const QString &component)
         QStringList(QDateTime().toString(Qt::ISODate)));
 }
 
-void MainWindow::registerDocumentation(const QString &component,
-                                       const QString &absFileName)
+void MainWindow::registerDocumentations(const QStringList &components,
+                                        const QStringList &absFileNames,
+                                        const QStringList &namespaceNames)
 {
     TRACE_OBJ
-    QString ns = QHelpEngineCore::namespaceName(absFileName);
-    if (ns.isEmpty())
+    HelpEngineWrapper &helpEngine = HelpEngineWrapper::instance();
+    const QStringList &registeredDocs = helpEngine.registeredDocumentations();
+    QStringList docComponents;
+    QStringList docFiles;
+    for (qsizetype i = 0; i < absFileNames.size(); ++i) {
+        const QString &ns = namespaceNames.at(i);
+        if (ns.isEmpty())
+            continue;
+        if (registeredDocs.contains(ns))
+            helpEngine.unregisterDocumentation(ns);
+        docComponents.append(components.at(i));
+        docFiles.append(absFileNames.at(i));
+    }
+    if (docFiles.isEmpty())
         return;
 
-    HelpEngineWrapper &helpEngine = HelpEngineWrapper::instance();
-    if (helpEngine.registeredDocumentations().contains(ns))
-        helpEngine.unregisterDocumentation(ns);
-    if (!helpEngine.registerDocumentation(absFileName)) {
-        QMessageBox::warning(this, tr("Qt Assistant"),
-            tr("Could not register file '%1': %2").
-            arg(absFileName).arg(helpEngine.error()));
-    } else {
-        QStringList docInfo;
-        docInfo << QFileInfo(absFileName).lastModified().toString(Qt::ISODate)
-                << absFileName;
-        helpEngine.setQtDocInfo(component, docInfo);
+    // Register all files in one go, but find out which one is broken if that fails
+    const bool registered = helpEngine.registerDocumentations(docFiles);
+    for (qsizetype i = 0; i < docFiles.size(); ++i) {
+        const QString &absFileName = docFiles.at(i);
+        if (!registered && !helpEngine.registerDocumentation(absFileName)) {
+            QMessageBox::warning(this, tr("Qt Assistant"),
+                tr("Could not register file '%1': %2").
+                arg(absFileName).arg(helpEngine.error()));
+        } else {
+            QStringList docInfo;
+            docInfo << QFileInfo(absFileName).lastModified().toString(Qt::ISODate)
+                    << absFileName;
+            helpEngine.setQtDocInfo(docComponents.at(i), docInfo);
+        }
     }
 }
 
@@ -73,8 +73,8 @@ private slots:
     void indexingStarted();
     void indexingFinished();
     void qtDocumentationInstalled();
-    void registerDocumentation(const QString &component,
-        const QString &absFileName);
+    void registerDocumentations(const QStringList &components,
+        const QStringList &absFileNames, const QStringList &namespaceNames);
     void resetQtDocInfo(const QString &component);
     void checkInitState();
     void documentationRemoved(const QString &namespaceName);
@@ -102,6 +102,9 @@ void OpenPagesManager::setupInitialPages(bool defaultCollection,
             QStringList zoomFactors = helpEngine.lastZoomFactors();
             while (zoomFactors.count() < pageCount)
                 zoomFactors.append(CollectionConfiguration::DefaultZoomFactor);
+            QStringList titles = helpEngine.lastShownPageTitles();
+            while (titles.count() < pageCount)
+                titles.append(QString());
             initialPage = helpEngine.lastTabPage();
             if (initialPage >= pageCount) {
                 qWarning("Initial page set to %d, maximum possible value is %d",
@@ -112,7 +115,9 @@ void OpenPagesManager::setupInitialPages(bool defaultCollection,
                 const QString &curFile = lastShownPageList.at(curPage);
                 if (helpEngine.findFile(curFile).isValid()
                     || curFile == QLatin1String("about:blank")) {
-                    m_model->addPage(curFile, zoomFactors.at(curPage).toFloat());
+                    // Loaded when shown, so at startup only the current page is
+                    m_model->addPendingPage(curFile, zoomFactors.at(curPage).toFloat(),
+                                            titles.at(curPage));
                 } else if (curPage <= initialPage && initialPage > 0)
                     --initialPage;
             }
@@ -40,15 +40,27 @@ QVariant OpenPagesModel::data(const QModelIndex &index, int role) const
 }
 
 HelpViewer *OpenPagesModel::addPage(const QUrl &url, qreal zoom)
+{
+    TRACE_OBJ
+    HelpViewer *page = addPendingPage(url, zoom, QString());
+    page->setSource(url);
+    return page;
+}
+
+/*
+    Adds a page that only loads \a url once it is shown for the
+    first time, and shows \a title until then.
+*/
+HelpViewer *OpenPagesModel::addPendingPage(const QUrl &url, qreal zoom, const QString &title)
 {
     TRACE_OBJ
     beginInsertRows(QModelIndex(), rowCount(), rowCount());
     HelpViewer *page = new HelpViewer(zoom);
+    page->setPendingSource(url, title);
     connect(page, &HelpViewer::titleChanged,
             this, &OpenPagesModel::handleTitleChanged);
     m_pages << page;
     endInsertRows();
-    page->setSource(url);
     return page;
 }
 
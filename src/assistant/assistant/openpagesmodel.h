@@ -24,6 +24,7 @@ public:
     QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const override;
 
     HelpViewer *addPage(const QUrl &url, qreal zoom = 0);
+    HelpViewer *addPendingPage(const QUrl &url, qreal zoom, const QString &title);
     void removePage(int index);
     HelpViewer *pageAt(int index) const;
 
@@ -6,10 +6,14 @@
 #include <QtCore/QLibraryInfo>
 #include <QtCore/QDateTime>
 #include <QtCore/QFileSystemWatcher>
+#include <QtCore/QAtomicInt>
 #include <QtHelp/QHelpEngineCore>
 #include "helpenginewrapper.h"
 #include "qtdocinstaller.h"
 
+#include <memory>
+#include <vector>
+
 QT_BEGIN_NAMESPACE
 
 QtDocInstaller::QtDocInstaller(const QList<DocInfo> &docInfos)
@@ -35,26 +39,61 @@ void QtDocInstaller::installDocs()
     start(LowPriority);
 }
 
+bool QtDocInstaller::isAborted()
+{
+    QMutexLocker locker(&m_mutex);
+    return m_abort;
+}
+
 void QtDocInstaller::run()
 {
     TRACE_OBJ
     m_qchDir.setPath(QLibraryInfo::path(QLibraryInfo::DocumentationPath));
     m_qchFiles = m_qchDir.entryList(QStringList() << QLatin1String("*.qch"));
 
+    /* Looking at the files and reading their namespaces is independent
+       for every component, so spread it over several threads. */
+    std::vector<DocResult> results(m_docInfos.size());
+    const int threadCount = qMin(QThread::idealThreadCount(), int(results.size()));
+    QAtomicInt next = 0;
+    std::vector<std::unique_ptr<QThread>> threads;
+    for (int i = 0; i < threadCount; ++i) {
+        threads.emplace_back(QThread::create([this, &results, &next] {
+            for (int j = next.fetchAndAddRelaxed(1); j < int(results.size());
+                 j = next.fetchAndAddRelaxed(1)) {
+                if (isAborted())
+                    return;
+                results[j] = installDoc(m_docInfos.at(j));
+            }
+        }));
+        threads.back()->start();
+    }
+    for (const auto &thread : threads)
+        thread->wait();
+    if (isAborted())
+        return;
+
     bool changes = false;
-    for (const DocInfo &docInfo : qAsConst(m_docInfos)) {
-        changes |= installDoc(docInfo);
-        m_mutex.lock();
-        if (m_abort) {
-            m_mutex.unlock();
-            return;
+    QStringList components;
+    QStringList absFileNames;
+    QStringList namespaceNames;
+    for (qsizetype i = 0; i < m_docInfos.size(); ++i) {
+        const DocResult &result = results[i];
+        if (!result.found) {
+            emit qchFileNotFound(m_docInfos.at(i).first);
+        } else if (result.changed) {
+            components.append(m_docInfos.at(i).first);
+            absFileNames.append(result.absFileName);
+            namespaceNames.append(result.namespaceName);
+            changes = true;
         }
-        m_mutex.unlock();
     }
+    if (!components.isEmpty())
+        emit registerDocumentations(components, absFileNames, namespaceNames);
     emit docsInstalled(changes);
 }
 
-bool QtDocInstaller::installDoc(const DocInfo &docInfo)
+QtDocInstaller::DocResult QtDocInstaller::installDoc(const DocInfo &docInfo) const
 {
     TRACE_OBJ
     const QString &component = docInfo.first;
@@ -67,23 +106,22 @@ bool QtDocInstaller::installDoc(const DocInfo &docInfo)
     if (info.count() == 2)
         qchFile = info.last();
 
-    if (m_qchFiles.isEmpty()) {
-        emit qchFileNotFound(component);
-        return false;
-    }
+    DocResult result;
     for (const QString &f : qAsConst(m_qchFiles)) {
         if (f.startsWith(component)) {
             QFileInfo fi(m_qchDir.absolutePath() + QDir::separator() + f);
+            result.found = true;
             if (dt.isValid() && fi.lastModified().toSecsSinceEpoch() == dt.toSecsSinceEpoch()
                 && qchFile == fi.absoluteFilePath())
-                return false;
-            emit registerDocumentation(component, fi.absoluteFilePath());
-            return true;
+                return result;
+            result.changed = true;
+            result.absFileName = fi.absoluteFilePath();
+            result.namespaceName = QHelpEngineCore::namespaceName(result.absFileName);
+            return result;
         }
     }
 
-    emit qchFileNotFound(component);
-    return false;
+    return result;
 }
 
 QT_END_NAMESPACE
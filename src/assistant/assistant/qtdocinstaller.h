@@ -26,13 +26,23 @@ public:
 
 signals:
     void qchFileNotFound(const QString &component);
-    void registerDocumentation(const QString &component,
-                               const QString &absFileName);
+    void registerDocumentations(const QStringList &components,
+                                const QStringList &absFileNames,
+                                const QStringList &namespaceNames);
     void docsInstalled(bool newDocsInstalled);
 
 private:
+    struct DocResult
+    {
+        bool found = false;
+        bool changed = false;
+        QString absFileName;
+        QString namespaceName;
+    };
+
     void run() override;
-    bool installDoc(const DocInfo &docInfo);
+    bool isAborted();
+    DocResult installDoc(const DocInfo &docInfo) const;
 
     bool m_abort;
     QMutex m_mutex;
@@ -39,6 +39,21 @@ RemoteControl::RemoteControl(MainWindow *mainWindow)
     connect(m_mainWindow, &MainWindow::initDone,
             this, &RemoteControl::applyCache);
 
+    m_applyTimer.setSingleShot(true);
+    m_applyTimer.setInterval(0);
+    connect(&m_applyTimer, &QTimer::timeout,
+            this, &RemoteControl::applyCache);
+
+    const auto clearIdentifierUrls = [this] { m_identifierUrls.clear(); };
+    connect(&helpEngine, &HelpEngineWrapper::setupFinished,
+            this, clearIdentifierUrls);
+    connect(&helpEngine, &HelpEngineWrapper::documentationRemoved,
+            this, clearIdentifierUrls);
+    connect(&helpEngine, &HelpEngineWrapper::documentationUpdated,
+            this, clearIdentifierUrls);
+    connect(helpEngine.filterEngine(), &QHelpFilterEngine::filterActivated,
+            this, clearIdentifierUrls);
+
     StdInListener *l = new StdInListener(this);
     connect(l, &StdInListener::receivedCommand,
             this, &RemoteControl::handleCommandString);
@@ -82,6 +97,10 @@ void RemoteControl::handleCommandString(const QString &cmdString)
          else
             break;
     }
+    // Navigation is deferred until the commands that are already queued
+    // have been received too, so that only the last page gets loaded.
+    if (!m_caching)
+        m_applyTimer.start();
     m_mainWindow->raise();
     m_mainWindow->activateWindow();
 }
@@ -123,62 +142,29 @@ void RemoteControl::handleSetSourceCommand(const QString &arg)
     if (url.isValid()) {
         if (url.isRelative())
             url = CentralWidget::instance()->currentSource().resolved(url);
-        if (m_caching) {
-            clearCache();
-            m_setSource = url;
-        } else {
-            CentralWidget::instance()->setSource(url);
-        }
+        clearCache();
+        m_setSource = url;
     }
 }
 
 void RemoteControl::handleSyncContentsCommand()
 {
     TRACE_OBJ
-    if (m_caching)
-        m_syncContents = true;
-    else
-        m_mainWindow->syncContents();
+    m_syncContents = true;
 }
 
 void RemoteControl::handleActivateKeywordCommand(const QString &arg)
 {
     TRACE_OBJ
-    if (m_caching) {
-        clearCache();
-        m_activateKeyword = arg;
-    } else {
-        m_mainWindow->setIndexString(arg);
-        if (!arg.isEmpty()) {
-            if (!helpEngine.indexWidget()->currentIndex().isValid()
-                && helpEngine.fullTextSearchFallbackEnabled()) {
-                if (QHelpSearchEngine *se = helpEngine.searchEngine()) {
-                    m_mainWindow->setSearchVisible(true);
-                    if (QHelpSearchQueryWidget *w = se->queryWidget()) {
-                        w->collapseExtendedSearch();
-                        w->setSearchInput(arg);
-                        se->search(arg);
-                    }
-                }
-            } else {
-                m_mainWindow->setIndexVisible(true);
-                helpEngine.indexWidget()->activateCurrentItem();
-            }
-        }
-    }
+    clearCache();
+    m_activateKeyword = arg;
 }
 
 void RemoteControl::handleActivateIdentifierCommand(const QString &arg)
 {
     TRACE_OBJ
-    if (m_caching) {
-        clearCache();
-        m_activateIdentifier = arg;
-    } else {
-        const auto docs = helpEngine.documentsForIdentifier(arg);
-        if (!docs.isEmpty())
-            CentralWidget::instance()->setSource(docs.first().url);
-    }
+    clearCache();
+    m_activateIdentifier = arg;
 }
 
 void RemoteControl::handleExpandTocCommand(const QString &arg)
@@ -191,23 +177,14 @@ void RemoteControl::handleExpandTocCommand(const QString &arg)
     if (!ok || depth < -2)
         depth = -2;
 
-    if (m_caching)
-        m_expandTOC = depth;
-    else if (depth != -2)
-        m_mainWindow->expandTOC(depth);
+    m_expandTOC = depth;
 }
 
 void RemoteControl::handleSetCurrentFilterCommand(const QString &arg)
 {
     TRACE_OBJ
-    if (helpEngine.filterEngine()->filters().contains(arg)) {
-        if (m_caching) {
-            clearCache();
-            m_currentFilter = arg;
-        } else {
-            helpEngine.filterEngine()->setActiveFilter(arg);
-        }
-    }
+    if (helpEngine.filterEngine()->filters().contains(arg))
+        m_currentFilter = arg;
 }
 
 void RemoteControl::handleRegisterCommand(const QString &arg)
@@ -233,21 +210,51 @@ void RemoteControl::handleUnregisterCommand(const QString &arg)
     }
 }
 
+void RemoteControl::activateKeyword(const QString &keyword)
+{
+    TRACE_OBJ
+    m_mainWindow->setIndexString(keyword);
+    if (!helpEngine.indexWidget()->currentIndex().isValid()
+        && helpEngine.fullTextSearchFallbackEnabled()) {
+        if (QHelpSearchEngine *se = helpEngine.searchEngine()) {
+            m_mainWindow->setSearchVisible(true);
+            if (QHelpSearchQueryWidget *w = se->queryWidget()) {
+                w->collapseExtendedSearch();
+                w->setSearchInput(keyword);
+                se->search(keyword);
+            }
+        }
+    } else {
+        m_mainWindow->setIndexVisible(true);
+        helpEngine.indexWidget()->activateCurrentItem();
+    }
+}
+
+QUrl RemoteControl::urlForIdentifier(const QString &identifier)
+{
+    TRACE_OBJ
+    auto it = m_identifierUrls.constFind(identifier);
+    if (it == m_identifierUrls.cend()) {
+        const auto docs = helpEngine.documentsForIdentifier(identifier);
+        it = m_identifierUrls.insert(identifier, docs.isEmpty() ? QUrl() : docs.first().url);
+    }
+    return *it;
+}
+
 void RemoteControl::applyCache()
 {
     TRACE_OBJ
+    if (!m_currentFilter.isEmpty())
+        helpEngine.filterEngine()->setActiveFilter(m_currentFilter);
+
     if (m_setSource.isValid()) {
         CentralWidget::instance()->setSource(m_setSource);
     } else if (!m_activateKeyword.isEmpty()) {
-        m_mainWindow->setIndexString(m_activateKeyword);
-        helpEngine.indexWidget()->activateCurrentItem();
+        activateKeyword(m_activateKeyword);
     } else if (!m_activateIdentifier.isEmpty()) {
-        const auto docs =
-            helpEngine.documentsForIdentifier(m_activateIdentifier);
-        if (!docs.isEmpty())
-            CentralWidget::instance()->setSource(docs.first().url);
-    } else if (!m_currentFilter.isEmpty()) {
-        helpEngine.filterEngine()->setActiveFilter(m_currentFilter);
+        const QUrl url = urlForIdentifier(m_activateIdentifier);
+        if (url.isValid())
+            CentralWidget::instance()->setSource(url);
     }
 
     if (m_syncContents)
@@ -258,12 +265,15 @@ void RemoteControl::applyCache()
         m_mainWindow->expandTOC(m_expandTOC);
 
     m_caching = false;
+    m_currentFilter.clear();
+    m_expandTOC = -2;
+    clearCache();
 }
 
+// Drops the pending navigation, which a new navigation command supersedes.
 void RemoteControl::clearCache()
 {
     TRACE_OBJ
-    m_currentFilter.clear();
     m_setSource.clear();
     m_syncContents = false;
     m_activateKeyword.clear();
@@ -4,8 +4,10 @@
 #ifndef REMOTECONTROL_H
 #define REMOTECONTROL_H
 
+#include <QtCore/QHash>
 #include <QtCore/QObject>
 #include <QtCore/QString>
+#include <QtCore/QTimer>
 #include <QtCore/QUrl>
 
 QT_BEGIN_NAMESPACE
@@ -26,6 +28,8 @@ private slots:
 
 private:
     void clearCache();
+    void activateKeyword(const QString &keyword);
+    QUrl urlForIdentifier(const QString &identifier);
     void splitInputString(const QString &input, QString &cmd, QString &arg);
     void handleDebugCommand(const QString &arg);
     void handleShowOrHideCommand(const QString &arg, bool show);
@@ -50,6 +54,10 @@ private:
 
     bool m_caching = true;
     bool m_syncContents = false;
+
+    // Applies the commands received in one go, dropping superseded navigation
+    QTimer m_applyTimer;
+    QHash<QString, QUrl> m_identifierUrls; // first document of each identifier looked up
 };
 
 QT_END_NAMESPACE
@@ -35,6 +35,7 @@ SearchWidget::SearchWidget(QHelpSearchEngine *engine, QWidget *parent)
 
     resultWidget = searchEngine->resultWidget();
     QHelpSearchQueryWidget *queryWidget = searchEngine->queryWidget();
+    queryWidget->setLiveSearchEnabled(true);
 
     vLayout->addWidget(queryWidget);
     vLayout->addWidget(resultWidget);
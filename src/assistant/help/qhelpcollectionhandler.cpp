@@ -6,13 +6,17 @@
 #include "qhelpdbreader_p.h"
 #include "qhelpfilterdata.h"
 
+#include <QtCore/QAtomicInt>
+#include <QtCore/QCryptographicHash>
 #include <QtCore/QDataStream>
 #include <QtCore/QDateTime>
 #include <QtCore/QDir>
 #include <QtCore/QFile>
 #include <QtCore/QFileInfo>
+#include <QtCore/QHash>
 #include <QtCore/QList>
 #include <QtCore/QMultiMap>
+#include <QtCore/QThread>
 #include <QtCore/QTimer>
 #include <QtCore/QVersionNumber>
 
@@ -21,6 +25,10 @@
 #include <QtSql/QSqlError>
 #include <QtSql/QSqlDriver>
 
+#include <memory>
+#include <utility>
+#include <vector>
+
 QT_BEGIN_NAMESPACE
 
 class Transaction
@@ -82,12 +90,81 @@ void QHelpCollectionHandler::closeDB()
     if (!m_query)
         return;
 
+    clearDocumentationReaders();
+    m_filterNamespaces.clear();
+    m_identifierLinks.reset();
+    qDeleteAll(m_preparedQueries);
+    m_preparedQueries.clear();
     delete m_query;
     m_query = nullptr;
     QSqlDatabase::removeDatabase(m_connectionName);
     m_connectionName = QString();
 }
 
+/*
+    Returns a query for \a statement, which is only prepared the first time
+    it is asked for. The query is finished when the returned object goes
+    out of scope, so that it does not keep its results open.
+*/
+QHelpCollectionHandler::PreparedQuery QHelpCollectionHandler::preparedQuery(
+        const QString &statement) const
+{
+    // The statements with filters depend on the number of attributes.
+    constexpr qsizetype MaxPreparedQueries = 64;
+
+    QSqlQuery *query = m_preparedQueries.value(statement);
+    if (query)
+        return PreparedQuery(query);
+
+    // The cached queries may be in use, so they are not dropped when there
+    // are too many of them, the statement just is not cached.
+    if (m_preparedQueries.size() < MaxPreparedQueries) {
+        query = new QSqlQuery(QSqlDatabase::database(m_connectionName));
+        query->setForwardOnly(true);
+        if (query->prepare(statement)) {
+            m_preparedQueries.insert(statement, query);
+            return PreparedQuery(query);
+        }
+        delete query;
+    }
+
+    // Otherwise the shared query is used, failing the way it did before.
+    m_query->prepare(statement);
+    return PreparedQuery(m_query);
+}
+
+/*
+    Returns a reader for the documentation file \a fileName, which stays
+    open until the documentation is registered or unregistered, so that
+    loading the files of a page does not open the file each time.
+*/
+QHelpDBReader *QHelpCollectionHandler::documentationReader(const QString &fileName) const
+{
+    constexpr qsizetype MaxDocumentationReaders = 16;
+
+    QHelpDBReader *reader = m_documentationReaders.value(fileName);
+    if (reader)
+        return reader;
+
+    if (m_documentationReaders.size() >= MaxDocumentationReaders)
+        clearDocumentationReaders();
+
+    reader = new QHelpDBReader(fileName, QHelpGlobal::uniquifyConnectionName(
+                                   fileName, const_cast<QHelpCollectionHandler *>(this)), nullptr);
+    if (!reader->init()) {
+        delete reader;
+        return nullptr;
+    }
+    m_documentationReaders.insert(fileName, reader);
+    return reader;
+}
+
+void QHelpCollectionHandler::clearDocumentationReaders() const
+{
+    qDeleteAll(m_documentationReaders);
+    m_documentationReaders.clear();
+}
+
 QString QHelpCollectionHandler::collectionFile() const
 {
     return m_collectionFile;
@@ -178,6 +255,13 @@ bool QHelpCollectionHandler::openCollectionFile()
         indexAndNamespaceFilterTablesMissing = tablesExist;
     }
 
+    // The indexes only speed up the lookups, so a collection that cannot
+    // get them, for example because it is read-only, is still used.
+    if (!createIndexes(m_query)) {
+        qWarning("Cannot create the lookup indexes in file %s: %s",
+                 qUtf8Printable(collectionFile()), qUtf8Printable(m_query->lastError().text()));
+    }
+
     const FileInfoList &docList = registeredDocumentations();
     if (indexAndNamespaceFilterTablesMissing) {
         for (const QHelpCollectionHandler::FileInfo &info : docList) {
@@ -189,9 +273,20 @@ bool QHelpCollectionHandler::openCollectionFile()
         return true;
     }
 
+    /* A documentation file that moved away from the registered path is
+       stale, whatever its time stamp says. */
     QList<TimeStamp> timeStamps;
-    m_query->exec(QLatin1String("SELECT NamespaceId, FolderId, FilePath, Size, TimeStamp "
-                               "FROM TimeStampTable"));
+    QList<TimeStamp> toRemove;
+    m_query->exec(QLatin1String("SELECT "
+                                    "TimeStampTable.NamespaceId, "
+                                    "TimeStampTable.FolderId, "
+                                    "TimeStampTable.FilePath, "
+                                    "TimeStampTable.Size, "
+                                    "TimeStampTable.TimeStamp, "
+                                    "NamespaceTable.FilePath "
+                                "FROM TimeStampTable "
+                                "LEFT JOIN NamespaceTable "
+                                "ON NamespaceTable.Id = TimeStampTable.NamespaceId"));
     while (m_query->next()) {
         TimeStamp timeStamp;
         timeStamp.namespaceId = m_query->value(0).toInt();
@@ -199,13 +294,39 @@ bool QHelpCollectionHandler::openCollectionFile()
         timeStamp.fileName    = m_query->value(2).toString();
         timeStamp.size        = m_query->value(3).toInt();
         timeStamp.timeStamp   = m_query->value(4).toString();
-        timeStamps.append(timeStamp);
+        if (m_query->isNull(5) || m_query->value(5).toString() != timeStamp.fileName)
+            toRemove.append(timeStamp);
+        else
+            timeStamps.append(timeStamp);
     }
+    m_query->clear();
 
-    QList<TimeStamp> toRemove;
-    for (const TimeStamp &timeStamp : timeStamps) {
-        if (!isTimeStampCorrect(timeStamp))
-            toRemove.append(timeStamp);
+    /* Checking the files is bound by the file system latency, which is
+       high for documentation on network drives, so do it in parallel. */
+    std::vector<char> timeStampCorrect(timeStamps.size(), false);
+    const int threadCount = qMin(QThread::idealThreadCount(), int(timeStamps.size()));
+    if (threadCount > 1) {
+        QAtomicInt next = 0;
+        std::vector<std::unique_ptr<QThread>> threads;
+        for (int i = 0; i < threadCount; ++i) {
+            threads.emplace_back(QThread::create([this, &timeStamps, &timeStampCorrect, &next] {
+                for (int j = next.fetchAndAddRelaxed(1); j < int(timeStamps.size());
+                     j = next.fetchAndAddRelaxed(1)) {
+                    timeStampCorrect[j] = isTimeStampCorrect(timeStamps.at(j));
+                }
+            }));
+            threads.back()->start();
+        }
+        for (const auto &thread : threads)
+            thread->wait();
+    } else {
+        for (qsizetype i = 0; i < timeStamps.size(); ++i)
+            timeStampCorrect[i] = isTimeStampCorrect(timeStamps.at(i));
+    }
+
+    for (qsizetype i = 0; i < timeStamps.size(); ++i) {
+        if (!timeStampCorrect[i])
+            toRemove.append(timeStamps.at(i));
     }
 
     // TODO: we may optimize when toRemove.size() == timeStamps.size().
@@ -240,6 +361,10 @@ QString QHelpCollectionHandler::absoluteDocPath(const QString &fileName) const
               .absoluteFilePath();
 }
 
+/*
+    Checks that the documentation file of \a timeStamp did not change. This
+    only accesses the file system, so it may be called from any thread.
+*/
 bool QHelpCollectionHandler::isTimeStampCorrect(const TimeStamp &timeStamp) const
 {
     const QFileInfo fi(absoluteDocPath(timeStamp.fileName));
@@ -253,18 +378,6 @@ bool QHelpCollectionHandler::isTimeStampCorrect(const TimeStamp &timeStamp) cons
     if (fi.lastModified().toString(Qt::ISODate) != timeStamp.timeStamp)
         return false;
 
-    m_query->prepare(QLatin1String("SELECT FilePath "
-                                  "FROM NamespaceTable "
-                                  "WHERE Id = ?"));
-    m_query->bindValue(0, timeStamp.namespaceId);
-    if (!m_query->exec() || !m_query->next())
-        return false;
-
-    const QString oldFileName = m_query->value(0).toString();
-    m_query->clear();
-    if (oldFileName != timeStamp.fileName)
-        return false;
-
     return true;
 }
 
@@ -440,6 +553,32 @@ bool QHelpCollectionHandler::createTables(QSqlQuery *query)
     return true;
 }
 
+// The lookups of files, keywords and namespaces by name
+bool QHelpCollectionHandler::createIndexes(QSqlQuery *query)
+{
+    const QStringList indexes = QStringList()
+            << QLatin1String("CREATE INDEX IF NOT EXISTS NamespaceNameIndex "
+                             "ON NamespaceTable (Name)")
+            << QLatin1String("CREATE INDEX IF NOT EXISTS FolderNameIndex "
+                             "ON FolderTable (Name)")
+            << QLatin1String("CREATE INDEX IF NOT EXISTS FolderNamespaceIndex "
+                             "ON FolderTable (NamespaceId)")
+            << QLatin1String("CREATE INDEX IF NOT EXISTS FileNameIndex "
+                             "ON FileNameTable (Name)")
+            << QLatin1String("CREATE INDEX IF NOT EXISTS IndexNameIndex "
+                             "ON IndexTable (Name)")
+            << QLatin1String("CREATE INDEX IF NOT EXISTS IndexIdentifierIndex "
+                             "ON IndexTable (Identifier)")
+            << QLatin1String("CREATE INDEX IF NOT EXISTS VersionNamespaceIndex "
+                             "ON VersionTable (NamespaceId)");
+
+    for (const QString &q : indexes) {
+        if (!query->exec(q))
+            return false;
+    }
+    return true;
+}
+
 bool QHelpCollectionHandler::recreateIndexAndNamespaceFilterTables(QSqlQuery *query)
 {
     const QStringList tables = QStringList()
@@ -683,6 +822,9 @@ bool QHelpCollectionHandler::setFilterData(const QString &filterName,
 
 bool QHelpCollectionHandler::removeFilter(const QString &filterName)
 {
+    m_filterNamespaces.clear();
+    m_identifierLinks.reset();
+
     m_query->prepare(QLatin1String("SELECT FilterId "
                                    "FROM Filter "
                                    "WHERE Name = ?"));
@@ -809,24 +951,23 @@ QHelpCollectionHandler::FileInfo QHelpCollectionHandler::registeredDocumentation
     if (!m_query)
         return fileInfo;
 
-    m_query->prepare(QLatin1String("SELECT "
-                                       "NamespaceTable.Name, "
-                                       "NamespaceTable.FilePath, "
-                                       "FolderTable.Name "
-                                   "FROM "
-                                       "NamespaceTable, "
-                                       "FolderTable "
-                                   "WHERE NamespaceTable.Id = FolderTable.NamespaceId "
-                                   "AND NamespaceTable.Name = ? LIMIT 1"));
-    m_query->bindValue(0, namespaceName);
-    if (!m_query->exec() || !m_query->next())
+    const PreparedQuery query = preparedQuery(QLatin1String(
+            "SELECT "
+                "NamespaceTable.Name, "
+                "NamespaceTable.FilePath, "
+                "FolderTable.Name "
+            "FROM "
+                "NamespaceTable, "
+                "FolderTable "
+            "WHERE NamespaceTable.Id = FolderTable.NamespaceId "
+            "AND NamespaceTable.Name = ? LIMIT 1"));
+    query->bindValue(0, namespaceName);
+    if (!query->exec() || !query->next())
         return fileInfo;
 
-    fileInfo.namespaceName = m_query->value(0).toString();
-    fileInfo.fileName = m_query->value(1).toString();
-    fileInfo.folderName = m_query->value(2).toString();
-
-    m_query->clear();
+    fileInfo.namespaceName = query->value(0).toString();
+    fileInfo.fileName = query->value(1).toString();
+    fileInfo.folderName = query->value(2).toString();
 
     return fileInfo;
 }
@@ -858,39 +999,126 @@ QHelpCollectionHandler::FileInfoList QHelpCollectionHandler::registeredDocumenta
 }
 
 bool QHelpCollectionHandler::registerDocumentation(const QString &fileName)
+{
+    return registerDocumentations(QStringList(fileName));
+}
+
+namespace {
+
+// What is registered of a documentation file, read before the collection
+// is changed
+struct DocumentationData
+{
+    QString fileName;
+    bool opened = false;
+    QString namespaceName;
+    QString virtualFolder;
+    QString version;
+    QList<QStringList> filterAttributeSets;
+    QList<std::pair<QString, QStringList>> customFilters;
+    QHelpDBReader::IndexTable indexTable;
+};
+
+}
+
+static void readDocumentation(DocumentationData *data)
+{
+    QHelpDBReader reader(data->fileName, QHelpGlobal::uniquifyConnectionName(
+        QLatin1String("QHelpCollectionHandler"), data), nullptr);
+    data->opened = reader.init();
+    if (!data->opened)
+        return;
+
+    data->namespaceName = reader.namespaceName();
+    if (data->namespaceName.isEmpty())
+        return;
+
+    data->virtualFolder = reader.virtualFolder();
+    data->version = reader.version();
+    data->filterAttributeSets = reader.filterAttributeSets();
+    for (const QString &filterName : reader.customFilters())
+        data->customFilters.append({ filterName, reader.filterAttributes(filterName) });
+    data->indexTable = reader.indexTable();
+}
+
+/*
+    Registers all the documentation files \a fileNames at once, or none of
+    them if one fails. The files are read in parallel before the collection
+    is changed, and their index tables are then written together.
+*/
+bool QHelpCollectionHandler::registerDocumentations(const QStringList &fileNames)
 {
     if (!isDBOpened())
         return false;
 
-    QHelpDBReader reader(fileName, QHelpGlobal::uniquifyConnectionName(
-        QLatin1String("QHelpCollectionHandler"), this), nullptr);
-    if (!reader.init()) {
-        emit error(tr("Cannot open documentation file %1.").arg(fileName));
-        return false;
+    clearDocumentationReaders();
+
+    std::vector<DocumentationData> documentations(fileNames.size());
+    for (qsizetype i = 0; i < fileNames.size(); ++i)
+        documentations[i].fileName = fileNames.at(i);
+
+    const int threadCount = qMin(QThread::idealThreadCount(), int(documentations.size()));
+    if (threadCount > 1) {
+        QAtomicInt next = 0;
+        std::vector<std::unique_ptr<QThread>> threads;
+        for (int i = 0; i < threadCount; ++i) {
+            threads.emplace_back(QThread::create([&documentations, &next] {
+                for (int j = next.fetchAndAddRelaxed(1); j < int(documentations.size());
+                     j = next.fetchAndAddRelaxed(1)) {
+                    readDocumentation(&documentations[j]);
+                }
+            }));
+            threads.back()->start();
+        }
+        for (const auto &thread : threads)
+            thread->wait();
+    } else {
+        for (DocumentationData &documentation : documentations)
+            readDocumentation(&documentation);
     }
 
-    const QString &ns = reader.namespaceName();
-    if (ns.isEmpty()) {
-        emit error(tr("Invalid documentation file \"%1\".").arg(fileName));
-        return false;
-    }
+    Transaction transaction(m_connectionName);
 
-    const int nsId = registerNamespace(ns, fileName);
-    if (nsId < 1)
-        return false;
+    const QDir collectionDir = QFileInfo(m_collectionFile).absoluteDir();
+    QList<IndexTableData> indexTables;
+    indexTables.reserve(documentations.size());
+    for (const DocumentationData &documentation : documentations) {
+        if (!documentation.opened) {
+            emit error(tr("Cannot open documentation file %1.").arg(documentation.fileName));
+            return false;
+        }
 
-    const int vfId = registerVirtualFolder(reader.virtualFolder(), nsId);
-    if (vfId < 1)
-        return false;
+        const QString &ns = documentation.namespaceName;
+        if (ns.isEmpty()) {
+            emit error(tr("Invalid documentation file \"%1\".").arg(documentation.fileName));
+            return false;
+        }
 
-    registerVersion(reader.version(), nsId);
-    registerFilterAttributes(reader.filterAttributeSets(), nsId); // qset, what happens when removing documentation?
-    for (const QString &filterName : reader.customFilters())
-        addCustomFilter(filterName, reader.filterAttributes(filterName));
+        const int nsId = registerNamespace(ns, documentation.fileName);
+        if (nsId < 1)
+            return false;
 
-    if (!registerIndexTable(reader.indexTable(), nsId, vfId, registeredDocumentation(ns).fileName))
+        const int vfId = registerVirtualFolder(documentation.virtualFolder, nsId);
+        if (vfId < 1)
+            return false;
+
+        registerVersion(documentation.version, nsId);
+        registerFilterAttributes(documentation.filterAttributeSets, nsId); // qset, what happens when removing documentation?
+        for (const auto &customFilter : documentation.customFilters)
+            addCustomFilter(customFilter.first, customFilter.second);
+
+        IndexTableData indexTable;
+        indexTable.indexTable = documentation.indexTable;
+        indexTable.nsId = nsId;
+        indexTable.vfId = vfId;
+        indexTable.fileName = collectionDir.relativeFilePath(documentation.fileName);
+        indexTables.append(indexTable);
+    }
+
+    if (!registerIndexTables(indexTables))
         return false;
 
+    transaction.commit();
     return true;
 }
 
@@ -899,6 +1127,10 @@ bool QHelpCollectionHandler::unregisterDocumentation(const QString &namespaceNam
     if (!isDBOpened())
         return false;
 
+    clearDocumentationReaders();
+    m_filterNamespaces.clear();
+    m_identifierLinks.reset();
+
     m_query->prepare(QLatin1String("SELECT Id FROM NamespaceTable WHERE Name = ?"));
     m_query->bindValue(0, namespaceName);
     m_query->exec();
@@ -972,22 +1204,22 @@ bool QHelpCollectionHandler::fileExists(const QUrl &url) const
     if (fileInfo.namespaceName.isEmpty())
         return false;
 
-    m_query->prepare(QLatin1String("SELECT COUNT (DISTINCT NamespaceTable.Id) "
-                                   "FROM "
-                                       "FileNameTable, "
-                                       "NamespaceTable, "
-                                       "FolderTable "
-                                   "WHERE FolderTable.Name = ? "
-                                   "AND FileNameTable.Name = ? "
-                                   "AND FileNameTable.FolderId = FolderTable.Id "
-                                   "AND FolderTable.NamespaceId = NamespaceTable.Id"));
-    m_query->bindValue(0, fileInfo.folderName);
-    m_query->bindValue(1, fileInfo.fileName);
-    if (!m_query->exec() || !m_query->next())
+    const PreparedQuery query = preparedQuery(QLatin1String(
+            "SELECT COUNT (DISTINCT NamespaceTable.Id) "
+            "FROM "
+                "FileNameTable, "
+                "NamespaceTable, "
+                "FolderTable "
+            "WHERE FolderTable.Name = ? "
+            "AND FileNameTable.Name = ? "
+            "AND FileNameTable.FolderId = FolderTable.Id "
+            "AND FolderTable.NamespaceId = NamespaceTable.Id"));
+    query->bindValue(0, fileInfo.folderName);
+    query->bindValue(1, fileInfo.fileName);
+    if (!query->exec() || !query->next())
         return false;
 
-    const int count = m_query->value(0).toInt();
-    m_query->clear();
+    const int count = query->value(0).toInt();
 
     return count;
 }
@@ -1137,17 +1369,17 @@ QString QHelpCollectionHandler::namespaceForFile(const QUrl &url,
                                  QLatin1String("FileFilterTable"),
                                  QLatin1String("FileId"));
 
-    m_query->prepare(filterQuery);
-    m_query->bindValue(0, fileInfo.folderName);
-    m_query->bindValue(1, fileInfo.fileName);
-    bindFilterQuery(m_query, 2, filterAttributes);
+    const PreparedQuery query = preparedQuery(filterQuery);
+    query->bindValue(0, fileInfo.folderName);
+    query->bindValue(1, fileInfo.fileName);
+    bindFilterQuery(query.get(), 2, filterAttributes);
 
-    if (!m_query->exec())
+    if (!query->exec())
         return QString();
 
     QList<QString> namespaceList;
-    while (m_query->next())
-        namespaceList.append(m_query->value(0).toString());
+    while (query->next())
+        namespaceList.append(query->value(0).toString());
 
     if (namespaceList.isEmpty())
         return QString();
@@ -1190,19 +1422,18 @@ QString QHelpCollectionHandler::namespaceForFile(const QUrl &url,
                 "AND FolderTable.NamespaceId = NamespaceTable.Id");
 
     const QString filterQuery = filterlessQuery
-            + prepareFilterQuery(filterName);
+            + filterNamespacesQuery(filterName);
 
-    m_query->prepare(filterQuery);
-    m_query->bindValue(0, fileInfo.folderName);
-    m_query->bindValue(1, fileInfo.fileName);
-    bindFilterQuery(m_query, 2, filterName);
+    const PreparedQuery query = preparedQuery(filterQuery);
+    query->bindValue(0, fileInfo.folderName);
+    query->bindValue(1, fileInfo.fileName);
 
-    if (!m_query->exec())
+    if (!query->exec())
         return QString();
 
     QList<QString> namespaceList;
-    while (m_query->next())
-        namespaceList.append(m_query->value(0).toString());
+    while (query->next())
+        namespaceList.append(query->value(0).toString());
 
     if (namespaceList.isEmpty())
         return QString();
@@ -1250,23 +1481,23 @@ QStringList QHelpCollectionHandler::files(const QString &namespaceName,
                                  QLatin1String("FileFilterTable"),
                                  QLatin1String("FileId"));
 
-    m_query->prepare(filterQuery);
-    m_query->bindValue(0, namespaceName);
+    const PreparedQuery query = preparedQuery(filterQuery);
+    query->bindValue(0, namespaceName);
     int bindCount = 1;
     if (!extensionFilter.isEmpty()) {
-        m_query->bindValue(bindCount, QString::fromLatin1("%.%1").arg(extensionFilter));
+        query->bindValue(bindCount, QString::fromLatin1("%.%1").arg(extensionFilter));
         ++bindCount;
     }
-    bindFilterQuery(m_query, bindCount, filterAttributes);
+    bindFilterQuery(query.get(), bindCount, filterAttributes);
 
-    if (!m_query->exec())
+    if (!query->exec())
         return QStringList();
 
     QStringList fileNames;
-    while (m_query->next()) {
-        fileNames.append(m_query->value(0).toString()
+    while (query->next()) {
+        fileNames.append(query->value(0).toString()
                          + QLatin1Char('/')
-                         + m_query->value(1).toString());
+                         + query->value(1).toString());
     }
 
     return fileNames;
@@ -1294,26 +1525,24 @@ QStringList QHelpCollectionHandler::files(const QString &namespaceName,
                 "AND NamespaceTable.Name = ?") + extensionQuery;
 
     const QString filterQuery = filterlessQuery
-            + prepareFilterQuery(filterName);
+            + filterNamespacesQuery(filterName);
 
-    m_query->prepare(filterQuery);
-    m_query->bindValue(0, namespaceName);
+    const PreparedQuery query = preparedQuery(filterQuery);
+    query->bindValue(0, namespaceName);
     int bindCount = 1;
     if (!extensionFilter.isEmpty()) {
-        m_query->bindValue(bindCount, QString::fromLatin1("%.%1").arg(extensionFilter));
+        query->bindValue(bindCount, QString::fromLatin1("%.%1").arg(extensionFilter));
         ++bindCount;
     }
 
-    bindFilterQuery(m_query, bindCount, filterName);
-
-    if (!m_query->exec())
+    if (!query->exec())
         return QStringList();
 
     QStringList fileNames;
-    while (m_query->next()) {
-        fileNames.append(m_query->value(0).toString()
+    while (query->next()) {
+        fileNames.append(query->value(0).toString()
                          + QLatin1Char('/')
-                         + m_query->value(1).toString());
+                         + query->value(1).toString());
     }
 
     return fileNames;
@@ -1359,14 +1588,11 @@ QByteArray QHelpCollectionHandler::fileData(const QUrl &url) const
     const FileInfo fileInfo = extractFileInfo(url);
 
     const FileInfo docInfo = registeredDocumentation(namespaceName);
-    const QString absFileName = absoluteDocPath(docInfo.fileName);
-
-    QHelpDBReader reader(absFileName, QHelpGlobal::uniquifyConnectionName(
-                             docInfo.fileName, const_cast<QHelpCollectionHandler *>(this)), nullptr);
-    if (!reader.init())
+    QHelpDBReader *reader = documentationReader(absoluteDocPath(docInfo.fileName));
+    if (!reader)
         return QByteArray();
 
-    return reader.fileData(fileInfo.folderName, fileInfo.fileName);
+    return reader->fileData(fileInfo.folderName, fileInfo.fileName);
 }
 
 QStringList QHelpCollectionHandler::indicesForFilter(const QStringList &filterAttributes) const
@@ -1409,6 +1635,33 @@ QStringList QHelpCollectionHandler::indicesForFilter(const QStringList &filterAt
 }
 
 
+/*
+    Returns a hash of the registered documentation files, their sizes and
+    modification times, which changes whenever the documentation of the
+    collection does, but not when other values in the collection do.
+*/
+QByteArray QHelpCollectionHandler::registeredDocumentationHash() const
+{
+    if (!isDBOpened())
+        return QByteArray();
+
+    QCryptographicHash hash(QCryptographicHash::Sha1);
+    m_query->exec(QLatin1String("SELECT NamespaceTable.Name, TimeStampTable.FolderId, "
+                                    "TimeStampTable.FilePath, TimeStampTable.Size, "
+                                    "TimeStampTable.TimeStamp "
+                                "FROM NamespaceTable, TimeStampTable "
+                                "WHERE NamespaceTable.Id = TimeStampTable.NamespaceId "
+                                "ORDER BY NamespaceTable.Name"));
+    while (m_query->next()) {
+        for (int i = 0; i < 5; ++i) {
+            hash.addData(m_query->value(i).toString().toUtf8());
+            hash.addData(QByteArrayView("", 1));
+        }
+    }
+    m_query->clear();
+    return hash.result();
+}
+
 QStringList QHelpCollectionHandler::indicesForFilter(const QString &filterName) const
 {
     QStringList indices;
@@ -1429,11 +1682,10 @@ QStringList QHelpCollectionHandler::indicesForFilter(const QString &filterName)
                 "AND IndexTable.NamespaceId = NamespaceTable.Id");
 
     const QString filterQuery = filterlessQuery
-            + prepareFilterQuery(filterName)
+            + filterNamespacesQuery(filterName)
             + QLatin1String(" ORDER BY LOWER(IndexTable.Name), IndexTable.Name");
 
     m_query->prepare(filterQuery);
-    bindFilterQuery(m_query, 0, filterName);
 
     m_query->exec();
 
@@ -1546,10 +1798,9 @@ QList<QHelpCollectionHandler::ContentsData> QHelpCollectionHandler::contentsForF
                 "AND VersionTable.NamespaceId = NamespaceTable.Id");
 
     const QString filterQuery = filterlessQuery
-            + prepareFilterQuery(filterName);
+            + filterNamespacesQuery(filterName);
 
     m_query->prepare(filterQuery);
-    bindFilterQuery(m_query, 0, filterName);
 
     m_query->exec();
 
@@ -1747,28 +1998,28 @@ QList<QStringList> QHelpCollectionHandler::filterAttributeSets(const QString &na
     if (!isDBOpened())
         return result;
 
-    m_query->prepare(QLatin1String(
-                         "SELECT "
-                             "FileAttributeSetTable.FilterAttributeSetId, "
-                             "FilterAttributeTable.Name "
-                         "FROM "
-                             "FileAttributeSetTable, "
-                             "FilterAttributeTable, "
-                             "NamespaceTable "
-                         "WHERE FileAttributeSetTable.FilterAttributeId = FilterAttributeTable.Id "
-                         "AND FileAttributeSetTable.NamespaceId = NamespaceTable.Id "
-                         "AND NamespaceTable.Name = ? "
-                         "ORDER BY FileAttributeSetTable.FilterAttributeSetId"));
-    m_query->bindValue(0, namespaceName);
-    m_query->exec();
+    const PreparedQuery query = preparedQuery(QLatin1String(
+            "SELECT "
+                "FileAttributeSetTable.FilterAttributeSetId, "
+                "FilterAttributeTable.Name "
+            "FROM "
+                "FileAttributeSetTable, "
+                "FilterAttributeTable, "
+                "NamespaceTable "
+            "WHERE FileAttributeSetTable.FilterAttributeId = FilterAttributeTable.Id "
+            "AND FileAttributeSetTable.NamespaceId = NamespaceTable.Id "
+            "AND NamespaceTable.Name = ? "
+            "ORDER BY FileAttributeSetTable.FilterAttributeSetId"));
+    query->bindValue(0, namespaceName);
+    query->exec();
     int oldId = -1;
-    while (m_query->next()) {
-        const int id = m_query->value(0).toInt();
+    while (query->next()) {
+        const int id = query->value(0).toInt();
         if (id != oldId) {
             result.append(QStringList());
             oldId = id;
         }
-        result.last().append(m_query->value(1).toString());
+        result.last().append(query->value(1).toString());
     }
 
     if (result.isEmpty())
@@ -1782,19 +2033,19 @@ QString QHelpCollectionHandler::namespaceVersion(const QString &namespaceName) c
     if (!m_query)
         return QString();
 
-    m_query->prepare(QLatin1String("SELECT "
-                                       "VersionTable.Version "
-                                   "FROM "
-                                       "NamespaceTable, "
-                                       "VersionTable "
-                                   "WHERE NamespaceTable.Name = ? "
-                                   "AND NamespaceTable.Id = VersionTable.NamespaceId"));
-    m_query->bindValue(0, namespaceName);
-    if (!m_query->exec() || !m_query->next())
+    const PreparedQuery query = preparedQuery(QLatin1String(
+            "SELECT "
+                "VersionTable.Version "
+            "FROM "
+                "NamespaceTable, "
+                "VersionTable "
+            "WHERE NamespaceTable.Name = ? "
+            "AND NamespaceTable.Id = VersionTable.NamespaceId"));
+    query->bindValue(0, namespaceName);
+    if (!query->exec() || !query->next())
         return QString();
 
-    const QString ret = m_query->value(0).toString();
-    m_query->clear();
+    const QString ret = query->value(0).toString();
 
     return ret;
 }
@@ -1805,6 +2056,9 @@ int QHelpCollectionHandler::registerNamespace(const QString &nspace, const QStri
     if (!m_query)
         return errorValue;
 
+    m_filterNamespaces.clear();
+    m_identifierLinks.reset();
+
     m_query->prepare(QLatin1String("SELECT COUNT(Id) FROM NamespaceTable WHERE Name=?"));
     m_query->bindValue(0, nspace);
     m_query->exec();
@@ -1858,6 +2112,9 @@ int QHelpCollectionHandler::registerVirtualFolder(const QString &folderName, int
 
 int QHelpCollectionHandler::registerComponent(const QString &componentName, int namespaceId)
 {
+    m_filterNamespaces.clear();
+    m_identifierLinks.reset();
+
     m_query->prepare(QLatin1String("SELECT ComponentId FROM ComponentTable WHERE Name = ?"));
     m_query->bindValue(0, componentName);
     if (!m_query->exec())
@@ -1891,6 +2148,9 @@ bool QHelpCollectionHandler::registerVersion(const QString &version, int namespa
     if (!m_query)
         return false;
 
+    m_filterNamespaces.clear();
+    m_identifierLinks.reset();
+
     m_query->prepare(QLatin1String("INSERT INTO VersionTable "
                                    "(NamespaceId, Version) "
                                    "VALUES(?, ?)"));
@@ -1964,215 +2224,178 @@ void QHelpCollectionHandler::createVersionFilter(const QString &version)
 bool QHelpCollectionHandler::registerIndexTable(const QHelpDBReader::IndexTable &indexTable,
                                                 int nsId, int vfId, const QString &fileName)
 {
-    Transaction transaction(m_connectionName);
-
-    QMap<QString, QVariantList> filterAttributeToNewFileId;
-
-    QVariantList fileFolderIds;
-    QVariantList fileNames;
-    QVariantList fileTitles;
-    const int fileSize = indexTable.fileItems.size();
-    fileFolderIds.reserve(fileSize);
-    fileNames.reserve(fileSize);
-    fileTitles.reserve(fileSize);
-
-    if (!m_query->exec(QLatin1String("SELECT MAX(FileId) FROM FileNameTable")) || !m_query->next())
-        return false;
-
-    const int maxFileId = m_query->value(0).toInt();
-
-    int newFileId = 0;
-    for (const QHelpDBReader::FileItem &item : indexTable.fileItems) {
-        fileFolderIds.append(vfId);
-        fileNames.append(item.name);
-        fileTitles.append(item.title);
+    IndexTableData data;
+    data.indexTable = indexTable;
+    data.nsId = nsId;
+    data.vfId = vfId;
+    data.fileName = fileName;
+    return registerIndexTables(QList<IndexTableData>() << data);
+}
 
-        for (const QString &filterAttribute : item.filterAttributes)
-            filterAttributeToNewFileId[filterAttribute].append(maxFileId + newFileId + 1);
-        ++newFileId;
-    }
+/*
+    Registers the files, keywords and contents of \a indexTables, with one
+    batch of inserts per table for all of them.
+*/
+bool QHelpCollectionHandler::registerIndexTables(const QList<IndexTableData> &indexTables)
+{
+    m_identifierLinks.reset();
+    Transaction transaction(m_connectionName);
 
-    m_query->prepare(QLatin1String("INSERT INTO FileNameTable VALUES(?, ?, NULL, ?)"));
-    m_query->addBindValue(fileFolderIds);
-    m_query->addBindValue(fileNames);
-    m_query->addBindValue(fileTitles);
-    if (!m_query->execBatch())
+    QHash<QString, int> attributeIds;
+    if (!m_query->exec(QLatin1String("SELECT Id, Name FROM FilterAttributeTable")))
         return false;
+    while (m_query->next())
+        attributeIds.insert(m_query->value(1).toString(), m_query->value(0).toInt());
+
+    // Appends the attributes of the new row rowId to the filter table lists.
+    const auto appendFilterRows = [&attributeIds](const QStringList &filterAttributes, int rowId,
+                                                  QVariantList *filterAttributeIds,
+                                                  QVariantList *rowIds) {
+        for (const QString &filterAttribute : filterAttributes) {
+            const auto it = attributeIds.constFind(filterAttribute);
+            if (it == attributeIds.cend())
+                return false;
+            filterAttributeIds->append(it.value());
+            rowIds->append(rowId);
+        }
+        return true;
+    };
 
-    for (auto it = filterAttributeToNewFileId.cbegin(),
-         end = filterAttributeToNewFileId.cend(); it != end; ++it) {
-        const QString filterAttribute = it.key();
-        m_query->prepare(QLatin1String("SELECT Id From FilterAttributeTable WHERE Name = ?"));
-        m_query->bindValue(0, filterAttribute);
-        if (!m_query->exec() || !m_query->next())
-            return false;
-
-        const int attributeId = m_query->value(0).toInt();
-
-        QVariantList attributeIds;
-        for (int i = 0; i < it.value().count(); i++)
-            attributeIds.append(attributeId);
-
-        m_query->prepare(QLatin1String("INSERT INTO FileFilterTable VALUES(?, ?)"));
-        m_query->addBindValue(attributeIds);
-        m_query->addBindValue(it.value());
-        if (!m_query->execBatch())
+    const auto maxId = [this](const QString &query, int *id) {
+        if (!m_query->exec(query) || !m_query->next())
             return false;
-    }
-
-    QMap<QString, QVariantList> filterAttributeToNewIndexId;
+        *id = m_query->value(0).toInt();
+        return true;
+    };
 
-    if (!m_query->exec(QLatin1String("SELECT MAX(Id) FROM IndexTable")) || !m_query->next())
+    int maxFileId = 0;
+    int maxIndexId = 0;
+    int maxContentsId = 0;
+    if (!maxId(QLatin1String("SELECT MAX(FileId) FROM FileNameTable"), &maxFileId)
+            || !maxId(QLatin1String("SELECT MAX(Id) FROM IndexTable"), &maxIndexId)
+            || !maxId(QLatin1String("SELECT MAX(Id) FROM ContentsTable"), &maxContentsId)) {
         return false;
+    }
 
-    const int maxIndexId = m_query->value(0).toInt();
-    int newIndexId = 0;
+    QVariantList fileFolderIds;
+    QVariantList fileNames;
+    QVariantList fileTitles;
+    QVariantList fileFilterAttributeIds;
+    QVariantList fileFilterFileIds;
 
     QVariantList indexNames;
     QVariantList indexIdentifiers;
     QVariantList indexNamespaceIds;
     QVariantList indexFileIds;
     QVariantList indexAnchors;
-    const int indexSize = indexTable.indexItems.size();
-    indexNames.reserve(indexSize);
-    indexIdentifiers.reserve(indexSize);
-    indexNamespaceIds.reserve(indexSize);
-    indexFileIds.reserve(indexSize);
-    indexAnchors.reserve(indexSize);
-
-    for (const QHelpDBReader::IndexItem &item : indexTable.indexItems) {
-        indexNames.append(item.name);
-        indexIdentifiers.append(item.identifier);
-        indexNamespaceIds.append(nsId);
-        indexFileIds.append(maxFileId + item.fileId + 1);
-        indexAnchors.append(item.anchor);
-
-        for (const QString &filterAttribute : item.filterAttributes)
-            filterAttributeToNewIndexId[filterAttribute].append(maxIndexId + newIndexId + 1);
-        ++newIndexId;
-    }
-
-    m_query->prepare(QLatin1String("INSERT INTO IndexTable VALUES(NULL, ?, ?, ?, ?, ?)"));
-    m_query->addBindValue(indexNames);
-    m_query->addBindValue(indexIdentifiers);
-    m_query->addBindValue(indexNamespaceIds);
-    m_query->addBindValue(indexFileIds);
-    m_query->addBindValue(indexAnchors);
-    if (!m_query->execBatch())
-        return false;
-
-    for (auto it = filterAttributeToNewIndexId.cbegin(),
-         end = filterAttributeToNewIndexId.cend(); it != end; ++it) {
-        const QString filterAttribute = it.key();
-        m_query->prepare(QLatin1String("SELECT Id From FilterAttributeTable WHERE Name = ?"));
-        m_query->bindValue(0, filterAttribute);
-        if (!m_query->exec() || !m_query->next())
-            return false;
-
-        const int attributeId = m_query->value(0).toInt();
-
-        QVariantList attributeIds;
-        for (int i = 0; i < it.value().count(); i++)
-            attributeIds.append(attributeId);
-
-        m_query->prepare(QLatin1String("INSERT INTO IndexFilterTable VALUES(?, ?)"));
-        m_query->addBindValue(attributeIds);
-        m_query->addBindValue(it.value());
-        if (!m_query->execBatch())
-            return false;
-    }
-
-    QMap<QString, QVariantList> filterAttributeToNewContentsId;
+    QVariantList indexFilterAttributeIds;
+    QVariantList indexFilterIndexIds;
 
     QVariantList contentsNsIds;
     QVariantList contentsData;
-    const int contentsSize = indexTable.contentsItems.size();
-    contentsNsIds.reserve(contentsSize);
-    contentsData.reserve(contentsSize);
-
-    if (!m_query->exec(QLatin1String("SELECT MAX(Id) FROM ContentsTable")) || !m_query->next())
-        return false;
+    QVariantList contentsFilterAttributeIds;
+    QVariantList contentsFilterContentsIds;
 
-    const int maxContentsId = m_query->value(0).toInt();
-
-    int newContentsId = 0;
-    for (const QHelpDBReader::ContentsItem &item : indexTable.contentsItems) {
-        contentsNsIds.append(nsId);
-        contentsData.append(item.data);
+    QVariantList filterNsIds;
+    QVariantList filterAttributeIds;
 
-        for (const QString &filterAttribute : item.filterAttributes) {
-            filterAttributeToNewContentsId[filterAttribute]
-                    .append(maxContentsId + newContentsId + 1);
+    QVariantList timeStampNsIds;
+    QVariantList timeStampFolderIds;
+    QVariantList timeStampFilePaths;
+    QVariantList timeStampSizes;
+    QVariantList timeStampTimeStamps;
+
+    for (const IndexTableData &data : indexTables) {
+        const QHelpDBReader::IndexTable &indexTable = data.indexTable;
+        const int firstFileId = maxFileId + 1;
+
+        for (const QHelpDBReader::FileItem &item : indexTable.fileItems) {
+            fileFolderIds.append(data.vfId);
+            fileNames.append(item.name);
+            fileTitles.append(item.title);
+            if (!appendFilterRows(item.filterAttributes, ++maxFileId,
+                                  &fileFilterAttributeIds, &fileFilterFileIds)) {
+                return false;
+            }
         }
-        ++newContentsId;
-    }
-
-    m_query->prepare(QLatin1String("INSERT INTO ContentsTable VALUES(NULL, ?, ?)"));
-    m_query->addBindValue(contentsNsIds);
-    m_query->addBindValue(contentsData);
-    if (!m_query->execBatch())
-        return false;
-
-    for (auto it = filterAttributeToNewContentsId.cbegin(),
-         end = filterAttributeToNewContentsId.cend(); it != end; ++it) {
-        const QString filterAttribute = it.key();
-        m_query->prepare(QLatin1String("SELECT Id From FilterAttributeTable WHERE Name = ?"));
-        m_query->bindValue(0, filterAttribute);
-        if (!m_query->exec() || !m_query->next())
-            return false;
-
-        const int attributeId = m_query->value(0).toInt();
-
-        QVariantList attributeIds;
-        for (int i = 0; i < it.value().count(); i++)
-            attributeIds.append(attributeId);
 
-        m_query->prepare(QLatin1String("INSERT INTO ContentsFilterTable VALUES(?, ?)"));
-        m_query->addBindValue(attributeIds);
-        m_query->addBindValue(it.value());
-        if (!m_query->execBatch())
-            return false;
-    }
+        for (const QHelpDBReader::IndexItem &item : indexTable.indexItems) {
+            indexNames.append(item.name);
+            indexIdentifiers.append(item.identifier);
+            indexNamespaceIds.append(data.nsId);
+            indexFileIds.append(firstFileId + item.fileId);
+            indexAnchors.append(item.anchor);
+            if (!appendFilterRows(item.filterAttributes, ++maxIndexId,
+                                  &indexFilterAttributeIds, &indexFilterIndexIds)) {
+                return false;
+            }
+        }
 
-    QVariantList filterNsIds;
-    QVariantList filterAttributeIds;
-    for (const QString &filterAttribute : indexTable.usedFilterAttributes) {
-        filterNsIds.append(nsId);
+        for (const QHelpDBReader::ContentsItem &item : indexTable.contentsItems) {
+            contentsNsIds.append(data.nsId);
+            contentsData.append(item.data);
+            if (!appendFilterRows(item.filterAttributes, ++maxContentsId,
+                                  &contentsFilterAttributeIds, &contentsFilterContentsIds)) {
+                return false;
+            }
+        }
 
-        m_query->prepare(QLatin1String("SELECT Id From FilterAttributeTable WHERE Name = ?"));
-        m_query->bindValue(0, filterAttribute);
-        if (!m_query->exec() || !m_query->next())
-            return false;
+        for (const QString &filterAttribute : indexTable.usedFilterAttributes) {
+            const auto it = attributeIds.constFind(filterAttribute);
+            if (it == attributeIds.cend())
+                return false;
+            filterNsIds.append(data.nsId);
+            filterAttributeIds.append(it.value());
+        }
 
-        filterAttributeIds.append(m_query->value(0).toInt());
+        timeStampNsIds.append(data.nsId);
+        timeStampFolderIds.append(data.vfId);
+        timeStampFilePaths.append(data.fileName);
+        const QFileInfo fi(absoluteDocPath(data.fileName));
+        timeStampSizes.append(fi.size());
+        QDateTime lastModified = fi.lastModified();
+        if (qEnvironmentVariableIsSet("SOURCE_DATE_EPOCH")) {
+            const QString sourceDateEpochStr = qEnvironmentVariable("SOURCE_DATE_EPOCH");
+            bool ok;
+            const qlonglong sourceDateEpoch = sourceDateEpochStr.toLongLong(&ok);
+            if (ok && sourceDateEpoch < lastModified.toSecsSinceEpoch())
+                lastModified.setSecsSinceEpoch(sourceDateEpoch);
+        }
+        timeStampTimeStamps.append(lastModified.toString(Qt::ISODate));
     }
 
-    m_query->prepare(QLatin1String("INSERT INTO OptimizedFilterTable "
-                                   "(NamespaceId, FilterAttributeId) VALUES(?, ?)"));
-    m_query->addBindValue(filterNsIds);
-    m_query->addBindValue(filterAttributeIds);
-    if (!m_query->execBatch())
-        return false;
+    const auto insert = [this](const QString &statement, const QList<QVariantList> &columns) {
+        if (columns.constFirst().isEmpty())
+            return true;
+        m_query->prepare(statement);
+        for (const QVariantList &column : columns)
+            m_query->addBindValue(column);
+        return m_query->execBatch();
+    };
 
-    m_query->prepare(QLatin1String("INSERT INTO TimeStampTable "
-                                   "(NamespaceId, FolderId, FilePath, Size, TimeStamp) "
-                                   "VALUES(?, ?, ?, ?, ?)"));
-    m_query->addBindValue(nsId);
-    m_query->addBindValue(vfId);
-    m_query->addBindValue(fileName);
-    const QFileInfo fi(absoluteDocPath(fileName));
-    m_query->addBindValue(fi.size());
-    QDateTime lastModified = fi.lastModified();
-    if (qEnvironmentVariableIsSet("SOURCE_DATE_EPOCH")) {
-        const QString sourceDateEpochStr = qEnvironmentVariable("SOURCE_DATE_EPOCH");
-        bool ok;
-        const qlonglong sourceDateEpoch = sourceDateEpochStr.toLongLong(&ok);
-        if (ok && sourceDateEpoch < lastModified.toSecsSinceEpoch())
-            lastModified.setSecsSinceEpoch(sourceDateEpoch);
-    }
-    m_query->addBindValue(lastModified.toString(Qt::ISODate));
-    if (!m_query->exec())
+    if (!insert(QLatin1String("INSERT INTO FileNameTable VALUES(?, ?, NULL, ?)"),
+                { fileFolderIds, fileNames, fileTitles })
+            || !insert(QLatin1String("INSERT INTO FileFilterTable VALUES(?, ?)"),
+                       { fileFilterAttributeIds, fileFilterFileIds })
+            || !insert(QLatin1String("INSERT INTO IndexTable VALUES(NULL, ?, ?, ?, ?, ?)"),
+                       { indexNames, indexIdentifiers, indexNamespaceIds, indexFileIds,
+                         indexAnchors })
+            || !insert(QLatin1String("INSERT INTO IndexFilterTable VALUES(?, ?)"),
+                       { indexFilterAttributeIds, indexFilterIndexIds })
+            || !insert(QLatin1String("INSERT INTO ContentsTable VALUES(NULL, ?, ?)"),
+                       { contentsNsIds, contentsData })
+            || !insert(QLatin1String("INSERT INTO ContentsFilterTable VALUES(?, ?)"),
+                       { contentsFilterAttributeIds, contentsFilterContentsIds })
+            || !insert(QLatin1String("INSERT INTO OptimizedFilterTable "
+                                     "(NamespaceId, FilterAttributeId) VALUES(?, ?)"),
+                       { filterNsIds, filterAttributeIds })
+            || !insert(QLatin1String("INSERT INTO TimeStampTable "
+                                     "(NamespaceId, FolderId, FilePath, Size, TimeStamp) "
+                                     "VALUES(?, ?, ?, ?, ?)"),
+                       { timeStampNsIds, timeStampFolderIds, timeStampFilePaths,
+                         timeStampSizes, timeStampTimeStamps })) {
         return false;
+    }
 
     transaction.commit();
     return true;
@@ -2180,6 +2403,7 @@ bool QHelpCollectionHandler::registerIndexTable(const QHelpDBReader::IndexTable
 
 bool QHelpCollectionHandler::unregisterIndexTable(int nsId, int vfId)
 {
+    m_identifierLinks.reset();
     m_query->prepare(QLatin1String("DELETE FROM IndexFilterTable WHERE IndexId IN "
                                        "(SELECT Id FROM IndexTable WHERE NamespaceId = ?)"));
     m_query->bindValue(0, nsId);
@@ -2349,21 +2573,21 @@ QList<QHelpLink> QHelpCollectionHandler::documentsForField(
                                  QLatin1String("IndexFilterTable"),
                                  QLatin1String("IndexId"));
 
-    m_query->prepare(filterQuery);
-    m_query->bindValue(0, fieldValue);
-    bindFilterQuery(m_query, 1, filterAttributes);
+    const PreparedQuery query = preparedQuery(filterQuery);
+    query->bindValue(0, fieldValue);
+    bindFilterQuery(query.get(), 1, filterAttributes);
 
-    m_query->exec();
+    query->exec();
 
-    while (m_query->next()) {
-        QString title = m_query->value(0).toString();
+    while (query->next()) {
+        QString title = query->value(0).toString();
         if (title.isEmpty()) // generate a title + corresponding path
-            title = fieldValue + QLatin1String(" : ") + m_query->value(3).toString();
+            title = fieldValue + QLatin1String(" : ") + query->value(3).toString();
 
-        const QUrl url = buildQUrl(m_query->value(1).toString(),
-                                   m_query->value(2).toString(),
-                                   m_query->value(3).toString(),
-                                   m_query->value(4).toString());
+        const QUrl url = buildQUrl(query->value(1).toString(),
+                                   query->value(2).toString(),
+                                   query->value(3).toString(),
+                                   query->value(4).toString());
         docList.append(QHelpLink {url, title});
     }
     return docList;
@@ -2387,7 +2611,28 @@ QList<QHelpLink> QHelpCollectionHandler::documentsForIdentifier(
         const QString &id,
         const QString &filterName) const
 {
-    return documentsForField(QLatin1String("Identifier"), id, filterName);
+    QList<QHelpLink> docList;
+
+    if (!isDBOpened() || id.isEmpty())
+        return docList;
+
+    const IdentifierLinks &table = identifierLinks(filterName);
+    const auto it = table.links.constFind(id);
+    if (it == table.links.cend())
+        return docList;
+
+    docList.reserve(it->size());
+    for (const auto &link : *it) {
+        const IdentifierLinks::Document &document = table.documents.at(link.first);
+        QString title = document.title;
+        if (title.isEmpty()) // generate a title + corresponding path
+            title = id + QLatin1String(" : ") + document.fileName;
+
+        const QUrl url = buildQUrl(document.namespaceName, document.folderName,
+                                   document.fileName, link.second);
+        docList.append(QHelpLink {url, title});
+    }
+    return docList;
 }
 
 QList<QHelpLink> QHelpCollectionHandler::documentsForKeyword(
@@ -2438,24 +2683,23 @@ QList<QHelpLink> QHelpCollectionHandler::documentsForField(
                 "AND IndexTable.%1 = ?").arg(fieldName);
 
     const QString filterQuery = filterlessQuery
-            + prepareFilterQuery(filterName)
+            + filterNamespacesQuery(filterName)
             + QLatin1String(" ORDER BY LOWER(FileNameTable.Title), FileNameTable.Title");
 
-    m_query->prepare(filterQuery);
-    m_query->bindValue(0, fieldValue);
-    bindFilterQuery(m_query, 1, filterName);
+    const PreparedQuery query = preparedQuery(filterQuery);
+    query->bindValue(0, fieldValue);
 
-    m_query->exec();
+    query->exec();
 
-    while (m_query->next()) {
-        QString title = m_query->value(0).toString();
+    while (query->next()) {
+        QString title = query->value(0).toString();
         if (title.isEmpty()) // generate a title + corresponding path
-            title = fieldValue + QLatin1String(" : ") + m_query->value(3).toString();
+            title = fieldValue + QLatin1String(" : ") + query->value(3).toString();
 
-        const QUrl url = buildQUrl(m_query->value(1).toString(),
-                                   m_query->value(2).toString(),
-                                   m_query->value(3).toString(),
-                                   m_query->value(4).toString());
+        const QUrl url = buildQUrl(query->value(1).toString(),
+                                   query->value(2).toString(),
+                                   query->value(3).toString(),
+                                   query->value(4).toString());
         docList.append(QHelpLink {url, title});
     }
     return docList;
@@ -2463,30 +2707,124 @@ QList<QHelpLink> QHelpCollectionHandler::documentsForField(
 
 QStringList QHelpCollectionHandler::namespacesForFilter(const QString &filterName) const
 {
-    QStringList namespaceList;
-
     if (!isDBOpened())
-        return namespaceList;
+        return QStringList();
 
-    const QString filterlessQuery = QString::fromLatin1(
+    return filterNamespaces(filterName).names;
+}
+
+/*
+    Returns the namespaces that \a filterName lets through. They are looked
+    up with the component and version filter joins the first time and kept
+    until a filter or the registered documentation changes, so that
+    switching between filters does not run the joins in every query.
+*/
+const QHelpCollectionHandler::FilterNamespaces &QHelpCollectionHandler::filterNamespaces(
+        const QString &filterName) const
+{
+    auto it = m_filterNamespaces.find(filterName);
+    if (it != m_filterNamespaces.end())
+        return it.value();
+
+    FilterNamespaces filterNamespaces;
+    const QString filterQuery = QLatin1String(
                 "SELECT "
+                    "NamespaceTable.Id, "
                     "NamespaceTable.Name "
                 "FROM "
                     "NamespaceTable "
-                "WHERE TRUE");
-
-    const QString filterQuery = filterlessQuery
+                "WHERE TRUE")
             + prepareFilterQuery(filterName);
 
-    m_query->prepare(filterQuery);
-    bindFilterQuery(m_query, 0, filterName);
+    // Callers may still be stepping through the results of m_query.
+    QSqlQuery query(QSqlDatabase::database(m_connectionName));
+    query.setForwardOnly(true);
+    query.prepare(filterQuery);
+    bindFilterQuery(&query, 0, filterName);
+    if (query.exec()) {
+        while (query.next()) {
+            filterNamespaces.ids.append(QString::number(query.value(0).toInt()));
+            filterNamespaces.names.append(query.value(1).toString());
+        }
+    }
 
-    m_query->exec();
+    return m_filterNamespaces.insert(filterName, filterNamespaces).value();
+}
 
-    while (m_query->next())
-        namespaceList.append(m_query->value(0).toString());
+/*
+    Returns the links of all identifiers that \a filterName lets through.
+    Context help looks up one identifier after the other, so they are read
+    in one query the first time and kept in memory until the filter or the
+    registered documentation changes. The links are ordered like the
+    results of documentsForField().
+*/
+const QHelpCollectionHandler::IdentifierLinks &QHelpCollectionHandler::identifierLinks(
+        const QString &filterName) const
+{
+    if (m_identifierLinks && m_identifierLinksFilter == filterName)
+        return *m_identifierLinks;
+
+    auto result = std::make_unique<IdentifierLinks>();
+    const QString linksQuery = QLatin1String(
+                "SELECT "
+                    "FileNameTable.FileId, "
+                    "FileNameTable.Title, "
+                    "NamespaceTable.Name, "
+                    "FolderTable.Name, "
+                    "FileNameTable.Name, "
+                    "IndexTable.Identifier, "
+                    "IndexTable.Anchor "
+                "FROM "
+                    "IndexTable, "
+                    "FileNameTable, "
+                    "FolderTable, "
+                    "NamespaceTable "
+                "WHERE IndexTable.FileId = FileNameTable.FileId "
+                "AND FileNameTable.FolderId = FolderTable.Id "
+                "AND IndexTable.NamespaceId = NamespaceTable.Id "
+                "AND IndexTable.Identifier != ''")
+            + filterNamespacesQuery(filterName)
+            + QLatin1String(" ORDER BY LOWER(FileNameTable.Title), FileNameTable.Title");
+
+    QSqlQuery query(QSqlDatabase::database(m_connectionName));
+    query.setForwardOnly(true);
+    if (query.exec(linksQuery)) {
+        QHash<int, qsizetype> documentIndexes;
+        while (query.next()) {
+            const int fileId = query.value(0).toInt();
+            auto it = documentIndexes.constFind(fileId);
+            if (it == documentIndexes.cend()) {
+                it = documentIndexes.insert(fileId, result->documents.size());
+                result->documents.append(IdentifierLinks::Document {
+                                             query.value(1).toString(),
+                                             query.value(2).toString(),
+                                             query.value(3).toString(),
+                                             query.value(4).toString() });
+            }
+            result->links[query.value(5).toString()].emplaceBack(
+                        *it, query.value(6).toString());
+        }
+    }
+
+    m_identifierLinksFilter = filterName;
+    m_identifierLinks = std::move(result);
+    return *m_identifierLinks;
+}
+
+/*
+    Returns the condition that restricts a query on NamespaceTable to the
+    namespaces of \a filterName.
+*/
+QString QHelpCollectionHandler::filterNamespacesQuery(const QString &filterName) const
+{
+    if (filterName.isEmpty())
+        return QString();
 
-    return namespaceList;
+    const FilterNamespaces &namespaces = filterNamespaces(filterName);
+    if (namespaces.ids.isEmpty())
+        return QLatin1String(" AND FALSE");
+    return QLatin1String(" AND NamespaceTable.Id IN (")
+            + namespaces.ids.join(QLatin1Char(',')) + QLatin1Char(')');
 }
 
 void QHelpCollectionHandler::setReadOnly(bool readOnly)
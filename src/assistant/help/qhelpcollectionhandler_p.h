@@ -15,6 +15,7 @@
 // We mean it.
 //
 
+#include <QtCore/QHash>
 #include <QtCore/QList>
 #include <QtCore/QString>
 #include <QtCore/QObject>
@@ -23,6 +24,9 @@
 
 #include <QtSql/QSqlQuery>
 
+#include <memory>
+#include <utility>
+
 #include "qhelpdbreader_p.h"
 #include "qhelplink.h"
 
@@ -140,6 +144,7 @@ public:
     FileInfo registeredDocumentation(const QString &namespaceName) const;
     FileInfoList registeredDocumentations() const;
     bool registerDocumentation(const QString &fileName);
+    bool registerDocumentations(const QStringList &fileNames);
     bool unregisterDocumentation(const QString &namespaceName);
 
 
@@ -157,6 +162,8 @@ public:
     QStringList indicesForFilter(const QString &filterName) const;
     QList<ContentsData> contentsForFilter(const QString &filterName) const;
 
+    QByteArray registeredDocumentationHash() const;
+
     bool removeCustomValue(const QString &key);
     QVariant customValue(const QString &key, const QVariant &defaultValue) const;
     bool setCustomValue(const QString &key, const QVariant &value);
@@ -184,6 +191,50 @@ signals:
     void error(const QString &msg) const;
 
 private:
+    // Finishes a query prepared by preparedQuery() once it is no longer used
+    class PreparedQuery
+    {
+    public:
+        explicit PreparedQuery(QSqlQuery *query) : m_query(query) {}
+        ~PreparedQuery() { m_query->finish(); }
+        QSqlQuery *get() const { return m_query; }
+        QSqlQuery *operator->() const { return m_query; }
+
+    private:
+        Q_DISABLE_COPY_MOVE(PreparedQuery)
+        QSqlQuery *m_query;
+    };
+
+    // The namespaces that a filter lets through, the ids as SQL literals
+    struct FilterNamespaces
+    {
+        QStringList ids;
+        QStringList names;
+    };
+
+    // The links of the identifiers that a filter lets through
+    struct IdentifierLinks
+    {
+        struct Document
+        {
+            QString title;
+            QString namespaceName;
+            QString folderName;
+            QString fileName;
+        };
+        QList<Document> documents;
+        // Index into documents and anchor of each link
+        QHash<QString, QList<std::pair<qsizetype, QString>>> links;
+    };
+
+    struct IndexTableData
+    {
+        QHelpDBReader::IndexTable indexTable;
+        int nsId = -1;
+        int vfId = -1;
+        QString fileName;
+    };
+
     // legacy stuff
     QMultiMap<QString, QUrl> linksForField(const QString &fieldName,
                                            const QString &fieldValue,
@@ -199,8 +250,15 @@ private:
                                        const QString &fieldValue,
                                        const QString &filterName) const;
 
+    PreparedQuery preparedQuery(const QString &statement) const;
+    const FilterNamespaces &filterNamespaces(const QString &filterName) const;
+    const IdentifierLinks &identifierLinks(const QString &filterName) const;
+    QString filterNamespacesQuery(const QString &filterName) const;
+    QHelpDBReader *documentationReader(const QString &fileName) const;
+    void clearDocumentationReaders() const;
     bool isDBOpened() const;
     bool createTables(QSqlQuery *query);
+    bool createIndexes(QSqlQuery *query);
     void closeDB();
     bool recreateIndexAndNamespaceFilterTables(QSqlQuery *query);
     bool registerIndexAndNamespaceFilterTables(const QString &nameSpace,
@@ -210,6 +268,7 @@ private:
     bool registerFileAttributeSets(const QList<QStringList> &attributeSets, int nsId);
     bool registerIndexTable(const QHelpDBReader::IndexTable &indexTable,
                             int nsId, int vfId, const QString &fileName);
+    bool registerIndexTables(const QList<IndexTableData> &indexTables);
     bool unregisterIndexTable(int nsId, int vfId);
     QString absoluteDocPath(const QString &fileName) const;
     bool isTimeStampCorrect(const TimeStamp &timeStamp) const;
@@ -220,6 +279,11 @@ private:
     QString m_collectionFile;
     QString m_connectionName;
     QSqlQuery *m_query = nullptr;
+    mutable QHash<QString, QSqlQuery *> m_preparedQueries;
+    mutable QHash<QString, QHelpDBReader *> m_documentationReaders;
+    mutable QHash<QString, FilterNamespaces> m_filterNamespaces;
+    mutable QString m_identifierLinksFilter;
+    mutable std::unique_ptr<IdentifierLinks> m_identifierLinks;
     bool m_vacuumScheduled = false;
     bool m_readOnly = true;
 };
@@ -7,13 +7,32 @@
 #include "qhelpcollectionhandler_p.h"
 
 #include <QDir>
-#include <QtCore/QStack>
 #include <QtCore/QThread>
 #include <QtCore/QMutex>
 #include <QtWidgets/QHeaderView>
 
+#include <memory>
+#include <vector>
+
 QT_BEGIN_NAMESPACE
 
+/*
+    The contents of one contents section of a namespace, as it is stored in
+    the collection, with the tree structure of its entries. The items of
+    the entries are only created when the view asks for them.
+*/
+struct QHelpContentTree
+{
+    QString namespaceName;
+    QString folderName;
+    QByteArray contents;
+    // The position of each entry in contents
+    std::vector<qint64> offsets;
+    std::vector<int> firstChild;
+    std::vector<int> nextSibling;
+    std::vector<int> topLevelEntries;
+};
+
 class QHelpContentItemPrivate
 {
 public:
@@ -24,12 +43,24 @@ public:
     {
     }
 
-    void appendChild(QHelpContentItem *item) { childItems.append(item); }
+    void appendChild(QHelpContentItem *item)
+    {
+        item->d->row = childItems.size();
+        childItems.append(item);
+    }
+    void loadChildren(QHelpContentItem *q);
+    static QHelpContentItem *createItem(const std::shared_ptr<const QHelpContentTree> &tree,
+                                        int entry, QHelpContentItem *parent);
 
     QList<QHelpContentItem*> childItems;
     QHelpContentItem *parent;
     QString title;
     QUrl link;
+    qsizetype row = 0;
+    // The tree and the entry of this item, as long as its children have
+    // not been created
+    std::shared_ptr<const QHelpContentTree> tree;
+    int entry = -1;
 };
 
 class QHelpContentProvider : public QThread
@@ -92,6 +123,7 @@ QHelpContentItem::~QHelpContentItem()
 */
 QHelpContentItem *QHelpContentItem::child(int row) const
 {
+    d->loadChildren(const_cast<QHelpContentItem *>(this));
     return d->childItems.value(row);
 }
 
@@ -100,6 +132,7 @@ QHelpContentItem *QHelpContentItem::child(int row) const
 */
 int QHelpContentItem::childCount() const
 {
+    d->loadChildren(const_cast<QHelpContentItem *>(this));
     return d->childItems.count();
 }
 
@@ -108,9 +141,7 @@ int QHelpContentItem::childCount() const
 */
 int QHelpContentItem::row() const
 {
-    if (d->parent)
-        return d->parent->d->childItems.indexOf(const_cast<QHelpContentItem*>(this));
-    return 0;
+    return d->parent ? int(d->row) : 0;
 }
 
 /*!
@@ -142,7 +173,7 @@ QHelpContentItem *QHelpContentItem::parent() const
 */
 int QHelpContentItem::childPosition(QHelpContentItem *child) const
 {
-    return d->childItems.indexOf(child);
+    return child && child->d->parent == this ? int(child->d->row) : -1;
 }
 
 
@@ -219,6 +250,114 @@ static QUrl constructUrl(const QString &namespaceName,
     return buildQUrl(namespaceName, folderName, rp, anchor);
 }
 
+// Skips a string in the stream, returns false if it is empty.
+static bool skipString(QDataStream &s)
+{
+    quint32 size = 0;
+    s >> size;
+    if (size == 0xffffffff || size == 0)
+        return false;
+    return s.skipRawData(int(size)) == int(size);
+}
+
+/*
+    Finds the entries of \a tree and where each of them belongs, without
+    decoding their titles and links.
+*/
+static void buildContentTree(QHelpContentTree *tree)
+{
+    const QByteArray &contents = tree->contents;
+    QDataStream s(contents);
+    int depth = 0;
+    int _depth = 0;
+    bool _root = false;
+    int item = -1;
+    std::vector<int> stack;
+    std::vector<int> lastChild;
+
+    const auto appendEntry = [&](int parent, qint64 offset) {
+        const int entry = int(tree->offsets.size());
+        tree->offsets.push_back(offset);
+        tree->firstChild.push_back(-1);
+        tree->nextSibling.push_back(-1);
+        lastChild.push_back(-1);
+        if (parent < 0) {
+            tree->topLevelEntries.push_back(entry);
+        } else {
+            if (lastChild[parent] < 0)
+                tree->firstChild[parent] = entry;
+            else
+                tree->nextSibling[lastChild[parent]] = entry;
+            lastChild[parent] = entry;
+        }
+        return entry;
+    };
+
+    for (;;) {
+        const qint64 offset = s.device()->pos();
+        s >> depth;
+        skipString(s);
+        if (!skipString(s) || s.status() != QDataStream::Ok)
+            break;
+        // The same nesting as the one the items were built with eagerly
+        for (;;) {
+            if (depth == 0) {
+                item = appendEntry(-1, offset);
+                stack.push_back(item);
+                _depth = 1;
+                _root = true;
+                break;
+            }
+            if (depth > _depth && _root) {
+                _depth = depth;
+                stack.push_back(item);
+            }
+            if (depth == _depth) {
+                if (!stack.empty())
+                    item = appendEntry(stack.back(), offset);
+                break;
+            }
+            if (depth > _depth || stack.empty())
+                break;
+            stack.pop_back();
+            --_depth;
+        }
+    }
+}
+
+QHelpContentItem *QHelpContentItemPrivate::createItem(
+        const std::shared_ptr<const QHelpContentTree> &tree, int entry, QHelpContentItem *parent)
+{
+    const QByteArray &contents = tree->contents;
+    const qint64 offset = tree->offsets[entry];
+    QDataStream s(QByteArray::fromRawData(contents.constData() + offset,
+                                          contents.size() - offset));
+    int depth = 0;
+    QString link;
+    QString title;
+    s >> depth >> link >> title;
+    QHelpContentItem *item = new QHelpContentItem(title, constructUrl(tree->namespaceName,
+                                                                      tree->folderName, link),
+                                                  parent);
+    if (tree->firstChild[entry] >= 0) {
+        item->d->tree = tree;
+        item->d->entry = entry;
+    }
+    return item;
+}
+
+void QHelpContentItemPrivate::loadChildren(QHelpContentItem *q)
+{
+    if (!tree)
+        return;
+
+    const std::shared_ptr<const QHelpContentTree> contentTree = std::move(tree);
+    for (int child = contentTree->firstChild[entry]; child >= 0;
+         child = contentTree->nextSibling[child]) {
+        appendChild(createItem(contentTree, child, q));
+    }
+}
+
 void QHelpContentProvider::run()
 {
     m_mutex.lock();
@@ -237,10 +376,6 @@ void QHelpContentProvider::run()
     if (!collectionHandler.openCollectionFile())
         return;
 
-    QString title;
-    QString link;
-    int depth = 0;
-    QHelpContentItem *item = nullptr;
     QHelpContentItem * const rootItem = new QHelpContentItem(QString(), QString(), nullptr);
 
     const QList<QHelpCollectionHandler::ContentsData> result = usesFilterEngine
@@ -257,48 +392,22 @@ void QHelpContentProvider::run()
         }
         m_mutex.unlock();
 
-        const QString namespaceName = contentsData.namespaceName;
-        const QString folderName = contentsData.folderName;
         for (const QByteArray &contents : contentsData.contentsList)  {
             if (contents.size() < 1)
                 continue;
 
-            int _depth = 0;
-            bool _root = false;
-            QStack<QHelpContentItem*> stack;
-
-            QDataStream s(contents);
-            for (;;) {
-                s >> depth;
-                s >> link;
-                s >> title;
-                if (title.isEmpty())
-                    break;
-                const QUrl url = constructUrl(namespaceName, folderName, link);
-CHECK_DEPTH:
-                if (depth == 0) {
-                    m_mutex.lock();
-                    item = new QHelpContentItem(title, url, rootItem);
-                    rootItem->d->appendChild(item);
-                    m_mutex.unlock();
-                    stack.push(item);
-                    _depth = 1;
-                    _root = true;
-                } else {
-                    if (depth > _depth && _root) {
-                        _depth = depth;
-                        stack.push(item);
-                    }
-                    if (depth == _depth) {
-                        item = new QHelpContentItem(title, url, stack.top());
-                        stack.top()->d->appendChild(item);
-                    } else if (depth < _depth) {
-                        stack.pop();
-                        --_depth;
-                        goto CHECK_DEPTH;
-                    }
-                }
-            }
+            auto tree = std::make_shared<QHelpContentTree>();
+            tree->namespaceName = contentsData.namespaceName;
+            tree->folderName = contentsData.folderName;
+            tree->contents = contents;
+            buildContentTree(tree.get());
+
+            // Only the top level items are created here, the others once
+            // their parents are expanded.
+            const std::shared_ptr<const QHelpContentTree> contentTree = std::move(tree);
+            for (int entry : contentTree->topLevelEntries)
+                rootItem->d->appendChild(QHelpContentItemPrivate::createItem(contentTree, entry,
+                                                                             rootItem));
         }
     }
 
@@ -38,6 +38,7 @@ private:
 
     QHelpContentItemPrivate *d;
     friend class QHelpContentProvider;
+    friend class QHelpContentItemPrivate;
 };
 
 class QHELP_EXPORT QHelpContentModel : public QAbstractItemModel
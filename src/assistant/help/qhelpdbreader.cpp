@@ -53,9 +53,27 @@ bool QHelpDBReader::init()
     m_initDone = true;
     m_query = new QSqlQuery(QSqlDatabase::database(m_uniqueId));
 
+    m_query->exec(QLatin1String("PRAGMA table_info(FileDataTable)"));
+    while (m_query->next()) {
+        if (m_query->value(1).toString() == QLatin1String("Compression"))
+            m_hasCompressionColumn = true;
+    }
+
     return true;
 }
 
+QByteArray QHelpDBReader::uncompressedData(const QByteArray &data, int compression)
+{
+    return compression == NoCompression ? data : qUncompress(data);
+}
+
+// The column that tells how the file data is stored
+QString QHelpDBReader::compressionColumn() const
+{
+    return m_hasCompressionColumn ? QLatin1String("FileDataTable.Compression")
+                                  : QString::number(ZlibCompression);
+}
+
 bool QHelpDBReader::initDB()
 {
     QSqlDatabase db = QSqlDatabase::addDatabase(QLatin1String("QSQLITE"), m_uniqueId);
@@ -387,7 +405,8 @@ QByteArray QHelpDBReader::fileData(const QString &virtualFolder,
     namespaceName();
     m_query->prepare(QLatin1String(
                     "SELECT "
-                        "FileDataTable.Data "
+                        "FileDataTable.Data, "
+                        "%1 "
                     "FROM "
                         "FileDataTable, "
                         "FileNameTable, "
@@ -398,14 +417,14 @@ QByteArray QHelpDBReader::fileData(const QString &virtualFolder,
                     "AND FileNameTable.FolderId = FolderTable.Id "
                     "AND FolderTable.Name = ? "
                     "AND FolderTable.NamespaceId = NamespaceTable.Id "
-                    "AND NamespaceTable.Name = ?"));
+                    "AND NamespaceTable.Name = ?").arg(compressionColumn()));
     m_query->bindValue(0, filePath);
     m_query->bindValue(1, QString(QLatin1String("./") + filePath));
     m_query->bindValue(2, virtualFolder);
     m_query->bindValue(3, m_namespace);
     m_query->exec();
     if (m_query->next() && m_query->isValid())
-        ba = qUncompress(m_query->value(0).toByteArray());
+        ba = uncompressedData(m_query->value(0).toByteArray(), m_query->value(1).toInt());
     return ba;
 }
 
@@ -446,30 +465,33 @@ QStringList QHelpDBReader::filterAttributes(const QString &filterName) const
     return lst;
 }
 
-QMultiMap<QString, QByteArray> QHelpDBReader::filesData(const QStringList &filterAttributes,
-                                                        const QString &extensionFilter) const
+QString QHelpDBReader::filesDataQuery(const QStringList &filterAttributes,
+                                      const QStringList &extensionFilters) const
 {
-    QMultiMap<QString, QByteArray> result;
-    if (!m_query)
-        return result;
-
     QString query;
     QString extension;
-    if (!extensionFilter.isEmpty())
-        extension = QString(QLatin1String("AND FileNameTable.Name "
-                                          "LIKE \'%.%1\'")).arg(extensionFilter);
+    if (!extensionFilters.isEmpty()) {
+        QStringList conditions;
+        for (const QString &extensionFilter : extensionFilters) {
+            conditions.append(QString(QLatin1String("FileNameTable.Name LIKE \'%.%1\'"))
+                              .arg(quote(extensionFilter)));
+        }
+        extension = QLatin1String("AND (") + conditions.join(QLatin1String(" OR "))
+                + QLatin1Char(')');
+    }
 
     if (filterAttributes.isEmpty()) {
         query = QString(QLatin1String("SELECT "
                                           "FileNameTable.Name, "
-                                          "FileDataTable.Data "
+                                          "FileDataTable.Data, "
+                                          "%2 "
                                       "FROM "
                                           "FolderTable, "
                                           "FileNameTable, "
                                           "FileDataTable "
                                       "WHERE FileDataTable.Id = FileNameTable.FileId "
                                       "AND FileNameTable.FolderId = FolderTable.Id %1"))
-            .arg(extension);
+            .arg(extension, compressionColumn());
     } else {
         for (int i = 0; i < filterAttributes.count(); ++i) {
             if (i > 0)
@@ -477,7 +499,8 @@ QMultiMap<QString, QByteArray> QHelpDBReader::filesData(const QStringList &filte
             query.append(QString(QLatin1String(
                                      "SELECT "
                                          "FileNameTable.Name, "
-                                         "FileDataTable.Data "
+                                         "FileDataTable.Data, "
+                                         "%3 "
                                      "FROM "
                                          "FolderTable, "
                                          "FileNameTable, "
@@ -489,17 +512,77 @@ QMultiMap<QString, QByteArray> QHelpDBReader::filesData(const QStringList &filte
                                      "AND FileNameTable.FileId = FileFilterTable.FileId "
                                      "AND FileFilterTable.FilterAttributeId = FilterAttributeTable.Id "
                                      "AND FilterAttributeTable.Name = \'%1\' %2"))
-                         .arg(quote(filterAttributes.at(i)))
-                         .arg(extension));
+                         .arg(quote(filterAttributes.at(i)), extension,
+                              compressionColumn()));
         }
     }
-    m_query->exec(query);
-    while (m_query->next())
-        result.insert(m_query->value(0).toString(), qUncompress(m_query->value(1).toByteArray()));
+    return query;
+}
+
+QMultiMap<QString, QByteArray> QHelpDBReader::filesData(const QStringList &filterAttributes,
+                                                        const QString &extensionFilter) const
+{
+    QMultiMap<QString, QByteArray> result;
+    FileDataIterator it = filesDataIterator(filterAttributes,
+                                            extensionFilter.isEmpty()
+                                            ? QStringList() : QStringList(extensionFilter));
+    while (it.next())
+        result.insert(it.name(), it.data());
 
     return result;
 }
 
+/*
+    Returns an iterator over the files that have all of the \a filterAttributes
+    and one of the \a extensionFilters, which reads the files one row at a time
+    and only decompresses the data that is asked for.
+
+    The iterator uses a query of its own, so it must not outlive the reader.
+*/
+QHelpDBReader::FileDataIterator QHelpDBReader::filesDataIterator(
+        const QStringList &filterAttributes, const QStringList &extensionFilters) const
+{
+    FileDataIterator it;
+    if (!m_query)
+        return it;
+
+    it.m_query.reset(new QSqlQuery(QSqlDatabase::database(m_uniqueId)));
+    // Rows are not kept once the iterator moved past them.
+    it.m_query->setForwardOnly(true);
+    it.m_query->exec(filesDataQuery(filterAttributes, extensionFilters));
+    return it;
+}
+
+QHelpDBReader::FileDataIterator::FileDataIterator() = default;
+QHelpDBReader::FileDataIterator::FileDataIterator(FileDataIterator &&other) noexcept = default;
+QHelpDBReader::FileDataIterator::~FileDataIterator() = default;
+
+bool QHelpDBReader::FileDataIterator::next()
+{
+    return m_query && m_query->next();
+}
+
+QString QHelpDBReader::FileDataIterator::name() const
+{
+    return m_query->value(0).toString();
+}
+
+QByteArray QHelpDBReader::FileDataIterator::data() const
+{
+    return uncompressedData(compressedData(), compression());
+}
+
+// The data as it is stored, which is only compressed if compression() says so
+QByteArray QHelpDBReader::FileDataIterator::compressedData() const
+{
+    return m_query->value(1).toByteArray();
+}
+
+int QHelpDBReader::FileDataIterator::compression() const
+{
+    return m_query->value(2).toInt();
+}
+
 QVariant QHelpDBReader::metaData(const QString &name) const
 {
     QVariant v;
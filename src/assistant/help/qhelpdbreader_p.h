@@ -21,6 +21,8 @@
 #include <QtCore/QByteArray>
 #include <QtCore/QSet>
 
+#include <memory>
+
 QT_BEGIN_NAMESPACE
 
 class QSqlQuery;
@@ -30,6 +32,13 @@ class QHelpDBReader : public QObject
     Q_OBJECT
 
 public:
+    // How the data in FileDataTable is stored, in its Compression column.
+    // Files without that column only have zlib compressed data.
+    enum FileCompression {
+        ZlibCompression = 0,
+        NoCompression = 1
+    };
+
     class IndexItem
     {
     public:
@@ -67,6 +76,24 @@ public:
         QStringList usedFilterAttributes;
     };
 
+    class FileDataIterator
+    {
+    public:
+        FileDataIterator();
+        FileDataIterator(FileDataIterator &&other) noexcept;
+        ~FileDataIterator();
+
+        bool next();
+        QString name() const;
+        QByteArray data() const;
+        QByteArray compressedData() const;
+        int compression() const;
+
+    private:
+        friend class QHelpDBReader;
+        std::unique_ptr<QSqlQuery> m_query;
+    };
+
     QHelpDBReader(const QString &dbName);
     QHelpDBReader(const QString &dbName, const QString &uniqueId,
         QObject *parent);
@@ -81,6 +108,8 @@ public:
     QList<QStringList> filterAttributeSets() const;
     QMultiMap<QString, QByteArray> filesData(const QStringList &filterAttributes,
                                              const QString &extensionFilter = QString()) const;
+    FileDataIterator filesDataIterator(const QStringList &filterAttributes,
+                                       const QStringList &extensionFilters) const;
     QByteArray fileData(const QString &virtualFolder,
         const QString &filePath) const;
 
@@ -90,11 +119,16 @@ public:
     QVariant metaData(const QString &name) const;
 
 private:
+    static QByteArray uncompressedData(const QByteArray &data, int compression);
+    QString compressionColumn() const;
     QString quote(const QString &string) const;
+    QString filesDataQuery(const QStringList &filterAttributes,
+                           const QStringList &extensionFilters) const;
     bool initDB();
     QString qtVersionHeuristic() const;
 
     bool m_initDone = false;
+    bool m_hasCompressionColumn = false;
     QString m_dbName;
     QString m_uniqueId;
     QString m_error;
@@ -15,10 +15,13 @@
 // We mean it.
 //
 
+#include <QtCore/QCache>
 #include <QtCore/QHash>
 #include <QtCore/QMap>
+#include <QtCore/QMutex>
 #include <QtCore/QStringList>
 #include <QtCore/QObject>
+#include <QtCore/QUrl>
 
 QT_BEGIN_NAMESPACE
 
@@ -45,6 +48,8 @@ public:
         QHelpEngineCore *helpEngineCore);
 
     bool setup();
+    QByteArray fileData(const QUrl &url);
+    void clearFileDataCache();
 
     QHelpCollectionHandler *collectionHandler = nullptr;
     QHelpFilterEngine *filterEngine = nullptr;
@@ -55,6 +60,10 @@ public:
     bool usesFilterEngine = false;
     bool readOnly = true;
 
+    // The uncompressed data of the files read last, the cost is their size
+    QCache<QUrl, QByteArray> fileDataCache { 32 * 1024 * 1024 };
+    QMutex fileDataCacheMutex;
+
 protected:
     QHelpEngineCore *q;
 
@@ -41,6 +41,7 @@ bool QHelpEngineCorePrivate::setup()
         return true;
 
     needsSetup = false;
+    clearFileDataCache();
     emit q->setupStarted();
 
     const QVariant readOnlyVariant = q->property("_q_readonly");
@@ -56,6 +57,33 @@ bool QHelpEngineCorePrivate::setup()
     return opened;
 }
 
+/*
+    Returns the data of the file at \a url, from the cache if it was read
+    recently. Style sheets, images and scripts are shared by many pages,
+    this way they are not read and uncompressed again for each of them.
+*/
+QByteArray QHelpEngineCorePrivate::fileData(const QUrl &url)
+{
+    {
+        QMutexLocker locker(&fileDataCacheMutex);
+        if (const QByteArray *data = fileDataCache.object(url))
+            return *data;
+    }
+
+    const QByteArray data = collectionHandler->fileData(url);
+    if (!data.isEmpty()) {
+        QMutexLocker locker(&fileDataCacheMutex);
+        fileDataCache.insert(url, new QByteArray(data), qMax(data.size(), qsizetype(1)));
+    }
+    return data;
+}
+
+void QHelpEngineCorePrivate::clearFileDataCache()
+{
+    QMutexLocker locker(&fileDataCacheMutex);
+    fileDataCache.clear();
+}
+
 void QHelpEngineCorePrivate::errorReceived(const QString &msg)
 {
     error = msg;
@@ -309,6 +337,26 @@ bool QHelpEngineCore::registerDocumentation(const QString &documentationFileName
     return d->collectionHandler->registerDocumentation(documentationFileName);
 }
 
+/*!
+    \since 6.5
+
+    Registers all the Qt compressed help files (.qch) in
+    \a documentationFileNames at once. This is faster than registering
+    them one by one with registerDocumentation(): the files are read in
+    parallel and the collection is updated in a single transaction.
+    If one of the files cannot be registered, none of them is.
+    True is returned if the registration was successful, otherwise
+    false.
+
+    \sa registerDocumentation(), error()
+*/
+bool QHelpEngineCore::registerDocumentations(const QStringList &documentationFileNames)
+{
+    d->error.clear();
+    d->needsSetup = true;
+    return d->collectionHandler->registerDocumentations(documentationFileNames);
+}
+
 /*!
     Unregisters the Qt compressed help file (.qch) identified by its
     \a namespaceName from the help collection. Returns true
@@ -602,7 +650,7 @@ QByteArray QHelpEngineCore::fileData(const QUrl &url) const
     if (!d->setup())
         return QByteArray();
 
-    return d->collectionHandler->fileData(url);
+    return d->fileData(url);
 }
 
 /*!
@@ -45,6 +45,7 @@ public:
 
     static QString namespaceName(const QString &documentationFileName);
     bool registerDocumentation(const QString &documentationFileName);
+    bool registerDocumentations(const QStringList &documentationFileNames);
     bool unregisterDocumentation(const QString &namespaceName);
     QString documentationFileName(const QString &namespaceName);
     QStringList registeredDocumentations() const;
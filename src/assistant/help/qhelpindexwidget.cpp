@@ -6,17 +6,130 @@
 #include "qhelpengine_p.h"
 #include "qhelpdbreader_p.h"
 #include "qhelpcollectionhandler_p.h"
-
+#include "qhelpfilterdata.h"
+
+#include <QtCore/QCryptographicHash>
+#include <QtCore/QDataStream>
+#include <QtCore/QDir>
+#include <QtCore/QFile>
+#include <QtCore/QFileInfo>
+#include <QtCore/QSaveFile>
 #include <QtCore/QThread>
 #include <QtCore/QMutex>
+#include <QtCore/QVersionNumber>
 #include <QtHelp/QHelpLink>
 #include <QtWidgets/QListView>
 #include <QtWidgets/QHeaderView>
 
 #include <algorithm>
+#include <memory>
+#include <vector>
 
 QT_BEGIN_NAMESPACE
 
+/*
+    Finds the keywords of the index that contain a filter string, without
+    comparing the filter with every keyword.
+
+    The case folded keywords are kept sorted, so that the keywords that
+    start with the filter are a range found by binary search, and each
+    trigram of a keyword leads to the keywords it appears in, so that only
+    the keywords with the rarest trigram of the filter need to be looked at.
+    Keywords are identified by their position in the index.
+*/
+class QHelpIndexSearchTable
+{
+public:
+    explicit QHelpIndexSearchTable(const QStringList &indices);
+
+    std::vector<int> keywordsContaining(const QString &foldedFilter) const;
+    std::pair<std::vector<int>::const_iterator, std::vector<int>::const_iterator>
+    keywordsStartingWith(const QString &foldedFilter) const;
+    const QString &foldedKeyword(int keyword) const { return m_folded.at(keyword); }
+
+private:
+    static quint64 trigram(const QChar *chars)
+    {
+        return quint64(chars[0].unicode()) << 32 | quint64(chars[1].unicode()) << 16
+                | chars[2].unicode();
+    }
+
+    QStringList m_folded;
+    // The keywords, sorted by their folded text and then by their position
+    std::vector<int> m_sorted;
+    QHash<quint64, std::vector<int>> m_trigrams;
+};
+
+QHelpIndexSearchTable::QHelpIndexSearchTable(const QStringList &indices)
+{
+    m_folded.reserve(indices.size());
+    for (const QString &index : indices)
+        m_folded.append(index.toCaseFolded());
+
+    m_sorted.resize(m_folded.size());
+    for (int i = 0; i < int(m_sorted.size()); ++i)
+        m_sorted[i] = i;
+    std::stable_sort(m_sorted.begin(), m_sorted.end(), [this](int a, int b) {
+        return m_folded.at(a) < m_folded.at(b);
+    });
+
+    for (int i = 0; i < int(m_folded.size()); ++i) {
+        const QString &folded = m_folded.at(i);
+        for (qsizetype j = 0; j + 3 <= folded.size(); ++j) {
+            std::vector<int> &keywords = m_trigrams[trigram(folded.constData() + j)];
+            if (keywords.empty() || keywords.back() != i)
+                keywords.push_back(i);
+        }
+    }
+}
+
+/*
+    Returns the keywords that contain \a foldedFilter, in the order of the
+    index.
+*/
+std::vector<int> QHelpIndexSearchTable::keywordsContaining(const QString &foldedFilter) const
+{
+    std::vector<int> result;
+    if (foldedFilter.size() < 3) {
+        for (int i = 0; i < int(m_folded.size()); ++i) {
+            if (m_folded.at(i).contains(foldedFilter))
+                result.push_back(i);
+        }
+        return result;
+    }
+
+    // The candidates are the keywords of the rarest trigram of the filter.
+    const std::vector<int> *candidates = nullptr;
+    for (qsizetype j = 0; j + 3 <= foldedFilter.size(); ++j) {
+        const auto it = m_trigrams.constFind(trigram(foldedFilter.constData() + j));
+        if (it == m_trigrams.cend())
+            return result;
+        if (!candidates || it->size() < candidates->size())
+            candidates = &*it;
+    }
+    for (int keyword : *candidates) {
+        if (m_folded.at(keyword).contains(foldedFilter))
+            result.push_back(keyword);
+    }
+    return result;
+}
+
+/*
+    Returns the range of the sorted keywords that start with \a foldedFilter.
+*/
+std::pair<std::vector<int>::const_iterator, std::vector<int>::const_iterator>
+QHelpIndexSearchTable::keywordsStartingWith(const QString &foldedFilter) const
+{
+    const auto begin = std::lower_bound(m_sorted.cbegin(), m_sorted.cend(), foldedFilter,
+                                        [this](int keyword, const QString &filter) {
+        return m_folded.at(keyword) < filter;
+    });
+    const auto end = std::partition_point(begin, m_sorted.cend(), [&](int keyword) {
+        return m_folded.at(keyword).startsWith(foldedFilter);
+    });
+    return { begin, end };
+}
+
 class QHelpIndexProvider : public QThread
 {
 public:
@@ -25,6 +138,7 @@ public:
     void collectIndices(const QString &customFilterName);
     void stopCollecting();
     QStringList indices() const;
+    std::shared_ptr<const QHelpIndexSearchTable> searchTable() const;
 
 private:
     void run() override;
@@ -33,6 +147,7 @@ private:
     QString m_currentFilter;
     QStringList m_filterAttributes;
     QStringList m_indices;
+    std::shared_ptr<const QHelpIndexSearchTable> m_searchTable;
     mutable QMutex m_mutex;
 };
 
@@ -45,11 +160,76 @@ public:
     {
     }
 
+    void setRows(std::vector<int> &&rows);
+
+    QHelpIndexModel *q = nullptr;
     QHelpEnginePrivate *helpEngine;
     QHelpIndexProvider *indexProvider;
     QStringList indices;
+    std::shared_ptr<const QHelpIndexSearchTable> searchTable;
+    // The positions in indices of the keywords in the model
+    std::vector<int> rows;
 };
 
+/*
+    Makes the model hold the keywords at the positions \a newRows of the
+    index. The rows that are not in the new list are removed and the new
+    ones inserted where they belong, instead of resetting the model, as
+    long as this does not change most of the rows.
+*/
+void QHelpIndexModelPrivate::setRows(std::vector<int> &&newRows)
+{
+    // Rows change run by run, a reset is cheaper for many of them.
+    constexpr size_t MaxChangedRows = 1000;
+
+    const bool removesOnly = newRows.size() <= rows.size()
+            && (newRows.empty() || rows.size() - newRows.size() <= MaxChangedRows)
+            && std::includes(rows.cbegin(), rows.cend(), newRows.cbegin(), newRows.cend());
+    const bool insertsOnly = !removesOnly && !rows.empty() && newRows.size() >= rows.size()
+            && newRows.size() - rows.size() <= MaxChangedRows
+            && std::includes(newRows.cbegin(), newRows.cend(), rows.cbegin(), rows.cend());
+
+    if (removesOnly) {
+        // From the back, so that the rows in front keep their numbers.
+        int row = int(rows.size());
+        auto it = newRows.crbegin();
+        while (row > 0) {
+            int end = row;
+            while (row > 0 && (it == newRows.crend() || *it != rows[row - 1]))
+                --row;
+            if (row < end)
+                q->removeRows(row, end - row);
+            if (row > 0) {
+                --row;
+                ++it;
+            }
+        }
+    } else if (insertsOnly) {
+        size_t old = 0;
+        for (size_t row = 0; row < newRows.size();) {
+            if (old < rows.size() && rows[old] == newRows[row]) {
+                ++old;
+                ++row;
+                continue;
+            }
+            size_t end = row;
+            while (end < newRows.size() && (old == rows.size() || newRows[end] != rows[old]))
+                ++end;
+            q->insertRows(int(row), int(end - row));
+            for (size_t i = row; i < end; ++i)
+                q->setData(q->index(int(i), 0), indices.at(newRows[i]));
+            row = end;
+        }
+    } else {
+        QStringList list;
+        list.reserve(newRows.size());
+        for (int keyword : newRows)
+            list.append(indices.at(keyword));
+        q->setStringList(list);
+    }
+    rows = std::move(newRows);
+}
+
 QHelpIndexProvider::QHelpIndexProvider(QHelpEnginePrivate *helpEngine)
     : QThread(helpEngine),
       m_helpEngine(helpEngine)
@@ -86,6 +266,97 @@ QStringList QHelpIndexProvider::indices() const
     return m_indices;
 }
 
+std::shared_ptr<const QHelpIndexSearchTable> QHelpIndexProvider::searchTable() const
+{
+    QMutexLocker lck(&m_mutex);
+    return m_searchTable;
+}
+
+/*
+    The keywords of a filter are kept in a cache file next to the full-text
+    search index of the collection, tagged with the state of the registered
+    documentation they were read for, so that a restart does not need to
+    query them again.
+*/
+static const quint32 KeywordCacheMagic = 0x51484b43; // "QHKC"
+static const quint16 KeywordCacheVersion = 1;
+
+static QString keywordCacheFile(const QString &collectionFile, const QByteArray &filterHash)
+{
+    const QFileInfo fi(collectionFile);
+    return fi.absolutePath() + QLatin1String("/.")
+            + fi.fileName().left(fi.fileName().lastIndexOf(QLatin1String(".qhc")))
+            + QLatin1String("/keywords/") + QString::fromLatin1(filterHash.toHex())
+            + QLatin1String(".cache");
+}
+
+// Reads the header of a cache file and returns the documentation hash it is tagged with.
+static bool readKeywordCacheHeader(QDataStream &in, QByteArray *documentationHash)
+{
+    in.setVersion(QDataStream::Qt_6_0);
+    quint32 magic = 0;
+    quint16 version = 0;
+    in >> magic >> version;
+    if (magic != KeywordCacheMagic || version != KeywordCacheVersion)
+        return false;
+    in >> *documentationHash;
+    return in.status() == QDataStream::Ok;
+}
+
+static bool readKeywordCache(const QString &fileName, const QByteArray &documentationHash,
+                             QStringList *keywords)
+{
+    QFile file(fileName);
+    if (!file.open(QIODevice::ReadOnly))
+        return false;
+
+    QDataStream in(&file);
+    QByteArray hash;
+    if (!readKeywordCacheHeader(in, &hash) || hash != documentationHash)
+        return false;
+    in >> *keywords;
+    return in.status() == QDataStream::Ok;
+}
+
+/*
+    Removes the cache files of the folder that were written for other
+    documentation than \a documentationHash, such as those of filters that
+    matched namespaces which are no longer registered. They can never be
+    read again, and each change of the collection would otherwise leave
+    one more file per filter behind.
+*/
+static void pruneKeywordCaches(const QString &cacheFolder, const QByteArray &documentationHash)
+{
+    QDir dir(cacheFolder);
+    const QStringList fileNames = dir.entryList({ QLatin1String("*.cache") }, QDir::Files);
+    for (const QString &fileName : fileNames) {
+        QFile file(dir.filePath(fileName));
+        if (!file.open(QIODevice::ReadOnly))
+            continue;
+        QDataStream in(&file);
+        QByteArray hash;
+        const bool current = readKeywordCacheHeader(in, &hash) && hash == documentationHash;
+        file.close();
+        if (!current)
+            file.remove();
+    }
+}
+
+static void writeKeywordCache(const QString &fileName, const QByteArray &documentationHash,
+                              const QStringList &keywords)
+{
+    QDir().mkpath(QFileInfo(fileName).absolutePath());
+    QSaveFile file(fileName);
+    if (!file.open(QIODevice::WriteOnly))
+        return;
+
+    QDataStream out(&file);
+    out.setVersion(QDataStream::Qt_6_0);
+    out << KeywordCacheMagic << KeywordCacheVersion << documentationHash << keywords;
+    if (out.status() == QDataStream::Ok)
+        file.commit();
+}
+
 void QHelpIndexProvider::run()
 {
     m_mutex.lock();
@@ -93,6 +364,7 @@ void QHelpIndexProvider::run()
     const QStringList attributes = m_filterAttributes;
     const QString collectionFile = m_helpEngine->collectionHandler->collectionFile();
     m_indices = QStringList();
+    m_searchTable.reset();
     m_mutex.unlock();
 
     if (collectionFile.isEmpty())
@@ -102,12 +374,43 @@ void QHelpIndexProvider::run()
     if (!collectionHandler.openCollectionFile())
         return;
 
-    const QStringList result = m_helpEngine->usesFilterEngine
-            ? collectionHandler.indicesForFilter(currentFilter)
-            : collectionHandler.indicesForFilter(attributes);
+    // The cache file is chosen by what the filter matches, not by its name.
+    QCryptographicHash filterHash(QCryptographicHash::Sha1);
+    const auto addToFilterHash = [&filterHash](const QString &value) {
+        filterHash.addData(value.toUtf8());
+        filterHash.addData(QByteArrayView("", 1));
+    };
+    if (m_helpEngine->usesFilterEngine) {
+        const QHelpFilterData filterData = collectionHandler.filterData(currentFilter);
+        addToFilterHash(QLatin1String("components"));
+        for (const QString &component : filterData.components())
+            addToFilterHash(component);
+        addToFilterHash(QLatin1String("versions"));
+        for (const QVersionNumber &version : filterData.versions())
+            addToFilterHash(version.toString());
+    } else {
+        addToFilterHash(QLatin1String("attributes"));
+        for (const QString &attribute : attributes)
+            addToFilterHash(attribute);
+    }
+
+    const QByteArray documentationHash = collectionHandler.registeredDocumentationHash();
+    const QString cacheFile = keywordCacheFile(collectionFile, filterHash.result());
+
+    QStringList result;
+    if (!readKeywordCache(cacheFile, documentationHash, &result)) {
+        result = m_helpEngine->usesFilterEngine
+                ? collectionHandler.indicesForFilter(currentFilter)
+                : collectionHandler.indicesForFilter(attributes);
+        pruneKeywordCaches(QFileInfo(cacheFile).absolutePath(), documentationHash);
+        writeKeywordCache(cacheFile, documentationHash, result);
+    }
+
+    auto searchTable = std::make_shared<const QHelpIndexSearchTable>(result);
 
     m_mutex.lock();
     m_indices = result;
+    m_searchTable = std::move(searchTable);
     m_mutex.unlock();
 }
 
@@ -141,6 +444,7 @@ QHelpIndexModel::QHelpIndexModel(QHelpEnginePrivate *helpEngine)
     : QStringListModel(helpEngine)
 {
     d = new QHelpIndexModelPrivate(helpEngine);
+    d->q = this;
 
     connect(d->indexProvider, &QThread::finished,
             this, &QHelpIndexModel::insertIndices);
@@ -163,6 +467,7 @@ void QHelpIndexModel::createIndex(const QString &customFilterName)
         return;
 
     d->indices = QStringList();
+    d->searchTable.reset();
     filter(QString());
     emit indexCreationStarted();
 }
@@ -173,6 +478,10 @@ void QHelpIndexModel::insertIndices()
         return;
 
     d->indices = d->indexProvider->indices();
+    d->searchTable = d->indexProvider->searchTable();
+    // The new keywords are not the ones in the rows.
+    d->rows.clear();
+    setStringList(QStringList());
     filter(QString());
     emit indexCreated();
 }
@@ -209,55 +518,63 @@ QHelpEngineCore *QHelpIndexModel::helpEngine() const
 QModelIndex QHelpIndexModel::filter(const QString &filter, const QString &wildcard)
 {
     if (filter.isEmpty()) {
-        setStringList(d->indices);
+        std::vector<int> rows(d->indices.size());
+        for (int i = 0; i < int(rows.size()); ++i)
+            rows[i] = i;
+        d->setRows(std::move(rows));
         return index(-1, 0, QModelIndex());
     }
 
-    QStringList lst;
-    int goodMatch = -1;
-    int perfectMatch = -1;
+    if (!d->searchTable)
+        d->searchTable = std::make_shared<const QHelpIndexSearchTable>(d->indices);
+    const QHelpIndexSearchTable &table = *d->searchTable;
+    const QString foldedFilter = filter.toCaseFolded();
 
+    std::vector<int> rows;
     if (!wildcard.isEmpty()) {
         auto re = QRegularExpression::wildcardToRegularExpression(wildcard,
                                                                   QRegularExpression::UnanchoredWildcardConversion);
         const QRegularExpression regExp(re, QRegularExpression::CaseInsensitiveOption);
-        for (const QString &index : qAsConst(d->indices)) {
-            if (index.contains(regExp)) {
-                lst.append(index);
-                if (perfectMatch == -1 && index.startsWith(filter, Qt::CaseInsensitive)) {
-                    if (goodMatch == -1)
-                        goodMatch = lst.count() - 1;
-                    if (filter.length() == index.length()){
-                        perfectMatch = lst.count() - 1;
-                    }
-                } else if (perfectMatch > -1 && index == filter) {
-                    perfectMatch = lst.count() - 1;
-                }
-            }
+        for (int i = 0; i < int(d->indices.size()); ++i) {
+            if (d->indices.at(i).contains(regExp))
+                rows.push_back(i);
         }
     } else {
-        for (const QString &index : qAsConst(d->indices)) {
-            if (index.contains(filter, Qt::CaseInsensitive)) {
-                lst.append(index);
-                if (perfectMatch == -1 && index.startsWith(filter, Qt::CaseInsensitive)) {
-                    if (goodMatch == -1)
-                        goodMatch = lst.count() - 1;
-                    if (filter.length() == index.length()){
-                        perfectMatch = lst.count() - 1;
-                    }
-                } else if (perfectMatch > -1 && index == filter) {
-                    perfectMatch = lst.count() - 1;
-                }
+        rows = table.keywordsContaining(foldedFilter);
+    }
+
+    // The best match is the first keyword that equals the filter, or the
+    // last one after it that equals it in case as well. Failing that, it is
+    // the first keyword that starts with the filter.
+    int goodMatch = -1;
+    int perfectMatch = -1;
+    const auto [begin, end] = table.keywordsStartingWith(foldedFilter);
+    for (auto it = begin; it != end; ++it) {
+        const int keyword = *it;
+        if (!std::binary_search(rows.cbegin(), rows.cend(), keyword))
+            continue;
+        if (goodMatch == -1 || keyword < goodMatch)
+            goodMatch = keyword;
+        if (table.foldedKeyword(keyword).size() == foldedFilter.size()
+                && (perfectMatch == -1 || keyword < perfectMatch)) {
+            perfectMatch = keyword;
+        }
+    }
+    if (perfectMatch != -1) {
+        for (auto it = begin; it != end; ++it) {
+            const int keyword = *it;
+            if (keyword > perfectMatch && d->indices.at(keyword) == filter
+                    && std::binary_search(rows.cbegin(), rows.cend(), keyword)) {
+                perfectMatch = keyword;
             }
         }
-
     }
+    const int bestMatch = perfectMatch != -1 ? perfectMatch : goodMatch;
+    const int bestRow = bestMatch == -1 ? 0
+            : int(std::lower_bound(rows.cbegin(), rows.cend(), bestMatch) - rows.cbegin());
 
-    if (perfectMatch == -1)
-        perfectMatch = qMax(0, goodMatch);
-
-    setStringList(lst);
-    return index(perfectMatch, 0, QModelIndex());
+    d->setRows(std::move(rows));
+    return index(bestRow, 0, QModelIndex());
 }
 
 
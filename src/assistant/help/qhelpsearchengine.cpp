@@ -123,6 +123,7 @@ signals:
     void indexingFinished();
 
     void searchingStarted();
+    void searchResultsAvailable(int searchResultCount);
     void searchingFinished(int searchResultCount);
 
 private:
@@ -168,7 +169,7 @@ private:
 
         indexWriter->cancelIndexing();
         indexWriter->updateIndex(helpEngine->collectionFile(),
-                                 indexFilesFolder(), reindex);
+                                 indexFilesFolder(), reindex, m_shardedIndex);
     }
 
     void cancelIndexing()
@@ -189,6 +190,8 @@ private:
             indexReader = new QHelpSearchIndexReaderDefault();
             connect(indexReader, &fulltextsearch::QHelpSearchIndexReader::searchingStarted,
                     this, &QHelpSearchEnginePrivate::searchingStarted);
+            connect(indexReader, &fulltextsearch::QHelpSearchIndexReader::searchResultsAvailable,
+                    this, &QHelpSearchEnginePrivate::searchResultsAvailable);
             connect(indexReader, &fulltextsearch::QHelpSearchIndexReader::searchingFinished,
                     this, &QHelpSearchEnginePrivate::searchingFinished);
         }
@@ -196,7 +199,8 @@ private:
         m_searchInput = searchInput;
         indexReader->cancelSearching();
         indexReader->search(helpEngine->collectionFile(), indexFilesFolder(),
-                            searchInput, helpEngine->usesFilterEngine());
+                            searchInput, helpEngine->usesFilterEngine(),
+                            queryWidget && queryWidget->isLiveSearchEnabled());
     }
 
     void cancelSearching()
@@ -221,8 +225,9 @@ private:
     friend class QHelpSearchEngine;
 
     bool m_isIndexingScheduled = false;
+    bool m_shardedIndex = false;
 
-    QHelpSearchQueryWidget *queryWidget = nullptr;
+    QPointer<QHelpSearchQueryWidget> queryWidget;
     QHelpSearchResultWidget *resultWidget = nullptr;
 
     fulltextsearch::QHelpSearchIndexReader *indexReader = nullptr;
@@ -334,6 +339,21 @@ private:
     This signal is emitted when the search process is started.
 */
 
+/*!
+    \fn void QHelpSearchEngine::searchResultsAvailable(int searchResultCount)
+    \since 6.5
+
+    This signal is emitted while the search is still running, once the
+    first results are found. searchResults() returns them until the
+    search is complete. The number of results found so far is stored in
+    \a searchResultCount.
+
+    The signal is not emitted if the search finishes with only a few
+    results.
+
+    \sa searchingFinished()
+*/
+
 /*!
     \fn void QHelpSearchEngine::searchingFinished(int searchResultCount)
 
@@ -362,6 +382,8 @@ QHelpSearchEngine::QHelpSearchEngine(QHelpEngineCore *helpEngine, QObject *paren
             this, &QHelpSearchEngine::indexingFinished);
     connect(d, &QHelpSearchEnginePrivate::searchingStarted,
             this, &QHelpSearchEngine::searchingStarted);
+    connect(d, &QHelpSearchEnginePrivate::searchResultsAvailable,
+            this, &QHelpSearchEngine::searchResultsAvailable);
     connect(d, &QHelpSearchEnginePrivate::searchingFinished,
             this, &QHelpSearchEngine::searchingFinished);
 }
@@ -472,6 +494,36 @@ QString QHelpSearchEngine::searchInput() const
     return d->m_searchInput;
 }
 
+/*!
+    \since 6.5
+    Sets whether the full text search index keeps a separate database for
+    each registered documentation to \a enabled.
+
+    A sharded index is faster to update when documentation is registered
+    or removed, as only the databases of the documentation concerned are
+    written, and it is searched on several threads. The change takes
+    effect the next time the documentation is indexed. The default is
+    \c false.
+
+    \sa isShardedIndexEnabled(), reindexDocumentation()
+*/
+void QHelpSearchEngine::setShardedIndexEnabled(bool enabled)
+{
+    d->m_shardedIndex = enabled;
+}
+
+/*!
+    \since 6.5
+    Returns whether the full text search index keeps a separate database
+    for each registered documentation.
+
+    \sa setShardedIndexEnabled()
+*/
+bool QHelpSearchEngine::isShardedIndexEnabled() const
+{
+    return d->m_shardedIndex;
+}
+
 #if QT_DEPRECATED_SINCE(5, 9)
 /*!
     \deprecated
@@ -77,6 +77,9 @@ public:
     QList<QHelpSearchResult> searchResults(int start, int end) const;
     QString searchInput() const;
 
+    void setShardedIndexEnabled(bool enabled);
+    bool isShardedIndexEnabled() const;
+
 public Q_SLOTS:
     void reindexDocumentation();
     void cancelIndexing();
@@ -95,6 +98,7 @@ Q_SIGNALS:
     void indexingFinished();
 
     void searchingStarted();
+    void searchResultsAvailable(int searchResultCount);
     void searchingFinished(int searchResultCount);
 
 private Q_SLOTS:
@@ -17,23 +17,83 @@ void QHelpSearchIndexReader::cancelSearching()
 {
     QMutexLocker lock(&m_mutex);
     m_cancel = true;
+    m_hasPending = false;
 }
 
+/*
+    Starts searching for \a searchInput. A search that is still running is
+    cancelled, and only the latest of the searches requested meanwhile is
+    run after it, so that searching while typing does not queue up work or
+    block the caller.
+*/
 void QHelpSearchIndexReader::search(const QString &collectionFile, const QString &indexFilesFolder,
-    const QString &searchInput, bool usesFilterEngine)
+    const QString &searchInput, bool usesFilterEngine, bool prefixSearch)
 {
-    wait();
+    QMutexLocker lock(&m_mutex);
 
-    m_searchResults.clear();
-    m_cancel = false;
-    m_searchInput = searchInput;
-    m_collectionFile = collectionFile;
-    m_indexFilesFolder = indexFilesFolder;
-    m_usesFilterEngine = usesFilterEngine;
+    m_pending.collectionFile = collectionFile;
+    m_pending.indexFilesFolder = indexFilesFolder;
+    m_pending.searchInput = searchInput;
+    m_pending.usesFilterEngine = usesFilterEngine;
+    m_pending.prefixSearch = prefixSearch;
+    m_hasPending = true;
+    m_cancel = true;
 
+    if (m_running)
+        return;
+    m_running = true;
+    lock.unlock();
+
+    // The thread may still be returning from run().
+    wait();
     start(QThread::NormalPriority);
 }
 
+void QHelpSearchIndexReader::run()
+{
+    QMutexLocker lock(&m_mutex);
+    while (m_hasPending) {
+        m_hasPending = false;
+        m_cancel = false;
+        m_searchResults.clear();
+        m_searchInput = m_pending.searchInput;
+        m_collectionFile = m_pending.collectionFile;
+        m_indexFilesFolder = m_pending.indexFilesFolder;
+        m_usesFilterEngine = m_pending.usesFilterEngine;
+        m_prefixSearch = m_pending.prefixSearch;
+        lock.unlock();
+
+        runSearch();
+
+        lock.relock();
+    }
+    m_running = false;
+}
+
+/*
+    Returns whether the search that is running has been superseded by a new
+    one. Must be called with the mutex locked.
+*/
+bool QHelpSearchIndexReader::isSuperseded() const
+{
+    return m_hasPending;
+}
+
+// Only called from the search thread.
+void QHelpSearchIndexReader::emitSearchingStarted()
+{
+    if (m_searchingStartedEmitted)
+        return;
+    m_searchingStartedEmitted = true;
+    emit searchingStarted();
+}
+
+void QHelpSearchIndexReader::emitSearchingFinished(int searchResultCount)
+{
+    m_searchingStartedEmitted = false;
+    emit searchingFinished(searchResultCount);
+}
+
 int QHelpSearchIndexReader::searchResultCount() const
 {
     QMutexLocker lock(&m_mutex);
@@ -4,11 +4,21 @@
 #include "qhelpenginecore.h"
 #include "qhelpfilterengine.h"
 #include "qhelpsearchindexreader_default_p.h"
+#include "qhelpsearchindexwriter_default_p.h"
 
+#include <QtCore/QDir>
+#include <QtCore/QMutex>
 #include <QtCore/QSet>
+#include <QtCore/QThread>
+#include <QtCore/QUrl>
+#include <QtCore/QWaitCondition>
 #include <QtSql/QSqlDatabase>
 #include <QtSql/QSqlQuery>
 
+#include <algorithm>
+#include <memory>
+#include <vector>
+
 QT_BEGIN_NAMESPACE
 
 namespace fulltextsearch {
@@ -99,74 +109,286 @@ static void bindNamespacesAndAttributes(QSqlQuery *query, const QStringList &nam
         query->addBindValue(ns);
 }
 
-QList<QHelpSearchResult> Reader::queryTable(const QSqlDatabase &db,
-                                         const QString &tableName,
-                                         const QString &searchInput) const
+Reader::~Reader()
+{
+    if (!m_connectionName.isEmpty())
+        QSqlDatabase::removeDatabase(m_connectionName);
+}
+
+/*
+    Returns the connection to the index, which stays open from one search to
+    the next as long as the index path is the same.
+*/
+QSqlDatabase Reader::database()
+{
+    const QString dbName = m_indexPath + QLatin1String("/fts");
+    if (!m_connectionName.isEmpty()) {
+        QSqlDatabase db = QSqlDatabase::database(m_connectionName, false);
+        if (db.databaseName() == dbName && (db.isOpen() || db.open()))
+            return db;
+        db = QSqlDatabase();
+        QSqlDatabase::removeDatabase(m_connectionName);
+        m_connectionName.clear();
+    }
+
+    const QString &uniqueId = QHelpGlobal::uniquifyConnectionName(QLatin1String("QHelpReader"), this);
+    QSqlDatabase db = QSqlDatabase::addDatabase(QLatin1String("QSQLITE"), uniqueId);
+    db.setConnectOptions(QLatin1String("QSQLITE_OPEN_READONLY"));
+    db.setDatabaseName(dbName);
+    m_connectionName = uniqueId;
+    db.open();
+    return db;
+}
+
+/*
+    Appends the results of \a searchInput in \a tableName whose URLs are not
+    in \a urls yet, best ranked first, calling \a progress along the way.
+    Matches in titles weigh more than matches in the text of the pages.
+
+    The rows are read while the query steps through them, so the snippets of
+    the first results are made without waiting for the rest. Returns
+    \c false if \a progress asked to stop.
+*/
+bool Reader::queryTable(const QSqlDatabase &db, const QString &tableName,
+                        const QString &searchInput, QSet<QUrl> *urls,
+                        const ProgressFunction &progress)
 {
     const QString nsPlaceholders = m_useFilterEngine
             ? namespacePlaceholders(m_filterEngineNamespaceList)
             : namespacePlaceholders(m_namespaceAttributes);
+    const QString rank = tableName == QLatin1String("titles")
+            ? QLatin1String("rank")
+            : QLatin1String("bm25(contents, 0.0, 0.0, 0.0, 5.0, 1.0)");
     QSqlQuery query(db);
+    query.setForwardOnly(true);
     query.prepare(QLatin1String("SELECT url, title, snippet(") + tableName +
                   QLatin1String(", -1, '<b>', '</b>', '...', '10') FROM ") + tableName +
                   QLatin1String(" WHERE (") + nsPlaceholders +
                   QLatin1String(") AND ") + tableName +
-                  QLatin1String(" MATCH ? ORDER BY rank"));
+                  QLatin1String(" MATCH ? ORDER BY ") + rank);
     m_useFilterEngine
             ? bindNamespacesAndAttributes(&query, m_filterEngineNamespaceList)
             : bindNamespacesAndAttributes(&query, m_namespaceAttributes);
     query.addBindValue(searchInput);
     query.exec();
 
-    QList<QHelpSearchResult> results;
-
-    while (query.next()) {
-        const QString &url = query.value(QLatin1String("url")).toString();
-        const QString &title = query.value(QLatin1String("title")).toString();
-        const QString &snippet = query.value(2).toString();
-        results.append(QHelpSearchResult(url, title, snippet));
+    for (int row = 1; query.next(); ++row) {
+        const QUrl url(query.value(0).toString());
+        if (!urls->contains(url)) {
+            urls->insert(url);
+            const QString &title = query.value(1).toString();
+            const QString &snippet = query.value(2).toString();
+            m_searchResults.append(QHelpSearchResult(url, title, snippet));
+        }
+        if (row % ProgressInterval == 0 && !progress(m_searchResults))
+            return false;
     }
 
-    return results;
+    return true;
 }
 
-void Reader::searchInDB(const QString &searchInput)
+/*
+    Returns the results of \a searchInput in \a tableName of the shard
+    \a dbPath, together with their ranks. Runs on a thread of its own, so
+    it opens and removes its own connection.
+*/
+static QList<Reader::RankedResult> queryShard(const QString &dbPath, const QString &tableName,
+                                              const QString &searchInput,
+                                              const QString &nsPlaceholders,
+                                              const QVariantList &bindValues)
 {
-    const QString &uniqueId = QHelpGlobal::uniquifyConnectionName(QLatin1String("QHelpReader"), this);
+    QList<Reader::RankedResult> results;
+    const QString &uniqueId =
+            QHelpGlobal::uniquifyConnectionName(QLatin1String("QHelpShardReader"), &results);
     {
         QSqlDatabase db = QSqlDatabase::addDatabase(QLatin1String("QSQLITE"), uniqueId);
         db.setConnectOptions(QLatin1String("QSQLITE_OPEN_READONLY"));
-        db.setDatabaseName(m_indexPath + QLatin1String("/fts"));
-
+        db.setDatabaseName(dbPath);
         if (db.open()) {
-            const QList<QHelpSearchResult> titleResults = queryTable(db,
-                                             QLatin1String("titles"), searchInput);
-            const QList<QHelpSearchResult> contentResults = queryTable(db,
-                                             QLatin1String("contents"), searchInput);
+            const QString rank = tableName == QLatin1String("titles")
+                    ? QLatin1String("rank")
+                    : QLatin1String("bm25(contents, 0.0, 0.0, 0.0, 5.0, 1.0)");
+            QSqlQuery query(db);
+            query.setForwardOnly(true);
+            query.prepare(QLatin1String("SELECT url, title, snippet(") + tableName +
+                          QLatin1String(", -1, '<b>', '</b>', '...', '10'), ") + rank +
+                          QLatin1String(" FROM ") + tableName +
+                          QLatin1String(" WHERE (") + nsPlaceholders +
+                          QLatin1String(") AND ") + tableName +
+                          QLatin1String(" MATCH ? ORDER BY ") + rank);
+            for (const QVariant &value : bindValues)
+                query.addBindValue(value);
+            query.addBindValue(searchInput);
+            query.exec();
+            while (query.next()) {
+                results.append({ QHelpSearchResult(QUrl(query.value(0).toString()),
+                                                   query.value(1).toString(),
+                                                   query.value(2).toString()),
+                                 query.value(3).toDouble() });
+            }
+        }
+    }
+    QSqlDatabase::removeDatabase(uniqueId);
 
-            // merge results form title and contents searches
-            m_searchResults = QList<QHelpSearchResult>();
+    // The bm25() ranks are negative, lower for better matches, and depend on
+    // the statistics of the database they come from. Relative to the best
+    // match of the shard, they compare across shards: 1 for the best match,
+    // closer to 0 for worse ones.
+    if (!results.isEmpty()) {
+        const double best = results.constFirst().rank;
+        for (Reader::RankedResult &result : results)
+            result.rank = best < 0 ? result.rank / best : 1.0;
+    }
+    return results;
+}
+
+/*
+    Searches the databases of the namespaces in the filter at the same time
+    and merges what they find as if it came from one database: the title
+    matches of all of them by relative rank, then their text matches by
+    relative rank. \a progress is called with the merged results each time
+    a shard is done; the shards that are not searched yet are skipped once
+    it returns \c false.
+*/
+void Reader::searchInShards(const QString &shardsPath, const QString &searchInput,
+                            const ProgressFunction &progress)
+{
+    struct Shard
+    {
+        QString dbPath;
+        QString nsPlaceholders;
+        QVariantList bindValues;
+        QList<RankedResult> titles;
+        QList<RankedResult> contents;
+        bool done = false;
+    };
+
+    std::vector<Shard> shards;
+    const QStringList namespaceList = m_useFilterEngine
+            ? m_filterEngineNamespaceList : m_namespaceAttributes.uniqueKeys();
+    for (const QString &namespaceName : namespaceList) {
+        const QString dbPath = shardsPath + QLatin1Char('/')
+                + Writer::shardFileName(namespaceName);
+        if (!QFileInfo::exists(dbPath))
+            continue;
+        Shard shard;
+        shard.dbPath = dbPath;
+        shard.bindValues.append(namespaceName);
+        if (m_useFilterEngine) {
+            shard.nsPlaceholders = namespacePlaceholders(QStringList(namespaceName));
+        } else {
+            QMultiMap<QString, QStringList> namespaceAttributes;
+            const QList<QStringList> &attributeSets = m_namespaceAttributes.values(namespaceName);
+            for (const QStringList &attributeSet : attributeSets) {
+                namespaceAttributes.insert(namespaceName, attributeSet);
+                if (!attributeSet.isEmpty())
+                    shard.bindValues.append(attributeSet.join(QLatin1Char('|')));
+            }
+            shard.nsPlaceholders = namespacePlaceholders(namespaceAttributes);
+        }
+        shards.push_back(shard);
+    }
 
-            QSet<QUrl> urls;
+    QMutex mutex;
+    QWaitCondition shardDone;
+    int doneCount = 0;
+    bool cancelled = false;
+    int next = 0;
+    const int threadCount = qMin(QThread::idealThreadCount(), int(shards.size()));
+    std::vector<std::unique_ptr<QThread>> threads;
+    for (int i = 0; i < threadCount; ++i) {
+        threads.emplace_back(QThread::create([&] {
+            QMutexLocker locker(&mutex);
+            while (!cancelled && next < int(shards.size())) {
+                Shard &shard = shards[next++];
+                locker.unlock();
+                QList<RankedResult> titles = queryShard(shard.dbPath, QLatin1String("titles"),
+                                                        searchInput, shard.nsPlaceholders,
+                                                        shard.bindValues);
+                QList<RankedResult> contents = queryShard(shard.dbPath,
+                                                          QLatin1String("contents"),
+                                                          searchInput, shard.nsPlaceholders,
+                                                          shard.bindValues);
+                locker.relock();
+                shard.titles = std::move(titles);
+                shard.contents = std::move(contents);
+                shard.done = true;
+                ++doneCount;
+                shardDone.wakeAll();
+            }
+        }));
+        threads.back()->start();
+    }
 
-            for (const QHelpSearchResult &result : titleResults) {
-                const QUrl &url = result.url();
-                if (!urls.contains(url)) {
-                    urls.insert(url);
-                    m_searchResults.append(result);
+    // Merges the results of the shards that are done, in the order of the
+    // shards where the ranks are equal. Called with the mutex locked.
+    const auto mergeResults = [&] {
+        const auto byRank = [](const RankedResult &left, const RankedResult &right) {
+            return left.rank > right.rank;
+        };
+        QList<RankedResult> titles;
+        QList<RankedResult> contents;
+        for (const Shard &shard : shards) {
+            if (!shard.done)
+                continue;
+            titles += shard.titles;
+            contents += shard.contents;
+        }
+        std::stable_sort(titles.begin(), titles.end(), byRank);
+        std::stable_sort(contents.begin(), contents.end(), byRank);
+
+        m_searchResults.clear();
+        QSet<QUrl> urls;
+        for (const QList<RankedResult> &ranked : { titles, contents }) {
+            for (const RankedResult &result : ranked) {
+                if (!urls.contains(result.result.url())) {
+                    urls.insert(result.result.url());
+                    m_searchResults.append(result.result);
                 }
             }
+        }
+    };
 
-            for (const QHelpSearchResult &result : contentResults) {
-                const QUrl &url = result.url();
-                if (!urls.contains(url)) {
-                    urls.insert(url);
-                    m_searchResults.append(result);
-                }
+    {
+        QMutexLocker locker(&mutex);
+        int reportedCount = 0;
+        while (reportedCount < int(shards.size())) {
+            while (doneCount == reportedCount)
+                shardDone.wait(&mutex);
+            reportedCount = doneCount;
+            mergeResults();
+            const QList<QHelpSearchResult> results = m_searchResults;
+            locker.unlock();
+            const bool proceed = progress(results);
+            locker.relock();
+            if (!proceed) {
+                cancelled = true;
+                break;
             }
         }
     }
-    QSqlDatabase::removeDatabase(uniqueId);
+    for (const auto &thread : threads)
+        thread->wait();
+}
+
+void Reader::searchInDB(const QString &searchInput, const ProgressFunction &progress)
+{
+    m_searchResults = QList<QHelpSearchResult>();
+
+    const QString shardsPath = Writer::shardsPath(m_indexPath);
+    if (QDir(shardsPath).exists()) {
+        searchInShards(shardsPath, searchInput, progress);
+        return;
+    }
+
+    const QSqlDatabase db = database();
+    if (!db.isOpen())
+        return;
+
+    // Title matches come first, then the pages that only match in the text.
+    QSet<QUrl> urls;
+    if (queryTable(db, QLatin1String("titles"), searchInput, &urls, progress))
+        queryTable(db, QLatin1String("contents"), searchInput, &urls, progress);
 }
 
 QList<QHelpSearchResult> Reader::searchResults() const
@@ -185,14 +407,43 @@ static bool attributesMatchFilter(const QStringList &attributes,
     return true;
 }
 
-void QHelpSearchIndexReaderDefault::run()
+/*
+    Returns \a searchInput with its last word turned into an FTS5 prefix
+    query, so that it also matches the words that it is the beginning of.
+    Input that ends with anything but a bare word is returned as it is.
+*/
+static QString prefixQuery(const QString &searchInput)
+{
+    const QString input = searchInput.trimmed();
+    if (input.isEmpty() || input.count(QLatin1Char('"')) % 2)
+        return searchInput;
+    const QChar last = input.back();
+    if (!last.isLetterOrNumber() && last != QLatin1Char('_'))
+        return searchInput;
+
+    qsizetype wordStart = input.size();
+    while (wordStart > 0 && (input.at(wordStart - 1).isLetterOrNumber()
+                             || input.at(wordStart - 1) == QLatin1Char('_'))) {
+        --wordStart;
+    }
+    const QStringView word = QStringView(input).mid(wordStart);
+    if (word == QLatin1String("AND") || word == QLatin1String("OR")
+            || word == QLatin1String("NOT")) {
+        return searchInput;
+    }
+    if (wordStart > 0 && input.at(wordStart - 1) == QLatin1Char('"'))
+        return searchInput;
+    return input + QLatin1Char('*');
+}
+
+void QHelpSearchIndexReaderDefault::runSearch()
 {
     QMutexLocker lock(&m_mutex);
 
     if (m_cancel)
         return;
 
-    const QString searchInput = m_searchInput;
+    const QString searchInput = m_prefixSearch ? prefixQuery(m_searchInput) : m_searchInput;
     const QString collectionFile = m_collectionFile;
     const QString indexPath = m_indexFilesFolder;
     const bool usesFilterEngine = m_usesFilterEngine;
@@ -203,7 +454,7 @@ void QHelpSearchIndexReaderDefault::run()
     if (!engine.setupData())
         return;
 
-    emit searchingStarted();
+    emitSearchingStarted();
 
     // setup the reader
     m_reader.setIndexPath(indexPath);
@@ -230,19 +481,37 @@ void QHelpSearchIndexReaderDefault::run()
 
     lock.relock();
     if (m_cancel) {
-        emit searchingFinished(0);   // TODO: check this, speed issue while locking???
+        if (!isSuperseded())
+            emitSearchingFinished(0);   // TODO: check this, speed issue while locking???
         return;
     }
     lock.unlock();
 
     m_searchResults.clear();
-    m_reader.searchInDB(searchInput);    // TODO: should this be interruptible as well ???
+    // The first page of results is shown while the rest are searched for.
+    bool firstResultsShown = false;
+    m_reader.searchInDB(searchInput, [&](const QList<QHelpSearchResult> &results) {
+        QMutexLocker locker(&m_mutex);
+        if (m_cancel)
+            return false;
+        if (!firstResultsShown && results.count() >= FirstResultsCount) {
+            firstResultsShown = true;
+            m_searchResults = results;
+            locker.unlock();
+            emit searchResultsAvailable(results.count());
+        }
+        return true;
+    });
 
     lock.relock();
+    // The results of a superseded search are not shown.
+    if (isSuperseded())
+        return;
     m_searchResults = m_reader.searchResults();
+    const int searchResultCount = m_searchResults.count();
     lock.unlock();
 
-    emit searchingFinished(m_searchResults.count());
+    emitSearchingFinished(searchResultCount);
 }
 
 }   // namespace std
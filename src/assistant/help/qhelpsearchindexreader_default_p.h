@@ -17,6 +17,11 @@
 
 #include "qhelpsearchindexreader_p.h"
 
+#include <QtCore/QSet>
+#include <QtCore/QUrl>
+
+#include <functional>
+
 QT_FORWARD_DECLARE_CLASS(QSqlDatabase)
 
 QT_BEGIN_NAMESPACE
@@ -27,18 +32,35 @@ namespace qt {
 class Reader
 {
 public:
+    // Called with the results found so far; returning false stops the search.
+    using ProgressFunction = std::function<bool(const QList<QHelpSearchResult> &)>;
+
+    struct RankedResult
+    {
+        QHelpSearchResult result;
+        double rank;
+    };
+
+    ~Reader();
+
     void setIndexPath(const QString &path);
     void addNamespaceAttributes(const QString &namespaceName, const QStringList &attributes);
     void setFilterEngineNamespaceList(const QStringList &namespaceList);
 
-    void searchInDB(const QString &term);
+    void searchInDB(const QString &term, const ProgressFunction &progress);
     QList<QHelpSearchResult> searchResults() const;
 
 private:
-    QList<QHelpSearchResult> queryTable(const QSqlDatabase &db,
-                                          const QString &tableName,
-                                          const QString &searchInput) const;
+    static const int ProgressInterval = 20;
+
+    QSqlDatabase database();
+    bool queryTable(const QSqlDatabase &db, const QString &tableName,
+                    const QString &searchInput, QSet<QUrl> *urls,
+                    const ProgressFunction &progress);
+    void searchInShards(const QString &shardsPath, const QString &searchInput,
+                        const ProgressFunction &progress);
 
+    QString m_connectionName;
     QMultiMap<QString, QStringList> m_namespaceAttributes;
     QStringList m_filterEngineNamespaceList;
     QList<QHelpSearchResult> m_searchResults;
@@ -52,7 +74,7 @@ class QHelpSearchIndexReaderDefault : public QHelpSearchIndexReader
     Q_OBJECT
 
 private:
-    void run() override;
+    void runSearch() override;
 
 private:
     Reader m_reader;
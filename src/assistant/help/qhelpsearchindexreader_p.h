@@ -38,15 +38,24 @@ public:
     void search(const QString &collectionFile,
                 const QString &indexFilesFolder,
                 const QString &searchInput,
-                bool usesFilterEngine = false);
+                bool usesFilterEngine = false,
+                bool prefixSearch = false);
     int searchResultCount() const;
     QList<QHelpSearchResult> searchResults(int start, int end) const;
 
 signals:
     void searchingStarted();
+    void searchResultsAvailable(int searchResultCount);
     void searchingFinished(int searchResultCount);
 
 protected:
+    // The number of results after which the first ones are made available
+    static const int FirstResultsCount = 20;
+
+    bool isSuperseded() const;
+    void emitSearchingStarted();
+    void emitSearchingFinished(int searchResultCount);
+
     mutable QMutex m_mutex;
     QList<QHelpSearchResult> m_searchResults;
     bool m_cancel = false;
@@ -54,9 +63,26 @@ protected:
     QString m_searchInput;
     QString m_indexFilesFolder;
     bool m_usesFilterEngine = false;
+    bool m_prefixSearch = false;
 
 private:
-    void run() override = 0;
+    void run() override;
+    virtual void runSearch() = 0;
+
+    struct Request
+    {
+        QString collectionFile;
+        QString indexFilesFolder;
+        QString searchInput;
+        bool usesFilterEngine = false;
+        bool prefixSearch = false;
+    };
+
+    Request m_pending;
+    bool m_hasPending = false;
+    bool m_running = false;
+    // Superseded searches share the signals of the one that replaces them.
+    bool m_searchingStartedEmitted = false;
 };
 
 }   // namespace fulltextsearch
@@ -6,6 +6,8 @@
 #include "qhelpenginecore.h"
 #include "qhelpdbreader_p.h"
 
+#include <QtCore/QAtomicInt>
+#include <QtCore/QCryptographicHash>
 #include <QtCore/QDataStream>
 #include <QtCore/QDateTime>
 #include <QtCore/QDir>
@@ -14,43 +16,85 @@
 #include <QtCore/QSet>
 #include <QtCore/QUrl>
 #include <QtCore/QVariant>
+#include <QtCore/QWaitCondition>
 #include <QtSql/QSqlDatabase>
 #include <QtSql/QSqlDriver>
 #include <QtSql/QSqlError>
 #include <QtSql/QSqlQuery>
 
+#include <QtCore/private/qfilesystemengine_p.h>
+
 #include <QTextDocument>
 
+#include <deque>
+#include <memory>
+#include <optional>
+#include <vector>
+
 QT_BEGIN_NAMESPACE
 
 namespace fulltextsearch {
 namespace qt {
 
 const char FTS_DB_NAME[] = "fts";
-
-Writer::Writer(const QString &path)
+const char FTS_SHARDS_DIR[] = "fts-shards";
+const char FTS_SHARD_SUFFIX[] = ".fts";
+const char FTS_BULK_LOAD_SUFFIX[] = ".new";
+
+/*
+    Opens the database \a dbName in \a path, which is the shared index of
+    all namespaces unless a shard is given.
+*/
+Writer::Writer(const QString &path, const QString &dbName)
     : m_dbDir(path)
 {
-    clearLegacyIndex();
+    if (dbName.isEmpty())
+        clearLegacyIndex();
     QDir().mkpath(m_dbDir);
     m_uniqueId = QHelpGlobal::uniquifyConnectionName(QLatin1String("QHelpWriter"), this);
     m_db = new QSqlDatabase();
     *m_db = QSqlDatabase::addDatabase(QLatin1String("QSQLITE"), m_uniqueId);
-    const QString dbPath = m_dbDir + QLatin1Char('/') + QLatin1String(FTS_DB_NAME);
-    m_db->setDatabaseName(dbPath);
+    m_dbPath = m_dbDir + QLatin1Char('/')
+            + (dbName.isEmpty() ? QLatin1String(FTS_DB_NAME) : dbName);
+    m_db->setDatabaseName(m_dbPath);
     if (!m_db->open()) {
         const QString &error = QHelpSearchIndexWriter::tr("Cannot open database \"%1\" using connection \"%2\": %3")
-                .arg(dbPath, m_uniqueId, m_db->lastError().text());
+                .arg(m_dbPath, m_uniqueId, m_db->lastError().text());
         qWarning("%s", qUtf8Printable(error));
-        delete m_db;
-        m_db = nullptr;
-        QSqlDatabase::removeDatabase(m_uniqueId);
-        m_uniqueId = QString();
+        closeDatabase();
     } else {
         startTransaction();
     }
 }
 
+void Writer::closeDatabase()
+{
+    delete m_db;
+    m_db = nullptr;
+    QSqlDatabase::removeDatabase(m_uniqueId);
+    m_uniqueId = QString();
+}
+
+QString Writer::shardsPath(const QString &indexPath)
+{
+    return indexPath + QLatin1Char('/') + QLatin1String(FTS_SHARDS_DIR);
+}
+
+// Namespaces are host names, but better safe than sorry with file names.
+QString Writer::shardFileName(const QString &namespaceName)
+{
+    return QString::fromLatin1(QUrl::toPercentEncoding(namespaceName))
+            + QLatin1String(FTS_SHARD_SUFFIX);
+}
+
+QString Writer::shardNamespace(const QString &shardFileName)
+{
+    if (!shardFileName.endsWith(QLatin1String(FTS_SHARD_SUFFIX)))
+        return QString();
+    return QUrl::fromPercentEncoding(
+                shardFileName.chopped(int(qstrlen(FTS_SHARD_SUFFIX))).toLatin1());
+}
+
 bool Writer::tryInit(bool reindex)
 {
     if (!m_db)
@@ -99,60 +143,118 @@ void Writer::clearLegacyIndex()
     }
 }
 
+// The triggers that keep the full-text indexes in step with the info table
+static void createTriggers(QSqlQuery *query)
+{
+    query->exec(QLatin1String("CREATE TRIGGER titles_insert AFTER INSERT ON info BEGIN "
+                              "INSERT INTO titles(rowid, namespace, attributes, url, title) "
+                              "VALUES(new.id, new.namespace, new.attributes, new.url, new.title); "
+                              "END;"));
+    query->exec(QLatin1String("CREATE TRIGGER titles_delete AFTER DELETE ON info BEGIN "
+                              "INSERT INTO titles(titles, rowid, namespace, attributes, url, title) "
+                              "VALUES('delete', old.id, old.namespace, old.attributes, old.url, old.title); "
+                              "END;"));
+    query->exec(QLatin1String("CREATE TRIGGER titles_update AFTER UPDATE ON info BEGIN "
+                              "INSERT INTO titles(titles, rowid, namespace, attributes, url, title) "
+                              "VALUES('delete', old.id, old.namespace, old.attributes, old.url, old.title); "
+                              "INSERT INTO titles(rowid, namespace, attributes, url, title) "
+                              "VALUES(new.id, new.namespace, new.attributes, new.url, new.title); "
+                              "END;"));
+    query->exec(QLatin1String("CREATE TRIGGER contents_insert AFTER INSERT ON info BEGIN "
+                              "INSERT INTO contents(rowid, namespace, attributes, url, title, data) "
+                              "VALUES(new.id, new.namespace, new.attributes, new.url, new.title, new.data); "
+                              "END;"));
+    query->exec(QLatin1String("CREATE TRIGGER contents_delete AFTER DELETE ON info BEGIN "
+                              "INSERT INTO contents(contents, rowid, namespace, attributes, url, title, data) "
+                              "VALUES('delete', old.id, old.namespace, old.attributes, old.url, old.title, old.data); "
+                              "END;"));
+    query->exec(QLatin1String("CREATE TRIGGER contents_update AFTER UPDATE ON info BEGIN "
+                              "INSERT INTO contents(contents, rowid, namespace, attributes, url, title, data) "
+                              "VALUES('delete', old.id, old.namespace, old.attributes, old.url, old.title, old.data); "
+                              "INSERT INTO contents(rowid, namespace, attributes, url, title, data) "
+                              "VALUES(new.id, new.namespace, new.attributes, new.url, new.title, new.data); "
+                              "END;"));
+}
+
 void Writer::init(bool reindex)
 {
     if (!m_db)
         return;
 
-    QSqlQuery query(*m_db);
-
-    if (reindex && hasDB()) {
-        m_needOptimize = true;
+    // When the index is built from scratch, it is built in a database file
+    // of its own, which replaces the old one once it is complete. The rows
+    // are only written to the info table, and the full-text indexes are
+    // built from it in one go by endTransaction(). The new file is written
+    // without a journal, so a crash can leave it broken, but then it never
+    // replaces the old one. Index files that cannot be read are replaced
+    // the same way.
+    m_bulkLoad = reindex || !hasDB();
+    if (m_bulkLoad && !openBulkLoadDatabase())
+        return;
 
-        query.exec(QLatin1String("DROP TABLE titles;"));
-        query.exec(QLatin1String("DROP TABLE contents;"));
-        query.exec(QLatin1String("DROP TABLE info;"));
-    }
+    QSqlQuery query(*m_db);
 
-    query.exec(QLatin1String("CREATE TABLE info (id INTEGER PRIMARY KEY, namespace, attributes, url, title, data);"));
+    query.exec(QLatin1String("CREATE TABLE info (id INTEGER PRIMARY KEY, namespace, attributes, url, title, data, hash);"));
+    // Indexes of older versions have no hashes of the files.
+    if (!query.exec(QLatin1String("SELECT hash FROM info LIMIT 0")))
+        query.exec(QLatin1String("ALTER TABLE info ADD COLUMN hash;"));
 
     query.exec(QLatin1String("CREATE VIRTUAL TABLE titles USING fts5("
                              "namespace UNINDEXED, attributes UNINDEXED, "
                              "url UNINDEXED, title, "
                              "tokenize = 'porter unicode61', content = 'info', content_rowid='id');"));
-    query.exec(QLatin1String("CREATE TRIGGER titles_insert AFTER INSERT ON info BEGIN "
-                             "INSERT INTO titles(rowid, namespace, attributes, url, title) "
-                             "VALUES(new.id, new.namespace, new.attributes, new.url, new.title); "
-                             "END;"));
-    query.exec(QLatin1String("CREATE TRIGGER titles_delete AFTER DELETE ON info BEGIN "
-                             "INSERT INTO titles(titles, rowid, namespace, attributes, url, title) "
-                             "VALUES('delete', old.id, old.namespace, old.attributes, old.url, old.title); "
-                             "END;"));
-    query.exec(QLatin1String("CREATE TRIGGER titles_update AFTER UPDATE ON info BEGIN "
-                             "INSERT INTO titles(titles, rowid, namespace, attributes, url, title) "
-                             "VALUES('delete', old.id, old.namespace, old.attributes, old.url, old.title); "
-                             "INSERT INTO titles(rowid, namespace, attributes, url, title) "
-                             "VALUES(new.id, new.namespace, new.attributes, new.url, new.title); "
-                             "END;"));
-
     query.exec(QLatin1String("CREATE VIRTUAL TABLE contents USING fts5("
                              "namespace UNINDEXED, attributes UNINDEXED, "
                              "url UNINDEXED, title, data, "
                              "tokenize = 'porter unicode61', content = 'info', content_rowid='id');"));
-    query.exec(QLatin1String("CREATE TRIGGER contents_insert AFTER INSERT ON info BEGIN "
-                             "INSERT INTO contents(rowid, namespace, attributes, url, title, data) "
-                             "VALUES(new.id, new.namespace, new.attributes, new.url, new.title, new.data); "
-                             "END;"));
-    query.exec(QLatin1String("CREATE TRIGGER contents_delete AFTER DELETE ON info BEGIN "
-                             "INSERT INTO contents(contents, rowid, namespace, attributes, url, title, data) "
-                             "VALUES('delete', old.id, old.namespace, old.attributes, old.url, old.title, old.data); "
-                             "END;"));
-    query.exec(QLatin1String("CREATE TRIGGER contents_update AFTER UPDATE ON info BEGIN "
-                             "INSERT INTO contents(contents, rowid, namespace, attributes, url, title, data) "
-                             "VALUES('delete', old.id, old.namespace, old.attributes, old.url, old.title, old.data); "
-                             "INSERT INTO contents(rowid, namespace, attributes, url, title, data) "
-                             "VALUES(new.id, new.namespace, new.attributes, new.url, new.title, new.data); "
-                             "END;"));
+    if (!m_bulkLoad)
+        createTriggers(&query);
+}
+
+/*
+    Closes the index file and opens an empty database next to it, which
+    endTransaction() renames to the index file.
+*/
+bool Writer::openBulkLoadDatabase()
+{
+    if (m_db->driver()->hasFeature(QSqlDriver::Transactions))
+        m_db->rollback();
+    m_db->close();
+
+    m_bulkLoadPath = m_dbPath + QLatin1String(FTS_BULK_LOAD_SUFFIX);
+    // Left behind by an indexing that did not finish
+    QFile::remove(m_bulkLoadPath);
+    m_db->setDatabaseName(m_bulkLoadPath);
+    if (!m_db->open()) {
+        const QString &error = QHelpSearchIndexWriter::tr("Cannot open database \"%1\" using connection \"%2\": %3")
+                .arg(m_bulkLoadPath, m_uniqueId, m_db->lastError().text());
+        qWarning("%s", qUtf8Printable(error));
+        closeDatabase();
+        return false;
+    }
+
+    QSqlQuery query(*m_db);
+    // The page size only has an effect before the tables are created.
+    query.exec(QLatin1String("PRAGMA page_size = 8192;"));
+    query.exec(QLatin1String("PRAGMA journal_mode = OFF;"));
+    query.exec(QLatin1String("PRAGMA synchronous = OFF;"));
+    query.exec(QLatin1String("PRAGMA cache_size = -65536;"));
+    startTransaction();
+    m_needOptimize = true;
+    return true;
+}
+
+/*
+    Removes the database opened by openBulkLoadDatabase() and opens the
+    index file again.
+*/
+void Writer::closeBulkLoadDatabase()
+{
+    m_db->close();
+    QFile::remove(m_bulkLoadPath);
+    m_bulkLoadPath.clear();
+    m_db->setDatabaseName(m_dbPath);
+    m_db->open();
 }
 
 Writer::~Writer()
@@ -164,6 +266,10 @@ Writer::~Writer()
 
     if (!m_uniqueId.isEmpty())
         QSqlDatabase::removeDatabase(m_uniqueId);
+
+    // A new index that was never completed
+    if (!m_bulkLoadPath.isEmpty())
+        QFile::remove(m_bulkLoadPath);
 }
 
 void Writer::flush()
@@ -173,19 +279,61 @@ void Writer::flush()
 
     QSqlQuery query(*m_db);
 
-    query.prepare(QLatin1String("INSERT INTO info (namespace, attributes, url, title, data) VALUES (?, ?, ?, ?, ?)"));
+    if (!m_removedIds.isEmpty()) {
+        query.prepare(QLatin1String("DELETE FROM info WHERE id = ?"));
+        query.addBindValue(m_removedIds);
+        query.execBatch();
+    }
+
+    query.prepare(QLatin1String("INSERT INTO info (namespace, attributes, url, title, data, hash) VALUES (?, ?, ?, ?, ?, ?)"));
     query.addBindValue(m_namespaces);
     query.addBindValue(m_attributes);
     query.addBindValue(m_urls);
     query.addBindValue(m_titles);
     query.addBindValue(m_contents);
+    query.addBindValue(m_hashes);
     query.execBatch();
 
+    m_removedIds = QVariantList();
     m_namespaces = QVariantList();
     m_attributes = QVariantList();
     m_urls = QVariantList();
     m_titles = QVariantList();
     m_contents = QVariantList();
+    m_hashes = QVariantList();
+}
+
+/*
+    Returns the indexed documents of \a namespaceName by their attributes and
+    URL, see documentKey(), so that only the files that changed need to be
+    indexed again.
+*/
+QHash<QString, Writer::IndexedDocument> Writer::indexedDocuments(const QString &namespaceName)
+{
+    QHash<QString, IndexedDocument> documents;
+    if (!m_db)
+        return documents;
+
+    QSqlQuery query(*m_db);
+    query.setForwardOnly(true);
+    query.prepare(QLatin1String("SELECT id, attributes, url, hash FROM info WHERE namespace = ?"));
+    query.addBindValue(namespaceName);
+    query.exec();
+    while (query.next()) {
+        documents.insert(documentKey(query.value(1).toString(), query.value(2).toString()),
+                         { query.value(0).toLongLong(), query.value(3).toByteArray() });
+    }
+    return documents;
+}
+
+QString Writer::documentKey(const QString &attributes, const QString &url)
+{
+    return attributes + QLatin1Char('\n') + url;
+}
+
+void Writer::removeDoc(qint64 id)
+{
+    m_removedIds.append(id);
 }
 
 void Writer::removeNamespace(const QString &namespaceName)
@@ -223,13 +371,15 @@ void Writer::insertDoc(const QString &namespaceName,
                        const QString &attributes,
                        const QString &url,
                        const QString &title,
-                       const QString &contents)
+                       const QString &contents,
+                       const QByteArray &hash)
 {
     m_namespaces.append(namespaceName);
     m_attributes.append(attributes);
     m_urls.append(url);
     m_titles.append(title);
     m_contents.append(contents);
+    m_hashes.append(hash);
 }
 
 void Writer::startTransaction()
@@ -242,23 +392,57 @@ void Writer::startTransaction()
         m_db->transaction();
 }
 
-void Writer::endTransaction()
+/*
+    Commits what was written since startTransaction(). When the index is
+    built from scratch, the new index file then replaces the old one.
+    Returns \c false if nothing was stored.
+*/
+bool Writer::endTransaction()
 {
     if (!m_db)
-        return;
+        return false;
 
     QSqlQuery query(*m_db);
 
+    if (m_bulkLoad) {
+        createTriggers(&query);
+        m_bulkLoad = false;
+    }
+
     if (m_needOptimize) {
         query.exec(QLatin1String("INSERT INTO titles(titles) VALUES('rebuild')"));
         query.exec(QLatin1String("INSERT INTO contents(contents) VALUES('rebuild')"));
     }
 
-    if (m_db && m_db->driver()->hasFeature(QSqlDriver::Transactions))
-        m_db->commit();
+    bool committed = true;
+    if (m_db->driver()->hasFeature(QSqlDriver::Transactions))
+        committed = m_db->commit();
 
     if (m_needOptimize)
         query.exec(QLatin1String("VACUUM"));
+
+    if (m_bulkLoadPath.isEmpty())
+        return committed;
+
+    if (!committed) {
+        closeBulkLoadDatabase();
+        return false;
+    }
+
+    query.finish();
+    m_db->close();
+    QSystemError error;
+    if (!QFileSystemEngine::renameOverwriteFile(QFileSystemEntry(m_bulkLoadPath),
+                                                QFileSystemEntry(m_dbPath), error)) {
+        qWarning("Cannot replace the search index \"%s\": %s", qUtf8Printable(m_dbPath),
+                 qUtf8Printable(error.toString()));
+        closeBulkLoadDatabase();
+        return false;
+    }
+    m_bulkLoadPath.clear();
+    m_db->setDatabaseName(m_dbPath);
+    m_db->open();
+    return true;
 }
 
 QHelpSearchIndexWriter::QHelpSearchIndexWriter()
@@ -284,13 +468,14 @@ void QHelpSearchIndexWriter::cancelIndexing()
 
 void QHelpSearchIndexWriter::updateIndex(const QString &collectionFile,
                                          const QString &indexFilesFolder,
-                                         bool reindex)
+                                         bool reindex, bool sharded)
 {
     wait();
     QMutexLocker lock(&m_mutex);
 
     m_cancel = false;
     m_reindex = reindex;
+    m_sharded = sharded;
     m_collectionFile = collectionFile;
     m_indexFilesFolder = indexFilesFolder;
 
@@ -300,18 +485,20 @@ void QHelpSearchIndexWriter::updateIndex(const QString &collectionFile,
 }
 
 static const char IndexedNamespacesKey[] = "FTS5IndexedNamespaces";
+static const char ShardedNamespacesKey[] = "FTS5ShardedNamespaces";
 
-static QMap<QString, QDateTime> readIndexMap(const QHelpEngineCore &engine)
+static QMap<QString, QDateTime> readIndexMap(const QHelpEngineCore &engine,
+    const char *key = IndexedNamespacesKey)
 {
     QMap<QString, QDateTime> indexMap;
     QDataStream dataStream(engine.customValue(
-                QLatin1String(IndexedNamespacesKey)).toByteArray());
+                QLatin1String(key)).toByteArray());
     dataStream >> indexMap;
     return indexMap;
 }
 
 static bool writeIndexMap(QHelpEngineCore *engine,
-    const QMap<QString, QDateTime> &indexMap)
+    const QMap<QString, QDateTime> &indexMap, const char *key = IndexedNamespacesKey)
 {
     QByteArray data;
 
@@ -319,12 +506,436 @@ static bool writeIndexMap(QHelpEngineCore *engine,
     dataStream << indexMap;
 
     return engine->setCustomValue(
-                QLatin1String(IndexedNamespacesKey), data);
+                QLatin1String(key), data);
+}
+
+static bool clearIndexMap(QHelpEngineCore *engine, const char *key = IndexedNamespacesKey)
+{
+    return engine->removeCustomValue(QLatin1String(key));
 }
 
-static bool clearIndexMap(QHelpEngineCore *engine)
+struct Document
 {
-    return engine->removeCustomValue(QLatin1String(IndexedNamespacesKey));
+    QString fileName;
+    QByteArray data;
+    QString title;
+    QString contents;
+    QByteArray hash;
+    bool hasText = false;
+    bool extracted = false;
+};
+
+/*
+    Returns the character of the HTML entity \a name, without the & and
+    the semicolon, or a null QChar if it is not known.
+*/
+static QChar entityCharacter(QStringView name)
+{
+    if (name.startsWith(QLatin1Char('#'))) {
+        bool ok = false;
+        const uint code = name.size() > 1 && (name.at(1) == QLatin1Char('x')
+                                              || name.at(1) == QLatin1Char('X'))
+                ? name.mid(2).toUInt(&ok, 16) : name.mid(1).toUInt(&ok, 10);
+        // Characters outside of the BMP are not searched for anyway.
+        if (!ok || code == 0 || code > 0xffff)
+            return QChar();
+        return code == 0xa0 ? QChar(QLatin1Char(' ')) : QChar(char16_t(code));
+    }
+
+    static const struct {
+        const char *name;
+        char16_t character;
+    } entities[] = {
+        { "amp", u'&' }, { "lt", u'<' }, { "gt", u'>' }, { "quot", u'"' },
+        { "apos", u'\'' }, { "nbsp", u' ' }, { "copy", u'\u00a9' }, { "reg", u'\u00ae' },
+        { "trade", u'\u2122' }, { "mdash", u'\u2014' }, { "ndash", u'\u2013' },
+        { "hellip", u'\u2026' }, { "laquo", u'\u00ab' }, { "raquo", u'\u00bb' },
+        { "lsquo", u'\u2018' }, { "rsquo", u'\u2019' }, { "ldquo", u'\u201c' },
+        { "rdquo", u'\u201d' }, { "bull", u'\u2022' }, { "middot", u'\u00b7' },
+        { "times", u'\u00d7' }, { "divide", u'\u00f7' }, { "deg", u'\u00b0' },
+        { "para", u'\u00b6' }, { "sect", u'\u00a7' }, { "euro", u'\u20ac' },
+        { "pound", u'\u00a3' }, { "yen", u'\u00a5' }, { "cent", u'\u00a2' },
+        { "larr", u'\u2190' }, { "rarr", u'\u2192' }, { "uarr", u'\u2191' },
+        { "darr", u'\u2193' }, { "le", u'\u2264' }, { "ge", u'\u2265' },
+        { "ne", u'\u2260' }, { "minus", u'\u2212' }, { "shy", u'\u00ad' },
+    };
+    for (const auto &entity : entities) {
+        if (name == QLatin1String(entity.name))
+            return QChar(entity.character);
+    }
+    return QChar();
+}
+
+static bool isBlockTag(QStringView name)
+{
+    static const char *const blockTags[] = {
+        "address", "blockquote", "br", "caption", "dd", "div", "dl", "dt", "h1", "h2",
+        "h3", "h4", "h5", "h6", "hr", "li", "ol", "p", "pre", "table", "td", "th", "tr",
+        "ul",
+    };
+    for (const char *tag : blockTags) {
+        if (name.compare(QLatin1String(tag), Qt::CaseInsensitive) == 0)
+            return true;
+    }
+    return false;
+}
+
+/*
+    Extracts the title and the text of the \a html page the way the index
+    needs them, without building a QTextDocument: tags and comments are
+    stripped, the contents of scripts and style sheets are skipped, entities
+    are decoded and white space is collapsed, with block elements starting
+    a new line.
+*/
+static void extractHtmlText(QStringView html, QString *title, QString *contents)
+{
+    QString *output = contents;
+    bool pendingSpace = false;
+    bool pendingNewline = false;
+    const auto append = [&](QChar ch) {
+        if (!output->isEmpty()) {
+            if (pendingNewline)
+                output->append(QLatin1Char('\n'));
+            else if (pendingSpace)
+                output->append(QLatin1Char(' '));
+        }
+        pendingSpace = pendingNewline = false;
+        output->append(ch);
+    };
+    const auto startOutput = [&](QString *newOutput) {
+        output = newOutput;
+        pendingSpace = pendingNewline = false;
+    };
+
+    contents->reserve(html.size() / 2);
+    const qsizetype size = html.size();
+    for (qsizetype pos = 0; pos < size;) {
+        const QChar ch = html.at(pos);
+        if (ch == QLatin1Char('<')) {
+            if (html.mid(pos).startsWith(QLatin1String("<!--"))) {
+                const qsizetype end = html.indexOf(QLatin1String("-->"), pos + 4);
+                pos = end < 0 ? size : end + 3;
+                continue;
+            }
+
+            qsizetype nameBegin = pos + 1;
+            const bool closing = nameBegin < size && html.at(nameBegin) == QLatin1Char('/');
+            if (closing)
+                ++nameBegin;
+            qsizetype nameEnd = nameBegin;
+            while (nameEnd < size && html.at(nameEnd).isLetterOrNumber())
+                ++nameEnd;
+            const QStringView name = html.mid(nameBegin, nameEnd - nameBegin);
+            const bool declaration = nameBegin < size
+                    && (html.at(nameBegin) == QLatin1Char('!')
+                        || html.at(nameBegin) == QLatin1Char('?'));
+            if (name.isEmpty() && !declaration) {
+                // Not a tag, a stray less-than sign.
+                append(ch);
+                ++pos;
+                continue;
+            }
+
+            // Skips to the end of the tag, over quoted attribute values.
+            QChar quote;
+            for (pos = nameEnd; pos < size; ++pos) {
+                const QChar c = html.at(pos);
+                if (!quote.isNull()) {
+                    if (c == quote)
+                        quote = QChar();
+                } else if (c == QLatin1Char('"') || c == QLatin1Char('\'')) {
+                    quote = c;
+                } else if (c == QLatin1Char('>')) {
+                    break;
+                }
+            }
+            ++pos;
+
+            if (name.compare(QLatin1String("script"), Qt::CaseInsensitive) == 0
+                    || name.compare(QLatin1String("style"), Qt::CaseInsensitive) == 0) {
+                if (!closing) {
+                    const QString endTag = QLatin1String("</") + name.toString();
+                    const qsizetype end = html.indexOf(endTag, pos, Qt::CaseInsensitive);
+                    pos = end < 0 ? size : end;
+                }
+            } else if (name.compare(QLatin1String("title"), Qt::CaseInsensitive) == 0) {
+                startOutput(closing ? contents : title);
+            } else if (isBlockTag(name)) {
+                pendingNewline = true;
+            }
+        } else if (ch.isSpace()) {
+            pendingSpace = true;
+            ++pos;
+        } else if (ch == QLatin1Char('&')) {
+            const qsizetype end = html.indexOf(QLatin1Char(';'), pos + 1);
+            const QChar decoded = end > pos + 1 && end - pos <= 10
+                    ? entityCharacter(html.mid(pos + 1, end - pos - 1)) : QChar();
+            if (decoded.isNull()) {
+                append(ch);
+                ++pos;
+            } else {
+                if (decoded == QLatin1Char(' '))
+                    pendingSpace = true;
+                else if (decoded.unicode() != 0xad)
+                    append(decoded);
+                pos = end + 1;
+            }
+        } else {
+            append(ch);
+            ++pos;
+        }
+    }
+}
+
+static bool useTextDocument()
+{
+    static const bool use = qEnvironmentVariableIsSet("QT_HELP_INDEX_USE_QTEXTDOCUMENT");
+    return use;
+}
+
+static void extractText(Document *document)
+{
+    QTextStream s(document->data);
+    auto encoding = QStringDecoder::encodingForHtml(document->data);
+    if (encoding)
+        s.setEncoding(*encoding);
+
+    const QString &text = s.readAll();
+    document->data = QByteArray();
+    if (text.isEmpty())
+        return;
+
+    const QString &fullFileName = document->fileName;
+    if (fullFileName.endsWith(QLatin1String(".txt"))) {
+        document->title = fullFileName.mid(fullFileName.lastIndexOf(QLatin1Char('/')) + 1);
+        document->contents = text.toHtmlEscaped();
+    } else if (useTextDocument()) {
+        QTextDocument doc;
+        doc.setHtml(text);
+
+        document->title = doc.metaInformation(QTextDocument::DocumentTitle).toHtmlEscaped();
+        document->contents = doc.toPlainText().toHtmlEscaped();
+    } else {
+        QString title;
+        QString contents;
+        extractHtmlText(text, &title, &contents);
+        document->title = title.toHtmlEscaped();
+        document->contents = contents.toHtmlEscaped();
+    }
+    document->hasText = true;
+}
+
+/*
+    Extracts the title and the plain text of the help files on worker
+    threads. The documents are added while earlier ones are taken, and at
+    most a few documents per thread are queued, which bounds the memory for
+    the file data and the extracted text.
+*/
+class TextExtractor
+{
+public:
+    explicit TextExtractor(int threadCount)
+    {
+        threadCount = qMax(1, threadCount);
+        m_window = 4 * size_t(threadCount);
+        for (int i = 0; i < threadCount; ++i) {
+            m_threads.emplace_back(QThread::create([this] { run(); }));
+            m_threads.back()->start();
+        }
+    }
+
+    ~TextExtractor()
+    {
+        cancel();
+    }
+
+    bool isFull()
+    {
+        QMutexLocker locker(&m_mutex);
+        return m_documents.size() >= m_window;
+    }
+
+    void add(Document document)
+    {
+        QMutexLocker locker(&m_mutex);
+        m_documents.push_back(std::move(document));
+        m_addedCondition.wakeOne();
+    }
+
+    // No documents are added after this.
+    void finish()
+    {
+        QMutexLocker locker(&m_mutex);
+        m_finished = true;
+        m_addedCondition.wakeAll();
+    }
+
+    // Returns the first document once its text is extracted, or nothing
+    // if there are no documents left after finish().
+    std::optional<Document> take()
+    {
+        QMutexLocker locker(&m_mutex);
+        while (m_documents.empty() ? !m_finished : !m_documents.front().extracted)
+            m_extractedCondition.wait(&m_mutex);
+        if (m_documents.empty())
+            return std::nullopt;
+        Document document = std::move(m_documents.front());
+        m_documents.pop_front();
+        ++m_taken;
+        return document;
+    }
+
+    void cancel()
+    {
+        {
+            QMutexLocker locker(&m_mutex);
+            m_cancel = true;
+            m_addedCondition.wakeAll();
+        }
+        for (const auto &thread : m_threads)
+            thread->wait();
+        m_threads.clear();
+    }
+
+private:
+    void run()
+    {
+        QMutexLocker locker(&m_mutex);
+        forever {
+            while (!m_cancel && !m_finished && m_next == m_taken + m_documents.size())
+                m_addedCondition.wait(&m_mutex);
+            if (m_cancel || m_next == m_taken + m_documents.size())
+                return;
+            // Documents stay queued until they are extracted, and the deque
+            // keeps the references to its elements when others are added
+            // or the first ones removed.
+            Document &document = m_documents[m_next++ - m_taken];
+            locker.unlock();
+            extractText(&document);
+            locker.relock();
+            document.extracted = true;
+            m_extractedCondition.wakeAll();
+        }
+    }
+
+    // The documents that are added and not taken yet
+    std::deque<Document> m_documents;
+    size_t m_next = 0;
+    size_t m_taken = 0;
+    size_t m_window = 0;
+    bool m_finished = false;
+    bool m_cancel = false;
+    std::vector<std::unique_ptr<QThread>> m_threads;
+    QMutex m_mutex;
+    QWaitCondition m_addedCondition;
+    QWaitCondition m_extractedCondition;
+};
+
+bool QHelpSearchIndexWriter::isCancelled()
+{
+    QMutexLocker lock(&m_mutex);
+    return m_cancel;
+}
+
+/*
+    Writes the documents of the namespace \a data to \a writer and flushes
+    them, extracting their text on \a extractorThreadCount threads. Does not
+    use the help engine, so that namespaces can be indexed on several
+    threads.
+*/
+QHelpSearchIndexWriter::IndexResult QHelpSearchIndexWriter::indexNamespace(
+        Writer *writer, const NamespaceData &data, int extractorThreadCount)
+{
+    const QString &namespaceName = data.namespaceName;
+    QHelpDBReader reader(data.fileName, QHelpGlobal::uniquifyConnectionName(
+                             data.fileName, this), nullptr);
+    if (!reader.init())
+        return NotIndexed;
+
+    const QString virtualFolder = reader.virtualFolder();
+
+    // The documents that are left in here once the namespace is indexed
+    // are no longer in it.
+    QHash<QString, Writer::IndexedDocument> indexedDocuments;
+    if (data.updated)
+        indexedDocuments = writer->indexedDocuments(namespaceName);
+
+    for (const QStringList &attributes : data.attributeSets) {
+        const QString &attributesString = attributes.join(QLatin1Char('|'));
+
+        QHelpDBReader::FileDataIterator it = reader.filesDataIterator(
+                attributes, { QLatin1String("html"), QLatin1String("htm"),
+                              QLatin1String("txt") });
+
+        // The text is extracted on worker threads, while this thread
+        // reads the files one at a time and writes the documents to the
+        // database in order.
+        TextExtractor extractor(extractorThreadCount);
+        bool hasMoreFiles = true;
+        forever {
+            while (hasMoreFiles && !extractor.isFull()) {
+                hasMoreFiles = it.next();
+                if (!hasMoreFiles) {
+                    extractor.finish();
+                    break;
+                }
+
+                const QByteArray compressedData = it.compressedData();
+                const QByteArray hash =
+                        QCryptographicHash::hash(compressedData, QCryptographicHash::Sha1);
+
+                QUrl url;
+                url.setScheme(QLatin1String("qthelp"));
+                url.setAuthority(namespaceName);
+                url.setPath(QLatin1Char('/') + virtualFolder + QLatin1Char('/') + it.name());
+
+                if (url.hasFragment())
+                    url.setFragment(QString());
+
+                const QString &fullFileName = url.toString();
+                if (!fullFileName.endsWith(QLatin1String(".html"))
+                        && !fullFileName.endsWith(QLatin1String(".htm"))
+                        && !fullFileName.endsWith(QLatin1String(".txt"))) {
+                    continue;
+                }
+
+                const auto indexed = indexedDocuments.constFind(
+                            Writer::documentKey(attributesString, fullFileName));
+                if (indexed != indexedDocuments.cend()) {
+                    const bool unchanged = indexed->hash == hash;
+                    if (!unchanged)
+                        writer->removeDoc(indexed->id);
+                    indexedDocuments.erase(indexed);
+                    if (unchanged)
+                        continue;
+                }
+
+                const QByteArray data = it.data();
+                if (data.isEmpty())
+                    continue;
+                extractor.add({ fullFileName, data, QString(), QString(), hash });
+            }
+
+            const std::optional<Document> document = extractor.take();
+            if (!document)
+                break;
+
+            if (isCancelled()) {
+                extractor.cancel();
+                return Cancelled;
+            }
+
+            if (!document->hasText)
+                continue;
+
+            writer->insertDoc(namespaceName, attributesString, document->fileName,
+                              document->title, document->contents, document->hash);
+        }
+    }
+    for (const Writer::IndexedDocument &removed : std::as_const(indexedDocuments))
+        writer->removeDoc(removed.id);
+    writer->flush();
+    return Indexed;
 }
 
 void QHelpSearchIndexWriter::run()
@@ -335,6 +946,7 @@ void QHelpSearchIndexWriter::run()
         return;
 
     const bool reindex(m_reindex);
+    const bool sharded(m_sharded);
     const QString collectionFile(m_collectionFile);
     const QString indexPath(m_indexFilesFolder);
 
@@ -344,27 +956,45 @@ void QHelpSearchIndexWriter::run()
     if (!engine.setupData())
         return;
 
-    if (reindex)
-        clearIndexMap(&engine);
-
     emit indexingStarted();
 
+    if (sharded)
+        indexSharded(&engine, indexPath, reindex);
+    else
+        indexShared(&engine, indexPath, reindex);
+
+    emit indexingFinished();
+}
+
+// Indexes all namespaces into the one database they share.
+void QHelpSearchIndexWriter::indexShared(QHelpEngineCore *engine, const QString &indexPath,
+                                         bool reindex)
+{
+    // The index may have been sharded before.
+    QDir(Writer::shardsPath(indexPath)).removeRecursively();
+    clearIndexMap(engine, ShardedNamespacesKey);
+
+    if (reindex)
+        clearIndexMap(engine);
+
     Writer writer(indexPath);
 
     while (!writer.tryInit(reindex))
         sleep(1);
 
-    const QStringList &registeredDocs = engine.registeredDocumentations();
-    QMap<QString, QDateTime> indexMap = readIndexMap(engine);
+    const QStringList &registeredDocs = engine->registeredDocumentations();
+    QMap<QString, QDateTime> indexMap = readIndexMap(*engine);
+    // The namespaces whose files are compared with the indexed ones
+    QSet<QString> updatedNamespaces;
 
     if (!reindex) {
         for (const QString &namespaceName : registeredDocs) {
             if (indexMap.contains(namespaceName)) {
-                const QString path = engine.documentationFileName(namespaceName);
+                const QString path = engine->documentationFileName(namespaceName);
                 if (indexMap.value(namespaceName) < QFileInfo(path).lastModified()) {
-                    // Remove some outdated indexed stuff
+                    // Only the files that changed are indexed again
                     indexMap.remove(namespaceName);
-                    writer.removeNamespace(namespaceName);
+                    updatedNamespaces.insert(namespaceName);
                 } else if (!writer.hasNamespace(namespaceName)) {
                     // No data in fts db for namespace.
                     // The namespace could have been removed from fts db
@@ -394,111 +1024,118 @@ void QHelpSearchIndexWriter::run()
     }
 
     for (const QString &namespaceName : registeredDocs) {
-        lock.relock();
-        if (m_cancel) {
-            // store what we have done so far
-            writeIndexMap(&engine, indexMap);
-            writer.endTransaction();
-            emit indexingFinished();
-            return;
-        }
-        lock.unlock();
+        if (isCancelled())
+            break;
 
         // if indexed, continue
         if (indexMap.contains(namespaceName))
             continue;
 
-        const QString fileName = engine.documentationFileName(namespaceName);
-        QHelpDBReader reader(fileName, QHelpGlobal::uniquifyConnectionName(
-                                 fileName, this), nullptr);
-        if (!reader.init())
-            continue;
+        NamespaceData data;
+        data.namespaceName = namespaceName;
+        data.fileName = engine->documentationFileName(namespaceName);
+        data.attributeSets = engine->filterAttributeSets(namespaceName);
+        data.updated = updatedNamespaces.contains(namespaceName);
+
+        const IndexResult result = indexNamespace(&writer, data, QThread::idealThreadCount());
+        if (result == Cancelled)
+            break; // store what we have done so far
+        if (result == Indexed)
+            indexMap.insert(namespaceName, QFileInfo(data.fileName).lastModified());
+    }
 
-        const QString virtualFolder = reader.virtualFolder();
+    // If the index could not be stored, everything is indexed again next time.
+    if (writer.endTransaction())
+        writeIndexMap(engine, indexMap);
+    else
+        clearIndexMap(engine);
+}
 
-        const QList<QStringList> &attributeSets =
-            engine.filterAttributeSets(namespaceName);
+/*
+    Indexes every namespace into a database of its own, several of them at
+    a time. Removing a namespace just removes its database, and indexing a
+    new one does not write to those of the others.
+*/
+void QHelpSearchIndexWriter::indexSharded(QHelpEngineCore *engine, const QString &indexPath,
+                                          bool reindex)
+{
+    // The index may have been shared before.
+    QFile::remove(indexPath + QLatin1Char('/') + QLatin1String(FTS_DB_NAME));
+    clearIndexMap(engine);
+
+    const QString shardsPath = Writer::shardsPath(indexPath);
+    QDir shardsDir(shardsPath);
+    if (reindex) {
+        clearIndexMap(engine, ShardedNamespacesKey);
+        shardsDir.removeRecursively();
+    }
+    shardsDir.mkpath(QLatin1String("."));
 
-        for (const QStringList &attributes : attributeSets) {
-            const QString &attributesString = attributes.join(QLatin1Char('|'));
+    const QStringList &registeredDocs = engine->registeredDocumentations();
+    QMap<QString, QDateTime> indexMap = readIndexMap(*engine, ShardedNamespacesKey);
 
-            const QMultiMap<QString, QByteArray> htmlFiles =
-                    reader.filesData(attributes, QLatin1String("html"));
-            const QMultiMap<QString, QByteArray> htmFiles =
-                    reader.filesData(attributes, QLatin1String("htm"));
-            const QMultiMap<QString, QByteArray> txtFiles =
-                    reader.filesData(attributes, QLatin1String("txt"));
+    // Remove the shards of the namespaces that are gone.
+    const QStringList shardFiles = shardsDir.entryList(QDir::Files);
+    for (const QString &shardFile : shardFiles) {
+        if (!registeredDocs.contains(Writer::shardNamespace(shardFile)))
+            shardsDir.remove(shardFile);
+    }
+    for (const QString &namespaceName : indexMap.keys()) {
+        if (!registeredDocs.contains(namespaceName))
+            indexMap.remove(namespaceName);
+    }
 
-            QMultiMap<QString, QByteArray> files = htmlFiles;
-            files.unite(htmFiles);
-            files.unite(txtFiles);
+    std::vector<NamespaceData> namespaces;
+    for (const QString &namespaceName : registeredDocs) {
+        const QString shardFile = Writer::shardFileName(namespaceName);
+        NamespaceData data;
+        data.namespaceName = namespaceName;
+        data.fileName = engine->documentationFileName(namespaceName);
+        if (indexMap.contains(namespaceName) && shardsDir.exists(shardFile)) {
+            if (!(indexMap.value(namespaceName) < QFileInfo(data.fileName).lastModified()))
+                continue;
+            data.updated = true;
+        } else {
+            // Whatever is in the shard is not known to be complete.
+            shardsDir.remove(shardFile);
+        }
+        indexMap.remove(namespaceName);
+        data.attributeSets = engine->filterAttributeSets(namespaceName);
+        namespaces.push_back(data);
+    }
 
-            for (auto it = files.cbegin(), end = files.cend(); it != end ; ++it) {
-                lock.relock();
-                if (m_cancel) {
-                    // store what we have done so far
-                    writeIndexMap(&engine, indexMap);
-                    writer.endTransaction();
-                    emit indexingFinished();
+    // Each shard extracts the text of its files on several threads, which
+    // share the ideal thread count with the other shards indexed meanwhile.
+    QMutex indexMapMutex;
+    QAtomicInt next = 0;
+    const int threadCount = qMin(qMax(1, QThread::idealThreadCount() / 2),
+                                 int(namespaces.size()));
+    const int extractorThreadCount = qMax(1, QThread::idealThreadCount() / qMax(1, threadCount));
+    std::vector<std::unique_ptr<QThread>> threads;
+    for (int i = 0; i < threadCount; ++i) {
+        threads.emplace_back(QThread::create([&] {
+            for (int j = next.fetchAndAddRelaxed(1); j < int(namespaces.size());
+                 j = next.fetchAndAddRelaxed(1)) {
+                if (isCancelled())
                     return;
+                const NamespaceData &data = namespaces[j];
+                Writer writer(shardsPath, Writer::shardFileName(data.namespaceName));
+                while (!writer.tryInit(!data.updated))
+                    QThread::sleep(1);
+                const IndexResult result = indexNamespace(&writer, data, extractorThreadCount);
+                if (writer.endTransaction() && result == Indexed) {
+                    QMutexLocker locker(&indexMapMutex);
+                    indexMap.insert(data.namespaceName,
+                                    QFileInfo(data.fileName).lastModified());
                 }
-                lock.unlock();
-
-                const QString &file = it.key();
-                const QByteArray &data = it.value();
-
-                if (data.isEmpty())
-                    continue;
-
-                QUrl url;
-                url.setScheme(QLatin1String("qthelp"));
-                url.setAuthority(namespaceName);
-                url.setPath(QLatin1Char('/') + virtualFolder + QLatin1Char('/') + file);
-
-                if (url.hasFragment())
-                    url.setFragment(QString());
-
-                const QString &fullFileName = url.toString();
-                if (!fullFileName.endsWith(QLatin1String(".html"))
-                        && !fullFileName.endsWith(QLatin1String(".htm"))
-                        && !fullFileName.endsWith(QLatin1String(".txt"))) {
-                    continue;
-                }
-
-                QTextStream s(data);
-                auto encoding = QStringDecoder::encodingForHtml(data);
-                if (encoding)
-                    s.setEncoding(*encoding);
-
-                const QString &text = s.readAll();
-                if (text.isEmpty())
-                    continue;
-
-                QString title;
-                QString contents;
-                if (fullFileName.endsWith(QLatin1String(".txt"))) {
-                    title = fullFileName.mid(fullFileName.lastIndexOf(QLatin1Char('/')) + 1);
-                    contents = text.toHtmlEscaped();
-                } else {
-                    QTextDocument doc;
-                    doc.setHtml(text);
-
-                    title = doc.metaInformation(QTextDocument::DocumentTitle).toHtmlEscaped();
-                    contents = doc.toPlainText().toHtmlEscaped();
-                }
-
-                writer.insertDoc(namespaceName, attributesString, fullFileName, title, contents);
             }
-        }
-        writer.flush();
-        const QString &path = engine.documentationFileName(namespaceName);
-        indexMap.insert(namespaceName, QFileInfo(path).lastModified());
+        }));
+        threads.back()->start();
     }
+    for (const auto &thread : threads)
+        thread->wait();
 
-    writeIndexMap(&engine, indexMap);
-
-    writer.endTransaction();
-    emit indexingFinished();
+    writeIndexMap(engine, indexMap, ShardedNamespacesKey);
 }
 
 }   // namespace std
@@ -15,10 +15,13 @@
 // We mean it.
 //
 
+#include <QtCore/QHash>
 #include <QtCore/QMutex>
+#include <QtCore/QStringList>
 #include <QtCore/QThread>
 
 QT_FORWARD_DECLARE_CLASS(QSqlDatabase)
+QT_FORWARD_DECLARE_CLASS(QHelpEngineCore)
 
 QT_BEGIN_NAMESPACE
 
@@ -28,9 +31,20 @@ namespace qt {
 class Writer
 {
 public:
-    Writer(const QString &path);
+    struct IndexedDocument
+    {
+        qint64 id;
+        QByteArray hash;
+    };
+
+    explicit Writer(const QString &path, const QString &dbName = QString());
     ~Writer();
 
+    // A sharded index keeps one database per namespace in this directory.
+    static QString shardsPath(const QString &indexPath);
+    static QString shardFileName(const QString &namespaceName);
+    static QString shardNamespace(const QString &shardFileName);
+
     bool tryInit(bool reindex);
     void flush();
 
@@ -40,24 +54,37 @@ public:
                    const QString &attributes,
                    const QString &url,
                    const QString &title,
-                   const QString &contents);
+                   const QString &contents,
+                   const QByteArray &hash);
+    QHash<QString, IndexedDocument> indexedDocuments(const QString &namespaceName);
+    static QString documentKey(const QString &attributes, const QString &url);
+    void removeDoc(qint64 id);
     void startTransaction();
-    void endTransaction();
+    bool endTransaction();
 private:
     void init(bool reindex);
+    bool openBulkLoadDatabase();
+    void closeBulkLoadDatabase();
+    void closeDatabase();
     bool hasDB();
     void clearLegacyIndex();
 
     const QString m_dbDir;
+    QString m_dbPath;
+    // The database a new index is built in, see init()
+    QString m_bulkLoadPath;
     QString m_uniqueId;
 
     bool m_needOptimize = false;
+    bool m_bulkLoad = false;
     QSqlDatabase *m_db = nullptr;
     QVariantList m_namespaces;
     QVariantList m_attributes;
     QVariantList m_urls;
     QVariantList m_titles;
     QVariantList m_contents;
+    QVariantList m_hashes;
+    QVariantList m_removedIds;
 };
 
 
@@ -71,20 +98,39 @@ public:
 
     void cancelIndexing();
     void updateIndex(const QString &collectionFile,
-        const QString &indexFilesFolder, bool reindex);
+        const QString &indexFilesFolder, bool reindex,
+        bool sharded = false);
 
 signals:
     void indexingStarted();
     void indexingFinished();
 
 private:
+    struct NamespaceData
+    {
+        QString namespaceName;
+        QString fileName;
+        QList<QStringList> attributeSets;
+        // Whether only the files that changed since the last indexing
+        // are indexed again
+        bool updated = false;
+    };
+
+    enum IndexResult { Indexed, NotIndexed, Cancelled };
+
     void run() override;
+    void indexShared(QHelpEngineCore *engine, const QString &indexPath, bool reindex);
+    void indexSharded(QHelpEngineCore *engine, const QString &indexPath, bool reindex);
+    IndexResult indexNamespace(Writer *writer, const NamespaceData &data,
+                               int extractorThreadCount);
+    bool isCancelled();
 
 private:
     QMutex m_mutex;
 
     bool m_cancel;
     bool m_reindex;
+    bool m_sharded = false;
     QString m_collectionFile;
     QString m_indexFilesFolder;
 };
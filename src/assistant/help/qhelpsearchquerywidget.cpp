@@ -6,6 +6,7 @@
 #include <QtCore/QAbstractListModel>
 #include <QtCore/QObject>
 #include <QtCore/QStringList>
+#include <QtCore/QTimer>
 #include <QtCore/QtGlobal>
 
 #include <QtWidgets/QCompleter>
@@ -138,6 +139,10 @@ private slots:
 
     void searchRequested()
     {
+        // Searches while typing are not remembered in the history.
+        if (m_isLiveSearch)
+            return;
+        m_liveSearchInput.clear();
         saveQuery(m_lineEdit->text());
         m_queries.curQuery = m_queries.queries.size() - 1;
         if (m_queries.curQuery > 0)
@@ -167,6 +172,11 @@ private:
     QueryHistory m_queries;
     QCompleter m_searchCompleter;
     bool m_compactMode = false;
+
+    QTimer m_liveSearchTimer;
+    QString m_liveSearchInput;
+    bool m_liveSearchEnabled = false;
+    bool m_isLiveSearch = false;
 };
 
 /*!
@@ -230,6 +240,26 @@ QHelpSearchQueryWidget::QHelpSearchQueryWidget(QWidget *parent)
     d->retranslate();
     connect(this, &QHelpSearchQueryWidget::search,
             d, &QHelpSearchQueryWidgetPrivate::searchRequested);
+
+    // Typing only starts a search once it pauses, the searches for the
+    // input in between would be cancelled anyway.
+    d->m_liveSearchTimer.setSingleShot(true);
+    d->m_liveSearchTimer.setInterval(250);
+    connect(d->m_lineEdit, &QLineEdit::textEdited, &d->m_liveSearchTimer, [this] {
+        if (d->m_liveSearchEnabled)
+            d->m_liveSearchTimer.start();
+    });
+    connect(d->m_lineEdit, &QLineEdit::returnPressed,
+            &d->m_liveSearchTimer, &QTimer::stop);
+    connect(&d->m_liveSearchTimer, &QTimer::timeout, this, [this] {
+        const QString input = d->m_lineEdit->text().trimmed();
+        if (input.isEmpty())
+            return;
+        d->m_liveSearchInput = input;
+        d->m_isLiveSearch = true;
+        emit search();
+        d->m_isLiveSearch = false;
+    });
     setCompactMode(true);
 }
 
@@ -292,6 +322,8 @@ void QHelpSearchQueryWidget::setQuery(const QList<QHelpSearchQuery> &queryList)
 */
 QString QHelpSearchQueryWidget::searchInput() const
 {
+    if (!d->m_liveSearchInput.isEmpty())
+        return d->m_liveSearchInput;
     if (d->m_queries.queries.isEmpty())
         return QString();
     return d->m_queries.queries.last();
@@ -330,6 +362,39 @@ void QHelpSearchQueryWidget::setCompactMode(bool on)
     }
 }
 
+/*!
+    \since 6.5
+
+    Returns whether the search() signal is also emitted while the user
+    types, once typing pauses.
+
+    \sa setLiveSearchEnabled()
+*/
+bool QHelpSearchQueryWidget::isLiveSearchEnabled() const
+{
+    return d->m_liveSearchEnabled;
+}
+
+/*!
+    \since 6.5
+
+    Sets whether the search() signal is also emitted while the user types
+    to \a enabled. The searches while typing are not added to the history
+    of searches, and searchInput() returns the input typed so far.
+
+    When the widget is the query widget of a QHelpSearchEngine, the
+    last word of the search input then also matches the words it is the
+    beginning of.
+
+    Live search is disabled by default.
+*/
+void QHelpSearchQueryWidget::setLiveSearchEnabled(bool enabled)
+{
+    d->m_liveSearchEnabled = enabled;
+    if (!enabled)
+        d->m_liveSearchTimer.stop();
+}
+
 /*!
     \reimp
 */
@@ -41,6 +41,9 @@ public:
     bool isCompactMode() const;
     Q_SLOT void setCompactMode(bool on);
 
+    bool isLiveSearchEnabled() const;
+    void setLiveSearchEnabled(bool enabled);
+
 Q_SIGNALS:
     void search();
 
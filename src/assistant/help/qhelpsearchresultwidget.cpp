@@ -276,6 +276,8 @@ QHelpSearchResultWidget::QHelpSearchResultWidget(QHelpSearchEngine *engine)
     connect(d->previousResultPage, &QAbstractButton::clicked,
             d, &QHelpSearchResultWidgetPrivate::showPreviousResultPage);
 
+    connect(engine, &QHelpSearchEngine::searchResultsAvailable,
+            d, &QHelpSearchResultWidgetPrivate::showFirstResultPage);
     connect(engine, &QHelpSearchEngine::searchingFinished,
             d, &QHelpSearchResultWidgetPrivate::showFirstResultPage);
 }
@@ -17,10 +17,16 @@
 #include <QtCore/QVariant>
 #include <QtCore/QDateTime>
 #include <QtCore/QStringConverter>
+#include <QtCore/QThreadPool>
+#include <QtCore/QMutex>
+#include <QtCore/QAtomicInt>
+#include <QtCore/QHash>
 #include <QtCore/QDataStream>
+#include <QtSql/QSqlDatabase>
 #include <QtSql/QSqlQuery>
 
 #include <stdio.h>
+#include <utility>
 
 QT_BEGIN_NAMESPACE
 
@@ -36,6 +42,9 @@ public:
     bool checkLinks(const QHelpProjectData &helpData);
     QString error() const;
 
+    bool m_storeIncompressibleFiles = false;
+    bool m_reuseUnchangedFiles = false;
+
 Q_SIGNALS:
     void statusChanged(const QString &msg);
     void progressChanged(double progress);
@@ -49,7 +58,7 @@ private:
         QString title;
     };
 
-    void writeTree(QDataStream &s, QHelpDataContentItem *item, int depth);
+    static void writeTree(QDataStream &s, QHelpDataContentItem *item, int depth);
     bool createTables();
     bool insertFileNotFoundFile();
     bool registerCustomFilter(const QString &filterName,
@@ -64,6 +73,7 @@ private:
         const QStringList &filterAttributes);
     bool insertMetaData(const QMap<QString, QVariant> &metaData);
     void cleanupDB();
+    void readPreviousFiles(const QString &fileName);
     void setupProgress(QHelpProjectData *helpData);
     void addProgress(double step);
 
@@ -75,12 +85,17 @@ private:
 
     QMap<QString, int> m_fileMap;
     QMap<int, QSet<int> > m_fileFilterMap;
+    // The stored data and compression of the files of a previous build
+    QHash<QString, std::pair<QByteArray, int>> m_previousFiles;
 
     double m_progress;
     double m_oldProgress;
     double m_contentStep;
     double m_fileStep;
     double m_indexStep;
+
+    // Keep the values bound to one statement below SQLite's default limit of 999
+    enum { KeywordColumns = 5, KeywordsPerInsert = 150 };
 };
 
 /*!
@@ -105,8 +120,12 @@ bool HelpGeneratorPrivate::generate(QHelpProjectData *helpData,
     }
 
     QFileInfo fi(outFileName);
+    m_previousFiles.clear();
     if (fi.exists()) {
+        if (m_reuseUnchangedFiles)
+            readPreviousFiles(outFileName);
         if (!fi.dir().remove(fi.fileName())) {
+            m_previousFiles.clear();
             m_error = tr("The file %1 cannot be overwritten.").arg(outFileName);
             return false;
         }
@@ -159,11 +178,20 @@ bool HelpGeneratorPrivate::generate(QHelpProjectData *helpData,
         emit statusChanged(tr("Insert help data for filter section (%1 of %2)...")
             .arg(i++).arg(helpData->filterSections().count()));
         insertFilterAttributes(fs.filterAttributes());
+
+        /* Serialize the contents tree while the files get compressed,
+           both only read the help data. */
         QByteArray ba;
-        QDataStream s(&ba, QIODevice::WriteOnly);
-        for (QHelpDataContentItem *itm : fs.contents())
-            writeTree(s, itm, 0);
-        if (!insertFiles(fs.files(), helpData->rootPath(), fs.filterAttributes())
+        QThreadPool serializer;
+        serializer.start([&ba, &fs] {
+            QDataStream s(&ba, QIODevice::WriteOnly);
+            for (QHelpDataContentItem *itm : fs.contents())
+                writeTree(s, itm, 0);
+        });
+        const bool filesInserted = insertFiles(fs.files(), helpData->rootPath(),
+                                               fs.filterAttributes());
+        serializer.waitForDone();
+        if (!filesInserted
             || !insertContents(ba, fs.filterAttributes())
             || !insertKeywords(fs.indices(), fs.filterAttributes())) {
             cleanupDB();
@@ -172,6 +200,7 @@ bool HelpGeneratorPrivate::generate(QHelpProjectData *helpData,
     }
 
     cleanupDB();
+    m_previousFiles.clear();
     emit progressChanged(100);
     emit statusChanged(tr("Documentation successfully generated."));
     return true;
@@ -217,6 +246,44 @@ void HelpGeneratorPrivate::cleanupDB()
     QSqlDatabase::removeDatabase(QLatin1String("builder"));
 }
 
+/*
+    Reads the stored data of all files of the help file \a fileName, so that
+    files which did not change since it was generated need not be
+    compressed again.
+*/
+void HelpGeneratorPrivate::readPreviousFiles(const QString &fileName)
+{
+    emit statusChanged(tr("Reading previous help file..."));
+    const QString connectionName = QLatin1String("previousBuilder");
+    {
+        QSqlDatabase db = QSqlDatabase::addDatabase(QLatin1String("QSQLITE"), connectionName);
+        db.setDatabaseName(fileName);
+        db.setConnectOptions(QLatin1String("QSQLITE_OPEN_READONLY"));
+        if (db.open()) {
+            QSqlQuery query(db);
+            bool hasCompressionColumn = false;
+            query.exec(QLatin1String("PRAGMA table_info(FileDataTable)"));
+            while (query.next()) {
+                if (query.value(1).toString() == QLatin1String("Compression"))
+                    hasCompressionColumn = true;
+            }
+
+            query.setForwardOnly(true);
+            query.exec(QString::fromLatin1("SELECT FileNameTable.Name, FileDataTable.Data, %1 "
+                                           "FROM FileNameTable, FileDataTable "
+                                           "WHERE FileNameTable.FileId = FileDataTable.Id")
+                       .arg(hasCompressionColumn
+                            ? QLatin1String("FileDataTable.Compression")
+                            : QLatin1String("0")));
+            while (query.next()) {
+                m_previousFiles.insert(query.value(0).toString(),
+                                       { query.value(1).toByteArray(), query.value(2).toInt() });
+            }
+        }
+    }
+    QSqlDatabase::removeDatabase(connectionName);
+}
+
 void HelpGeneratorPrivate::writeTree(QDataStream &s, QHelpDataContentItem *item, int depth)
 {
     s << depth;
@@ -280,9 +347,14 @@ bool HelpGeneratorPrivate::createTables()
             << QLatin1String("CREATE TABLE FileAttributeSetTable ("
                              "Id INTEGER, "
                              "FilterAttributeId INTEGER )")
-            << QLatin1String("CREATE TABLE FileDataTable ("
-                             "Id INTEGER PRIMARY KEY, "
-                             "Data BLOB )")
+            << (m_storeIncompressibleFiles
+                ? QLatin1String("CREATE TABLE FileDataTable ("
+                                "Id INTEGER PRIMARY KEY, "
+                                "Data BLOB, "
+                                "Compression INTEGER DEFAULT 0 )")
+                : QLatin1String("CREATE TABLE FileDataTable ("
+                                "Id INTEGER PRIMARY KEY, "
+                                "Data BLOB )"))
             << QLatin1String("CREATE TABLE FileFilterTable ("
                              "FilterAttributeId INTEGER, "
                              "FileId INTEGER )")
@@ -306,7 +378,10 @@ bool HelpGeneratorPrivate::createTables()
         }
     }
 
-    m_query->exec(QLatin1String("INSERT INTO MetaDataTable VALUES('qchVersion', '1.0')"));
+    // Version 1.1 files have the Compression column in FileDataTable.
+    m_query->exec(m_storeIncompressibleFiles
+                  ? QLatin1String("INSERT INTO MetaDataTable VALUES('qchVersion', '1.1')")
+                  : QLatin1String("INSERT INTO MetaDataTable VALUES('qchVersion', '1.0')"));
 
     return true;
 }
@@ -320,7 +395,7 @@ bool HelpGeneratorPrivate::insertFileNotFoundFile()
     if (m_query->next() && m_query->isValid())
         return true;
 
-    m_query->prepare(QLatin1String("INSERT INTO FileDataTable VALUES (Null, ?)"));
+    m_query->prepare(QLatin1String("INSERT INTO FileDataTable (Id, Data) VALUES (Null, ?)"));
     m_query->bindValue(0, QByteArray());
     if (!m_query->exec())
         return false;
@@ -426,49 +501,120 @@ bool HelpGeneratorPrivate::insertFiles(const QStringList &files, const QString &
     if (m_query->next())
         tableFileId = m_query->value(0).toInt() + 1;
 
-    QString title;
-    QString charSet;
-    QList<QByteArray> fileDataList;
-    QMap<int, QSet<int> > tmpFileFilterMap;
-    QList<FileNameTableData> fileNameDataList;
+    // The values of QHelpDBReader::FileCompression
+    enum { ZlibCompression = 0, NoCompression = 1 };
 
-    int i = 0;
+    struct FileJob
+    {
+        QString fileName;
+        QString filePath;
+        QByteArray data;
+        QString title;
+        int compression = ZlibCompression;
+        bool opened = false;
+    };
+
+    /* Only files which are not part of the help file yet need to be read;
+       for the others just the filter attributes get updated below. */
+    QList<FileJob> jobs;
+    QSet<QString> scheduledFiles;
     for (const QString &file : files) {
         const QString fileName = QDir::cleanPath(file);
-
-        QFile fi(rootPath + QDir::separator() + fileName);
-        if (!fi.exists()) {
-            emit warning(tr("The file %1 does not exist, skipping it...")
-                .arg(QDir::cleanPath(rootPath + QDir::separator() + fileName)));
+        if (m_fileMap.contains(fileName) || scheduledFiles.contains(fileName))
             continue;
-        }
+        scheduledFiles.insert(fileName);
+        FileJob job;
+        job.fileName = fileName;
+        job.filePath = QDir::cleanPath(rootPath + QDir::separator() + fileName);
+        jobs.append(job);
+    }
 
-        if (!fi.open(QIODevice::ReadOnly)) {
-            emit warning(tr("Cannot open file %1, skipping it...")
-                .arg(QDir::cleanPath(rootPath + QDir::separator() + fileName)));
-            continue;
-        }
+    /* Reading, decoding and compressing the files is independent of each
+       other and by far the most expensive part, so spread it over all cores.
+       The results are inserted in the original order afterwards. */
+    const bool storeIncompressibleFiles = m_storeIncompressibleFiles;
+    const QHash<QString, std::pair<QByteArray, int>> &previousFiles = m_previousFiles;
+    QAtomicInt reusedFiles;
+    QThreadPool pool;
+    for (FileJob &job : jobs) {
+        pool.start([&job, &previousFiles, &reusedFiles, storeIncompressibleFiles] {
+            QFile fi(job.filePath);
+            if (!fi.open(QIODevice::ReadOnly))
+                return;
+            job.opened = true;
+
+            const QByteArray data = fi.readAll();
+            if (job.fileName.endsWith(QLatin1String(".html"))
+                || job.fileName.endsWith(QLatin1String(".htm"))) {
+                auto encoding = QStringDecoder::encodingForHtml(data);
+                if (!encoding)
+                    encoding = QStringDecoder::Utf8;
+                job.title = QHelpGlobal::documentTitle(QStringDecoder(*encoding)(data));
+            } else {
+                job.title = job.fileName.mid(job.fileName.lastIndexOf(QLatin1Char('/')) + 1);
+            }
 
-        QByteArray data = fi.readAll();
-        if (fileName.endsWith(QLatin1String(".html"))
-            || fileName.endsWith(QLatin1String(".htm"))) {
-            auto encoding = QStringDecoder::encodingForHtml(data);
-            if (!encoding)
-                encoding = QStringDecoder::Utf8;
-            title = QHelpGlobal::documentTitle(QStringDecoder(*encoding)(data));
-        } else {
-            title = fileName.mid(fileName.lastIndexOf(QLatin1Char('/')) + 1);
-        }
+            /* Keep the stored data of unchanged files, unless the
+               layout of the new help file cannot express it. */
+            const auto previous = previousFiles.constFind(job.fileName);
+            if (previous != previousFiles.cend()
+                && (storeIncompressibleFiles || previous->second == ZlibCompression)) {
+                const QByteArray &previousData = previous->second == NoCompression
+                        ? previous->first : qUncompress(previous->first);
+                if (previousData == data) {
+                    job.data = previous->first;
+                    job.compression = previous->second;
+                    reusedFiles.ref();
+                    return;
+                }
+            }
+
+            job.data = qCompress(data);
+            // Images and the like would only be uncompressed in vain.
+            if (storeIncompressibleFiles && job.data.size() >= data.size() * 9 / 10) {
+                job.data = data;
+                job.compression = NoCompression;
+            }
+        });
+    }
+    pool.waitForDone();
+    if (reusedFiles.loadRelaxed() > 0)
+        emit statusChanged(tr("Reused %n unchanged file(s)...", nullptr, reusedFiles.loadRelaxed()));
+
+    QHash<QString, const FileJob *> jobForFile;
+    jobForFile.reserve(jobs.size());
+    for (const FileJob &job : qAsConst(jobs))
+        jobForFile.insert(job.fileName, &job);
+
+    QList<std::pair<QByteArray, int>> fileDataList;
+    QMap<int, QSet<int> > tmpFileFilterMap;
+    QList<FileNameTableData> fileNameDataList;
+
+    int i = 0;
+    for (const QString &file : files) {
+        const QString fileName = QDir::cleanPath(file);
 
         int fileId = -1;
         const auto &it = m_fileMap.constFind(fileName);
         if (it == m_fileMap.cend()) {
-            fileDataList.append(qCompress(data));
+            const FileJob *job = jobForFile.value(fileName);
+            if (!job)
+                continue;
+            if (!job->opened) {
+                if (QFileInfo::exists(job->filePath))
+                    emit warning(tr("Cannot open file %1, skipping it...").arg(job->filePath));
+                else
+                    emit warning(tr("The file %1 does not exist, skipping it...").arg(job->filePath));
+                jobForFile.remove(fileName);
+                continue;
+            }
+
+            fileDataList.append({ job->data, job->compression });
 
             FileNameTableData fileNameData;
             fileNameData.name = fileName;
             fileNameData.fileId = tableFileId;
-            fileNameData.title = title;
+            fileNameData.title = job->title;
             fileNameDataList.append(fileNameData);
 
             m_fileMap.insert(fileName, tableFileId);
@@ -492,30 +638,38 @@ bool HelpGeneratorPrivate::insertFiles(const QStringList &files, const QString &
 
     if (!tmpFileFilterMap.isEmpty()) {
         m_query->exec(QLatin1String("BEGIN"));
+        m_query->prepare(QLatin1String("INSERT INTO FileFilterTable "
+            "VALUES(?, ?)"));
         for (auto it = tmpFileFilterMap.cbegin(), end = tmpFileFilterMap.cend(); it != end; ++it) {
             QList<int> filterValues = it.value().values();
             std::sort(filterValues.begin(), filterValues.end());
             for (int fv : qAsConst(filterValues)) {
-                m_query->prepare(QLatin1String("INSERT INTO FileFilterTable "
-                    "VALUES(?, ?)"));
                 m_query->bindValue(0, fv);
                 m_query->bindValue(1, it.key());
                 m_query->exec();
             }
         }
 
-        for (const QByteArray &fileData : qAsConst(fileDataList)) {
+        if (m_storeIncompressibleFiles) {
+            m_query->prepare(QLatin1String("INSERT INTO FileDataTable "
+                "(Id, Data, Compression) VALUES (Null, ?, ?)"));
+        } else {
             m_query->prepare(QLatin1String("INSERT INTO FileDataTable VALUES "
                 "(Null, ?)"));
-            m_query->bindValue(0, fileData);
+        }
+        for (const auto &fileData : qAsConst(fileDataList)) {
+            m_query->bindValue(0, fileData.first);
+            if (m_storeIncompressibleFiles)
+                m_query->bindValue(1, fileData.second);
             m_query->exec();
             if (++i % 20 == 0)
                 addProgress(m_fileStep * 20.0);
         }
+        fileDataList.clear();
 
+        m_query->prepare(QLatin1String("INSERT INTO FileNameTable "
+            "(FolderId, Name, FileId, Title) VALUES (?, ?, ?, ?)"));
         for (const FileNameTableData &fnd : qAsConst(fileNameDataList)) {
-            m_query->prepare(QLatin1String("INSERT INTO FileNameTable "
-                "(FolderId, Name, FileId, Title) VALUES (?, ?, ?, ?)"));
             m_query->bindValue(0, 1);
             m_query->bindValue(1, fnd.name);
             m_query->bindValue(2, fnd.fileId);
@@ -615,10 +769,30 @@ bool HelpGeneratorPrivate::insertKeywords(const QList<QHelpDataIndexItem> &keywo
             filterAtts.append(m_query->value(0).toInt());
     }
 
-    QList<int> indexFilterTable;
+    const int firstIndexId = indexId;
+
+    /* The keywords are inserted with multi-row statements, which saves most
+       of the per-statement overhead of SQLite for large indices. Only the
+       statement for the last, partial batch needs to be prepared anew. */
+    const auto insertStatement = [](int rows) {
+        QString statement = QLatin1String("INSERT INTO IndexTable (Name, Identifier, NamespaceId, FileId, Anchor) "
+            "VALUES");
+        for (int row = 0; row < rows; ++row)
+            statement += row ? QLatin1String(", (?, ?, ?, ?, ?)") : QLatin1String("(?, ?, ?, ?, ?)");
+        return statement;
+    };
+    QVariantList batch;
+    batch.reserve(KeywordsPerInsert * KeywordColumns);
+    const auto flushBatch = [this, &batch] {
+        for (int value = 0; value < batch.size(); ++value)
+            m_query->bindValue(value, batch.at(value));
+        m_query->exec();
+        batch.clear();
+    };
 
     int i = 0;
     m_query->exec(QLatin1String("BEGIN"));
+    m_query->prepare(insertStatement(KeywordsPerInsert));
     QSet<QString> indices;
     for (const QHelpDataIndexItem &itm : keywords) {
          // Identical ids make no sense and just confuse the Assistant user,
@@ -640,30 +814,30 @@ bool HelpGeneratorPrivate::insertKeywords(const QList<QHelpDataIndexItem> &keywo
         const auto &it = m_fileMap.constFind(fName);
         const int fileId = it == m_fileMap.cend() ? 1 : it.value();
 
-        m_query->prepare(QLatin1String("INSERT INTO IndexTable (Name, Identifier, NamespaceId, FileId, Anchor) "
-            "VALUES(?, ?, ?, ?, ?)"));
-        m_query->bindValue(0, itm.name);
-        m_query->bindValue(1, itm.identifier);
-        m_query->bindValue(2, m_namespaceId);
-        m_query->bindValue(3, fileId);
-        m_query->bindValue(4, anchor);
-        m_query->exec();
+        batch << itm.name << itm.identifier << m_namespaceId << fileId << anchor;
+        if (batch.size() == KeywordsPerInsert * KeywordColumns)
+            flushBatch();
 
-        indexFilterTable.append(indexId++);
+        ++indexId;
         if (++i % 100 == 0)
             addProgress(m_indexStep * 100.0);
     }
+    if (!batch.isEmpty()) {
+        m_query->prepare(insertStatement(int(batch.size()) / KeywordColumns));
+        flushBatch();
+    }
     m_query->exec(QLatin1String("COMMIT"));
 
+    // The ids of the inserted keywords are consecutive, so SQLite can
+    // associate them with each filter attribute in one go.
     m_query->exec(QLatin1String("BEGIN"));
-    for (int idx : qAsConst(indexFilterTable)) {
-        for (int a : qAsConst(filterAtts)) {
-            m_query->prepare(QLatin1String("INSERT INTO IndexFilterTable (FilterAttributeId, IndexId) "
-                "VALUES(?, ?)"));
-            m_query->bindValue(0, a);
-            m_query->bindValue(1, idx);
-            m_query->exec();
-        }
+    m_query->prepare(QLatin1String("INSERT INTO IndexFilterTable (FilterAttributeId, IndexId) "
+        "SELECT ?, Id FROM IndexTable WHERE Id >= ? AND Id < ? ORDER BY Id"));
+    for (int a : qAsConst(filterAtts)) {
+        m_query->bindValue(0, a);
+        m_query->bindValue(1, firstIndexId);
+        m_query->bindValue(2, indexId);
+        m_query->exec();
     }
     m_query->exec(QLatin1String("COMMIT"));
 
@@ -692,9 +866,9 @@ bool HelpGeneratorPrivate::insertContents(const QByteArray &ba,
     }
 
     // associate the filter attributes
+    m_query->prepare(QLatin1String("INSERT INTO ContentsFilterTable (FilterAttributeId, ContentsId) "
+        "SELECT Id, ? FROM FilterAttributeTable WHERE Name=?"));
     for (const QString &filterAtt : filterAttributes) {
-        m_query->prepare(QLatin1String("INSERT INTO ContentsFilterTable (FilterAttributeId, ContentsId) "
-            "SELECT Id, ? FROM FilterAttributeTable WHERE Name=?"));
         m_query->bindValue(0, contentId);
         m_query->bindValue(1, filterAtt);
         m_query->exec();
@@ -765,40 +939,84 @@ bool HelpGeneratorPrivate::checkLinks(const QHelpProjectData &helpData)
      *         respective HTML elements. Therefore. contents that are e.g.
      *         commented out can cause false warning.
      */
-    bool allLinksOk = true;
+    struct LinkCheckJob
+    {
+        QString fileName;
+        bool opened = false;
+        QStringList invalidLinks;
+    };
+
+    QList<LinkCheckJob> jobs;
     for (const QString &fileName : qAsConst(files)) {
         if (!fileName.endsWith(QLatin1String("html"))
             && !fileName.endsWith(QLatin1String("htm")))
             continue;
-        QFile htmlFile(fileName);
-        if (!htmlFile.open(QIODevice::ReadOnly)) {
-            emit warning(tr("File \"%1\" cannot be opened.").arg(fileName));
-            continue;
+        LinkCheckJob job;
+        job.fileName = fileName;
+        jobs.append(job);
+    }
+
+    /* The files are scanned in parallel. Many pages link to the same files
+       via the same relative paths, so the canonical paths are shared. */
+    static const QRegularExpression linkPattern(
+                QLatin1String("<(?:a href|img src)=\"?([^#\">]+)[#\">]"));
+    QMutex canonicalPathsMutex;
+    QHash<QString, QString> canonicalPaths;
+    const auto canonicalFilePath = [&](const QString &filePath) {
+        {
+            QMutexLocker locker(&canonicalPathsMutex);
+            const auto it = canonicalPaths.constFind(filePath);
+            if (it != canonicalPaths.cend())
+                return it.value();
         }
-        const QRegularExpression linkPattern(QLatin1String("<(?:a href|img src)=\"?([^#\">]+)[#\">]"));
-        QByteArray data = htmlFile.readAll();
-        auto encoding = QStringDecoder::encodingForHtml(data);
-        if (!encoding)
-            encoding = QStringDecoder::Utf8;
-        const QString &content = QStringDecoder(*encoding)(data);
-        QStringList invalidLinks;
-        QRegularExpressionMatch match;
-        int pos = 0;
-        while ((match = linkPattern.match(content, pos)).hasMatch()) {
-            pos = match.capturedEnd();
-            const QString &linkedFileName = match.captured(1);
-            if (linkedFileName.contains(QLatin1String("://")))
-                continue;
-            const QString &curDir = QFileInfo(fileName).dir().path();
-            const QString &canonicalLinkedFileName =
-                QFileInfo(curDir + QDir::separator() + linkedFileName).canonicalFilePath();
-            if (!files.contains(canonicalLinkedFileName)
-                && !invalidLinks.contains(canonicalLinkedFileName)) {
-                emit warning(tr("File \"%1\" contains an invalid link to file \"%2\"").
-                         arg(fileName).arg(linkedFileName));
-                allLinksOk = false;
-                invalidLinks.append(canonicalLinkedFileName);
+        const QString canonicalPath = QFileInfo(filePath).canonicalFilePath();
+        QMutexLocker locker(&canonicalPathsMutex);
+        canonicalPaths.insert(filePath, canonicalPath);
+        return canonicalPath;
+    };
+
+    QThreadPool pool;
+    for (LinkCheckJob &job : jobs) {
+        pool.start([&job, &files, &canonicalFilePath] {
+            QFile htmlFile(job.fileName);
+            if (!htmlFile.open(QIODevice::ReadOnly))
+                return;
+            job.opened = true;
+
+            const QByteArray data = htmlFile.readAll();
+            auto encoding = QStringDecoder::encodingForHtml(data);
+            if (!encoding)
+                encoding = QStringDecoder::Utf8;
+            const QString &content = QStringDecoder(*encoding)(data);
+            const QString curDir = QFileInfo(job.fileName).dir().path() + QDir::separator();
+            QSet<QString> invalidFiles;
+            QRegularExpressionMatchIterator it = linkPattern.globalMatch(content);
+            while (it.hasNext()) {
+                const QString &linkedFileName = it.next().captured(1);
+                if (linkedFileName.contains(QLatin1String("://")))
+                    continue;
+                const QString &canonicalLinkedFileName =
+                    canonicalFilePath(curDir + linkedFileName);
+                if (!files.contains(canonicalLinkedFileName)
+                    && !invalidFiles.contains(canonicalLinkedFileName)) {
+                    invalidFiles.insert(canonicalLinkedFileName);
+                    job.invalidLinks.append(linkedFileName);
+                }
             }
+        });
+    }
+    pool.waitForDone();
+
+    bool allLinksOk = true;
+    for (const LinkCheckJob &job : qAsConst(jobs)) {
+        if (!job.opened) {
+            emit warning(tr("File \"%1\" cannot be opened.").arg(job.fileName));
+            continue;
+        }
+        for (const QString &linkedFileName : job.invalidLinks) {
+            emit warning(tr("File \"%1\" contains an invalid link to file \"%2\"").
+                     arg(job.fileName).arg(linkedFileName));
+            allLinksOk = false;
         }
     }
 
@@ -831,6 +1049,26 @@ bool HelpGenerator::checkLinks(const QHelpProjectData &helpData)
     return m_private->checkLinks(helpData);
 }
 
+/*!
+    Sets whether files that do not get noticeably smaller when compressed,
+    such as images, are stored uncompressed to \a store. Such files can
+    only be read by Qt 6.5 or later.
+*/
+void HelpGenerator::setStoreIncompressibleFiles(bool store)
+{
+    m_private->m_storeIncompressibleFiles = store;
+}
+
+/*!
+    Sets whether the stored data of files which did not change is taken
+    over from an existing output file instead of being compressed again
+    to \a reuse. All other data is generated from scratch.
+*/
+void HelpGenerator::setReuseUnchangedFiles(bool reuse)
+{
+    m_private->m_reuseUnchangedFiles = reuse;
+}
+
 QString HelpGenerator::error() const
 {
     return m_private->error();
@@ -20,6 +20,8 @@ public:
     bool generate(QHelpProjectData *helpData,
         const QString &outputFileName);
     bool checkLinks(const QHelpProjectData &helpData);
+    void setStoreIncompressibleFiles(bool store);
+    void setReuseUnchangedFiles(bool reuse);
     QString error() const;
 
 private slots:
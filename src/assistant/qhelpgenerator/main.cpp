@@ -38,7 +38,8 @@ namespace {
     }
 }
 
-int generateCollectionFile(const QByteArray &data, const QString &basePath, const QString outputFile)
+int generateCollectionFile(const QByteArray &data, const QString &basePath, const QString outputFile,
+                           bool storeIncompressible, bool reuseUnchanged)
 {
     fputs(qPrintable(QHG::tr("Reading collection config file...\n")), stdout);
     CollectionConfigReader config;
@@ -59,6 +60,8 @@ int generateCollectionFile(const QByteArray &data, const QString &basePath, cons
         }
 
         HelpGenerator helpGenerator;
+        helpGenerator.setStoreIncompressibleFiles(storeIncompressible);
+        helpGenerator.setReuseUnchangedFiles(reuseUnchanged);
         if (!helpGenerator.generate(&helpData, absoluteFilePath(basePath, it.value()))) {
             fprintf(stderr, "%s\n", qPrintable(helpGenerator.error()));
             return 1;
@@ -83,11 +86,12 @@ int generateCollectionFile(const QByteArray &data, const QString &basePath, cons
         return 1;
     }
 
-    for (const QString &file : config.filesToRegister()) {
-        if (!helpEngine.registerDocumentation(absoluteFilePath(basePath, file))) {
-            fprintf(stderr, "%s\n", qPrintable(helpEngine.error()));
-            return 1;
-        }
+    QStringList filesToRegister;
+    for (const QString &file : config.filesToRegister())
+        filesToRegister.append(absoluteFilePath(basePath, file));
+    if (!helpEngine.registerDocumentations(filesToRegister)) {
+        fprintf(stderr, "%s\n", qPrintable(helpEngine.error()));
+        return 1;
     }
     if (!config.filesToRegister().isEmpty()) {
         if (Q_UNLIKELY(qEnvironmentVariableIsSet("SOURCE_DATE_EPOCH"))) {
@@ -231,6 +235,8 @@ int main(int argc, char *argv[])
     bool showVersion = false;
     bool checkLinks = false;
     bool silent = false;
+    bool storeIncompressible = false;
+    bool reuseUnchanged = false;
 
     // don't require a window manager even though we're a QGuiApplication
     qputenv("QT_QPA_PLATFORM", QByteArrayLiteral("minimal"));
@@ -268,6 +274,10 @@ int main(int argc, char *argv[])
             checkLinks = true;
         } else if (arg == QLatin1String("-s")) {
             silent = true;
+        } else if (arg == QLatin1String("-store-incompressible")) {
+            storeIncompressible = true;
+        } else if (arg == QLatin1String("-update")) {
+            reuseUnchanged = true;
         } else {
             const QFileInfo fi(arg);
             inputFile = fi.absoluteFilePath();
@@ -318,6 +328,13 @@ int main(int argc, char *argv[])
         "  -c                     Checks whether all links in HTML files\n"
         "                         point to files in this help project.\n"
         "  -s                     Suppresses status messages.\n"
+        "  -store-incompressible  Stores files that do not compress\n"
+        "                         well, such as images, uncompressed.\n"
+        "                         The generated help file can only be\n"
+        "                         read by Qt 6.5 or later.\n"
+        "  -update                Takes the compressed data of files\n"
+        "                         that did not change over from an\n"
+        "                         existing output file (*.qch).\n"
         "  -v                     Displays the version of \n"
         "                         qhelpgenerator.\n\n");
 
@@ -365,6 +382,8 @@ int main(int argc, char *argv[])
         }
 
         HelpGenerator generator(silent);
+        generator.setStoreIncompressibleFiles(storeIncompressible);
+        generator.setReuseUnchangedFiles(reuseUnchanged);
         bool success = true;
         if (checkLinks)
             success = generator.checkLinks(*helpData);
@@ -377,7 +396,8 @@ int main(int argc, char *argv[])
         }
     } else {
         const QByteArray data = file.readAll();
-        return generateCollectionFile(data, basePath, outputFile);
+        return generateCollectionFile(data, basePath, outputFile, storeIncompressible,
+                                      reuseUnchanged);
 
     }
 
@@ -19,7 +19,7 @@ QT_BEGIN_NAMESPACE
 class QHelpProjectDataPrivate : public QXmlStreamReader
 {
 public:
-    void readData(const QByteArray &contents);
+    void readData(QIODevice *device);
 
     QString virtualFolder;
     QString namespaceName;
@@ -56,9 +56,10 @@ void QHelpProjectDataPrivate::skipUnknownToken()
     skipCurrentElement();
 }
 
-void QHelpProjectDataPrivate::readData(const QByteArray &contents)
+void QHelpProjectDataPrivate::readData(QIODevice *device)
 {
-    addData(contents);
+    // Parse while reading instead of keeping the whole document in memory
+    setDevice(device);
     while (!atEnd()) {
         readNext();
         if (isStartElement()) {
@@ -364,7 +365,7 @@ bool QHelpProjectData::readData(const QString &fileName)
         return false;
     }
 
-    d->readData(file.readAll());
+    d->readData(&file);
     return !d->hasError();
 }
 
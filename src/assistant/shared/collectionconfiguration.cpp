@@ -25,6 +25,7 @@ namespace {
     const QString LastPageKey(QLatin1String("LastTabPage"));
     const QString LastRegisterTime(QLatin1String("LastRegisterTime"));
     const QString LastShownPagesKey(QLatin1String("LastShownPages"));
+    const QString LastShownPageTitlesKey(QLatin1String("LastShownPageTitles"));
     const QString LastZoomFactorsKey(QLatin1String(
 #if defined(BROWSER_QTWEBKIT)
             "LastPagesZoomWebView"
@@ -213,6 +214,23 @@ void CollectionConfiguration::setLastShownPages(QHelpEngineCore &helpEngine,
                               lastShownPages.join(ListSeparator));
 }
 
+const QStringList CollectionConfiguration::lastShownPageTitles(const QHelpEngineCore &helpEngine)
+{
+    // Titles may be empty, so keep them to stay in sync with the pages
+    return helpEngine.customValue(LastShownPageTitlesKey).toString().
+        split(ListSeparator);
+}
+
+void CollectionConfiguration::setLastShownPageTitles(QHelpEngineCore &helpEngine,
+                                                  const QStringList &lastShownPageTitles)
+{
+    QStringList titles;
+    titles.reserve(lastShownPageTitles.size());
+    for (QString title : lastShownPageTitles)
+        titles.append(title.replace(ListSeparator, QLatin1String(" ")));
+    helpEngine.setCustomValue(LastShownPageTitlesKey, titles.join(ListSeparator));
+}
+
 const QStringList CollectionConfiguration::lastZoomFactors(const QHelpEngineCore &helpEngine)
 {
     return helpEngine.customValue(LastZoomFactorsKey).toString().
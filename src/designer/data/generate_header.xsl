@@ -321,8 +321,14 @@
         <xsl:value-of select="$name"/>
         <xsl:text>();&endl;&endl;</xsl:text>
 
+        <xsl:text>    static void *operator new(size_t size) { return DomArena::allocate(size); }&endl;</xsl:text>
+        <xsl:text>    static void operator delete(void *pointer) noexcept { DomArena::deallocate(pointer); }&endl;&endl;</xsl:text>
+
         <xsl:text>    void read(QXmlStreamReader &amp;reader);&endl;</xsl:text>
-        <xsl:text>    void write(QXmlStreamWriter &amp;writer, const QString &amp;tagName = QString()) const;&endl;&endl;</xsl:text>
+        <xsl:text>    void write(QXmlStreamWriter &amp;writer, const QString &amp;tagName = QString()) const;&endl;</xsl:text>
+        <xsl:text>    void write(DomXmlWriter &amp;writer, const QString &amp;tagName = QString()) const;&endl;</xsl:text>
+        <xsl:text>    void read(QDataStream &amp;stream);&endl;</xsl:text>
+        <xsl:text>    void write(QDataStream &amp;stream) const;&endl;&endl;</xsl:text>
 
         <xsl:if test="$hasText">
             <xsl:text>    inline QString text() const { return m_text; }&endl;</xsl:text>
@@ -338,6 +344,11 @@
         </xsl:call-template>
 
         <xsl:text>private:&endl;</xsl:text>
+        <xsl:text>    template &lt;class Writer&gt;&endl;</xsl:text>
+        <xsl:text>    void writeXml(Writer &amp;writer, const QString &amp;tagName) const;&endl;</xsl:text>
+        <xsl:if test="$hasText or $node//xs:attribute">
+            <xsl:text>&endl;</xsl:text>
+        </xsl:if>
 
         <xsl:if test="$hasText">
             <xsl:text>    QString m_text;&endl;&endl;</xsl:text>
@@ -418,8 +429,10 @@
 #ifndef UI4_H
 #define UI4_H
 
+#include &lt;qdatastream.h&gt;
 #include &lt;qlist.h&gt;
 #include &lt;qstring.h&gt;
+#include &lt;qstringconverter.h&gt;
 #include &lt;qstringlist.h&gt;
 #include &lt;qxmlstream.h&gt;
 #include &lt;qglobal.h&gt;
@@ -459,6 +472,81 @@ namespace QFormInternal
             </xsl:call-template>
         </xsl:for-each>
 
+        <xsl:text>&endl;</xsl:text>
+        <xsl:text>/*******************************************************************************&endl;</xsl:text>
+        <xsl:text>** Allocation&endl;</xsl:text>
+        <xsl:text>*/&endl;</xsl:text>
+        <xsl:text>&endl;</xsl:text>
+        <xsl:text>// Lets the Dom classes be allocated from large blocks that are freed at once&endl;</xsl:text>
+        <xsl:text>// when the arena is destroyed, for trees that are read and thrown away. The&endl;</xsl:text>
+        <xsl:text>// objects only give their memory back if they did not come from an arena.&endl;</xsl:text>
+        <xsl:text>class QDESIGNER_UILIB_EXPORT DomArena {&endl;</xsl:text>
+        <xsl:text>    Q_DISABLE_COPY_MOVE(DomArena)&endl;</xsl:text>
+        <xsl:text>public:&endl;</xsl:text>
+        <xsl:text>    DomArena() = default;&endl;</xsl:text>
+        <xsl:text>    ~DomArena();&endl;</xsl:text>
+        <xsl:text>&endl;</xsl:text>
+        <xsl:text>    // Makes the Dom objects created on this thread while it exists come from&endl;</xsl:text>
+        <xsl:text>    // the arena, which has to outlive them.&endl;</xsl:text>
+        <xsl:text>    class QDESIGNER_UILIB_EXPORT Scope {&endl;</xsl:text>
+        <xsl:text>        Q_DISABLE_COPY_MOVE(Scope)&endl;</xsl:text>
+        <xsl:text>    public:&endl;</xsl:text>
+        <xsl:text>        explicit Scope(DomArena *arena);&endl;</xsl:text>
+        <xsl:text>        ~Scope();&endl;</xsl:text>
+        <xsl:text>&endl;</xsl:text>
+        <xsl:text>    private:&endl;</xsl:text>
+        <xsl:text>        DomArena *m_previous;&endl;</xsl:text>
+        <xsl:text>    };&endl;</xsl:text>
+        <xsl:text>&endl;</xsl:text>
+        <xsl:text>    static void *allocate(size_t size);&endl;</xsl:text>
+        <xsl:text>    static void deallocate(void *pointer) noexcept;&endl;</xsl:text>
+        <xsl:text>&endl;</xsl:text>
+        <xsl:text>private:&endl;</xsl:text>
+        <xsl:text>    void *allocateInBlock(size_t size);&endl;</xsl:text>
+        <xsl:text>&endl;</xsl:text>
+        <xsl:text>    QList&lt;char *&gt; m_blocks;&endl;</xsl:text>
+        <xsl:text>    char *m_free = nullptr;&endl;</xsl:text>
+        <xsl:text>    size_t m_left = 0;&endl;</xsl:text>
+        <xsl:text>};&endl;</xsl:text>
+        <xsl:text>&endl;</xsl:text>
+        <xsl:text>/*******************************************************************************&endl;</xsl:text>
+        <xsl:text>** Writing&endl;</xsl:text>
+        <xsl:text>*/&endl;</xsl:text>
+        <xsl:text>&endl;</xsl:text>
+        <xsl:text>// Writes the XML of the Dom classes into a UTF-8 buffer, formatted like a&endl;</xsl:text>
+        <xsl:text>// QXmlStreamWriter on a device with auto-formatting and an indentation of one&endl;</xsl:text>
+        <xsl:text>// space. Names are appended as they are, only values and text are escaped.&endl;</xsl:text>
+        <xsl:text>class QDESIGNER_UILIB_EXPORT DomXmlWriter {&endl;</xsl:text>
+        <xsl:text>    Q_DISABLE_COPY_MOVE(DomXmlWriter)&endl;</xsl:text>
+        <xsl:text>public:&endl;</xsl:text>
+        <xsl:text>    explicit DomXmlWriter(QByteArray *buffer);&endl;</xsl:text>
+        <xsl:text>&endl;</xsl:text>
+        <xsl:text>    void writeStartDocument();&endl;</xsl:text>
+        <xsl:text>    void writeEndDocument();&endl;</xsl:text>
+        <xsl:text>&endl;</xsl:text>
+        <xsl:text>    void writeStartElement(const QString &amp;name);&endl;</xsl:text>
+        <xsl:text>    void writeEndElement();&endl;</xsl:text>
+        <xsl:text>    void writeAttribute(const QString &amp;name, const QString &amp;value);&endl;</xsl:text>
+        <xsl:text>    void writeTextElement(const QString &amp;name, const QString &amp;text);&endl;</xsl:text>
+        <xsl:text>    void writeCharacters(const QString &amp;text);&endl;</xsl:text>
+        <xsl:text>&endl;</xsl:text>
+        <xsl:text>    // Whether characters that cannot occur in XML were dropped&endl;</xsl:text>
+        <xsl:text>    bool hasError() const { return m_hasError; }&endl;</xsl:text>
+        <xsl:text>&endl;</xsl:text>
+        <xsl:text>private:&endl;</xsl:text>
+        <xsl:text>    bool finishStartElement(bool contents);&endl;</xsl:text>
+        <xsl:text>    void indent(qsizetype level);&endl;</xsl:text>
+        <xsl:text>    void append(QStringView text);&endl;</xsl:text>
+        <xsl:text>    void appendEscaped(QStringView text, bool escapeWhitespace);&endl;</xsl:text>
+        <xsl:text>&endl;</xsl:text>
+        <xsl:text>    QByteArray *m_buffer;&endl;</xsl:text>
+        <xsl:text>    QStringEncoder m_encoder;&endl;</xsl:text>
+        <xsl:text>    QList&lt;QString&gt; m_tags;&endl;</xsl:text>
+        <xsl:text>    bool m_inStartElement = false;&endl;</xsl:text>
+        <xsl:text>    bool m_lastWasStartElement = false;&endl;</xsl:text>
+        <xsl:text>    bool m_wroteSomething = false;&endl;</xsl:text>
+        <xsl:text>    bool m_hasError = false;&endl;</xsl:text>
+        <xsl:text>};&endl;</xsl:text>
         <xsl:text>&endl;</xsl:text>
         <xsl:text>/*******************************************************************************&endl;</xsl:text>
         <xsl:text>** Declarations&endl;</xsl:text>
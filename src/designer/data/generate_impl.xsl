@@ -169,6 +169,86 @@
         <xsl:text>"_s</xsl:text>
     </xsl:template>
 
+<!-- Implementation: element names -->
+
+    <!-- The enumerator of an element name in DomTag -->
+    <xsl:template name="tag-id">
+        <xsl:param name="name"/>
+        <xsl:variable name="lower-name">
+            <xsl:call-template name="lower-text">
+                <xsl:with-param name="text" select="$name"/>
+            </xsl:call-template>
+        </xsl:variable>
+        <xsl:variable name="camel-case-name">
+            <xsl:call-template name="camel-case">
+                <xsl:with-param name="text" select="$lower-name"/>
+            </xsl:call-template>
+        </xsl:variable>
+        <xsl:call-template name="cap-first-char">
+            <xsl:with-param name="text" select="$camel-case-name"/>
+        </xsl:call-template>
+    </xsl:template>
+
+    <!--
+        The element names of the schema are looked up once per element with
+        a binary search in read(), which then switches on them instead of
+        comparing the tag with each element name that may occur.
+    -->
+    <xsl:template name="tag-table">
+        <xsl:param name="node"/>
+        <xsl:variable name="elements"
+            select="$node/xs:complexType//xs:element[not(@name = preceding::xs:element[ancestor::xs:complexType]/@name)]"/>
+
+        <xsl:text>namespace {&endl;&endl;</xsl:text>
+        <xsl:text>// The names of the elements read by the Dom classes&endl;</xsl:text>
+        <xsl:text>enum class DomTag {&endl;</xsl:text>
+        <xsl:text>    Unknown,&endl;</xsl:text>
+        <xsl:for-each select="$elements">
+            <xsl:sort select="translate(@name, 'ABCDEFGHIJKLMNOPQRSTUVWXYZ', 'abcdefghijklmnopqrstuvwxyz')"/>
+            <xsl:text>    </xsl:text>
+            <xsl:call-template name="tag-id">
+                <xsl:with-param name="name" select="@name"/>
+            </xsl:call-template>
+            <xsl:text>,&endl;</xsl:text>
+        </xsl:for-each>
+        <xsl:text>};&endl;&endl;</xsl:text>
+
+        <xsl:text>struct DomTagName&endl;</xsl:text>
+        <xsl:text>{&endl;</xsl:text>
+        <xsl:text>    QStringView name;&endl;</xsl:text>
+        <xsl:text>    DomTag tag;&endl;</xsl:text>
+        <xsl:text>};&endl;&endl;</xsl:text>
+
+        <xsl:text>// Sorted by name for domTag()&endl;</xsl:text>
+        <xsl:text>constexpr DomTagName domTagNames[] = {&endl;</xsl:text>
+        <xsl:for-each select="$elements">
+            <xsl:sort select="translate(@name, 'ABCDEFGHIJKLMNOPQRSTUVWXYZ', 'abcdefghijklmnopqrstuvwxyz')"/>
+            <xsl:text>    { u"</xsl:text>
+            <xsl:call-template name="lower-text">
+                <xsl:with-param name="text" select="@name"/>
+            </xsl:call-template>
+            <xsl:text>", DomTag::</xsl:text>
+            <xsl:call-template name="tag-id">
+                <xsl:with-param name="name" select="@name"/>
+            </xsl:call-template>
+            <xsl:text> },&endl;</xsl:text>
+        </xsl:for-each>
+        <xsl:text>};&endl;&endl;</xsl:text>
+
+        <xsl:text>// Element names are case insensitive.&endl;</xsl:text>
+        <xsl:text>DomTag domTag(QStringView name)&endl;</xsl:text>
+        <xsl:text>{&endl;</xsl:text>
+        <xsl:text>    const auto lessThan = [](const DomTagName &amp;tagName, QStringView name) {&endl;</xsl:text>
+        <xsl:text>        return tagName.name.compare(name, Qt::CaseInsensitive) &lt; 0;&endl;</xsl:text>
+        <xsl:text>    };&endl;</xsl:text>
+        <xsl:text>    const auto end = std::end(domTagNames);&endl;</xsl:text>
+        <xsl:text>    const auto it = std::lower_bound(std::begin(domTagNames), end, name, lessThan);&endl;</xsl:text>
+        <xsl:text>    return it != end &amp;&amp; !it->name.compare(name, Qt::CaseInsensitive)&endl;</xsl:text>
+        <xsl:text>            ? it->tag : DomTag::Unknown;&endl;</xsl:text>
+        <xsl:text>}&endl;&endl;</xsl:text>
+        <xsl:text>} // namespace&endl;&endl;</xsl:text>
+    </xsl:template>
+
 <!-- Implementation: read(QXmlStreamReader) -->
 
     <xsl:template name="read-impl-load-attributes">
@@ -246,11 +326,11 @@
             </xsl:variable>
             <xsl:variable name="array" select="@maxOccurs = 'unbounded'"/>
 
-            <xsl:text>            if (!tag.compare(</xsl:text>
-            <xsl:call-template name="string-constant">
-                <xsl:with-param name="literal" select="$lower-name"/>
+            <xsl:text>            case DomTag::</xsl:text>
+            <xsl:call-template name="tag-id">
+                <xsl:with-param name="name" select="@name"/>
             </xsl:call-template>
-            <xsl:text>, Qt::CaseInsensitive)) {&endl;</xsl:text>
+            <xsl:text> : {&endl;</xsl:text>
 
             <xsl:choose>
                 <xsl:when test="@use='deprecated'">
@@ -332,11 +412,17 @@
         <xsl:text>        case QXmlStreamReader::StartElement : {&endl;</xsl:text>
         <xsl:text>            const auto tag = reader.name();&endl;</xsl:text>
 
-        <xsl:for-each select="$node//xs:sequence | $node//xs:choice | $node//xs:all">
-            <xsl:call-template name="read-impl-load-child-element">
-                <xsl:with-param name="node" select="."/>
-            </xsl:call-template>
-        </xsl:for-each>
+        <xsl:if test="$node//xs:element">
+            <xsl:text>            switch (domTag(tag)) {&endl;</xsl:text>
+            <xsl:for-each select="$node//xs:sequence | $node//xs:choice | $node//xs:all">
+                <xsl:call-template name="read-impl-load-child-element">
+                    <xsl:with-param name="node" select="."/>
+                </xsl:call-template>
+            </xsl:for-each>
+            <xsl:text>            default :&endl;</xsl:text>
+            <xsl:text>                break;&endl;</xsl:text>
+            <xsl:text>            }&endl;</xsl:text>
+        </xsl:if>
 
         <xsl:text>            reader.raiseError("Unexpected element "_L1 + tag);&endl;</xsl:text>
         <xsl:text>        }&endl;</xsl:text>
@@ -585,9 +671,10 @@
             </xsl:call-template>
         </xsl:variable>
 
+        <xsl:text>template &lt;class Writer&gt;&endl;</xsl:text>
         <xsl:text>void </xsl:text>
         <xsl:value-of select="$name"/>
-        <xsl:text>::write(QXmlStreamWriter &amp;writer, const QString &amp;tagName) const&endl;</xsl:text>
+        <xsl:text>::writeXml(Writer &amp;writer, const QString &amp;tagName) const&endl;</xsl:text>
         <xsl:text>{&endl;</xsl:text>
 
         <xsl:text>    writer.writeStartElement(tagName.isEmpty() ? QStringLiteral("</xsl:text>
@@ -618,6 +705,148 @@
 
         <xsl:text>    writer.writeEndElement();&endl;</xsl:text>
         <xsl:text>}&endl;&endl;</xsl:text>
+
+        <xsl:text>void </xsl:text>
+        <xsl:value-of select="$name"/>
+        <xsl:text>::write(QXmlStreamWriter &amp;writer, const QString &amp;tagName) const&endl;</xsl:text>
+        <xsl:text>{&endl;</xsl:text>
+        <xsl:text>    writeXml(writer, tagName);&endl;</xsl:text>
+        <xsl:text>}&endl;&endl;</xsl:text>
+
+        <xsl:text>void </xsl:text>
+        <xsl:value-of select="$name"/>
+        <xsl:text>::write(DomXmlWriter &amp;writer, const QString &amp;tagName) const&endl;</xsl:text>
+        <xsl:text>{&endl;</xsl:text>
+        <xsl:text>    writeXml(writer, tagName);&endl;</xsl:text>
+        <xsl:text>}&endl;&endl;</xsl:text>
+    </xsl:template>
+
+<!-- Implementation: read(QDataStream) and write(QDataStream) -->
+
+    <xsl:template name="stream-impl-members">
+        <xsl:param name="node"/>
+        <xsl:param name="operator"/>
+
+        <xsl:for-each select="$node//xs:attribute">
+            <xsl:variable name="camel-case-name">
+                <xsl:call-template name="camel-case">
+                    <xsl:with-param name="text" select="@name"/>
+                </xsl:call-template>
+            </xsl:variable>
+            <xsl:text>    stream </xsl:text>
+            <xsl:value-of select="$operator"/>
+            <xsl:text> m_attr_</xsl:text>
+            <xsl:value-of select="$camel-case-name"/>
+            <xsl:text> </xsl:text>
+            <xsl:value-of select="$operator"/>
+            <xsl:text> m_has_attr_</xsl:text>
+            <xsl:value-of select="$camel-case-name"/>
+            <xsl:text>;&endl;</xsl:text>
+        </xsl:for-each>
+
+        <xsl:if test="$node[@mixed='true']">
+            <xsl:text>    stream </xsl:text>
+            <xsl:value-of select="$operator"/>
+            <xsl:text> m_text;&endl;</xsl:text>
+        </xsl:if>
+
+        <xsl:variable name="set" select="$node/xs:sequence | $node/xs:choice | $node/xs:all"/>
+        <xsl:if test="not($node/xs:choice) and count($set) &gt; 0">
+            <xsl:text>    stream </xsl:text>
+            <xsl:value-of select="$operator"/>
+            <xsl:text> m_children;&endl;</xsl:text>
+        </xsl:if>
+
+        <xsl:for-each select="$set/xs:element[not(@use) or (@use!='deprecated')]">
+            <xsl:variable name="camel-case-name">
+                <xsl:call-template name="camel-case">
+                    <xsl:with-param name="text" select="@name"/>
+                </xsl:call-template>
+            </xsl:variable>
+            <xsl:variable name="xs-type-cat">
+                <xsl:call-template name="xs-type-category">
+                    <xsl:with-param name="xs-type" select="@type"/>
+                </xsl:call-template>
+            </xsl:variable>
+            <xsl:choose>
+                <xsl:when test="$xs-type-cat = 'pointer'">
+                    <xsl:choose>
+                        <xsl:when test="$operator = '&gt;&gt;'">
+                            <xsl:text>    readDom</xsl:text>
+                        </xsl:when>
+                        <xsl:otherwise>
+                            <xsl:text>    writeDom</xsl:text>
+                        </xsl:otherwise>
+                    </xsl:choose>
+                    <xsl:choose>
+                        <xsl:when test="@maxOccurs='unbounded'">
+                            <xsl:text>List</xsl:text>
+                        </xsl:when>
+                        <xsl:otherwise>
+                            <xsl:text>Pointer</xsl:text>
+                        </xsl:otherwise>
+                    </xsl:choose>
+                    <xsl:text>(stream, m_</xsl:text>
+                    <xsl:value-of select="$camel-case-name"/>
+                    <xsl:text>);&endl;</xsl:text>
+                </xsl:when>
+                <xsl:otherwise>
+                    <xsl:text>    stream </xsl:text>
+                    <xsl:value-of select="$operator"/>
+                    <xsl:text> m_</xsl:text>
+                    <xsl:value-of select="$camel-case-name"/>
+                    <xsl:text>;&endl;</xsl:text>
+                </xsl:otherwise>
+            </xsl:choose>
+        </xsl:for-each>
+
+        <xsl:if test="not($node//xs:attribute) and not($node[@mixed='true']) and count($set) = 0">
+            <xsl:text>    Q_UNUSED(stream);&endl;</xsl:text>
+        </xsl:if>
+    </xsl:template>
+
+    <xsl:template name="stream-read-impl">
+        <xsl:param name="node"/>
+        <xsl:variable name="name" select="concat('Dom', $node/@name)"/>
+
+        <xsl:text>void </xsl:text>
+        <xsl:value-of select="$name"/>
+        <xsl:text>::read(QDataStream &amp;stream)&endl;</xsl:text>
+        <xsl:text>{&endl;</xsl:text>
+
+        <xsl:if test="boolean($node/xs:choice)">
+            <xsl:text>    int kind = Unknown;&endl;</xsl:text>
+            <xsl:text>    stream &gt;&gt; kind;&endl;</xsl:text>
+            <xsl:text>    m_kind = Kind(kind);&endl;</xsl:text>
+        </xsl:if>
+
+        <xsl:call-template name="stream-impl-members">
+            <xsl:with-param name="node" select="$node"/>
+            <xsl:with-param name="operator" select="'&gt;&gt;'"/>
+        </xsl:call-template>
+
+        <xsl:text>}&endl;&endl;</xsl:text>
+    </xsl:template>
+
+    <xsl:template name="stream-write-impl">
+        <xsl:param name="node"/>
+        <xsl:variable name="name" select="concat('Dom', $node/@name)"/>
+
+        <xsl:text>void </xsl:text>
+        <xsl:value-of select="$name"/>
+        <xsl:text>::write(QDataStream &amp;stream) const&endl;</xsl:text>
+        <xsl:text>{&endl;</xsl:text>
+
+        <xsl:if test="boolean($node/xs:choice)">
+            <xsl:text>    stream &lt;&lt; int(m_kind);&endl;</xsl:text>
+        </xsl:if>
+
+        <xsl:call-template name="stream-impl-members">
+            <xsl:with-param name="node" select="$node"/>
+            <xsl:with-param name="operator" select="'&lt;&lt;'"/>
+        </xsl:call-template>
+
+        <xsl:text>}&endl;&endl;</xsl:text>
     </xsl:template>
 
 <!-- Implementation: child element setters -->
@@ -799,6 +1028,14 @@
             <xsl:with-param name="node" select="$node"/>
         </xsl:call-template>
 
+        <xsl:call-template name="stream-read-impl">
+            <xsl:with-param name="node" select="$node"/>
+        </xsl:call-template>
+
+        <xsl:call-template name="stream-write-impl">
+            <xsl:with-param name="node" select="$node"/>
+        </xsl:call-template>
+
         <xsl:call-template name="child-setter-impl">
             <xsl:with-param name="node" select="$node"/>
         </xsl:call-template>
@@ -819,6 +1056,10 @@
 </xsl:text>
         <xsl:text>#include "@HEADER@"&endl;</xsl:text>
         <xsl:text>&endl;</xsl:text>
+        <xsl:text>#include &lt;algorithm&gt;&endl;</xsl:text>
+        <xsl:text>#include &lt;cstddef&gt;&endl;</xsl:text>
+        <xsl:text>#include &lt;iterator&gt;&endl;</xsl:text>
+        <xsl:text>#include &lt;new&gt;&endl;</xsl:text>
         <xsl:text>&endl;</xsl:text>
         <xsl:text>QT_BEGIN_NAMESPACE&endl;</xsl:text>
         <xsl:text>&endl;using namespace Qt::StringLiterals;&endl;&endl;</xsl:text>
@@ -828,6 +1069,266 @@
         <xsl:text>#endif&endl;</xsl:text>
         <xsl:text>&endl;</xsl:text>
 
+        <xsl:call-template name="tag-table">
+            <xsl:with-param name="node" select="."/>
+        </xsl:call-template>
+
+        <xsl:text>/*******************************************************************************&endl;</xsl:text>
+        <xsl:text>** Allocation&endl;</xsl:text>
+        <xsl:text>*/&endl;</xsl:text>
+        <xsl:text>&endl;</xsl:text>
+        <xsl:text>namespace {&endl;</xsl:text>
+        <xsl:text>&endl;</xsl:text>
+        <xsl:text>// Each allocation starts with a flag telling whether it is in an arena,&endl;</xsl:text>
+        <xsl:text>// padded so that the object stays aligned.&endl;</xsl:text>
+        <xsl:text>constexpr size_t domHeaderSize = alignof(std::max_align_t);&endl;</xsl:text>
+        <xsl:text>constexpr size_t domBlockSize = 64 * 1024;&endl;</xsl:text>
+        <xsl:text>&endl;</xsl:text>
+        <xsl:text>thread_local DomArena *domCurrentArena = nullptr;&endl;</xsl:text>
+        <xsl:text>&endl;</xsl:text>
+        <xsl:text>} // namespace&endl;</xsl:text>
+        <xsl:text>&endl;</xsl:text>
+        <xsl:text>DomArena::~DomArena()&endl;</xsl:text>
+        <xsl:text>{&endl;</xsl:text>
+        <xsl:text>    for (char *block : std::as_const(m_blocks))&endl;</xsl:text>
+        <xsl:text>        ::operator delete(block);&endl;</xsl:text>
+        <xsl:text>}&endl;</xsl:text>
+        <xsl:text>&endl;</xsl:text>
+        <xsl:text>DomArena::Scope::Scope(DomArena *arena)&endl;</xsl:text>
+        <xsl:text>    : m_previous(domCurrentArena)&endl;</xsl:text>
+        <xsl:text>{&endl;</xsl:text>
+        <xsl:text>    domCurrentArena = arena;&endl;</xsl:text>
+        <xsl:text>}&endl;</xsl:text>
+        <xsl:text>&endl;</xsl:text>
+        <xsl:text>DomArena::Scope::~Scope()&endl;</xsl:text>
+        <xsl:text>{&endl;</xsl:text>
+        <xsl:text>    domCurrentArena = m_previous;&endl;</xsl:text>
+        <xsl:text>}&endl;</xsl:text>
+        <xsl:text>&endl;</xsl:text>
+        <xsl:text>void *DomArena::allocateInBlock(size_t size)&endl;</xsl:text>
+        <xsl:text>{&endl;</xsl:text>
+        <xsl:text>    if (size &gt; m_left) {&endl;</xsl:text>
+        <xsl:text>        const size_t blockSize = qMax(size, domBlockSize);&endl;</xsl:text>
+        <xsl:text>        m_free = static_cast&lt;char *&gt;(::operator new(blockSize));&endl;</xsl:text>
+        <xsl:text>        m_blocks.append(m_free);&endl;</xsl:text>
+        <xsl:text>        m_left = blockSize;&endl;</xsl:text>
+        <xsl:text>    }&endl;</xsl:text>
+        <xsl:text>    char *result = m_free;&endl;</xsl:text>
+        <xsl:text>    m_free += size;&endl;</xsl:text>
+        <xsl:text>    m_left -= size;&endl;</xsl:text>
+        <xsl:text>    return result;&endl;</xsl:text>
+        <xsl:text>}&endl;</xsl:text>
+        <xsl:text>&endl;</xsl:text>
+        <xsl:text>void *DomArena::allocate(size_t size)&endl;</xsl:text>
+        <xsl:text>{&endl;</xsl:text>
+        <xsl:text>    const size_t paddedSize = (size + domHeaderSize - 1) / domHeaderSize * domHeaderSize;&endl;</xsl:text>
+        <xsl:text>    DomArena *arena = domCurrentArena;&endl;</xsl:text>
+        <xsl:text>    char *memory = static_cast&lt;char *&gt;(arena ? arena-&gt;allocateInBlock(domHeaderSize + paddedSize)&endl;</xsl:text>
+        <xsl:text>                                             : ::operator new(domHeaderSize + paddedSize));&endl;</xsl:text>
+        <xsl:text>    new (memory) bool(arena != nullptr);&endl;</xsl:text>
+        <xsl:text>    return memory + domHeaderSize;&endl;</xsl:text>
+        <xsl:text>}&endl;</xsl:text>
+        <xsl:text>&endl;</xsl:text>
+        <xsl:text>void DomArena::deallocate(void *pointer) noexcept&endl;</xsl:text>
+        <xsl:text>{&endl;</xsl:text>
+        <xsl:text>    if (!pointer)&endl;</xsl:text>
+        <xsl:text>        return;&endl;</xsl:text>
+        <xsl:text>    char *memory = static_cast&lt;char *&gt;(pointer) - domHeaderSize;&endl;</xsl:text>
+        <xsl:text>    if (!*std::launder(reinterpret_cast&lt;bool *&gt;(memory)))&endl;</xsl:text>
+        <xsl:text>        ::operator delete(memory);&endl;</xsl:text>
+        <xsl:text>}&endl;</xsl:text>
+        <xsl:text>&endl;</xsl:text>
+
+        <xsl:text>/*******************************************************************************&endl;</xsl:text>
+        <xsl:text>** Writing&endl;</xsl:text>
+        <xsl:text>*/&endl;</xsl:text>
+        <xsl:text>&endl;</xsl:text>
+        <xsl:text>DomXmlWriter::DomXmlWriter(QByteArray *buffer)&endl;</xsl:text>
+        <xsl:text>    : m_buffer(buffer),&endl;</xsl:text>
+        <xsl:text>      m_encoder(QStringEncoder::Utf8)&endl;</xsl:text>
+        <xsl:text>{&endl;</xsl:text>
+        <xsl:text>}&endl;</xsl:text>
+        <xsl:text>&endl;</xsl:text>
+        <xsl:text>void DomXmlWriter::writeStartDocument()&endl;</xsl:text>
+        <xsl:text>{&endl;</xsl:text>
+        <xsl:text>    finishStartElement(false);&endl;</xsl:text>
+        <xsl:text>    m_buffer-&gt;append("&lt;?xml version=\"1.0\" encoding=\"UTF-8\"?&gt;");&endl;</xsl:text>
+        <xsl:text>}&endl;</xsl:text>
+        <xsl:text>&endl;</xsl:text>
+        <xsl:text>void DomXmlWriter::writeEndDocument()&endl;</xsl:text>
+        <xsl:text>{&endl;</xsl:text>
+        <xsl:text>    while (!m_tags.isEmpty())&endl;</xsl:text>
+        <xsl:text>        writeEndElement();&endl;</xsl:text>
+        <xsl:text>    m_buffer-&gt;append('\n');&endl;</xsl:text>
+        <xsl:text>}&endl;</xsl:text>
+        <xsl:text>&endl;</xsl:text>
+        <xsl:text>void DomXmlWriter::writeStartElement(const QString &amp;name)&endl;</xsl:text>
+        <xsl:text>{&endl;</xsl:text>
+        <xsl:text>    if (!finishStartElement(false))&endl;</xsl:text>
+        <xsl:text>        indent(m_tags.size());&endl;</xsl:text>
+        <xsl:text>    m_tags.append(name);&endl;</xsl:text>
+        <xsl:text>    m_buffer-&gt;append('&lt;');&endl;</xsl:text>
+        <xsl:text>    append(name);&endl;</xsl:text>
+        <xsl:text>    m_inStartElement = m_lastWasStartElement = true;&endl;</xsl:text>
+        <xsl:text>}&endl;</xsl:text>
+        <xsl:text>&endl;</xsl:text>
+        <xsl:text>void DomXmlWriter::writeEndElement()&endl;</xsl:text>
+        <xsl:text>{&endl;</xsl:text>
+        <xsl:text>    if (m_tags.isEmpty())&endl;</xsl:text>
+        <xsl:text>        return;&endl;</xsl:text>
+        <xsl:text>    // An element without contents is closed as an empty element.&endl;</xsl:text>
+        <xsl:text>    if (m_inStartElement) {&endl;</xsl:text>
+        <xsl:text>        m_buffer-&gt;append("/&gt;");&endl;</xsl:text>
+        <xsl:text>        m_inStartElement = m_lastWasStartElement = false;&endl;</xsl:text>
+        <xsl:text>        m_tags.removeLast();&endl;</xsl:text>
+        <xsl:text>        return;&endl;</xsl:text>
+        <xsl:text>    }&endl;</xsl:text>
+        <xsl:text>    if (!finishStartElement(false) &amp;&amp; !m_lastWasStartElement)&endl;</xsl:text>
+        <xsl:text>        indent(m_tags.size() - 1);&endl;</xsl:text>
+        <xsl:text>    m_lastWasStartElement = false;&endl;</xsl:text>
+        <xsl:text>    m_buffer-&gt;append("&lt;/");&endl;</xsl:text>
+        <xsl:text>    append(m_tags.takeLast());&endl;</xsl:text>
+        <xsl:text>    m_buffer-&gt;append('&gt;');&endl;</xsl:text>
+        <xsl:text>}&endl;</xsl:text>
+        <xsl:text>&endl;</xsl:text>
+        <xsl:text>void DomXmlWriter::writeAttribute(const QString &amp;name, const QString &amp;value)&endl;</xsl:text>
+        <xsl:text>{&endl;</xsl:text>
+        <xsl:text>    Q_ASSERT(m_inStartElement);&endl;</xsl:text>
+        <xsl:text>    m_buffer-&gt;append(' ');&endl;</xsl:text>
+        <xsl:text>    append(name);&endl;</xsl:text>
+        <xsl:text>    m_buffer-&gt;append("=\"");&endl;</xsl:text>
+        <xsl:text>    appendEscaped(value, true);&endl;</xsl:text>
+        <xsl:text>    m_buffer-&gt;append('"');&endl;</xsl:text>
+        <xsl:text>}&endl;</xsl:text>
+        <xsl:text>&endl;</xsl:text>
+        <xsl:text>void DomXmlWriter::writeTextElement(const QString &amp;name, const QString &amp;text)&endl;</xsl:text>
+        <xsl:text>{&endl;</xsl:text>
+        <xsl:text>    writeStartElement(name);&endl;</xsl:text>
+        <xsl:text>    writeCharacters(text);&endl;</xsl:text>
+        <xsl:text>    writeEndElement();&endl;</xsl:text>
+        <xsl:text>}&endl;</xsl:text>
+        <xsl:text>&endl;</xsl:text>
+        <xsl:text>void DomXmlWriter::writeCharacters(const QString &amp;text)&endl;</xsl:text>
+        <xsl:text>{&endl;</xsl:text>
+        <xsl:text>    finishStartElement(true);&endl;</xsl:text>
+        <xsl:text>    appendEscaped(text, false);&endl;</xsl:text>
+        <xsl:text>}&endl;</xsl:text>
+        <xsl:text>&endl;</xsl:text>
+        <xsl:text>bool DomXmlWriter::finishStartElement(bool contents)&endl;</xsl:text>
+        <xsl:text>{&endl;</xsl:text>
+        <xsl:text>    const bool hadSomethingWritten = m_wroteSomething;&endl;</xsl:text>
+        <xsl:text>    m_wroteSomething = contents;&endl;</xsl:text>
+        <xsl:text>    if (m_inStartElement) {&endl;</xsl:text>
+        <xsl:text>        m_buffer-&gt;append('&gt;');&endl;</xsl:text>
+        <xsl:text>        m_inStartElement = false;&endl;</xsl:text>
+        <xsl:text>    }&endl;</xsl:text>
+        <xsl:text>    return hadSomethingWritten;&endl;</xsl:text>
+        <xsl:text>}&endl;</xsl:text>
+        <xsl:text>&endl;</xsl:text>
+        <xsl:text>void DomXmlWriter::indent(qsizetype level)&endl;</xsl:text>
+        <xsl:text>{&endl;</xsl:text>
+        <xsl:text>    m_buffer-&gt;append('\n');&endl;</xsl:text>
+        <xsl:text>    m_buffer-&gt;append(level, ' ');&endl;</xsl:text>
+        <xsl:text>}&endl;</xsl:text>
+        <xsl:text>&endl;</xsl:text>
+        <xsl:text>void DomXmlWriter::append(QStringView text)&endl;</xsl:text>
+        <xsl:text>{&endl;</xsl:text>
+        <xsl:text>    if (text.isEmpty())&endl;</xsl:text>
+        <xsl:text>        return;&endl;</xsl:text>
+        <xsl:text>    const qsizetype size = m_buffer-&gt;size();&endl;</xsl:text>
+        <xsl:text>    m_buffer-&gt;resize(size + m_encoder.requiredSpace(text.size()));&endl;</xsl:text>
+        <xsl:text>    char *end = m_encoder.appendToBuffer(m_buffer-&gt;data() + size, text);&endl;</xsl:text>
+        <xsl:text>    m_buffer-&gt;truncate(end - m_buffer-&gt;constData());&endl;</xsl:text>
+        <xsl:text>}&endl;</xsl:text>
+        <xsl:text>&endl;</xsl:text>
+        <xsl:text>// Escapes like QXmlStreamWriter, appending the runs in between in one go.&endl;</xsl:text>
+        <xsl:text>void DomXmlWriter::appendEscaped(QStringView text, bool escapeWhitespace)&endl;</xsl:text>
+        <xsl:text>{&endl;</xsl:text>
+        <xsl:text>    qsizetype start = 0;&endl;</xsl:text>
+        <xsl:text>    for (qsizetype i = 0, size = text.size(); i != size; ++i) {&endl;</xsl:text>
+        <xsl:text>        const char16_t c = text[i].unicode();&endl;</xsl:text>
+        <xsl:text>        const char *replacement = "";&endl;</xsl:text>
+        <xsl:text>        switch (c) {&endl;</xsl:text>
+        <xsl:text>        case '&lt;':&endl;</xsl:text>
+        <xsl:text>            replacement = "&amp;lt;";&endl;</xsl:text>
+        <xsl:text>            break;&endl;</xsl:text>
+        <xsl:text>        case '&gt;':&endl;</xsl:text>
+        <xsl:text>            replacement = "&amp;gt;";&endl;</xsl:text>
+        <xsl:text>            break;&endl;</xsl:text>
+        <xsl:text>        case '&amp;':&endl;</xsl:text>
+        <xsl:text>            replacement = "&amp;amp;";&endl;</xsl:text>
+        <xsl:text>            break;&endl;</xsl:text>
+        <xsl:text>        case '"':&endl;</xsl:text>
+        <xsl:text>            replacement = "&amp;quot;";&endl;</xsl:text>
+        <xsl:text>            break;&endl;</xsl:text>
+        <xsl:text>        case '\t':&endl;</xsl:text>
+        <xsl:text>        case '\n':&endl;</xsl:text>
+        <xsl:text>        case '\r':&endl;</xsl:text>
+        <xsl:text>            if (!escapeWhitespace)&endl;</xsl:text>
+        <xsl:text>                continue;&endl;</xsl:text>
+        <xsl:text>            replacement = c == '\t' ? "&amp;#9;" : c == '\n' ? "&amp;#10;" : "&amp;#13;";&endl;</xsl:text>
+        <xsl:text>            break;&endl;</xsl:text>
+        <xsl:text>        default:&endl;</xsl:text>
+        <xsl:text>            if (c &gt; 0x1f &amp;&amp; c &lt; 0xfffe)&endl;</xsl:text>
+        <xsl:text>                continue;&endl;</xsl:text>
+        <xsl:text>            m_hasError = true;&endl;</xsl:text>
+        <xsl:text>            break;&endl;</xsl:text>
+        <xsl:text>        }&endl;</xsl:text>
+        <xsl:text>        append(text.sliced(start, i - start));&endl;</xsl:text>
+        <xsl:text>        m_buffer-&gt;append(replacement);&endl;</xsl:text>
+        <xsl:text>        start = i + 1;&endl;</xsl:text>
+        <xsl:text>    }&endl;</xsl:text>
+        <xsl:text>    append(text.sliced(start));&endl;</xsl:text>
+        <xsl:text>}&endl;</xsl:text>
+        <xsl:text>&endl;</xsl:text>
+        <xsl:text>/*******************************************************************************&endl;</xsl:text>
+        <xsl:text>** Streaming&endl;</xsl:text>
+        <xsl:text>*/&endl;</xsl:text>
+        <xsl:text>&endl;</xsl:text>
+        <xsl:text>namespace {&endl;</xsl:text>
+        <xsl:text>&endl;</xsl:text>
+        <xsl:text>template &lt;class T&gt;&endl;</xsl:text>
+        <xsl:text>void readDomPointer(QDataStream &amp;stream, T *&amp;pointer)&endl;</xsl:text>
+        <xsl:text>{&endl;</xsl:text>
+        <xsl:text>    bool present = false;&endl;</xsl:text>
+        <xsl:text>    stream &gt;&gt; present;&endl;</xsl:text>
+        <xsl:text>    if (present &amp;&amp; stream.status() == QDataStream::Ok) {&endl;</xsl:text>
+        <xsl:text>        pointer = new T;&endl;</xsl:text>
+        <xsl:text>        pointer-&gt;read(stream);&endl;</xsl:text>
+        <xsl:text>    }&endl;</xsl:text>
+        <xsl:text>}&endl;</xsl:text>
+        <xsl:text>&endl;</xsl:text>
+        <xsl:text>template &lt;class T&gt;&endl;</xsl:text>
+        <xsl:text>void writeDomPointer(QDataStream &amp;stream, const T *pointer)&endl;</xsl:text>
+        <xsl:text>{&endl;</xsl:text>
+        <xsl:text>    stream &lt;&lt; (pointer != nullptr);&endl;</xsl:text>
+        <xsl:text>    if (pointer)&endl;</xsl:text>
+        <xsl:text>        pointer-&gt;write(stream);&endl;</xsl:text>
+        <xsl:text>}&endl;</xsl:text>
+        <xsl:text>&endl;</xsl:text>
+        <xsl:text>template &lt;class T&gt;&endl;</xsl:text>
+        <xsl:text>void readDomList(QDataStream &amp;stream, QList&lt;T *&gt; &amp;list)&endl;</xsl:text>
+        <xsl:text>{&endl;</xsl:text>
+        <xsl:text>    qint32 count = 0;&endl;</xsl:text>
+        <xsl:text>    stream &gt;&gt; count;&endl;</xsl:text>
+        <xsl:text>    for (qint32 i = 0; i &lt; count &amp;&amp; stream.status() == QDataStream::Ok; ++i) {&endl;</xsl:text>
+        <xsl:text>        auto *element = new T;&endl;</xsl:text>
+        <xsl:text>        element-&gt;read(stream);&endl;</xsl:text>
+        <xsl:text>        list.append(element);&endl;</xsl:text>
+        <xsl:text>    }&endl;</xsl:text>
+        <xsl:text>}&endl;</xsl:text>
+        <xsl:text>&endl;</xsl:text>
+        <xsl:text>template &lt;class T&gt;&endl;</xsl:text>
+        <xsl:text>void writeDomList(QDataStream &amp;stream, const QList&lt;T *&gt; &amp;list)&endl;</xsl:text>
+        <xsl:text>{&endl;</xsl:text>
+        <xsl:text>    stream &lt;&lt; qint32(list.size());&endl;</xsl:text>
+        <xsl:text>    for (const T *element : list)&endl;</xsl:text>
+        <xsl:text>        element-&gt;write(stream);&endl;</xsl:text>
+        <xsl:text>}&endl;</xsl:text>
+        <xsl:text>&endl;</xsl:text>
+        <xsl:text>} // namespace&endl;</xsl:text>
+        <xsl:text>&endl;</xsl:text>
+
         <xsl:text>/*******************************************************************************&endl;</xsl:text>
         <xsl:text>** Implementations&endl;</xsl:text>
         <xsl:text>*/&endl;&endl;</xsl:text>
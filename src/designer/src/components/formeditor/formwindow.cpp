@@ -69,6 +69,7 @@
 
 #include <QtCore/qdebug.h>
 #include <QtCore/qbuffer.h>
+#include <QtCore/qelapsedtimer.h>
 #include <QtCore/qtimer.h>
 #include <QtCore/qlist.h>
 #include <QtCore/qxmlstream.h>
@@ -100,6 +101,38 @@ private:
 };
 
 enum { debugFormWindow = 0 };
+
+// Prints the time spent in the phases of loading a form if
+// QT_DESIGNER_TRACE_LOAD is set.
+class LoadTrace
+{
+    Q_DISABLE_COPY_MOVE(LoadTrace)
+public:
+    LoadTrace()
+    {
+        static const bool enabled = qEnvironmentVariableIsSet("QT_DESIGNER_TRACE_LOAD");
+        if (enabled) {
+            m_total.start();
+            m_phase.start();
+        }
+    }
+
+    void phase(const char *name)
+    {
+        if (m_phase.isValid())
+            qDebug("Designer: %s: %lld ms", name, qlonglong(m_phase.restart()));
+    }
+
+    void finish(int widgetCount)
+    {
+        if (m_total.isValid())
+            qDebug("Designer: form loaded: %lld ms, %d widgets", qlonglong(m_total.elapsed()), widgetCount);
+    }
+
+private:
+    QElapsedTimer m_total;
+    QElapsedTimer m_phase;
+};
 }
 
 namespace qdesigner_internal {
@@ -2127,8 +2160,10 @@ bool FormWindow::handleContextMenu(QWidget *, QWidget *managedWidget, QContextMe
 
 bool FormWindow::setContents(QIODevice *dev, QString *errorMessageIn /* = 0 */)
 {
+    LoadTrace trace;
     QDesignerResource r(this);
     QScopedPointer<DomUI> ui(r.readUi(dev));
+    trace.phase("read");
     if (ui.isNull()) {
         if (errorMessageIn)
             *errorMessageIn = r.errorString();
@@ -2145,12 +2180,16 @@ bool FormWindow::setContents(QIODevice *dev, QString *errorMessageIn /* = 0 */)
     clearMainContainer();
     m_undoStack.clear();
     emit changed();
+    trace.phase("clear");
 
     QWidget *w = r.loadUi(ui.data(), formContainer());
+    trace.phase("create");
     if (w) {
         setMainContainer(w);
         emit changed();
+        trace.phase("main container");
     }
+    trace.finish(int(m_widgets.size()));
     if (errorMessageIn)
         *errorMessageIn = r.errorString();
     return w != nullptr;
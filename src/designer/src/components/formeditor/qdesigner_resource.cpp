@@ -447,7 +447,29 @@ static inline QString messageBoxTitle()
 
 void QDesignerResource::save(QIODevice *dev, QWidget *widget)
 {
-    QAbstractFormBuilder::save(dev, widget);
+    QScopedPointer<DomUI> ui(saveUi(widget));
+
+    QByteArray xml;
+    DomXmlWriter writer(&xml);
+    writer.writeStartDocument();
+    ui->write(writer);
+    writer.writeEndDocument();
+    dev->write(xml);
+}
+
+DomUI *QDesignerResource::saveUi(QWidget *widget)
+{
+    DomWidget *ui_widget = createDom(widget, nullptr);
+    Q_ASSERT(ui_widget != nullptr);
+
+    DomUI *ui = new DomUI();
+    ui->setAttributeVersion(QStringLiteral("4.0"));
+    ui->setElementWidget(ui_widget);
+
+    saveDom(ui, widget);
+
+    d->m_laidout.clear();
+    return ui;
 }
 
 void QDesignerResource::saveDom(DomUI *ui, QWidget *widget)
@@ -1669,12 +1691,12 @@ bool QDesignerResource::copy(QIODevice *dev, const FormBuilderClipboard &selecti
     if (!ui)
         return false;
 
-    QXmlStreamWriter writer(dev);
-    writer.setAutoFormatting(true);
-    writer.setAutoFormattingIndent(1);
+    QByteArray xml;
+    DomXmlWriter writer(&xml);
     writer.writeStartDocument();
     ui->write(writer);
     writer.writeEndDocument();
+    dev->write(xml);
     delete ui;
     return true;
 }
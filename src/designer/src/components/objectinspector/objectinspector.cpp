@@ -39,6 +39,7 @@
 #include <QtCore/qdebug.h>
 #include <QtCore/qlist.h>
 #include <QtCore/qsortfilterproxymodel.h>
+#include <QtCore/qtimer.h>
 
 QT_BEGIN_NAMESPACE
 
@@ -169,6 +170,7 @@ public:
 
     void clear();
     void setFormWindow(QDesignerFormWindowInterface *fwi);
+    void flushPendingUpdate();
 
     QWidget *managedWidgetAt(const QPoint &global_mouse_pos);
 
@@ -189,6 +191,7 @@ public:
     void slotPopupContextMenu(QWidget *parent, const QPoint &pos);
 
 private:
+    void updateFormWindow(QDesignerFormWindowInterface *fwi);
     void setFormWindowBlocked(QDesignerFormWindowInterface *fwi);
     void applyCursorSelection();
     void synchronizeSelection(const QItemSelection & selected, const QItemSelection &deselected);
@@ -205,6 +208,8 @@ private:
     QSortFilterProxyModel *m_filterModel;
     QPointer<FormWindowBase> m_formWindow;
     QPointer<QWidget> m_formFakeDropTarget;
+    QTimer m_updateTimer;
+    bool m_updatePending = false;
     bool m_withinClearSelection;
 };
 
@@ -216,6 +221,10 @@ ObjectInspector::ObjectInspectorPrivate::ObjectInspectorPrivate(QDesignerFormEdi
     m_filterModel(new QSortFilterProxyModel(m_treeView)),
     m_withinClearSelection(false)
 {
+    m_updateTimer.setSingleShot(true);
+    m_updateTimer.setInterval(0);
+    connect(&m_updateTimer, &QTimer::timeout,
+            &m_updateTimer, [this] { flushPendingUpdate(); });
     m_filterModel->setRecursiveFilteringEnabled(true);
     m_filterLineEdit->setPlaceholderText(ObjectInspector::tr("Filter"));
     m_filterLineEdit->setClearButtonEnabled(true);
@@ -457,7 +466,32 @@ static inline bool mainContainerIsCurrent(const QDesignerFormWindowInterface *fw
     return current == fw || current == fw->mainContainer();
 }
 
+// Commands refresh the inspector for each widget they insert, remove or
+// rename, which happens hundreds of times when pasting or laying out many
+// widgets. Refreshes of the current form are therefore coalesced into one
+// per event loop pass; accessing the selection applies a pending one.
 void ObjectInspector::ObjectInspectorPrivate::setFormWindow(QDesignerFormWindowInterface *fwi)
+{
+    if (fwi != nullptr && fwi == m_formWindow.data()) {
+        m_updatePending = true;
+        m_updateTimer.start();
+        return;
+    }
+    m_updatePending = false;
+    m_updateTimer.stop();
+    updateFormWindow(fwi);
+}
+
+void ObjectInspector::ObjectInspectorPrivate::flushPendingUpdate()
+{
+    if (!m_updatePending)
+        return;
+    m_updatePending = false;
+    m_updateTimer.stop();
+    updateFormWindow(m_formWindow);
+}
+
+void ObjectInspector::ObjectInspectorPrivate::updateFormWindow(QDesignerFormWindowInterface *fwi)
 {
     const bool blocked = m_treeView->selectionModel()->blockSignals(true);
     {
@@ -498,6 +532,10 @@ void ObjectInspector::ObjectInspectorPrivate::setFormWindowBlocked(QDesignerForm
             m_treeView->verticalScrollBar()->setValue(yoffset);
         }
         break;
+    case ObjectInspectorModel::Changed: // Rows inserted/removed: Expand the new ones
+        for (const QModelIndex &index : m_model->insertedIndexes())
+            m_treeView->expandRecursively(index);
+        Q_FALLTHROUGH();
     case ObjectInspectorModel::Updated: {
         // Same structure (property changed or click on the form)
         // We maintain a selection of unmanaged objects
@@ -762,6 +800,7 @@ QDesignerFormEditorInterface *ObjectInspector::core() const
 
 void ObjectInspector::slotPopupContextMenu(const QPoint &pos)
 {
+    m_impl->flushPendingUpdate();
     m_impl->slotPopupContextMenu(this, pos);
 }
 
@@ -777,16 +816,19 @@ void ObjectInspector::slotSelectionChanged(const QItemSelection & selected, cons
 
 void ObjectInspector::getSelection(Selection &s) const
 {
+    m_impl->flushPendingUpdate();
     m_impl->getSelection(s);
 }
 
 bool ObjectInspector::selectObject(QObject *o)
 {
+   m_impl->flushPendingUpdate();
    return m_impl->selectObject(o);
 }
 
 void ObjectInspector::clearSelection()
 {
+    m_impl->flushPendingUpdate();
     m_impl->clearSelection();
 }
 
@@ -804,6 +846,7 @@ void ObjectInspector::mainContainerChanged()
 
 void  ObjectInspector::dragEnterEvent (QDragEnterEvent * event)
 {
+    m_impl->flushPendingUpdate();
     m_impl->handleDragEnterMoveEvent(this, event, true);
 }
 
@@ -819,6 +862,7 @@ void  ObjectInspector::dragLeaveEvent(QDragLeaveEvent * /* event*/)
 
 void  ObjectInspector::dropEvent (QDropEvent * event)
 {
+    m_impl->flushPendingUpdate();
     m_impl->dropEvent(event);
 
 QT_END_NAMESPACE
@@ -325,12 +325,14 @@ namespace qdesigner_internal {
 
     ObjectInspectorModel::UpdateResult ObjectInspectorModel::update(QDesignerFormWindowInterface *fw)
     {
+        m_insertedIndexes.clear();
         QWidget *mainContainer = fw ? fw->mainContainer() : nullptr;
         if (!mainContainer) {
             clearItems();
             m_formWindow = nullptr;
             return NoForm;
         }
+        const bool formWindowChanged = m_formWindow != fw;
         m_formWindow = fw;
         // Build new model and compare to previous one. If the structure is
         // identical, just update, else rebuild
@@ -345,6 +347,13 @@ namespace qdesigner_internal {
             return Updated;
         }
 
+        // Widgets of the same form were added, removed or reparented:
+        // Touch only the affected rows, keeping the state of the view.
+        if (!formWindowChanged && updateStructure(newModel)) {
+            m_model = newModel;
+            return Changed;
+        }
+
         rebuild(newModel);
         m_model = newModel;
         return Rebuilt;
@@ -398,6 +407,134 @@ namespace qdesigner_internal {
         }
     }
 
+    // Update the tree in case objects were inserted, removed or moved by
+    // inserting, removing and moving the affected rows only. This requires
+    // the entries (parent, object) to be unique, which is not the case if
+    // an object with children (a menu, say) occurs under several parents;
+    // the caller rebuilds the tree then.
+    bool ObjectInspectorModel::updateStructure(const ObjectModel &newModel)
+    {
+        if (m_model.isEmpty() || newModel.isEmpty() || rowCount() != 1)
+            return false;
+        QStandardItem *rootItem = item(0);
+        const ObjectData &rootEntry = newModel.constFirst();
+        if (objectOfItem(rootItem) != rootEntry.object())
+            return false;
+
+        EntryHash oldEntries;
+        oldEntries.reserve(m_model.size());
+        for (qsizetype i = 0, size = m_model.size(); i < size; ++i) {
+            const ObjectData &entry = m_model.at(i);
+            const QPair<QObject *, QObject *> key(entry.parent(), entry.object());
+            if (oldEntries.contains(key))
+                return false;
+            oldEntries.insert(key, i);
+        }
+
+        ChildIndexHash newChildren;
+        QSet<QPair<QObject *, QObject *>> newEntries;
+        newEntries.reserve(newModel.size());
+        for (qsizetype i = 1, size = newModel.size(); i < size; ++i) {
+            const ObjectData &entry = newModel.at(i);
+            const QPair<QObject *, QObject *> key(entry.parent(), entry.object());
+            if (newEntries.contains(key))
+                return false;
+            newEntries.insert(key);
+            newChildren[entry.parent()].append(i);
+        }
+
+        const auto rootIt = oldEntries.constFind({rootEntry.parent(), rootEntry.object()});
+        if (rootIt != oldEntries.constEnd()) {
+            if (const unsigned changedMask = m_model.at(rootIt.value()).compare(rootEntry))
+                rootEntry.setItemsDisplayData(rowAt(rootItem->index()), m_icons, changedMask);
+        }
+
+        StandardItemList insertedItems;
+        updateChildRows(rootItem, rootEntry.object(), newModel, newChildren, oldEntries, insertedItems);
+
+        m_objectIndexMultiMap.clear();
+        updateObjectIndexes(invisibleRootItem());
+        for (const QStandardItem *item : std::as_const(insertedItems))
+            m_insertedIndexes.append(item->index());
+        return true;
+    }
+
+    // Bring the child rows of an item in line with the new model.
+    void ObjectInspectorModel::updateChildRows(QStandardItem *parentItem, QObject *parentObject,
+                                               const ObjectModel &newModel,
+                                               const ChildIndexHash &newChildren,
+                                               const EntryHash &oldEntries,
+                                               StandardItemList &insertedItems)
+    {
+        const QList<qsizetype> childIndexes = newChildren.value(parentObject);
+
+        QSet<QObject *> childObjects;
+        childObjects.reserve(childIndexes.size());
+        for (qsizetype index : childIndexes)
+            childObjects.insert(newModel.at(index).object());
+        for (int row = parentItem->rowCount() - 1; row >= 0; --row) {
+            if (!childObjects.contains(objectOfItem(parentItem->child(row))))
+                parentItem->removeRow(row);
+        }
+
+        for (int row = 0, count = int(childIndexes.size()); row < count; ++row) {
+            const ObjectData &entry = newModel.at(childIndexes.at(row));
+            QStandardItem *childItem = parentItem->child(row);
+            if (childItem == nullptr || objectOfItem(childItem) != entry.object()) {
+                int oldRow = -1;
+                for (int r = row + 1, rowCount = parentItem->rowCount(); r < rowCount; ++r) {
+                    if (objectOfItem(parentItem->child(r)) == entry.object()) {
+                        oldRow = r;
+                        break;
+                    }
+                }
+                if (oldRow == -1) {
+                    insertedItems.append(insertSubtree(parentItem, row, childIndexes.at(row),
+                                                       newModel, newChildren));
+                    continue;
+                }
+                parentItem->insertRow(row, parentItem->takeRow(oldRow));
+                childItem = parentItem->child(row);
+            }
+
+            const auto oldIt = oldEntries.constFind({parentObject, entry.object()});
+            const unsigned changedMask = oldIt != oldEntries.constEnd()
+                ? m_model.at(oldIt.value()).compare(entry)
+                : unsigned(ObjectData::ClassNameChanged|ObjectData::ObjectNameChanged
+                           |ObjectData::ClassIconChanged|ObjectData::TypeChanged
+                           |ObjectData::LayoutTypeChanged);
+            if (changedMask)
+                entry.setItemsDisplayData(rowAt(childItem->index()), m_icons, changedMask);
+            updateChildRows(childItem, entry.object(), newModel, newChildren, oldEntries, insertedItems);
+        }
+    }
+
+    // Insert the row of an entry and the rows of its children.
+    QStandardItem *ObjectInspectorModel::insertSubtree(QStandardItem *parentItem, int row,
+                                                       qsizetype entryIndex,
+                                                       const ObjectModel &newModel,
+                                                       const ChildIndexHash &newChildren)
+    {
+        const ObjectData &entry = newModel.at(entryIndex);
+        StandardItemList items = createModelRow(entry.object());
+        entry.setItems(items, m_icons);
+        parentItem->insertRow(row, items);
+        QStandardItem *item = items.constFirst();
+        const QList<qsizetype> childIndexes = newChildren.value(entry.object());
+        for (int childRow = 0, count = int(childIndexes.size()); childRow < count; ++childRow)
+            insertSubtree(item, childRow, childIndexes.at(childRow), newModel, newChildren);
+        return item;
+    }
+
+    void ObjectInspectorModel::updateObjectIndexes(const QStandardItem *parentItem)
+    {
+        for (int row = 0, count = parentItem->rowCount(); row < count; ++row) {
+            const QStandardItem *childItem = parentItem->child(row);
+            m_objectIndexMultiMap.insert(objectOfItem(childItem), childItem->index());
+            updateObjectIndexes(childItem);
+        }
+    }
+
     // Update item data in case the model has the same structure
     void ObjectInspectorModel::updateItemContents(ObjectModel &oldModel, const ObjectModel &newModel)
     {
@@ -20,8 +20,10 @@
 #include <QtGui/qstandarditemmodel.h>
 #include <QtGui/qicon.h>
 #include <QtCore/qstring.h>
+#include <QtCore/qhash.h>
 #include <QtCore/qlist.h>
 #include <QtCore/qmap.h>
+#include <QtCore/qpair.h>
 #include <QtCore/qpointer.h>
 
 QT_BEGIN_NAMESPACE
@@ -100,9 +102,13 @@ namespace qdesigner_internal {
 
         explicit ObjectInspectorModel(QObject *parent);
 
-        enum UpdateResult { NoForm, Rebuilt, Updated };
+        // Changed: Rows were inserted, removed or moved, see insertedIndexes().
+        enum UpdateResult { NoForm, Rebuilt, Updated, Changed };
         UpdateResult update(QDesignerFormWindowInterface *fw);
 
+        // Rows inserted by the last update() returning Changed, without their children
+        const QModelIndexList &insertedIndexes() const { return m_insertedIndexes; }
+
         const QModelIndexList indexesOf(QObject *o) const { return m_objectIndexMultiMap.values(o); }
         QObject *objectAt(const QModelIndex &index) const;
 
@@ -112,14 +118,25 @@ namespace qdesigner_internal {
     private:
         typedef QMultiMap<QObject *,QModelIndex> ObjectIndexMultiMap;
 
+        using ChildIndexHash = QHash<QObject *, QList<qsizetype>>;
+        using EntryHash = QHash<QPair<QObject *, QObject *>, qsizetype>;
+
         void rebuild(const ObjectModel &newModel);
         void updateItemContents(ObjectModel &oldModel, const ObjectModel &newModel);
+        bool updateStructure(const ObjectModel &newModel);
+        void updateChildRows(QStandardItem *parentItem, QObject *parentObject,
+                             const ObjectModel &newModel, const ChildIndexHash &newChildren,
+                             const EntryHash &oldEntries, StandardItemList &insertedItems);
+        QStandardItem *insertSubtree(QStandardItem *parentItem, int row, qsizetype entryIndex,
+                                     const ObjectModel &newModel, const ChildIndexHash &newChildren);
+        void updateObjectIndexes(const QStandardItem *parentItem);
         void clearItems();
         StandardItemList rowAt(QModelIndex index) const;
 
         ObjectInspectorIcons m_icons;
         ObjectIndexMultiMap m_objectIndexMultiMap;
         ObjectModel m_model;
+        QModelIndexList m_insertedIndexes;
         QPointer<QDesignerFormWindowInterface> m_formWindow;
     };
 }  // namespace qdesigner_internal
@@ -762,7 +762,7 @@ void PropertyEditor::updateToolBarLabel()
                              .arg(objectName, className));
 }
 
-void PropertyEditor::updateBrowserValue(QtVariantProperty *property, const QVariant &value)
+void PropertyEditor::updateBrowserValue(QtVariantProperty *property, const QVariant &value, int index)
 {
     QVariant v = value;
     const int type = property->propertyType();
@@ -776,9 +776,8 @@ void PropertyEditor::updateBrowserValue(QtVariantProperty *property, const QVari
         const PropertySheetFlagValue f = qvariant_cast<PropertySheetFlagValue>(v);
         v = QVariant(f.value);
     }
-    QDesignerPropertySheet *sheet = qobject_cast<QDesignerPropertySheet*>(m_core->extensionManager()->extension(m_object, Q_TYPEID(QDesignerPropertySheetExtension)));
-    int index = -1;
-    if (sheet)
+    QDesignerPropertySheet *sheet = m_designerPropertySheet;
+    if (sheet && index == -1)
         index = sheet->indexOf(property->propertyName());
     if (sheet && m_propertyToGroup.contains(property)) { // don't do it for comments since property sheet doesn't keep them
         property->setEnabled(sheet->isEnabled(index));
@@ -872,6 +871,7 @@ void PropertyEditor::setObject(QObject *object)
     // In the first setObject() call following the addition of a dynamic property, focus and edit it.
     const bool editNewDynamicProperty = object != nullptr && m_object == object && !m_recentlyAddedDynamicProperty.isEmpty();
     m_object = object;
+    m_designerPropertySheet = qobject_cast<QDesignerPropertySheet*>(m_core->extensionManager()->extension(m_object, Q_TYPEID(QDesignerPropertySheetExtension)));
     m_propertyManager->setObject(object);
     QDesignerFormWindowInterface *formWindow = QDesignerFormWindowInterface::findFormWindow(m_object);
     // QTBUG-68507: Form window can be null for objects in Morph Undo macros with buddies
@@ -893,6 +893,8 @@ void PropertyEditor::setObject(QObject *object)
     storeExpansionState();
 
     UpdateBlocker ub(this);
+    // Update the tree items of all properties in one go.
+    m_treeBrowser->beginUpdate();
 
     updateToolBarLabel();
 
@@ -900,16 +902,27 @@ void PropertyEditor::setObject(QObject *object)
 
     const QDesignerDynamicPropertySheetExtension *dynamicSheet =
             qt_extension<QDesignerDynamicPropertySheetExtension*>(m_core->extensionManager(), m_object);
-    const QDesignerPropertySheet *sheet = qobject_cast<QDesignerPropertySheet*>(m_core->extensionManager()->extension(m_object, Q_TYPEID(QDesignerPropertySheetExtension)));
+    const QDesignerPropertySheet *sheet = m_designerPropertySheet;
 
     // Optimizization: Instead of rebuilding the complete list every time, compile a list of properties to remove,
     // remove them, traverse the sheet, in case property exists just set a value, otherwise - create it.
     QExtensionManager *m = m_core->extensionManager();
 
     m_propertySheet = qobject_cast<QDesignerPropertySheetExtension*>(m->extension(object, Q_TYPEID(QDesignerPropertySheetExtension)));
+
+    // The visible properties of the sheet, their values are read only once.
+    struct SheetProperty {
+        int index;
+        QString name;
+        QString group;
+        QVariant value;
+        int type;
+    };
+    QList<SheetProperty> sheetProperties;
     if (m_propertySheet) {
         const int stringTypeId = qMetaTypeId<PropertySheetStringValue>();
         const int propertyCount = m_propertySheet->count();
+        sheetProperties.reserve(propertyCount);
         for (int i = 0; i < propertyCount; ++i) {
             if (!m_propertySheet->isVisible(i))
                 continue;
@@ -918,6 +931,9 @@ void PropertyEditor::setObject(QObject *object)
             if (m_propertySheet->indexOf(propertyName) != i)
                 continue;
             const QString groupName = m_propertySheet->propertyGroup(i);
+            const QVariant value = m_propertySheet->property(i);
+            const int type = toBrowserType(value, propertyName);
+            sheetProperties.append({i, propertyName, groupName, value, type});
             const QMap<QString, QtVariantProperty *>::const_iterator rit = toRemove.constFind(propertyName);
             if (rit != toRemove.constEnd()) {
                 QtVariantProperty *property = rit.value();
@@ -926,7 +942,7 @@ void PropertyEditor::setObject(QObject *object)
                 // occurred since different sub-properties are used (disambiguation/id).
                 if (m_propertyToGroup.value(property) == groupName
                     && (idIdBasedTranslationUnchanged || propertyType != stringTypeId)
-                    && toBrowserType(m_propertySheet->property(i), propertyName) == propertyType) {
+                    && type == propertyType) {
                     toRemove.remove(propertyName);
                 }
             }
@@ -957,17 +973,11 @@ void PropertyEditor::setObject(QObject *object)
 
         QtProperty *lastProperty = nullptr;
         QtProperty *lastGroup = nullptr;
-        const int propertyCount = m_propertySheet->count();
-        for (int i = 0; i < propertyCount; ++i) {
-            if (!m_propertySheet->isVisible(i))
-                continue;
-
-            const QString propertyName = m_propertySheet->propertyName(i);
-            if (m_propertySheet->indexOf(propertyName) != i)
-                continue;
-            const QVariant value = m_propertySheet->property(i);
-
-            const int type = toBrowserType(value, propertyName);
+        for (const SheetProperty &sheetProperty : std::as_const(sheetProperties)) {
+            const int i = sheetProperty.index;
+            const QString &propertyName = sheetProperty.name;
+            const QVariant &value = sheetProperty.value;
+            const int type = sheetProperty.type;
 
             QtVariantProperty *property = m_nameToProperty.value(propertyName, 0);
             bool newProperty = property == nullptr;
@@ -1024,7 +1034,7 @@ void PropertyEditor::setObject(QObject *object)
                     setupStringProperty(property, isMainContainer);
                 property->setAttribute(m_strings.m_resettableAttribute, m_propertySheet->hasReset(i));
 
-                const QString groupName = m_propertySheet->propertyGroup(i);
+                const QString &groupName = sheetProperty.group;
                 QtVariantProperty *groupProperty = nullptr;
 
                 if (newProperty) {
@@ -1075,7 +1085,7 @@ void PropertyEditor::setObject(QObject *object)
 
                 lastProperty = property;
 
-                updateBrowserValue(property, value);
+                updateBrowserValue(property, value, i);
 
                 property->setModified(m_propertySheet->isChanged(i));
                 if (propertyName == QStringLiteral("geometry") && type == QMetaType::QRect) {
@@ -1104,6 +1114,7 @@ void PropertyEditor::setObject(QObject *object)
     const bool addEnabled = dynamicSheet ? dynamicSheet->dynamicPropertiesAllowed() : false;
     m_addDynamicAction->setEnabled(addEnabled);
     m_removeDynamicAction->setEnabled(false);
+    m_treeBrowser->endUpdate();
     applyExpansionState();
     applyFilter();
     // In the first setObject() call following the addition of a dynamic property, focus and edit it.
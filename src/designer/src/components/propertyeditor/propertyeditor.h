@@ -16,6 +16,7 @@ QT_BEGIN_NAMESPACE
 
 class DomProperty;
 class QDesignerMetaDataBaseItemInterface;
+class QDesignerPropertySheet;
 class QDesignerPropertySheetExtension;
 class QLineEdit;
 
@@ -73,7 +74,7 @@ private slots:
     void setFilter(const QString &pattern);
 
 private:
-    void updateBrowserValue(QtVariantProperty *property, const QVariant &value);
+    void updateBrowserValue(QtVariantProperty *property, const QVariant &value, int index = -1);
     void updateToolBarLabel();
     int toBrowserType(const QVariant &value, const QString &propertyName) const;
     QString removeScope(const QString &value) const;
@@ -122,6 +123,7 @@ private:
     const Strings m_strings;
     QDesignerFormEditorInterface *m_core;
     QDesignerPropertySheetExtension *m_propertySheet = nullptr;
+    QPointer<QDesignerPropertySheet> m_designerPropertySheet;
     QtAbstractPropertyBrowser *m_currentBrowser = nullptr;
     QtButtonPropertyBrowser *m_buttonBrowser;
     QtTreePropertyBrowser *m_treeBrowser = nullptr;
@@ -54,23 +54,25 @@ struct WidgetBoxCategoryEntry {
     WidgetBoxCategoryEntry() = default;
     explicit WidgetBoxCategoryEntry(const QDesignerWidgetBoxInterface::Widget &widget,
                                     const QString &filter,
-                                    const QIcon &icon,
                                     bool editable);
 
     QDesignerWidgetBoxInterface::Widget widget;
     QString toolTip;
     QString whatsThis;
     QString filter;
-    QIcon icon;
+    QString foldedFilter; // case folded filter for case insensitive matching
+    // Loaded on first display, that is, when the category is expanded
+    mutable QIcon icon;
+    mutable bool iconLoaded{false};
     bool editable{false};
 };
 
 WidgetBoxCategoryEntry::WidgetBoxCategoryEntry(const QDesignerWidgetBoxInterface::Widget &w,
                                                const QString &filterIn,
-                                               const QIcon &i, bool e) :
+                                               bool e) :
     widget(w),
     filter(filterIn),
-    icon(i),
+    foldedFilter(filterIn.toCaseFolded()),
     editable(e)
 {
 }
@@ -94,11 +96,14 @@ public:
     QListView::ViewMode viewMode() const;
     void setViewMode(QListView::ViewMode vm);
 
-    void addWidget(const QDesignerWidgetBoxInterface::Widget &widget, const QIcon &icon, bool editable);
+    void setIconLoader(const WidgetBoxCategoryListView::IconLoader &loader) { m_iconLoader = loader; }
+    void addWidget(const QDesignerWidgetBoxInterface::Widget &widget, bool editable);
 
     QDesignerWidgetBoxInterface::Widget widgetAt(const QModelIndex & index) const;
     QDesignerWidgetBoxInterface::Widget widgetAt(int row) const;
 
+    bool matches(int row, const QString &needle, Qt::CaseSensitivity caseSensitivity) const;
+
     int indexOfWidget(const QString &name);
 
     QDesignerWidgetBoxInterface::Category category() const;
@@ -107,7 +112,10 @@ public:
 private:
     using WidgetBoxCategoryEntrys = QList<WidgetBoxCategoryEntry>;
 
+    const QIcon &icon(const WidgetBoxCategoryEntry &item) const;
+
     QDesignerFormEditorInterface *m_core;
+    WidgetBoxCategoryListView::IconLoader m_iconLoader;
     WidgetBoxCategoryEntrys m_items;
     QListView::ViewMode m_viewMode;
 };
@@ -173,7 +181,7 @@ bool WidgetBoxCategoryModel::removeCustomWidgets()
     return changed;
 }
 
-void WidgetBoxCategoryModel::addWidget(const QDesignerWidgetBoxInterface::Widget &widget, const QIcon &icon,bool editable)
+void WidgetBoxCategoryModel::addWidget(const QDesignerWidgetBoxInterface::Widget &widget, bool editable)
 {
     static const QRegularExpression classNameRegExp(QStringLiteral("<widget +class *= *\"([^\"]+)\""));
     Q_ASSERT(classNameRegExp.isValid());
@@ -185,7 +193,7 @@ void WidgetBoxCategoryModel::addWidget(const QDesignerWidgetBoxInterface::Widget
     if (!className.isEmpty() && !filter.contains(QStringLiteral("Layout")) && !filter.contains(className))
         filter += className;
 
-    WidgetBoxCategoryEntry item(widget, filter, icon, editable);
+    WidgetBoxCategoryEntry item(widget, filter, editable);
     const QDesignerWidgetDataBaseInterface *db = m_core->widgetDataBase();
     int dbIndex = className.isEmpty() ? -1 : db->indexOfClassName(className);
     if (dbIndex == -1)
@@ -206,6 +214,24 @@ void WidgetBoxCategoryModel::addWidget(const QDesignerWidgetBoxInterface::Widget
     endInsertRows();
 }
 
+const QIcon &WidgetBoxCategoryModel::icon(const WidgetBoxCategoryEntry &item) const
+{
+    if (!item.iconLoaded) {
+        item.iconLoaded = true;
+        if (m_iconLoader)
+            item.icon = m_iconLoader(item.widget.iconName());
+    }
+    return item.icon;
+}
+
+bool WidgetBoxCategoryModel::matches(int row, const QString &needle,
+                                     Qt::CaseSensitivity caseSensitivity) const
+{
+    const WidgetBoxCategoryEntry &item = m_items.at(row);
+    return caseSensitivity == Qt::CaseInsensitive
+        ? item.foldedFilter.contains(needle) : item.filter.contains(needle);
+}
+
 QVariant WidgetBoxCategoryModel::data(const QModelIndex &index, int role) const
 {
     const int row = index.row();
@@ -218,7 +244,7 @@ QVariant WidgetBoxCategoryModel::data(const QModelIndex &index, int role) const
         // No text in icon mode
         return QVariant(m_viewMode == QListView::ListMode ? item.widget.name() : QString());
     case Qt::DecorationRole:
-        return QVariant(item.icon);
+        return QVariant(icon(item));
     case Qt::EditRole:
         return QVariant(item.widget.name());
     case Qt::ToolTipRole: {
@@ -309,6 +335,45 @@ QDesignerWidgetBoxInterface::Widget WidgetBoxCategoryModel::widgetAt(int row) co
     return m_items.at(row).widget;
 }
 
+/* WidgetBoxCategoryFilterModel, matches the precomputed filter strings of
+ * the entries instead of retrieving and comparing FilterRole data case
+ * insensitively for each row and keystroke. */
+
+class WidgetBoxCategoryFilterModel : public QSortFilterProxyModel
+{
+public:
+    explicit WidgetBoxCategoryFilterModel(QObject *parent = nullptr) : QSortFilterProxyModel(parent) {}
+
+    void setNeedle(const QString &needle, Qt::CaseSensitivity caseSensitivity);
+
+protected:
+    bool filterAcceptsRow(int sourceRow, const QModelIndex &sourceParent) const override;
+
+private:
+    QString m_needle; // case folded for Qt::CaseInsensitive
+    Qt::CaseSensitivity m_caseSensitivity = Qt::CaseInsensitive;
+};
+
+void WidgetBoxCategoryFilterModel::setNeedle(const QString &needleIn,
+                                             Qt::CaseSensitivity caseSensitivity)
+{
+    const QString needle = caseSensitivity == Qt::CaseInsensitive
+        ? needleIn.toCaseFolded() : needleIn;
+    if (needle == m_needle && caseSensitivity == m_caseSensitivity)
+        return;
+    m_needle = needle;
+    m_caseSensitivity = caseSensitivity;
+    invalidateFilter();
+}
+
+bool WidgetBoxCategoryFilterModel::filterAcceptsRow(int sourceRow, const QModelIndex &) const
+{
+    if (m_needle.isEmpty())
+        return true;
+    const auto *model = static_cast<const WidgetBoxCategoryModel *>(sourceModel());
+    return model->matches(sourceRow, m_needle, m_caseSensitivity);
+}
+
 /* WidgetSubBoxItemDelegate, ensures a valid name using a regexp validator */
 
 class WidgetBoxCategoryEntryDelegate : public QItemDelegate
@@ -337,7 +402,7 @@ QWidget *WidgetBoxCategoryEntryDelegate::createEditor(QWidget *parent,
 
 WidgetBoxCategoryListView::WidgetBoxCategoryListView(QDesignerFormEditorInterface *core, QWidget *parent) :
     QListView(parent),
-    m_proxyModel(new QSortFilterProxyModel(this)),
+    m_proxyModel(new WidgetBoxCategoryFilterModel(this)),
     m_model(new WidgetBoxCategoryModel(core, this))
 {
     setFocusPolicy(Qt::NoFocus);
@@ -357,7 +422,6 @@ WidgetBoxCategoryListView::WidgetBoxCategoryListView(QDesignerFormEditorInterfac
     setEditTriggers(QAbstractItemView::AnyKeyPressed);
 
     m_proxyModel->setSourceModel(m_model);
-    m_proxyModel->setFilterRole(FilterRole);
     setModel(m_proxyModel);
     connect(m_model, &QAbstractItemModel::dataChanged,
             this, &WidgetBoxCategoryListView::scratchPadChanged);
@@ -441,9 +505,14 @@ bool WidgetBoxCategoryListView::containsWidget(const QString &name)
     return m_model->indexOfWidget(name) != -1;
 }
 
-void WidgetBoxCategoryListView::addWidget(const QDesignerWidgetBoxInterface::Widget &widget, const QIcon &icon, bool editable)
+void WidgetBoxCategoryListView::setIconLoader(const IconLoader &loader)
+{
+    m_model->setIconLoader(loader);
+}
+
+void WidgetBoxCategoryListView::addWidget(const QDesignerWidgetBoxInterface::Widget &widget, bool editable)
 {
-    m_model->addWidget(widget, icon, editable);
+    m_model->addWidget(widget, editable);
 }
 
 QString WidgetBoxCategoryListView::widgetDomXml(const QDesignerWidgetBoxInterface::Widget &widget)
@@ -462,8 +531,7 @@ QString WidgetBoxCategoryListView::widgetDomXml(const QDesignerWidgetBoxInterfac
 
 void WidgetBoxCategoryListView::filter(const QString &needle, Qt::CaseSensitivity caseSensitivity)
 {
-    m_proxyModel->setFilterFixedString(needle);
-    m_proxyModel->setFilterCaseSensitivity(caseSensitivity);
+    m_proxyModel->setNeedle(needle, caseSensitivity);
 }
 
 QDesignerWidgetBoxInterface::Category WidgetBoxCategoryListView::category() const
@@ -9,16 +9,17 @@
 #include <QtWidgets/qlistview.h>
 #include <QtCore/qlist.h>
 
+#include <functional>
+
 QT_BEGIN_NAMESPACE
 
 class QDesignerFormEditorInterface;
 class QDesignerDnDItemInterface;
 
-class QSortFilterProxyModel;
-
 namespace qdesigner_internal {
 
 class WidgetBoxCategoryModel;
+class WidgetBoxCategoryFilterModel;
 
 // List view of a category, switchable between icon and list mode.
 // Provides a filtered view.
@@ -44,7 +45,10 @@ public:
     void setCurrentItem(AccessMode am, int row);
 
     // These methods operate on the unfiltered model and are used for serialization
-    void addWidget(const QDesignerWidgetBoxInterface::Widget &widget, const QIcon &icon, bool editable);
+    // Icons are loaded by the icon loader when they are first displayed
+    using IconLoader = std::function<QIcon(const QString &iconName)>;
+    void setIconLoader(const IconLoader &loader);
+    void addWidget(const QDesignerWidgetBoxInterface::Widget &widget, bool editable);
     bool containsWidget(const QString &name);
     QDesignerWidgetBoxInterface::Category category() const;
     bool removeCustomWidgets();
@@ -68,7 +72,7 @@ private slots:
 
 private:
     int mapRowToSource(int filterRow) const;
-    QSortFilterProxyModel *m_proxyModel;
+    WidgetBoxCategoryFilterModel *m_proxyModel;
     WidgetBoxCategoryModel *m_model;
 };
 
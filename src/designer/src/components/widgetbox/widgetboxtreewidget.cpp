@@ -226,6 +226,7 @@ WidgetBoxCategoryListView *WidgetBoxTreeWidget::addCategoryView(QTreeWidgetItem
     embed_item->setFlags(Qt::ItemIsEnabled);
     WidgetBoxCategoryListView *categoryView = new WidgetBoxCategoryListView(m_core, this);
     categoryView->setViewMode(iconMode ? QListView::IconMode : QListView::ListMode);
+    categoryView->setIconLoader([this](const QString &iconName) { return iconForWidget(iconName); });
     connect(categoryView, &WidgetBoxCategoryListView::scratchPadChanged,
             this, &WidgetBoxTreeWidget::slotSave);
     connect(categoryView, &WidgetBoxCategoryListView::pressed,
@@ -718,7 +719,7 @@ void WidgetBoxTreeWidget::addCategory(const Category &cat)
     for (int i = 0; i < widgetCount; ++i) {
         const Widget w = cat.widget(i);
         if (!categoryView->containsWidget(w.name()))
-            categoryView->addWidget(w, iconForWidget(w.iconName()), isScratchPad);
+            categoryView->addWidget(w, isScratchPad);
     }
     adjustSubListSize(cat_item);
 }
@@ -756,7 +757,7 @@ void WidgetBoxTreeWidget::addWidget(int cat_idx, const Widget &wgt)
     WidgetBoxCategoryListView *categoryView = categoryViewAt(cat_idx);
 
     const bool scratch = topLevelRole(cat_item) == SCRATCHPAD_ITEM;
-    categoryView->addWidget(wgt, iconForWidget(wgt.iconName()), scratch);
+    categoryView->addWidget(wgt, scratch);
     adjustSubListSize(cat_item);
 }
 
@@ -931,7 +932,7 @@ void WidgetBoxTreeWidget::dropWidgets(const QList<QDesignerDnDItemInterface*> &i
         dom_ui->setElementWidget(fakeTopLevel);
 
         const Widget wgt = Widget(w->objectName(), xml);
-        categoryView->addWidget(wgt, iconForWidget(wgt.iconName()), true);
+        categoryView->addWidget(wgt, true);
         scratch_item->setExpanded(true);
         added = true;
     }
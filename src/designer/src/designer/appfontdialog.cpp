@@ -25,6 +25,8 @@
 #include <QtCore/qlist.h>
 #include <QtCore/qsettings.h>
 #include <QtCore/qstringlist.h>
+#include <QtCore/qthreadpool.h>
+#include <QtCore/qtimer.h>
 
 #include <algorithm>
 
@@ -51,6 +53,8 @@ public:
 
     // Return id or -1
     int add(const QString &fontFile, QString *errorMessage);
+    // Load the fonts on a background thread
+    void addAsync(const QStringList &fontFiles);
 
     bool remove(int id, QString *errorMessage);
     bool remove(const QString &fontFile, QString *errorMessage);
@@ -62,7 +66,12 @@ public:
     const FileNameFontIdPairs &fonts() const;
 
 private:
+    static bool checkFile(const QString &fontFile, QString *errorMessage);
+    bool isLoaded(const QString &fullPath) const;
+    void addLoaded(const FileNameFontIdPairs &fonts);
+
     FileNameFontIdPairs m_fonts;
+    QStringList m_pendingFonts; // being loaded by addAsync()
 };
 
 AppFontManager::AppFontManager() = default;
@@ -80,6 +89,7 @@ void AppFontManager::save(QDesignerSettingsInterface *s, const QString &prefix)
     const FileNameFontIdPairs::const_iterator cend = m_fonts.constEnd();
     for (FileNameFontIdPairs::const_iterator it = m_fonts.constBegin(); it != cend; ++it)
         fontFiles.push_back(it->first);
+    fontFiles += m_pendingFonts;
 
     s->beginGroup(prefix);
     s->setValue(QLatin1String(fontFileKeyC),  fontFiles);
@@ -98,34 +108,42 @@ void AppFontManager::restore(const QDesignerSettingsInterface *s, const QString
 
     if (debugAppFontWidget)
         qDebug() << "AppFontManager::restoring" << fontFiles.size() << "fonts from " << prefix;
-    if (!fontFiles.isEmpty()) {
-        QString errorMessage;
-        const QStringList::const_iterator cend = fontFiles.constEnd();
-        for (QStringList::const_iterator it = fontFiles.constBegin(); it != cend; ++it)
-            if (add(*it, &errorMessage) == -1)
-                qWarning("%s", qPrintable(errorMessage));
-    }
+    if (!fontFiles.isEmpty())
+        addAsync(fontFiles);
 }
 
-int AppFontManager::add(const QString &fontFile, QString *errorMessage)
+bool AppFontManager::checkFile(const QString &fontFile, QString *errorMessage)
 {
     const QFileInfo inf(fontFile);
     if (!inf.isFile()) {
         *errorMessage = QCoreApplication::translate("AppFontManager", "'%1' is not a file.").arg(fontFile);
-        return -1;
+        return false;
     }
     if (!inf.isReadable()) {
         *errorMessage = QCoreApplication::translate("AppFontManager", "The font file '%1' does not have read permissions.").arg(fontFile);
-        return -1;
+        return false;
     }
-    const QString fullPath = inf.absoluteFilePath();
-    // Check if already loaded
+    return true;
+}
+
+bool AppFontManager::isLoaded(const QString &fullPath) const
+{
     const FileNameFontIdPairs::const_iterator cend = m_fonts.constEnd();
     for (FileNameFontIdPairs::const_iterator it = m_fonts.constBegin(); it != cend; ++it) {
-        if (it->first == fullPath) {
-            *errorMessage = QCoreApplication::translate("AppFontManager", "The font file '%1' is already loaded.").arg(fontFile);
-            return -1;
-        }
+        if (it->first == fullPath)
+            return true;
+    }
+    return m_pendingFonts.contains(fullPath);
+}
+
+int AppFontManager::add(const QString &fontFile, QString *errorMessage)
+{
+    if (!checkFile(fontFile, errorMessage))
+        return -1;
+    const QString fullPath = QFileInfo(fontFile).absoluteFilePath();
+    if (isLoaded(fullPath)) {
+        *errorMessage = QCoreApplication::translate("AppFontManager", "The font file '%1' is already loaded.").arg(fontFile);
+        return -1;
     }
 
     const int id = QFontDatabase::addApplicationFont(fullPath);
@@ -140,6 +158,58 @@ int AppFontManager::add(const QString &fontFile, QString *errorMessage)
     return id;
 }
 
+/*
+    Loading a large number of fonts takes seconds, so the fonts stored in the
+    settings are loaded on a background thread once the event loop runs,
+    that is, after the main window appeared. QFontDatabase is thread-safe;
+    the ids are recorded in the order of \a fontFiles when all are loaded.
+*/
+void AppFontManager::addAsync(const QStringList &fontFiles)
+{
+    QStringList fullPaths;
+    QString errorMessage;
+    for (const QString &fontFile : fontFiles) {
+        if (!checkFile(fontFile, &errorMessage)) {
+            qWarning("%s", qPrintable(errorMessage));
+            continue;
+        }
+        const QString fullPath = QFileInfo(fontFile).absoluteFilePath();
+        if (isLoaded(fullPath) || fullPaths.contains(fullPath)) {
+            qWarning("%s", qPrintable(QCoreApplication::translate("AppFontManager", "The font file '%1' is already loaded.").arg(fontFile)));
+            continue;
+        }
+        fullPaths.push_back(fullPath);
+    }
+    if (fullPaths.isEmpty())
+        return;
+
+    m_pendingFonts += fullPaths;
+    QTimer::singleShot(0, qApp, [fullPaths] {
+        QThreadPool::globalInstance()->start([fullPaths] {
+            FileNameFontIdPairs fonts;
+            for (const QString &fullPath : fullPaths)
+                fonts.push_back(FileNameFontIdPair(fullPath, QFontDatabase::addApplicationFont(fullPath)));
+            QMetaObject::invokeMethod(qApp, [fonts] {
+                AppFontManager::instance().addLoaded(fonts);
+            }, Qt::QueuedConnection);
+        });
+    });
+}
+
+void AppFontManager::addLoaded(const FileNameFontIdPairs &fonts)
+{
+    for (const FileNameFontIdPair &font : fonts) {
+        m_pendingFonts.removeOne(font.first);
+        if (font.second == -1) {
+            qWarning("%s", qPrintable(QCoreApplication::translate("AppFontManager", "The font file '%1' could not be loaded.").arg(font.first)));
+            continue;
+        }
+        if (debugAppFontWidget)
+            qDebug() << "AppFontManager::addLoaded" << font.first << font.second;
+        m_fonts.push_back(font);
+    }
+}
+
 bool AppFontManager::remove(int id, QString *errorMessage)
 {
     const int count = m_fonts.size();
@@ -27,11 +27,38 @@ static const int VLABEL_MARGIN =          1;
 static const int HLABEL_MARGIN =          3;
 static const int GROUND_W =              20;
 static const int GROUND_H =              25;
+static const int INDEX_CELL_SIZE =       64;
 
 /*******************************************************************************
 ** Tools
 */
 
+// Cell of the connection index containing a coordinate
+static inline int indexCell(int c)
+{
+    return c >= 0 ? c / INDEX_CELL_SIZE : (c - INDEX_CELL_SIZE + 1) / INDEX_CELL_SIZE;
+}
+
+static inline quint64 indexCellKey(int column, int row)
+{
+    return (quint64(quint32(column)) << 32) | quint32(row);
+}
+
+// Keys of the index cells touched by a region
+static QSet<quint64> indexCellKeys(const QRegion &region)
+{
+    QSet<quint64> result;
+    for (const QRect &r : region) {
+        const int right = indexCell(r.right());
+        const int bottom = indexCell(r.bottom());
+        for (int column = indexCell(r.left()); column <= right; ++column) {
+            for (int row = indexCell(r.top()); row <= bottom; ++row)
+                result.insert(indexCellKey(column, row));
+        }
+    }
+    return result;
+}
+
 static QRect fixRect(const QRect &r)
 {
     return QRect(r.x(), r.y(), r.width() - 1, r.height() - 1);
@@ -110,6 +137,7 @@ void AddConnectionCommand::redo()
     edit()->selectNone();
     emit edit()->aboutToAddConnection(edit()->m_con_list.size());
     edit()->m_con_list.append(m_con);
+    edit()->insertIntoIndex(m_con);
     m_con->inserted();
     emit edit()->connectionAdded(m_con);
     edit()->setSelected(m_con, true);
@@ -123,6 +151,7 @@ void AddConnectionCommand::undo()
     m_con->update();
     m_con->removed();
     edit()->m_con_list.removeAll(m_con);
+    edit()->removeFromIndex(m_con);
     emit edit()->connectionRemoved(idx);
 }
 
@@ -188,6 +217,7 @@ void DeleteConnectionsCommand::redo()
         con->update();
         con->removed();
         edit()->m_con_list.removeAll(con);
+        edit()->removeFromIndex(con);
         emit edit()->connectionRemoved(idx);
     }
 }
@@ -198,6 +228,7 @@ void DeleteConnectionsCommand::undo()
         Q_ASSERT(!edit()->m_con_list.contains(con));
         emit edit()->aboutToAddConnection(edit()->m_con_list.size());
         edit()->m_con_list.append(con);
+        edit()->insertIntoIndex(con);
         edit()->selectNone();
         con->update();
         con->inserted();
@@ -651,6 +682,7 @@ void Connection::setSource(QObject *source, const QPoint &pos)
         m_source_pos = pos;
         m_source_rect = m_edit->widgetRect(widget);
         updateKneeList();
+        m_edit->updateIndex(this);
     }
 
     update(false);
@@ -668,6 +700,7 @@ void Connection::setTarget(QObject *target, const QPoint &pos)
         m_target_pos = pos;
         m_target_rect = m_edit->widgetRect(widget);
         updateKneeList();
+        m_edit->updateIndex(this);
     }
 
     update(false);
@@ -830,6 +863,7 @@ void Connection::setLabel(EndPoint::Type type, const QString &text)
         m_target_label = text;
 
     updatePixmap(type);
+    m_edit->updateIndex(this);
 }
 
 void Connection::updatePixmap(EndPoint::Type type)
@@ -893,6 +927,7 @@ void Connection::checkWidgets()
     if (changed) {
         update();
         updateKneeList();
+        m_edit->updateIndex(this);
         update();
     }
 }
@@ -927,6 +962,8 @@ ConnectionEdit::~ConnectionEdit()
 void ConnectionEdit::clear()
 {
     m_con_list.clear();
+    m_con_index.clear();
+    m_con_cells.clear();
     m_sel_con_set.clear();
     m_bg_widget = nullptr;
     m_widget_under_mouse = nullptr;
@@ -1014,15 +1051,18 @@ void ConnectionEdit::paintLabel(QPainter *p, EndPoint::Type type, Connection *co
 
 void ConnectionEdit::paintConnection(QPainter *p, Connection *con,
                                         WidgetSet *heavy_highlight_set,
-                                        WidgetSet *light_highlight_set) const
+                                        WidgetSet *light_highlight_set,
+                                        bool exposed) const
 {
     QWidget *source = con->widget(EndPoint::Source);
     QWidget *target = con->widget(EndPoint::Target);
 
     const bool heavy = selected(con) || con == m_tmp_con;
     WidgetSet *set = heavy ? heavy_highlight_set : light_highlight_set;
-    p->setPen(heavy ? m_active_color : m_inactive_color);
-    con->paint(p);
+    if (exposed) {
+        p->setPen(heavy ? m_active_color : m_inactive_color);
+        con->paint(p);
+    }
 
     if (source != nullptr && source != m_bg_widget)
         set->insert(source, source);
@@ -1038,11 +1078,14 @@ void ConnectionEdit::paintEvent(QPaintEvent *e)
 
     WidgetSet heavy_highlight_set, light_highlight_set;
 
+    // Connections outside of the exposed region still highlight their widgets
+    const ConnectionSet exposed = connectionsIn(e->region());
     for (Connection *con : qAsConst(m_con_list)) {
         if (!con->isVisible())
             continue;
 
-        paintConnection(&p, con, &heavy_highlight_set, &light_highlight_set);
+        paintConnection(&p, con, &heavy_highlight_set, &light_highlight_set,
+                        exposed.contains(con));
     }
 
     if (m_tmp_con != nullptr)
@@ -1072,7 +1115,7 @@ void ConnectionEdit::paintEvent(QPaintEvent *e)
     p.setBrush(palette().color(QPalette::Base));
     p.setPen(palette().color(QPalette::Text));
     for (Connection *con : qAsConst(m_con_list)) {
-        if (con->isVisible()) {
+        if (con->isVisible() && exposed.contains(con)) {
             paintLabel(&p, EndPoint::Source, con);
             paintLabel(&p, EndPoint::Target, con);
         }
@@ -1418,11 +1461,78 @@ void ConnectionEdit::selectAll()
 
 Connection *ConnectionEdit::connectionAt(const QPoint &pos) const
 {
-    for (Connection *con : m_con_list) {
-        if (con->contains(pos))
-            return con;
+    const auto cellIt = m_con_index.constFind(indexCellKey(indexCell(pos.x()), indexCell(pos.y())));
+    if (cellIt == m_con_index.constEnd())
+        return nullptr;
+
+    Connection *result = nullptr;
+    qsizetype resultIndex = -1;
+    for (Connection *con : cellIt.value()) {
+        if (!con->contains(pos))
+            continue;
+        if (result == nullptr) {
+            result = con;
+            continue;
+        }
+        // Overlapping connections: The first one of the list wins.
+        if (resultIndex == -1)
+            resultIndex = m_con_list.indexOf(result);
+        const qsizetype index = m_con_list.indexOf(con);
+        if (index < resultIndex) {
+            result = con;
+            resultIndex = index;
+        }
     }
-    return nullptr;
+    return result;
+}
+
+void ConnectionEdit::insertIntoIndex(Connection *con)
+{
+    const QSet<quint64> cells = indexCellKeys(con->region());
+    for (quint64 cell : cells)
+        m_con_index[cell].append(con);
+    m_con_cells.insert(con, cells);
+}
+
+void ConnectionEdit::removeFromIndex(Connection *con)
+{
+    const auto it = m_con_cells.find(con);
+    if (it == m_con_cells.end())
+        return;
+    for (quint64 cell : std::as_const(it.value())) {
+        const auto cellIt = m_con_index.find(cell);
+        if (cellIt != m_con_index.end()) {
+            cellIt.value().removeOne(con);
+            if (cellIt.value().isEmpty())
+                m_con_index.erase(cellIt);
+        }
+    }
+    m_con_cells.erase(it);
+}
+
+// Move a connection of the list to the cells of its new geometry
+void ConnectionEdit::updateIndex(Connection *con)
+{
+    if (!m_con_cells.contains(con))
+        return;
+    removeFromIndex(con);
+    insertIntoIndex(con);
+}
+
+ConnectionEdit::ConnectionSet ConnectionEdit::connectionsIn(const QRegion &region) const
+{
+    ConnectionSet result;
+    const QSet<quint64> cells = indexCellKeys(region);
+    for (quint64 cell : cells) {
+        const auto cellIt = m_con_index.constFind(cell);
+        if (cellIt == m_con_index.constEnd())
+            continue;
+        for (Connection *con : cellIt.value()) {
+            if (con->region().intersects(region))
+                result.insert(con, con);
+        }
+    }
+    return result;
 }
 
 CETypes::EndPoint ConnectionEdit::endPointAt(const QPoint &pos) const
@@ -1487,6 +1597,7 @@ void ConnectionEdit::deleteSelected()
 void ConnectionEdit::addConnection(Connection *con)
 {
     m_con_list.append(con);
+    insertIntoIndex(con);
 }
 
 void ConnectionEdit::updateLines()
@@ -1534,6 +1645,7 @@ Connection *ConnectionEdit::takeConnection(Connection *con)
     if (!m_con_list.contains(con))
         return nullptr;
     m_con_list.removeAll(con);
+    removeFromIndex(con);
     return con;
 }
 
@@ -21,6 +21,7 @@
 #include <QtCore/qhash.h>
 #include <QtCore/qlist.h>
 #include <QtCore/qpointer.h>
+#include <QtCore/qset.h>
 
 #include <QtWidgets/qwidget.h>
 #include <QtGui/qpixmap.h>
@@ -217,9 +218,15 @@ private:
     EndPoint endPointAt(const QPoint &pos) const;
     void paintConnection(QPainter *p, Connection *con,
                          WidgetSet *heavy_highlight_set,
-                         WidgetSet *light_highlight_set) const;
+                         WidgetSet *light_highlight_set,
+                         bool exposed) const;
     void paintLabel(QPainter *p, EndPoint::Type type, Connection *con);
 
+    void insertIntoIndex(Connection *con);
+    void removeFromIndex(Connection *con);
+    void updateIndex(Connection *con);
+    ConnectionSet connectionsIn(const QRegion &region) const;
+
 
     QPointer<QWidget> m_bg_widget;
     QUndoStack *m_undo_stack;
@@ -227,6 +234,10 @@ private:
 
     Connection *m_tmp_con; // the connection we are currently editing
     ConnectionList m_con_list;
+    // Grid of the cells touched by the connections of the list, for hit
+    // testing and painting the exposed connections only.
+    QHash<quint64, ConnectionList> m_con_index;
+    QHash<Connection *, QSet<quint64>> m_con_cells;
     bool m_start_connection_on_drag;
     EndPoint m_end_point_under_mouse;
     QPointer<QWidget> m_widget_under_mouse;
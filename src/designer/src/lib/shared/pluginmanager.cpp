@@ -11,9 +11,11 @@
 
 #include <QtUiPlugin/customwidget.h>
 
+#include <QtCore/qdatetime.h>
 #include <QtCore/qdir.h>
 #include <QtCore/qfile.h>
 #include <QtCore/qfileinfo.h>
+#include <QtCore/qhash.h>
 #include <QtCore/qset.h>
 #include <QtCore/qpluginloader.h>
 #include <QtCore/qlibrary.h>
@@ -21,6 +23,7 @@
 #include <QtCore/qdebug.h>
 #include <QtCore/qmap.h>
 #include <QtCore/qsettings.h>
+#include <QtCore/qthreadpool.h>
 #include <QtCore/qcoreapplication.h>
 
 #include <QtCore/qxmlstream.h>
@@ -46,7 +49,8 @@ static const char *jambiLanguageC = "jambi";
 enum { debugPluginManager = 0 };
 
 /* Custom widgets: Loading custom widgets is a 2-step process: PluginManager
- * scans for its plugins in the constructor. At this point, it might not be safe
+ * scans for its plugins in the constructor, loading the libraries in parallel.
+ * At this point, it might not be safe
  * to immediately initialize the custom widgets it finds, because the rest of
  * Designer is not initialized yet.
  * Later on, in ensureInitialized(), the plugin instances (including static ones)
@@ -55,7 +59,7 @@ enum { debugPluginManager = 0 };
  * mismatch, it kicks out the respective custom widget. The m_initialized flag
  * is used to indicate the state.
  * Later, someone might call registerNewPlugins(), which agains clears the flag via
- * registerPlugin() and triggers the process again.
+ * registerPlugins() and triggers the process again.
  * Also note that Jambi fakes a custom widget collection that changes its contents
  * every time the project is switched. So, custom widget plugins can actually
  * disappear, and the custom widget list must be cleared and refilled in
@@ -445,6 +449,17 @@ class QDesignerPluginManagerPrivate {
     QList<QDesignerCustomWidgetInterface *> m_customWidgets;
     QList<QDesignerCustomWidgetData> m_customWidgetData;
 
+    // Parsed Dom XML by plugin file and widget name, reused when the plugin
+    // file and the XML have not changed when re-initializing.
+    struct ParsedXml {
+        QDateTime lastModified;
+        QString domXml;
+        QDesignerCustomWidgetData data;
+        QDesignerCustomWidgetData::ParseResult result = QDesignerCustomWidgetData::ParseOk;
+        QString errorMessage;
+    };
+    QHash<QPair<QString, QString>, ParsedXml> m_parsedXml;
+
     QStringList defaultPluginPaths() const;
 
     bool m_initialized;
@@ -477,16 +492,25 @@ bool QDesignerPluginManagerPrivate::addCustomWidget(QDesignerCustomWidgetInterfa
     QDesignerCustomWidgetData data(pluginPath);
     const QString domXml = c->domXml();
     if (!domXml.isEmpty()) { // Legacy: Empty XML means: Do not show up in widget box.
-        QString errorMessage;
-        const QDesignerCustomWidgetData::ParseResult pr = data.parseXml(domXml, c->name(), &errorMessage);
-        switch (pr) {
+        const QString name = c->name();
+        const QDateTime lastModified = QFileInfo(pluginPath).lastModified();
+        ParsedXml &parsed = m_parsedXml[qMakePair(pluginPath, name)];
+        if (parsed.domXml != domXml || parsed.lastModified != lastModified) {
+            parsed.lastModified = lastModified;
+            parsed.domXml = domXml;
+            parsed.data = QDesignerCustomWidgetData(pluginPath);
+            parsed.errorMessage.clear();
+            parsed.result = parsed.data.parseXml(domXml, name, &parsed.errorMessage);
+        }
+        data = parsed.data;
+        switch (parsed.result) {
             case QDesignerCustomWidgetData::ParseOk:
             break;
             case QDesignerCustomWidgetData::ParseWarning:
-            qdesigner_internal::designerWarning(errorMessage);
+            qdesigner_internal::designerWarning(parsed.errorMessage);
             break;
             case QDesignerCustomWidgetData::ParseError:
-            qdesigner_internal::designerWarning(errorMessage);
+            qdesigner_internal::designerWarning(parsed.errorMessage);
             return false;
         }
         // Does the language match?
@@ -628,8 +652,10 @@ void QDesignerPluginManager::updateRegisteredPlugins()
     if (debugPluginManager)
         qDebug() << Q_FUNC_INFO;
     m_d->m_registeredPlugins.clear();
+    QStringList candidates;
     for (const QString &path : qAsConst(m_d->m_pluginPaths))
-        registerPath(path);
+        candidates += findPlugins(path);
+    registerPlugins(candidates);
 }
 
 bool QDesignerPluginManager::registerNewPlugins()
@@ -638,8 +664,10 @@ bool QDesignerPluginManager::registerNewPlugins()
         qDebug() << Q_FUNC_INFO;
 
     const int before = m_d->m_registeredPlugins.size();
+    QStringList candidates;
     for (const QString &path : qAsConst(m_d->m_pluginPaths))
-        registerPath(path);
+        candidates += findPlugins(path);
+    registerPlugins(candidates);
     const bool newPluginsFound = m_d->m_registeredPlugins.size() > before;
     // We force a re-initialize as Jambi collection might return
     // different widget lists when switching projects.
@@ -649,35 +677,52 @@ bool QDesignerPluginManager::registerNewPlugins()
     return newPluginsFound;
 }
 
-void QDesignerPluginManager::registerPath(const QString &path)
+// Load the libraries in parallel, as resolving and relocating them is what
+// takes time. The instances are created later in ensureInitialized() on the
+// GUI thread.
+void QDesignerPluginManager::registerPlugins(const QStringList &candidates)
 {
     if (debugPluginManager)
-        qDebug() << Q_FUNC_INFO << path;
-    const QStringList &candidates = findPlugins(path);
-    for (const QString &plugin : candidates)
-        registerPlugin(plugin);
-}
+        qDebug() << Q_FUNC_INFO << candidates;
 
-void QDesignerPluginManager::registerPlugin(const QString &plugin)
-{
-    if (debugPluginManager)
-        qDebug() << Q_FUNC_INFO << plugin;
-    if (m_d->m_disabledPlugins.contains(plugin))
-        return;
-    if (m_d->m_registeredPlugins.contains(plugin))
+    QStringList plugins;
+    for (const QString &plugin : candidates) {
+        if (!m_d->m_disabledPlugins.contains(plugin) && !m_d->m_registeredPlugins.contains(plugin)
+            && !plugins.contains(plugin)) {
+            plugins.append(plugin);
+        }
+    }
+    if (plugins.isEmpty())
         return;
 
-    QPluginLoader loader(plugin);
-    if (loader.isLoaded() || loader.load()) {
-        m_d->m_registeredPlugins += plugin;
-        QDesignerPluginManagerPrivate::FailedPluginMap::iterator fit = m_d->m_failedPlugins.find(plugin);
-        if (fit != m_d->m_failedPlugins.end())
-            m_d->m_failedPlugins.erase(fit);
-        return;
+    QList<bool> loaded(plugins.size(), false);
+    QStringList errorMessages(plugins.size());
+    bool *loadedData = loaded.data();
+    QString *errorMessageData = errorMessages.data();
+    const auto load = [&plugins, loadedData, errorMessageData](qsizetype i) {
+        QPluginLoader loader(plugins.at(i));
+        loadedData[i] = loader.isLoaded() || loader.load();
+        if (!loadedData[i])
+            errorMessageData[i] = loader.errorString();
+    };
+    if (plugins.size() > 1) {
+        QThreadPool pool;
+        for (qsizetype i = 0, size = plugins.size(); i < size; ++i)
+            pool.start([&load, i] { load(i); });
+        pool.waitForDone();
+    } else {
+        load(0);
     }
 
-    const QString errorMessage = loader.errorString();
-    m_d->m_failedPlugins.insert(plugin, errorMessage);
+    for (qsizetype i = 0, size = plugins.size(); i < size; ++i) {
+        const QString &plugin = plugins.at(i);
+        if (loaded.at(i)) {
+            m_d->m_registeredPlugins += plugin;
+            m_d->m_failedPlugins.remove(plugin);
+        } else {
+            m_d->m_failedPlugins.insert(plugin, errorMessages.at(i));
+        }
+    }
 }
 
 
@@ -110,8 +110,7 @@ public slots:
 
 private:
     void updateRegisteredPlugins();
-    void registerPath(const QString &path);
-    void registerPlugin(const QString &plugin);
+    void registerPlugins(const QStringList &candidates);
 
 private:
     static QStringList defaultPluginPaths();
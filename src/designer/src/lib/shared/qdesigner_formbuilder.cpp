@@ -41,6 +41,7 @@
 #include <QtCore/qbuffer.h>
 #include <QtCore/qdebug.h>
 #include <QtCore/qcoreapplication.h>
+#include <QtCore/qscopedpointer.h>
 
 QT_BEGIN_NAMESPACE
 
@@ -301,12 +302,22 @@ QWidget *QDesignerFormBuilder::createPreview(const QDesignerFormWindowInterface
     QDesignerFormBuilder builder(fw->core(), deviceProfile);
     builder.setWorkingDirectory(fw->absoluteDir());
 
-    QByteArray bytes = fw->contents().toUtf8();
+    // Forms of the editor are previewed straight from their DOM, which saves
+    // writing and parsing the XML.
+    QWidget *widget = nullptr;
+    auto *fwb = qobject_cast<FormWindowBase *>(const_cast<QDesignerFormWindowInterface *>(fw));
+    if (fwb && fwb->mainContainer()) {
+        QScopedPointer<QEditorFormBuilder> resource(fwb->createFormBuilder());
+        QScopedPointer<DomUI> ui(resource->saveUi(fwb->mainContainer()));
+        widget = builder.create(ui.data(), nullptr);
+    } else {
+        QByteArray bytes = fw->contents().toUtf8();
 
-    QBuffer buffer(&bytes);
-    buffer.open(QIODevice::ReadOnly);
+        QBuffer buffer(&bytes);
+        buffer.open(QIODevice::ReadOnly);
 
-    QWidget *widget = builder.load(&buffer, nullptr);
+        widget = builder.load(&buffer, nullptr);
+    }
     if (!widget) { // Shouldn't happen
         *errorMessage = QCoreApplication::translate("QDesignerFormBuilder", "The preview failed to build.");
         return  nullptr;
@@ -1149,7 +1149,10 @@ void PropertyListCommand::update(unsigned updateMask)
         // the child is the active widget,
         // TODO: current object?
         if (QDesignerPropertyEditorInterface *propertyEditor = formWindow()->core()->propertyEditor()) {
-            propertyEditor->setObject(propertyEditor->object());
+            if (auto *designerPropertyEditor = qobject_cast<QDesignerPropertyEditor *>(propertyEditor))
+                designerPropertyEditor->scheduleReloadObject();
+            else
+                propertyEditor->setObject(propertyEditor->object());
         }
     }
 }
@@ -1159,7 +1162,7 @@ void PropertyListCommand::undo()
     update(restoreOldValue());
     QDesignerPropertyEditor *designerPropertyEditor = qobject_cast<QDesignerPropertyEditor *>(core()->propertyEditor());
     if (designerPropertyEditor)
-        designerPropertyEditor->updatePropertySheet();
+        designerPropertyEditor->scheduleUpdatePropertySheet();
 }
 
 // check if lists are aequivalent for command merging (same widgets and props)
@@ -1246,7 +1249,7 @@ void SetPropertyCommand::redo()
     update(setValue(m_newValue, true, m_subPropertyMask));
     QDesignerPropertyEditor *designerPropertyEditor = qobject_cast<QDesignerPropertyEditor *>(core()->propertyEditor());
     if (designerPropertyEditor)
-        designerPropertyEditor->updatePropertySheet();
+        designerPropertyEditor->scheduleUpdatePropertySheet();
 }
 
 
@@ -1346,7 +1349,7 @@ void ResetPropertyCommand::redo()
     update(restoreDefaultValue());
     QDesignerPropertyEditor *designerPropertyEditor = qobject_cast<QDesignerPropertyEditor *>(core()->propertyEditor());
     if (designerPropertyEditor)
-        designerPropertyEditor->updatePropertySheet();
+        designerPropertyEditor->scheduleUpdatePropertySheet();
 }
 
 AddDynamicPropertyCommand::AddDynamicPropertyCommand(QDesignerFormWindowInterface *formWindow)
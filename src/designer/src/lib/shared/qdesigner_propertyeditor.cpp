@@ -15,6 +15,8 @@
 
 #include <QtGui/qaction.h>
 
+#include <QtCore/qtimer.h>
+
 QT_BEGIN_NAMESPACE
 
 namespace qdesigner_internal {
@@ -148,6 +150,39 @@ void QDesignerPropertyEditor::slotPropertyChanged(const QString &name, const QVa
         emit propertyValueChanged(name, value, true);
 }
 
+void QDesignerPropertyEditor::scheduleUpdatePropertySheet()
+{
+    startScheduledUpdate(UpdatePropertySheet);
+}
+
+void QDesignerPropertyEditor::scheduleReloadObject()
+{
+    startScheduledUpdate(ReloadObject);
+}
+
+void QDesignerPropertyEditor::startScheduledUpdate(int update)
+{
+    if (m_scheduledUpdate == NoUpdate)
+        QTimer::singleShot(0, this, &QDesignerPropertyEditor::slotScheduledUpdate);
+    m_scheduledUpdate = qMax(m_scheduledUpdate, update);
+}
+
+void QDesignerPropertyEditor::slotScheduledUpdate()
+{
+    const int update = m_scheduledUpdate;
+    m_scheduledUpdate = NoUpdate;
+    switch (update) {
+    case UpdatePropertySheet:
+        updatePropertySheet();
+        break;
+    case ReloadObject:
+        setObject(object());
+        break;
+    default:
+        break;
+    }
+}
+
 }
 
 QT_END_NAMESPACE
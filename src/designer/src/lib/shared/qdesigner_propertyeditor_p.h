@@ -41,6 +41,13 @@ public:
     static StringPropertyParameters textPropertyValidationMode(QDesignerFormEditorInterface *core,
                 const QObject *object, const QString &propertyName, bool isMainContainer);
 
+    // Coalesce the refreshes requested by property commands, for example
+    // when a macro of property changes is undone or a selection of many
+    // objects is changed. A reload (setObject() on the current object)
+    // includes the quick update.
+    void scheduleUpdatePropertySheet();
+    void scheduleReloadObject();
+
 Q_SIGNALS:
     void propertyValueChanged(const QString &name, const QVariant &value, bool enableSubPropertyHandling);
     void resetProperty(const QString &name);
@@ -58,11 +65,17 @@ public Q_SLOTS:
 
 private Q_SLOTS:
     void slotPropertyChanged(const QString &name, const QVariant &value);
+    void slotScheduledUpdate();
 
 protected:
     void emitPropertyValueChanged(const QString &name, const QVariant &value, bool enableSubPropertyHandling);
 
 private:
+    void startScheduledUpdate(int update);
+
+    enum ScheduledUpdate { NoUpdate, UpdatePropertySheet, ReloadObject };
+
+    int m_scheduledUpdate = NoUpdate;
     bool m_propertyChangedForwardingBlocked = false;
 
 };
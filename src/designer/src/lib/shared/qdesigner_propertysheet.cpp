@@ -204,13 +204,27 @@ public:
 
     Info &ensureInfo(int index);
 
+    using InfoHash = QHash<int, Info>;
+
+    // The initial state of the properties of a class, which is the same for
+    // all sheets of the class except for the default values of some types
+    struct ClassData {
+        const QDesignerMetaObjectInterface *meta = nullptr;
+        InfoHash info;
+        QHash<int, QVariant> fakeProperties;
+        QHash<int, QVariant> resourceProperties;
+        QHash<int, qdesigner_internal::PropertySheetStringValue> stringProperties;
+        QHash<int, qdesigner_internal::PropertySheetStringListValue> stringListProperties;
+        QHash<int, qdesigner_internal::PropertySheetKeySequenceValue> keySequenceProperties;
+        QList<int> defaultValueProperties;
+    };
+
     QDesignerPropertySheet *q;
     QDesignerFormEditorInterface *m_core;
     const QDesignerMetaObjectInterface *m_meta;
     const ObjectType m_objectType;
     const ObjectFlags m_objectFlags;
 
-    using InfoHash = QHash<int, Info>;
     InfoHash m_info;
     QHash<int, QVariant> m_fakeProperties;
     QHash<int, QVariant> m_addProperties;
@@ -572,47 +586,70 @@ QDesignerPropertySheet::QDesignerPropertySheet(QObject *object, QObject *parent)
         d->m_fwb->addReloadablePropertySheet(this, object);
     }
 
-    for (int index=0; index<count(); ++index) {
-        const QDesignerMetaPropertyInterface *p = d->m_meta->property(index);
-        const QString name = p->name();
-        if (p->type() == QMetaType::QKeySequence) {
-            createFakeProperty(name);
-        } else {
-            setVisible(index, false); // use the default for `real' properties
-        }
+    // Set up the properties of the class for its first sheet and copy them
+    // for the others.
+    static QHash<const QMetaObject *, QDesignerPropertySheetPrivate::ClassData> classDataHash;
+    QDesignerPropertySheetPrivate::ClassData &classData = classDataHash[object->metaObject()];
+    if (classData.meta != d->m_meta) {
+        classData = {};
+        for (int index=0; index<count(); ++index) {
+            const QDesignerMetaPropertyInterface *p = d->m_meta->property(index);
+            const QString name = p->name();
+            if (p->type() == QMetaType::QKeySequence) {
+                createFakeProperty(name);
+            } else {
+                setVisible(index, false); // use the default for `real' properties
+            }
 
-        QString pgroup = baseMeta->className();
+            QString pgroup = baseMeta->className();
 
-        if (const QDesignerMetaObjectInterface *pmeta = propertyIntroducedBy(baseMeta, index)) {
-            pgroup = pmeta->className();
-        }
+            if (const QDesignerMetaObjectInterface *pmeta = propertyIntroducedBy(baseMeta, index)) {
+                pgroup = pmeta->className();
+            }
 
-        Info &info = d->ensureInfo(index);
-        info.group = pgroup;
-        info.propertyType = propertyTypeFromName(name);
+            Info &info = d->ensureInfo(index);
+            info.group = pgroup;
+            info.propertyType = propertyTypeFromName(name);
 
-        const int type = p->type();
-        switch (type) {
-        case QMetaType::QCursor:
-        case QMetaType::QIcon:
-        case QMetaType::QPixmap:
-            info.defaultValue = p->read(d->m_object);
-            if (type == QMetaType::QIcon || type == QMetaType::QPixmap)
-                d->addResourceProperty(index, type);
-            break;
-        case QMetaType::QString:
-            d->addStringProperty(index);
-            break;
-        case QMetaType::QStringList:
-            d->addStringListProperty(index);
-            break;
-        case QMetaType::QKeySequence:
-            d->addKeySequenceProperty(index);
-            break;
-        default:
-            break;
+            const int type = p->type();
+            switch (type) {
+            case QMetaType::QCursor:
+            case QMetaType::QIcon:
+            case QMetaType::QPixmap:
+                classData.defaultValueProperties.append(index);
+                if (type == QMetaType::QIcon || type == QMetaType::QPixmap)
+                    d->addResourceProperty(index, type);
+                break;
+            case QMetaType::QString:
+                d->addStringProperty(index);
+                break;
+            case QMetaType::QStringList:
+                d->addStringListProperty(index);
+                break;
+            case QMetaType::QKeySequence:
+                d->addKeySequenceProperty(index);
+                break;
+            default:
+                break;
+            }
         }
+        classData.meta = d->m_meta;
+        classData.info = d->m_info;
+        classData.fakeProperties = d->m_fakeProperties;
+        classData.resourceProperties = d->m_resourceProperties;
+        classData.stringProperties = d->m_stringProperties;
+        classData.stringListProperties = d->m_stringListProperties;
+        classData.keySequenceProperties = d->m_keySequenceProperties;
+    } else {
+        d->m_info = classData.info;
+        d->m_fakeProperties = classData.fakeProperties;
+        d->m_resourceProperties = classData.resourceProperties;
+        d->m_stringProperties = classData.stringProperties;
+        d->m_stringListProperties = classData.stringListProperties;
+        d->m_keySequenceProperties = classData.keySequenceProperties;
     }
+    for (int index : std::as_const(classData.defaultValueProperties))
+        d->m_info[index].defaultValue = d->m_meta->property(index)->read(d->m_object);
 
     if (object->isWidgetType()) {
         createFakeProperty(QStringLiteral("focusPolicy"));
@@ -98,6 +98,9 @@ public:
     virtual bool copy(QIODevice *dev, const FormBuilderClipboard &selection) = 0;
     virtual DomUI *copy(const FormBuilderClipboard &selection) = 0;
 
+    // Returns the DOM that save() writes, for snapshots of the form that do not need the XML.
+    virtual DomUI *saveUi(QWidget *widget) = 0;
+
     // A widget parent needs to be specified, otherwise, the widget factory cannot locate the form window via parent
     // and thus is not able to construct special widgets (QLayoutWidget).
     virtual FormBuilderClipboard paste(DomUI *ui, QWidget *widgetParent, QObject *actionParent = nullptr) = 0;
@@ -27,12 +27,18 @@
 #  include <QtGui/qclipboard.h>
 #endif
 #include <QtGui/qdrag.h>
+#include <QtGui/qimagereader.h>
 #include <QtGui/qpainter.h>
 
+#include <QtCore/qbuffer.h>
+#include <QtCore/qcache.h>
+#include <QtCore/qcryptographichash.h>
+#include <QtCore/qfile.h>
 #include <QtCore/qmimedata.h>
 #include <QtCore/qfileinfo.h>
 #include <QtCore/qdir.h>
 #include <QtCore/qqueue.h>
+#include <QtCore/qthreadpool.h>
 
 #include <QtXml/qdom.h>
 
@@ -92,10 +98,39 @@ void ResourceListWidget::startDrag(Qt::DropActions supportedActions)
     drag->exec(Qt::CopyAction);
 }
 
-/* TODO
-
-   1) load the icons in separate thread...Hmm..if Qt is configured with threads....
-*/
+static constexpr int ThumbnailExtent = 48; // matches the icon size of the list widget
+static constexpr int ThumbnailCacheCost = 32 * 1024; // in KB
+
+// Decodes an image at most extent x extent device pixels large and centers
+// it on a transparent square, without QPixmap so that it can run in a worker
+// thread. SVG and other scalable formats are rendered at the thumbnail size
+// directly.
+static QImage makeThumbnail(const QByteArray &data, const QByteArray &format,
+                            int extent, qreal devicePixelRatio, QSize *imageSize)
+{
+    QBuffer buffer;
+    buffer.setData(data);
+    QImageReader reader(&buffer, format);
+    const QSize size = reader.size();
+    if (size.isValid() && (size.width() > extent || size.height() > extent))
+        reader.setScaledSize(size.scaled(extent, extent, Qt::KeepAspectRatio));
+    const QImage image = reader.read();
+    if (image.isNull())
+        return QImage();
+    *imageSize = size.isValid() ? size : image.size();
+
+    const int w = qMax(extent, image.width());
+    const int h = qMax(extent, image.height());
+    QImage thumbnail(w, h, QImage::Format_ARGB32_Premultiplied);
+    thumbnail.fill(0);
+    QRect r(0, 0, image.width(), image.height());
+    r.moveCenter(thumbnail.rect().center());
+    QPainter p(&thumbnail);
+    p.drawImage(r.topLeft(), image);
+    p.end();
+    thumbnail.setDevicePixelRatio(devicePixelRatio);
+    return thumbnail;
+}
 
 // ---------------------------- QtResourceViewPrivate
 class QtResourceViewPrivate
@@ -126,7 +161,19 @@ public:
     void updateActions();
     void filterOutResources();
 
-    QPixmap makeThumbnail(const QPixmap &pix) const;
+    // A decoded thumbnail and the size of the image, both null for files
+    // that are not images.
+    struct Thumbnail {
+        QPixmap pixmap;
+        QSize imageSize;
+    };
+
+    void clearResources();
+    void requestThumbnail(QListWidgetItem *item, const QString &filePath);
+    void thumbnailReady(int generation, const QString &filePath, const QByteArray &key,
+                        const QImage &image, const QSize &imageSize);
+    void setThumbnail(QListWidgetItem *item, const QString &filePath,
+                      const Thumbnail &thumbnail) const;
 
     QDesignerFormEditorInterface *m_core;
     QtResourceModel *m_resourceModel = nullptr;
@@ -142,6 +189,12 @@ public:
     QMap<QTreeWidgetItem *, QString> m_itemToPath;
     QMap<QString, QListWidgetItem *> m_resourceToItem;
     QMap<QListWidgetItem *, QString> m_itemToResource;
+    // Thumbnails by hash of the file contents, so that they stay valid when
+    // resource sets are switched or reloaded.
+    QCache<QByteArray, Thumbnail>   m_thumbnailCache;
+    QThreadPool                      m_thumbnailPool;
+    // Incremented whenever the list is cleared to drop results for old items
+    int m_thumbnailGeneration = 0;
     QAction *m_editResourcesAction = nullptr;
     QAction *m_reloadResourcesAction = nullptr;
     QAction *m_copyResourcePathAction = nullptr;
@@ -161,6 +214,7 @@ QtResourceViewPrivate::QtResourceViewPrivate(QDesignerFormEditorInterface *core)
     m_listWidget(new ResourceListWidget)
 {
     m_toolBar->setIconSize(QSize(22, 22));
+    m_thumbnailCache.setMaxCost(ThumbnailCacheCost);
 }
 
 void QtResourceViewPrivate::restoreSettings()
@@ -241,20 +295,76 @@ void QtResourceViewPrivate::applyExpansionState()
         it.value()->setExpanded(m_expansionState.value(it.key(), true));
 }
 
-QPixmap QtResourceViewPrivate::makeThumbnail(const QPixmap &pix) const
+void QtResourceViewPrivate::clearResources()
+{
+    m_listWidget->clear();
+    m_resourceToItem.clear();
+    m_itemToResource.clear();
+    m_thumbnailPool.clear();
+    ++m_thumbnailGeneration;
+}
+
+// Sets the icon from the cache or has it decoded in the thread pool. The
+// contents are read here as resource data may be unregistered and freed
+// while the worker runs.
+void QtResourceViewPrivate::requestThumbnail(QListWidgetItem *item, const QString &filePath)
+{
+    QFile file(filePath);
+    if (!file.open(QIODevice::ReadOnly)) {
+        item->setToolTip(filePath);
+        return;
+    }
+    const QByteArray data = file.readAll();
+    const QByteArray key = QCryptographicHash::hash(data, QCryptographicHash::Sha1);
+    const qreal devicePixelRatio = m_listWidget->devicePixelRatioF();
+
+    if (const Thumbnail *thumbnail = m_thumbnailCache.object(key)) {
+        if (thumbnail->pixmap.isNull() || thumbnail->pixmap.devicePixelRatio() == devicePixelRatio) {
+            setThumbnail(item, filePath, *thumbnail);
+            return;
+        }
+    }
+
+    item->setToolTip(filePath);
+    const int generation = m_thumbnailGeneration;
+    const QByteArray format = QFileInfo(filePath).suffix().toLatin1();
+    const int extent = qRound(ThumbnailExtent * devicePixelRatio);
+    // The view outlives the pool, which is waited for on destruction.
+    QtResourceView *view = q_ptr;
+    m_thumbnailPool.start([this, view, generation, filePath, key, data, format, extent, devicePixelRatio] {
+        QSize imageSize;
+        const QImage image = makeThumbnail(data, format, extent, devicePixelRatio, &imageSize);
+        QMetaObject::invokeMethod(view, [this, generation, filePath, key, image, imageSize] {
+            thumbnailReady(generation, filePath, key, image, imageSize);
+        }, Qt::QueuedConnection);
+    });
+}
+
+void QtResourceViewPrivate::thumbnailReady(int generation, const QString &filePath,
+                                           const QByteArray &key, const QImage &image,
+                                           const QSize &imageSize)
+{
+    auto *thumbnail = new Thumbnail{QPixmap::fromImage(image), imageSize};
+    const qsizetype cost = qMax(qsizetype(1), image.sizeInBytes() / 1024);
+    const Thumbnail result = *thumbnail;
+    m_thumbnailCache.insert(key, thumbnail, cost);
+
+    if (generation != m_thumbnailGeneration)
+        return;
+    if (QListWidgetItem *item = m_resourceToItem.value(filePath))
+        setThumbnail(item, filePath, result);
+}
+
+void QtResourceViewPrivate::setThumbnail(QListWidgetItem *item, const QString &filePath,
+                                         const Thumbnail &thumbnail) const
 {
-    int w = qMax(48, pix.width());
-    int h = qMax(48, pix.height());
-    QRect imgRect(0, 0, w, h);
-    QImage img(w, h, QImage::Format_ARGB32_Premultiplied);
-    img.fill(0);
-    if (!pix.isNull()) {
-        QRect r(0, 0, pix.width(), pix.height());
-        r.moveCenter(imgRect.center());
-        QPainter p(&img);
-        p.drawPixmap(r.topLeft(), pix);
+    if (thumbnail.pixmap.isNull()) {
+        item->setToolTip(filePath);
+    } else {
+        item->setIcon(QIcon(thumbnail.pixmap));
+        const QSize &size = thumbnail.imageSize;
+        item->setToolTip(QtResourceView::tr("Size: %1 x %2\n%3").arg(size.width()).arg(size.height()).arg(filePath));
     }
-    return QPixmap::fromImage(img);
 }
 
 void QtResourceViewPrivate::updateActions()
@@ -284,9 +394,7 @@ void QtResourceViewPrivate::slotResourceSetActivated(QtResourceSet *resourceSet)
     m_pathToSubPaths.clear();
     m_pathToItem.clear();
     m_itemToPath.clear();
-    m_listWidget->clear();
-    m_resourceToItem.clear();
-    m_itemToResource.clear();
+    clearResources();
 
     createPaths();
     applyExpansionState();
@@ -303,9 +411,7 @@ void QtResourceViewPrivate::slotCurrentPathChanged(QTreeWidgetItem *item)
     if (m_ignoreGuiSignals)
         return;
 
-    m_listWidget->clear();
-    m_resourceToItem.clear();
-    m_itemToResource.clear();
+    clearResources();
 
     if (!item)
         return;
@@ -505,14 +611,7 @@ void QtResourceViewPrivate::createResources(const QString &path)
             QFileInfo fi(filePath);
             if (fi.isFile()) {
                 QListWidgetItem *item = new QListWidgetItem(fi.fileName(), m_listWidget);
-                const QPixmap pix = QPixmap(filePath);
-                if (pix.isNull()) {
-                    item->setToolTip(filePath);
-                } else {
-                    item->setIcon(QIcon(makeThumbnail(pix)));
-                    const QSize size = pix.size();
-                    item->setToolTip(QtResourceView::tr("Size: %1 x %2\n%3").arg(size.width()).arg(size.height()).arg(filePath));
-                }
+                requestThumbnail(item, filePath);
                 item->setFlags(item->flags() | Qt::ItemIsDragEnabled);
                 item->setData(Qt::UserRole, filePath);
                 m_itemToResource[item] = filePath;
@@ -596,6 +695,8 @@ QtResourceView::~QtResourceView()
 {
     if (!d_ptr->m_settingsKey.isEmpty())
         d_ptr->saveSettings();
+    d_ptr->m_thumbnailPool.clear();
+    d_ptr->m_thumbnailPool.waitForDone();
 }
 
 bool QtResourceView::event(QEvent *event)
@@ -675,7 +776,7 @@ void QtResourceView::setResourceModel(QtResourceModel *model)
 
     // clear here
     d_ptr->m_treeWidget->clear();
-    d_ptr->m_listWidget->clear();
+    d_ptr->clearResources();
 
     d_ptr->m_resourceModel = model;
 
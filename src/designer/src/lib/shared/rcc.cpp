@@ -6,6 +6,7 @@
 #include "rcc_p.h"
 
 #include <QtCore/qbytearray.h>
+#include <QtCore/qcryptographichash.h>
 #include <QtCore/qdatetime.h>
 #include <QtCore/qdebug.h>
 #include <QtCore/qdir.h>
@@ -13,7 +14,9 @@
 #include <QtCore/qfile.h>
 #include <QtCore/qiodevice.h>
 #include <QtCore/qlocale.h>
+#include <QtCore/qmutex.h>
 #include <QtCore/qstack.h>
+#include <QtCore/qthreadpool.h>
 #include <QtCore/qxmlstream.h>
 
 #include <algorithm>
@@ -47,6 +50,55 @@ static inline QString msgOpenReadFailed(const QString &fname, const QString &why
     return QString::fromUtf8("Unable to open %1 for reading: %2\n").arg(fname).arg(why);
 }
 
+#ifndef QT_NO_COMPRESS
+// Compressed payloads by content, so that reloading resources only
+// compresses the files that actually changed.
+namespace {
+struct CompressedData
+{
+    QByteArray data;
+    bool compressed = false;
+};
+
+class CompressionCache
+{
+public:
+    bool find(const QByteArray &key, CompressedData *result) const;
+    void insert(const QByteArray &key, const CompressedData &data);
+
+private:
+    enum { MaxSize = 64 * 1024 * 1024 };
+
+    mutable QMutex m_mutex;
+    QHash<QByteArray, CompressedData> m_entries;
+    qsizetype m_size = 0;
+};
+
+bool CompressionCache::find(const QByteArray &key, CompressedData *result) const
+{
+    QMutexLocker locker(&m_mutex);
+    const auto it = m_entries.constFind(key);
+    if (it == m_entries.constEnd())
+        return false;
+    *result = it.value();
+    return true;
+}
+
+void CompressionCache::insert(const QByteArray &key, const CompressedData &data)
+{
+    QMutexLocker locker(&m_mutex);
+    if (m_size + data.data.size() > MaxSize) {
+        m_entries.clear();
+        m_size = 0;
+    }
+    m_entries.insert(key, data);
+    m_size += data.data.size();
+}
+} // namespace
+
+Q_GLOBAL_STATIC(CompressionCache, compressionCache)
+#endif // QT_NO_COMPRESS
+
 
 ///////////////////////////////////////////////////////////
 //
@@ -75,6 +127,7 @@ public:
     QString resourceName() const;
 
 public:
+    bool readData();
     qint64 writeDataBlob(RCCResourceLibrary &lib, qint64 offset, QString *errorMessage);
     qint64 writeDataName(RCCResourceLibrary &, qint64 offset);
     void writeDataInfo(RCCResourceLibrary &lib);
@@ -92,6 +145,10 @@ public:
     qint64 m_nameOffset;
     qint64 m_dataOffset;
     qint64 m_childOffset;
+
+    // Payload to be written, set up by readData()
+    QByteArray m_data;
+    QString m_errorMessage;
 };
 
 RCCFileInfo::RCCFileInfo(const QString &name, const QFileInfo &fileInfo,
@@ -175,35 +232,56 @@ void RCCFileInfo::writeDataInfo(RCCResourceLibrary &lib)
         lib.writeChar('\n');
 }
 
-qint64 RCCFileInfo::writeDataBlob(RCCResourceLibrary &lib, qint64 offset,
-    QString *errorMessage)
+// Read and compress the payload. Called from worker threads.
+bool RCCFileInfo::readData()
 {
-    const bool text = (lib.m_format == RCCResourceLibrary::C_Code);
-
-    //capture the offset
-    m_dataOffset = offset;
-
-    //find the data to be written
     QFile file(m_fileInfo.absoluteFilePath());
     if (!file.open(QFile::ReadOnly)) {
-        *errorMessage = msgOpenReadFailed(m_fileInfo.absoluteFilePath(), file.errorString());
-        return 0;
+        m_errorMessage = msgOpenReadFailed(m_fileInfo.absoluteFilePath(), file.errorString());
+        return false;
     }
-    QByteArray data = file.readAll();
+    m_data = file.readAll();
 
 #ifndef QT_NO_COMPRESS
     // Check if compression is useful for this file
-    if (m_compressLevel != 0 && data.size() != 0) {
-        QByteArray compressed =
-            qCompress(reinterpret_cast<uchar *>(data.data()), data.size(), m_compressLevel);
-
-        int compressRatio = int(100.0 * (data.size() - compressed.size()) / data.size());
-        if (compressRatio >= m_compressThreshold) {
-            data = compressed;
+    if (m_compressLevel != 0 && m_data.size() != 0) {
+        QByteArray key = QCryptographicHash::hash(m_data, QCryptographicHash::Sha1);
+        key += QByteArray::number(m_compressLevel) + '/' + QByteArray::number(m_compressThreshold);
+        CompressedData cached;
+        if (!compressionCache()->find(key, &cached)) {
+            QByteArray compressed =
+                qCompress(reinterpret_cast<const uchar *>(m_data.constData()), m_data.size(), m_compressLevel);
+
+            int compressRatio = int(100.0 * (m_data.size() - compressed.size()) / m_data.size());
+            cached.compressed = compressRatio >= m_compressThreshold;
+            if (cached.compressed)
+                cached.data = compressed;
+            compressionCache()->insert(key, cached);
+        }
+        if (cached.compressed) {
+            m_data = cached.data;
             m_flags |= Compressed;
         }
     }
 #endif // QT_NO_COMPRESS
+    return true;
+}
+
+qint64 RCCFileInfo::writeDataBlob(RCCResourceLibrary &lib, qint64 offset,
+    QString *errorMessage)
+{
+    const bool text = (lib.m_format == RCCResourceLibrary::C_Code);
+
+    //capture the offset
+    m_dataOffset = offset;
+
+    //find the data to be written
+    if (!m_errorMessage.isEmpty()) {
+        *errorMessage = m_errorMessage;
+        return 0;
+    }
+    const QByteArray data = m_data;
+    m_data.clear();
 
     // some info
     if (text) {
@@ -787,8 +865,7 @@ bool RCCResourceLibrary::writeDataBlobs()
         return false;
 
     pending.push(m_root);
-    qint64 offset = 0;
-    QString errorMessage;
+    QList<RCCFileInfo *> files;
     while (!pending.isEmpty()) {
         RCCFileInfo *file = pending.pop();
         for (QHash<QString, RCCFileInfo*>::iterator it = file->m_children.begin();
@@ -796,13 +873,29 @@ bool RCCResourceLibrary::writeDataBlobs()
             RCCFileInfo *child = it.value();
             if (child->m_flags & RCCFileInfo::Directory)
                 pending.push(child);
-            else {
-                offset = child->writeDataBlob(*this, offset, &errorMessage);
-                if (offset == 0) {
-                    m_errorDevice->write(errorMessage.toUtf8());
-                    return false;
-                }
-            }
+            else
+                files.append(child);
+        }
+    }
+
+    // Read and compress the files in parallel, then write them in order.
+    if (files.size() > 1) {
+        QThreadPool pool;
+        for (RCCFileInfo *file : std::as_const(files))
+            pool.start([file] { file->readData(); });
+        pool.waitForDone();
+    } else {
+        for (RCCFileInfo *file : std::as_const(files))
+            file->readData();
+    }
+
+    qint64 offset = 0;
+    QString errorMessage;
+    for (RCCFileInfo *file : std::as_const(files)) {
+        offset = file->writeDataBlob(*this, offset, &errorMessage);
+        if (offset == 0) {
+            m_errorDevice->write(errorMessage.toUtf8());
+            return false;
         }
     }
     if (m_format == C_Code)
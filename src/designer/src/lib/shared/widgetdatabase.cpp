@@ -41,6 +41,10 @@ namespace qdesigner_internal {
 
 using namespace Qt::StringLiterals;
 
+// Number of renames of items, which invalidate the class name index of
+// WidgetDataBase as the items do not know their data base.
+static quint64 itemRenameCount = 0;
+
 // ----------------------------------------------------------
 WidgetDataBaseItem::WidgetDataBaseItem(const QString &name, const QString &group)
     : m_name(name),
@@ -59,7 +63,10 @@ QString WidgetDataBaseItem::name() const
 
 void WidgetDataBaseItem::setName(const QString &name)
 {
-    m_name = name;
+    if (m_name != name) {
+        m_name = name;
+        ++itemRenameCount;
+    }
 }
 
 QString WidgetDataBaseItem::group() const
@@ -174,14 +181,25 @@ void WidgetDataBaseItem::setExtends(const QString &s)
 
 void WidgetDataBaseItem::setDefaultPropertyValues(const QList<QVariant> &list)
 {
+    m_pendingDefaultPropertyValuesDataBase = nullptr;
     m_defaultPropertyValues = list;
 }
 
 QList<QVariant> WidgetDataBaseItem::defaultPropertyValues() const
 {
+    if (WidgetDataBase *db = m_pendingDefaultPropertyValuesDataBase) {
+        m_pendingDefaultPropertyValuesDataBase = nullptr;
+        m_defaultPropertyValues = db->defaultPropertyValues(m_name);
+    }
     return m_defaultPropertyValues;
 }
 
+void WidgetDataBaseItem::setDefaultPropertyValuesPending(WidgetDataBase *db)
+{
+    m_pendingDefaultPropertyValuesDataBase = db;
+    m_defaultPropertyValues.clear();
+}
+
 QStringList WidgetDataBaseItem::fakeSlots() const
 {
     return m_fakeSlots;
@@ -349,7 +367,36 @@ int WidgetDataBase::indexOfObject(QObject *object, bool /*resolveName*/) const
     if (id.isEmpty())
         id = WidgetFactory::classNameOf(m_core,object);
 
-    return QDesignerWidgetDataBaseInterface::indexOfClassName(id);
+    return WidgetDataBase::indexOfClassName(id);
+}
+
+void WidgetDataBase::updateClassNameIndex() const
+{
+    m_classNameIndex.clear();
+    m_classNameIndex.reserve(m_items.size());
+    // Backwards so that the first item of a name wins as in a linear search
+    for (auto i = m_items.size() - 1; i >= 0; --i)
+        m_classNameIndex.insert(m_items.at(i)->name(), int(i));
+    m_classNameIndexRenameCount = itemRenameCount;
+}
+
+int WidgetDataBase::indexOfClassName(const QString &className, bool) const
+{
+    if (m_classNameIndex.isEmpty() || m_classNameIndexRenameCount != itemRenameCount)
+        updateClassNameIndex();
+    return m_classNameIndex.value(className, -1);
+}
+
+void WidgetDataBase::insert(int index, QDesignerWidgetDataBaseItemInterface *item)
+{
+    QDesignerWidgetDataBaseInterface::insert(index, item);
+    invalidateClassNameIndex();
+}
+
+void WidgetDataBase::append(QDesignerWidgetDataBaseItemInterface *item)
+{
+    QDesignerWidgetDataBaseInterface::append(item);
+    invalidateClassNameIndex();
 }
 
 static WidgetDataBaseItem *createCustomWidgetItem(const QDesignerCustomWidgetInterface *c,
@@ -413,6 +460,7 @@ void WidgetDataBase::loadPlugins()
                 const int existingIndex = existingIt.value();
                 delete m_items[existingIndex];
                 m_items[existingIndex] = pluginItem;
+                invalidateClassNameIndex();
                 existingCustomClasses.erase(existingIt);
                 replacedPlugins++;
 
@@ -438,6 +486,7 @@ void WidgetDataBase::remove(int index)
 {
     Q_ASSERT(index < m_items.size());
     delete m_items.takeAt(index);
+    invalidateClassNameIndex();
 }
 
 QList<QVariant> WidgetDataBase::defaultPropertyValues(const QString &name)
@@ -467,11 +516,8 @@ QList<QVariant> WidgetDataBase::defaultPropertyValues(const QString &name)
 void WidgetDataBase::grabDefaultPropertyValues()
 {
     const int itemCount = count();
-    for (int i = 0; i < itemCount; ++i) {
-        QDesignerWidgetDataBaseItemInterface *dbItem = item(i);
-        const auto default_prop_values = defaultPropertyValues(dbItem->name());
-        dbItem->setDefaultPropertyValues(default_prop_values);
-    }
+    for (int i = 0; i < itemCount; ++i)
+        static_cast<WidgetDataBaseItem *>(item(i))->setDefaultPropertyValuesPending(this);
 }
 
 void WidgetDataBase::grabStandardWidgetBoxIcons()
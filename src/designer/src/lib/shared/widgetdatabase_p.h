@@ -21,6 +21,7 @@
 #include <QtDesigner/abstractwidgetdatabase.h>
 
 #include <QtGui/qicon.h>
+#include <QtCore/qhash.h>
 #include <QtCore/qstring.h>
 #include <QtCore/qvariant.h>
 #include <QtCore/qpair.h>
@@ -78,6 +79,9 @@ public:
 
     void setDefaultPropertyValues(const QList<QVariant> &list) override;
     QList<QVariant> defaultPropertyValues() const override;
+    // Obtain the default property values from an instance created by the
+    // database when they are first needed.
+    void setDefaultPropertyValuesPending(class WidgetDataBase *db);
 
     static WidgetDataBaseItem *clone(const QDesignerWidgetDataBaseItemInterface *item);
 
@@ -108,7 +112,8 @@ private:
     uint m_container: 1;
     uint m_custom: 1;
     uint m_promoted: 1;
-    QList<QVariant> m_defaultPropertyValues;
+    mutable WidgetDataBase *m_pendingDefaultPropertyValuesDataBase = nullptr;
+    mutable QList<QVariant> m_defaultPropertyValues;
     QStringList m_fakeSlots;
     QStringList m_fakeSignals;
 };
@@ -130,11 +135,16 @@ public:
     QDesignerFormEditorInterface *core() const override;
 
     int indexOfObject(QObject *o, bool resolveName = true) const override;
+    int indexOfClassName(const QString &className, bool resolveName = true) const override;
 
+    void insert(int index, QDesignerWidgetDataBaseItemInterface *item) override;
+    void append(QDesignerWidgetDataBaseItemInterface *item) override;
     void remove(int index);
 
-
+    // Marks the default property values of all items to be obtained on
+    // first use, instantiating the widgets lazily.
     void grabDefaultPropertyValues();
+    QList<QVariant> defaultPropertyValues(const QString &name);
     void grabStandardWidgetBoxIcons();
 
     // Helpers for 'New Form' wizards in integrations. Obtain a list of suitable classes and generate XML for them.
@@ -149,9 +159,14 @@ public slots:
     void loadPlugins();
 
 private:
-    QList<QVariant> defaultPropertyValues(const QString &name);
+    void invalidateClassNameIndex() { m_classNameIndex.clear(); }
+    void updateClassNameIndex() const;
 
     QDesignerFormEditorInterface *m_core;
+    // Index of the items by class name, built on demand. It is cleared when
+    // items are added or removed and rebuilt when items were renamed.
+    mutable QHash<QString, int> m_classNameIndex;
+    mutable quint64 m_classNameIndexRenameCount = 0;
 };
 
 QDESIGNER_SHARED_EXPORT QDesignerWidgetDataBaseItemInterface
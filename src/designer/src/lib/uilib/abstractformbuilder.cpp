@@ -134,11 +134,21 @@ QAbstractFormBuilder::~QAbstractFormBuilder() = default;
     Loads an XML representation of a widget from the given \a device,
     and constructs a new widget with the specified \a parent.
 
-    \sa save(), errorString()
+    Since Qt 6.5, the device may also contain a compiled form as written
+    to the form cache of QUiLoader.
+
+    \sa save(), errorString(), QUiLoader::setFormCacheDirectory()
 */
 QWidget *QAbstractFormBuilder::load(QIODevice *dev, QWidget *parentWidget)
 {
-    QScopedPointer<DomUI> ui(d->readUi(dev));
+    // The DOM is thrown away once the widgets are created, so it is
+    // allocated in one go. The arena has to outlive it.
+    DomArena arena;
+    QScopedPointer<DomUI> ui;
+    {
+        const DomArena::Scope arenaScope(&arena);
+        ui.reset(QFormBuilderExtra::isCompiledUi(dev) ? d->readCompiledUi(dev) : d->readUi(dev));
+    }
     if (ui.isNull())
         return nullptr;
     QWidget *widget = create(ui.data(), parentWidget);
@@ -147,6 +157,37 @@ QWidget *QAbstractFormBuilder::load(QIODevice *dev, QWidget *parentWidget)
     return widget;
 }
 
+/*!
+    \since 6.5
+
+    Reads the XML representation of a form from \a uiDevice and writes
+    it to \a compiledDevice as a compiled form, which load() reads
+    without parsing XML. Returns \c true on success.
+
+    Compiled forms are meant to be generated when building an application
+    and shipped instead of the \c .ui files. They depend on the version
+    of Qt they were written with; load() rejects forms of a different
+    format version.
+
+    \sa load(), errorString()
+*/
+bool QAbstractFormBuilder::compile(QIODevice *uiDevice, QIODevice *compiledDevice)
+{
+    DomArena arena;
+    QScopedPointer<DomUI> ui;
+    {
+        const DomArena::Scope arenaScope(&arena);
+        ui.reset(d->readUi(uiDevice));
+    }
+    if (ui.isNull())
+        return false;
+    if (!QFormBuilderExtra::writeCompiledUi(ui.data(), compiledDevice)) {
+        d->m_errorString = compiledDevice->errorString();
+        return false;
+    }
+    return true;
+}
+
 /*!
     \internal
 */
@@ -880,7 +921,7 @@ void QAbstractFormBuilder::applyProperties(QObject *o, const QList<DomProperty*>
             if (attributeName == QLatin1String("numDigits") && o->inherits("QLCDNumber")) // Deprecated in Qt 4, removed in Qt 5.
                 attributeName = QLatin1String("digitCount");
             if (!d->applyPropertyInternally(o, attributeName, v))
-                o->setProperty(attributeName.toUtf8(), v);
+                d->setProperty(o, attributeName, v);
         }
     }
 }
@@ -1013,12 +1054,12 @@ void QAbstractFormBuilder::save(QIODevice *dev, QWidget *widget)
 
     saveDom(ui, widget);
 
-    QXmlStreamWriter writer(dev);
-    writer.setAutoFormatting(true);
-    writer.setAutoFormattingIndent(1);
+    QByteArray xml;
+    DomXmlWriter writer(&xml);
     writer.writeStartDocument();
     ui->write(writer);
     writer.writeEndDocument();
+    dev->write(xml);
 
     d->m_laidout.clear();
 
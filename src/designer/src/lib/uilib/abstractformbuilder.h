@@ -82,6 +82,8 @@ public:
     virtual QWidget *load(QIODevice *dev, QWidget *parentWidget = nullptr);
     virtual void save(QIODevice *dev, QWidget *widget);
 
+    bool compile(QIODevice *uiDevice, QIODevice *compiledDevice);
+
     QString errorString() const;
 
 protected:
@@ -494,7 +494,7 @@ void QFormBuilder::applyProperties(QObject *o, const QList<DomProperty*> &proper
             // ### special-casing for Line (QFrame) -- try to fix me
             o->setProperty("frameShape", v); // v is of QFrame::Shape enum
         } else {
-            o->setProperty(attributeName.toUtf8(), v);
+            d->setProperty(o, attributeName, v);
         }
     }
 }
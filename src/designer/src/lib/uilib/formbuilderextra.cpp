@@ -13,7 +13,10 @@
 #include <QtWidgets/qgridlayout.h>
 
 #include <QtCore/qvariant.h>
+#include <QtCore/qcryptographichash.h>
+#include <QtCore/qdatastream.h>
 #include <QtCore/qdebug.h>
+#include <QtCore/qmetaobject.h>
 #include <QtCore/qtextstream.h>
 #include <QtCore/qstringlist.h>
 #include <QtCore/qcoreapplication.h>
@@ -71,6 +74,37 @@ static inline QString msgXmlError(const QXmlStreamReader &reader)
                                        .arg(reader.errorString());
 }
 
+// Check the version and the (optional) language attribute of an <ui> element.
+static bool checkUiAttributes(const QXmlStreamAttributes &attributes, const QString &language,
+                              QString *errorMessage)
+{
+    const QString versionAttribute = QStringLiteral("version");
+    const QString languageAttribute = QStringLiteral("language");
+    if (attributes.hasAttribute(versionAttribute)) {
+        const QVersionNumber version =
+            QVersionNumber::fromString(attributes.value(versionAttribute));
+        if (version < QVersionNumber(4)) {
+            *errorMessage =
+                QCoreApplication::translate("QAbstractFormBuilder",
+                                            "This file was created using Designer from Qt-%1 and cannot be read.")
+                                            .arg(attributes.value(versionAttribute));
+            return false;
+        } // version error
+    }     // has version
+    if (attributes.hasAttribute(languageAttribute)) {
+        // Check on optional language (Jambi)
+        const QString formLanguage = attributes.value(languageAttribute).toString();
+        if (!formLanguage.isEmpty() && formLanguage.compare(language, Qt::CaseInsensitive)) {
+            *errorMessage =
+                QCoreApplication::translate("QAbstractFormBuilder",
+                                            "This file cannot be read because it was created using %1.")
+                                            .arg(formLanguage);
+            return false;
+        } // language error
+    }    // has language
+    return true;
+}
+
 // Read and check the  version and the (optional) language attribute
 // of an <ui> element and leave reader positioned at <ui>.
 static bool inline readUiAttributes(QXmlStreamReader &reader, const QString &language,
@@ -84,34 +118,8 @@ static bool inline readUiAttributes(QXmlStreamReader &reader, const QString &lan
             *errorMessage = msgXmlError(reader);
             return false;
         case QXmlStreamReader::StartElement:
-            if (reader.name().compare(uiElement, Qt::CaseInsensitive) == 0) {
-                const QString versionAttribute = QStringLiteral("version");
-                const QString languageAttribute = QStringLiteral("language");
-                const QXmlStreamAttributes attributes = reader.attributes();
-                if (attributes.hasAttribute(versionAttribute)) {
-                    const QVersionNumber version =
-                        QVersionNumber::fromString(attributes.value(versionAttribute));
-                    if (version < QVersionNumber(4)) {
-                        *errorMessage =
-                            QCoreApplication::translate("QAbstractFormBuilder",
-                                                        "This file was created using Designer from Qt-%1 and cannot be read.")
-                                                        .arg(attributes.value(versionAttribute));
-                        return false;
-                    } // version error
-                }     // has version
-                if (attributes.hasAttribute(languageAttribute)) {
-                    // Check on optional language (Jambi)
-                    const QString formLanguage = attributes.value(languageAttribute).toString();
-                    if (!formLanguage.isEmpty() && formLanguage.compare(language, Qt::CaseInsensitive)) {
-                        *errorMessage =
-                            QCoreApplication::translate("QAbstractFormBuilder",
-                                                        "This file cannot be read because it was created using %1.")
-                                                        .arg(formLanguage);
-                        return false;
-                    } // language error
-                }    // has language
-                return true;
-            }  // <ui> matched
+            if (reader.name().compare(uiElement, Qt::CaseInsensitive) == 0)
+                return checkUiAttributes(reader.attributes(), language, errorMessage);
             break;
         default:
             break;
@@ -142,6 +150,73 @@ DomUI *QFormBuilderExtra::readUi(QIODevice *dev)
     return ui;
 }
 
+// Compiled forms start with a magic number and the version of the format,
+// which has to be increased whenever ui4.xsd changes.
+static const quint32 compiledUiMagic = 0x51554942; // "QUIB"
+static const quint32 compiledUiVersion = 1;
+
+DomUI *QFormBuilderExtra::readCompiledUi(QIODevice *dev)
+{
+    QDataStream stream(dev);
+    stream.setVersion(QDataStream::Qt_6_5);
+    quint32 magic = 0;
+    quint32 version = 0;
+    stream >> magic >> version;
+    m_errorString.clear();
+    if (magic != compiledUiMagic || version != compiledUiVersion) {
+        m_errorString = QCoreApplication::translate("QAbstractFormBuilder",
+                                                    "Invalid compiled form: Unknown format.");
+        uiLibWarning(m_errorString);
+        return nullptr;
+    }
+    DomUI *ui = new DomUI;
+    ui->read(stream);
+    if (stream.status() != QDataStream::Ok) {
+        m_errorString = QCoreApplication::translate("QAbstractFormBuilder",
+                                                    "Invalid compiled form: The data is truncated or corrupt.");
+        uiLibWarning(m_errorString);
+        delete ui;
+        return nullptr;
+    }
+    // The same checks as for the <ui> element of the form it was compiled from
+    QXmlStreamAttributes attributes;
+    if (ui->hasAttributeVersion())
+        attributes.append(QStringLiteral("version"), ui->attributeVersion());
+    if (ui->hasAttributeLanguage())
+        attributes.append(QStringLiteral("language"), ui->attributeLanguage());
+    if (!checkUiAttributes(attributes, m_language, &m_errorString)) {
+        uiLibWarning(m_errorString);
+        delete ui;
+        return nullptr;
+    }
+    return ui;
+}
+
+bool QFormBuilderExtra::writeCompiledUi(const DomUI *ui, QIODevice *dev)
+{
+    QDataStream stream(dev);
+    stream.setVersion(QDataStream::Qt_6_5);
+    stream << compiledUiMagic << compiledUiVersion;
+    ui->write(stream);
+    return stream.status() == QDataStream::Ok;
+}
+
+QString QFormBuilderExtra::compiledUiFileName(const QByteArray &uiContents)
+{
+    const QByteArray hash = QCryptographicHash::hash(uiContents, QCryptographicHash::Sha256);
+    return QString::fromLatin1(hash.toHex()) + u'-' + QString::number(compiledUiVersion)
+        + QStringLiteral(".uic");
+}
+
+bool QFormBuilderExtra::isCompiledUi(QIODevice *dev)
+{
+    const QByteArray header = dev->peek(sizeof(quint32));
+    QDataStream stream(header);
+    quint32 magic = 0;
+    stream >> magic;
+    return magic == compiledUiMagic;
+}
+
 QString QFormBuilderExtra::msgInvalidUiFile()
 {
     return QCoreApplication::translate("QAbstractFormBuilder", "Invalid UI file");
@@ -240,6 +315,43 @@ bool QFormBuilderExtra::isCustomWidgetContainer(const QString &className) const
     return false;
 }
 
+int QFormBuilderExtra::propertyIndex(const QMetaObject *meta, const QString &propertyName)
+{
+    const PropertyKey key(meta, propertyName);
+    auto it = m_propertyIndexes.constFind(key);
+    if (it == m_propertyIndexes.constEnd())
+        it = m_propertyIndexes.insert(key, meta->indexOfProperty(propertyName.toUtf8()));
+    return it.value();
+}
+
+// Returns the value of the keys of the enumeration or flags of the property,
+// -1 if they do not match.
+int QFormBuilderExtra::enumValue(const QMetaObject *meta, int propertyIndex, const QString &keys)
+{
+    QHash<QString, int> &values = m_enumValues[EnumKey(meta, propertyIndex)];
+    auto it = values.constFind(keys);
+    if (it == values.constEnd()) {
+        const QMetaEnum e = meta->property(propertyIndex).enumerator();
+        const QByteArray utf8Keys = keys.toUtf8();
+        it = values.insert(keys, e.isFlag() ? e.keysToValue(utf8Keys) : e.keyToValue(utf8Keys));
+    }
+    return it.value();
+}
+
+// QObject::setProperty() using the cached property index; read-only and
+// dynamic properties are left to QObject.
+bool QFormBuilderExtra::setProperty(QObject *o, const QString &propertyName, const QVariant &value)
+{
+    const QMetaObject *meta = o->metaObject();
+    const int index = propertyIndex(meta, propertyName);
+    if (index != -1) {
+        const QMetaProperty property = meta->property(index);
+        if (property.isWritable())
+            return property.write(o, value);
+    }
+    return o->setProperty(propertyName.toUtf8(), value);
+}
+
 void QFormBuilderExtra::setProcessingLayoutWidget(bool processing)
 {
     m_layoutWidget = processing;
@@ -32,6 +32,7 @@ class QVariant;
 class QWidget;
 class QObject;
 class QLabel;
+class QMetaObject;
 class QButtonGroup;
 class QBoxLayout;
 class QGridLayout;
@@ -75,6 +76,11 @@ public:
     void clear();
 
     DomUI *readUi(QIODevice *dev);
+    // Compiled forms are the DOM written to a QDataStream, see QUiLoader
+    DomUI *readCompiledUi(QIODevice *dev);
+    static bool writeCompiledUi(const DomUI *ui, QIODevice *dev);
+    static bool isCompiledUi(QIODevice *dev);
+    static QString compiledUiFileName(const QByteArray &uiContents);
     static QString msgInvalidUiFile();
 
     bool applyPropertyInternally(QObject *o, const QString &propertyName, const QVariant &value);
@@ -102,6 +108,12 @@ public:
     QString customWidgetBaseClass(const QString &className) const;
     bool isCustomWidgetContainer(const QString &className) const;
 
+    // --- Property indexes and enumeration values cached across loads since the
+    // same classes are instantiated over and over
+    int propertyIndex(const QMetaObject *meta, const QString &propertyName);
+    int enumValue(const QMetaObject *meta, int propertyIndex, const QString &keys);
+    bool setProperty(QObject *o, const QString &propertyName, const QVariant &value);
+
     // --- Hash used in creating button groups on demand. Store a map of name and pair of dom group and real group
     void registerButtonGroups(const DomButtonGroups *groups);
 
@@ -166,6 +178,11 @@ private:
 
     ButtonGroupHash m_buttonGroups;
 
+    using PropertyKey = QPair<const QMetaObject *, QString>;
+    QHash<PropertyKey, int> m_propertyIndexes;
+    using EnumKey = QPair<const QMetaObject *, int>;
+    QHash<EnumKey, QHash<QString, int>> m_enumValues;
+
     bool m_layoutWidget = false;
     QResourceBuilder *m_resourceBuilder = nullptr;
     QTextBuilder *m_textBuilder = nullptr;
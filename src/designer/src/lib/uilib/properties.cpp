@@ -38,7 +38,7 @@ QVariant domPropertyToVariant(QAbstractFormBuilder *afb,const QMetaObject *meta,
     // Complex types that need functions from QAbstractFormBuilder
     switch(p->kind()) {
     case DomProperty::String: {
-        const int index = meta->indexOfProperty(p->attributeName().toUtf8());
+        const int index = afb->d->propertyIndex(meta, p->attributeName());
         if (index != -1 && meta->property(index).metaType().id() == QMetaType::QKeySequence)
             return QVariant::fromValue(QKeySequence(p->elementString()->text()));
     }
@@ -62,21 +62,19 @@ QVariant domPropertyToVariant(QAbstractFormBuilder *afb,const QMetaObject *meta,
     }
 
     case DomProperty::Set: {
-        const QByteArray pname = p->attributeName().toUtf8();
-        const int index = meta->indexOfProperty(pname);
+        const int index = afb->d->propertyIndex(meta, p->attributeName());
         if (index == -1) {
             uiLibWarning(QCoreApplication::translate("QFormBuilder", "The set-type property %1 could not be read.").arg(p->attributeName()));
             return QVariant();
         }
 
-        const QMetaEnum e = meta->property(index).enumerator();
-        Q_ASSERT(e.isFlag() == true);
-        return QVariant(e.keysToValue(p->elementSet().toUtf8()));
+        Q_ASSERT(meta->property(index).enumerator().isFlag() == true);
+        return QVariant(afb->d->enumValue(meta, index, p->elementSet()));
     }
 
     case DomProperty::Enum: {
-        const QByteArray pname = p->attributeName().toUtf8();
-        const int index = meta->indexOfProperty(pname);
+        const QString pname = p->attributeName();
+        const int index = afb->d->propertyIndex(meta, pname);
         QString enumValue = p->elementEnum();
         // Triggers in case of objects in Designer like Spacer/Line for which properties
         // are serialized using language introspection. On preview, however, these objects are
@@ -85,15 +83,14 @@ QVariant domPropertyToVariant(QAbstractFormBuilder *afb,const QMetaObject *meta,
         if (index == -1) {
             // ### special-casing for Line (QFrame) -- fix for 4.2. Jambi hack for enumerations
             if (!qstrcmp(meta->className(), "QFrame")
-                && (pname == QByteArray("orientation"))) {
+                && (pname == QLatin1String("orientation"))) {
                 return QVariant(enumValue == QFormBuilderStrings::instance().horizontalPostFix ? QFrame::HLine : QFrame::VLine);
             }
             uiLibWarning(QCoreApplication::translate("QFormBuilder", "The enumeration-type property %1 could not be read.").arg(p->attributeName()));
             return QVariant();
         }
 
-        const QMetaEnum e = meta->property(index).enumerator();
-        return QVariant(e.keyToValue(enumValue.toUtf8()));
+        return QVariant(afb->d->enumValue(meta, index, enumValue));
     }
     case DomProperty::Brush:
         return QVariant::fromValue(afb->setupBrush(p->elementBrush()));
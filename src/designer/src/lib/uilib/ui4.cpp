@@ -5,6 +5,10 @@
 
 #include "ui4_p.h"
 
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <new>
 
 QT_BEGIN_NAMESPACE
 
@@ -14,6 +18,543 @@ using namespace Qt::StringLiterals;
 using namespace QFormInternal;
 #endif
 
+namespace {
+
+// The names of the elements read by the Dom classes
+enum class DomTag {
+    Unknown,
+    Action,
+    ActionGroup,
+    Active,
+    ActiveOff,
+    ActiveOn,
+    AddAction,
+    AddPageMethod,
+    Antialiasing,
+    Attribute,
+    Author,
+    Blue,
+    Bold,
+    Bool,
+    Brush,
+    ButtonGroup,
+    ButtonGroups,
+    Char,
+    Class,
+    Color,
+    ColorRole,
+    Column,
+    Comment,
+    Connection,
+    Connections,
+    Container,
+    Cstring,
+    Cursor,
+    CursorShape,
+    CustomWidget,
+    CustomWidgets,
+    Date,
+    DateTime,
+    Day,
+    Designerdata,
+    Disabled,
+    DisabledOff,
+    DisabledOn,
+    Double,
+    Enum,
+    ExportMacro,
+    Extends,
+    Family,
+    Float,
+    Font,
+    Gradient,
+    Gradientstop,
+    Green,
+    Header,
+    Height,
+    Hint,
+    Hints,
+    HorStretch,
+    Hour,
+    HSizeType,
+    IconSet,
+    Images,
+    Inactive,
+    Include,
+    Includes,
+    Italic,
+    Item,
+    Kerning,
+    Layout,
+    LayoutDefault,
+    LayoutFunction,
+    Locale,
+    LongLong,
+    Minute,
+    Month,
+    NormalOff,
+    NormalOn,
+    Number,
+    Palette,
+    Pixmap,
+    PixmapFunction,
+    Point,
+    PointF,
+    PointSize,
+    Properties,
+    Property,
+    Propertyspecifications,
+    Receiver,
+    Rect,
+    RectF,
+    Red,
+    Resources,
+    Row,
+    Script,
+    Second,
+    SelectedOff,
+    SelectedOn,
+    Sender,
+    Set,
+    Signal,
+    Size,
+    SizeF,
+    SizeHint,
+    SizePolicy,
+    Slot,
+    Slots,
+    Spacer,
+    StrikeOut,
+    String,
+    StringList,
+    Stringpropertyspecification,
+    StyleStrategy,
+    TabStop,
+    TabStops,
+    Texture,
+    Time,
+    Tooltip,
+    UInt,
+    ULongLong,
+    Underline,
+    Unicode,
+    Url,
+    VerStretch,
+    VSizeType,
+    Weight,
+    Widget,
+    WidgetData,
+    Width,
+    X,
+    Y,
+    Year,
+    ZOrder,
+};
+
+struct DomTagName
+{
+    QStringView name;
+    DomTag tag;
+};
+
+// Sorted by name for domTag()
+constexpr DomTagName domTagNames[] = {
+    { u"action", DomTag::Action },
+    { u"actiongroup", DomTag::ActionGroup },
+    { u"active", DomTag::Active },
+    { u"activeoff", DomTag::ActiveOff },
+    { u"activeon", DomTag::ActiveOn },
+    { u"addaction", DomTag::AddAction },
+    { u"addpagemethod", DomTag::AddPageMethod },
+    { u"antialiasing", DomTag::Antialiasing },
+    { u"attribute", DomTag::Attribute },
+    { u"author", DomTag::Author },
+    { u"blue", DomTag::Blue },
+    { u"bold", DomTag::Bold },
+    { u"bool", DomTag::Bool },
+    { u"brush", DomTag::Brush },
+    { u"buttongroup", DomTag::ButtonGroup },
+    { u"buttongroups", DomTag::ButtonGroups },
+    { u"char", DomTag::Char },
+    { u"class", DomTag::Class },
+    { u"color", DomTag::Color },
+    { u"colorrole", DomTag::ColorRole },
+    { u"column", DomTag::Column },
+    { u"comment", DomTag::Comment },
+    { u"connection", DomTag::Connection },
+    { u"connections", DomTag::Connections },
+    { u"container", DomTag::Container },
+    { u"cstring", DomTag::Cstring },
+    { u"cursor", DomTag::Cursor },
+    { u"cursorshape", DomTag::CursorShape },
+    { u"customwidget", DomTag::CustomWidget },
+    { u"customwidgets", DomTag::CustomWidgets },
+    { u"date", DomTag::Date },
+    { u"datetime", DomTag::DateTime },
+    { u"day", DomTag::Day },
+    { u"designerdata", DomTag::Designerdata },
+    { u"disabled", DomTag::Disabled },
+    { u"disabledoff", DomTag::DisabledOff },
+    { u"disabledon", DomTag::DisabledOn },
+    { u"double", DomTag::Double },
+    { u"enum", DomTag::Enum },
+    { u"exportmacro", DomTag::ExportMacro },
+    { u"extends", DomTag::Extends },
+    { u"family", DomTag::Family },
+    { u"float", DomTag::Float },
+    { u"font", DomTag::Font },
+    { u"gradient", DomTag::Gradient },
+    { u"gradientstop", DomTag::Gradientstop },
+    { u"green", DomTag::Green },
+    { u"header", DomTag::Header },
+    { u"height", DomTag::Height },
+    { u"hint", DomTag::Hint },
+    { u"hints", DomTag::Hints },
+    { u"horstretch", DomTag::HorStretch },
+    { u"hour", DomTag::Hour },
+    { u"hsizetype", DomTag::HSizeType },
+    { u"iconset", DomTag::IconSet },
+    { u"images", DomTag::Images },
+    { u"inactive", DomTag::Inactive },
+    { u"include", DomTag::Include },
+    { u"includes", DomTag::Includes },
+    { u"italic", DomTag::Italic },
+    { u"item", DomTag::Item },
+    { u"kerning", DomTag::Kerning },
+    { u"layout", DomTag::Layout },
+    { u"layoutdefault", DomTag::LayoutDefault },
+    { u"layoutfunction", DomTag::LayoutFunction },
+    { u"locale", DomTag::Locale },
+    { u"longlong", DomTag::LongLong },
+    { u"minute", DomTag::Minute },
+    { u"month", DomTag::Month },
+    { u"normaloff", DomTag::NormalOff },
+    { u"normalon", DomTag::NormalOn },
+    { u"number", DomTag::Number },
+    { u"palette", DomTag::Palette },
+    { u"pixmap", DomTag::Pixmap },
+    { u"pixmapfunction", DomTag::PixmapFunction },
+    { u"point", DomTag::Point },
+    { u"pointf", DomTag::PointF },
+    { u"pointsize", DomTag::PointSize },
+    { u"properties", DomTag::Properties },
+    { u"property", DomTag::Property },
+    { u"propertyspecifications", DomTag::Propertyspecifications },
+    { u"receiver", DomTag::Receiver },
+    { u"rect", DomTag::Rect },
+    { u"rectf", DomTag::RectF },
+    { u"red", DomTag::Red },
+    { u"resources", DomTag::Resources },
+    { u"row", DomTag::Row },
+    { u"script", DomTag::Script },
+    { u"second", DomTag::Second },
+    { u"selectedoff", DomTag::SelectedOff },
+    { u"selectedon", DomTag::SelectedOn },
+    { u"sender", DomTag::Sender },
+    { u"set", DomTag::Set },
+    { u"signal", DomTag::Signal },
+    { u"size", DomTag::Size },
+    { u"sizef", DomTag::SizeF },
+    { u"sizehint", DomTag::SizeHint },
+    { u"sizepolicy", DomTag::SizePolicy },
+    { u"slot", DomTag::Slot },
+    { u"slots", DomTag::Slots },
+    { u"spacer", DomTag::Spacer },
+    { u"strikeout", DomTag::StrikeOut },
+    { u"string", DomTag::String },
+    { u"stringlist", DomTag::StringList },
+    { u"stringpropertyspecification", DomTag::Stringpropertyspecification },
+    { u"stylestrategy", DomTag::StyleStrategy },
+    { u"tabstop", DomTag::TabStop },
+    { u"tabstops", DomTag::TabStops },
+    { u"texture", DomTag::Texture },
+    { u"time", DomTag::Time },
+    { u"tooltip", DomTag::Tooltip },
+    { u"uint", DomTag::UInt },
+    { u"ulonglong", DomTag::ULongLong },
+    { u"underline", DomTag::Underline },
+    { u"unicode", DomTag::Unicode },
+    { u"url", DomTag::Url },
+    { u"verstretch", DomTag::VerStretch },
+    { u"vsizetype", DomTag::VSizeType },
+    { u"weight", DomTag::Weight },
+    { u"widget", DomTag::Widget },
+    { u"widgetdata", DomTag::WidgetData },
+    { u"width", DomTag::Width },
+    { u"x", DomTag::X },
+    { u"y", DomTag::Y },
+    { u"year", DomTag::Year },
+    { u"zorder", DomTag::ZOrder },
+};
+
+// Element names are case insensitive.
+DomTag domTag(QStringView name)
+{
+    const auto lessThan = [](const DomTagName &tagName, QStringView name) {
+        return tagName.name.compare(name, Qt::CaseInsensitive) < 0;
+    };
+    const auto end = std::end(domTagNames);
+    const auto it = std::lower_bound(std::begin(domTagNames), end, name, lessThan);
+    return it != end && !it->name.compare(name, Qt::CaseInsensitive)
+            ? it->tag : DomTag::Unknown;
+}
+
+} // namespace
+
+/*******************************************************************************
+** Allocation
+*/
+
+namespace {
+
+// Each allocation starts with a flag telling whether it is in an arena,
+// padded so that the object stays aligned.
+constexpr size_t domHeaderSize = alignof(std::max_align_t);
+constexpr size_t domBlockSize = 64 * 1024;
+
+thread_local DomArena *domCurrentArena = nullptr;
+
+} // namespace
+
+DomArena::~DomArena()
+{
+    for (char *block : std::as_const(m_blocks))
+        ::operator delete(block);
+}
+
+DomArena::Scope::Scope(DomArena *arena)
+    : m_previous(domCurrentArena)
+{
+    domCurrentArena = arena;
+}
+
+DomArena::Scope::~Scope()
+{
+    domCurrentArena = m_previous;
+}
+
+void *DomArena::allocateInBlock(size_t size)
+{
+    if (size > m_left) {
+        const size_t blockSize = qMax(size, domBlockSize);
+        m_free = static_cast<char *>(::operator new(blockSize));
+        m_blocks.append(m_free);
+        m_left = blockSize;
+    }
+    char *result = m_free;
+    m_free += size;
+    m_left -= size;
+    return result;
+}
+
+void *DomArena::allocate(size_t size)
+{
+    const size_t paddedSize = (size + domHeaderSize - 1) / domHeaderSize * domHeaderSize;
+    DomArena *arena = domCurrentArena;
+    char *memory = static_cast<char *>(arena ? arena->allocateInBlock(domHeaderSize + paddedSize)
+                                             : ::operator new(domHeaderSize + paddedSize));
+    new (memory) bool(arena != nullptr);
+    return memory + domHeaderSize;
+}
+
+void DomArena::deallocate(void *pointer) noexcept
+{
+    if (!pointer)
+        return;
+    char *memory = static_cast<char *>(pointer) - domHeaderSize;
+    if (!*std::launder(reinterpret_cast<bool *>(memory)))
+        ::operator delete(memory);
+}
+
+/*******************************************************************************
+** Writing
+*/
+
+DomXmlWriter::DomXmlWriter(QByteArray *buffer)
+    : m_buffer(buffer),
+      m_encoder(QStringEncoder::Utf8)
+{
+}
+
+void DomXmlWriter::writeStartDocument()
+{
+    finishStartElement(false);
+    m_buffer->append("<?xml version=\"1.0\" encoding=\"UTF-8\"?>");
+}
+
+void DomXmlWriter::writeEndDocument()
+{
+    while (!m_tags.isEmpty())
+        writeEndElement();
+    m_buffer->append('\n');
+}
+
+void DomXmlWriter::writeStartElement(const QString &name)
+{
+    if (!finishStartElement(false))
+        indent(m_tags.size());
+    m_tags.append(name);
+    m_buffer->append('<');
+    append(name);
+    m_inStartElement = m_lastWasStartElement = true;
+}
+
+void DomXmlWriter::writeEndElement()
+{
+    if (m_tags.isEmpty())
+        return;
+    // An element without contents is closed as an empty element.
+    if (m_inStartElement) {
+        m_buffer->append("/>");
+        m_inStartElement = m_lastWasStartElement = false;
+        m_tags.removeLast();
+        return;
+    }
+    if (!finishStartElement(false) && !m_lastWasStartElement)
+        indent(m_tags.size() - 1);
+    m_lastWasStartElement = false;
+    m_buffer->append("</");
+    append(m_tags.takeLast());
+    m_buffer->append('>');
+}
+
+void DomXmlWriter::writeAttribute(const QString &name, const QString &value)
+{
+    Q_ASSERT(m_inStartElement);
+    m_buffer->append(' ');
+    append(name);
+    m_buffer->append("=\"");
+    appendEscaped(value, true);
+    m_buffer->append('"');
+}
+
+void DomXmlWriter::writeTextElement(const QString &name, const QString &text)
+{
+    writeStartElement(name);
+    writeCharacters(text);
+    writeEndElement();
+}
+
+void DomXmlWriter::writeCharacters(const QString &text)
+{
+    finishStartElement(true);
+    appendEscaped(text, false);
+}
+
+bool DomXmlWriter::finishStartElement(bool contents)
+{
+    const bool hadSomethingWritten = m_wroteSomething;
+    m_wroteSomething = contents;
+    if (m_inStartElement) {
+        m_buffer->append('>');
+        m_inStartElement = false;
+    }
+    return hadSomethingWritten;
+}
+
+void DomXmlWriter::indent(qsizetype level)
+{
+    m_buffer->append('\n');
+    m_buffer->append(level, ' ');
+}
+
+void DomXmlWriter::append(QStringView text)
+{
+    if (text.isEmpty())
+        return;
+    const qsizetype size = m_buffer->size();
+    m_buffer->resize(size + m_encoder.requiredSpace(text.size()));
+    char *end = m_encoder.appendToBuffer(m_buffer->data() + size, text);
+    m_buffer->truncate(end - m_buffer->constData());
+}
+
+// Escapes like QXmlStreamWriter, appending the runs in between in one go.
+void DomXmlWriter::appendEscaped(QStringView text, bool escapeWhitespace)
+{
+    qsizetype start = 0;
+    for (qsizetype i = 0, size = text.size(); i != size; ++i) {
+        const char16_t c = text[i].unicode();
+        const char *replacement = "";
+        switch (c) {
+        case '<':
+            replacement = "&lt;";
+            break;
+        case '>':
+            replacement = "&gt;";
+            break;
+        case '&':
+            replacement = "&amp;";
+            break;
+        case '"':
+            replacement = "&quot;";
+            break;
+        case '\t':
+        case '\n':
+        case '\r':
+            if (!escapeWhitespace)
+                continue;
+            replacement = c == '\t' ? "&#9;" : c == '\n' ? "&#10;" : "&#13;";
+            break;
+        default:
+            if (c > 0x1f && c < 0xfffe)
+                continue;
+            m_hasError = true;
+            break;
+        }
+        append(text.sliced(start, i - start));
+        m_buffer->append(replacement);
+        start = i + 1;
+    }
+    append(text.sliced(start));
+}
+
+/*******************************************************************************
+** Streaming
+*/
+
+namespace {
+
+template <class T>
+void readDomPointer(QDataStream &stream, T *&pointer)
+{
+    bool present = false;
+    stream >> present;
+    if (present && stream.status() == QDataStream::Ok) {
+        pointer = new T;
+        pointer->read(stream);
+    }
+}
+
+template <class T>
+void writeDomPointer(QDataStream &stream, const T *pointer)
+{
+    stream << (pointer != nullptr);
+    if (pointer)
+        pointer->write(stream);
+}
+
+template <class T>
+void readDomList(QDataStream &stream, QList<T *> &list)
+{
+    qint32 count = 0;
+    stream >> count;
+    for (qint32 i = 0; i < count && stream.status() == QDataStream::Ok; ++i) {
+        auto *element = new T;
+        element->read(stream);
+        list.append(element);
+    }
+}
+
+template <class T>
+void writeDomList(QDataStream &stream, const QList<T *> &list)
+{
+    stream << qint32(list.size());
+    for (const T *element : list)
+        element->write(stream);
+}
+
+} // namespace
+
 /*******************************************************************************
 ** Implementations
 */
@@ -73,97 +614,101 @@ void DomUI::read(QXmlStreamReader &reader)
         switch (reader.readNext()) {
         case QXmlStreamReader::StartElement : {
             const auto tag = reader.name();
-            if (!tag.compare(u"author"_s, Qt::CaseInsensitive)) {
+            switch (domTag(tag)) {
+            case DomTag::Author : {
                 setElementAuthor(reader.readElementText());
                 continue;
             }
-            if (!tag.compare(u"comment"_s, Qt::CaseInsensitive)) {
+            case DomTag::Comment : {
                 setElementComment(reader.readElementText());
                 continue;
             }
-            if (!tag.compare(u"exportmacro"_s, Qt::CaseInsensitive)) {
+            case DomTag::ExportMacro : {
                 setElementExportMacro(reader.readElementText());
                 continue;
             }
-            if (!tag.compare(u"class"_s, Qt::CaseInsensitive)) {
+            case DomTag::Class : {
                 setElementClass(reader.readElementText());
                 continue;
             }
-            if (!tag.compare(u"widget"_s, Qt::CaseInsensitive)) {
+            case DomTag::Widget : {
                 auto *v = new DomWidget();
                 v->read(reader);
                 setElementWidget(v);
                 continue;
             }
-            if (!tag.compare(u"layoutdefault"_s, Qt::CaseInsensitive)) {
+            case DomTag::LayoutDefault : {
                 auto *v = new DomLayoutDefault();
                 v->read(reader);
                 setElementLayoutDefault(v);
                 continue;
             }
-            if (!tag.compare(u"layoutfunction"_s, Qt::CaseInsensitive)) {
+            case DomTag::LayoutFunction : {
                 auto *v = new DomLayoutFunction();
                 v->read(reader);
                 setElementLayoutFunction(v);
                 continue;
             }
-            if (!tag.compare(u"pixmapfunction"_s, Qt::CaseInsensitive)) {
+            case DomTag::PixmapFunction : {
                 setElementPixmapFunction(reader.readElementText());
                 continue;
             }
-            if (!tag.compare(u"customwidgets"_s, Qt::CaseInsensitive)) {
+            case DomTag::CustomWidgets : {
                 auto *v = new DomCustomWidgets();
                 v->read(reader);
                 setElementCustomWidgets(v);
                 continue;
             }
-            if (!tag.compare(u"tabstops"_s, Qt::CaseInsensitive)) {
+            case DomTag::TabStops : {
                 auto *v = new DomTabStops();
                 v->read(reader);
                 setElementTabStops(v);
                 continue;
             }
-            if (!tag.compare(u"images"_s, Qt::CaseInsensitive)) {
+            case DomTag::Images : {
                 qWarning("Omitting deprecated element <images>.");
                 reader.skipCurrentElement();
                 continue;
             }
-            if (!tag.compare(u"includes"_s, Qt::CaseInsensitive)) {
+            case DomTag::Includes : {
                 auto *v = new DomIncludes();
                 v->read(reader);
                 setElementIncludes(v);
                 continue;
             }
-            if (!tag.compare(u"resources"_s, Qt::CaseInsensitive)) {
+            case DomTag::Resources : {
                 auto *v = new DomResources();
                 v->read(reader);
                 setElementResources(v);
                 continue;
             }
-            if (!tag.compare(u"connections"_s, Qt::CaseInsensitive)) {
+            case DomTag::Connections : {
                 auto *v = new DomConnections();
                 v->read(reader);
                 setElementConnections(v);
                 continue;
             }
-            if (!tag.compare(u"designerdata"_s, Qt::CaseInsensitive)) {
+            case DomTag::Designerdata : {
                 auto *v = new DomDesignerData();
                 v->read(reader);
                 setElementDesignerdata(v);
                 continue;
             }
-            if (!tag.compare(u"slots"_s, Qt::CaseInsensitive)) {
+            case DomTag::Slots : {
                 auto *v = new DomSlots();
                 v->read(reader);
                 setElementSlots(v);
                 continue;
             }
-            if (!tag.compare(u"buttongroups"_s, Qt::CaseInsensitive)) {
+            case DomTag::ButtonGroups : {
                 auto *v = new DomButtonGroups();
                 v->read(reader);
                 setElementButtonGroups(v);
                 continue;
             }
+            default :
+                break;
+            }
             reader.raiseError("Unexpected element "_L1 + tag);
         }
             break;
@@ -175,7 +720,8 @@ void DomUI::read(QXmlStreamReader &reader)
     }
 }
 
-void DomUI::write(QXmlStreamWriter &writer, const QString &tagName) const
+template <class Writer>
+void DomUI::writeXml(Writer &writer, const QString &tagName) const
 {
     writer.writeStartElement(tagName.isEmpty() ? QStringLiteral("ui") : tagName.toLower());
 
@@ -251,6 +797,72 @@ void DomUI::write(QXmlStreamWriter &writer, const QString &tagName) const
     writer.writeEndElement();
 }
 
+void DomUI::write(QXmlStreamWriter &writer, const QString &tagName) const
+{
+    writeXml(writer, tagName);
+}
+
+void DomUI::write(DomXmlWriter &writer, const QString &tagName) const
+{
+    writeXml(writer, tagName);
+}
+
+void DomUI::read(QDataStream &stream)
+{
+    stream >> m_attr_version >> m_has_attr_version;
+    stream >> m_attr_language >> m_has_attr_language;
+    stream >> m_attr_displayname >> m_has_attr_displayname;
+    stream >> m_attr_idbasedtr >> m_has_attr_idbasedtr;
+    stream >> m_attr_connectslotsbyname >> m_has_attr_connectslotsbyname;
+    stream >> m_attr_stdsetdef >> m_has_attr_stdsetdef;
+    stream >> m_attr_stdSetDef >> m_has_attr_stdSetDef;
+    stream >> m_children;
+    stream >> m_author;
+    stream >> m_comment;
+    stream >> m_exportMacro;
+    stream >> m_class;
+    readDomPointer(stream, m_widget);
+    readDomPointer(stream, m_layoutDefault);
+    readDomPointer(stream, m_layoutFunction);
+    stream >> m_pixmapFunction;
+    readDomPointer(stream, m_customWidgets);
+    readDomPointer(stream, m_tabStops);
+    readDomPointer(stream, m_includes);
+    readDomPointer(stream, m_resources);
+    readDomPointer(stream, m_connections);
+    readDomPointer(stream, m_designerdata);
+    readDomPointer(stream, m_slots);
+    readDomPointer(stream, m_buttonGroups);
+}
+
+void DomUI::write(QDataStream &stream) const
+{
+    stream << m_attr_version << m_has_attr_version;
+    stream << m_attr_language << m_has_attr_language;
+    stream << m_attr_displayname << m_has_attr_displayname;
+    stream << m_attr_idbasedtr << m_has_attr_idbasedtr;
+    stream << m_attr_connectslotsbyname << m_has_attr_connectslotsbyname;
+    stream << m_attr_stdsetdef << m_has_attr_stdsetdef;
+    stream << m_attr_stdSetDef << m_has_attr_stdSetDef;
+    stream << m_children;
+    stream << m_author;
+    stream << m_comment;
+    stream << m_exportMacro;
+    stream << m_class;
+    writeDomPointer(stream, m_widget);
+    writeDomPointer(stream, m_layoutDefault);
+    writeDomPointer(stream, m_layoutFunction);
+    stream << m_pixmapFunction;
+    writeDomPointer(stream, m_customWidgets);
+    writeDomPointer(stream, m_tabStops);
+    writeDomPointer(stream, m_includes);
+    writeDomPointer(stream, m_resources);
+    writeDomPointer(stream, m_connections);
+    writeDomPointer(stream, m_designerdata);
+    writeDomPointer(stream, m_slots);
+    writeDomPointer(stream, m_buttonGroups);
+}
+
 void DomUI::setElementAuthor(const QString &a)
 {
     m_children |= Author;
@@ -560,12 +1172,16 @@ void DomIncludes::read(QXmlStreamReader &reader)
         switch (reader.readNext()) {
         case QXmlStreamReader::StartElement : {
             const auto tag = reader.name();
-            if (!tag.compare(u"include"_s, Qt::CaseInsensitive)) {
+            switch (domTag(tag)) {
+            case DomTag::Include : {
                 auto *v = new DomInclude();
                 v->read(reader);
                 m_include.append(v);
                 continue;
             }
+            default :
+                break;
+            }
             reader.raiseError("Unexpected element "_L1 + tag);
         }
             break;
@@ -577,7 +1193,8 @@ void DomIncludes::read(QXmlStreamReader &reader)
     }
 }
 
-void DomIncludes::write(QXmlStreamWriter &writer, const QString &tagName) const
+template <class Writer>
+void DomIncludes::writeXml(Writer &writer, const QString &tagName) const
 {
     writer.writeStartElement(tagName.isEmpty() ? QStringLiteral("includes") : tagName.toLower());
 
@@ -587,6 +1204,28 @@ void DomIncludes::write(QXmlStreamWriter &writer, const QString &tagName) const
     writer.writeEndElement();
 }
 
+void DomIncludes::write(QXmlStreamWriter &writer, const QString &tagName) const
+{
+    writeXml(writer, tagName);
+}
+
+void DomIncludes::write(DomXmlWriter &writer, const QString &tagName) const
+{
+    writeXml(writer, tagName);
+}
+
+void DomIncludes::read(QDataStream &stream)
+{
+    stream >> m_children;
+    readDomList(stream, m_include);
+}
+
+void DomIncludes::write(QDataStream &stream) const
+{
+    stream << m_children;
+    writeDomList(stream, m_include);
+}
+
 void DomIncludes::setElementInclude(const QList<DomInclude *> &a)
 {
     m_children |= Include;
@@ -630,7 +1269,8 @@ void DomInclude::read(QXmlStreamReader &reader)
     }
 }
 
-void DomInclude::write(QXmlStreamWriter &writer, const QString &tagName) const
+template <class Writer>
+void DomInclude::writeXml(Writer &writer, const QString &tagName) const
 {
     writer.writeStartElement(tagName.isEmpty() ? QStringLiteral("include") : tagName.toLower());
 
@@ -646,6 +1286,30 @@ void DomInclude::write(QXmlStreamWriter &writer, const QString &tagName) const
     writer.writeEndElement();
 }
 
+void DomInclude::write(QXmlStreamWriter &writer, const QString &tagName) const
+{
+    writeXml(writer, tagName);
+}
+
+void DomInclude::write(DomXmlWriter &writer, const QString &tagName) const
+{
+    writeXml(writer, tagName);
+}
+
+void DomInclude::read(QDataStream &stream)
+{
+    stream >> m_attr_location >> m_has_attr_location;
+    stream >> m_attr_impldecl >> m_has_attr_impldecl;
+    stream >> m_text;
+}
+
+void DomInclude::write(QDataStream &stream) const
+{
+    stream << m_attr_location << m_has_attr_location;
+    stream << m_attr_impldecl << m_has_attr_impldecl;
+    stream << m_text;
+}
+
 DomResources::~DomResources()
 {
     qDeleteAll(m_include);
@@ -668,12 +1332,16 @@ void DomResources::read(QXmlStreamReader &reader)
         switch (reader.readNext()) {
         case QXmlStreamReader::StartElement : {
             const auto tag = reader.name();
-            if (!tag.compare(u"include"_s, Qt::CaseInsensitive)) {
+            switch (domTag(tag)) {
+            case DomTag::Include : {
                 auto *v = new DomResource();
                 v->read(reader);
                 m_include.append(v);
                 continue;
             }
+            default :
+                break;
+            }
             reader.raiseError("Unexpected element "_L1 + tag);
         }
             break;
@@ -685,7 +1353,8 @@ void DomResources::read(QXmlStreamReader &reader)
     }
 }
 
-void DomResources::write(QXmlStreamWriter &writer, const QString &tagName) const
+template <class Writer>
+void DomResources::writeXml(Writer &writer, const QString &tagName) const
 {
     writer.writeStartElement(tagName.isEmpty() ? QStringLiteral("resources") : tagName.toLower());
 
@@ -698,6 +1367,30 @@ void DomResources::write(QXmlStreamWriter &writer, const QString &tagName) const
     writer.writeEndElement();
 }
 
+void DomResources::write(QXmlStreamWriter &writer, const QString &tagName) const
+{
+    writeXml(writer, tagName);
+}
+
+void DomResources::write(DomXmlWriter &writer, const QString &tagName) const
+{
+    writeXml(writer, tagName);
+}
+
+void DomResources::read(QDataStream &stream)
+{
+    stream >> m_attr_name >> m_has_attr_name;
+    stream >> m_children;
+    readDomList(stream, m_include);
+}
+
+void DomResources::write(QDataStream &stream) const
+{
+    stream << m_attr_name << m_has_attr_name;
+    stream << m_children;
+    writeDomList(stream, m_include);
+}
+
 void DomResources::setElementInclude(const QList<DomResource *> &a)
 {
     m_children |= Include;
@@ -733,7 +1426,8 @@ void DomResource::read(QXmlStreamReader &reader)
     }
 }
 
-void DomResource::write(QXmlStreamWriter &writer, const QString &tagName) const
+template <class Writer>
+void DomResource::writeXml(Writer &writer, const QString &tagName) const
 {
     writer.writeStartElement(tagName.isEmpty() ? QStringLiteral("resource") : tagName.toLower());
 
@@ -743,6 +1437,26 @@ void DomResource::write(QXmlStreamWriter &writer, const QString &tagName) const
     writer.writeEndElement();
 }
 
+void DomResource::write(QXmlStreamWriter &writer, const QString &tagName) const
+{
+    writeXml(writer, tagName);
+}
+
+void DomResource::write(DomXmlWriter &writer, const QString &tagName) const
+{
+    writeXml(writer, tagName);
+}
+
+void DomResource::read(QDataStream &stream)
+{
+    stream >> m_attr_location >> m_has_attr_location;
+}
+
+void DomResource::write(QDataStream &stream) const
+{
+    stream << m_attr_location << m_has_attr_location;
+}
+
 DomActionGroup::~DomActionGroup()
 {
     qDeleteAll(m_action);
@@ -771,30 +1485,34 @@ void DomActionGroup::read(QXmlStreamReader &reader)
         switch (reader.readNext()) {
         case QXmlStreamReader::StartElement : {
             const auto tag = reader.name();
-            if (!tag.compare(u"action"_s, Qt::CaseInsensitive)) {
+            switch (domTag(tag)) {
+            case DomTag::Action : {
                 auto *v = new DomAction();
                 v->read(reader);
                 m_action.append(v);
                 continue;
             }
-            if (!tag.compare(u"actiongroup"_s, Qt::CaseInsensitive)) {
+            case DomTag::ActionGroup : {
                 auto *v = new DomActionGroup();
                 v->read(reader);
                 m_actionGroup.append(v);
                 continue;
             }
-            if (!tag.compare(u"property"_s, Qt::CaseInsensitive)) {
+            case DomTag::Property : {
                 auto *v = new DomProperty();
                 v->read(reader);
                 m_property.append(v);
                 continue;
             }
-            if (!tag.compare(u"attribute"_s, Qt::CaseInsensitive)) {
+            case DomTag::Attribute : {
                 auto *v = new DomProperty();
                 v->read(reader);
                 m_attribute.append(v);
                 continue;
             }
+            default :
+                break;
+            }
             reader.raiseError("Unexpected element "_L1 + tag);
         }
             break;
@@ -806,7 +1524,8 @@ void DomActionGroup::read(QXmlStreamReader &reader)
     }
 }
 
-void DomActionGroup::write(QXmlStreamWriter &writer, const QString &tagName) const
+template <class Writer>
+void DomActionGroup::writeXml(Writer &writer, const QString &tagName) const
 {
     writer.writeStartElement(tagName.isEmpty() ? QStringLiteral("actiongroup") : tagName.toLower());
 
@@ -828,6 +1547,36 @@ void DomActionGroup::write(QXmlStreamWriter &writer, const QString &tagName) con
     writer.writeEndElement();
 }
 
+void DomActionGroup::write(QXmlStreamWriter &writer, const QString &tagName) const
+{
+    writeXml(writer, tagName);
+}
+
+void DomActionGroup::write(DomXmlWriter &writer, const QString &tagName) const
+{
+    writeXml(writer, tagName);
+}
+
+void DomActionGroup::read(QDataStream &stream)
+{
+    stream >> m_attr_name >> m_has_attr_name;
+    stream >> m_children;
+    readDomList(stream, m_action);
+    readDomList(stream, m_actionGroup);
+    readDomList(stream, m_property);
+    readDomList(stream, m_attribute);
+}
+
+void DomActionGroup::write(QDataStream &stream) const
+{
+    stream << m_attr_name << m_has_attr_name;
+    stream << m_children;
+    writeDomList(stream, m_action);
+    writeDomList(stream, m_actionGroup);
+    writeDomList(stream, m_property);
+    writeDomList(stream, m_attribute);
+}
+
 void DomActionGroup::setElementAction(const QList<DomAction *> &a)
 {
     m_children |= Action;
@@ -880,18 +1629,22 @@ void DomAction::read(QXmlStreamReader &reader)
         switch (reader.readNext()) {
         case QXmlStreamReader::StartElement : {
             const auto tag = reader.name();
-            if (!tag.compare(u"property"_s, Qt::CaseInsensitive)) {
+            switch (domTag(tag)) {
+            case DomTag::Property : {
                 auto *v = new DomProperty();
                 v->read(reader);
                 m_property.append(v);
                 continue;
             }
-            if (!tag.compare(u"attribute"_s, Qt::CaseInsensitive)) {
+            case DomTag::Attribute : {
                 auto *v = new DomProperty();
                 v->read(reader);
                 m_attribute.append(v);
                 continue;
             }
+            default :
+                break;
+            }
             reader.raiseError("Unexpected element "_L1 + tag);
         }
             break;
@@ -903,7 +1656,8 @@ void DomAction::read(QXmlStreamReader &reader)
     }
 }
 
-void DomAction::write(QXmlStreamWriter &writer, const QString &tagName) const
+template <class Writer>
+void DomAction::writeXml(Writer &writer, const QString &tagName) const
 {
     writer.writeStartElement(tagName.isEmpty() ? QStringLiteral("action") : tagName.toLower());
 
@@ -922,6 +1676,34 @@ void DomAction::write(QXmlStreamWriter &writer, const QString &tagName) const
     writer.writeEndElement();
 }
 
+void DomAction::write(QXmlStreamWriter &writer, const QString &tagName) const
+{
+    writeXml(writer, tagName);
+}
+
+void DomAction::write(DomXmlWriter &writer, const QString &tagName) const
+{
+    writeXml(writer, tagName);
+}
+
+void DomAction::read(QDataStream &stream)
+{
+    stream >> m_attr_name >> m_has_attr_name;
+    stream >> m_attr_menu >> m_has_attr_menu;
+    stream >> m_children;
+    readDomList(stream, m_property);
+    readDomList(stream, m_attribute);
+}
+
+void DomAction::write(QDataStream &stream) const
+{
+    stream << m_attr_name << m_has_attr_name;
+    stream << m_attr_menu << m_has_attr_menu;
+    stream << m_children;
+    writeDomList(stream, m_property);
+    writeDomList(stream, m_attribute);
+}
+
 void DomAction::setElementProperty(const QList<DomProperty *> &a)
 {
     m_children |= Property;
@@ -963,7 +1745,8 @@ void DomActionRef::read(QXmlStreamReader &reader)
     }
 }
 
-void DomActionRef::write(QXmlStreamWriter &writer, const QString &tagName) const
+template <class Writer>
+void DomActionRef::writeXml(Writer &writer, const QString &tagName) const
 {
     writer.writeStartElement(tagName.isEmpty() ? QStringLiteral("actionref") : tagName.toLower());
 
@@ -973,6 +1756,26 @@ void DomActionRef::write(QXmlStreamWriter &writer, const QString &tagName) const
     writer.writeEndElement();
 }
 
+void DomActionRef::write(QXmlStreamWriter &writer, const QString &tagName) const
+{
+    writeXml(writer, tagName);
+}
+
+void DomActionRef::write(DomXmlWriter &writer, const QString &tagName) const
+{
+    writeXml(writer, tagName);
+}
+
+void DomActionRef::read(QDataStream &stream)
+{
+    stream >> m_attr_name >> m_has_attr_name;
+}
+
+void DomActionRef::write(QDataStream &stream) const
+{
+    stream << m_attr_name << m_has_attr_name;
+}
+
 DomButtonGroup::~DomButtonGroup()
 {
     qDeleteAll(m_property);
@@ -997,18 +1800,22 @@ void DomButtonGroup::read(QXmlStreamReader &reader)
         switch (reader.readNext()) {
         case QXmlStreamReader::StartElement : {
             const auto tag = reader.name();
-            if (!tag.compare(u"property"_s, Qt::CaseInsensitive)) {
+            switch (domTag(tag)) {
+            case DomTag::Property : {
                 auto *v = new DomProperty();
                 v->read(reader);
                 m_property.append(v);
                 continue;
             }
-            if (!tag.compare(u"attribute"_s, Qt::CaseInsensitive)) {
+            case DomTag::Attribute : {
                 auto *v = new DomProperty();
                 v->read(reader);
                 m_attribute.append(v);
                 continue;
             }
+            default :
+                break;
+            }
             reader.raiseError("Unexpected element "_L1 + tag);
         }
             break;
@@ -1020,7 +1827,8 @@ void DomButtonGroup::read(QXmlStreamReader &reader)
     }
 }
 
-void DomButtonGroup::write(QXmlStreamWriter &writer, const QString &tagName) const
+template <class Writer>
+void DomButtonGroup::writeXml(Writer &writer, const QString &tagName) const
 {
     writer.writeStartElement(tagName.isEmpty() ? QStringLiteral("buttongroup") : tagName.toLower());
 
@@ -1036,6 +1844,32 @@ void DomButtonGroup::write(QXmlStreamWriter &writer, const QString &tagName) con
     writer.writeEndElement();
 }
 
+void DomButtonGroup::write(QXmlStreamWriter &writer, const QString &tagName) const
+{
+    writeXml(writer, tagName);
+}
+
+void DomButtonGroup::write(DomXmlWriter &writer, const QString &tagName) const
+{
+    writeXml(writer, tagName);
+}
+
+void DomButtonGroup::read(QDataStream &stream)
+{
+    stream >> m_attr_name >> m_has_attr_name;
+    stream >> m_children;
+    readDomList(stream, m_property);
+    readDomList(stream, m_attribute);
+}
+
+void DomButtonGroup::write(QDataStream &stream) const
+{
+    stream << m_attr_name << m_has_attr_name;
+    stream << m_children;
+    writeDomList(stream, m_property);
+    writeDomList(stream, m_attribute);
+}
+
 void DomButtonGroup::setElementProperty(const QList<DomProperty *> &a)
 {
     m_children |= Property;
@@ -1060,12 +1894,16 @@ void DomButtonGroups::read(QXmlStreamReader &reader)
         switch (reader.readNext()) {
         case QXmlStreamReader::StartElement : {
             const auto tag = reader.name();
-            if (!tag.compare(u"buttongroup"_s, Qt::CaseInsensitive)) {
+            switch (domTag(tag)) {
+            case DomTag::ButtonGroup : {
                 auto *v = new DomButtonGroup();
                 v->read(reader);
                 m_buttonGroup.append(v);
                 continue;
             }
+            default :
+                break;
+            }
             reader.raiseError("Unexpected element "_L1 + tag);
         }
             break;
@@ -1077,7 +1915,8 @@ void DomButtonGroups::read(QXmlStreamReader &reader)
     }
 }
 
-void DomButtonGroups::write(QXmlStreamWriter &writer, const QString &tagName) const
+template <class Writer>
+void DomButtonGroups::writeXml(Writer &writer, const QString &tagName) const
 {
     writer.writeStartElement(tagName.isEmpty() ? QStringLiteral("buttongroups") : tagName.toLower());
 
@@ -1087,6 +1926,28 @@ void DomButtonGroups::write(QXmlStreamWriter &writer, const QString &tagName) co
     writer.writeEndElement();
 }
 
+void DomButtonGroups::write(QXmlStreamWriter &writer, const QString &tagName) const
+{
+    writeXml(writer, tagName);
+}
+
+void DomButtonGroups::write(DomXmlWriter &writer, const QString &tagName) const
+{
+    writeXml(writer, tagName);
+}
+
+void DomButtonGroups::read(QDataStream &stream)
+{
+    stream >> m_children;
+    readDomList(stream, m_buttonGroup);
+}
+
+void DomButtonGroups::write(QDataStream &stream) const
+{
+    stream << m_children;
+    writeDomList(stream, m_buttonGroup);
+}
+
 void DomButtonGroups::setElementButtonGroup(const QList<DomButtonGroup *> &a)
 {
     m_children |= ButtonGroup;
@@ -1105,12 +1966,16 @@ void DomCustomWidgets::read(QXmlStreamReader &reader)
         switch (reader.readNext()) {
         case QXmlStreamReader::StartElement : {
             const auto tag = reader.name();
-            if (!tag.compare(u"customwidget"_s, Qt::CaseInsensitive)) {
+            switch (domTag(tag)) {
+            case DomTag::CustomWidget : {
                 auto *v = new DomCustomWidget();
                 v->read(reader);
                 m_customWidget.append(v);
                 continue;
             }
+            default :
+                break;
+            }
             reader.raiseError("Unexpected element "_L1 + tag);
         }
             break;
@@ -1122,7 +1987,8 @@ void DomCustomWidgets::read(QXmlStreamReader &reader)
     }
 }
 
-void DomCustomWidgets::write(QXmlStreamWriter &writer, const QString &tagName) const
+template <class Writer>
+void DomCustomWidgets::writeXml(Writer &writer, const QString &tagName) const
 {
     writer.writeStartElement(tagName.isEmpty() ? QStringLiteral("customwidgets") : tagName.toLower());
 
@@ -1132,6 +1998,28 @@ void DomCustomWidgets::write(QXmlStreamWriter &writer, const QString &tagName) c
     writer.writeEndElement();
 }
 
+void DomCustomWidgets::write(QXmlStreamWriter &writer, const QString &tagName) const
+{
+    writeXml(writer, tagName);
+}
+
+void DomCustomWidgets::write(DomXmlWriter &writer, const QString &tagName) const
+{
+    writeXml(writer, tagName);
+}
+
+void DomCustomWidgets::read(QDataStream &stream)
+{
+    stream >> m_children;
+    readDomList(stream, m_customWidget);
+}
+
+void DomCustomWidgets::write(QDataStream &stream) const
+{
+    stream << m_children;
+    writeDomList(stream, m_customWidget);
+}
+
 void DomCustomWidgets::setElementCustomWidget(const QList<DomCustomWidget *> &a)
 {
     m_children |= CustomWidget;
@@ -1171,7 +2059,8 @@ void DomHeader::read(QXmlStreamReader &reader)
     }
 }
 
-void DomHeader::write(QXmlStreamWriter &writer, const QString &tagName) const
+template <class Writer>
+void DomHeader::writeXml(Writer &writer, const QString &tagName) const
 {
     writer.writeStartElement(tagName.isEmpty() ? QStringLiteral("header") : tagName.toLower());
 
@@ -1184,6 +2073,28 @@ void DomHeader::write(QXmlStreamWriter &writer, const QString &tagName) const
     writer.writeEndElement();
 }
 
+void DomHeader::write(QXmlStreamWriter &writer, const QString &tagName) const
+{
+    writeXml(writer, tagName);
+}
+
+void DomHeader::write(DomXmlWriter &writer, const QString &tagName) const
+{
+    writeXml(writer, tagName);
+}
+
+void DomHeader::read(QDataStream &stream)
+{
+    stream >> m_attr_location >> m_has_attr_location;
+    stream >> m_text;
+}
+
+void DomHeader::write(QDataStream &stream) const
+{
+    stream << m_attr_location << m_has_attr_location;
+    stream << m_text;
+}
+
 DomCustomWidget::~DomCustomWidget()
 {
     delete m_header;
@@ -1198,65 +2109,69 @@ void DomCustomWidget::read(QXmlStreamReader &reader)
         switch (reader.readNext()) {
         case QXmlStreamReader::StartElement : {
             const auto tag = reader.name();
-            if (!tag.compare(u"class"_s, Qt::CaseInsensitive)) {
+            switch (domTag(tag)) {
+            case DomTag::Class : {
                 setElementClass(reader.readElementText());
                 continue;
             }
-            if (!tag.compare(u"extends"_s, Qt::CaseInsensitive)) {
+            case DomTag::Extends : {
                 setElementExtends(reader.readElementText());
                 continue;
             }
-            if (!tag.compare(u"header"_s, Qt::CaseInsensitive)) {
+            case DomTag::Header : {
                 auto *v = new DomHeader();
                 v->read(reader);
                 setElementHeader(v);
                 continue;
             }
-            if (!tag.compare(u"sizehint"_s, Qt::CaseInsensitive)) {
+            case DomTag::SizeHint : {
                 auto *v = new DomSize();
                 v->read(reader);
                 setElementSizeHint(v);
                 continue;
             }
-            if (!tag.compare(u"addpagemethod"_s, Qt::CaseInsensitive)) {
+            case DomTag::AddPageMethod : {
                 setElementAddPageMethod(reader.readElementText());
                 continue;
             }
-            if (!tag.compare(u"container"_s, Qt::CaseInsensitive)) {
+            case DomTag::Container : {
                 setElementContainer(reader.readElementText().toInt());
                 continue;
             }
-            if (!tag.compare(u"sizepolicy"_s, Qt::CaseInsensitive)) {
+            case DomTag::SizePolicy : {
                 qWarning("Omitting deprecated element <sizepolicy>.");
                 reader.skipCurrentElement();
                 continue;
             }
-            if (!tag.compare(u"pixmap"_s, Qt::CaseInsensitive)) {
+            case DomTag::Pixmap : {
                 setElementPixmap(reader.readElementText());
                 continue;
             }
-            if (!tag.compare(u"script"_s, Qt::CaseInsensitive)) {
+            case DomTag::Script : {
                 qWarning("Omitting deprecated element <script>.");
                 reader.skipCurrentElement();
                 continue;
             }
-            if (!tag.compare(u"properties"_s, Qt::CaseInsensitive)) {
+            case DomTag::Properties : {
                 qWarning("Omitting deprecated element <properties>.");
                 reader.skipCurrentElement();
                 continue;
             }
-            if (!tag.compare(u"slots"_s, Qt::CaseInsensitive)) {
+            case DomTag::Slots : {
                 auto *v = new DomSlots();
                 v->read(reader);
                 setElementSlots(v);
                 continue;
             }
-            if (!tag.compare(u"propertyspecifications"_s, Qt::CaseInsensitive)) {
+            case DomTag::Propertyspecifications : {
                 auto *v = new DomPropertySpecifications();
                 v->read(reader);
                 setElementPropertyspecifications(v);
                 continue;
             }
+            default :
+                break;
+            }
             reader.raiseError("Unexpected element "_L1 + tag);
         }
             break;
@@ -1268,7 +2183,8 @@ void DomCustomWidget::read(QXmlStreamReader &reader)
     }
 }
 
-void DomCustomWidget::write(QXmlStreamWriter &writer, const QString &tagName) const
+template <class Writer>
+void DomCustomWidget::writeXml(Writer &writer, const QString &tagName) const
 {
     writer.writeStartElement(tagName.isEmpty() ? QStringLiteral("customwidget") : tagName.toLower());
 
@@ -1302,6 +2218,44 @@ void DomCustomWidget::write(QXmlStreamWriter &writer, const QString &tagName) co
     writer.writeEndElement();
 }
 
+void DomCustomWidget::write(QXmlStreamWriter &writer, const QString &tagName) const
+{
+    writeXml(writer, tagName);
+}
+
+void DomCustomWidget::write(DomXmlWriter &writer, const QString &tagName) const
+{
+    writeXml(writer, tagName);
+}
+
+void DomCustomWidget::read(QDataStream &stream)
+{
+    stream >> m_children;
+    stream >> m_class;
+    stream >> m_extends;
+    readDomPointer(stream, m_header);
+    readDomPointer(stream, m_sizeHint);
+    stream >> m_addPageMethod;
+    stream >> m_container;
+    stream >> m_pixmap;
+    readDomPointer(stream, m_slots);
+    readDomPointer(stream, m_propertyspecifications);
+}
+
+void DomCustomWidget::write(QDataStream &stream) const
+{
+    stream << m_children;
+    stream << m_class;
+    stream << m_extends;
+    writeDomPointer(stream, m_header);
+    writeDomPointer(stream, m_sizeHint);
+    stream << m_addPageMethod;
+    stream << m_container;
+    stream << m_pixmap;
+    writeDomPointer(stream, m_slots);
+    writeDomPointer(stream, m_propertyspecifications);
+}
+
 void DomCustomWidget::setElementClass(const QString &a)
 {
     m_children |= Class;
@@ -1478,7 +2432,8 @@ void DomLayoutDefault::read(QXmlStreamReader &reader)
     }
 }
 
-void DomLayoutDefault::write(QXmlStreamWriter &writer, const QString &tagName) const
+template <class Writer>
+void DomLayoutDefault::writeXml(Writer &writer, const QString &tagName) const
 {
     writer.writeStartElement(tagName.isEmpty() ? QStringLiteral("layoutdefault") : tagName.toLower());
 
@@ -1491,6 +2446,28 @@ void DomLayoutDefault::write(QXmlStreamWriter &writer, const QString &tagName) c
     writer.writeEndElement();
 }
 
+void DomLayoutDefault::write(QXmlStreamWriter &writer, const QString &tagName) const
+{
+    writeXml(writer, tagName);
+}
+
+void DomLayoutDefault::write(DomXmlWriter &writer, const QString &tagName) const
+{
+    writeXml(writer, tagName);
+}
+
+void DomLayoutDefault::read(QDataStream &stream)
+{
+    stream >> m_attr_spacing >> m_has_attr_spacing;
+    stream >> m_attr_margin >> m_has_attr_margin;
+}
+
+void DomLayoutDefault::write(QDataStream &stream) const
+{
+    stream << m_attr_spacing << m_has_attr_spacing;
+    stream << m_attr_margin << m_has_attr_margin;
+}
+
 DomLayoutFunction::~DomLayoutFunction() = default;
 
 void DomLayoutFunction::read(QXmlStreamReader &reader)
@@ -1524,7 +2501,8 @@ void DomLayoutFunction::read(QXmlStreamReader &reader)
     }
 }
 
-void DomLayoutFunction::write(QXmlStreamWriter &writer, const QString &tagName) const
+template <class Writer>
+void DomLayoutFunction::writeXml(Writer &writer, const QString &tagName) const
 {
     writer.writeStartElement(tagName.isEmpty() ? QStringLiteral("layoutfunction") : tagName.toLower());
 
@@ -1537,6 +2515,28 @@ void DomLayoutFunction::write(QXmlStreamWriter &writer, const QString &tagName)
     writer.writeEndElement();
 }
 
+void DomLayoutFunction::write(QXmlStreamWriter &writer, const QString &tagName) const
+{
+    writeXml(writer, tagName);
+}
+
+void DomLayoutFunction::write(DomXmlWriter &writer, const QString &tagName) const
+{
+    writeXml(writer, tagName);
+}
+
+void DomLayoutFunction::read(QDataStream &stream)
+{
+    stream >> m_attr_spacing >> m_has_attr_spacing;
+    stream >> m_attr_margin >> m_has_attr_margin;
+}
+
+void DomLayoutFunction::write(QDataStream &stream) const
+{
+    stream << m_attr_spacing << m_has_attr_spacing;
+    stream << m_attr_margin << m_has_attr_margin;
+}
+
 DomTabStops::~DomTabStops()
 {
     m_tabStop.clear();
@@ -1548,10 +2548,14 @@ void DomTabStops::read(QXmlStreamReader &reader)
         switch (reader.readNext()) {
         case QXmlStreamReader::StartElement : {
             const auto tag = reader.name();
-            if (!tag.compare(u"tabstop"_s, Qt::CaseInsensitive)) {
+            switch (domTag(tag)) {
+            case DomTag::TabStop : {
                 m_tabStop.append(reader.readElementText());
                 continue;
             }
+            default :
+                break;
+            }
             reader.raiseError("Unexpected element "_L1 + tag);
         }
             break;
@@ -1563,7 +2567,8 @@ void DomTabStops::read(QXmlStreamReader &reader)
     }
 }
 
-void DomTabStops::write(QXmlStreamWriter &writer, const QString &tagName) const
+template <class Writer>
+void DomTabStops::writeXml(Writer &writer, const QString &tagName) const
 {
     writer.writeStartElement(tagName.isEmpty() ? QStringLiteral("tabstops") : tagName.toLower());
 
@@ -1573,6 +2578,28 @@ void DomTabStops::write(QXmlStreamWriter &writer, const QString &tagName) const
     writer.writeEndElement();
 }
 
+void DomTabStops::write(QXmlStreamWriter &writer, const QString &tagName) const
+{
+    writeXml(writer, tagName);
+}
+
+void DomTabStops::write(DomXmlWriter &writer, const QString &tagName) const
+{
+    writeXml(writer, tagName);
+}
+
+void DomTabStops::read(QDataStream &stream)
+{
+    stream >> m_children;
+    stream >> m_tabStop;
+}
+
+void DomTabStops::write(QDataStream &stream) const
+{
+    stream << m_children;
+    stream << m_tabStop;
+}
+
 void DomTabStops::setElementTabStop(const QStringList &a)
 {
     m_children |= TabStop;
@@ -1629,24 +2656,28 @@ void DomLayout::read(QXmlStreamReader &reader)
         switch (reader.readNext()) {
         case QXmlStreamReader::StartElement : {
             const auto tag = reader.name();
-            if (!tag.compare(u"property"_s, Qt::CaseInsensitive)) {
+            switch (domTag(tag)) {
+            case DomTag::Property : {
                 auto *v = new DomProperty();
                 v->read(reader);
                 m_property.append(v);
                 continue;
             }
-            if (!tag.compare(u"attribute"_s, Qt::CaseInsensitive)) {
+            case DomTag::Attribute : {
                 auto *v = new DomProperty();
                 v->read(reader);
                 m_attribute.append(v);
                 continue;
             }
-            if (!tag.compare(u"item"_s, Qt::CaseInsensitive)) {
+            case DomTag::Item : {
                 auto *v = new DomLayoutItem();
                 v->read(reader);
                 m_item.append(v);
                 continue;
             }
+            default :
+                break;
+            }
             reader.raiseError("Unexpected element "_L1 + tag);
         }
             break;
@@ -1658,7 +2689,8 @@ void DomLayout::read(QXmlStreamReader &reader)
     }
 }
 
-void DomLayout::write(QXmlStreamWriter &writer, const QString &tagName) const
+template <class Writer>
+void DomLayout::writeXml(Writer &writer, const QString &tagName) const
 {
     writer.writeStartElement(tagName.isEmpty() ? QStringLiteral("layout") : tagName.toLower());
 
@@ -1695,6 +2727,46 @@ void DomLayout::write(QXmlStreamWriter &writer, const QString &tagName) const
     writer.writeEndElement();
 }
 
+void DomLayout::write(QXmlStreamWriter &writer, const QString &tagName) const
+{
+    writeXml(writer, tagName);
+}
+
+void DomLayout::write(DomXmlWriter &writer, const QString &tagName) const
+{
+    writeXml(writer, tagName);
+}
+
+void DomLayout::read(QDataStream &stream)
+{
+    stream >> m_attr_class >> m_has_attr_class;
+    stream >> m_attr_name >> m_has_attr_name;
+    stream >> m_attr_stretch >> m_has_attr_stretch;
+    stream >> m_attr_rowStretch >> m_has_attr_rowStretch;
+    stream >> m_attr_columnStretch >> m_has_attr_columnStretch;
+    stream >> m_attr_rowMinimumHeight >> m_has_attr_rowMinimumHeight;
+    stream >> m_attr_columnMinimumWidth >> m_has_attr_columnMinimumWidth;
+    stream >> m_children;
+    readDomList(stream, m_property);
+    readDomList(stream, m_attribute);
+    readDomList(stream, m_item);
+}
+
+void DomLayout::write(QDataStream &stream) const
+{
+    stream << m_attr_class << m_has_attr_class;
+    stream << m_attr_name << m_has_attr_name;
+    stream << m_attr_stretch << m_has_attr_stretch;
+    stream << m_attr_rowStretch << m_has_attr_rowStretch;
+    stream << m_attr_columnStretch << m_has_attr_columnStretch;
+    stream << m_attr_rowMinimumHeight << m_has_attr_rowMinimumHeight;
+    stream << m_attr_columnMinimumWidth << m_has_attr_columnMinimumWidth;
+    stream << m_children;
+    writeDomList(stream, m_property);
+    writeDomList(stream, m_attribute);
+    writeDomList(stream, m_item);
+}
+
 void DomLayout::setElementProperty(const QList<DomProperty *> &a)
 {
     m_children |= Property;
@@ -1765,24 +2837,28 @@ void DomLayoutItem::read(QXmlStreamReader &reader)
         switch (reader.readNext()) {
         case QXmlStreamReader::StartElement : {
             const auto tag = reader.name();
-            if (!tag.compare(u"widget"_s, Qt::CaseInsensitive)) {
+            switch (domTag(tag)) {
+            case DomTag::Widget : {
                 auto *v = new DomWidget();
                 v->read(reader);
                 setElementWidget(v);
                 continue;
             }
-            if (!tag.compare(u"layout"_s, Qt::CaseInsensitive)) {
+            case DomTag::Layout : {
                 auto *v = new DomLayout();
                 v->read(reader);
                 setElementLayout(v);
                 continue;
             }
-            if (!tag.compare(u"spacer"_s, Qt::CaseInsensitive)) {
+            case DomTag::Spacer : {
                 auto *v = new DomSpacer();
                 v->read(reader);
                 setElementSpacer(v);
                 continue;
             }
+            default :
+                break;
+            }
             reader.raiseError("Unexpected element "_L1 + tag);
         }
             break;
@@ -1794,7 +2870,8 @@ void DomLayoutItem::read(QXmlStreamReader &reader)
     }
 }
 
-void DomLayoutItem::write(QXmlStreamWriter &writer, const QString &tagName) const
+template <class Writer>
+void DomLayoutItem::writeXml(Writer &writer, const QString &tagName) const
 {
     writer.writeStartElement(tagName.isEmpty() ? QStringLiteral("layoutitem") : tagName.toLower());
 
@@ -1835,6 +2912,44 @@ void DomLayoutItem::write(QXmlStreamWriter &writer, const QString &tagName) cons
     writer.writeEndElement();
 }
 
+void DomLayoutItem::write(QXmlStreamWriter &writer, const QString &tagName) const
+{
+    writeXml(writer, tagName);
+}
+
+void DomLayoutItem::write(DomXmlWriter &writer, const QString &tagName) const
+{
+    writeXml(writer, tagName);
+}
+
+void DomLayoutItem::read(QDataStream &stream)
+{
+    int kind = Unknown;
+    stream >> kind;
+    m_kind = Kind(kind);
+    stream >> m_attr_row >> m_has_attr_row;
+    stream >> m_attr_column >> m_has_attr_column;
+    stream >> m_attr_rowSpan >> m_has_attr_rowSpan;
+    stream >> m_attr_colSpan >> m_has_attr_colSpan;
+    stream >> m_attr_alignment >> m_has_attr_alignment;
+    readDomPointer(stream, m_widget);
+    readDomPointer(stream, m_layout);
+    readDomPointer(stream, m_spacer);
+}
+
+void DomLayoutItem::write(QDataStream &stream) const
+{
+    stream << int(m_kind);
+    stream << m_attr_row << m_has_attr_row;
+    stream << m_attr_column << m_has_attr_column;
+    stream << m_attr_rowSpan << m_has_attr_rowSpan;
+    stream << m_attr_colSpan << m_has_attr_colSpan;
+    stream << m_attr_alignment << m_has_attr_alignment;
+    writeDomPointer(stream, m_widget);
+    writeDomPointer(stream, m_layout);
+    writeDomPointer(stream, m_spacer);
+}
+
 DomWidget *DomLayoutItem::takeElementWidget()
 {
     DomWidget *a = m_widget;
@@ -1889,12 +3004,16 @@ void DomRow::read(QXmlStreamReader &reader)
         switch (reader.readNext()) {
         case QXmlStreamReader::StartElement : {
             const auto tag = reader.name();
-            if (!tag.compare(u"property"_s, Qt::CaseInsensitive)) {
+            switch (domTag(tag)) {
+            case DomTag::Property : {
                 auto *v = new DomProperty();
                 v->read(reader);
                 m_property.append(v);
                 continue;
             }
+            default :
+                break;
+            }
             reader.raiseError("Unexpected element "_L1 + tag);
         }
             break;
@@ -1906,7 +3025,8 @@ void DomRow::read(QXmlStreamReader &reader)
     }
 }
 
-void DomRow::write(QXmlStreamWriter &writer, const QString &tagName) const
+template <class Writer>
+void DomRow::writeXml(Writer &writer, const QString &tagName) const
 {
     writer.writeStartElement(tagName.isEmpty() ? QStringLiteral("row") : tagName.toLower());
 
@@ -1916,6 +3036,28 @@ void DomRow::write(QXmlStreamWriter &writer, const QString &tagName) const
     writer.writeEndElement();
 }
 
+void DomRow::write(QXmlStreamWriter &writer, const QString &tagName) const
+{
+    writeXml(writer, tagName);
+}
+
+void DomRow::write(DomXmlWriter &writer, const QString &tagName) const
+{
+    writeXml(writer, tagName);
+}
+
+void DomRow::read(QDataStream &stream)
+{
+    stream >> m_children;
+    readDomList(stream, m_property);
+}
+
+void DomRow::write(QDataStream &stream) const
+{
+    stream << m_children;
+    writeDomList(stream, m_property);
+}
+
 void DomRow::setElementProperty(const QList<DomProperty *> &a)
 {
     m_children |= Property;
@@ -1934,12 +3076,16 @@ void DomColumn::read(QXmlStreamReader &reader)
         switch (reader.readNext()) {
         case QXmlStreamReader::StartElement : {
             const auto tag = reader.name();
-            if (!tag.compare(u"property"_s, Qt::CaseInsensitive)) {
+            switch (domTag(tag)) {
+            case DomTag::Property : {
                 auto *v = new DomProperty();
                 v->read(reader);
                 m_property.append(v);
                 continue;
             }
+            default :
+                break;
+            }
             reader.raiseError("Unexpected element "_L1 + tag);
         }
             break;
@@ -1951,7 +3097,8 @@ void DomColumn::read(QXmlStreamReader &reader)
     }
 }
 
-void DomColumn::write(QXmlStreamWriter &writer, const QString &tagName) const
+template <class Writer>
+void DomColumn::writeXml(Writer &writer, const QString &tagName) const
 {
     writer.writeStartElement(tagName.isEmpty() ? QStringLiteral("column") : tagName.toLower());
 
@@ -1961,6 +3108,28 @@ void DomColumn::write(QXmlStreamWriter &writer, const QString &tagName) const
     writer.writeEndElement();
 }
 
+void DomColumn::write(QXmlStreamWriter &writer, const QString &tagName) const
+{
+    writeXml(writer, tagName);
+}
+
+void DomColumn::write(DomXmlWriter &writer, const QString &tagName) const
+{
+    writeXml(writer, tagName);
+}
+
+void DomColumn::read(QDataStream &stream)
+{
+    stream >> m_children;
+    readDomList(stream, m_property);
+}
+
+void DomColumn::write(QDataStream &stream) const
+{
+    stream << m_children;
+    writeDomList(stream, m_property);
+}
+
 void DomColumn::setElementProperty(const QList<DomProperty *> &a)
 {
     m_children |= Property;
@@ -1995,18 +3164,22 @@ void DomItem::read(QXmlStreamReader &reader)
         switch (reader.readNext()) {
         case QXmlStreamReader::StartElement : {
             const auto tag = reader.name();
-            if (!tag.compare(u"property"_s, Qt::CaseInsensitive)) {
+            switch (domTag(tag)) {
+            case DomTag::Property : {
                 auto *v = new DomProperty();
                 v->read(reader);
                 m_property.append(v);
                 continue;
             }
-            if (!tag.compare(u"item"_s, Qt::CaseInsensitive)) {
+            case DomTag::Item : {
                 auto *v = new DomItem();
                 v->read(reader);
                 m_item.append(v);
                 continue;
             }
+            default :
+                break;
+            }
             reader.raiseError("Unexpected element "_L1 + tag);
         }
             break;
@@ -2018,7 +3191,8 @@ void DomItem::read(QXmlStreamReader &reader)
     }
 }
 
-void DomItem::write(QXmlStreamWriter &writer, const QString &tagName) const
+template <class Writer>
+void DomItem::writeXml(Writer &writer, const QString &tagName) const
 {
     writer.writeStartElement(tagName.isEmpty() ? QStringLiteral("item") : tagName.toLower());
 
@@ -2037,6 +3211,34 @@ void DomItem::write(QXmlStreamWriter &writer, const QString &tagName) const
     writer.writeEndElement();
 }
 
+void DomItem::write(QXmlStreamWriter &writer, const QString &tagName) const
+{
+    writeXml(writer, tagName);
+}
+
+void DomItem::write(DomXmlWriter &writer, const QString &tagName) const
+{
+    writeXml(writer, tagName);
+}
+
+void DomItem::read(QDataStream &stream)
+{
+    stream >> m_attr_row >> m_has_attr_row;
+    stream >> m_attr_column >> m_has_attr_column;
+    stream >> m_children;
+    readDomList(stream, m_property);
+    readDomList(stream, m_item);
+}
+
+void DomItem::write(QDataStream &stream) const
+{
+    stream << m_attr_row << m_has_attr_row;
+    stream << m_attr_column << m_has_attr_column;
+    stream << m_children;
+    writeDomList(stream, m_property);
+    writeDomList(stream, m_item);
+}
+
 void DomItem::setElementProperty(const QList<DomProperty *> &a)
 {
     m_children |= Property;
@@ -2099,84 +3301,88 @@ void DomWidget::read(QXmlStreamReader &reader)
         switch (reader.readNext()) {
         case QXmlStreamReader::StartElement : {
             const auto tag = reader.name();
-            if (!tag.compare(u"class"_s, Qt::CaseInsensitive)) {
+            switch (domTag(tag)) {
+            case DomTag::Class : {
                 m_class.append(reader.readElementText());
                 continue;
             }
-            if (!tag.compare(u"property"_s, Qt::CaseInsensitive)) {
+            case DomTag::Property : {
                 auto *v = new DomProperty();
                 v->read(reader);
                 m_property.append(v);
                 continue;
             }
-            if (!tag.compare(u"script"_s, Qt::CaseInsensitive)) {
+            case DomTag::Script : {
                 qWarning("Omitting deprecated element <script>.");
                 reader.skipCurrentElement();
                 continue;
             }
-            if (!tag.compare(u"widgetdata"_s, Qt::CaseInsensitive)) {
+            case DomTag::WidgetData : {
                 qWarning("Omitting deprecated element <widgetdata>.");
                 reader.skipCurrentElement();
                 continue;
             }
-            if (!tag.compare(u"attribute"_s, Qt::CaseInsensitive)) {
+            case DomTag::Attribute : {
                 auto *v = new DomProperty();
                 v->read(reader);
                 m_attribute.append(v);
                 continue;
             }
-            if (!tag.compare(u"row"_s, Qt::CaseInsensitive)) {
+            case DomTag::Row : {
                 auto *v = new DomRow();
                 v->read(reader);
                 m_row.append(v);
                 continue;
             }
-            if (!tag.compare(u"column"_s, Qt::CaseInsensitive)) {
+            case DomTag::Column : {
                 auto *v = new DomColumn();
                 v->read(reader);
                 m_column.append(v);
                 continue;
             }
-            if (!tag.compare(u"item"_s, Qt::CaseInsensitive)) {
+            case DomTag::Item : {
                 auto *v = new DomItem();
                 v->read(reader);
                 m_item.append(v);
                 continue;
             }
-            if (!tag.compare(u"layout"_s, Qt::CaseInsensitive)) {
+            case DomTag::Layout : {
                 auto *v = new DomLayout();
                 v->read(reader);
                 m_layout.append(v);
                 continue;
             }
-            if (!tag.compare(u"widget"_s, Qt::CaseInsensitive)) {
+            case DomTag::Widget : {
                 auto *v = new DomWidget();
                 v->read(reader);
                 m_widget.append(v);
                 continue;
             }
-            if (!tag.compare(u"action"_s, Qt::CaseInsensitive)) {
+            case DomTag::Action : {
                 auto *v = new DomAction();
                 v->read(reader);
                 m_action.append(v);
                 continue;
             }
-            if (!tag.compare(u"actiongroup"_s, Qt::CaseInsensitive)) {
+            case DomTag::ActionGroup : {
                 auto *v = new DomActionGroup();
                 v->read(reader);
                 m_actionGroup.append(v);
                 continue;
             }
-            if (!tag.compare(u"addaction"_s, Qt::CaseInsensitive)) {
+            case DomTag::AddAction : {
                 auto *v = new DomActionRef();
                 v->read(reader);
                 m_addAction.append(v);
                 continue;
             }
-            if (!tag.compare(u"zorder"_s, Qt::CaseInsensitive)) {
+            case DomTag::ZOrder : {
                 m_zOrder.append(reader.readElementText());
                 continue;
             }
+            default :
+                break;
+            }
             reader.raiseError("Unexpected element "_L1 + tag);
         }
             break;
@@ -2188,7 +3394,8 @@ void DomWidget::read(QXmlStreamReader &reader)
     }
 }
 
-void DomWidget::write(QXmlStreamWriter &writer, const QString &tagName) const
+template <class Writer>
+void DomWidget::writeXml(Writer &writer, const QString &tagName) const
 {
     writer.writeStartElement(tagName.isEmpty() ? QStringLiteral("widget") : tagName.toLower());
 
@@ -2240,6 +3447,56 @@ void DomWidget::write(QXmlStreamWriter &writer, const QString &tagName) const
     writer.writeEndElement();
 }
 
+void DomWidget::write(QXmlStreamWriter &writer, const QString &tagName) const
+{
+    writeXml(writer, tagName);
+}
+
+void DomWidget::write(DomXmlWriter &writer, const QString &tagName) const
+{
+    writeXml(writer, tagName);
+}
+
+void DomWidget::read(QDataStream &stream)
+{
+    stream >> m_attr_class >> m_has_attr_class;
+    stream >> m_attr_name >> m_has_attr_name;
+    stream >> m_attr_native >> m_has_attr_native;
+    stream >> m_children;
+    stream >> m_class;
+    readDomList(stream, m_property);
+    readDomList(stream, m_attribute);
+    readDomList(stream, m_row);
+    readDomList(stream, m_column);
+    readDomList(stream, m_item);
+    readDomList(stream, m_layout);
+    readDomList(stream, m_widget);
+    readDomList(stream, m_action);
+    readDomList(stream, m_actionGroup);
+    readDomList(stream, m_addAction);
+    stream >> m_zOrder;
+}
+
+void DomWidget::write(QDataStream &stream) const
+{
+    stream << m_attr_class << m_has_attr_class;
+    stream << m_attr_name << m_has_attr_name;
+    stream << m_attr_native << m_has_attr_native;
+    stream << m_children;
+    stream << m_class;
+    writeDomList(stream, m_property);
+    writeDomList(stream, m_attribute);
+    writeDomList(stream, m_row);
+    writeDomList(stream, m_column);
+    writeDomList(stream, m_item);
+    writeDomList(stream, m_layout);
+    writeDomList(stream, m_widget);
+    writeDomList(stream, m_action);
+    writeDomList(stream, m_actionGroup);
+    writeDomList(stream, m_addAction);
+    stream << m_zOrder;
+}
+
 void DomWidget::setElementClass(const QStringList &a)
 {
     m_children |= Class;
@@ -2334,12 +3591,16 @@ void DomSpacer::read(QXmlStreamReader &reader)
         switch (reader.readNext()) {
         case QXmlStreamReader::StartElement : {
             const auto tag = reader.name();
-            if (!tag.compare(u"property"_s, Qt::CaseInsensitive)) {
+            switch (domTag(tag)) {
+            case DomTag::Property : {
                 auto *v = new DomProperty();
                 v->read(reader);
                 m_property.append(v);
                 continue;
             }
+            default :
+                break;
+            }
             reader.raiseError("Unexpected element "_L1 + tag);
         }
             break;
@@ -2351,7 +3612,8 @@ void DomSpacer::read(QXmlStreamReader &reader)
     }
 }
 
-void DomSpacer::write(QXmlStreamWriter &writer, const QString &tagName) const
+template <class Writer>
+void DomSpacer::writeXml(Writer &writer, const QString &tagName) const
 {
     writer.writeStartElement(tagName.isEmpty() ? QStringLiteral("spacer") : tagName.toLower());
 
@@ -2364,6 +3626,30 @@ void DomSpacer::write(QXmlStreamWriter &writer, const QString &tagName) const
     writer.writeEndElement();
 }
 
+void DomSpacer::write(QXmlStreamWriter &writer, const QString &tagName) const
+{
+    writeXml(writer, tagName);
+}
+
+void DomSpacer::write(DomXmlWriter &writer, const QString &tagName) const
+{
+    writeXml(writer, tagName);
+}
+
+void DomSpacer::read(QDataStream &stream)
+{
+    stream >> m_attr_name >> m_has_attr_name;
+    stream >> m_children;
+    readDomList(stream, m_property);
+}
+
+void DomSpacer::write(QDataStream &stream) const
+{
+    stream << m_attr_name << m_has_attr_name;
+    stream << m_children;
+    writeDomList(stream, m_property);
+}
+
 void DomSpacer::setElementProperty(const QList<DomProperty *> &a)
 {
     m_children |= Property;
@@ -2388,18 +3674,22 @@ void DomColor::read(QXmlStreamReader &reader)
         switch (reader.readNext()) {
         case QXmlStreamReader::StartElement : {
             const auto tag = reader.name();
-            if (!tag.compare(u"red"_s, Qt::CaseInsensitive)) {
+            switch (domTag(tag)) {
+            case DomTag::Red : {
                 setElementRed(reader.readElementText().toInt());
                 continue;
             }
-            if (!tag.compare(u"green"_s, Qt::CaseInsensitive)) {
+            case DomTag::Green : {
                 setElementGreen(reader.readElementText().toInt());
                 continue;
             }
-            if (!tag.compare(u"blue"_s, Qt::CaseInsensitive)) {
+            case DomTag::Blue : {
                 setElementBlue(reader.readElementText().toInt());
                 continue;
             }
+            default :
+                break;
+            }
             reader.raiseError("Unexpected element "_L1 + tag);
         }
             break;
@@ -2411,7 +3701,8 @@ void DomColor::read(QXmlStreamReader &reader)
     }
 }
 
-void DomColor::write(QXmlStreamWriter &writer, const QString &tagName) const
+template <class Writer>
+void DomColor::writeXml(Writer &writer, const QString &tagName) const
 {
     writer.writeStartElement(tagName.isEmpty() ? QStringLiteral("color") : tagName.toLower());
 
@@ -2430,6 +3721,34 @@ void DomColor::write(QXmlStreamWriter &writer, const QString &tagName) const
     writer.writeEndElement();
 }
 
+void DomColor::write(QXmlStreamWriter &writer, const QString &tagName) const
+{
+    writeXml(writer, tagName);
+}
+
+void DomColor::write(DomXmlWriter &writer, const QString &tagName) const
+{
+    writeXml(writer, tagName);
+}
+
+void DomColor::read(QDataStream &stream)
+{
+    stream >> m_attr_alpha >> m_has_attr_alpha;
+    stream >> m_children;
+    stream >> m_red;
+    stream >> m_green;
+    stream >> m_blue;
+}
+
+void DomColor::write(QDataStream &stream) const
+{
+    stream << m_attr_alpha << m_has_attr_alpha;
+    stream << m_children;
+    stream << m_red;
+    stream << m_green;
+    stream << m_blue;
+}
+
 void DomColor::setElementRed(int a)
 {
     m_children |= Red;
@@ -2484,12 +3803,16 @@ void DomGradientStop::read(QXmlStreamReader &reader)
         switch (reader.readNext()) {
         case QXmlStreamReader::StartElement : {
             const auto tag = reader.name();
-            if (!tag.compare(u"color"_s, Qt::CaseInsensitive)) {
+            switch (domTag(tag)) {
+            case DomTag::Color : {
                 auto *v = new DomColor();
                 v->read(reader);
                 setElementColor(v);
                 continue;
             }
+            default :
+                break;
+            }
             reader.raiseError("Unexpected element "_L1 + tag);
         }
             break;
@@ -2501,7 +3824,8 @@ void DomGradientStop::read(QXmlStreamReader &reader)
     }
 }
 
-void DomGradientStop::write(QXmlStreamWriter &writer, const QString &tagName) const
+template <class Writer>
+void DomGradientStop::writeXml(Writer &writer, const QString &tagName) const
 {
     writer.writeStartElement(tagName.isEmpty() ? QStringLiteral("gradientstop") : tagName.toLower());
 
@@ -2514,6 +3838,30 @@ void DomGradientStop::write(QXmlStreamWriter &writer, const QString &tagName) co
     writer.writeEndElement();
 }
 
+void DomGradientStop::write(QXmlStreamWriter &writer, const QString &tagName) const
+{
+    writeXml(writer, tagName);
+}
+
+void DomGradientStop::write(DomXmlWriter &writer, const QString &tagName) const
+{
+    writeXml(writer, tagName);
+}
+
+void DomGradientStop::read(QDataStream &stream)
+{
+    stream >> m_attr_position >> m_has_attr_position;
+    stream >> m_children;
+    readDomPointer(stream, m_color);
+}
+
+void DomGradientStop::write(QDataStream &stream) const
+{
+    stream << m_attr_position << m_has_attr_position;
+    stream << m_children;
+    writeDomPointer(stream, m_color);
+}
+
 DomColor *DomGradientStop::takeElementColor()
 {
     DomColor *a = m_color;
@@ -2606,12 +3954,16 @@ void DomGradient::read(QXmlStreamReader &reader)
         switch (reader.readNext()) {
         case QXmlStreamReader::StartElement : {
             const auto tag = reader.name();
-            if (!tag.compare(u"gradientstop"_s, Qt::CaseInsensitive)) {
+            switch (domTag(tag)) {
+            case DomTag::Gradientstop : {
                 auto *v = new DomGradientStop();
                 v->read(reader);
                 m_gradientStop.append(v);
                 continue;
             }
+            default :
+                break;
+            }
             reader.raiseError("Unexpected element "_L1 + tag);
         }
             break;
@@ -2623,7 +3975,8 @@ void DomGradient::read(QXmlStreamReader &reader)
     }
 }
 
-void DomGradient::write(QXmlStreamWriter &writer, const QString &tagName) const
+template <class Writer>
+void DomGradient::writeXml(Writer &writer, const QString &tagName) const
 {
     writer.writeStartElement(tagName.isEmpty() ? QStringLiteral("gradient") : tagName.toLower());
 
@@ -2672,6 +4025,54 @@ void DomGradient::write(QXmlStreamWriter &writer, const QString &tagName) const
     writer.writeEndElement();
 }
 
+void DomGradient::write(QXmlStreamWriter &writer, const QString &tagName) const
+{
+    writeXml(writer, tagName);
+}
+
+void DomGradient::write(DomXmlWriter &writer, const QString &tagName) const
+{
+    writeXml(writer, tagName);
+}
+
+void DomGradient::read(QDataStream &stream)
+{
+    stream >> m_attr_startX >> m_has_attr_startX;
+    stream >> m_attr_startY >> m_has_attr_startY;
+    stream >> m_attr_endX >> m_has_attr_endX;
+    stream >> m_attr_endY >> m_has_attr_endY;
+    stream >> m_attr_centralX >> m_has_attr_centralX;
+    stream >> m_attr_centralY >> m_has_attr_centralY;
+    stream >> m_attr_focalX >> m_has_attr_focalX;
+    stream >> m_attr_focalY >> m_has_attr_focalY;
+    stream >> m_attr_radius >> m_has_attr_radius;
+    stream >> m_attr_angle >> m_has_attr_angle;
+    stream >> m_attr_type >> m_has_attr_type;
+    stream >> m_attr_spread >> m_has_attr_spread;
+    stream >> m_attr_coordinateMode >> m_has_attr_coordinateMode;
+    stream >> m_children;
+    readDomList(stream, m_gradientStop);
+}
+
+void DomGradient::write(QDataStream &stream) const
+{
+    stream << m_attr_startX << m_has_attr_startX;
+    stream << m_attr_startY << m_has_attr_startY;
+    stream << m_attr_endX << m_has_attr_endX;
+    stream << m_attr_endY << m_has_attr_endY;
+    stream << m_attr_centralX << m_has_attr_centralX;
+    stream << m_attr_centralY << m_has_attr_centralY;
+    stream << m_attr_focalX << m_has_attr_focalX;
+    stream << m_attr_focalY << m_has_attr_focalY;
+    stream << m_attr_radius << m_has_attr_radius;
+    stream << m_attr_angle << m_has_attr_angle;
+    stream << m_attr_type << m_has_attr_type;
+    stream << m_attr_spread << m_has_attr_spread;
+    stream << m_attr_coordinateMode << m_has_attr_coordinateMode;
+    stream << m_children;
+    writeDomList(stream, m_gradientStop);
+}
+
 void DomGradient::setElementGradientStop(const QList<DomGradientStop *> &a)
 {
     m_children |= GradientStop;
@@ -2714,24 +4115,28 @@ void DomBrush::read(QXmlStreamReader &reader)
         switch (reader.readNext()) {
         case QXmlStreamReader::StartElement : {
             const auto tag = reader.name();
-            if (!tag.compare(u"color"_s, Qt::CaseInsensitive)) {
+            switch (domTag(tag)) {
+            case DomTag::Color : {
                 auto *v = new DomColor();
                 v->read(reader);
                 setElementColor(v);
                 continue;
             }
-            if (!tag.compare(u"texture"_s, Qt::CaseInsensitive)) {
+            case DomTag::Texture : {
                 auto *v = new DomProperty();
                 v->read(reader);
                 setElementTexture(v);
                 continue;
             }
-            if (!tag.compare(u"gradient"_s, Qt::CaseInsensitive)) {
+            case DomTag::Gradient : {
                 auto *v = new DomGradient();
                 v->read(reader);
                 setElementGradient(v);
                 continue;
             }
+            default :
+                break;
+            }
             reader.raiseError("Unexpected element "_L1 + tag);
         }
             break;
@@ -2743,7 +4148,8 @@ void DomBrush::read(QXmlStreamReader &reader)
     }
 }
 
-void DomBrush::write(QXmlStreamWriter &writer, const QString &tagName) const
+template <class Writer>
+void DomBrush::writeXml(Writer &writer, const QString &tagName) const
 {
     writer.writeStartElement(tagName.isEmpty() ? QStringLiteral("brush") : tagName.toLower());
 
@@ -2772,6 +4178,36 @@ void DomBrush::write(QXmlStreamWriter &writer, const QString &tagName) const
     writer.writeEndElement();
 }
 
+void DomBrush::write(QXmlStreamWriter &writer, const QString &tagName) const
+{
+    writeXml(writer, tagName);
+}
+
+void DomBrush::write(DomXmlWriter &writer, const QString &tagName) const
+{
+    writeXml(writer, tagName);
+}
+
+void DomBrush::read(QDataStream &stream)
+{
+    int kind = Unknown;
+    stream >> kind;
+    m_kind = Kind(kind);
+    stream >> m_attr_brushStyle >> m_has_attr_brushStyle;
+    readDomPointer(stream, m_color);
+    readDomPointer(stream, m_texture);
+    readDomPointer(stream, m_gradient);
+}
+
+void DomBrush::write(QDataStream &stream) const
+{
+    stream << int(m_kind);
+    stream << m_attr_brushStyle << m_has_attr_brushStyle;
+    writeDomPointer(stream, m_color);
+    writeDomPointer(stream, m_texture);
+    writeDomPointer(stream, m_gradient);
+}
+
 DomColor *DomBrush::takeElementColor()
 {
     DomColor *a = m_color;
@@ -2835,12 +4271,16 @@ void DomColorRole::read(QXmlStreamReader &reader)
         switch (reader.readNext()) {
         case QXmlStreamReader::StartElement : {
             const auto tag = reader.name();
-            if (!tag.compare(u"brush"_s, Qt::CaseInsensitive)) {
+            switch (domTag(tag)) {
+            case DomTag::Brush : {
                 auto *v = new DomBrush();
                 v->read(reader);
                 setElementBrush(v);
                 continue;
             }
+            default :
+                break;
+            }
             reader.raiseError("Unexpected element "_L1 + tag);
         }
             break;
@@ -2852,7 +4292,8 @@ void DomColorRole::read(QXmlStreamReader &reader)
     }
 }
 
-void DomColorRole::write(QXmlStreamWriter &writer, const QString &tagName) const
+template <class Writer>
+void DomColorRole::writeXml(Writer &writer, const QString &tagName) const
 {
     writer.writeStartElement(tagName.isEmpty() ? QStringLiteral("colorrole") : tagName.toLower());
 
@@ -2865,6 +4306,30 @@ void DomColorRole::write(QXmlStreamWriter &writer, const QString &tagName) const
     writer.writeEndElement();
 }
 
+void DomColorRole::write(QXmlStreamWriter &writer, const QString &tagName) const
+{
+    writeXml(writer, tagName);
+}
+
+void DomColorRole::write(DomXmlWriter &writer, const QString &tagName) const
+{
+    writeXml(writer, tagName);
+}
+
+void DomColorRole::read(QDataStream &stream)
+{
+    stream >> m_attr_role >> m_has_attr_role;
+    stream >> m_children;
+    readDomPointer(stream, m_brush);
+}
+
+void DomColorRole::write(QDataStream &stream) const
+{
+    stream << m_attr_role << m_has_attr_role;
+    stream << m_children;
+    writeDomPointer(stream, m_brush);
+}
+
 DomBrush *DomColorRole::takeElementBrush()
 {
     DomBrush *a = m_brush;
@@ -2901,18 +4366,22 @@ void DomColorGroup::read(QXmlStreamReader &reader)
         switch (reader.readNext()) {
         case QXmlStreamReader::StartElement : {
             const auto tag = reader.name();
-            if (!tag.compare(u"colorrole"_s, Qt::CaseInsensitive)) {
+            switch (domTag(tag)) {
+            case DomTag::ColorRole : {
                 auto *v = new DomColorRole();
                 v->read(reader);
                 m_colorRole.append(v);
                 continue;
             }
-            if (!tag.compare(u"color"_s, Qt::CaseInsensitive)) {
+            case DomTag::Color : {
                 auto *v = new DomColor();
                 v->read(reader);
                 m_color.append(v);
                 continue;
             }
+            default :
+                break;
+            }
             reader.raiseError("Unexpected element "_L1 + tag);
         }
             break;
@@ -2924,7 +4393,8 @@ void DomColorGroup::read(QXmlStreamReader &reader)
     }
 }
 
-void DomColorGroup::write(QXmlStreamWriter &writer, const QString &tagName) const
+template <class Writer>
+void DomColorGroup::writeXml(Writer &writer, const QString &tagName) const
 {
     writer.writeStartElement(tagName.isEmpty() ? QStringLiteral("colorgroup") : tagName.toLower());
 
@@ -2937,6 +4407,30 @@ void DomColorGroup::write(QXmlStreamWriter &writer, const QString &tagName) cons
     writer.writeEndElement();
 }
 
+void DomColorGroup::write(QXmlStreamWriter &writer, const QString &tagName) const
+{
+    writeXml(writer, tagName);
+}
+
+void DomColorGroup::write(DomXmlWriter &writer, const QString &tagName) const
+{
+    writeXml(writer, tagName);
+}
+
+void DomColorGroup::read(QDataStream &stream)
+{
+    stream >> m_children;
+    readDomList(stream, m_colorRole);
+    readDomList(stream, m_color);
+}
+
+void DomColorGroup::write(QDataStream &stream) const
+{
+    stream << m_children;
+    writeDomList(stream, m_colorRole);
+    writeDomList(stream, m_color);
+}
+
 void DomColorGroup::setElementColorRole(const QList<DomColorRole *> &a)
 {
     m_children |= ColorRole;
@@ -2962,24 +4456,28 @@ void DomPalette::read(QXmlStreamReader &reader)
         switch (reader.readNext()) {
         case QXmlStreamReader::StartElement : {
             const auto tag = reader.name();
-            if (!tag.compare(u"active"_s, Qt::CaseInsensitive)) {
+            switch (domTag(tag)) {
+            case DomTag::Active : {
                 auto *v = new DomColorGroup();
                 v->read(reader);
                 setElementActive(v);
                 continue;
             }
-            if (!tag.compare(u"inactive"_s, Qt::CaseInsensitive)) {
+            case DomTag::Inactive : {
                 auto *v = new DomColorGroup();
                 v->read(reader);
                 setElementInactive(v);
                 continue;
             }
-            if (!tag.compare(u"disabled"_s, Qt::CaseInsensitive)) {
+            case DomTag::Disabled : {
                 auto *v = new DomColorGroup();
                 v->read(reader);
                 setElementDisabled(v);
                 continue;
             }
+            default :
+                break;
+            }
             reader.raiseError("Unexpected element "_L1 + tag);
         }
             break;
@@ -2991,7 +4489,8 @@ void DomPalette::read(QXmlStreamReader &reader)
     }
 }
 
-void DomPalette::write(QXmlStreamWriter &writer, const QString &tagName) const
+template <class Writer>
+void DomPalette::writeXml(Writer &writer, const QString &tagName) const
 {
     writer.writeStartElement(tagName.isEmpty() ? QStringLiteral("palette") : tagName.toLower());
 
@@ -3007,6 +4506,32 @@ void DomPalette::write(QXmlStreamWriter &writer, const QString &tagName) const
     writer.writeEndElement();
 }
 
+void DomPalette::write(QXmlStreamWriter &writer, const QString &tagName) const
+{
+    writeXml(writer, tagName);
+}
+
+void DomPalette::write(DomXmlWriter &writer, const QString &tagName) const
+{
+    writeXml(writer, tagName);
+}
+
+void DomPalette::read(QDataStream &stream)
+{
+    stream >> m_children;
+    readDomPointer(stream, m_active);
+    readDomPointer(stream, m_inactive);
+    readDomPointer(stream, m_disabled);
+}
+
+void DomPalette::write(QDataStream &stream) const
+{
+    stream << m_children;
+    writeDomPointer(stream, m_active);
+    writeDomPointer(stream, m_inactive);
+    writeDomPointer(stream, m_disabled);
+}
+
 DomColorGroup *DomPalette::takeElementActive()
 {
     DomColorGroup *a = m_active;
@@ -3081,46 +4606,50 @@ void DomFont::read(QXmlStreamReader &reader)
         switch (reader.readNext()) {
         case QXmlStreamReader::StartElement : {
             const auto tag = reader.name();
-            if (!tag.compare(u"family"_s, Qt::CaseInsensitive)) {
+            switch (domTag(tag)) {
+            case DomTag::Family : {
                 setElementFamily(reader.readElementText());
                 continue;
             }
-            if (!tag.compare(u"pointsize"_s, Qt::CaseInsensitive)) {
+            case DomTag::PointSize : {
                 setElementPointSize(reader.readElementText().toInt());
                 continue;
             }
-            if (!tag.compare(u"weight"_s, Qt::CaseInsensitive)) {
+            case DomTag::Weight : {
                 setElementWeight(reader.readElementText().toInt());
                 continue;
             }
-            if (!tag.compare(u"italic"_s, Qt::CaseInsensitive)) {
+            case DomTag::Italic : {
                 setElementItalic(reader.readElementText() == u"true"_s);
                 continue;
             }
-            if (!tag.compare(u"bold"_s, Qt::CaseInsensitive)) {
+            case DomTag::Bold : {
                 setElementBold(reader.readElementText() == u"true"_s);
                 continue;
             }
-            if (!tag.compare(u"underline"_s, Qt::CaseInsensitive)) {
+            case DomTag::Underline : {
                 setElementUnderline(reader.readElementText() == u"true"_s);
                 continue;
             }
-            if (!tag.compare(u"strikeout"_s, Qt::CaseInsensitive)) {
+            case DomTag::StrikeOut : {
                 setElementStrikeOut(reader.readElementText() == u"true"_s);
                 continue;
             }
-            if (!tag.compare(u"antialiasing"_s, Qt::CaseInsensitive)) {
+            case DomTag::Antialiasing : {
                 setElementAntialiasing(reader.readElementText() == u"true"_s);
                 continue;
             }
-            if (!tag.compare(u"stylestrategy"_s, Qt::CaseInsensitive)) {
+            case DomTag::StyleStrategy : {
                 setElementStyleStrategy(reader.readElementText());
                 continue;
             }
-            if (!tag.compare(u"kerning"_s, Qt::CaseInsensitive)) {
+            case DomTag::Kerning : {
                 setElementKerning(reader.readElementText() == u"true"_s);
                 continue;
             }
+            default :
+                break;
+            }
             reader.raiseError("Unexpected element "_L1 + tag);
         }
             break;
@@ -3132,7 +4661,8 @@ void DomFont::read(QXmlStreamReader &reader)
     }
 }
 
-void DomFont::write(QXmlStreamWriter &writer, const QString &tagName) const
+template <class Writer>
+void DomFont::writeXml(Writer &writer, const QString &tagName) const
 {
     writer.writeStartElement(tagName.isEmpty() ? QStringLiteral("font") : tagName.toLower());
 
@@ -3169,6 +4699,46 @@ void DomFont::write(QXmlStreamWriter &writer, const QString &tagName) const
     writer.writeEndElement();
 }
 
+void DomFont::write(QXmlStreamWriter &writer, const QString &tagName) const
+{
+    writeXml(writer, tagName);
+}
+
+void DomFont::write(DomXmlWriter &writer, const QString &tagName) const
+{
+    writeXml(writer, tagName);
+}
+
+void DomFont::read(QDataStream &stream)
+{
+    stream >> m_children;
+    stream >> m_family;
+    stream >> m_pointSize;
+    stream >> m_weight;
+    stream >> m_italic;
+    stream >> m_bold;
+    stream >> m_underline;
+    stream >> m_strikeOut;
+    stream >> m_antialiasing;
+    stream >> m_styleStrategy;
+    stream >> m_kerning;
+}
+
+void DomFont::write(QDataStream &stream) const
+{
+    stream << m_children;
+    stream << m_family;
+    stream << m_pointSize;
+    stream << m_weight;
+    stream << m_italic;
+    stream << m_bold;
+    stream << m_underline;
+    stream << m_strikeOut;
+    stream << m_antialiasing;
+    stream << m_styleStrategy;
+    stream << m_kerning;
+}
+
 void DomFont::setElementFamily(const QString &a)
 {
     m_children |= Family;
@@ -3287,14 +4857,18 @@ void DomPoint::read(QXmlStreamReader &reader)
         switch (reader.readNext()) {
         case QXmlStreamReader::StartElement : {
             const auto tag = reader.name();
-            if (!tag.compare(u"x"_s, Qt::CaseInsensitive)) {
+            switch (domTag(tag)) {
+            case DomTag::X : {
                 setElementX(reader.readElementText().toInt());
                 continue;
             }
-            if (!tag.compare(u"y"_s, Qt::CaseInsensitive)) {
+            case DomTag::Y : {
                 setElementY(reader.readElementText().toInt());
                 continue;
             }
+            default :
+                break;
+            }
             reader.raiseError("Unexpected element "_L1 + tag);
         }
             break;
@@ -3306,7 +4880,8 @@ void DomPoint::read(QXmlStreamReader &reader)
     }
 }
 
-void DomPoint::write(QXmlStreamWriter &writer, const QString &tagName) const
+template <class Writer>
+void DomPoint::writeXml(Writer &writer, const QString &tagName) const
 {
     writer.writeStartElement(tagName.isEmpty() ? QStringLiteral("point") : tagName.toLower());
 
@@ -3319,6 +4894,30 @@ void DomPoint::write(QXmlStreamWriter &writer, const QString &tagName) const
     writer.writeEndElement();
 }
 
+void DomPoint::write(QXmlStreamWriter &writer, const QString &tagName) const
+{
+    writeXml(writer, tagName);
+}
+
+void DomPoint::write(DomXmlWriter &writer, const QString &tagName) const
+{
+    writeXml(writer, tagName);
+}
+
+void DomPoint::read(QDataStream &stream)
+{
+    stream >> m_children;
+    stream >> m_x;
+    stream >> m_y;
+}
+
+void DomPoint::write(QDataStream &stream) const
+{
+    stream << m_children;
+    stream << m_x;
+    stream << m_y;
+}
+
 void DomPoint::setElementX(int a)
 {
     m_children |= X;
@@ -3349,22 +4948,26 @@ void DomRect::read(QXmlStreamReader &reader)
         switch (reader.readNext()) {
         case QXmlStreamReader::StartElement : {
             const auto tag = reader.name();
-            if (!tag.compare(u"x"_s, Qt::CaseInsensitive)) {
+            switch (domTag(tag)) {
+            case DomTag::X : {
                 setElementX(reader.readElementText().toInt());
                 continue;
             }
-            if (!tag.compare(u"y"_s, Qt::CaseInsensitive)) {
+            case DomTag::Y : {
                 setElementY(reader.readElementText().toInt());
                 continue;
             }
-            if (!tag.compare(u"width"_s, Qt::CaseInsensitive)) {
+            case DomTag::Width : {
                 setElementWidth(reader.readElementText().toInt());
                 continue;
             }
-            if (!tag.compare(u"height"_s, Qt::CaseInsensitive)) {
+            case DomTag::Height : {
                 setElementHeight(reader.readElementText().toInt());
                 continue;
             }
+            default :
+                break;
+            }
             reader.raiseError("Unexpected element "_L1 + tag);
         }
             break;
@@ -3376,7 +4979,8 @@ void DomRect::read(QXmlStreamReader &reader)
     }
 }
 
-void DomRect::write(QXmlStreamWriter &writer, const QString &tagName) const
+template <class Writer>
+void DomRect::writeXml(Writer &writer, const QString &tagName) const
 {
     writer.writeStartElement(tagName.isEmpty() ? QStringLiteral("rect") : tagName.toLower());
 
@@ -3395,6 +4999,34 @@ void DomRect::write(QXmlStreamWriter &writer, const QString &tagName) const
     writer.writeEndElement();
 }
 
+void DomRect::write(QXmlStreamWriter &writer, const QString &tagName) const
+{
+    writeXml(writer, tagName);
+}
+
+void DomRect::write(DomXmlWriter &writer, const QString &tagName) const
+{
+    writeXml(writer, tagName);
+}
+
+void DomRect::read(QDataStream &stream)
+{
+    stream >> m_children;
+    stream >> m_x;
+    stream >> m_y;
+    stream >> m_width;
+    stream >> m_height;
+}
+
+void DomRect::write(QDataStream &stream) const
+{
+    stream << m_children;
+    stream << m_x;
+    stream << m_y;
+    stream << m_width;
+    stream << m_height;
+}
+
 void DomRect::setElementX(int a)
 {
     m_children |= X;
@@ -3472,7 +5104,8 @@ void DomLocale::read(QXmlStreamReader &reader)
     }
 }
 
-void DomLocale::write(QXmlStreamWriter &writer, const QString &tagName) const
+template <class Writer>
+void DomLocale::writeXml(Writer &writer, const QString &tagName) const
 {
     writer.writeStartElement(tagName.isEmpty() ? QStringLiteral("locale") : tagName.toLower());
 
@@ -3485,6 +5118,28 @@ void DomLocale::write(QXmlStreamWriter &writer, const QString &tagName) const
     writer.writeEndElement();
 }
 
+void DomLocale::write(QXmlStreamWriter &writer, const QString &tagName) const
+{
+    writeXml(writer, tagName);
+}
+
+void DomLocale::write(DomXmlWriter &writer, const QString &tagName) const
+{
+    writeXml(writer, tagName);
+}
+
+void DomLocale::read(QDataStream &stream)
+{
+    stream >> m_attr_language >> m_has_attr_language;
+    stream >> m_attr_country >> m_has_attr_country;
+}
+
+void DomLocale::write(QDataStream &stream) const
+{
+    stream << m_attr_language << m_has_attr_language;
+    stream << m_attr_country << m_has_attr_country;
+}
+
 DomSizePolicy::~DomSizePolicy() = default;
 
 void DomSizePolicy::read(QXmlStreamReader &reader)
@@ -3507,22 +5162,26 @@ void DomSizePolicy::read(QXmlStreamReader &reader)
         switch (reader.readNext()) {
         case QXmlStreamReader::StartElement : {
             const auto tag = reader.name();
-            if (!tag.compare(u"hsizetype"_s, Qt::CaseInsensitive)) {
+            switch (domTag(tag)) {
+            case DomTag::HSizeType : {
                 setElementHSizeType(reader.readElementText().toInt());
                 continue;
             }
-            if (!tag.compare(u"vsizetype"_s, Qt::CaseInsensitive)) {
+            case DomTag::VSizeType : {
                 setElementVSizeType(reader.readElementText().toInt());
                 continue;
             }
-            if (!tag.compare(u"horstretch"_s, Qt::CaseInsensitive)) {
+            case DomTag::HorStretch : {
                 setElementHorStretch(reader.readElementText().toInt());
                 continue;
             }
-            if (!tag.compare(u"verstretch"_s, Qt::CaseInsensitive)) {
+            case DomTag::VerStretch : {
                 setElementVerStretch(reader.readElementText().toInt());
                 continue;
             }
+            default :
+                break;
+            }
             reader.raiseError("Unexpected element "_L1 + tag);
         }
             break;
@@ -3534,7 +5193,8 @@ void DomSizePolicy::read(QXmlStreamReader &reader)
     }
 }
 
-void DomSizePolicy::write(QXmlStreamWriter &writer, const QString &tagName) const
+template <class Writer>
+void DomSizePolicy::writeXml(Writer &writer, const QString &tagName) const
 {
     writer.writeStartElement(tagName.isEmpty() ? QStringLiteral("sizepolicy") : tagName.toLower());
 
@@ -3559,6 +5219,38 @@ void DomSizePolicy::write(QXmlStreamWriter &writer, const QString &tagName) cons
     writer.writeEndElement();
 }
 
+void DomSizePolicy::write(QXmlStreamWriter &writer, const QString &tagName) const
+{
+    writeXml(writer, tagName);
+}
+
+void DomSizePolicy::write(DomXmlWriter &writer, const QString &tagName) const
+{
+    writeXml(writer, tagName);
+}
+
+void DomSizePolicy::read(QDataStream &stream)
+{
+    stream >> m_attr_hSizeType >> m_has_attr_hSizeType;
+    stream >> m_attr_vSizeType >> m_has_attr_vSizeType;
+    stream >> m_children;
+    stream >> m_hSizeType;
+    stream >> m_vSizeType;
+    stream >> m_horStretch;
+    stream >> m_verStretch;
+}
+
+void DomSizePolicy::write(QDataStream &stream) const
+{
+    stream << m_attr_hSizeType << m_has_attr_hSizeType;
+    stream << m_attr_vSizeType << m_has_attr_vSizeType;
+    stream << m_children;
+    stream << m_hSizeType;
+    stream << m_vSizeType;
+    stream << m_horStretch;
+    stream << m_verStretch;
+}
+
 void DomSizePolicy::setElementHSizeType(int a)
 {
     m_children |= HSizeType;
@@ -3611,14 +5303,18 @@ void DomSize::read(QXmlStreamReader &reader)
         switch (reader.readNext()) {
         case QXmlStreamReader::StartElement : {
             const auto tag = reader.name();
-            if (!tag.compare(u"width"_s, Qt::CaseInsensitive)) {
+            switch (domTag(tag)) {
+            case DomTag::Width : {
                 setElementWidth(reader.readElementText().toInt());
                 continue;
             }
-            if (!tag.compare(u"height"_s, Qt::CaseInsensitive)) {
+            case DomTag::Height : {
                 setElementHeight(reader.readElementText().toInt());
                 continue;
             }
+            default :
+                break;
+            }
             reader.raiseError("Unexpected element "_L1 + tag);
         }
             break;
@@ -3630,7 +5326,8 @@ void DomSize::read(QXmlStreamReader &reader)
     }
 }
 
-void DomSize::write(QXmlStreamWriter &writer, const QString &tagName) const
+template <class Writer>
+void DomSize::writeXml(Writer &writer, const QString &tagName) const
 {
     writer.writeStartElement(tagName.isEmpty() ? QStringLiteral("size") : tagName.toLower());
 
@@ -3643,6 +5340,30 @@ void DomSize::write(QXmlStreamWriter &writer, const QString &tagName) const
     writer.writeEndElement();
 }
 
+void DomSize::write(QXmlStreamWriter &writer, const QString &tagName) const
+{
+    writeXml(writer, tagName);
+}
+
+void DomSize::write(DomXmlWriter &writer, const QString &tagName) const
+{
+    writeXml(writer, tagName);
+}
+
+void DomSize::read(QDataStream &stream)
+{
+    stream >> m_children;
+    stream >> m_width;
+    stream >> m_height;
+}
+
+void DomSize::write(QDataStream &stream) const
+{
+    stream << m_children;
+    stream << m_width;
+    stream << m_height;
+}
+
 void DomSize::setElementWidth(int a)
 {
     m_children |= Width;
@@ -3673,18 +5394,22 @@ void DomDate::read(QXmlStreamReader &reader)
         switch (reader.readNext()) {
         case QXmlStreamReader::StartElement : {
             const auto tag = reader.name();
-            if (!tag.compare(u"year"_s, Qt::CaseInsensitive)) {
+            switch (domTag(tag)) {
+            case DomTag::Year : {
                 setElementYear(reader.readElementText().toInt());
                 continue;
             }
-            if (!tag.compare(u"month"_s, Qt::CaseInsensitive)) {
+            case DomTag::Month : {
                 setElementMonth(reader.readElementText().toInt());
                 continue;
             }
-            if (!tag.compare(u"day"_s, Qt::CaseInsensitive)) {
+            case DomTag::Day : {
                 setElementDay(reader.readElementText().toInt());
                 continue;
             }
+            default :
+                break;
+            }
             reader.raiseError("Unexpected element "_L1 + tag);
         }
             break;
@@ -3696,7 +5421,8 @@ void DomDate::read(QXmlStreamReader &reader)
     }
 }
 
-void DomDate::write(QXmlStreamWriter &writer, const QString &tagName) const
+template <class Writer>
+void DomDate::writeXml(Writer &writer, const QString &tagName) const
 {
     writer.writeStartElement(tagName.isEmpty() ? QStringLiteral("date") : tagName.toLower());
 
@@ -3712,6 +5438,32 @@ void DomDate::write(QXmlStreamWriter &writer, const QString &tagName) const
     writer.writeEndElement();
 }
 
+void DomDate::write(QXmlStreamWriter &writer, const QString &tagName) const
+{
+    writeXml(writer, tagName);
+}
+
+void DomDate::write(DomXmlWriter &writer, const QString &tagName) const
+{
+    writeXml(writer, tagName);
+}
+
+void DomDate::read(QDataStream &stream)
+{
+    stream >> m_children;
+    stream >> m_year;
+    stream >> m_month;
+    stream >> m_day;
+}
+
+void DomDate::write(QDataStream &stream) const
+{
+    stream << m_children;
+    stream << m_year;
+    stream << m_month;
+    stream << m_day;
+}
+
 void DomDate::setElementYear(int a)
 {
     m_children |= Year;
@@ -3753,18 +5505,22 @@ void DomTime::read(QXmlStreamReader &reader)
         switch (reader.readNext()) {
         case QXmlStreamReader::StartElement : {
             const auto tag = reader.name();
-            if (!tag.compare(u"hour"_s, Qt::CaseInsensitive)) {
+            switch (domTag(tag)) {
+            case DomTag::Hour : {
                 setElementHour(reader.readElementText().toInt());
                 continue;
             }
-            if (!tag.compare(u"minute"_s, Qt::CaseInsensitive)) {
+            case DomTag::Minute : {
                 setElementMinute(reader.readElementText().toInt());
                 continue;
             }
-            if (!tag.compare(u"second"_s, Qt::CaseInsensitive)) {
+            case DomTag::Second : {
                 setElementSecond(reader.readElementText().toInt());
                 continue;
             }
+            default :
+                break;
+            }
             reader.raiseError("Unexpected element "_L1 + tag);
         }
             break;
@@ -3776,7 +5532,8 @@ void DomTime::read(QXmlStreamReader &reader)
     }
 }
 
-void DomTime::write(QXmlStreamWriter &writer, const QString &tagName) const
+template <class Writer>
+void DomTime::writeXml(Writer &writer, const QString &tagName) const
 {
     writer.writeStartElement(tagName.isEmpty() ? QStringLiteral("time") : tagName.toLower());
 
@@ -3792,6 +5549,32 @@ void DomTime::write(QXmlStreamWriter &writer, const QString &tagName) const
     writer.writeEndElement();
 }
 
+void DomTime::write(QXmlStreamWriter &writer, const QString &tagName) const
+{
+    writeXml(writer, tagName);
+}
+
+void DomTime::write(DomXmlWriter &writer, const QString &tagName) const
+{
+    writeXml(writer, tagName);
+}
+
+void DomTime::read(QDataStream &stream)
+{
+    stream >> m_children;
+    stream >> m_hour;
+    stream >> m_minute;
+    stream >> m_second;
+}
+
+void DomTime::write(QDataStream &stream) const
+{
+    stream << m_children;
+    stream << m_hour;
+    stream << m_minute;
+    stream << m_second;
+}
+
 void DomTime::setElementHour(int a)
 {
     m_children |= Hour;
@@ -3833,30 +5616,34 @@ void DomDateTime::read(QXmlStreamReader &reader)
         switch (reader.readNext()) {
         case QXmlStreamReader::StartElement : {
             const auto tag = reader.name();
-            if (!tag.compare(u"hour"_s, Qt::CaseInsensitive)) {
+            switch (domTag(tag)) {
+            case DomTag::Hour : {
                 setElementHour(reader.readElementText().toInt());
                 continue;
             }
-            if (!tag.compare(u"minute"_s, Qt::CaseInsensitive)) {
+            case DomTag::Minute : {
                 setElementMinute(reader.readElementText().toInt());
                 continue;
             }
-            if (!tag.compare(u"second"_s, Qt::CaseInsensitive)) {
+            case DomTag::Second : {
                 setElementSecond(reader.readElementText().toInt());
                 continue;
             }
-            if (!tag.compare(u"year"_s, Qt::CaseInsensitive)) {
+            case DomTag::Year : {
                 setElementYear(reader.readElementText().toInt());
                 continue;
             }
-            if (!tag.compare(u"month"_s, Qt::CaseInsensitive)) {
+            case DomTag::Month : {
                 setElementMonth(reader.readElementText().toInt());
                 continue;
             }
-            if (!tag.compare(u"day"_s, Qt::CaseInsensitive)) {
+            case DomTag::Day : {
                 setElementDay(reader.readElementText().toInt());
                 continue;
             }
+            default :
+                break;
+            }
             reader.raiseError("Unexpected element "_L1 + tag);
         }
             break;
@@ -3868,7 +5655,8 @@ void DomDateTime::read(QXmlStreamReader &reader)
     }
 }
 
-void DomDateTime::write(QXmlStreamWriter &writer, const QString &tagName) const
+template <class Writer>
+void DomDateTime::writeXml(Writer &writer, const QString &tagName) const
 {
     writer.writeStartElement(tagName.isEmpty() ? QStringLiteral("datetime") : tagName.toLower());
 
@@ -3893,6 +5681,38 @@ void DomDateTime::write(QXmlStreamWriter &writer, const QString &tagName) const
     writer.writeEndElement();
 }
 
+void DomDateTime::write(QXmlStreamWriter &writer, const QString &tagName) const
+{
+    writeXml(writer, tagName);
+}
+
+void DomDateTime::write(DomXmlWriter &writer, const QString &tagName) const
+{
+    writeXml(writer, tagName);
+}
+
+void DomDateTime::read(QDataStream &stream)
+{
+    stream >> m_children;
+    stream >> m_hour;
+    stream >> m_minute;
+    stream >> m_second;
+    stream >> m_year;
+    stream >> m_month;
+    stream >> m_day;
+}
+
+void DomDateTime::write(QDataStream &stream) const
+{
+    stream << m_children;
+    stream << m_hour;
+    stream << m_minute;
+    stream << m_second;
+    stream << m_year;
+    stream << m_month;
+    stream << m_day;
+}
+
 void DomDateTime::setElementHour(int a)
 {
     m_children |= Hour;
@@ -3992,10 +5812,14 @@ void DomStringList::read(QXmlStreamReader &reader)
         switch (reader.readNext()) {
         case QXmlStreamReader::StartElement : {
             const auto tag = reader.name();
-            if (!tag.compare(u"string"_s, Qt::CaseInsensitive)) {
+            switch (domTag(tag)) {
+            case DomTag::String : {
                 m_string.append(reader.readElementText());
                 continue;
             }
+            default :
+                break;
+            }
             reader.raiseError("Unexpected element "_L1 + tag);
         }
             break;
@@ -4007,7 +5831,8 @@ void DomStringList::read(QXmlStreamReader &reader)
     }
 }
 
-void DomStringList::write(QXmlStreamWriter &writer, const QString &tagName) const
+template <class Writer>
+void DomStringList::writeXml(Writer &writer, const QString &tagName) const
 {
     writer.writeStartElement(tagName.isEmpty() ? QStringLiteral("stringlist") : tagName.toLower());
 
@@ -4029,6 +5854,36 @@ void DomStringList::write(QXmlStreamWriter &writer, const QString &tagName) cons
     writer.writeEndElement();
 }
 
+void DomStringList::write(QXmlStreamWriter &writer, const QString &tagName) const
+{
+    writeXml(writer, tagName);
+}
+
+void DomStringList::write(DomXmlWriter &writer, const QString &tagName) const
+{
+    writeXml(writer, tagName);
+}
+
+void DomStringList::read(QDataStream &stream)
+{
+    stream >> m_attr_notr >> m_has_attr_notr;
+    stream >> m_attr_comment >> m_has_attr_comment;
+    stream >> m_attr_extraComment >> m_has_attr_extraComment;
+    stream >> m_attr_id >> m_has_attr_id;
+    stream >> m_children;
+    stream >> m_string;
+}
+
+void DomStringList::write(QDataStream &stream) const
+{
+    stream << m_attr_notr << m_has_attr_notr;
+    stream << m_attr_comment << m_has_attr_comment;
+    stream << m_attr_extraComment << m_has_attr_extraComment;
+    stream << m_attr_id << m_has_attr_id;
+    stream << m_children;
+    stream << m_string;
+}
+
 void DomStringList::setElementString(const QStringList &a)
 {
     m_children |= String;
@@ -4072,7 +5927,8 @@ void DomResourcePixmap::read(QXmlStreamReader &reader)
     }
 }
 
-void DomResourcePixmap::write(QXmlStreamWriter &writer, const QString &tagName) const
+template <class Writer>
+void DomResourcePixmap::writeXml(Writer &writer, const QString &tagName) const
 {
     writer.writeStartElement(tagName.isEmpty() ? QStringLiteral("resourcepixmap") : tagName.toLower());
 
@@ -4088,6 +5944,30 @@ void DomResourcePixmap::write(QXmlStreamWriter &writer, const QString &tagName)
     writer.writeEndElement();
 }
 
+void DomResourcePixmap::write(QXmlStreamWriter &writer, const QString &tagName) const
+{
+    writeXml(writer, tagName);
+}
+
+void DomResourcePixmap::write(DomXmlWriter &writer, const QString &tagName) const
+{
+    writeXml(writer, tagName);
+}
+
+void DomResourcePixmap::read(QDataStream &stream)
+{
+    stream >> m_attr_resource >> m_has_attr_resource;
+    stream >> m_attr_alias >> m_has_attr_alias;
+    stream >> m_text;
+}
+
+void DomResourcePixmap::write(QDataStream &stream) const
+{
+    stream << m_attr_resource << m_has_attr_resource;
+    stream << m_attr_alias << m_has_attr_alias;
+    stream << m_text;
+}
+
 DomResourceIcon::~DomResourceIcon()
 {
     delete m_normalOff;
@@ -4120,54 +6000,58 @@ void DomResourceIcon::read(QXmlStreamReader &reader)
         switch (reader.readNext()) {
         case QXmlStreamReader::StartElement : {
             const auto tag = reader.name();
-            if (!tag.compare(u"normaloff"_s, Qt::CaseInsensitive)) {
+            switch (domTag(tag)) {
+            case DomTag::NormalOff : {
                 auto *v = new DomResourcePixmap();
                 v->read(reader);
                 setElementNormalOff(v);
                 continue;
             }
-            if (!tag.compare(u"normalon"_s, Qt::CaseInsensitive)) {
+            case DomTag::NormalOn : {
                 auto *v = new DomResourcePixmap();
                 v->read(reader);
                 setElementNormalOn(v);
                 continue;
             }
-            if (!tag.compare(u"disabledoff"_s, Qt::CaseInsensitive)) {
+            case DomTag::DisabledOff : {
                 auto *v = new DomResourcePixmap();
                 v->read(reader);
                 setElementDisabledOff(v);
                 continue;
             }
-            if (!tag.compare(u"disabledon"_s, Qt::CaseInsensitive)) {
+            case DomTag::DisabledOn : {
                 auto *v = new DomResourcePixmap();
                 v->read(reader);
                 setElementDisabledOn(v);
                 continue;
             }
-            if (!tag.compare(u"activeoff"_s, Qt::CaseInsensitive)) {
+            case DomTag::ActiveOff : {
                 auto *v = new DomResourcePixmap();
                 v->read(reader);
                 setElementActiveOff(v);
                 continue;
             }
-            if (!tag.compare(u"activeon"_s, Qt::CaseInsensitive)) {
+            case DomTag::ActiveOn : {
                 auto *v = new DomResourcePixmap();
                 v->read(reader);
                 setElementActiveOn(v);
                 continue;
             }
-            if (!tag.compare(u"selectedoff"_s, Qt::CaseInsensitive)) {
+            case DomTag::SelectedOff : {
                 auto *v = new DomResourcePixmap();
                 v->read(reader);
                 setElementSelectedOff(v);
                 continue;
             }
-            if (!tag.compare(u"selectedon"_s, Qt::CaseInsensitive)) {
+            case DomTag::SelectedOn : {
                 auto *v = new DomResourcePixmap();
                 v->read(reader);
                 setElementSelectedOn(v);
                 continue;
             }
+            default :
+                break;
+            }
             reader.raiseError("Unexpected element "_L1 + tag);
         }
             break;
@@ -4183,7 +6067,8 @@ void DomResourceIcon::read(QXmlStreamReader &reader)
     }
 }
 
-void DomResourceIcon::write(QXmlStreamWriter &writer, const QString &tagName) const
+template <class Writer>
+void DomResourceIcon::writeXml(Writer &writer, const QString &tagName) const
 {
     writer.writeStartElement(tagName.isEmpty() ? QStringLiteral("resourceicon") : tagName.toLower());
 
@@ -4223,6 +6108,48 @@ void DomResourceIcon::write(QXmlStreamWriter &writer, const QString &tagName) co
     writer.writeEndElement();
 }
 
+void DomResourceIcon::write(QXmlStreamWriter &writer, const QString &tagName) const
+{
+    writeXml(writer, tagName);
+}
+
+void DomResourceIcon::write(DomXmlWriter &writer, const QString &tagName) const
+{
+    writeXml(writer, tagName);
+}
+
+void DomResourceIcon::read(QDataStream &stream)
+{
+    stream >> m_attr_theme >> m_has_attr_theme;
+    stream >> m_attr_resource >> m_has_attr_resource;
+    stream >> m_text;
+    stream >> m_children;
+    readDomPointer(stream, m_normalOff);
+    readDomPointer(stream, m_normalOn);
+    readDomPointer(stream, m_disabledOff);
+    readDomPointer(stream, m_disabledOn);
+    readDomPointer(stream, m_activeOff);
+    readDomPointer(stream, m_activeOn);
+    readDomPointer(stream, m_selectedOff);
+    readDomPointer(stream, m_selectedOn);
+}
+
+void DomResourceIcon::write(QDataStream &stream) const
+{
+    stream << m_attr_theme << m_has_attr_theme;
+    stream << m_attr_resource << m_has_attr_resource;
+    stream << m_text;
+    stream << m_children;
+    writeDomPointer(stream, m_normalOff);
+    writeDomPointer(stream, m_normalOn);
+    writeDomPointer(stream, m_disabledOff);
+    writeDomPointer(stream, m_disabledOn);
+    writeDomPointer(stream, m_activeOff);
+    writeDomPointer(stream, m_activeOn);
+    writeDomPointer(stream, m_selectedOff);
+    writeDomPointer(stream, m_selectedOn);
+}
+
 DomResourcePixmap *DomResourceIcon::takeElementNormalOff()
 {
     DomResourcePixmap *a = m_normalOff;
@@ -4444,7 +6371,8 @@ void DomString::read(QXmlStreamReader &reader)
     }
 }
 
-void DomString::write(QXmlStreamWriter &writer, const QString &tagName) const
+template <class Writer>
+void DomString::writeXml(Writer &writer, const QString &tagName) const
 {
     writer.writeStartElement(tagName.isEmpty() ? QStringLiteral("string") : tagName.toLower());
 
@@ -4466,6 +6394,34 @@ void DomString::write(QXmlStreamWriter &writer, const QString &tagName) const
     writer.writeEndElement();
 }
 
+void DomString::write(QXmlStreamWriter &writer, const QString &tagName) const
+{
+    writeXml(writer, tagName);
+}
+
+void DomString::write(DomXmlWriter &writer, const QString &tagName) const
+{
+    writeXml(writer, tagName);
+}
+
+void DomString::read(QDataStream &stream)
+{
+    stream >> m_attr_notr >> m_has_attr_notr;
+    stream >> m_attr_comment >> m_has_attr_comment;
+    stream >> m_attr_extraComment >> m_has_attr_extraComment;
+    stream >> m_attr_id >> m_has_attr_id;
+    stream >> m_text;
+}
+
+void DomString::write(QDataStream &stream) const
+{
+    stream << m_attr_notr << m_has_attr_notr;
+    stream << m_attr_comment << m_has_attr_comment;
+    stream << m_attr_extraComment << m_has_attr_extraComment;
+    stream << m_attr_id << m_has_attr_id;
+    stream << m_text;
+}
+
 DomPointF::~DomPointF() = default;
 
 void DomPointF::read(QXmlStreamReader &reader)
@@ -4474,14 +6430,18 @@ void DomPointF::read(QXmlStreamReader &reader)
         switch (reader.readNext()) {
         case QXmlStreamReader::StartElement : {
             const auto tag = reader.name();
-            if (!tag.compare(u"x"_s, Qt::CaseInsensitive)) {
+            switch (domTag(tag)) {
+            case DomTag::X : {
                 setElementX(reader.readElementText().toDouble());
                 continue;
             }
-            if (!tag.compare(u"y"_s, Qt::CaseInsensitive)) {
+            case DomTag::Y : {
                 setElementY(reader.readElementText().toDouble());
                 continue;
             }
+            default :
+                break;
+            }
             reader.raiseError("Unexpected element "_L1 + tag);
         }
             break;
@@ -4493,7 +6453,8 @@ void DomPointF::read(QXmlStreamReader &reader)
     }
 }
 
-void DomPointF::write(QXmlStreamWriter &writer, const QString &tagName) const
+template <class Writer>
+void DomPointF::writeXml(Writer &writer, const QString &tagName) const
 {
     writer.writeStartElement(tagName.isEmpty() ? QStringLiteral("pointf") : tagName.toLower());
 
@@ -4506,6 +6467,30 @@ void DomPointF::write(QXmlStreamWriter &writer, const QString &tagName) const
     writer.writeEndElement();
 }
 
+void DomPointF::write(QXmlStreamWriter &writer, const QString &tagName) const
+{
+    writeXml(writer, tagName);
+}
+
+void DomPointF::write(DomXmlWriter &writer, const QString &tagName) const
+{
+    writeXml(writer, tagName);
+}
+
+void DomPointF::read(QDataStream &stream)
+{
+    stream >> m_children;
+    stream >> m_x;
+    stream >> m_y;
+}
+
+void DomPointF::write(QDataStream &stream) const
+{
+    stream << m_children;
+    stream << m_x;
+    stream << m_y;
+}
+
 void DomPointF::setElementX(double a)
 {
     m_children |= X;
@@ -4536,22 +6521,26 @@ void DomRectF::read(QXmlStreamReader &reader)
         switch (reader.readNext()) {
         case QXmlStreamReader::StartElement : {
             const auto tag = reader.name();
-            if (!tag.compare(u"x"_s, Qt::CaseInsensitive)) {
+            switch (domTag(tag)) {
+            case DomTag::X : {
                 setElementX(reader.readElementText().toDouble());
                 continue;
             }
-            if (!tag.compare(u"y"_s, Qt::CaseInsensitive)) {
+            case DomTag::Y : {
                 setElementY(reader.readElementText().toDouble());
                 continue;
             }
-            if (!tag.compare(u"width"_s, Qt::CaseInsensitive)) {
+            case DomTag::Width : {
                 setElementWidth(reader.readElementText().toDouble());
                 continue;
             }
-            if (!tag.compare(u"height"_s, Qt::CaseInsensitive)) {
+            case DomTag::Height : {
                 setElementHeight(reader.readElementText().toDouble());
                 continue;
             }
+            default :
+                break;
+            }
             reader.raiseError("Unexpected element "_L1 + tag);
         }
             break;
@@ -4563,7 +6552,8 @@ void DomRectF::read(QXmlStreamReader &reader)
     }
 }
 
-void DomRectF::write(QXmlStreamWriter &writer, const QString &tagName) const
+template <class Writer>
+void DomRectF::writeXml(Writer &writer, const QString &tagName) const
 {
     writer.writeStartElement(tagName.isEmpty() ? QStringLiteral("rectf") : tagName.toLower());
 
@@ -4582,6 +6572,34 @@ void DomRectF::write(QXmlStreamWriter &writer, const QString &tagName) const
     writer.writeEndElement();
 }
 
+void DomRectF::write(QXmlStreamWriter &writer, const QString &tagName) const
+{
+    writeXml(writer, tagName);
+}
+
+void DomRectF::write(DomXmlWriter &writer, const QString &tagName) const
+{
+    writeXml(writer, tagName);
+}
+
+void DomRectF::read(QDataStream &stream)
+{
+    stream >> m_children;
+    stream >> m_x;
+    stream >> m_y;
+    stream >> m_width;
+    stream >> m_height;
+}
+
+void DomRectF::write(QDataStream &stream) const
+{
+    stream << m_children;
+    stream << m_x;
+    stream << m_y;
+    stream << m_width;
+    stream << m_height;
+}
+
 void DomRectF::setElementX(double a)
 {
     m_children |= X;
@@ -4634,14 +6652,18 @@ void DomSizeF::read(QXmlStreamReader &reader)
         switch (reader.readNext()) {
         case QXmlStreamReader::StartElement : {
             const auto tag = reader.name();
-            if (!tag.compare(u"width"_s, Qt::CaseInsensitive)) {
+            switch (domTag(tag)) {
+            case DomTag::Width : {
                 setElementWidth(reader.readElementText().toDouble());
                 continue;
             }
-            if (!tag.compare(u"height"_s, Qt::CaseInsensitive)) {
+            case DomTag::Height : {
                 setElementHeight(reader.readElementText().toDouble());
                 continue;
             }
+            default :
+                break;
+            }
             reader.raiseError("Unexpected element "_L1 + tag);
         }
             break;
@@ -4653,7 +6675,8 @@ void DomSizeF::read(QXmlStreamReader &reader)
     }
 }
 
-void DomSizeF::write(QXmlStreamWriter &writer, const QString &tagName) const
+template <class Writer>
+void DomSizeF::writeXml(Writer &writer, const QString &tagName) const
 {
     writer.writeStartElement(tagName.isEmpty() ? QStringLiteral("sizef") : tagName.toLower());
 
@@ -4666,6 +6689,30 @@ void DomSizeF::write(QXmlStreamWriter &writer, const QString &tagName) const
     writer.writeEndElement();
 }
 
+void DomSizeF::write(QXmlStreamWriter &writer, const QString &tagName) const
+{
+    writeXml(writer, tagName);
+}
+
+void DomSizeF::write(DomXmlWriter &writer, const QString &tagName) const
+{
+    writeXml(writer, tagName);
+}
+
+void DomSizeF::read(QDataStream &stream)
+{
+    stream >> m_children;
+    stream >> m_width;
+    stream >> m_height;
+}
+
+void DomSizeF::write(QDataStream &stream) const
+{
+    stream << m_children;
+    stream << m_width;
+    stream << m_height;
+}
+
 void DomSizeF::setElementWidth(double a)
 {
     m_children |= Width;
@@ -4696,10 +6743,14 @@ void DomChar::read(QXmlStreamReader &reader)
         switch (reader.readNext()) {
         case QXmlStreamReader::StartElement : {
             const auto tag = reader.name();
-            if (!tag.compare(u"unicode"_s, Qt::CaseInsensitive)) {
+            switch (domTag(tag)) {
+            case DomTag::Unicode : {
                 setElementUnicode(reader.readElementText().toInt());
                 continue;
             }
+            default :
+                break;
+            }
             reader.raiseError("Unexpected element "_L1 + tag);
         }
             break;
@@ -4711,7 +6762,8 @@ void DomChar::read(QXmlStreamReader &reader)
     }
 }
 
-void DomChar::write(QXmlStreamWriter &writer, const QString &tagName) const
+template <class Writer>
+void DomChar::writeXml(Writer &writer, const QString &tagName) const
 {
     writer.writeStartElement(tagName.isEmpty() ? QStringLiteral("char") : tagName.toLower());
 
@@ -4721,6 +6773,28 @@ void DomChar::write(QXmlStreamWriter &writer, const QString &tagName) const
     writer.writeEndElement();
 }
 
+void DomChar::write(QXmlStreamWriter &writer, const QString &tagName) const
+{
+    writeXml(writer, tagName);
+}
+
+void DomChar::write(DomXmlWriter &writer, const QString &tagName) const
+{
+    writeXml(writer, tagName);
+}
+
+void DomChar::read(QDataStream &stream)
+{
+    stream >> m_children;
+    stream >> m_unicode;
+}
+
+void DomChar::write(QDataStream &stream) const
+{
+    stream << m_children;
+    stream << m_unicode;
+}
+
 void DomChar::setElementUnicode(int a)
 {
     m_children |= Unicode;
@@ -4743,12 +6817,16 @@ void DomUrl::read(QXmlStreamReader &reader)
         switch (reader.readNext()) {
         case QXmlStreamReader::StartElement : {
             const auto tag = reader.name();
-            if (!tag.compare(u"string"_s, Qt::CaseInsensitive)) {
+            switch (domTag(tag)) {
+            case DomTag::String : {
                 auto *v = new DomString();
                 v->read(reader);
                 setElementString(v);
                 continue;
             }
+            default :
+                break;
+            }
             reader.raiseError("Unexpected element "_L1 + tag);
         }
             break;
@@ -4760,7 +6838,8 @@ void DomUrl::read(QXmlStreamReader &reader)
     }
 }
 
-void DomUrl::write(QXmlStreamWriter &writer, const QString &tagName) const
+template <class Writer>
+void DomUrl::writeXml(Writer &writer, const QString &tagName) const
 {
     writer.writeStartElement(tagName.isEmpty() ? QStringLiteral("url") : tagName.toLower());
 
@@ -4770,6 +6849,28 @@ void DomUrl::write(QXmlStreamWriter &writer, const QString &tagName) const
     writer.writeEndElement();
 }
 
+void DomUrl::write(QXmlStreamWriter &writer, const QString &tagName) const
+{
+    writeXml(writer, tagName);
+}
+
+void DomUrl::write(DomXmlWriter &writer, const QString &tagName) const
+{
+    writeXml(writer, tagName);
+}
+
+void DomUrl::read(QDataStream &stream)
+{
+    stream >> m_children;
+    readDomPointer(stream, m_string);
+}
+
+void DomUrl::write(QDataStream &stream) const
+{
+    stream << m_children;
+    writeDomPointer(stream, m_string);
+}
+
 DomString *DomUrl::takeElementString()
 {
     DomString *a = m_string;
@@ -4893,180 +6994,184 @@ void DomProperty::read(QXmlStreamReader &reader)
         switch (reader.readNext()) {
         case QXmlStreamReader::StartElement : {
             const auto tag = reader.name();
-            if (!tag.compare(u"bool"_s, Qt::CaseInsensitive)) {
+            switch (domTag(tag)) {
+            case DomTag::Bool : {
                 setElementBool(reader.readElementText());
                 continue;
             }
-            if (!tag.compare(u"color"_s, Qt::CaseInsensitive)) {
+            case DomTag::Color : {
                 auto *v = new DomColor();
                 v->read(reader);
                 setElementColor(v);
                 continue;
             }
-            if (!tag.compare(u"cstring"_s, Qt::CaseInsensitive)) {
+            case DomTag::Cstring : {
                 setElementCstring(reader.readElementText());
                 continue;
             }
-            if (!tag.compare(u"cursor"_s, Qt::CaseInsensitive)) {
+            case DomTag::Cursor : {
                 setElementCursor(reader.readElementText().toInt());
                 continue;
             }
-            if (!tag.compare(u"cursorshape"_s, Qt::CaseInsensitive)) {
+            case DomTag::CursorShape : {
                 setElementCursorShape(reader.readElementText());
                 continue;
             }
-            if (!tag.compare(u"enum"_s, Qt::CaseInsensitive)) {
+            case DomTag::Enum : {
                 setElementEnum(reader.readElementText());
                 continue;
             }
-            if (!tag.compare(u"font"_s, Qt::CaseInsensitive)) {
+            case DomTag::Font : {
                 auto *v = new DomFont();
                 v->read(reader);
                 setElementFont(v);
                 continue;
             }
-            if (!tag.compare(u"iconset"_s, Qt::CaseInsensitive)) {
+            case DomTag::IconSet : {
                 auto *v = new DomResourceIcon();
                 v->read(reader);
                 setElementIconSet(v);
                 continue;
             }
-            if (!tag.compare(u"pixmap"_s, Qt::CaseInsensitive)) {
+            case DomTag::Pixmap : {
                 auto *v = new DomResourcePixmap();
                 v->read(reader);
                 setElementPixmap(v);
                 continue;
             }
-            if (!tag.compare(u"palette"_s, Qt::CaseInsensitive)) {
+            case DomTag::Palette : {
                 auto *v = new DomPalette();
                 v->read(reader);
                 setElementPalette(v);
                 continue;
             }
-            if (!tag.compare(u"point"_s, Qt::CaseInsensitive)) {
+            case DomTag::Point : {
                 auto *v = new DomPoint();
                 v->read(reader);
                 setElementPoint(v);
                 continue;
             }
-            if (!tag.compare(u"rect"_s, Qt::CaseInsensitive)) {
+            case DomTag::Rect : {
                 auto *v = new DomRect();
                 v->read(reader);
                 setElementRect(v);
                 continue;
             }
-            if (!tag.compare(u"set"_s, Qt::CaseInsensitive)) {
+            case DomTag::Set : {
                 setElementSet(reader.readElementText());
                 continue;
             }
-            if (!tag.compare(u"locale"_s, Qt::CaseInsensitive)) {
+            case DomTag::Locale : {
                 auto *v = new DomLocale();
                 v->read(reader);
                 setElementLocale(v);
                 continue;
             }
-            if (!tag.compare(u"sizepolicy"_s, Qt::CaseInsensitive)) {
+            case DomTag::SizePolicy : {
                 auto *v = new DomSizePolicy();
                 v->read(reader);
                 setElementSizePolicy(v);
                 continue;
             }
-            if (!tag.compare(u"size"_s, Qt::CaseInsensitive)) {
+            case DomTag::Size : {
                 auto *v = new DomSize();
                 v->read(reader);
                 setElementSize(v);
                 continue;
             }
-            if (!tag.compare(u"string"_s, Qt::CaseInsensitive)) {
+            case DomTag::String : {
                 auto *v = new DomString();
                 v->read(reader);
                 setElementString(v);
                 continue;
             }
-            if (!tag.compare(u"stringlist"_s, Qt::CaseInsensitive)) {
+            case DomTag::StringList : {
                 auto *v = new DomStringList();
                 v->read(reader);
                 setElementStringList(v);
                 continue;
             }
-            if (!tag.compare(u"number"_s, Qt::CaseInsensitive)) {
+            case DomTag::Number : {
                 setElementNumber(reader.readElementText().toInt());
                 continue;
             }
-            if (!tag.compare(u"float"_s, Qt::CaseInsensitive)) {
+            case DomTag::Float : {
                 setElementFloat(reader.readElementText().toFloat());
                 continue;
             }
-            if (!tag.compare(u"double"_s, Qt::CaseInsensitive)) {
+            case DomTag::Double : {
                 setElementDouble(reader.readElementText().toDouble());
                 continue;
             }
-            if (!tag.compare(u"date"_s, Qt::CaseInsensitive)) {
+            case DomTag::Date : {
                 auto *v = new DomDate();
                 v->read(reader);
                 setElementDate(v);
                 continue;
             }
-            if (!tag.compare(u"time"_s, Qt::CaseInsensitive)) {
+            case DomTag::Time : {
                 auto *v = new DomTime();
                 v->read(reader);
                 setElementTime(v);
                 continue;
             }
-            if (!tag.compare(u"datetime"_s, Qt::CaseInsensitive)) {
+            case DomTag::DateTime : {
                 auto *v = new DomDateTime();
                 v->read(reader);
                 setElementDateTime(v);
                 continue;
             }
-            if (!tag.compare(u"pointf"_s, Qt::CaseInsensitive)) {
+            case DomTag::PointF : {
                 auto *v = new DomPointF();
                 v->read(reader);
                 setElementPointF(v);
                 continue;
             }
-            if (!tag.compare(u"rectf"_s, Qt::CaseInsensitive)) {
+            case DomTag::RectF : {
                 auto *v = new DomRectF();
                 v->read(reader);
                 setElementRectF(v);
                 continue;
             }
-            if (!tag.compare(u"sizef"_s, Qt::CaseInsensitive)) {
+            case DomTag::SizeF : {
                 auto *v = new DomSizeF();
                 v->read(reader);
                 setElementSizeF(v);
                 continue;
             }
-            if (!tag.compare(u"longlong"_s, Qt::CaseInsensitive)) {
+            case DomTag::LongLong : {
                 setElementLongLong(reader.readElementText().toLongLong());
                 continue;
             }
-            if (!tag.compare(u"char"_s, Qt::CaseInsensitive)) {
+            case DomTag::Char : {
                 auto *v = new DomChar();
                 v->read(reader);
                 setElementChar(v);
                 continue;
             }
-            if (!tag.compare(u"url"_s, Qt::CaseInsensitive)) {
+            case DomTag::Url : {
                 auto *v = new DomUrl();
                 v->read(reader);
                 setElementUrl(v);
                 continue;
             }
-            if (!tag.compare(u"uint"_s, Qt::CaseInsensitive)) {
+            case DomTag::UInt : {
                 setElementUInt(reader.readElementText().toUInt());
                 continue;
             }
-            if (!tag.compare(u"ulonglong"_s, Qt::CaseInsensitive)) {
+            case DomTag::ULongLong : {
                 setElementULongLong(reader.readElementText().toULongLong());
                 continue;
             }
-            if (!tag.compare(u"brush"_s, Qt::CaseInsensitive)) {
+            case DomTag::Brush : {
                 auto *v = new DomBrush();
                 v->read(reader);
                 setElementBrush(v);
                 continue;
             }
+            default :
+                break;
+            }
             reader.raiseError("Unexpected element "_L1 + tag);
         }
             break;
@@ -5078,7 +7183,8 @@ void DomProperty::read(QXmlStreamReader &reader)
     }
 }
 
-void DomProperty::write(QXmlStreamWriter &writer, const QString &tagName) const
+template <class Writer>
+void DomProperty::writeXml(Writer &writer, const QString &tagName) const
 {
     writer.writeStartElement(tagName.isEmpty() ? QStringLiteral("property") : tagName.toLower());
 
@@ -5248,6 +7354,98 @@ void DomProperty::write(QXmlStreamWriter &writer, const QString &tagName) const
     writer.writeEndElement();
 }
 
+void DomProperty::write(QXmlStreamWriter &writer, const QString &tagName) const
+{
+    writeXml(writer, tagName);
+}
+
+void DomProperty::write(DomXmlWriter &writer, const QString &tagName) const
+{
+    writeXml(writer, tagName);
+}
+
+void DomProperty::read(QDataStream &stream)
+{
+    int kind = Unknown;
+    stream >> kind;
+    m_kind = Kind(kind);
+    stream >> m_attr_name >> m_has_attr_name;
+    stream >> m_attr_stdset >> m_has_attr_stdset;
+    stream >> m_bool;
+    readDomPointer(stream, m_color);
+    stream >> m_cstring;
+    stream >> m_cursor;
+    stream >> m_cursorShape;
+    stream >> m_enum;
+    readDomPointer(stream, m_font);
+    readDomPointer(stream, m_iconSet);
+    readDomPointer(stream, m_pixmap);
+    readDomPointer(stream, m_palette);
+    readDomPointer(stream, m_point);
+    readDomPointer(stream, m_rect);
+    stream >> m_set;
+    readDomPointer(stream, m_locale);
+    readDomPointer(stream, m_sizePolicy);
+    readDomPointer(stream, m_size);
+    readDomPointer(stream, m_string);
+    readDomPointer(stream, m_stringList);
+    stream >> m_number;
+    stream >> m_float;
+    stream >> m_double;
+    readDomPointer(stream, m_date);
+    readDomPointer(stream, m_time);
+    readDomPointer(stream, m_dateTime);
+    readDomPointer(stream, m_pointF);
+    readDomPointer(stream, m_rectF);
+    readDomPointer(stream, m_sizeF);
+    stream >> m_longLong;
+    readDomPointer(stream, m_char);
+    readDomPointer(stream, m_url);
+    stream >> m_UInt;
+    stream >> m_uLongLong;
+    readDomPointer(stream, m_brush);
+}
+
+void DomProperty::write(QDataStream &stream) const
+{
+    stream << int(m_kind);
+    stream << m_attr_name << m_has_attr_name;
+    stream << m_attr_stdset << m_has_attr_stdset;
+    stream << m_bool;
+    writeDomPointer(stream, m_color);
+    stream << m_cstring;
+    stream << m_cursor;
+    stream << m_cursorShape;
+    stream << m_enum;
+    writeDomPointer(stream, m_font);
+    writeDomPointer(stream, m_iconSet);
+    writeDomPointer(stream, m_pixmap);
+    writeDomPointer(stream, m_palette);
+    writeDomPointer(stream, m_point);
+    writeDomPointer(stream, m_rect);
+    stream << m_set;
+    writeDomPointer(stream, m_locale);
+    writeDomPointer(stream, m_sizePolicy);
+    writeDomPointer(stream, m_size);
+    writeDomPointer(stream, m_string);
+    writeDomPointer(stream, m_stringList);
+    stream << m_number;
+    stream << m_float;
+    stream << m_double;
+    writeDomPointer(stream, m_date);
+    writeDomPointer(stream, m_time);
+    writeDomPointer(stream, m_dateTime);
+    writeDomPointer(stream, m_pointF);
+    writeDomPointer(stream, m_rectF);
+    writeDomPointer(stream, m_sizeF);
+    stream << m_longLong;
+    writeDomPointer(stream, m_char);
+    writeDomPointer(stream, m_url);
+    stream << m_UInt;
+    stream << m_uLongLong;
+    writeDomPointer(stream, m_brush);
+}
+
 void DomProperty::setElementBool(const QString &a)
 {
     clear();
@@ -5638,12 +7836,16 @@ void DomConnections::read(QXmlStreamReader &reader)
         switch (reader.readNext()) {
         case QXmlStreamReader::StartElement : {
             const auto tag = reader.name();
-            if (!tag.compare(u"connection"_s, Qt::CaseInsensitive)) {
+            switch (domTag(tag)) {
+            case DomTag::Connection : {
                 auto *v = new DomConnection();
                 v->read(reader);
                 m_connection.append(v);
                 continue;
             }
+            default :
+                break;
+            }
             reader.raiseError("Unexpected element "_L1 + tag);
         }
             break;
@@ -5655,7 +7857,8 @@ void DomConnections::read(QXmlStreamReader &reader)
     }
 }
 
-void DomConnections::write(QXmlStreamWriter &writer, const QString &tagName) const
+template <class Writer>
+void DomConnections::writeXml(Writer &writer, const QString &tagName) const
 {
     writer.writeStartElement(tagName.isEmpty() ? QStringLiteral("connections") : tagName.toLower());
 
@@ -5665,6 +7868,28 @@ void DomConnections::write(QXmlStreamWriter &writer, const QString &tagName) con
     writer.writeEndElement();
 }
 
+void DomConnections::write(QXmlStreamWriter &writer, const QString &tagName) const
+{
+    writeXml(writer, tagName);
+}
+
+void DomConnections::write(DomXmlWriter &writer, const QString &tagName) const
+{
+    writeXml(writer, tagName);
+}
+
+void DomConnections::read(QDataStream &stream)
+{
+    stream >> m_children;
+    readDomList(stream, m_connection);
+}
+
+void DomConnections::write(QDataStream &stream) const
+{
+    stream << m_children;
+    writeDomList(stream, m_connection);
+}
+
 void DomConnections::setElementConnection(const QList<DomConnection *> &a)
 {
     m_children |= Connection;
@@ -5682,28 +7907,32 @@ void DomConnection::read(QXmlStreamReader &reader)
         switch (reader.readNext()) {
         case QXmlStreamReader::StartElement : {
             const auto tag = reader.name();
-            if (!tag.compare(u"sender"_s, Qt::CaseInsensitive)) {
+            switch (domTag(tag)) {
+            case DomTag::Sender : {
                 setElementSender(reader.readElementText());
                 continue;
             }
-            if (!tag.compare(u"signal"_s, Qt::CaseInsensitive)) {
+            case DomTag::Signal : {
                 setElementSignal(reader.readElementText());
                 continue;
             }
-            if (!tag.compare(u"receiver"_s, Qt::CaseInsensitive)) {
+            case DomTag::Receiver : {
                 setElementReceiver(reader.readElementText());
                 continue;
             }
-            if (!tag.compare(u"slot"_s, Qt::CaseInsensitive)) {
+            case DomTag::Slot : {
                 setElementSlot(reader.readElementText());
                 continue;
             }
-            if (!tag.compare(u"hints"_s, Qt::CaseInsensitive)) {
+            case DomTag::Hints : {
                 auto *v = new DomConnectionHints();
                 v->read(reader);
                 setElementHints(v);
                 continue;
             }
+            default :
+                break;
+            }
             reader.raiseError("Unexpected element "_L1 + tag);
         }
             break;
@@ -5715,7 +7944,8 @@ void DomConnection::read(QXmlStreamReader &reader)
     }
 }
 
-void DomConnection::write(QXmlStreamWriter &writer, const QString &tagName) const
+template <class Writer>
+void DomConnection::writeXml(Writer &writer, const QString &tagName) const
 {
     writer.writeStartElement(tagName.isEmpty() ? QStringLiteral("connection") : tagName.toLower());
 
@@ -5737,6 +7967,36 @@ void DomConnection::write(QXmlStreamWriter &writer, const QString &tagName) cons
     writer.writeEndElement();
 }
 
+void DomConnection::write(QXmlStreamWriter &writer, const QString &tagName) const
+{
+    writeXml(writer, tagName);
+}
+
+void DomConnection::write(DomXmlWriter &writer, const QString &tagName) const
+{
+    writeXml(writer, tagName);
+}
+
+void DomConnection::read(QDataStream &stream)
+{
+    stream >> m_children;
+    stream >> m_sender;
+    stream >> m_signal;
+    stream >> m_receiver;
+    stream >> m_slot;
+    readDomPointer(stream, m_hints);
+}
+
+void DomConnection::write(QDataStream &stream) const
+{
+    stream << m_children;
+    stream << m_sender;
+    stream << m_signal;
+    stream << m_receiver;
+    stream << m_slot;
+    writeDomPointer(stream, m_hints);
+}
+
 void DomConnection::setElementSender(const QString &a)
 {
     m_children |= Sender;
@@ -5815,12 +8075,16 @@ void DomConnectionHints::read(QXmlStreamReader &reader)
         switch (reader.readNext()) {
         case QXmlStreamReader::StartElement : {
             const auto tag = reader.name();
-            if (!tag.compare(u"hint"_s, Qt::CaseInsensitive)) {
+            switch (domTag(tag)) {
+            case DomTag::Hint : {
                 auto *v = new DomConnectionHint();
                 v->read(reader);
                 m_hint.append(v);
                 continue;
             }
+            default :
+                break;
+            }
             reader.raiseError("Unexpected element "_L1 + tag);
         }
             break;
@@ -5832,7 +8096,8 @@ void DomConnectionHints::read(QXmlStreamReader &reader)
     }
 }
 
-void DomConnectionHints::write(QXmlStreamWriter &writer, const QString &tagName) const
+template <class Writer>
+void DomConnectionHints::writeXml(Writer &writer, const QString &tagName) const
 {
     writer.writeStartElement(tagName.isEmpty() ? QStringLiteral("connectionhints") : tagName.toLower());
 
@@ -5842,6 +8107,28 @@ void DomConnectionHints::write(QXmlStreamWriter &writer, const QString &tagName)
     writer.writeEndElement();
 }
 
+void DomConnectionHints::write(QXmlStreamWriter &writer, const QString &tagName) const
+{
+    writeXml(writer, tagName);
+}
+
+void DomConnectionHints::write(DomXmlWriter &writer, const QString &tagName) const
+{
+    writeXml(writer, tagName);
+}
+
+void DomConnectionHints::read(QDataStream &stream)
+{
+    stream >> m_children;
+    readDomList(stream, m_hint);
+}
+
+void DomConnectionHints::write(QDataStream &stream) const
+{
+    stream << m_children;
+    writeDomList(stream, m_hint);
+}
+
 void DomConnectionHints::setElementHint(const QList<DomConnectionHint *> &a)
 {
     m_children |= Hint;
@@ -5866,14 +8153,18 @@ void DomConnectionHint::read(QXmlStreamReader &reader)
         switch (reader.readNext()) {
         case QXmlStreamReader::StartElement : {
             const auto tag = reader.name();
-            if (!tag.compare(u"x"_s, Qt::CaseInsensitive)) {
+            switch (domTag(tag)) {
+            case DomTag::X : {
                 setElementX(reader.readElementText().toInt());
                 continue;
             }
-            if (!tag.compare(u"y"_s, Qt::CaseInsensitive)) {
+            case DomTag::Y : {
                 setElementY(reader.readElementText().toInt());
                 continue;
             }
+            default :
+                break;
+            }
             reader.raiseError("Unexpected element "_L1 + tag);
         }
             break;
@@ -5885,7 +8176,8 @@ void DomConnectionHint::read(QXmlStreamReader &reader)
     }
 }
 
-void DomConnectionHint::write(QXmlStreamWriter &writer, const QString &tagName) const
+template <class Writer>
+void DomConnectionHint::writeXml(Writer &writer, const QString &tagName) const
 {
     writer.writeStartElement(tagName.isEmpty() ? QStringLiteral("connectionhint") : tagName.toLower());
 
@@ -5901,6 +8193,32 @@ void DomConnectionHint::write(QXmlStreamWriter &writer, const QString &tagName)
     writer.writeEndElement();
 }
 
+void DomConnectionHint::write(QXmlStreamWriter &writer, const QString &tagName) const
+{
+    writeXml(writer, tagName);
+}
+
+void DomConnectionHint::write(DomXmlWriter &writer, const QString &tagName) const
+{
+    writeXml(writer, tagName);
+}
+
+void DomConnectionHint::read(QDataStream &stream)
+{
+    stream >> m_attr_type >> m_has_attr_type;
+    stream >> m_children;
+    stream >> m_x;
+    stream >> m_y;
+}
+
+void DomConnectionHint::write(QDataStream &stream) const
+{
+    stream << m_attr_type << m_has_attr_type;
+    stream << m_children;
+    stream << m_x;
+    stream << m_y;
+}
+
 void DomConnectionHint::setElementX(int a)
 {
     m_children |= X;
@@ -5935,12 +8253,16 @@ void DomDesignerData::read(QXmlStreamReader &reader)
         switch (reader.readNext()) {
         case QXmlStreamReader::StartElement : {
             const auto tag = reader.name();
-            if (!tag.compare(u"property"_s, Qt::CaseInsensitive)) {
+            switch (domTag(tag)) {
+            case DomTag::Property : {
                 auto *v = new DomProperty();
                 v->read(reader);
                 m_property.append(v);
                 continue;
             }
+            default :
+                break;
+            }
             reader.raiseError("Unexpected element "_L1 + tag);
         }
             break;
@@ -5952,7 +8274,8 @@ void DomDesignerData::read(QXmlStreamReader &reader)
     }
 }
 
-void DomDesignerData::write(QXmlStreamWriter &writer, const QString &tagName) const
+template <class Writer>
+void DomDesignerData::writeXml(Writer &writer, const QString &tagName) const
 {
     writer.writeStartElement(tagName.isEmpty() ? QStringLiteral("designerdata") : tagName.toLower());
 
@@ -5962,6 +8285,28 @@ void DomDesignerData::write(QXmlStreamWriter &writer, const QString &tagName) co
     writer.writeEndElement();
 }
 
+void DomDesignerData::write(QXmlStreamWriter &writer, const QString &tagName) const
+{
+    writeXml(writer, tagName);
+}
+
+void DomDesignerData::write(DomXmlWriter &writer, const QString &tagName) const
+{
+    writeXml(writer, tagName);
+}
+
+void DomDesignerData::read(QDataStream &stream)
+{
+    stream >> m_children;
+    readDomList(stream, m_property);
+}
+
+void DomDesignerData::write(QDataStream &stream) const
+{
+    stream << m_children;
+    writeDomList(stream, m_property);
+}
+
 void DomDesignerData::setElementProperty(const QList<DomProperty *> &a)
 {
     m_children |= Property;
@@ -5980,14 +8325,18 @@ void DomSlots::read(QXmlStreamReader &reader)
         switch (reader.readNext()) {
         case QXmlStreamReader::StartElement : {
             const auto tag = reader.name();
-            if (!tag.compare(u"signal"_s, Qt::CaseInsensitive)) {
+            switch (domTag(tag)) {
+            case DomTag::Signal : {
                 m_signal.append(reader.readElementText());
                 continue;
             }
-            if (!tag.compare(u"slot"_s, Qt::CaseInsensitive)) {
+            case DomTag::Slot : {
                 m_slot.append(reader.readElementText());
                 continue;
             }
+            default :
+                break;
+            }
             reader.raiseError("Unexpected element "_L1 + tag);
         }
             break;
@@ -5999,7 +8348,8 @@ void DomSlots::read(QXmlStreamReader &reader)
     }
 }
 
-void DomSlots::write(QXmlStreamWriter &writer, const QString &tagName) const
+template <class Writer>
+void DomSlots::writeXml(Writer &writer, const QString &tagName) const
 {
     writer.writeStartElement(tagName.isEmpty() ? QStringLiteral("slots") : tagName.toLower());
 
@@ -6012,6 +8362,30 @@ void DomSlots::write(QXmlStreamWriter &writer, const QString &tagName) const
     writer.writeEndElement();
 }
 
+void DomSlots::write(QXmlStreamWriter &writer, const QString &tagName) const
+{
+    writeXml(writer, tagName);
+}
+
+void DomSlots::write(DomXmlWriter &writer, const QString &tagName) const
+{
+    writeXml(writer, tagName);
+}
+
+void DomSlots::read(QDataStream &stream)
+{
+    stream >> m_children;
+    stream >> m_signal;
+    stream >> m_slot;
+}
+
+void DomSlots::write(QDataStream &stream) const
+{
+    stream << m_children;
+    stream << m_signal;
+    stream << m_slot;
+}
+
 void DomSlots::setElementSignal(const QStringList &a)
 {
     m_children |= Signal;
@@ -6038,18 +8412,22 @@ void DomPropertySpecifications::read(QXmlStreamReader &reader)
         switch (reader.readNext()) {
         case QXmlStreamReader::StartElement : {
             const auto tag = reader.name();
-            if (!tag.compare(u"tooltip"_s, Qt::CaseInsensitive)) {
+            switch (domTag(tag)) {
+            case DomTag::Tooltip : {
                 auto *v = new DomPropertyToolTip();
                 v->read(reader);
                 m_tooltip.append(v);
                 continue;
             }
-            if (!tag.compare(u"stringpropertyspecification"_s, Qt::CaseInsensitive)) {
+            case DomTag::Stringpropertyspecification : {
                 auto *v = new DomStringPropertySpecification();
                 v->read(reader);
                 m_stringpropertyspecification.append(v);
                 continue;
             }
+            default :
+                break;
+            }
             reader.raiseError("Unexpected element "_L1 + tag);
         }
             break;
@@ -6061,7 +8439,8 @@ void DomPropertySpecifications::read(QXmlStreamReader &reader)
     }
 }
 
-void DomPropertySpecifications::write(QXmlStreamWriter &writer, const QString &tagName) const
+template <class Writer>
+void DomPropertySpecifications::writeXml(Writer &writer, const QString &tagName) const
 {
     writer.writeStartElement(tagName.isEmpty() ? QStringLiteral("propertyspecifications") : tagName.toLower());
 
@@ -6074,6 +8453,30 @@ void DomPropertySpecifications::write(QXmlStreamWriter &writer, const QString &t
     writer.writeEndElement();
 }
 
+void DomPropertySpecifications::write(QXmlStreamWriter &writer, const QString &tagName) const
+{
+    writeXml(writer, tagName);
+}
+
+void DomPropertySpecifications::write(DomXmlWriter &writer, const QString &tagName) const
+{
+    writeXml(writer, tagName);
+}
+
+void DomPropertySpecifications::read(QDataStream &stream)
+{
+    stream >> m_children;
+    readDomList(stream, m_tooltip);
+    readDomList(stream, m_stringpropertyspecification);
+}
+
+void DomPropertySpecifications::write(QDataStream &stream) const
+{
+    stream << m_children;
+    writeDomList(stream, m_tooltip);
+    writeDomList(stream, m_stringpropertyspecification);
+}
+
 void DomPropertySpecifications::setElementTooltip(const QList<DomPropertyToolTip *> &a)
 {
     m_children |= Tooltip;
@@ -6115,7 +8518,8 @@ void DomPropertyToolTip::read(QXmlStreamReader &reader)
     }
 }
 
-void DomPropertyToolTip::write(QXmlStreamWriter &writer, const QString &tagName) const
+template <class Writer>
+void DomPropertyToolTip::writeXml(Writer &writer, const QString &tagName) const
 {
     writer.writeStartElement(tagName.isEmpty() ? QStringLiteral("propertytooltip") : tagName.toLower());
 
@@ -6125,6 +8529,26 @@ void DomPropertyToolTip::write(QXmlStreamWriter &writer, const QString &tagName)
     writer.writeEndElement();
 }
 
+void DomPropertyToolTip::write(QXmlStreamWriter &writer, const QString &tagName) const
+{
+    writeXml(writer, tagName);
+}
+
+void DomPropertyToolTip::write(DomXmlWriter &writer, const QString &tagName) const
+{
+    writeXml(writer, tagName);
+}
+
+void DomPropertyToolTip::read(QDataStream &stream)
+{
+    stream >> m_attr_name >> m_has_attr_name;
+}
+
+void DomPropertyToolTip::write(QDataStream &stream) const
+{
+    stream << m_attr_name << m_has_attr_name;
+}
+
 DomStringPropertySpecification::~DomStringPropertySpecification() = default;
 
 void DomStringPropertySpecification::read(QXmlStreamReader &reader)
@@ -6162,7 +8586,8 @@ void DomStringPropertySpecification::read(QXmlStreamReader &reader)
     }
 }
 
-void DomStringPropertySpecification::write(QXmlStreamWriter &writer, const QString &tagName) const
+template <class Writer>
+void DomStringPropertySpecification::writeXml(Writer &writer, const QString &tagName) const
 {
     writer.writeStartElement(tagName.isEmpty() ? QStringLiteral("stringpropertyspecification") : tagName.toLower());
 
@@ -6178,5 +8603,29 @@ void DomStringPropertySpecification::write(QXmlStreamWriter &writer, const QStri
     writer.writeEndElement();
 }
 
+void DomStringPropertySpecification::write(QXmlStreamWriter &writer, const QString &tagName) const
+{
+    writeXml(writer, tagName);
+}
+
+void DomStringPropertySpecification::write(DomXmlWriter &writer, const QString &tagName) const
+{
+    writeXml(writer, tagName);
+}
+
+void DomStringPropertySpecification::read(QDataStream &stream)
+{
+    stream >> m_attr_name >> m_has_attr_name;
+    stream >> m_attr_type >> m_has_attr_type;
+    stream >> m_attr_notr >> m_has_attr_notr;
+}
+
+void DomStringPropertySpecification::write(QDataStream &stream) const
+{
+    stream << m_attr_name << m_has_attr_name;
+    stream << m_attr_type << m_has_attr_type;
+    stream << m_attr_notr << m_has_attr_notr;
+}
+
 QT_END_NAMESPACE
 
@@ -17,8 +17,10 @@
 #ifndef UI4_H
 #define UI4_H
 
+#include <qdatastream.h>
 #include <qlist.h>
 #include <qstring.h>
+#include <qstringconverter.h>
 #include <qstringlist.h>
 #include <qxmlstream.h>
 #include <qglobal.h>
@@ -109,6 +111,81 @@ class DomPropertySpecifications;
 class DomPropertyToolTip;
 class DomStringPropertySpecification;
 
+/*******************************************************************************
+** Allocation
+*/
+
+// Lets the Dom classes be allocated from large blocks that are freed at once
+// when the arena is destroyed, for trees that are read and thrown away. The
+// objects only give their memory back if they did not come from an arena.
+class QDESIGNER_UILIB_EXPORT DomArena {
+    Q_DISABLE_COPY_MOVE(DomArena)
+public:
+    DomArena() = default;
+    ~DomArena();
+
+    // Makes the Dom objects created on this thread while it exists come from
+    // the arena, which has to outlive them.
+    class QDESIGNER_UILIB_EXPORT Scope {
+        Q_DISABLE_COPY_MOVE(Scope)
+    public:
+        explicit Scope(DomArena *arena);
+        ~Scope();
+
+    private:
+        DomArena *m_previous;
+    };
+
+    static void *allocate(size_t size);
+    static void deallocate(void *pointer) noexcept;
+
+private:
+    void *allocateInBlock(size_t size);
+
+    QList<char *> m_blocks;
+    char *m_free = nullptr;
+    size_t m_left = 0;
+};
+
+/*******************************************************************************
+** Writing
+*/
+
+// Writes the XML of the Dom classes into a UTF-8 buffer, formatted like a
+// QXmlStreamWriter on a device with auto-formatting and an indentation of one
+// space. Names are appended as they are, only values and text are escaped.
+class QDESIGNER_UILIB_EXPORT DomXmlWriter {
+    Q_DISABLE_COPY_MOVE(DomXmlWriter)
+public:
+    explicit DomXmlWriter(QByteArray *buffer);
+
+    void writeStartDocument();
+    void writeEndDocument();
+
+    void writeStartElement(const QString &name);
+    void writeEndElement();
+    void writeAttribute(const QString &name, const QString &value);
+    void writeTextElement(const QString &name, const QString &text);
+    void writeCharacters(const QString &text);
+
+    // Whether characters that cannot occur in XML were dropped
+    bool hasError() const { return m_hasError; }
+
+private:
+    bool finishStartElement(bool contents);
+    void indent(qsizetype level);
+    void append(QStringView text);
+    void appendEscaped(QStringView text, bool escapeWhitespace);
+
+    QByteArray *m_buffer;
+    QStringEncoder m_encoder;
+    QList<QString> m_tags;
+    bool m_inStartElement = false;
+    bool m_lastWasStartElement = false;
+    bool m_wroteSomething = false;
+    bool m_hasError = false;
+};
+
 /*******************************************************************************
 ** Declarations
 */
@@ -119,8 +196,14 @@ public:
     DomUI() = default;
     ~DomUI();
 
+    static void *operator new(size_t size) { return DomArena::allocate(size); }
+    static void operator delete(void *pointer) noexcept { DomArena::deallocate(pointer); }
+
     void read(QXmlStreamReader &reader);
     void write(QXmlStreamWriter &writer, const QString &tagName = QString()) const;
+    void write(DomXmlWriter &writer, const QString &tagName = QString()) const;
+    void read(QDataStream &stream);
+    void write(QDataStream &stream) const;
 
     // attribute accessors
     inline bool hasAttributeVersion() const { return m_has_attr_version; }
@@ -251,6 +334,9 @@ public:
     void clearElementButtonGroups();
 
 private:
+    template <class Writer>
+    void writeXml(Writer &writer, const QString &tagName) const;
+
     // attribute data
     QString m_attr_version;
     bool m_has_attr_version = false;
@@ -318,14 +404,22 @@ public:
     DomIncludes() = default;
     ~DomIncludes();
 
+    static void *operator new(size_t size) { return DomArena::allocate(size); }
+    static void operator delete(void *pointer) noexcept { DomArena::deallocate(pointer); }
+
     void read(QXmlStreamReader &reader);
     void write(QXmlStreamWriter &writer, const QString &tagName = QString()) const;
+    void write(DomXmlWriter &writer, const QString &tagName = QString()) const;
+    void read(QDataStream &stream);
+    void write(QDataStream &stream) const;
 
     // child element accessors
     inline QList<DomInclude *> elementInclude() const { return m_include; }
     void setElementInclude(const QList<DomInclude *> &a);
 
 private:
+    template <class Writer>
+    void writeXml(Writer &writer, const QString &tagName) const;
 
     // child element data
     uint m_children = 0;
@@ -342,8 +436,14 @@ public:
     DomInclude() = default;
     ~DomInclude();
 
+    static void *operator new(size_t size) { return DomArena::allocate(size); }
+    static void operator delete(void *pointer) noexcept { DomArena::deallocate(pointer); }
+
     void read(QXmlStreamReader &reader);
     void write(QXmlStreamWriter &writer, const QString &tagName = QString()) const;
+    void write(DomXmlWriter &writer, const QString &tagName = QString()) const;
+    void read(QDataStream &stream);
+    void write(QDataStream &stream) const;
 
     inline QString text() const { return m_text; }
     inline void setText(const QString &s) { m_text = s; }
@@ -360,6 +460,9 @@ public:
     inline void clearAttributeImpldecl() { m_has_attr_impldecl = false; }
 
 private:
+    template <class Writer>
+    void writeXml(Writer &writer, const QString &tagName) const;
+
     QString m_text;
 
     // attribute data
@@ -376,8 +479,14 @@ public:
     DomResources() = default;
     ~DomResources();
 
+    static void *operator new(size_t size) { return DomArena::allocate(size); }
+    static void operator delete(void *pointer) noexcept { DomArena::deallocate(pointer); }
+
     void read(QXmlStreamReader &reader);
     void write(QXmlStreamWriter &writer, const QString &tagName = QString()) const;
+    void write(DomXmlWriter &writer, const QString &tagName = QString()) const;
+    void read(QDataStream &stream);
+    void write(QDataStream &stream) const;
 
     // attribute accessors
     inline bool hasAttributeName() const { return m_has_attr_name; }
@@ -390,6 +499,9 @@ public:
     void setElementInclude(const QList<DomResource *> &a);
 
 private:
+    template <class Writer>
+    void writeXml(Writer &writer, const QString &tagName) const;
+
     // attribute data
     QString m_attr_name;
     bool m_has_attr_name = false;
@@ -409,8 +521,14 @@ public:
     DomResource() = default;
     ~DomResource();
 
+    static void *operator new(size_t size) { return DomArena::allocate(size); }
+    static void operator delete(void *pointer) noexcept { DomArena::deallocate(pointer); }
+
     void read(QXmlStreamReader &reader);
     void write(QXmlStreamWriter &writer, const QString &tagName = QString()) const;
+    void write(DomXmlWriter &writer, const QString &tagName = QString()) const;
+    void read(QDataStream &stream);
+    void write(QDataStream &stream) const;
 
     // attribute accessors
     inline bool hasAttributeLocation() const { return m_has_attr_location; }
@@ -419,6 +537,9 @@ public:
     inline void clearAttributeLocation() { m_has_attr_location = false; }
 
 private:
+    template <class Writer>
+    void writeXml(Writer &writer, const QString &tagName) const;
+
     // attribute data
     QString m_attr_location;
     bool m_has_attr_location = false;
@@ -430,8 +551,14 @@ public:
     DomActionGroup() = default;
     ~DomActionGroup();
 
+    static void *operator new(size_t size) { return DomArena::allocate(size); }
+    static void operator delete(void *pointer) noexcept { DomArena::deallocate(pointer); }
+
     void read(QXmlStreamReader &reader);
     void write(QXmlStreamWriter &writer, const QString &tagName = QString()) const;
+    void write(DomXmlWriter &writer, const QString &tagName = QString()) const;
+    void read(QDataStream &stream);
+    void write(QDataStream &stream) const;
 
     // attribute accessors
     inline bool hasAttributeName() const { return m_has_attr_name; }
@@ -453,6 +580,9 @@ public:
     void setElementAttribute(const QList<DomProperty *> &a);
 
 private:
+    template <class Writer>
+    void writeXml(Writer &writer, const QString &tagName) const;
+
     // attribute data
     QString m_attr_name;
     bool m_has_attr_name = false;
@@ -478,8 +608,14 @@ public:
     DomAction() = default;
     ~DomAction();
 
+    static void *operator new(size_t size) { return DomArena::allocate(size); }
+    static void operator delete(void *pointer) noexcept { DomArena::deallocate(pointer); }
+
     void read(QXmlStreamReader &reader);
     void write(QXmlStreamWriter &writer, const QString &tagName = QString()) const;
+    void write(DomXmlWriter &writer, const QString &tagName = QString()) const;
+    void read(QDataStream &stream);
+    void write(QDataStream &stream) const;
 
     // attribute accessors
     inline bool hasAttributeName() const { return m_has_attr_name; }
@@ -500,6 +636,9 @@ public:
     void setElementAttribute(const QList<DomProperty *> &a);
 
 private:
+    template <class Writer>
+    void writeXml(Writer &writer, const QString &tagName) const;
+
     // attribute data
     QString m_attr_name;
     bool m_has_attr_name = false;
@@ -524,8 +663,14 @@ public:
     DomActionRef() = default;
     ~DomActionRef();
 
+    static void *operator new(size_t size) { return DomArena::allocate(size); }
+    static void operator delete(void *pointer) noexcept { DomArena::deallocate(pointer); }
+
     void read(QXmlStreamReader &reader);
     void write(QXmlStreamWriter &writer, const QString &tagName = QString()) const;
+    void write(DomXmlWriter &writer, const QString &tagName = QString()) const;
+    void read(QDataStream &stream);
+    void write(QDataStream &stream) const;
 
     // attribute accessors
     inline bool hasAttributeName() const { return m_has_attr_name; }
@@ -534,6 +679,9 @@ public:
     inline void clearAttributeName() { m_has_attr_name = false; }
 
 private:
+    template <class Writer>
+    void writeXml(Writer &writer, const QString &tagName) const;
+
     // attribute data
     QString m_attr_name;
     bool m_has_attr_name = false;
@@ -545,8 +693,14 @@ public:
     DomButtonGroup() = default;
     ~DomButtonGroup();
 
+    static void *operator new(size_t size) { return DomArena::allocate(size); }
+    static void operator delete(void *pointer) noexcept { DomArena::deallocate(pointer); }
+
     void read(QXmlStreamReader &reader);
     void write(QXmlStreamWriter &writer, const QString &tagName = QString()) const;
+    void write(DomXmlWriter &writer, const QString &tagName = QString()) const;
+    void read(QDataStream &stream);
+    void write(QDataStream &stream) const;
 
     // attribute accessors
     inline bool hasAttributeName() const { return m_has_attr_name; }
@@ -562,6 +716,9 @@ public:
     void setElementAttribute(const QList<DomProperty *> &a);
 
 private:
+    template <class Writer>
+    void writeXml(Writer &writer, const QString &tagName) const;
+
     // attribute data
     QString m_attr_name;
     bool m_has_attr_name = false;
@@ -583,14 +740,22 @@ public:
     DomButtonGroups() = default;
     ~DomButtonGroups();
 
+    static void *operator new(size_t size) { return DomArena::allocate(size); }
+    static void operator delete(void *pointer) noexcept { DomArena::deallocate(pointer); }
+
     void read(QXmlStreamReader &reader);
     void write(QXmlStreamWriter &writer, const QString &tagName = QString()) const;
+    void write(DomXmlWriter &writer, const QString &tagName = QString()) const;
+    void read(QDataStream &stream);
+    void write(QDataStream &stream) const;
 
     // child element accessors
     inline QList<DomButtonGroup *> elementButtonGroup() const { return m_buttonGroup; }
     void setElementButtonGroup(const QList<DomButtonGroup *> &a);
 
 private:
+    template <class Writer>
+    void writeXml(Writer &writer, const QString &tagName) const;
 
     // child element data
     uint m_children = 0;
@@ -607,14 +772,22 @@ public:
     DomCustomWidgets() = default;
     ~DomCustomWidgets();
 
+    static void *operator new(size_t size) { return DomArena::allocate(size); }
+    static void operator delete(void *pointer) noexcept { DomArena::deallocate(pointer); }
+
     void read(QXmlStreamReader &reader);
     void write(QXmlStreamWriter &writer, const QString &tagName = QString()) const;
+    void write(DomXmlWriter &writer, const QString &tagName = QString()) const;
+    void read(QDataStream &stream);
+    void write(QDataStream &stream) const;
 
     // child element accessors
     inline QList<DomCustomWidget *> elementCustomWidget() const { return m_customWidget; }
     void setElementCustomWidget(const QList<DomCustomWidget *> &a);
 
 private:
+    template <class Writer>
+    void writeXml(Writer &writer, const QString &tagName) const;
 
     // child element data
     uint m_children = 0;
@@ -631,8 +804,14 @@ public:
     DomHeader() = default;
     ~DomHeader();
 
+    static void *operator new(size_t size) { return DomArena::allocate(size); }
+    static void operator delete(void *pointer) noexcept { DomArena::deallocate(pointer); }
+
     void read(QXmlStreamReader &reader);
     void write(QXmlStreamWriter &writer, const QString &tagName = QString()) const;
+    void write(DomXmlWriter &writer, const QString &tagName = QString()) const;
+    void read(QDataStream &stream);
+    void write(QDataStream &stream) const;
 
     inline QString text() const { return m_text; }
     inline void setText(const QString &s) { m_text = s; }
@@ -644,6 +823,9 @@ public:
     inline void clearAttributeLocation() { m_has_attr_location = false; }
 
 private:
+    template <class Writer>
+    void writeXml(Writer &writer, const QString &tagName) const;
+
     QString m_text;
 
     // attribute data
@@ -657,8 +839,14 @@ public:
     DomCustomWidget() = default;
     ~DomCustomWidget();
 
+    static void *operator new(size_t size) { return DomArena::allocate(size); }
+    static void operator delete(void *pointer) noexcept { DomArena::deallocate(pointer); }
+
     void read(QXmlStreamReader &reader);
     void write(QXmlStreamWriter &writer, const QString &tagName = QString()) const;
+    void write(DomXmlWriter &writer, const QString &tagName = QString()) const;
+    void read(QDataStream &stream);
+    void write(QDataStream &stream) const;
 
     // child element accessors
     inline QString elementClass() const { return m_class; }
@@ -711,6 +899,8 @@ public:
     void clearElementPropertyspecifications();
 
 private:
+    template <class Writer>
+    void writeXml(Writer &writer, const QString &tagName) const;
 
     // child element data
     uint m_children = 0;
@@ -743,8 +933,14 @@ public:
     DomLayoutDefault() = default;
     ~DomLayoutDefault();
 
+    static void *operator new(size_t size) { return DomArena::allocate(size); }
+    static void operator delete(void *pointer) noexcept { DomArena::deallocate(pointer); }
+
     void read(QXmlStreamReader &reader);
     void write(QXmlStreamWriter &writer, const QString &tagName = QString()) const;
+    void write(DomXmlWriter &writer, const QString &tagName = QString()) const;
+    void read(QDataStream &stream);
+    void write(QDataStream &stream) const;
 
     // attribute accessors
     inline bool hasAttributeSpacing() const { return m_has_attr_spacing; }
@@ -758,6 +954,9 @@ public:
     inline void clearAttributeMargin() { m_has_attr_margin = false; }
 
 private:
+    template <class Writer>
+    void writeXml(Writer &writer, const QString &tagName) const;
+
     // attribute data
     int m_attr_spacing = 0;
     bool m_has_attr_spacing = false;
@@ -772,8 +971,14 @@ public:
     DomLayoutFunction() = default;
     ~DomLayoutFunction();
 
+    static void *operator new(size_t size) { return DomArena::allocate(size); }
+    static void operator delete(void *pointer) noexcept { DomArena::deallocate(pointer); }
+
     void read(QXmlStreamReader &reader);
     void write(QXmlStreamWriter &writer, const QString &tagName = QString()) const;
+    void write(DomXmlWriter &writer, const QString &tagName = QString()) const;
+    void read(QDataStream &stream);
+    void write(QDataStream &stream) const;
 
     // attribute accessors
     inline bool hasAttributeSpacing() const { return m_has_attr_spacing; }
@@ -787,6 +992,9 @@ public:
     inline void clearAttributeMargin() { m_has_attr_margin = false; }
 
 private:
+    template <class Writer>
+    void writeXml(Writer &writer, const QString &tagName) const;
+
     // attribute data
     QString m_attr_spacing;
     bool m_has_attr_spacing = false;
@@ -801,14 +1009,22 @@ public:
     DomTabStops() = default;
     ~DomTabStops();
 
+    static void *operator new(size_t size) { return DomArena::allocate(size); }
+    static void operator delete(void *pointer) noexcept { DomArena::deallocate(pointer); }
+
     void read(QXmlStreamReader &reader);
     void write(QXmlStreamWriter &writer, const QString &tagName = QString()) const;
+    void write(DomXmlWriter &writer, const QString &tagName = QString()) const;
+    void read(QDataStream &stream);
+    void write(QDataStream &stream) const;
 
     // child element accessors
     inline QStringList elementTabStop() const { return m_tabStop; }
     void setElementTabStop(const QStringList &a);
 
 private:
+    template <class Writer>
+    void writeXml(Writer &writer, const QString &tagName) const;
 
     // child element data
     uint m_children = 0;
@@ -825,8 +1041,14 @@ public:
     DomLayout() = default;
     ~DomLayout();
 
+    static void *operator new(size_t size) { return DomArena::allocate(size); }
+    static void operator delete(void *pointer) noexcept { DomArena::deallocate(pointer); }
+
     void read(QXmlStreamReader &reader);
     void write(QXmlStreamWriter &writer, const QString &tagName = QString()) const;
+    void write(DomXmlWriter &writer, const QString &tagName = QString()) const;
+    void read(QDataStream &stream);
+    void write(QDataStream &stream) const;
 
     // attribute accessors
     inline bool hasAttributeClass() const { return m_has_attr_class; }
@@ -875,6 +1097,9 @@ public:
     void setElementItem(const QList<DomLayoutItem *> &a);
 
 private:
+    template <class Writer>
+    void writeXml(Writer &writer, const QString &tagName) const;
+
     // attribute data
     QString m_attr_class;
     bool m_has_attr_class = false;
@@ -916,8 +1141,14 @@ public:
     DomLayoutItem() = default;
     ~DomLayoutItem();
 
+    static void *operator new(size_t size) { return DomArena::allocate(size); }
+    static void operator delete(void *pointer) noexcept { DomArena::deallocate(pointer); }
+
     void read(QXmlStreamReader &reader);
     void write(QXmlStreamWriter &writer, const QString &tagName = QString()) const;
+    void write(DomXmlWriter &writer, const QString &tagName = QString()) const;
+    void read(QDataStream &stream);
+    void write(QDataStream &stream) const;
 
     // attribute accessors
     inline bool hasAttributeRow() const { return m_has_attr_row; }
@@ -962,6 +1193,9 @@ public:
     void setElementSpacer(DomSpacer *a);
 
 private:
+    template <class Writer>
+    void writeXml(Writer &writer, const QString &tagName) const;
+
     void clear();
 
     // attribute data
@@ -993,14 +1227,22 @@ public:
     DomRow() = default;
     ~DomRow();
 
+    static void *operator new(size_t size) { return DomArena::allocate(size); }
+    static void operator delete(void *pointer) noexcept { DomArena::deallocate(pointer); }
+
     void read(QXmlStreamReader &reader);
     void write(QXmlStreamWriter &writer, const QString &tagName = QString()) const;
+    void write(DomXmlWriter &writer, const QString &tagName = QString()) const;
+    void read(QDataStream &stream);
+    void write(QDataStream &stream) const;
 
     // child element accessors
     inline QList<DomProperty *> elementProperty() const { return m_property; }
     void setElementProperty(const QList<DomProperty *> &a);
 
 private:
+    template <class Writer>
+    void writeXml(Writer &writer, const QString &tagName) const;
 
     // child element data
     uint m_children = 0;
@@ -1017,14 +1259,22 @@ public:
     DomColumn() = default;
     ~DomColumn();
 
+    static void *operator new(size_t size) { return DomArena::allocate(size); }
+    static void operator delete(void *pointer) noexcept { DomArena::deallocate(pointer); }
+
     void read(QXmlStreamReader &reader);
     void write(QXmlStreamWriter &writer, const QString &tagName = QString()) const;
+    void write(DomXmlWriter &writer, const QString &tagName = QString()) const;
+    void read(QDataStream &stream);
+    void write(QDataStream &stream) const;
 
     // child element accessors
     inline QList<DomProperty *> elementProperty() const { return m_property; }
     void setElementProperty(const QList<DomProperty *> &a);
 
 private:
+    template <class Writer>
+    void writeXml(Writer &writer, const QString &tagName) const;
 
     // child element data
     uint m_children = 0;
@@ -1041,8 +1291,14 @@ public:
     DomItem() = default;
     ~DomItem();
 
+    static void *operator new(size_t size) { return DomArena::allocate(size); }
+    static void operator delete(void *pointer) noexcept { DomArena::deallocate(pointer); }
+
     void read(QXmlStreamReader &reader);
     void write(QXmlStreamWriter &writer, const QString &tagName = QString()) const;
+    void write(DomXmlWriter &writer, const QString &tagName = QString()) const;
+    void read(QDataStream &stream);
+    void write(QDataStream &stream) const;
 
     // attribute accessors
     inline bool hasAttributeRow() const { return m_has_attr_row; }
@@ -1063,6 +1319,9 @@ public:
     void setElementItem(const QList<DomItem *> &a);
 
 private:
+    template <class Writer>
+    void writeXml(Writer &writer, const QString &tagName) const;
+
     // attribute data
     int m_attr_row = 0;
     bool m_has_attr_row = false;
@@ -1087,8 +1346,14 @@ public:
     DomWidget() = default;
     ~DomWidget();
 
+    static void *operator new(size_t size) { return DomArena::allocate(size); }
+    static void operator delete(void *pointer) noexcept { DomArena::deallocate(pointer); }
+
     void read(QXmlStreamReader &reader);
     void write(QXmlStreamWriter &writer, const QString &tagName = QString()) const;
+    void write(DomXmlWriter &writer, const QString &tagName = QString()) const;
+    void read(QDataStream &stream);
+    void write(QDataStream &stream) const;
 
     // attribute accessors
     inline bool hasAttributeClass() const { return m_has_attr_class; }
@@ -1144,6 +1409,9 @@ public:
     void setElementZOrder(const QStringList &a);
 
 private:
+    template <class Writer>
+    void writeXml(Writer &writer, const QString &tagName) const;
+
     // attribute data
     QString m_attr_class;
     bool m_has_attr_class = false;
@@ -1191,8 +1459,14 @@ public:
     DomSpacer() = default;
     ~DomSpacer();
 
+    static void *operator new(size_t size) { return DomArena::allocate(size); }
+    static void operator delete(void *pointer) noexcept { DomArena::deallocate(pointer); }
+
     void read(QXmlStreamReader &reader);
     void write(QXmlStreamWriter &writer, const QString &tagName = QString()) const;
+    void write(DomXmlWriter &writer, const QString &tagName = QString()) const;
+    void read(QDataStream &stream);
+    void write(QDataStream &stream) const;
 
     // attribute accessors
     inline bool hasAttributeName() const { return m_has_attr_name; }
@@ -1205,6 +1479,9 @@ public:
     void setElementProperty(const QList<DomProperty *> &a);
 
 private:
+    template <class Writer>
+    void writeXml(Writer &writer, const QString &tagName) const;
+
     // attribute data
     QString m_attr_name;
     bool m_has_attr_name = false;
@@ -1224,8 +1501,14 @@ public:
     DomColor() = default;
     ~DomColor();
 
+    static void *operator new(size_t size) { return DomArena::allocate(size); }
+    static void operator delete(void *pointer) noexcept { DomArena::deallocate(pointer); }
+
     void read(QXmlStreamReader &reader);
     void write(QXmlStreamWriter &writer, const QString &tagName = QString()) const;
+    void write(DomXmlWriter &writer, const QString &tagName = QString()) const;
+    void read(QDataStream &stream);
+    void write(QDataStream &stream) const;
 
     // attribute accessors
     inline bool hasAttributeAlpha() const { return m_has_attr_alpha; }
@@ -1250,6 +1533,9 @@ public:
     void clearElementBlue();
 
 private:
+    template <class Writer>
+    void writeXml(Writer &writer, const QString &tagName) const;
+
     // attribute data
     int m_attr_alpha = 0;
     bool m_has_attr_alpha = false;
@@ -1273,8 +1559,14 @@ public:
     DomGradientStop() = default;
     ~DomGradientStop();
 
+    static void *operator new(size_t size) { return DomArena::allocate(size); }
+    static void operator delete(void *pointer) noexcept { DomArena::deallocate(pointer); }
+
     void read(QXmlStreamReader &reader);
     void write(QXmlStreamWriter &writer, const QString &tagName = QString()) const;
+    void write(DomXmlWriter &writer, const QString &tagName = QString()) const;
+    void read(QDataStream &stream);
+    void write(QDataStream &stream) const;
 
     // attribute accessors
     inline bool hasAttributePosition() const { return m_has_attr_position; }
@@ -1290,6 +1582,9 @@ public:
     void clearElementColor();
 
 private:
+    template <class Writer>
+    void writeXml(Writer &writer, const QString &tagName) const;
+
     // attribute data
     double m_attr_position = 0.0;
     bool m_has_attr_position = false;
@@ -1309,8 +1604,14 @@ public:
     DomGradient() = default;
     ~DomGradient();
 
+    static void *operator new(size_t size) { return DomArena::allocate(size); }
+    static void operator delete(void *pointer) noexcept { DomArena::deallocate(pointer); }
+
     void read(QXmlStreamReader &reader);
     void write(QXmlStreamWriter &writer, const QString &tagName = QString()) const;
+    void write(DomXmlWriter &writer, const QString &tagName = QString()) const;
+    void read(QDataStream &stream);
+    void write(QDataStream &stream) const;
 
     // attribute accessors
     inline bool hasAttributeStartX() const { return m_has_attr_startX; }
@@ -1383,6 +1684,9 @@ public:
     void setElementGradientStop(const QList<DomGradientStop *> &a);
 
 private:
+    template <class Writer>
+    void writeXml(Writer &writer, const QString &tagName) const;
+
     // attribute data
     double m_attr_startX = 0.0;
     bool m_has_attr_startX = false;
@@ -1438,8 +1742,14 @@ public:
     DomBrush() = default;
     ~DomBrush();
 
+    static void *operator new(size_t size) { return DomArena::allocate(size); }
+    static void operator delete(void *pointer) noexcept { DomArena::deallocate(pointer); }
+
     void read(QXmlStreamReader &reader);
     void write(QXmlStreamWriter &writer, const QString &tagName = QString()) const;
+    void write(DomXmlWriter &writer, const QString &tagName = QString()) const;
+    void read(QDataStream &stream);
+    void write(QDataStream &stream) const;
 
     // attribute accessors
     inline bool hasAttributeBrushStyle() const { return m_has_attr_brushStyle; }
@@ -1464,6 +1774,9 @@ public:
     void setElementGradient(DomGradient *a);
 
 private:
+    template <class Writer>
+    void writeXml(Writer &writer, const QString &tagName) const;
+
     void clear();
 
     // attribute data
@@ -1483,8 +1796,14 @@ public:
     DomColorRole() = default;
     ~DomColorRole();
 
+    static void *operator new(size_t size) { return DomArena::allocate(size); }
+    static void operator delete(void *pointer) noexcept { DomArena::deallocate(pointer); }
+
     void read(QXmlStreamReader &reader);
     void write(QXmlStreamWriter &writer, const QString &tagName = QString()) const;
+    void write(DomXmlWriter &writer, const QString &tagName = QString()) const;
+    void read(QDataStream &stream);
+    void write(QDataStream &stream) const;
 
     // attribute accessors
     inline bool hasAttributeRole() const { return m_has_attr_role; }
@@ -1500,6 +1819,9 @@ public:
     void clearElementBrush();
 
 private:
+    template <class Writer>
+    void writeXml(Writer &writer, const QString &tagName) const;
+
     // attribute data
     QString m_attr_role;
     bool m_has_attr_role = false;
@@ -1519,8 +1841,14 @@ public:
     DomColorGroup() = default;
     ~DomColorGroup();
 
+    static void *operator new(size_t size) { return DomArena::allocate(size); }
+    static void operator delete(void *pointer) noexcept { DomArena::deallocate(pointer); }
+
     void read(QXmlStreamReader &reader);
     void write(QXmlStreamWriter &writer, const QString &tagName = QString()) const;
+    void write(DomXmlWriter &writer, const QString &tagName = QString()) const;
+    void read(QDataStream &stream);
+    void write(QDataStream &stream) const;
 
     // child element accessors
     inline QList<DomColorRole *> elementColorRole() const { return m_colorRole; }
@@ -1530,6 +1858,8 @@ public:
     void setElementColor(const QList<DomColor *> &a);
 
 private:
+    template <class Writer>
+    void writeXml(Writer &writer, const QString &tagName) const;
 
     // child element data
     uint m_children = 0;
@@ -1548,8 +1878,14 @@ public:
     DomPalette() = default;
     ~DomPalette();
 
+    static void *operator new(size_t size) { return DomArena::allocate(size); }
+    static void operator delete(void *pointer) noexcept { DomArena::deallocate(pointer); }
+
     void read(QXmlStreamReader &reader);
     void write(QXmlStreamWriter &writer, const QString &tagName = QString()) const;
+    void write(DomXmlWriter &writer, const QString &tagName = QString()) const;
+    void read(QDataStream &stream);
+    void write(QDataStream &stream) const;
 
     // child element accessors
     inline DomColorGroup *elementActive() const { return m_active; }
@@ -1571,6 +1907,8 @@ public:
     void clearElementDisabled();
 
 private:
+    template <class Writer>
+    void writeXml(Writer &writer, const QString &tagName) const;
 
     // child element data
     uint m_children = 0;
@@ -1591,8 +1929,14 @@ public:
     DomFont() = default;
     ~DomFont();
 
+    static void *operator new(size_t size) { return DomArena::allocate(size); }
+    static void operator delete(void *pointer) noexcept { DomArena::deallocate(pointer); }
+
     void read(QXmlStreamReader &reader);
     void write(QXmlStreamWriter &writer, const QString &tagName = QString()) const;
+    void write(DomXmlWriter &writer, const QString &tagName = QString()) const;
+    void read(QDataStream &stream);
+    void write(QDataStream &stream) const;
 
     // child element accessors
     inline QString elementFamily() const { return m_family; }
@@ -1646,6 +1990,8 @@ public:
     void clearElementKerning();
 
 private:
+    template <class Writer>
+    void writeXml(Writer &writer, const QString &tagName) const;
 
     // child element data
     uint m_children = 0;
@@ -1680,8 +2026,14 @@ public:
     DomPoint() = default;
     ~DomPoint();
 
+    static void *operator new(size_t size) { return DomArena::allocate(size); }
+    static void operator delete(void *pointer) noexcept { DomArena::deallocate(pointer); }
+
     void read(QXmlStreamReader &reader);
     void write(QXmlStreamWriter &writer, const QString &tagName = QString()) const;
+    void write(DomXmlWriter &writer, const QString &tagName = QString()) const;
+    void read(QDataStream &stream);
+    void write(QDataStream &stream) const;
 
     // child element accessors
     inline int elementX() const { return m_x; }
@@ -1695,6 +2047,8 @@ public:
     void clearElementY();
 
 private:
+    template <class Writer>
+    void writeXml(Writer &writer, const QString &tagName) const;
 
     // child element data
     uint m_children = 0;
@@ -1713,8 +2067,14 @@ public:
     DomRect() = default;
     ~DomRect();
 
+    static void *operator new(size_t size) { return DomArena::allocate(size); }
+    static void operator delete(void *pointer) noexcept { DomArena::deallocate(pointer); }
+
     void read(QXmlStreamReader &reader);
     void write(QXmlStreamWriter &writer, const QString &tagName = QString()) const;
+    void write(DomXmlWriter &writer, const QString &tagName = QString()) const;
+    void read(QDataStream &stream);
+    void write(QDataStream &stream) const;
 
     // child element accessors
     inline int elementX() const { return m_x; }
@@ -1738,6 +2098,8 @@ public:
     void clearElementHeight();
 
 private:
+    template <class Writer>
+    void writeXml(Writer &writer, const QString &tagName) const;
 
     // child element data
     uint m_children = 0;
@@ -1760,8 +2122,14 @@ public:
     DomLocale() = default;
     ~DomLocale();
 
+    static void *operator new(size_t size) { return DomArena::allocate(size); }
+    static void operator delete(void *pointer) noexcept { DomArena::deallocate(pointer); }
+
     void read(QXmlStreamReader &reader);
     void write(QXmlStreamWriter &writer, const QString &tagName = QString()) const;
+    void write(DomXmlWriter &writer, const QString &tagName = QString()) const;
+    void read(QDataStream &stream);
+    void write(QDataStream &stream) const;
 
     // attribute accessors
     inline bool hasAttributeLanguage() const { return m_has_attr_language; }
@@ -1775,6 +2143,9 @@ public:
     inline void clearAttributeCountry() { m_has_attr_country = false; }
 
 private:
+    template <class Writer>
+    void writeXml(Writer &writer, const QString &tagName) const;
+
     // attribute data
     QString m_attr_language;
     bool m_has_attr_language = false;
@@ -1789,8 +2160,14 @@ public:
     DomSizePolicy() = default;
     ~DomSizePolicy();
 
+    static void *operator new(size_t size) { return DomArena::allocate(size); }
+    static void operator delete(void *pointer) noexcept { DomArena::deallocate(pointer); }
+
     void read(QXmlStreamReader &reader);
     void write(QXmlStreamWriter &writer, const QString &tagName = QString()) const;
+    void write(DomXmlWriter &writer, const QString &tagName = QString()) const;
+    void read(QDataStream &stream);
+    void write(QDataStream &stream) const;
 
     // attribute accessors
     inline bool hasAttributeHSizeType() const { return m_has_attr_hSizeType; }
@@ -1825,6 +2202,9 @@ public:
     void clearElementVerStretch();
 
 private:
+    template <class Writer>
+    void writeXml(Writer &writer, const QString &tagName) const;
+
     // attribute data
     QString m_attr_hSizeType;
     bool m_has_attr_hSizeType = false;
@@ -1853,8 +2233,14 @@ public:
     DomSize() = default;
     ~DomSize();
 
+    static void *operator new(size_t size) { return DomArena::allocate(size); }
+    static void operator delete(void *pointer) noexcept { DomArena::deallocate(pointer); }
+
     void read(QXmlStreamReader &reader);
     void write(QXmlStreamWriter &writer, const QString &tagName = QString()) const;
+    void write(DomXmlWriter &writer, const QString &tagName = QString()) const;
+    void read(QDataStream &stream);
+    void write(QDataStream &stream) const;
 
     // child element accessors
     inline int elementWidth() const { return m_width; }
@@ -1868,6 +2254,8 @@ public:
     void clearElementHeight();
 
 private:
+    template <class Writer>
+    void writeXml(Writer &writer, const QString &tagName) const;
 
     // child element data
     uint m_children = 0;
@@ -1886,8 +2274,14 @@ public:
     DomDate() = default;
     ~DomDate();
 
+    static void *operator new(size_t size) { return DomArena::allocate(size); }
+    static void operator delete(void *pointer) noexcept { DomArena::deallocate(pointer); }
+
     void read(QXmlStreamReader &reader);
     void write(QXmlStreamWriter &writer, const QString &tagName = QString()) const;
+    void write(DomXmlWriter &writer, const QString &tagName = QString()) const;
+    void read(QDataStream &stream);
+    void write(QDataStream &stream) const;
 
     // child element accessors
     inline int elementYear() const { return m_year; }
@@ -1906,6 +2300,8 @@ public:
     void clearElementDay();
 
 private:
+    template <class Writer>
+    void writeXml(Writer &writer, const QString &tagName) const;
 
     // child element data
     uint m_children = 0;
@@ -1926,8 +2322,14 @@ public:
     DomTime() = default;
     ~DomTime();
 
+    static void *operator new(size_t size) { return DomArena::allocate(size); }
+    static void operator delete(void *pointer) noexcept { DomArena::deallocate(pointer); }
+
     void read(QXmlStreamReader &reader);
     void write(QXmlStreamWriter &writer, const QString &tagName = QString()) const;
+    void write(DomXmlWriter &writer, const QString &tagName = QString()) const;
+    void read(QDataStream &stream);
+    void write(QDataStream &stream) const;
 
     // child element accessors
     inline int elementHour() const { return m_hour; }
@@ -1946,6 +2348,8 @@ public:
     void clearElementSecond();
 
 private:
+    template <class Writer>
+    void writeXml(Writer &writer, const QString &tagName) const;
 
     // child element data
     uint m_children = 0;
@@ -1966,8 +2370,14 @@ public:
     DomDateTime() = default;
     ~DomDateTime();
 
+    static void *operator new(size_t size) { return DomArena::allocate(size); }
+    static void operator delete(void *pointer) noexcept { DomArena::deallocate(pointer); }
+
     void read(QXmlStreamReader &reader);
     void write(QXmlStreamWriter &writer, const QString &tagName = QString()) const;
+    void write(DomXmlWriter &writer, const QString &tagName = QString()) const;
+    void read(QDataStream &stream);
+    void write(QDataStream &stream) const;
 
     // child element accessors
     inline int elementHour() const { return m_hour; }
@@ -2001,6 +2411,8 @@ public:
     void clearElementDay();
 
 private:
+    template <class Writer>
+    void writeXml(Writer &writer, const QString &tagName) const;
 
     // child element data
     uint m_children = 0;
@@ -2027,8 +2439,14 @@ public:
     DomStringList() = default;
     ~DomStringList();
 
+    static void *operator new(size_t size) { return DomArena::allocate(size); }
+    static void operator delete(void *pointer) noexcept { DomArena::deallocate(pointer); }
+
     void read(QXmlStreamReader &reader);
     void write(QXmlStreamWriter &writer, const QString &tagName = QString()) const;
+    void write(DomXmlWriter &writer, const QString &tagName = QString()) const;
+    void read(QDataStream &stream);
+    void write(QDataStream &stream) const;
 
     // attribute accessors
     inline bool hasAttributeNotr() const { return m_has_attr_notr; }
@@ -2056,6 +2474,9 @@ public:
     void setElementString(const QStringList &a);
 
 private:
+    template <class Writer>
+    void writeXml(Writer &writer, const QString &tagName) const;
+
     // attribute data
     QString m_attr_notr;
     bool m_has_attr_notr = false;
@@ -2084,8 +2505,14 @@ public:
     DomResourcePixmap() = default;
     ~DomResourcePixmap();
 
+    static void *operator new(size_t size) { return DomArena::allocate(size); }
+    static void operator delete(void *pointer) noexcept { DomArena::deallocate(pointer); }
+
     void read(QXmlStreamReader &reader);
     void write(QXmlStreamWriter &writer, const QString &tagName = QString()) const;
+    void write(DomXmlWriter &writer, const QString &tagName = QString()) const;
+    void read(QDataStream &stream);
+    void write(QDataStream &stream) const;
 
     inline QString text() const { return m_text; }
     inline void setText(const QString &s) { m_text = s; }
@@ -2102,6 +2529,9 @@ public:
     inline void clearAttributeAlias() { m_has_attr_alias = false; }
 
 private:
+    template <class Writer>
+    void writeXml(Writer &writer, const QString &tagName) const;
+
     QString m_text;
 
     // attribute data
@@ -2118,8 +2548,14 @@ public:
     DomResourceIcon() = default;
     ~DomResourceIcon();
 
+    static void *operator new(size_t size) { return DomArena::allocate(size); }
+    static void operator delete(void *pointer) noexcept { DomArena::deallocate(pointer); }
+
     void read(QXmlStreamReader &reader);
     void write(QXmlStreamWriter &writer, const QString &tagName = QString()) const;
+    void write(DomXmlWriter &writer, const QString &tagName = QString()) const;
+    void read(QDataStream &stream);
+    void write(QDataStream &stream) const;
 
     inline QString text() const { return m_text; }
     inline void setText(const QString &s) { m_text = s; }
@@ -2185,6 +2621,9 @@ public:
     void clearElementSelectedOn();
 
 private:
+    template <class Writer>
+    void writeXml(Writer &writer, const QString &tagName) const;
+
     QString m_text;
 
     // attribute data
@@ -2223,8 +2662,14 @@ public:
     DomString() = default;
     ~DomString();
 
+    static void *operator new(size_t size) { return DomArena::allocate(size); }
+    static void operator delete(void *pointer) noexcept { DomArena::deallocate(pointer); }
+
     void read(QXmlStreamReader &reader);
     void write(QXmlStreamWriter &writer, const QString &tagName = QString()) const;
+    void write(DomXmlWriter &writer, const QString &tagName = QString()) const;
+    void read(QDataStream &stream);
+    void write(QDataStream &stream) const;
 
     inline QString text() const { return m_text; }
     inline void setText(const QString &s) { m_text = s; }
@@ -2251,6 +2696,9 @@ public:
     inline void clearAttributeId() { m_has_attr_id = false; }
 
 private:
+    template <class Writer>
+    void writeXml(Writer &writer, const QString &tagName) const;
+
     QString m_text;
 
     // attribute data
@@ -2273,8 +2721,14 @@ public:
     DomPointF() = default;
     ~DomPointF();
 
+    static void *operator new(size_t size) { return DomArena::allocate(size); }
+    static void operator delete(void *pointer) noexcept { DomArena::deallocate(pointer); }
+
     void read(QXmlStreamReader &reader);
     void write(QXmlStreamWriter &writer, const QString &tagName = QString()) const;
+    void write(DomXmlWriter &writer, const QString &tagName = QString()) const;
+    void read(QDataStream &stream);
+    void write(QDataStream &stream) const;
 
     // child element accessors
     inline double elementX() const { return m_x; }
@@ -2288,6 +2742,8 @@ public:
     void clearElementY();
 
 private:
+    template <class Writer>
+    void writeXml(Writer &writer, const QString &tagName) const;
 
     // child element data
     uint m_children = 0;
@@ -2306,8 +2762,14 @@ public:
     DomRectF() = default;
     ~DomRectF();
 
+    static void *operator new(size_t size) { return DomArena::allocate(size); }
+    static void operator delete(void *pointer) noexcept { DomArena::deallocate(pointer); }
+
     void read(QXmlStreamReader &reader);
     void write(QXmlStreamWriter &writer, const QString &tagName = QString()) const;
+    void write(DomXmlWriter &writer, const QString &tagName = QString()) const;
+    void read(QDataStream &stream);
+    void write(QDataStream &stream) const;
 
     // child element accessors
     inline double elementX() const { return m_x; }
@@ -2331,6 +2793,8 @@ public:
     void clearElementHeight();
 
 private:
+    template <class Writer>
+    void writeXml(Writer &writer, const QString &tagName) const;
 
     // child element data
     uint m_children = 0;
@@ -2353,8 +2817,14 @@ public:
     DomSizeF() = default;
     ~DomSizeF();
 
+    static void *operator new(size_t size) { return DomArena::allocate(size); }
+    static void operator delete(void *pointer) noexcept { DomArena::deallocate(pointer); }
+
     void read(QXmlStreamReader &reader);
     void write(QXmlStreamWriter &writer, const QString &tagName = QString()) const;
+    void write(DomXmlWriter &writer, const QString &tagName = QString()) const;
+    void read(QDataStream &stream);
+    void write(QDataStream &stream) const;
 
     // child element accessors
     inline double elementWidth() const { return m_width; }
@@ -2368,6 +2838,8 @@ public:
     void clearElementHeight();
 
 private:
+    template <class Writer>
+    void writeXml(Writer &writer, const QString &tagName) const;
 
     // child element data
     uint m_children = 0;
@@ -2386,8 +2858,14 @@ public:
     DomChar() = default;
     ~DomChar();
 
+    static void *operator new(size_t size) { return DomArena::allocate(size); }
+    static void operator delete(void *pointer) noexcept { DomArena::deallocate(pointer); }
+
     void read(QXmlStreamReader &reader);
     void write(QXmlStreamWriter &writer, const QString &tagName = QString()) const;
+    void write(DomXmlWriter &writer, const QString &tagName = QString()) const;
+    void read(QDataStream &stream);
+    void write(QDataStream &stream) const;
 
     // child element accessors
     inline int elementUnicode() const { return m_unicode; }
@@ -2396,6 +2874,8 @@ public:
     void clearElementUnicode();
 
 private:
+    template <class Writer>
+    void writeXml(Writer &writer, const QString &tagName) const;
 
     // child element data
     uint m_children = 0;
@@ -2412,8 +2892,14 @@ public:
     DomUrl() = default;
     ~DomUrl();
 
+    static void *operator new(size_t size) { return DomArena::allocate(size); }
+    static void operator delete(void *pointer) noexcept { DomArena::deallocate(pointer); }
+
     void read(QXmlStreamReader &reader);
     void write(QXmlStreamWriter &writer, const QString &tagName = QString()) const;
+    void write(DomXmlWriter &writer, const QString &tagName = QString()) const;
+    void read(QDataStream &stream);
+    void write(QDataStream &stream) const;
 
     // child element accessors
     inline DomString *elementString() const { return m_string; }
@@ -2423,6 +2909,8 @@ public:
     void clearElementString();
 
 private:
+    template <class Writer>
+    void writeXml(Writer &writer, const QString &tagName) const;
 
     // child element data
     uint m_children = 0;
@@ -2439,8 +2927,14 @@ public:
     DomProperty() = default;
     ~DomProperty();
 
+    static void *operator new(size_t size) { return DomArena::allocate(size); }
+    static void operator delete(void *pointer) noexcept { DomArena::deallocate(pointer); }
+
     void read(QXmlStreamReader &reader);
     void write(QXmlStreamWriter &writer, const QString &tagName = QString()) const;
+    void write(DomXmlWriter &writer, const QString &tagName = QString()) const;
+    void read(QDataStream &stream);
+    void write(QDataStream &stream) const;
 
     // attribute accessors
     inline bool hasAttributeName() const { return m_has_attr_name; }
@@ -2578,6 +3072,9 @@ public:
     void setElementBrush(DomBrush *a);
 
 private:
+    template <class Writer>
+    void writeXml(Writer &writer, const QString &tagName) const;
+
     void clear();
 
     // attribute data
@@ -2630,14 +3127,22 @@ public:
     DomConnections() = default;
     ~DomConnections();
 
+    static void *operator new(size_t size) { return DomArena::allocate(size); }
+    static void operator delete(void *pointer) noexcept { DomArena::deallocate(pointer); }
+
     void read(QXmlStreamReader &reader);
     void write(QXmlStreamWriter &writer, const QString &tagName = QString()) const;
+    void write(DomXmlWriter &writer, const QString &tagName = QString()) const;
+    void read(QDataStream &stream);
+    void write(QDataStream &stream) const;
 
     // child element accessors
     inline QList<DomConnection *> elementConnection() const { return m_connection; }
     void setElementConnection(const QList<DomConnection *> &a);
 
 private:
+    template <class Writer>
+    void writeXml(Writer &writer, const QString &tagName) const;
 
     // child element data
     uint m_children = 0;
@@ -2654,8 +3159,14 @@ public:
     DomConnection() = default;
     ~DomConnection();
 
+    static void *operator new(size_t size) { return DomArena::allocate(size); }
+    static void operator delete(void *pointer) noexcept { DomArena::deallocate(pointer); }
+
     void read(QXmlStreamReader &reader);
     void write(QXmlStreamWriter &writer, const QString &tagName = QString()) const;
+    void write(DomXmlWriter &writer, const QString &tagName = QString()) const;
+    void read(QDataStream &stream);
+    void write(QDataStream &stream) const;
 
     // child element accessors
     inline QString elementSender() const { return m_sender; }
@@ -2685,6 +3196,8 @@ public:
     void clearElementHints();
 
 private:
+    template <class Writer>
+    void writeXml(Writer &writer, const QString &tagName) const;
 
     // child element data
     uint m_children = 0;
@@ -2709,14 +3222,22 @@ public:
     DomConnectionHints() = default;
     ~DomConnectionHints();
 
+    static void *operator new(size_t size) { return DomArena::allocate(size); }
+    static void operator delete(void *pointer) noexcept { DomArena::deallocate(pointer); }
+
     void read(QXmlStreamReader &reader);
     void write(QXmlStreamWriter &writer, const QString &tagName = QString()) const;
+    void write(DomXmlWriter &writer, const QString &tagName = QString()) const;
+    void read(QDataStream &stream);
+    void write(QDataStream &stream) const;
 
     // child element accessors
     inline QList<DomConnectionHint *> elementHint() const { return m_hint; }
     void setElementHint(const QList<DomConnectionHint *> &a);
 
 private:
+    template <class Writer>
+    void writeXml(Writer &writer, const QString &tagName) const;
 
     // child element data
     uint m_children = 0;
@@ -2733,8 +3254,14 @@ public:
     DomConnectionHint() = default;
     ~DomConnectionHint();
 
+    static void *operator new(size_t size) { return DomArena::allocate(size); }
+    static void operator delete(void *pointer) noexcept { DomArena::deallocate(pointer); }
+
     void read(QXmlStreamReader &reader);
     void write(QXmlStreamWriter &writer, const QString &tagName = QString()) const;
+    void write(DomXmlWriter &writer, const QString &tagName = QString()) const;
+    void read(QDataStream &stream);
+    void write(QDataStream &stream) const;
 
     // attribute accessors
     inline bool hasAttributeType() const { return m_has_attr_type; }
@@ -2754,6 +3281,9 @@ public:
     void clearElementY();
 
 private:
+    template <class Writer>
+    void writeXml(Writer &writer, const QString &tagName) const;
+
     // attribute data
     QString m_attr_type;
     bool m_has_attr_type = false;
@@ -2775,14 +3305,22 @@ public:
     DomDesignerData() = default;
     ~DomDesignerData();
 
+    static void *operator new(size_t size) { return DomArena::allocate(size); }
+    static void operator delete(void *pointer) noexcept { DomArena::deallocate(pointer); }
+
     void read(QXmlStreamReader &reader);
     void write(QXmlStreamWriter &writer, const QString &tagName = QString()) const;
+    void write(DomXmlWriter &writer, const QString &tagName = QString()) const;
+    void read(QDataStream &stream);
+    void write(QDataStream &stream) const;
 
     // child element accessors
     inline QList<DomProperty *> elementProperty() const { return m_property; }
     void setElementProperty(const QList<DomProperty *> &a);
 
 private:
+    template <class Writer>
+    void writeXml(Writer &writer, const QString &tagName) const;
 
     // child element data
     uint m_children = 0;
@@ -2799,8 +3337,14 @@ public:
     DomSlots() = default;
     ~DomSlots();
 
+    static void *operator new(size_t size) { return DomArena::allocate(size); }
+    static void operator delete(void *pointer) noexcept { DomArena::deallocate(pointer); }
+
     void read(QXmlStreamReader &reader);
     void write(QXmlStreamWriter &writer, const QString &tagName = QString()) const;
+    void write(DomXmlWriter &writer, const QString &tagName = QString()) const;
+    void read(QDataStream &stream);
+    void write(QDataStream &stream) const;
 
     // child element accessors
     inline QStringList elementSignal() const { return m_signal; }
@@ -2810,6 +3354,8 @@ public:
     void setElementSlot(const QStringList &a);
 
 private:
+    template <class Writer>
+    void writeXml(Writer &writer, const QString &tagName) const;
 
     // child element data
     uint m_children = 0;
@@ -2828,8 +3374,14 @@ public:
     DomPropertySpecifications() = default;
     ~DomPropertySpecifications();
 
+    static void *operator new(size_t size) { return DomArena::allocate(size); }
+    static void operator delete(void *pointer) noexcept { DomArena::deallocate(pointer); }
+
     void read(QXmlStreamReader &reader);
     void write(QXmlStreamWriter &writer, const QString &tagName = QString()) const;
+    void write(DomXmlWriter &writer, const QString &tagName = QString()) const;
+    void read(QDataStream &stream);
+    void write(QDataStream &stream) const;
 
     // child element accessors
     inline QList<DomPropertyToolTip *> elementTooltip() const { return m_tooltip; }
@@ -2839,6 +3391,8 @@ public:
     void setElementStringpropertyspecification(const QList<DomStringPropertySpecification *> &a);
 
 private:
+    template <class Writer>
+    void writeXml(Writer &writer, const QString &tagName) const;
 
     // child element data
     uint m_children = 0;
@@ -2857,8 +3411,14 @@ public:
     DomPropertyToolTip() = default;
     ~DomPropertyToolTip();
 
+    static void *operator new(size_t size) { return DomArena::allocate(size); }
+    static void operator delete(void *pointer) noexcept { DomArena::deallocate(pointer); }
+
     void read(QXmlStreamReader &reader);
     void write(QXmlStreamWriter &writer, const QString &tagName = QString()) const;
+    void write(DomXmlWriter &writer, const QString &tagName = QString()) const;
+    void read(QDataStream &stream);
+    void write(QDataStream &stream) const;
 
     // attribute accessors
     inline bool hasAttributeName() const { return m_has_attr_name; }
@@ -2867,6 +3427,9 @@ public:
     inline void clearAttributeName() { m_has_attr_name = false; }
 
 private:
+    template <class Writer>
+    void writeXml(Writer &writer, const QString &tagName) const;
+
     // attribute data
     QString m_attr_name;
     bool m_has_attr_name = false;
@@ -2878,8 +3441,14 @@ public:
     DomStringPropertySpecification() = default;
     ~DomStringPropertySpecification();
 
+    static void *operator new(size_t size) { return DomArena::allocate(size); }
+    static void operator delete(void *pointer) noexcept { DomArena::deallocate(pointer); }
+
     void read(QXmlStreamReader &reader);
     void write(QXmlStreamWriter &writer, const QString &tagName = QString()) const;
+    void write(DomXmlWriter &writer, const QString &tagName = QString()) const;
+    void read(QDataStream &stream);
+    void write(QDataStream &stream) const;
 
     // attribute accessors
     inline bool hasAttributeName() const { return m_has_attr_name; }
@@ -2898,6 +3467,9 @@ public:
     inline void clearAttributeNotr() { m_has_attr_notr = false; }
 
 private:
+    template <class Writer>
+    void writeXml(Writer &writer, const QString &tagName) const;
+
     // attribute data
     QString m_attr_name;
     bool m_has_attr_name = false;
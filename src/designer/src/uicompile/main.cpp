@@ -0,0 +1,64 @@
+// Copyright (C) 2023 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
+
+#include <QtDesigner/QFormBuilder>
+
+#include <QtCore/qcommandlineparser.h>
+#include <QtCore/qcoreapplication.h>
+#include <QtCore/qfile.h>
+#include <QtCore/qsavefile.h>
+
+#include <cstdio>
+
+QT_USE_NAMESPACE
+
+// Writes .ui files as compiled forms, which QFormBuilder and QUiLoader
+// load without parsing XML.
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+    QCoreApplication::setApplicationVersion(QLatin1StringView(QT_VERSION_STR));
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription(
+        QStringLiteral("Qt User Interface Compiler for QFormBuilder version %1")
+            .arg(QCoreApplication::applicationVersion()));
+    parser.addHelpOption();
+    parser.addVersionOption();
+    const QCommandLineOption outputOption(QStringList{QStringLiteral("o"), QStringLiteral("output")},
+                                          QStringLiteral("Place the output into <file>."),
+                                          QStringLiteral("file"));
+    parser.addOption(outputOption);
+    parser.addPositionalArgument(QStringLiteral("uifile"), QStringLiteral("Input file."));
+    parser.process(app);
+
+    const QStringList positionalArguments = parser.positionalArguments();
+    if (positionalArguments.size() != 1 || !parser.isSet(outputOption))
+        parser.showHelp(1);
+
+    const QString inputFileName = positionalArguments.constFirst();
+    QFile input(inputFileName);
+    if (!input.open(QIODevice::ReadOnly)) {
+        std::fprintf(stderr, "uicompile: Cannot open %s: %s\n",
+                     qPrintable(inputFileName), qPrintable(input.errorString()));
+        return 1;
+    }
+
+    const QString outputFileName = parser.value(outputOption);
+    QSaveFile output(outputFileName);
+    if (!output.open(QIODevice::WriteOnly)) {
+        std::fprintf(stderr, "uicompile: Cannot open %s: %s\n",
+                     qPrintable(outputFileName), qPrintable(output.errorString()));
+        return 1;
+    }
+
+    QFormBuilder builder;
+    if (!builder.compile(&input, &output) || !output.commit()) {
+        const QString error = builder.errorString().isEmpty()
+            ? output.errorString() : builder.errorString();
+        std::fprintf(stderr, "uicompile: Cannot compile %s: %s\n",
+                     qPrintable(inputFileName), qPrintable(error));
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,498 @@
+// Copyright (C) 2023 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
+
+#include "distancefieldfontwriter.h"
+#include "distancefieldmodel.h"
+
+#include <QtCore/qmath.h>
+#include <QtCore/qendian.h>
+#include <QtCore/qbuffer.h>
+#include <QtCore/qfile.h>
+#include <QtCore/qsavefile.h>
+#include <QtCore/qvarlengtharray.h>
+
+#include <QtGui/private/qdistancefield_p.h>
+#include <QtQuick/private/qsgareaallocator_p.h>
+#include <QtQuick/private/qsgadaptationlayer_p.h>
+
+#include <cstddef>
+
+QT_BEGIN_NAMESPACE
+
+#   pragma pack(1)
+struct FontDirectoryHeader
+{
+    quint32 sfntVersion;
+    quint16 numTables;
+    quint16 searchRange;
+    quint16 entrySelector;
+    quint16 rangeShift;
+};
+
+struct TableRecord
+{
+    quint32 tag;
+    quint32 checkSum;
+    quint32 offset;
+    quint32 length;
+};
+
+struct QtdfHeader
+{
+    quint8 majorVersion;
+    quint8 minorVersion;
+    quint16 pixelSize;
+    quint32 textureSize;
+    quint8 flags;
+    quint8 padding;
+    quint32 numGlyphs;
+};
+
+struct QtdfGlyphRecord
+{
+    quint32 glyphIndex;
+    quint32 textureOffsetX;
+    quint32 textureOffsetY;
+    quint32 textureWidth;
+    quint32 textureHeight;
+    quint32 xMargin;
+    quint32 yMargin;
+    qint32 boundingRectX;
+    qint32 boundingRectY;
+    quint32 boundingRectWidth;
+    quint32 boundingRectHeight;
+    quint16 textureIndex;
+};
+
+struct QtdfTextureRecord
+{
+    quint32 allocatedX;
+    quint32 allocatedY;
+    quint32 allocatedWidth;
+    quint32 allocatedHeight;
+    quint8 padding;
+};
+
+struct Head
+{
+    quint16 majorVersion;
+    quint16 minorVersion;
+    quint32 fontRevision;
+    quint32 checkSumAdjustment;
+};
+#   pragma pack()
+
+#define PAD_BUFFER(buffer, size) \
+    { \
+        int paddingNeed = size % 4; \
+        if (paddingNeed > 0) { \
+            const char padding[3] = { 0, 0, 0 }; \
+            buffer.write(padding, 4 - paddingNeed); \
+        } \
+    }
+
+#define ALIGN_OFFSET(offset) \
+    { \
+        int paddingNeed = offset % 4; \
+        if (paddingNeed > 0) \
+            offset += 4 - paddingNeed; \
+    }
+
+#define TO_FIXED_POINT(value) \
+    ((int)(value*qreal(65536)))
+
+DistanceFieldFontWriter::DistanceFieldFontWriter(const DistanceFieldModel *model,
+                                                 const QList<glyph_t> &glyphs,
+                                                 quint32 maximumTextureSize)
+    : m_model(model)
+    , m_glyphs(glyphs)
+    , m_maximumTextureSize(maximumTextureSize)
+{
+}
+
+// Sums the data as 32 bit words, padding the last one with zeros
+static quint32 checkSum(const void *data, qsizetype length)
+{
+    const uchar *bytes = static_cast<const uchar *>(data);
+    quint32 sum = 0;
+    qsizetype i = 0;
+    for (; i + qsizetype(sizeof(quint32)) <= length; i += sizeof(quint32))
+        sum += qFromUnaligned<quint32>(bytes + i);
+    if (i < length) {
+        quint32 last = 0;
+        memcpy(&last, bytes + i, length - i);
+        sum += last;
+    }
+    return sum;
+}
+
+void DistanceFieldFontWriter::setError(const QString &title, const QString &errorString)
+{
+    m_errorTitle = title;
+    m_errorString = errorString;
+}
+
+bool DistanceFieldFontWriter::write(const QString &fontFile, const QString &fileName)
+{
+    if (m_glyphs.isEmpty()) {
+        setError(tr("Nothing to save"),
+                 tr("No glyphs selected for saving."));
+        return false;
+    }
+
+    QFile inFile(fontFile);
+    if (!inFile.open(QIODevice::ReadOnly)) {
+        setError(tr("Can't read original font"),
+                 tr("Cannot open '%1' for reading. The original font file must remain in place until the new file has been saved.").arg(fontFile));
+        return false;
+    }
+
+    const uchar *inData = inFile.map(0, inFile.size());
+    if (inData == nullptr) {
+        setError(tr("Can't map input file"),
+                 tr("Unable to memory map input file '%1'.").arg(fontFile));
+        return false;
+    }
+
+    const uchar *end = inData + inFile.size();
+    if (inData + sizeof(FontDirectoryHeader) > end) {
+        setError(tr("Can't read font directory"),
+                 tr("Input file seems to be invalid or corrupt."));
+        return false;
+    }
+
+    FontDirectoryHeader fontDirectoryHeader;
+    memcpy(&fontDirectoryHeader, inData, sizeof(FontDirectoryHeader));
+    quint16 numTables = qFromBigEndian(fontDirectoryHeader.numTables) + 1;
+    fontDirectoryHeader.numTables = qToBigEndian(numTables);
+    {
+        quint16 searchRange = qFromBigEndian(fontDirectoryHeader.searchRange);
+        if (searchRange / 16 < numTables) {
+            quint16 pot = (searchRange / 16) * 2;
+            searchRange = pot * 16;
+            fontDirectoryHeader.searchRange = qToBigEndian(searchRange);
+            fontDirectoryHeader.rangeShift = qToBigEndian(numTables * 16 - searchRange);
+
+            quint16 entrySelector = 0;
+            while (pot > 1) {
+                pot >>= 1;
+                entrySelector++;
+            }
+            fontDirectoryHeader.entrySelector = qToBigEndian(entrySelector);
+        }
+    }
+
+    // The file is written table by table from the original font, so the
+    // directory with the new offsets and the checksums are computed first
+    QByteArray directory;
+    directory.reserve(sizeof(FontDirectoryHeader) + sizeof(TableRecord) * numTables);
+    directory.append(reinterpret_cast<const char *>(&fontDirectoryHeader),
+                     sizeof(FontDirectoryHeader));
+
+    QVarLengthArray<QPair<quint32, quint32>> offsetLengthPairs;
+    offsetLengthPairs.reserve(numTables - 1);
+
+    // Copy the offset table, updating offsets
+    const TableRecord *offsetTable = reinterpret_cast<const TableRecord *>(inData + sizeof(FontDirectoryHeader));
+    if (reinterpret_cast<const uchar *>(offsetTable + numTables - 1) > end) {
+        setError(tr("Can't read font directory"),
+                 tr("Input file seems to be invalid or corrupt."));
+        return false;
+    }
+
+    int headIndex = -1;
+    quint32 currentOffset = sizeof(FontDirectoryHeader) + sizeof(TableRecord) * numTables;
+    for (int i = 0; i < numTables - 1; ++i) {
+        ALIGN_OFFSET(currentOffset)
+
+        quint32 originalOffset = qFromBigEndian(offsetTable->offset);
+        quint32 length = qFromBigEndian(offsetTable->length);
+        if (quint64(originalOffset) + length > quint64(inFile.size())) {
+            setError(tr("Can't read font table"),
+                     tr("Input file seems to be invalid or corrupt."));
+            return false;
+        }
+
+        offsetLengthPairs.append(qMakePair(originalOffset, length));
+        if (offsetTable->tag == qToBigEndian(MAKE_TAG('h', 'e', 'a', 'd')) && length >= sizeof(Head))
+            headIndex = i;
+
+        TableRecord newTableRecord;
+        memcpy(&newTableRecord, offsetTable, sizeof(TableRecord));
+        newTableRecord.offset = qToBigEndian(currentOffset);
+        directory.append(reinterpret_cast<const char *>(&newTableRecord), sizeof(TableRecord));
+
+        offsetTable++;
+        currentOffset += length;
+    }
+
+    if (headIndex < 0) {
+        setError(tr("Invalid font file"),
+                 tr("Font file does not have 'head' table."));
+        return false;
+    }
+
+    QByteArray qtdf = createSfntTable();
+    if (qtdf.isEmpty())
+        return false;
+
+    {
+        ALIGN_OFFSET(currentOffset)
+
+        TableRecord qtdfRecord;
+        qtdfRecord.offset = qToBigEndian(currentOffset);
+        qtdfRecord.length = qToBigEndian(qtdf.length());
+        qtdfRecord.tag = qToBigEndian(MAKE_TAG('q', 't', 'd', 'f'));
+        qtdfRecord.checkSum = qToBigEndian(checkSum(qtdf.constData(), qtdf.size()));
+
+        directory.append(reinterpret_cast<const char *>(&qtdfRecord), sizeof(TableRecord));
+    }
+
+    // All parts of the file start at a four byte boundary, so the checksum
+    // of the file is the sum of theirs. The 'head' checksum adjustment
+    // counts as zero.
+    const qsizetype checkSumAdjustmentOffset = offsetof(Head, checkSumAdjustment);
+    quint32 fileCheckSum = checkSum(directory.constData(), directory.size());
+    for (int i = 0; i < offsetLengthPairs.size(); ++i) {
+        const uchar *table = inData + offsetLengthPairs.at(i).first;
+        fileCheckSum += checkSum(table, offsetLengthPairs.at(i).second);
+        if (i == headIndex)
+            fileCheckSum -= qFromUnaligned<quint32>(table + checkSumAdjustmentOffset);
+    }
+    fileCheckSum += checkSum(qtdf.constData(), qtdf.size());
+    const quint32 checkSumAdjustment = qToBigEndian(0xB1B0AFBA - fileCheckSum);
+
+    QSaveFile outFile(fileName);
+    if (!outFile.open(QIODevice::WriteOnly)) {
+        setError(tr("Can't write to file"),
+                 tr("Cannot open the file '%1' for writing").arg(fileName));
+        return false;
+    }
+
+    outFile.write(directory);
+
+    // Copy all font tables
+    for (int i = 0; i < offsetLengthPairs.size(); ++i) {
+        PAD_BUFFER(outFile, outFile.pos())
+        const char *table = reinterpret_cast<const char *>(inData + offsetLengthPairs.at(i).first);
+        const quint32 length = offsetLengthPairs.at(i).second;
+        if (i == headIndex) {
+            outFile.write(table, checkSumAdjustmentOffset);
+            outFile.write(reinterpret_cast<const char *>(&checkSumAdjustment), sizeof(quint32));
+            outFile.write(table + checkSumAdjustmentOffset + sizeof(quint32),
+                          length - checkSumAdjustmentOffset - sizeof(quint32));
+        } else {
+            outFile.write(table, length);
+        }
+    }
+
+    PAD_BUFFER(outFile, outFile.pos())
+    outFile.write(qtdf);
+
+    if (!outFile.commit()) {
+        setError(tr("Can't write to file"),
+                 tr("Cannot write the file '%1': %2").arg(fileName, outFile.errorString()));
+        return false;
+    }
+    return true;
+}
+
+QByteArray DistanceFieldFontWriter::createSfntTable()
+{
+    const QList<glyph_t> &list = m_glyphs;
+    Q_ASSERT(!list.isEmpty());
+
+    QByteArray ret;
+    {
+        QBuffer buffer(&ret);
+        buffer.open(QIODevice::WriteOnly);
+
+        QtdfHeader header;
+        header.majorVersion = 5;
+        header.minorVersion = 12;
+        header.pixelSize = qToBigEndian(quint16(qRound(m_model->pixelSize())));
+
+        const quint8 padding = 2;
+        qreal scaleFactor = qreal(1) / QT_DISTANCEFIELD_SCALE(m_model->doubleGlyphResolution());
+        const int radius = QT_DISTANCEFIELD_RADIUS(m_model->doubleGlyphResolution())
+                / QT_DISTANCEFIELD_SCALE(m_model->doubleGlyphResolution());
+
+        quint32 textureSize = m_maximumTextureSize;
+
+        // Since we are using a single area allocator that spans all textures, we need
+        // to split the textures one row before the actual maximum size, otherwise
+        // glyphs that fall on the edge between two textures will expand the texture
+        // they are assigned to, and this will end up being larger than the max.
+        const quint32 rowHeight =
+                quint32(qCeil(m_model->pixelSize() * scaleFactor) + radius * 2 + padding * 2);
+        if (textureSize <= rowHeight) {
+            setError(tr("Texture too small"),
+                     tr("The texture size %1 must be larger than the height of a row of glyphs, %2.")
+                     .arg(textureSize).arg(rowHeight));
+            return QByteArray();
+        }
+        textureSize -= rowHeight;
+        header.textureSize = qToBigEndian(textureSize);
+
+        header.padding = padding;
+        header.flags = m_model->doubleGlyphResolution() ? 1 : 0;
+        header.numGlyphs = qToBigEndian(quint32(list.size()));
+        buffer.write(reinterpret_cast<char *>(&header),
+                     sizeof(QtdfHeader));
+
+        // Maximum height allocator to find optimal number of textures
+        QList<QRect> allocatedAreaPerTexture;
+
+        struct GlyphData {
+            QSGDistanceFieldGlyphCache::TexCoord texCoord;
+            QRectF boundingRect;
+            QSize glyphSize;
+            int textureIndex;
+        };
+        QList<GlyphData> glyphDatas;
+        glyphDatas.resize(m_model->rowCount());
+
+        int textureCount = 0;
+
+        {
+            QTransform scaleDown;
+            scaleDown.scale(scaleFactor, scaleFactor);
+
+            {
+                bool foundOptimalSize = false;
+                while (!foundOptimalSize) {
+                    allocatedAreaPerTexture.clear();
+
+                    QSGAreaAllocator allocator(QSize(textureSize, textureSize * (++textureCount)));
+
+                    int i;
+                    for (i = 0; i < list.size(); ++i) {
+                        int glyphIndex = int(list.at(i));
+                        GlyphData &glyphData = glyphDatas[glyphIndex];
+
+                        QPainterPath path = m_model->path(glyphIndex);
+                        glyphData.boundingRect = scaleDown.mapRect(path.boundingRect());
+                        int glyphWidth = qCeil(glyphData.boundingRect.width()) + radius * 2;
+                        int glyphHeight = qCeil(glyphData.boundingRect.height()) + radius * 2;
+
+                        glyphData.glyphSize = QSize(glyphWidth + padding * 2, glyphHeight + padding * 2);
+
+                        if (glyphData.glyphSize.width() > qint32(textureSize)
+                                || glyphData.glyphSize.height() > qint32(textureSize)) {
+                            setError(tr("Glyph too large for texture"),
+                                     tr("Glyph %1 is too large to fit in texture of size %2.")
+                                     .arg(glyphIndex).arg(textureSize));
+                            return QByteArray();
+                        }
+
+                        QRect rect = allocator.allocate(glyphData.glyphSize);
+                        if (rect.isNull())
+                            break;
+
+                        glyphData.textureIndex = rect.y() / textureSize;
+                        while (glyphData.textureIndex >= allocatedAreaPerTexture.size())
+                            allocatedAreaPerTexture.append(QRect(0, 0, 1, 1));
+
+                        allocatedAreaPerTexture[glyphData.textureIndex] |= QRect(rect.x(),
+                                                            rect.y() % textureSize,
+                                                            rect.width(),
+                                                            rect.height());
+
+                        glyphData.texCoord.xMargin = QT_DISTANCEFIELD_RADIUS(m_model->doubleGlyphResolution()) / qreal(QT_DISTANCEFIELD_SCALE(m_model->doubleGlyphResolution()));
+                        glyphData.texCoord.yMargin = QT_DISTANCEFIELD_RADIUS(m_model->doubleGlyphResolution()) / qreal(QT_DISTANCEFIELD_SCALE(m_model->doubleGlyphResolution()));
+                        glyphData.texCoord.x = rect.x() + padding;
+                        glyphData.texCoord.y = rect.y() % textureSize + padding;
+                        glyphData.texCoord.width = glyphData.boundingRect.width();
+                        glyphData.texCoord.height = glyphData.boundingRect.height();
+
+                        glyphDatas.append(glyphData);
+                    }
+
+                    foundOptimalSize = i == list.size();
+                    if (foundOptimalSize)
+                        buffer.write(allocator.serialize());
+                }
+            }
+        }
+
+        QList<QDistanceField> textures;
+        textures.resize(textureCount);
+
+        for (int textureIndex = 0; textureIndex < textureCount; ++textureIndex) {
+            textures[textureIndex] = QDistanceField(allocatedAreaPerTexture.at(textureIndex).width(),
+                                                    allocatedAreaPerTexture.at(textureIndex).height());
+
+            QRect rect = allocatedAreaPerTexture.at(textureIndex);
+
+            QtdfTextureRecord record;
+            record.allocatedX = qToBigEndian(rect.x());
+            record.allocatedY = qToBigEndian(rect.y());
+            record.allocatedWidth = qToBigEndian(rect.width());
+            record.allocatedHeight = qToBigEndian(rect.height());
+            record.padding = padding;
+            buffer.write(reinterpret_cast<char *>(&record),
+                         sizeof(QtdfTextureRecord));
+        }
+
+        {
+            for (int i = 0; i < list.size(); ++i) {
+                int glyphIndex = int(list.at(i));
+                QRect sourceRect;
+                const QImage &atlas = m_model->distanceFieldAtlas(glyphIndex, &sourceRect);
+
+                const GlyphData &glyphData = glyphDatas.at(glyphIndex);
+
+                QtdfGlyphRecord glyphRecord;
+                glyphRecord.glyphIndex = qToBigEndian(glyphIndex);
+                glyphRecord.textureOffsetX = qToBigEndian(TO_FIXED_POINT(glyphData.texCoord.x));
+                glyphRecord.textureOffsetY = qToBigEndian(TO_FIXED_POINT(glyphData.texCoord.y));
+                glyphRecord.textureWidth = qToBigEndian(TO_FIXED_POINT(glyphData.texCoord.width));
+                glyphRecord.textureHeight = qToBigEndian(TO_FIXED_POINT(glyphData.texCoord.height));
+                glyphRecord.xMargin = qToBigEndian(TO_FIXED_POINT(glyphData.texCoord.xMargin));
+                glyphRecord.yMargin = qToBigEndian(TO_FIXED_POINT(glyphData.texCoord.yMargin));
+                glyphRecord.boundingRectX = qToBigEndian(TO_FIXED_POINT(glyphData.boundingRect.x()));
+                glyphRecord.boundingRectY = qToBigEndian(TO_FIXED_POINT(glyphData.boundingRect.y()));
+                glyphRecord.boundingRectWidth = qToBigEndian(TO_FIXED_POINT(glyphData.boundingRect.width()));
+                glyphRecord.boundingRectHeight = qToBigEndian(TO_FIXED_POINT(glyphData.boundingRect.height()));
+                glyphRecord.textureIndex = qToBigEndian(quint16(glyphData.textureIndex));
+                buffer.write(reinterpret_cast<char *>(&glyphRecord), sizeof(QtdfGlyphRecord));
+
+                if (atlas.isNull())
+                    continue;
+
+                // Copy the rows of the glyph straight from the atlas, clearing
+                // the padding around it
+                int expectedWidth = qCeil(glyphData.texCoord.width + glyphData.texCoord.xMargin * 2);
+                const int copyWidth = qMin(expectedWidth, sourceRect.width());
+                const int paddedWidth = expectedWidth + padding * 2;
+                const int paddedHeight = sourceRect.height() + padding * 2;
+                QDistanceField &texture = textures[glyphData.textureIndex];
+                const int x = int(glyphData.texCoord.x) - padding;
+                const int y = int(glyphData.texCoord.y) - padding;
+                for (int row = 0; row < paddedHeight; ++row) {
+                    uchar *outBits = texture.scanLine(y + row) + x;
+                    memset(outBits, 0, paddedWidth);
+                    const int sourceRow = row - padding;
+                    if (sourceRow >= 0 && sourceRow < sourceRect.height()) {
+                        memcpy(outBits + padding,
+                               atlas.constScanLine(sourceRect.y() + sourceRow) + sourceRect.x(),
+                               copyWidth);
+                    }
+                }
+            }
+        }
+
+        for (int i = 0; i < textures.size(); ++i) {
+            const QDistanceField &texture = textures.at(i);
+            const QRect &allocatedArea = allocatedAreaPerTexture.at(i);
+            buffer.write(reinterpret_cast<const char *>(texture.constBits()),
+                       allocatedArea.width() * allocatedArea.height());
+        }
+
+        PAD_BUFFER(buffer, ret.size())
+    }
+
+    return ret;
+}
+
+QT_END_NAMESPACE
@@ -0,0 +1,44 @@
+// Copyright (C) 2023 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
+
+#ifndef DISTANCEFIELDFONTWRITER_H
+#define DISTANCEFIELDFONTWRITER_H
+
+#include <QCoreApplication>
+#include <QList>
+#include <QString>
+#include <QtGui/private/qtextengine_p.h>
+
+QT_BEGIN_NAMESPACE
+
+class DistanceFieldModel;
+
+// Writes a copy of a font file with a 'qtdf' table holding the
+// pre-generated distance fields of the given glyphs
+class DistanceFieldFontWriter
+{
+    Q_DECLARE_TR_FUNCTIONS(DistanceFieldFontWriter)
+public:
+    DistanceFieldFontWriter(const DistanceFieldModel *model,
+                            const QList<glyph_t> &glyphs,
+                            quint32 maximumTextureSize);
+
+    bool write(const QString &fontFile, const QString &fileName);
+
+    QString errorTitle() const { return m_errorTitle; }
+    QString errorString() const { return m_errorString; }
+
+private:
+    QByteArray createSfntTable();
+    void setError(const QString &title, const QString &errorString);
+
+    const DistanceFieldModel *m_model;
+    QList<glyph_t> m_glyphs;
+    quint32 m_maximumTextureSize;
+    QString m_errorTitle;
+    QString m_errorString;
+};
+
+QT_END_NAMESPACE
+
+#endif // DISTANCEFIELDFONTWRITER_H
@@ -12,6 +12,7 @@ QT_BEGIN_NAMESPACE
 DistanceFieldModel::DistanceFieldModel(QObject *parent)
     : QAbstractListModel(parent)
     , m_glyphCount(0)
+    , m_atlasRowHeight(0)
 {
     int index = metaObject()->indexOfEnumerator("UnicodeRange");
     Q_ASSERT(index >= 0);
@@ -29,12 +30,10 @@ DistanceFieldModel::DistanceFieldModel(QObject *parent)
             this, &DistanceFieldModel::startGeneration);
     connect(m_worker, &DistanceFieldModelWorker::fontLoaded,
             this, &DistanceFieldModel::reserveSpace);
-    connect(m_worker, &DistanceFieldModelWorker::distanceFieldGenerated,
-            this, &DistanceFieldModel::addDistanceField);
+    connect(m_worker, &DistanceFieldModelWorker::distanceFieldsGenerated,
+            this, &DistanceFieldModel::addDistanceFields);
     connect(m_worker, &DistanceFieldModelWorker::fontGenerated,
             this, &DistanceFieldModel::stopGeneration);
-    connect(m_worker, &DistanceFieldModelWorker::distanceFieldGenerated,
-            this, &DistanceFieldModel::distanceFieldGenerated);
     connect(m_worker, &DistanceFieldModelWorker::error,
             this, &DistanceFieldModel::error);
 
@@ -75,8 +74,8 @@ QVariant DistanceFieldModel::data(const QModelIndex &index, int role) const
         return QVariant();
 
     if (role == Qt::DecorationRole) {
-        if (index.row() < m_distanceFields.size()) {
-            return QPixmap::fromImage(m_distanceFields.at(index.row()).scaled(64, 64));
+        if (index.row() < m_atlasLocations.size() && m_atlasLocations.at(index.row()).page >= 0) {
+            return QPixmap::fromImage(distanceField(index.row()).scaled(64, 64));
         } else {
             return defaultImage;
         }
@@ -99,17 +98,21 @@ void DistanceFieldModel::reserveSpace(quint16 glyphCount,
 {
     beginResetModel();
     m_glyphsPerUnicodeRange.clear();
-    m_distanceFields.clear();
+    m_atlasPages.clear();
+    m_atlasLocations.clear();
+    m_atlasLocations.resize(glyphCount);
+    m_atlasPosition = QPoint();
+    m_atlasRowHeight = 0;
+    m_paths.clear();
+    m_paths.resize(glyphCount);
     m_glyphCount = glyphCount;
-    if (glyphCount > 0)
-        m_distanceFields.reserve(glyphCount);
     endResetModel();
 
     m_doubleGlyphResolution = doubleResolution;
     m_pixelSize = pixelSize;
 
     QMetaObject::invokeMethod(m_worker,
-                              [this] { m_worker->generateOneDistanceField(); },
+                              [this] { m_worker->generateDistanceFields(); },
                               Qt::QueuedConnection);
 }
 
@@ -144,29 +147,95 @@ QString DistanceFieldModel::nameForUnicodeRange(UnicodeRange range) const
     return QString::fromLatin1(m_rangeEnum.valueToKey(int(range)));
 }
 
-void DistanceFieldModel::addDistanceField(const QImage &distanceField,
-                                          const QPainterPath &path,
-                                          glyph_t glyphId,
-                                          quint32 ucs4)
+void DistanceFieldModel::addDistanceFields(const QList<GeneratedDistanceField> &distanceFields)
 {
-    if (glyphId >= quint16(m_distanceFields.size()))
-        m_distanceFields.resize(glyphId + 1);
-    m_distanceFields[glyphId] = distanceField;
-    if (glyphId >= quint16(m_paths.size()))
-        m_paths.resize(glyphId + 1);
-    m_paths[glyphId] = path;
+    if (distanceFields.isEmpty())
+        return;
+
+    glyph_t firstGlyphId = distanceFields.constFirst().glyphId;
+    glyph_t lastGlyphId = firstGlyphId;
+    for (const GeneratedDistanceField &distanceField : distanceFields) {
+        const glyph_t glyphId = distanceField.glyphId;
+        if (glyphId >= quint16(m_glyphCount))
+            continue;
+        addToAtlas(glyphId, distanceField.distanceField);
+        m_paths[glyphId] = distanceField.path;
+
+        if (distanceField.ucs4 != 0) {
+            UnicodeRange range = unicodeRangeForUcs4(distanceField.ucs4);
+            m_glyphsPerUnicodeRange.insert(range, glyphId);
+            m_glyphsPerUcs4.insert(distanceField.ucs4, glyphId);
+        }
 
-    if (ucs4 != 0) {
-        UnicodeRange range = unicodeRangeForUcs4(ucs4);
-        m_glyphsPerUnicodeRange.insert(range, glyphId);
-        m_glyphsPerUcs4.insert(ucs4, glyphId);
+        firstGlyphId = qMin(firstGlyphId, glyphId);
+        lastGlyphId = qMax(lastGlyphId, glyphId);
     }
 
-    emit dataChanged(createIndex(glyphId, 0), createIndex(glyphId, 0));
+    emit dataChanged(createIndex(firstGlyphId, 0), createIndex(lastGlyphId, 0));
+    emit distanceFieldsGenerated(int(distanceFields.size()));
+}
 
-    QMetaObject::invokeMethod(m_worker,
-                             [this] { m_worker->generateOneDistanceField(); },
-                             Qt::QueuedConnection);
+static const int atlasPageSize = 2048;
+
+void DistanceFieldModel::addToAtlas(glyph_t glyphId, const QImage &distanceField)
+{
+    AtlasLocation &location = m_atlasLocations[glyphId];
+    location = AtlasLocation();
+    if (distanceField.isNull())
+        return;
+
+    const QSize size = distanceField.size();
+    if (size.width() > atlasPageSize || size.height() > atlasPageSize) {
+        // Does not fit into a page, give it one of its own
+        location.page = int(m_atlasPages.size());
+        location.rect = QRect(QPoint(0, 0), size);
+        m_atlasPages.append(distanceField.convertToFormat(QImage::Format_Alpha8));
+        return;
+    }
+
+    if (m_atlasPosition.x() + size.width() > atlasPageSize) {
+        m_atlasPosition = QPoint(0, m_atlasPosition.y() + m_atlasRowHeight);
+        m_atlasRowHeight = 0;
+    }
+    if (m_atlasPages.isEmpty()
+            || m_atlasPages.constLast().size() != QSize(atlasPageSize, atlasPageSize)
+            || m_atlasPosition.y() + size.height() > atlasPageSize) {
+        QImage page(atlasPageSize, atlasPageSize, QImage::Format_Alpha8);
+        page.fill(0);
+        m_atlasPages.append(page);
+        m_atlasPosition = QPoint();
+        m_atlasRowHeight = 0;
+    }
+
+    location.page = int(m_atlasPages.size()) - 1;
+    location.rect = QRect(m_atlasPosition, size);
+
+    QImage &page = m_atlasPages.last();
+    for (int y = 0; y < size.height(); ++y) {
+        memcpy(page.scanLine(m_atlasPosition.y() + y) + m_atlasPosition.x(),
+               distanceField.constScanLine(y),
+               size.width());
+    }
+
+    m_atlasPosition.rx() += size.width();
+    m_atlasRowHeight = qMax(m_atlasRowHeight, size.height());
+}
+
+QImage DistanceFieldModel::distanceField(int row) const
+{
+    QRect rect;
+    const QImage &atlas = distanceFieldAtlas(row, &rect);
+    return atlas.isNull() ? QImage() : atlas.copy(rect);
+}
+
+// Returns the atlas page that holds the distance field of the glyph and
+// its area in the page. The page is null for empty glyphs.
+const QImage &DistanceFieldModel::distanceFieldAtlas(int row, QRect *rect) const
+{
+    static const QImage nullImage;
+    const AtlasLocation &location = m_atlasLocations.at(row);
+    *rect = location.rect;
+    return location.page >= 0 ? m_atlasPages.at(location.page) : nullImage;
 }
 
 glyph_t DistanceFieldModel::glyphIndexForUcs4(quint32 ucs4) const
@@ -4,6 +4,8 @@
 #ifndef DISTANCEFIELDMODEL_H
 #define DISTANCEFIELDMODEL_H
 
+#include "distancefieldmodelworker.h"
+
 #include <QAbstractListModel>
 #include <QRawFont>
 #include <QtGui/qpainterpath.h>
@@ -164,10 +166,8 @@ public:
     QString nameForUnicodeRange(UnicodeRange range) const;
     glyph_t glyphIndexForUcs4(quint32 ucs4) const;
 
-    QImage distanceField(int row) const
-    {
-        return m_distanceFields.at(row);
-    }
+    QImage distanceField(int row) const;
+    const QImage &distanceFieldAtlas(int row, QRect *rect) const;
 
     QPainterPath path(int row) const
     {
@@ -180,26 +180,34 @@ public:
 signals:
     void startGeneration(quint16 glyphCount);
     void stopGeneration();
-    void distanceFieldGenerated();
+    void distanceFieldsGenerated(int count);
     void error(const QString &errorString);
 
 private slots:
-    void addDistanceField(const QImage &distanceField,
-                          const QPainterPath &path,
-                          glyph_t glyphId,
-                          quint32 ucs4);
+    void addDistanceFields(const QList<GeneratedDistanceField> &distanceFields);
     void reserveSpace(quint16 glyphCount,
                       bool doubleResolution,
                       qreal pixelSize);
 
 private:
     UnicodeRange unicodeRangeForUcs4(quint32 ucs4) const;
+    void addToAtlas(glyph_t glyphId, const QImage &distanceField);
+
+    // The distance fields are packed into a few large images, row by row
+    struct AtlasLocation
+    {
+        int page = -1;
+        QRect rect;
+    };
 
     QRawFont m_font;
     DistanceFieldModelWorker *m_worker;
     QScopedPointer<QThread> m_workerThread;
     quint16 m_glyphCount;
-    QList<QImage> m_distanceFields;
+    QList<QImage> m_atlasPages;
+    QList<AtlasLocation> m_atlasLocations;
+    QPoint m_atlasPosition;
+    int m_atlasRowHeight;
     QList<QPainterPath> m_paths;
     QMultiHash<UnicodeRange, glyph_t> m_glyphsPerUnicodeRange;
     QHash<quint32, glyph_t> m_glyphsPerUcs4;
@@ -5,6 +5,7 @@
 
 #include "distancefieldmodel.h"
 #include <qendian.h>
+#include <QFile>
 #include <QtGui/private/qdistancefield_p.h>
 
 QT_BEGIN_NAMESPACE
@@ -83,11 +84,15 @@ struct SequentialMapGroup
 DistanceFieldModelWorker::DistanceFieldModelWorker(QObject *parent)
     : QObject(parent)
     , m_glyphCount(0)
-    , m_nextGlyphId(0)
     , m_doubleGlyphResolution(false)
 {
 }
 
+DistanceFieldModelWorker::~DistanceFieldModelWorker()
+{
+    cancelGeneration();
+}
+
 template <typename T>
 static void readCmapSubtable(DistanceFieldModelWorker *worker, const QByteArray &cmap, quint32 tableOffset, quint16 format)
 {
@@ -275,7 +280,6 @@ void DistanceFieldModelWorker::readCmap()
 
 void DistanceFieldModelWorker::readGlyphCount()
 {
-    m_nextGlyphId = 0;
     m_glyphCount = 0;
     if (m_font.isValid()) {
         QByteArray maxp = m_font.fontTable("maxp");
@@ -290,7 +294,16 @@ void DistanceFieldModelWorker::readGlyphCount()
 
 void DistanceFieldModelWorker::loadFont(const QString &fileName)
 {
-    m_font = QRawFont(fileName, 64);
+    cancelGeneration();
+
+    // The generator threads each need their own QRawFont, which they
+    // create from the data of the file
+    m_fontData.clear();
+    QFile file(fileName);
+    if (file.open(QIODevice::ReadOnly))
+        m_fontData = file.readAll();
+
+    m_font = QRawFont(m_fontData, 64);
     if (!m_font.isValid())
         emit error(tr("File '%1' is not a valid font file.").arg(fileName));
 
@@ -305,23 +318,66 @@ void DistanceFieldModelWorker::loadFont(const QString &fileName)
                     pixelSize);
 }
 
-void DistanceFieldModelWorker::generateOneDistanceField()
+// Number of glyphs generated by one task and delivered to the model at once
+static const glyph_t glyphsPerBatch = 128;
+
+void DistanceFieldModelWorker::generateDistanceFields()
 {
-    Q_ASSERT(m_nextGlyphId <= m_glyphCount);
+    cancelGeneration();
 
-    if (m_nextGlyphId == m_glyphCount) {
+    const int batchCount = int((m_glyphCount + glyphsPerBatch - 1) / glyphsPerBatch);
+    if (batchCount == 0) {
         emit fontGenerated();
         return;
     }
 
-    QPainterPath path = m_font.pathForGlyph(m_nextGlyphId);
-    QDistanceField distanceField(path, m_nextGlyphId, m_doubleGlyphResolution);
-    emit distanceFieldGenerated(distanceField.toImage(QImage::Format_Alpha8),
+    const int generation = m_generation.loadRelaxed();
+    const qreal pixelSize = m_font.pixelSize();
+    QSharedPointer<QAtomicInt> remaining(new QAtomicInt(batchCount));
+    for (int batch = 0; batch < batchCount; ++batch) {
+        const glyph_t firstGlyphId = glyph_t(batch) * glyphsPerBatch;
+        const glyph_t lastGlyphId = qMin(firstGlyphId + glyphsPerBatch, glyph_t(m_glyphCount));
+        m_threadPool.start([this, firstGlyphId, lastGlyphId, pixelSize, generation, remaining] {
+            generateDistanceFields(firstGlyphId, lastGlyphId, pixelSize, generation, remaining);
+        });
+    }
+}
+
+// Runs in the thread pool. The last batch to finish reports the end of
+// the generation, batches of a cancelled generation are dropped.
+void DistanceFieldModelWorker::generateDistanceFields(glyph_t firstGlyphId, glyph_t lastGlyphId,
+                                                      qreal pixelSize, int generation,
+                                                      const QSharedPointer<QAtomicInt> &remaining)
+{
+    QRawFont font(m_fontData, pixelSize);
+
+    QList<GeneratedDistanceField> distanceFields;
+    distanceFields.reserve(lastGlyphId - firstGlyphId);
+    for (glyph_t glyphId = firstGlyphId; glyphId < lastGlyphId; ++glyphId) {
+        if (m_generation.loadRelaxed() != generation)
+            return;
+
+        QPainterPath path = font.pathForGlyph(glyphId);
+        QDistanceField distanceField(path, glyphId, m_doubleGlyphResolution);
+        distanceFields.append({ distanceField.toImage(QImage::Format_Alpha8),
                                 path,
-                                m_nextGlyphId,
-                                m_cmapping.value(m_nextGlyphId));
+                                glyphId,
+                                m_cmapping.value(glyphId) });
+    }
+
+    if (m_generation.loadRelaxed() != generation)
+        return;
 
-    m_nextGlyphId++;
+    emit distanceFieldsGenerated(distanceFields);
+    if (!remaining->deref())
+        emit fontGenerated();
+}
+
+void DistanceFieldModelWorker::cancelGeneration()
+{
+    m_generation.ref();
+    m_threadPool.clear();
+    m_threadPool.waitForDone();
 }
 
 QT_END_NAMESPACE
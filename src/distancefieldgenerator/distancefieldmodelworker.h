@@ -6,6 +6,11 @@
 
 #include <QObject>
 #include <QRawFont>
+#include <QThreadPool>
+#include <QAtomicInt>
+#include <QSharedPointer>
+#include <QtGui/qimage.h>
+#include <QtGui/qpainterpath.h>
 #include <QtGui/private/qtextengine_p.h>
 
 QT_BEGIN_NAMESPACE
@@ -15,13 +20,23 @@ struct CmapSubtable4;
 struct CmapSubtable6;
 struct CmapSubtable10;
 struct CmapSubtable12;
+
+struct GeneratedDistanceField
+{
+    QImage distanceField;
+    QPainterPath path;
+    glyph_t glyphId;
+    quint32 ucs4;
+};
+
 class DistanceFieldModelWorker : public QObject
 {
     Q_OBJECT
 public:
     explicit DistanceFieldModelWorker(QObject *parent = nullptr);
+    ~DistanceFieldModelWorker() override;
 
-    Q_INVOKABLE void generateOneDistanceField();
+    Q_INVOKABLE void generateDistanceFields();
     Q_INVOKABLE void loadFont(const QString &fileName);
 
     void readCmapSubtable(const CmapSubtable0 *subtable, const void *end);
@@ -33,20 +48,22 @@ public:
 signals:
     void fontLoaded(quint16 glyphCount, bool doubleResolution, qreal pixelSize);
     void fontGenerated();
-    void distanceFieldGenerated(const QImage &distanceField,
-                                const QPainterPath &path,
-                                glyph_t glyphId,
-                                quint32 cmapAssignment);
+    void distanceFieldsGenerated(const QList<GeneratedDistanceField> &distanceFields);
     void error(const QString &errorString);
 
 private:
     void readGlyphCount();
     void readCmap();
+    void generateDistanceFields(glyph_t firstGlyphId, glyph_t lastGlyphId,
+                                qreal pixelSize, int generation, const QSharedPointer<QAtomicInt> &remaining);
+    void cancelGeneration();
 
+    QByteArray m_fontData;
     QRawFont m_font;
     quint16 m_glyphCount;
-    quint16 m_nextGlyphId;
     bool m_doubleGlyphResolution;
+    QThreadPool m_threadPool;
+    QAtomicInt m_generation;
     QHash<glyph_t, quint32> m_cmapping;
 };
 
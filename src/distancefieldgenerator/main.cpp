@@ -2,18 +2,113 @@
 // SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
 
 #include "mainwindow.h"
+#include "distancefieldmodel.h"
+#include "distancefieldfontwriter.h"
 
 #include <QApplication>
 #include <QCommandLineParser>
+#include <QEventLoop>
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
 
 QT_USE_NAMESPACE
 
+// With an output file, the fonts are generated without showing a window
+static bool isHeadless(int argc, char **argv)
+{
+    for (int i = 1; i < argc; ++i) {
+        if (!std::strcmp(argv[i], "-o") || !std::strcmp(argv[i], "--output")
+                || !std::strncmp(argv[i], "--output=", 9)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+static bool parseCodePoint(QString value, quint32 *ucs4)
+{
+    value = value.trimmed();
+    bool ok = false;
+    if (value.startsWith(QLatin1String("U+"), Qt::CaseInsensitive))
+        *ucs4 = value.mid(2).toUInt(&ok, 16);
+    else
+        *ucs4 = value.toUInt(&ok, 0);
+    return ok;
+}
+
+// Parses "first-last" or a single code point
+static bool parseRange(const QString &range, quint32 *first, quint32 *last)
+{
+    const qsizetype dash = range.indexOf(QLatin1Char('-'));
+    if (dash < 0) {
+        if (!parseCodePoint(range, first) || *first > quint32(QChar::LastValidCodePoint))
+            return false;
+        *last = *first;
+        return true;
+    }
+    return parseCodePoint(range.left(dash), first)
+            && parseCodePoint(range.mid(dash + 1), last)
+            && *first <= *last
+            && *last <= quint32(QChar::LastValidCodePoint);
+}
+
+static int generateFont(const QString &fontFile,
+                        const QString &outputFile,
+                        const QList<quint32> &characters,
+                        quint32 maximumTextureSize)
+{
+    DistanceFieldModel model;
+    bool failed = false;
+    QObject::connect(&model, &DistanceFieldModel::error, [&failed](const QString &errorString) {
+        std::fprintf(stderr, "%s\n", qPrintable(errorString));
+        failed = true;
+    });
+
+    QEventLoop loop;
+    QObject::connect(&model, &DistanceFieldModel::stopGeneration, &loop, &QEventLoop::quit);
+    model.setFont(fontFile);
+    loop.exec();
+    if (failed)
+        return 1;
+
+    QList<glyph_t> glyphs;
+    if (characters.isEmpty()) {
+        glyphs.reserve(model.rowCount());
+        for (int row = 0; row < model.rowCount(); ++row)
+            glyphs.append(glyph_t(row));
+    } else {
+        glyphs.reserve(characters.size());
+        for (quint32 ucs4 : characters) {
+            const glyph_t glyph = model.glyphIndexForUcs4(ucs4);
+            if (glyph != 0)
+                glyphs.append(glyph);
+        }
+        std::sort(glyphs.begin(), glyphs.end());
+        glyphs.erase(std::unique(glyphs.begin(), glyphs.end()), glyphs.end());
+    }
+
+    DistanceFieldFontWriter writer(&model, glyphs, maximumTextureSize);
+    if (!writer.write(fontFile, outputFile)) {
+        std::fprintf(stderr, "%s: %s\n",
+                     qPrintable(writer.errorTitle()), qPrintable(writer.errorString()));
+        return 1;
+    }
+    return 0;
+}
+
 int main(int argc, char **argv)
 {
-    QApplication app(argc, argv);
-    app.setOrganizationName(QStringLiteral("QtProject"));
-    app.setApplicationName(QStringLiteral("Qt Distance Field Generator"));
-    app.setApplicationVersion(QStringLiteral(QT_VERSION_STR));
+    const bool headless = isHeadless(argc, argv);
+    if (headless && !qEnvironmentVariableIsSet("QT_QPA_PLATFORM"))
+        qputenv("QT_QPA_PLATFORM", "offscreen");
+
+    QScopedPointer<QGuiApplication> app(headless ? new QGuiApplication(argc, argv)
+                                                 : new QApplication(argc, argv));
+    app->setOrganizationName(QStringLiteral("QtProject"));
+    app->setApplicationName(QStringLiteral("Qt Distance Field Generator"));
+    app->setApplicationVersion(QStringLiteral(QT_VERSION_STR));
 
     QCommandLineParser parser;
     parser.setApplicationDescription(
@@ -24,12 +119,80 @@ int main(int argc, char **argv)
     parser.addPositionalArgument(QLatin1String("file"),
                                  QCoreApplication::translate("main",
                                                              "Font file (*.ttf, *.otf)"));
-    parser.process(app);
+    const QCommandLineOption outputOption(
+                QStringList{QStringLiteral("o"), QStringLiteral("output")},
+                QCoreApplication::translate("main",
+                                            "Write the font to <file> without showing a window."),
+                QStringLiteral("file"));
+    parser.addOption(outputOption);
+    const QCommandLineOption rangeOption(
+                QStringLiteral("range"),
+                QCoreApplication::translate("main",
+                                            "Include the characters of <range>, for example "
+                                            "U+0020-U+007E. Can be given several times."),
+                QStringLiteral("range"));
+    parser.addOption(rangeOption);
+    const QCommandLineOption charactersOption(
+                QStringLiteral("characters"),
+                QCoreApplication::translate("main", "Include the characters of <string>."),
+                QStringLiteral("string"));
+    parser.addOption(charactersOption);
+    const QCommandLineOption textureSizeOption(
+                QStringLiteral("texture-size"),
+                QCoreApplication::translate("main",
+                                            "Maximum size of the textures (default: 2048)."),
+                QStringLiteral("size"),
+                QStringLiteral("2048"));
+    parser.addOption(textureSizeOption);
+    parser.process(*app);
+
+    if (!headless) {
+        MainWindow mainWindow;
+        if (!parser.positionalArguments().isEmpty())
+            mainWindow.open(parser.positionalArguments().constFirst());
+        mainWindow.show();
+
+        return app->exec();
+    }
+
+    if (parser.positionalArguments().size() != 1) {
+        std::fprintf(stderr, "%s\n",
+                     qPrintable(QCoreApplication::translate("main", "A font file is required.")));
+        parser.showHelp(1);
+    }
+
+    // Without characters, all glyphs of the font are written
+    QList<quint32> characters;
+    const QStringList ranges = parser.values(rangeOption);
+    for (const QString &range : ranges) {
+        quint32 first = 0;
+        quint32 last = 0;
+        if (!parseRange(range, &first, &last)) {
+            std::fprintf(stderr, "%s\n",
+                         qPrintable(QCoreApplication::translate("main", "Invalid range '%1'.")
+                                    .arg(range)));
+            return 1;
+        }
+        for (quint32 ucs4 = first; ucs4 <= last; ++ucs4)
+            characters.append(ucs4);
+    }
+    const QStringList strings = parser.values(charactersOption);
+    for (const QString &string : strings) {
+        for (uint ucs4 : string.toUcs4())
+            characters.append(ucs4);
+    }
 
-    MainWindow mainWindow;
-    if (!parser.positionalArguments().isEmpty())
-        mainWindow.open(parser.positionalArguments().constFirst());
-    mainWindow.show();
+    bool ok = false;
+    const quint32 textureSize = parser.value(textureSizeOption).toUInt(&ok);
+    if (!ok || textureSize < 64) {
+        std::fprintf(stderr, "%s\n",
+                     qPrintable(QCoreApplication::translate("main", "Invalid texture size '%1'.")
+                                .arg(parser.value(textureSizeOption))));
+        return 1;
+    }
 
-    return app.exec();
+    return generateFont(parser.positionalArguments().constFirst(),
+                        parser.value(outputOption),
+                        characters,
+                        textureSize);
 }
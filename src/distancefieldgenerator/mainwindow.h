@@ -33,7 +33,7 @@ private slots:
     void openFont();
     void startProgressBar(quint16 glyphCount);
     void stopProgressBar();
-    void updateProgressBar();
+    void updateProgressBar(int count);
     void selectAll();
     void updateSelection();
     void updateUnicodeRanges();
@@ -47,7 +47,6 @@ private slots:
 private:
     void setupConnections();
     void writeFile();
-    QByteArray createSfntTable();
 
     Ui::MainWindow *ui;
     QString m_fontDir;
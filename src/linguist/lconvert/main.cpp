@@ -1,16 +1,28 @@
 // Copyright (C) 2016 The Qt Company Ltd.
 // SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
 
+#include "trace.h"
 #include "translator.h"
+#include "tsstream.h"
 
 #include <QtCore/QCoreApplication>
 #include <QtCore/QDebug>
+#include <QtCore/QDir>
+#include <QtCore/QFile>
+#include <QtCore/QFileInfo>
 #include <QtCore/QString>
 #include <QtCore/QStringList>
 #include <QtCore/QTranslator>
 #include <QtCore/QLibraryInfo>
+#include <QtCore/QSaveFile>
+#include <QtCore/QSet>
 
+#include <atomic>
 #include <iostream>
+#include <memory>
+#include <thread>
+#include <utility>
+#include <vector>
 
 QT_USE_NAMESPACE
 
@@ -76,6 +88,9 @@ static int usage(const QStringList &args)
         "           Drop line numbers from references to UI files.\n\n"
         "    -verbose\n"
         "           be a bit more verbose\n\n"
+        "    -trace <file>\n"
+        "           Write where the time is spent to <file>, in the Chrome\n"
+        "           trace event JSON format.\n\n"
         "Long options can be specified with only one leading dash, too.\n\n"
         "Return value:\n"
         "    0 on success\n"
@@ -91,6 +106,230 @@ struct File
     QString format;
 };
 
+struct FilterOptions
+{
+    QString targetLanguage;
+    QString sourceLanguage;
+    bool dropTranslations = false;
+    bool noObsolete = false;
+    bool noFinished = false;
+    bool noUntranslated = false;
+    bool verbose = false;
+    bool noUiLines = false;
+    Translator::LocationsType locations = Translator::DefaultLocations;
+};
+
+static void filterMessages(Translator &tr, const FilterOptions &options)
+{
+    if (options.noObsolete)
+        tr.stripObsoleteMessages();
+    if (options.noFinished)
+        tr.stripFinishedMessages();
+    if (options.noUntranslated)
+        tr.stripUntranslatedMessages();
+    if (options.dropTranslations)
+        tr.dropTranslations();
+    if (options.noUiLines)
+        tr.dropUiLines();
+}
+
+/*
+    Converts a single TS file to TS one context at a time, so that only the
+    messages of one context are in memory at once. Returns -1 without doing
+    anything if the conversion needs the whole file, otherwise the exit code.
+    The output is the same as the one of the regular code path.
+*/
+static int convertTsStreaming(const File &inFile, const QString &outFileName,
+                              const QString &outFormat, const FilterOptions &options,
+                              ConversionData &cd)
+{
+    if (inFile.name.isEmpty() || inFile.name == QLatin1String("-") || cd.sortContexts()
+        || Translator::guessFormat(inFile.name, inFile.format) != QLatin1String("ts")
+        || Translator::guessFormat(outFileName, outFormat) != QLatin1String("ts")) {
+        return -1;
+    }
+
+    QFile in(inFile.name);
+    if (!in.open(QIODevice::ReadOnly))
+        return -1; // let the regular code path report the error
+    Translator::LocationsType locationsType;
+    if (!scanTSForStreaming(in, &locationsType) || !in.seek(0))
+        return -1;
+
+    TraceSpan span("io", "convertTsStreaming", inFile.name);
+
+    std::unique_ptr<QFileDevice> out;
+    if (outFileName.isEmpty() || outFileName == QLatin1String("-")) {
+        auto file = std::make_unique<QFile>();
+        if (!file->open(stdout, QIODevice::WriteOnly)) {
+            std::cerr << qPrintable(QString::fromLatin1("Cannot open stdout!? (%1)\n")
+                                    .arg(file->errorString()));
+            return 3;
+        }
+        out = std::move(file);
+    } else {
+        // Nothing is written if reading fails half-way.
+        auto file = std::make_unique<QSaveFile>(outFileName);
+        if (!file->open(QIODevice::WriteOnly)) {
+            std::cerr << qPrintable(QString::fromLatin1("Cannot create %1: %2\n")
+                                    .arg(outFileName, file->errorString()));
+            return 3;
+        }
+        out = std::move(file);
+    }
+
+    cd.m_sourceDir = QFileInfo(inFile.name).absoluteDir();
+    cd.m_sourceFileName = inFile.name;
+    cd.m_targetDir = QFileInfo(outFileName).absoluteDir();
+
+    Translator header;
+    header.setLanguageCode(Translator::guessLanguageCodeFromFileName(inFile.name));
+    TSStreamWriter writer(*out, cd);
+    bool headerWritten = false;
+    auto writeHeader = [&]() {
+        if (headerWritten)
+            return;
+        if (!options.targetLanguage.isEmpty())
+            header.setLanguageCode(options.targetLanguage);
+        if (!options.sourceLanguage.isEmpty())
+            header.setSourceLanguageCode(options.sourceLanguage);
+        header.setLocationsType(options.locations != Translator::DefaultLocations
+                                ? options.locations : locationsType);
+        writer.writeHeader(header);
+        headerWritten = true;
+    };
+
+    Translator dupesTor;
+    Translator::Duplicates dupes;
+    QString truncation;
+    Translator chunk;
+    QString chunkContext;
+    auto flushChunk = [&]() {
+        writeHeader();
+        const Translator::Duplicates chunkDupes = chunk.resolveDuplicates();
+        for (int i : chunkDupes.byId) {
+            dupes.byId.insert(dupesTor.messageCount());
+            dupesTor.append(chunk.message(i));
+        }
+        for (int i : chunkDupes.byContents) {
+            dupes.byContents.insert(dupesTor.messageCount());
+            dupesTor.append(chunk.message(i));
+        }
+        filterMessages(chunk, options);
+        chunk.setLanguageCode(header.languageCode());
+        ConversionData chunkCd;
+        chunk.normalizeTranslations(chunkCd);
+        if (truncation.isEmpty() && !chunkCd.errors().isEmpty())
+            truncation = chunkCd.errors().first();
+        writer.writeContext(chunkContext, chunk.messages());
+        chunk = Translator();
+    };
+
+    const bool ok = loadTS(header, in, cd, [&](const TranslatorMessage &msg) {
+        if (chunk.messageCount() && msg.context() != chunkContext)
+            flushChunk();
+        chunkContext = msg.context();
+        chunk.append(msg);
+    });
+    if (!ok) {
+        std::cerr << qPrintable(cd.error());
+        return 2;
+    }
+    if (chunk.messageCount())
+        flushChunk();
+    writeHeader();
+    writer.writeFooter();
+    dupesTor.reportDuplicates(dupes, inFile.name, options.verbose);
+
+    if (!truncation.isEmpty())
+        cd.appendError(truncation);
+    if (!cd.errors().isEmpty()) {
+        std::cerr << qPrintable(cd.error());
+        cd.clearErrors();
+    }
+
+    if (auto saveFile = qobject_cast<QSaveFile *>(out.get())) {
+        if (!saveFile->commit()) {
+            std::cerr << qPrintable(QString::fromLatin1("Cannot create %1: %2\n")
+                                    .arg(outFileName, saveFile->errorString()));
+            return 3;
+        }
+    }
+    return 0;
+}
+
+struct LoadResult
+{
+    Translator translator;
+    ConversionData cd;
+    Translator::Duplicates dupes;
+    bool ok = false;
+};
+
+/*
+    Loads the input files concurrently. The results are in the order of the
+    files, so that they can be merged and reported as if they had been loaded
+    one by one.
+*/
+static std::vector<LoadResult> loadFiles(const QList<File> &inFiles, const ConversionData &cd)
+{
+    std::vector<LoadResult> results(inFiles.size());
+    results.front().translator.setLanguageCode(
+                Translator::guessLanguageCodeFromFileName(inFiles.front().name));
+
+    std::atomic<qsizetype> nextFile = 0;
+    const qsizetype threadCount = qBound(qsizetype(1),
+                                         qsizetype(std::thread::hardware_concurrency()),
+                                         inFiles.size());
+    std::vector<std::thread> workers;
+    for (qsizetype i = 0; i < threadCount; ++i) {
+        workers.emplace_back([&inFiles, &cd, &results, &nextFile]() {
+            for (qsizetype k = nextFile++; k < inFiles.size(); k = nextFile++) {
+                LoadResult &result = results[k];
+                result.cd = cd;
+                result.cd.clearErrors();
+                result.ok = result.translator.load(inFiles.at(k).name, result.cd,
+                                                   inFiles.at(k).format);
+                if (result.ok)
+                    result.dupes = result.translator.resolveDuplicates();
+            }
+        });
+    }
+    for (std::thread &worker : workers)
+        worker.join();
+    return results;
+}
+
+static std::pair<QString, QString> locationKey(const TranslatorMessage &msg)
+{
+    return { msg.fileName(), msg.context() };
+}
+
+/*
+    Merges \a from into \a tr, messages of \a from taking precedence, like
+    Translator::replaceSorted() does one message at a time.
+
+    Finding the insertion point of a new message means scanning all messages
+    of \a tr for the ones with the same file and context. \a locationKeys
+    holds the file and context of each message \a tr has had, so that
+    messages of files and contexts it does not have, which are the bulk when
+    merging catalogs of different modules, are appended right away.
+*/
+static void mergeInto(Translator &tr, const Translator &from,
+                      QSet<std::pair<QString, QString>> *locationKeys)
+{
+    TraceSpan span("merge", "mergeInto");
+    for (int j = 0; j < from.messageCount(); ++j) {
+        const TranslatorMessage &msg = from.constMessage(j);
+        const auto key = locationKey(msg);
+        if (!locationKeys->contains(key) && tr.find(msg) < 0)
+            tr.append(msg);
+        else
+            tr.replaceSorted(msg);
+        locationKeys->insert(key);
+    }
+}
+
 int main(int argc, char *argv[])
 {
     QCoreApplication app(argc, argv);
@@ -115,6 +354,7 @@ int main(int argc, char *argv[])
     QString outFormat(QLatin1String("auto"));
     QString targetLanguage;
     QString sourceLanguage;
+    QString traceFile;
     bool dropTranslations = false;
     bool noObsolete = false;
     bool noFinished = false;
@@ -192,6 +432,10 @@ int main(int argc, char *argv[])
             noUiLines = true;
         } else if (args[i] == QLatin1String("-verbose")) {
             verbose = true;
+        } else if (args[i] == QLatin1String("-trace")) {
+            if (++i >= args.size())
+                return usage(args);
+            traceFile = args[i];
         } else if (args[i].startsWith(QLatin1Char('-'))) {
             return usage(args);
         } else {
@@ -205,39 +449,57 @@ int main(int argc, char *argv[])
     if (inFiles.isEmpty())
         return usage(args);
 
-    tr.setLanguageCode(Translator::guessLanguageCodeFromFileName(inFiles[0].name));
+    TraceSession traceSession;
+    QString errorString;
+    if (!traceFile.isEmpty() && !traceSession.start(traceFile, &errorString)) {
+        std::cerr << qPrintable(QString::fromLatin1("Cannot create %1: %2\n")
+                                .arg(traceFile, errorString));
+        return 3;
+    }
 
-    if (!tr.load(inFiles[0].name, cd, inFiles[0].format)) {
-        std::cerr << qPrintable(cd.error());
-        return 2;
+    FilterOptions options;
+    options.targetLanguage = targetLanguage;
+    options.sourceLanguage = sourceLanguage;
+    options.dropTranslations = dropTranslations;
+    options.noObsolete = noObsolete;
+    options.noFinished = noFinished;
+    options.noUntranslated = noUntranslated;
+    options.verbose = verbose;
+    options.noUiLines = noUiLines;
+    options.locations = locations;
+
+    if (inFiles.size() == 1) {
+        const int result = convertTsStreaming(inFiles[0], outFileName, outFormat, options, cd);
+        if (result >= 0)
+            return result;
     }
-    tr.reportDuplicates(tr.resolveDuplicates(), inFiles[0].name, verbose);
 
-    for (int i = 1; i < inFiles.size(); ++i) {
-        Translator tr2;
-        if (!tr2.load(inFiles[i].name, cd, inFiles[i].format)) {
+    std::vector<LoadResult> loaded = loadFiles(inFiles, cd);
+    QSet<std::pair<QString, QString>> locationKeys;
+    for (int i = 0; i < inFiles.size(); ++i) {
+        LoadResult &result = loaded[i];
+        for (const QString &error : result.cd.errors())
+            cd.appendError(error);
+        if (!result.ok) {
             std::cerr << qPrintable(cd.error());
             return 2;
         }
-        tr2.reportDuplicates(tr2.resolveDuplicates(), inFiles[i].name, verbose);
-        for (int j = 0; j < tr2.messageCount(); ++j)
-            tr.replaceSorted(tr2.message(j));
+        result.translator.reportDuplicates(result.dupes, inFiles[i].name, verbose);
+        if (i == 0) {
+            tr = std::move(result.translator);
+            for (int j = 0; j < tr.messageCount(); ++j)
+                locationKeys.insert(locationKey(tr.constMessage(j)));
+        } else {
+            mergeInto(tr, result.translator, &locationKeys);
+            result.translator = Translator();
+        }
     }
 
     if (!targetLanguage.isEmpty())
         tr.setLanguageCode(targetLanguage);
     if (!sourceLanguage.isEmpty())
         tr.setSourceLanguageCode(sourceLanguage);
-    if (noObsolete)
-        tr.stripObsoleteMessages();
-    if (noFinished)
-        tr.stripFinishedMessages();
-    if (noUntranslated)
-        tr.stripUntranslatedMessages();
-    if (dropTranslations)
-        tr.dropTranslations();
-    if (noUiLines)
-        tr.dropUiLines();
+    filterMessages(tr, options);
     if (locations != Translator::DefaultLocations)
         tr.setLocationsType(locations);
 
@@ -5,10 +5,17 @@
 #include "phrase.h"
 #include "messagemodel.h"
 
+#include <QtCore/QEventLoop>
+#include <QtCore/QHash>
 #include <QtCore/QMap>
+#include <QtCore/QTimer>
 #include <QtWidgets/QMessageBox>
 #include <QtWidgets/QProgressDialog>
 
+#include <atomic>
+#include <thread>
+#include <vector>
+
 QT_BEGIN_NAMESPACE
 
 CheckableListModel::CheckableListModel(QObject *parent)
@@ -78,47 +85,81 @@ void BatchTranslationDialog::startTranslation()
     setCursor(Qt::BusyCursor);
     int messageCount = m_dataModel->messageCount();
 
-    QProgressDialog *dlgProgress;
-    dlgProgress = new QProgressDialog(tr("Searching, please wait..."), tr("&Cancel"), 0, messageCount, this);
-    dlgProgress->show();
+    // A phrase of a book higher up in the user's list wins, and the first
+    // one of a book wins within it.
+    QHash<QString, QString> targets;
+    for (int b = 0; b < m_model.rowCount(); ++b) {
+        QModelIndex idx(m_model.index(b, 0));
+        QVariant checkState = m_model.data(idx, Qt::CheckStateRole);
+        if (checkState == Qt::Checked) {
+            PhraseBook *pb = m_phrasebooks[m_model.data(idx, Qt::UserRole).toInt()];
+            const auto phrases = pb->phrases();
+            for (const Phrase *ph : phrases) {
+                if (!targets.contains(ph->source()))
+                    targets.insert(ph->source(), ph->target());
+            }
+        }
+    }
 
-    int msgidx = 0;
+    QProgressDialog dlgProgress(tr("Searching, please wait..."), tr("&Cancel"), 0, messageCount,
+                                this);
+    dlgProgress.setWindowModality(Qt::WindowModal);
+    dlgProgress.show();
+
+    // The messages are matched on a worker thread. The models are not
+    // changed meanwhile, the dialogs are modal.
+    struct Match
+    {
+        MultiDataIndex index;
+        QString target;
+    };
+    std::vector<Match> matches;
+    std::atomic<int> visited = 0;
+    std::atomic<bool> canceled = false;
     const bool translateTranslated = m_ui.ckTranslateTranslated->isChecked();
     const bool translateFinished = m_ui.ckTranslateFinished->isChecked();
-    for (MultiDataModelIterator it(m_dataModel, m_modelIndex); it.isValid(); ++it) {
-        if (MessageItem *m = it.current()) {
-            if (!m->isObsolete()
+    QEventLoop loop;
+    std::thread worker([&] {
+        for (MultiDataModelIterator it(m_dataModel, m_modelIndex); it.isValid() && !canceled;
+             ++it, ++visited) {
+            const MessageItem *m = it.current();
+            if (m && !m->isObsolete()
                 && (translateTranslated || m->translation().isEmpty())
                 && (translateFinished || !m->isFinished())) {
-
-                // Go through them in the order the user specified in the phrasebookList
-                for (int b = 0; b < m_model.rowCount(); ++b) {
-                    QModelIndex idx(m_model.index(b, 0));
-                    QVariant checkState = m_model.data(idx, Qt::CheckStateRole);
-                    if (checkState == Qt::Checked) {
-                        PhraseBook *pb = m_phrasebooks[m_model.data(idx, Qt::UserRole).toInt()];
-                        const auto phrases = pb->phrases();
-                        for (const Phrase *ph : phrases) {
-                            if (ph->source() == m->text()) {
-                                m_dataModel->setTranslation(it, ph->target());
-                                m_dataModel->setFinished(it, m_ui.ckMarkFinished->isChecked());
-                                ++translatedcount;
-                                goto done; // break 2;
-                            }
-                        }
-                    }
-                }
+                const auto target = targets.constFind(m->text());
+                if (target != targets.cend())
+                    matches.push_back({ it, *target });
+            }
+        }
+        QMetaObject::invokeMethod(&loop, &QEventLoop::quit, Qt::QueuedConnection);
+    });
+    connect(&dlgProgress, &QProgressDialog::canceled, &loop, [&] { canceled = true; });
+    QTimer timer;
+    connect(&timer, &QTimer::timeout, &dlgProgress, [&] { dlgProgress.setValue(visited); });
+    timer.start(100);
+    loop.exec();
+    worker.join();
+    timer.stop();
+
+    // The translations are applied on this thread, which owns the models,
+    // in chunks between which the progress dialog is updated.
+    if (!canceled) {
+        dlgProgress.setLabelText(tr("Translating, please wait..."));
+        dlgProgress.setRange(0, int(matches.size()));
+        dlgProgress.setValue(0);
+        const bool markFinished = m_ui.ckMarkFinished->isChecked();
+        for (const Match &match : matches) {
+            m_dataModel->setTranslation(match.index, match.target);
+            m_dataModel->setFinished(match.index, markFinished);
+            if (!(++translatedcount & 255)) {
+                dlgProgress.setValue(translatedcount);
+                qApp->processEvents();
+                if (dlgProgress.wasCanceled())
+                    break;
             }
         }
-      done:
-        ++msgidx;
-        if (!(msgidx & 15))
-            dlgProgress->setValue(msgidx);
-        qApp->processEvents();
-        if (dlgProgress->wasCanceled())
-            break;
     }
-    dlgProgress->hide();
+    dlgProgress.hide();
 
     setCursor(oldCursor);
     emit finished();
@@ -460,8 +460,11 @@ static void highlightTargets(const QList<TranslatableEntry> &targets, bool on)
         highlightTarget(target, on);
 }
 
+// The number of forms kept hidden besides the shown one
+static const int MaxCachedForms = 8;
+
 FormPreviewView::FormPreviewView(QWidget *parent, MultiDataModel *dataModel)
-  : QMainWindow(parent), m_form(0), m_dataModel(dataModel)
+  : QMainWindow(parent), m_form(0), m_dataModel(dataModel), m_lastModel(-1)
 {
     m_mdiSubWindow = new QMdiSubWindow;
     m_mdiSubWindow->setWindowFlags(m_mdiSubWindow->windowFlags() & ~Qt::WindowSystemMenuHint);
@@ -470,6 +473,19 @@ FormPreviewView::FormPreviewView(QWidget *parent, MultiDataModel *dataModel)
     setCentralWidget(m_mdiArea);
     m_mdiArea->setHorizontalScrollBarPolicy(Qt::ScrollBarAsNeeded);
     m_mdiArea->setVerticalScrollBarPolicy(Qt::ScrollBarAsNeeded);
+
+    connect(m_dataModel, &MultiDataModel::translationChanged,
+            this, &FormPreviewView::retranslateMessage);
+    connect(m_dataModel, &MultiDataModel::modelDeleted,
+            this, &FormPreviewView::forgetModels);
+    connect(m_dataModel, &MultiDataModel::allModelsDeleted,
+            this, &FormPreviewView::clearCachedForms);
+}
+
+FormPreviewView::~FormPreviewView()
+{
+    clearCachedForms();
+    destroyTargets(&m_targets);
 }
 
 void FormPreviewView::setSourceContext(int model, MessageItem *messageItem)
@@ -482,47 +498,48 @@ void FormPreviewView::setSourceContext(int model, MessageItem *messageItem)
     QDir dir = QFileInfo(m_dataModel->srcFileName(model)).dir();
     QString fileName = QDir::cleanPath(dir.absoluteFilePath(messageItem->fileName()));
     if (m_lastFormName != fileName) {
-        delete m_form;
-        m_form = 0;
-        m_lastFormName.clear();
+        highlightTargets(m_highlights, false);
         m_highlights.clear();
-        destroyTargets(&m_targets);
-
-        static QUiLoader *uiLoader;
-        if (!uiLoader) {
-            uiLoader = new QUiLoader(this);
-            uiLoader->setLanguageChangeEnabled(true);
-            uiLoader->setTranslationEnabled(false);
-        }
+        cacheForm();
+
+        if (!restoreForm(fileName)) {
+            static QUiLoader *uiLoader;
+            if (!uiLoader) {
+                uiLoader = new QUiLoader(this);
+                uiLoader->setLanguageChangeEnabled(true);
+                uiLoader->setTranslationEnabled(false);
+            }
 
-        QFile file(fileName);
-        if (!file.open(QIODevice::ReadOnly)) {
-            qDebug() << "CANNOT OPEN FORM" << fileName;
-            m_mdiSubWindow->hide();
-            return;
-        }
-        m_form = uiLoader->load(&file, m_mdiSubWindow);
-        if (!m_form) {
-            qDebug() << "CANNOT LOAD FORM" << fileName;
-            m_mdiSubWindow->hide();
-            return;
+            QFile file(fileName);
+            if (!file.open(QIODevice::ReadOnly)) {
+                qDebug() << "CANNOT OPEN FORM" << fileName;
+                m_mdiSubWindow->hide();
+                return;
+            }
+            m_form = uiLoader->load(&file, m_mdiSubWindow);
+            if (!m_form) {
+                qDebug() << "CANNOT LOAD FORM" << fileName;
+                m_mdiSubWindow->hide();
+                return;
+            }
+            file.close();
+            buildTargets(m_form, &m_targets);
+
+            m_form->setWindowFlags(Qt::Widget);
+            m_form->setWindowModality(Qt::NonModal);
+            m_form->setFocusPolicy(Qt::NoFocus);
+            m_lastFormName = fileName;
+            m_lastClassName = messageItem->context();
+            m_lastModel = -1;
         }
-        file.close();
-        buildTargets(m_form, &m_targets);
 
         setToolTip(fileName);
 
-        m_form->setWindowFlags(Qt::Widget);
-        m_form->setWindowModality(Qt::NonModal);
-        m_form->setFocusPolicy(Qt::NoFocus);
         m_form->show(); // needed, otherwide the Qt::NoFocus is not propagated.
         m_mdiSubWindow->setWidget(m_form);
         m_mdiSubWindow->setWindowTitle(m_form->windowTitle());
         m_mdiSubWindow->show();
         m_mdiArea->cascadeSubWindows();
-        m_lastFormName = fileName;
-        m_lastClassName = messageItem->context();
-        m_lastModel = -1;
     } else {
         highlightTargets(m_highlights, false);
     }
@@ -540,4 +557,89 @@ void FormPreviewView::setSourceContext(int model, MessageItem *messageItem)
     highlightTargets(m_highlights, true);
 }
 
+/*
+    Hides the shown form and keeps it with its targets, so that it does not
+    have to be loaded again when a message of it is selected later.
+*/
+void FormPreviewView::cacheForm()
+{
+    if (!m_form)
+        return;
+
+    m_mdiSubWindow->setWidget(nullptr);
+    m_form->hide();
+    m_cachedForms.append({ m_lastFormName, m_lastClassName, m_form, m_targets, m_lastModel });
+    m_form = 0;
+    m_targets.clear();
+    m_lastFormName.clear();
+
+    if (m_cachedForms.size() > MaxCachedForms) {
+        CachedForm evicted = m_cachedForms.takeFirst();
+        destroyTargets(&evicted.targets);
+        delete evicted.form;
+    }
+}
+
+bool FormPreviewView::restoreForm(const QString &fileName)
+{
+    for (qsizetype i = m_cachedForms.size(); --i >= 0; ) {
+        if (m_cachedForms.at(i).fileName == fileName) {
+            const CachedForm cached = m_cachedForms.takeAt(i);
+            m_form = cached.form;
+            m_targets = cached.targets;
+            m_lastFormName = cached.fileName;
+            m_lastClassName = cached.className;
+            m_lastModel = cached.model;
+            return true;
+        }
+    }
+    return false;
+}
+
+void FormPreviewView::clearCachedForms()
+{
+    for (CachedForm &cached : m_cachedForms) {
+        destroyTargets(&cached.targets);
+        delete cached.form;
+    }
+    m_cachedForms.clear();
+}
+
+/*
+    Updates the widgets of the shown and the cached forms that show the
+    translation at \a index, which was just edited.
+*/
+void FormPreviewView::retranslateMessage(const MultiDataIndex &index)
+{
+    const MessageItem *m = m_dataModel->messageItem(index);
+    if (!m)
+        return;
+
+    QUiTranslatableStringValue tsv;
+    tsv.setValue(m->text().toUtf8());
+    tsv.setQualifier(m->comment().toUtf8());
+    const DataModel *dataModel = m_dataModel->model(index.model());
+    const auto retranslate = [&](const TargetsHash &targets, const QString &className,
+                                 int model) {
+        if (model != index.model() || className != m->context())
+            return;
+        const auto it = targets.constFind(tsv);
+        if (it != targets.cend())
+            retranslateTargets(*it, tsv, dataModel, className);
+    };
+
+    if (m_form)
+        retranslate(m_targets, m_lastClassName, m_lastModel);
+    for (const CachedForm &cached : qAsConst(m_cachedForms))
+        retranslate(cached.targets, cached.className, cached.model);
+}
+
+// The model numbers shifted, so all forms are retranslated when shown again.
+void FormPreviewView::forgetModels()
+{
+    m_lastModel = -1;
+    for (CachedForm &cached : m_cachedForms)
+        cached.model = -1;
+}
+
 QT_END_NAMESPACE
@@ -13,6 +13,7 @@
 
 QT_BEGIN_NAMESPACE
 
+class MultiDataIndex;
 class MultiDataModel;
 class FormFrame;
 class MessageItem;
@@ -67,10 +68,27 @@ class FormPreviewView : public QMainWindow
     Q_OBJECT
 public:
     FormPreviewView(QWidget *parent, MultiDataModel *dataModel);
+    ~FormPreviewView();
 
     void setSourceContext(int model, MessageItem *messageItem);
 
 private:
+    // A form that was shown before, kept hidden to be shown again
+    struct CachedForm
+    {
+        QString fileName;
+        QString className;
+        QWidget *form;
+        TargetsHash targets;
+        int model;
+    };
+
+    void cacheForm();
+    bool restoreForm(const QString &fileName);
+    void clearCachedForms();
+    void retranslateMessage(const MultiDataIndex &index);
+    void forgetModels();
+
     bool m_isActive;
     QString m_currentFileName;
     QMdiArea *m_mdiArea;
@@ -83,6 +101,8 @@ private:
     QString m_lastFormName;
     QString m_lastClassName;
     int m_lastModel;
+
+    QList<CachedForm> m_cachedForms; // the least recently shown first
 };
 
 QT_END_NAMESPACE
@@ -14,6 +14,7 @@
 #include "formpreviewview.h"
 #include "globals.h"
 #include "messageeditor.h"
+#include "messagefinder.h"
 #include "messagemodel.h"
 #include "phrasebookbox.h"
 #include "phrasemodel.h"
@@ -30,6 +31,7 @@
 #include <QCloseEvent>
 #include <QDebug>
 #include <QDockWidget>
+#include <QEventLoop>
 #include <QFile>
 #include <QFileDialog>
 #include <QFileInfo>
@@ -46,6 +48,7 @@
 #include <QPrintDialog>
 #include <QPrinter>
 #include <QProcess>
+#include <QProgressDialog>
 #include <QRegularExpression>
 #include <QScreen>
 #include <QShortcut>
@@ -54,12 +57,19 @@
 #include <QStackedWidget>
 #include <QStatusBar>
 #include <QTextStream>
+#include <QTimer>
 #include <QToolBar>
 #include <QUrl>
 #include <QWhatsThis>
 
 #include <ctype.h>
 
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <utility>
+#include <vector>
+
 QT_BEGIN_NAMESPACE
 
 static const int MessageMS = 2500;
@@ -266,6 +276,7 @@ MainWindow::MainWindow()
 
     m_dataModel = new MultiDataModel(this);
     m_messageModel = new MessageModel(this, m_dataModel);
+    m_finder = new MessageFinder(m_dataModel);
 
     // Set up the context dock widget
     m_contextDock = new QDockWidget(this);
@@ -439,6 +450,20 @@ MainWindow::MainWindow()
             this, &MainWindow::translationChanged);
     connect(m_dataModel, &MultiDataModel::languageChanged,
             this, &MainWindow::updatePhraseDict);
+    connect(m_dataModel, &MultiDataModel::messageDataChanged,
+            this, [this](const MultiDataIndex &index) {
+        m_finder->invalidateContext(index.context());
+    });
+    connect(m_dataModel, &MultiDataModel::translationChanged,
+            this, [this](const MultiDataIndex &index) {
+        m_finder->invalidateContext(index.context());
+    });
+    connect(m_dataModel, &MultiDataModel::modelAppended,
+            this, [this] { m_finder->invalidate(); });
+    connect(m_dataModel, &MultiDataModel::modelDeleted,
+            this, [this] { m_finder->invalidate(); });
+    connect(m_dataModel, &MultiDataModel::allModelsDeleted,
+            this, [this] { m_finder->invalidate(); });
 
     setWindowModified(m_dataModel->isModified());
     m_modifiedLabel->setVisible(m_dataModel->isModified());
@@ -489,6 +514,7 @@ MainWindow::~MainWindow()
         m_assistantProcess->waitForFinished(3000);
     }
     qDeleteAll(m_phraseBooks);
+    delete m_finder;
     delete m_dataModel;
     delete m_statistics;
     delete m_printer;
@@ -557,6 +583,55 @@ struct OpenedFile {
     bool langGuessed;
 };
 
+/*
+    Reads the files into the models on worker threads, while a progress dialog
+    keeps the GUI responsive. Returns false if the user canceled.
+*/
+static bool readFiles(const QList<DataModel *> &models, const QStringList &fileNames,
+                      QWidget *parent)
+{
+    if (models.isEmpty())
+        return true;
+
+    QProgressDialog progress(MainWindow::tr("Loading..."), MainWindow::tr("&Cancel"), 0,
+                             models.size() > 1 ? models.size() : 0, parent);
+    progress.setWindowModality(Qt::WindowModal);
+    progress.setMinimumDuration(500);
+    progress.setValue(0);
+
+    QEventLoop loop;
+    std::atomic<bool> canceled = false;
+    std::atomic<int> next = 0;
+    std::atomic<int> finished = 0; // files
+    std::atomic<int> done = 0; // threads
+    const int threadCount = std::clamp(int(std::thread::hardware_concurrency()), 1,
+                                       int(models.size()));
+    std::vector<std::thread> workers;
+    for (int t = 0; t < threadCount; ++t) {
+        workers.emplace_back([&] {
+            for (int i; !canceled && (i = next++) < models.size(); ) {
+                models.at(i)->read(fileNames.at(i));
+                ++finished;
+            }
+            if (++done == threadCount)
+                QMetaObject::invokeMethod(&loop, &QEventLoop::quit, Qt::QueuedConnection);
+        });
+    }
+    QObject::connect(&progress, &QProgressDialog::canceled, &loop, [&] {
+        canceled = true;
+    });
+    QTimer timer;
+    QObject::connect(&timer, &QTimer::timeout, &progress, [&] {
+        if (progress.maximum())
+            progress.setValue(finished);
+    });
+    timer.start(100);
+    loop.exec();
+    for (std::thread &worker : workers)
+        worker.join();
+    return !canceled;
+}
+
 bool MainWindow::openFiles(const QStringList &names, bool globalReadWrite)
 {
     if (names.isEmpty())
@@ -566,14 +641,9 @@ bool MainWindow::openFiles(const QStringList &names, bool globalReadWrite)
     statusBar()->showMessage(tr("Loading..."));
     qApp->processEvents();
 
-    QList<OpenedFile> opened;
-    bool closeOld = false;
+    QStringList fileNames;
+    QList<bool> readWrites;
     for (QString name : names) {
-        if (!waitCursor) {
-            QApplication::setOverrideCursor(Qt::WaitCursor);
-            waitCursor = true;
-        }
-
         bool readWrite = globalReadWrite;
         if (name.startsWith(QLatin1Char('='))) {
             name.remove(0, 1);
@@ -584,10 +654,32 @@ bool MainWindow::openFiles(const QStringList &names, bool globalReadWrite)
             name = fi.canonicalFilePath();
         if (m_dataModel->isFileLoaded(name) >= 0)
             continue;
+        fileNames << name;
+        readWrites << readWrite;
+    }
 
+    QList<DataModel *> models;
+    for (int i = 0; i < fileNames.size(); ++i)
+        models << new DataModel(m_dataModel);
+    if (!readFiles(models, fileNames, this)) {
+        qDeleteAll(models);
+        statusBar()->clearMessage();
+        return false;
+    }
+
+    QList<OpenedFile> opened;
+    bool closeOld = false;
+    for (int i = 0; i < fileNames.size(); ++i) {
+        if (!waitCursor) {
+            QApplication::setOverrideCursor(Qt::WaitCursor);
+            waitCursor = true;
+        }
+
+        const QString &name = fileNames.at(i);
+        const bool readWrite = readWrites.at(i);
+        DataModel *dm = std::exchange(models[i], nullptr);
         bool langGuessed;
-        DataModel *dm = new DataModel(m_dataModel);
-        if (!dm->load(name, &langGuessed, this)) {
+        if (!dm->finishLoading(&langGuessed, this)) {
             delete dm;
             continue;
         }
@@ -603,6 +695,7 @@ bool MainWindow::openFiles(const QStringList &names, bool globalReadWrite)
                 {
                     case QMessageBox::Cancel:
                         delete dm;
+                        qDeleteAll(models);
                         return false;
                     case QMessageBox::Yes:
                         closeOld = true;
@@ -624,6 +717,7 @@ bool MainWindow::openFiles(const QStringList &names, bool globalReadWrite)
                 {
                     case QMessageBox::Cancel:
                         delete dm;
+                        qDeleteAll(models);
                         for (const OpenedFile &op : qAsConst(opened))
                             delete op.dataModel;
                         return false;
@@ -821,22 +915,98 @@ void MainWindow::releaseAs()
 
     newFilename = QFileDialog::getSaveFileName(this, tr("Release"), newFilename,
         tr("Qt message files for released applications (*.qm)\nAll files (*)"));
-    if (!newFilename.isEmpty()) {
-        if (m_dataModel->release(m_currentIndex.model(), newFilename, false, false, SaveEverything, this))
-            statusBar()->showMessage(tr("File created."), MessageMS);
-    }
+    if (!newFilename.isEmpty())
+        releaseModels({ m_currentIndex.model() }, { newFilename });
 }
 
-void MainWindow::releaseInternal(int model)
-{
-    QFileInfo oldFile(m_dataModel->srcFileName(model));
-    QString newFilename = oldFile.path() + QLatin1Char('/')
-                + oldFile.completeBaseName() + QLatin1String(".qm");
+struct ReleaseJob {
+    Translator translator;
+    QString fileName;
+    QString errorString;
+    bool ok = false;
+};
 
-    if (!newFilename.isEmpty()) {
-        if (m_dataModel->release(model, newFilename, false, false, SaveEverything, this))
-            statusBar()->showMessage(tr("File created."), MessageMS);
+/*
+    Writes the .qm files on worker threads, while a progress dialog keeps the
+    GUI responsive. Files that are not written yet when the user cancels are
+    left alone. Returns false if the user canceled.
+*/
+static bool releaseFiles(QList<ReleaseJob> &jobs, QWidget *parent)
+{
+    QProgressDialog progress(MainWindow::tr("Releasing..."), MainWindow::tr("&Cancel"), 0,
+                             jobs.size() > 1 ? jobs.size() : 0, parent);
+    progress.setWindowModality(Qt::WindowModal);
+    progress.setMinimumDuration(500);
+    progress.setValue(0);
+
+    QEventLoop loop;
+    std::atomic<bool> canceled = false;
+    std::atomic<int> next = 0;
+    std::atomic<int> finished = 0; // files
+    std::atomic<int> done = 0; // threads
+    const int threadCount = std::clamp(int(std::thread::hardware_concurrency()), 1,
+                                       int(jobs.size()));
+    ReleaseJob *data = jobs.data();
+    std::vector<std::thread> workers;
+    for (int t = 0; t < threadCount; ++t) {
+        workers.emplace_back([&] {
+            for (int i; !canceled && (i = next++) < jobs.size(); ) {
+                ReleaseJob &job = data[i];
+                job.ok = DataModel::release(job.translator, job.fileName, false, false,
+                                            SaveEverything, &job.errorString, &canceled);
+                ++finished;
+            }
+            if (++done == threadCount)
+                QMetaObject::invokeMethod(&loop, &QEventLoop::quit, Qt::QueuedConnection);
+        });
     }
+    QObject::connect(&progress, &QProgressDialog::canceled, &loop, [&] {
+        canceled = true;
+    });
+    QTimer timer;
+    QObject::connect(&timer, &QTimer::timeout, &progress, [&] {
+        if (progress.maximum())
+            progress.setValue(finished);
+    });
+    timer.start(100);
+    loop.exec();
+    for (std::thread &worker : workers)
+        worker.join();
+    return !canceled;
+}
+
+void MainWindow::releaseModels(const QList<int> &models, const QStringList &fileNames)
+{
+    if (models.isEmpty())
+        return;
+
+    QList<ReleaseJob> jobs(models.size());
+    for (int i = 0; i < models.size(); ++i) {
+        jobs[i].translator = m_dataModel->releaseTranslator(models.at(i));
+        jobs[i].fileName = fileNames.at(i);
+    }
+
+    const bool completed = releaseFiles(jobs, this);
+
+    int created = 0;
+    for (const ReleaseJob &job : std::as_const(jobs)) {
+        if (job.ok)
+            ++created;
+        else if (!job.errorString.isEmpty())
+            QMessageBox::warning(this, tr("Qt Linguist"), job.errorString);
+    }
+    if (!completed)
+        statusBar()->showMessage(tr("Release canceled."), MessageMS);
+    else if (created == 1)
+        statusBar()->showMessage(tr("File created."), MessageMS);
+    else if (created > 1)
+        statusBar()->showMessage(tr("%n file(s) created.", 0, created), MessageMS);
+}
+
+static QString releaseFileName(const QString &srcFileName)
+{
+    QFileInfo oldFile(srcFileName);
+    return oldFile.path() + QLatin1Char('/') + oldFile.completeBaseName() + QLatin1String(".qm");
 }
 
 // No-question
@@ -845,14 +1015,21 @@ void MainWindow::release()
     if (m_currentIndex.model() < 0)
         return;
 
-    releaseInternal(m_currentIndex.model());
+    const int model = m_currentIndex.model();
+    releaseModels({ model }, { releaseFileName(m_dataModel->srcFileName(model)) });
 }
 
 void MainWindow::releaseAll()
 {
-    for (int i = 0; i < m_dataModel->modelCount(); ++i)
-        if (m_dataModel->isModelWritable(i))
-            releaseInternal(i);
+    QList<int> models;
+    QStringList fileNames;
+    for (int i = 0; i < m_dataModel->modelCount(); ++i) {
+        if (m_dataModel->isModelWritable(i)) {
+            models << i;
+            fileNames << releaseFileName(m_dataModel->srcFileName(i));
+        }
+    }
+    releaseModels(models, fileNames);
 }
 
 QPrinter *MainWindow::printer()
@@ -944,24 +1121,6 @@ void MainWindow::print()
     }
 }
 
-bool MainWindow::searchItem(DataModel::FindLocation where, const QString &searchWhat)
-{
-    if ((m_findWhere & where) == 0)
-        return false;
-
-    QString text = searchWhat;
-
-    if (m_findOptions.testFlag(FindDialog::IgnoreAccelerators))
-        // FIXME: This removes too much. The proper solution might be too slow, though.
-        text.remove(QLatin1Char('&'));
-
-    if (m_findOptions.testFlag(FindDialog::UseRegExp))
-        return m_findDialog->getRegExp().match(text).hasMatch();
-    else
-        return text.indexOf(m_findText, 0, m_findOptions.testFlag(FindDialog::MatchCase)
-                            ? Qt::CaseSensitive : Qt::CaseInsensitive) >= 0;
-}
-
 void MainWindow::findAgain(FindDirection direction)
 {
     if (m_dataModel->contextCount() == 0)
@@ -972,59 +1131,59 @@ void MainWindow::findAgain(FindDirection direction)
             ? nextMessage(startIndex)
             : prevMessage(startIndex));
 
+    // Have the contexts searched in the order they are visited below, so
+    // that the nearby hits are known early.
+    QList<int> contexts;
+    const int contextRows = m_sortedContextsModel->rowCount();
+    if (index.isValid()) {
+        QModelIndex startContext = m_sortedContextsModel->mapFromSource(
+                m_sortedMessagesModel->mapToSource(index));
+        if (startContext.parent().isValid())
+            startContext = startContext.parent();
+        for (int i = 0; i < contextRows; ++i) {
+            const int row = direction == FindNext
+                    ? (startContext.row() + i) % contextRows
+                    : (startContext.row() - i + contextRows) % contextRows;
+            contexts << m_sortedContextsModel->mapToSource(
+                            m_sortedContextsModel->index(row, 0)).row();
+        }
+    }
+    m_finder->start(contexts);
+
+    QProgressDialog progress(tr("Searching..."), tr("&Cancel"), 0, contextRows, m_findDialog);
+    progress.setWindowModality(Qt::WindowModal);
+    progress.setMinimumDuration(500);
+
     while (index.isValid()) {
         QModelIndex realIndex = m_sortedMessagesModel->mapToSource(index);
         MultiDataIndex dataIndex = m_messageModel->dataIndex(realIndex, -1);
-        bool hadMessage = false;
-        for (int i = 0; i < m_dataModel->modelCount(); ++i) {
-            if (MessageItem *m = m_dataModel->messageItem(dataIndex, i)) {
-                if (m_findStatusFilter != -1 && m_findStatusFilter != m->type())
-                    continue;
-
-                if (m_findOptions.testFlag(FindDialog::SkipObsolete)
-                        && m->isObsolete())
-                    continue;
-
-                bool found = true;
-                do {
-                    if (!hadMessage) {
-                        if (searchItem(DataModel::SourceText, m->text()))
-                            break;
-                        if (searchItem(DataModel::SourceText, m->pluralText()))
-                            break;
-                        if (searchItem(DataModel::Comments, m->comment()))
-                            break;
-                        if (searchItem(DataModel::Comments, m->extraComment()))
-                            break;
-                    }
-                    const auto translations = m->translations();
-                    for (const QString &trans : translations)
-                        if (searchItem(DataModel::Translations, trans))
-                            goto didfind;
-                    if (searchItem(DataModel::Comments, m->translatorComment()))
-                        break;
-                    found = false;
-                    // did not find the search string in this message
-                } while (0);
-                if (found) {
-                  didfind:
-                    setCurrentMessage(realIndex, i);
-
-                    // determine whether the search wrapped
-                    const QModelIndex &c1 = m_sortedContextsModel->mapFromSource(
-                            m_sortedMessagesModel->mapToSource(startIndex)).parent();
-                    const QModelIndex &c2 = m_sortedContextsModel->mapFromSource(realIndex).parent();
-                    const QModelIndex &m = m_sortedMessagesModel->mapFromSource(realIndex);
-
-                    if (c2.row() < c1.row() || (c1.row() == c2.row() && m.row() <= startIndex.row()))
-                        statusBar()->showMessage(tr("Search wrapped."), MessageMS);
-
-                    m_findDialog->hide();
-                    return;
-                }
-                hadMessage = true;
+        while (!m_finder->waitForContext(dataIndex.context(), 100)) {
+            if (!m_finder->isRunning())
+                m_finder->start(contexts);
+            progress.setValue(m_finder->searchedContextCount());
+            if (progress.wasCanceled()) {
+                m_finder->stop();
+                return;
             }
         }
+        const int model = m_finder->matchingModel(dataIndex.context(), dataIndex.message());
+        if (model >= 0) {
+            m_finder->stop();
+            progress.reset();
+            setCurrentMessage(realIndex, model);
+
+            // determine whether the search wrapped
+            const QModelIndex &c1 = m_sortedContextsModel->mapFromSource(
+                    m_sortedMessagesModel->mapToSource(startIndex)).parent();
+            const QModelIndex &c2 = m_sortedContextsModel->mapFromSource(realIndex).parent();
+            const QModelIndex &m = m_sortedMessagesModel->mapFromSource(realIndex);
+
+            if (c2.row() < c1.row() || (c1.row() == c2.row() && m.row() <= startIndex.row()))
+                statusBar()->showMessage(tr("Search wrapped."), MessageMS);
+
+            m_findDialog->hide();
+            return;
+        }
 
         // since we don't search startIndex at the beginning, only now we have searched everything
         if (index == startIndex)
@@ -1034,6 +1193,8 @@ void MainWindow::findAgain(FindDirection direction)
                     ? nextMessage(index)
                     : prevMessage(index));
     }
+    m_finder->stop();
+    progress.reset();
 
     qApp->beep();
     QMessageBox::warning(m_findDialog, tr("Qt Linguist"),
@@ -1042,10 +1203,10 @@ void MainWindow::findAgain(FindDirection direction)
 
 void MainWindow::showBatchTranslateDialog()
 {
-    m_messageModel->blockSignals(true);
+    m_messageModel->beginBatchUpdate();
     m_batchTranslateDialog->setPhraseBooks(m_phraseBooks, m_currentIndex.model());
     if (m_batchTranslateDialog->exec() != QDialog::Accepted)
-        m_messageModel->blockSignals(false);
+        m_messageModel->endBatchUpdate();
     // else signal finished() calls refreshItemViews()
 }
 
@@ -1082,7 +1243,7 @@ void MainWindow::translate(int mode)
             MessageItem *m = it.current();
             if (m && !m->isObsolete() && m->compare(findText, false, caseSensitivity)) {
                 if (!translatedCount)
-                    m_messageModel->blockSignals(true);
+                    m_messageModel->beginBatchUpdate();
                 m_dataModel->setTranslation(it, replaceText);
                 m_dataModel->setFinished(it, markFinished);
                 ++translatedCount;
@@ -1542,7 +1703,8 @@ void MainWindow::updateTranslation(const QStringList &translations)
     if (translations == m->translations())
         return;
 
-    m->setTranslations(translations);
+    m_dataModel->setTranslations(m_currentIndex, translations);
+    m_finder->invalidateContext(m_currentIndex.context());
     if (!m->fileName().isEmpty() && hasFormPreview(m->fileName()))
         m_formPreviewView->setSourceContext(m_currentIndex.model(), m);
     updateDanger(m_currentIndex, true);
@@ -1562,13 +1724,14 @@ void MainWindow::updateTranslatorComment(const QString &comment)
         return;
 
     m->setTranslatorComment(comment);
+    m_finder->invalidateContext(m_currentIndex.context());
 
     m_dataModel->setModified(m_currentIndex.model(), true);
 }
 
 void MainWindow::refreshItemViews()
 {
-    m_messageModel->blockSignals(false);
+    m_messageModel->endBatchUpdate();
     m_contextView->update();
     m_messageView->update();
     setWindowModified(m_dataModel->isModified());
@@ -1771,6 +1934,7 @@ void MainWindow::findNext(const QString &text, DataModel::FindLocation where,
                                                     ? QRegularExpression::NoPatternOption
                                                     : QRegularExpression::CaseInsensitiveOption);
     }
+    m_finder->setQuery(text, where, options, statusFilter, m_findDialog->getRegExp());
     m_ui.actionFindNext->setEnabled(true);
     m_ui.actionFindPrev->setEnabled(true);
     findAgain();
@@ -2759,8 +2923,8 @@ void MainWindow::maybeUpdateStatistics(const MultiDataIndex &index)
 
 void MainWindow::updateStatistics()
 {
-    // don't call this if stats dialog is not open
-    // because this can be slow...
+    // The counts are kept up to date by the models, so this is cheap,
+    // but there is nobody to tell if the dialog is not open.
     if (!m_statistics || !m_statistics->isVisible() || m_currentIndex.model() < 0)
         return;
 
@@ -36,6 +36,7 @@ class ErrorsView;
 class FocusWatcher;
 class FormPreviewView;
 class MessageEditor;
+class MessageFinder;
 class PhraseView;
 class SourceCodeView;
 class Statistics;
@@ -168,7 +169,7 @@ private:
     void updateSourceView(int model, MessageItem *item);
     void updatePhraseBookActions();
     void updatePhraseDictInternal(int model);
-    void releaseInternal(int model);
+    void releaseModels(const QList<int> &models, const QStringList &fileNames);
     void saveInternal(int model);
 
     QPrinter *printer();
@@ -176,7 +177,6 @@ private:
     // FIXME: move to DataModel
     void updateDanger(const MultiDataIndex &index, bool verbose);
 
-    bool searchItem(DataModel::FindLocation where, const QString &searchWhat);
 
     QProcess *m_assistantProcess;
     QTreeView *m_contextView;
@@ -202,6 +202,7 @@ private:
     QPrinter *m_printer;
 
     FindDialog *m_findDialog;
+    MessageFinder *m_finder;
     QString m_findText;
     FindDialog::FindOptions m_findOptions;
     int m_findStatusFilter = -1;
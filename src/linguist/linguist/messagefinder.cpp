@@ -0,0 +1,179 @@
+// Copyright (C) 2023 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
+
+#include "messagefinder.h"
+
+#include <algorithm>
+#include <chrono>
+
+QT_BEGIN_NAMESPACE
+
+void MessageFinder::setQuery(const QString &text, DataModel::FindLocation where,
+                             FindDialog::FindOptions options, int statusFilter,
+                             const QRegularExpression &regExp)
+{
+    invalidate();
+    m_where = where;
+    m_options = options;
+    m_statusFilter = statusFilter;
+    m_regExp = regExp;
+    // The matcher folds the case of the pattern once, instead of indexOf()
+    // doing it for every message.
+    m_matcher = QStringMatcher(text, options.testFlag(FindDialog::MatchCase)
+                               ? Qt::CaseSensitive : Qt::CaseInsensitive);
+}
+
+void MessageFinder::invalidate()
+{
+    stop();
+    m_hits.clear();
+    m_searched.clear();
+    m_searchedCount = 0;
+}
+
+void MessageFinder::invalidateContext(int context)
+{
+    stop();
+    if (context >= 0 && context < int(m_searched.size()) && m_searched[context]) {
+        m_searched[context] = false;
+        --m_searchedCount;
+    }
+}
+
+/*
+    Starts searching the \a contexts that have not been searched yet, in the
+    given order.
+*/
+void MessageFinder::start(const QList<int> &contexts)
+{
+    stop();
+    const size_t contextCount = m_dataModel->contextCount();
+    if (m_searched.size() != contextCount) {
+        m_hits.assign(contextCount, QList<int>());
+        m_searched.assign(contextCount, false);
+        m_searchedCount = 0;
+    }
+
+    for (int context : contexts) {
+        if (!m_searched[context])
+            m_queue << context;
+    }
+    if (m_queue.isEmpty())
+        return;
+
+    const int threadCount = std::clamp(int(std::thread::hardware_concurrency()), 1,
+                                       int(m_queue.size()));
+    for (int t = 0; t < threadCount; ++t)
+        m_workers.emplace_back([this] { run(); });
+}
+
+/*
+    Stops the workers, keeping the results of the contexts they searched.
+*/
+void MessageFinder::stop()
+{
+    m_stop = true;
+    for (std::thread &worker : m_workers)
+        worker.join();
+    m_workers.clear();
+    m_queue.clear();
+    m_next = 0;
+    m_stop = false;
+}
+
+/*
+    Waits up to \a msecs milliseconds for \a context to be searched and
+    returns whether it is.
+*/
+bool MessageFinder::waitForContext(int context, int msecs)
+{
+    std::unique_lock lock(m_mutex);
+    return m_searchedCondition.wait_for(lock, std::chrono::milliseconds(msecs),
+                                        [&] { return bool(m_searched[context]); });
+}
+
+void MessageFinder::run()
+{
+    // QRegularExpression compiles its pattern lazily, so each thread gets
+    // its own instead of sharing the compiled one.
+    const QRegularExpression regExp(m_regExp.pattern(), m_regExp.patternOptions());
+    for (int i; !m_stop && (i = m_next++) < m_queue.size(); ) {
+        const int context = m_queue.at(i);
+        QList<int> hits = searchContext(context, regExp);
+        {
+            std::lock_guard lock(m_mutex);
+            m_hits[context] = std::move(hits);
+            m_searched[context] = true;
+            ++m_searchedCount;
+        }
+        m_searchedCondition.notify_all();
+    }
+}
+
+QList<int> MessageFinder::searchContext(int context, const QRegularExpression &regExp) const
+{
+    const MultiContextItem *mc = m_dataModel->multiContextItem(context);
+    QList<int> hits;
+    hits.reserve(mc->messageCount());
+    for (int j = 0; j < mc->messageCount(); ++j)
+        hits << matchingModel(mc, j, regExp);
+    return hits;
+}
+
+/*
+    Returns the first model in which \a message matches, or -1. The source
+    text and comments are only looked at in the first model that has the
+    message and passes the filters, they are the same in all of them.
+*/
+int MessageFinder::matchingModel(const MultiContextItem *mc, int message,
+                                 const QRegularExpression &regExp) const
+{
+    bool hadMessage = false;
+    for (int i = 0; i < m_dataModel->modelCount(); ++i) {
+        const MessageItem *m = mc->messageItem(i, message);
+        if (!m)
+            continue;
+        if (m_statusFilter != -1 && m_statusFilter != m->type())
+            continue;
+        if (m_options.testFlag(FindDialog::SkipObsolete) && m->isObsolete())
+            continue;
+
+        if (!hadMessage) {
+            if (matches(DataModel::SourceText, m->text(), regExp)
+                || matches(DataModel::SourceText, m->pluralText(), regExp)
+                || matches(DataModel::Comments, m->comment(), regExp)
+                || matches(DataModel::Comments, m->extraComment(), regExp)) {
+                return i;
+            }
+        }
+        const auto translations = m->translations();
+        for (const QString &trans : translations) {
+            if (matches(DataModel::Translations, trans, regExp))
+                return i;
+        }
+        if (matches(DataModel::Comments, m->translatorComment(), regExp))
+            return i;
+        hadMessage = true;
+    }
+    return -1;
+}
+
+bool MessageFinder::matches(DataModel::FindLocation where, const QString &searchWhat,
+                            const QRegularExpression &regExp) const
+{
+    if ((m_where & where) == 0)
+        return false;
+
+    QString text = searchWhat;
+
+    if (m_options.testFlag(FindDialog::IgnoreAccelerators))
+        // FIXME: This removes too much. The proper solution might be too slow, though.
+        text.remove(QLatin1Char('&'));
+
+    if (m_options.testFlag(FindDialog::UseRegExp))
+        return regExp.match(text).hasMatch();
+    else
+        return m_matcher.indexIn(text) >= 0;
+}
+
+QT_END_NAMESPACE
@@ -0,0 +1,85 @@
+// Copyright (C) 2023 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
+
+#ifndef MESSAGEFINDER_H
+#define MESSAGEFINDER_H
+
+#include "finddialog.h"
+#include "messagemodel.h"
+
+#include <QtCore/QList>
+#include <QtCore/QRegularExpression>
+#include <QtCore/QString>
+#include <QtCore/QStringMatcher>
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+QT_BEGIN_NAMESPACE
+
+/*
+    Searches the messages of all open models for the text of the Find dialog.
+
+    The contexts are searched on worker threads in the order they are going
+    to be visited, and the first model in which each message matches is
+    remembered until the context is invalidated, so that repeated Find Next
+    only waits for contexts it has not seen yet.
+
+    The workers read the messages without locking, so they must be stopped
+    before the models are changed; the main window only runs them while it
+    is inside its find loop, and invalidating a context stops them.
+*/
+class MessageFinder
+{
+public:
+    explicit MessageFinder(MultiDataModel *dataModel) : m_dataModel(dataModel) {}
+    ~MessageFinder() { stop(); }
+
+    void setQuery(const QString &text, DataModel::FindLocation where,
+                  FindDialog::FindOptions options, int statusFilter,
+                  const QRegularExpression &regExp);
+    void invalidate();
+    void invalidateContext(int context);
+
+    void start(const QList<int> &contexts);
+    void stop();
+    bool isRunning() const { return !m_workers.empty(); }
+    bool waitForContext(int context, int msecs);
+    int searchedContextCount() const { return m_searchedCount; }
+    int matchingModel(int context, int message) const { return m_hits[context].at(message); }
+
+private:
+    void run();
+    QList<int> searchContext(int context, const QRegularExpression &regExp) const;
+    int matchingModel(const MultiContextItem *mc, int message,
+                      const QRegularExpression &regExp) const;
+    bool matches(DataModel::FindLocation where, const QString &searchWhat,
+                 const QRegularExpression &regExp) const;
+
+    MultiDataModel *m_dataModel; // not owned
+
+    QStringMatcher m_matcher;
+    QRegularExpression m_regExp;
+    DataModel::FindLocation m_where = DataModel::NoLocation;
+    FindDialog::FindOptions m_options;
+    int m_statusFilter = -1;
+
+    // Per context, the first matching model of each message; valid if searched
+    std::vector<QList<int>> m_hits;
+    std::vector<bool> m_searched;
+    std::atomic<int> m_searchedCount = 0;
+
+    QList<int> m_queue;
+    std::atomic<int> m_next = 0;
+    std::atomic<bool> m_stop = false;
+    std::vector<std::thread> m_workers;
+    std::mutex m_mutex;
+    std::condition_variable m_searchedCondition;
+};
+
+QT_END_NAMESPACE
+
+#endif // MESSAGEFINDER_H
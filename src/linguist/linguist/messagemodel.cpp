@@ -6,6 +6,7 @@
 
 #include <QtCore/QCoreApplication>
 #include <QtCore/QDebug>
+#include <QtCore/QSaveFile>
 
 #include <QtWidgets/QMessageBox>
 #include <QtGui/QPainter>
@@ -14,7 +15,9 @@
 
 #include <private/qtranslator_p.h>
 
+#include <algorithm>
 #include <limits.h>
+#include <utility>
 
 QT_BEGIN_NAMESPACE
 
@@ -26,12 +29,22 @@ QT_BEGIN_NAMESPACE
 
 MessageItem::MessageItem(const TranslatorMessage &message)
   : m_message(message),
-    m_danger(false)
+    m_danger(false),
+    m_hasFingerprint(false)
 {
     if (m_message.translation().isEmpty())
         m_message.setTranslation(QString());
 }
 
+const SimilarityFingerprint &MessageItem::similarityFingerprint() const
+{
+    if (!m_hasFingerprint) {
+        m_fingerprint = SimilarityFingerprint(m_message.sourceText());
+        m_hasFingerprint = true;
+    }
+    return m_fingerprint;
+}
+
 
 bool MessageItem::compare(const QString &findText, bool matchSubstring,
     Qt::CaseSensitivity cs) const
@@ -72,12 +85,17 @@ MessageItem *ContextItem::messageItem(int i) const
 
 MessageItem *ContextItem::findMessage(const QString &sourcetext, const QString &comment) const
 {
-    for (int i = 0; i < messageCount(); ++i) {
-        MessageItem *mi = messageItem(i);
-        if (mi->text() == sourcetext && mi->comment() == comment)
-            return mi;
+    if (m_messageIndex.isEmpty()) {
+        m_messageIndex.reserve(msgItemList.size());
+        for (int i = 0; i < msgItemList.size(); ++i) {
+            const MessageItem &mi = msgItemList.at(i);
+            const std::pair<QString, QString> key(mi.text(), mi.comment());
+            if (!m_messageIndex.contains(key))
+                m_messageIndex.insert(key, i);
+        }
     }
-    return 0;
+    const auto it = m_messageIndex.constFind(std::pair<QString, QString>(sourcetext, comment));
+    return it == m_messageIndex.cend() ? 0 : messageItem(*it);
 }
 
 /******************************************************************************
@@ -93,6 +111,7 @@ DataModel::DataModel(QObject *parent)
     m_srcWords(0),
     m_srcChars(0),
     m_srcCharsSpc(0),
+    m_stats(),
     m_language(QLocale::Language(-1)),
     m_sourceLanguage(QLocale::Language(-1)),
     m_country(QLocale::Country(-1)),
@@ -121,12 +140,8 @@ MessageItem *DataModel::messageItem(const DataIndex &index) const
 
 ContextItem *DataModel::findContext(const QString &context) const
 {
-    for (int c = 0; c < m_contextList.count(); ++c) {
-        ContextItem *ctx = contextItem(c);
-        if (ctx->context() == context)
-            return ctx;
-    }
-    return 0;
+    const auto it = m_contextIndex.constFind(context);
+    return it == m_contextIndex.cend() ? 0 : contextItem(*it);
 }
 
 MessageItem *DataModel::findMessage(const QString &context,
@@ -163,18 +178,31 @@ bool DataModel::isWellMergeable(const DataModel *other) const
 
 bool DataModel::load(const QString &fileName, bool *langGuessed, QWidget *parent)
 {
+    read(fileName);
+    return finishLoading(langGuessed, parent);
+}
+
+/*
+    Reads the file and builds the contexts and messages from it. This does not
+    touch the GUI, so it may run on a worker thread; finishLoading() reports
+    the problems found and sets up the languages afterwards.
+*/
+bool DataModel::read(const QString &fileName)
+{
+    m_loadState = LoadState();
+
     Translator tor;
     ConversionData cd;
     bool ok = tor.load(fileName, cd, QLatin1String("auto"));
     if (!ok) {
-        QMessageBox::warning(parent, QObject::tr("Qt Linguist"), cd.error());
+        m_loadState.error = cd.error();
         return false;
     }
 
     if (!tor.messageCount()) {
-        QMessageBox::warning(parent, QObject::tr("Qt Linguist"),
-                             tr("The translation file '%1' will not be loaded because it is empty.")
-                             .arg(fileName.toHtmlEscaped()));
+        m_loadState.error =
+                tr("The translation file '%1' will not be loaded because it is empty.")
+                .arg(fileName.toHtmlEscaped());
         return false;
     }
 
@@ -201,28 +229,28 @@ bool DataModel::load(const QString &fileName, bool *langGuessed, QWidget *parent
                 err += tr("<br>* Comment: %3").arg(msg.comment().toHtmlEscaped());
         }
       doWarn:
-        QMessageBox::warning(parent, QObject::tr("Qt Linguist"), err);
+        m_loadState.warning = err;
     }
 
     m_srcFileName = fileName;
     m_relativeLocations = (tor.locationsType() == Translator::RelativeLocations);
     m_extra = tor.extras();
     m_contextList.clear();
+    m_contextIndex.clear();
     m_numMessages = 0;
 
-    QHash<QString, int> contexts;
-
     m_srcWords = 0;
     m_srcChars = 0;
     m_srcCharsSpc = 0;
+    m_stats = StatisticalData();
 
     for (const TranslatorMessage &msg : tor.messages()) {
-        if (!contexts.contains(msg.context())) {
-            contexts.insert(msg.context(), m_contextList.size());
+        if (!m_contextIndex.contains(msg.context())) {
+            m_contextIndex.insert(msg.context(), m_contextList.size());
             m_contextList.append(ContextItem(msg.context()));
         }
 
-        ContextItem *c = contextItem(contexts.value(msg.context()));
+        ContextItem *c = contextItem(m_contextIndex.value(msg.context()));
         if (msg.sourceText() == QLatin1String(ContextComment)) {
             c->appendToComment(msg.comment());
         } else {
@@ -235,10 +263,30 @@ bool DataModel::load(const QString &fileName, bool *langGuessed, QWidget *parent
                 c->incrementNonobsoleteCount();
             }
             c->appendMessage(tmp);
+            addToStatistics(tmp);
             ++m_numMessages;
         }
     }
 
+    m_loadState.ok = true;
+    m_loadState.languageCode = tor.languageCode();
+    m_loadState.sourceLanguageCode = tor.sourceLanguageCode();
+    return true;
+}
+
+/*
+    Completes loading the file read by read(), on the GUI thread.
+*/
+bool DataModel::finishLoading(bool *langGuessed, QWidget *parent)
+{
+    const LoadState state = std::exchange(m_loadState, LoadState());
+    if (!state.ok) {
+        QMessageBox::warning(parent, QObject::tr("Qt Linguist"), state.error);
+        return false;
+    }
+    if (!state.warning.isEmpty())
+        QMessageBox::warning(parent, QObject::tr("Qt Linguist"), state.warning);
+
     // Try to detect the correct language in the following order
     // 1. Look for the language attribute in the ts
     //   if that fails
@@ -247,9 +295,9 @@ bool DataModel::load(const QString &fileName, bool *langGuessed, QWidget *parent
     //   if that fails
     // 3. Retrieve the locale from the system.
     *langGuessed = false;
-    QString lang = tor.languageCode();
+    QString lang = state.languageCode;
     if (lang.isEmpty()) {
-        lang = QFileInfo(fileName).baseName();
+        lang = QFileInfo(m_srcFileName).baseName();
         int pos = lang.indexOf(QLatin1Char('_'));
         if (pos != -1)
             lang.remove(0, pos + 1);
@@ -275,7 +323,7 @@ bool DataModel::load(const QString &fileName, bool *langGuessed, QWidget *parent
     // 1. Look for the language attribute in the ts
     //   if that fails
     // 2. Assume English
-    lang = tor.sourceLanguageCode();
+    lang = state.sourceLanguageCode;
     if (lang.isEmpty()) {
         l = QLocale::C;
         c = QLocale::AnyCountry;
@@ -318,28 +366,51 @@ bool DataModel::saveAs(const QString &newFileName, QWidget *parent)
     return true;
 }
 
-bool DataModel::release(const QString &fileName, bool verbose, bool ignoreUnfinished,
-    TranslatorSaveMode mode, QWidget *parent)
+/*
+    Returns the translator that release() writes. It is a copy of the messages,
+    so it can be released on another thread while the model is edited.
+*/
+Translator DataModel::releaseTranslator()
 {
-    QFile file(fileName);
-    if (!file.open(QIODevice::WriteOnly)) {
-        QMessageBox::warning(parent, QObject::tr("Qt Linguist"),
-            tr("Cannot create '%2': %1").arg(file.errorString()).arg(fileName));
-        return false;
-    }
     Translator tor;
     QLocale locale(m_language, m_country);
     tor.setLanguageCode(locale.name());
     for (DataModelIterator it(this); it.isValid(); ++it)
         tor.append(it.current()->message());
+    return tor;
+}
+
+/*
+    Writes \a tor as a .qm file. This does not touch any model and can run on
+    any thread. If \a canceled becomes true while the file is written, it is
+    discarded and the previous file, if any, is kept.
+*/
+bool DataModel::release(const Translator &tor, const QString &fileName, bool verbose,
+    bool ignoreUnfinished, TranslatorSaveMode mode, QString *errorString,
+    const std::atomic<bool> *canceled)
+{
+    QSaveFile file(fileName);
+    if (!file.open(QIODevice::WriteOnly)) {
+        *errorString = tr("Cannot create '%2': %1").arg(file.errorString()).arg(fileName);
+        return false;
+    }
     ConversionData cd;
     cd.m_verbose = verbose;
     cd.m_ignoreUnfinished = ignoreUnfinished;
     cd.m_saveMode = mode;
-    bool ok = saveQM(tor, file, cd);
-    if (!ok)
-        QMessageBox::warning(parent, QObject::tr("Qt Linguist"), cd.error());
-    return ok;
+    if (!saveQM(tor, file, cd)) {
+        *errorString = cd.error();
+        return false;
+    }
+    if (canceled && *canceled) {
+        file.cancelWriting();
+        return false;
+    }
+    if (!file.commit()) {
+        *errorString = tr("Cannot create '%2': %1").arg(file.errorString()).arg(fileName);
+        return false;
+    }
+    return true;
 }
 
 void DataModel::doCharCounting(const QString &text, int &trW, int &trC, int &trCS)
@@ -400,35 +471,52 @@ void DataModel::setSourceLanguageAndCountry(QLocale::Language lang, QLocale::Cou
     setModified(true);
 }
 
-void DataModel::updateStatistics()
+/*
+    Adds the contribution of \a m to the statistics if \a sign is 1, or
+    takes it away if it is -1.
+*/
+void DataModel::countMessage(const MessageItem &m, int sign)
 {
     StatisticalData stats {};
-    for (DataModelIterator it(this); it.isValid(); ++it) {
-        const MessageItem *mi = it.current();
-        if (mi->isObsolete()) {
-            stats.obsoleteMsg++;
-        } else if (mi->isFinished()) {
-            bool hasDanger = false;
-            for (const QString &trnsl : mi->translations()) {
-                doCharCounting(trnsl, stats.wordsFinished, stats.charsFinished, stats.charsSpacesFinished);
-                hasDanger |= mi->danger();
-            }
-            if (hasDanger)
-                stats.translatedMsgDanger++;
-            else
-                stats.translatedMsgNoDanger++;
-        } else if (mi->isUnfinished()) {
-            bool hasDanger = false;
-            for (const QString &trnsl : mi->translations()) {
-                doCharCounting(trnsl, stats.wordsUnfinished, stats.charsUnfinished, stats.charsSpacesUnfinished);
-                hasDanger |= mi->danger();
-            }
-            if (hasDanger)
-                stats.unfinishedMsgDanger++;
-            else
-                stats.unfinishedMsgNoDanger++;
+    if (m.isObsolete()) {
+        stats.obsoleteMsg++;
+    } else if (m.isFinished()) {
+        bool hasDanger = false;
+        for (const QString &trnsl : m.translations()) {
+            doCharCounting(trnsl, stats.wordsFinished, stats.charsFinished, stats.charsSpacesFinished);
+            hasDanger |= m.danger();
+        }
+        if (hasDanger)
+            stats.translatedMsgDanger++;
+        else
+            stats.translatedMsgNoDanger++;
+    } else if (m.isUnfinished()) {
+        bool hasDanger = false;
+        for (const QString &trnsl : m.translations()) {
+            doCharCounting(trnsl, stats.wordsUnfinished, stats.charsUnfinished, stats.charsSpacesUnfinished);
+            hasDanger |= m.danger();
         }
+        if (hasDanger)
+            stats.unfinishedMsgDanger++;
+        else
+            stats.unfinishedMsgNoDanger++;
     }
+    m_stats.wordsFinished += sign * stats.wordsFinished;
+    m_stats.charsFinished += sign * stats.charsFinished;
+    m_stats.charsSpacesFinished += sign * stats.charsSpacesFinished;
+    m_stats.wordsUnfinished += sign * stats.wordsUnfinished;
+    m_stats.charsUnfinished += sign * stats.charsUnfinished;
+    m_stats.charsSpacesUnfinished += sign * stats.charsSpacesUnfinished;
+    m_stats.translatedMsgNoDanger += sign * stats.translatedMsgNoDanger;
+    m_stats.translatedMsgDanger += sign * stats.translatedMsgDanger;
+    m_stats.obsoleteMsg += sign * stats.obsoleteMsg;
+    m_stats.unfinishedMsgNoDanger += sign * stats.unfinishedMsgNoDanger;
+    m_stats.unfinishedMsgDanger += sign * stats.unfinishedMsgDanger;
+}
+
+void DataModel::updateStatistics()
+{
+    StatisticalData stats = m_stats;
     stats.wordsSource = m_srcWords;
     stats.charsSource = m_srcChars;
     stats.charsSpacesSource = m_srcCharsSpc;
@@ -507,6 +595,22 @@ MultiMessageItem::MultiMessageItem(const MessageItem *m)
 {
 }
 
+const QString &MultiMessageItem::displayText() const
+{
+    if (!m_hasDisplayTexts) {
+        m_displayText = m_text.simplified();
+        m_sortText = QString(m_displayText).remove(QLatin1Char('&'));
+        m_hasDisplayTexts = true;
+    }
+    return m_displayText;
+}
+
+const QString &MultiMessageItem::sortText() const
+{
+    displayText();
+    return m_sortText;
+}
+
 /******************************************************************************
  *
  * MultiContextItem
@@ -593,6 +697,9 @@ void MultiContextItem::removeMultiMessageItem(int pos)
     for (int i = 0; i < m_messageLists.count(); ++i)
         m_messageLists[i].removeAt(pos);
     m_multiMessageList.removeAt(pos);
+    m_messageIndex.clear();
+    m_idIndex.clear();
+    m_indexedCount = 0;
 }
 
 int MultiContextItem::firstNonobsoleteMessageIndex(int msgIdx) const
@@ -603,24 +710,30 @@ int MultiContextItem::firstNonobsoleteMessageIndex(int msgIdx) const
     return -1;
 }
 
-int MultiContextItem::findMessage(const QString &sourcetext, const QString &comment) const
+// Multi-messages are only ever appended between removals, and their texts,
+// comments and ids do not change, so the index is extended with the new ones.
+void MultiContextItem::updateMessageIndex() const
 {
-    for (int i = 0, cnt = messageCount(); i < cnt; ++i) {
-        MultiMessageItem *m = multiMessageItem(i);
-        if (m->text() == sourcetext && m->comment() == comment)
-            return i;
+    for (const int cnt = m_multiMessageList.size(); m_indexedCount < cnt; ++m_indexedCount) {
+        const MultiMessageItem &m = m_multiMessageList.at(m_indexedCount);
+        const std::pair<QString, QString> key(m.text(), m.comment());
+        if (!m_messageIndex.contains(key))
+            m_messageIndex.insert(key, m_indexedCount);
+        if (!m_idIndex.contains(m.id()))
+            m_idIndex.insert(m.id(), m_indexedCount);
     }
-    return -1;
+}
+
+int MultiContextItem::findMessage(const QString &sourcetext, const QString &comment) const
+{
+    updateMessageIndex();
+    return m_messageIndex.value(std::pair<QString, QString>(sourcetext, comment), -1);
 }
 
 int MultiContextItem::findMessageById(const QString &id) const
 {
-    for (int i = 0, cnt = messageCount(); i < cnt; ++i) {
-        MultiMessageItem *m = multiMessageItem(i);
-        if (m->id() == id)
-            return i;
-    }
-    return -1;
+    updateMessageIndex();
+    return m_idIndex.value(id, -1);
 }
 
 /******************************************************************************
@@ -800,6 +913,7 @@ void MultiDataModel::close(int model)
             if (!mc.messageCount()) {
                 m_msgModel->beginRemoveRows(QModelIndex(), i, i);
                 m_multiContextList.removeAt(i);
+                m_contextIndex.clear();
                 m_msgModel->endRemoveRows();
             }
         }
@@ -816,6 +930,7 @@ void MultiDataModel::closeAll()
     qDeleteAll(m_dataModels);
     m_dataModels.clear();
     m_multiContextList.clear();
+    m_contextIndex.clear();
     m_msgModel->endResetModel();
     emit allModelsDeleted();
     onModifiedChanged();
@@ -945,22 +1060,23 @@ int MultiDataModel::isFileLoaded(const QString &name) const
 
 int MultiDataModel::findContextIndex(const QString &context) const
 {
-    for (int i = 0; i < m_multiContextList.size(); ++i) {
-        const MultiContextItem &mc = m_multiContextList[i];
-        if (mc.context() == context)
-            return i;
+    // Context names are unique and contexts are only appended between
+    // removals, so the index is extended with the new ones on a miss.
+    auto it = m_contextIndex.constFind(context);
+    if (it == m_contextIndex.cend()) {
+        for (int i = m_contextIndex.size(); i < m_multiContextList.size(); ++i)
+            m_contextIndex.insert(m_multiContextList.at(i).context(), i);
+        it = m_contextIndex.constFind(context);
+        if (it == m_contextIndex.cend())
+            return -1;
     }
-    return -1;
+    return *it;
 }
 
 MultiContextItem *MultiDataModel::findContext(const QString &context) const
 {
-    for (int i = 0; i < m_multiContextList.size(); ++i) {
-        const MultiContextItem &mc = m_multiContextList[i];
-        if (mc.context() == context)
-            return const_cast<MultiContextItem *>(&mc);
-    }
-    return 0;
+    const int i = findContextIndex(context);
+    return i >= 0 ? multiContextItem(i) : 0;
 }
 
 MessageItem *MultiDataModel::messageItem(const MultiDataIndex &index, int model) const
@@ -980,11 +1096,26 @@ void MultiDataModel::setTranslation(const MultiDataIndex &index, const QString &
     MessageItem *m = messageItem(index);
     if (translation == m->translation())
         return;
+    DataModel *dm = model(index.model());
+    dm->removeFromStatistics(*m);
     m->setTranslation(translation);
+    dm->addToStatistics(*m);
     setModified(index.model(), true);
     emit translationChanged(index);
 }
 
+// Unlike setTranslation(), this neither emits translationChanged() nor marks
+// the model modified; it is meant for the editor the change comes from.
+void MultiDataModel::setTranslations(const MultiDataIndex &index,
+                                     const QStringList &translations)
+{
+    MessageItem *m = messageItem(index);
+    DataModel *dm = model(index.model());
+    dm->removeFromStatistics(*m);
+    m->setTranslations(translations);
+    dm->addToStatistics(*m);
+}
+
 void MultiDataModel::setFinished(const MultiDataIndex &index, bool finished)
 {
     MultiContextItem *mc = multiContextItem(index.context());
@@ -992,8 +1123,11 @@ void MultiDataModel::setFinished(const MultiDataIndex &index, bool finished)
     ContextItem *c = contextItem(index);
     MessageItem *m = messageItem(index);
     TranslatorMessage::Type type = m->type();
+    DataModel *dm = model(index.model());
     if (type == TranslatorMessage::Unfinished && finished) {
+        dm->removeFromStatistics(*m);
         m->setType(TranslatorMessage::Finished);
+        dm->addToStatistics(*m);
         mm->decrementUnfinishedCount();
         if (!mm->countUnfinished()) {
             incrementFinishedCount();
@@ -1013,7 +1147,9 @@ void MultiDataModel::setFinished(const MultiDataIndex &index, bool finished)
         emit messageDataChanged(index);
         setModified(index.model(), true);
     } else if (type == TranslatorMessage::Finished && !finished) {
+        dm->removeFromStatistics(*m);
         m->setType(TranslatorMessage::Unfinished);
+        dm->addToStatistics(*m);
         mm->incrementUnfinishedCount();
         if (mm->countUnfinished() == 1) {
             decrementFinishedCount();
@@ -1050,7 +1186,10 @@ void MultiDataModel::setDanger(const MultiDataIndex &index, bool danger)
                 emit contextDataChanged(index);
         }
         emit messageDataChanged(index);
+        DataModel *dm = model(index.model());
+        dm->removeFromStatistics(*m);
         m->setDanger(danger);
+        dm->addToStatistics(*m);
     } else if (m->danger() && !danger) {
         if (m->isFinished()) {
             c->decrementFinishedDangerCount();
@@ -1062,7 +1201,10 @@ void MultiDataModel::setDanger(const MultiDataIndex &index, bool danger)
                 emit contextDataChanged(index);
         }
         emit messageDataChanged(index);
+        DataModel *dm = model(index.model());
+        dm->removeFromStatistics(*m);
         m->setDanger(danger);
+        dm->addToStatistics(*m);
     }
 }
 
@@ -1204,22 +1346,56 @@ QModelIndex MessageModel::parent(const QModelIndex& index) const
 
 void MessageModel::multiContextItemChanged(const MultiDataIndex &index)
 {
+    if (m_batching) {
+        m_changedContexts.insert(index.context());
+        return;
+    }
     QModelIndex idx = createIndex(index.context(), m_data->modelCount() + 2);
     emit dataChanged(idx, idx);
 }
 
 void MessageModel::contextItemChanged(const MultiDataIndex &index)
 {
+    if (m_batching) {
+        m_changedContexts.insert(index.context());
+        return;
+    }
     QModelIndex idx = createIndex(index.context(), index.model() + 1);
     emit dataChanged(idx, idx);
 }
 
 void MessageModel::messageItemChanged(const MultiDataIndex &index)
 {
+    if (m_batching) {
+        m_changedContexts.insert(index.context());
+        return;
+    }
     QModelIndex idx = createIndex(index.message(), index.model() + 1, index.context() + 1);
     emit dataChanged(idx, idx);
 }
 
+void MessageModel::endBatchUpdate()
+{
+    if (!m_batching)
+        return;
+    m_batching = false;
+    if (m_changedContexts.isEmpty())
+        return;
+
+    QList<int> contexts(m_changedContexts.cbegin(), m_changedContexts.cend());
+    m_changedContexts.clear();
+    std::sort(contexts.begin(), contexts.end());
+    const int lastColumn = m_data->modelCount() + 1;
+    for (int context : qAsConst(contexts)) {
+        if (int messageCount = m_data->multiContextItem(context)->messageCount()) {
+            emit dataChanged(createIndex(0, 0, context + 1),
+                             createIndex(messageCount - 1, lastColumn, context + 1));
+        }
+    }
+    emit dataChanged(createIndex(contexts.first(), 0),
+                     createIndex(contexts.last(), lastColumn + 1));
+}
+
 QModelIndex MessageModel::modelIndex(const MultiDataIndex &index)
 {
     if (index.message() < 0) // Should be unused case
@@ -1285,7 +1461,7 @@ QVariant MessageModel::data(const QModelIndex &index, int role) const
                         else
                             return tr("<context comment>");
                     }
-                    return msgItem->text().simplified();
+                    return msgItem->displayText();
                 }
             default: // Status or dummy column => no text
                 return QVariant();
@@ -1313,7 +1489,7 @@ QVariant MessageModel::data(const QModelIndex &index, int role) const
         else if (role == SortRole) {
             switch (column - numLangs) {
             case 0: // Source text
-                return mci->multiMessageItem(row)->text().simplified().remove(QLatin1Char('&'));
+                return mci->multiMessageItem(row)->sortText();
             case 1: // Dummy column
                 return QVariant();
             default:
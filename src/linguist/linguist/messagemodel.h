@@ -4,20 +4,42 @@
 #ifndef MESSAGEMODEL_H
 #define MESSAGEMODEL_H
 
+#include "simtexth.h"
 #include "translator.h"
 
 #include <QtCore/QAbstractItemModel>
 #include <QtCore/QList>
 #include <QtCore/QHash>
 #include <QtCore/QLocale>
+#include <QtCore/QSet>
 #include <QtGui/QColor>
 #include <QtGui/QBitmap>
 
+#include <atomic>
+#include <utility>
+
 QT_BEGIN_NAMESPACE
 
 class DataModel;
 class MultiDataModel;
-struct StatisticalData;
+
+struct StatisticalData
+{
+    int wordsSource;
+    int charsSource;
+    int charsSpacesSource;
+    int wordsFinished;
+    int charsFinished;
+    int charsSpacesFinished;
+    int wordsUnfinished;
+    int charsUnfinished;
+    int charsSpacesUnfinished;
+    int translatedMsgNoDanger;
+    int translatedMsgDanger;
+    int obsoleteMsg;
+    int unfinishedMsgNoDanger;
+    int unfinishedMsgDanger;
+};
 
 class MessageItem
 {
@@ -57,9 +79,14 @@ public:
     bool compare(const QString &findText, bool matchSubstring,
         Qt::CaseSensitivity cs) const;
 
+    // Computed on first use; the source text never changes.
+    const SimilarityFingerprint &similarityFingerprint() const;
+
 private:
     TranslatorMessage m_message;
     bool m_danger;
+    mutable bool m_hasFingerprint;
+    mutable SimilarityFingerprint m_fingerprint;
 };
 
 
@@ -91,7 +118,7 @@ public:
 private:
     friend class DataModel;
     friend class MultiDataModel;
-    void appendMessage(const MessageItem &msg) { msgItemList.append(msg); }
+    void appendMessage(const MessageItem &msg) { msgItemList.append(msg); m_messageIndex.clear(); }
     void appendToComment(const QString &x);
     void incrementFinishedCount() { ++m_finishedCount; }
     void decrementFinishedCount() { --m_finishedCount; }
@@ -108,6 +135,8 @@ private:
     int m_unfinishedDangerCount;
     int m_nonobsoleteCount;
     QList<MessageItem> msgItemList;
+    // Built on first lookup; maps source text and comment to the first matching message
+    mutable QHash<std::pair<QString, QString>, int> m_messageIndex;
 };
 
 
@@ -164,10 +193,14 @@ public:
 
     bool isWellMergeable(const DataModel *other) const;
     bool load(const QString &fileName, bool *langGuessed, QWidget *parent);
+    bool read(const QString &fileName);
+    bool finishLoading(bool *langGuessed, QWidget *parent);
     bool save(QWidget *parent) { return save(m_srcFileName, parent); }
     bool saveAs(const QString &newFileName, QWidget *parent);
-    bool release(const QString &fileName, bool verbose,
-        bool ignoreUnfinished, TranslatorSaveMode mode, QWidget *parent);
+    Translator releaseTranslator();
+    static bool release(const Translator &tor, const QString &fileName, bool verbose,
+        bool ignoreUnfinished, TranslatorSaveMode mode, QString *errorString,
+        const std::atomic<bool> *canceled = nullptr);
     QString srcFileName(bool pretty = false) const
         { return pretty ? prettifyPlainFileName(m_srcFileName) : m_srcFileName; }
 
@@ -201,11 +234,30 @@ signals:
 
 private:
     friend class DataModelIterator;
+    friend class MultiDataModel;
     QList<ContextItem> m_contextList;
+    QHash<QString, int> m_contextIndex;
 
     bool save(const QString &fileName, QWidget *parent);
     void updateLocale();
 
+    // To be called around every change of the type, danger or translations
+    // of a message, so that the statistics need not be recounted.
+    void addToStatistics(const MessageItem &m) { countMessage(m, 1); }
+    void removeFromStatistics(const MessageItem &m) { countMessage(m, -1); }
+    void countMessage(const MessageItem &m, int sign);
+
+    // Handed from read() to finishLoading()
+    struct LoadState
+    {
+        bool ok = false;
+        QString error;
+        QString warning;
+        QString languageCode;
+        QString sourceLanguageCode;
+    };
+    LoadState m_loadState;
+
     bool m_writable;
     bool m_modified;
 
@@ -215,6 +267,7 @@ private:
     int m_srcWords;
     int m_srcChars;
     int m_srcCharsSpc;
+    StatisticalData m_stats; // the translation counts, kept up to date
 
     QString m_srcFileName;
     QLocale::Language m_language;
@@ -238,6 +291,9 @@ public:
     QString text() const { return m_text; }
     QString pluralText() const { return m_pluralText; }
     QString comment() const { return m_comment; }
+    // For the message list; computed on first use, the source text never changes
+    const QString &displayText() const;
+    const QString &sortText() const;
     bool isEmpty() const { return !m_nonnullCount; }
     // The next two include also read-only
     bool isObsolete() const { return m_nonnullCount && !m_nonobsoleteCount; }
@@ -262,6 +318,9 @@ private:
     QString m_text;
     QString m_pluralText;
     QString m_comment;
+    mutable QString m_displayText;
+    mutable QString m_sortText;
+    mutable bool m_hasDisplayTexts = false;
     int m_nonnullCount; // all
     int m_nonobsoleteCount; // all
     int m_editableCount; // read-write
@@ -306,6 +365,7 @@ private:
     void decrementEditableCount() { --m_editableCount; }
     void incrementNonobsoleteCount() { ++m_nonobsoleteCount; }
     void decrementNonobsoleteCount() { --m_nonobsoleteCount; }
+    void updateMessageIndex() const;
 
     QString m_context;
     QString m_comment;
@@ -317,6 +377,11 @@ private:
     int m_finishedCount; // read-write
     int m_editableCount; // read-write
     int m_nonobsoleteCount; // all (note: this counts messages, not multi-messages)
+    // Lookup tables for aligning the messages of newly opened files. They are
+    // extended on demand with the multi-messages appended since the last lookup.
+    mutable QHash<std::pair<QString, QString>, int> m_messageIndex; // text, comment
+    mutable QHash<QString, int> m_idIndex;
+    mutable int m_indexedCount = 0;
 };
 
 
@@ -369,8 +434,7 @@ public:
     bool save(int model, QWidget *parent) { return m_dataModels[model]->save(parent); }
     bool saveAs(int model, const QString &newFileName, QWidget *parent)
         { return m_dataModels[model]->saveAs(newFileName, parent); }
-    bool release(int model, const QString &fileName, bool verbose, bool ignoreUnfinished, TranslatorSaveMode mode, QWidget *parent)
-        { return m_dataModels[model]->release(fileName, verbose, ignoreUnfinished, mode, parent); }
+    Translator releaseTranslator(int model) { return m_dataModels[model]->releaseTranslator(); }
     void close(int model);
     void closeAll();
     int isFileLoaded(const QString &name) const;
@@ -397,6 +461,7 @@ public:
 
     // Per message
     void setTranslation(const MultiDataIndex &index, const QString &translation);
+    void setTranslations(const MultiDataIndex &index, const QStringList &translations);
     void setFinished(const MultiDataIndex &index, bool finished);
     void setDanger(const MultiDataIndex &index, bool danger);
 
@@ -453,6 +518,7 @@ private:
     bool m_modified;
 
     QList<MultiContextItem> m_multiContextList;
+    mutable QHash<QString, int> m_contextIndex; // built on demand, cleared on removal
     QList<DataModel *> m_dataModels;
 
     MessageModel *m_msgModel;
@@ -483,6 +549,11 @@ public:
         { return dataIndex(index, index.column() - 1 < m_data->modelCount() ? index.column() - 1 : -1); }
     QModelIndex modelIndex(const MultiDataIndex &index);
 
+    // Collects the changes of the items and announces them per context once
+    // endBatchUpdate() is called, instead of one row at a time.
+    void beginBatchUpdate() { m_batching = true; }
+    void endBatchUpdate();
+
 private slots:
     void multiContextItemChanged(const MultiDataIndex &index);
     void contextItemChanged(const MultiDataIndex &index);
@@ -492,6 +563,8 @@ private:
     friend class MultiDataModel;
 
     MultiDataModel *m_data; // not owned
+    bool m_batching = false;
+    QSet<int> m_changedContexts;
 };
 
 QT_END_NAMESPACE
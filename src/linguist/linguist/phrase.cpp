@@ -6,14 +6,39 @@
 #include "xmlparser.h"
 
 #include <QApplication>
+#include <QCryptographicHash>
+#include <QDataStream>
+#include <QDateTime>
+#include <QDir>
 #include <QFile>
 #include <QFileInfo>
 #include <QMessageBox>
+#include <QSaveFile>
+#include <QStandardPaths>
 #include <QTextStream>
 #include <QXmlStreamReader>
 
 QT_BEGIN_NAMESPACE
 
+static const quint32 CompiledMagic = 0x51504843; // "QPHC"
+static const quint32 CompiledVersion = 1;
+
+/*
+    Returns where the compiled form of the phrase book \a fileName is kept.
+    It is keyed by the absolute path, so that all Linguist instances of the
+    user share it.
+*/
+static QString compiledFilePath(const QString &fileName)
+{
+    const QString dir = QStandardPaths::writableLocation(QStandardPaths::CacheLocation);
+    if (dir.isEmpty())
+        return QString();
+    const QByteArray key = QCryptographicHash::hash(
+                QFileInfo(fileName).absoluteFilePath().toUtf8(), QCryptographicHash::Sha1);
+    return dir + QLatin1String("/phrasebooks/") + QString::fromLatin1(key.toHex())
+            + QLatin1String(".qphc");
+}
+
 static QString protect(const QString & str)
 {
     QString p = str;
@@ -200,12 +225,21 @@ bool PhraseBook::load(const QString &fileName, bool *langGuessed)
 
     m_fileName = fileName;
 
-    QXmlStreamReader reader(&f);
-    QphHandler *hand = new QphHandler(this, reader);
-    reader.setNamespaceProcessing(false);
-    bool ok = hand->parse();
+    QString language;
+    QString lang;
+    bool ok = loadCompiled(fileName, &language, &lang);
+    if (!ok) {
+        QXmlStreamReader reader(&f);
+        QphHandler hand(this, reader);
+        reader.setNamespaceProcessing(false);
+        ok = hand.parse();
+        language = hand.language();
+        lang = hand.sourceLanguage();
+        if (ok)
+            saveCompiled(fileName, language, lang);
+    }
 
-    Translator::languageAndCountry(hand->language(), &m_language, &m_country);
+    Translator::languageAndCountry(language, &m_language, &m_country);
     *langGuessed = false;
     if (m_language == QLocale::C) {
         QLocale sys;
@@ -214,7 +248,6 @@ bool PhraseBook::load(const QString &fileName, bool *langGuessed)
         *langGuessed = true;
     }
 
-    QString lang = hand->sourceLanguage();
     if (lang.isEmpty()) {
         m_sourceLanguage = QLocale::C;
         m_sourceCountry = QLocale::AnyCountry;
@@ -222,7 +255,6 @@ bool PhraseBook::load(const QString &fileName, bool *langGuessed)
         Translator::languageAndCountry(lang, &m_sourceLanguage, &m_sourceCountry);
     }
 
-    delete hand;
     f.close();
     if (!ok) {
         qDeleteAll(m_phrases);
@@ -297,6 +329,78 @@ void PhraseBook::phraseChanged(Phrase *p)
     setModified(true);
 }
 
+/*
+    Reads the phrases from the compiled form of \a fileName if it was written
+    for the current version of the file, which spares the XML parse of large
+    phrase books.
+*/
+bool PhraseBook::loadCompiled(const QString &fileName, QString *language,
+                              QString *sourceLanguage)
+{
+    const QString compiledName = compiledFilePath(fileName);
+    if (compiledName.isEmpty())
+        return false;
+    QFile compiled(compiledName);
+    if (!compiled.open(QIODevice::ReadOnly))
+        return false;
+
+    QDataStream in(&compiled);
+    quint32 magic = 0;
+    quint32 version = 0;
+    in >> magic >> version;
+    if (magic != CompiledMagic || version != CompiledVersion)
+        return false;
+    in.setVersion(QDataStream::Qt_6_0);
+
+    const QFileInfo fi(fileName);
+    qint64 size = -1;
+    qint64 lastModified = -1;
+    quint32 count = 0;
+    in >> size >> lastModified >> *language >> *sourceLanguage >> count;
+    if (in.status() != QDataStream::Ok || size != fi.size()
+        || lastModified != fi.lastModified().toMSecsSinceEpoch()) {
+        return false;
+    }
+
+    QList<Phrase *> phrases;
+    phrases.reserve(qMin(count, quint32(0x10000)));
+    for (quint32 i = 0; i < count && in.status() == QDataStream::Ok; ++i) {
+        QString source;
+        QString target;
+        QString definition;
+        in >> source >> target >> definition;
+        phrases.append(new Phrase(source, target, definition, this));
+    }
+    if (in.status() != QDataStream::Ok) {
+        qDeleteAll(phrases);
+        return false;
+    }
+    m_phrases = std::move(phrases);
+    return true;
+}
+
+void PhraseBook::saveCompiled(const QString &fileName, const QString &language,
+                              const QString &sourceLanguage) const
+{
+    const QString compiledName = compiledFilePath(fileName);
+    if (compiledName.isEmpty() || !QDir().mkpath(QFileInfo(compiledName).path()))
+        return;
+    QSaveFile compiled(compiledName);
+    if (!compiled.open(QIODevice::WriteOnly))
+        return;
+
+    const QFileInfo fi(fileName);
+    QDataStream out(&compiled);
+    out << CompiledMagic << CompiledVersion;
+    out.setVersion(QDataStream::Qt_6_0);
+    out << fi.size() << fi.lastModified().toMSecsSinceEpoch() << language << sourceLanguage
+        << quint32(m_phrases.size());
+    for (const Phrase *p : m_phrases)
+        out << p->source() << p->target() << p->definition();
+    if (out.status() == QDataStream::Ok)
+        compiled.commit();
+}
+
 QString PhraseBook::friendlyPhraseBookName() const
 {
     if (!m_fileName.isEmpty())
@@ -86,6 +86,10 @@ private:
     void setModified(bool modified);
     void phraseChanged(Phrase *phrase);
 
+    bool loadCompiled(const QString &fileName, QString *language, QString *sourceLanguage);
+    void saveCompiled(const QString &fileName, const QString &language,
+                      const QString &sourceLanguage) const;
+
     QList<Phrase *> m_phrases;
     QString m_fileName;
     bool m_changed;
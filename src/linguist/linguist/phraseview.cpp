@@ -9,10 +9,12 @@
 #include "phrasemodel.h"
 #include "simtexth.h"
 
+#include <QElapsedTimer>
 #include <QHeaderView>
 #include <QKeyEvent>
 #include <QSettings>
 #include <QShortcut>
+#include <QTimer>
 #include <QTreeView>
 #include <QWidget>
 #include <QDebug>
@@ -25,6 +27,31 @@ static QString phraseViewHeaderKey()
     return settingPath("PhraseViewHeader");
 }
 
+/*
+    The translation guesses being computed for the current message.
+
+    The messages of the open models are visited from the event loop a slice
+    at a time, so that moving on to the next message does not wait for a
+    scan of all of them; the job is simply dropped then. They are not
+    scanned on a worker thread because the editor changes them without
+    any locking.
+*/
+struct GuessJob
+{
+    GuessJob(MultiDataModel *dataModel, int model, const QString &sourceText)
+        : matcher(QString::fromLatin1(sourceText.toLatin1())), it(dataModel, model)
+    {}
+
+    const StringSimilarityMatcher matcher;
+    MultiDataModelIterator it;
+    // The messages that can reach the threshold, to be scored in one batch
+    QList<const MessageItem *> items;
+    QList<const SimilarityFingerprint *> fingerprints;
+};
+
+// Milliseconds spent on a slice before returning to the event loop
+static const int GuessSliceTime = 10;
+
 PhraseView::PhraseView(MultiDataModel *model, QList<QHash<QString, QList<Phrase *> > > *phraseDict, QWidget *parent)
     : QTreeView(parent),
       m_dataModel(model),
@@ -36,6 +63,19 @@ PhraseView::PhraseView(MultiDataModel *model, QList<QHash<QString, QList<Phrase
 
     m_phraseModel = new PhraseModel(this);
 
+    m_guessTimer = new QTimer(this);
+    connect(m_guessTimer, &QTimer::timeout, this, &PhraseView::continueGuessing);
+    connect(m_dataModel, &MultiDataModel::translationChanged,
+            this, &PhraseView::invalidateGuesses);
+    connect(m_dataModel, &MultiDataModel::messageDataChanged,
+            this, &PhraseView::invalidateGuesses);
+    connect(m_dataModel, &MultiDataModel::modelAppended,
+            this, &PhraseView::cancelGuesses);
+    connect(m_dataModel, &MultiDataModel::modelDeleted,
+            this, &PhraseView::cancelGuesses);
+    connect(m_dataModel, &MultiDataModel::allModelsDeleted,
+            this, &PhraseView::cancelGuesses);
+
     setModel(m_phraseModel);
     setAlternatingRowColors(true);
     setSelectionBehavior(QAbstractItemView::SelectRows);
@@ -172,27 +212,50 @@ void PhraseView::resetNumGuesses()
     setSourceText(m_modelIndex, m_sourceText);
 }
 
-static CandidateList similarTextHeuristicCandidates(MultiDataModel *model, int mi,
-    const char *text, int maxCandidates)
+// Visits the messages of the job for a slice of time and returns whether
+// all of them have been visited.
+static bool collectCandidates(GuessJob *job)
 {
-    QList<int> scores;
-    CandidateList candidates;
+    QElapsedTimer timer;
+    timer.start();
+    for (int n = 0; job->it.isValid(); ++job->it, ++n) {
+        if ((n & 255) == 255 && timer.elapsed() >= GuessSliceTime)
+            return false;
 
-    StringSimilarityMatcher stringmatcher(QString::fromLatin1(text));
-
-    for (MultiDataModelIterator it(model, mi); it.isValid(); ++it) {
-        MessageItem *m = it.current();
+        const MessageItem *m = job->it.current();
         if (!m)
             continue;
 
-        TranslatorMessage mtm = m->message();
+        const TranslatorMessage &mtm = m->message();
         if (mtm.type() == TranslatorMessage::Unfinished
             || mtm.translation().isEmpty())
             continue;
 
-        QString s = m->text();
+        // Messages that cannot reach the threshold are dropped before scoring.
+        const SimilarityFingerprint &fingerprint = m->similarityFingerprint();
+        if (job->matcher.maxSimilarityScore(fingerprint) < textSimilarityThreshold)
+            continue;
+        job->items.append(m);
+        job->fingerprints.append(&fingerprint);
+    }
+    return true;
+}
+
+static CandidateList similarTextHeuristicCandidates(const GuessJob &job, int maxCandidates)
+{
+    QList<int> scores;
+    CandidateList candidates;
+
+    const QList<const MessageItem *> &items = job.items;
+    QList<int> itemScores(items.size());
+    job.matcher.getSimilarityScores(job.fingerprints.constData(), job.fingerprints.size(),
+                                    itemScores.data());
+
+    for (int k = 0; k < items.size(); ++k) {
+        const TranslatorMessage &mtm = items.at(k)->message();
+        QString s = items.at(k)->text();
 
-        int score = stringmatcher.getSimilarityScore(s);
+        int score = itemScores.at(k);
 
         if (candidates.count() == maxCandidates && score > scores[maxCandidates - 1])
             candidates.removeLast();
@@ -226,6 +289,8 @@ void PhraseView::setSourceText(int model, const QString &sourceText)
     m_sourceText = sourceText;
     m_phraseModel->removePhrases();
     deleteGuesses();
+    m_guessTimer->stop();
+    m_guessJob.reset();
 
     if (model < 0)
         return;
@@ -235,25 +300,66 @@ void PhraseView::setSourceText(int model, const QString &sourceText)
         m_phraseModel->addPhrase(p);
 
     if (!sourceText.isEmpty() && m_doGuesses) {
-        const CandidateList cl = similarTextHeuristicCandidates(m_dataModel, model,
-            sourceText.toLatin1(), m_maxCandidates);
-        int n = 0;
-        for (const Candidate &candidate : cl) {
-            QString def;
-            if (n < 9)
-                def = tr("Guess from '%1' (%2)")
-                      .arg(candidate.context, QKeySequence(Qt::CTRL | (Qt::Key_0 + (n + 1)))
-                                              .toString(QKeySequence::NativeText));
-            else
-                def = tr("Guess from '%1'").arg(candidate.context);
-            Phrase *guess = new Phrase(candidate.source, candidate.translation, def, candidate, n);
-            m_guesses.append(guess);
-            m_phraseModel->addPhrase(guess);
-            ++n;
+        if (m_cachedGuesses.model == model && m_cachedGuesses.sourceText == sourceText
+            && m_cachedGuesses.maxCandidates == m_maxCandidates) {
+            addGuesses(m_cachedGuesses.candidates);
+        } else {
+            m_guessJob = std::make_unique<GuessJob>(m_dataModel, model, sourceText);
+            m_guessTimer->start(0);
         }
     }
 }
 
+void PhraseView::continueGuessing()
+{
+    if (!collectCandidates(m_guessJob.get()))
+        return;
+    m_guessTimer->stop();
+    m_cachedGuesses.model = m_modelIndex;
+    m_cachedGuesses.sourceText = m_sourceText;
+    m_cachedGuesses.maxCandidates = m_maxCandidates;
+    m_cachedGuesses.candidates = similarTextHeuristicCandidates(*m_guessJob, m_maxCandidates);
+    m_guessJob.reset();
+    addGuesses(m_cachedGuesses.candidates);
+}
+
+// Drops the cached guesses after a message changed.
+void PhraseView::invalidateGuesses()
+{
+    m_cachedGuesses.model = -1;
+    m_cachedGuesses.candidates.clear();
+}
+
+/*
+    Also drops the job in progress after a model was opened or closed, its
+    messages may be gone. The main window sets the source text again when
+    the current message changes with it.
+*/
+void PhraseView::cancelGuesses()
+{
+    invalidateGuesses();
+    m_guessTimer->stop();
+    m_guessJob.reset();
+}
+
+void PhraseView::addGuesses(const CandidateList &candidates)
+{
+    int n = 0;
+    for (const Candidate &candidate : candidates) {
+        QString def;
+        if (n < 9)
+            def = tr("Guess from '%1' (%2)")
+                  .arg(candidate.context, QKeySequence(Qt::CTRL | (Qt::Key_0 + (n + 1)))
+                                          .toString(QKeySequence::NativeText));
+        else
+            def = tr("Guess from '%1'").arg(candidate.context);
+        Phrase *guess = new Phrase(candidate.source, candidate.translation, def, candidate, n);
+        m_guesses.append(guess);
+        m_phraseModel->addPhrase(guess);
+        ++n;
+    }
+}
+
 QList<Phrase *> PhraseView::getPhrases(int model, const QString &source)
 {
     QList<Phrase *> phrases;
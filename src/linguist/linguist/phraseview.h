@@ -8,12 +8,16 @@
 #include <QTreeView>
 #include "phrase.h"
 
+#include <memory>
+
 QT_BEGIN_NAMESPACE
 
 static const int DefaultMaxCandidates = 5;
 
 class MultiDataModel;
 class PhraseModel;
+class QTimer;
+struct GuessJob;
 
 class PhraseView : public QTreeView
 {
@@ -51,9 +55,13 @@ private slots:
     void selectCurrentPhrase();
     void editPhrase();
     void gotoMessageFromGuess();
+    void continueGuessing();
+    void invalidateGuesses();
+    void cancelGuesses();
 
 private:
     QList<Phrase *> getPhrases(int model, const QString &sourceText);
+    void addGuesses(const CandidateList &candidates);
     void deleteGuesses();
 
     MultiDataModel *m_dataModel;
@@ -64,6 +72,17 @@ private:
     int m_modelIndex;
     bool m_doGuesses;
     int m_maxCandidates = DefaultMaxCandidates;
+
+    // The guesses are computed in slices from the event loop
+    std::unique_ptr<GuessJob> m_guessJob;
+    QTimer *m_guessTimer;
+    // The guesses of the latest message, until a translation changes
+    struct {
+        int model = -1;
+        QString sourceText;
+        int maxCandidates = 0;
+        CandidateList candidates;
+    } m_cachedGuesses;
 };
 
 QT_END_NAMESPACE
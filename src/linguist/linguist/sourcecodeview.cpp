@@ -5,20 +5,41 @@
 
 #include <QtCore/QFile>
 #include <QtCore/QFileInfo>
+#include <QtCore/QPromise>
 #include <QtCore/QTextStream>
+#include <QtCore/QThreadPool>
 
 #include <QtGui/QTextCharFormat>
 #include <QtGui/QTextBlock>
 #include <QtGui/QTextCursor>
 
+#include <climits>
+#include <cstring>
+#include <memory>
+
 QT_BEGIN_NAMESPACE
 
+// Files the size of which exceeds this are decoded on a worker thread.
+static const qint64 AsyncLoadSize = 1024 * 1024;
+// The number of lines shown on either side of the referenced one while
+// a large file is decoded
+static const int LoadingContextLines = 100;
+
+// The cache cost of a decoded file is its size in KiB.
+static int fileCacheCost(const QString &fileText)
+{
+    return int(qMin(fileText.size() / 1024 + 1, qsizetype(INT_MAX)));
+}
+
 SourceCodeView::SourceCodeView(QWidget *parent)
   : QPlainTextEdit(parent),
     m_isActive(true),
-    m_lineNumToLoad(0)
+    m_lineNumToLoad(0),
+    fileCache(32 * 1024)
 {
     setReadOnly(true);
+    connect(&m_loadWatcher, &QFutureWatcher<QString>::finished,
+            this, &SourceCodeView::sourceCodeLoaded);
 }
 
 void SourceCodeView::setSourceContext(const QString &fileName, const int lineNum)
@@ -29,6 +50,7 @@ void SourceCodeView::setSourceContext(const QString &fileName, const int lineNum
     if (fileName.isEmpty()) {
         clear();
         m_currentFileName.clear();
+        m_showLoadingFile = false;
         appendHtml(tr("<i>Source code not available</i>"));
         return;
     }
@@ -52,9 +74,20 @@ void SourceCodeView::setActivated(bool activated)
 
 void SourceCodeView::showSourceCode(const QString &absFileName, const int lineNum)
 {
-    QString fileText = fileHash.value(absFileName);
+    if (m_currentFileName == absFileName) {
+        highlightLine(lineNum - 1);
+        return;
+    }
+    if (m_loadingFileName == absFileName) {
+        showLoadingSourceCode(lineNum);
+        return;
+    }
+    m_showLoadingFile = false;
 
-    if (fileText.isNull()) { // File not in hash
+    QString fileText;
+    if (const QString *cachedText = fileCache.object(absFileName)) {
+        fileText = *cachedText;
+    } else { // File not in cache
         m_currentFileName.clear();
 
         // Assume fileName is relative to directory
@@ -70,18 +103,78 @@ void SourceCodeView::showSourceCode(const QString &absFileName, const int lineNu
             appendHtml(tr("<i>File %1 not readable</i>").arg(absFileName));
             return;
         }
+        if (file.size() > AsyncLoadSize) {
+            m_loadingFileName = absFileName;
+            m_loadingData = file.readAll();
+            auto promise = std::make_shared<QPromise<QString>>();
+            m_loadWatcher.setFuture(promise->future());
+            QThreadPool::globalInstance()->start([promise, data = m_loadingData] {
+                promise->start();
+                promise->addResult(QString::fromUtf8(data));
+                promise->finish();
+            });
+            showLoadingSourceCode(lineNum);
+            return;
+        }
         fileText = QString::fromUtf8(file.readAll());
-        fileHash.insert(absFileName, fileText);
+        fileCache.insert(absFileName, new QString(fileText), fileCacheCost(fileText));
     }
 
+    setPlainText(fileText);
+    m_currentFileName = absFileName;
+    highlightLine(lineNum - 1);
+}
+
+/*
+    Shows the lines around \a lineNum of the file that is being decoded
+    and remembers to show the whole file once it is.
+*/
+void SourceCodeView::showLoadingSourceCode(const int lineNum)
+{
+    m_currentFileName.clear();
+    m_showLoadingFile = true;
+    m_loadingLineNum = lineNum;
+
+    const char *data = m_loadingData.constData();
+    const qsizetype size = m_loadingData.size();
+    qsizetype begin = 0;
+    int firstLine = 1;
+    for (; firstLine < lineNum - LoadingContextLines; ++firstLine) {
+        const void *newline = std::memchr(data + begin, '\n', size - begin);
+        if (!newline)
+            break;
+        begin = static_cast<const char *>(newline) - data + 1;
+    }
+    qsizetype end = begin;
+    for (int line = firstLine; end < size && line <= lineNum + LoadingContextLines; ++line) {
+        const void *newline = std::memchr(data + end, '\n', size - end);
+        end = newline ? static_cast<const char *>(newline) - data + 1 : size;
+    }
 
-    if (m_currentFileName != absFileName) {
+    setPlainText(QString::fromUtf8(data + begin, end - begin));
+    highlightLine(lineNum - firstLine);
+}
+
+void SourceCodeView::sourceCodeLoaded()
+{
+    const QString fileName = m_loadingFileName;
+    const QString fileText = m_loadWatcher.result();
+    m_loadingFileName.clear();
+    m_loadingData.clear();
+    fileCache.insert(fileName, new QString(fileText), fileCacheCost(fileText));
+
+    if (m_showLoadingFile) {
+        m_showLoadingFile = false;
         setPlainText(fileText);
-        m_currentFileName = absFileName;
+        m_currentFileName = fileName;
+        highlightLine(m_loadingLineNum - 1);
     }
+}
 
+void SourceCodeView::highlightLine(int blockNumber)
+{
     QTextCursor cursor = textCursor();
-    cursor.setPosition(document()->findBlockByNumber(lineNum - 1).position());
+    cursor.setPosition(document()->findBlockByNumber(blockNumber).position());
     setTextCursor(cursor);
     centerCursor();
     cursor.movePosition(QTextCursor::EndOfBlock, QTextCursor::KeepAnchor);
@@ -4,8 +4,9 @@
 #ifndef SOURCECODEVIEW_H
 #define SOURCECODEVIEW_H
 
+#include <QCache>
 #include <QDir>
-#include <QHash>
+#include <QFutureWatcher>
 #include <QPlainTextEdit>
 
 QT_BEGIN_NAMESPACE
@@ -22,13 +23,24 @@ public slots:
 
 private:
     void showSourceCode(const QString &fileName, const int lineNum);
+    void showLoadingSourceCode(const int lineNum);
+    void sourceCodeLoaded();
+    void highlightLine(int blockNumber);
 
     bool m_isActive;
     QString m_fileToLoad;
     int m_lineNumToLoad;
     QString m_currentFileName;
 
-    QHash<QString, QString> fileHash;
+    // A large file is decoded on a worker thread, meanwhile only the lines
+    // around the referenced one are shown.
+    QFutureWatcher<QString> m_loadWatcher;
+    QString m_loadingFileName;
+    QByteArray m_loadingData;
+    int m_loadingLineNum = 0;
+    bool m_showLoadingFile = false;
+
+    QCache<QString, QString> fileCache; // decoded files, the least recently shown go first
 };
 
 QT_END_NAMESPACE
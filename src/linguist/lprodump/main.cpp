@@ -14,14 +14,18 @@
 #include <QtCore/QFile>
 #include <QtCore/QFileInfo>
 #include <QtCore/QLibraryInfo>
+#include <QtCore/QMutex>
 #include <QtCore/QRegularExpression>
+#include <QtCore/QSemaphore>
 #include <QtCore/QString>
 #include <QtCore/QStringList>
+#include <QtCore/QThreadPool>
 
 #include <QtCore/QJsonArray>
 #include <QtCore/QJsonDocument>
 #include <QtCore/QJsonObject>
 
+#include <atomic>
 #include <iostream>
 
 using namespace Qt::StringLiterals;
@@ -31,8 +35,12 @@ static void printOut(const QString &out)
     std::cout << qPrintable(out);
 }
 
+// Sub-projects are evaluated on several threads, keep their messages apart.
+static QMutex errMutex;
+
 static void printErr(const QString &out)
 {
+    QMutexLocker lock(&errMutex);
     std::cerr << qPrintable(out);
 }
 
@@ -76,6 +84,9 @@ Options:
            Virtual output directory for processing subsequent .pro files.
     -pro-debug
            Trace processing .pro files. Specify twice for more verbosity.
+    -pro-cache <directory>
+           Keep the parsed .pro, .pri and .prf files in <directory>, so that
+           later runs do not need to parse unchanged files again.
     -out <filename>
            Name of the output file.
     -translations-variables <variable_1>[,<variable_2>,...]
@@ -250,12 +261,12 @@ static void excludeProjects(const ProFileEvaluator &visitor, QStringList *subPro
 static QJsonArray processProjects(bool topLevel, const QStringList &proFiles,
         const QStringList &translationsVariables,
         const QHash<QString, QString> &outDirMap,
-        ProFileGlobals *option, QMakeVfs *vfs, QMakeParser *parser,
+        ProFileGlobals *option, QMakeVfs *vfs, ProFileCache *cache,
         bool *fail);
 
 static QJsonObject processProject(const QString &proFile, const QStringList &translationsVariables,
                                   ProFileGlobals *option, QMakeVfs *vfs,
-                                  QMakeParser *parser, ProFileEvaluator &visitor)
+                                  ProFileCache *cache, ProFileEvaluator &visitor)
 {
     QJsonObject result;
     QStringList tmp = visitor.values(QLatin1String("CODECFORSRC"));
@@ -283,7 +294,7 @@ static QJsonObject processProject(const QString &proFile, const QStringList &tra
             }
         }
         QJsonArray subResults = processProjects(false, subProFiles, translationsVariables,
-                                                QHash<QString, QString>(), option, vfs, parser,
+                                                QHash<QString, QString>(), option, vfs, cache,
                                                 nullptr);
         if (!subResults.isEmpty())
             setValue(result, "subProjects", subResults);
@@ -298,54 +309,103 @@ static QJsonObject processProject(const QString &proFile, const QStringList &tra
     return result;
 }
 
+static bool processProjectFile(bool topLevel, const QString &proFile,
+                               const QStringList &translationsVariables,
+                               ProFileGlobals *option, QMakeVfs *vfs, ProFileCache *cache,
+                               QJsonObject *result)
+{
+    QMakeParser parser(cache, vfs, &evalHandler);
+    ProFile *pro;
+    if (!(pro = parser.parsedProFile(proFile, topLevel ? QMakeParser::ParseReportMissing
+                                                       : QMakeParser::ParseDefault))) {
+        return false;
+    }
+    ProFileEvaluator visitor(option, &parser, vfs, &evalHandler);
+    visitor.setCumulative(true);
+    visitor.setOutputDir(option->shadowedPath(pro->directoryName()));
+    if (!visitor.accept(pro)) {
+        pro->deref();
+        return false;
+    }
+
+    QJsonObject prj = processProject(proFile, translationsVariables, option, vfs, cache, visitor);
+    setValue(prj, "projectFile", proFile);
+    QStringList tsFiles;
+    for (const QString &varName : translationsVariables) {
+        if (!visitor.contains(varName))
+            continue;
+        QDir proDir(QFileInfo(proFile).path());
+        const QStringList translations = visitor.values(varName);
+        for (const QString &tsFile : translations)
+            tsFiles << proDir.filePath(tsFile);
+    }
+    if (!tsFiles.isEmpty())
+        setValue(prj, "translations", tsFiles);
+    if (visitor.contains(QLatin1String("LUPDATE_COMPILE_COMMANDS_PATH"))) {
+        const QStringList thepathjson = visitor.values(
+            QLatin1String("LUPDATE_COMPILE_COMMANDS_PATH"));
+        setValue(prj, "compileCommands", thepathjson.value(0));
+    }
+    *result = prj;
+    pro->deref();
+    return true;
+}
+
+/*
+    Top-level projects are evaluated one after the other, as each of them may
+    come with its own output directory. Sibling sub-projects are evaluated
+    concurrently: the calling thread and as many idle threads of the global
+    pool as are available take projects in turn, each with its own parser on
+    the shared cache and VFS. Sub-projects nest, so helpers are only started
+    when a pool thread is free, and the calling thread never waits for a
+    project nobody picked up. The results keep the order of \a proFiles.
+*/
 static QJsonArray processProjects(bool topLevel, const QStringList &proFiles,
         const QStringList &translationsVariables,
         const QHash<QString, QString> &outDirMap,
-        ProFileGlobals *option, QMakeVfs *vfs, QMakeParser *parser, bool *fail)
+        ProFileGlobals *option, QMakeVfs *vfs, ProFileCache *cache, bool *fail)
 {
     QJsonArray result;
-    for (const QString &proFile : proFiles) {
-        if (!outDirMap.isEmpty())
-            option->setDirectories(QFileInfo(proFile).path(), outDirMap[proFile]);
-
-        ProFile *pro;
-        if (!(pro = parser->parsedProFile(proFile, topLevel ? QMakeParser::ParseReportMissing
-                                                            : QMakeParser::ParseDefault))) {
-            if (topLevel)
-                *fail = true;
-            continue;
-        }
-        ProFileEvaluator visitor(option, parser, vfs, &evalHandler);
-        visitor.setCumulative(true);
-        visitor.setOutputDir(option->shadowedPath(pro->directoryName()));
-        if (!visitor.accept(pro)) {
-            if (topLevel)
+    if (topLevel) {
+        for (const QString &proFile : proFiles) {
+            if (!outDirMap.isEmpty())
+                option->setDirectories(QFileInfo(proFile).path(), outDirMap[proFile]);
+            QJsonObject prj;
+            if (processProjectFile(true, proFile, translationsVariables, option, vfs, cache,
+                                   &prj)) {
+                result.append(prj);
+            } else {
                 *fail = true;
-            pro->deref();
-            continue;
+            }
         }
+        return result;
+    }
 
-        QJsonObject prj = processProject(proFile, translationsVariables, option, vfs, parser,
-                                         visitor);
-        setValue(prj, "projectFile", proFile);
-        QStringList tsFiles;
-        for (const QString &varName : translationsVariables) {
-            if (!visitor.contains(varName))
-                continue;
-            QDir proDir(QFileInfo(proFile).path());
-            const QStringList translations = visitor.values(varName);
-            for (const QString &tsFile : translations)
-                tsFiles << proDir.filePath(tsFile);
+    QList<QJsonObject> projects(proFiles.size());
+    QList<bool> ok(proFiles.size(), false);
+    std::atomic<qsizetype> next = 0;
+    const auto work = [&] {
+        for (qsizetype i; (i = next++) < proFiles.size(); ) {
+            ok[i] = processProjectFile(false, proFiles.at(i), translationsVariables, option,
+                                       vfs, cache, &projects[i]);
         }
-        if (!tsFiles.isEmpty())
-            setValue(prj, "translations", tsFiles);
-        if (visitor.contains(QLatin1String("LUPDATE_COMPILE_COMMANDS_PATH"))) {
-            const QStringList thepathjson = visitor.values(
-                QLatin1String("LUPDATE_COMPILE_COMMANDS_PATH"));
-            setValue(prj, "compileCommands", thepathjson.value(0));
-        }
-        result.append(prj);
-        pro->deref();
+    };
+
+    QThreadPool *pool = QThreadPool::globalInstance();
+    QSemaphore done;
+    int helpers = 0;
+    while (helpers < proFiles.size() - 1 && pool->tryStart([&] { work(); done.release(); }))
+        ++helpers;
+    work();
+    if (helpers) {
+        pool->releaseThread();
+        done.acquire(helpers);
+        pool->reserveThread();
+    }
+
+    for (qsizetype i = 0; i < proFiles.size(); ++i) {
+        if (ok.at(i))
+            result.append(projects.at(i));
     }
     return result;
 }
@@ -359,6 +419,7 @@ int main(int argc, char **argv)
     QString outDir = QDir::currentPath();
     QHash<QString, QString> outDirMap;
     QString outputFilePath;
+    QString cacheDir;
     int proDebug = 0;
 
     for (int i = 1; i < args.size(); ++i) {
@@ -398,6 +459,13 @@ int main(int argc, char **argv)
                 return 1;
             }
             outDir = QDir::cleanPath(QFileInfo(args[i]).absoluteFilePath());
+        } else if (arg == QLatin1String("-pro-cache")) {
+            ++i;
+            if (i == argc) {
+                printErr(u"The -pro-cache option should be followed by a directory name.\n"_s);
+                return 1;
+            }
+            cacheDir = QDir::cleanPath(QFileInfo(args[i]).absoluteFilePath());
         } else if (arg == u"-translations-variables"_s) {
             ++i;
             if (i == argc) {
@@ -443,10 +511,13 @@ int main(int argc, char **argv)
     option.setCommandLineArguments(QDir::currentPath(),
                                    QStringList() << QLatin1String("CONFIG+=lupdate_run"));
     QMakeVfs vfs;
-    QMakeParser parser(0, &vfs, &evalHandler);
-
+    ProFileCache proFileCache;
+    proFileCache.setPersistentDirectory(cacheDir);
+    // Sub-projects are evaluated on several threads, set up the statics first.
+    QMakeParser::initialize();
+    ProFileEvaluator::initialize();
     QJsonArray results = processProjects(true, proFiles, translationsVariables, outDirMap, &option,
-                                         &vfs, &parser, &fail);
+                                         &vfs, &proFileCache, &fail);
     if (fail)
         return 1;
 
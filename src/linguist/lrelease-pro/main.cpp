@@ -40,6 +40,11 @@ Options:
     -keep  Keep the temporary project dump around
     -silent
            Do not explain what is being done
+    -pro-cache <directory>
+           Keep the parsed .pro, .pri and .prf files in <directory>, so that
+           later runs do not need to parse unchanged files again
+    -trace <file>
+           Passed to lrelease, which records where its time is spent
     -version
            Display the version of lrelease-pro and exit
 )"_s);
@@ -74,6 +79,18 @@ int main(int argc, char **argv)
             const QString arg = QString::fromLocal8Bit(argv[i]);
             lprodumpOptions << arg;
             lreleaseOptions << arg;
+        } else if (!strcmp(argv[i], "-pro-cache")) {
+            if (++i == argc) {
+                printErr(u"The -pro-cache option should be followed by a directory name.\n"_s);
+                return 1;
+            }
+            lprodumpOptions << QStringLiteral("-pro-cache") << QString::fromLocal8Bit(argv[i]);
+        } else if (!strcmp(argv[i], "-trace") || !strcmp(argv[i], "--trace")) {
+            if (++i == argc) {
+                printErr(u"The -trace option should be followed by a file name.\n"_s);
+                return 1;
+            }
+            lreleaseOptions << QStringLiteral("-trace") << QString::fromLocal8Bit(argv[i]);
         } else if (!strcmp(argv[i], "-version")) {
             printOut(QStringLiteral("lrelease-pro version %1\n")
                      .arg(QLatin1String(QT_VERSION_STR)));
@@ -6,6 +6,7 @@
 #include <profileutils.h>
 #include <projectdescriptionreader.h>
 #include <runqttool.h>
+#include <trace.h>
 
 #ifndef QT_BOOTSTRAPPED
 #include <QtCore/QCoreApplication>
@@ -20,18 +21,40 @@
 #include <QtCore/QTextStream>
 #include <QtCore/QLibraryInfo>
 
+#include <atomic>
+#include <sstream>
+#include <thread>
+#include <vector>
+
 QT_USE_NAMESPACE
 
 using namespace Qt::StringLiterals;
 
+// When releasing files in parallel, the output for each file is collected
+// and printed in the order of the files afterwards.
+struct OutputChunk
+{
+    bool toStderr;
+    QByteArray data;
+};
+static thread_local QList<OutputChunk> *bufferedOutput = nullptr;
+
 static void printOut(const QString & out)
 {
+    if (bufferedOutput) {
+        bufferedOutput->append({ false, out.toUtf8() });
+        return;
+    }
     QTextStream stream(stdout);
     stream << out;
 }
 
 static void printErr(const QString & out)
 {
+    if (bufferedOutput) {
+        bufferedOutput->append({ true, out.toUtf8() });
+        return;
+    }
     QTextStream stream(stderr);
     stream << out;
 }
@@ -67,8 +90,13 @@ Options:
     -project <filename>
            Name of a file containing the project's description in JSON format.
            Such a file may be generated from a .pro file using the lprodump tool.
+    -j <n>
+           Release up to <n> TS files in parallel. Has no effect if -qm is given.
     -silent
            Do not explain what is being done
+    -trace <file>
+           Write where the time is spent to <file>, in the Chrome
+           trace event JSON format.
     -version
            Display the version of lrelease and exit
 )"_s);
@@ -91,7 +119,15 @@ static bool loadTsFile(Translator &tor, const QString &tsFileName, bool /* verbo
 static bool releaseTranslator(Translator &tor, const QString &qmFileName,
     ConversionData &cd, bool removeIdentical)
 {
-    tor.reportDuplicates(tor.resolveDuplicates(), qmFileName, cd.isVerbose());
+    TraceSpan span("qm", "releaseTranslator", qmFileName);
+    if (bufferedOutput) {
+        std::ostringstream report;
+        tor.reportDuplicates(tor.resolveDuplicates(), qmFileName, cd.isVerbose(), report);
+        if (!report.str().empty())
+            bufferedOutput->append({ true, QByteArray::fromStdString(report.str()) });
+    } else {
+        tor.reportDuplicates(tor.resolveDuplicates(), qmFileName, cd.isVerbose());
+    }
 
     if (cd.isVerbose())
         printOut(QLatin1String("Updating '%1'...\n").arg(qmFileName));
@@ -141,6 +177,48 @@ static bool releaseTsFile(const QString& tsFileName,
     return releaseTranslator(tor, qmFileName, cd, removeIdentical);
 }
 
+static bool releaseTsFiles(const QStringList &tsFileNames, const ConversionData &cd,
+                           bool removeIdentical, int threadCount)
+{
+    struct FileResult
+    {
+        QList<OutputChunk> output;
+        bool ok = false;
+    };
+    std::vector<FileResult> results(tsFileNames.size());
+    std::atomic<qsizetype> nextFile = 0;
+    std::atomic<bool> failed = false;
+
+    std::vector<std::thread> workers;
+    for (int i = 0; i < threadCount; ++i) {
+        workers.emplace_back([&]() {
+            // Like in the serial case, no more files are started after a failure.
+            for (qsizetype k = nextFile++; k < tsFileNames.size() && !failed; k = nextFile++) {
+                FileResult &result = results[k];
+                ConversionData fileCd = cd;
+                bufferedOutput = &result.output;
+                result.ok = releaseTsFile(tsFileNames.at(k), fileCd, removeIdentical);
+                bufferedOutput = nullptr;
+                if (!result.ok)
+                    failed = true;
+            }
+        });
+    }
+    for (std::thread &worker : workers)
+        worker.join();
+
+    for (const FileResult &result : results) {
+        for (const OutputChunk &chunk : result.output) {
+            FILE *stream = chunk.toStderr ? stderr : stdout;
+            fwrite(chunk.data.constData(), 1, chunk.data.size(), stream);
+            fflush(stream);
+        }
+        if (!result.ok)
+            return false;
+    }
+    return true;
+}
+
 static QStringList translationsFromProjects(const Projects &projects, bool topLevel);
 
 static QStringList translationsFromProject(const Project &project, bool topLevel)
@@ -176,6 +254,8 @@ int main(int argc, char **argv)
     QStringList inputFiles;
     QString outputFile;
     QString projectDescriptionFile;
+    QString traceFile;
+    int threadCount = 1;
 
     for (int i = 1; i < argc; ++i) {
         if (!strcmp(argv[i], "-compress")) {
@@ -209,6 +289,20 @@ int main(int argc, char **argv)
                 return 1;
             }
             projectDescriptionFile = QString::fromLocal8Bit(argv[++i]);
+        } else if (!strcmp(argv[i], "-trace") || !strcmp(argv[i], "--trace")) {
+            if (i == argc - 1) {
+                printErr(QLatin1String("The option -trace requires a parameter.\n"));
+                return 1;
+            }
+            traceFile = QString::fromLocal8Bit(argv[++i]);
+        } else if (!strcmp(argv[i], "-j")) {
+            bool ok = false;
+            if (i < argc - 1)
+                threadCount = QString::fromLocal8Bit(argv[++i]).toInt(&ok);
+            if (!ok || threadCount < 1) {
+                printErr(QLatin1String("The option -j requires a positive number.\n"));
+                return 1;
+            }
         } else if (!strcmp(argv[i], "-silent")) {
             cd.m_verbose = false;
             continue;
@@ -246,6 +340,13 @@ int main(int argc, char **argv)
         return 0;
     }
 
+    TraceSession traceSession;
+    if (!traceFile.isEmpty() && !traceSession.start(traceFile, &errorString)) {
+        printErr(QLatin1String("lrelease error: Cannot write trace file %1: %2\n")
+                 .arg(traceFile, errorString));
+        return 1;
+    }
+
     if (!projectDescriptionFile.isEmpty()) {
         if (!inputFiles.isEmpty()) {
             printErr(QLatin1String(
@@ -260,6 +361,11 @@ int main(int argc, char **argv)
         inputFiles = translationsFromProjects(projectDescription);
     }
 
+    if (outputFile.isEmpty() && threadCount > 1 && inputFiles.size() > 1) {
+        threadCount = int(qMin(qsizetype(threadCount), inputFiles.size()));
+        return releaseTsFiles(inputFiles, cd, removeIdentical, threadCount) ? 0 : 1;
+    }
+
     for (const QString &inputFile : qAsConst(inputFiles)) {
         if (outputFile.isEmpty()) {
             if (!releaseTsFile(inputFile, cd, removeIdentical))
@@ -0,0 +1,242 @@
+// Copyright (C) 2023 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
+
+#include "clangparsecache.h"
+
+#include <QtCore/qcryptographichash.h>
+#include <QtCore/qdatastream.h>
+#include <QtCore/qfile.h>
+#include <QtCore/qfileinfo.h>
+#include <QtCore/qiodevice.h>
+#include <QtCore/qsavefile.h>
+#include <QtCore/qset.h>
+
+#include <clang/Tooling/CompilationDatabase.h>
+
+QT_BEGIN_NAMESPACE
+
+using namespace Qt::StringLiterals;
+
+static const quint32 CacheMagic = 0x4c55504b; // "LUPK"
+static const quint32 CacheVersion = 2;
+
+static QDataStream &operator<<(QDataStream &out, const TranslationRelatedStore &store)
+{
+    out << store.callType << store.rawCode << store.funcName << store.locationCol
+        << store.contextArg << store.contextRetrieved << store.lupdateSource
+        << store.lupdateLocationFile << store.lupdateInputFile << store.lupdateLocationLine
+        << store.lupdateId << store.lupdateSourceWhenId << store.lupdateIdMetaData
+        << store.lupdateMagicMetaData << store.lupdateAllMagicMetaData << store.lupdateComment
+        << store.lupdateExtraComment << store.lupdatePlural << store.lupdateWarning;
+    return out;
+}
+
+static QDataStream &operator>>(QDataStream &in, TranslationRelatedStore &store)
+{
+    in >> store.callType >> store.rawCode >> store.funcName >> store.locationCol
+       >> store.contextArg >> store.contextRetrieved >> store.lupdateSource
+       >> store.lupdateLocationFile >> store.lupdateInputFile >> store.lupdateLocationLine
+       >> store.lupdateId >> store.lupdateSourceWhenId >> store.lupdateIdMetaData
+       >> store.lupdateMagicMetaData >> store.lupdateAllMagicMetaData >> store.lupdateComment
+       >> store.lupdateExtraComment >> store.lupdatePlural >> store.lupdateWarning;
+    return in;
+}
+
+static void writeStores(QDataStream &out, const TranslationStores &stores)
+{
+    out << quint32(stores.size());
+    for (const TranslationRelatedStore &store : stores)
+        out << store;
+}
+
+static bool readStores(QDataStream &in, TranslationStores *stores)
+{
+    quint32 count = 0;
+    in >> count;
+    if (in.status() != QDataStream::Ok)
+        return false;
+    // Every store takes more than one byte, so a larger count can only come
+    // from a corrupt file and must not be allocated.
+    if (qint64(count) > in.device()->bytesAvailable())
+        return false;
+    stores->resize(count);
+    for (TranslationRelatedStore &store : *stores)
+        in >> store;
+    return in.status() == QDataStream::Ok;
+}
+
+ClangParseCache::ClangParseCache(const QString &directory)
+{
+    if (directory.isEmpty())
+        return;
+    m_directory.setPath(directory);
+    m_enabled = m_directory.mkpath(u"."_s);
+    if (!m_enabled)
+        qWarning("lupdate: Cannot create parse cache directory %s", qPrintable(directory));
+}
+
+QByteArray ClangParseCache::fileHash(const QString &filePath) const
+{
+    {
+        QMutexLocker lock(&m_fileHashesMutex);
+        const auto it = m_fileHashes.constFind(filePath);
+        if (it != m_fileHashes.cend())
+            return *it;
+    }
+
+    QByteArray hash;
+    QFile file(filePath);
+    if (file.open(QIODevice::ReadOnly)) {
+        QCryptographicHash hasher(QCryptographicHash::Sha1);
+        hasher.addData(&file);
+        hash = hasher.result();
+    }
+
+    QMutexLocker lock(&m_fileHashesMutex);
+    m_fileHashes.insert(filePath, hash);
+    return hash;
+}
+
+QString ClangParseCache::entryFilePath(const std::string &file) const
+{
+    const QString absolutePath = QFileInfo(QString::fromStdString(file)).absoluteFilePath();
+    const QByteArray name = QCryptographicHash::hash(absolutePath.toUtf8(),
+                                                     QCryptographicHash::Sha1).toHex();
+    return m_directory.filePath(QString::fromLatin1(name) + ".lupcache"_L1);
+}
+
+/*
+    Returns the key of the cache entry for \a file, or an empty byte array if
+    the file cannot be read. The key covers the content of the file, the
+    compile commands from \a db and the configuration of this lupdate run.
+*/
+QByteArray ClangParseCache::key(const std::string &file,
+                                const clang::tooling::CompilationDatabase &db) const
+{
+    const QByteArray contentHash = fileHash(QString::fromStdString(file));
+    if (contentHash.isEmpty())
+        return {};
+
+    QCryptographicHash hasher(QCryptographicHash::Sha1);
+    hasher.addData(m_configuration);
+    hasher.addData(contentHash);
+    for (const clang::tooling::CompileCommand &command : db.getCompileCommands(file)) {
+        hasher.addData(QByteArrayView(command.Directory.data(), command.Directory.size()));
+        for (const std::string &argument : command.CommandLine) {
+            hasher.addData(QByteArrayView("\0", 1));
+            hasher.addData(QByteArrayView(argument.data(), argument.size()));
+        }
+        hasher.addData(QByteArrayView("\n", 1));
+    }
+    return hasher.result();
+}
+
+/*
+    Loads the entry for \a file into \a entry if it is up to date. The parse
+    time recorded with the entry is returned in \a lastParseTime even if the
+    entry is outdated, or -1 if there is no entry.
+*/
+bool ClangParseCache::load(const std::string &file, const QByteArray &key, Entry *entry,
+                           qint64 *lastParseTime) const
+{
+    if (lastParseTime)
+        *lastParseTime = -1;
+    if (!m_enabled)
+        return false;
+
+    QFile cacheFile(entryFilePath(file));
+    if (!cacheFile.open(QIODevice::ReadOnly))
+        return false;
+
+    QDataStream in(&cacheFile);
+    quint32 magic = 0;
+    quint32 version = 0;
+    in >> magic >> version;
+    if (magic != CacheMagic || version != CacheVersion)
+        return false;
+    in.setVersion(QDataStream::Qt_6_0);
+
+    qint64 parseTime = -1;
+    in >> parseTime;
+    if (in.status() != QDataStream::Ok)
+        return false;
+    if (lastParseTime)
+        *lastParseTime = parseTime;
+
+    QByteArray storedKey;
+    in >> storedKey;
+    if (key.isEmpty() || storedKey != key)
+        return false;
+
+    QList<std::pair<QString, QByteArray>> dependencies;
+    in >> dependencies;
+    if (in.status() != QDataStream::Ok)
+        return false;
+    for (const auto &dependency : qAsConst(dependencies)) {
+        if (fileHash(dependency.first) != dependency.second)
+            return false;
+    }
+
+    Entry result;
+    result.parseTime = parseTime;
+    for (const auto &dependency : qAsConst(dependencies))
+        result.dependencies.append(dependency.first);
+    if (!readStores(in, &result.ast) || !readStores(in, &result.qDeclareTrWithContext)
+        || !readStores(in, &result.qNoopTranslationWithContext)) {
+        return false;
+    }
+    *entry = std::move(result);
+    return true;
+}
+
+/*
+    Returns the significant headers included according to the
+    InclusionDirective stores in \a preprocessor.
+*/
+QStringList ClangParseCache::includedFiles(const TranslationStores &preprocessor)
+{
+    QStringList files;
+    QSet<QString> seen;
+    for (const TranslationRelatedStore &store : preprocessor) {
+        if (store.callType != "InclusionDirective"_L1)
+            continue;
+        if (seen.contains(store.lupdateLocationFile))
+            continue;
+        seen.insert(store.lupdateLocationFile);
+        files.append(store.lupdateLocationFile);
+    }
+    return files;
+}
+
+/*
+    Writes the cache entry for \a file. The entry is only valid as long as
+    the files in \a dependencies keep their content.
+*/
+void ClangParseCache::store(const std::string &file, const QByteArray &key,
+                            const QStringList &dependencies, const Entry &entry) const
+{
+    if (!m_enabled || key.isEmpty())
+        return;
+
+    QList<std::pair<QString, QByteArray>> hashes;
+    hashes.reserve(dependencies.size());
+    for (const QString &dependency : dependencies)
+        hashes.append({ dependency, fileHash(dependency) });
+
+    QSaveFile cacheFile(entryFilePath(file));
+    if (!cacheFile.open(QIODevice::WriteOnly))
+        return;
+
+    QDataStream out(&cacheFile);
+    out << CacheMagic << CacheVersion;
+    out.setVersion(QDataStream::Qt_6_0);
+    out << entry.parseTime << key << hashes;
+    writeStores(out, entry.ast);
+    writeStores(out, entry.qDeclareTrWithContext);
+    writeStores(out, entry.qNoopTranslationWithContext);
+
+    if (out.status() != QDataStream::Ok || !cacheFile.commit())
+        qWarning("lupdate: Cannot write parse cache entry for %s", file.c_str());
+}
+
+QT_END_NAMESPACE
@@ -0,0 +1,77 @@
+// Copyright (C) 2023 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
+
+#ifndef CLANGPARSECACHE_H
+#define CLANGPARSECACHE_H
+
+#include "cpp_clang.h"
+
+#include <QtCore/qbytearray.h>
+#include <QtCore/qdir.h>
+#include <QtCore/qhash.h>
+#include <QtCore/qmutex.h>
+#include <QtCore/qstring.h>
+#include <QtCore/qstringlist.h>
+
+#include <string>
+
+namespace clang {
+namespace tooling {
+class CompilationDatabase;
+}
+}
+
+QT_BEGIN_NAMESPACE
+
+/*
+    On-disk cache of the translation stores the clang based parser extracts
+    from a translation unit.
+
+    An entry is keyed on the content of the translation unit, its compile
+    commands and the configuration of the lupdate run (aliases, project
+    roots, ...). Significant headers included by the translation unit are
+    recorded with their content hash and checked when the entry is loaded.
+    The time clang needed for the translation unit is recorded as well, it is
+    used to schedule the expensive translation units first on the next run.
+*/
+class ClangParseCache
+{
+public:
+    struct Entry
+    {
+        TranslationStores ast;
+        TranslationStores qDeclareTrWithContext;
+        TranslationStores qNoopTranslationWithContext;
+        qint64 parseTime = -1; // milliseconds spent in clang for the translation unit
+        QStringList dependencies; // filled in by load()
+    };
+
+    explicit ClangParseCache(const QString &directory);
+
+    bool isEnabled() const { return m_enabled; }
+    void setConfiguration(const QByteArray &configuration) { m_configuration = configuration; }
+
+    QByteArray key(const std::string &file,
+                   const clang::tooling::CompilationDatabase &db) const;
+    bool load(const std::string &file, const QByteArray &key, Entry *entry,
+              qint64 *lastParseTime = nullptr) const;
+    void store(const std::string &file, const QByteArray &key,
+               const QStringList &dependencies, const Entry &entry) const;
+
+    static QStringList includedFiles(const TranslationStores &preprocessor);
+
+private:
+    QByteArray fileHash(const QString &filePath) const;
+    QString entryFilePath(const std::string &file) const;
+
+    QDir m_directory;
+    QByteArray m_configuration;
+    bool m_enabled = false;
+
+    mutable QMutex m_fileHashesMutex;
+    mutable QHash<QString, QByteArray> m_fileHashes;
+};
+
+QT_END_NAMESPACE
+
+#endif // CLANGPARSECACHE_H
@@ -0,0 +1,234 @@
+// Copyright (C) 2023 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
+
+#include "clangprefilter.h"
+#include "filesignificancecheck.h"
+#include "lupdate.h"
+
+#include <QtCore/qdir.h>
+#include <QtCore/qfile.h>
+#include <QtCore/qfileinfo.h>
+
+#include <clang/Tooling/CompilationDatabase.h>
+
+#include <cstring>
+
+QT_BEGIN_NAMESPACE
+
+using namespace Qt::StringLiterals;
+
+static bool isIdentifierChar(char c)
+{
+    return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9')
+            || c == '_';
+}
+
+static bool isSpace(char c)
+{
+    return c == ' ' || c == '\t' || c == '\n' || c == '\r' || c == '\f' || c == '\v';
+}
+
+// Collects the #include directives of a file, including those in excluded
+// preprocessor blocks.
+static QList<std::pair<QByteArray, bool>> includeDirectives(QByteArrayView text)
+{
+    QList<std::pair<QByteArray, bool>> includes;
+    const char *p = text.data();
+    const char *const end = p + text.size();
+    while (p < end) {
+        const char *lineEnd = static_cast<const char *>(std::memchr(p, '\n', end - p));
+        if (!lineEnd)
+            lineEnd = end;
+        while (p < lineEnd && (*p == ' ' || *p == '\t'))
+            ++p;
+        if (p < lineEnd && *p == '#') {
+            ++p;
+            while (p < lineEnd && (*p == ' ' || *p == '\t'))
+                ++p;
+            const QByteArrayView directive(p, lineEnd - p);
+            if (directive.startsWith("include")) {
+                p += 7;
+                while (p < lineEnd && (*p == ' ' || *p == '\t'))
+                    ++p;
+                if (p < lineEnd && (*p == '"' || *p == '<')) {
+                    const char close = *p == '"' ? '"' : '>';
+                    const char *nameEnd = static_cast<const char *>(
+                                std::memchr(p + 1, close, lineEnd - p - 1));
+                    if (nameEnd)
+                        includes.append({ QByteArray(p + 1, nameEnd - p - 1), close == '"' });
+                }
+            }
+        }
+        p = lineEnd + 1;
+    }
+    return includes;
+}
+
+ClangPrefilter::ClangPrefilter()
+{
+    const auto &functions = trFunctionAliasManager.nameToTrFunctionMap();
+    for (auto it = functions.cbegin(), end = functions.cend(); it != end; ++it)
+        m_keywords.insert(it.key().toUtf8());
+    m_keywords.insert("Q_DECLARE_TR_FUNCTIONS"_ba);
+}
+
+/*
+    Returns whether \a text contains one of the keywords followed by an
+    opening parenthesis, or a TRANSLATOR comment. The parentheses are found
+    with memchr(), which the C library vectorizes; only the identifier in
+    front of each one is looked up.
+*/
+bool ClangPrefilter::containsKeyword(QByteArrayView text) const
+{
+    if (text.contains("TRANSLATOR"))
+        return true;
+
+    const char *const begin = text.data();
+    const char *const end = begin + text.size();
+    for (const char *p = begin;
+         (p = static_cast<const char *>(std::memchr(p, '(', end - p))); ++p) {
+        const char *identifierEnd = p;
+        while (identifierEnd > begin && isSpace(identifierEnd[-1]))
+            --identifierEnd;
+        const char *identifierBegin = identifierEnd;
+        while (identifierBegin > begin && isIdentifierChar(identifierBegin[-1]))
+            --identifierBegin;
+        if (identifierBegin != identifierEnd
+            && m_keywords.contains(QByteArray::fromRawData(identifierBegin,
+                                                           identifierEnd - identifierBegin))) {
+            return true;
+        }
+    }
+    return false;
+}
+
+ClangPrefilter::FileScan ClangPrefilter::scan(const QString &filePath) const
+{
+    {
+        QMutexLocker lock(&m_scansMutex);
+        const auto it = m_scans.constFind(filePath);
+        if (it != m_scans.cend())
+            return *it;
+    }
+
+    FileScan result;
+    QFile file(filePath);
+    if (file.open(QIODevice::ReadOnly)) {
+        const QByteArray contents = file.readAll();
+        result.readable = true;
+        result.hasKeyword = containsKeyword(contents);
+        if (!result.hasKeyword)
+            result.includes = includeDirectives(contents);
+    }
+
+    QMutexLocker lock(&m_scansMutex);
+    m_scans.insert(filePath, result);
+    return result;
+}
+
+/*
+    Returns whether the translation unit \a file may contain translation
+    information. The include paths are taken from \a commands. The
+    significant files the translation unit includes are appended to
+    \a dependencies, they decide together with \a file whether the answer is
+    still valid.
+
+    Files that are not significant are not searched, and neither are the
+    files they include.
+*/
+bool ClangPrefilter::mayContainTranslations(
+        const std::string &file, const std::vector<clang::tooling::CompileCommand> &commands,
+        QStringList *dependencies) const
+{
+    QStringList quoteDirs;
+    QStringList includeDirs;
+    QStringList forcedIncludes;
+    const std::pair<QLatin1StringView, QStringList *> options[] = {
+        { "-iquote"_L1, &quoteDirs },
+        { "-isystem"_L1, &includeDirs },
+        { "-idirafter"_L1, &includeDirs },
+        { "-include"_L1, &forcedIncludes },
+        { "-I"_L1, &includeDirs },
+#ifdef Q_OS_WIN
+        { "/I"_L1, &includeDirs },
+        { "/FI"_L1, &forcedIncludes },
+#endif
+    };
+    for (const clang::tooling::CompileCommand &command : commands) {
+        const QDir workingDir(QString::fromStdString(command.Directory));
+        const std::vector<std::string> &args = command.CommandLine;
+        for (size_t i = 0; i < args.size(); ++i) {
+            const QString arg = QString::fromStdString(args[i]);
+            for (const auto &[option, list] : options) {
+                if (!arg.startsWith(option))
+                    continue;
+                QString value;
+                if (arg.size() > option.size())
+                    value = arg.mid(option.size());
+                else if (i + 1 < args.size())
+                    value = QString::fromStdString(args[++i]);
+                if (!value.isEmpty())
+                    list->append(QDir::cleanPath(workingDir.absoluteFilePath(value)));
+                break;
+            }
+        }
+    }
+
+    const QString sourceFile = QFileInfo(QString::fromStdString(file)).canonicalFilePath();
+    if (sourceFile.isEmpty())
+        return true;
+
+    QStringList pending = { sourceFile };
+    QSet<QString> seen = { sourceFile };
+    for (const QString &forced : qAsConst(forcedIncludes)) {
+        const QString path = QFileInfo(forced).canonicalFilePath();
+        if (path.isEmpty())
+            return true;
+        if (!seen.contains(path) && LupdatePrivate::isFileSignificant(path.toStdString())) {
+            seen.insert(path);
+            pending.append(path);
+        }
+    }
+
+    while (!pending.isEmpty()) {
+        const QString current = pending.takeLast();
+        if (current != sourceFile)
+            dependencies->append(current);
+        const FileScan fileScan = scan(current);
+        if (!fileScan.readable || fileScan.hasKeyword)
+            return true;
+
+        const QString currentDir = QFileInfo(current).path();
+        for (const Include &include : fileScan.includes) {
+            const QString name = QString::fromUtf8(include.first);
+            QString path;
+            if (QDir::isAbsolutePath(name)) {
+                path = QFileInfo(name).canonicalFilePath();
+            } else {
+                QStringList searchDirs = includeDirs;
+                if (include.second)
+                    searchDirs = QStringList(currentDir) + quoteDirs + includeDirs;
+                for (const QString &dir : qAsConst(searchDirs)) {
+                    path = QFileInfo(dir + u'/' + name).canonicalFilePath();
+                    if (!path.isEmpty())
+                        break;
+                }
+            }
+            if (path.isEmpty()) {
+                // Angle includes that cannot be found are system headers,
+                // quoted ones may be generated files clang would know about.
+                if (include.second)
+                    return true;
+                continue;
+            }
+            if (seen.contains(path))
+                continue;
+            seen.insert(path);
+            if (LupdatePrivate::isFileSignificant(path.toStdString()))
+                pending.append(path);
+        }
+    }
+    return false;
+}
+
+QT_END_NAMESPACE
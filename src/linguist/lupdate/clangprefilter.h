@@ -0,0 +1,71 @@
+// Copyright (C) 2023 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
+
+#ifndef CLANGPREFILTER_H
+#define CLANGPREFILTER_H
+
+#include <QtCore/qbytearray.h>
+#include <QtCore/qbytearrayview.h>
+#include <QtCore/qhash.h>
+#include <QtCore/qlist.h>
+#include <QtCore/qmutex.h>
+#include <QtCore/qset.h>
+#include <QtCore/qstring.h>
+#include <QtCore/qstringlist.h>
+
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace clang {
+namespace tooling {
+struct CompileCommand;
+}
+}
+
+QT_BEGIN_NAMESPACE
+
+/*
+    Cheap text search run on a translation unit before it is handed to clang.
+
+    Only significant files can contribute messages, so the translation unit
+    and the significant files it includes, directly or not, are searched for
+    the names of the tr functions and their aliases followed by an opening
+    parenthesis, and for TRANSLATOR comments. A translation unit without any
+    of them cannot produce messages and does not need to be parsed.
+
+    The search errs on the safe side: matches in comments and in excluded
+    preprocessor blocks count, and a translation unit is always parsed if it
+    or one of its quoted includes cannot be found.
+*/
+class ClangPrefilter
+{
+public:
+    ClangPrefilter();
+
+    bool mayContainTranslations(const std::string &file,
+                                const std::vector<clang::tooling::CompileCommand> &commands,
+                                QStringList *dependencies) const;
+
+private:
+    using Include = std::pair<QByteArray, bool>; // file name, quoted
+
+    struct FileScan
+    {
+        bool readable = false;
+        bool hasKeyword = false;
+        QList<Include> includes;
+    };
+
+    FileScan scan(const QString &filePath) const;
+    bool containsKeyword(QByteArrayView text) const;
+
+    QSet<QByteArray> m_keywords;
+
+    mutable QMutex m_scansMutex;
+    mutable QHash<QString, FileScan> m_scans;
+};
+
+QT_END_NAMESPACE
+
+#endif // CLANGPREFILTER_H
@@ -0,0 +1,215 @@
+// Copyright (C) 2023 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
+
+#include "clangprefixheader.h"
+
+#include <QtCore/qdir.h>
+#include <QtCore/qfileinfo.h>
+
+QT_WARNING_PUSH
+QT_WARNING_DISABLE_MSVC(4100)
+QT_WARNING_DISABLE_MSVC(4146)
+QT_WARNING_DISABLE_MSVC(4267)
+QT_WARNING_DISABLE_MSVC(4624)
+QT_WARNING_DISABLE_GCC("-Wnonnull")
+
+#include <clang/Frontend/CompilerInvocation.h>
+#include <clang/Frontend/FrontendActions.h>
+#include <clang/Tooling/Tooling.h>
+
+QT_WARNING_POP
+
+#include <algorithm>
+#include <optional>
+
+QT_BEGIN_NAMESPACE
+
+using namespace Qt::StringLiterals;
+
+namespace {
+
+class PrefixHeaderDatabase : public clang::tooling::CompilationDatabase
+{
+public:
+    explicit PrefixHeaderDatabase(clang::tooling::CompileCommand command)
+        : m_command(std::move(command))
+    {}
+
+    std::vector<clang::tooling::CompileCommand>
+    getCompileCommands(llvm::StringRef /*filePath*/) const override
+    {
+        return { m_command };
+    }
+
+private:
+    clang::tooling::CompileCommand m_command;
+};
+
+class GeneratePchActionFactory : public clang::tooling::FrontendActionFactory
+{
+public:
+    explicit GeneratePchActionFactory(const std::string &outputFile)
+        : m_outputFile(outputFile)
+    {}
+
+#if (LUPDATE_CLANG_VERSION >= LUPDATE_CLANG_VERSION_CHECK(10,0,0))
+    std::unique_ptr<clang::FrontendAction> create() override
+    {
+        return std::make_unique<clang::GeneratePCHAction>();
+    }
+#else
+    clang::FrontendAction *create() override
+    {
+        return new clang::GeneratePCHAction;
+    }
+#endif
+
+    bool runInvocation(std::shared_ptr<clang::CompilerInvocation> invocation,
+                       clang::FileManager *files,
+                       std::shared_ptr<clang::PCHContainerOperations> pchContainerOps,
+                       clang::DiagnosticConsumer *diagConsumer) override
+    {
+        // The tool strips the output options of the compile command.
+        invocation->getFrontendOpts().OutputFile = m_outputFile;
+        return FrontendActionFactory::runInvocation(std::move(invocation), files,
+                                                    std::move(pchContainerOps), diagConsumer);
+    }
+
+private:
+    std::string m_outputFile;
+};
+
+} // unnamed namespace
+
+static bool isClangClMode(const clang::tooling::CompileCommand &command)
+{
+    if (command.CommandLine.empty())
+        return false;
+    const QString program = QFileInfo(QString::fromStdString(command.CommandLine.front()))
+            .completeBaseName().toLower();
+    if (program == "cl"_L1 || program == "clang-cl"_L1)
+        return true;
+    return std::find(command.CommandLine.cbegin(), command.CommandLine.cend(),
+                     "--driver-mode=cl") != command.CommandLine.cend();
+}
+
+// Returns the compile command of the translation unit, with the prefix header
+// in place of the translation unit.
+static std::optional<clang::tooling::CompileCommand>
+headerCommand(const clang::tooling::CompileCommand &command, const std::string &header)
+{
+    if (isClangClMode(command))
+        return std::nullopt;
+
+    const QDir workingDir(QString::fromStdString(command.Directory));
+    const QString sourceFile = QDir::cleanPath(
+                workingDir.absoluteFilePath(QString::fromStdString(command.Filename)));
+    clang::tooling::CompileCommand result;
+    result.Directory = command.Directory;
+    result.Filename = header;
+    bool replaced = false;
+    const std::vector<std::string> &args = command.CommandLine;
+    for (size_t i = 0; i < args.size(); ++i) {
+        if (i > 0 && !replaced && QDir::cleanPath(workingDir.absoluteFilePath(
+                        QString::fromStdString(args[i]))) == sourceFile) {
+            result.CommandLine.push_back("-x");
+            result.CommandLine.push_back("c++-header");
+            result.CommandLine.push_back(header);
+            replaced = true;
+        } else if (args[i] == "-o" && i + 1 < args.size()) {
+            ++i;
+        } else if (args[i].compare(0, 2, "-o") != 0) {
+            result.CommandLine.push_back(args[i]);
+        }
+    }
+    if (!replaced)
+        return std::nullopt;
+    return result;
+}
+
+ClangPrefixHeader::ClangPrefixHeader(const QString &headerFile,
+                                     const clang::tooling::ArgumentsAdjuster &argumentsAdjuster)
+    : m_argumentsAdjuster(argumentsAdjuster)
+    , m_directory(QDir::tempPath() + "/lupdate_pch"_L1)
+{
+    if (headerFile.isEmpty())
+        return;
+    const QString header = QFileInfo(headerFile).canonicalFilePath();
+    if (header.isEmpty()) {
+        qWarning("lupdate: Cannot find the prefix header %s", qPrintable(headerFile));
+        return;
+    }
+    if (!m_directory.isValid()) {
+        qWarning("lupdate: Cannot create a directory for the precompiled prefix header: %s",
+                 qPrintable(m_directory.errorString()));
+        return;
+    }
+    m_header = header.toStdString();
+}
+
+/*
+    Returns a compilation database that compiles the prefix header the way the
+    translation unit with \a commands is compiled, or nullptr if the prefix
+    header cannot be used for it.
+*/
+std::unique_ptr<clang::tooling::CompilationDatabase>
+ClangPrefixHeader::database(const std::vector<clang::tooling::CompileCommand> &commands) const
+{
+    if (!isEnabled() || commands.size() != 1)
+        return nullptr;
+    std::optional<clang::tooling::CompileCommand> command = headerCommand(commands.front(),
+                                                                          m_header);
+    if (!command)
+        return nullptr;
+    return std::make_unique<PrefixHeaderDatabase>(std::move(*command));
+}
+
+/*
+    Returns the precompiled prefix header for the translation unit with
+    \a commands, building it on first use, or an empty string if the
+    translation unit has to be parsed without it.
+
+    This function is called from multiple threads; translation units with the
+    same flags wait for the one that builds their precompiled header.
+*/
+std::string ClangPrefixHeader::precompiledHeader(
+        const std::vector<clang::tooling::CompileCommand> &commands)
+{
+    if (!isEnabled() || commands.size() != 1)
+        return {};
+    std::optional<clang::tooling::CompileCommand> command = headerCommand(commands.front(),
+                                                                          m_header);
+    if (!command)
+        return {};
+
+    QByteArray key = QByteArray::fromStdString(command->Directory);
+    for (const std::string &arg : command->CommandLine)
+        key += '\0' + QByteArray::fromStdString(arg);
+
+    std::shared_ptr<Pch> pch;
+    {
+        QMutexLocker lock(&m_pchsMutex);
+        std::shared_ptr<Pch> &slot = m_pchs[key];
+        if (!slot) {
+            slot = std::make_shared<Pch>();
+            slot->outputFile = m_directory.filePath(u"prefix%1.pch"_s.arg(m_pchs.size()))
+                                       .toStdString();
+        }
+        pch = slot;
+    }
+
+    std::call_once(pch->built, [&] {
+        qCDebug(lcClang) << "Precompiling prefix header: " << m_header << " to "
+                         << pch->outputFile;
+        PrefixHeaderDatabase db(std::move(*command));
+        clang::tooling::ClangTool tool(db, m_header);
+        tool.appendArgumentsAdjuster(m_argumentsAdjuster);
+        GeneratePchActionFactory factory(pch->outputFile);
+        pch->ok = tool.run(&factory) == 0;
+        if (!pch->ok)
+            qWarning("lupdate: Cannot precompile the prefix header %s", m_header.c_str());
+    });
+    return pch->ok ? pch->outputFile : std::string();
+}
+
+QT_END_NAMESPACE
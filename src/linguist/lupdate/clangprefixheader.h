@@ -0,0 +1,77 @@
+// Copyright (C) 2023 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
+
+#ifndef CLANGPREFIXHEADER_H
+#define CLANGPREFIXHEADER_H
+
+#include "cpp_clang.h"
+
+#include <QtCore/qhash.h>
+#include <QtCore/qmutex.h>
+#include <QtCore/qstring.h>
+#include <QtCore/qtemporarydir.h>
+
+QT_WARNING_PUSH
+QT_WARNING_DISABLE_MSVC(4100)
+QT_WARNING_DISABLE_MSVC(4146)
+QT_WARNING_DISABLE_MSVC(4267)
+QT_WARNING_DISABLE_MSVC(4624)
+QT_WARNING_DISABLE_GCC("-Wnonnull")
+
+#include <clang/Tooling/ArgumentsAdjusters.h>
+#include <clang/Tooling/CompilationDatabase.h>
+
+QT_WARNING_POP
+
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+QT_BEGIN_NAMESPACE
+
+/*
+    Precompiled prefix header shared by the translation units of a project.
+
+    The prefix header, typically the one the build system precompiles, is
+    compiled once per distinct set of compile flags and then loaded with
+    -include-pch instead of being parsed again by every translation unit.
+    Translation units with several compile commands, and those compiled in
+    clang-cl mode, are parsed as usual.
+
+    Macro expansions and comments in the precompiled header are not seen by
+    the translation units, so the prefix header is also parsed once on its
+    own to collect the messages from the significant files it includes.
+*/
+class ClangPrefixHeader
+{
+public:
+    ClangPrefixHeader(const QString &headerFile,
+                      const clang::tooling::ArgumentsAdjuster &argumentsAdjuster);
+
+    bool isEnabled() const { return !m_header.empty() && m_directory.isValid(); }
+    const std::string &header() const { return m_header; }
+
+    std::unique_ptr<clang::tooling::CompilationDatabase>
+    database(const std::vector<clang::tooling::CompileCommand> &commands) const;
+    std::string precompiledHeader(const std::vector<clang::tooling::CompileCommand> &commands);
+
+private:
+    struct Pch
+    {
+        std::once_flag built;
+        std::string outputFile;
+        bool ok = false;
+    };
+
+    std::string m_header;
+    clang::tooling::ArgumentsAdjuster m_argumentsAdjuster;
+    QTemporaryDir m_directory;
+
+    QMutex m_pchsMutex;
+    QHash<QByteArray, std::shared_ptr<Pch>> m_pchs;
+};
+
+QT_END_NAMESPACE
+
+#endif // CLANGPREFIXHEADER_H
@@ -5,6 +5,7 @@
 #define CLANG_TOOL_AST_READER_H
 
 #include "cpp_clang.h"
+#include "lupdatepreprocessoraction.h"
 
 QT_WARNING_PUSH
 QT_WARNING_DISABLE_MSVC(4100)
@@ -101,6 +102,18 @@ public:
     }
 
 private:
+    // The preprocessor stores are collected in the same compiler invocation
+    // that builds the AST, so every translation unit is only lexed once.
+    // Missing includes are reported, as they were by the separate AST pass.
+    void ExecuteAction() override
+    {
+        auto &preprocessor = getCompilerInstance().getPreprocessor();
+        auto callbacks = new LupdatePPCallbacks(&m_stores->Preprocessor, preprocessor);
+        preprocessor.addPPCallbacks(std::unique_ptr<clang::PPCallbacks>(callbacks));
+
+        clang::ASTFrontendAction::ExecuteAction();
+    }
+
     Stores *m_stores = nullptr;
 };
 
@@ -2,13 +2,20 @@
 // SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
 
 #include "cpp.h"
+#include "cppincludecache.h"
 
+#include <trace.h>
 #include <translator.h>
 #include <QtCore/QBitArray>
 #include <QtCore/QStack>
 #include <QtCore/QTextStream>
 #include <QtCore/QRegularExpression>
 
+#include <atomic>
+#include <sstream>
+#include <thread>
+#include <vector>
+
 QT_BEGIN_NAMESPACE
 
 
@@ -40,13 +47,13 @@ size_t qHash(const HashStringList &list)
     return list.m_hash;
 }
 
-static int nextFileId;
+static std::atomic<int> nextFileId = 0;
 
 class VisitRecorder {
 public:
     VisitRecorder()
     {
-        m_ba.resize(nextFileId);
+        m_ba.resize(nextFileId.load());
     }
     bool tryVisit(int fileId)
     {
@@ -75,6 +82,7 @@ public:
     void setInput(const QString &in);
     void setInput(QTextStream &ts, const QString &fileName);
     void setTranslator(Translator *_tor) { tor = _tor; }
+    void setIncludeCache(const CppIncludeCache *cache) { includeCache = cache; }
     void parse(ConversionData &cd, const QStringList &includeStack, QSet<QString> &inclusions);
     void parseInternal(ConversionData &cd, const QStringList &includeStack, QSet<QString> &inclusions);
     const ParseResults *recordResults(bool isHeader);
@@ -111,6 +119,9 @@ private:
     std::ostream &yyMsg(int line = 0);
 
     int getChar();
+    inline void copyPlainChars(ushort *&ptr, uchar stops);
+    inline void skipPlainChars(uchar stops);
+    inline void skipBlanks();
     TokenType lookAheadToSemicolonOrLeftBrace();
     TokenType getToken();
 
@@ -134,6 +145,8 @@ private:
 
     void processInclude(const QString &file, ConversionData &cd,
                         const QStringList &includeStack, QSet<QString> &inclusions);
+    bool loadCachedInclude(const QString &cleanFile, bool hasTranslator, ConversionData &cd,
+                           const QStringList &includeStack, QSet<QString> &inclusions);
 
     void saveState(CppParserState *state);
     void loadState(const CppParserState &state);
@@ -206,6 +219,8 @@ private:
     ParseResults *results;
     Translator *tor;
     bool directInclude;
+    const CppIncludeCache *includeCache = nullptr;
+    CppIncludeCache::Recording *recording = nullptr; // of the header being parsed stand-alone
 
     CppParserState savedState;
     int yyMinBraceDepth;
@@ -235,9 +250,14 @@ CppParser::CppParser(ParseResults *_results)
 }
 
 
+// Where the parsers of the calling thread write their diagnostics. The
+// threads of a parallel run buffer them, to print them in file order.
+static thread_local std::ostream *yyMsgStream = nullptr;
+
 std::ostream &CppParser::yyMsg(int line)
 {
-    return std::cerr << qPrintable(yyFileName) << ':' << (line ? line : yyLineNo) << ": ";
+    std::ostream &out = yyMsgStream ? *yyMsgStream : std::cerr;
+    return out << qPrintable(yyFileName) << ':' << (line ? line : yyLineNo) << ": ";
 }
 
 void CppParser::setInput(const QString &in)
@@ -276,6 +296,78 @@ void CppParser::setInput(QTextStream &ts, const QString &fileName)
   The 0 doesn't produce any token.
 */
 
+/*
+  Classes of the ASCII characters for skipping over the spans of the input
+  that getChar() would return as they are. All other characters are plain.
+*/
+enum CharClass : uchar {
+    Special = 0x01, // handled by getChar(): the terminating 0, '\\', '\r', '\n'
+    IdentChar = 0x02,
+    Blank = 0x04,
+    Star = 0x08,
+    Slash = 0x10,
+    Quote = 0x20
+};
+
+struct CharClasses
+{
+    constexpr CharClasses()
+    {
+        table[0] = table['\\'] = table['\r'] = table['\n'] = Special;
+        for (int c = 'a'; c <= 'z'; ++c)
+            table[c] = table[c - 'a' + 'A'] = IdentChar;
+        for (int c = '0'; c <= '9'; ++c)
+            table[c] = IdentChar;
+        table['_'] = IdentChar;
+        table[' '] = table['\t'] = Blank;
+        table['*'] = Star;
+        table['/'] = Slash;
+        table['"'] = Quote;
+    }
+
+    uchar table[128] = {};
+};
+
+static constexpr CharClasses charClasses;
+
+static inline bool hasCharClass(ushort c, uchar classes)
+{
+    return c < 128 && (charClasses.table[c] & classes);
+}
+
+/*
+  Copies the characters up to the next one of the classes \a stops or one
+  that is special to getChar() to \a ptr, like reading them with getChar()
+  would. This is only used after a character that cleared yyAtNewline.
+*/
+void CppParser::copyPlainChars(ushort *&ptr, uchar stops)
+{
+    const ushort *uc = yyInPtr;
+    stops |= Special;
+    while (!hasCharClass(*uc, stops))
+        *ptr++ = *uc++;
+    yyInPtr = uc;
+}
+
+// Like copyPlainChars(), but drops the characters.
+void CppParser::skipPlainChars(uchar stops)
+{
+    const ushort *uc = yyInPtr;
+    stops |= Special;
+    while (!hasCharClass(*uc, stops))
+        ++uc;
+    yyInPtr = uc;
+}
+
+// Skips the blanks getChar() would return next, they do not change any state.
+void CppParser::skipBlanks()
+{
+    const ushort *uc = yyInPtr;
+    while (hasCharClass(*uc, Blank))
+        ++uc;
+    yyInPtr = uc;
+}
+
 int CppParser::getChar()
 {
     const ushort *uc = yyInPtr;
@@ -355,6 +447,38 @@ STRING(signals);
 STRING(Q_SLOTS);
 STRING(Q_SIGNALS);
 
+/*
+  For each first character, the lengths of the keywords getToken() looks
+  for, so that most identifiers need no string comparison.
+*/
+struct KeywordLengths
+{
+    constexpr KeywordLengths()
+    {
+        const char *const keywords[] = {
+            "NULL", "Q_NULLPTR", "Q_OBJECT", "Q_SLOTS", "Q_SIGNALS", "class", "friend",
+            "namespace", "nullptr", "operator", "public", "protected", "private", "return",
+            "struct", "slots", "signals", "using"
+        };
+        for (const char *keyword : keywords) {
+            int length = 0;
+            while (keyword[length])
+                ++length;
+            table[uchar(keyword[0])] |= 1u << length;
+        }
+    }
+
+    quint32 table[128] = {};
+};
+
+static constexpr KeywordLengths keywordLengths;
+
+static inline bool maybeKeyword(const QString &word)
+{
+    const ushort c = word.unicode()[0].unicode();
+    return c < 128 && word.size() < 32 && (keywordLengths.table[c] & (1u << word.size()));
+}
+
 CppParser::TokenType CppParser::getToken()
 {
   restart:
@@ -524,6 +648,7 @@ CppParser::TokenType CppParser::getToken()
                     yyCh = getChar();
                     if (yyCh == '/') {
                         do {
+                            skipPlainChars(0);
                             yyCh = getChar();
                         } while (yyCh != EOF && yyCh != '\n');
                         break;
@@ -531,6 +656,10 @@ CppParser::TokenType CppParser::getToken()
                         bool metAster = false;
 
                         forever {
+                            const ushort *uc = yyInPtr;
+                            skipPlainChars(Star | Slash);
+                            if (yyInPtr != uc)
+                                metAster = false;
                             yyCh = getChar();
                             if (yyCh == EOF) {
                                 yyMsg() << "Unterminated C++ comment\n";
@@ -548,6 +677,8 @@ CppParser::TokenType CppParser::getToken()
                         }
                     }
                 } else {
+                    if (yyCh != '\n')
+                        skipPlainChars(Slash);
                     yyCh = getChar();
                 }
             } while (yyCh != '\n' && yyCh != EOF);
@@ -556,6 +687,10 @@ CppParser::TokenType CppParser::getToken()
             ushort *ptr = (ushort *)yyWord.unicode();
             do {
                 *ptr++ = yyCh;
+                const ushort *uc = yyInPtr;
+                while (hasCharClass(*uc, IdentChar))
+                    *ptr++ = *uc++;
+                yyInPtr = uc;
                 yyCh = getChar();
             } while ((yyCh >= 'A' && yyCh <= 'Z') || (yyCh >= 'a' && yyCh <= 'z')
                      || (yyCh >= '0' && yyCh <= '9') || yyCh == '_');
@@ -563,7 +698,7 @@ CppParser::TokenType CppParser::getToken()
 
             //qDebug() << "IDENT: " << yyWord;
 
-            switch (yyWord.unicode()[0].unicode()) {
+            switch (maybeKeyword(yyWord) ? yyWord.unicode()[0].unicode() : 0) {
             case 'N':
                 if (yyWord == strNULL)
                     return Tok_Null;
@@ -692,6 +827,7 @@ CppParser::TokenType CppParser::getToken()
                     yyCh = getChar();
                     return Tok_Cancel; // Break out of any multi-token constructs
                 }
+                skipBlanks();
                 yyCh = getChar();
                 break;
             case '/':
@@ -699,6 +835,7 @@ CppParser::TokenType CppParser::getToken()
                 if (yyCh == '/') {
                     ushort *ptr = (ushort *)yyWord.unicode();
                     do {
+                        copyPlainChars(ptr, 0);
                         yyCh = getChar();
                         if (yyCh == EOF)
                             break;
@@ -711,6 +848,10 @@ CppParser::TokenType CppParser::getToken()
                     ushort *ptr = (ushort *)yyWord.unicode();
 
                     forever {
+                        const ushort *uc = yyInPtr;
+                        copyPlainChars(ptr, Star | Slash);
+                        if (yyInPtr != uc)
+                            metAster = false;
                         yyCh = getChar();
                         if (yyCh == EOF) {
                             yyMsg() << "Unterminated C++ comment\n";
@@ -742,6 +883,7 @@ CppParser::TokenType CppParser::getToken()
                         *ptr++ = '\\';
                     }
                     *ptr++ = yyCh;
+                    copyPlainChars(ptr, Quote);
                     yyCh = getChar();
                 }
                 yyWord.resize(ptr - (ushort *)yyWord.unicode());
@@ -878,6 +1020,7 @@ CppParser::TokenType CppParser::getToken()
                 } while ((yyCh >= '0' && yyCh <= '9') || yyCh == '\'');
                 return Tok_Integer;
             default:
+                skipBlanks();
                 yyCh = getChar();
                 break;
             }
@@ -1130,29 +1273,41 @@ void CppParser::truncateNamespaces(NamespaceList *namespaces, int length)
 
 /*
   Functions for processing include files.
+
+  The parse results are cached per thread. The namespaces of cached results
+  are still modified while they are looked up (delayed alias resolution,
+  complaints about missing Q_OBJECT), so they cannot be shared between the
+  threads of a parallel run.
 */
 
 IncludeCycleHash &CppFiles::includeCycles()
 {
-    static IncludeCycleHash cycles;
+    static thread_local IncludeCycleHash cycles;
 
     return cycles;
 }
 
 TranslatorHash &CppFiles::translatedFiles()
 {
-    static TranslatorHash tors;
+    static thread_local TranslatorHash tors;
 
     return tors;
 }
 
 QSet<QString> &CppFiles::blacklistedFiles()
 {
-    static QSet<QString> blacklisted;
+    static thread_local QSet<QString> blacklisted;
 
     return blacklisted;
 }
 
+int &CppFiles::cycleCount()
+{
+    static thread_local int count = 0;
+
+    return count;
+}
+
 QSet<const ParseResults *> CppFiles::getResults(const QString &cleanFile)
 {
     IncludeCycle * const cycle = includeCycles().value(cleanFile);
@@ -1196,8 +1351,14 @@ void CppFiles::setBlacklisted(const QString &cleanFile)
     blacklistedFiles().insert(cleanFile);
 }
 
+int CppFiles::includeCycleCount()
+{
+    return cycleCount();
+}
+
 void CppFiles::addIncludeCycle(const QSet<QString> &fileNames)
 {
+    ++cycleCount();
     IncludeCycle * const cycle = new IncludeCycle;
     cycle->fileNames = fileNames;
 
@@ -1224,6 +1385,27 @@ static bool isHeader(const QString &name)
     return fileExt.isEmpty() || fileExt.startsWith(QLatin1Char('h'), Qt::CaseInsensitive);
 }
 
+// Returns the files an #include of \a name in \a fromFile refers to.
+static QStringList resolveInclude(const QString &fromFile, const QString &name, bool angled,
+                                  const ConversionData &cd)
+{
+    if (!angled) {
+        const QString file = QDir(QFileInfo(fromFile).absolutePath()).absoluteFilePath(name);
+        if (QFileInfo(file).isFile())
+            return QStringList(file);
+    }
+
+    const QStringList cSources = cd.m_allCSources.values(name);
+    if (!cSources.isEmpty())
+        return cSources;
+    for (const QString &incPath : qAsConst(cd.m_includePath)) {
+        const QString file = QDir(incPath).absoluteFilePath(name);
+        if (QFileInfo(file).isFile())
+            return QStringList(file);
+    }
+    return QStringList();
+}
+
 void CppParser::processInclude(const QString &file, ConversionData &cd, const QStringList &includeStack,
                                QSet<QString> &inclusions)
 {
@@ -1254,12 +1436,32 @@ void CppParser::processInclude(const QString &file, ConversionData &cd, const QS
         QSet<const ParseResults *> res = CppFiles::getResults(cleanFile);
         if (!res.isEmpty()) {
             results->includes.unite(res);
+            if (recording)
+                recording->dependencies.append(cleanFile);
             return;
         }
 
         isIndirect = true;
     }
 
+    bool hasTranslator = false;
+    if (isIndirect) {
+        for (const QString &projectRoot : qAsConst(cd.m_projectRoots))
+            if (cleanFile.startsWith(projectRoot)) {
+                hasTranslator = true;
+                break;
+            }
+
+        if (includeCache
+            && loadCachedInclude(cleanFile, hasTranslator, cd, includeStack, inclusions)) {
+            if (recording)
+                recording->dependencies.append(cleanFile);
+            prospectiveContext.clear();
+            pendingContext.clear();
+            return;
+        }
+    }
+
     QFile f(cleanFile);
     if (!f.open(QIODevice::ReadOnly)) {
         yyMsg() << qPrintable(
@@ -1274,18 +1476,43 @@ void CppParser::processInclude(const QString &file, ConversionData &cd, const QS
     inclusions.insert(cleanFile);
     if (isIndirect) {
         CppParser parser;
-        for (const QString &projectRoot : qAsConst(cd.m_projectRoots))
-            if (cleanFile.startsWith(projectRoot)) {
-                parser.setTranslator(new Translator);
-                break;
-            }
+        if (hasTranslator)
+            parser.setTranslator(new Translator);
+        parser.includeCache = includeCache;
+        CppIncludeCache::Recording headerRecording;
+        if (includeCache) {
+            headerRecording.files.append(cleanFile);
+            headerRecording.cycleCount = CppFiles::includeCycleCount();
+            parser.recording = &headerRecording;
+        }
         parser.setInput(ts, cleanFile);
         QStringList stack = includeStack;
         stack << cleanFile;
         parser.parse(cd, stack, inclusions);
+        // Headers that are part of an include cycle are not cached, their
+        // results depend on where the cycle was entered.
+        if (includeCache && headerRecording.cycleCount == CppFiles::includeCycleCount()) {
+            CppIncludeCache::Entry entry;
+            entry.recording = std::move(headerRecording);
+            entry.hasTranslator = hasTranslator;
+            entry.rootNamespace = CppIncludeCache::writeNamespace(parser.results->rootNamespace);
+            if (parser.tor) {
+                entry.messages = parser.tor->messages();
+                entry.extras = parser.tor->extras();
+            }
+            includeCache->store(cleanFile, entry);
+        }
         results->includes.insert(parser.recordResults(true));
+        if (recording)
+            recording->dependencies.append(cleanFile);
     } else {
+        if (recording) {
+            recording->files.append(cleanFile);
+            recording->blacklisted.append(cleanFile);
+        }
         CppParser parser(results);
+        parser.includeCache = includeCache;
+        parser.recording = recording;
         parser.namespaces = namespaces;
         parser.functionContext = functionContext;
         parser.functionContextUnresolved = functionContextUnresolved;
@@ -1303,6 +1530,63 @@ void CppParser::processInclude(const QString &file, ConversionData &cd, const QS
     pendingContext.clear();
 }
 
+/*
+  Uses the cached results of the header \a cleanFile if they are still
+  valid: the header, the files included into it and those of the headers
+  whose results were used did not change, its #include directives resolve
+  to the same files, and the headers whose results were used are still
+  processed stand-alone.
+*/
+bool CppParser::loadCachedInclude(const QString &cleanFile, bool hasTranslator,
+                                  ConversionData &cd, const QStringList &includeStack,
+                                  QSet<QString> &inclusions)
+{
+    CppIncludeCache::Entry entry;
+    if (!includeCache->load(cleanFile, &entry) || entry.hasTranslator != hasTranslator)
+        return false;
+    for (const CppIncludeCache::Include &include : qAsConst(entry.recording.includes)) {
+        if (resolveInclude(include.fromFile, include.name, include.angled, cd) != include.files)
+            return false;
+    }
+    for (const QString &dependency : qAsConst(entry.recording.dependencies)) {
+        if (CppFiles::isBlacklisted(dependency) || includeStack.contains(dependency))
+            return false;
+    }
+
+    CppParser parser;
+    parser.includeCache = includeCache;
+    parser.yyFileName = cleanFile;
+    parser.namespaces << HashString();
+    parser.functionContext = parser.namespaces;
+    QStringList stack = includeStack;
+    stack << cleanFile;
+    inclusions.insert(cleanFile);
+    for (const QString &dependency : qAsConst(entry.recording.dependencies))
+        parser.processInclude(dependency, cd, stack, inclusions);
+    inclusions.remove(cleanFile);
+
+    const auto findNamespace = [&parser](const NamespaceList &path) {
+        return parser.findNamespace(path);
+    };
+    if (!CppIncludeCache::readNamespace(entry.rootNamespace, &parser.results->rootNamespace,
+                                        findNamespace)) {
+        parser.deleteResults();
+        return false;
+    }
+
+    if (hasTranslator) {
+        Translator *tor = new Translator;
+        for (const TranslatorMessage &msg : qAsConst(entry.messages))
+            tor->append(msg);
+        tor->setExtras(entry.extras);
+        parser.setTranslator(tor);
+    }
+    for (const QString &file : qAsConst(entry.recording.blacklisted))
+        CppFiles::setBlacklisted(file);
+    results->includes.insert(parser.recordResults(true));
+    return true;
+}
+
 /*
   The third part of this source file is the parser. It accomplishes
   a very easy task: It finds all strings inside a tr() or translate()
@@ -1663,32 +1947,17 @@ void CppParser::parseInternal(ConversionData &cd, const QStringList &includeStac
         }
         //qDebug() << "TOKEN: " << yyTok;
         switch (yyTok) {
-        case Tok_QuotedInclude: {
-            text = QDir(QFileInfo(yyFileName).absolutePath()).absoluteFilePath(yyWord);
-            text.detach();
-            if (QFileInfo(text).isFile()) {
-                processInclude(text, cd, includeStack, inclusions);
-                yyTok = getToken();
-                break;
-            }
-        }
-        Q_FALLTHROUGH();
+        case Tok_QuotedInclude:
         case Tok_AngledInclude: {
-            const QStringList cSources = cd.m_allCSources.values(yyWord);
-            if (!cSources.isEmpty()) {
-                for (const QString &cSource : cSources)
-                    processInclude(cSource, cd, includeStack, inclusions);
-                goto incOk;
-            }
-            for (const QString &incPath : qAsConst(cd.m_includePath)) {
-                text = QDir(incPath).absoluteFilePath(yyWord);
-                text.detach();
-                if (QFileInfo(text).isFile()) {
-                    processInclude(text, cd, includeStack, inclusions);
-                    goto incOk;
-                }
+            const bool angled = yyTok == Tok_AngledInclude;
+            const QStringList files = resolveInclude(yyFileName, yyWord, angled, cd);
+            if (recording) {
+                QString name = yyWord;
+                name.detach();
+                recording->includes.append({ yyFileName, name, angled, files });
             }
-          incOk:
+            for (const QString &file : files)
+                processInclude(file, cd, includeStack, inclusions);
             yyTok = getToken();
             break;
         }
@@ -2207,22 +2476,29 @@ const ParseResults *CppParser::recordResults(bool isHeader)
     }
 }
 
-void loadCPP(Translator &translator, const QStringList &filenames, ConversionData &cd)
+// Parses the files in the range [begin, end) of filenames, using the include
+// caches of the calling thread.
+static void parseCppFiles(const QStringList &filenames, qsizetype begin, qsizetype end,
+                          ConversionData &cd, const CppIncludeCache *includeCache,
+                          QStringList *errors)
 {
     QStringConverter::Encoding e = cd.m_sourceIsUtf16 ? QStringConverter::Utf16 : QStringConverter::Utf8;
 
-    for (const QString &filename : filenames) {
+    for (qsizetype i = begin; i < end; ++i) {
+        const QString &filename = filenames.at(i);
         if (!CppFiles::getResults(filename).isEmpty() || CppFiles::isBlacklisted(filename))
             continue;
 
+        TraceSpan span("parse", "loadCPP", filename);
         QFile file(filename);
         if (!file.open(QIODevice::ReadOnly)) {
-            cd.appendError(QStringLiteral("Cannot open %1: %2").arg(filename,
+            errors->append(QStringLiteral("Cannot open %1: %2").arg(filename,
                                                                     file.errorString()));
             continue;
         }
 
         CppParser parser;
+        parser.setIncludeCache(includeCache);
         QTextStream ts(&file);
         ts.setEncoding(e);
         ts.setAutoDetectUnicode(true);
@@ -2233,13 +2509,90 @@ void loadCPP(Translator &translator, const QStringList &filenames, ConversionDat
         parser.parse(cd, QStringList(), inclusions);
         parser.recordResults(isHeader(filename));
     }
+}
+
+void loadCPP(Translator &translator, const QStringList &filenames, ConversionData &cd)
+{
+    // The include directives are checked when an entry is loaded, so only
+    // what else affects the parse of a header goes into the configuration.
+    CppIncludeCache cache(cd.m_cppIncludeCacheDir);
+    const CppIncludeCache *includeCache = cache.isEnabled() ? &cache : nullptr;
+    if (includeCache) {
+        QByteArray configuration = cd.m_sourceIsUtf16 ? "utf-16" : "utf-8";
+        for (const QString &exclude : qAsConst(cd.m_excludes))
+            configuration += '\0' + exclude.toUtf8();
+        cache.setConfiguration(configuration);
+    }
+
+    const qsizetype threadCount = qMin(qsizetype(cd.m_maxThreadCount), filenames.size());
+    if (threadCount <= 1) {
+        QStringList errors;
+        parseCppFiles(filenames, 0, filenames.size(), cd, includeCache, &errors);
+        for (const QString &error : qAsConst(errors))
+            cd.appendError(error);
+
+        for (const QString &filename : filenames) {
+            if (!CppFiles::isBlacklisted(filename)) {
+                if (const Translator *tor = CppFiles::getTranslator(filename)) {
+                    for (const TranslatorMessage &msg : tor->messages())
+                        translator.extend(msg, cd);
+                }
+            }
+        }
+        return;
+    }
 
-    for (const QString &filename : filenames) {
-        if (!CppFiles::isBlacklisted(filename)) {
-            if (const Translator *tor = CppFiles::getTranslator(filename)) {
-                for (const TranslatorMessage &msg : tor->messages())
-                    translator.extend(msg, cd);
+    // Each thread parses a contiguous chunk of the files with its own include
+    // caches, so files from the same directory, which likely include the same
+    // headers, end up in the same thread. The assignment of files to threads
+    // only depends on the thread count, which keeps the output reproducible.
+    struct ChunkResults {
+        TranslatorHash translators;
+        QSet<QString> blacklisted;
+        QStringList errors;
+        std::ostringstream diagnostics;
+    };
+    const qsizetype chunkSize = (filenames.size() + threadCount - 1) / threadCount;
+    std::vector<ChunkResults> chunkResults(threadCount);
+    std::vector<std::thread> workers;
+    for (qsizetype i = 0; i < threadCount; ++i) {
+        workers.emplace_back([&filenames, &cd, includeCache, &chunkResults, chunkSize, i]() {
+            ChunkResults &results = chunkResults[i];
+            const qsizetype begin = i * chunkSize;
+            const qsizetype end = qMin(begin + chunkSize, filenames.size());
+            yyMsgStream = &results.diagnostics;
+            parseCppFiles(filenames, begin, end, cd, includeCache, &results.errors);
+            yyMsgStream = nullptr;
+            for (qsizetype k = begin; k < end; ++k) {
+                if (const Translator *tor = CppFiles::getTranslator(filenames.at(k)))
+                    results.translators.insert(filenames.at(k), tor);
+            }
+            for (const QString &filename : filenames) {
+                if (CppFiles::isBlacklisted(filename))
+                    results.blacklisted.insert(filename);
             }
+        });
+    }
+    for (std::thread &worker : workers)
+        worker.join();
+
+    // A file that was included as part of another file in any of the threads
+    // must not contribute its messages on its own, like in the serial case.
+    QSet<QString> blacklisted;
+    for (const ChunkResults &results : chunkResults) {
+        std::cerr << results.diagnostics.str();
+        blacklisted.unite(results.blacklisted);
+        for (const QString &error : results.errors)
+            cd.appendError(error);
+    }
+
+    for (qsizetype i = 0; i < filenames.size(); ++i) {
+        const QString &filename = filenames.at(i);
+        if (blacklisted.contains(filename))
+            continue;
+        if (const Translator *tor = chunkResults[i / chunkSize].translators.value(filename)) {
+            for (const TranslatorMessage &msg : tor->messages())
+                translator.extend(msg, cd);
         }
     }
 }
@@ -32,6 +32,9 @@ struct HashStringList {
     mutable uint m_hash; // We use the highest bit as a validity indicator (set => invalid)
 };
 
+size_t qHash(const HashString &str);
+size_t qHash(const HashStringList &list);
+
 typedef QList<HashString> NamespaceList;
 
 struct Namespace {
@@ -92,11 +95,13 @@ public:
     static bool isBlacklisted(const QString &cleanFile);
     static void setBlacklisted(const QString &cleanFile);
     static void addIncludeCycle(const QSet<QString> &fileNames);
+    static int includeCycleCount();
 
 private:
     static IncludeCycleHash &includeCycles();
     static TranslatorHash &translatedFiles();
     static QSet<QString> &blacklistedFiles();
+    static int &cycleCount();
 };
 
 QT_END_NAMESPACE
@@ -2,14 +2,18 @@
 // SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
 
 #include "cpp_clang.h"
+#include "clangparsecache.h"
+#include "clangprefilter.h"
+#include "clangprefixheader.h"
 #include "clangtoolastreader.h"
 #include "filesignificancecheck.h"
-#include "lupdatepreprocessoraction.h"
 #include "synchronized.h"
+#include "trace.h"
 #include "translator.h"
 
 #include <QLibraryInfo>
 #include <QtCore/qdir.h>
+#include <QtCore/qelapsedtimer.h>
 #include <QtCore/qfileinfo.h>
 #include <QtCore/qjsonarray.h>
 #include <QtCore/qjsondocument.h>
@@ -22,6 +26,7 @@
 #include <clang/Tooling/CompilationDatabase.h>
 
 #include <algorithm>
+#include <iterator>
 #include <limits>
 #include <thread>
 #include <iostream>
@@ -239,10 +244,21 @@ std::vector<std::string> ClangCppParser::getAliasFunctionDefinition()
 }
 
 static std::vector<std::string> aliasDefinition;
+static size_t maxThreadCount = 0;
 
-static clang::tooling::ArgumentsAdjuster getClangArgumentAdjuster()
+// Returns the number of worker threads to start for \a jobCount jobs,
+// honoring the limit passed with the -j option.
+static size_t producerCount(size_t jobCount)
+{
+    size_t threadCount = std::max(size_t(std::thread::hardware_concurrency()), size_t(1));
+    if (maxThreadCount > 0)
+        threadCount = std::min(threadCount, maxThreadCount);
+    return std::min(jobCount, threadCount);
+}
+
+static clang::tooling::ArgumentsAdjuster getClangArgumentAdjuster(
+        const QByteArrayList &compilerIncludeFlags)
 {
-    const QByteArrayList compilerIncludeFlags = getIncludePathsFromCompiler();
     return [=](const clang::tooling::CommandLineArguments &args,
                llvm::StringRef /*unused*/) {
         clang::tooling::CommandLineArguments adjustedArgs;
@@ -365,6 +381,40 @@ static bool generateCompilationDatabase(const QString &outputFilePath, const Con
     return true;
 }
 
+// Orders the translation units by their expected cost, the most expensive
+// first. The cost is the parse time recorded by the previous run if there is
+// one, otherwise it is estimated from the file size.
+static void sortByExpectedCost(std::vector<size_t> &indexes,
+                               const std::vector<std::string> &sources,
+                               const std::vector<qint64> &lastParseTimes)
+{
+    std::vector<double> costs(sources.size(), 0.);
+    qint64 knownTime = 0;
+    qint64 knownSize = 0;
+    for (size_t index : indexes) {
+        const qint64 size = QFileInfo(QString::fromStdString(sources[index])).size();
+        costs[index] = double(size);
+        if (lastParseTimes[index] >= 0) {
+            knownTime += lastParseTimes[index];
+            knownSize += size;
+        }
+    }
+
+    // Bring the estimates based on the size into the same unit as the
+    // recorded parse times.
+    const double timePerByte = knownSize > 0 ? double(knownTime) / double(knownSize) : 1.;
+    for (size_t index : indexes) {
+        if (lastParseTimes[index] >= 0)
+            costs[index] = double(lastParseTimes[index]);
+        else
+            costs[index] *= timePerByte;
+    }
+
+    std::stable_sort(indexes.begin(), indexes.end(), [&](size_t lhs, size_t rhs) {
+        return costs[lhs] > costs[rhs];
+    });
+}
+
 // Sort messages in such a way that they appear in the same order like in the given file list.
 static void sortMessagesByFileOrder(ClangCppParser::TranslatorMessageVector &messages,
                                     const QStringList &files)
@@ -403,6 +453,7 @@ bool ClangCppParser::hasAliases()
 void ClangCppParser::loadCPP(Translator &translator, const QStringList &files, ConversionData &cd,
                             bool *fail)
 {
+    TraceSpan span("parse", "ClangCppParser::loadCPP");
     FileSignificanceCheck::create();
     auto cleanup = qScopeGuard(FileSignificanceCheck::destroy);
     FileSignificanceCheck::the()->setExclusionPatterns(cd.m_excludes);
@@ -413,6 +464,7 @@ void ClangCppParser::loadCPP(Translator &translator, const QStringList &files, C
 
     if (hasAliases())
         aliasDefinition = getAliasFunctionDefinition();
+    maxThreadCount = size_t(std::max(cd.m_maxThreadCount, 0));
 
     // pre-process the files by a simple text search if there is any occurrence
     // of things we are interested in
@@ -454,39 +506,127 @@ void ClangCppParser::loadCPP(Translator &translator, const QStringList &files, C
         return;
     }
 
-    TranslationStores ast, qdecl, qnoop;
-    Stores stores(ast, qdecl, qnoop);
+    const QByteArrayList compilerIncludeFlags = getIncludePathsFromCompiler();
+    clang::tooling::ArgumentsAdjuster argumentsAdjuster =
+            getClangArgumentAdjuster(compilerIncludeFlags);
+
+    ClangParseCache cache(cd.m_clangParseCacheDir);
+    if (cache.isEnabled()) {
+        QByteArray configuration(QT_VERSION_STR " " LUPDATE_CLANG_VERSION_STR);
+        for (const std::string &alias : aliasDefinition)
+            configuration += '\0' + QByteArray::fromStdString(alias);
+        for (const QByteArray &flag : compilerIncludeFlags)
+            configuration += '\0' + flag;
+        configuration += '\0' + cd.m_rootDirs.join(u'\0').toUtf8();
+        configuration += '\0' + cd.m_excludes.join(u'\0').toUtf8();
+        configuration += '\0' + cd.m_clangPrefixHeader.toUtf8();
+        cache.setConfiguration(configuration);
+    }
 
-    std::vector<std::thread> producers;
-    ReadSynchronizedRef<std::string> ppSources(sources);
-    WriteSynchronizedRef<TranslationRelatedStore> ppStore(stores.Preprocessor);
-    size_t idealProducerCount = std::min(ppSources.size(), size_t(std::thread::hardware_concurrency()));
-    clang::tooling::ArgumentsAdjuster argumentsAdjuster = getClangArgumentAdjuster();
+    ClangPrefixHeader prefixHeader(cd.m_clangPrefixHeader, argumentsAdjuster);
+
+    // The results are kept per translation unit and only merged once all
+    // workers are done, in the order of the input files. This avoids locking
+    // for every store and keeps the output independent of thread scheduling.
+    std::vector<ClangParseCache::Entry> results(sources.size());
+
+    // Replay the translation units that did not change since the last run,
+    // only the remaining ones are handed over to clang.
+    std::vector<QByteArray> cacheKeys(sources.size());
+    std::vector<qint64> lastParseTimes(sources.size(), -1);
+    std::vector<size_t> pendingSources;
+    pendingSources.reserve(sources.size());
+    for (size_t i = 0; i < sources.size(); ++i) {
+        if (cache.isEnabled()) {
+            cacheKeys[i] = cache.key(sources[i], *db);
+            if (cache.load(sources[i], cacheKeys[i], &results[i], &lastParseTimes[i])) {
+                qCDebug(lcClang) << "Parse cache hit: " << sources[i];
+                continue;
+            }
+        }
+        pendingSources.push_back(i);
+    }
 
-    for (size_t i = 0; i < idealProducerCount; ++i) {
-        std::thread producer([&ppSources, &db, &ppStore, &argumentsAdjuster]() {
-            std::string file;
-            while (ppSources.next(&file)) {
-                clang::tooling::ClangTool tool(*db, file);
+    // Hand out the most expensive translation units first, so that a few huge
+    // ones do not end up being parsed last while all other workers are idle.
+    // The workers share one queue: any idle worker takes the next unit.
+    sortByExpectedCost(pendingSources, sources, lastParseTimes);
+
+    // The messages from the prefix header are collected once. The translation
+    // units loading it precompiled do not see its macro expansions and comments.
+    ClangParseCache::Entry prefixEntry;
+    QStringList prefixDependencies;
+    bool usePrefixHeader = false;
+    if (prefixHeader.isEnabled() && !pendingSources.empty()) {
+        const std::string &header = prefixHeader.header();
+        const std::unique_ptr<CompilationDatabase> prefixDb =
+                prefixHeader.database(db->getCompileCommands(sources[pendingSources.front()]));
+        if (prefixDb) {
+            const QByteArray prefixKey = cache.key(header, *prefixDb);
+            if (!cache.load(header, prefixKey, &prefixEntry)) {
+                Stores fileStores(prefixEntry.ast, prefixEntry.qDeclareTrWithContext,
+                                  prefixEntry.qNoopTranslationWithContext);
+                clang::tooling::ClangTool tool(*prefixDb, header);
                 tool.appendArgumentsAdjuster(argumentsAdjuster);
-                tool.run(new LupdatePreprocessorActionFactory(&ppStore));
+                tool.run(new LupdateToolActionFactory(&fileStores));
+                prefixEntry.dependencies = ClangParseCache::includedFiles(fileStores.Preprocessor);
+                cache.store(header, prefixKey, prefixEntry.dependencies, prefixEntry);
             }
-        });
-        producers.emplace_back(std::move(producer));
+            prefixDependencies = prefixEntry.dependencies;
+            prefixDependencies.prepend(QString::fromStdString(header));
+            usePrefixHeader = true;
+        } else {
+            qWarning("lupdate: Cannot use the prefix header %s with the compile commands of %s",
+                     header.c_str(), sources[pendingSources.front()].c_str());
+        }
     }
-    for (auto &producer : producers)
-        producer.join();
-    producers.clear();
 
-    ReadSynchronizedRef<std::string> astSources(sources);
-    idealProducerCount = std::min(astSources.size(), size_t(std::thread::hardware_concurrency()));
+    // Translation units that cannot contain translation information according
+    // to a plain text search are not handed to clang at all. Every other one
+    // is handled by a single compiler invocation,
+    // which collects both the preprocessor and the AST stores.
+    const ClangPrefilter prefilter;
+    std::vector<std::thread> producers;
+    ReadSynchronizedRef<size_t> astSources(pendingSources);
+    const size_t idealProducerCount = producerCount(astSources.size());
     for (size_t i = 0; i < idealProducerCount; ++i) {
-        std::thread producer([&astSources, &db, &stores, &argumentsAdjuster]() {
-            std::string file;
-            while (astSources.next(&file)) {
-                clang::tooling::ClangTool tool(*db, file);
+        std::thread producer([&]() {
+            size_t index;
+            while (astSources.next(&index)) {
+                ClangParseCache::Entry &entry = results[index];
+                QStringList dependencies;
+                if (!prefilter.mayContainTranslations(sources[index],
+                                                      db->getCompileCommands(sources[index]),
+                                                      &dependencies)) {
+                    qCDebug(lcClang) << "No translation information in: " << sources[index];
+                    entry.parseTime = 0;
+                    cache.store(sources[index], cacheKeys[index], dependencies, entry);
+                    continue;
+                }
+
+                Stores fileStores(entry.ast, entry.qDeclareTrWithContext,
+                                  entry.qNoopTranslationWithContext);
+
+                TraceSpan span("parse", "clang", QString::fromStdString(sources[index]));
+                QElapsedTimer timer;
+                timer.start();
+                std::string pch;
+                if (usePrefixHeader)
+                    pch = prefixHeader.precompiledHeader(db->getCompileCommands(sources[index]));
+                clang::tooling::ClangTool tool(*db, sources[index]);
                 tool.appendArgumentsAdjuster(argumentsAdjuster);
-                tool.run(new LupdateToolActionFactory(&stores));
+                if (!pch.empty()) {
+                    tool.appendArgumentsAdjuster(clang::tooling::getInsertArgumentAdjuster(
+                            { "-include-pch", pch },
+                            clang::tooling::ArgumentInsertPosition::BEGIN));
+                }
+                tool.run(new LupdateToolActionFactory(&fileStores));
+                entry.parseTime = timer.elapsed();
+
+                dependencies = ClangParseCache::includedFiles(fileStores.Preprocessor);
+                if (!pch.empty())
+                    dependencies += prefixDependencies;
+                cache.store(sources[index], cacheKeys[index], dependencies, entry);
             }
         });
         producers.emplace_back(std::move(producer));
@@ -494,17 +634,30 @@ void ClangCppParser::loadCPP(Translator &translator, const QStringList &files, C
     for (auto &producer : producers)
         producer.join();
     producers.clear();
+    if (usePrefixHeader)
+        results.push_back(std::move(prefixEntry));
+
+    TranslationStores ast, qdecl, qnoop;
+    for (ClangParseCache::Entry &entry : results) {
+        std::move(entry.ast.begin(), entry.ast.end(), std::back_inserter(ast));
+        std::move(entry.qDeclareTrWithContext.begin(), entry.qDeclareTrWithContext.end(),
+                  std::back_inserter(qdecl));
+        std::move(entry.qNoopTranslationWithContext.begin(),
+                  entry.qNoopTranslationWithContext.end(), std::back_inserter(qnoop));
+    }
+    results.clear();
 
     TranslationStores finalStores;
-    WriteSynchronizedRef<TranslationRelatedStore> wsv(finalStores);
 
     ReadSynchronizedRef<TranslationRelatedStore> rsv(ast);
+    IndexedWriteRef<TranslationRelatedStore> wsv(finalStores, rsv.size());
     ClangCppParser::correctAstTranslationContext(rsv, wsv, qdecl);
 
     ReadSynchronizedRef<TranslationRelatedStore> rsvQNoop(qnoop);
+    IndexedWriteRef<TranslationRelatedStore> wsvQNoop(finalStores, rsvQNoop.size());
     //unlike ast translation context, qnoop context don't need to be corrected
     //(because Q_DECLARE_TR_FUNCTION context is already applied).
-    ClangCppParser::finalize(rsvQNoop, wsv);
+    ClangCppParser::finalize(rsvQNoop, wsvQNoop);
 
     TranslatorMessageVector messages;
     for (auto &store : finalStores)
@@ -670,19 +823,20 @@ TranslatorMessage ClangCppParser::translatorMessage(const TranslationRelatedStor
 
 #define START_THREADS(RSV, WSV) \
     std::vector<std::thread> producers; \
-    const size_t idealProducerCount = std::min(RSV.size(), size_t(std::thread::hardware_concurrency())); \
+    const size_t idealProducerCount = producerCount(RSV.size()); \
     \
     for (size_t i = 0; i < idealProducerCount; ++i) { \
         std::thread producer([&]() { \
             TranslationRelatedStore store; \
-            while (RSV.next(&store)) { \
+            size_t index; \
+            while (RSV.next(&store, &index)) { \
                 if (!store.contextArg.isEmpty()) { \
-                    WSV.emplace_back(std::move(store)); \
+                    WSV.set(index, std::move(store)); \
                     continue; \
                 }
 
 #define JOIN_THREADS(WSV) \
-                WSV.emplace_back(std::move(store)); \
+                WSV.set(index, std::move(store)); \
             } \
         }); \
         producers.emplace_back(std::move(producer)); \
@@ -692,14 +846,14 @@ TranslatorMessage ClangCppParser::translatorMessage(const TranslationRelatedStor
         producer.join();
 
 void ClangCppParser::finalize(ReadSynchronizedRef<TranslationRelatedStore> &ast,
-    WriteSynchronizedRef<TranslationRelatedStore> &newAst)
+    IndexedWriteRef<TranslationRelatedStore> &newAst)
 {
     START_THREADS(ast, newAst)
     JOIN_THREADS(newAst)
 }
 
 void ClangCppParser::correctAstTranslationContext(ReadSynchronizedRef<TranslationRelatedStore> &ast,
-    WriteSynchronizedRef<TranslationRelatedStore> &newAst, const TranslationStores &qDecl)
+    IndexedWriteRef<TranslationRelatedStore> &newAst, const TranslationStores &qDecl)
 {
     START_THREADS(ast, newAst)
 
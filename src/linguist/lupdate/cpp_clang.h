@@ -307,9 +307,9 @@ namespace ClangCppParser
         const QString &id, bool plural, bool isID, bool isWarningOnly = false);
 
     void correctAstTranslationContext(ReadSynchronizedRef<TranslationRelatedStore> &ast,
-        WriteSynchronizedRef<TranslationRelatedStore> &newAst, const TranslationStores &qDecl);
+        IndexedWriteRef<TranslationRelatedStore> &newAst, const TranslationStores &qDecl);
     void finalize(ReadSynchronizedRef<TranslationRelatedStore> &ast,
-        WriteSynchronizedRef<TranslationRelatedStore> &newAst);
+        IndexedWriteRef<TranslationRelatedStore> &newAst);
 
     bool stringContainsTranslationInformation(llvm::StringRef ba);
     bool hasAliases();
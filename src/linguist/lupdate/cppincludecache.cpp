@@ -0,0 +1,278 @@
+// Copyright (C) 2023 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
+
+#include "cppincludecache.h"
+#include "incrementalmanifest.h"
+
+#include <QtCore/qcryptographichash.h>
+#include <QtCore/qdatastream.h>
+#include <QtCore/qfile.h>
+#include <QtCore/qfileinfo.h>
+#include <QtCore/qsavefile.h>
+
+QT_BEGIN_NAMESPACE
+
+using namespace Qt::StringLiterals;
+
+static const quint32 CacheMagic = 0x4c555048; // "LUPH"
+static const quint32 CacheVersion = 2;
+
+static QDataStream &operator<<(QDataStream &out, const CppIncludeCache::Include &include)
+{
+    out << include.fromFile << include.name << include.angled << include.files;
+    return out;
+}
+
+static QDataStream &operator>>(QDataStream &in, CppIncludeCache::Include &include)
+{
+    in >> include.fromFile >> include.name >> include.angled >> include.files;
+    return in;
+}
+
+static QStringList toStringList(const NamespaceList &list)
+{
+    QStringList strings;
+    strings.reserve(list.size());
+    for (const HashString &str : list)
+        strings.append(str.value());
+    return strings;
+}
+
+static NamespaceList toNamespaceList(const QStringList &strings)
+{
+    NamespaceList list;
+    list.reserve(strings.size());
+    for (const QString &str : strings)
+        list.append(HashString(str));
+    return list;
+}
+
+static void writeNamespaceTree(QDataStream &out, const Namespace &ns)
+{
+    out << ns.hasTrFunctions << ns.complained << (ns.classDef == &ns) << ns.trQualification;
+    out << quint32(ns.aliases.size());
+    for (auto it = ns.aliases.cbegin(), end = ns.aliases.cend(); it != end; ++it)
+        out << it.key().value() << toStringList(it.value());
+    out << quint32(ns.usings.size());
+    for (const HashStringList &usings : ns.usings)
+        out << toStringList(usings.value());
+    out << quint32(ns.children.size());
+    for (auto it = ns.children.cbegin(), end = ns.children.cend(); it != end; ++it) {
+        out << it.key().value();
+        writeNamespaceTree(out, **it);
+    }
+}
+
+// The namespace at \a path is filled in before it is added to its parent,
+// so that a class definition links to the definition it reopens from the
+// included headers, like in CppParser::modifyNamespace().
+static bool readNamespaceTree(QDataStream &in, Namespace *ns, NamespaceList *path,
+                              const CppIncludeCache::FindNamespace &findNamespace)
+{
+    bool ownClassDef = true;
+    in >> ns->hasTrFunctions >> ns->complained >> ownClassDef >> ns->trQualification;
+    if (!ownClassDef && path->size() > 1) {
+        if (const Namespace *ons = findNamespace(*path))
+            ns->classDef = ons->classDef;
+    }
+
+    quint32 count = 0;
+    in >> count;
+    for (quint32 i = 0; i < count && in.status() == QDataStream::Ok; ++i) {
+        QString name;
+        QStringList alias;
+        in >> name >> alias;
+        ns->aliases.insert(HashString(name), toNamespaceList(alias));
+    }
+    in >> count;
+    for (quint32 i = 0; i < count && in.status() == QDataStream::Ok; ++i) {
+        QStringList usings;
+        in >> usings;
+        ns->usings.append(HashStringList(toNamespaceList(usings)));
+    }
+    in >> count;
+    for (quint32 i = 0; i < count && in.status() == QDataStream::Ok; ++i) {
+        QString name;
+        in >> name;
+        path->append(HashString(name));
+        Namespace *child = new Namespace;
+        const bool ok = readNamespaceTree(in, child, path, findNamespace);
+        ns->children.insert(path->takeLast(), child);
+        if (!ok)
+            return false;
+    }
+    return in.status() == QDataStream::Ok;
+}
+
+CppIncludeCache::CppIncludeCache(const QString &directory)
+{
+    if (directory.isEmpty())
+        return;
+    m_directory.setPath(directory);
+    m_enabled = m_directory.mkpath(u"."_s);
+    if (!m_enabled)
+        qWarning("lupdate: Cannot create include cache directory %s", qPrintable(directory));
+}
+
+QByteArray CppIncludeCache::fileHash(const QString &filePath) const
+{
+    {
+        QMutexLocker lock(&m_fileHashesMutex);
+        const auto it = m_fileHashes.constFind(filePath);
+        if (it != m_fileHashes.cend())
+            return *it;
+    }
+
+    QByteArray hash;
+    QFile file(filePath);
+    if (file.open(QIODevice::ReadOnly)) {
+        QCryptographicHash hasher(QCryptographicHash::Sha1);
+        hasher.addData(&file);
+        hash = hasher.result();
+    }
+
+    QMutexLocker lock(&m_fileHashesMutex);
+    m_fileHashes.insert(filePath, hash);
+    return hash;
+}
+
+QString CppIncludeCache::entryFilePath(const QString &header) const
+{
+    const QByteArray name = QCryptographicHash::hash(header.toUtf8(),
+                                                     QCryptographicHash::Sha1).toHex();
+    return m_directory.filePath(QString::fromLatin1(name) + ".lupinc"_L1);
+}
+
+void CppIncludeCache::setCoveredFiles(const QString &header, const QStringList &files) const
+{
+    QMutexLocker lock(&m_coveredFilesMutex);
+    m_coveredFiles.insert(header, files);
+}
+
+/*
+    Loads the entry for \a header into \a entry if it was written with the
+    same configuration and none of the files it covers changed: the header,
+    the files included into it and, transitively, the files covered by the
+    headers it depends on. The caller still has to check the include
+    directives and that the dependencies are still processed stand-alone.
+*/
+bool CppIncludeCache::load(const QString &header, Entry *entry) const
+{
+    if (!m_enabled)
+        return false;
+
+    QFile cacheFile(entryFilePath(header));
+    if (!cacheFile.open(QIODevice::ReadOnly))
+        return false;
+
+    QDataStream in(&cacheFile);
+    quint32 magic = 0;
+    quint32 version = 0;
+    in >> magic >> version;
+    if (magic != CacheMagic || version != CacheVersion)
+        return false;
+    in.setVersion(QDataStream::Qt_6_0);
+
+    QString storedHeader;
+    QByteArray configuration;
+    QList<std::pair<QString, QByteArray>> files;
+    in >> storedHeader >> configuration >> files;
+    if (in.status() != QDataStream::Ok || storedHeader != header
+        || configuration != m_configuration) {
+        return false;
+    }
+    QStringList coveredFiles;
+    coveredFiles.reserve(files.size());
+    for (const auto &file : qAsConst(files)) {
+        if (fileHash(file.first) != file.second)
+            return false;
+        coveredFiles.append(file.first);
+    }
+
+    Entry result;
+    result.recording.files = coveredFiles;
+    in >> result.recording.includes >> result.recording.dependencies
+       >> result.recording.blacklisted >> result.hasTranslator >> result.rootNamespace
+       >> result.messages >> result.extras;
+    if (in.status() != QDataStream::Ok)
+        return false;
+    setCoveredFiles(header, coveredFiles);
+    *entry = std::move(result);
+    return true;
+}
+
+void CppIncludeCache::store(const QString &header, const Entry &entry) const
+{
+    if (!m_enabled)
+        return;
+
+    // The results of the dependencies went into the parse of the header, so
+    // the entry also covers their files. A dependency whose files are not
+    // known, because it was not cached, cannot be checked later.
+    QStringList coveredFiles = entry.recording.files;
+    {
+        QMutexLocker lock(&m_coveredFilesMutex);
+        for (const QString &dependency : entry.recording.dependencies) {
+            const auto it = m_coveredFiles.constFind(dependency);
+            if (it == m_coveredFiles.cend())
+                return;
+            coveredFiles += *it;
+        }
+    }
+    coveredFiles.removeDuplicates();
+
+    QList<std::pair<QString, QByteArray>> files;
+    files.reserve(coveredFiles.size());
+    for (const QString &file : qAsConst(coveredFiles)) {
+        const QByteArray hash = fileHash(file);
+        if (hash.isEmpty())
+            return;
+        files.append({ file, hash });
+    }
+
+    QSaveFile cacheFile(entryFilePath(header));
+    if (!cacheFile.open(QIODevice::WriteOnly))
+        return;
+
+    QDataStream out(&cacheFile);
+    out << CacheMagic << CacheVersion;
+    out.setVersion(QDataStream::Qt_6_0);
+    out << header << m_configuration << files << entry.recording.includes
+        << entry.recording.dependencies << entry.recording.blacklisted << entry.hasTranslator
+        << entry.rootNamespace << entry.messages << entry.extras;
+
+    if (out.status() != QDataStream::Ok || !cacheFile.commit()) {
+        qWarning("lupdate: Cannot write include cache entry for %s", qPrintable(header));
+        return;
+    }
+    setCoveredFiles(header, coveredFiles);
+}
+
+/*
+    Serializes the namespace tree of a header. Whether a class definition
+    links to another definition is recorded, but not to which one.
+*/
+QByteArray CppIncludeCache::writeNamespace(const Namespace &root)
+{
+    QByteArray data;
+    QDataStream out(&data, QIODevice::WriteOnly);
+    out.setVersion(QDataStream::Qt_6_0);
+    writeNamespaceTree(out, root);
+    return data;
+}
+
+/*
+    Fills \a root with the tree serialized in \a data. Links of class
+    definitions are resolved with \a findNamespace.
+*/
+bool CppIncludeCache::readNamespace(const QByteArray &data, Namespace *root,
+                                    const FindNamespace &findNamespace)
+{
+    QDataStream in(data);
+    in.setVersion(QDataStream::Qt_6_0);
+    NamespaceList path;
+    path << HashString();
+    return readNamespaceTree(in, root, &path, findNamespace);
+}
+
+QT_END_NAMESPACE
@@ -0,0 +1,98 @@
+// Copyright (C) 2023 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
+
+#ifndef CPPINCLUDECACHE_H
+#define CPPINCLUDECACHE_H
+
+#include "cpp.h"
+
+#include <QtCore/qbytearray.h>
+#include <QtCore/qdir.h>
+#include <QtCore/qhash.h>
+#include <QtCore/qmutex.h>
+#include <QtCore/qstring.h>
+#include <QtCore/qstringlist.h>
+
+#include <functional>
+#include <utility>
+
+QT_BEGIN_NAMESPACE
+
+/*
+    On-disk cache of the headers the built-in C++ parser processes stand-alone.
+
+    An entry records the namespaces and messages of a header together with
+    what lupdate checks before it uses them again: the files each #include
+    directive resolved to, the headers whose parse results were used, and
+    the content hashes of the header, of the files it included directly, and
+    of the files the entries of those headers cover in turn. The entry files
+    are written atomically, so lupdate processes can share a directory.
+*/
+class CppIncludeCache
+{
+public:
+    struct Include
+    {
+        QString fromFile;
+        QString name;
+        bool angled = false;
+        QStringList files; // what the directive resolved to
+    };
+
+    // What the parse of a header depended on, collected while parsing it
+    struct Recording
+    {
+        // The header and the files included into it; after load(), all the files
+        // the entry covers
+        QStringList files;
+        QList<Include> includes;
+        QStringList dependencies; // headers whose results were used
+        QStringList blacklisted; // files included into the header
+        int cycleCount = 0; // CppFiles include cycles when the parse started
+    };
+
+    struct Entry
+    {
+        Recording recording;
+        bool hasTranslator = false;
+        QByteArray rootNamespace; // see writeNamespace()
+        QList<TranslatorMessage> messages;
+        TranslatorMessage::ExtraData extras;
+    };
+
+    // Finds the namespace a new class definition at the path links to
+    using FindNamespace = std::function<const Namespace *(const NamespaceList &)>;
+
+    explicit CppIncludeCache(const QString &directory);
+
+    bool isEnabled() const { return m_enabled; }
+    void setConfiguration(const QByteArray &configuration) { m_configuration = configuration; }
+
+    bool load(const QString &header, Entry *entry) const;
+    void store(const QString &header, const Entry &entry) const;
+
+    static QByteArray writeNamespace(const Namespace &root);
+    static bool readNamespace(const QByteArray &data, Namespace *root,
+                              const FindNamespace &findNamespace);
+
+private:
+    QByteArray fileHash(const QString &filePath) const;
+    QString entryFilePath(const QString &header) const;
+    void setCoveredFiles(const QString &header, const QStringList &files) const;
+
+    QDir m_directory;
+    QByteArray m_configuration;
+    bool m_enabled = false;
+
+    mutable QMutex m_fileHashesMutex;
+    mutable QHash<QString, QByteArray> m_fileHashes;
+
+    // The files whose hashes the entry of each header stored or loaded in
+    // this run checks, including those of the headers it depends on
+    mutable QMutex m_coveredFilesMutex;
+    mutable QHash<QString, QStringList> m_coveredFiles;
+};
+
+QT_END_NAMESPACE
+
+#endif // CPPINCLUDECACHE_H
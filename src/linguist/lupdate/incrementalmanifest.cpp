@@ -0,0 +1,262 @@
+// Copyright (C) 2023 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
+
+#include "incrementalmanifest.h"
+
+#include <QtCore/qcryptographichash.h>
+#include <QtCore/qdatastream.h>
+#include <QtCore/qfile.h>
+#include <QtCore/qfileinfo.h>
+#include <QtCore/qsavefile.h>
+
+QT_BEGIN_NAMESPACE
+
+static const quint32 ManifestMagic = 0x4c55504d; // "LUPM"
+static const quint32 ManifestVersion = 1;
+
+QDataStream &operator<<(QDataStream &out, const TranslatorMessage &msg)
+{
+    QStringList refFileNames;
+    QList<int> refLineNumbers;
+    for (const TranslatorMessage::Reference &ref : msg.extraReferences()) {
+        refFileNames << ref.fileName();
+        refLineNumbers << ref.lineNumber();
+    }
+    out << msg.context() << msg.sourceText() << msg.oldSourceText() << msg.comment()
+        << msg.oldComment() << msg.id() << msg.userData() << msg.extraComment()
+        << msg.translatorComment() << msg.warning() << msg.translations() << msg.fileName()
+        << qint32(msg.lineNumber()) << qint32(msg.tsLineNumber()) << refFileNames
+        << refLineNumbers << qint32(msg.type()) << msg.isPlural() << msg.warningOnly()
+        << msg.extras();
+    return out;
+}
+
+QDataStream &operator>>(QDataStream &in, TranslatorMessage &msg)
+{
+    QString context, sourceText, oldSourceText, comment, oldComment, id, userData,
+            extraComment, translatorComment, warning, fileName;
+    QStringList translations, refFileNames;
+    QList<int> refLineNumbers;
+    qint32 lineNumber, tsLineNumber, type;
+    bool plural, warningOnly;
+    TranslatorMessage::ExtraData extras;
+    in >> context >> sourceText >> oldSourceText >> comment >> oldComment >> id >> userData
+       >> extraComment >> translatorComment >> warning >> translations >> fileName
+       >> lineNumber >> tsLineNumber >> refFileNames >> refLineNumbers >> type >> plural
+       >> warningOnly >> extras;
+    if (in.status() != QDataStream::Ok || refFileNames.size() != refLineNumbers.size())
+        return in;
+
+    msg = TranslatorMessage(context, sourceText, comment, userData, fileName, lineNumber,
+                            translations, TranslatorMessage::Type(type), plural);
+    msg.setOldSourceText(oldSourceText);
+    msg.setOldComment(oldComment);
+    msg.setId(id);
+    msg.setExtraComment(extraComment);
+    msg.setTranslatorComment(translatorComment);
+    msg.setWarning(warning);
+    msg.setTsLineNumber(tsLineNumber);
+    for (int i = 0; i < refFileNames.size(); ++i)
+        msg.addReference(refFileNames.at(i), refLineNumbers.at(i));
+    msg.setWarningOnly(warningOnly);
+    msg.setExtras(extras);
+    return in;
+}
+
+static QByteArray contentHash(const QString &filePath)
+{
+    QFile file(filePath);
+    if (!file.open(QIODevice::ReadOnly))
+        return {};
+    QCryptographicHash hasher(QCryptographicHash::Sha1);
+    hasher.addData(&file);
+    return hasher.result();
+}
+
+IncrementalManifest::IncrementalManifest(const QString &filePath)
+    : m_filePath(filePath)
+{
+}
+
+/*
+    Reads the manifest file. A missing, outdated or damaged manifest is
+    treated as empty, every file is parsed again then.
+*/
+bool IncrementalManifest::load()
+{
+    if (!isEnabled())
+        return false;
+
+    QFile file(m_filePath);
+    if (!file.open(QIODevice::ReadOnly))
+        return false;
+
+    QDataStream in(&file);
+    quint32 magic = 0;
+    quint32 version = 0;
+    in >> magic >> version;
+    if (magic != ManifestMagic || version != ManifestVersion)
+        return false;
+    in.setVersion(QDataStream::Qt_6_0);
+
+    quint32 count = 0;
+    in >> count;
+    QHash<QString, Entry> entries;
+    for (quint32 i = 0; i < count && in.status() == QDataStream::Ok; ++i) {
+        QString sourceFile;
+        Entry entry;
+        quint32 callCount = 0;
+        in >> sourceFile >> entry.state.size >> entry.state.lastModified
+           >> entry.state.contentHash >> entry.configuration >> callCount;
+        for (quint32 k = 0; k < callCount && in.status() == QDataStream::Ok; ++k) {
+            Translator::RecordedCall call;
+            in >> call.extend >> call.message;
+            entry.calls.append(call);
+        }
+        in >> entry.hasExtras >> entry.extras >> entry.errors;
+        entries.insert(sourceFile, entry);
+    }
+    if (in.status() != QDataStream::Ok)
+        return false;
+
+    m_entries = entries;
+    return true;
+}
+
+/*
+    Writes the manifest file if any entry changed since it was loaded. The
+    entries of files that were not looked up in this run, because they were
+    removed from the project or no longer exist, are dropped.
+*/
+bool IncrementalManifest::save()
+{
+    if (!isEnabled())
+        return true;
+    for (auto it = m_entries.begin(); it != m_entries.end();) {
+        if (m_seenFiles.contains(it.key())) {
+            ++it;
+        } else {
+            it = m_entries.erase(it);
+            m_dirty = true;
+        }
+    }
+    if (!m_dirty)
+        return true;
+
+    QSaveFile file(m_filePath);
+    if (!file.open(QIODevice::WriteOnly))
+        return false;
+
+    QDataStream out(&file);
+    out << ManifestMagic << ManifestVersion;
+    out.setVersion(QDataStream::Qt_6_0);
+    out << quint32(m_entries.size());
+    for (auto it = m_entries.cbegin(), end = m_entries.cend(); it != end; ++it) {
+        const Entry &entry = it.value();
+        out << it.key() << entry.state.size << entry.state.lastModified
+            << entry.state.contentHash << entry.configuration << quint32(entry.calls.size());
+        for (const Translator::RecordedCall &call : entry.calls)
+            out << call.extend << call.message;
+        out << entry.hasExtras << entry.extras << entry.errors;
+    }
+
+    if (out.status() != QDataStream::Ok || !file.commit())
+        return false;
+    m_dirty = false;
+    return true;
+}
+
+QByteArray IncrementalManifest::configurationKey(const ConversionData &cd) const
+{
+    QByteArray key = m_configuration;
+    key += cd.m_sourceIsUtf16 ? '1' : '0';
+    key += cd.m_noUiLines ? '1' : '0';
+    return key;
+}
+
+/*
+    Returns whether the recorded results for \a sourceFile are up to date, and
+    replays them into \a recording and \a errors in that case. \a recording
+    must be in recording mode.
+*/
+bool IncrementalManifest::lookup(const QString &sourceFile, const ConversionData &cd,
+                                 Translator *recording, QStringList *errors)
+{
+    if (!isEnabled())
+        return false;
+
+    const QFileInfo fi(sourceFile);
+    FileState state;
+    state.size = fi.size();
+    state.lastModified = fi.lastModified();
+
+    Entry entry;
+    {
+        QMutexLocker lock(&m_mutex);
+        m_seenFiles.insert(sourceFile);
+        entry = m_entries.value(sourceFile);
+    }
+    bool upToDate = entry.state.size >= 0 && entry.configuration == configurationKey(cd);
+    if (upToDate && (entry.state.size != state.size
+                     || entry.state.lastModified != state.lastModified)) {
+        // The file was touched, but its content may still be the same.
+        state.contentHash = contentHash(sourceFile);
+        upToDate = !state.contentHash.isEmpty() && state.contentHash == entry.state.contentHash;
+        if (upToDate) {
+            QMutexLocker lock(&m_mutex);
+            m_entries[sourceFile].state = state;
+            m_dirty = true;
+        }
+    }
+
+    if (!upToDate) {
+        if (state.contentHash.isEmpty())
+            state.contentHash = contentHash(sourceFile);
+        QMutexLocker lock(&m_mutex);
+        m_pendingStates.insert(sourceFile, state);
+        return false;
+    }
+
+    ConversionData dummy;
+    for (const Translator::RecordedCall &call : qAsConst(entry.calls)) {
+        if (call.extend)
+            recording->extend(call.message, dummy);
+        else
+            recording->append(call.message);
+    }
+    if (entry.hasExtras)
+        recording->setExtras(entry.extras);
+    *errors = entry.errors;
+    return true;
+}
+
+/*
+    Records the results of parsing \a sourceFile for the next run. The state
+    of the file is the one taken by lookup() before it was parsed, so changes
+    made while parsing are noticed next time.
+*/
+void IncrementalManifest::record(const QString &sourceFile, const ConversionData &cd,
+                                 const Translator &recording, const QStringList &errors)
+{
+    if (!isEnabled())
+        return;
+
+    QMutexLocker lock(&m_mutex);
+    const auto it = m_pendingStates.constFind(sourceFile);
+    if (it == m_pendingStates.cend() || it->contentHash.isEmpty())
+        return;
+
+    Entry entry;
+    entry.state = *it;
+    entry.configuration = configurationKey(cd);
+    entry.calls = recording.recordedCalls();
+    entry.hasExtras = recording.hasRecordedExtras();
+    if (entry.hasExtras)
+        entry.extras = recording.extras();
+    entry.errors = errors;
+    m_entries.insert(sourceFile, entry);
+    m_pendingStates.erase(it);
+    m_dirty = true;
+}
+
+QT_END_NAMESPACE
@@ -0,0 +1,85 @@
+// Copyright (C) 2023 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
+
+#ifndef INCREMENTALMANIFEST_H
+#define INCREMENTALMANIFEST_H
+
+#include <translator.h>
+
+#include <QtCore/qbytearray.h>
+#include <QtCore/qdatastream.h>
+#include <QtCore/qdatetime.h>
+#include <QtCore/qhash.h>
+#include <QtCore/qmutex.h>
+#include <QtCore/qset.h>
+#include <QtCore/qstring.h>
+#include <QtCore/qstringlist.h>
+
+QT_BEGIN_NAMESPACE
+
+// Also used by the include cache of the built-in C++ parser.
+QDataStream &operator<<(QDataStream &out, const TranslatorMessage &msg);
+QDataStream &operator>>(QDataStream &in, TranslatorMessage &msg);
+
+/*
+    Sidecar file of an incremental lupdate run.
+
+    For every source file handled by one of the non-C++ parsers the manifest
+    records the size, modification time and content hash of the file together
+    with the messages and errors the parser produced for it. A file whose
+    size and timestamp, or else whose content hash, did not change is not
+    parsed again; its recorded messages are replayed instead.
+
+    The C++ parsers are not covered: the messages of a C++ file also depend
+    on the headers it includes. The clang parser has its own cache for this,
+    the built-in parser can cache the headers it includes (CppIncludeCache).
+*/
+class IncrementalManifest
+{
+public:
+    explicit IncrementalManifest(const QString &filePath);
+
+    bool isEnabled() const { return !m_filePath.isEmpty(); }
+    void setConfiguration(const QByteArray &configuration) { m_configuration = configuration; }
+
+    bool load();
+    bool save();
+
+    bool lookup(const QString &sourceFile, const ConversionData &cd, Translator *recording,
+                QStringList *errors);
+    void record(const QString &sourceFile, const ConversionData &cd,
+                const Translator &recording, const QStringList &errors);
+
+private:
+    struct FileState
+    {
+        qint64 size = -1;
+        QDateTime lastModified;
+        QByteArray contentHash;
+    };
+
+    struct Entry
+    {
+        FileState state;
+        QByteArray configuration;
+        QList<Translator::RecordedCall> calls;
+        bool hasExtras = false;
+        Translator::ExtraData extras;
+        QStringList errors;
+    };
+
+    QByteArray configurationKey(const ConversionData &cd) const;
+
+    QString m_filePath;
+    QByteArray m_configuration;
+    bool m_dirty = false;
+
+    QMutex m_mutex;
+    QHash<QString, Entry> m_entries;
+    QHash<QString, FileState> m_pendingStates; // of files that need to be parsed
+    QSet<QString> m_seenFiles; // looked up in this run; the others are dropped
+};
+
+QT_END_NAMESPACE
+
+#endif // INCREMENTALMANIFEST_H
@@ -3,6 +3,7 @@
 
 #include "lupdate.h"
 
+#include <trace.h>
 #include <translator.h>
 
 #include <QtCore/QDebug>
@@ -14,8 +15,6 @@
 #include <QtCore/QStringConverter>
 #include <QtCore/QTextStream>
 
-#include <iostream>
-
 #include <ctype.h>
 
 QT_BEGIN_NAMESPACE
@@ -49,31 +48,36 @@ class Scope
   should be self-explanatory.
 */
 
-static QString yyFileName;
-static QChar yyCh;
-static QString yyIdent;
-static QString yyComment;
-static QString yyString;
-static bool yyEOF = false;
+static thread_local QString yyFileName;
+static thread_local QChar yyCh;
+static thread_local QString yyIdent;
+static thread_local QString yyComment;
+static thread_local QString yyString;
+static thread_local bool yyEOF = false;
 
-static qlonglong yyInteger;
-static int yyParenDepth;
-static int yyLineNo;
-static int yyCurLineNo;
-static int yyParenLineNo;
-static int yyTok;
+static thread_local qlonglong yyInteger;
+static thread_local int yyParenDepth;
+static thread_local int yyLineNo;
+static thread_local int yyCurLineNo;
+static thread_local int yyParenLineNo;
+static thread_local int yyTok;
 
 // the string to read from and current position in the string
-static QString yyInStr;
-static int yyInPos;
+static thread_local QString yyInStr;
+static thread_local qsizetype yyInPos;
 
 // The parser maintains the following global variables.
-static QString yyPackage;
-static QStack<Scope*> yyScope;
+static thread_local QString yyPackage;
+static thread_local QStack<Scope*> yyScope;
+
+// The diagnostics go to the conversion data of the file, so that those of
+// files parsed on several threads are reported in file order.
+static thread_local ConversionData *yyConversionData;
 
-std::ostream &yyMsg(int line = 0)
+static void yyMsg(const QString &message, int line = 0)
 {
-    return std::cerr << qPrintable(yyFileName) << ':' << (line ? line : yyLineNo) << ": ";
+    yyConversionData->appendError(QStringLiteral("%1:%2: %3")
+                                  .arg(yyFileName).arg(line ? line : yyLineNo).arg(message));
 }
 
 static QChar getChar()
@@ -88,6 +92,19 @@ static QChar getChar()
     return c;
 }
 
+/*
+  Takes the input up to \a end as a comment. Comments are searched for their
+  end with QStringView::indexOf() instead of reading them character by
+  character, which matters for the large doc comments of Java sources.
+*/
+static QString readComment(qsizetype end)
+{
+    const QStringView comment = QStringView(yyInStr).sliced(yyInPos, end - yyInPos);
+    yyCurLineNo += comment.count(QLatin1Char('\n'));
+    yyInPos = end;
+    return comment.toString();
+}
+
 static int getToken()
 {
     const char tab[] = "bfnrt\"\'\\";
@@ -140,35 +157,27 @@ static int getToken()
             case '/':
                 yyCh = getChar();
                 if ( yyCh == QLatin1Char('/') ) {
-                    do {
+                    // The line is taken up to and including the newline.
+                    const qsizetype end = yyInStr.indexOf(QLatin1Char('\n'), yyInPos);
+                    if (end < 0) {
+                        yyComment = readComment(yyInStr.size());
                         yyCh = getChar();
-                        if (yyEOF)
-                            break;
-                        yyComment.append(yyCh);
-                    } while (yyCh != QLatin1Char('\n'));
+                    } else {
+                        yyComment = readComment(end + 1);
+                        yyCh = QLatin1Char('\n');
+                    }
                     return Tok_Comment;
 
                 } else if ( yyCh == QLatin1Char('*') ) {
-                    bool metAster = false;
-                    bool metAsterSlash = false;
-
-                    while ( !metAsterSlash ) {
+                    const qsizetype end = yyInStr.indexOf(QLatin1String("*/"), yyInPos);
+                    if (end < 0) {
+                        yyComment = readComment(yyInStr.size());
                         yyCh = getChar();
-                        if (yyEOF) {
-                            yyMsg() << "Unterminated Java comment.\n";
-                            return Tok_Comment;
-                        }
-
-                        yyComment.append( yyCh );
-
-                        if ( yyCh == QLatin1Char('*') )
-                            metAster = true;
-                        else if ( metAster && yyCh == QLatin1Char('/') )
-                            metAsterSlash = true;
-                        else
-                            metAster = false;
+                        yyMsg(QStringLiteral("Unterminated Java comment."));
+                        return Tok_Comment;
                     }
-                    yyComment.chop(2);
+                    yyComment = readComment(end);
+                    yyInPos += 2;
                     yyCh = getChar();
 
                     return Tok_Comment;
@@ -192,7 +201,7 @@ static int getToken()
                                 else {
                                     int sub(yyCh.toLower().toLatin1() - 87);
                                     if( sub > 15 || sub < 10) {
-                                        yyMsg() << "Invalid Unicode value.\n";
+                                        yyMsg(QStringLiteral("Invalid Unicode value."));
                                         break;
                                     }
                                     unicode += sub;
@@ -215,7 +224,7 @@ static int getToken()
                 }
 
                 if ( yyCh != QLatin1Char('"') )
-                    yyMsg() << "Unterminated string.\n";
+                    yyMsg(QStringLiteral("Unterminated string."));
 
                 yyCh = getChar();
 
@@ -328,9 +337,9 @@ static bool matchString( QString &s )
         if (yyTok == Tok_String)
             s += yyString;
         else {
-            yyMsg() <<
-                "String used in translation can contain only literals"
-                " concatenated with other literals, not expressions or numbers.\n";
+            yyMsg(QStringLiteral("String used in translation can contain only literals"
+                                 " concatenated with other literals, not expressions or"
+                                 " numbers."));
             return false;
         }
         yyTok = getToken();
@@ -439,7 +448,7 @@ static void parse(Translator *tor, ConversionData &cd)
                 yyScope.push(new Scope(yyIdent, Scope::Clazz, yyLineNo));
             }
             else {
-                yyMsg() << "'class' must be followed by a class name.\n";
+                yyMsg(QStringLiteral("'class' must be followed by a class name."));
                 break;
             }
             while (!match(Tok_LeftBrace)) {
@@ -511,7 +520,7 @@ static void parse(Translator *tor, ConversionData &cd)
 
         case Tok_RightBrace:
             if ( yyScope.isEmpty() ) {
-                yyMsg() << "Excess closing brace.\n";
+                yyMsg(QStringLiteral("Excess closing brace."));
             }
             else
                 delete (yyScope.pop());
@@ -540,7 +549,7 @@ static void parse(Translator *tor, ConversionData &cd)
                         yyPackage.append(QLatin1String("."));
                         break;
                     default:
-                         yyMsg() << "'package' must be followed by package name.\n";
+                         yyMsg(QStringLiteral("'package' must be followed by package name."));
                          break;
                 }
                 yyTok = getToken();
@@ -553,20 +562,22 @@ static void parse(Translator *tor, ConversionData &cd)
     }
 
     if ( !yyScope.isEmpty() )
-        yyMsg(yyScope.top()->line) << "Unbalanced opening brace.\n";
+        yyMsg(QStringLiteral("Unbalanced opening brace."), yyScope.top()->line);
     else if ( yyParenDepth != 0 )
-        yyMsg(yyParenLineNo) << "Unbalanced opening parenthesis.\n";
+        yyMsg(QStringLiteral("Unbalanced opening parenthesis."), yyParenLineNo);
 }
 
 
 bool loadJava(Translator &translator, const QString &filename, ConversionData &cd)
 {
+    TraceSpan span("parse", "loadJava", filename);
     QFile file(filename);
     if (!file.open(QIODevice::ReadOnly)) {
         cd.appendError(QStringLiteral("Cannot open %1: %2").arg(filename, file.errorString()));
         return false;
     }
 
+    yyConversionData = &cd;
     yyInPos = -1;
     yyFileName = filename;
     yyPackage.clear();
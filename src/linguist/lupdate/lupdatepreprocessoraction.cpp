@@ -86,7 +86,7 @@ void LupdatePPCallbacks::MacroExpands(const clang::Token &token,
         storeMacroArguments(arguments, &store);
     }
     if (store.isValid())
-        m_ppStores.emplace_back(std::move(store));
+        m_stores->emplace_back(std::move(store));
 }
 
 void LupdatePPCallbacks::storeMacroArguments(const std::vector<QString> &args,
@@ -178,7 +178,7 @@ void LupdatePPCallbacks::InclusionDirective(clang::SourceLocation /*hashLoc*/,
     // when traversing the AST
 
     if (store.isValid())
-        m_ppStores.emplace_back(std::move(store));
+        m_stores->emplace_back(std::move(store));
 }
 
 QT_END_NAMESPACE
@@ -5,7 +5,6 @@
 #define LUPDATEPREPROCESSORACTION_H
 
 #include "cpp_clang.h"
-#include "synchronized.h"
 
 QT_WARNING_PUSH
 QT_WARNING_DISABLE_MSVC(4100)
@@ -14,22 +13,23 @@ QT_WARNING_DISABLE_MSVC(4267)
 QT_WARNING_DISABLE_MSVC(4624)
 QT_WARNING_DISABLE_GCC("-Wnonnull")
 
-#include <clang/Frontend/CompilerInstance.h>
-#include <clang/Frontend/FrontendActions.h>
-#include <clang/Tooling/Tooling.h>
 #include <clang/Lex/PPCallbacks.h>
 #include <clang/Lex/Preprocessor.h>
 
 QT_WARNING_POP
 
-#include <memory>
+#include <vector>
 
 QT_BEGIN_NAMESPACE
 
+// Collects the translation related macro expansions and the inclusion
+// directives of a translation unit while it is being parsed. The stores are
+// appended right away, so they are available to the AST visitor once the
+// whole translation unit has been parsed.
 class LupdatePPCallbacks : public clang::PPCallbacks
 {
 public:
-    LupdatePPCallbacks(WriteSynchronizedRef<TranslationRelatedStore> *stores, clang::Preprocessor &pp)
+    LupdatePPCallbacks(TranslationStores *stores, clang::Preprocessor &pp)
         : m_preprocessor(pp)
         , m_stores(stores)
     {
@@ -37,11 +37,6 @@ public:
         m_inputFile = sm.getFileEntryForID(sm.getMainFileID())->getName();
     }
 
-    ~LupdatePPCallbacks() override
-    {
-        m_stores->emplace_bulk(std::move(m_ppStores));
-    }
-
 private:
     void MacroExpands(const clang::Token &token, const clang::MacroDefinition &macroDefinition,
         clang::SourceRange sourceRange, const clang::MacroArgs *macroArgs) override;
@@ -59,53 +54,7 @@ private:
     std::string m_inputFile;
     clang::Preprocessor &m_preprocessor;
 
-    TranslationStores m_ppStores;
-    WriteSynchronizedRef<TranslationRelatedStore> *m_stores { nullptr };
-};
-
-class LupdatePreprocessorAction : public clang::PreprocessOnlyAction
-{
-public:
-    LupdatePreprocessorAction(WriteSynchronizedRef<TranslationRelatedStore> *stores)
-        : m_stores(stores)
-    {}
-
-private:
-    void ExecuteAction() override
-    {
-        auto &preprocessor = getCompilerInstance().getPreprocessor();
-        preprocessor.SetSuppressIncludeNotFoundError(true);
-        auto callbacks = new LupdatePPCallbacks(m_stores, preprocessor);
-        preprocessor.addPPCallbacks(std::unique_ptr<clang::PPCallbacks>(callbacks));
-
-        clang::PreprocessOnlyAction::ExecuteAction();
-    }
-
-private:
-    WriteSynchronizedRef<TranslationRelatedStore> *m_stores { nullptr };
-};
-
-class LupdatePreprocessorActionFactory : public clang::tooling::FrontendActionFactory
-{
-public:
-    explicit LupdatePreprocessorActionFactory(WriteSynchronizedRef<TranslationRelatedStore> *stores)
-        : m_stores(stores)
-    {}
-
-#if (LUPDATE_CLANG_VERSION >= LUPDATE_CLANG_VERSION_CHECK(10,0,0))
-    std::unique_ptr<clang::FrontendAction> create() override
-    {
-        return std::make_unique<LupdatePreprocessorAction>(m_stores);
-    }
-#else
-    clang::FrontendAction *create() override
-    {
-        return new LupdatePreprocessorAction(m_stores);
-    }
-#endif
-
-private:
-    WriteSynchronizedRef<TranslationRelatedStore> *m_stores { nullptr };
+    TranslationStores *m_stores { nullptr };
 };
 
 QT_END_NAMESPACE
@@ -3,6 +3,7 @@
 // SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
 
 #include "lupdate.h"
+#include "incrementalmanifest.h"
 #if QT_CONFIG(clangcpp)
 #include "cpp_clang.h"
 #endif
@@ -11,8 +12,10 @@
 #include <projectdescriptionreader.h>
 #include <qrcreader.h>
 #include <runqttool.h>
+#include <trace.h>
 #include <translator.h>
 
+#include <QtCore/QBuffer>
 #include <QtCore/QCoreApplication>
 #include <QtCore/QDir>
 #include <QtCore/QFile>
@@ -22,7 +25,11 @@
 #include <QtCore/QStringList>
 #include <QtCore/QTranslator>
 
+#include <algorithm>
+#include <atomic>
 #include <iostream>
+#include <thread>
+#include <vector>
 
 using namespace Qt::StringLiterals;
 
@@ -30,6 +37,12 @@ bool useClangToParseCpp = false;
 QString commandLineCompilationDatabaseDir; // for the path to the json file passed as a command line argument.
                                     // Has priority over what is in the .pro file and passed to the project.
 QStringList rootDirs;
+QString commandLineClangParseCacheDir;
+QString commandLineCppIncludeCacheDir;
+QString commandLineClangPrefixHeader;
+int maxThreadCount = 0;
+QString incrementalManifestFile;
+static IncrementalManifest *incrementalManifest = nullptr;
 
 // Can't have an array of QStaticStringData<N> for different N, so
 // use QString, which requires constructor calls. Doesn't matter
@@ -287,6 +300,31 @@ static void printUsage()
         "           A directory specified on the command line takes precedence.\n"
         "           If no path is given, the compilation database will be searched\n"
         "           in all parent paths of the first input file.\n"
+        "    -j <n>\n"
+        "           Use at most <n> threads for parsing source files.\n"
+        "           The clang parser uses one thread per CPU core by default.\n"
+        "           The built-in parsers are single-threaded by default.\n"
+        "    -incremental <manifest-file>\n"
+        "           Record the messages found in Java, Python, UI, QML and JavaScript files\n"
+        "           in the given manifest and only parse the files that changed since the\n"
+        "           last run. Also, TS files are only written if their content changes.\n"
+        "    -clang-parse-cache <directory>\n"
+        "           Store the results of the clang parser per translation unit in the given\n"
+        "           directory and reuse them in later runs for files that did not change.\n"
+        "           Only used together with the -clang-parser option.\n"
+        "    -include-cache <directory>\n"
+        "           Store the namespaces and messages the built-in C++ parser finds in\n"
+        "           included headers in the given directory and reuse them in later runs\n"
+        "           for headers that did not change. The directory can be shared by\n"
+        "           several lupdate processes.\n"
+        "    -clang-prefix-header <file>\n"
+        "           Precompile the given header, which should be included by every C++\n"
+        "           translation unit, once and load it into each translation unit instead\n"
+        "           of parsing it again. Only used together with the -clang-parser option.\n"
+        "    -trace <file>\n"
+        "           Write the time spent reading the project, parsing each source file,\n"
+        "           merging and writing the TS files to the given file, in the Chrome\n"
+        "           trace event JSON format.\n"
         "    -project-roots <directory>...\n"
         "           Specify one or more project root directories.\n"
         "           Only files below a project root are considered for translation when using\n"
@@ -431,7 +469,30 @@ static void updateTsFiles(const Translator &fetchedTor, const QStringList &tsFil
             printErr(cd.error());
             cd.clearErrors();
         }
-        if (!out.save(fileName, cd, QLatin1String("auto"))) {
+        if (incrementalManifest && !fileName.isEmpty() && fileName != QLatin1String("-")) {
+            // Leave the file alone if its content would not change, so that
+            // build systems do not consider it to be modified. Standard
+            // output, "-", is always written.
+            QBuffer buffer;
+            buffer.open(QIODevice::WriteOnly);
+            if (!out.save(buffer, fileName, cd, QLatin1String("auto"))) {
+                printErr(cd.error());
+                *fail = true;
+                continue;
+            }
+            QFile file(fileName);
+            if (file.open(QIODevice::ReadOnly) && file.readAll() == buffer.data()) {
+                if (options & Verbose)
+                    printOut(QStringLiteral("'%1' is up to date.\n").arg(fn));
+                continue;
+            }
+            file.close();
+            if (!file.open(QIODevice::WriteOnly) || file.write(buffer.data()) != buffer.size()) {
+                printErr(QStringLiteral("lupdate error: Cannot write %1: %2\n")
+                         .arg(fileName, file.errorString()));
+                *fail = true;
+            }
+        } else if (!out.save(fileName, cd, QLatin1String("auto"))) {
             printErr(cd.error());
             *fail = true;
         }
@@ -495,41 +556,142 @@ static bool processTs(Translator &fetchedTor, const QString &file, ConversionDat
     return false;
 }
 
+enum class SourceKind { Cpp, Handled, NeedsQml };
+
+// Whether loadNonCppSource() leaves \a sourceFile to the C++ parsers.
+static bool isCppSource(const QString &sourceFile)
+{
+    static const char *const nonCppSuffixes[] = { ".java", ".ui", ".jui", ".js", ".qs", ".qml",
+                                                  ".py" };
+    for (const char *suffix : nonCppSuffixes) {
+        if (sourceFile.endsWith(QLatin1String(suffix), Qt::CaseInsensitive))
+            return false;
+    }
+    for (const Translator::FileFormat &fmt : qAsConst(Translator::registeredFileFormats())) {
+        if (sourceFile.endsWith(QLatin1Char('.') + fmt.extension, Qt::CaseInsensitive))
+            return false;
+    }
+    return true;
+}
+
+static SourceKind loadNonCppSource(Translator &fetchedTor, const QString &sourceFile,
+                                   ConversionData &cd)
+{
+    if (sourceFile.endsWith(QLatin1String(".java"), Qt::CaseInsensitive))
+        loadJava(fetchedTor, sourceFile, cd);
+    else if (sourceFile.endsWith(QLatin1String(".ui"), Qt::CaseInsensitive)
+             || sourceFile.endsWith(QLatin1String(".jui"), Qt::CaseInsensitive))
+        loadUI(fetchedTor, sourceFile, cd);
+#ifndef QT_NO_QML
+    else if (sourceFile.endsWith(QLatin1String(".js"), Qt::CaseInsensitive)
+             || sourceFile.endsWith(QLatin1String(".qs"), Qt::CaseInsensitive))
+        loadQScript(fetchedTor, sourceFile, cd);
+    else if (sourceFile.endsWith(QLatin1String(".qml"), Qt::CaseInsensitive))
+        loadQml(fetchedTor, sourceFile, cd);
+#else
+    else if (sourceFile.endsWith(QLatin1String(".qml"), Qt::CaseInsensitive)
+             || sourceFile.endsWith(QLatin1String(".js"), Qt::CaseInsensitive)
+             || sourceFile.endsWith(QLatin1String(".qs"), Qt::CaseInsensitive))
+        return SourceKind::NeedsQml;
+#endif // QT_NO_QML
+    else if (sourceFile.endsWith(u".py", Qt::CaseInsensitive))
+        loadPython(fetchedTor, sourceFile, cd);
+    else if (!processTs(fetchedTor, sourceFile, cd))
+        return SourceKind::Cpp;
+    return SourceKind::Handled;
+}
+
 static void processSources(Translator &fetchedTor,
                            const QStringList &sourceFiles, ConversionData &cd, bool *fail)
 {
-#ifdef QT_NO_QML
     bool requireQmlSupport = false;
-#endif
     QStringList sourceFilesCpp;
-    for (const auto &sourceFile : sourceFiles) {
-        if (sourceFile.endsWith(QLatin1String(".java"), Qt::CaseInsensitive))
-            loadJava(fetchedTor, sourceFile, cd);
-        else if (sourceFile.endsWith(QLatin1String(".ui"), Qt::CaseInsensitive)
-                 || sourceFile.endsWith(QLatin1String(".jui"), Qt::CaseInsensitive))
-            loadUI(fetchedTor, sourceFile, cd);
-#ifndef QT_NO_QML
-        else if (sourceFile.endsWith(QLatin1String(".js"), Qt::CaseInsensitive)
-                 || sourceFile.endsWith(QLatin1String(".qs"), Qt::CaseInsensitive))
-            loadQScript(fetchedTor, sourceFile, cd);
-        else if (sourceFile.endsWith(QLatin1String(".qml"), Qt::CaseInsensitive))
-            loadQml(fetchedTor, sourceFile, cd);
-#else
-        else if (sourceFile.endsWith(QLatin1String(".qml"), Qt::CaseInsensitive)
-                 || sourceFile.endsWith(QLatin1String(".js"), Qt::CaseInsensitive)
-                 || sourceFile.endsWith(QLatin1String(".qs"), Qt::CaseInsensitive))
-            requireQmlSupport = true;
-#endif // QT_NO_QML
-        else if (sourceFile.endsWith(u".py", Qt::CaseInsensitive))
-            loadPython(fetchedTor, sourceFile, cd);
-        else if (!processTs(fetchedTor, sourceFile, cd))
-            sourceFilesCpp << sourceFile;
+    const qsizetype threadCount = qMin(qsizetype(cd.m_maxThreadCount), sourceFiles.size());
+    if (threadCount <= 1 && !incrementalManifest) {
+        for (const auto &sourceFile : sourceFiles) {
+            switch (loadNonCppSource(fetchedTor, sourceFile, cd)) {
+            case SourceKind::Cpp:
+                sourceFilesCpp << sourceFile;
+                break;
+            case SourceKind::NeedsQml:
+                requireQmlSupport = true;
+                break;
+            case SourceKind::Handled:
+                break;
+            }
+        }
+    } else {
+        // The parsers record their messages per file and the recordings are
+        // replayed in file order afterwards, so the merged messages and the
+        // diagnostics are the same as when loading the files one by one.
+        // In incremental mode, recordings of unchanged files come from the
+        // manifest.
+        struct FileResult {
+            Translator translator;
+            ConversionData cd;
+            SourceKind kind = SourceKind::Handled;
+        };
+        std::vector<FileResult> results(sourceFiles.size());
+
+        // The alias map is built lazily; do it before the threads share it.
+        trFunctionAliasManager.nameToTrFunctionMap();
+
+        // Hand out the largest files first, so that a big QML or JavaScript
+        // file picked up last does not keep a single thread busy at the end.
+        std::vector<qsizetype> order(sourceFiles.size());
+        std::vector<qint64> sizes(sourceFiles.size());
+        for (qsizetype k = 0; k < sourceFiles.size(); ++k) {
+            order[k] = k;
+            sizes[k] = QFileInfo(sourceFiles.at(k)).size();
+        }
+        std::stable_sort(order.begin(), order.end(), [&sizes](qsizetype lhs, qsizetype rhs) {
+            return sizes[lhs] > sizes[rhs];
+        });
+
+        std::atomic<qsizetype> nextFile = 0;
+        std::vector<std::thread> workers;
+        for (qsizetype i = 0; i < qMax(threadCount, qsizetype(1)); ++i) {
+            workers.emplace_back([&sourceFiles, &cd, &results, &order, &nextFile]() {
+                for (qsizetype n = nextFile++; n < sourceFiles.size(); n = nextFile++) {
+                    const qsizetype k = order[n];
+                    const QString &sourceFile = sourceFiles.at(k);
+                    FileResult &result = results[k];
+                    result.cd = cd;
+                    result.cd.clearErrors();
+                    result.translator.setRecording(true);
+                    const bool cached = incrementalManifest && !isCppSource(sourceFile);
+                    QStringList errors;
+                    if (cached && incrementalManifest->lookup(sourceFile, cd, &result.translator,
+                                                              &errors)) {
+                        for (const QString &error : qAsConst(errors))
+                            result.cd.appendError(error);
+                        continue;
+                    }
+                    result.kind = loadNonCppSource(result.translator, sourceFile, result.cd);
+                    if (cached && result.kind == SourceKind::Handled) {
+                        incrementalManifest->record(sourceFile, cd, result.translator,
+                                                    result.cd.errors());
+                    }
+                }
+            });
+        }
+        for (std::thread &worker : workers)
+            worker.join();
+
+        for (qsizetype k = 0; k < sourceFiles.size(); ++k) {
+            const FileResult &result = results[k];
+            for (const QString &error : result.cd.errors())
+                cd.appendError(error);
+            result.translator.replay(fetchedTor, cd);
+            if (result.kind == SourceKind::Cpp)
+                sourceFilesCpp << sourceFiles.at(k);
+            else if (result.kind == SourceKind::NeedsQml)
+                requireQmlSupport = true;
+        }
     }
 
-#ifdef QT_NO_QML
     if (requireQmlSupport)
         printErr(QStringLiteral("lupdate warning: Some files have been ignored due to missing qml/javascript support\n"));
-#endif
 
     if (useClangToParseCpp) {
 #if QT_CONFIG(clangcpp)
@@ -584,6 +746,7 @@ private:
     void processProject(UpdateOptions options, const Project &prj, bool topLevel,
                         bool nestComplain, Translator *parentTor, bool *fail) const
     {
+        TraceSpan span("project", "processProject", prj.filePath);
         QString codecForSource = prj.codec.toLower();
         if (!codecForSource.isEmpty()) {
             if (codecForSource == QLatin1String("utf-16")
@@ -615,6 +778,10 @@ private:
             cd.m_compilationDatabaseDir = prj.compileCommands;
         else
             cd.m_compilationDatabaseDir = commandLineCompilationDatabaseDir;
+        cd.m_clangParseCacheDir = commandLineClangParseCacheDir;
+        cd.m_cppIncludeCacheDir = commandLineCppIncludeCacheDir;
+        cd.m_clangPrefixHeader = commandLineClangPrefixHeader;
+        cd.m_maxThreadCount = maxThreadCount;
 
         QStringList tsFiles;
         if (prj.translations) {
@@ -686,6 +853,7 @@ int main(int argc, char **argv)
     QStringList tsFileNames;
     QStringList proFiles;
     QString projectDescriptionFile;
+    QString traceFile;
     QString outDir = QDir::currentPath();
     QMultiHash<QString, QString> allCSources;
     QSet<QString> projectRoots;
@@ -857,6 +1025,24 @@ int main(int argc, char **argv)
             }
             outDir = QDir::cleanPath(QFileInfo(args[i]).absoluteFilePath());
             continue;
+        } else if (arg == QLatin1String("-j")) {
+            ++i;
+            bool ok = false;
+            if (i < argc)
+                maxThreadCount = args[i].toInt(&ok);
+            if (!ok || maxThreadCount < 1) {
+                printErr(u"The -j option should be followed by a positive number.\n"_s);
+                return 1;
+            }
+            continue;
+        } else if (arg == QLatin1String("-incremental")) {
+            ++i;
+            if (i == argc) {
+                printErr(u"The -incremental option should be followed by a file name.\n"_s);
+                return 1;
+            }
+            incrementalManifestFile = QDir::cleanPath(QFileInfo(args[i]).absoluteFilePath());
+            continue;
         } else if (arg.startsWith(QLatin1String("-I"))) {
             if (arg.length() == 2) {
                 ++i;
@@ -888,6 +1074,42 @@ int main(int argc, char **argv)
             rootDirs.removeDuplicates();
             continue;
         }
+        else if (arg == QLatin1String("-clang-parse-cache")) {
+            ++i;
+            if (i == argc) {
+                printErr(u"The -clang-parse-cache option should be followed by a directory name.\n"_s);
+                return 1;
+            }
+            commandLineClangParseCacheDir = QDir::cleanPath(QFileInfo(args[i]).absoluteFilePath());
+            continue;
+        }
+        else if (arg == QLatin1String("-include-cache")) {
+            ++i;
+            if (i == argc) {
+                printErr(u"The -include-cache option should be followed by a directory name.\n"_s);
+                return 1;
+            }
+            commandLineCppIncludeCacheDir = QDir::cleanPath(QFileInfo(args[i]).absoluteFilePath());
+            continue;
+        }
+        else if (arg == QLatin1String("-trace") || arg == QLatin1String("--trace")) {
+            ++i;
+            if (i == argc) {
+                printErr(u"The -trace option should be followed by a file name.\n"_s);
+                return 1;
+            }
+            traceFile = args[i];
+            continue;
+        }
+        else if (arg == QLatin1String("-clang-prefix-header")) {
+            ++i;
+            if (i == argc) {
+                printErr(u"The -clang-prefix-header option should be followed by a file name.\n"_s);
+                return 1;
+            }
+            commandLineClangPrefixHeader = QDir::cleanPath(QFileInfo(args[i]).absoluteFilePath());
+            continue;
+        }
 #endif
         else if (arg.startsWith(QLatin1String("-")) && arg != QLatin1String("-")) {
             printErr(QStringLiteral("Unrecognized option '%1'.\n").arg(arg));
@@ -1023,8 +1245,17 @@ int main(int argc, char **argv)
         return 0;
     }
 
+    // Only started here, the lupdate that lupdate-pro runs writes the trace otherwise.
+    TraceSession traceSession;
+    if (!traceFile.isEmpty() && !traceSession.start(traceFile, &errorString)) {
+        printErr(QStringLiteral("lupdate error: Cannot write trace file %1: %2\n")
+                 .arg(traceFile, errorString));
+        return 1;
+    }
+
     Projects projectDescription;
     if (!projectDescriptionFile.isEmpty()) {
+        TraceSpan span("project", "readProjectDescription", projectDescriptionFile);
         projectDescription = readProjectDescription(projectDescriptionFile, &errorString);
         if (!errorString.isEmpty()) {
             printErr(QStringLiteral("lupdate error: %1\n").arg(errorString));
@@ -1038,6 +1269,14 @@ int main(int argc, char **argv)
         }
     }
 
+    IncrementalManifest manifest(incrementalManifestFile);
+    if (manifest.isEnabled()) {
+        manifest.setConfiguration(QByteArray(QT_VERSION_STR) + ' '
+                                  + trFunctionAliasManager.listAliases().join(u' ').toUtf8());
+        manifest.load();
+        incrementalManifest = &manifest;
+    }
+
     bool fail = false;
     if (projectDescription.empty()) {
         if (tsFileNames.isEmpty())
@@ -1052,6 +1291,10 @@ int main(int argc, char **argv)
         cd.m_includePath = includePath;
         cd.m_allCSources = allCSources;
         cd.m_compilationDatabaseDir = commandLineCompilationDatabaseDir;
+        cd.m_clangParseCacheDir = commandLineClangParseCacheDir;
+        cd.m_cppIncludeCacheDir = commandLineCppIncludeCacheDir;
+        cd.m_clangPrefixHeader = commandLineClangPrefixHeader;
+        cd.m_maxThreadCount = maxThreadCount;
         cd.m_rootDirs = rootDirs;
         for (const QString &resource : qAsConst(resourceFiles))
             sourceFiles << getResources(resource);
@@ -1079,5 +1322,10 @@ int main(int argc, char **argv)
                                              &fail);
         }
     }
+
+    if (incrementalManifest && !manifest.save()) {
+        printErr(QStringLiteral("lupdate warning: Cannot write incremental manifest %1.\n")
+                 .arg(incrementalManifestFile));
+    }
     return fail ? 1 : 0;
 }
@@ -4,14 +4,18 @@
 #include "lupdate.h"
 
 #include "simtexth.h"
+#include "trace.h"
 #include "translator.h"
 
 #include <QtCore/QCoreApplication>
 #include <QtCore/QDebug>
+#include <QtCore/QHash>
 #include <QtCore/QList>
-#include <QtCore/QMap>
+#include <QtCore/QSet>
 #include <QtCore/QStringList>
 
+#include <optional>
+
 QT_BEGIN_NAMESPACE
 
 static bool isDigitFriendly(QChar c)
@@ -171,6 +175,62 @@ static QString translationAttempt(const QString &oldTranslation,
 }
 
 
+/*
+  Finds messages by context, comment and one of their references, like
+  Translator::find(context, comment, refs). The messages are hashed once
+  per merge instead of being scanned for every lookup.
+*/
+class ReferenceIndex
+{
+public:
+    explicit ReferenceIndex(const Translator &tor)
+    {
+        m_index.reserve(tor.messageCount());
+        // Backwards, so that the first message wins for equal keys.
+        for (int i = tor.messageCount() - 1; i >= 0; --i) {
+            const TranslatorMessage &msg = tor.constMessage(i);
+            for (const TranslatorMessage::Reference &ref : msg.allReferences())
+                m_index.insert({ msg.context(), msg.comment(), ref.fileName(), ref.lineNumber() },
+                               i);
+        }
+    }
+
+    // Returns the first message that matches, or -1.
+    int find(const QString &context, const QString &comment,
+             const TranslatorMessage::References &refs) const
+    {
+        int found = -1;
+        for (const TranslatorMessage::Reference &ref : refs) {
+            const auto it = m_index.constFind({ context, comment, ref.fileName(),
+                                                ref.lineNumber() });
+            if (it != m_index.cend() && (found < 0 || *it < found))
+                found = *it;
+        }
+        return found;
+    }
+
+private:
+    struct Key
+    {
+        QString context;
+        QString comment;
+        QString fileName;
+        int lineNumber;
+
+        bool operator==(const Key &other) const
+        {
+            return lineNumber == other.lineNumber && fileName == other.fileName
+                    && context == other.context && comment == other.comment;
+        }
+        friend size_t qHash(const Key &key, size_t seed = 0)
+        {
+            return qHashMulti(seed, key.context, key.comment, key.fileName, key.lineNumber);
+        }
+    };
+
+    QHash<Key, int> m_index;
+};
+
 /*
   Augments a Translator with translations easily derived from
   similar existing (probably obsolete) translations.
@@ -183,7 +243,7 @@ static QString translationAttempt(const QString &oldTranslation,
 */
 int applyNumberHeuristic(Translator &tor)
 {
-    QMap<QString, QPair<QString, QString> > translated;
+    QHash<QString, QPair<QString, QString> > translated;
     QList<bool> untranslated(tor.messageCount());
     int inserted = 0;
 
@@ -200,6 +260,9 @@ int applyNumberHeuristic(Translator &tor)
         }
     }
 
+    if (translated.isEmpty())
+        return 0;
+
     for (int i = 0; i < tor.messageCount(); ++i) {
         if (untranslated[i]) {
             TranslatorMessage &msg = tor.message(i);
@@ -230,8 +293,8 @@ int applyNumberHeuristic(Translator &tor)
 
 int applySameTextHeuristic(Translator &tor)
 {
-    QMap<QString, QStringList> translated;
-    QMap<QString, bool> avoid; // Want a QTreeSet, in fact
+    QHash<QString, QStringList> translated;
+    QSet<QString> avoid;
     QList<bool> untranslated(tor.messageCount());
     int inserted = 0;
 
@@ -250,7 +313,7 @@ int applySameTextHeuristic(Translator &tor)
                 */
                 if (*t != msg.translations()) {
                     translated.remove(key);
-                    avoid.insert(key, true);
+                    avoid.insert(key);
                 }
             } else if (!avoid.contains(key)) {
                 translated.insert(key, msg.translations());
@@ -285,11 +348,20 @@ Translator merge(
     const Translator &tor, const Translator &virginTor, const QList<Translator> &aliens,
     UpdateOptions options, QString &err)
 {
+    TraceSpan span("merge", "merge");
     int known = 0;
     int neww = 0;
     int obsoleted = 0;
     int similarTextHeuristicCount = 0;
 
+    // Only the similar text heuristic needs to find messages by location.
+    std::optional<ReferenceIndex> torRefs;
+    std::optional<ReferenceIndex> virginRefs;
+    if (options & HeuristicSimilarText) {
+        torRefs.emplace(tor);
+        virginRefs.emplace(virginTor);
+    }
+
     Translator outTor;
     outTor.setLanguageCode(tor.languageCode());
     outTor.setSourceLanguageCode(tor.sourceLanguageCode());
@@ -329,7 +401,7 @@ Translator merge(
                     }
                     m.clearReferences();
                 } else {
-                    mvi = virginTor.find(m.context(), m.comment(), m.allReferences());
+                    mvi = virginRefs->find(m.context(), m.comment(), m.allReferences());
                     if (mvi < 0) {
                         // did not find it in the virgin, mark it as obsolete
                         goto makeObsolete;
@@ -428,7 +500,7 @@ Translator merge(
             if (tor.find(mv) >= 0)
                 continue;
             if (options & HeuristicSimilarText) {
-                int mi = tor.find(mv.context(), mv.comment(), mv.allReferences());
+                int mi = torRefs->find(mv.context(), mv.comment(), mv.allReferences());
                 if (mi >= 0) {
                     // The similar message found in tor (ts file) must NOT correspond exactly
                     // to an other message is virginTor
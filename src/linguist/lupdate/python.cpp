@@ -2,9 +2,11 @@
 // Copyright (C) 2021 The Qt Company Ltd.
 // SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
 
+#include <trace.h>
 #include <translator.h>
 #include "lupdate.h"
 
+#include <QtCore/qfile.h>
 #include <QtCore/qhash.h>
 #include <QtCore/qstring.h>
 #include <QtCore/qtextstream.h>
@@ -34,19 +36,21 @@ enum Token { Tok_Eof, Tok_class, Tok_return, Tok_tr,
   The tokenizer maintains the following global variables. The names
   should be self-explanatory.
 */
-static QString yyFileName;
-static int yyCh;
-static QByteArray yyIdent;
-static char yyComment[65536];
-static size_t yyCommentLen;
-static char yyString[65536];
-static size_t yyStringLen;
-static int yyParenDepth;
-static int yyLineNo;
-static int yyCurLineNo;
-
-static QByteArray extraComment;
-static QByteArray id;
+static thread_local QString yyFileName;
+// Collects the warnings of the file being tokenized
+static thread_local ConversionData *yyConversionData;
+static thread_local int yyCh;
+static thread_local QByteArray yyIdent;
+static thread_local char yyComment[65536];
+static thread_local size_t yyCommentLen;
+static thread_local char yyString[65536];
+static thread_local size_t yyStringLen;
+static thread_local int yyParenDepth;
+static thread_local int yyLineNo;
+static thread_local int yyCurLineNo;
+
+static thread_local QByteArray extraComment;
+static thread_local QByteArray id;
 
 QHash<QByteArray, Token> tokens = {
     {"None", Tok_None},
@@ -56,38 +60,28 @@ QHash<QByteArray, Token> tokens = {
     {"__trUtf8", Tok_trUtf8}
 };
 
-// the file to read from (if reading from a file)
-static FILE *yyInFile;
+// the contents of the file and the current position in them
+static thread_local QByteArray yyInStr;
+static thread_local qsizetype yyInPos;
 
-// the string to read from and current position in the string (otherwise)
-static int yyInPos;
-static int buf;
-
-static int (*getChar)();
-static int (*peekChar)();
-
-static int yyIndentationSize;
-static int yyContinuousSpaceCount;
-static bool yyCountingIndentation;
+static thread_local int yyIndentationSize;
+static thread_local int yyContinuousSpaceCount;
+static thread_local bool yyCountingIndentation;
 
 // (Context, indentation level) pair.
 using ContextPair = QPair<QByteArray, int>;
 // Stack of (Context, indentation level) pairs.
 using ContextStack = QStack<ContextPair>;
-static ContextStack yyContextStack;
+static thread_local ContextStack yyContextStack;
 
-static int yyContextPops;
+static thread_local int yyContextPops;
 
-static int getCharFromFile()
+static int getChar()
 {
-    int c;
+    if (yyInPos >= yyInStr.size())
+        return EOF;
 
-    if (buf < 0) {
-        c = getc(yyInFile);
-    } else {
-        c = buf;
-        buf = -1;
-    }
+    const int c = uchar(yyInStr.at(yyInPos++));
     if (c == '\n') {
         yyCurLineNo++;
         yyCountingIndentation = true;
@@ -111,20 +105,27 @@ static int getCharFromFile()
     return c;
 }
 
-static int peekCharFromFile()
+static int peekChar()
 {
-    int c = getc(yyInFile);
-    buf = c;
-    return c;
+    return yyInPos < yyInStr.size() ? uchar(yyInStr.at(yyInPos)) : EOF;
+}
+
+/*
+  Skips the rest of a comment line up to the newline, which is read with
+  getChar() to count it. The characters in between only need to be counted
+  for indentation at the start of a line, so they are skipped with memchr().
+*/
+static void skipLine()
+{
+    const char *data = yyInStr.constData();
+    const void *newline = std::memchr(data + yyInPos, '\n', yyInStr.size() - yyInPos);
+    yyInPos = newline ? static_cast<const char *>(newline) - data : yyInStr.size();
+    yyCh = getChar();
 }
 
-static void startTokenizer(const QString &fileName, int (*getCharFunc)(),
-                           int (*peekCharFunc)())
+static void startTokenizer(const QString &fileName)
 {
     yyInPos = 0;
-    buf = -1;
-    getChar = getCharFunc;
-    peekChar = peekCharFunc;
 
     yyFileName = fileName;
     yyCh = getChar();
@@ -240,8 +241,8 @@ static Token parseString()
     if (yyCh != quoteChar) {
         printf("%c\n", yyCh);
 
-        qWarning("%s:%d: Unterminated string",
-                 qPrintable(yyFileName), yyLineNo);
+        yyConversionData->appendError(QStringLiteral("%1:%2: Unterminated string")
+                                      .arg(yyFileName).arg(yyLineNo));
     }
 
     if (yyCh == EOF)
@@ -291,9 +292,7 @@ static Token getToken()
             case '\n':
                 break;
             default:
-                do {
-                    yyCh = getChar();
-                } while (yyCh != EOF && yyCh != '\n');
+                skipLine();
                 break;
             }
             break;
@@ -361,7 +360,7 @@ static Token getToken()
   (3) the call appears within a function defined outside the class definition.
 */
 
-static Token yyTok;
+static thread_local Token yyTok;
 
 static bool match(Token t)
 {
@@ -670,17 +669,17 @@ static void parse(Translator &tor, ConversionData &cd,
     }
 
     if (yyParenDepth != 0) {
-        qWarning("%s: Unbalanced parentheses in Python code",
-                 qPrintable(yyFileName));
+        cd.appendError(QStringLiteral("%1: Unbalanced parentheses in Python code")
+                       .arg(yyFileName));
     }
 }
 
 bool loadPython(Translator &translator, const QString &fileName, ConversionData &cd)
 {
-    // Match the function aliases to our tokens
-    static bool firstTime = true;
-    if (firstTime) {
-        firstTime = false;
+    TraceSpan span("parse", "loadPython", fileName);
+    // Match the function aliases to our tokens. The static initializer runs
+    // exactly once, even if files are loaded from several threads.
+    [[maybe_unused]] static const bool aliasesRegistered = [] {
         const auto &nameMap  = trFunctionAliasManager.nameToTrFunctionMap();
         for (auto it = nameMap.cbegin(), end = nameMap.cend(); it != end; ++it) {
             switch (it.value()) {
@@ -701,24 +700,21 @@ bool loadPython(Translator &translator, const QString &fileName, ConversionData
                 break;
             }
         }
-    }
+        return true;
+    }();
 
-#ifdef Q_CC_MSVC
-    const auto *fileNameC = reinterpret_cast<const wchar_t *>(fileName.utf16());
-    const bool ok = _wfopen_s(&yyInFile, fileNameC, L"r") == 0;
-#else
-    const QByteArray fileNameC = QFile::encodeName(fileName);
-    yyInFile = std::fopen( fileNameC.constData(), "r");
-    const bool ok = yyInFile != nullptr;
-#endif
-    if (!ok) {
+    QFile file(fileName);
+    if (!file.open(QIODevice::ReadOnly | QIODevice::Text)) {
         cd.appendError(QStringLiteral("Cannot open %1").arg(fileName));
         return false;
     }
+    yyInStr = file.readAll();
+    file.close();
 
-    startTokenizer(fileName, getCharFromFile, peekCharFromFile);
+    yyConversionData = &cd;
+    startTokenizer(fileName);
     parse(translator, cd);
-    std::fclose(yyInFile);
+    yyInStr.clear();
     return true;
 }
 
@@ -3,12 +3,13 @@
 
 #include "lupdate.h"
 
+#include <trace.h>
 #include <translator.h>
 
 #include <QtCore/QDebug>
 #include <QtCore/QFile>
 #include <QtCore/QString>
-#include <QtCore/QTextStream>
+#include <QtCore/QStringConverter>
 
 #include <private/qqmljsengine_p.h>
 #include <private/qqmljsparser_p.h>
@@ -433,13 +434,10 @@ static bool load(Translator &translator, const QString &filename, ConversionData
         return false;
     }
 
-    QString code;
-    if (!qmlMode) {
-        code = QTextStream(&file).readAll();
-    } else {
-        QTextStream ts(&file);
-        code = ts.readAll();
-    }
+    // Decode in one go, honoring a byte order mark like QTextStream does.
+    const QByteArray data = file.readAll();
+    const auto encoding = QStringConverter::encodingForData(data);
+    const QString code = QStringDecoder(encoding.value_or(QStringConverter::Utf8))(data);
 
     Engine driver;
     Parser parser(&driver);
@@ -463,11 +461,13 @@ static bool load(Translator &translator, const QString &filename, ConversionData
 
 bool loadQml(Translator &translator, const QString &filename, ConversionData &cd)
 {
+    TraceSpan span("parse", "loadQml", filename);
     return load(translator, filename, cd, /*qmlMode=*/ true);
 }
 
 bool loadQScript(Translator &translator, const QString &filename, ConversionData &cd)
 {
+    TraceSpan span("parse", "loadQScript", filename);
     return load(translator, filename, cd, /*qmlMode=*/ false);
 }
 
@@ -48,6 +48,31 @@ private:
     std::vector<T> &m_vector;
 };
 
+// Writes values into preallocated slots of a vector. Each slot is written by
+// exactly one thread, so no locking is needed and the order of the values
+// does not depend on the scheduling of the threads.
+template<typename T> class IndexedWriteRef
+{
+    Q_DISABLE_COPY_MOVE(IndexedWriteRef)
+
+public:
+    IndexedWriteRef(std::vector<T> &vector, size_t count)
+        : m_vector(vector)
+        , m_offset(vector.size())
+    {
+        m_vector.resize(m_offset + count);
+    }
+
+    void set(size_t index, T &&value)
+    {
+        m_vector[m_offset + index] = std::move(value);
+    }
+
+private:
+    std::vector<T> &m_vector;
+    const size_t m_offset;
+};
+
 template<typename T> class ReadSynchronizedRef
 {
     Q_DISABLE_COPY_MOVE(ReadSynchronizedRef)
@@ -63,11 +88,19 @@ public:
     }
 
     bool next(T *value) const
+    {
+        size_t idx;
+        return next(value, &idx);
+    }
+
+    bool next(T *value, size_t *index) const
     {
         const auto idx = m_next.fetch_add(1, std::memory_order_acquire);
         const bool hasNext = idx < m_vector.size();
-        if (hasNext)
+        if (hasNext) {
             *value = m_vector[idx];
+            *index = idx;
+        }
         return hasNext;
     }
 
@@ -3,8 +3,8 @@
 
 #include "lupdate.h"
 
+#include <trace.h>
 #include <translator.h>
-#include <xmlparser.h>
 
 #include <QtCore/QCoreApplication>
 #include <QtCore/QDebug>
@@ -16,11 +16,17 @@ QT_BEGIN_NAMESPACE
 
 using namespace Qt::StringLiterals;
 
-class UiReader : public XmlParser
+/*
+    Extracts the translatable strings of a form. Unlike the generic XmlParser,
+    it only reads the attributes of the few elements that carry translation
+    data, and it collects text without copying every chunk of it, since .ui
+    files consist mostly of elements that are of no interest here.
+*/
+class UiReader
 {
 public:
     UiReader(Translator &translator, ConversionData &cd, QXmlStreamReader &reader)
-        : XmlParser(reader),
+        : reader(reader),
           m_translator(translator),
           m_cd(cd),
           m_lineNumber(-1),
@@ -29,19 +35,19 @@ public:
           m_idBasedTranslations(false)
     {
     }
-    ~UiReader() override = default;
+
+    bool parse();
 
 private:
-    bool startElement(QStringView namespaceURI, QStringView localName,
-                      QStringView qName, const QXmlStreamAttributes &atts) override;
-    bool endElement(QStringView namespaceURI, QStringView localName,
-                    QStringView qName) override;
-    bool characters(QStringView ch) override;
-    bool fatalError(qint64 line, qint64 column, const QString &message) override;
+    void startElement(QStringView qName);
+    void endElement(QStringView qName);
+    void characters(QStringView ch);
+    void fatalError(qint64 line, qint64 column, const QString &message);
 
     void flush();
     void readTranslationAttributes(const QXmlStreamAttributes &atts);
 
+    QXmlStreamReader &reader;
     Translator &m_translator;
     ConversionData &m_cd;
     QString m_context;
@@ -57,67 +63,80 @@ private:
     bool m_idBasedTranslations;
 };
 
-bool UiReader::startElement(QStringView namespaceURI, QStringView localName,
-                            QStringView qName, const QXmlStreamAttributes &atts)
+bool UiReader::parse()
 {
-    Q_UNUSED(namespaceURI);
-    Q_UNUSED(localName);
+    while (!reader.atEnd()) {
+        reader.readNext();
+        if (reader.hasError()) {
+            fatalError(reader.lineNumber(), reader.columnNumber(), reader.errorString());
+            return false;
+        }
+
+        switch (reader.tokenType()) {
+        case QXmlStreamReader::StartElement:
+            startElement(reader.qualifiedName());
+            break;
+        case QXmlStreamReader::EndElement:
+            endElement(reader.qualifiedName());
+            break;
+        case QXmlStreamReader::Characters:
+            // Like XmlParser, ignore whitespace-only text
+            if (!reader.isWhitespace() && !reader.text().trimmed().isEmpty())
+                characters(reader.text());
+            break;
+        default:
+            break;
+        }
+    }
+    return true;
+}
 
+void UiReader::startElement(QStringView qName)
+{
     if (qName == QLatin1String("string")) {
         flush();
         if (!m_insideStringList)
-            readTranslationAttributes(atts);
+            readTranslationAttributes(reader.attributes());
     } else if (qName == QLatin1String("stringlist")) {
         flush();
         m_insideStringList = true;
-        readTranslationAttributes(atts);
+        readTranslationAttributes(reader.attributes());
     } else if (qName == QLatin1String("ui")) { // UI "header"
-        const auto attr = QStringLiteral("idbasedtr");
-        m_idBasedTranslations =
-                atts.hasAttribute(attr) && atts.value(attr) == QLatin1String("true");
+        const QXmlStreamAttributes atts = reader.attributes();
+        m_idBasedTranslations = atts.value(QLatin1String("idbasedtr")) == QLatin1String("true");
     }
     m_accum.clear();
-    return true;
 }
 
-bool UiReader::endElement(QStringView namespaceURI, QStringView localName,
-                          QStringView qName)
+void UiReader::endElement(QStringView qName)
 {
-    Q_UNUSED(namespaceURI);
-    Q_UNUSED(localName);
-
-    m_accum.replace(QLatin1String("\r\n"), QLatin1String("\n"));
-
     if (qName == QLatin1String("class")) { // UI "header"
         if (m_context.isEmpty())
-            m_context = m_accum;
+            m_context = QString(m_accum).replace(QLatin1String("\r\n"), QLatin1String("\n"));
     } else if (qName == QLatin1String("string") && m_isTrString) {
-        m_source = m_accum;
+        m_source = QString(m_accum).replace(QLatin1String("\r\n"), QLatin1String("\n"));
     } else if (qName == QLatin1String("comment")) { // FIXME: what's that?
-        m_comment = m_accum;
+        m_comment = QString(m_accum).replace(QLatin1String("\r\n"), QLatin1String("\n"));
         flush();
     } else if (qName == QLatin1String("stringlist")) {
         m_insideStringList = false;
     } else {
         flush();
     }
-    return true;
 }
 
-bool UiReader::characters(QStringView ch)
+void UiReader::characters(QStringView ch)
 {
-    m_accum += ch.toString();
-    return true;
+    m_accum += ch;
 }
 
-bool UiReader::fatalError(qint64 line, qint64 column, const QString &message)
+void UiReader::fatalError(qint64 line, qint64 column, const QString &message)
 {
     QString msg = QStringLiteral("XML error: Parse error at line %1, column %2 (%3).")
                           .arg(line)
                           .arg(column)
                           .arg(message);
     m_cd.appendError(msg);
-    return false;
 }
 
 void UiReader::flush()
@@ -156,6 +175,7 @@ void UiReader::readTranslationAttributes(const QXmlStreamAttributes &atts)
 
 bool loadUI(Translator &translator, const QString &filename, ConversionData &cd)
 {
+    TraceSpan span("parse", "loadUI", filename);
     cd.m_sourceFileName = filename;
     QFile file(filename);
     if (!file.open(QIODevice::ReadOnly)) {
@@ -163,7 +183,7 @@ bool loadUI(Translator &translator, const QString &filename, ConversionData &cd)
         return false;
     }
 
-    QXmlStreamReader reader(&file);
+    QXmlStreamReader reader(file.readAll());
     reader.setNamespaceProcessing(false);
 
     UiReader uiReader(translator, cd, reader);
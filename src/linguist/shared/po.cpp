@@ -4,9 +4,11 @@
 #include "translator.h"
 
 #include <QtCore/QDebug>
+#include <QtCore/QFileDevice>
 #include <QtCore/QIODevice>
 #include <QtCore/QHash>
 #include <QtCore/QRegularExpression>
+#include <QtCore/QScopeGuard>
 #include <QtCore/QString>
 #include <QtCore/QStringConverter>
 #include <QtCore/QTextStream>
@@ -181,19 +183,29 @@ public:
 };
 
 
-static bool isTranslationLine(const QByteArray &line)
+// The lines of a .po file, trimmed. They point into the file's contents,
+// which are read or mapped all at once.
+using PoLines = QList<QByteArrayView>;
+
+// Like QByteArray::mid(pos), for views
+static QByteArrayView tail(QByteArrayView line, qsizetype pos)
+{
+    return pos < line.size() ? line.sliced(pos) : QByteArrayView();
+}
+
+static bool isTranslationLine(QByteArrayView line)
 {
     return line.startsWith("#~ msgstr") || line.startsWith("msgstr");
 }
 
-static QByteArray slurpEscapedString(const QList<QByteArray> &lines, int &l,
-        int offset, const QByteArray &prefix, ConversionData &cd)
+static QByteArray slurpEscapedString(const PoLines &lines, int &l,
+        int offset, QByteArrayView prefix, ConversionData &cd)
 {
     QByteArray msg;
     int stoff;
 
     for (; l < lines.size(); ++l) {
-        const QByteArray &line = lines.at(l);
+        const QByteArrayView line = lines.at(l);
         if (line.isEmpty() || !line.startsWith(prefix))
             break;
         while (isspace(line[offset])) // No length check, as string has no trailing spaces.
@@ -259,17 +271,20 @@ static QByteArray slurpEscapedString(const QList<QByteArray> &lines, int &l,
                 case '6':
                 case '7':
                     stoff = offset - 1;
-                    while ((c = line[offset]) >= '0' && c <= '7')
-                        if (++offset == line.length())
-                            goto premature_eol;
-                    msg += line.mid(stoff, offset - stoff).toUInt(0, 8);
+                    // The view does not end with a NUL, so check the length first
+                    while (offset < line.length() && (c = line[offset]) >= '0' && c <= '7')
+                        ++offset;
+                    if (offset == line.length())
+                        goto premature_eol;
+                    msg += line.sliced(stoff, offset - stoff).toUInt(0, 8);
                     break;
                 case 'x':
                     stoff = offset;
-                    while (isxdigit(line[offset]))
-                        if (++offset == line.length())
-                            goto premature_eol;
-                    msg += line.mid(stoff, offset - stoff).toUInt(0, 16);
+                    while (offset < line.length() && isxdigit(line[offset]))
+                        ++offset;
+                    if (offset == line.length())
+                        goto premature_eol;
+                    msg += line.sliced(stoff, offset - stoff).toUInt(0, 16);
                     break;
                 default:
                     cd.appendError(QString::fromLatin1(
@@ -280,7 +295,13 @@ static QByteArray slurpEscapedString(const QList<QByteArray> &lines, int &l,
                     break;
                 }
             } else {
+                // Copy the run of plain characters at once
+                qsizetype end = offset;
+                while (end < line.size() && line[end] != '"' && line[end] != '\\')
+                    ++end;
                 msg += c;
+                msg += line.sliced(offset, end - offset);
+                offset = end;
             }
         }
         offset = prefix.size();
@@ -294,10 +315,10 @@ premature_eol:
     return QByteArray();
 }
 
-static void slurpComment(QByteArray &msg, const QList<QByteArray> &lines, int & l)
+static void slurpComment(QByteArray &msg, const PoLines &lines, int & l)
 {
     int firstLine = l;
-    QByteArray prefix = lines.at(l);
+    QByteArrayView prefix = lines.at(l);
     for (int i = 1; ; i++) {
         if (prefix.at(i) != ' ') {
             prefix.truncate(i);
@@ -305,11 +326,11 @@ static void slurpComment(QByteArray &msg, const QList<QByteArray> &lines, int &
         }
     }
     for (; l < lines.size(); ++l) {
-        const QByteArray &line = lines.at(l);
+        const QByteArrayView line = lines.at(l);
         if (line.startsWith(prefix)) {
             if (l > firstLine)
                 msg += '\n';
-            msg += line.mid(prefix.size());
+            msg += tail(line, prefix.size());
         } else if (line == "#") {
             msg += '\n';
         } else {
@@ -347,7 +368,8 @@ static QString makePoHeader(const QString &str)
     return QLatin1String("po-header-") + str.toLower().replace(QLatin1Char('-'), QLatin1Char('_'));
 }
 
-static QByteArray QByteArrayList_join(const QList<QByteArray> &that, char sep)
+template <typename ByteArrayList>
+static QByteArray QByteArrayList_join(const ByteArrayList &that, char sep)
 {
     int totalLength = 0;
     const int size = that.size();
@@ -374,6 +396,7 @@ bool loadPO(Translator &translator, QIODevice &dev, ConversionData &cd)
 {
     QStringDecoder toUnicode(QStringConverter::Utf8, QStringDecoder::Flag::Stateless);
     bool error = false;
+    StringPool strings;
 
     // format of a .po file entry:
     // white-space
@@ -393,22 +416,46 @@ bool loadPO(Translator &translator, QIODevice &dev, ConversionData &cd)
     // msgstr[0] translated-string
     // ...
 
-    // we need line based lookahead below.
-    QList<QByteArray> lines;
-    while (!dev.atEnd())
-        lines.append(dev.readLine().trimmed());
-    lines.append(QByteArray());
+    // we need line based lookahead below. Map the file if possible, and
+    // split it into lines in place.
+    QByteArray contents;
+    QByteArrayView data;
+    QFileDevice *file = qobject_cast<QFileDevice *>(&dev);
+    uchar *mapped = nullptr;
+    if (file && !file->isSequential() && file->size() > file->pos())
+        mapped = file->map(file->pos(), file->size() - file->pos());
+    const auto unmap = qScopeGuard([&] {
+        if (mapped)
+            file->unmap(mapped);
+    });
+    if (mapped) {
+        data = QByteArrayView(mapped, file->size() - file->pos());
+    } else {
+        contents = dev.readAll();
+        data = contents;
+    }
+
+    PoLines lines;
+    lines.reserve(data.count('\n') + 2);
+    for (qsizetype start = 0; start < data.size(); ) {
+        qsizetype end = data.indexOf('\n', start);
+        if (end < 0)
+            end = data.size();
+        lines.append(data.sliced(start, end - start).trimmed());
+        start = end + 1;
+    }
+    lines.append(QByteArrayView());
 
     int l = 0, lastCmtLine = -1;
     bool qtContexts = false;
     PoItem item;
     for (; l != lines.size(); ++l) {
-        QByteArray line = lines.at(l);
+        QByteArrayView line = lines.at(l);
         if (line.isEmpty())
            continue;
         if (isTranslationLine(line)) {
             bool isObsolete = line.startsWith("#~ msgstr");
-            const QByteArray prefix = isObsolete ? "#~ " : "";
+            const QByteArrayView prefix = isObsolete ? "#~ " : "";
             while (true) {
                 int idx = line.indexOf(' ', prefix.length());
                 QByteArray str = slurpEscapedString(lines, l, idx, prefix, cd);
@@ -528,7 +575,7 @@ bool loadPO(Translator &translator, QIODevice &dev, ConversionData &cd)
                         bool ok;
                         int lno = ref.mid(pos + 1).toInt(&ok);
                         if (ok) {
-                            msg.addReference(ref.left(pos), lno);
+                            msg.addReference(strings.intern(QStringView(ref).left(pos)), lno);
                             continue;
                         }
                     }
@@ -537,7 +584,7 @@ bool loadPO(Translator &translator, QIODevice &dev, ConversionData &cd)
                     xrefs += ref;
                 }
                 if (!xrefs.isEmpty())
-                    item.extra[QLatin1String("po-references")] = xrefs;
+                    item.extra[QStringLiteral("po-references")] = xrefs;
             }
             msg.setId(toUnicode(item.id));
             msg.setSourceText(toUnicode(item.msgId));
@@ -574,12 +621,12 @@ bool loadPO(Translator &translator, QIODevice &dev, ConversionData &cd)
         } else if (line.startsWith('#')) {
             switch (line.size() < 2 ? 0 : line.at(1)) {
                 case ':':
-                    item.references += line.mid(3);
+                    item.references += tail(line, 3);
                     item.references += '\n';
                     break;
                 case ',': {
                     QStringList flags =
-                            QString::fromLatin1(line.mid(2)).split(
+                            QString::fromLatin1(tail(line, 2)).split(
                                     QRegularExpression(QLatin1String("[, ]")), Qt::SkipEmptyParts);
                     if (flags.removeOne(QLatin1String("fuzzy")))
                         item.isFuzzy = true;
@@ -588,7 +635,7 @@ bool loadPO(Translator &translator, QIODevice &dev, ConversionData &cd)
                     if (it != item.extra.cend())
                         flags.prepend(*it);
                     if (!flags.isEmpty())
-                        item.extra[QLatin1String("po-flags")] = flags.join(QLatin1String(", "));
+                        item.extra[QStringLiteral("po-flags")] = flags.join(QLatin1String(", "));
                     break;
                 }
                 case 0:
@@ -599,11 +646,11 @@ bool loadPO(Translator &translator, QIODevice &dev, ConversionData &cd)
                     break;
                 case '.':
                     if (line.startsWith("#. ts-context ")) { // legacy
-                        item.context = line.mid(14);
+                        item.context = tail(line, 14).toByteArray();
                     } else if (line.startsWith("#. ts-id ")) {
-                        item.id = line.mid(9);
+                        item.id = tail(line, 9).toByteArray();
                     } else {
-                        item.automaticComments += line.mid(3);
+                        item.automaticComments += tail(line, 3);
 
                     }
                     break;
@@ -613,7 +660,7 @@ bool loadPO(Translator &translator, QIODevice &dev, ConversionData &cd)
                     } else if (line.startsWith("#| msgid_plural ")) {
                         QByteArray extra = slurpEscapedString(lines, l, 16, "#| ", cd);
                         if (extra != item.oldMsgId)
-                            item.extra[QLatin1String("po-old_msgid_plural")] =
+                            item.extra[QStringLiteral("po-old_msgid_plural")] =
                                     toUnicode(extra);
                     } else if (line.startsWith("#| msgctxt ")) {
                         item.oldTscomment = slurpEscapedString(lines, l, 11, "#| ", cd);
@@ -631,7 +678,7 @@ bool loadPO(Translator &translator, QIODevice &dev, ConversionData &cd)
                     } else if (line.startsWith("#~ msgid_plural ")) {
                         QByteArray extra = slurpEscapedString(lines, l, 16, "#~ ", cd);
                         if (extra != item.msgId)
-                            item.extra[QLatin1String("po-msgid_plural")] =
+                            item.extra[QStringLiteral("po-msgid_plural")] =
                                     toUnicode(extra);
                         item.isPlural = true;
                     } else if (line.startsWith("#~ msgctxt ")) {
@@ -643,7 +690,7 @@ bool loadPO(Translator &translator, QIODevice &dev, ConversionData &cd)
                     } else if (line.startsWith("#~| msgid_plural ")) {
                         QByteArray extra = slurpEscapedString(lines, l, 17, "#~| ", cd);
                         if (extra != item.oldMsgId)
-                            item.extra[QLatin1String("po-old_msgid_plural")] =
+                            item.extra[QStringLiteral("po-old_msgid_plural")] =
                                     toUnicode(extra);
                     } else if (line.startsWith("#~| msgctxt ")) {
                         item.oldTscomment = slurpEscapedString(lines, l, 12, "#~| ", cd);
@@ -671,7 +718,7 @@ bool loadPO(Translator &translator, QIODevice &dev, ConversionData &cd)
         } else if (line.startsWith("msgid_plural ")) {
             QByteArray extra = slurpEscapedString(lines, l, 13, QByteArray(), cd);
             if (extra != item.msgId)
-                item.extra[QLatin1String("po-msgid_plural")] = toUnicode(extra);
+                item.extra[QStringLiteral("po-msgid_plural")] = toUnicode(extra);
             item.isPlural = true;
         } else {
             cd.appendError(QString(QLatin1String("PO-format error in line %1: '%2'"))
@@ -750,7 +797,8 @@ bool savePO(const Translator &translator, QIODevice &dev, ConversionData &)
     out << poEscapedString(QString(), QString::fromLatin1("msgstr"), true, hdrStr);
 
     for (const TranslatorMessage &msg : translator.messages()) {
-        out << Qt::endl;
+        // Not Qt::endl, which would flush the stream for every message
+        out << '\n';
 
         if (!msg.translatorComment().isEmpty())
             out << poEscapedLines(QLatin1String("#"), true, msg.translatorComment());
@@ -361,35 +361,39 @@ QString ProStringList::join(QChar sep) const
     return ProStringList_join(*this, &sep, 1);
 }
 
+// Below this, scanning the list beats building a hash of it.
+static const int MinHashedListSize = 16;
+
 void ProStringList::removeAll(const ProString &str)
 {
-    for (int i = size(); --i >= 0; )
-        if (at(i) == str)
-            remove(i);
+    removeIf([&str](const ProString &s) { return s == str; });
 }
 
 void ProStringList::removeAll(const char *str)
 {
-    for (int i = size(); --i >= 0; )
-        if (at(i) == str)
-            remove(i);
+    removeIf([str](const ProString &s) { return s == str; });
 }
 
 void ProStringList::removeEach(const ProStringList &value)
 {
-    for (const ProString &str : value) {
-        if (isEmpty())
-            break;
-        if (!str.isEmpty())
-            removeAll(str);
+    if (isEmpty() || value.isEmpty())
+        return;
+    if (value.size() == 1) {
+        if (!value.first().isEmpty())
+            removeAll(value.first());
+        return;
     }
+    QSet<ProString> unwanted;
+    unwanted.reserve(value.size());
+    for (const ProString &str : value)
+        if (!str.isEmpty())
+            unwanted.insert(str);
+    removeIf([&unwanted](const ProString &s) { return unwanted.contains(s); });
 }
 
 void ProStringList::removeEmpty()
 {
-    for (int i = size(); --i >= 0;)
-        if (at(i).isEmpty())
-            remove(i);
+    removeIf([](const ProString &s) { return s.isEmpty(); });
 }
 
 void ProStringList::removeDuplicates()
@@ -413,9 +417,24 @@ void ProStringList::removeDuplicates()
 
 void ProStringList::insertUnique(const ProStringList &value)
 {
-    for (const ProString &str : value)
-        if (!str.isEmpty() && !contains(str))
+    if (value.size() == 1 || size() + value.size() < MinHashedListSize) {
+        for (const ProString &str : value)
+            if (!str.isEmpty() && !contains(str))
+                append(str);
+        return;
+    }
+    QSet<ProString> seen;
+    seen.reserve(size() + value.size());
+    for (const ProString &str : qAsConst(*this))
+        seen.insert(str);
+    for (const ProString &str : value) {
+        if (str.isEmpty())
+            continue;
+        const qsizetype count = seen.size();
+        seen.insert(str);
+        if (seen.size() != count)
             append(str);
+    }
 }
 
 ProStringList::ProStringList(const QStringList &list)
@@ -2,6 +2,7 @@
 // SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
 
 #include "translator.h"
+#include "trace.h"
 
 #ifndef QT_BOOTSTRAPPED
 #include <QtCore/QCoreApplication>
@@ -14,6 +15,11 @@
 #include <QtCore/QMap>
 #include <QtCore/QString>
 #include <QtCore/QStringDecoder>
+#include <QtCore/qendian.h>
+
+#include <algorithm>
+#include <thread>
+#include <vector>
 
 QT_BEGIN_NAMESPACE
 
@@ -68,6 +74,77 @@ static uint elfHash(const QByteArray &ba)
     return h;
 }
 
+/*
+    The message and offset arrays are written straight into preallocated
+    buffers. The layout is the one QDataStream produces: big endian
+    integers, strings and byte arrays prefixed with their size in bytes,
+    null ones with 0xffffffff.
+*/
+static uchar *write8(uchar *dest, quint8 value)
+{
+    *dest = value;
+    return dest + 1;
+}
+
+static uchar *write32(uchar *dest, quint32 value)
+{
+    qToBigEndian(value, dest);
+    return dest + 4;
+}
+
+static qsizetype serializedSize(const QByteArray &ba)
+{
+    return 4 + ba.size();
+}
+
+static qsizetype serializedSize(const QString &str)
+{
+    return 4 + 2 * str.size();
+}
+
+static uchar *writeBytes(uchar *dest, const QByteArray &ba)
+{
+    if (ba.isNull())
+        return write32(dest, 0xffffffff);
+    dest = write32(dest, quint32(ba.size()));
+    memcpy(dest, ba.constData(), ba.size());
+    return dest + ba.size();
+}
+
+static uchar *writeString(uchar *dest, const QString &str)
+{
+    if (str.isNull())
+        return write32(dest, 0xffffffff);
+    dest = write32(dest, quint32(2 * str.size()));
+    qToBigEndian<quint16>(str.utf16(), str.size(), dest);
+    return dest + 2 * str.size();
+}
+
+/*
+    Calls \a work on consecutive chunks of the range [0, \a count). Large
+    ranges are split between threads, \a work must be safe to run
+    concurrently on distinct chunks.
+*/
+template <typename Work>
+static void forEachChunk(qsizetype count, const Work &work)
+{
+    constexpr qsizetype MinChunkSize = 8192;
+    const qsizetype threadCount = qMax(1u, std::thread::hardware_concurrency());
+    const qsizetype chunkCount = qMin(threadCount, count / MinChunkSize);
+    if (chunkCount <= 1) {
+        work(0, count);
+        return;
+    }
+
+    std::vector<std::thread> threads;
+    threads.reserve(chunkCount - 1);
+    for (qsizetype c = 1; c < chunkCount; ++c)
+        threads.emplace_back(work, c * count / chunkCount, (c + 1) * count / chunkCount);
+    work(0, count / chunkCount);
+    for (std::thread &thread : threads)
+        thread.join();
+}
+
 class ByteTranslatorMessage
 {
 public:
@@ -147,12 +224,15 @@ private:
     // on turn should be the same as passed to the actual tr(...) calls
     QByteArray originalBytes(const QString &str) const;
 
-    static Prefix commonPrefix(const ByteTranslatorMessage &m1, const ByteTranslatorMessage &m2);
+    static Prefix commonPrefix(const ByteTranslatorMessage &m1, uint h1,
+                               const ByteTranslatorMessage &m2, uint h2);
 
     static uint msgHash(const ByteTranslatorMessage &msg);
 
-    void writeMessage(const ByteTranslatorMessage & msg, QDataStream & stream,
-        TranslatorSaveMode strip, Prefix prefix) const;
+    static qsizetype messageSize(const ByteTranslatorMessage &msg, TranslatorSaveMode mode,
+                                 Prefix prefix);
+    static uchar *writeMessage(const ByteTranslatorMessage &msg, uchar *dest,
+                               TranslatorSaveMode mode, Prefix prefix);
 
     QString m_language;
     // for squeezed but non-file data, this is what needs to be deleted
@@ -180,9 +260,10 @@ uint Releaser::msgHash(const ByteTranslatorMessage &msg)
     return elfHash(msg.sourceText() + msg.comment());
 }
 
-Prefix Releaser::commonPrefix(const ByteTranslatorMessage &m1, const ByteTranslatorMessage &m2)
+Prefix Releaser::commonPrefix(const ByteTranslatorMessage &m1, uint h1,
+                              const ByteTranslatorMessage &m2, uint h2)
 {
-    if (msgHash(m1) != msgHash(m2))
+    if (h1 != h2)
         return NoPrefix;
     if (m1.context() != m2.context())
         return Hash;
@@ -193,11 +274,37 @@ Prefix Releaser::commonPrefix(const ByteTranslatorMessage &m1, const ByteTransla
     return HashContextSourceTextComment;
 }
 
-void Releaser::writeMessage(const ByteTranslatorMessage &msg, QDataStream &stream,
-    TranslatorSaveMode mode, Prefix prefix) const
+qsizetype Releaser::messageSize(const ByteTranslatorMessage &msg, TranslatorSaveMode mode,
+                                Prefix prefix)
 {
-    for (int i = 0; i < msg.translations().count(); ++i)
-        stream << quint8(Tag_Translation) << msg.translations().at(i);
+    qsizetype size = 0;
+    for (const QString &translation : msg.translations())
+        size += 1 + serializedSize(translation);
+
+    if (mode == SaveEverything)
+        prefix = HashContextSourceTextComment;
+
+    switch (prefix) {
+    default:
+    case HashContextSourceTextComment:
+        size += 1 + serializedSize(msg.comment());
+        Q_FALLTHROUGH();
+    case HashContextSourceText:
+        size += 1 + serializedSize(msg.sourceText());
+        Q_FALLTHROUGH();
+    case HashContext:
+        size += 1 + serializedSize(msg.context());
+        break;
+    }
+
+    return size + 1;
+}
+
+uchar *Releaser::writeMessage(const ByteTranslatorMessage &msg, uchar *dest,
+                              TranslatorSaveMode mode, Prefix prefix)
+{
+    for (const QString &translation : msg.translations())
+        dest = writeString(write8(dest, Tag_Translation), translation);
 
     if (mode == SaveEverything)
         prefix = HashContextSourceTextComment;
@@ -206,61 +313,63 @@ void Releaser::writeMessage(const ByteTranslatorMessage &msg, QDataStream &strea
     switch (prefix) {
     default:
     case HashContextSourceTextComment:
-        stream << quint8(Tag_Comment) << msg.comment();
+        dest = writeBytes(write8(dest, Tag_Comment), msg.comment());
         Q_FALLTHROUGH();
     case HashContextSourceText:
-        stream << quint8(Tag_SourceText) << msg.sourceText();
+        dest = writeBytes(write8(dest, Tag_SourceText), msg.sourceText());
         Q_FALLTHROUGH();
     case HashContext:
-        stream << quint8(Tag_Context) << msg.context();
+        dest = writeBytes(write8(dest, Tag_Context), msg.context());
         break;
     }
 
-    stream << quint8(Tag_End);
+    return write8(dest, Tag_End);
 }
 
+static void appendSection(QByteArray &out, quint8 tag, const QByteArray &data)
+{
+    uchar header[5];
+    write32(write8(header, tag), quint32(data.size()));
+    out.append(reinterpret_cast<const char *>(header), sizeof(header));
+    out.append(data);
+}
 
 bool Releaser::save(QIODevice *iod)
 {
-    QDataStream s(iod);
-    s.writeRawData((const char *)magic, MagicLength);
-
-    if (!m_language.isEmpty()) {
-        QByteArray lang = originalBytes(m_language);
-        quint32 las = quint32(lang.size());
-        s << quint8(Language) << las;
-        s.writeRawData(lang, las);
-    }
-    if (!m_dependencyArray.isEmpty()) {
-        quint32 das = quint32(m_dependencyArray.size());
-        s << quint8(Dependencies) << das;
-        s.writeRawData(m_dependencyArray.constData(), das);
-    }
-    if (!m_offsetArray.isEmpty()) {
-        quint32 oas = quint32(m_offsetArray.size());
-        s << quint8(Hashes) << oas;
-        s.writeRawData(m_offsetArray.constData(), oas);
-    }
-    if (!m_messageArray.isEmpty()) {
-        quint32 mas = quint32(m_messageArray.size());
-        s << quint8(Messages) << mas;
-        s.writeRawData(m_messageArray.constData(), mas);
-    }
-    if (!m_contextArray.isEmpty()) {
-        quint32 cas = quint32(m_contextArray.size());
-        s << quint8(Contexts) << cas;
-        s.writeRawData(m_contextArray.constData(), cas);
-    }
-    if (!m_numerusRules.isEmpty()) {
-        quint32 nrs = m_numerusRules.size();
-        s << quint8(NumerusRules) << nrs;
-        s.writeRawData(m_numerusRules.constData(), nrs);
+    QByteArray lang;
+    if (!m_language.isEmpty())
+        lang = originalBytes(m_language);
+
+    // Assemble the whole file first, so that it is written with a single call.
+    const QByteArrayList sections = { lang, m_dependencyArray, m_offsetArray, m_messageArray,
+                                      m_contextArray, m_numerusRules };
+    qsizetype size = MagicLength;
+    for (const QByteArray &section : sections) {
+        if (!section.isEmpty())
+            size += 5 + section.size();
     }
-    return true;
+
+    QByteArray out;
+    out.reserve(size);
+    out.append(reinterpret_cast<const char *>(magic), MagicLength);
+    if (!lang.isEmpty())
+        appendSection(out, Language, lang);
+    if (!m_dependencyArray.isEmpty())
+        appendSection(out, Dependencies, m_dependencyArray);
+    if (!m_offsetArray.isEmpty())
+        appendSection(out, Hashes, m_offsetArray);
+    if (!m_messageArray.isEmpty())
+        appendSection(out, Messages, m_messageArray);
+    if (!m_contextArray.isEmpty())
+        appendSection(out, Contexts, m_contextArray);
+    if (!m_numerusRules.isEmpty())
+        appendSection(out, NumerusRules, m_numerusRules);
+    return iod->write(out) == out.size();
 }
 
 void Releaser::squeeze(TranslatorSaveMode mode)
 {
+    TraceSpan span("qm", "Releaser::squeeze");
     m_dependencyArray.clear();
     QDataStream depstream(&m_dependencyArray, QIODevice::WriteOnly);
     for (const QString &dep : qAsConst(m_dependencies))
@@ -277,28 +386,66 @@ void Releaser::squeeze(TranslatorSaveMode mode)
     m_contextArray.clear();
     m_messages.clear();
 
-    QMap<Offset, void *> offsets;
+    // Lay out the message array up front, then fill it in place. Once the
+    // sorted order is known every message can be encoded on its own, so
+    // the work is spread over several threads for large catalogs.
+    struct Layout
+    {
+        const ByteTranslatorMessage *msg;
+        uint hash;
+        Prefix prefix;
+        uint offset;
+    };
+    std::vector<Layout> layout;
+    layout.reserve(messages.size());
+    for (auto it = messages.cbegin(), end = messages.cend(); it != end; ++it)
+        layout.push_back({ &it.key(), 0, NoPrefix, 0 });
+    const qsizetype count = qsizetype(layout.size());
+
+    forEachChunk(count, [&](qsizetype begin, qsizetype end) {
+        for (qsizetype i = begin; i < end; ++i)
+            layout[i].hash = msgHash(*layout[i].msg);
+    });
+
+    std::vector<qsizetype> sizes(count);
+    forEachChunk(count, [&](qsizetype begin, qsizetype end) {
+        for (qsizetype i = begin; i < end; ++i) {
+            Layout &l = layout[i];
+            const int cpPrev = i == 0 ? 0
+                    : commonPrefix(*layout[i - 1].msg, layout[i - 1].hash, *l.msg, l.hash);
+            const int cpNext = i + 1 == count ? 0
+                    : commonPrefix(*l.msg, l.hash, *layout[i + 1].msg, layout[i + 1].hash);
+            l.prefix = Prefix(qMax(cpPrev, cpNext + 1));
+            sizes[i] = messageSize(*l.msg, mode, l.prefix);
+        }
+    });
 
-    QDataStream ms(&m_messageArray, QIODevice::WriteOnly);
-    int cpPrev = 0, cpNext = 0;
-    for (auto it = messages.cbegin(), end = messages.cend(); it != end; ++it) {
-        cpPrev = cpNext;
-        const auto next = std::next(it);
-        if (next == end)
-            cpNext = 0;
-        else
-            cpNext = commonPrefix(it.key(), next.key());
-        offsets.insert(Offset(msgHash(it.key()), ms.device()->pos()), (void *)0);
-        writeMessage(it.key(), ms, mode, Prefix(qMax(cpPrev, cpNext + 1)));
+    qsizetype size = 0;
+    for (qsizetype i = 0; i < count; ++i) {
+        layout[i].offset = uint(size);
+        size += sizes[i];
     }
 
-    auto offset = offsets.cbegin();
-    QDataStream ds(&m_offsetArray, QIODevice::WriteOnly);
-    while (offset != offsets.cend()) {
-        Offset k = offset.key();
-        ++offset;
-        ds << quint32(k.h) << quint32(k.o);
-    }
+    m_messageArray.resize(size);
+    uchar *data = reinterpret_cast<uchar *>(m_messageArray.data());
+    forEachChunk(count, [&](qsizetype begin, qsizetype end) {
+        for (qsizetype i = begin; i < end; ++i) {
+            [[maybe_unused]] const uchar *next =
+                    writeMessage(*layout[i].msg, data + layout[i].offset, mode, layout[i].prefix);
+            Q_ASSERT(next == data + layout[i].offset + sizes[i]);
+        }
+    });
+
+    std::vector<Offset> offsets;
+    offsets.reserve(layout.size());
+    for (const Layout &entry : layout)
+        offsets.emplace_back(entry.hash, entry.offset);
+    std::sort(offsets.begin(), offsets.end());
+
+    m_offsetArray.resize(qsizetype(offsets.size()) * 8);
+    uchar *dest = reinterpret_cast<uchar *>(m_offsetArray.data());
+    for (const Offset &offset : offsets)
+        dest = write32(write32(dest, offset.h), offset.o);
 
     if (mode == SaveStripped) {
         QMap<QByteArray, int> contextSet;
@@ -7,7 +7,11 @@
 #include "ioutils.h"
 using namespace QMakeInternal;
 
+#include <qcryptographichash.h>
+#include <qdatastream.h>
+#include <qdir.h>
 #include <qfile.h>
+#include <qsavefile.h>
 #ifdef PROPARSER_THREAD_SAFE
 # include <qthreadpool.h>
 #endif
@@ -99,6 +103,69 @@ void ProFileCache::discardFiles(const QString &prefix, QMakeVfs *vfs)
     }
 }
 
+static const quint32 persistentCacheMagic = 0x51504643; // "QPFC"
+static const quint32 persistentCacheVersion = 1;
+
+// The entries are addressed by the name and contents of the parsed file,
+// so a changed file simply misses. Entries of old versions of a file are
+// never removed.
+QString ProFileCache::persistentEntryPath(const QString &fileName, QStringView contents) const
+{
+    QCryptographicHash hash(QCryptographicHash::Sha1);
+    hash.addData(QByteArrayView(reinterpret_cast<const char *>(fileName.utf16()),
+                                fileName.size() * 2));
+    hash.addData(QByteArrayView("\0\0", 2));
+    hash.addData(QByteArrayView(reinterpret_cast<const char *>(contents.utf16()),
+                                contents.size() * 2));
+    return persistent_dir + QLatin1Char('/') + QString::fromLatin1(hash.result().toHex())
+            + QLatin1String(".procache");
+}
+
+ProFile *ProFileCache::loadPersistent(int id, const QString &fileName, QStringView contents) const
+{
+    if (persistent_dir.isEmpty())
+        return nullptr;
+    QFile file(persistentEntryPath(fileName, contents));
+    if (!file.open(QIODevice::ReadOnly))
+        return nullptr;
+    QDataStream in(&file);
+    quint32 magic, version;
+    in >> magic >> version;
+    if (in.status() != QDataStream::Ok || magic != persistentCacheMagic
+        || version != persistentCacheVersion) {
+        return nullptr;
+    }
+    in.setVersion(QDataStream::Qt_6_0);
+    QString storedFileName, items;
+    bool hostBuild;
+    in >> storedFileName >> hostBuild >> items;
+    if (in.status() != QDataStream::Ok || storedFileName != fileName)
+        return nullptr;
+    ProFile *pro = new ProFile(id, fileName);
+    pro->setHostBuild(hostBuild);
+    *pro->itemsRef() = items;
+    return pro;
+}
+
+// Only files that parsed without any message are stored, replaying a cached
+// file must not lose diagnostics.
+void ProFileCache::storePersistent(const ProFile *pro, QStringView contents) const
+{
+    if (persistent_dir.isEmpty() || !pro->isOk())
+        return;
+    if (!QDir().mkpath(persistent_dir))
+        return;
+    QSaveFile file(persistentEntryPath(pro->fileName(), contents));
+    if (!file.open(QIODevice::WriteOnly))
+        return;
+    QDataStream out(&file);
+    out << persistentCacheMagic << persistentCacheVersion;
+    out.setVersion(QDataStream::Qt_6_0);
+    out << pro->fileName() << pro->isHostBuild() << pro->items();
+    if (out.status() == QDataStream::Ok)
+        file.commit();
+}
+
 ////////// Parser ///////////
 
 #define fL1S(s) QString::fromLatin1(s)
@@ -176,6 +243,7 @@ ProFile *QMakeParser::parsedProFile(const QString &fileName, ParseFlags flags)
                 QThreadPool::globalInstance()->releaseThread();
                 ent->locker->cond.wait(locker.mutex());
                 QThreadPool::globalInstance()->reserveThread();
+                ent = &m_cache->parsed_files[id];
                 if (!--ent->locker->waiters) {
                     delete ent->locker;
                     ent->locker = 0;
@@ -192,15 +260,23 @@ ProFile *QMakeParser::parsedProFile(const QString &fileName, ParseFlags flags)
 #endif
             QString contents;
             if (readFile(id, flags, &contents)) {
-                pro = parsedProBlock(QStringView(contents), id, fileName, 1, FullGrammar);
-                pro->itemsRef()->squeeze();
+                pro = m_cache->loadPersistent(id, fileName, contents);
+                if (!pro) {
+                    const int messageCount = m_messageCount;
+                    pro = parsedProBlock(QStringView(contents), id, fileName, 1, FullGrammar);
+                    pro->itemsRef()->squeeze();
+                    if (m_messageCount == messageCount)
+                        m_cache->storePersistent(pro, contents);
+                }
                 pro->ref();
             } else {
                 pro = nullptr;
             }
-            ent->pro = pro;
 #ifdef PROPARSER_THREAD_SAFE
             locker.relock();
+            // Other threads may have added entries meanwhile, moving this one.
+            ent = &m_cache->parsed_files[id];
+            ent->pro = pro;
             if (ent->locker->waiters) {
                 ent->locker->done = true;
                 ent->locker->cond.wakeAll();
@@ -208,6 +284,8 @@ ProFile *QMakeParser::parsedProFile(const QString &fileName, ParseFlags flags)
                 delete ent->locker;
                 ent->locker = 0;
             }
+#else
+            ent->pro = pro;
 #endif
         }
     } else {
@@ -1285,6 +1363,7 @@ bool QMakeParser::resolveVariable(ushort *xprPtr, int tlen, int needSep, ushort
 
 void QMakeParser::message(int type, const QString &msg) const
 {
+    ++m_messageCount;
     if (!m_inError && m_handler)
         m_handler->message(type, msg, m_proFile->fileName(), m_lineNo);
 }
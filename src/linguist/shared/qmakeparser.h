@@ -159,6 +159,7 @@ private:
     enum { NoOperator, AndOperator, OrOperator } m_operator; // Pending conditional is ORed/ANDed
 
     QString m_tmp; // Temporary for efficient toQString
+    mutable int m_messageCount = 0; // Files that caused messages are not cached persistently
 
     ProFileCache *m_cache;
     QMakeParserHandler *m_handler;
@@ -182,7 +183,14 @@ public:
     void discardFile(const QString &fileName, QMakeVfs *vfs);
     void discardFiles(const QString &prefix, QMakeVfs *vfs);
 
+    // Keep parsed files in this directory as well, for use by later processes.
+    void setPersistentDirectory(const QString &directory) { persistent_dir = directory; }
+
 private:
+    QString persistentEntryPath(const QString &fileName, QStringView contents) const;
+    ProFile *loadPersistent(int id, const QString &fileName, QStringView contents) const;
+    void storePersistent(const ProFile *pro, QStringView contents) const;
+
     struct Entry {
         ProFile *pro;
 #ifdef PROPARSER_THREAD_SAFE
@@ -197,6 +205,7 @@ private:
     };
 
     QHash<int, Entry> parsed_files;
+    QString persistent_dir;
 #ifdef PROPARSER_THREAD_SAFE
     QMutex mutex;
 #endif
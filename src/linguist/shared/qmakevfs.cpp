@@ -31,7 +31,7 @@ QMakeVfs::~QMakeVfs()
 void QMakeVfs::ref()
 {
 #ifdef PROEVALUATOR_THREAD_SAFE
-    QMutexLocker locker(&s_mutex);
+    QWriteLocker locker(&s_lock);
 #endif
     ++s_refCount;
 }
@@ -39,7 +39,7 @@ void QMakeVfs::ref()
 void QMakeVfs::deref()
 {
 #ifdef PROEVALUATOR_THREAD_SAFE
-    QMutexLocker locker(&s_mutex);
+    QWriteLocker locker(&s_lock);
 #endif
     if (!--s_refCount) {
         s_fileIdCounter = 0;
@@ -49,7 +49,7 @@ void QMakeVfs::deref()
 }
 
 #ifdef PROPARSER_THREAD_SAFE
-QMutex QMakeVfs::s_mutex;
+QReadWriteLock QMakeVfs::s_lock;
 #endif
 int QMakeVfs::s_refCount;
 QAtomicInt QMakeVfs::s_fileIdCounter;
@@ -79,7 +79,13 @@ int QMakeVfs::idForFileName(const QString &fn, VfsFlags flags)
 #endif
     if (!(flags & VfsAccessedOnly)) {
 #ifdef PROPARSER_THREAD_SAFE
-        QMutexLocker locker(&s_mutex);
+        // Most files are looked up many times, they only need the read lock then.
+        {
+            QReadLocker locker(&s_lock);
+            if (int id = s_fileIdMap.value(fn))
+                return id;
+        }
+        QWriteLocker locker(&s_lock);
 #endif
         int &id = s_fileIdMap[fn];
         if (!id) {
@@ -88,6 +94,9 @@ int QMakeVfs::idForFileName(const QString &fn, VfsFlags flags)
         }
         return id;
     }
+#ifdef PROPARSER_THREAD_SAFE
+    QReadLocker locker(&s_lock);
+#endif
     return s_fileIdMap.value(fn);
 }
 
@@ -104,7 +113,7 @@ QString QMakeVfs::fileNameForId(int id)
     }
 #endif
 #ifdef PROPARSER_THREAD_SAFE
-    QMutexLocker locker(&s_mutex);
+    QReadLocker locker(&s_lock);
 #endif
     return s_idFileMap.value(id);
 }
@@ -114,7 +123,7 @@ bool QMakeVfs::writeFile(int id, QIODevice::OpenMode mode, VfsFlags flags,
 {
 #ifndef PROEVALUATOR_FULL
 # ifdef PROEVALUATOR_THREAD_SAFE
-    QMutexLocker locker(&m_mutex);
+    QWriteLocker locker(&m_lock);
 # endif
     QString *cont = &m_files[id];
     Q_UNUSED(flags);
@@ -165,17 +174,24 @@ bool QMakeVfs::writeFile(int id, QIODevice::OpenMode mode, VfsFlags flags,
 QMakeVfs::ReadResult QMakeVfs::readFile(int id, QString *contents, QString *errStr)
 {
 #ifndef PROEVALUATOR_FULL
+    {
 # ifdef PROEVALUATOR_THREAD_SAFE
-    QMutexLocker locker(&m_mutex);
+        QReadLocker locker(&m_lock);
 # endif
-    auto it = m_files.constFind(id);
-    if (it != m_files.constEnd()) {
-        if (it->constData() == m_magicMissing.constData()) {
-            *errStr = fL1S("No such file or directory");
-            return ReadNotFound;
+        auto it = m_files.constFind(id);
+        if (it != m_files.constEnd()) {
+            if (it->constData() == m_magicMissing.constData()) {
+                *errStr = fL1S("No such file or directory");
+                return ReadNotFound;
+            }
+            if (it->constData() != m_magicExisting.constData()) {
+                *contents = *it;
+                return ReadOk;
+            }
         }
-        if (it->constData() != m_magicExisting.constData()) {
-            *contents = *it;
+        auto cit = m_contents.constFind(id);
+        if (cit != m_contents.constEnd()) {
+            *contents = *cit;
             return ReadOk;
         }
     }
@@ -185,7 +201,7 @@ QMakeVfs::ReadResult QMakeVfs::readFile(int id, QString *contents, QString *errS
     if (!file.open(QIODevice::ReadOnly)) {
         if (!file.exists()) {
 #ifndef PROEVALUATOR_FULL
-            m_files[id] = m_magicMissing;
+            markFile(id, false);
 #endif
             *errStr = fL1S("No such file or directory");
             return ReadNotFound;
@@ -193,47 +209,83 @@ QMakeVfs::ReadResult QMakeVfs::readFile(int id, QString *contents, QString *errS
         *errStr = file.errorString();
         return ReadOtherError;
     }
+
+    // Decode straight from the mapped file if possible.
+    QByteArray bcont;
+    QByteArrayView data;
+    const qint64 size = file.size();
+    if (const uchar *mapped = size > 0 ? file.map(0, size) : nullptr) {
+        data = QByteArrayView(mapped, size);
+    } else {
+        bcont = file.readAll();
+        data = bcont;
+    }
+    // UTF-8 BOM will cause subtle errors
+    const bool hasBom = data.startsWith("\xef\xbb\xbf");
+    if (!hasBom)
+        *contents = QString::fromLocal8Bit(data);
 #ifndef PROEVALUATOR_FULL
-    m_files[id] = m_magicExisting;
+    markFile(id, true);
+    if (!hasBom) {
+# ifdef PROEVALUATOR_THREAD_SAFE
+        QWriteLocker locker(&m_lock);
+# endif
+        m_contents.insert(id, *contents);
+    }
 #endif
-
-    QByteArray bcont = file.readAll();
-    if (bcont.startsWith("\xef\xbb\xbf")) {
-        // UTF-8 BOM will cause subtle errors
+    if (hasBom) {
         *errStr = fL1S("Unexpected UTF-8 BOM");
         return ReadOtherError;
     }
-    *contents = QString::fromLocal8Bit(bcont);
     return ReadOk;
 }
 
 bool QMakeVfs::exists(const QString &fn, VfsFlags flags)
 {
 #ifndef PROEVALUATOR_FULL
+    int id = idForFileName(fn, flags);
+    {
 # ifdef PROEVALUATOR_THREAD_SAFE
-    QMutexLocker locker(&m_mutex);
+        QReadLocker locker(&m_lock);
 # endif
-    int id = idForFileName(fn, flags);
-    auto it = m_files.constFind(id);
-    if (it != m_files.constEnd())
-        return it->constData() != m_magicMissing.constData();
+        auto it = m_files.constFind(id);
+        if (it != m_files.constEnd())
+            return it->constData() != m_magicMissing.constData();
+    }
 #else
     Q_UNUSED(flags);
 #endif
     bool ex = IoUtils::fileType(fn) == IoUtils::FileIsRegular;
 #ifndef PROEVALUATOR_FULL
-    m_files[id] = ex ? m_magicExisting : m_magicMissing;
+    markFile(id, ex);
 #endif
     return ex;
 }
 
+#ifndef PROEVALUATOR_FULL
+// Records whether the real file exists, unless it was written meanwhile.
+void QMakeVfs::markFile(int id, bool exists)
+{
+# ifdef PROEVALUATOR_THREAD_SAFE
+    QWriteLocker locker(&m_lock);
+# endif
+    auto it = m_files.find(id);
+    if (it == m_files.end())
+        m_files.insert(id, exists ? m_magicExisting : m_magicMissing);
+    else if (it->constData() == m_magicMissing.constData()
+             || it->constData() == m_magicExisting.constData())
+        *it = exists ? m_magicExisting : m_magicMissing;
+}
+#endif
+
 #ifndef PROEVALUATOR_FULL
 // This should be called when the sources may have changed (e.g., VCS update).
 void QMakeVfs::invalidateCache()
 {
 # ifdef PROEVALUATOR_THREAD_SAFE
-    QMutexLocker locker(&m_mutex);
+    QWriteLocker locker(&m_lock);
 # endif
+    m_contents.clear();
     auto it = m_files.begin(), eit = m_files.end();
     while (it != eit) {
         if (it->constData() == m_magicMissing.constData()
@@ -248,9 +300,10 @@ void QMakeVfs::invalidateCache()
 void QMakeVfs::invalidateContents()
 {
 # ifdef PROEVALUATOR_THREAD_SAFE
-    QMutexLocker locker(&m_mutex);
+    QWriteLocker locker(&m_lock);
 # endif
     m_files.clear();
+    m_contents.clear();
 }
 #endif
 
@@ -11,6 +11,7 @@
 #include <qstring.h>
 #ifdef PROEVALUATOR_THREAD_SAFE
 # include <qmutex.h>
+# include <qreadwritelock.h>
 #endif
 
 #ifdef PROEVALUATOR_DUAL_VFS
@@ -64,8 +65,12 @@ public:
 #endif
 
 private:
+#ifndef PROEVALUATOR_FULL
+    void markFile(int id, bool exists);
+#endif
+
 #ifdef PROEVALUATOR_THREAD_SAFE
-    static QMutex s_mutex;
+    static QReadWriteLock s_lock;
 #endif
     static int s_refCount;
     static QAtomicInt s_fileIdCounter;
@@ -77,7 +82,7 @@ private:
     static QHash<int, QString> s_idFileMap;
 #ifdef PROEVALUATOR_DUAL_VFS
 # ifdef PROEVALUATOR_THREAD_SAFE
-    // The simple way to avoid recursing m_mutex.
+    // The simple way to avoid recursing m_lock.
     QMutex m_vmutex;
 # endif
     // Virtual files are bound to the project context they were created in,
@@ -90,9 +95,11 @@ private:
 
 #ifndef PROEVALUATOR_FULL
 # ifdef PROEVALUATOR_THREAD_SAFE
-    QMutex m_mutex;
+    // Files are read and stat'ed without holding it.
+    QReadWriteLock m_lock;
 # endif
     QHash<int, QString> m_files;
+    QHash<int, QString> m_contents; // of the real files read so far
     QString m_magicMissing;
     QString m_magicExisting;
 #endif
@@ -2,17 +2,16 @@
 // SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
 
 #include "simtexth.h"
-#include "translator.h"
 
 #include <QtCore/QByteArray>
 #include <QtCore/QString>
 #include <QtCore/QList>
+#include <QtCore/qalgorithms.h>
+#include <QtCore/private/qsimd_p.h>
 
 
 QT_BEGIN_NAMESPACE
 
-typedef QList<TranslatorMessage> TML;
-
 /*
   How similar are two texts?  The approach used here relies on co-occurrence
   matrices and is very efficient.
@@ -71,29 +70,6 @@ static const int indexOf[256] = {
     15, 12, 16, 17, 18, 19, 2,  10, 15, 7,  19, 2,  6,  7,  10, 0
 };
 
-/*
-  The entry bitCount[i] (for i between 0 and 255) is the number of bits used to
-  represent i in binary.
-*/
-static const int bitCount[256] = {
-    0,  1,  1,  2,  1,  2,  2,  3,  1,  2,  2,  3,  2,  3,  3,  4,
-    1,  2,  2,  3,  2,  3,  3,  4,  2,  3,  3,  4,  3,  4,  4,  5,
-    1,  2,  2,  3,  2,  3,  3,  4,  2,  3,  3,  4,  3,  4,  4,  5,
-    2,  3,  3,  4,  3,  4,  4,  5,  3,  4,  4,  5,  4,  5,  5,  6,
-    1,  2,  2,  3,  2,  3,  3,  4,  2,  3,  3,  4,  3,  4,  4,  5,
-    2,  3,  3,  4,  3,  4,  4,  5,  3,  4,  4,  5,  4,  5,  5,  6,
-    2,  3,  3,  4,  3,  4,  4,  5,  3,  4,  4,  5,  4,  5,  5,  6,
-    3,  4,  4,  5,  4,  5,  5,  6,  4,  5,  5,  6,  5,  6,  6,  7,
-    1,  2,  2,  3,  2,  3,  3,  4,  2,  3,  3,  4,  3,  4,  4,  5,
-    2,  3,  3,  4,  3,  4,  4,  5,  3,  4,  4,  5,  4,  5,  5,  6,
-    2,  3,  3,  4,  3,  4,  4,  5,  3,  4,  4,  5,  4,  5,  5,  6,
-    3,  4,  4,  5,  4,  5,  5,  6,  4,  5,  5,  6,  5,  6,  6,  7,
-    2,  3,  3,  4,  3,  4,  4,  5,  3,  4,  4,  5,  4,  5,  5,  6,
-    3,  4,  4,  5,  4,  5,  5,  6,  4,  5,  5,  6,  5,  6,  6,  7,
-    3,  4,  4,  5,  4,  5,  5,  6,  4,  5,  5,  6,  5,  6,  6,  7,
-    4,  5,  5,  6,  5,  6,  6,  7,  5,  6,  6,  7,  6,  7,  7,  8
-};
-
 static inline void setCoOccurence(CoMatrix &m, char c, char d)
 {
     int k = indexOf[(uchar) c] + 20 * indexOf[(uchar) d];
@@ -119,84 +95,93 @@ CoMatrix::CoMatrix(const QString &str)
     }
 }
 
-static inline int worth(const CoMatrix &m)
+/*
+  The bits are counted a word at a time. qPopulationCount() maps to a single
+  instruction where the CPU has one.
+*/
+static Q_ALWAYS_INLINE int worth(const CoMatrix &m)
 {
     int w = 0;
-    for (int i = 0; i < 50; i++)
-        w += bitCount[m.b[i]];
+    for (int i = 0; i < 13; ++i)
+        w += qPopulationCount(m.w[i]);
     return w;
 }
 
-static inline CoMatrix reunion(const CoMatrix &m, const CoMatrix &n)
+static Q_ALWAYS_INLINE int score(const SimilarityFingerprint &m, const SimilarityFingerprint &n)
 {
-    CoMatrix p;
-    for (int i = 0; i < 13; ++i)
-        p.w[i] = m.w[i] | n.w[i];
-    return p;
+    // Count the bits of the intersection and of the union in one pass,
+    // without building the matrices.
+    int common = 0;
+    int all = 0;
+    for (int i = 0; i < 13; ++i) {
+        common += qPopulationCount(m.cm.w[i] & n.cm.w[i]);
+        all += qPopulationCount(m.cm.w[i] | n.cm.w[i]);
+    }
+    int delta = qAbs(m.length - n.length);
+    return ( (common + 1) << 10 ) / ( all + (delta << 1) + 1 );
 }
 
-static inline CoMatrix intersection(const CoMatrix &m, const CoMatrix &n)
+static void scoreBatch(const SimilarityFingerprint &query,
+                       const SimilarityFingerprint *const *candidates, qsizetype count,
+                       int *scores)
+{
+    for (qsizetype i = 0; i < count; ++i)
+        scores[i] = score(query, *candidates[i]);
+}
+
+#if defined(Q_PROCESSOR_X86) && !defined(__POPCNT__) && defined(QT_FUNCTION_TARGET_STRING_POPCNT)
+#  define SIMTEXTH_POPCNT_DISPATCH
+// The same, compiled for CPUs with the POPCNT instruction, which is not part
+// of the baseline instruction set.
+QT_FUNCTION_TARGET(POPCNT)
+static void scoreBatchPopcnt(const SimilarityFingerprint &query,
+                             const SimilarityFingerprint *const *candidates, qsizetype count,
+                             int *scores)
+{
+    for (qsizetype i = 0; i < count; ++i)
+        scores[i] = score(query, *candidates[i]);
+}
+#endif
+
+SimilarityFingerprint::SimilarityFingerprint(const QString &str)
+    : cm(str), length(str.length()), bits(worth(cm))
 {
-    CoMatrix p;
-    for (int i = 0; i < 13; ++i)
-        p.w[i] = m.w[i] & n.w[i];
-    return p;
 }
 
 StringSimilarityMatcher::StringSimilarityMatcher(const QString &stringToMatch)
-    : m_cm(stringToMatch)
+    : m_fp(stringToMatch)
 {
-    m_length = stringToMatch.length();
 }
 
 int StringSimilarityMatcher::getSimilarityScore(const QString &strCandidate)
 {
-    CoMatrix cmTarget(strCandidate);
-    int delta = qAbs(m_length - strCandidate.size());
-    int score = ( (worth(intersection(m_cm, cmTarget)) + 1) << 10 ) /
-        ( worth(reunion(m_cm, cmTarget)) + (delta << 1) + 1 );
-    return score;
+    return score(m_fp, SimilarityFingerprint(strCandidate));
 }
 
-CandidateList similarTextHeuristicCandidates(const Translator *tor,
-    const QString &text, int maxCandidates)
+int StringSimilarityMatcher::getSimilarityScore(const SimilarityFingerprint &candidate) const
 {
-    QList<int> scores;
-    CandidateList candidates;
-    StringSimilarityMatcher matcher(text);
-
-    for (const TranslatorMessage &mtm : tor->messages()) {
-        if (mtm.type() == TranslatorMessage::Unfinished
-            || mtm.translation().isEmpty())
-            continue;
-
-        QString s = mtm.sourceText();
-        int score = matcher.getSimilarityScore(s);
-
-        if (candidates.size() == maxCandidates && score > scores[maxCandidates - 1] )
-            candidates.removeLast();
-
-        if (candidates.size() < maxCandidates && score >= textSimilarityThreshold) {
-            Candidate cand(mtm.context(), s, mtm.comment(), mtm.translation());
-
-            int i;
-            for (i = 0; i < candidates.size(); i++) {
-                if (score >= scores.at(i)) {
-                    if (score == scores.at(i)) {
-                        if (candidates.at(i) == cand)
-                            goto continue_outer_loop;
-                    } else {
-                        break;
-                    }
-                }
-            }
-            scores.insert(i, score);
-            candidates.insert(i, cand);
-        }
-        continue_outer_loop:
-        ;
+    return score(m_fp, candidate);
+}
+
+void StringSimilarityMatcher::getSimilarityScores(const SimilarityFingerprint *const *candidates,
+                                                  qsizetype count, int *scores) const
+{
+#ifdef SIMTEXTH_POPCNT_DISPATCH
+    if (qCpuHasFeature(POPCNT)) {
+        scoreBatchPopcnt(m_fp, candidates, count, scores);
+        return;
     }
-    return candidates;
+#endif
+    scoreBatch(m_fp, candidates, count, scores);
+}
+
+int StringSimilarityMatcher::maxSimilarityScore(const SimilarityFingerprint &candidate) const
+{
+    // The intersection has at most as many bits as the smaller matrix,
+    // the union at least as many as the larger one.
+    int delta = qAbs(m_fp.length - candidate.length);
+    return ( (qMin(m_fp.bits, candidate.bits) + 1) << 10 ) /
+        ( qMax(m_fp.bits, candidate.bits) + (delta << 1) + 1 );
 }
 
 QT_END_NAMESPACE
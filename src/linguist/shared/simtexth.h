@@ -11,8 +11,6 @@ const int textSimilarityThreshold = 190;
 
 QT_BEGIN_NAMESPACE
 
-class Translator;
-
 struct Candidate
 {
     Candidate() {}
@@ -51,6 +49,21 @@ struct CoMatrix
     };
 };
 
+/**
+ * The data of a candidate string that is needed to score it: its CoMatrix,
+ * its length and the number of bits set in the matrix. Computing it once
+ * per candidate avoids the UTF-8 conversion on every comparison.
+ */
+struct SimilarityFingerprint
+{
+    SimilarityFingerprint(const QString &str);
+    SimilarityFingerprint() {}
+
+    CoMatrix cm;
+    int length = 0;
+    int bits = 0;
+};
+
 /**
  * This class is more efficient for searching through a large array of candidate strings, since we only
  * have to construct the CoMatrix for the \a stringToMatch once,
@@ -61,10 +74,20 @@ class StringSimilarityMatcher {
 public:
     StringSimilarityMatcher(const QString &stringToMatch);
     int getSimilarityScore(const QString &strCandidate);
+    int getSimilarityScore(const SimilarityFingerprint &candidate) const;
+    // Scores \a count candidates at once, using the POPCNT instruction if the CPU has it.
+    void getSimilarityScores(const SimilarityFingerprint *const *candidates, qsizetype count,
+                             int *scores) const;
+    const SimilarityFingerprint &fingerprint() const { return m_fp; }
+
+    /**
+     * Returns an upper bound of getSimilarityScore(\a candidate) that is
+     * computed from the lengths and bit counts only.
+     */
+    int maxSimilarityScore(const SimilarityFingerprint &candidate) const;
 
 private:
-    CoMatrix m_cm;
-    int m_length;
+    SimilarityFingerprint m_fp;
 };
 
 /**
@@ -79,10 +102,6 @@ static inline int getSimilarityScore(const QString &str1, const QString &str2)
     return StringSimilarityMatcher(str1).getSimilarityScore(str2);
 }
 
-CandidateList similarTextHeuristicCandidates( const Translator *tor,
-                                              const QString &text,
-                                              int maxCandidates );
-
 QT_END_NAMESPACE
 
 #endif
@@ -0,0 +1,131 @@
+// Copyright (C) 2023 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
+
+#include "trace.h"
+
+#include <QtCore/qcoreapplication.h>
+#include <QtCore/qelapsedtimer.h>
+#include <QtCore/qjsonarray.h>
+#include <QtCore/qjsondocument.h>
+#include <QtCore/qjsonobject.h>
+#include <QtCore/qmutex.h>
+
+#include <atomic>
+#include <vector>
+
+QT_BEGIN_NAMESPACE
+
+using namespace Qt::StringLiterals;
+
+namespace {
+
+struct TraceEvent
+{
+    const char *category;
+    const char *name;
+    QString fileName;
+    qint64 start; // in microseconds
+    qint64 duration;
+    int thread;
+};
+
+struct TraceData
+{
+    QElapsedTimer timer;
+    QMutex mutex;
+    std::vector<TraceEvent> events;
+    std::atomic<int> threadCount = 0;
+};
+
+} // unnamed namespace
+
+static std::atomic<bool> traceEnabled = false;
+
+static TraceData &traceData()
+{
+    static TraceData data;
+    return data;
+}
+
+// The threads are numbered in the order of their first span, the one that
+// started the session being 0.
+static int traceThread()
+{
+    static thread_local int thread = traceData().threadCount++;
+    return thread;
+}
+
+bool TraceSession::start(const QString &fileName, QString *errorString)
+{
+    m_file.setFileName(fileName);
+    if (!m_file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        *errorString = m_file.errorString();
+        return false;
+    }
+    traceThread();
+    traceData().timer.start();
+    traceEnabled = true;
+    return true;
+}
+
+TraceSession::~TraceSession()
+{
+    if (!m_file.isOpen())
+        return;
+    traceEnabled = false;
+
+    TraceData &data = traceData();
+    QMutexLocker locker(&data.mutex);
+    const qint64 pid = QCoreApplication::applicationPid();
+    QJsonArray events;
+    for (int thread = 0; thread < data.threadCount; ++thread) {
+        events.append(QJsonObject {
+            { "name"_L1, "thread_name"_L1 },
+            { "ph"_L1, "M"_L1 },
+            { "pid"_L1, pid },
+            { "tid"_L1, thread },
+            { "args"_L1, QJsonObject {
+                  { "name"_L1, thread ? u"worker %1"_s.arg(thread) : u"main"_s } } }
+        });
+    }
+    for (const TraceEvent &event : data.events) {
+        QJsonObject object {
+            { "name"_L1, QLatin1StringView(event.name) },
+            { "cat"_L1, QLatin1StringView(event.category) },
+            { "ph"_L1, "X"_L1 },
+            { "ts"_L1, event.start },
+            { "dur"_L1, event.duration },
+            { "pid"_L1, pid },
+            { "tid"_L1, event.thread }
+        };
+        if (!event.fileName.isEmpty())
+            object.insert("args"_L1, QJsonObject { { "file"_L1, event.fileName } });
+        events.append(object);
+    }
+    data.events.clear();
+
+    m_file.write(QJsonDocument(QJsonObject { { "traceEvents"_L1, events } }).toJson());
+    m_file.close();
+}
+
+TraceSpan::TraceSpan(const char *category, const char *name, const QString &fileName)
+    : m_category(category), m_name(name)
+{
+    if (!traceEnabled.load(std::memory_order_relaxed))
+        return;
+    m_fileName = fileName;
+    m_start = traceData().timer.nsecsElapsed() / 1000;
+}
+
+TraceSpan::~TraceSpan()
+{
+    if (m_start < 0 || !traceEnabled.load(std::memory_order_relaxed))
+        return;
+    TraceData &data = traceData();
+    const qint64 end = data.timer.nsecsElapsed() / 1000;
+    const int thread = traceThread();
+    QMutexLocker locker(&data.mutex);
+    data.events.push_back({ m_category, m_name, m_fileName, m_start, end - m_start, thread });
+}
+
+QT_END_NAMESPACE
@@ -0,0 +1,53 @@
+// Copyright (C) 2023 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
+
+#ifndef TRACE_H
+#define TRACE_H
+
+#include <QtCore/qfile.h>
+#include <QtCore/qstring.h>
+
+QT_BEGIN_NAMESPACE
+
+/*
+    Records the spans of the linguist tools into a Chrome trace event file
+    (see chrome://tracing or https://ui.perfetto.dev). The events are written
+    when the session is destroyed, typically at the end of main().
+*/
+class TraceSession
+{
+public:
+    TraceSession() = default;
+    ~TraceSession();
+
+    bool start(const QString &fileName, QString *errorString);
+
+private:
+    Q_DISABLE_COPY_MOVE(TraceSession)
+
+    QFile m_file;
+};
+
+/*
+    Records the time from its construction to its destruction as a complete
+    event of \a category, if a session is running. \a name and \a category
+    must be string literals.
+*/
+class TraceSpan
+{
+public:
+    TraceSpan(const char *category, const char *name, const QString &fileName = QString());
+    ~TraceSpan();
+
+private:
+    Q_DISABLE_COPY_MOVE(TraceSpan)
+
+    const char *m_category;
+    const char *m_name;
+    QString m_fileName;
+    qint64 m_start = -1;
+};
+
+QT_END_NAMESPACE
+
+#endif // TRACE_H
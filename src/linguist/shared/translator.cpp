@@ -4,6 +4,7 @@
 #include "translator.h"
 
 #include "simtexth.h"
+#include "trace.h"
 
 #include <iostream>
 
@@ -28,6 +29,8 @@ QT_BEGIN_NAMESPACE
 
 Translator::Translator() :
     m_locationsType(AbsoluteLocations),
+    m_recording(false),
+    m_extrasRecorded(false),
     m_indexOk(true)
 {
 }
@@ -85,6 +88,26 @@ void Translator::ensureIndexed() const
     }
 }
 
+QString StringPool::intern(const QString &str)
+{
+    if (str.isEmpty())
+        return str;
+    if (str != m_last) {
+        auto it = m_strings.constFind(str);
+        if (it == m_strings.cend())
+            it = m_strings.insert(str);
+        m_last = *it;
+    }
+    return m_last;
+}
+
+QString StringPool::intern(QStringView str)
+{
+    if (!str.isEmpty() && str == m_last)
+        return m_last;
+    return intern(str.toString());
+}
+
 void Translator::replaceSorted(const TranslatorMessage &msg)
 {
     int index = find(msg);
@@ -93,6 +116,7 @@ void Translator::replaceSorted(const TranslatorMessage &msg)
     } else {
         delIndex(index);
         m_messages[index] = msg;
+        internStrings(m_messages[index]);
         addIndex(index, msg);
     }
 }
@@ -112,6 +136,11 @@ static QString makeMsgId(const TranslatorMessage &msg)
 
 void Translator::extend(const TranslatorMessage &msg, ConversionData &cd)
 {
+    if (m_recording) {
+        m_recordedCalls.append({ msg, true });
+        return;
+    }
+
     int index = find(msg);
     if (index == -1) {
         append(msg);
@@ -161,13 +190,37 @@ void Translator::insert(int idx, const TranslatorMessage &msg)
             m_indexOk = false;
     }
     m_messages.insert(idx, msg);
+    internStrings(m_messages[idx]);
+}
+
+void Translator::internStrings(TranslatorMessage &msg)
+{
+    msg.setContext(m_strings.intern(msg.context()));
+    msg.setFileName(m_strings.intern(msg.fileName()));
 }
 
 void Translator::append(const TranslatorMessage &msg)
 {
+    if (m_recording) {
+        m_recordedCalls.append({ msg, false });
+        return;
+    }
+
     insert(m_messages.count(), msg);
 }
 
+void Translator::replay(Translator &target, ConversionData &cd) const
+{
+    for (const RecordedCall &call : m_recordedCalls) {
+        if (call.extend)
+            target.extend(call.message, cd);
+        else
+            target.append(call.message);
+    }
+    if (m_extrasRecorded)
+        target.setExtras(m_extra);
+}
+
 void Translator::appendSorted(const TranslatorMessage &msg)
 {
     int msgLine = msg.lineNumber();
@@ -227,7 +280,7 @@ void Translator::appendSorted(const TranslatorMessage &msg)
         append(msg);
 }
 
-static QString guessFormat(const QString &filename, const QString &format)
+QString Translator::guessFormat(const QString &filename, const QString &format)
 {
     if (format != QLatin1String("auto"))
         return format;
@@ -244,6 +297,7 @@ static QString guessFormat(const QString &filename, const QString &format)
 
 bool Translator::load(const QString &filename, ConversionData &cd, const QString &format)
 {
+    TraceSpan span("io", "Translator::load", filename);
     cd.m_sourceDir = QFileInfo(filename).absoluteDir();
     cd.m_sourceFileName = filename;
 
@@ -287,6 +341,7 @@ bool Translator::load(const QString &filename, ConversionData &cd, const QString
 
 bool Translator::save(const QString &filename, ConversionData &cd, const QString &format) const
 {
+    TraceSpan span("io", "Translator::save", filename);
     QFile file;
     if (filename.isEmpty() || filename == QLatin1String("-")) {
 #ifdef Q_OS_WIN
@@ -307,13 +362,23 @@ bool Translator::save(const QString &filename, ConversionData &cd, const QString
         }
     }
 
+    return save(file, filename, cd, format);
+}
+
+/*
+    Saves to \a dev as if it was the file \a filename, which determines the
+    format if \a format is "auto" and the base of relative locations.
+*/
+bool Translator::save(QIODevice &dev, const QString &filename, ConversionData &cd,
+                      const QString &format) const
+{
     QString fmt = guessFormat(filename, format);
     cd.m_targetDir = QFileInfo(filename).absoluteDir();
 
     for (const FileFormat &format : qAsConst(registeredFileFormats())) {
         if (fmt == format.extension) {
             if (format.saver)
-                return (*format.saver)(*this, file, cd);
+                return (*format.saver)(*this, dev, cd);
             cd.appendError(QString(QLatin1String("Cannot save %1 files")).arg(fmt));
             return false;
         }
@@ -393,32 +458,30 @@ int Translator::find(const QString &context) const
 
 void Translator::stripObsoleteMessages()
 {
-    for (auto it = m_messages.begin(); it != m_messages.end(); )
-        if (it->type() == TranslatorMessage::Obsolete || it->type() == TranslatorMessage::Vanished)
-            it = m_messages.erase(it);
-        else
-            ++it;
-    m_indexOk = false;
+    if (m_messages.removeIf([](const TranslatorMessage &msg) {
+            return msg.type() == TranslatorMessage::Obsolete
+                    || msg.type() == TranslatorMessage::Vanished;
+        })) {
+        m_indexOk = false;
+    }
 }
 
 void Translator::stripFinishedMessages()
 {
-    for (auto it = m_messages.begin(); it != m_messages.end(); )
-        if (it->type() == TranslatorMessage::Finished)
-            it = m_messages.erase(it);
-        else
-            ++it;
-    m_indexOk = false;
+    if (m_messages.removeIf([](const TranslatorMessage &msg) {
+            return msg.type() == TranslatorMessage::Finished;
+        })) {
+        m_indexOk = false;
+    }
 }
 
 void Translator::stripUntranslatedMessages()
 {
-    for (auto it = m_messages.begin(); it != m_messages.end(); )
-        if (!it->isTranslated())
-            it = m_messages.erase(it);
-        else
-            ++it;
-    m_indexOk = false;
+    if (m_messages.removeIf([](const TranslatorMessage &msg) {
+            return !msg.isTranslated();
+        })) {
+        m_indexOk = false;
+    }
 }
 
 bool Translator::translationsExist() const
@@ -432,34 +495,30 @@ bool Translator::translationsExist() const
 
 void Translator::stripEmptyContexts()
 {
-    for (auto it = m_messages.begin(); it != m_messages.end(); )
-        if (it->sourceText() == QLatin1String(ContextComment))
-            it = m_messages.erase(it);
-        else
-            ++it;
-    m_indexOk = false;
+    if (m_messages.removeIf([](const TranslatorMessage &msg) {
+            return msg.sourceText() == QLatin1String(ContextComment);
+        })) {
+        m_indexOk = false;
+    }
 }
 
 void Translator::stripNonPluralForms()
 {
-    for (auto it = m_messages.begin(); it != m_messages.end(); )
-        if (!it->isPlural())
-            it = m_messages.erase(it);
-        else
-            ++it;
-    m_indexOk = false;
+    if (m_messages.removeIf([](const TranslatorMessage &msg) {
+            return !msg.isPlural();
+        })) {
+        m_indexOk = false;
+    }
 }
 
 void Translator::stripIdenticalSourceTranslations()
 {
-    for (auto it = m_messages.begin(); it != m_messages.end(); ) {
-        // we need to have just one translation, and it be equal to the source
-        if (it->translations().count() == 1 && it->translation() == it->sourceText())
-            it = m_messages.erase(it);
-        else
-            ++it;
+    if (m_messages.removeIf([](const TranslatorMessage &msg) {
+            // we need to have just one translation, and it be equal to the source
+            return msg.translations().count() == 1 && msg.translation() == msg.sourceText();
+        })) {
+        m_indexOk = false;
     }
-    m_indexOk = false;
 }
 
 void Translator::dropTranslations()
@@ -553,12 +612,20 @@ inline bool operator==(TranslatorMessageContentPtr tmp1, TranslatorMessageConten
     return tmp1->comment() == tmp2->comment();
 }
 
+/*
+    Removes the duplicate messages and returns the indexes of the messages
+    they duplicate. The kept messages are compacted in place in a single
+    pass, so the indexes are the ones after the removal, and the message
+    index is rebuilt only once afterwards.
+*/
 Translator::Duplicates Translator::resolveDuplicates()
 {
     Duplicates dups;
     QSet<TranslatorMessageIdPtr> idRefs;
     QSet<TranslatorMessageContentPtr> contentRefs;
-    for (int i = 0; i < m_messages.count();) {
+    contentRefs.reserve(m_messages.count());
+    int kept = 0;
+    for (int i = 0; i < m_messages.count(); ++i) {
         const TranslatorMessage &msg = m_messages.at(i);
         TranslatorMessage *omsg;
         int oi;
@@ -588,43 +655,53 @@ Translator::Duplicates Translator::resolveDuplicates()
                 // This is really a content dupe, but with two distinct IDs.
             }
         }
-        if (!msg.id().isEmpty())
-            idRefs.insert(TranslatorMessageIdPtr(this, i));
-        contentRefs.insert(TranslatorMessageContentPtr(this, i));
-        ++i;
+        if (kept != i)
+            m_messages[kept] = std::move(m_messages[i]);
+        if (!m_messages.at(kept).id().isEmpty())
+            idRefs.insert(TranslatorMessageIdPtr(this, kept));
+        contentRefs.insert(TranslatorMessageContentPtr(this, kept));
+        ++kept;
         continue;
       gotDupe:
         pDup->insert(oi);
         if (!omsg->isTranslated() && msg.isTranslated())
             omsg->setTranslations(msg.translations());
+    }
+    if (kept != m_messages.count()) {
+        m_messages.resize(kept);
         m_indexOk = false;
-        m_messages.removeAt(i);
     }
     return dups;
 }
 
 void Translator::reportDuplicates(const Duplicates &dupes,
                                   const QString &fileName, bool verbose)
+{
+    reportDuplicates(dupes, fileName, verbose, std::cerr);
+}
+
+void Translator::reportDuplicates(const Duplicates &dupes,
+                                  const QString &fileName, bool verbose, std::ostream &out)
 {
     if (!dupes.byId.isEmpty() || !dupes.byContents.isEmpty()) {
-        std::cerr << "Warning: dropping duplicate messages in '" << qPrintable(fileName);
+        out << "Warning: dropping duplicate messages in '" << qPrintable(fileName);
         if (!verbose) {
-            std::cerr << "'\n(try -verbose for more info).\n";
+            out << "'\n(try -verbose for more info).\n";
         } else {
-            std::cerr << "':\n";
+            out << "':\n";
             for (int i : dupes.byId)
-                std::cerr << "\n* ID: " << qPrintable(message(i).id()) << std::endl;
+                out << "\n* ID: " << qPrintable(message(i).id()) << std::endl;
             for (int j : dupes.byContents) {
                 const TranslatorMessage &msg = message(j);
-                std::cerr << "\n* Context: " << qPrintable(msg.context())
-                          << "\n* Source: " << qPrintable(msg.sourceText()) << std::endl;
+                out << "\n* Context: " << qPrintable(msg.context())
+                    << "\n* Source: " << qPrintable(msg.sourceText()) << std::endl;
                 if (!msg.comment().isEmpty())
-                    std::cerr << "* Comment: " << qPrintable(msg.comment()) << std::endl;
+                    out << "* Comment: " << qPrintable(msg.comment()) << std::endl;
                 const int tsLine = msg.tsLineNumber();
                 if (tsLine >= 0)
-                    std::cerr << "* Line in .ts File: " << msg.tsLineNumber() << std::endl;
+                    out << "* Line in .ts File: " << msg.tsLineNumber() << std::endl;
             }
-            std::cerr << std::endl;
+            out << std::endl;
         }
     }
 }
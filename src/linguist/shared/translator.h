@@ -14,6 +14,8 @@
 #include <QString>
 #include <QSet>
 
+#include <iosfwd>
+
 
 QT_BEGIN_NAMESPACE
 
@@ -23,6 +25,19 @@ class FMT {
 
 class QIODevice;
 
+// Makes equal strings share their data. Contexts, file names and extra keys
+// repeat across many messages, interning them keeps one copy of each.
+class StringPool
+{
+public:
+    QString intern(const QString &str);
+    QString intern(QStringView str);
+
+private:
+    QSet<QString> m_strings;
+    QString m_last; // consecutive messages mostly share their strings
+};
+
 // A struct of "interesting" data passed to and from the load and save routines
 class ConversionData
 {
@@ -33,7 +48,8 @@ public:
         m_sortContexts(false),
         m_noUiLines(false),
         m_idBased(false),
-        m_saveMode(SaveEverything)
+        m_saveMode(SaveEverything),
+        m_maxThreadCount(0)
     {}
 
     // tag manipulation
@@ -56,6 +72,9 @@ public:
     QString m_sourceFileName;
     QString m_targetFileName;
     QString m_compilationDatabaseDir;
+    QString m_clangParseCacheDir;
+    QString m_cppIncludeCacheDir;
+    QString m_clangPrefixHeader;
     QStringList m_excludes;
     QDir m_sourceDir;
     QDir m_targetDir; // FIXME: TS specific
@@ -71,6 +90,7 @@ public:
     bool m_idBased;
     TranslatorSaveMode m_saveMode;
     QStringList m_rootDirs;
+    int m_maxThreadCount; // 0 means one thread per core
 };
 
 class TMMKey {
@@ -94,6 +114,8 @@ public:
 
     bool load(const QString &filename, ConversionData &err, const QString &format /* = "auto" */);
     bool save(const QString &filename, ConversionData &err, const QString &format /* = "auto" */) const;
+    bool save(QIODevice &dev, const QString &filename, ConversionData &err,
+              const QString &format /* = "auto" */) const;
 
     int find(const TranslatorMessage &msg) const;
     int find(const QString &context,
@@ -106,6 +128,17 @@ public:
     void append(const TranslatorMessage &msg);
     void appendSorted(const TranslatorMessage &msg);
 
+    // While recording, extend() and append() only log the message.
+    // replay() performs the logged calls on another translator, in order.
+    struct RecordedCall {
+        TranslatorMessage message;
+        bool extend;
+    };
+    void setRecording(bool recording) { m_recording = recording; }
+    const QList<RecordedCall> &recordedCalls() const { return m_recordedCalls; }
+    bool hasRecordedExtras() const { return m_extrasRecorded; }
+    void replay(Translator &target, ConversionData &cd) const;
+
     void stripObsoleteMessages();
     void stripFinishedMessages();
     void stripUntranslatedMessages();
@@ -120,6 +153,8 @@ public:
     struct Duplicates { QSet<int> byId, byContents; };
     Duplicates resolveDuplicates();
     void reportDuplicates(const Duplicates &dupes, const QString &fileName, bool verbose);
+    void reportDuplicates(const Duplicates &dupes, const QString &fileName, bool verbose,
+                          std::ostream &out);
 
     QString languageCode() const { return m_language; }
     QString sourceLanguageCode() const { return m_sourceLanguage; }
@@ -134,6 +169,7 @@ public:
     void setLanguageCode(const QString &languageCode) { m_language = languageCode; }
     void setSourceLanguageCode(const QString &languageCode) { m_sourceLanguage = languageCode; }
     static QString guessLanguageCodeFromFileName(const QString &fileName);
+    static QString guessFormat(const QString &filename, const QString &format);
     const QList<TranslatorMessage> &messages() const;
     static QStringList normalizedTranslations(const TranslatorMessage &m, int numPlurals);
     void normalizeTranslations(ConversionData &cd);
@@ -156,7 +192,7 @@ public:
     void setExtra(const QString &ba, const QString &var);
     bool hasExtra(const QString &ba) const;
     const ExtraData &extras() const { return m_extra; }
-    void setExtras(const ExtraData &extras) { m_extra = extras; }
+    void setExtras(const ExtraData &extras) { m_extra = extras; m_extrasRecorded = m_recording; }
 
     // registration of file formats
     typedef bool (*SaveFunction)(const Translator &, QIODevice &out, ConversionData &data);
@@ -182,6 +218,7 @@ public:
 
 private:
     void insert(int idx, const TranslatorMessage &msg);
+    void internStrings(TranslatorMessage &msg);
     void addIndex(int idx, const TranslatorMessage &msg) const;
     void delIndex(int idx) const;
     void ensureIndexed() const;
@@ -205,6 +242,12 @@ private:
     QStringList m_dependencies;
     ExtraData m_extra;
 
+    bool m_recording;
+    bool m_extrasRecorded;
+    QList<RecordedCall> m_recordedCalls;
+
+    StringPool m_strings;
+
     mutable bool m_indexOk;
     mutable QHash<QString, int> m_ctxCmtIdx;
     mutable QHash<QString, int> m_idMsgIdx;
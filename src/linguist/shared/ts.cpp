@@ -2,15 +2,16 @@
 // SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
 
 #include "translator.h"
+#include "tsstream.h"
 
 #include <QtCore/QByteArray>
 #include <QtCore/QDebug>
 #include <QtCore/QRegularExpression>
-#include <QtCore/QTextStream>
 
 #include <QtCore/QXmlStreamReader>
 
 #include <algorithm>
+#include <numeric>
 
 #define STRINGIFY_INTERNAL(x) #x
 #define STRINGIFY(x) STRINGIFY_INTERNAL(x)
@@ -34,6 +35,9 @@ public:
     // the "real thing"
     bool read(Translator &translator);
 
+    // Passes the messages to \a sink instead of appending them to the translator.
+    void setMessageSink(const TSMessageSink &sink) { m_sink = sink; }
+
 private:
     bool elementStarts(const QString &str) const
     {
@@ -53,6 +57,8 @@ private:
     void handleError();
 
     ConversionData &m_cd;
+    TSMessageSink m_sink;
+    StringPool m_strings;
 };
 
 void TSReader::handleError()
@@ -286,7 +292,10 @@ bool TSReader::read(Translator &translator)
                                 if (isEndElement()) {
                                     // </message> found, finish local loop
                                     msg.setReferences(refs);
-                                    translator.append(msg);
+                                    if (m_sink)
+                                        m_sink(msg);
+                                    else
+                                        translator.append(msg);
                                     break;
                                 } else if (isWhiteSpace()) {
                                     // ignore these, just whitespace
@@ -309,7 +318,7 @@ bool TSReader::read(Translator &translator)
                                     // <location/>
                                     maybeAbsolute = true;
                                     QXmlStreamAttributes atts = attributes();
-                                    QString fileName = atts.value(strfilename).toString();
+                                    QString fileName = m_strings.intern(atts.value(strfilename));
                                     if (fileName.isEmpty()) {
                                         fileName = currentMsgFile;
                                         maybeRelative = true;
@@ -372,8 +381,8 @@ bool TSReader::read(Translator &translator)
                                 } else if (isStartElement()
                                         && name().toString().startsWith(strextrans)) {
                                     // <extra-...>
-                                    QString tag = name().toString();
-                                    msg.setExtra(tag.mid(6), readContents());
+                                    const QString tag = m_strings.intern(name().mid(6));
+                                    msg.setExtra(tag, readContents());
                                     // </extra-...>
                                 } else {
                                     handleError();
@@ -406,51 +415,135 @@ bool TSReader::read(Translator &translator)
     return true;
 }
 
-static QString numericEntity(int ch)
+// Whether \a ch cannot be written to TS files as it is
+static inline bool needsEscaping(char16_t ch)
+{
+    switch (ch) {
+    case '\"':
+    case '&':
+    case '>':
+    case '<':
+    case '\'':
+        return true;
+    case '\n':
+    case '\t':
+        return false;
+    default:
+        return ch < 0x20 || (ch > 0x7f && QChar::isSpace(ch));
+    }
+}
+
+static const char *entity(char16_t ch)
+{
+    switch (ch) {
+    case '\"':
+        return "&quot;";
+    case '&':
+        return "&amp;";
+    case '>':
+        return "&gt;";
+    case '<':
+        return "&lt;";
+    case '\'':
+        return "&apos;";
+    default:
+        return nullptr;
+    }
+}
+
+static QByteArray numericEntity(int ch)
 {
-    return QString(ch <= 0x20 ? QLatin1String("<byte value=\"x%1\"/>")
-        : QLatin1String("&#x%1;")) .arg(ch, 0, 16);
+    return (ch <= 0x20 ? "<byte value=\"x" : "&#x") + QByteArray::number(ch, 16)
+        + (ch <= 0x20 ? "\"/>" : ";");
 }
 
 static QString protect(const QString &str)
 {
     QString result;
     result.reserve(str.length() * 12 / 10);
-    for (int i = 0; i != str.size(); ++i) {
-        const QChar ch = str[i];
-        uint c = ch.unicode();
-        switch (c) {
-        case '\"':
-            result += QLatin1String("&quot;");
-            break;
-        case '&':
-            result += QLatin1String("&amp;");
-            break;
-        case '>':
-            result += QLatin1String("&gt;");
-            break;
-        case '<':
-            result += QLatin1String("&lt;");
-            break;
-        case '\'':
-            result += QLatin1String("&apos;");
-            break;
-        default:
-            if ((c < 0x20 || (ch > QChar(0x7f) && ch.isSpace())) && c != '\n' && c != '\t')
-                result += numericEntity(c);
-            else // this also covers surrogates
-                result += QChar(c);
-        }
+    for (const QChar ch : str) {
+        const char16_t c = ch.unicode();
+        if (!needsEscaping(c)) // this also covers surrogates
+            result += ch;
+        else if (const char *e = entity(c))
+            result += QLatin1String(e);
+        else
+            result += QLatin1String(numericEntity(c));
     }
     return result;
 }
 
-static void writeExtras(QTextStream &t, const char *indent,
-                        const TranslatorMessage::ExtraData &extras, QRegularExpression drops)
+// The buffer is passed to the device when it gets this large.
+static const qsizetype StreamChunkSize = 256 * 1024;
+
+TSStreamWriter::Stream::Stream(QIODevice &dev)
+    : m_device(dev),
+      m_encoder(QStringEncoder::Utf8)
+{
+    m_buffer.reserve(StreamChunkSize + 4096);
+}
+
+TSStreamWriter::Stream &TSStreamWriter::Stream::operator<<(const char *str)
+{
+    m_buffer.append(str);
+    if (m_buffer.size() >= StreamChunkSize)
+        flush();
+    return *this;
+}
+
+TSStreamWriter::Stream &TSStreamWriter::Stream::operator<<(QStringView str)
+{
+    append(str);
+    if (m_buffer.size() >= StreamChunkSize)
+        flush();
+    return *this;
+}
+
+// Writes the runs of characters that need no escaping in one go.
+TSStreamWriter::Stream &TSStreamWriter::Stream::operator<<(Escaped str)
+{
+    const QStringView text = str.text;
+    qsizetype start = 0;
+    for (qsizetype i = 0; i != text.size(); ++i) {
+        const char16_t c = text[i].unicode();
+        if (!needsEscaping(c))
+            continue;
+        append(text.sliced(start, i - start));
+        if (const char *e = entity(c))
+            m_buffer.append(e);
+        else
+            m_buffer.append(numericEntity(c));
+        start = i + 1;
+    }
+    append(text.sliced(start));
+    if (m_buffer.size() >= StreamChunkSize)
+        flush();
+    return *this;
+}
+
+void TSStreamWriter::Stream::append(QStringView str)
+{
+    if (str.isEmpty())
+        return;
+    const qsizetype size = m_buffer.size();
+    m_buffer.resize(size + m_encoder.requiredSpace(str.size()));
+    char *end = m_encoder.appendToBuffer(m_buffer.data() + size, str);
+    m_buffer.truncate(end - m_buffer.constData());
+}
+
+void TSStreamWriter::Stream::flush()
+{
+    if (m_buffer.isEmpty())
+        return;
+    m_device.write(m_buffer);
+    m_buffer.truncate(0);
+}
+
+void TSStreamWriter::writeExtras(const char *indent, const TranslatorMessage::ExtraData &extras)
 {
     QStringList outs;
     for (auto it = extras.cbegin(), end = extras.cend(); it != end; ++it) {
-        if (!drops.match(it.key()).hasMatch()) {
+        if (!m_drops.match(it.key()).hasMatch()) {
             outs << (QStringLiteral("<extra-") + it.key() + QLatin1Char('>')
                      + protect(it.value())
                      + QStringLiteral("</extra-") + it.key() + QLatin1Char('>'));
@@ -458,19 +551,19 @@ static void writeExtras(QTextStream &t, const char *indent,
     }
     outs.sort();
     for (const QString &out : qAsConst(outs))
-        t << indent << out << Qt::endl;
+        m_stream << indent << out << "\n";
 }
 
-static void writeVariants(QTextStream &t, const char *indent, const QString &input)
+void TSStreamWriter::writeVariants(const char *indent, const QString &input)
 {
-    int offset;
+    qsizetype offset;
     if ((offset = input.indexOf(QChar(Translator::BinaryVariantSeparator))) >= 0) {
-        t << " variants=\"yes\">";
-        int start = 0;
+        m_stream << " variants=\"yes\">";
+        qsizetype start = 0;
         forever {
-            t << "\n    " << indent << "<lengthvariant>"
-              << protect(input.mid(start, offset - start))
-              << "</lengthvariant>";
+            m_stream << "\n    " << indent << "<lengthvariant>"
+                     << escaped(QStringView(input).sliced(start, offset - start))
+                     << "</lengthvariant>";
             if (offset == input.length())
                 break;
             start = offset + 1;
@@ -478,169 +571,252 @@ static void writeVariants(QTextStream &t, const char *indent, const QString &inp
             if (offset < 0)
                 offset = input.length();
         }
-        t << "\n" << indent;
+        m_stream << "\n" << indent;
     } else {
-        t << ">" << protect(input);
+        m_stream << ">" << escaped(input);
     }
 }
 
-bool saveTS(const Translator &translator, QIODevice &dev, ConversionData &cd)
+// Obsolete messages without translation are not written.
+static bool isNoise(const TranslatorMessage &msg)
+{
+    return (msg.type() == TranslatorMessage::Obsolete
+            || msg.type() == TranslatorMessage::Vanished)
+        && msg.translation().isEmpty();
+}
+
+TSStreamWriter::TSStreamWriter(QIODevice &dev, const ConversionData &cd)
+    : m_stream(dev),
+      m_drops(QRegularExpression::anchoredPattern(cd.dropTags().join(QLatin1Char('|')))),
+      m_targetDir(cd.m_targetDir),
+      m_locationsType(Translator::AbsoluteLocations)
 {
-    bool result = true;
-    QTextStream t(&dev);
+}
+
+void TSStreamWriter::writeHeader(const Translator &translator)
+{
+    m_locationsType = translator.locationsType();
 
     // The xml prolog allows processors to easily detect the correct encoding
-    t << "<?xml version=\"1.0\" encoding=\"utf-8\"?>\n<!DOCTYPE TS>\n";
+    m_stream << "<?xml version=\"1.0\" encoding=\"utf-8\"?>\n<!DOCTYPE TS>\n";
 
-    t << "<TS version=\"2.1\"";
+    m_stream << "<TS version=\"2.1\"";
 
     QString languageCode = translator.languageCode();
     if (!languageCode.isEmpty() && languageCode != QLatin1String("C"))
-        t << " language=\"" << languageCode << "\"";
+        m_stream << " language=\"" << languageCode << "\"";
     languageCode = translator.sourceLanguageCode();
     if (!languageCode.isEmpty() && languageCode != QLatin1String("C"))
-        t << " sourcelanguage=\"" << languageCode << "\"";
-    t << ">\n";
+        m_stream << " sourcelanguage=\"" << languageCode << "\"";
+    m_stream << ">\n";
 
     const QStringList deps = translator.dependencies();
     if (!deps.isEmpty()) {
-        t << "<dependencies>\n";
+        m_stream << "<dependencies>\n";
         for (const QString &dep : deps)
-            t << "<dependency catalog=\"" << dep << "\"/>\n";
-        t << "</dependencies>\n";
+            m_stream << "<dependency catalog=\"" << dep << "\"/>\n";
+        m_stream << "</dependencies>\n";
     }
 
-    QRegularExpression drops(QRegularExpression::anchoredPattern(cd.dropTags().join(QLatin1Char('|'))));
-
-    writeExtras(t, "    ", translator.extras(), drops);
-
-    QHash<QString, QList<TranslatorMessage> > messageOrder;
-    QList<QString> contextOrder;
-    for (const TranslatorMessage &msg : translator.messages()) {
-        // no need for such noise
-        if ((msg.type() == TranslatorMessage::Obsolete || msg.type() == TranslatorMessage::Vanished)
-            && msg.translation().isEmpty()) {
-            continue;
-        }
+    writeExtras("    ", translator.extras());
+}
 
-        QList<TranslatorMessage> &context = messageOrder[msg.context()];
-        if (context.isEmpty())
-            contextOrder.append(msg.context());
-        context.append(msg);
+/*
+    Returns the index in m_sourceFiles of the file \a fileName. Its path
+    relative to the target directory is only computed the first time. Names
+    that lead to the same path share an entry, like they share the line
+    counter of relative locations.
+*/
+int TSStreamWriter::sourceFileId(const QString &fileName)
+{
+    const auto it = m_sourceFileIds.constFind(fileName);
+    if (it != m_sourceFileIds.cend())
+        return *it;
+
+    const QString path = m_targetDir.relativeFilePath(fileName)
+            .replace(QLatin1Char('\\'), QLatin1Char('/'));
+    int id = m_sourcePathIds.value(path, -1);
+    if (id < 0) {
+        id = int(m_sourceFiles.size());
+        m_sourceFiles.append({ path, 0 });
+        m_sourcePathIds.insert(path, id);
     }
-    if (cd.sortContexts())
-        std::sort(contextOrder.begin(), contextOrder.end());
-
-    QHash<QString, int> currentLine;
-    QString currentFile;
-    for (const QString &context : qAsConst(contextOrder)) {
-        t << "<context>\n"
-             "    <name>"
-          << protect(context)
-          << "</name>\n";
-        for (const TranslatorMessage &msg : qAsConst(messageOrder[context])) {
-            //msg.dump();
-
-                t << "    <message";
-                if (!msg.id().isEmpty())
-                    t << " id=\"" << msg.id() << "\"";
-                if (msg.isPlural())
-                    t << " numerus=\"yes\"";
-                t << ">\n";
-                if (translator.locationsType() != Translator::NoLocations) {
-                    QString cfile = currentFile;
-                    bool first = true;
-                    for (const TranslatorMessage::Reference &ref : msg.allReferences()) {
-                        QString fn = cd.m_targetDir.relativeFilePath(ref.fileName())
-                                    .replace(QLatin1Char('\\'),QLatin1Char('/'));
-                        int ln = ref.lineNumber();
-                        QString ld;
-                        if (translator.locationsType() == Translator::RelativeLocations) {
-                            if (ln != -1) {
-                                int dlt = ln - currentLine[fn];
-                                if (dlt >= 0)
-                                    ld.append(QLatin1Char('+'));
-                                ld.append(QString::number(dlt));
-                                currentLine[fn] = ln;
-                            }
+    m_sourceFileIds.insert(fileName, id);
+    return id;
+}
 
-                            if (fn != cfile) {
-                                if (first)
-                                    currentFile = fn;
-                                cfile = fn;
-                            } else {
-                                fn.clear();
-                            }
-                            first = false;
-                        } else {
-                            if (ln != -1)
-                                ld = QString::number(ln);
-                        }
-                        t << "        <location";
-                        if (!fn.isEmpty())
-                            t << " filename=\"" << fn << "\"";
-                        if (!ld.isEmpty())
-                            t << " line=\"" << ld << "\"";
-                        t << "/>\n";
-                    }
-                }
+void TSStreamWriter::writeContext(const QString &context,
+                                  const QList<TranslatorMessage> &messages)
+{
+    QList<const TranslatorMessage *> msgs;
+    msgs.reserve(messages.size());
+    for (const TranslatorMessage &msg : messages)
+        msgs.append(&msg);
+    writeContext(context, msgs);
+}
 
-                t << "        <source>"
-                  << protect(msg.sourceText())
-                  << "</source>\n";
+void TSStreamWriter::writeContext(const QString &context,
+                                  const QList<const TranslatorMessage *> &messages)
+{
+    if (std::all_of(messages.cbegin(), messages.cend(),
+                    [](const TranslatorMessage *msg) { return isNoise(*msg); })) {
+        return;
+    }
 
-                if (!msg.oldSourceText().isEmpty())
-                    t << "        <oldsource>" << protect(msg.oldSourceText()) << "</oldsource>\n";
+    m_stream << "<context>\n"
+                "    <name>"
+             << escaped(context)
+             << "</name>\n";
+    for (const TranslatorMessage *msg : messages) {
+        if (!isNoise(*msg))
+            writeMessage(*msg);
+    }
+    m_stream << "</context>\n";
+}
 
-                if (!msg.comment().isEmpty()) {
-                    t << "        <comment>"
-                      << protect(msg.comment())
-                      << "</comment>\n";
+void TSStreamWriter::writeMessage(const TranslatorMessage &msg)
+{
+    m_stream << "    <message";
+    if (!msg.id().isEmpty())
+        m_stream << " id=\"" << msg.id() << "\"";
+    if (msg.isPlural())
+        m_stream << " numerus=\"yes\"";
+    m_stream << ">\n";
+    if (m_locationsType != Translator::NoLocations) {
+        int cfile = m_currentFile;
+        bool first = true;
+        for (const TranslatorMessage::Reference &ref : msg.allReferences()) {
+            const int id = sourceFileId(ref.fileName());
+            SourceFile &file = m_sourceFiles[id];
+            bool writeFileName = true;
+            int ln = ref.lineNumber();
+            QString ld;
+            if (m_locationsType == Translator::RelativeLocations) {
+                if (ln != -1) {
+                    int dlt = ln - file.currentLine;
+                    if (dlt >= 0)
+                        ld.append(QLatin1Char('+'));
+                    ld.append(QString::number(dlt));
+                    file.currentLine = ln;
                 }
 
-                    if (!msg.oldComment().isEmpty())
-                        t << "        <oldcomment>" << protect(msg.oldComment()) << "</oldcomment>\n";
-
-                    if (!msg.extraComment().isEmpty())
-                        t << "        <extracomment>" << protect(msg.extraComment())
-                          << "</extracomment>\n";
-
-                    if (!msg.translatorComment().isEmpty())
-                        t << "        <translatorcomment>" << protect(msg.translatorComment())
-                          << "</translatorcomment>\n";
-
-                t << "        <translation";
-                if (msg.type() == TranslatorMessage::Unfinished)
-                    t << " type=\"unfinished\"";
-                else if (msg.type() == TranslatorMessage::Vanished)
-                    t << " type=\"vanished\"";
-                else if (msg.type() == TranslatorMessage::Obsolete)
-                    t << " type=\"obsolete\"";
-                if (msg.isPlural()) {
-                    t << ">";
-                    const QStringList &translns = msg.translations();
-                    for (int j = 0; j < translns.count(); ++j) {
-                        t << "\n            <numerusform";
-                        writeVariants(t, "            ", translns[j]);
-                        t << "</numerusform>";
-                    }
-                    t << "\n        ";
+                if (id != cfile) {
+                    if (first)
+                        m_currentFile = id;
+                    cfile = id;
                 } else {
-                    writeVariants(t, "        ", msg.translation());
+                    writeFileName = false;
                 }
-                t << "</translation>\n";
+                first = false;
+            } else {
+                if (ln != -1)
+                    ld = QString::number(ln);
+            }
+            m_stream << "        <location";
+            if (writeFileName && !file.path.isEmpty())
+                m_stream << " filename=\"" << file.path << "\"";
+            if (!ld.isEmpty())
+                m_stream << " line=\"" << ld << "\"";
+            m_stream << "/>\n";
+        }
+    }
 
-                writeExtras(t, "        ", msg.extras(), drops);
+    m_stream << "        <source>"
+             << escaped(msg.sourceText())
+             << "</source>\n";
 
-                if (!msg.userData().isEmpty())
-                    t << "        <userdata>" << msg.userData() << "</userdata>\n";
-                t << "    </message>\n";
+    if (!msg.oldSourceText().isEmpty())
+        m_stream << "        <oldsource>" << escaped(msg.oldSourceText()) << "</oldsource>\n";
+
+    if (!msg.comment().isEmpty()) {
+        m_stream << "        <comment>"
+                 << escaped(msg.comment())
+                 << "</comment>\n";
+    }
+
+    if (!msg.oldComment().isEmpty())
+        m_stream << "        <oldcomment>" << escaped(msg.oldComment()) << "</oldcomment>\n";
+
+    if (!msg.extraComment().isEmpty())
+        m_stream << "        <extracomment>" << escaped(msg.extraComment())
+                 << "</extracomment>\n";
+
+    if (!msg.translatorComment().isEmpty())
+        m_stream << "        <translatorcomment>" << escaped(msg.translatorComment())
+                 << "</translatorcomment>\n";
+
+    m_stream << "        <translation";
+    if (msg.type() == TranslatorMessage::Unfinished)
+        m_stream << " type=\"unfinished\"";
+    else if (msg.type() == TranslatorMessage::Vanished)
+        m_stream << " type=\"vanished\"";
+    else if (msg.type() == TranslatorMessage::Obsolete)
+        m_stream << " type=\"obsolete\"";
+    if (msg.isPlural()) {
+        m_stream << ">";
+        const QStringList &translns = msg.translations();
+        for (int j = 0; j < translns.count(); ++j) {
+            m_stream << "\n            <numerusform";
+            writeVariants("            ", translns[j]);
+            m_stream << "</numerusform>";
         }
-        t << "</context>\n";
+        m_stream << "\n        ";
+    } else {
+        writeVariants("        ", msg.translation());
     }
+    m_stream << "</translation>\n";
 
-    t << "</TS>\n";
-    return result;
+    writeExtras("        ", msg.extras());
+
+    if (!msg.userData().isEmpty())
+        m_stream << "        <userdata>" << msg.userData() << "</userdata>\n";
+    m_stream << "    </message>\n";
+}
+
+void TSStreamWriter::writeFooter()
+{
+    m_stream << "</TS>\n";
+    m_stream.flush();
+}
+
+bool saveTS(const Translator &translator, QIODevice &dev, ConversionData &cd)
+{
+    // Group the messages by context without copying them
+    QHash<QString, int> contextIds;
+    QStringList contexts;
+    QList<QList<const TranslatorMessage *>> contextMessages;
+    for (const TranslatorMessage &msg : translator.messages()) {
+        // no need for such noise
+        if (isNoise(msg))
+            continue;
+
+        const auto it = contextIds.constFind(msg.context());
+        int id;
+        if (it == contextIds.cend()) {
+            id = int(contexts.size());
+            contextIds.insert(msg.context(), id);
+            contexts.append(msg.context());
+            contextMessages.append({});
+        } else {
+            id = *it;
+        }
+        contextMessages[id].append(&msg);
+    }
+
+    QList<int> contextOrder(contexts.size());
+    std::iota(contextOrder.begin(), contextOrder.end(), 0);
+    if (cd.sortContexts()) {
+        std::sort(contextOrder.begin(), contextOrder.end(), [&contexts](int a, int b) {
+            return contexts.at(a) < contexts.at(b);
+        });
+    }
+
+    TSStreamWriter writer(dev, cd);
+    writer.writeHeader(translator);
+    for (int id : qAsConst(contextOrder))
+        writer.writeContext(contexts.at(id), contextMessages.at(id));
+    writer.writeFooter();
+    return true;
 }
 
 bool loadTS(Translator &translator, QIODevice &dev, ConversionData &cd)
@@ -649,6 +825,110 @@ bool loadTS(Translator &translator, QIODevice &dev, ConversionData &cd)
     return reader.read(translator);
 }
 
+bool loadTS(Translator &header, QIODevice &dev, ConversionData &cd, const TSMessageSink &sink)
+{
+    TSReader reader(dev, cd);
+    reader.setMessageSink(sink);
+    return reader.read(header);
+}
+
+/*
+    Checks whether the TS file in \a dev can be converted message by message
+    with the same result as when it is loaded as a whole: every context name
+    must occur only once and precede the messages of its context, message
+    ids must not be shared between contexts, and extras and dependencies
+    must precede the first context. Also
+    determines the locations type TSReader would assign to the translator.
+*/
+bool scanTSForStreaming(QIODevice &dev, Translator::LocationsType *locationsType)
+{
+    STRING(context);
+    STRING(dependencies);
+    STRING(filename);
+    STRING(id);
+    STRING(line);
+    STRING(location);
+    STRING(message);
+    STRING(name);
+    STRING(TS);
+
+    QXmlStreamReader reader(&dev);
+    QSet<QString> contexts;
+    QHash<QString, int> idContexts; // id -> number of the context element
+    int contextNumber = 0;
+    int messageCount = 0;
+    bool seenContext = false;
+    bool seenName = false;
+    bool maybeRelative = false;
+    bool maybeAbsolute = false;
+    int depth = 0;
+
+    while (!reader.atEnd()) {
+        reader.readNext();
+        if (reader.isStartElement()) {
+            ++depth;
+            const QStringView name = reader.name();
+            if (depth == 1 && name != strTS)
+                return false;
+            if (depth == 2) {
+                if (name == strcontext) {
+                    seenContext = true;
+                    seenName = false;
+                    ++contextNumber;
+                } else if (seenContext
+                           && (name == strdependencies || name.startsWith(u"extra-"))) {
+                    return false;
+                }
+            } else if (depth == 3 && name == strname) {
+                const QString context = reader.readElementText();
+                --depth;
+                if (contexts.contains(context))
+                    return false;
+                contexts.insert(context);
+                seenName = true;
+            } else if (depth == 3 && name == strmessage) {
+                // The messages before the <name> would get an empty context.
+                if (!seenName)
+                    return false;
+                const QString id = reader.attributes().value(strid).toString();
+                if (!id.isEmpty()) {
+                    const auto it = idContexts.constFind(id);
+                    if (it != idContexts.cend() && *it != contextNumber)
+                        return false;
+                    idContexts.insert(id, contextNumber);
+                }
+            } else if (depth == 4 && name == strlocation) {
+                // Same logic as in TSReader::read()
+                maybeAbsolute = true;
+                const QXmlStreamAttributes atts = reader.attributes();
+                if (atts.value(strfilename).isEmpty())
+                    maybeRelative = true;
+                const QStringView lin = atts.value(strline);
+                bool ok = false;
+                lin.toInt(&ok);
+                if (ok && (lin.startsWith(u'+') || lin.startsWith(u'-')))
+                    maybeRelative = true;
+            }
+        } else if (reader.isEndElement()) {
+            --depth;
+            if (depth == 2 && reader.name() == strmessage)
+                ++messageCount;
+        }
+        // TSReader::read() checks this after every token directly inside <TS>.
+        if (depth == 1 && !(reader.isStartElement() && reader.name() == strTS)
+            && messageCount == 0) {
+            maybeAbsolute = true;
+        }
+    }
+    if (reader.hasError())
+        return false;
+
+    *locationsType = maybeRelative ? Translator::RelativeLocations
+                   : maybeAbsolute ? Translator::AbsoluteLocations
+                                   : Translator::NoLocations;
+    return true;
+}
+
 int initTS()
 {
     Translator::FileFormat format;
@@ -0,0 +1,92 @@
+// Copyright (C) 2023 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
+
+#ifndef TSSTREAM_H
+#define TSSTREAM_H
+
+#include "translator.h"
+
+#include <QtCore/QDir>
+#include <QtCore/QHash>
+#include <QtCore/QRegularExpression>
+#include <QtCore/QStringEncoder>
+
+#include <functional>
+
+QT_BEGIN_NAMESPACE
+
+/*
+    Message by message access to TS files, for conversions that do not need
+    the whole file in memory. saveTS() is implemented on top of the writer.
+*/
+
+using TSMessageSink = std::function<void(const TranslatorMessage &)>;
+
+// Reads the TS file in \a dev. The file level data ends up in \a header,
+// the messages are passed to \a sink in file order.
+bool loadTS(Translator &header, QIODevice &dev, ConversionData &cd, const TSMessageSink &sink);
+
+bool scanTSForStreaming(QIODevice &dev, Translator::LocationsType *locationsType);
+
+class TSStreamWriter
+{
+public:
+    TSStreamWriter(QIODevice &dev, const ConversionData &cd);
+
+    void writeHeader(const Translator &translator);
+    // Each context must be written only once.
+    void writeContext(const QString &context, const QList<TranslatorMessage> &messages);
+    void writeContext(const QString &context, const QList<const TranslatorMessage *> &messages);
+    void writeFooter();
+
+private:
+    // Text that gets XML escaped when written
+    struct Escaped {
+        QStringView text;
+    };
+    static Escaped escaped(QStringView text) { return { text }; }
+
+    // Buffered UTF-8 output to the device
+    class Stream
+    {
+    public:
+        explicit Stream(QIODevice &dev);
+        ~Stream() { flush(); }
+
+        Stream &operator<<(const char *str);
+        Stream &operator<<(QStringView str);
+        Stream &operator<<(Escaped str);
+        void flush();
+
+    private:
+        void append(QStringView str);
+
+        QIODevice &m_device;
+        QByteArray m_buffer;
+        QStringEncoder m_encoder;
+    };
+
+    void writeMessage(const TranslatorMessage &msg);
+    void writeExtras(const char *indent, const TranslatorMessage::ExtraData &extras);
+    void writeVariants(const char *indent, const QString &input);
+
+    // A file referenced by the locations written so far
+    struct SourceFile {
+        QString path; // relative to the target directory, as written
+        int currentLine = 0; // last line written, for relative locations
+    };
+    int sourceFileId(const QString &fileName);
+
+    Stream m_stream;
+    QRegularExpression m_drops;
+    QDir m_targetDir;
+    Translator::LocationsType m_locationsType;
+    QList<SourceFile> m_sourceFiles;
+    QHash<QString, int> m_sourceFileIds; // by the file name in the message
+    QHash<QString, int> m_sourcePathIds; // by the path written
+    int m_currentFile = -1;
+};
+
+QT_END_NAMESPACE
+
+#endif // TSSTREAM_H
@@ -339,6 +339,79 @@ static void writeMessage(QTextStream &ts, const TranslatorMessage &msg, const QR
     }
 }
 
+namespace {
+
+enum XliffNamespace {
+    XN_unknown,
+    XN_xliff, // 1.1 or 1.2
+    XN_trolltech
+};
+
+// The elements the reader handles, everything else is ignored.
+enum XliffElement {
+    XE_other,
+    XE_xliff,
+    XE_file,
+    XE_group,
+    XE_trans_unit,
+    XE_alt_trans,
+    XE_source,
+    XE_target,
+    XE_context_group,
+    XE_context,
+    XE_note,
+    XE_ph
+};
+
+} // namespace
+
+// Maps an element name to its token, checking the length first so that most
+// names are rejected or matched with a single comparison.
+static XliffElement elementToken(QStringView localName)
+{
+    switch (localName.size()) {
+    case 2:
+        if (localName == u"ph")
+            return XE_ph;
+        break;
+    case 4:
+        if (localName == u"file")
+            return XE_file;
+        if (localName == u"note")
+            return XE_note;
+        break;
+    case 5:
+        if (localName == u"xliff")
+            return XE_xliff;
+        if (localName == u"group")
+            return XE_group;
+        break;
+    case 6:
+        if (localName == u"source")
+            return XE_source;
+        if (localName == u"target")
+            return XE_target;
+        break;
+    case 7:
+        if (localName == u"context")
+            return XE_context;
+        break;
+    case 9:
+        if (localName == u"alt-trans")
+            return XE_alt_trans;
+        break;
+    case 10:
+        if (localName == u"trans-unit")
+            return XE_trans_unit;
+        break;
+    case 13:
+        if (localName == u"context-group")
+            return XE_context_group;
+        break;
+    }
+    return XE_other;
+}
+
 class XLIFFHandler : public XmlParser
 {
 public:
@@ -380,6 +453,7 @@ private:
     XliffContext currentContext() const;
     bool hasContext(XliffContext ctx) const;
     bool finalizeMessage(bool isPlural);
+    XliffNamespace namespaceToken(QStringView namespaceURI);
 
 private:
     Translator &m_translator;
@@ -404,12 +478,15 @@ private:
     QString m_extraFileName;
     TranslatorMessage::References m_refs;
     TranslatorMessage::ExtraData m_extra;
+    StringPool m_strings;
 
     QString accum;
     QString m_ctype;
     const QString m_URITT;  // convenience and efficiency
     const QString m_URI;  // ...
     const QString m_URI12;  // ...
+    QString m_lastURI; // the namespace of the previous element, mostly the same
+    XliffNamespace m_lastNamespace = XN_unknown;
     QStack<int> m_contextStack;
 };
 
@@ -458,20 +535,39 @@ bool XLIFFHandler::hasContext(XliffContext ctx) const
     return false;
 }
 
+XliffNamespace XLIFFHandler::namespaceToken(QStringView namespaceURI)
+{
+    if (namespaceURI != m_lastURI) {
+        m_lastURI = namespaceURI.toString();
+        if (m_lastURI == m_URITT)
+            m_lastNamespace = XN_trolltech;
+        else if (m_lastURI == m_URI || m_lastURI == m_URI12)
+            m_lastNamespace = XN_xliff;
+        else
+            m_lastNamespace = XN_unknown;
+    }
+    return m_lastNamespace;
+}
+
 bool XLIFFHandler::startElement(QStringView namespaceURI, QStringView localName,
                                 QStringView qName, const QXmlStreamAttributes &atts)
 {
     Q_UNUSED(qName);
-    if (namespaceURI == m_URITT)
+    switch (namespaceToken(namespaceURI)) {
+    case XN_trolltech:
         goto bail;
-    if (namespaceURI != m_URI && namespaceURI != m_URI12) {
+    case XN_unknown:
         return fatalError(reader.lineNumber(), reader.columnNumber(),
                           QLatin1String("Unknown namespace in the XLIFF file"));
+    case XN_xliff:
+        break;
     }
-    if (localName == QLatin1String("xliff")) {
+    switch (elementToken(localName)) {
+    case XE_xliff:
         // make sure that the stack is not empty during parsing
         pushContext(XC_xliff);
-    } else if (localName == QLatin1String("file")) {
+        break;
+    case XE_file:
         m_fileName = atts.value(QLatin1String("original")).toString();
         m_language = atts.value(QLatin1String("target-language")).toString();
         m_language.replace(QLatin1Char('-'), QLatin1Char('_'));
@@ -479,68 +575,85 @@ bool XLIFFHandler::startElement(QStringView namespaceURI, QStringView localName,
         m_sourceLanguage.replace(QLatin1Char('-'), QLatin1Char('_'));
         if (m_sourceLanguage == QLatin1String("en"))
             m_sourceLanguage.clear();
-    } else if (localName == QLatin1String("group")) {
-        if (atts.value(QLatin1String("restype")) == QLatin1String(restypeContext)) {
-            m_context = atts.value(QLatin1String("resname")).toString();
+        break;
+    case XE_group: {
+        const QStringView restype = atts.value(QLatin1String("restype"));
+        if (restype == QLatin1String(restypeContext)) {
+            m_context = m_strings.intern(atts.value(QLatin1String("resname")));
             pushContext(XC_restype_context);
+        } else if (restype == QLatin1String(restypePlurals)) {
+            pushContext(XC_restype_plurals);
+            m_id = atts.value(QLatin1String("id")).toString();
+            if (atts.value(QLatin1String("translate")) == QLatin1String("no"))
+                m_translate = false;
         } else {
-            if (atts.value(QLatin1String("restype")) == QLatin1String(restypePlurals)) {
-                pushContext(XC_restype_plurals);
-                m_id = atts.value(QLatin1String("id")).toString();
-                if (atts.value(QLatin1String("translate")) == QLatin1String("no"))
-                    m_translate = false;
-            } else {
-                pushContext(XC_group);
-            }
+            pushContext(XC_group);
         }
-    } else if (localName == QLatin1String("trans-unit")) {
+        break;
+    }
+    case XE_trans_unit:
         if (!hasContext(XC_restype_plurals) || m_sources.isEmpty() /* who knows ... */)
             if (atts.value(QLatin1String("translate")) == QLatin1String("no"))
                 m_translate = false;
         if (!hasContext(XC_restype_plurals)) {
-            m_id = atts.value(QLatin1String("id")).toString();
-            if (m_id.startsWith(QLatin1String("_msg")))
+            const QStringView id = atts.value(QLatin1String("id"));
+            if (id.startsWith(QLatin1String("_msg")))
                 m_id.clear();
+            else
+                m_id = id.toString();
         }
         if (atts.value(QLatin1String("approved")) != QLatin1String("yes"))
             m_approved = false;
         pushContext(XC_trans_unit);
         m_hadAlt = false;
-    } else if (localName == QLatin1String("alt-trans")) {
+        break;
+    case XE_alt_trans:
         pushContext(XC_alt_trans);
-    } else if (localName == QLatin1String("source")) {
+        break;
+    case XE_source:
         m_isPlural = atts.value(QLatin1String(attribPlural)) == QLatin1String("yes");
-    } else if (localName == QLatin1String("target")) {
+        break;
+    case XE_target:
         if (atts.value(QLatin1String("restype")) != QLatin1String(restypeDummy))
             pushContext(XC_restype_translation);
-    } else if (localName == QLatin1String("context-group")) {
+        break;
+    case XE_context_group:
         if (atts.value(QLatin1String("purpose")) == QLatin1String("location"))
             pushContext(XC_context_group);
         else
             pushContext(XC_context_group_any);
-    } else if (currentContext() == XC_context_group && localName == QLatin1String("context")) {
-        const auto ctxtype = atts.value(QLatin1String("context-type"));
-        if (ctxtype == QLatin1String("linenumber"))
-            pushContext(XC_context_linenumber);
-        else if (ctxtype == QLatin1String("sourcefile"))
-            pushContext(XC_context_filename);
-    } else if (currentContext() == XC_context_group_any && localName == QLatin1String("context")) {
-        const auto ctxtype = atts.value(QLatin1String("context-type"));
-        if (ctxtype == QLatin1String(contextMsgctxt))
-            pushContext(XC_context_comment);
-        else if (ctxtype == QLatin1String(contextOldMsgctxt))
-            pushContext(XC_context_old_comment);
-    } else if (localName == QLatin1String("note")) {
+        break;
+    case XE_context:
+        if (currentContext() == XC_context_group) {
+            const auto ctxtype = atts.value(QLatin1String("context-type"));
+            if (ctxtype == QLatin1String("linenumber"))
+                pushContext(XC_context_linenumber);
+            else if (ctxtype == QLatin1String("sourcefile"))
+                pushContext(XC_context_filename);
+        } else if (currentContext() == XC_context_group_any) {
+            const auto ctxtype = atts.value(QLatin1String("context-type"));
+            if (ctxtype == QLatin1String(contextMsgctxt))
+                pushContext(XC_context_comment);
+            else if (ctxtype == QLatin1String(contextOldMsgctxt))
+                pushContext(XC_context_old_comment);
+        }
+        break;
+    case XE_note:
         if (atts.value(QLatin1String("annotates")) == QLatin1String("source") &&
             atts.value(QLatin1String("from")) == QLatin1String("developer"))
             pushContext(XC_extra_comment);
         else
             pushContext(XC_translator_comment);
-    } else if (localName == QLatin1String("ph")) {
-        QString ctype = atts.value(QLatin1String("ctype")).toString();
+        break;
+    case XE_ph: {
+        const QStringView ctype = atts.value(QLatin1String("ctype"));
         if (ctype.startsWith(QLatin1String("x-ch-")))
-            m_ctype = ctype.mid(5);
+            m_ctype = ctype.mid(5).toString();
         pushContext(XC_ph);
+        break;
+    }
+    case XE_other:
+        break;
     }
 bail:
     if (currentContext() != XC_ph)
@@ -552,21 +665,25 @@ bool XLIFFHandler::endElement(QStringView namespaceURI, QStringView localName,
                               QStringView qName)
 {
     Q_UNUSED(qName);
-    if (namespaceURI == m_URITT) {
+    switch (namespaceToken(namespaceURI)) {
+    case XN_trolltech:
         if (hasContext(XC_trans_unit) || hasContext(XC_restype_plurals))
-            m_extra[localName.toString()] = accum;
+            m_extra[m_strings.intern(localName)] = accum;
         else
             m_translator.setExtra(localName.toString(), accum);
         return true;
-    }
-    if (namespaceURI != m_URI && namespaceURI != m_URI12) {
+    case XN_unknown:
         return fatalError(reader.lineNumber(), reader.columnNumber(),
                           QLatin1String("Unknown namespace in the XLIFF file"));
+    case XN_xliff:
+        break;
     }
     //qDebug() << "URI:" <<  namespaceURI << "QNAME:" << qName;
-    if (localName == QLatin1String("xliff")) {
+    switch (elementToken(localName)) {
+    case XE_xliff:
         popContext(XC_xliff);
-    } else if (localName == QLatin1String("source")) {
+        break;
+    case XE_source:
         if (hasContext(XC_alt_trans)) {
             if (m_isPlural && m_oldSources.isEmpty())
                 m_oldSources.append(QString());
@@ -575,22 +692,26 @@ bool XLIFFHandler::endElement(QStringView namespaceURI, QStringView localName,
         } else {
             m_sources.append(accum);
         }
-    } else if (localName == QLatin1String("target")) {
+        break;
+    case XE_target:
         if (popContext(XC_restype_translation)) {
             accum.replace(QChar(Translator::TextVariantSeparator),
                           QChar(Translator::BinaryVariantSeparator));
             m_translations.append(accum);
         }
-    } else if (localName == QLatin1String("context-group")) {
+        break;
+    case XE_context_group:
         if (popContext(XC_context_group)) {
             m_refs.append(TranslatorMessage::Reference(
-                m_extraFileName.isEmpty() ? m_fileName : m_extraFileName, m_lineNumber));
+                m_extraFileName.isEmpty() ? m_fileName : m_strings.intern(m_extraFileName),
+                m_lineNumber));
             m_extraFileName.clear();
             m_lineNumber = -1;
         } else {
             popContext(XC_context_group_any);
         }
-    } else if (localName == QLatin1String("context")) {
+        break;
+    case XE_context:
         if (popContext(XC_context_linenumber)) {
             bool ok;
             m_lineNumber = accum.trimmed().toInt(&ok);
@@ -603,15 +724,18 @@ bool XLIFFHandler::endElement(QStringView namespaceURI, QStringView localName,
         } else if (popContext(XC_context_old_comment)) {
             m_oldComment = accum;
         }
-    } else if (localName == QLatin1String("note")) {
+        break;
+    case XE_note:
         if (popContext(XC_extra_comment))
             m_extraComment = accum;
         else if (popContext(XC_translator_comment))
             m_translatorComment = accum;
-    } else if (localName == QLatin1String("ph")) {
+        break;
+    case XE_ph:
         m_ctype.clear();
         popContext(XC_ph);
-    } else if (localName == QLatin1String("trans-unit")) {
+        break;
+    case XE_trans_unit:
         popContext(XC_trans_unit);
         if (!m_hadAlt)
             m_oldSources.append(QString());
@@ -621,9 +745,11 @@ bool XLIFFHandler::endElement(QStringView namespaceURI, QStringView localName,
                                   QLatin1String("Element processing failed"));
             }
         }
-    } else if (localName == QLatin1String("alt-trans")) {
+        break;
+    case XE_alt_trans:
         popContext(XC_alt_trans);
-    } else if (localName == QLatin1String("group")) {
+        break;
+    case XE_group:
         if (popContext(XC_restype_plurals)) {
             if (!finalizeMessage(true)) {
                 return fatalError(reader.lineNumber(), reader.columnNumber(),
@@ -634,6 +760,10 @@ bool XLIFFHandler::endElement(QStringView namespaceURI, QStringView localName,
         } else {
             popContext(XC_group);
         }
+        break;
+    case XE_file:
+    case XE_other:
+        break;
     }
     return true;
 }
@@ -650,9 +780,13 @@ bool XLIFFHandler::characters(QStringView ch)
                 accum.append(chr);
         }
     } else {
-        QString t = ch.toString();
-        t.replace(QLatin1String("\r"), QLatin1String(""));
-        accum.append(t);
+        // drop carriage returns without a temporary copy of the text
+        qsizetype from = 0;
+        for (qsizetype cr = ch.indexOf(u'\r'); cr >= 0; cr = ch.indexOf(u'\r', from)) {
+            accum.append(ch.mid(from, cr - from));
+            from = cr + 1;
+        }
+        accum.append(ch.mid(from));
     }
     return true;
 }
@@ -685,12 +819,12 @@ bool XLIFFHandler::finalizeMessage(bool isPlural)
     msg.setExtraComment(m_extraComment);
     msg.setTranslatorComment(m_translatorComment);
     if (m_sources.count() > 1 && m_sources[1] != m_sources[0])
-        m_extra.insert(QLatin1String("po-msgid_plural"), m_sources[1]);
+        m_extra.insert(QStringLiteral("po-msgid_plural"), m_sources[1]);
     if (!m_oldSources.isEmpty()) {
         if (!m_oldSources[0].isEmpty())
             msg.setOldSourceText(m_oldSources[0]);
         if (m_oldSources.count() > 1 && m_oldSources[1] != m_oldSources[0])
-            m_extra.insert(QLatin1String("po-old_msgid_plural"), m_oldSources[1]);
+            m_extra.insert(QStringLiteral("po-old_msgid_plural"), m_oldSources[1]);
     }
     msg.setExtras(m_extra);
     m_translator.append(msg);
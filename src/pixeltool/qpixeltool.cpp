@@ -52,12 +52,13 @@ QPixelTool::QPixelTool(QWidget *parent)
     m_zoom = settings.value(QLatin1String("zoom"), 4).toInt();
     m_initialSize = settings.value(QLatin1String("initialSize"), QSize(250, 200)).toSize();
     m_lcdMode = settings.value(QLatin1String("lcdMode"), 0).toInt();
+    m_maxFrameRate = qMax(1, settings.value(QLatin1String("maxFrameRate"), 30).toInt());
 
     move(initialPos(settings, m_initialSize));
 
     setMouseTracking(true);
     setAttribute(Qt::WA_OpaquePaintEvent);
-    m_updateId = startTimer(30);
+    restartUpdateTimer();
 }
 
 QPixelTool::~QPixelTool()
@@ -70,6 +71,7 @@ QPixelTool::~QPixelTool()
     settings.setValue(QLatin1String("initialSize"), size());
     settings.setValue(QLatin1String("position"), pos());
     settings.setValue(QLatin1String("lcdMode"), m_lcdMode);
+    settings.setValue(QLatin1String("maxFrameRate"), m_maxFrameRate);
 }
 
 void QPixelTool::setPreviewImage(const QImage &image)
@@ -163,6 +165,32 @@ static QImage imageLCDFilter(const QImage &image, int lcdMode)
     return scaled;
 }
 
+/*
+    Returns the buffer scaled up to the zoom, in device pixels of the
+    widget, so that painting only copies it. It is built at most once per
+    grab instead of scaling the buffer in every paint event, which happen
+    on every mouse move.
+*/
+const QPixmap &QPixelTool::zoomedBuffer()
+{
+    if (m_zoomedBuffer.isNull() && !m_buffer.isNull()) {
+        const QImage image = m_lcdMode == 0 ? m_buffer : imageLCDFilter(m_buffer, m_lcdMode);
+        const qreal dpr = devicePixelRatio();
+        const QSizeF size = m_buffer.deviceIndependentSize() * m_zoom * dpr;
+        QImage zoomed = image.scaled(size.toSize(), Qt::IgnoreAspectRatio,
+                                     Qt::FastTransformation);
+        zoomed.setDevicePixelRatio(dpr);
+        m_zoomedBuffer = QPixmap::fromImage(std::move(zoomed));
+    }
+    return m_zoomedBuffer;
+}
+
+void QPixelTool::setBuffer(const QImage &buffer)
+{
+    m_buffer = buffer.convertToFormat(QImage::Format_ARGB32);
+    m_zoomedBuffer = QPixmap();
+}
+
 void QPixelTool::paintEvent(QPaintEvent *)
 {
     QPainter p(this);
@@ -181,18 +209,7 @@ void QPixelTool::paintEvent(QPaintEvent *)
     int w = width();
     int h = height();
 
-    p.save();
-    if (m_lcdMode == 0)  {
-        p.scale(m_zoom, m_zoom);
-        p.drawPixmap(0, 0, m_buffer);
-    } else {
-        if (m_lcdMode <= 2)
-            p.scale(m_zoom / 3.0, m_zoom);
-        else
-            p.scale(m_zoom, m_zoom / 3.0);
-        p.drawImage(0, 0, imageLCDFilter(m_buffer.toImage(), m_lcdMode));
-    }
-    p.restore();
+    p.drawPixmap(0, 0, zoomedBuffer());
 
     // Draw the grid on top.
     if (m_gridActive) {
@@ -281,6 +298,7 @@ void QPixelTool::keyPressEvent(QKeyEvent *e)
         break;
     case Qt::Key_A:
         m_autoUpdate = !m_autoUpdate;
+        restartUpdateTimer();
         break;
 #if QT_CONFIG(clipboard)
     case Qt::Key_C:
@@ -330,9 +348,8 @@ void QPixelTool::mouseMoveEvent(QMouseEvent *e)
     const int x = pos.x() / m_zoom;
     const int y = pos.y() / m_zoom;
 
-    QImage im = m_buffer.toImage().convertToFormat(QImage::Format_ARGB32);
-    if (x < im.width() && y < im.height() && x >= 0 && y >= 0) {
-        m_currentColor = im.pixel(x, y);
+    if (x < m_buffer.width() && y < m_buffer.height() && x >= 0 && y >= 0) {
+        m_currentColor = m_buffer.pixel(x, y);
         update();
     }
 }
@@ -420,6 +437,16 @@ void QPixelTool::contextMenuEvent(QContextMenuEvent *e)
                                          tmpFreeze, Qt::Key_Space);
     QAction *autoUpdate = addCheckableAction(menu, QLatin1String("Continuous update"),
                                              m_autoUpdate, Qt::Key_A);
+    QMenu *frameRateMenu = menu.addMenu(QLatin1String("Maximum frame rate"));
+    QActionGroup *frameRateGroup = new QActionGroup(&menu);
+    for (int frameRate : {60, 30, 15, 5, 1}) {
+        QAction *action = addCheckableAction(*frameRateMenu,
+                                             QString::number(frameRate) + QLatin1String(" fps"),
+                                             m_maxFrameRate == frameRate, QKeySequence(),
+                                             frameRateGroup);
+        connect(action, &QAction::triggered, this,
+                [this, frameRate] { setMaxFrameRate(frameRate); });
+    }
     menu.addSeparator();
 
     // Copy to clipboard / save
@@ -460,6 +487,8 @@ void QPixelTool::contextMenuEvent(QContextMenuEvent *e)
 
     m_autoUpdate = autoUpdate->isChecked();
     m_freeze = freeze->isChecked();
+    m_zoomedBuffer = QPixmap();
+    restartUpdateTimer();
 
     // LCD mode looks off unless zoom is dividable by 3
     if (m_lcdMode && m_zoom % 3)
@@ -488,7 +517,7 @@ void QPixelTool::grabScreen()
     if (m_preview_mode) {
         int w = qMin(width() / m_zoom + 1, m_preview_image.width());
         int h = qMin(height() / m_zoom + 1, m_preview_image.height());
-        m_buffer = QPixmap::fromImage(m_preview_image).copy(0, 0, w, h);
+        setBuffer(m_preview_image.copy(0, 0, w, h));
         update();
         return;
     }
@@ -512,11 +541,13 @@ void QPixelTool::grabScreen()
     int y = mousePos.y() - h/2;
 
     const QBrush darkBrush = palette().color(QPalette::Dark);
+    QImage buffer;
     if (QScreen *screen = this->screen()) {
-        m_buffer = screen->grabWindow(0, x, y, w, h);
+        buffer = screen->grabWindow(0, x, y, w, h).toImage()
+                .convertToFormat(QImage::Format_ARGB32);
     } else {
-        m_buffer = QPixmap(w, h);
-        m_buffer.fill(darkBrush.color());
+        buffer = QImage(w, h, QImage::Format_ARGB32);
+        buffer.fill(darkBrush.color());
     }
     QRegion geom(x, y, w, h);
     QRect screenRect;
@@ -526,17 +557,60 @@ void QPixelTool::grabScreen()
     geom -= screenRect;
     const auto rectsInRegion = geom.rectCount();
     if (rectsInRegion > 0) {
-        QPainter p(&m_buffer);
+        QPainter p(&buffer);
         p.translate(-x, -y);
         p.setPen(Qt::NoPen);
         p.setBrush(darkBrush);
         p.drawRects(geom.begin(), rectsInRegion);
     }
 
+    // Nothing changed under the cursor: skip the repaint, and grab less
+    // often until something does.
+    const bool unchanged = mousePos == m_lastMousePos && buffer == m_buffer
+            && buffer.devicePixelRatio() == m_buffer.devicePixelRatio();
+    m_lastMousePos = mousePos;
+    if (unchanged) {
+        m_idleGrabCount = qMin(m_idleGrabCount + 1, 3);
+        restartUpdateTimer();
+        return;
+    }
+    if (m_idleGrabCount > 0) {
+        m_idleGrabCount = 0;
+        restartUpdateTimer();
+    }
+
+    setBuffer(buffer);
     update();
 
-    m_currentColor = m_buffer.toImage().pixel(m_buffer.rect().center());
-    m_lastMousePos = mousePos;
+    m_currentColor = m_buffer.pixel(m_buffer.rect().center());
+}
+
+/*
+    Grabs at the maximum frame rate while the screen changes, and at down
+    to an eighth of it while the region under the cursor stays the same.
+    Without continuous update, the timer only polls the cursor position,
+    so it keeps the full rate to follow the mouse.
+*/
+void QPixelTool::restartUpdateTimer()
+{
+    int interval = 1000 / m_maxFrameRate;
+    if (m_autoUpdate)
+        interval <<= m_idleGrabCount;
+    if (interval == m_updateInterval)
+        return;
+    if (m_updateId)
+        killTimer(m_updateId);
+    m_updateInterval = interval;
+    m_updateId = startTimer(interval);
+}
+
+void QPixelTool::setMaxFrameRate(int frameRate)
+{
+    if (frameRate <= 0 || frameRate == m_maxFrameRate)
+        return;
+    m_maxFrameRate = frameRate;
+    m_idleGrabCount = 0;
+    restartUpdateTimer();
 }
 
 void QPixelTool::startZoomVisibleTimer()
@@ -593,6 +667,7 @@ void QPixelTool::setZoom(int zoom)
         QPoint pos = m_lastMousePos;
         m_lastMousePos = QPoint();
         m_zoom = zoom;
+        m_zoomedBuffer = QPixmap();
         grabScreen();
         m_lastMousePos = pos;
         m_dragStart = m_dragCurrent = QPoint();
@@ -619,7 +694,7 @@ void QPixelTool::setGridSize(int gridSize)
 #if QT_CONFIG(clipboard)
 void QPixelTool::copyToClipboard()
 {
-    QGuiApplication::clipboard()->setPixmap(m_buffer);
+    QGuiApplication::clipboard()->setImage(m_buffer);
 }
 
 void QPixelTool::copyColorToClipboard()
@@ -22,6 +22,7 @@ public:
 
 public slots:
     void setZoom(int zoom);
+    void setMaxFrameRate(int frameRate);
     void setGridSize(int gridSize);
     void toggleGrid();
     void toggleFreeze();
@@ -50,6 +51,9 @@ protected:
 
 private:
     void grabScreen();
+    void restartUpdateTimer();
+    void setBuffer(const QImage &buffer);
+    const QPixmap &zoomedBuffer();
     void startZoomVisibleTimer();
     void startGridSizeVisibleTimer();
     QString aboutText() const;
@@ -66,7 +70,10 @@ private:
     int m_gridSize;
     int m_lcdMode;
 
-    int m_updateId;
+    int m_maxFrameRate;
+    int m_updateId = 0;
+    int m_updateInterval = 0;
+    int m_idleGrabCount = 0; // grabs in a row that found the same pixels
     int m_displayZoomId = 0;
     int m_displayGridSizeId = 0;
 
@@ -75,7 +82,8 @@ private:
     QPoint m_lastMousePos;
     QPoint m_dragStart;
     QPoint m_dragCurrent;
-    QPixmap m_buffer;
+    QImage m_buffer; // ARGB32, so that pixels can be read directly
+    QPixmap m_zoomedBuffer; // m_buffer as displayed at the current zoom, built on demand
 
     QSize m_initialSize;
 
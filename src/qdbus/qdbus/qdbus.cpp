@@ -5,8 +5,11 @@
 #include <stdlib.h>
 
 #include <QtCore/QCoreApplication>
+#include <QtCore/QEventLoop>
+#include <QtCore/QHash>
 #include <QtCore/QRegularExpression>
 #include <QtCore/QStringList>
+#include <QtCore/QTextStream>
 #include <QtCore/qmetaobject.h>
 #include <QtXml/QDomDocument>
 #include <QtXml/QDomElement>
@@ -17,18 +20,23 @@
 #include <QtDBus/QDBusArgument>
 #include <QtDBus/QDBusMessage>
 #include <QtDBus/QDBusReply>
+#include <QtDBus/QDBusPendingCallWatcher>
 #include <private/qdbusutil_p.h>
 
+#include <functional>
+
 QT_BEGIN_NAMESPACE
 Q_DBUS_EXPORT extern bool qt_dbus_metaobject_skip_annotations;
 QT_END_NAMESPACE
 
 static QDBusConnection connection(QLatin1String(""));
 static bool printArgumentsLiterally = false;
+static int maxPendingCalls = 1;
 
 static void showUsage()
 {
-    printf("Usage: qdbus [--system] [--bus busaddress] [--literal] [servicename] [path] [method] [args]\n"
+    printf("Usage: qdbus [--system] [--bus busaddress] [--literal] [--parallel n] [servicename] [path] [method] [args]\n"
+           "       qdbus [--system] [--bus busaddress] [--literal] [--parallel n] --batch\n"
            "\n"
            "  servicename       the service to connect to (e.g., org.freedesktop.DBus)\n"
            "  path              the path to the object (e.g., /)\n"
@@ -42,6 +50,9 @@ static void showUsage()
            "  --system          connect to the system bus\n"
            "  --bus busaddress  connect to a custom bus\n"
            "  --literal         print replies literally\n"
+           "  --parallel n      keep up to n calls pending when listing services or object paths\n"
+           "  --batch           read commands from the standard input, one per line, and run\n"
+           "                    them over the same connection\n"
            );
 }
 
@@ -83,46 +94,164 @@ static void printArg(const QVariant &v)
     }
 }
 
-static void listObjects(const QString &service, const QString &path)
+// Sends D-Bus calls asynchronously, keeping at most a given number of them
+// pending, and hands each reply to the handler of its call.
+class CallQueue
 {
-    // make a low-level call, to avoid introspecting the Introspectable interface
-    QDBusMessage call = QDBusMessage::createMethodCall(service, path.isEmpty() ? QLatin1String("/") : path,
-                                                       QLatin1String("org.freedesktop.DBus.Introspectable"),
-                                                       QLatin1String("Introspect"));
-    QDBusReply<QString> xml = connection.call(call);
+public:
+    using Handler = std::function<void(const QDBusMessage &reply)>;
 
-    if (path.isEmpty()) {
-        // top-level
-        if (xml.isValid()) {
-            printf("/\n");
-        } else {
-            QDBusError err = xml.error();
-            if (err.type() == QDBusError::ServiceUnknown)
-                fprintf(stderr, "Service '%s' does not exist.\n", qPrintable(service));
-            else
-                printf("Error: %s\n%s\n", qPrintable(err.name()), qPrintable(err.message()));
-            exit(2);
+    explicit CallQueue(int maxPending) : maxPending(qMax(maxPending, 1)) {}
+
+    void enqueue(const QDBusMessage &call, Handler handler)
+    {
+        queue.append({ call, std::move(handler) });
+    }
+
+    // Returns when all calls, including the ones the handlers enqueued, are done
+    void run()
+    {
+        startCalls();
+        if (pending > 0)
+            loop.exec();
+    }
+
+private:
+    struct Call
+    {
+        QDBusMessage message;
+        Handler handler;
+    };
+
+    void startCalls()
+    {
+        while (pending < maxPending && !queue.isEmpty()) {
+            Call call = queue.takeFirst();
+            QDBusPendingCallWatcher *watcher =
+                    new QDBusPendingCallWatcher(connection.asyncCall(call.message));
+            ++pending;
+            QObject::connect(watcher, &QDBusPendingCallWatcher::finished, watcher,
+                             [this, handler = std::move(call.handler)](QDBusPendingCallWatcher *finished) {
+                --pending;
+                handler(finished->reply());
+                finished->deleteLater();
+                startCalls();
+                if (pending == 0)
+                    loop.quit();
+            });
         }
-    } else if (!xml.isValid()) {
-        // this is not the first object, just fail silently
-        return;
     }
 
+    QList<Call> queue;
+    QEventLoop loop;
+    int pending = 0;
+    const int maxPending;
+};
+
+static QDBusMessage introspectCall(const QString &service, const QString &path)
+{
+    // make a low-level call, to avoid introspecting the Introspectable interface
+    return QDBusMessage::createMethodCall(service, path.isEmpty() ? QLatin1String("/") : path,
+                                          QLatin1String("org.freedesktop.DBus.Introspectable"),
+                                          QLatin1String("Introspect"));
+}
+
+static QStringList childObjects(const QString &path, const QString &xml)
+{
+    QStringList result;
     QDomDocument doc;
     doc.setContent(xml);
     QDomElement node = doc.documentElement();
     QDomElement child = node.firstChildElement();
     while (!child.isNull()) {
-        if (child.tagName() == QLatin1String("node")) {
-            QString sub = path + QLatin1Char('/') + child.attribute(QLatin1String("name"));
-            printf("%s\n", qPrintable(sub));
-            listObjects(service, sub);
-        }
+        if (child.tagName() == QLatin1String("node"))
+            result += path + QLatin1Char('/') + child.attribute(QLatin1String("name"));
         child = child.nextSiblingElement();
     }
+    return result;
+}
+
+static int printIntrospectionError(const QString &service, const QDBusError &err)
+{
+    if (err.type() == QDBusError::ServiceUnknown)
+        fprintf(stderr, "Service '%s' does not exist.\n", qPrintable(service));
+    else
+        printf("Error: %s\n%s\n", qPrintable(err.name()), qPrintable(err.message()));
+    return 2;
 }
 
-static void listInterface(const QString &service, const QString &path, const QString &interface)
+static void printObjects(const QHash<QString, QStringList> &children, const QString &path)
+{
+    const QStringList subs = children.value(path);
+    for (const QString &sub : subs) {
+        printf("%s\n", qPrintable(sub));
+        printObjects(children, sub);
+    }
+}
+
+// Introspects the paths with several calls pending and prints them in the
+// same order as listObjects() once all are known.
+static int listObjectsInParallel(const QString &service)
+{
+    CallQueue queue(maxPendingCalls);
+    QHash<QString, QStringList> children;
+    QDBusError rootError;
+    bool rootValid = false;
+
+    std::function<void(const QString &)> introspect = [&](const QString &path) {
+        queue.enqueue(introspectCall(service, path), [&, path](const QDBusMessage &reply) {
+            const QDBusReply<QString> xml = reply;
+            if (path.isEmpty()) {
+                rootValid = xml.isValid();
+                if (!rootValid)
+                    rootError = xml.error();
+            }
+            if (!xml.isValid())
+                return; // not the first object, just fail silently
+
+            const QStringList subs = childObjects(path, xml.value());
+            children.insert(path, subs);
+            for (const QString &sub : subs)
+                introspect(sub);
+        });
+    };
+    introspect(QString());
+    queue.run();
+
+    if (!rootValid)
+        return printIntrospectionError(service, rootError);
+    printf("/\n");
+    printObjects(children, QString());
+    return 0;
+}
+
+static int listObjects(const QString &service, const QString &path)
+{
+    if (path.isEmpty() && maxPendingCalls > 1)
+        return listObjectsInParallel(service);
+
+    QDBusReply<QString> xml = connection.call(introspectCall(service, path));
+
+    if (path.isEmpty()) {
+        // top-level
+        if (xml.isValid())
+            printf("/\n");
+        else
+            return printIntrospectionError(service, xml.error());
+    } else if (!xml.isValid()) {
+        // this is not the first object, just fail silently
+        return 0;
+    }
+
+    const QStringList subs = childObjects(path, xml.value());
+    for (const QString &sub : subs) {
+        printf("%s\n", qPrintable(sub));
+        listObjects(service, sub);
+    }
+    return 0;
+}
+
+static bool listInterface(const QString &service, const QString &path, const QString &interface)
 {
     QDBusInterface iface(service, path, interface, connection);
     if (!iface.isValid()) {
@@ -130,7 +259,7 @@ static void listInterface(const QString &service, const QString &path, const QSt
         fprintf(stderr, "Interface '%s' not available in object %s at %s:\n%s (%s)\n",
                 qPrintable(interface), qPrintable(path), qPrintable(service),
                 qPrintable(err.name()), qPrintable(err.message()));
-        exit(1);
+        return false;
     }
     const QMetaObject *mo = iface.metaObject();
 
@@ -174,24 +303,15 @@ static void listInterface(const QString &service, const QString &path, const QSt
         }
         printf(")\n");
     }
+    return true;
 }
 
-static void listAllInterfaces(const QString &service, const QString &path)
+static int listAllInterfaces(const QString &service, const QString &path)
 {
-    // make a low-level call, to avoid introspecting the Introspectable interface
-    QDBusMessage call = QDBusMessage::createMethodCall(service, path.isEmpty() ? QLatin1String("/") : path,
-                                                       QLatin1String("org.freedesktop.DBus.Introspectable"),
-                                                       QLatin1String("Introspect"));
-    QDBusReply<QString> xml = connection.call(call);
+    QDBusReply<QString> xml = connection.call(introspectCall(service, path));
 
-    if (!xml.isValid()) {
-        QDBusError err = xml.error();
-        if (err.type() == QDBusError::ServiceUnknown)
-            fprintf(stderr, "Service '%s' does not exist.\n", qPrintable(service));
-        else
-            printf("Error: %s\n%s\n", qPrintable(err.name()), qPrintable(err.message()));
-        exit(2);
-    }
+    if (!xml.isValid())
+        return printIntrospectionError(service, xml.error());
 
     QDomDocument doc;
     doc.setContent(xml);
@@ -200,15 +320,17 @@ static void listAllInterfaces(const QString &service, const QString &path)
     while (!child.isNull()) {
         if (child.tagName() == QLatin1String("interface")) {
             QString ifaceName = child.attribute(QLatin1String("name"));
-            if (QDBusUtil::isValidInterfaceName(ifaceName))
-                listInterface(service, path, ifaceName);
-            else {
+            if (QDBusUtil::isValidInterfaceName(ifaceName)) {
+                if (!listInterface(service, path, ifaceName))
+                    return 1;
+            } else {
                 qWarning("Invalid D-BUS interface name '%s' found while parsing introspection",
                          qPrintable(ifaceName));
             }
         }
         child = child.nextSiblingElement();
     }
+    return 0;
 }
 
 static QStringList readList(QStringList &args)
@@ -398,12 +520,29 @@ static void printAllServices(QDBusConnectionInterface *bus)
     const QStringList services = bus->registeredServiceNames();
     QMap<QString, QStringList> servicesWithAliases;
 
-    for (const QString &serviceName : services) {
-        QDBusReply<QString> reply = bus->serviceOwner(serviceName);
-        QString owner = reply;
-        if (owner.isEmpty())
-            owner = serviceName;
-        servicesWithAliases[owner].append(serviceName);
+    if (maxPendingCalls > 1) {
+        CallQueue queue(maxPendingCalls);
+        for (const QString &serviceName : services) {
+            QDBusMessage call = QDBusMessage::createMethodCall(bus->service(), bus->path(),
+                                                               bus->interface(),
+                                                               QLatin1String("GetNameOwner"));
+            call << serviceName;
+            queue.enqueue(call, [&servicesWithAliases, serviceName](const QDBusMessage &reply) {
+                QString owner = QDBusReply<QString>(reply);
+                if (owner.isEmpty())
+                    owner = serviceName;
+                servicesWithAliases[owner].append(serviceName);
+            });
+        }
+        queue.run();
+    } else {
+        for (const QString &serviceName : services) {
+            QDBusReply<QString> reply = bus->serviceOwner(serviceName);
+            QString owner = reply;
+            if (owner.isEmpty())
+                owner = serviceName;
+            servicesWithAliases[owner].append(serviceName);
+        }
     }
 
     for (QMap<QString,QStringList>::const_iterator it = servicesWithAliases.constBegin();
@@ -414,6 +553,113 @@ static void printAllServices(QDBusConnectionInterface *bus)
     }
 }
 
+static int runCommand(QDBusConnectionInterface *bus, QStringList args)
+{
+    if (args.isEmpty()) {
+        printAllServices(bus);
+        return 0;
+    }
+
+    QString service = args.takeFirst();
+    if (!QDBusUtil::isValidBusName(service)) {
+        if (service.contains(QLatin1Char('*'))) {
+            if (globServices(bus, service))
+                return 0;
+        }
+        fprintf(stderr, "Service '%s' is not a valid name.\n", qPrintable(service));
+        return 1;
+    }
+
+    if (args.isEmpty())
+        return listObjects(service, QString());
+
+    QString path = args.takeFirst();
+    if (!QDBusUtil::isValidObjectPath(path)) {
+        fprintf(stderr, "Path '%s' is not a valid path name.\n", qPrintable(path));
+        return 1;
+    }
+    if (args.isEmpty())
+        return listAllInterfaces(service, path);
+
+    QString interface = args.takeFirst();
+    QString member;
+    int pos = interface.lastIndexOf(QLatin1Char('.'));
+    if (pos == -1) {
+        member = interface;
+        interface.clear();
+    } else {
+        member = interface.mid(pos + 1);
+        interface.truncate(pos);
+    }
+    if (!interface.isEmpty() && !QDBusUtil::isValidInterfaceName(interface)) {
+        fprintf(stderr, "Interface '%s' is not a valid interface name.\n", qPrintable(interface));
+        return 1;
+    }
+    if (!QDBusUtil::isValidMemberName(member)) {
+        fprintf(stderr, "Method name '%s' is not a valid member name.\n", qPrintable(member));
+        return 1;
+    }
+
+    return placeCall(service, path, interface, member, args);
+}
+
+// Splits a line of the batch input into arguments. Arguments are separated
+// by white space, quotes group them and a backslash escapes a character.
+static QStringList splitCommand(const QString &line)
+{
+    QStringList args;
+    QString arg;
+    bool inArg = false;
+    QChar quote;
+    for (qsizetype i = 0; i < line.size(); ++i) {
+        const QChar c = line.at(i);
+        if (c == QLatin1Char('\\') && i + 1 < line.size()) {
+            arg += line.at(++i);
+            inArg = true;
+        } else if (!quote.isNull()) {
+            if (c == quote)
+                quote = QChar();
+            else
+                arg += c;
+        } else if (c == QLatin1Char('"') || c == QLatin1Char('\'')) {
+            quote = c;
+            inArg = true;
+        } else if (c.isSpace()) {
+            if (inArg)
+                args += arg;
+            arg.clear();
+            inArg = false;
+        } else {
+            arg += c;
+            inArg = true;
+        }
+    }
+    if (inArg)
+        args += arg;
+    return args;
+}
+
+// Runs the commands read from the standard input, one per line. Empty
+// lines and lines starting with '#' are skipped. Returns the status of
+// the last command that failed.
+static int runBatch(QDBusConnectionInterface *bus)
+{
+    int ret = 0;
+    QTextStream in(stdin);
+    QString line;
+    while (in.readLineInto(&line)) {
+        const QString command = line.trimmed();
+        if (command.isEmpty() || command.startsWith(QLatin1Char('#')))
+            continue;
+        const int status = runCommand(bus, splitCommand(command));
+        if (status != 0)
+            ret = status;
+        fflush(stdout);
+        fflush(stderr);
+    }
+    return ret;
+}
+
 int main(int argc, char **argv)
 {
     QT_PREPEND_NAMESPACE(qt_dbus_metaobject_skip_annotations) = true;
@@ -422,6 +668,7 @@ int main(int argc, char **argv)
     args.takeFirst();
 
     bool connectionOpened = false;
+    bool batchMode = false;
     while (!args.isEmpty() && args.at(0).startsWith(QLatin1Char('-'))) {
         QString arg = args.takeFirst();
         if (arg == QLatin1String("--system")) {
@@ -434,6 +681,11 @@ int main(int argc, char **argv)
             }
         } else if (arg == QLatin1String("--literal")) {
             printArgumentsLiterally = true;
+        } else if (arg == QLatin1String("--parallel")) {
+            if (!args.isEmpty())
+                maxPendingCalls = qMax(args.takeFirst().toInt(), 1);
+        } else if (arg == QLatin1String("--batch")) {
+            batchMode = true;
         } else if (arg == QLatin1String("--help")) {
             showUsage();
             return 0;
@@ -457,56 +709,8 @@ int main(int argc, char **argv)
     }
 
     QDBusConnectionInterface *bus = connection.interface();
-    if (args.isEmpty()) {
-        printAllServices(bus);
-        return 0;
-    }
-
-    QString service = args.takeFirst();
-    if (!QDBusUtil::isValidBusName(service)) {
-        if (service.contains(QLatin1Char('*'))) {
-            if (globServices(bus, service))
-                return 0;
-        }
-        fprintf(stderr, "Service '%s' is not a valid name.\n", qPrintable(service));
-        return 1;
-    }
-
-    if (args.isEmpty()) {
-        listObjects(service, QString());
-        return 0;
-    }
-
-    QString path = args.takeFirst();
-    if (!QDBusUtil::isValidObjectPath(path)) {
-        fprintf(stderr, "Path '%s' is not a valid path name.\n", qPrintable(path));
-        return 1;
-    }
-    if (args.isEmpty()) {
-        listAllInterfaces(service, path);
-        return 0;
-    }
-
-    QString interface = args.takeFirst();
-    QString member;
-    int pos = interface.lastIndexOf(QLatin1Char('.'));
-    if (pos == -1) {
-        member = interface;
-        interface.clear();
-    } else {
-        member = interface.mid(pos + 1);
-        interface.truncate(pos);
-    }
-    if (!interface.isEmpty() && !QDBusUtil::isValidInterfaceName(interface)) {
-        fprintf(stderr, "Interface '%s' is not a valid interface name.\n", qPrintable(interface));
-        exit(1);
-    }
-    if (!QDBusUtil::isValidMemberName(member)) {
-        fprintf(stderr, "Method name '%s' is not a valid member name.\n", qPrintable(member));
-        return 1;
-    }
-
-    int ret = placeCall(service, path, interface, member, args);
-    return ret;
+    if (batchMode)
+        return runBatch(bus);
+    return runCommand(bus, args);
 }
 
@@ -4,18 +4,139 @@
 #include "logviewer.h"
 
 #include <QtGui/QContextMenuEvent>
+#include <QtGui/QTextDocumentFragment>
+#include <QtWidgets/QInputDialog>
 #include <QtWidgets/QMenu>
+#include <QtWidgets/QScrollBar>
+
+static const int defaultMaximumMessageCount = 10000;
 
 LogViewer::LogViewer(QWidget *parent)
-    : QTextBrowser(parent)
+    : QTextBrowser(parent), messages(defaultMaximumMessageCount)
+{
+    // One block per message, the document drops the oldest ones
+    document()->setMaximumBlockCount(defaultMaximumMessageCount);
+
+    // Messages arriving within a frame are added at once
+    flushTimer.setSingleShot(true);
+    flushTimer.setInterval(16);
+    connect(&flushTimer, &QTimer::timeout, this, &LogViewer::flushPendingMessages);
+}
+
+void LogViewer::appendMessage(const QString &text)
+{
+    messages.append({ text, Qt::mightBeRichText(text), QString() });
+    pendingMessageCount = qMin(pendingMessageCount + 1, messages.count());
+    if (!flushTimer.isActive())
+        flushTimer.start();
+}
+
+void LogViewer::setMaximumMessageCount(int count)
+{
+    count = qMax(count, 1);
+    if (count == messages.capacity())
+        return;
+    messages.setCapacity(count);
+    pendingMessageCount = qMin(pendingMessageCount, messages.count());
+    document()->setMaximumBlockCount(count);
+}
+
+void LogViewer::setFilter(const QString &filter)
+{
+    if (filter == filterText)
+        return;
+    filterText = filter;
+    rebuildDocument();
+}
+
+void LogViewer::clearMessages()
+{
+    messages.clear();
+    pendingMessageCount = 0;
+    flushTimer.stop();
+    clear();
+}
+
+bool LogViewer::matchesFilter(const Message &message) const
+{
+    if (filterText.isEmpty())
+        return true;
+    if (!message.isRichText)
+        return message.text.contains(filterText, Qt::CaseInsensitive);
+    if (message.plainText.isNull())
+        message.plainText = QTextDocumentFragment::fromHtml(message.text).toPlainText();
+    return message.plainText.contains(filterText, Qt::CaseInsensitive);
+}
+
+void LogViewer::flushPendingMessages()
+{
+    QList<const Message *> batch;
+    batch.reserve(pendingMessageCount);
+    for (qsizetype i = messages.lastIndex() - pendingMessageCount + 1; i <= messages.lastIndex(); ++i) {
+        const Message &message = messages.at(i);
+        if (matchesFilter(message))
+            batch.append(&message);
+    }
+    pendingMessageCount = 0;
+    insertMessages(batch);
+}
+
+void LogViewer::insertMessages(const QList<const Message *> &batch)
 {
+    if (batch.isEmpty())
+        return;
+
+    QScrollBar *scrollBar = verticalScrollBar();
+    const bool atBottom = scrollBar->value() == scrollBar->maximum();
+
+    QTextCursor cursor(document());
+    cursor.movePosition(QTextCursor::End);
+    cursor.beginEditBlock();
+    bool firstBlock = document()->isEmpty();
+    for (const Message *message : batch) {
+        if (!firstBlock)
+            cursor.insertBlock(QTextBlockFormat(), QTextCharFormat());
+        firstBlock = false;
+        if (message->isRichText)
+            cursor.insertHtml(message->text);
+        else
+            cursor.insertText(message->text);
+    }
+    cursor.endEditBlock();
+
+    if (atBottom)
+        scrollBar->setValue(scrollBar->maximum());
+}
+
+void LogViewer::rebuildDocument()
+{
+    flushTimer.stop();
+    pendingMessageCount = 0;
+    clear();
+
+    QList<const Message *> batch;
+    for (qsizetype i = messages.firstIndex(); i <= messages.lastIndex(); ++i) {
+        const Message &message = messages.at(i);
+        if (matchesFilter(message))
+            batch.append(&message);
+    }
+    insertMessages(batch);
 }
 
 void LogViewer::contextMenuEvent(QContextMenuEvent *event)
 {
     QMenu *menu = createStandardContextMenu();
     QAction *action = menu->addAction(tr("Clear"));
-    connect(action, &QAction::triggered, this, &QTextEdit::clear);
+    connect(action, &QAction::triggered, this, &LogViewer::clearMessages);
+    action = menu->addAction(tr("Maximum Messages..."));
+    connect(action, &QAction::triggered, this, [this] {
+        bool ok = false;
+        const int count = QInputDialog::getInt(this, tr("Maximum Messages"),
+                                               tr("Number of messages to keep:"),
+                                               maximumMessageCount(), 1, 10000000, 1000, &ok);
+        if (ok)
+            setMaximumMessageCount(count);
+    });
     menu->exec(event->globalPos());
     delete menu;
 }
@@ -5,15 +5,49 @@
 #define LOGVIEWER_H
 
 #include <QtWidgets/QTextBrowser>
+#include <QtCore/QContiguousCache>
+#include <QtCore/QTimer>
 
+// Shows the last messages logged. The messages are kept in a ring buffer
+// and added to the document in batches, the document only ever holds the
+// messages matching the filter.
 class LogViewer : public QTextBrowser
 {
     Q_OBJECT
 public:
     explicit LogViewer(QWidget *parent = 0);
 
+    void appendMessage(const QString &text);
+
+    int maximumMessageCount() const { return int(messages.capacity()); }
+    void setMaximumMessageCount(int count);
+
+    QString filter() const { return filterText; }
+
+public slots:
+    void setFilter(const QString &filter);
+    void clearMessages();
+
 protected:
     void contextMenuEvent(QContextMenuEvent *event) override;
+
+private:
+    struct Message
+    {
+        QString text;
+        bool isRichText;
+        mutable QString plainText; // for filtering, created on demand
+    };
+
+    bool matchesFilter(const Message &message) const;
+    void flushPendingMessages();
+    void insertMessages(const QList<const Message *> &batch);
+    void rebuildDocument();
+
+    QContiguousCache<Message> messages;
+    qsizetype pendingMessageCount = 0;
+    QTimer flushTimer;
+    QString filterText;
 };
 
 #endif // LOGVIEWER_H
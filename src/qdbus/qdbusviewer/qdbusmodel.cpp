@@ -6,16 +6,59 @@
 #include <QtCore/QDebug>
 #include <QtCore/QList>
 
+#include <QtCore/QSet>
+#include <QtCore/QXmlStreamReader>
+
 #include <QtDBus/QDBusObjectPath>
-#include <QtDBus/QDBusInterface>
+#include <QtDBus/QDBusMessage>
+#include <QtDBus/QDBusPendingCallWatcher>
+#include <QtDBus/QDBusPendingReply>
 #include <QtDBus/QDBusReply>
 
-#include <QtXml/QDomDocument>
+bool QDBusIntrospectionCache::lookup(const QString &service, const QString &path,
+                                     QString *xml) const
+{
+    const auto serviceIt = m_xml.constFind(service);
+    if (serviceIt == m_xml.cend())
+        return false;
+    const auto it = serviceIt->constFind(path);
+    if (it == serviceIt->cend())
+        return false;
+    *xml = it.value();
+    return true;
+}
+
+void QDBusIntrospectionCache::insert(const QString &service, const QString &path,
+                                     const QString &xml)
+{
+    m_xml[service].insert(path, xml);
+}
+
+void QDBusIntrospectionCache::removeService(const QString &service)
+{
+    m_xml.remove(service);
+}
+
+void QDBusIntrospectionCache::removePaths(const QString &service, const QString &path)
+{
+    const auto serviceIt = m_xml.find(service);
+    if (serviceIt == m_xml.end())
+        return;
+    if (path == QLatin1String("/")) {
+        m_xml.erase(serviceIt);
+        return;
+    }
+    const QString prefix = path + QLatin1Char('/');
+    serviceIt->removeIf([&](const QHash<QString, QString>::iterator &it) {
+        return it.key() == path || it.key().startsWith(prefix);
+    });
+}
 
 struct QDBusItem
 {
     inline QDBusItem(QDBusModel::Type aType, const QString &aName, QDBusItem *aParent = 0)
-        : type(aType), parent(aParent), isPrefetched(type != QDBusModel::PathItem), name(aName)
+        : type(aType), parent(aParent), isPrefetched(type != QDBusModel::PathItem),
+          isFetching(false), name(aName)
         {}
     inline ~QDBusItem()
     {
@@ -41,112 +84,235 @@ struct QDBusItem
     QDBusItem *parent;
     QList<QDBusItem *> children;
     bool isPrefetched;
+    bool isFetching;
     QString name;
     QString caption;
     QString typeSignature;
 };
 
-QDomDocument QDBusModel::introspect(const QString &path)
+static inline QString introspectableInterface()
 {
-    QDomDocument doc;
+    return QStringLiteral("org.freedesktop.DBus.Introspectable");
+}
 
-    QDBusInterface iface(service, path, QLatin1String("org.freedesktop.DBus.Introspectable"), c);
-    if (!iface.isValid()) {
-        QDBusError err(iface.lastError());
-        emit busError(QString::fromLatin1("Cannot introspect object %1 at %2:\n  %3 (%4)\n").arg(path).arg(
-                      service).arg(err.name()).arg(err.message()));
-        return doc;
+QString QDBusModel::introspectionError(const QString &path, const QDBusError &err) const
+{
+    if (err.isValid()) {
+        return QString::fromLatin1("Call to object %1 at %2:\n  %3 (%4) failed\n").arg(
+                    path).arg(service).arg(err.name()).arg(err.message());
     }
+    return QString::fromLatin1("Invalid XML received from object %1 at %2\n").arg(
+                path).arg(service);
+}
 
-    QDBusReply<QString> xml = iface.call(QLatin1String("Introspect"));
+QString QDBusModel::introspect(const QString &path)
+{
+    QString cachedXml;
+    if (cache && cache->lookup(service, path, &cachedXml))
+        return cachedXml;
 
+    const QDBusMessage call = QDBusMessage::createMethodCall(service, path, introspectableInterface(),
+                                                             QStringLiteral("Introspect"));
+    const QDBusReply<QString> xml = c.call(call);
     if (!xml.isValid()) {
-        QDBusError err(xml.error());
-        if (err.isValid()) {
-            emit busError(QString::fromLatin1("Call to object %1 at %2:\n  %3 (%4) failed\n").arg(
-                        path).arg(service).arg(err.name()).arg(err.message()));
+        emit busError(introspectionError(path, xml.error()));
+        return QString();
+    }
+    if (cache)
+        cache->insert(service, path, xml.value());
+    return xml.value();
+}
+
+// Queues an asynchronous introspection of the path. Paths the user
+// asked for go first, prefetching their children goes last.
+void QDBusModel::fetchPath(QDBusItem *item, bool prefetchChildren)
+{
+    Q_ASSERT(item->type == PathItem);
+    if (item->isPrefetched || item->isFetching)
+        return;
+
+    QString cachedXml;
+    if (cache && cache->lookup(service, item->path(), &cachedXml)) {
+        addPath(item, cachedXml);
+        if (prefetchChildren)
+            prefetchChildPaths(item);
+        return;
+    }
+
+    item->isFetching = true;
+    const PendingIntrospection introspection = { item, prefetchChildren };
+    if (prefetchChildren)
+        pendingIntrospections.prepend(introspection);
+    else
+        pendingIntrospections.append(introspection);
+    startIntrospections();
+}
+
+void QDBusModel::startIntrospections()
+{
+    while (runningIntrospections.size() < MaxRunningIntrospections
+           && !pendingIntrospections.isEmpty()) {
+        const PendingIntrospection introspection = pendingIntrospections.takeFirst();
+        const QDBusMessage call =
+                QDBusMessage::createMethodCall(service, introspection.item->path(),
+                                               introspectableInterface(),
+                                               QStringLiteral("Introspect"));
+        QDBusPendingCallWatcher *watcher = new QDBusPendingCallWatcher(c.asyncCall(call), this);
+        connect(watcher, &QDBusPendingCallWatcher::finished,
+                this, &QDBusModel::introspectionFinished);
+        runningIntrospections.insert(watcher, introspection);
+    }
+}
+
+void QDBusModel::introspectionFinished(QDBusPendingCallWatcher *watcher)
+{
+    watcher->deleteLater();
+    const auto it = runningIntrospections.constFind(watcher);
+    if (it == runningIntrospections.cend())
+        return;
+    const PendingIntrospection introspection = it.value();
+    runningIntrospections.erase(it);
+
+    QDBusItem *item = introspection.item;
+    item->isFetching = false;
+    const QDBusPendingReply<QString> xml = *watcher;
+    if (xml.isError()) {
+        emit busError(introspectionError(item->path(), xml.error()));
+        item->isPrefetched = true;
+    } else {
+        if (cache)
+            cache->insert(service, item->path(), xml.value());
+        addPath(item, xml.value());
+    }
+
+    if (introspection.prefetchChildren)
+        prefetchChildPaths(item);
+    startIntrospections();
+}
+
+void QDBusModel::prefetchChildPaths(QDBusItem *item)
+{
+    for (QDBusItem *child : std::as_const(item->children)) {
+        if (child->type == PathItem)
+            fetchPath(child, false);
+    }
+}
+
+// Drops the introspections of the item and its descendants, which are
+// about to be deleted.
+void QDBusModel::cancelIntrospections(QDBusItem *item)
+{
+    QSet<const QDBusItem *> items;
+    QList<const QDBusItem *> stack{item};
+    while (!stack.isEmpty()) {
+        const QDBusItem *current = stack.takeLast();
+        items.insert(current);
+        for (const QDBusItem *child : current->children)
+            stack.append(child);
+    }
+
+    pendingIntrospections.removeIf([&items](const PendingIntrospection &introspection) {
+        return items.contains(introspection.item);
+    });
+    for (auto it = runningIntrospections.begin(); it != runningIntrospections.end(); ) {
+        if (items.contains(it.value().item)) {
+            it.key()->deleteLater();
+            it = runningIntrospections.erase(it);
         } else {
-            emit busError(QString::fromLatin1("Invalid XML received from object %1 at %2\n").arg(
-                    path).arg(service));
+            ++it;
         }
-        return doc;
     }
+    item->isFetching = false;
+}
 
-    doc.setContent(xml);
-    return doc;
+QModelIndex QDBusModel::indexForItem(QDBusItem *item) const
+{
+    if (!item->parent)
+        return QModelIndex();
+    return createIndex(item->parent->children.indexOf(item), 0, item);
 }
 
-void QDBusModel::addMethods(QDBusItem *parent, const QDomElement &iface)
+void QDBusModel::addMethods(QDBusItem *parent, QXmlStreamReader &reader)
 {
     Q_ASSERT(parent);
 
-    QDomElement child = iface.firstChildElement();
-    while (!child.isNull()) {
+    while (reader.readNextStartElement()) {
         QDBusItem *item = nullptr;
-        if (child.tagName() == QLatin1String("method")) {
+        const QStringView tagName = reader.name();
+        if (tagName == QLatin1String("method")) {
             item = new QDBusItem(QDBusModel::MethodItem,
-                    child.attribute(QLatin1String("name")), parent);
+                    reader.attributes().value(QLatin1String("name")).toString(), parent);
             item->caption = QLatin1String("Method: ") + item->name;
             //get "type" from <arg> where "direction" is "in"
-            QDomElement n = child.firstChildElement();
-            while (!n.isNull()) {
-                if (n.attribute(QLatin1String("direction")) == QLatin1String("in"))
-                    item->typeSignature += n.attribute(QLatin1String("type"));
-                n = n.nextSiblingElement();
+            while (reader.readNextStartElement()) {
+                const QXmlStreamAttributes attributes = reader.attributes();
+                if (attributes.value(QLatin1String("direction")) == QLatin1String("in"))
+                    item->typeSignature += attributes.value(QLatin1String("type"));
+                reader.skipCurrentElement();
             }
-        } else if (child.tagName() == QLatin1String("signal")) {
+        } else if (tagName == QLatin1String("signal")) {
             item = new QDBusItem(QDBusModel::SignalItem,
-                    child.attribute(QLatin1String("name")), parent);
+                    reader.attributes().value(QLatin1String("name")).toString(), parent);
             item->caption = QLatin1String("Signal: ") + item->name;
-        } else if (child.tagName() == QLatin1String("property")) {
+            reader.skipCurrentElement();
+        } else if (tagName == QLatin1String("property")) {
             item = new QDBusItem(QDBusModel::PropertyItem,
-                    child.attribute(QLatin1String("name")), parent);
+                    reader.attributes().value(QLatin1String("name")).toString(), parent);
             item->caption = QLatin1String("Property: ") + item->name;
+            reader.skipCurrentElement();
         } else {
-            qDebug() << "addMethods: unknown tag:" << child.tagName();
+            qDebug() << "addMethods: unknown tag:" << tagName;
+            reader.skipCurrentElement();
         }
         if (item)
             parent->children.append(item);
-
-        child = child.nextSiblingElement();
     }
 }
 
-void QDBusModel::addPath(QDBusItem *parent)
+void QDBusModel::addPath(QDBusItem *parent, const QString &xml)
 {
     Q_ASSERT(parent);
 
-    QString path = parent->path();
-
-    QDomDocument doc = introspect(path);
-    QDomElement node = doc.documentElement();
-    QDomElement child = node.firstChildElement();
-    while (!child.isNull()) {
-        if (child.tagName() == QLatin1String("node")) {
-            QDBusItem *item = new QDBusItem(QDBusModel::PathItem,
-                        child.attribute(QLatin1String("name")) + QLatin1Char('/'), parent);
-            parent->children.append(item);
-
-            addMethods(item, child);
-        } else if (child.tagName() == QLatin1String("interface")) {
-            QDBusItem *item = new QDBusItem(QDBusModel::InterfaceItem,
-                        child.attribute(QLatin1String("name")), parent);
-            parent->children.append(item);
-
-            addMethods(item, child);
-        } else {
-            qDebug() << "addPath: Unknown tag name:" << child.tagName();
+    QList<QDBusItem *> children;
+    QXmlStreamReader reader(xml);
+    if (reader.readNextStartElement()) {
+        while (reader.readNextStartElement()) {
+            const QStringView tagName = reader.name();
+            if (tagName == QLatin1String("node")) {
+                QDBusItem *item = new QDBusItem(QDBusModel::PathItem,
+                            reader.attributes().value(QLatin1String("name")).toString()
+                            + QLatin1Char('/'), parent);
+                children.append(item);
+
+                addMethods(item, reader);
+            } else if (tagName == QLatin1String("interface")) {
+                QDBusItem *item = new QDBusItem(QDBusModel::InterfaceItem,
+                            reader.attributes().value(QLatin1String("name")).toString(), parent);
+                children.append(item);
+
+                addMethods(item, reader);
+            } else {
+                qDebug() << "addPath: Unknown tag name:" << tagName;
+                reader.skipCurrentElement();
+            }
         }
-        child = child.nextSiblingElement();
     }
 
     parent->isPrefetched = true;
+    if (!children.isEmpty()) {
+        beginInsertRows(indexForItem(parent), parent->children.count(),
+                        parent->children.count() + children.count() - 1);
+        parent->children += children;
+        endInsertRows();
+    }
 }
 
-QDBusModel::QDBusModel(const QString &aService, const QDBusConnection &connection)
-    : service(aService), c(connection), root(0)
+QDBusModel::QDBusModel(const QString &aService, const QDBusConnection &connection,
+                       QDBusIntrospectionCache *introspectionCache)
+    : service(aService), c(connection), root(0), cache(introspectionCache)
 {
     root = new QDBusItem(QDBusModel::PathItem, QLatin1String("/"));
+    fetchPath(root, true);
 }
 
 QDBusModel::~QDBusModel()
@@ -180,12 +346,34 @@ int QDBusModel::rowCount(const QModelIndex &parent) const
     QDBusItem *item = static_cast<QDBusItem *>(parent.internalPointer());
     if (!item)
         item = root;
-    if (!item->isPrefetched)
-        const_cast<QDBusModel *>(this)->addPath(item);
 
     return item->children.count();
 }
 
+bool QDBusModel::hasChildren(const QModelIndex &parent) const
+{
+    const QDBusItem *item = static_cast<QDBusItem *>(parent.internalPointer());
+    if (!item)
+        item = root;
+    return !item->isPrefetched || !item->children.isEmpty();
+}
+
+bool QDBusModel::canFetchMore(const QModelIndex &parent) const
+{
+    const QDBusItem *item = static_cast<QDBusItem *>(parent.internalPointer());
+    if (!item)
+        item = root;
+    return !item->isPrefetched && !item->isFetching;
+}
+
+void QDBusModel::fetchMore(const QModelIndex &parent)
+{
+    QDBusItem *item = static_cast<QDBusItem *>(parent.internalPointer());
+    if (!item)
+        item = root;
+    fetchPath(item, true);
+}
+
 int QDBusModel::columnCount(const QModelIndex &) const
 {
     return 1;
@@ -228,6 +416,9 @@ void QDBusModel::refresh(const QModelIndex &aIndex)
     if (!item)
         item = root;
 
+    cancelIntrospections(item);
+    if (cache)
+        cache->removePaths(service, item->path());
     if (!item->children.isEmpty()) {
         beginRemoveRows(index, 0, item->children.count() - 1);
         qDeleteAll(item->children);
@@ -235,11 +426,8 @@ void QDBusModel::refresh(const QModelIndex &aIndex)
         endRemoveRows();
     }
 
-    addPath(item);
-    if (!item->children.isEmpty()) {
-        beginInsertRows(index, 0, item->children.count() - 1);
-        endInsertRows();
-    }
+    item->isPrefetched = false;
+    fetchPath(item, true);
 }
 
 QString QDBusModel::dBusPath(const QModelIndex &aIndex) const
@@ -297,9 +485,11 @@ QModelIndex QDBusModel::findObject(const QDBusObjectPath &objectPath)
                 item = child;
                 childIdx = i;
 
-                // prefetch the found branch
-                if (!item->isPrefetched)
-                    addPath(item);
+                // fetch the found branch, waiting for it
+                if (!item->isPrefetched) {
+                    cancelIntrospections(item);
+                    addPath(item, introspect(item->path()));
+                }
                 break;
             }
         }
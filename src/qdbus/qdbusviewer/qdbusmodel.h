@@ -5,14 +5,30 @@
 #define QDBUSMODEL_H
 
 #include <QtCore/qabstractitemmodel.h>
+#include <QtCore/qhash.h>
+#include <QtCore/qlist.h>
 #include <QtDBus/QDBusConnection>
 
 struct QDBusItem;
 
-QT_FORWARD_DECLARE_CLASS(QDomDocument);
-QT_FORWARD_DECLARE_CLASS(QDomElement);
+QT_FORWARD_DECLARE_CLASS(QXmlStreamReader)
 QT_FORWARD_DECLARE_CLASS(QDBusObjectPath)
+QT_FORWARD_DECLARE_CLASS(QDBusError)
+QT_FORWARD_DECLARE_CLASS(QDBusPendingCallWatcher)
 
+// Introspection data of object paths by service. It is valid as long as
+// the owner of the service stays the same.
+class QDBusIntrospectionCache
+{
+public:
+    bool lookup(const QString &service, const QString &path, QString *xml) const;
+    void insert(const QString &service, const QString &path, const QString &xml);
+    void removeService(const QString &service);
+    void removePaths(const QString &service, const QString &path);
+
+private:
+    QHash<QString, QHash<QString, QString>> m_xml;
+};
 
 class QDBusModel: public QAbstractItemModel
 {
@@ -21,13 +37,17 @@ class QDBusModel: public QAbstractItemModel
 public:
     enum Type { InterfaceItem, PathItem, MethodItem, SignalItem, PropertyItem };
 
-    QDBusModel(const QString &service, const QDBusConnection &connection);
+    QDBusModel(const QString &service, const QDBusConnection &connection,
+               QDBusIntrospectionCache *introspectionCache = nullptr);
     ~QDBusModel();
 
 
     QModelIndex index(int row, int column, const QModelIndex &parent = QModelIndex()) const override;
     QModelIndex parent(const QModelIndex &child) const override;
     int rowCount(const QModelIndex &parent = QModelIndex()) const override;
+    bool hasChildren(const QModelIndex &parent = QModelIndex()) const override;
+    bool canFetchMore(const QModelIndex &parent) const override;
+    void fetchMore(const QModelIndex &parent) override;
     int columnCount(const QModelIndex &parent = QModelIndex()) const override;
     QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const override;
     QVariant headerData(int section, Qt::Orientation orientation, int role = Qt::DisplayRole) const override;
@@ -46,13 +66,30 @@ Q_SIGNALS:
     void busError(const QString &text);
 
 private:
-    QDomDocument introspect(const QString &path);
-    void addMethods(QDBusItem *parent, const QDomElement &iface);
-    void addPath(QDBusItem *parent);
+    struct PendingIntrospection
+    {
+        QDBusItem *item;
+        bool prefetchChildren;
+    };
+    enum { MaxRunningIntrospections = 8 };
+
+    QString introspect(const QString &path);
+    QString introspectionError(const QString &path, const QDBusError &err) const;
+    void fetchPath(QDBusItem *item, bool prefetchChildren);
+    void startIntrospections();
+    void introspectionFinished(QDBusPendingCallWatcher *watcher);
+    void prefetchChildPaths(QDBusItem *item);
+    void cancelIntrospections(QDBusItem *item);
+    QModelIndex indexForItem(QDBusItem *item) const;
+    void addMethods(QDBusItem *parent, QXmlStreamReader &reader);
+    void addPath(QDBusItem *parent, const QString &xml);
 
     QString service;
     QDBusConnection c;
     QDBusItem *root;
+    QDBusIntrospectionCache *cache;
+    QList<PendingIntrospection> pendingIntrospections;
+    QHash<QDBusPendingCallWatcher *, PendingIntrospection> runningIntrospections;
 };
 
 #endif
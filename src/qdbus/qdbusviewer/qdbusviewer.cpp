@@ -34,8 +34,9 @@
 class QDBusViewModel: public QDBusModel
 {
 public:
-    inline QDBusViewModel(const QString &service, const QDBusConnection &connection)
-        : QDBusModel(service, connection)
+    inline QDBusViewModel(const QString &service, const QDBusConnection &connection,
+                          QDBusIntrospectionCache *introspectionCache)
+        : QDBusModel(service, connection, introspectionCache)
     {}
 
     QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const override
@@ -111,6 +112,17 @@ QDBusViewer::QDBusViewer(const QDBusConnection &connection, QWidget *parent)  :
     log = new LogViewer;
     connect(log, &QTextBrowser::anchorClicked, this, &QDBusViewer::anchorClicked);
 
+    QLineEdit *logFilterLine = new QLineEdit;
+    logFilterLine->setPlaceholderText(tr("Filter log..."));
+    logFilterLine->setClearButtonEnabled(true);
+    connect(logFilterLine, &QLineEdit::textChanged, log, &LogViewer::setFilter);
+
+    QWidget *logWidget = new QWidget;
+    QVBoxLayout *logLayout = new QVBoxLayout(logWidget);
+    logLayout->setContentsMargins(QMargins());
+    logLayout->addWidget(logFilterLine);
+    logLayout->addWidget(log);
+
     splitter = new QSplitter(topSplitter);
     splitter->addWidget(servicesView);
 
@@ -123,7 +135,7 @@ QDBusViewer::QDBusViewer(const QDBusConnection &connection, QWidget *parent)  :
     splitter->addWidget(tree);
 
     topSplitter->addWidget(splitter);
-    topSplitter->addWidget(log);
+    topSplitter->addWidget(logWidget);
 
     connect(servicesView->selectionModel(), &QItemSelectionModel::currentChanged, this, &QDBusViewer::serviceChanged);
     connect(tree, &QWidget::customContextMenuRequested, this, &QDBusViewer::showContextMenu);
@@ -145,22 +157,26 @@ QDBusViewer::QDBusViewer(const QDBusConnection &connection, QWidget *parent)  :
 
 static inline QString topSplitterStateKey() { return QStringLiteral("topSplitterState"); }
 static inline QString splitterStateKey() { return QStringLiteral("splitterState"); }
+static inline QString logMaximumMessageCountKey() { return QStringLiteral("logMaximumMessageCount"); }
 
 void QDBusViewer::saveState(QSettings *settings) const
 {
     settings->setValue(topSplitterStateKey(), topSplitter->saveState());
     settings->setValue(splitterStateKey(), splitter->saveState());
+    settings->setValue(logMaximumMessageCountKey(), log->maximumMessageCount());
 }
 
 void QDBusViewer::restoreState(const QSettings *settings)
 {
     topSplitter->restoreState(settings->value(topSplitterStateKey()).toByteArray());
     splitter->restoreState(settings->value(splitterStateKey()).toByteArray());
+    log->setMaximumMessageCount(settings->value(logMaximumMessageCountKey(),
+                                                log->maximumMessageCount()).toInt());
 }
 
 void QDBusViewer::logMessage(const QString &msg)
 {
-    log->append(msg + QLatin1Char('\n'));
+    log->appendMessage(msg + QLatin1Char('\n'));
 }
 
 void QDBusViewer::showEvent(QShowEvent *)
@@ -185,7 +201,7 @@ bool QDBusViewer::eventFilter(QObject *obj, QEvent *event)
 
 void QDBusViewer::logError(const QString &msg)
 {
-    log->append(QLatin1String("<font color=\"red\">Error: </font>") + msg.toHtmlEscaped() + QLatin1String("<br>"));
+    log->appendMessage(QLatin1String("<font color=\"red\">Error: </font>") + msg.toHtmlEscaped() + QLatin1String("<br>"));
 }
 
 void QDBusViewer::refresh()
@@ -457,7 +473,7 @@ void QDBusViewer::dumpMessage(const QDBusMessage &message)
         out.chop(2);
     }
 
-    log->append(out);
+    log->appendMessage(out);
 }
 
 void QDBusViewer::dumpError(const QDBusError &error)
@@ -474,7 +490,7 @@ void QDBusViewer::serviceChanged(const QModelIndex &index)
         return;
     currentService = index.data().toString();
 
-    QDBusViewModel *model = new QDBusViewModel(currentService, c);
+    QDBusViewModel *model = new QDBusViewModel(currentService, c, &introspectionCache);
     tree->setModel(model);
     connect(model, &QDBusModel::busError, this, &QDBusViewer::logError);
 }
@@ -499,6 +515,7 @@ static QModelIndex findItem(QStringListModel *servicesModel, const QString &name
 
 void QDBusViewer::serviceUnregistered(const QString &name)
 {
+    introspectionCache.removeService(name);
     QModelIndex hit = findItem(servicesModel, name);
     if (!hit.isValid())
         return;
@@ -508,6 +525,11 @@ void QDBusViewer::serviceUnregistered(const QString &name)
 void QDBusViewer::serviceOwnerChanged(const QString &name, const QString &oldOwner,
                                       const QString &newOwner)
 {
+    // The cached introspection data belongs to the old owner
+    introspectionCache.removeService(name);
+    if (!oldOwner.isEmpty())
+        introspectionCache.removeService(oldOwner);
+
     QModelIndex hit = findItem(servicesModel, name);
 
     if (!hit.isValid() && oldOwner.isEmpty() && !newOwner.isEmpty())
@@ -4,11 +4,14 @@
 #ifndef QDBUSVIEWER_H
 #define QDBUSVIEWER_H
 
+#include "qdbusmodel.h"
+
 #include <QtWidgets/QWidget>
 #include <QtDBus/QDBusConnection>
 #include <QtCore/QRegularExpression>
 
 class ServicesProxyModel;
+class LogViewer;
 
 QT_FORWARD_DECLARE_CLASS(QTableView)
 QT_FORWARD_DECLARE_CLASS(QTreeView)
@@ -16,8 +19,6 @@ QT_FORWARD_DECLARE_CLASS(QTreeWidget)
 QT_FORWARD_DECLARE_CLASS(QStringListModel)
 QT_FORWARD_DECLARE_CLASS(QLineEdit)
 QT_FORWARD_DECLARE_CLASS(QTextBrowser)
-QT_FORWARD_DECLARE_CLASS(QDomDocument)
-QT_FORWARD_DECLARE_CLASS(QDomElement)
 QT_FORWARD_DECLARE_CLASS(QSplitter)
 QT_FORWARD_DECLARE_CLASS(QSettings)
 
@@ -74,10 +75,11 @@ private:
     ServicesProxyModel *servicesProxyModel;
     QLineEdit *serviceFilterLine;
     QTableView *servicesView;
-    QTextBrowser *log;
+    LogViewer *log;
     QSplitter *topSplitter;
     QSplitter *splitter;
     QRegularExpression objectPathRegExp;
+    QDBusIntrospectionCache introspectionCache;
 };
 
 #endif
@@ -54,6 +54,7 @@ Aggregate::~Aggregate()
     m_enumChildren.clear();
     m_nonfunctionMap.clear();
     m_functionMap.clear();
+    m_overloadSignatures.clear();
     qDeleteAll(m_children.begin(), m_children.end());
     m_children.clear();
 }
@@ -203,12 +204,98 @@ FunctionNode *Aggregate::findFunctionChild(const FunctionNode *clone)
     return nullptr;
 }
 
+/*!
+  Returns \c true if \a signatures describe the overloads starting
+  at \a fn with the parameters they have now. A parameter type that
+  was changed since is no longer shared with the recorded copy.
+ */
+static bool isUpToDate(const QList<Aggregate::OverloadSignature> &signatures,
+                       const FunctionNode *fn)
+{
+    for (const auto &signature : signatures) {
+        if (signature.function != fn)
+            return false;
+        const Parameters &parameters = fn->parameters();
+        if (parameters.count() != signature.types.size())
+            return false;
+        for (int i = 0; i < parameters.count(); ++i) {
+            const QString &type = parameters.at(i).type();
+            const QString &recorded = signature.types.at(i);
+            if (type.constData() != recorded.constData() || type.size() != recorded.size())
+                return false;
+        }
+        fn = fn->nextOverload();
+    }
+    return fn == nullptr;
+}
+
+/*!
+  Returns the functions named \a name that are children of this
+  aggregate, in the order of their overload list, together with their
+  parameter types as normalizeType() returns them.
+
+  The signatures are computed the first time they are needed and
+  again after the overloads or their parameters changed, so that
+  resolving a \c {\fn} command against many overloads doesn't
+  normalize the same parameter types over and over.
+ */
+const QList<Aggregate::OverloadSignature> &Aggregate::overloadSignatures(const QString &name)
+{
+    FunctionNode *primary = m_functionMap.value(name);
+    QList<OverloadSignature> &signatures = m_overloadSignatures[name];
+    if (isUpToDate(signatures, primary))
+        return signatures;
+
+    signatures.clear();
+    for (FunctionNode *fn = primary; fn != nullptr; fn = fn->nextOverload()) {
+        OverloadSignature signature;
+        signature.function = fn;
+        const Parameters &parameters = fn->parameters();
+        signature.types.reserve(parameters.count());
+        signature.normalizedTypes.reserve(parameters.count());
+        for (const Parameter &parameter : parameters.parameters()) {
+            signature.types.append(parameter.type());
+            signature.normalizedTypes.append(normalizeType(parameter.type()));
+        }
+        signatures.append(std::move(signature));
+    }
+    return signatures;
+}
+
+/*!
+  Returns \a type with the scopes of this aggregate and of its
+  parents removed, innermost first, so that types spelled with
+  different qualifications inside this aggregate compare equal.
+ */
+QString Aggregate::normalizeType(QString type) const
+{
+    for (const Node *node = this; node != nullptr; node = node->parent())
+        type.remove(node->name() + QLatin1String("::"));
+    return type;
+}
+
 /*!
   Mark all child nodes that have no documentation as having
   private access and internal status. qdoc will then ignore
   them for documentation purposes.
+
+  \sa markOwnUndocumentedChildrenInternal()
  */
 void Aggregate::markUndocumentedChildrenInternal()
+{
+    markOwnUndocumentedChildrenInternal();
+    for (auto *child : qAsConst(m_children)) {
+        if (child->isAggregate())
+            static_cast<Aggregate *>(child)->markUndocumentedChildrenInternal();
+    }
+}
+
+/*!
+  Marks the undocumented children of this aggregate as private and
+  internal, without recursing into the child aggregates. This reads
+  the children and their children, and only changes the children.
+ */
+void Aggregate::markOwnUndocumentedChildrenInternal()
 {
     for (auto *child : qAsConst(m_children)) {
         if (!child->isSharingComment() && !child->hasDoc() && !child->isDontDocument()) {
@@ -224,16 +311,29 @@ void Aggregate::markUndocumentedChildrenInternal()
                 child->setStatus(Node::Internal);
             }
         }
-        if (child->isAggregate()) {
-            static_cast<Aggregate *>(child)->markUndocumentedChildrenInternal();
-        }
     }
 }
 
 /*!
   This is where we set the overload numbers for function nodes.
+
+  \sa normalizeOwnOverloads()
  */
 void Aggregate::normalizeOverloads()
+{
+    normalizeOwnOverloads();
+    for (auto *node : qAsConst(m_children)) {
+        if (node->isAggregate())
+            static_cast<Aggregate *>(node)->normalizeOverloads();
+    }
+}
+
+/*!
+  Sets the overload numbers of the functions of this aggregate,
+  without recursing into the child aggregates. Only the functions
+  of this aggregate are read and changed.
+ */
+void Aggregate::normalizeOwnOverloads()
 {
     /*
       Ensure that none of the primary functions is inactive, private,
@@ -275,11 +375,6 @@ void Aggregate::normalizeOverloads()
             internalFn = internalFn->nextOverload();
         }
     }
-
-    for (auto *node : qAsConst(m_children)) {
-        if (node->isAggregate())
-            static_cast<Aggregate *>(node)->normalizeOverloads();
-    }
 }
 
 /*!
@@ -395,6 +490,7 @@ bool Aggregate::isSameSignature(const FunctionNode *f1, const FunctionNode *f2)
  */
 void Aggregate::addFunction(FunctionNode *fn)
 {
+    m_overloadSignatures.remove(fn->name());
     auto it = m_functionMap.find(fn->name());
     if (it == m_functionMap.end())
         m_functionMap.insert(fn->name(), fn);
@@ -414,6 +510,7 @@ void Aggregate::addFunction(FunctionNode *fn)
  */
 void Aggregate::adoptFunction(FunctionNode *fn, Aggregate *firstParent)
 {
+    firstParent->m_overloadSignatures.remove(fn->name());
     auto *primary = firstParent->m_functionMap.value(fn->name());
     if (primary) {
         if (primary != fn)
@@ -9,6 +9,7 @@
 #include <optional>
 
 #include <QtCore/qglobal.h>
+#include <QtCore/qhash.h>
 #include <QtCore/qstringlist.h>
 
 QT_BEGIN_NAMESPACE
@@ -20,15 +21,26 @@ class QmlPropertyNode;
 class Aggregate : public PageNode
 {
 public:
+    struct OverloadSignature
+    {
+        FunctionNode *function { nullptr };
+        QStringList types {}; // as recorded, to notice changed parameters
+        QStringList normalizedTypes {}; // see normalizeType()
+    };
+
     [[nodiscard]] Node *findChildNode(const QString &name, Node::Genus genus,
                                       int findFlags = 0) const;
     Node *findNonfunctionChild(const QString &name, bool (Node::*)() const);
     void findChildren(const QString &name, NodeVector &nodes) const;
     FunctionNode *findFunctionChild(const QString &name, const Parameters &parameters);
     FunctionNode *findFunctionChild(const FunctionNode *clone);
+    const QList<OverloadSignature> &overloadSignatures(const QString &name);
+    [[nodiscard]] QString normalizeType(QString type) const;
 
     void normalizeOverloads();
+    void normalizeOwnOverloads();
     void markUndocumentedChildrenInternal();
+    void markOwnUndocumentedChildrenInternal();
 
     [[nodiscard]] bool isAggregate() const override { return true; }
     [[nodiscard]] const EnumNode *findEnumNodeForValue(const QString &enumValue) const;
@@ -111,6 +123,7 @@ private:
     NodeList m_enumChildren {};
     NodeMultiMap m_nonfunctionMap {};
     NodeList m_nonfunctionList {};
+    QHash<QString, QList<OverloadSignature>> m_overloadSignatures {};
 };
 
 QT_END_NAMESPACE
@@ -111,25 +111,22 @@ public:
 
     friend class LinkAtom;
 
-    explicit Atom(AtomType type, const QString &string = "") : m_type(type), m_strs(string) { }
+    explicit Atom(AtomType type, const QString &string = "") : m_type(type), m_strs{ string } { }
 
-    Atom(AtomType type, const QString &p1, const QString &p2) : m_type(type), m_strs(p1)
+    Atom(AtomType type, const QString &p1, const QString &p2)
+        : m_type(type), m_count(p2.isEmpty() ? 1 : 2), m_strs{ p1, p2 }
     {
-        if (!p2.isEmpty())
-            m_strs << p2;
     }
 
     Atom(Atom *previous, AtomType type, const QString &string)
-        : m_next(previous->m_next), m_type(type), m_strs(string)
+        : m_next(previous->m_next), m_type(type), m_strs{ string }
     {
         previous->m_next = this;
     }
 
     Atom(Atom *previous, AtomType type, const QString &p1, const QString &p2)
-        : m_next(previous->m_next), m_type(type), m_strs(p1)
+        : m_next(previous->m_next), m_type(type), m_count(p2.isEmpty() ? 1 : 2), m_strs{ p1, p2 }
     {
-        if (!p2.isEmpty())
-            m_strs << p2;
         previous->m_next = this;
     }
 
@@ -148,10 +145,17 @@ public:
     [[nodiscard]] AtomType type() const { return m_type; }
     [[nodiscard]] QString typeString() const;
     [[nodiscard]] const QString &string() const { return m_strs[0]; }
-    [[nodiscard]] const QString &string(int i) const { return m_strs[i]; }
-    [[nodiscard]] qsizetype count() const { return m_strs.size(); }
+    [[nodiscard]] const QString &string(int i) const
+    {
+        Q_ASSERT(i >= 0 && i < m_count);
+        return m_strs[i];
+    }
+    [[nodiscard]] qsizetype count() const { return m_count; }
     [[nodiscard]] QString linkText() const;
-    [[nodiscard]] const QStringList &strings() const { return m_strs; }
+    [[nodiscard]] QStringList strings() const
+    {
+        return m_count == 1 ? QStringList { m_strs[0] } : QStringList { m_strs[0], m_strs[1] };
+    }
 
     [[nodiscard]] virtual bool isLinkAtom() const { return false; }
     virtual Node::Genus genus() { return Node::DontCare; }
@@ -163,7 +167,10 @@ protected:
     static QString s_noError;
     Atom *m_next = nullptr;
     AtomType m_type {};
-    QStringList m_strs {};
+    // An atom has one or two strings; they are stored inline rather than
+    // in a list, which would be a second allocation for every atom.
+    qsizetype m_count { 1 };
+    QString m_strs[2] {};
 };
 
 class LinkAtom : public Atom
@@ -8,6 +8,7 @@
 #include "codechunk.h"
 #include "config.h"
 #include "enumnode.h"
+#include "fileprefetcher.h"
 #include "functionnode.h"
 #include "namespacenode.h"
 #include "propertynode.h"
@@ -16,6 +17,9 @@
 #include "utilities.h"
 #include "variablenode.h"
 
+#include <QtCore/qcoreapplication.h>
+#include <QtCore/qcryptographichash.h>
+#include <QtCore/qdatetime.h>
 #include <QtCore/qdebug.h>
 #include <QtCore/qelapsedtimer.h>
 #include <QtCore/qfile.h>
@@ -26,7 +30,9 @@
 
 #include <clang-c/Index.h>
 
+#include <algorithm>
 #include <cstdio>
+#include <filesystem>
 
 QT_BEGIN_NAMESPACE
 
@@ -37,6 +43,19 @@ static const auto kClangDontDisplayDiagnostics = 0;
 static CXTranslationUnit_Flags flags_ = static_cast<CXTranslationUnit_Flags>(0);
 static CXIndex index_ = nullptr;
 
+// The flags for parsing source files; initializeParser() applies the
+// clangkeepgoing and clangpreamble configuration variables.
+static CXTranslationUnit_Flags sourceFileFlags_ = static_cast<CXTranslationUnit_Flags>(
+        CXTranslationUnit_Incomplete | CXTranslationUnit_SkipFunctionBodies
+        | CXTranslationUnit_KeepGoing);
+
+// Every translation unit parsed ahead holds its AST until it is visited,
+// so the number of worker threads and of units in flight is bounded.
+static const unsigned int kMaxParserThreads = 8;
+
+// The number of translation units kept for reparsing in watch mode.
+static const qsizetype kMaxPooledTranslationUnits = 64;
+
 QByteArray ClangCodeParser::s_fn;
 constexpr const char *fnDummyFileName = "/fn_dummyfile.cpp";
 
@@ -59,6 +78,156 @@ static QDebug operator<<(QDebug debug, const std::vector<T> &v)
 }
 #endif // !QT_NO_DEBUG_STREAM
 
+/*!
+  \internal
+  \struct PrefetchedUnit
+
+  A translation unit that was parsed ahead, with the index it was
+  parsed with and the error code of the parse.
+ */
+struct PrefetchedUnit
+{
+    CXIndex index = nullptr;
+    CXTranslationUnit tu = nullptr;
+    CXErrorCode err = CXError_Failure;
+};
+
+/*!
+  \internal
+  \class TranslationUnitPrefetcher
+
+  Parses the translation units of source files with libclang ahead of
+  ClangCodeParser::parseSourceFile(). Each unit gets its own index.
+  The caller that takes a unit is responsible for disposing of it and
+  its index.
+ */
+class TranslationUnitPrefetcher : public FilePrefetcher<PrefetchedUnit>
+{
+public:
+    TranslationUnitPrefetcher(const QStringList &filePaths, const QList<QByteArray> &args,
+                              const QList<QByteArray> &mmArgs);
+};
+
+/*!
+  Starts parsing the files in \a filePaths with \a args, or with
+  \a mmArgs for Objective-C++ files.
+ */
+TranslationUnitPrefetcher::TranslationUnitPrefetcher(const QStringList &filePaths,
+                                                     const QList<QByteArray> &args,
+                                                     const QList<QByteArray> &mmArgs)
+    : FilePrefetcher(
+            filePaths, std::min(Utilities::threadCount(), kMaxParserThreads),
+            std::min(Utilities::threadCount(), kMaxParserThreads) + 1,
+            [args, mmArgs](const QString &filePath) {
+                std::vector<const char *> argv;
+                for (const auto &arg : filePath.endsWith(".mm") ? mmArgs : args)
+                    argv.push_back(arg.constData());
+                PrefetchedUnit unit;
+                unit.index = clang_createIndex(1, kClangDontDisplayDiagnostics);
+                unit.err = clang_parseTranslationUnit2(unit.index, filePath.toLocal8Bit(),
+                                                       argv.data(), static_cast<int>(argv.size()),
+                                                       nullptr, 0, sourceFileFlags_, &unit.tu);
+                return unit;
+            },
+            [](PrefetchedUnit &unit) {
+                if (unit.tu)
+                    clang_disposeTranslationUnit(unit.tu);
+                if (unit.index)
+                    clang_disposeIndex(unit.index);
+            })
+{
+}
+
+/*!
+  \internal
+  \class TranslationUnitPool
+
+  Keeps the translation units of source files after they are visited,
+  so that the next run in watch mode reparses them with
+  clang_reparseTranslationUnit() instead of parsing them from scratch.
+  Reparsing reads the files that changed again, and reuses the
+  precompiled preamble of the unit if it has one. A unit is only
+  reused with the arguments it was parsed with.
+
+  The number of units kept is bounded. Once the pool is full, further
+  units are disposed of as usual, so the same files benefit in every
+  run.
+ */
+class TranslationUnitPool
+{
+public:
+    TranslationUnitPool() = default;
+    ~TranslationUnitPool();
+
+    [[nodiscard]] bool contains(const QString &filePath) const
+    {
+        return m_units.contains(filePath);
+    }
+    bool take(const QString &filePath, const QList<QByteArray> &args, CXIndex *index,
+              CXTranslationUnit *tu);
+    bool keep(const QString &filePath, const QList<QByteArray> &args, CXIndex index,
+              CXTranslationUnit tu);
+
+private:
+    struct Unit
+    {
+        QList<QByteArray> args;
+        CXIndex index = nullptr;
+        CXTranslationUnit tu = nullptr;
+    };
+
+    QHash<QString, Unit> m_units;
+};
+
+TranslationUnitPool::~TranslationUnitPool()
+{
+    for (const Unit &unit : qAsConst(m_units)) {
+        clang_disposeTranslationUnit(unit.tu);
+        clang_disposeIndex(unit.index);
+    }
+}
+
+/*!
+  Reparses the translation unit of \a filePath, if the pool has one
+  that was parsed with \a args, and passes it with its index to the
+  caller, who is responsible for disposing of them or for keeping them
+  again. Returns \c false if there is no such unit or reparsing it fails.
+ */
+bool TranslationUnitPool::take(const QString &filePath, const QList<QByteArray> &args,
+                               CXIndex *index, CXTranslationUnit *tu)
+{
+    const auto it = m_units.constFind(filePath);
+    if (it == m_units.cend())
+        return false;
+    const Unit unit = *it;
+    m_units.erase(it);
+    if (unit.args != args
+        || clang_reparseTranslationUnit(unit.tu, 0, nullptr,
+                                        clang_defaultReparseOptions(unit.tu)) != 0) {
+        // A unit that failed to reparse is invalid and can only be disposed of.
+        clang_disposeTranslationUnit(unit.tu);
+        clang_disposeIndex(unit.index);
+        return false;
+    }
+    *index = unit.index;
+    *tu = unit.tu;
+    return true;
+}
+
+/*!
+  Keeps the translation unit \a tu of \a filePath, parsed with \a args,
+  and its \a index. Returns \c false if the pool is full, in which case
+  the caller disposes of them.
+ */
+bool TranslationUnitPool::keep(const QString &filePath, const QList<QByteArray> &args,
+                               CXIndex index, CXTranslationUnit tu)
+{
+    if (m_units.size() >= kMaxPooledTranslationUnits || m_units.contains(filePath))
+        return false;
+    m_units.insert(filePath, { args, index, tu });
+    return true;
+}
+
 /*!
    Call clang_visitChildren on the given cursor with the lambda as a callback
    T can be any functor that is callable with a CXCursor parameter and returns a CXChildVisitResult
@@ -282,18 +451,17 @@ static Node *findNodeForCursor(QDocDatabase *qdb, CXCursor cur)
     case CXCursor_Constructor:
     case CXCursor_Destructor:
     case CXCursor_ConversionFunction: {
-        NodeVector candidates;
-        parent->findChildren(functionName(cur), candidates);
+        const auto &candidates = parent->overloadSignatures(functionName(cur));
         if (candidates.isEmpty())
             return nullptr;
         CXType funcType = clang_getCursorType(cur);
         auto numArg = clang_getNumArgTypes(funcType);
         bool isVariadic = clang_isFunctionTypeVariadic(funcType);
         QVarLengthArray<QString, 20> args;
-        for (Node *candidate : qAsConst(candidates)) {
-            if (!candidate->isFunction(Node::CPP))
+        for (const auto &candidate : candidates) {
+            auto fn = candidate.function;
+            if (!fn->isFunction(Node::CPP))
                 continue;
-            auto fn = static_cast<FunctionNode *>(candidate);
             const Parameters &parameters = fn->parameters();
             if (parameters.count() != numArg + isVariadic)
                 continue;
@@ -310,17 +478,10 @@ static Node *findNodeForCursor(QDocDatabase *qdb, CXCursor cur)
             for (int i = 0; i < numArg; ++i) {
                 CXType argType = clang_getArgType(funcType, i);
                 if (args.size() <= i)
-                    args.append(fromCXString(clang_getTypeSpelling(argType)));
-                QString recordedType = parameters.at(i).type();
-                QString typeSpelling = args.at(i);
-                auto p = parent;
-                while (p && recordedType != typeSpelling) {
-                    QString parentScope = p->name() + QLatin1String("::");
-                    recordedType.remove(parentScope);
-                    typeSpelling.remove(parentScope);
-                    p = p->parent();
-                }
-                different = recordedType != typeSpelling;
+                    args.append(parent->normalizeType(fromCXString(clang_getTypeSpelling(argType))));
+                // Removing the scopes from both types until they match gives
+                // the same result as comparing them with all scopes removed.
+                different = candidate.normalizedTypes.at(i) != args.at(i);
 
                 // Retry with a canonical type spelling
                 if (different && (argType.kind == CXType_Typedef || argType.kind == CXType_Elaborated)) {
@@ -1015,6 +1176,25 @@ bool ClangVisitor::parseProperty(const QString &spelling, const Location &loc)
     return true;
 }
 
+/*!
+  Returns true if \a cursor is the definition of a function, whose body
+  is skipped when the source file is parsed.
+ */
+static bool isFunctionDefinition(CXCursor cursor)
+{
+    switch (clang_getCursorKind(cursor)) {
+    case CXCursor_FunctionDecl:
+    case CXCursor_CXXMethod:
+    case CXCursor_Constructor:
+    case CXCursor_Destructor:
+    case CXCursor_ConversionFunction:
+    case CXCursor_FunctionTemplate:
+        return clang_isCursorDefinition(cursor);
+    default:
+        return false;
+    }
+}
+
 /*!
   Given a comment at location \a loc, return a Node for this comment
   \a nextCommentLoc is the location of the next comment so the declaration
@@ -1026,28 +1206,39 @@ Node *ClangVisitor::nodeForCommentAtLocation(CXSourceLocation loc, CXSourceLocat
     ClangVisitor::SimpleLoc docloc;
     clang_getPresumedLocation(loc, nullptr, &docloc.line, &docloc.column);
     auto decl_it = declMap_.upperBound(docloc);
-    if (decl_it == declMap_.end())
-        return nullptr;
-
-    unsigned int declLine = decl_it.key().line;
-    unsigned int nextCommentLine;
-    clang_getPresumedLocation(nextCommentLoc, nullptr, &nextCommentLine, nullptr);
-    if (nextCommentLine < declLine)
-        return nullptr; // there is another comment before the declaration, ignore it.
+    bool insideFunction = false;
 
     // make sure the previous decl was finished.
     if (decl_it != declMap_.begin()) {
-        CXSourceLocation prevDeclEnd = clang_getRangeEnd(clang_getCursorExtent(*(std::prev(decl_it))));
+        const auto prev_it = std::prev(decl_it);
+        CXSourceLocation prevDeclEnd = clang_getRangeEnd(clang_getCursorExtent(*prev_it));
         unsigned int prevDeclLine;
         clang_getPresumedLocation(prevDeclEnd, nullptr, &prevDeclLine, nullptr);
         if (prevDeclLine >= docloc.line) {
             // The previous declaration was still going. This is only valid if the previous
             // declaration is a parent of the next declaration.
-            auto parent = clang_getCursorLexicalParent(*decl_it);
-            if (!clang_equalCursors(parent, *(std::prev(decl_it))))
-                return nullptr;
+            if (decl_it == declMap_.end()
+                || !clang_equalCursors(clang_getCursorLexicalParent(*decl_it), *prev_it)) {
+                // Function bodies are skipped, so a comment inside one has
+                // no declaration of its own; it documents the function.
+                if (!isFunctionDefinition(*prev_it))
+                    return nullptr;
+                decl_it = prev_it;
+                insideFunction = true;
+            }
         }
     }
+    if (decl_it == declMap_.end())
+        return nullptr;
+
+    if (!insideFunction) {
+        unsigned int declLine = decl_it.key().line;
+        unsigned int nextCommentLine;
+        clang_getPresumedLocation(nextCommentLoc, nullptr, &nextCommentLine, nullptr);
+        if (nextCommentLine < declLine)
+            return nullptr; // there is another comment before the declaration, ignore it.
+    }
+
     auto *node = findNodeForCursor(qdb_, *decl_it);
     // borrow the parameter name from the definition
     if (node && node->isFunction(Node::CPP))
@@ -1081,6 +1272,7 @@ void ClangCodeParser::initializeParser()
                          m_includePaths.end());
     CppCodeParser::initializeParser();
     m_pchFileDir.reset(nullptr);
+    m_pchDir.clear();
     m_allHeaders.clear();
     m_pchName.clear();
     m_defines.clear();
@@ -1107,14 +1299,37 @@ void ClangCodeParser::initializeParser()
             }
         }
     }
+
+    int flags = CXTranslationUnit_Incomplete | CXTranslationUnit_SkipFunctionBodies;
+    if (QVariant(config.getString(CONFIG_CLANGKEEPGOING, QStringLiteral("true"))).toBool())
+        flags |= CXTranslationUnit_KeepGoing;
+    // A precompiled preamble only pays off when the units are reparsed.
+    const QString preambleDefault = config.watching() ? QStringLiteral("true") : QString();
+    if (QVariant(config.getString(CONFIG_CLANGPREAMBLE, preambleDefault)).toBool()) {
+        flags |= CXTranslationUnit_CreatePreambleOnFirstParse
+                | CXTranslationUnit_PrecompiledPreamble;
+    }
+    sourceFileFlags_ = static_cast<CXTranslationUnit_Flags>(flags);
+    if (config.watching() && !m_unitPool)
+        m_unitPool = std::make_unique<TranslationUnitPool>();
+
     qCDebug(lcQdoc).nospace() << __FUNCTION__ << " Clang v" << CINDEX_VERSION_MAJOR << '.'
                               << CINDEX_VERSION_MINOR;
 }
 
+ClangCodeParser::ClangCodeParser() = default;
+
+ClangCodeParser::~ClangCodeParser() = default;
+
 /*!
  */
 void ClangCodeParser::terminateParser()
 {
+    m_prefetcher.reset();
+    if (!m_unsharedPchFile.isEmpty()) {
+        QFile::remove(m_unsharedPchFile);
+        m_unsharedPchFile.clear();
+    }
     CppCodeParser::terminateParser();
 }
 
@@ -1240,137 +1455,334 @@ void ClangCodeParser::getMoreArgs()
     }
 }
 
+/*!
+  Returns the directory in which pre-compiled headers are kept between
+  qdoc runs: the \c QDOC_PCH_CACHE_DIR environment variable or the
+  \c pchcachedir configuration variable, in that order. Returns an
+  empty string if neither is set, and the cache is not used.
+ */
+static QString pchCacheDirectory()
+{
+    QString dir = qEnvironmentVariable("QDOC_PCH_CACHE_DIR");
+    if (dir.isEmpty())
+        dir = Config::instance().getString(CONFIG_PCHCACHEDIR);
+    return dir.isEmpty() ? dir : QDir(dir).absolutePath();
+}
+
+/*!
+  Removes the subdirectories of the PCH cache directory \a cacheDir,
+  other than \a keepDir, that no qdoc run used for 30 days. A run that
+  reuses a PCH updates the modification time of its dependency file.
+ */
+static void prunePchCache(const QString &cacheDir, const QString &keepDir)
+{
+    const QDateTime expiry = QDateTime::currentDateTimeUtc().addDays(-30);
+    const QFileInfoList entries =
+            QDir(cacheDir).entryInfoList(QDir::Dirs | QDir::NoDotAndDotDot);
+    for (const QFileInfo &entry : entries) {
+        if (entry.absoluteFilePath() == QDir(keepDir).absolutePath())
+            continue;
+        QDateTime lastUsed = entry.lastModified();
+        const QFileInfoList files = QDir(entry.absoluteFilePath()).entryInfoList(QDir::Files);
+        for (const QFileInfo &file : files)
+            lastUsed = std::max(lastUsed, file.lastModified());
+        if (lastUsed < expiry) {
+            qCDebug(lcQdoc) << "Removing unused PCH cache directory" << entry.absoluteFilePath();
+            QDir(entry.absoluteFilePath()).removeRecursively();
+        }
+    }
+}
+
+/*!
+  Replaces \a newName, if it exists, with \a oldName in a single step,
+  so that other qdoc runs see either the old file or the new one.
+  Returns \c true on success.
+ */
+static bool replaceFile(const QString &oldName, const QString &newName)
+{
+    std::error_code error;
+    std::filesystem::rename(std::filesystem::path(oldName.toStdU16String()),
+                            std::filesystem::path(newName.toStdU16String()), error);
+    return !error;
+}
+
+/*!
+  Writes the size, modification time and path of each file included
+  by \a tu, and of its main file, to \a fileName.
+ */
+static bool writePchDependencies(CXTranslationUnit tu, const QString &fileName)
+{
+    QStringList files;
+    clang_getInclusions(
+            tu,
+            [](CXFile file, CXSourceLocation *, unsigned, CXClientData data) {
+                CXString name = clang_getFileName(file);
+                static_cast<QStringList *>(data)->append(QString::fromUtf8(clang_getCString(name)));
+                clang_disposeString(name);
+            },
+            &files);
+    files.removeDuplicates();
+
+    QFile out(fileName);
+    if (!out.open(QIODevice::WriteOnly | QIODevice::Truncate | QIODevice::Text))
+        return false;
+    QTextStream stream(&out);
+    for (const QString &file : qAsConst(files)) {
+        const QFileInfo info(file);
+        stream << info.size() << ' ' << info.lastModified().toMSecsSinceEpoch() << ' ' << file
+               << '\n';
+    }
+    return true;
+}
+
+/*!
+  Returns \c true if all the files listed in \a fileName by
+  writePchDependencies() still have the same size and modification
+  time.
+ */
+static bool pchDependenciesUnchanged(const QString &fileName)
+{
+    QFile in(fileName);
+    if (!in.open(QIODevice::ReadOnly | QIODevice::Text))
+        return false;
+    QTextStream stream(&in);
+    bool empty = true;
+    QString line;
+    while (stream.readLineInto(&line)) {
+        const qsizetype sizeEnd = line.indexOf(QLatin1Char(' '));
+        const qsizetype timeEnd = line.indexOf(QLatin1Char(' '), sizeEnd + 1);
+        if (sizeEnd < 0 || timeEnd < 0)
+            return false;
+        const QFileInfo info(line.mid(timeEnd + 1));
+        if (!info.exists() || info.size() != QStringView(line).left(sizeEnd).toLongLong()
+            || info.lastModified().toMSecsSinceEpoch()
+                    != QStringView(line).mid(sizeEnd + 1, timeEnd - sizeEnd - 1).toLongLong()) {
+            return false;
+        }
+        empty = false;
+    }
+    return !empty;
+}
+
 /*!
   Building the PCH must be possible when there are no .cpp
   files, so it is moved here to its own member function, and
   it is called after the list of header files is complete.
+
+  If pchCacheDirectory() is set, the PCH is kept there, in a
+  subdirectory named after the module header and a hash of the header
+  text, the compiler arguments and the version of Clang. A later run,
+  such as the \c -generate run following the \c -prepare run, reuses
+  it if none of the files it was built from changed since. In watch
+  mode without pchCacheDirectory(), a temporary directory kept until
+  qdoc exits is used the same way. Otherwise, or if the cache
+  directory cannot be created, the PCH is built in a temporary
+  directory.
  */
 void ClangCodeParser::buildPCH()
 {
-    if (!m_pchFileDir && !moduleHeader().isEmpty()) {
-        m_pchFileDir.reset(new QTemporaryDir(QDir::tempPath() + QLatin1String("/qdoc_pch")));
-        if (m_pchFileDir->isValid()) {
-            const QByteArray module = moduleHeader().toUtf8();
-            QByteArray header;
-            QByteArray privateHeaderDir;
-            qCDebug(lcQdoc) << "Build and visit PCH for" << moduleHeader();
-            // A predicate for std::find_if() to locate a path to the module's header
-            // (e.g. QtGui/QtGui) to be used as pre-compiled header
-            struct FindPredicate
-            {
-                enum SearchType { Any, Module, Private };
-                QByteArray &candidate_;
-                const QByteArray &module_;
-                SearchType type_;
-                FindPredicate(QByteArray &candidate, const QByteArray &module,
-                              SearchType type = Any)
-                    : candidate_(candidate), module_(module), type_(type)
-                {
-                }
+    if (!m_pchDir.isEmpty() || moduleHeader().isEmpty())
+        return;
 
-                bool operator()(const QByteArray &p) const
-                {
-                    if (type_ != Any && !p.endsWith(module_))
-                        return false;
-                    candidate_ = p + "/";
-                    switch (type_) {
-                    case Any:
-                    case Module:
-                        candidate_.append(module_);
-                        break;
-                    case Private:
-                        candidate_.append("private");
-                        break;
-                    default:
-                        break;
-                    }
-                    if (p.startsWith("-I"))
-                        candidate_ = candidate_.mid(2);
-                    return QFile::exists(QString::fromUtf8(candidate_));
-                }
-            };
-
-            // First, search for an include path that contains the module name, then any path
-            QByteArray candidate;
-            auto it = std::find_if(m_includePaths.begin(), m_includePaths.end(),
-                                   FindPredicate(candidate, module, FindPredicate::Module));
-            if (it == m_includePaths.end())
-                it = std::find_if(m_includePaths.begin(), m_includePaths.end(),
-                                  FindPredicate(candidate, module, FindPredicate::Any));
-            if (it != m_includePaths.end())
-                header = candidate;
-
-            // Find the path to module's private headers - currently unused
-            it = std::find_if(m_includePaths.begin(), m_includePaths.end(),
-                              FindPredicate(candidate, module, FindPredicate::Private));
-            if (it != m_includePaths.end())
-                privateHeaderDir = candidate;
-
-            if (header.isEmpty()) {
-                qWarning() << "(qdoc) Could not find the module header in include paths for module"
-                           << module << "  (include paths: " << m_includePaths << ")";
-                qWarning() << "       Artificial module header built from header dirs in qdocconf "
-                              "file";
+    const QByteArray module = moduleHeader().toUtf8();
+    QByteArray header;
+    QByteArray privateHeaderDir;
+    qCDebug(lcQdoc) << "Build and visit PCH for" << moduleHeader();
+    // A predicate for std::find_if() to locate a path to the module's header
+    // (e.g. QtGui/QtGui) to be used as pre-compiled header
+    struct FindPredicate
+    {
+        enum SearchType { Any, Module, Private };
+        QByteArray &candidate_;
+        const QByteArray &module_;
+        SearchType type_;
+        FindPredicate(QByteArray &candidate, const QByteArray &module,
+                      SearchType type = Any)
+            : candidate_(candidate), module_(module), type_(type)
+        {
+        }
+
+        bool operator()(const QByteArray &p) const
+        {
+            if (type_ != Any && !p.endsWith(module_))
+                return false;
+            candidate_ = p + "/";
+            switch (type_) {
+            case Any:
+            case Module:
+                candidate_.append(module_);
+                break;
+            case Private:
+                candidate_.append("private");
+                break;
+            default:
+                break;
             }
-            m_args.push_back("-xc++");
-            CXTranslationUnit tu;
-            QString tmpHeader = m_pchFileDir->path() + "/" + module;
-            QFile tmpHeaderFile(tmpHeader);
-            if (tmpHeaderFile.open(QIODevice::Text | QIODevice::WriteOnly)) {
-                QTextStream out(&tmpHeaderFile);
-                if (header.isEmpty()) {
-                    for (auto it = m_allHeaders.constKeyValueBegin();
-                         it != m_allHeaders.constKeyValueEnd(); ++it) {
-                        if (!(*it).first.endsWith(QLatin1String("_p.h"))
-                            && !(*it).first.startsWith(QLatin1String("moc_"))) {
-                            QString line = QLatin1String("#include \"") + (*it).second
-                                    + QLatin1String("/") + (*it).first + QLatin1String("\"");
-                            out << line << "\n";
-                        }
-                    }
-                } else {
-                    QFileInfo headerFile(header);
-                    if (!headerFile.exists()) {
-                        qWarning() << "Could not find module header file" << header;
-                        return;
-                    }
-                    out << QLatin1String("#include \"") + header + QLatin1String("\"");
-                }
-                tmpHeaderFile.close();
+            if (p.startsWith("-I"))
+                candidate_ = candidate_.mid(2);
+            return QFile::exists(QString::fromUtf8(candidate_));
+        }
+    };
+
+    // First, search for an include path that contains the module name, then any path
+    QByteArray candidate;
+    auto it = std::find_if(m_includePaths.begin(), m_includePaths.end(),
+                           FindPredicate(candidate, module, FindPredicate::Module));
+    if (it == m_includePaths.end())
+        it = std::find_if(m_includePaths.begin(), m_includePaths.end(),
+                          FindPredicate(candidate, module, FindPredicate::Any));
+    if (it != m_includePaths.end())
+        header = candidate;
+
+    // Find the path to module's private headers - currently unused
+    it = std::find_if(m_includePaths.begin(), m_includePaths.end(),
+                      FindPredicate(candidate, module, FindPredicate::Private));
+    if (it != m_includePaths.end())
+        privateHeaderDir = candidate;
+
+    if (header.isEmpty()) {
+        qWarning() << "(qdoc) Could not find the module header in include paths for module"
+                   << module << "  (include paths: " << m_includePaths << ")";
+        qWarning() << "       Artificial module header built from header dirs in qdocconf "
+                      "file";
+    }
+
+    QByteArray headerText;
+    if (header.isEmpty()) {
+        // Sorted, so that the text, and the cache key, is the same in every run
+        QStringList lines;
+        for (auto it = m_allHeaders.constKeyValueBegin(); it != m_allHeaders.constKeyValueEnd();
+             ++it) {
+            if (!(*it).first.endsWith(QLatin1String("_p.h"))
+                && !(*it).first.startsWith(QLatin1String("moc_"))) {
+                lines << QLatin1String("#include \"") + (*it).second + QLatin1String("/")
+                                + (*it).first + QLatin1String("\"\n");
             }
+        }
+        lines.sort();
+        headerText = lines.join(QString()).toUtf8();
+    } else {
+        QFileInfo headerFile(header);
+        if (!headerFile.exists()) {
+            qWarning() << "Could not find module header file" << header;
+            return;
+        }
+        headerText = "#include \"" + header + "\"";
+    }
 
-            CXErrorCode err =
-                    clang_parseTranslationUnit2(index_, tmpHeader.toLatin1().data(), m_args.data(),
-                                                static_cast<int>(m_args.size()), nullptr, 0,
-                                                flags_ | CXTranslationUnit_ForSerialization, &tu);
-            qCDebug(lcQdoc) << __FUNCTION__ << "clang_parseTranslationUnit2(" << tmpHeader << m_args
-                            << ") returns" << err;
-
-            printDiagnostics(tu);
-
-            if (!err && tu) {
-                m_pchName = m_pchFileDir->path().toUtf8() + "/" + module + ".pch";
-                auto error = clang_saveTranslationUnit(tu, m_pchName.constData(),
-                                                       clang_defaultSaveOptions(tu));
-                if (error) {
-                    qCCritical(lcQdoc) << "Could not save PCH file for" << moduleHeader();
-                    m_pchName.clear();
-                } else {
-                    // Visit the header now, as token from pre-compiled header won't be visited
-                    // later
-                    CXCursor cur = clang_getTranslationUnitCursor(tu);
-                    ClangVisitor visitor(m_qdb, m_allHeaders);
-                    visitor.visitChildren(cur);
-                    qCDebug(lcQdoc) << "PCH built and visited for" << moduleHeader();
-                }
+    m_args.push_back("-xc++");
+
+    QCryptographicHash hash(QCryptographicHash::Sha1);
+    CXString clangVersion = clang_getClangVersion();
+    hash.addData(QByteArrayView(clang_getCString(clangVersion)));
+    clang_disposeString(clangVersion);
+    hash.addData(QByteArray::number(flags_));
+    hash.addData(headerText);
+    for (const char *arg : m_args)
+        hash.addData(QByteArrayView(arg, qstrlen(arg) + 1));
+
+    QString cacheDir = pchCacheDirectory();
+    if (cacheDir.isEmpty() && Config::instance().watching()) {
+        // Keep the PCH for the next run in watch mode
+        if (!m_watchPchDir)
+            m_watchPchDir.reset(new QTemporaryDir(QDir::tempPath() + QLatin1String("/qdoc_pch")));
+        if (m_watchPchDir->isValid())
+            cacheDir = m_watchPchDir->path();
+    }
+    m_pchDir = cacheDir + QLatin1Char('/') + moduleHeader() + QLatin1Char('-')
+            + QString::fromLatin1(hash.result().toHex().left(16));
+    if (cacheDir.isEmpty() || !QDir().mkpath(m_pchDir)) {
+        qCDebug(lcQdoc) << "Could not create the PCH cache directory" << m_pchDir;
+        m_pchFileDir.reset(new QTemporaryDir(QDir::tempPath() + QLatin1String("/qdoc_pch")));
+        if (!m_pchFileDir->isValid()) {
+            m_args.pop_back(); // remove the "-xc++";
+            return;
+        }
+        m_pchDir = m_pchFileDir->path();
+    }
+
+    const auto visitPch = [this](CXTranslationUnit tu) {
+        // Visit the header now, as token from pre-compiled header won't be visited
+        // later
+        CXCursor cur = clang_getTranslationUnitCursor(tu);
+        ClangVisitor visitor(m_qdb, m_allHeaders);
+        visitor.visitChildren(cur);
+    };
+
+    const QString pchFile = m_pchDir + QLatin1Char('/') + moduleHeader() + QLatin1String(".pch");
+    const QString dependenciesFile = pchFile + QLatin1String(".deps");
+    CXTranslationUnit tu = nullptr;
+    if (QFile::exists(pchFile) && pchDependenciesUnchanged(dependenciesFile)
+        && clang_createTranslationUnit2(index_, pchFile.toUtf8().constData(), &tu) == CXError_Success
+        && tu) {
+        m_pchName = pchFile.toUtf8();
+        // Mark the PCH as used, so that it is not pruned
+        QFile dependencies(dependenciesFile);
+        if (dependencies.open(QIODevice::Append))
+            dependencies.setFileTime(QDateTime::currentDateTime(), QFileDevice::FileModificationTime);
+        visitPch(tu);
+        qCDebug(lcQdoc) << "Cached PCH" << pchFile << "visited for" << moduleHeader();
+        clang_disposeTranslationUnit(tu);
+        m_args.pop_back(); // remove the "-xc++";
+        return;
+    }
+    if (tu)
+        clang_disposeTranslationUnit(tu);
+    if (!m_pchFileDir)
+        prunePchCache(cacheDir, m_pchDir);
+
+    // The PCH records the modification time of the header; only write it if it changed
+    const QString tmpHeader = m_pchDir + QLatin1Char('/') + moduleHeader();
+    QFile tmpHeaderFile(tmpHeader);
+    if (!tmpHeaderFile.open(QIODevice::ReadOnly) || tmpHeaderFile.readAll() != headerText) {
+        tmpHeaderFile.close();
+        if (tmpHeaderFile.open(QIODevice::WriteOnly | QIODevice::Truncate))
+            tmpHeaderFile.write(headerText);
+    }
+    tmpHeaderFile.close();
+    // A PCH without dependencies is never reused, even if a concurrent run renames it into place
+    QFile::remove(dependenciesFile);
+
+    CXErrorCode err =
+            clang_parseTranslationUnit2(index_, tmpHeader.toLatin1().data(), m_args.data(),
+                                        static_cast<int>(m_args.size()), nullptr, 0,
+                                        flags_ | CXTranslationUnit_ForSerialization, &tu);
+    qCDebug(lcQdoc) << __FUNCTION__ << "clang_parseTranslationUnit2(" << tmpHeader << m_args
+                    << ") returns" << err;
+
+    printDiagnostics(tu);
+
+    if (!err && tu) {
+        // Save under a name of our own first, so that other runs only
+        // ever see complete PCH files.
+        const QString savedFile = pchFile + QLatin1String(".tmp")
+                + QString::number(QCoreApplication::applicationPid());
+        auto error = clang_saveTranslationUnit(tu, savedFile.toUtf8().constData(),
+                                               clang_defaultSaveOptions(tu));
+        if (error) {
+            qCCritical(lcQdoc) << "Could not save PCH file for" << moduleHeader();
+            QFile::remove(savedFile);
+        } else {
+            if (replaceFile(savedFile, pchFile)) {
+                m_pchName = pchFile.toUtf8();
+                if (!writePchDependencies(tu, dependenciesFile))
+                    qCDebug(lcQdoc) << "Could not write" << dependenciesFile;
             } else {
-                m_pchFileDir->remove();
-                qCCritical(lcQdoc) << "Could not create PCH file for " << moduleHeader();
+                // The cached PCH is in use by another run; use ours for
+                // this one only, and remove it in terminateParser()
+                m_pchName = savedFile.toUtf8();
+                m_unsharedPchFile = savedFile;
             }
-            clang_disposeTranslationUnit(tu);
-            m_args.pop_back(); // remove the "-xc++";
+            visitPch(tu);
+            qCDebug(lcQdoc) << "PCH built and visited for" << moduleHeader();
         }
+    } else {
+        if (m_pchFileDir)
+            m_pchFileDir->remove();
+        qCCritical(lcQdoc) << "Could not create PCH file for " << moduleHeader();
     }
+    clang_disposeTranslationUnit(tu);
+    m_args.pop_back(); // remove the "-xc++";
 }
 
 /*!
@@ -1393,6 +1805,59 @@ void ClangCodeParser::precompileHeaders()
     clang_disposeIndex(index_);
 }
 
+/*!
+  Load the arguments for parsing the source file \a filePath into
+  \a m_args.
+ */
+void ClangCodeParser::getSourceFileArgs(const QString &filePath)
+{
+    getDefaultArgs();
+    if (!m_pchName.isEmpty() && !filePath.endsWith(".mm")) {
+        m_args.push_back("-w");
+        m_args.push_back("-include-pch");
+        m_args.push_back(m_pchName.constData());
+    }
+    getMoreArgs();
+    for (const auto &p : qAsConst(m_moreArgs))
+        m_args.push_back(p.constData());
+}
+
+/*!
+  Start parsing the source files in \a filePaths on worker threads.
+  parseSourceFile() takes the translation units from them as they
+  become ready, so the files should be passed to it in the same order.
+  Files that are not in the list are parsed by parseSourceFile()
+  itself.
+
+  Must be called after precompileHeaders().
+ */
+void ClangCodeParser::parseSourceFilesAhead(const QStringList &filePaths)
+{
+    m_prefetcher.reset();
+    if (filePaths.isEmpty() || Utilities::threadCount() == 1)
+        return;
+
+    // The workers keep their own copies of the arguments.
+    const auto argList = [this](const QString &filePath) {
+        getSourceFileArgs(filePath);
+        QList<QByteArray> list;
+        list.reserve(static_cast<qsizetype>(m_args.size()));
+        for (const char *arg : m_args)
+            list.append(QByteArray(arg));
+        return list;
+    };
+    const QList<QByteArray> args = argList(QStringLiteral("source.cpp"));
+    const QList<QByteArray> mmArgs = argList(QStringLiteral("source.mm"));
+    // The files kept from the previous run in watch mode are reparsed instead.
+    QStringList filesToParse = filePaths;
+    if (m_unitPool) {
+        filesToParse.removeIf([this](const QString &filePath) {
+            return m_unitPool->contains(filePath);
+        });
+    }
+    m_prefetcher = std::make_unique<TranslationUnitPrefetcher>(filesToParse, args, mmArgs);
+}
+
 static float getUnpatchedVersion(QString t)
 {
     if (t.count(QChar('.')) > 1)
@@ -1415,26 +1880,32 @@ void ClangCodeParser::parseSourceFile(const Location & /*location*/, const QStri
      */
     m_qdb->clearOpenNamespaces();
     m_currentFile = filePath;
-    flags_ = static_cast<CXTranslationUnit_Flags>(CXTranslationUnit_Incomplete
-                                                  | CXTranslationUnit_SkipFunctionBodies
-                                                  | CXTranslationUnit_KeepGoing);
+    flags_ = sourceFileFlags_;
 
-    index_ = clang_createIndex(1, kClangDontDisplayDiagnostics);
+    getSourceFileArgs(filePath);
 
-    getDefaultArgs();
-    if (!m_pchName.isEmpty() && !filePath.endsWith(".mm")) {
-        m_args.push_back("-w");
-        m_args.push_back("-include-pch");
-        m_args.push_back(m_pchName.constData());
+    // The arguments and flags a unit kept for watch mode was parsed with.
+    QList<QByteArray> unitArgs;
+    if (m_unitPool) {
+        for (const char *arg : m_args)
+            unitArgs.append(QByteArray(arg));
+        unitArgs.append(QByteArray::number(sourceFileFlags_));
     }
-    getMoreArgs();
-    for (const auto &p : qAsConst(m_moreArgs))
-        m_args.push_back(p.constData());
 
-    CXTranslationUnit tu;
-    CXErrorCode err =
-            clang_parseTranslationUnit2(index_, filePath.toLocal8Bit(), m_args.data(),
-                                        static_cast<int>(m_args.size()), nullptr, 0, flags_, &tu);
+    CXTranslationUnit tu = nullptr;
+    CXErrorCode err = CXError_Success;
+    if (m_unitPool && m_unitPool->take(filePath, unitArgs, &index_, &tu)) {
+        qCDebug(lcQdoc) << "Reparsed the translation unit of" << filePath;
+    } else if (PrefetchedUnit unit; m_prefetcher && m_prefetcher->take(filePath, &unit)) {
+        index_ = unit.index;
+        tu = unit.tu;
+        err = unit.err;
+    } else {
+        index_ = clang_createIndex(1, kClangDontDisplayDiagnostics);
+        err = clang_parseTranslationUnit2(index_, filePath.toLocal8Bit(), m_args.data(),
+                                          static_cast<int>(m_args.size()), nullptr, 0, flags_,
+                                          &tu);
+    }
     qCDebug(lcQdoc) << __FUNCTION__ << "clang_parseTranslationUnit2(" << filePath << m_args
                     << ") returns" << err;
     printDiagnostics(tu);
@@ -1528,8 +1999,10 @@ void ClangCodeParser::parseSourceFile(const Location & /*location*/, const QStri
     }
 
     clang_disposeTokens(tu, tokens, numTokens);
-    clang_disposeTranslationUnit(tu);
-    clang_disposeIndex(index_);
+    if (!m_unitPool || !m_unitPool->keep(filePath, unitArgs, index_, tu)) {
+        clang_disposeTranslationUnit(tu);
+        clang_disposeIndex(index_);
+    }
     m_namespaceScope.clear();
     s_fn.clear();
 }
@@ -8,14 +8,20 @@
 
 #include <QtCore/qtemporarydir.h>
 
+#include <memory>
+
 typedef struct CXTranslationUnitImpl *CXTranslationUnit;
 
 QT_BEGIN_NAMESPACE
 
+class TranslationUnitPool;
+class TranslationUnitPrefetcher;
+
 class ClangCodeParser : public CppCodeParser
 {
 public:
-    ~ClangCodeParser() override = default;
+    ClangCodeParser();
+    ~ClangCodeParser() override;
 
     void initializeParser() override;
     void terminateParser() override;
@@ -25,12 +31,14 @@ public:
     void parseHeaderFile(const Location &location, const QString &filePath) override;
     void parseSourceFile(const Location &location, const QString &filePath) override;
     void precompileHeaders() override;
+    void parseSourceFilesAhead(const QStringList &filePaths);
     Node *parseFnArg(const Location &location, const QString &fnSignature, const QString &idTag) override;
     static const QByteArray &fn() { return s_fn; }
 
 private:
     void getDefaultArgs(); // FIXME: Clean up API
     void getMoreArgs(); // FIXME: Clean up API
+    void getSourceFileArgs(const QString &filePath);
 
     void buildPCH();
 
@@ -40,11 +48,16 @@ private:
     QMultiHash<QString, QString> m_allHeaders {}; // file name->path
     QList<QByteArray> m_includePaths {};
     QScopedPointer<QTemporaryDir> m_pchFileDir {};
+    QScopedPointer<QTemporaryDir> m_watchPchDir {};
+    QString m_pchDir {};
     QByteArray m_pchName {};
+    QString m_unsharedPchFile {};
     QList<QByteArray> m_defines {};
     std::vector<const char *> m_args {};
     QList<QByteArray> m_moreArgs {};
     QStringList m_namespaceScope {};
+    std::unique_ptr<TranslationUnitPrefetcher> m_prefetcher;
+    std::unique_ptr<TranslationUnitPool> m_unitPool;
     static QByteArray s_fn;
 };
 
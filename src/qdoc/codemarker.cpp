@@ -16,6 +16,10 @@ QT_BEGIN_NAMESPACE
 QString CodeMarker::s_defaultLang;
 QList<CodeMarker *> CodeMarker::s_markers;
 
+// The number of characters of code and markup a marker keeps in its
+// cache of marked-up code.
+static const qsizetype kMaxMarkUpCacheSize = 64 * 1024 * 1024;
+
 /*!
   When a code marker constructs itself, it puts itself into
   the static list of code markers. All the code markers in
@@ -389,4 +393,38 @@ QString CodeMarker::linkTag(const Node *node, const QString &body)
             + QLatin1String("</@link>");
 }
 
+/*!
+  Returns \a code marked up by \a markUp, which is only called if the
+  marker did not mark up the same code before. The same snippets are
+  quoted by many pages, and example files are marked up once for each
+  output format, so the result is kept in a cache of the marker, keyed
+  by the code. \a markUp sets its argument to \c false if the result
+  must not be reused, for instance because it reported a problem that
+  should be reported at the location of every copy.
+
+  The markup only depends on the code, so the cache is kept for the
+  lifetime of the marker, across the runs of qdoc in watch mode.
+ */
+QString CodeMarker::cachedMarkUp(const QString &code,
+                                 const std::function<QString(bool &)> &markUp)
+{
+    {
+        QReadLocker locker(&m_markUpCacheLock);
+        const auto it = m_markUpCache.constFind(code);
+        if (it != m_markUpCache.cend())
+            return *it;
+    }
+    bool cacheable = true;
+    QString markedUp = markUp(cacheable);
+    if (cacheable) {
+        QWriteLocker locker(&m_markUpCacheLock);
+        const qsizetype size = code.size() + markedUp.size();
+        if (m_markUpCacheSize + size <= kMaxMarkUpCacheSize && !m_markUpCache.contains(code)) {
+            m_markUpCache.insert(code, markedUp);
+            m_markUpCacheSize += size;
+        }
+    }
+    return markedUp;
+}
+
 QT_END_NAMESPACE
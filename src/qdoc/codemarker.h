@@ -7,6 +7,11 @@
 #include "atom.h"
 #include "sections.h"
 
+#include <QtCore/qhash.h>
+#include <QtCore/qreadwritelock.h>
+
+#include <functional>
+
 QT_BEGIN_NAMESPACE
 
 class CodeMarker
@@ -56,10 +61,15 @@ protected:
     QString taggedNode(const Node *node);
     QString taggedQmlNode(const Node *node);
     QString linkTag(const Node *node, const QString &body);
+    QString cachedMarkUp(const QString &code, const std::function<QString(bool &)> &markUp);
 
 private:
     static QString s_defaultLang;
     static QList<CodeMarker *> s_markers;
+
+    QHash<QString, QString> m_markUpCache {};
+    qsizetype m_markUpCacheSize { 0 };
+    QReadWriteLock m_markUpCacheLock {};
 };
 
 QT_END_NAMESPACE
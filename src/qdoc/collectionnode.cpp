@@ -22,6 +22,20 @@ void CollectionNode::addMember(Node *node)
         m_members.append(node);
 }
 
+/*!
+  Removes the members that belong to \a tree before the tree is
+  deleted. The collection is merged again the next time it is
+  needed, so that it picks up the members of the tree that replaces
+  \a tree.
+
+  \sa QDocForest::retireTree()
+ */
+void CollectionNode::removeMembers(const Tree *tree)
+{
+    m_members.removeIf([tree](const Node *member) { return member->tree() == tree; });
+    m_merged = false;
+}
+
 /*!
   Returns \c true if this collection node contains at least
   one namespace node.
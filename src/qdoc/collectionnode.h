@@ -25,6 +25,7 @@ public:
     [[nodiscard]] QString qtCMakeComponent() const override { return m_qtCMakeComponent; }
     void setQtCMakeComponent(const QString &target) override { m_qtCMakeComponent = target; }
     void addMember(Node *node) override;
+    void removeMembers(const Tree *tree);
     [[nodiscard]] bool hasNamespaces() const override;
     [[nodiscard]] bool hasClasses() const override;
     void getMemberNamespaces(NodeMap &out) override;
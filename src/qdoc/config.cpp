@@ -2,21 +2,30 @@
 // SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
 
 #include "config.h"
+#include "pagewriter.h"
 #include "utilities.h"
 
+#include <QtCore/qcryptographichash.h>
+#include <QtCore/qdatastream.h>
+#include <QtCore/qdatetime.h>
 #include <QtCore/qdir.h>
 #include <QtCore/qfile.h>
+#include <QtCore/qsavefile.h>
 #include <QtCore/qtemporaryfile.h>
 #include <QtCore/qtextstream.h>
 #include <QtCore/qvariant.h>
 #include <QtCore/qregularexpression.h>
 
+#include <algorithm>
+
 QT_BEGIN_NAMESPACE
 
 QString ConfigStrings::ALIAS = QStringLiteral("alias");
 QString ConfigStrings::AUTOLINKERRORS = QStringLiteral("autolinkerrors");
 QString ConfigStrings::BUILDVERSION = QStringLiteral("buildversion");
 QString ConfigStrings::CLANGDEFINES = QStringLiteral("clangdefines");
+QString ConfigStrings::CLANGKEEPGOING = QStringLiteral("clangkeepgoing");
+QString ConfigStrings::CLANGPREAMBLE = QStringLiteral("clangpreamble");
 QString ConfigStrings::CODEINDENT = QStringLiteral("codeindent");
 QString ConfigStrings::CODEPREFIX = QStringLiteral("codeprefix");
 QString ConfigStrings::CODESUFFIX = QStringLiteral("codesuffix");
@@ -48,6 +57,7 @@ QString ConfigStrings::IGNOREWORDS = QStringLiteral("ignorewords");
 QString ConfigStrings::IMAGEDIRS = QStringLiteral("imagedirs");
 QString ConfigStrings::IMAGES = QStringLiteral("images");
 QString ConfigStrings::INCLUDEPATHS = QStringLiteral("includepaths");
+QString ConfigStrings::INCREMENTAL = QStringLiteral("incremental");
 QString ConfigStrings::INCLUSIVE = QStringLiteral("inclusive");
 QString ConfigStrings::INDEXES = QStringLiteral("indexes");
 QString ConfigStrings::LANDINGPAGE = QStringLiteral("landingpage");
@@ -65,6 +75,7 @@ QString ConfigStrings::OUTPUTDIR = QStringLiteral("outputdir");
 QString ConfigStrings::OUTPUTFORMATS = QStringLiteral("outputformats");
 QString ConfigStrings::OUTPUTPREFIXES = QStringLiteral("outputprefixes");
 QString ConfigStrings::OUTPUTSUFFIXES = QStringLiteral("outputsuffixes");
+QString ConfigStrings::PCHCACHEDIR = QStringLiteral("pchcachedir");
 QString ConfigStrings::PROJECT = QStringLiteral("project");
 QString ConfigStrings::REDIRECTDOCUMENTATIONTODEVNULL =
         QStringLiteral("redirectdocumentationtodevnull");
@@ -259,6 +270,7 @@ void Config::clear()
     m_location = m_lastLocation = Location();
     m_configVars.clear();
     m_includeFilesMap.clear();
+    m_loadedFiles.clear();
 }
 
 /*!
@@ -293,6 +305,9 @@ void Config::reset()
     setListFlag(CONFIG_NOLINKERRORS,
                 m_parser.isSet(m_parser.noLinkErrorsOption)
                         || qEnvironmentVariableIsSet("QDOC_NOLINKERRORS"));
+    // In watch mode, only the pages that changed are written again
+    setListFlag(CONFIG_INCREMENTAL,
+                m_parser.isSet(m_parser.incrementalOption) || m_parser.isSet(m_parser.watchOption));
 
     // CONFIG_DEFINES and CONFIG_INCLUDEPATHS are set in load()
 }
@@ -403,11 +418,36 @@ void Config::processCommandLineOptions(const QStringList &args)
     m_atomsDump = m_parser.isSet(m_parser.atomsDumpOption);
     m_showInternal = m_parser.isSet(m_parser.showInternalOption)
             || qEnvironmentVariableIsSet("QDOC_SHOW_INTERNAL");
+    if (m_parser.isSet(m_parser.timingsOption))
+        m_timingsFile = m_parser.value(m_parser.timingsOption);
+    m_watching = m_parser.isSet(m_parser.watchOption);
 
     if (m_parser.isSet(m_parser.prepareOption))
         m_qdocPass = Prepare;
     if (m_parser.isSet(m_parser.generateOption))
         m_qdocPass = Generate;
+    if (m_parser.isSet(m_parser.shardOption)) {
+        const QStringList shard = m_parser.value(m_parser.shardOption).split(QLatin1Char('/'));
+        bool indexOk = false;
+        bool countOk = false;
+        if (shard.size() == 2) {
+            m_shardIndex = shard.at(0).toInt(&indexOk);
+            m_shardCount = shard.at(1).toInt(&countOk);
+        }
+        if (!indexOk || !countOk || m_shardIndex < 0 || m_shardIndex >= m_shardCount)
+            qFatal("The -shard option requires <index>/<count>, with 0 <= index < count");
+    }
+    if (m_parser.isSet(m_parser.mergeShardsOption)) {
+        if (m_shardCount > 0)
+            qFatal("The -shard and -merge-shards options cannot be used together");
+        bool ok = false;
+        m_shardCount = m_parser.value(m_parser.mergeShardsOption).toInt(&ok);
+        if (!ok || m_shardCount < 1)
+            qFatal("The -merge-shards option requires a positive number");
+        m_mergingShards = true;
+    }
+    if (m_shardCount > 0 && m_qdocPass != Generate)
+        qFatal("The -shard and -merge-shards options require -generate");
     if (m_parser.isSet(m_parser.logProgressOption))
         setStringList(CONFIG_LOGPROGRESS, QStringList("true"));
     if (m_parser.isSet(m_parser.timestampsOption))
@@ -952,6 +992,7 @@ QString Config::copyFile(const Location &location, const QString &sourceFilePath
                                  .arg(sourceFilePath, inFile.errorString()));
         return QString();
     }
+    inFile.close();
 
     // TODO: [non-canonical-representation]
     // Similar to other part of QDoc, we do a series of non-intuitive
@@ -993,28 +1034,13 @@ QString Config::copyFile(const Location &location, const QString &sourceFilePath
         outFileName = outFileNameInfo.fileName();
 
     outFileName = targetDirPath + "/" + outFileName;
-    QDir targetDir(targetDirPath);
-    if (!targetDir.exists())
-        targetDir.mkpath(".");
-
-    QFile outFile(outFileName);
-    if (!outFile.open(QFile::WriteOnly)) {
+    QString errorString;
+    if (!PageWriter::instance().copy(sourceFilePath, outFileName, &errorString)) {
         // TODO: [uncrentralized-warning]
         location.warning(QStringLiteral("Cannot open output file for copy: '%1': %2")
-                                 .arg(outFileName, outFile.errorString()));
+                                 .arg(outFileName, errorString));
         return QString();
     }
-
-    // TODO: There shouldn't be any particular advantage to copying
-    // the file by readying its content and writing it compared to
-    // asking the underlying system to do the copy for us.
-    // Consider simplifying this part by avoiding doing the manual
-    // work ourselves.
-
-    char buffer[1024];
-    qsizetype len;
-    while ((len = inFile.read(buffer, sizeof(buffer))) > 0)
-        outFile.write(buffer, len);
     return outFileName;
 }
 
@@ -1074,20 +1100,217 @@ QStringList Config::loadMaster(const QString &fileName)
     return qdocFiles;
 }
 
+/*
+  The statements of a qdoc configuration file, as parsed by
+  parseFile(): include statements, with the name of the included file,
+  and assignments, with values that are not expanded yet.
+
+  Parsing only depends on the contents of the file and on the
+  environment variables it refers to, so the result is kept, in
+  memory and in the configuration cache directory, together with the
+  size and modification time of the file and the values of those
+  variables. A qdocconf file included by many modules, such as the
+  global macros, is then only parsed once.
+ */
+struct Config::ParsedFile
+{
+    struct Statement
+    {
+        int lineNo;
+        int columnNo;
+        QString includeFile;
+        QStringList keys;
+        bool plus;
+        QStringList values;
+        QList<ExpandVar> expandVars;
+    };
+
+    qint64 size { -1 };
+    qint64 lastModified { -1 };
+    QList<std::pair<QString, QByteArray>> environment {};
+    QList<Statement> statements {};
+
+    [[nodiscard]] bool isUpToDate(const QFileInfo &fileInfo) const
+    {
+        if (size != fileInfo.size()
+            || lastModified != fileInfo.lastModified().toMSecsSinceEpoch()) {
+            return false;
+        }
+        return std::all_of(environment.cbegin(), environment.cend(), [](const auto &var) {
+            return qgetenv(var.first.toLatin1().constData()) == var.second
+                    && qEnvironmentVariableIsSet(var.first.toLatin1().constData())
+                    == !var.second.isNull();
+        });
+    }
+};
+
+static const quint32 s_configCacheMagic = 0x51444343; // "QDCC"
+static const quint32 s_configCacheVersion = 1;
+
+static QDataStream &operator<<(QDataStream &out, const ExpandVar &var)
+{
+    return out << var.m_valueIndex << var.m_index << var.m_var << var.m_delim;
+}
+
+static QDataStream &operator>>(QDataStream &in, ExpandVar &var)
+{
+    return in >> var.m_valueIndex >> var.m_index >> var.m_var >> var.m_delim;
+}
+
+static QDataStream &operator<<(QDataStream &out, const Config::ParsedFile::Statement &statement)
+{
+    return out << statement.lineNo << statement.columnNo << statement.includeFile
+               << statement.keys << statement.plus << statement.values << statement.expandVars;
+}
+
+static QDataStream &operator>>(QDataStream &in, Config::ParsedFile::Statement &statement)
+{
+    return in >> statement.lineNo >> statement.columnNo >> statement.includeFile
+              >> statement.keys >> statement.plus >> statement.values >> statement.expandVars;
+}
+
 /*!
-  Load, parse, and process a qdoc configuration file. This
-  function is only called by the other load() function, but
-  this one is recursive, i.e., it calls itself when it sees
-  an \c{include} statement in the qdoc configuration file.
+  Returns the path of the file in which the parsed contents of the
+  qdoc configuration file \a filePath are cached across qdoc runs, or
+  an empty string if there is no cache directory.
+
+  The directory is the one set with the \c QDOC_CONFIG_CACHE_DIR
+  environment variable; the cache is not used if it is not set.
  */
-void Config::load(Location location, const QString &fileName)
+static QString configCacheFile(const QString &filePath)
 {
-    QFileInfo fileInfo(fileName);
-    QString path = fileInfo.canonicalPath();
-    pushWorkingDir(path);
-    QDir::setCurrent(path);
+    const QString dir = qEnvironmentVariable("QDOC_CONFIG_CACHE_DIR");
+    if (dir.isEmpty())
+        return QString();
+    const QByteArray hash = QCryptographicHash::hash(filePath.toUtf8(), QCryptographicHash::Sha1);
+    return dir + QLatin1Char('/') + QString::fromLatin1(hash.toHex()) + QLatin1String(".cache");
+}
+
+/*!
+  Reads the parsed contents of the configuration file \a filePath from
+  \a cacheFile into \a parsed. Returns \c false if the cache file
+  does not exist or was written by another version of qdoc.
+ */
+static bool readConfigCache(const QString &cacheFile, const QString &filePath,
+                            Config::ParsedFile *parsed)
+{
+    QFile file(cacheFile);
+    if (!file.open(QIODevice::ReadOnly))
+        return false;
+    QDataStream in(&file);
+    in.setVersion(QDataStream::Qt_6_5);
+    quint32 magic = 0;
+    quint32 version = 0;
+    QString path;
+    in >> magic >> version;
+    if (magic != s_configCacheMagic || version != s_configCacheVersion)
+        return false;
+    in >> path >> parsed->size >> parsed->lastModified >> parsed->environment
+       >> parsed->statements;
+    return in.status() == QDataStream::Ok && path == filePath;
+}
+
+/*!
+  Removes the cache files in \a dir that no qdoc run used for 30 days,
+  such as those of configuration files that were moved or removed. A
+  run that reads a cache file updates its modification time.
+ */
+static void pruneConfigCache(const QString &dir)
+{
+    const QDateTime expiry = QDateTime::currentDateTimeUtc().addDays(-30);
+    const QFileInfoList entries =
+            QDir(dir).entryInfoList({ QStringLiteral("*.cache") }, QDir::Files);
+    for (const QFileInfo &entry : entries) {
+        if (entry.lastModified() < expiry)
+            QFile::remove(entry.absoluteFilePath());
+    }
+}
+
+/*!
+  Writes \a parsed, the parsed contents of the configuration file
+  \a filePath, to \a cacheFile. The first write of a qdoc run also
+  prunes the cache directory.
+ */
+static void writeConfigCache(const QString &cacheFile, const QString &filePath,
+                             const Config::ParsedFile &parsed)
+{
+    const QString dir = QFileInfo(cacheFile).path();
+    if (!QDir().mkpath(dir))
+        return;
+    static bool pruned = false;
+    if (!pruned) {
+        pruneConfigCache(dir);
+        pruned = true;
+    }
+    QSaveFile file(cacheFile);
+    if (!file.open(QIODevice::WriteOnly))
+        return;
+    QDataStream out(&file);
+    out.setVersion(QDataStream::Qt_6_5);
+    out << s_configCacheMagic << s_configCacheVersion << filePath << parsed.size
+        << parsed.lastModified << parsed.environment << parsed.statements;
+    file.commit();
+}
+
+/*!
+  Returns the statements of the qdoc configuration file \a fin,
+  opened at \a location, which has been pushed for the file.
+
+  The statements are taken from the configuration cache if the file
+  and the environment variables it uses did not change since it was
+  cached; otherwise the file is parsed and the cache updated.
+ */
+const Config::ParsedFile &Config::parsedFile(QFile &fin, Location &location)
+{
+    static QHash<QString, ParsedFile> parsedFiles;
+
+    const QFileInfo fileInfo(fin);
+    const QString filePath = fileInfo.absoluteFilePath();
+    auto it = parsedFiles.find(filePath);
+    if (it != parsedFiles.end() && it->isUpToDate(fileInfo))
+        return *it;
+
+    ParsedFile parsed;
+    const QString cacheFile = configCacheFile(filePath);
+    if (!cacheFile.isEmpty() && readConfigCache(cacheFile, filePath, &parsed)
+        && parsed.isUpToDate(fileInfo)) {
+        // Mark the cache file as used, so that it is not pruned
+        QFile used(cacheFile);
+        if (used.open(QIODevice::Append))
+            used.setFileTime(QDateTime::currentDateTime(), QFileDevice::FileModificationTime);
+        return *parsedFiles.insert(filePath, parsed);
+    }
+
+    parsed = ParsedFile();
+    parsed.size = fileInfo.size();
+    parsed.lastModified = fileInfo.lastModified().toMSecsSinceEpoch();
+    QTextStream stream(&fin);
+    QString text = stream.readAll();
+    text += QLatin1String("\n\n");
+    text += QLatin1Char('\0');
+    parseFile(text, location, &parsed);
+
+    if (!cacheFile.isEmpty())
+        writeConfigCache(cacheFile, filePath, parsed);
+    return *parsedFiles.insert(filePath, parsed);
+}
+
+/*!
+  Parses \a text, the contents of a qdoc configuration file, into the
+  statements of \a result, advancing \a location. Reports a fatal
+  error at \a location if the text is malformed.
+ */
+void Config::parseFile(QString text, Location &location, ParsedFile *result)
+{
+    ParsedFile &parsed = *result;
     QRegularExpression keySyntax(QRegularExpression::anchoredPattern(QLatin1String("\\w+(?:\\.\\w+)*")));
 
+    const auto environmentVariable = [&parsed](const QString &var) {
+        const QByteArray val = qgetenv(var.toLatin1().constData());
+        parsed.environment.append({ var, val });
+        return val;
+    };
+
 #define SKIP_CHAR()                                                                                \
     do {                                                                                           \
         location.advance(c);                                                                       \
@@ -1104,30 +1327,6 @@ void Config::load(Location location, const QString &fileName)
     word += c;                                                                                     \
     SKIP_CHAR();
 
-    if (location.depth() > 16)
-        location.fatal(QStringLiteral("Too many nested includes"));
-
-    QFile fin(fileInfo.fileName());
-    if (!fin.open(QFile::ReadOnly | QFile::Text)) {
-        if (!Config::installDir.isEmpty()) {
-            qsizetype prefix = location.filePath().length() - location.fileName().length();
-            fin.setFileName(Config::installDir + QLatin1Char('/')
-                            + fileName.right(fileName.length() - prefix));
-        }
-        if (!fin.open(QFile::ReadOnly | QFile::Text))
-            location.fatal(
-                    QStringLiteral("Cannot open file '%1': %2").arg(fileName, fin.errorString()));
-    }
-
-    QTextStream stream(&fin);
-    QString text = stream.readAll();
-    text += QLatin1String("\n\n");
-    text += QLatin1Char('\0');
-    fin.close();
-
-    location.push(fileName);
-    location.start();
-
     int i = 0;
     QChar c = text.at(0);
     uint cc = c.unicode();
@@ -1176,7 +1375,7 @@ void Config::load(Location location, const QString &fileName)
                             SKIP_CHAR();
                         }
                         if (!var.isEmpty()) {
-                            const QByteArray val = qgetenv(var.toLatin1().data());
+                            const QByteArray val = environmentVariable(var);
                             if (val.isNull()) {
                                 location.fatal(QStringLiteral("Environment variable '%1' undefined")
                                                        .arg(var));
@@ -1197,10 +1396,8 @@ void Config::load(Location location, const QString &fileName)
                 if (cc != '#' && cc != '\n')
                     location.fatal(QStringLiteral("Trailing garbage"));
 
-                /*
-                  Here is the recursive call.
-                 */
-                load(location, QFileInfo(QDir(path), includeFile).filePath());
+                parsed.statements.append(
+                        { keyLoc.lineNo(), keyLoc.columnNo(), includeFile, {}, false, {}, {} });
             } else {
                 /*
                   It wasn't an include statement, so it's something else.
@@ -1283,7 +1480,7 @@ void Config::load(Location location, const QString &fileName)
                                 location.fatal(QStringLiteral("Missing '}'"));
                         }
                         if (!var.isEmpty()) {
-                            const QByteArray val = qgetenv(var.toLatin1().constData());
+                            const QByteArray val = environmentVariable(var);
                             if (val.isNull()) {
                                 expandVars << ExpandVar(rhsValues.size(), word.size(), var, delim);
                                 needsExpansion = true;
@@ -1304,19 +1501,72 @@ void Config::load(Location location, const QString &fileName)
                 for (const auto &key : keys) {
                     if (!keySyntax.match(key).hasMatch())
                         keyLoc.fatal(QStringLiteral("Invalid key '%1'").arg(key));
-
-                    ConfigVar configVar(key, rhsValues, QDir::currentPath(), keyLoc, expandVars);
-                    if (plus && m_configVars.contains(key)) {
-                        m_configVars[key].append(configVar);
-                    } else {
-                        m_configVars.insert(key, configVar);
-                    }
                 }
+                parsed.statements.append({ keyLoc.lineNo(), keyLoc.columnNo(), QString(), keys,
+                                           plus, rhsValues, expandVars });
             }
         } else {
             location.fatal(QStringLiteral("Unexpected character '%1' at beginning of line").arg(c));
         }
     }
+}
+
+/*!
+  Load, parse, and process a qdoc configuration file. This
+  function is only called by the other load() function, but
+  this one is recursive, i.e., it calls itself when it sees
+  an \c{include} statement in the qdoc configuration file.
+ */
+void Config::load(Location location, const QString &fileName)
+{
+    QFileInfo fileInfo(fileName);
+    QString path = fileInfo.canonicalPath();
+    pushWorkingDir(path);
+    QDir::setCurrent(path);
+
+    if (location.depth() > 16)
+        location.fatal(QStringLiteral("Too many nested includes"));
+
+    QFile fin(fileInfo.fileName());
+    if (!fin.open(QFile::ReadOnly | QFile::Text)) {
+        if (!Config::installDir.isEmpty()) {
+            qsizetype prefix = location.filePath().length() - location.fileName().length();
+            fin.setFileName(Config::installDir + QLatin1Char('/')
+                            + fileName.right(fileName.length() - prefix));
+        }
+        if (!fin.open(QFile::ReadOnly | QFile::Text))
+            location.fatal(
+                    QStringLiteral("Cannot open file '%1': %2").arg(fileName, fin.errorString()));
+    }
+    m_loadedFiles << QFileInfo(fin).absoluteFilePath();
+
+    location.push(fileName);
+    location.start();
+
+    // Copied, as including a file may parse other files
+    const QList<ParsedFile::Statement> statements = parsedFile(fin, location).statements;
+    fin.close();
+
+    for (const auto &statement : statements) {
+        location.setLineNo(statement.lineNo);
+        location.setColumnNo(statement.columnNo);
+        if (statement.keys.isEmpty()) {
+            /*
+              Here is the recursive call.
+             */
+            load(location, QFileInfo(QDir(path), statement.includeFile).filePath());
+            continue;
+        }
+        for (const auto &key : statement.keys) {
+            ConfigVar configVar(key, statement.values, QDir::currentPath(), location,
+                                statement.expandVars);
+            if (statement.plus && m_configVars.contains(key)) {
+                m_configVars[key].append(configVar);
+            } else {
+                m_configVars.insert(key, configVar);
+            }
+        }
+    }
     popWorkingDir();
     if (!m_workingDirs.isEmpty())
         QDir::setCurrent(m_workingDirs.top());
@@ -8,6 +8,7 @@
 #include "qdoccommandlineparser.h"
 #include "singleton.h"
 
+#include <QtCore/qfile.h>
 #include <QtCore/qmap.h>
 #include <QtCore/qpair.h>
 #include <QtCore/qset.h>
@@ -30,6 +31,7 @@ struct ExpandVar
     QString m_var {};
     QChar m_delim {};
 
+    ExpandVar() = default;
     ExpandVar(int valueIndex, int index, QString var, const QChar &delim)
         : m_valueIndex(valueIndex), m_index(index), m_var(std::move(var)), m_delim(delim)
     {
@@ -93,6 +95,8 @@ public:
 
     enum QDocPass { Neither, Prepare, Generate };
 
+    struct ParsedFile;
+
     enum PathFlags : unsigned char {
         None = 0x0,
         // TODO: [unenforced-unclear-validation]
@@ -114,6 +118,13 @@ public:
     [[nodiscard]] bool getDebug() const { return m_debug; }
     [[nodiscard]] bool getAtomsDump() const { return m_atomsDump; }
     [[nodiscard]] bool showInternal() const { return m_showInternal; }
+    [[nodiscard]] const QString &timingsFile() const { return m_timingsFile; }
+    [[nodiscard]] bool watching() const { return m_watching; }
+    [[nodiscard]] int shardIndex() const { return m_shardIndex; }
+    [[nodiscard]] int shardCount() const { return m_shardCount; }
+    [[nodiscard]] bool mergingShards() const { return m_mergingShards; }
+    [[nodiscard]] bool generatingShard() const { return m_shardCount > 0 && !m_mergingShards; }
+    [[nodiscard]] const QStringList &loadedFiles() const { return m_loadedFiles; }
 
     void clear();
     void reset();
@@ -209,6 +220,12 @@ private:
     QString m_previousCurrentDir {};
 
     bool m_showInternal { false };
+    QString m_timingsFile {};
+    bool m_watching { false };
+    int m_shardIndex { 0 };
+    int m_shardCount { 0 }; // 0 if the pages are not sharded
+    bool m_mergingShards { false };
+    QStringList m_loadedFiles {};
     static bool m_debug;
 
     // An option that can be set trough a similarly named command-line option.
@@ -218,6 +235,8 @@ private:
     static bool m_atomsDump;
 
     static bool isMetaKeyChar(QChar ch);
+    static const ParsedFile &parsedFile(QFile &fin, Location &location);
+    static void parseFile(QString text, Location &location, ParsedFile *result);
     void load(Location location, const QString &fileName);
 
     QString m_prog {};
@@ -239,6 +258,8 @@ struct ConfigStrings
     static QString AUTOLINKERRORS;
     static QString BUILDVERSION;
     static QString CLANGDEFINES;
+    static QString CLANGKEEPGOING;
+    static QString CLANGPREAMBLE;
     static QString CODEINDENT;
     static QString CODEPREFIX;
     static QString CODESUFFIX;
@@ -270,6 +291,7 @@ struct ConfigStrings
     static QString IMAGEDIRS;
     static QString IMAGES;
     static QString INCLUDEPATHS;
+    static QString INCREMENTAL;
     static QString INCLUSIVE;
     static QString INDEXES;
     static QString LANDINGPAGE;
@@ -287,6 +309,7 @@ struct ConfigStrings
     static QString OUTPUTFORMATS;
     static QString OUTPUTPREFIXES;
     static QString OUTPUTSUFFIXES;
+    static QString PCHCACHEDIR;
     static QString PROJECT;
     static QString REDIRECTDOCUMENTATIONTODEVNULL;
     static QString QHP;
@@ -319,6 +342,8 @@ struct ConfigStrings
 #define CONFIG_AUTOLINKERRORS ConfigStrings::AUTOLINKERRORS
 #define CONFIG_BUILDVERSION ConfigStrings::BUILDVERSION
 #define CONFIG_CLANGDEFINES ConfigStrings::CLANGDEFINES
+#define CONFIG_CLANGKEEPGOING ConfigStrings::CLANGKEEPGOING
+#define CONFIG_CLANGPREAMBLE ConfigStrings::CLANGPREAMBLE
 #define CONFIG_CODEINDENT ConfigStrings::CODEINDENT
 #define CONFIG_CODEPREFIX ConfigStrings::CODEPREFIX
 #define CONFIG_CODESUFFIX ConfigStrings::CODESUFFIX
@@ -350,6 +375,7 @@ struct ConfigStrings
 #define CONFIG_IMAGEDIRS ConfigStrings::IMAGEDIRS
 #define CONFIG_IMAGES ConfigStrings::IMAGES
 #define CONFIG_INCLUDEPATHS ConfigStrings::INCLUDEPATHS
+#define CONFIG_INCREMENTAL ConfigStrings::INCREMENTAL
 #define CONFIG_INCLUSIVE ConfigStrings::INCLUSIVE
 #define CONFIG_INDEXES ConfigStrings::INDEXES
 #define CONFIG_LANDINGPAGE ConfigStrings::LANDINGPAGE
@@ -367,6 +393,7 @@ struct ConfigStrings
 #define CONFIG_OUTPUTFORMATS ConfigStrings::OUTPUTFORMATS
 #define CONFIG_OUTPUTPREFIXES ConfigStrings::OUTPUTPREFIXES
 #define CONFIG_OUTPUTSUFFIXES ConfigStrings::OUTPUTSUFFIXES
+#define CONFIG_PCHCACHEDIR ConfigStrings::PCHCACHEDIR
 #define CONFIG_PROJECT ConfigStrings::PROJECT
 #define CONFIG_REDIRECTDOCUMENTATIONTODEVNULL ConfigStrings::REDIRECTDOCUMENTATIONTODEVNULL
 #define CONFIG_QHP ConfigStrings::QHP
@@ -58,7 +58,7 @@ Atom::AtomType CppCodeMarker::atomType() const
 QString CppCodeMarker::markedUpCode(const QString &code, const Node *relative,
                                     const Location &location)
 {
-    return addMarkUp(code, relative, location);
+    return cachedMarkUp(code, [&](bool &) { return addMarkUp(code, relative, location); });
 }
 
 QString CppCodeMarker::markedUpSynopsis(const Node *node, const Node * /* relative */,
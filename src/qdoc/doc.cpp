@@ -13,6 +13,8 @@
 #include "quoter.h"
 #include "text.h"
 
+#include <QtCore/qmutex.h>
+
 QT_BEGIN_NAMESPACE
 
 using namespace Qt::StringLiterals;
@@ -40,12 +42,31 @@ DocUtilities &Doc::m_utilities = DocUtilities::instance();
   Normally, there is only one topic command in a qdoc comment, but in
   QML documentation, there is the case where the qdoc \e{qmlproperty}
   command can appear multiple times in a qdoc comment.
+
+  Comments marked \c{\\internal} are not generated, nor written to the
+  index, unless internal documentation is shown. Only their commands
+  are parsed here, which is what the code parsers need. The text of
+  such a comment is parsed the first time it is asked for, so the
+  warnings about it are only reported if it is.
  */
 Doc::Doc(const Location &start_loc, const Location &end_loc, const QString &source,
          const QSet<QString> &metaCommandSet, const QSet<QString> &topics)
 {
     m_priv = new DocPrivate(start_loc, end_loc, source);
     DocParser parser;
+    const Config &config = Config::instance();
+    if (!config.showInternal() && !config.getAtomsDump()
+        && source.contains(QLatin1String("\\internal"))) {
+        if (parser.parseCommands(source, m_priv, metaCommandSet, topics)
+            && m_priv->m_metacommandsUsed.contains(QLatin1String("internal"))) {
+            m_priv->m_metaCommandSet = metaCommandSet;
+            m_priv->m_topicCommandSet = topics;
+            m_priv->m_deferred.storeRelaxed(1);
+            return;
+        }
+        delete m_priv;
+        m_priv = new DocPrivate(start_loc, end_loc, source);
+    }
     parser.parse(source, m_priv, metaCommandSet, topics);
 
     if (Config::instance().getAtomsDump()) {
@@ -69,6 +90,28 @@ Doc::~Doc()
         delete m_priv;
 }
 
+/*!
+  Parses the text of a comment whose parsing was deferred, see Doc().
+  The commands collected so far are collected again by the full parse.
+ */
+void Doc::parseDeferred() const
+{
+    if (!m_priv || !m_priv->m_deferred.loadAcquire())
+        return;
+    static QBasicMutex mutex;
+    QMutexLocker locker(&mutex);
+    if (!m_priv->m_deferred.loadRelaxed())
+        return;
+    m_priv->m_metacommandsUsed.clear();
+    m_priv->m_metaCommandMap.clear();
+    m_priv->m_hasLegalese = false;
+    DocParser parser;
+    parser.parse(m_priv->m_src, m_priv, m_priv->m_metaCommandSet, m_priv->m_topicCommandSet);
+    m_priv->m_metaCommandSet.clear();
+    m_priv->m_topicCommandSet.clear();
+    m_priv->m_deferred.storeRelease(0);
+}
+
 Doc &Doc::operator=(const Doc &doc)
 {
     if (doc.m_priv)
@@ -110,6 +153,7 @@ bool Doc::isEmpty() const
 const Text &Doc::body() const
 {
     static const Text dummy;
+    parseDeferred();
     return m_priv == nullptr ? dummy : m_priv->m_text;
 }
 
@@ -183,22 +227,27 @@ Text Doc::legaleseText() const
 {
     if (m_priv == nullptr || !m_priv->m_hasLegalese)
         return Text();
-    else
-        return body().subText(Atom::LegaleseLeft, Atom::LegaleseRight);
+    parseDeferred();
+    if (!m_priv->m_hasLegalese)
+        return Text();
+    return body().subText(Atom::LegaleseLeft, Atom::LegaleseRight);
 }
 
 QSet<QString> Doc::parameterNames() const
 {
+    parseDeferred();
     return m_priv == nullptr ? QSet<QString>() : m_priv->m_params;
 }
 
 QStringList Doc::enumItemNames() const
 {
+    parseDeferred();
     return m_priv == nullptr ? QStringList() : m_priv->m_enumItemList;
 }
 
 QStringList Doc::omitEnumItemNames() const
 {
+    parseDeferred();
     return m_priv == nullptr ? QStringList() : m_priv->m_omitEnumItemList;
 }
 
@@ -242,50 +291,67 @@ ArgList Doc::metaCommandArgs(const QString &metacommand) const
 
 QList<Text> Doc::alsoList() const
 {
+    parseDeferred();
     return m_priv == nullptr ? QList<Text>() : m_priv->m_alsoList;
 }
 
 bool Doc::hasTableOfContents() const
 {
+    if (m_priv && m_priv->m_deferred.loadAcquire() && !m_priv->m_hasExtraCommands)
+        return false;
+    parseDeferred();
     return m_priv && m_priv->extra && !m_priv->extra->m_tableOfContents.isEmpty();
 }
 
 bool Doc::hasKeywords() const
 {
+    if (m_priv && m_priv->m_deferred.loadAcquire() && !m_priv->m_hasExtraCommands)
+        return false;
+    parseDeferred();
     return m_priv && m_priv->extra && !m_priv->extra->m_keywords.isEmpty();
 }
 
 bool Doc::hasTargets() const
 {
+    if (m_priv && m_priv->m_deferred.loadAcquire() && !m_priv->m_hasExtraCommands)
+        return false;
+    parseDeferred();
     return m_priv && m_priv->extra && !m_priv->extra->m_targets.isEmpty();
 }
 
 const QList<Atom *> &Doc::tableOfContents() const
 {
+    parseDeferred();
     m_priv->constructExtra();
     return m_priv->extra->m_tableOfContents;
 }
 
 const QList<int> &Doc::tableOfContentsLevels() const
 {
+    parseDeferred();
     m_priv->constructExtra();
     return m_priv->extra->m_tableOfContentsLevels;
 }
 
 const QList<Atom *> &Doc::keywords() const
 {
+    parseDeferred();
     m_priv->constructExtra();
     return m_priv->extra->m_keywords;
 }
 
 const QList<Atom *> &Doc::targets() const
 {
+    parseDeferred();
     m_priv->constructExtra();
     return m_priv->extra->m_targets;
 }
 
 QStringMultiMap *Doc::metaTagMap() const
 {
+    if (m_priv && m_priv->m_deferred.loadAcquire() && !m_priv->m_hasExtraCommands)
+        return nullptr;
+    parseDeferred();
     return m_priv && m_priv->extra ? &m_priv->extra->m_metaMap : nullptr;
 }
 
@@ -356,6 +422,7 @@ void Doc::terminate()
     m_utilities.aliasMap.clear();
     m_utilities.cmdHash.clear();
     m_utilities.macroHash.clear();
+    Quoter::clearCache();
     DocParser::terminate();
 }
 
@@ -411,6 +478,11 @@ CodeMarker *Doc::quoteFromFile(const Location &location, Quoter &quoter, Resolve
     // spread resposability should be removed, together with quoteFromFile.
     quoter.reset();
 
+    CodeMarker *marker = CodeMarker::markerForFileName(resolved_file.get_path());
+    // Files are usually quoted from many times; they are read and marked up once per run
+    if (quoter.quoteFromCachedFile(resolved_file.get_path()))
+        return marker;
+
     QString code;
     {
         QFile input_file{resolved_file.get_path()};
@@ -418,8 +490,8 @@ CodeMarker *Doc::quoteFromFile(const Location &location, Quoter &quoter, Resolve
         code = DocParser::untabifyEtc(QTextStream{&input_file}.readAll());
     }
 
-    CodeMarker *marker = CodeMarker::markerForFileName(resolved_file.get_path());
-    quoter.quoteFromFile(resolved_file.get_path(), code, marker->markedUpCode(code, nullptr, location));
+    quoter.quoteFromFile(resolved_file.get_path(), code,
+                         marker->markedUpCode(code, nullptr, location), true);
     return marker;
 }
 
@@ -469,6 +541,7 @@ void Doc::detach()
     if (m_priv->count == 1)
         return;
 
+    parseDeferred();
     --m_priv->count;
 
     auto *newPriv = new DocPrivate(*m_priv);
@@ -82,6 +82,7 @@ public:
 
 private:
     void detach();
+    void parseDeferred() const;
     DocPrivate *m_priv { nullptr };
     static DocUtilities &m_utilities;
 };
@@ -15,6 +15,7 @@
 #include "functionnode.h"
 #include "generator.h"
 #include "node.h"
+#include "pagewriter.h"
 #include "propertynode.h"
 #include "quoter.h"
 #include "qdocdatabase.h"
@@ -23,6 +24,7 @@
 #include "typedefnode.h"
 #include "variablenode.h"
 
+#include <QtCore/qfile.h>
 #include <QtCore/qlist.h>
 #include <QtCore/qmap.h>
 #include <QtCore/quuid.h>
@@ -31,6 +33,7 @@
 #include <QtCore/qversionnumber.h>
 
 #include <cctype>
+#include <utility>
 
 QT_BEGIN_NAMESPACE
 
@@ -388,7 +391,7 @@ qsizetype DocBookGenerator::generateAtom(const Atom *atom, const Node *relative)
                     ? m_qdb->getCppClasses()
                     : atom->string() == QLatin1String("attributions") ? m_qdb->getAttributions()
                                                                       : m_qdb->getNamespaces();
-            generateAnnotatedList(relative, things.values(), atom->string());
+            generateAnnotatedList(relative, things.cbegin(), things.cend(), atom->string());
         } else if (atom->string() == QLatin1String("annotatedexamples")
                    || atom->string() == QLatin1String("annotatedattributions")) {
             const NodeMultiMap things = atom->string() == QLatin1String("annotatedexamples")
@@ -419,7 +422,7 @@ qsizetype DocBookGenerator::generateAtom(const Atom *atom, const Node *relative)
                     NodeMap m;
                     cn->getMemberClasses(m);
                     if (!m.isEmpty())
-                        generateAnnotatedList(relative, m.values(), atom->string());
+                        generateAnnotatedList(relative, m.cbegin(), m.cend(), atom->string());
                 } else {
                     generateAnnotatedList(relative, cn->members(), atom->string());
                 }
@@ -1109,11 +1112,20 @@ void DocBookGenerator::generateList(const Node *relative, const QString &selecto
 void DocBookGenerator::generateAnnotatedList(const Node *relative, const NodeList &nodeList,
                                              const QString &selector)
 {
-    if (nodeList.isEmpty())
-        return;
+    generateAnnotatedList(relative, nodeList.cbegin(), nodeList.cend(), selector);
+}
 
+/*!
+  Outputs an annotated list of the nodes from \a first to \a last, which
+  iterate over a list or a map of nodes. Maps are iterated in place, so
+  that large lists are not copied before they are written.
+ */
+template<typename Iterator>
+void DocBookGenerator::generateAnnotatedList(const Node *relative, Iterator first, Iterator last,
+                                             const QString &selector)
+{
     // Do nothing if all items are internal or obsolete
-    if (std::all_of(nodeList.cbegin(), nodeList.cend(), [](const Node *n) {
+    if (std::all_of(first, last, [](const Node *n) {
         return n->isInternal() || n->isDeprecated(); })) {
         return;
     }
@@ -1123,7 +1135,8 @@ void DocBookGenerator::generateAnnotatedList(const Node *relative, const NodeLis
     m_writer->writeAttribute("role", selector);
     newLine();
 
-    for (const auto node : nodeList) {
+    for (auto it = first; it != last; ++it) {
+        const Node *node = *it;
         if (node->isInternal() || node->isDeprecated())
             continue;
         m_writer->writeStartElement(dbNamespace, "varlistentry");
@@ -1155,13 +1168,19 @@ void DocBookGenerator::generateAnnotatedList(const Node *relative, const NodeLis
 void DocBookGenerator::generateAnnotatedLists(const Node *relative, const NodeMultiMap &nmm,
                                               const QString &selector)
 {
-    // From HtmlGenerator::generateAnnotatedLists.
-    for (const QString &name : nmm.uniqueKeys()) {
+    // From HtmlGenerator::generateAnnotatedLists. Each key is written from
+    // its range in the map, without collecting the keys and values first.
+    for (auto it = nmm.cbegin(); it != nmm.cend();) {
+        const QString &name = it.key();
+        auto last = it;
+        while (last != nmm.cend() && last.key() == name)
+            ++last;
         if (!name.isEmpty())
             startSection(registerRef(name.toLower()), name);
-        generateAnnotatedList(relative, nmm.values(name), selector);
+        generateAnnotatedList(relative, it, last, selector);
         if (!name.isEmpty())
             endSection();
+        it = last;
     }
 }
 
@@ -1193,9 +1212,10 @@ void DocBookGenerator::generateCompactList(ListType listType, const Node *relati
       Divide the data into 37 paragraphs: 0, ..., 9, A, ..., Z,
       underscore (_). QAccel will fall in paragraph 10 (A) and
       QXtWidget in paragraph 33 (X). This is the only place where we
-      assume that NumParagraphs is 37. Each paragraph is a NodeMultiMap.
+      assume that NumParagraphs is 37. Each paragraph refers to its
+      entries in nmm, in the order of the map, rather than copying them.
     */
-    NodeMultiMap paragraph[NumParagraphs + 1];
+    QList<NodeMultiMap::ConstIterator> paragraph[NumParagraphs + 1];
     QString paragraphName[NumParagraphs + 1];
     QSet<char> usedParagraphNames;
 
@@ -1217,7 +1237,7 @@ void DocBookGenerator::generateCompactList(ListType listType, const Node *relati
 
         paragraphName[paragraphNr] = key[0].toUpper();
         usedParagraphNames.insert(key[0].toLower().cell());
-        paragraph[paragraphNr].insert(c.key(), c.value());
+        paragraph[paragraphNr].append(c);
         ++c;
     }
 
@@ -1281,11 +1301,7 @@ void DocBookGenerator::generateCompactList(ListType listType, const Node *relati
         newLine();
         m_writer->writeStartElement(dbNamespace, "para");
         if ((curParNr < NumParagraphs) && !paragraphName[curParNr].isEmpty()) {
-            NodeMultiMap::Iterator it;
-            NodeMultiMap::Iterator next;
-            it = paragraph[curParNr].begin();
-            for (int j = 0; j < curParOffset; j++)
-                ++it;
+            const NodeMultiMap::ConstIterator it = paragraph[curParNr].at(curParOffset);
 
             if (listType == Generic) {
                 generateFullName(it.value(), relative);
@@ -1307,11 +1323,10 @@ void DocBookGenerator::generateCompactList(ListType listType, const Node *relati
             QStringList pieces;
             if (it.value()->isQmlType() || it.value()->isJsType()) {
                 QString name = it.value()->name();
-                next = it;
-                ++next;
                 if (name != previousName)
                     multipleOccurrences = false;
-                if ((next != paragraph[curParNr].end()) && (name == next.value()->name())) {
+                if (curParOffset + 1 < paragraph[curParNr].size()
+                    && name == paragraph[curParNr].at(curParOffset + 1).value()->name()) {
                     multipleOccurrences = true;
                     previousName = name;
                 }
@@ -2568,14 +2583,41 @@ void DocBookGenerator::generateMaintainerList(const Aggregate *node)
     }
 }
 
+/*!
+  Returns \c true if the page of \a node lists other nodes, which makes
+  it grow with the size of the documentation: collection pages list their
+  members, and \\annotatedlist and \\generatelist expand to lists of any
+  size.
+ */
+static bool hasGeneratedLists(const Node *node)
+{
+    if (node->isCollectionNode())
+        return true;
+    for (const Atom *atom = node->doc().body().firstAtom(); atom; atom = atom->next()) {
+        if (atom->type() == Atom::AnnotatedList || atom->type() == Atom::GeneratedList)
+            return true;
+    }
+    return false;
+}
+
 /*!
   Open a new file to write XML contents, including the DocBook
   opening tag.
+
+  Pages with generated lists are streamed to their file, through the
+  buffer of the file, instead of being rendered in memory and handed
+  over to the PageWriter, which bounds the memory they take. In
+  incremental mode, the PageWriter has to see the whole page to tell
+  whether it changed, so all pages are rendered in memory.
  */
 QXmlStreamWriter *DocBookGenerator::startGenericDocument(const Node *node, const QString &fileName)
 {
-    QFile *outFile = openSubPageFile(node, fileName);
-    m_writer = new QXmlStreamWriter(outFile);
+    m_outFile = openSubPageFile(node, fileName);
+    m_outData.clear();
+    if (m_outFile->isOpen() && hasGeneratedLists(node))
+        m_writer = new QXmlStreamWriter(m_outFile);
+    else
+        m_writer = new QXmlStreamWriter(&m_outData);
     m_writer->setAutoFormatting(false); // We need a precise handling of line feeds.
 
     m_writer->writeStartDocument();
@@ -2610,10 +2652,17 @@ void DocBookGenerator::endDocument()
 {
     m_writer->writeEndElement(); // article
     m_writer->writeEndDocument();
-    m_writer->device()->close();
-    delete m_writer->device();
+    const bool streamed = m_writer->device() == m_outFile;
     delete m_writer;
     m_writer = nullptr;
+    if (streamed) {
+        if (!m_outFile->flush())
+            qCWarning(lcQdoc, "Cannot write output file '%s'", qPrintable(m_outFile->fileName()));
+        delete m_outFile;
+    } else {
+        PageWriter::instance().write(m_outFile, std::exchange(m_outData, {}));
+    }
+    m_outFile = nullptr;
 }
 
 /*!
@@ -4171,7 +4220,7 @@ void DocBookGenerator::generateDocumentation(Node *node)
     if (node->isExternalPage())
         return;
 
-    if (node->parent()) {
+    if (node->parent() && isInShard(node)) {
         if (node->isCollectionNode()) {
             /*
               A collection node collects: groups, C++ modules,
@@ -4318,14 +4367,14 @@ void DocBookGenerator::generateCollectionNode(CollectionNode *cn)
             cn->getMemberNamespaces(nmm);
             if (!nmm.isEmpty()) {
                 startSection(registerRef("namespaces"), "Namespaces");
-                generateAnnotatedList(cn, nmm.values(), "namespaces");
+                generateAnnotatedList(cn, nmm.cbegin(), nmm.cend(), "namespaces");
                 endSection();
             }
             nmm.clear();
             cn->getMemberClasses(nmm);
             if (!nmm.isEmpty()) {
                 startSection(registerRef("classes"), "Classes");
-                generateAnnotatedList(cn, nmm.values(), "classes");
+                generateAnnotatedList(cn, nmm.cbegin(), nmm.cend(), "classes");
                 endSection();
             }
         }
@@ -75,6 +75,9 @@ private:
 
     void generateAnnotatedList(const Node *relative, const NodeList &nodeList,
                                const QString &selector);
+    template<typename Iterator>
+    void generateAnnotatedList(const Node *relative, Iterator first, Iterator last,
+                               const QString &selector);
     void generateAnnotatedLists(const Node *relative, const NodeMultiMap &nmm,
                                 const QString &selector);
     void generateCompactList(ListType listType, const Node *relative, const NodeMultiMap &nmm,
@@ -141,6 +144,8 @@ private:
     QString m_naturalLanguage {};
     QString m_buildVersion {};
     QXmlStreamWriter *m_writer { nullptr };
+    QFile *m_outFile { nullptr };
+    QByteArray m_outData {};
 
     Config *m_config { nullptr };
 };
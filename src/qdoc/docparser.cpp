@@ -14,7 +14,7 @@
 #include <QtCore/qregularexpression.h>
 #include <QtCore/qtextstream.h>
 
-#include <cctype>
+#include <array>
 #include <climits>
 #include <functional>
 
@@ -1267,6 +1267,116 @@ void DocParser::parse(const QString &source, DocPrivate *docPrivate,
     m_private->m_text.stripFirstAtom();
 }
 
+/*!
+  Collects only the metacommands and topic commands of \a source, with
+  their arguments, into \a docPrivate, the way parse() does, without
+  building the Text of the comment. Records in \a docPrivate whether the
+  comment has commands that produce legalese text, a table of contents,
+  keywords, targets, or meta tags, which parse() keeps outside the Text.
+
+  Returns \c false if the commands cannot be told apart from the text
+  without parsing it, because the comment uses conditional text, includes
+  other files, or uses macros that expand to commands. \a docPrivate must
+  then be parsed with parse() instead.
+ */
+bool DocParser::parseCommands(const QString &source, DocPrivate *docPrivate,
+                              const QSet<QString> &metaCommandSet,
+                              const QSet<QString> &possibleTopics)
+{
+    m_input = source;
+    m_position = 0;
+    m_inputLength = m_input.length();
+    m_cachedLocation = docPrivate->m_start_loc;
+    m_cachedPosition = 0;
+    m_private = docPrivate;
+    m_private->m_topics.clear();
+
+    while (m_position < m_inputLength) {
+        const QChar ch = m_input.at(m_position);
+        if (ch == '/' && m_input.mid(m_position, 3) == QLatin1String("//!")) {
+            m_position += 2;
+            getRestOfLine();
+            continue;
+        }
+        ++m_position;
+        if (ch != '\\')
+            continue;
+
+        QString cmdStr;
+        m_backslashPosition = m_position - 1;
+        while (m_position < m_inputLength && m_input.at(m_position).isLetterOrNumber())
+            cmdStr += m_input.at(m_position++);
+        m_endPosition = m_position;
+        if (cmdStr.isEmpty()) {
+            ++m_position; // an escaped character
+            continue;
+        }
+
+        const int cmd = s_utilities.cmdHash.value(cmdStr, NOT_A_CMD);
+        switch (cmd) {
+        case CMD_IF:
+        case CMD_ELSE:
+        case CMD_ENDIF:
+        case CMD_INCLUDE:
+        case CMD_INPUT:
+            return false;
+        case CMD_BADCODE:
+        case CMD_CODE:
+        case CMD_QML:
+        case CMD_JS:
+        case CMD_OLDCODE:
+        case CMD_OMIT:
+        case CMD_RAW:
+            getUntilEnd(cmd);
+            break;
+        case CMD_LEGALESE:
+            m_private->m_hasLegalese = true;
+            break;
+        case CMD_KEYWORD:
+        case CMD_META:
+        case CMD_SECTION1:
+        case CMD_SECTION2:
+        case CMD_SECTION3:
+        case CMD_SECTION4:
+        case CMD_TARGET:
+            m_private->m_hasExtraCommands = true;
+            break;
+        case CMD_OVERLOAD: {
+            m_private->m_metacommandsUsed.insert(cmdStr);
+            QString arg;
+            if (!isBlankLine())
+                arg = getRestOfLine();
+            if (arg.isEmpty())
+                arg = getMetaCommandArgument(cmdStr);
+            m_private->m_metaCommandMap[cmdStr].append(ArgPair(arg, QString()));
+            break;
+        }
+        case NOT_A_CMD:
+            if (metaCommandSet.contains(cmdStr)) {
+                QString arg;
+                QString bracketedArg;
+                m_private->m_metacommandsUsed.insert(cmdStr);
+                if (isLeftBracketAhead())
+                    bracketedArg = getBracketedArgument();
+                if (cmdStr != QLatin1String("obsolete") && cmdStr != QLatin1String("deprecated"))
+                    arg = getMetaCommandArgument(cmdStr);
+                m_private->m_metaCommandMap[cmdStr].append(ArgPair(arg, bracketedArg));
+                if (possibleTopics.contains(cmdStr)) {
+                    if (!cmdStr.endsWith(QLatin1String("propertygroup")))
+                        m_private->m_topics.append(Topic(cmdStr, arg));
+                }
+            } else if (s_utilities.macroHash.contains(cmdStr)
+                       && s_utilities.macroHash.value(cmdStr).m_defaultDef.contains('\\')) {
+                return false;
+            }
+            break;
+        default:
+            break;
+        }
+    }
+    return true;
+}
+
 /*!
   Returns the current location.
  */
@@ -1527,6 +1637,35 @@ inline bool DocParser::isAutoLinkString(const QString &word)
     return isAutoLinkString(word, start) && (start == word.length());
 }
 
+namespace {
+enum AutoLinkCharClass : unsigned char {
+    OtherChar,
+    LowercaseChar,
+    UppercaseChar,
+    DigitChar,
+    StrangeChar, // '_' and '@'
+    ColonChar,
+    OpenParenChar
+};
+
+// Classifies the ASCII characters for isAutoLinkString(); everything
+// else ends an auto-link string.
+constexpr auto autoLinkCharClasses = [] {
+    std::array<AutoLinkCharClass, 128> classes {};
+    for (char c = 'a'; c <= 'z'; ++c)
+        classes[c] = LowercaseChar;
+    for (char c = 'A'; c <= 'Z'; ++c)
+        classes[c] = UppercaseChar;
+    for (char c = '0'; c <= '9'; ++c)
+        classes[c] = DigitChar;
+    classes['_'] = StrangeChar;
+    classes['@'] = StrangeChar;
+    classes[':'] = ColonChar;
+    classes['('] = OpenParenChar;
+    return classes;
+}();
+} // namespace
+
 /*!
     Returns \c true if a prefix of a substring of \a word qualifies
     for auto-linking.
@@ -1555,36 +1694,37 @@ bool DocParser::isAutoLinkString(const QString &word, qsizetype &curPos)
     int numUppercase = 0;
     int numLowercase = 0;
     int numStrangeSymbols = 0;
+    const char16_t *data = word.utf16();
 
     while (curPos < len) {
-        unsigned char latin1Ch = word.at(curPos).toLatin1();
-        if (islower(latin1Ch)) {
+        const char16_t ch = data[curPos];
+        const AutoLinkCharClass charClass = ch < 128 ? autoLinkCharClasses[ch] : OtherChar;
+        if (charClass == LowercaseChar) {
             ++numLowercase;
             ++curPos;
-        } else if (isupper(latin1Ch)) {
+        } else if (charClass == UppercaseChar) {
             if (curPos > startPos)
                 ++numUppercase;
             ++curPos;
-        } else if (isdigit(latin1Ch)) {
+        } else if (charClass == DigitChar) {
             if (curPos > startPos)
                 ++curPos;
             else
                 break;
-        } else if (latin1Ch == '_' || latin1Ch == '@') {
+        } else if (charClass == StrangeChar) {
             ++numStrangeSymbols;
             ++curPos;
-        } else if ((latin1Ch == ':') && (curPos < len - 1)
-                   && (word.at(curPos + 1) == QLatin1Char(':'))) {
+        } else if (charClass == ColonChar && (curPos < len - 1) && (data[curPos + 1] == u':')) {
             ++numStrangeSymbols;
             curPos += 2;
-        } else if (latin1Ch == '(') {
-            if ((curPos < len - 1) && (word.at(curPos + 1) == QLatin1Char(')'))) {
+        } else if (charClass == OpenParenChar) {
+            if ((curPos < len - 1) && (data[curPos + 1] == u')')) {
                 ++numStrangeSymbols;
                 m_position += 2;
             }
 
             break;
-       } else {
+        } else {
             break;
         }
     }
@@ -29,6 +29,8 @@ class DocParser
 public:
     void parse(const QString &source, DocPrivate *docPrivate, const QSet<QString> &metaCommandSet,
                const QSet<QString> &possibleTopics);
+    bool parseCommands(const QString &source, DocPrivate *docPrivate,
+                       const QSet<QString> &metaCommandSet, const QSet<QString> &possibleTopics);
 
     static void initialize(const Config &config, FileResolver& file_resolver);
     static void terminate();
@@ -15,6 +15,7 @@
 #include "text.h"
 #include "tokenizer.h"
 
+#include <QtCore/qatomic.h>
 #include <QtCore/qdatetime.h>
 #include <QtCore/qfile.h>
 #include <QtCore/qfileinfo.h>
@@ -67,6 +68,12 @@ public:
     DocPrivateExtra *extra { nullptr };
     TopicList m_topics {};
 
+    // The command sets to parse a deferred comment with; see Doc::Doc().
+    QSet<QString> m_metaCommandSet {};
+    QSet<QString> m_topicCommandSet {};
+    QAtomicInt m_deferred { 0 };
+    bool m_hasExtraCommands { false };
+
     bool m_hasLegalese : 1;
 };
 
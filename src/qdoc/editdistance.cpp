@@ -3,6 +3,10 @@
 
 #include "editdistance.h"
 
+#include <QtCore/qvarlengtharray.h>
+
+#include <utility>
+
 QT_BEGIN_NAMESPACE
 
 int editDistance(const QString &s, const QString &t)
@@ -37,18 +41,68 @@ int editDistance(const QString &s, const QString &t)
 #undef D
 }
 
+/*
+  Returns the edit distance between \a s and \a t if it is at most
+  \a maxDistance, and maxDistance + 1 otherwise. Only the band of the
+  distance matrix around the diagonal that can stay within the bound is
+  computed, and the computation stops as soon as a whole row exceeds it.
+*/
+static int boundedEditDistance(QStringView s, QStringView t, int maxDistance)
+{
+    const int over = maxDistance + 1;
+    const qsizetype m = s.size();
+    const qsizetype n = t.size();
+    if (qAbs(m - n) > maxDistance)
+        return over;
+
+    QVarLengthArray<int, 128> rows(2 * (n + 1));
+    int *previous = rows.data();
+    int *current = previous + n + 1;
+    for (qsizetype j = 0; j <= n; ++j) {
+        previous[j] = j <= maxDistance ? int(j) : over;
+        current[j] = over;
+    }
+    for (qsizetype i = 1; i <= m; ++i) {
+        const qsizetype from = qMax(qsizetype(1), i - maxDistance);
+        const qsizetype to = qMin(n, i + maxDistance);
+        current[0] = i <= maxDistance ? int(i) : over;
+        current[from - 1] = from > 1 ? over : current[0];
+        int rowMin = current[from - 1];
+        for (qsizetype j = from; j <= to; ++j) {
+            int d;
+            if (s[i - 1] == t[j - 1])
+                d = previous[j - 1];
+            else
+                d = 1 + qMin(qMin(previous[j], previous[j - 1]), current[j - 1]);
+            current[j] = qMin(d, over);
+            rowMin = qMin(rowMin, current[j]);
+        }
+        if (rowMin > maxDistance)
+            return over;
+        std::swap(previous, current);
+    }
+    return previous[n];
+}
+
+/*
+  Returns the candidate within an edit distance of two of \a actual, if
+  there is exactly one closest candidate. The distances are computed
+  with a bound that shrinks with the best match found so far, so most
+  candidates are rejected after a few characters.
+*/
 QString nearestName(const QString &actual, const QSet<QString> &candidates)
 {
     if (actual.isEmpty())
         return QString();
 
-    int deltaBest = 10000;
+    const int maxDistance = 2;
+    int deltaBest = maxDistance + 1;
     int numBest = 0;
     QString best;
 
     for (const auto &candidate : candidates) {
-        if (candidate[0] == actual[0]) {
-            int delta = editDistance(actual, candidate);
+        if (candidate.startsWith(actual[0])) {
+            int delta = boundedEditDistance(actual, candidate, qMin(deltaBest, maxDistance));
             if (delta < deltaBest) {
                 deltaBest = delta;
                 numBest = 1;
@@ -59,7 +113,7 @@ QString nearestName(const QString &actual, const QSet<QString> &candidates)
         }
     }
 
-    if (numBest == 1 && deltaBest <= 2 && actual.length() + best.length() >= 5)
+    if (numBest == 1 && deltaBest <= maxDistance && actual.length() + best.length() >= 5)
         return best;
 
     return QString();
@@ -0,0 +1,160 @@
+// Copyright (C) 2023 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
+#ifndef FILEPREFETCHER_H
+#define FILEPREFETCHER_H
+
+#include <QtCore/qhash.h>
+#include <QtCore/qstringlist.h>
+
+#include <algorithm>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+QT_BEGIN_NAMESPACE
+
+/*!
+  \internal
+  \class FilePrefetcher
+
+  Parses source files on worker threads, ahead of the code parser that
+  visits them. The files are parsed in the order of the file list and
+  at most a window of them wait to be taken at any time. They are
+  visited on the thread that takes them, in the order it takes them, so
+  the database is built the same way as when the files are parsed one
+  after the other.
+
+  \c T is what the parse function returns for a file, and is passed
+  to the discard function if it is never taken.
+ */
+template<typename T>
+class FilePrefetcher
+{
+public:
+    using ParseFunction = std::function<T(const QString &filePath)>;
+    using DiscardFunction = std::function<void(T &result)>;
+
+    /*!
+      Starts parsing the files in \a filePaths with \a parse on at most
+      \a threadCount threads, keeping at most \a window files parsed
+      ahead of the last one taken. The results that are not taken are
+      passed to \a discard when the prefetcher is destroyed.
+     */
+    FilePrefetcher(const QStringList &filePaths, unsigned int threadCount, size_t window,
+                   ParseFunction parse, DiscardFunction discard = {})
+        : m_parse(std::move(parse)),
+          m_discard(std::move(discard)),
+          m_window(std::max<size_t>(window, 1))
+    {
+        m_entries.reserve(filePaths.size());
+        for (const QString &filePath : filePaths) {
+            if (m_entryIndex.contains(filePath))
+                continue;
+            m_entryIndex.insert(filePath, m_entries.size());
+            Entry entry;
+            entry.filePath = filePath;
+            m_entries.push_back(std::move(entry));
+        }
+        if (m_entries.empty())
+            return;
+
+        threadCount = std::clamp(threadCount, 1u, static_cast<unsigned int>(m_entries.size()));
+        for (unsigned int i = 0; i < threadCount; ++i)
+            m_workers.emplace_back([this] { run(); });
+    }
+
+    /*!
+      Stops the workers and discards the results that were not taken.
+     */
+    ~FilePrefetcher()
+    {
+        {
+            std::lock_guard lock(m_mutex);
+            m_stop = true;
+        }
+        m_condition.notify_all();
+        for (auto &worker : m_workers)
+            worker.join();
+        if (!m_discard)
+            return;
+        for (auto &entry : m_entries) {
+            if (entry.parsed && !entry.taken)
+                m_discard(entry.result);
+        }
+    }
+
+    FilePrefetcher(const FilePrefetcher &) = delete;
+    FilePrefetcher &operator=(const FilePrefetcher &) = delete;
+
+    /*!
+      Waits for \a filePath to be parsed and passes the result to the
+      caller in \a result. Returns \c false if \a filePath is not parsed
+      ahead, or was taken before.
+     */
+    bool take(const QString &filePath, T *result)
+    {
+        const auto it = m_entryIndex.constFind(filePath);
+        if (it == m_entryIndex.cend())
+            return false;
+
+        std::unique_lock lock(m_mutex);
+        Entry &entry = m_entries[*it];
+        if (entry.taken)
+            return false;
+        // Let the workers reach this file even if earlier ones are skipped.
+        m_taken = std::max(m_taken, *it + 1);
+        m_condition.notify_all();
+        m_condition.wait(lock, [&] { return entry.parsed; });
+        entry.taken = true;
+        *result = std::move(entry.result);
+        return true;
+    }
+
+private:
+    struct Entry
+    {
+        QString filePath;
+        T result {};
+        bool parsed = false;
+        bool taken = false;
+    };
+
+    void run()
+    {
+        std::unique_lock lock(m_mutex);
+        while (true) {
+            m_condition.wait(lock, [&] {
+                return m_stop || m_next >= m_entries.size() || m_next < m_taken + m_window;
+            });
+            if (m_stop || m_next >= m_entries.size())
+                return;
+            Entry &entry = m_entries[m_next++];
+            lock.unlock();
+
+            T result = m_parse(entry.filePath);
+
+            lock.lock();
+            entry.result = std::move(result);
+            entry.parsed = true;
+            m_condition.notify_all();
+        }
+    }
+
+    ParseFunction m_parse;
+    DiscardFunction m_discard;
+    std::vector<Entry> m_entries;
+    QHash<QString, size_t> m_entryIndex;
+    size_t m_next = 0;
+    size_t m_taken = 0;
+    size_t m_window = 1;
+    bool m_stop = false;
+    std::mutex m_mutex;
+    std::condition_variable m_condition;
+    std::vector<std::thread> m_workers;
+};
+
+QT_END_NAMESPACE
+
+#endif // FILEPREFETCHER_H
@@ -6,9 +6,11 @@
 #include "boundaries/filesystem/filepath.h"
 
 #include <QDir>
+#include <QDirIterator>
 
 #include <iostream>
 #include <algorithm>
+#include <thread>
 
 /*!
  * \class FileResolver
@@ -27,6 +29,13 @@
  * A file is considered to be resolved if, from any root directory,
  * the query represents an existing file.
  *
+ * The files under the root directories are listed once, on the first
+ * query, and the following queries are looked up in that listing, so
+ * that a query only touches the filesystem for the file it resolves
+ * to. Files that are created under the root directories after the
+ * first query are not found. The listing is taken exactly once, also
+ * when the first queries come from several threads.
+ *
  * For example, consider the following directory structure on some
  * filesystem:
  *
@@ -136,6 +145,49 @@ FileResolver::FileResolver(std::vector<DirectoryPath>&& search_directories)
 // This will then define how we should handle absolute paths, if we
 // can receive them at all and so on.
 
+#if defined(Q_OS_WIN) || defined(Q_OS_DARWIN)
+static constexpr Qt::CaseSensitivity path_case_sensitivity = Qt::CaseInsensitive;
+#else
+static constexpr Qt::CaseSensitivity path_case_sensitivity = Qt::CaseSensitive;
+#endif
+
+/*!
+ * \internal
+ *
+ * Returns the form in which \a relative_path is kept in, and looked up
+ * from, the snapshot of the search directories.
+ */
+static QString snapshot_key(const QString& relative_path) {
+    return path_case_sensitivity == Qt::CaseSensitive ? relative_path : relative_path.toLower();
+}
+
+/*!
+ * \internal
+ *
+ * Lists the files under each search directory into the snapshot, each
+ * directory on a thread of its own.
+ */
+void FileResolver::take_snapshot() const {
+    snapshot.resize(search_directories.size());
+
+    auto list_files = [this](std::size_t index) {
+        const QString& root{search_directories[index].value()};
+        const qsizetype prefix_size{root.endsWith('/') ? root.size() : root.size() + 1};
+        QSet<QString>& files{snapshot[index]};
+        QDirIterator iterator(root, QDir::Files | QDir::Hidden | QDir::System,
+                              QDirIterator::Subdirectories | QDirIterator::FollowSymlinks);
+        while (iterator.hasNext())
+            files.insert(snapshot_key(iterator.next().mid(prefix_size)));
+    };
+
+    std::vector<std::thread> threads;
+    threads.reserve(search_directories.size());
+    for (std::size_t index = 0; index < search_directories.size(); ++index)
+        threads.emplace_back(list_files, index);
+    for (auto& thread : threads)
+        thread.join();
+}
+
 /*!
 * Returns a ResolvedFile if \a query can be resolved or std::nullopt
 * otherwise.
@@ -144,6 +196,24 @@ FileResolver::FileResolver(std::vector<DirectoryPath>&& search_directories)
 * query and the path that the \a query was resolved to.
 */
 [[nodiscard]] std::optional<ResolvedFile> FileResolver::resolve(QString query) const {
+    // Queries that may leave the search directories are not in the
+    // snapshot and are resolved on the filesystem.
+    const QString relative_path{QDir::cleanPath(query)};
+    if (!relative_path.isEmpty() && !QDir::isAbsolutePath(relative_path)
+        && relative_path != QLatin1String("..") && !relative_path.startsWith(QLatin1String("../"))) {
+        std::call_once(snapshot_taken, &FileResolver::take_snapshot, this);
+
+        const QString key{snapshot_key(relative_path)};
+        for (std::size_t index = 0; index < search_directories.size(); ++index) {
+            if (!snapshot[index].contains(key))
+                continue;
+            auto maybe_filepath = FilePath::refine(QDir(search_directories[index].value() + "/" + query).path());
+            if (maybe_filepath) return ResolvedFile{std::move(query), std::move(*maybe_filepath)};
+        }
+
+        return std::nullopt;
+    }
+
     for (auto& directory_path : search_directories) {
         auto maybe_filepath = FilePath::refine(QDir(directory_path.value() + "/" + query).path());
         if (maybe_filepath) return ResolvedFile{std::move(query), std::move(*maybe_filepath)};
@@ -6,9 +6,11 @@
 #include "boundaries/filesystem/directorypath.h"
 #include "boundaries/filesystem/resolvedfile.h"
 
+#include <mutex>
 #include <optional>
 #include <vector>
 
+#include <QtCore/qset.h>
 #include <QtCore/qstring.h>
 
 class FileResolver {
@@ -20,5 +22,11 @@ public:
     [[nodiscard]] const std::vector<DirectoryPath>& get_search_directories() const { return search_directories; }
 
 private:
+    void take_snapshot() const;
+
     std::vector<DirectoryPath> search_directories;
+    // The relative paths of the files under each search directory,
+    // taken on the first query. Queries may come from several threads.
+    mutable std::once_flag snapshot_taken;
+    mutable std::vector<QSet<QString>> snapshot;
 };
@@ -16,6 +16,7 @@
 #include "functionnode.h"
 #include "node.h"
 #include "openedlist.h"
+#include "pagewriter.h"
 #include "propertynode.h"
 #include "qdocdatabase.h"
 #include "qmltypenode.h"
@@ -27,6 +28,8 @@
 
 #include <QtCore/qdebug.h>
 #include <QtCore/qdir.h>
+#include <QtCore/qreadwritelock.h>
+#include <QtCore/qsavefile.h>
 #include <QtCore/qregularexpression.h>
 
 #ifndef QT_BOOTSTRAPPED
@@ -50,6 +53,35 @@ bool Generator::s_noLinkErrors = false;
 bool Generator::s_autolinkErrors = false;
 bool Generator::s_redirectDocumentationToDevNull = false;
 bool Generator::s_useOutputSubdirs = true;
+
+namespace {
+/*
+  The document location of a node depends on the generator whose
+  fileBase() is called and on the current generator, whose file
+  extension is used.
+*/
+struct DocumentLocationKey
+{
+    const Node *node;
+    const Generator *generator;
+    const Generator *currentGenerator;
+    bool useSubdir;
+
+    friend bool operator==(const DocumentLocationKey &a, const DocumentLocationKey &b) noexcept
+    {
+        return a.node == b.node && a.generator == b.generator
+                && a.currentGenerator == b.currentGenerator && a.useSubdir == b.useSubdir;
+    }
+    friend size_t qHash(const DocumentLocationKey &key, size_t seed = 0) noexcept
+    {
+        return qHashMulti(seed, key.node, key.generator, key.currentGenerator, key.useSubdir);
+    }
+};
+} // namespace
+
+static bool s_documentLocationCacheEnabled = false;
+static QReadWriteLock s_documentLocationCacheLock;
+static QHash<DocumentLocationKey, QString> s_documentLocationCache;
 QmlTypeNode *Generator::s_qmlTypeContext = nullptr;
 
 static QRegularExpression tag("</?@[^>]*>");
@@ -197,10 +229,15 @@ QFile *Generator::openSubPageFile(const Node *node, const QString &fileName)
     auto outPath = s_redirectDocumentationToDevNull ? QStringLiteral("/dev/null") : path;
     auto outFile = new QFile(outPath);
 
+    // A page may be generated twice; the last one written must win.
+    if (!s_redirectDocumentationToDevNull)
+        PageWriter::instance().waitForFile(outFile->fileName());
+
     if (!s_redirectDocumentationToDevNull && outFile->exists())
         qCDebug(lcQdoc) << "Output file already exists; overwriting" << qPrintable(outFile->fileName());
 
-    if (!outFile->open(QFile::WriteOnly)) {
+    // In incremental mode, the PageWriter opens the file if the page changed.
+    if (!PageWriter::instance().isIncremental() && !outFile->open(QFile::WriteOnly)) {
         node->location().fatal(
                 QStringLiteral("Cannot open output file '%1'").arg(outFile->fileName()));
     }
@@ -212,26 +249,30 @@ QFile *Generator::openSubPageFile(const Node *node, const QString &fileName)
 
 /*!
   Creates the file named \a fileName in the output directory.
-  Attaches a QTextStream to the created file, which is written
-  to all over the place using out().
+  Attaches a QTextStream to a buffer for the contents of the
+  file, which is written to all over the place using out().
  */
 void Generator::beginSubPage(const Node *node, const QString &fileName)
 {
-    QFile *outFile = openSubPageFile(node, fileName);
-    auto *out = new QTextStream(outFile);
+    outFileStack.push(openSubPageFile(node, fileName));
+    auto *out = new QTextStream(new QString(PageWriter::instance().takeBuffer()));
     outStreamStack.push(out);
 }
 
 /*!
   Flush the text stream associated with the subpage, and
   then pop it off the text stream stack and delete it.
-  This terminates output of the subpage.
+  This terminates output of the subpage; the contents are
+  written to the file by the PageWriter.
  */
 void Generator::endSubPage()
 {
-    outStreamStack.top()->flush();
-    delete outStreamStack.top()->device();
-    delete outStreamStack.pop();
+    QTextStream *out = outStreamStack.pop();
+    out->flush();
+    QString *text = out->string();
+    PageWriter::instance().write(outFileStack.pop(), std::move(*text));
+    delete text;
+    delete out;
 }
 
 /*
@@ -333,8 +374,12 @@ QString Generator::fileBase(const Node *node) const
 
     QString res;
     transmogrify(base, res);
-    Node *n = const_cast<Node *>(node);
-    n->setFileNameBase(res);
+    // An empty base is not remembered; not storing it keeps the root
+    // namespace unchanged while the index is written on several threads.
+    if (!res.isEmpty()) {
+        Node *n = const_cast<Node *>(node);
+        n->setFileNameBase(res);
+    }
     return res;
 }
 
@@ -447,6 +492,25 @@ QMap<QString, QString> &Generator::formattingRightMap()
     return s_fmtRightMaps[format()];
 }
 
+/*!
+  Enables or disables the cache of document locations, depending on
+  \a enabled. Disabling the cache clears it.
+
+  The document location of a node does not change once the tree is
+  resolved, but links to the node are written many times per page,
+  and by every generator. The cache is shared by the generators and is
+  thread-safe, as the index file is written on worker threads.
+
+  \sa fullDocumentLocation()
+ */
+void Generator::setDocumentLocationCacheEnabled(bool enabled)
+{
+    QWriteLocker locker(&s_documentLocationCacheLock);
+    s_documentLocationCacheEnabled = enabled;
+    if (!enabled)
+        s_documentLocationCache.clear();
+}
+
 /*!
   Returns the full document location.
  */
@@ -454,6 +518,24 @@ QString Generator::fullDocumentLocation(const Node *node, bool useSubdir)
 {
     if (node == nullptr)
         return QString();
+    if (!s_documentLocationCacheEnabled)
+        return computeFullDocumentLocation(node, useSubdir);
+
+    const DocumentLocationKey key { node, this, currentGenerator(), useSubdir };
+    {
+        QReadLocker locker(&s_documentLocationCacheLock);
+        const auto it = s_documentLocationCache.constFind(key);
+        if (it != s_documentLocationCache.cend())
+            return *it;
+    }
+    const QString location = computeFullDocumentLocation(node, useSubdir);
+    QWriteLocker locker(&s_documentLocationCacheLock);
+    s_documentLocationCache.insert(key, location);
+    return location;
+}
+
+QString Generator::computeFullDocumentLocation(const Node *node, bool useSubdir)
+{
     if (!node->url().isEmpty())
         return node->url();
 
@@ -1012,7 +1094,7 @@ void Generator::generateDocumentation(Node *node)
      */
     CodeMarker *marker = CodeMarker::markerForFileName(node->location().filePath());
 
-    if (node->parent() != nullptr) {
+    if (node->parent() != nullptr && isInShard(node)) {
         if (node->isCollectionNode()) {
             /*
               A collection node collects: groups, C++ modules,
@@ -1546,6 +1628,82 @@ void Generator::generateDocs()
 {
     s_currentGenerator = this;
     generateDocumentation(m_qdb->primaryTreeRoot());
+
+    const Config &config = Config::instance();
+    if (config.generatingShard())
+        writeShardFileList();
+    else if (config.mergingShards())
+        readShardFileLists();
+}
+
+/*!
+  Returns \c true if the page of \a node is generated by this qdoc
+  process. That is every page, unless the generate phase is split
+  with \c {-shard}; then the pages are assigned to the shards by a
+  checksum of their full names, which is the same on every machine
+  of a build farm. With \c {-merge-shards}, no page is generated.
+ */
+bool Generator::isInShard(const Node *node)
+{
+    const Config &config = Config::instance();
+    if (config.mergingShards())
+        return false;
+    if (config.shardCount() < 2)
+        return true;
+    const QByteArray key = node->fullName().toUtf8();
+    return qChecksum(key) % config.shardCount() == config.shardIndex();
+}
+
+/*!
+  Returns the path of the file listing the pages shard \a shard
+  wrote in this generator's format.
+ */
+QString Generator::shardFileListPath(int shard)
+{
+    const QString project = Config::instance().getString(CONFIG_PROJECT).toLower();
+    return s_outDir + QLatin1String("/.") + project + QLatin1Char('.') + format().toLower()
+            + QLatin1String(".shard") + QString::number(shard);
+}
+
+/*!
+  Writes the names of the files this shard generated, one per line,
+  for the qdoc process that runs with \c {-merge-shards} to list
+  them in the help project.
+ */
+void Generator::writeShardFileList()
+{
+    const int shard = Config::instance().shardIndex();
+    QSaveFile file(shardFileListPath(shard));
+    if (file.open(QIODevice::WriteOnly | QIODevice::Text)) {
+        for (const QString &fileName : qAsConst(s_outFileNames))
+            file.write(fileName.toUtf8() + '\n');
+        if (file.commit())
+            return;
+    }
+    Config::instance().lastLocation().error(
+            QStringLiteral("Cannot write the file list of shard %1: %2")
+                    .arg(QString::number(shard), file.errorString()));
+}
+
+/*!
+  Adds the files the shards generated to the output file names, as
+  if this process had generated them.
+ */
+void Generator::readShardFileLists()
+{
+    for (int shard = 0; shard < Config::instance().shardCount(); ++shard) {
+        QFile file(shardFileListPath(shard));
+        if (!file.open(QIODevice::ReadOnly | QIODevice::Text)) {
+            Config::instance().lastLocation().fatal(
+                    QStringLiteral("Cannot read the file list of shard %1: %2")
+                            .arg(QString::number(shard), file.errorString()));
+        }
+        while (!file.atEnd()) {
+            const QString fileName = QString::fromUtf8(file.readLine()).trimmed();
+            if (!fileName.isEmpty())
+                s_outFileNames << fileName;
+        }
+    }
 }
 
 Generator *Generator::generatorForFormat(const QString &format)
@@ -1740,9 +1898,11 @@ void Generator::initializeFormat()
         s_outSubdir = s_outDir.mid(s_outDir.lastIndexOf('/') + 1);
     }
 
+    const bool incremental = config.getBool(CONFIG_INCREMENTAL) && !s_redirectDocumentationToDevNull
+            && !config.preparing();
     QDir outputDir(s_outDir);
     if (outputDir.exists()) {
-        if (!config.generating() && Generator::useOutputSubdirs()) {
+        if (!config.generating() && !incremental && Generator::useOutputSubdirs()) {
             if (!outputDir.isEmpty())
                 config.lastLocation().error(
                         QStringLiteral("Output directory '%1' exists but is not empty")
@@ -1757,6 +1917,18 @@ void Generator::initializeFormat()
     if (config.preparing())
         return;
 
+    if (incremental) {
+        // Each shard removes only the stale pages it wrote itself.
+        const QString project = config.getString(CONFIG_PROJECT).toLower();
+        QString manifest = QLatin1Char('.') + project + QLatin1Char('.') + format().toLower();
+        if (config.generatingShard())
+            manifest += QLatin1String(".shard") + QString::number(config.shardIndex());
+        else if (config.mergingShards())
+            manifest += QLatin1String(".merge");
+        PageWriter::instance().beginIncremental(s_outDir,
+                                                manifest + QLatin1String(".qdocpages"));
+    }
+
     const QLatin1String imagesDir("images");
     if (!outputDir.exists(imagesDir) && !outputDir.mkdir(imagesDir))
         config.lastLocation().fatal(
@@ -1798,7 +1970,7 @@ QTextStream &Generator::out()
 
 QString Generator::outFileName()
 {
-    return QFileInfo(static_cast<QFile *>(out().device())->fileName()).fileName();
+    return QFileInfo(outFileStack.top()->fileName()).fileName();
 }
 
 QString Generator::outputPrefix(const Node *node)
@@ -2000,6 +2172,9 @@ void Generator::supplementAlsoList(const Node *node, QList<Text> &alsoList)
 
 void Generator::terminate()
 {
+    PageWriter::instance().endIncremental();
+    PageWriter::instance().waitForFinished();
+
     for (const auto &generator : qAsConst(s_generators)) {
         if (s_outputFormats.contains(generator->format()))
             generator->terminateGenerator();
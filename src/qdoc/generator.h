@@ -52,6 +52,7 @@ public:
     virtual QString typeString(const Node *node);
 
     QString fullDocumentLocation(const Node *node, bool useSubdir = false);
+    static void setDocumentLocationCacheEnabled(bool enabled);
     QString linkForExampleFile(const QString &path, const QString &fileExt = QString());
     static QString exampleFileTitle(const ExampleNode *relative, const QString &fileName);
     static Generator *currentGenerator() { return s_currentGenerator; }
@@ -61,6 +62,7 @@ public:
     static const QString &outputSubdir() { return s_outSubdir; }
     static void terminate();
     static const QStringList &outputFileNames() { return s_outFileNames; }
+    static bool isInShard(const Node *node);
     static bool noLinkErrors() { return s_noLinkErrors; }
     static bool autolinkErrors() { return s_autolinkErrors; }
     static QString defaultModuleName() { return s_project; }
@@ -155,6 +157,7 @@ protected:
     QString naturalLanguage;
     QString tagFile_;
     QStack<QTextStream *> outStreamStack;
+    QStack<QFile *> outFileStack;
 
     void appendFullName(Text &text, const Node *apparentNode, const Node *relative,
                         const Node *actualNode = nullptr);
@@ -191,8 +194,12 @@ private:
     static bool s_useOutputSubdirs;
     static QmlTypeNode *s_qmlTypeContext;
 
+    QString computeFullDocumentLocation(const Node *node, bool useSubdir);
     void generateReimplementsClause(const FunctionNode *fn, CodeMarker *marker);
     static void copyTemplateFiles(const QString &configVar, const QString &subDir);
+    QString shardFileListPath(int shard);
+    void writeShardFileList();
+    void readShardFileLists();
 
 protected:
     FileResolver& file_resolver;
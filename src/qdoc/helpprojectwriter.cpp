@@ -460,16 +460,39 @@ void HelpProjectWriter::generate()
         generateProject(project);
 }
 
-void HelpProjectWriter::writeHashFile(QFile &file)
+/*!
+  Writes \a data to the help project file \a fileName, and its SHA-1
+  hash to \a fileName with the suffix \c{.sha1}, unless the hash file
+  already has the same hash and the project file exists.
+
+  The project files are rendered completely before they are written, so
+  that the files of projects that did not change keep their time stamps
+  from one run to the next, in incremental and watch mode in particular.
+  Tools like qhelpgenerator that are chained after qdoc then only run
+  for the projects that changed.
+ */
+void HelpProjectWriter::writeProjectFile(const QString &fileName, const QByteArray &data)
 {
-    QCryptographicHash hash(QCryptographicHash::Sha1);
-    hash.addData(&file);
+    const QByteArray hash = QCryptographicHash::hash(data, QCryptographicHash::Sha1).toHex();
+    QFile hashFile(fileName + ".sha1");
+    if (QFile::exists(fileName) && hashFile.open(QFile::ReadOnly | QFile::Text)) {
+        const bool unchanged = hashFile.readAll().trimmed() == hash;
+        hashFile.close();
+        if (unchanged) {
+            qCDebug(lcQdoc, "Help project unchanged: %s", qPrintable(fileName));
+            return;
+        }
+    }
 
-    QFile hashFile(file.fileName() + ".sha1");
-    if (!hashFile.open(QFile::WriteOnly | QFile::Text))
+    QFile file(fileName);
+    if (!file.open(QFile::WriteOnly | QFile::Text))
         return;
+    file.write(data);
+    file.close();
 
-    hashFile.write(hash.result().toHex());
+    if (!hashFile.open(QFile::WriteOnly | QFile::Text))
+        return;
+    hashFile.write(hash);
     hashFile.close();
 }
 
@@ -584,11 +607,8 @@ void HelpProjectWriter::generateProject(HelpProject &project)
     project.m_files.clear();
     project.m_keywords.clear();
 
-    QFile file(m_outputDir + QDir::separator() + project.m_fileName);
-    if (!file.open(QFile::WriteOnly | QFile::Text))
-        return;
-
-    QXmlStreamWriter writer(&file);
+    QByteArray data;
+    QXmlStreamWriter writer(&data);
     writer.setAutoFormatting(true);
     writer.writeStartDocument();
     writer.writeStartElement("QtHelpProject");
@@ -785,8 +805,7 @@ void HelpProjectWriter::generateProject(HelpProject &project)
     writer.writeEndElement(); // filterSection
     writer.writeEndElement(); // QtHelpProject
     writer.writeEndDocument();
-    writeHashFile(file);
-    file.close();
+    writeProjectFile(m_outputDir + QDir::separator() + project.m_fileName, data);
 }
 
 QT_END_NAMESPACE
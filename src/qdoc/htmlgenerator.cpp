@@ -223,6 +223,11 @@ QString HtmlGenerator::format()
   If qdoc is in the \c {-generate} phase, traverse the primary
   tree to generate all the HTML documentation for the current
   module. Then generate the help file and the tag file.
+
+  With \c {-shard}, only the pages of the shard are generated;
+  the help file, the tag file and the manifest are generated for
+  the pages of all shards by the qdoc process that runs with
+  \c {-merge-shards} when the shards are done.
  */
 void HtmlGenerator::generateDocs()
 {
@@ -239,7 +244,8 @@ void HtmlGenerator::generateDocs()
                              m_projectDescription, this);
     }
 
-    if (!config->preparing()) {
+    // With -shard, the process that runs with -merge-shards writes these.
+    if (!config->preparing() && !config->generatingShard()) {
         m_helpProjectWriter->generate();
         m_manifestWriter->generateManifestFiles();
         /*
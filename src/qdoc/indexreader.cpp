@@ -0,0 +1,333 @@
+// Copyright (C) 2023 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
+
+#include "indexreader.h"
+
+#include "utilities.h"
+
+#include <QtCore/qdatetime.h>
+#include <QtCore/qfileinfo.h>
+#include <QtCore/qhash.h>
+#include <QtCore/qsavefile.h>
+
+#include <utility>
+#include <vector>
+
+QT_BEGIN_NAMESPACE
+
+/*!
+  \class IndexReader
+  \internal
+
+  \brief The subset of QXmlStreamReader that QDocIndexFiles uses to
+  read the elements of an index file.
+ */
+
+/*!
+  \class XmlIndexReader
+  \internal
+
+  \brief Reads an .index file with QXmlStreamReader.
+ */
+
+XmlIndexReader::XmlIndexReader(QIODevice *device) : m_reader(device)
+{
+    m_reader.setNamespaceProcessing(false);
+}
+
+/*
+  Layout of the binary index, in native-endian 32-bit words:
+
+  header      magic, version, XML size (2 words), XML modification
+              time (2 words), string count, offset of the string table,
+              offset of the string data, offset of the first token and
+              offset past the last one; offsets count words
+  strings     for each string, the offset of its first character in the
+              string data and its length
+  data        the UTF-16 characters of all strings, padded to a word
+  tokens      a start element is the number of attributes shifted left
+              by one, the name, the offset past its end element and a
+              name and a value per attribute; an end element is a 1.
+ */
+enum : quint32 {
+    BinaryIndexMagic = 0x42584451, // "QDXB"
+    BinaryIndexVersion = 1,
+    HeaderWords = 11,
+    EndElementToken = 1
+};
+
+enum HeaderField : quint32 {
+    Magic,
+    Version,
+    XmlSizeLow,
+    XmlSizeHigh,
+    XmlTimeLow,
+    XmlTimeHigh,
+    StringCount,
+    StringTable,
+    StringData,
+    TokensBegin,
+    TokensEnd
+};
+
+static std::pair<quint64, quint64> xmlStamp(const QString &indexPath)
+{
+    const QFileInfo info(indexPath);
+    return { quint64(info.size()), quint64(info.lastModified().toMSecsSinceEpoch()) };
+}
+
+/*!
+  \class BinaryIndexReader
+  \internal
+
+  \brief Reads the binary cache of an .index file.
+
+  The cache holds the start and end elements of the XML file together
+  with a table of all the strings in it. The file is mapped into memory,
+  names and attribute values are read from it without decoding XML,
+  and skipping an element jumps past its end without visiting its
+  children. The cache is written next to the .index file by
+  generateIndex(); it is only used while the size and modification time
+  of the .index file match the ones it was written for.
+ */
+
+/*!
+  Maps the cache of the index file \a indexPath, if it is valid.
+ */
+BinaryIndexReader::BinaryIndexReader(const QString &indexPath) : m_file(cachePath(indexPath))
+{
+    if (m_file.open(QFile::ReadOnly))
+        load(m_file.map(0, m_file.size()), m_file.size(), indexPath);
+}
+
+/*!
+  Reads the binary index \a data of the index file \a indexPath, as
+  returned by encode().
+ */
+BinaryIndexReader::BinaryIndexReader(const QString &indexPath, QByteArray data)
+    : m_data(std::move(data))
+{
+    load(reinterpret_cast<const uchar *>(m_data.constData()), m_data.size(), indexPath);
+}
+
+void BinaryIndexReader::load(const uchar *data, qint64 size, const QString &indexPath)
+{
+    if (!data || size < qint64(HeaderWords * sizeof(quint32)) || size % sizeof(quint32) != 0)
+        return;
+    const auto *words = reinterpret_cast<const quint32 *>(data);
+
+    const auto wordCount = quint64(size / sizeof(quint32));
+    const auto [xmlSize, xmlTime] = xmlStamp(indexPath);
+    const bool valid = words[Magic] == BinaryIndexMagic && words[Version] == BinaryIndexVersion
+            && words[XmlSizeLow] == quint32(xmlSize) && words[XmlSizeHigh] == quint32(xmlSize >> 32)
+            && words[XmlTimeLow] == quint32(xmlTime) && words[XmlTimeHigh] == quint32(xmlTime >> 32)
+            && words[StringTable] + 2 * quint64(words[StringCount]) <= words[StringData]
+            && words[StringData] <= words[TokensBegin] && words[TokensBegin] <= words[TokensEnd]
+            && words[TokensEnd] <= wordCount;
+    if (!valid)
+        return;
+
+    m_words = words;
+    m_stringCount = words[StringCount];
+    m_stringData = reinterpret_cast<const char16_t *>(words + words[StringData]);
+    m_tokensBegin = words[TokensBegin];
+    m_tokensEnd = words[TokensEnd];
+    m_current = m_tokensBegin;
+}
+
+BinaryIndexReader::~BinaryIndexReader() = default;
+
+/*!
+  Returns the path of the binary cache of the index file \a indexPath.
+ */
+QString BinaryIndexReader::cachePath(const QString &indexPath)
+{
+    return indexPath + QLatin1String(".bin");
+}
+
+bool BinaryIndexReader::readNextStartElement()
+{
+    return readNext() && isStartElement();
+}
+
+bool BinaryIndexReader::readNext()
+{
+    if (!m_started) {
+        m_started = true;
+        return m_current < m_tokensEnd;
+    }
+    if (m_current >= m_tokensEnd)
+        return false;
+    const quint32 token = m_words[m_current];
+    const quint64 next = token == EndElementToken ? m_current + 1 : m_current + 3 + quint64(token);
+    m_current = quint32(qMin(next, quint64(m_tokensEnd)));
+    return m_current < m_tokensEnd;
+}
+
+void BinaryIndexReader::skipCurrentElement()
+{
+    if (isStartElement()) {
+        const quint32 past = m_words[m_current + 2];
+        if (past > m_current && past <= m_tokensEnd && m_words[past - 1] == EndElementToken) {
+            m_current = past - 1;
+            return;
+        }
+    }
+    int depth = 1;
+    while (depth && readNext()) {
+        if (isEndElement())
+            --depth;
+        else if (isStartElement())
+            ++depth;
+    }
+}
+
+bool BinaryIndexReader::isEndElement() const
+{
+    return m_started && m_current < m_tokensEnd && m_words[m_current] == EndElementToken;
+}
+
+bool BinaryIndexReader::isStartElement() const
+{
+    return m_started && m_current < m_tokensEnd && (m_words[m_current] & 1) == 0
+            && m_current + 3 + quint64(m_words[m_current]) <= m_tokensEnd;
+}
+
+QStringView BinaryIndexReader::name() const
+{
+    return isStartElement() ? string(m_words[m_current + 1]) : QStringView();
+}
+
+QXmlStreamAttributes BinaryIndexReader::attributes() const
+{
+    QXmlStreamAttributes result;
+    if (!isStartElement())
+        return result;
+    const quint32 count = m_words[m_current] >> 1;
+    const quint32 *attribute = m_words + m_current + 3;
+    result.reserve(count);
+    for (quint32 i = 0; i < count; ++i, attribute += 2)
+        result.append(string(attribute[0]).toString(), string(attribute[1]).toString());
+    return result;
+}
+
+QStringView BinaryIndexReader::string(quint32 id) const
+{
+    if (id >= m_stringCount)
+        return {};
+    const quint32 *entry = m_words + m_words[StringTable] + 2 * quint64(id);
+    const quint64 end = quint64(entry[0]) + entry[1];
+    if (end > 2 * quint64(m_tokensBegin - m_words[StringData]))
+        return {};
+    return QStringView(m_stringData + entry[0], qsizetype(entry[1]));
+}
+
+/*!
+  Returns the binary index of the index file \a indexPath, or an empty
+  byte array if the index file cannot be read.
+ */
+QByteArray BinaryIndexReader::encode(const QString &indexPath)
+{
+    QFile file(indexPath);
+    if (!file.open(QFile::ReadOnly))
+        return {};
+
+    QHash<QString, quint32> ids;
+    std::vector<QString> strings;
+    const auto intern = [&](QStringView s) {
+        const QString string = s.toString();
+        auto it = ids.constFind(string);
+        if (it == ids.cend()) {
+            it = ids.insert(string, quint32(strings.size()));
+            strings.push_back(string);
+        }
+        return *it;
+    };
+
+    std::vector<quint32> tokens;
+    std::vector<size_t> open;
+    QXmlStreamReader reader(&file);
+    reader.setNamespaceProcessing(false);
+    while (!reader.atEnd()) {
+        reader.readNext();
+        if (reader.isStartElement()) {
+            const QXmlStreamAttributes attributes = reader.attributes();
+            open.push_back(tokens.size());
+            tokens.push_back(quint32(attributes.size()) << 1);
+            tokens.push_back(intern(reader.qualifiedName()));
+            tokens.push_back(0);
+            for (const QXmlStreamAttribute &attribute : attributes) {
+                tokens.push_back(intern(attribute.qualifiedName()));
+                tokens.push_back(intern(attribute.value()));
+            }
+        } else if (reader.isEndElement() && !open.empty()) {
+            tokens.push_back(EndElementToken);
+            tokens[open.back() + 2] = quint32(tokens.size());
+            open.pop_back();
+        }
+    }
+    if (reader.hasError())
+        return {};
+    file.close();
+
+    std::vector<quint32> table;
+    QString data;
+    table.reserve(2 * strings.size());
+    for (const QString &string : strings) {
+        table.push_back(quint32(data.size()));
+        table.push_back(quint32(string.size()));
+        data += string;
+    }
+    if (data.size() % 2)
+        data += QChar::Null;
+
+    const quint32 stringTable = HeaderWords;
+    const quint32 stringData = stringTable + quint32(table.size());
+    const quint32 tokensBegin = stringData + quint32(data.size() / 2);
+    const quint32 tokensEnd = tokensBegin + quint32(tokens.size());
+    // The offsets past the end elements are relative to the first token.
+    for (size_t i = 0; i < tokens.size(); i += tokens[i] == EndElementToken ? 1 : 3 + tokens[i])
+        if (tokens[i] != EndElementToken)
+            tokens[i + 2] += tokensBegin;
+
+    const auto [xmlSize, xmlTime] = xmlStamp(indexPath);
+    const quint32 header[HeaderWords] = {
+        BinaryIndexMagic, BinaryIndexVersion, quint32(xmlSize), quint32(xmlSize >> 32),
+        quint32(xmlTime), quint32(xmlTime >> 32), quint32(strings.size()), stringTable,
+        stringData, tokensBegin, tokensEnd
+    };
+
+    QByteArray result;
+    result.reserve(qsizetype(tokensEnd) * qsizetype(sizeof(quint32)));
+    result.append(reinterpret_cast<const char *>(header), sizeof(header));
+    result.append(reinterpret_cast<const char *>(table.data()),
+                  qsizetype(table.size() * sizeof(quint32)));
+    result.append(reinterpret_cast<const char *>(data.constData()), data.size() * 2);
+    result.append(reinterpret_cast<const char *>(tokens.data()),
+                  qsizetype(tokens.size() * sizeof(quint32)));
+    return result;
+}
+
+/*!
+  Writes the binary cache of the index file \a indexPath. Returns
+  \c false if the index file cannot be read or the cache cannot be
+  written.
+ */
+bool BinaryIndexReader::write(const QString &indexPath)
+{
+    const QByteArray data = encode(indexPath);
+    if (data.isEmpty())
+        return false;
+
+    QSaveFile cache(cachePath(indexPath));
+    if (!cache.open(QFile::WriteOnly))
+        return false;
+    cache.write(data);
+    if (!cache.commit()) {
+        qCDebug(lcQdoc) << "Cannot write binary index" << cachePath(indexPath);
+        return false;
+    }
+    return true;
+}
+
+QT_END_NAMESPACE
@@ -0,0 +1,83 @@
+// Copyright (C) 2023 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
+
+#ifndef INDEXREADER_H
+#define INDEXREADER_H
+
+#include <QtCore/qfile.h>
+#include <QtCore/qstring.h>
+#include <QtCore/qxmlstream.h>
+
+QT_BEGIN_NAMESPACE
+
+class IndexReader
+{
+public:
+    virtual ~IndexReader() = default;
+
+    virtual bool readNextStartElement() = 0;
+    virtual bool readNext() = 0;
+    virtual void skipCurrentElement() = 0;
+    [[nodiscard]] virtual bool isEndElement() const = 0;
+    [[nodiscard]] virtual QStringView name() const = 0;
+    [[nodiscard]] virtual QXmlStreamAttributes attributes() const = 0;
+};
+
+class XmlIndexReader : public IndexReader
+{
+public:
+    explicit XmlIndexReader(QIODevice *device);
+
+    bool readNextStartElement() override { return m_reader.readNextStartElement(); }
+    bool readNext() override { return m_reader.readNext() != QXmlStreamReader::Invalid; }
+    void skipCurrentElement() override { m_reader.skipCurrentElement(); }
+    [[nodiscard]] bool isEndElement() const override { return m_reader.isEndElement(); }
+    [[nodiscard]] QStringView name() const override { return m_reader.name(); }
+    [[nodiscard]] QXmlStreamAttributes attributes() const override
+    {
+        return m_reader.attributes();
+    }
+
+private:
+    QXmlStreamReader m_reader;
+};
+
+class BinaryIndexReader : public IndexReader
+{
+public:
+    explicit BinaryIndexReader(const QString &indexPath);
+    BinaryIndexReader(const QString &indexPath, QByteArray data);
+    ~BinaryIndexReader() override;
+
+    [[nodiscard]] bool isValid() const { return m_words != nullptr; }
+
+    bool readNextStartElement() override;
+    bool readNext() override;
+    void skipCurrentElement() override;
+    [[nodiscard]] bool isEndElement() const override;
+    [[nodiscard]] QStringView name() const override;
+    [[nodiscard]] QXmlStreamAttributes attributes() const override;
+
+    static QString cachePath(const QString &indexPath);
+    static QByteArray encode(const QString &indexPath);
+    static bool write(const QString &indexPath);
+
+private:
+    void load(const uchar *data, qint64 size, const QString &indexPath);
+    [[nodiscard]] QStringView string(quint32 id) const;
+    [[nodiscard]] bool isStartElement() const;
+
+    QFile m_file;
+    QByteArray m_data;
+    const quint32 *m_words { nullptr };
+    const char16_t *m_stringData { nullptr };
+    quint32 m_stringCount { 0 };
+    quint32 m_tokensBegin { 0 };
+    quint32 m_tokensEnd { 0 };
+    quint32 m_current { 0 };
+    bool m_started { false };
+};
+
+QT_END_NAMESPACE
+
+#endif // INDEXREADER_H
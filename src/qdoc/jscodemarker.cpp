@@ -66,11 +66,18 @@ Atom::AtomType JsCodeMarker::atomType() const
 QString JsCodeMarker::markedUpCode(const QString &code, const Node *relative,
                                    const Location &location)
 {
-    return addMarkUp(code, relative, location);
+    return cachedMarkUp(code, [&](bool &complete) {
+        return addMarkUp(code, relative, location, &complete);
+    });
 }
 
+/*!
+  Returns \a code marked up as JavaScript. Sets \a complete, if given, to
+  \c false if the code could not be fully analyzed, in which case a
+  warning is reported at \a location.
+ */
 QString JsCodeMarker::addMarkUp(const QString &code, const Node * /* relative */,
-                                const Location &location)
+                                const Location &location, bool *complete)
 {
 #ifndef QT_NO_DECLARATIVE
     QQmlJS::Engine engine;
@@ -90,12 +97,16 @@ QString JsCodeMarker::addMarkUp(const QString &code, const Node * /* relative */
         QmlMarkupVisitor visitor(code, pragmas, &engine);
         QQmlJS::AST::Node::accept(ast, &visitor);
         if (visitor.hasError()) {
+            if (complete)
+                *complete = false;
             location.warning(
                     location.fileName()
                     + QStringLiteral("Unable to analyze JavaScript. The output is incomplete."));
         }
         output = visitor.markedUpCode();
     } else {
+        if (complete)
+            *complete = false;
         location.warning(
                 location.fileName()
                 + QStringLiteral("Unable to parse JavaScript: \"%1\" at line %2, column %3")
@@ -107,6 +118,8 @@ QString JsCodeMarker::addMarkUp(const QString &code, const Node * /* relative */
     return output;
 #else
     Q_UNUSED(code);
+    if (complete)
+        *complete = false;
     location.warning("QtDeclarative not installed; cannot parse QML or JS.");
     return QString();
 #endif
@@ -23,7 +23,8 @@ public:
                          const Location &location) override;
 
 private:
-    QString addMarkUp(const QString &code, const Node *relative, const Location &location);
+    QString addMarkUp(const QString &code, const Node *relative, const Location &location,
+                      bool *complete = nullptr);
 };
 
 QT_END_NAMESPACE
@@ -7,11 +7,13 @@
 
 #include <QtCore/qdebug.h>
 #include <QtCore/qdir.h>
+#include <QtCore/qmutex.h>
 #include <QtCore/qregularexpression.h>
 
 #include <climits>
 #include <cstdio>
 #include <cstdlib>
+#include <unordered_set>
 
 QT_BEGIN_NAMESPACE
 
@@ -21,6 +23,30 @@ int Location::s_warningLimit = -1;
 QString Location::s_programName;
 QString Location::s_project;
 QRegularExpression *Location::s_spuriousRegExp = nullptr;
+const QString Location::s_noFilePath;
+
+namespace {
+struct FilePathHash
+{
+    size_t operator()(const QString &filePath) const noexcept { return qHash(filePath); }
+};
+} // namespace
+
+/*!
+  \internal
+  Returns the entry for \a filePath in the table of file paths, adding
+  it first if needed. Locations refer to the entries by address; they
+  are never removed, and std::unordered_set does not move them.
+
+  This function is thread-safe.
+ */
+static const QString *internFilePath(const QString &filePath)
+{
+    static QMutex mutex;
+    static std::unordered_set<QString, FilePathHash> filePaths;
+    QMutexLocker locker(&mutex);
+    return &*filePaths.insert(filePath).first;
+}
 
 /*!
   \class Location
@@ -120,6 +146,9 @@ void Location::advance(QChar ch)
   Pushes \a filePath onto the file position stack. The current
   file position becomes (\a filePath, 1, 1).
 
+  The path is interned, as the locations of all the nodes declared
+  in a file refer to it, and the location keeps a pointer to it.
+
   \sa pop()
 */
 void Location::push(const QString &filePath)
@@ -131,7 +160,7 @@ void Location::push(const QString &filePath)
         m_stkTop = &m_stk->top();
     }
 
-    m_stkTop->m_filePath = filePath;
+    m_stkTop->m_filePath = internFilePath(filePath);
     m_stkTop->m_lineNo = INT_MIN;
     m_stkTop->m_columnNo = 1;
 }
@@ -37,7 +37,10 @@ public:
 
     [[nodiscard]] bool isEmpty() const { return m_stkDepth == 0; }
     [[nodiscard]] int depth() const { return m_stkDepth; }
-    [[nodiscard]] const QString &filePath() const { return m_stkTop->m_filePath; }
+    [[nodiscard]] const QString &filePath() const
+    {
+        return m_stkTop->m_filePath ? *m_stkTop->m_filePath : s_noFilePath;
+    }
     [[nodiscard]] QString fileName() const;
     [[nodiscard]] QString fileSuffix() const;
     [[nodiscard]] int lineNo() const { return m_stkTop->m_lineNo; }
@@ -59,9 +62,11 @@ public:
 private:
     enum MessageType { Warning, Error, Report };
 
+    // The file path points into a table of interned paths that is never
+    // shrunk, so copying a location does not touch any reference count.
     struct StackEntry
     {
-        QString m_filePath {};
+        const QString *m_filePath {};
         int m_lineNo {};
         int m_columnNo {};
     };
@@ -83,8 +88,9 @@ private:
     static QString s_programName;
     static QString s_project;
     static QRegularExpression *s_spuriousRegExp;
+    static const QString s_noFilePath;
 };
-Q_DECLARE_TYPEINFO(Location::StackEntry, Q_RELOCATABLE_TYPE);
+Q_DECLARE_TYPEINFO(Location::StackEntry, Q_PRIMITIVE_TYPE);
 Q_DECLARE_TYPEINFO(Location, Q_COMPLEX_TYPE); // stkTop = &stkBottom
 
 QT_END_NAMESPACE
@@ -15,8 +15,10 @@
 #include "qdocdatabase.h"
 #include "qmlcodemarker.h"
 #include "qmlcodeparser.h"
+#include "timings.h"
 #include "utilities.h"
 #include "qtranslator.h"
+#include "sections.h"
 #include "tokenizer.h"
 #include "tree.h"
 #include "webxmlgenerator.h"
@@ -28,6 +30,7 @@
 #include <QtCore/qdebug.h>
 #include <QtCore/qglobal.h>
 #include <QtCore/qhashfunctions.h>
+#include <QtCore/qthread.h>
 
 #ifndef QT_BOOTSTRAPPED
 #    include <QtCore/qcoreapplication.h>
@@ -35,6 +38,7 @@
 
 #include <algorithm>
 #include <cstdlib>
+#include <optional>
 
 QT_BEGIN_NAMESPACE
 
@@ -49,6 +53,18 @@ static QList<Translator> translators;
 #endif
 
 static ClangCodeParser *clangParser_ = nullptr;
+static QmlCodeParser *qmlParser_ = nullptr;
+
+/*
+  The project and the files each qdoc config file was last
+  processed from, for -watch.
+ */
+struct WatchedProject
+{
+    QString project;
+    QStringList files;
+};
+static QHash<QString, WatchedProject> watchedProjects_;
 
 /*!
   Read some XML indexes containing definitions from other
@@ -200,6 +216,67 @@ static void loadIndexFiles(const QSet<QString> &formats)
     qdb->readIndexes(indexFiles);
 }
 
+/*!
+    \internal
+    Returns the modification times of \a files and of the directories
+    they are in, so that added and removed files are noticed too.
+ */
+static QHash<QString, qint64> modificationTimes(const QStringList &files)
+{
+    QHash<QString, qint64> result;
+    for (const auto &file : files) {
+        const QFileInfo info(file);
+        result.insert(file, info.exists() ? info.lastModified().toMSecsSinceEpoch() : -1);
+        const QString dir = info.absolutePath();
+        if (!result.contains(dir))
+            result.insert(dir, QFileInfo(dir).lastModified().toMSecsSinceEpoch());
+    }
+    return result;
+}
+
+static void processQdocconfFile(const QString &fileName);
+
+/*!
+    \internal
+    Processes each of the qdoc config files \a qdocFiles again whenever
+    one of the files it was last processed from changes, until qdoc is
+    killed.
+
+    The loaded index trees stay in memory, and the module's PCH is
+    taken from the PCH cache, or from a temporary directory kept while
+    watching if there is no cache. The previous tree of a project is
+    deleted before the project is processed again. Only the pages whose
+    contents changed are written, as with -incremental.
+ */
+static void watchQdocconfFiles(const QStringList &qdocFiles)
+{
+    Config &config = Config::instance();
+    QHash<QString, QHash<QString, qint64>> times;
+    qsizetype count = 0;
+    for (const auto &file : qdocFiles) {
+        times.insert(file, modificationTimes(watchedProjects_.value(file).files));
+        count += watchedProjects_.value(file).files.size();
+    }
+    qCInfo(lcQdoc) << "Watching" << count << "files for changes";
+
+    // Polled rather than watched with QFileSystemWatcher, which runs out of
+    // inotify watches on large documentation projects.
+    forever {
+        QThread::msleep(500);
+        for (const auto &file : qdocFiles) {
+            const WatchedProject watched = watchedProjects_.value(file);
+            if (modificationTimes(watched.files) == times.value(file))
+                continue;
+            qCInfo(lcQdoc) << "Files changed; generating the docs for" << watched.project
+                           << "again";
+            QDocDatabase::qdocDB()->retireTree(watched.project);
+            config.dependModules().clear();
+            processQdocconfFile(file);
+            times.insert(file, modificationTimes(watchedProjects_.value(file).files));
+        }
+    }
+}
+
 /*!
     \internal
     Prints to stderr the name of the project that QDoc is running for,
@@ -241,8 +318,14 @@ static void processQdocconfFile(const QString &fileName)
       purposes.
      */
     Location::initialize();
+    std::optional<Timings::Phase> loadPhase;
+    loadPhase.emplace(QStringLiteral("load config"));
     config.load(fileName);
     QString project = config.getString(CONFIG_PROJECT);
+    Timings::instance().setProject(project);
+    loadPhase.reset();
+    if (config.watching())
+        watchedProjects_[fileName] = { project, config.loadedFiles() };
     if (project.isEmpty()) {
         qCCritical(lcQdoc) << QLatin1String("qdoc can't run; no project set in qdocconf file");
         exit(1);
@@ -439,6 +522,7 @@ static void processQdocconfFile(const QString &fileName)
     if (!config.singleExec()) {
         if (!config.preparing()) {
             qCDebug(lcQdoc, "  loading index files");
+            Timings::Phase phase(QStringLiteral("load index files"));
             loadIndexFiles(outputFormats);
             qCDebug(lcQdoc, "  done loading index files");
         }
@@ -522,6 +606,8 @@ static void processQdocconfFile(const QString &fileName)
 
         qCDebug(lcQdoc, "Parsing header files");
         int parsed = 0;
+        std::optional<Timings::Phase> parsePhase;
+        parsePhase.emplace(QStringLiteral("parse headers"));
         for (auto it = headers.constBegin(); it != headers.constEnd(); ++it) {
             CodeParser *codeParser = CodeParser::parserForHeaderFile(it.key());
             if (codeParser) {
@@ -531,6 +617,7 @@ static void processQdocconfFile(const QString &fileName)
             }
         }
 
+        parsePhase.emplace(QStringLiteral("precompile headers"));
         clangParser_->precompileHeaders();
 
         /*
@@ -538,8 +625,21 @@ static void processQdocconfFile(const QString &fileName)
           add it to the big tree.
         */
         parsed = 0;
+        parsePhase.emplace(QStringLiteral("parse sources"));
         qCInfo(lcQdoc) << "Parse source files for" << project;
-        for (const auto &key : sources.keys()) {
+        const QStringList sourceFiles = sources.keys();
+        QStringList clangSourceFiles;
+        QStringList qmlSourceFiles;
+        for (const auto &key : sourceFiles) {
+            const CodeParser *codeParser = CodeParser::parserForSourceFile(key);
+            if (codeParser == clangParser_)
+                clangSourceFiles << key;
+            else if (codeParser == qmlParser_)
+                qmlSourceFiles << key;
+        }
+        clangParser_->parseSourceFilesAhead(clangSourceFiles);
+        qmlParser_->parseSourceFilesAhead(qmlSourceFiles);
+        for (const auto &key : sourceFiles) {
             auto *codeParser = CodeParser::parserForSourceFile(key);
             if (codeParser) {
                 ++parsed;
@@ -548,6 +648,11 @@ static void processQdocconfFile(const QString &fileName)
             }
         }
         qCInfo(lcQdoc) << "Source files parsed for" << project;
+
+        if (config.watching()) {
+            QStringList &watched = watchedProjects_[fileName].files;
+            watched << headers.keys() << sourceFiles;
+        }
     }
     /*
       Now the primary tree has been built from all the header and
@@ -555,7 +660,11 @@ static void processQdocconfFile(const QString &fileName)
       targets, URLs, links, and other stuff that needs resolving.
     */
     qCDebug(lcQdoc, "Resolving stuff prior to generating docs");
-    qdb->resolveStuff();
+    {
+        Timings::Phase phase(QStringLiteral("resolve"));
+        qdb->resolveStuff();
+    }
+    qdb->recordNodeStatistics();
 
     /*
       The primary tree is built and all the stuff that needed
@@ -565,14 +674,22 @@ static void processQdocconfFile(const QString &fileName)
       one.
      */
     qCDebug(lcQdoc, "Generating docs");
+    // The generators for each format ask for the same sections and links.
+    Sections::setCacheEnabled(outputFormats.size() > 1);
+    qdb->setLinkCacheEnabled(outputFormats.size() > 1);
+    Generator::setDocumentLocationCacheEnabled(true);
     for (const auto &format : outputFormats) {
         auto *generator = Generator::generatorForFormat(format);
         if (generator == nullptr)
             outputFormatsLocation.fatal(
                     QCoreApplication::translate("QDoc", "Unknown output format '%1'").arg(format));
+        Timings::Phase phase(QStringLiteral("generate ") + format);
         generator->initializeFormat();
         generator->generateDocs();
     }
+    Sections::setCacheEnabled(false);
+    qdb->setLinkCacheEnabled(false);
+    Generator::setDocumentLocationCacheEnabled(false);
 
     qCDebug(lcQdoc, "Terminating qdoc classes");
     if (Utilities::debugging())
@@ -612,6 +729,7 @@ int main(int argc, char **argv)
     ClangCodeParser clangParser;
     clangParser_ = &clangParser;
     QmlCodeParser qmlParser;
+    qmlParser_ = &qmlParser;
     PureDocParser docParser;
 
     /*
@@ -631,6 +749,7 @@ int main(int argc, char **argv)
 
     Config::instance().init(QCoreApplication::translate("QDoc", "qdoc"), app.arguments());
     Config &config = Config::instance();
+    Timings::instance().setOutputFile(config.timingsFile());
 
     // Get the list of files to act on:
     QStringList qdocFiles = config.qdocFiles();
@@ -659,6 +778,8 @@ int main(int argc, char **argv)
             config.dependModules().clear();
             processQdocconfFile(file);
         }
+        if (config.watching())
+            watchQdocconfFiles(qdocFiles);
     }
 
     // Tidy everything away:
@@ -679,5 +800,6 @@ int main(int argc, char **argv)
     qDebug() << "main(): qdoc database deleted";
 #endif
 
+    Timings::instance().write();
     return Location::exitCode();
 }
@@ -107,6 +107,20 @@ void NamespaceNode::includeChild(Node *child)
     m_includedChildren.append(child);
 }
 
+/*!
+  Removes the included children that belong to \a tree, and the
+  documentation node if it belongs to \a tree, before the tree is
+  deleted.
+
+  \sa includeChild(), QDocForest::retireTree()
+ */
+void NamespaceNode::removeIncludedChildren(const Tree *tree)
+{
+    m_includedChildren.removeIf([tree](const Node *child) { return child->tree() == tree; });
+    if (m_docNode && m_docNode->tree() == tree)
+        m_docNode = nullptr;
+}
+
 /*! \fn Tree* NamespaceNode::tree() const
   Returns a pointer to the Tree that contains this NamespaceNode.
   This requires traversing the parent() pointers to the root of
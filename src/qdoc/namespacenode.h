@@ -27,6 +27,7 @@ public:
     void setTree(Tree *t) { m_tree = t; }
     [[nodiscard]] const NodeList &includedChildren() const;
     void includeChild(Node *child);
+    void removeIncludedChildren(const Tree *tree);
     void setWhereDocumented(const QString &t) { m_whereDocumented = t; }
     [[nodiscard]] bool isDocumentedHere() const;
     [[nodiscard]] bool hasDocumentedChildren() const;
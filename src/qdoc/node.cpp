@@ -16,6 +16,7 @@
 #include "sharedcommentnode.h"
 #include "tokenizer.h"
 #include "tree.h"
+#include "utilities.h"
 
 #include <QtCore/quuid.h>
 #include <QtCore/qversionnumber.h>
@@ -26,6 +27,7 @@ QT_BEGIN_NAMESPACE
 
 QStringMap Node::operators;
 QMap<QString, Node::NodeType> Node::goals;
+const QString Node::s_noString;
 
 /*!
   \class Node
@@ -1013,7 +1015,7 @@ void Node::setSince(const QString &since)
     if (!cutoff.isNull() && QVersionNumber::fromString(parts.last()).normalized() < cutoff)
         return;
 
-    m_since = parts.join(QLatin1Char(' '));
+    m_since = Utilities::intern(parts.join(QLatin1Char(' ')));
 }
 
 /*!
@@ -1243,12 +1245,37 @@ QString Node::fullDocumentName() const
 
 void Node::setDeprecatedSince(const QString &sinceVersion)
 {
-    if (!m_deprecatedSince.isEmpty())
+    if (!deprecatedSince().isEmpty())
         qCWarning(lcQdoc) << QStringLiteral(
                                      "Setting deprecated since version for %1 to %2 even though it "
                                      "was already set to %3. This is very unexpected.")
-                                     .arg(this->m_name, sinceVersion, this->m_deprecatedSince);
-    m_deprecatedSince = sinceVersion;
+                                     .arg(this->m_name, sinceVersion, deprecatedSince());
+    if (!sinceVersion.isEmpty() || m_rareFields.constData())
+        rareFields()->m_deprecatedSince = Utilities::intern(sinceVersion);
+}
+
+/*!
+  Sets the template declaration of the node to \a t.
+ */
+void Node::setTemplateDecl(const QString &t)
+{
+    if (!t.isEmpty() || m_rareFields.constData())
+        rareFields()->m_templateDecl = t;
+}
+
+/*!
+  \internal
+  Returns the rarely set fields of this node, allocating them first
+  if none was set yet.
+
+  Most nodes are not templates and are not deprecated, so those fields
+  are kept out of the node until one of them is set.
+ */
+Node::RareFields *Node::rareFields()
+{
+    if (!m_rareFields)
+        m_rareFields = new RareFields;
+    return m_rareFields.data();
 }
 
 /*! \fn Node *Node::clone(Aggregate *parent)
@@ -1328,9 +1355,14 @@ void Node::setDeprecatedSince(const QString &sinceVersion)
   \sa ThreadSafeness
 */
 
-/*! \fn void Node::setPhysicalModuleName(const QString &name)
-  Sets the node's physical module \a name.
+/*!
+  Sets the node's physical module \a name. The name is interned, as
+  it is the same for all the nodes of a module.
 */
+void Node::setPhysicalModuleName(const QString &name)
+{
+    m_physicalModuleName = Utilities::intern(name);
+}
 
 /*! \fn void Node::setReconstitutedBrief(const QString &t)
   When reading an index file, this function is called with the
@@ -16,6 +16,7 @@
 #include <QtCore/qlist.h>
 #include <QtCore/qmap.h>
 #include <QtCore/qpair.h>
+#include <QtCore/qshareddata.h>
 #include <QtCore/qstringlist.h>
 
 QT_BEGIN_NAMESPACE
@@ -228,9 +229,9 @@ public:
     void setStatus(Status t);
     void setThreadSafeness(ThreadSafeness t) { m_safeness = t; }
     void setSince(const QString &since);
-    void setPhysicalModuleName(const QString &name) { m_physicalModuleName = name; }
+    void setPhysicalModuleName(const QString &name);
     void setUrl(const QString &url) { m_url = url; }
-    void setTemplateDecl(const QString &t) { m_templateDecl = t; }
+    void setTemplateDecl(const QString &t);
     void setReconstitutedBrief(const QString &t) { m_reconstitutedBrief = t; }
     void setParent(Aggregate *n) { m_parent = n; }
     void setIndexNodeFlag(bool isIndexNode = true) { m_indexNodeFlag = isIndexNode; }
@@ -279,7 +280,10 @@ public:
     [[nodiscard]] virtual bool hasTag(const QString &) const { return false; }
 
     void setDeprecatedSince(const QString &sinceVersion);
-    [[nodiscard]] const QString &deprecatedSince() const { return m_deprecatedSince; }
+    [[nodiscard]] const QString &deprecatedSince() const
+    {
+        return m_rareFields ? m_rareFields->m_deprecatedSince : s_noString;
+    }
 
     [[nodiscard]] const QMap<LinkType, QPair<QString, QString>> &links() const { return m_linkMap; }
     void setLink(LinkType linkType, const QString &link, const QString &desc);
@@ -304,7 +308,10 @@ public:
     [[nodiscard]] ThreadSafeness threadSafeness() const;
     [[nodiscard]] ThreadSafeness inheritedThreadSafeness() const;
     [[nodiscard]] QString since() const { return m_since; }
-    [[nodiscard]] const QString &templateDecl() const { return m_templateDecl; }
+    [[nodiscard]] const QString &templateDecl() const
+    {
+        return m_rareFields ? m_rareFields->m_templateDecl : s_noString;
+    }
     [[nodiscard]] const QString &reconstitutedBrief() const { return m_reconstitutedBrief; }
 
     [[nodiscard]] bool isSharingComment() const { return (m_sharedCommentNode != nullptr); }
@@ -345,6 +352,14 @@ protected:
     Node(NodeType type, Aggregate *parent, QString name);
 
 private:
+    // Fields that few nodes set, allocated by the first one that is set.
+    struct RareFields : public QSharedData
+    {
+        QString m_templateDecl {};
+        QString m_deprecatedSince {};
+    };
+    RareFields *rareFields();
+
     NodeType m_nodeType {};
     Genus m_genus {};
     Access m_access { Access::Public };
@@ -366,12 +381,12 @@ private:
     QString m_physicalModuleName {};
     QString m_url {};
     QString m_since {};
-    QString m_templateDecl {};
     QString m_reconstitutedBrief {};
     QString m_outSubDir {};
     static QStringMap operators;
     static QMap<QString, Node::NodeType> goals;
-    QString m_deprecatedSince {};
+    QSharedDataPointer<RareFields> m_rareFields {};
+    static const QString s_noString;
     const Node *m_navParent { nullptr };
 };
 
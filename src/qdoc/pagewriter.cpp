@@ -0,0 +1,322 @@
+// Copyright (C) 2023 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
+
+#include "pagewriter.h"
+
+#include "utilities.h"
+
+#include <QtCore/qcryptographichash.h>
+#include <QtCore/qdatetime.h>
+#include <QtCore/qdir.h>
+#include <QtCore/qfile.h>
+#include <QtCore/qfileinfo.h>
+#include <QtCore/qstringconverter.h>
+
+#include <algorithm>
+
+QT_BEGIN_NAMESPACE
+
+// The number of pages that may wait to be written; the generator blocks
+// when it gets that far ahead of the disk.
+static const qsizetype kMaxQueuedPages = 64;
+
+// The number of page buffers kept for reuse once their pages are written.
+static const qsizetype kMaxPooledBuffers = 16;
+
+/*!
+  \class PageWriter
+  \internal
+
+  \brief Writes the generated pages to their files on worker threads.
+
+  The generators render each page into memory and hand it over together
+  with its open output file when the page is complete. Encoding the text
+  and writing it to the disk then overlap with the rendering of the
+  following pages. The files are opened by the generators, so errors
+  opening them are still reported where the page is generated.
+
+  The generators render into strings they get from takeBuffer(). Once a
+  page is written, its string is emptied and kept for a following page,
+  so that the text of a page does not have to grow from nothing by
+  reallocation. Each worker encodes the pages into a UTF-8 buffer of its
+  own, which is reused for every page it writes with a single write().
+
+  In incremental mode, the writer keeps a manifest with a hash of every
+  page it writes to an output directory. Pages whose hash and file did
+  not change since the previous run are not written again, so their
+  files keep their time stamps, and the files of pages that are no
+  longer generated are removed. The files are only opened by the
+  writer in that mode, once it knows they have to be written.
+
+  The writer also keeps track of the images and other files the pages
+  refer to. They are copied on the calling thread, so that errors are
+  reported where the file is referenced, but each file is copied once
+  per run, and not at all if the copy in the output directory has the
+  same size and is not older than the original.
+ */
+
+/*!
+  Waits for the pages to be written and stops the workers.
+ */
+PageWriter::~PageWriter()
+{
+    {
+        std::lock_guard lock(m_mutex);
+        m_stop = true;
+    }
+    m_pageQueued.notify_all();
+    for (auto &worker : m_workers)
+        worker.join();
+}
+
+/*!
+  Returns an empty string to render a page into, reusing the storage
+  of a page that was already written if there is one. Pass the string
+  to write() when the page is complete.
+ */
+QString PageWriter::takeBuffer()
+{
+    std::lock_guard lock(m_mutex);
+    return m_buffers.isEmpty() ? QString() : m_buffers.takeLast();
+}
+
+/*!
+  Writes \a text to \a file encoded as UTF-8, then closes and deletes
+  \a file.
+ */
+void PageWriter::write(QFile *file, QString text)
+{
+    enqueue({ file, std::move(text), {}, isIncremental() });
+}
+
+/*!
+  Writes \a data to \a file, then closes and deletes \a file.
+ */
+void PageWriter::write(QFile *file, QByteArray data)
+{
+    enqueue({ file, {}, std::move(data), isIncremental() });
+}
+
+/*!
+  Copies the file \a sourceFilePath to \a targetFilePath, creating
+  the directory of the target if needed, unless the file was already
+  copied there since the last waitForFinished(). Returns \c false and
+  sets \a errorString if the file cannot be copied.
+ */
+bool PageWriter::copy(const QString &sourceFilePath, const QString &targetFilePath,
+                      QString *errorString)
+{
+    {
+        std::lock_guard lock(m_mutex);
+        if (m_copiedFiles.contains(targetFilePath))
+            return true;
+        m_copiedFiles.insert(targetFilePath);
+    }
+    if (copyFile(sourceFilePath, targetFilePath, errorString))
+        return true;
+    std::lock_guard lock(m_mutex);
+    m_copiedFiles.remove(targetFilePath);
+    return false;
+}
+
+/*!
+  Blocks until the pages handed over for the file \a fileName are
+  written, so that the file can be opened again and overwritten.
+ */
+void PageWriter::waitForFile(const QString &fileName)
+{
+    std::unique_lock lock(m_mutex);
+    m_pageTaken.wait(lock, [&] { return !m_pendingFiles.contains(fileName); });
+}
+
+/*!
+  Blocks until all pages handed over so far are written. Files are
+  copied again by copy() after this, if they changed.
+ */
+void PageWriter::waitForFinished()
+{
+    std::unique_lock lock(m_mutex);
+    m_pageTaken.wait(lock, [this] { return m_pages.isEmpty() && m_busy == 0; });
+    m_copiedFiles.clear();
+}
+
+/*!
+  Starts writing the pages for \a outputDir incrementally, with the
+  manifest \a manifestFileName in that directory. Ends the previous
+  incremental run, if any.
+ */
+void PageWriter::beginIncremental(const QString &outputDir, const QString &manifestFileName)
+{
+    endIncremental();
+
+    m_outputDir = QDir(outputDir).absolutePath();
+    m_manifestPath = m_outputDir + QLatin1Char('/') + manifestFileName;
+
+    QFile manifest(m_manifestPath);
+    if (!manifest.open(QFile::ReadOnly | QFile::Text))
+        return;
+    while (!manifest.atEnd()) {
+        const QByteArray line = manifest.readLine().trimmed();
+        const qsizetype space = line.indexOf(' ');
+        if (space > 0)
+            m_previousHashes.insert(QString::fromUtf8(line.mid(space + 1)), line.left(space));
+    }
+}
+
+/*!
+  Waits for the pages to be written, removes the files of the pages
+  that were written by the previous run but not by this one, and saves
+  the manifest.
+ */
+void PageWriter::endIncremental()
+{
+    if (!isIncremental())
+        return;
+    waitForFinished();
+
+    const QDir outputDir(m_outputDir);
+    for (auto it = m_previousHashes.cbegin(); it != m_previousHashes.cend(); ++it) {
+        if (!m_hashes.contains(it.key()) && outputDir.exists(it.key())) {
+            qCDebug(lcQdoc, "Removing stale output file: %s", qPrintable(it.key()));
+            outputDir.remove(it.key());
+        }
+    }
+
+    QFile manifest(m_manifestPath);
+    if (manifest.open(QFile::WriteOnly | QFile::Text)) {
+        QStringList fileNames = m_hashes.keys();
+        fileNames.sort();
+        for (const QString &fileName : qAsConst(fileNames))
+            manifest.write(m_hashes.value(fileName) + ' ' + fileName.toUtf8() + '\n');
+    } else {
+        qCWarning(lcQdoc, "Cannot write the page manifest '%s'", qPrintable(m_manifestPath));
+    }
+
+    m_outputDir.clear();
+    m_manifestPath.clear();
+    m_previousHashes.clear();
+    m_hashes.clear();
+}
+
+void PageWriter::enqueue(Page page)
+{
+    if (Utilities::threadCount() == 1) {
+        // A serial run writes the page on the calling thread.
+        writePage(page, m_serialBuffer);
+        delete page.file;
+        std::lock_guard lock(m_mutex);
+        recycle(std::move(page.text));
+        return;
+    }
+
+    std::unique_lock lock(m_mutex);
+    if (m_workers.empty()) {
+        const unsigned int threadCount = std::clamp(Utilities::threadCount() / 2, 1u, 4u);
+        for (unsigned int i = 0; i < threadCount; ++i)
+            m_workers.emplace_back([this] { run(); });
+    }
+    m_pageTaken.wait(lock, [this] { return m_pages.size() < kMaxQueuedPages; });
+    m_pendingFiles.insert(page.file->fileName());
+    m_pages.enqueue(std::move(page));
+    lock.unlock();
+    m_pageQueued.notify_one();
+}
+
+void PageWriter::run()
+{
+    QByteArray buffer;
+    std::unique_lock lock(m_mutex);
+    while (true) {
+        m_pageQueued.wait(lock, [this] { return m_stop || !m_pages.isEmpty(); });
+        if (m_pages.isEmpty())
+            return;
+        Page page = m_pages.dequeue();
+        ++m_busy;
+        lock.unlock();
+        m_pageTaken.notify_all();
+
+        writePage(page, buffer);
+        const QString fileName = page.file->fileName();
+        delete page.file;
+
+        lock.lock();
+        m_pendingFiles.remove(fileName);
+        recycle(std::move(page.text));
+        --m_busy;
+        m_pageTaken.notify_all();
+    }
+}
+
+/*!
+  Keeps the storage of \a text for takeBuffer(). Must be called with
+  the mutex locked.
+ */
+void PageWriter::recycle(QString &&text)
+{
+    if (text.capacity() == 0 || m_buffers.size() >= kMaxPooledBuffers)
+        return;
+    text.resize(0);
+    m_buffers.append(std::move(text));
+}
+
+/*!
+  Writes the page \a page, encoding its text into \a buffer. The
+  buffer keeps its capacity from one page to the next.
+ */
+void PageWriter::writePage(const Page &page, QByteArray &buffer)
+{
+    QByteArrayView data = page.data;
+    if (!page.text.isNull()) {
+        QStringEncoder encoder(QStringEncoder::Utf8);
+        buffer.resize(encoder.requiredSpace(page.text.size()));
+        char *end = encoder.appendToBuffer(buffer.data(), page.text);
+        buffer.resize(end - buffer.constData());
+        data = buffer;
+    }
+    if (page.incremental) {
+        const QString fileName = QDir(m_outputDir).relativeFilePath(page.file->fileName());
+        const QByteArray hash = QCryptographicHash::hash(data, QCryptographicHash::Sha1).toHex();
+        bool unchanged = false;
+        {
+            std::lock_guard lock(m_mutex);
+            m_hashes.insert(fileName, hash);
+            unchanged = m_previousHashes.value(fileName) == hash;
+        }
+        if (unchanged && page.file->exists())
+            return;
+        if (!page.file->open(QFile::WriteOnly)) {
+            qCWarning(lcQdoc, "Cannot open output file '%s'", qPrintable(page.file->fileName()));
+            return;
+        }
+    }
+    if (page.file->write(data.data(), data.size()) != data.size())
+        qCWarning(lcQdoc, "Cannot write output file '%s'", qPrintable(page.file->fileName()));
+    page.file->close();
+}
+
+/*!
+  Copies \a sourceFilePath to \a targetFilePath unless the target is
+  up to date. QFile::copy() clones the file on filesystems that support
+  it. Returns \c false and sets \a errorString if the copy fails.
+ */
+bool PageWriter::copyFile(const QString &sourceFilePath, const QString &targetFilePath,
+                          QString *errorString)
+{
+    const QFileInfo source(sourceFilePath);
+    const QFileInfo target(targetFilePath);
+    if (target.exists()) {
+        if (target.size() == source.size() && target.lastModified() >= source.lastModified())
+            return true;
+        QFile::remove(targetFilePath);
+    } else {
+        QDir().mkpath(target.path());
+    }
+    QFile file(sourceFilePath);
+    if (!file.copy(targetFilePath)) {
+        *errorString = file.errorString();
+        return false;
+    }
+    return true;
+}
+
+QT_END_NAMESPACE
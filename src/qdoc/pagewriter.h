@@ -0,0 +1,79 @@
+// Copyright (C) 2023 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
+
+#ifndef PAGEWRITER_H
+#define PAGEWRITER_H
+
+#include "singleton.h"
+
+#include <QtCore/qbytearray.h>
+#include <QtCore/qhash.h>
+#include <QtCore/qlist.h>
+#include <QtCore/qqueue.h>
+#include <QtCore/qset.h>
+#include <QtCore/qstring.h>
+
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+QT_BEGIN_NAMESPACE
+
+class QFile;
+
+class PageWriter : public Singleton<PageWriter>
+{
+public:
+    PageWriter() = default;
+    ~PageWriter();
+
+    [[nodiscard]] QString takeBuffer();
+    void write(QFile *file, QString text);
+    void write(QFile *file, QByteArray data);
+    [[nodiscard]] bool copy(const QString &sourceFilePath, const QString &targetFilePath,
+                            QString *errorString);
+    void waitForFile(const QString &fileName);
+    void waitForFinished();
+
+    void beginIncremental(const QString &outputDir, const QString &manifestFileName);
+    void endIncremental();
+    [[nodiscard]] bool isIncremental() const { return !m_manifestPath.isEmpty(); }
+
+private:
+    struct Page
+    {
+        QFile *file { nullptr };
+        QString text {};
+        QByteArray data {};
+        bool incremental { false };
+    };
+
+    void enqueue(Page page);
+    void run();
+    void writePage(const Page &page, QByteArray &buffer);
+    void recycle(QString &&text);
+    static bool copyFile(const QString &sourceFilePath, const QString &targetFilePath,
+                         QString *errorString);
+
+    QQueue<Page> m_pages {};
+    QSet<QString> m_pendingFiles {};
+    QSet<QString> m_copiedFiles {};
+    QList<QString> m_buffers {};
+    QByteArray m_serialBuffer {};
+    int m_busy { 0 };
+    bool m_stop { false };
+    std::mutex m_mutex {};
+    std::condition_variable m_pageQueued {};
+    std::condition_variable m_pageTaken {};
+    std::vector<std::thread> m_workers {};
+
+    QString m_outputDir {};
+    QString m_manifestPath {};
+    QHash<QString, QByteArray> m_previousHashes {};
+    QHash<QString, QByteArray> m_hashes {};
+};
+
+QT_END_NAMESPACE
+
+#endif // PAGEWRITER_H
@@ -6,6 +6,7 @@
 #include "qdocdatabase.h"
 #include "tokenizer.h"
 
+#include <algorithm>
 #include <cerrno>
 
 QT_BEGIN_NAMESPACE
@@ -39,18 +40,34 @@ void PureDocParser::parseSourceFile(const Location &location, const QString &fil
         return;
     }
 
-    Location fileLocation(filePath);
-    Tokenizer fileTokenizer(fileLocation, in);
-    m_tokenizer = &fileTokenizer;
-    m_token = m_tokenizer->getToken();
-
     /*
       The set of open namespaces is cleared before parsing
       each source file. The word "source" here means cpp file.
      */
     m_qdb->clearOpenNamespaces();
 
+    // Files that hold nothing but comments are scanned in place, and only
+    // their qdoc comments are decoded. Others go through the tokenizer.
+    const qint64 size = in.size();
+    const uchar *mapped = size > 0 ? in.map(0, size) : nullptr;
+    if (mapped
+        && processQdocComments(filePath,
+                               QByteArrayView(reinterpret_cast<const char *>(mapped), size))) {
+        in.unmap(const_cast<uchar *>(mapped));
+        in.close();
+        m_currentFile.clear();
+        return;
+    }
+    if (mapped)
+        in.unmap(const_cast<uchar *>(mapped));
+
+    Location fileLocation(filePath);
+    Tokenizer fileTokenizer(fileLocation, in);
+    m_tokenizer = &fileTokenizer;
+    m_token = m_tokenizer->getToken();
+
     processQdocComments();
+    m_tokenizer = nullptr;
     in.close();
     m_currentFile.clear();
 }
@@ -69,28 +86,7 @@ bool PureDocParser::processQdocComments()
             QString comment = m_tokenizer->lexeme(); // returns an entire qdoc comment.
             Location start_loc(m_tokenizer->location());
             m_token = m_tokenizer->getToken();
-
-            Doc::trimCStyleComment(start_loc, comment);
-            Location end_loc(m_tokenizer->location());
-
-            // Doc constructor parses the comment.
-            Doc doc(start_loc, end_loc, comment, commands, topicCommands());
-            const TopicList &topics = doc.topicsUsed();
-            if (topics.isEmpty()) {
-                doc.location().warning(QStringLiteral("This qdoc comment contains no topic command "
-                                                      "(e.g., '\\%1', '\\%2').")
-                                               .arg(COMMAND_MODULE, COMMAND_PAGE));
-                continue;
-            }
-            if (hasTooManyTopics(doc))
-                continue;
-
-            DocList docs;
-            NodeList nodes;
-            QString topic = topics[0].m_topic;
-
-            processTopicArgs(doc, topic, nodes, docs);
-            processMetaCommands(nodes, docs);
+            processQdocComment(comment, start_loc, m_tokenizer->location(), commands);
         } else {
             m_token = m_tokenizer->getToken();
         }
@@ -98,4 +94,115 @@ bool PureDocParser::processQdocComments()
     return true;
 }
 
+static bool isSpace(char ch)
+{
+    return ch == ' ' || (ch >= '\t' && ch <= '\r');
+}
+
+/*!
+  Moves \a location from offset \a from to offset \a to of \a data,
+  the way the tokenizer advances its location over the characters.
+ */
+static void advance(Location &location, QByteArrayView data, qsizetype from, qsizetype to)
+{
+    const QByteArrayView skipped = data.sliced(from, to - from);
+    const qsizetype lastNewline = skipped.lastIndexOf('\n');
+    if (lastNewline >= 0) {
+        const auto lines = std::count(skipped.begin(), skipped.end(), '\n');
+        location.setLineNo(location.lineNo() + int(lines));
+        location.setColumnNo(1);
+        from += lastNewline + 1;
+    }
+    for (qsizetype i = from; i < to; ++i)
+        location.advance(QLatin1Char(data[i]));
+}
+
+/*!
+  Processes the qdoc comments of \a data, the contents of the file
+  \a filePath, without running the tokenizer over it. Only the bytes
+  of the qdoc comments are decoded.
+
+  This is only done when \a data holds nothing but white space and
+  comments, as .qdoc files usually do; the tokenizer treats anything
+  else, such as preprocessor directives and string literals, in ways
+  the scan does not. Returns \c false without processing any comment
+  if that is not the case.
+ */
+bool PureDocParser::processQdocComments(const QString &filePath, QByteArrayView data)
+{
+    QList<std::pair<qsizetype, qsizetype>> comments;
+    for (qsizetype pos = 0; pos < data.size();) {
+        const char ch = data[pos];
+        if (isSpace(ch)) {
+            ++pos;
+        } else if (ch == '/' && data.sliced(pos).startsWith("//")) {
+            pos = data.indexOf('\n', pos);
+            if (pos < 0)
+                break;
+        } else if (ch == '/' && data.sliced(pos).startsWith("/*")) {
+            // An unterminated comment is left to the tokenizer to report.
+            const qsizetype end = data.indexOf("*/", pos + 2);
+            if (end < 0)
+                return false;
+            if (data.sliced(pos).startsWith("/*!"))
+                comments.append({ pos, end + 2 });
+            pos = end + 2;
+        } else {
+            return false;
+        }
+    }
+
+    const QSet<QString> &commands = topicCommands() + metaCommands();
+
+    // The tokenizer's location is one column ahead on the first line.
+    Location location(filePath);
+    location.advance(QChar());
+    qsizetype pos = 0;
+    for (const auto &[begin, end] : std::as_const(comments)) {
+        advance(location, data, pos, begin);
+        const Location start_loc(location);
+
+        // The comment ends where the next token starts.
+        qsizetype next = end;
+        while (next < data.size() && isSpace(data[next]))
+            ++next;
+        advance(location, data, begin, next);
+        pos = next;
+
+        processQdocComment(Tokenizer::decode(data.sliced(begin, end - begin)), start_loc,
+                           location, commands);
+    }
+    return true;
+}
+
+/*!
+  Parses the qdoc \a comment that spans from \a start to \a end, with
+  the topic and meta \a commands, and adds the nodes it documents to
+  the database.
+ */
+void PureDocParser::processQdocComment(QString comment, Location start, const Location &end,
+                                       const QSet<QString> &commands)
+{
+    Doc::trimCStyleComment(start, comment);
+
+    // Doc constructor parses the comment.
+    Doc doc(start, end, comment, commands, topicCommands());
+    const TopicList &topics = doc.topicsUsed();
+    if (topics.isEmpty()) {
+        doc.location().warning(QStringLiteral("This qdoc comment contains no topic command "
+                                              "(e.g., '\\%1', '\\%2').")
+                                       .arg(COMMAND_MODULE, COMMAND_PAGE));
+        return;
+    }
+    if (hasTooManyTopics(doc))
+        return;
+
+    DocList docs;
+    NodeList nodes;
+    QString topic = topics[0].m_topic;
+
+    processTopicArgs(doc, topic, nodes, docs);
+    processMetaCommands(nodes, docs);
+}
+
 QT_END_NAMESPACE
@@ -21,6 +21,9 @@ public:
 
 private:
     bool processQdocComments();
+    bool processQdocComments(const QString &filePath, QByteArrayView data);
+    void processQdocComment(QString comment, Location start, const Location &end,
+                            const QSet<QString> &commands);
     Tokenizer *m_tokenizer { nullptr };
     int m_token { 0 };
 };
@@ -35,7 +35,20 @@ QDocCommandLineParser::QDocCommandLineParser()
       frameworkOption("F", "Add macOS framework to the include path for header files.",
                       "framework"),
       timestampsOption(QStringList() << QStringLiteral("timestamps")),
-      useDocBookExtensions(QStringList() << QStringLiteral("docbook-extensions"))
+      useDocBookExtensions(QStringList() << QStringLiteral("docbook-extensions")),
+      incrementalOption(QStringList() << QStringLiteral("incremental")),
+      timingsOption("timings",
+                    "Write the time and memory used by each phase of qdoc to <file> as JSON.",
+                    "file"),
+      watchOption(QStringList() << QStringLiteral("watch")),
+      shardOption("shard",
+                  "In the generate phase, generate only the pages of shard <index> of "
+                  "<count>, so that <count> qdoc processes can share the work.",
+                  "index/count"),
+      mergeShardsOption("merge-shards",
+                        "In the generate phase, generate no pages, but write the manifest, "
+                        "help project and tag files for the pages of <count> shards.",
+                        "count")
 {
     setApplicationDescription(QCoreApplication::translate("qdoc", "Qt documentation generator"));
     addHelpOption();
@@ -140,6 +153,21 @@ QDocCommandLineParser::QDocCommandLineParser()
     useDocBookExtensions.setDescription(QCoreApplication::translate(
             "qdoc", "Use the DocBook Library extensions for metadata."));
     addOption(useDocBookExtensions);
+
+    incrementalOption.setDescription(QCoreApplication::translate(
+            "qdoc", "Only write the output files whose contents changed since the last run."));
+    addOption(incrementalOption);
+
+    addOption(timingsOption);
+
+    watchOption.setDescription(QCoreApplication::translate(
+            "qdoc",
+            "Keep running after generating the docs, and generate them again "
+            "whenever one of the files they were generated from changes."));
+    addOption(watchOption);
+
+    addOption(shardOption);
+    addOption(mergeShardsOption);
 }
 
 /*!
@@ -183,4 +211,8 @@ void QDocCommandLineParser::process(const QStringList &arguments)
 
     if (isSet(singleExecOption) && isSet(indexDirOption))
         qDebug("WARNING: -indexdir option ignored: Index files are not used in single-exec mode.");
+    if (isSet(watchOption)
+        && (isSet(singleExecOption) || isSet(prepareOption) || isSet(generateOption))) {
+        qFatal("The -watch option cannot be combined with -single-exec, -prepare or -generate");
+    }
 }
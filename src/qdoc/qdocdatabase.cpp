@@ -4,19 +4,73 @@
 #include "qdocdatabase.h"
 
 #include "atom.h"
+#include "classnode.h"
 #include "collectionnode.h"
 #include "functionnode.h"
 #include "generator.h"
 #include "qdocindexfiles.h"
+#include "timings.h"
 #include "tree.h"
+#include "utilities.h"
 
 #include <QtCore/qregularexpression.h>
+
+#include <atomic>
 #include <stack>
+#include <thread>
+#include <vector>
 
 QT_BEGIN_NAMESPACE
 
 static NodeMultiMap emptyNodeMultiMap_;
 
+// Levels of the tree with fewer aggregates are not worth the threads.
+static const qsizetype kMinParallelAggregates = 64;
+
+/*!
+  \internal
+  Calls \a func for \a root and for every aggregate below it, on worker
+  threads. The aggregates are processed one level of the tree at a
+  time, each level after its parent level, which is the order in which
+  a recursive traversal processes the children of any aggregate.
+
+  \a func must only change the children of its aggregate, and may read
+  the children and grandchildren. Two calls in the same level do not
+  touch the same nodes then.
+ */
+static void forEachAggregateInParallel(Aggregate *root, void (Aggregate::*func)())
+{
+    QList<Aggregate *> level { root };
+    while (!level.isEmpty()) {
+        std::atomic<qsizetype> next = 0;
+        const auto process = [&] {
+            for (qsizetype i; (i = next++) < level.size();)
+                (level.at(i)->*func)();
+        };
+        const qsizetype threadCount = level.size() < kMinParallelAggregates
+                ? 1
+                : qMin(qsizetype(Utilities::threadCount()), level.size());
+        std::vector<std::thread> workers;
+        for (qsizetype t = 1; t < threadCount; ++t)
+            workers.emplace_back(process);
+        process();
+        for (auto &worker : workers)
+            worker.join();
+
+        QList<Aggregate *> nextLevel;
+        for (const Aggregate *aggregate : qAsConst(level)) {
+            for (Node *child : aggregate->childNodes()) {
+                if (child->isAggregate())
+                    nextLevel.append(static_cast<Aggregate *>(child));
+            }
+        }
+        level = std::move(nextLevel);
+    }
+}
+
+// A reference no target can have, for telling whether a search set one.
+const QString QDocForest::s_untouchedRef = QString(QChar(0xFFFF));
+
 /*!
   \class QDocForest
 
@@ -255,6 +309,93 @@ NamespaceNode *QDocForest::newIndexTree(const QString &module)
     return m_primaryTree->root();
 }
 
+/*!
+  Drops the references that \a aggregate and its descendants hold
+  to the nodes of \a tree. References that are resolved by name are
+  resolved again against the tree that replaces \a tree.
+ */
+static void dropReferencesTo(Aggregate *aggregate, const Tree *tree)
+{
+    const auto inTree = [tree](const Node *node) { return node && node->tree() == tree; };
+    aggregate->relatedByProxy().removeIf(inTree);
+    if (aggregate->isNamespace()) {
+        static_cast<NamespaceNode *>(aggregate)->removeIncludedChildren(tree);
+    } else if (aggregate->isClassNode()) {
+        auto *cn = static_cast<ClassNode *>(aggregate);
+        for (auto &base : cn->baseClasses()) {
+            if (inTree(base.m_node))
+                base.m_node = nullptr;
+        }
+        for (auto &base : cn->ignoredBaseClasses()) {
+            if (inTree(base.m_node))
+                base.m_node = nullptr;
+        }
+        cn->derivedClasses().removeIf(
+                [&inTree](const RelatedClass &derived) { return inTree(derived.m_node); });
+        if (inTree(cn->qmlElement()))
+            cn->setQmlElement(nullptr);
+    } else if (aggregate->isQmlType() || aggregate->isJsType()) {
+        auto *qcn = static_cast<QmlTypeNode *>(aggregate);
+        if (inTree(qcn->classNode()))
+            qcn->setClassNode(nullptr);
+        if (inTree(qcn->qmlBaseNode()))
+            qcn->clearQmlBaseNode();
+    }
+    for (Node *child : aggregate->childNodes()) {
+        if (child->isAggregate())
+            dropReferencesTo(static_cast<Aggregate *>(child), tree);
+    }
+}
+
+/*!
+  Removes the tree for \a module from the forest and deletes it, so
+  that the module can be processed again with a new primary tree.
+
+  The references that the nodes of the other trees hold to its nodes
+  are dropped first, and the other trees are analyzed again the next
+  time the database needs it.
+ */
+void QDocForest::retireTree(const QString &module)
+{
+    Tree *tree = m_forest.take(module.toLower());
+    if (!tree)
+        return;
+    const qsizetype i = m_searchOrder.indexOf(tree);
+    if (i >= 0) {
+        m_searchOrder.removeAt(i);
+        m_moduleNames.removeAt(i);
+    }
+    m_indexSearchOrder.removeAll(tree);
+    if (m_primaryTree == tree)
+        m_primaryTree = nullptr;
+    m_cachedSearchOrder.clear();
+    m_targetCache.clear();
+    m_functionCache.clear();
+
+    QList<Tree *> others = m_searchOrder;
+    for (Tree *other : qAsConst(m_forest)) {
+        if (!others.contains(other))
+            others.append(other);
+    }
+    for (Tree *other : qAsConst(others)) {
+        dropReferencesTo(other->root(), tree);
+        for (auto type : { Node::Group, Node::Module, Node::QmlModule, Node::JsModule }) {
+            if (CNMap *collections = other->getCollectionMap(type)) {
+                for (CollectionNode *collection : qAsConst(*collections))
+                    collection->removeMembers(tree);
+            }
+        }
+        other->setTreeHasBeenAnalyzed(false);
+    }
+    for (auto it = QmlTypeNode::s_inheritedBy.begin(); it != QmlTypeNode::s_inheritedBy.end();) {
+        if (it.key()->tree() == tree || it.value()->tree() == tree)
+            it = QmlTypeNode::s_inheritedBy.erase(it);
+        else
+            ++it;
+    }
+    delete tree;
+}
+
 /*!
   Create a new Tree for use as the primary tree. This tree
   will represent the primary module. \a module is camel case.
@@ -293,7 +434,7 @@ const Node *QDocForest::findNodeForTarget(QStringList &targetPath, const Node *r
     TargetRec::TargetType type = TargetRec::Unknown;
     const Node *tocNode = nullptr;
     for (const auto *tree : searchOrder()) {
-        const Node *n = tree->findNodeForTarget(entityPath, target, relative, flags, genus, ref, &type);
+        const Node *n = lookupTarget(tree, entityPath, target, relative, flags, genus, ref, &type);
         if (n) {
             // Targets referring to non-section titles are returned immediately
             if (type != TargetRec::Contents)
@@ -321,7 +462,7 @@ const FunctionNode *QDocForest::findFunctionNode(const QStringList &path,
                                                  Node::Genus genus)
 {
     for (const auto *tree : searchOrder()) {
-        const FunctionNode *fn = tree->findFunctionNode(path, parameters, relative, genus);
+        const FunctionNode *fn = lookupFunction(tree, path, parameters, relative, genus);
         if (fn)
             return fn;
         relative = nullptr;
@@ -329,6 +470,86 @@ const FunctionNode *QDocForest::findFunctionNode(const QStringList &path,
     return nullptr;
 }
 
+/*!
+  Returns whether a search in \a tree that starts from \a relative
+  can be answered from the lookup caches.
+
+  Only the searches in index trees that start from the tree's root,
+  which is when \a relative is \c nullptr, are cached. This is how
+  findNodeForTarget() and findFunctionNode() search all trees after
+  the first one. The index trees do not change once they are loaded,
+  so the results of these searches only depend on their arguments,
+  and not finding anything is cached as well.
+
+  The caches are cleared whenever the search order changes, and are
+  not used while the index files are being loaded.
+ */
+bool QDocForest::useLookupCache(const Tree *tree, const Node *relative)
+{
+    if (relative || tree == m_primaryTree || m_searchOrder.isEmpty())
+        return false;
+    if (m_searchOrder != m_cachedSearchOrder) {
+        m_cachedSearchOrder = m_searchOrder;
+        m_targetCache.clear();
+        m_functionCache.clear();
+    }
+    return true;
+}
+
+/*!
+  Calls Tree::findNodeForTarget() for \a tree, or returns its cached
+  result if useLookupCache() allows it. \a type is both the target
+  type left by the search in the previous tree and the target type
+  found.
+ */
+const Node *QDocForest::lookupTarget(const Tree *tree, const QStringList &entityPath,
+                                     const QString &target, const Node *relative, int flags,
+                                     Node::Genus genus, QString &ref,
+                                     TargetRec::TargetType *type)
+{
+    if (!useLookupCache(tree, relative))
+        return tree->findNodeForTarget(entityPath, target, relative, flags, genus, ref, type);
+
+    // Of the type left by the previous tree, only whether it is a section
+    // title affects the search.
+    const QString key = entityPath.join(QLatin1String("::")) + QChar::Null + target + QChar::Null
+            + QString::number(flags) + QChar::Null + QString::number(int(genus))
+            + (*type == TargetRec::Contents ? u'c' : u'u');
+    auto it = m_targetCache.constFind({ tree, key });
+    if (it == m_targetCache.cend()) {
+        TargetLookup lookup;
+        lookup.type = *type;
+        lookup.ref = s_untouchedRef;
+        lookup.node = tree->findNodeForTarget(entityPath, target, nullptr, flags, genus,
+                                              lookup.ref, &lookup.type);
+        it = m_targetCache.insert({ tree, key }, lookup);
+    }
+    if (it->ref != s_untouchedRef)
+        ref = it->ref;
+    *type = it->type;
+    return it->node;
+}
+
+/*!
+  Calls Tree::findFunctionNode() for \a tree, or returns its cached
+  result if useLookupCache() allows it.
+ */
+const FunctionNode *QDocForest::lookupFunction(const Tree *tree, const QStringList &path,
+                                               const Parameters &parameters,
+                                               const Node *relative, Node::Genus genus)
+{
+    if (!useLookupCache(tree, relative))
+        return tree->findFunctionNode(path, parameters, relative, genus);
+
+    const QString key = path.join(QLatin1String("::")) + QChar::Null
+            + parameters.rawSignature(true, true) + QChar::Null + QString::number(int(genus))
+            + (parameters.isPrivateSignal() ? u'p' : u'-') + (parameters.isValid() ? u'v' : u'-');
+    auto it = m_functionCache.constFind({ tree, key });
+    if (it == m_functionCache.cend())
+        it = m_functionCache.insert({ tree, key }, tree->findFunctionNode(path, parameters, nullptr, genus));
+    return *it;
+}
+
 /*! \class QDocDatabase
   This class provides exclusive access to the qdoc database,
   which consists of a forrest of trees and a lot of maps and
@@ -777,6 +998,20 @@ void QDocDatabase::processForest()
     resolveNamespaces();
 }
 
+/*!
+  Records the number and memory use of the nodes of each tree in
+  the search order, if timings are enabled.
+
+  \sa Timings::recordNodes()
+ */
+void QDocDatabase::recordNodeStatistics()
+{
+    if (!Timings::instance().isEnabled())
+        return;
+    for (Tree *tree : m_forest.searchOrder())
+        Timings::instance().recordNodes(tree->camelCaseModuleName(), tree->root());
+}
+
 /*!
   This function calls \a func for each tree in the forest,
   but only if Tree::treeHasBeenAnalyzed() returns false for
@@ -1005,6 +1240,34 @@ const NodeMultiMap &QDocDatabase::getSinceMap(const QString &key)
     return emptyNodeMultiMap_;
 }
 
+/*!
+  Removes the tree for \a module from the forest and deletes it, as
+  QDocForest::retireTree() does, and clears the indexes and caches
+  that the database built from the nodes of the forest. They are
+  built again from the remaining trees and the new primary tree when
+  they are next needed.
+ */
+void QDocDatabase::retireTree(const QString &module)
+{
+    s_obsoleteClasses.clear();
+    s_classesWithObsoleteMembers.clear();
+    s_obsoleteQmlTypes.clear();
+    s_qmlTypesWithObsoleteMembers.clear();
+    s_cppClasses.clear();
+    s_qmlBasicTypes.clear();
+    s_qmlTypes.clear();
+    s_examples.clear();
+    s_newClassMaps.clear();
+    s_newQmlTypeMaps.clear();
+    s_newSinceMaps.clear();
+    m_namespaceIndex.clear();
+    m_attributions.clear();
+    m_functionIndex.clear();
+    m_legaleseTexts.clear();
+    m_linkCache.clear();
+    m_forest.retireTree(module);
+}
+
 /*!
   Performs several housekeeping tasks prior to generating the
   documentation. These tasks create required data structures
@@ -1017,11 +1280,12 @@ void QDocDatabase::resolveStuff()
         // order matters
         primaryTree()->resolveBaseClasses(primaryTreeRoot());
         primaryTree()->resolvePropertyOverriddenFromPtrs(primaryTreeRoot());
-        primaryTreeRoot()->normalizeOverloads();
+        forEachAggregateInParallel(primaryTreeRoot(), &Aggregate::normalizeOwnOverloads);
         primaryTree()->markDontDocumentNodes();
         primaryTree()->removePrivateAndInternalBases(primaryTreeRoot());
         primaryTree()->resolveProperties();
-        primaryTreeRoot()->markUndocumentedChildrenInternal();
+        forEachAggregateInParallel(primaryTreeRoot(),
+                                   &Aggregate::markOwnUndocumentedChildrenInternal);
         primaryTreeRoot()->resolveQmlInheritance();
         primaryTree()->resolveTargets(primaryTreeRoot());
         primaryTree()->resolveCppToQmlLinks();
@@ -1308,6 +1572,7 @@ void QDocDatabase::readIndexes(const QStringList &indexFiles)
 void QDocDatabase::generateIndex(const QString &fileName, const QString &url, const QString &title,
                                  Generator *g)
 {
+    Timings::Phase phase(QStringLiteral("write index"));
     QString t = fileName.mid(fileName.lastIndexOf(QChar('/')) + 1);
     primaryTree()->setIndexFileName(t);
     QDocIndexFiles::qdocIndexFiles()->generateIndex(fileName, url, title, g);
@@ -1575,9 +1840,53 @@ void QDocDatabase::mergeCollections(CollectionNode *c)
   in the path after the node is found. The node is returned as
   well as the \a ref. If the returned node pointer is null,
   \a ref is also not valid.
+
+  If the link cache is enabled, the result is remembered for the
+  link target, domain and genus of \a atom and the \a relative node.
+
+  \sa setLinkCacheEnabled()
  */
 const Node *QDocDatabase::findNodeForAtom(const Atom *a, const Node *relative, QString &ref,
                                           Node::Genus genus)
+{
+    if (!m_linkCacheEnabled || !ref.isEmpty())
+        return resolveAtom(a, relative, ref, genus);
+
+    Atom *atom = const_cast<Atom *>(a);
+    const Tree *domain = atom->isLinkAtom() ? atom->domain() : nullptr;
+    if (atom->isLinkAtom())
+        genus = atom->genus();
+    const QString key = atom->string() + QChar::Null + QString::number(quintptr(domain), 16)
+            + QChar::Null + QString::number(quintptr(relative), 16) + QChar::Null
+            + QString::number(int(genus));
+    auto it = m_linkCache.constFind(key);
+    if (it == m_linkCache.cend()) {
+        LinkTarget target;
+        target.node = resolveAtom(a, relative, target.ref, genus);
+        it = m_linkCache.insert(key, target);
+    }
+    ref = it->ref;
+    return it->node;
+}
+
+/*!
+  Enables or disables the cache of the nodes that findNodeForAtom()
+  finds. The cache is cleared when it is disabled.
+
+  The generators for the different output formats resolve the same
+  links in the same documentation, so with several output formats,
+  the cache is enabled while the generators run, after the tree has
+  stopped changing.
+ */
+void QDocDatabase::setLinkCacheEnabled(bool enabled)
+{
+    m_linkCacheEnabled = enabled;
+    if (!enabled)
+        m_linkCache.clear();
+}
+
+const Node *QDocDatabase::resolveAtom(const Atom *a, const Node *relative, QString &ref,
+                                      Node::Genus genus)
 {
     const Node *node = nullptr;
 
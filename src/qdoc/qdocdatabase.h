@@ -11,9 +11,12 @@
 #include "tree.h"
 
 #include <QtCore/qdebug.h>
+#include <QtCore/qhash.h>
 #include <QtCore/qmap.h>
 #include <QtCore/qstring.h>
 
+#include <utility>
+
 QT_BEGIN_NAMESPACE
 
 typedef QMultiMap<Text, const Node *> TextToNodeMap;
@@ -161,8 +164,25 @@ private:
     void newPrimaryTree(const QString &module);
     void setPrimaryTree(const QString &t);
     NamespaceNode *newIndexTree(const QString &module);
+    void retireTree(const QString &module);
 
 private:
+    struct TargetLookup
+    {
+        const Node *node { nullptr };
+        TargetRec::TargetType type { TargetRec::Unknown };
+        QString ref {};
+    };
+    using LookupKey = std::pair<const Tree *, QString>;
+
+    bool useLookupCache(const Tree *tree, const Node *relative);
+    const Node *lookupTarget(const Tree *tree, const QStringList &entityPath,
+                             const QString &target, const Node *relative, int flags,
+                             Node::Genus genus, QString &ref, TargetRec::TargetType *type);
+    const FunctionNode *lookupFunction(const Tree *tree, const QStringList &path,
+                                       const Parameters &parameters, const Node *relative,
+                                       Node::Genus genus);
+
     QDocDatabase *m_qdb;
     Tree *m_primaryTree;
     int m_currentIndex;
@@ -170,6 +190,11 @@ private:
     QList<Tree *> m_searchOrder;
     QList<Tree *> m_indexSearchOrder;
     QList<QString> m_moduleNames;
+
+    static const QString s_untouchedRef;
+    QList<Tree *> m_cachedSearchOrder;
+    QHash<LookupKey, TargetLookup> m_targetCache;
+    QHash<LookupKey, const FunctionNode *> m_functionCache;
 };
 
 class QDocDatabase
@@ -281,6 +306,7 @@ public:
     ******************************************************************************/
     const Node *findNodeForAtom(const Atom *atom, const Node *relative, QString &ref,
                                 Node::Genus genus = Node::DontCare);
+    void setLinkCacheEnabled(bool enabled);
     /*******************************************************************/
 
     /*******************************************************************
@@ -344,6 +370,7 @@ public:
     void clearOpenNamespaces() { m_openNamespaces.clear(); }
     void insertOpenNamespace(const QString &path) { m_openNamespaces.insert(path); }
     void processForest();
+    void recordNodeStatistics();
 
     // Try to make this function private.
     QDocForest &forest() { return m_forest; }
@@ -351,6 +378,7 @@ public:
     void newPrimaryTree(const QString &module) { m_forest.newPrimaryTree(module); }
     void setPrimaryTree(const QString &t) { m_forest.setPrimaryTree(t); }
     NamespaceNode *newIndexTree(const QString &module) { return m_forest.newIndexTree(module); }
+    void retireTree(const QString &module);
     const QList<Tree *> &searchOrder() { return m_forest.searchOrder(); }
     void setLocalSearch() { m_forest.m_searchOrder = QList<Tree *>(1, primaryTree()); }
     void setSearchOrder(const QList<Tree *> &searchOrder) { m_forest.m_searchOrder = searchOrder; }
@@ -381,6 +409,15 @@ private:
     QDocDatabase(QDocDatabase const &) : m_forest(this) { }
     QDocDatabase &operator=(QDocDatabase const &);
 
+    struct LinkTarget
+    {
+        const Node *node { nullptr };
+        QString ref {};
+    };
+
+    const Node *resolveAtom(const Atom *atom, const Node *relative, QString &ref,
+                            Node::Genus genus);
+
 public:
     Tree *primaryTree() { return m_forest.primaryTree(); }
 
@@ -407,6 +444,8 @@ private:
     NodeMapMap m_functionIndex {};
     TextToNodeMap m_legaleseTexts {};
     QSet<QString> m_openNamespaces {};
+    bool m_linkCacheEnabled { false };
+    QHash<QString, LinkTarget> m_linkCache {};
 };
 
 QT_END_NAMESPACE
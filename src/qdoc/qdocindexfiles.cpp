@@ -14,6 +14,7 @@
 #include "functionnode.h"
 #include "generator.h"
 #include "headernode.h"
+#include "indexreader.h"
 #include "location.h"
 #include "utilities.h"
 #include "propertynode.h"
@@ -25,6 +26,10 @@
 #include <QtCore/qxmlstream.h>
 
 #include <algorithm>
+#include <atomic>
+#include <thread>
+#include <utility>
+#include <vector>
 
 QT_BEGIN_NAMESPACE
 
@@ -38,7 +43,7 @@ enum QDocAttr {
 };
 
 static Node *root_ = nullptr;
-static IndexSectionWriter *post_ = nullptr;
+static thread_local IndexSectionWriter *post_ = nullptr;
 
 /*!
   \class QDocIndexFiles
@@ -93,8 +98,36 @@ void QDocIndexFiles::destroyQDocIndexFiles()
  */
 void QDocIndexFiles::readIndexes(const QStringList &indexFiles)
 {
-    for (const QString &file : indexFiles) {
+    // Decoding the XML of the index files is independent for each file,
+    // so the files without an up-to-date binary cache are decoded on
+    // worker threads. The trees are then built from them in order.
+    std::vector<QByteArray> decoded(indexFiles.size());
+    std::atomic<qsizetype> next = 0;
+    const auto decode = [&] {
+        for (qsizetype i; (i = next++) < indexFiles.size();) {
+            if (!BinaryIndexReader(indexFiles.at(i)).isValid())
+                decoded[i] = BinaryIndexReader::encode(indexFiles.at(i));
+        }
+    };
+    std::vector<std::thread> workers;
+    const qsizetype threadCount = qMin(qsizetype(Utilities::threadCount()),
+                                       indexFiles.size());
+    for (qsizetype t = 1; t < threadCount; ++t)
+        workers.emplace_back(decode);
+    decode();
+    for (auto &worker : workers)
+        worker.join();
+
+    for (qsizetype i = 0; i < indexFiles.size(); ++i) {
+        const QString &file = indexFiles.at(i);
         qCDebug(lcQdoc) << "Loading index file: " << file;
+        if (!decoded[i].isEmpty()) {
+            BinaryIndexReader reader(file, std::exchange(decoded[i], {}));
+            if (reader.isValid()) {
+                readIndexFile(file, reader);
+                continue;
+            }
+        }
         readIndexFile(file);
     }
 }
@@ -104,15 +137,29 @@ void QDocIndexFiles::readIndexes(const QStringList &indexFiles)
  */
 void QDocIndexFiles::readIndexFile(const QString &path)
 {
+    // Prefer the binary cache written by generateIndex() when it is up to date.
+    BinaryIndexReader binaryReader(path);
+    if (binaryReader.isValid()) {
+        qCDebug(lcQdoc) << "Reading binary index for" << path;
+        readIndexFile(path, binaryReader);
+        return;
+    }
+
     QFile file(path);
     if (!file.open(QFile::ReadOnly)) {
         qWarning() << "Could not read index file" << path;
         return;
     }
 
-    QXmlStreamReader reader(&file);
-    reader.setNamespaceProcessing(false);
+    XmlIndexReader reader(&file);
+    readIndexFile(path, reader);
+}
 
+/*!
+  Reads the index file \a path with \a reader.
+ */
+void QDocIndexFiles::readIndexFile(const QString &path, IndexReader &reader)
+{
     if (!reader.readNextStartElement())
         return;
 
@@ -137,6 +184,7 @@ void QDocIndexFiles::readIndexFile(const QString &path)
     QString indexTitle = attrs.value(QLatin1String("indexTitle")).toString();
     m_basesList.clear();
     m_relatedNodes.clear();
+    m_relatedNodeIndexes.clear();
 
     NamespaceNode *root = m_qdb->newIndexTree(m_project);
     if (!root) {
@@ -161,7 +209,7 @@ void QDocIndexFiles::readIndexFile(const QString &path)
   Read a <section> element from the index file and create the
   appropriate node(s).
  */
-void QDocIndexFiles::readIndexSection(QXmlStreamReader &reader, Node *current,
+void QDocIndexFiles::readIndexSection(IndexReader &reader, Node *current,
                                       const QString &indexUrl)
 {
     QXmlStreamAttributes attributes = reader.attributes();
@@ -662,7 +710,7 @@ void QDocIndexFiles::readIndexSection(QXmlStreamReader &reader, Node *current,
 
 done:
     while (!reader.isEndElement()) {
-        if (reader.readNext() == QXmlStreamReader::Invalid) {
+        if (!reader.readNext()) {
             break;
         }
     }
@@ -778,11 +826,12 @@ static QString getThreadSafenessString(Node::ThreadSafeness t)
 */
 int QDocIndexFiles::indexForNode(Node *node)
 {
-    qsizetype i = m_relatedNodes.indexOf(node);
-    if (i == -1) {
-        i = m_relatedNodes.size();
-        m_relatedNodes << node;
-    }
+    const auto it = m_relatedNodeIndexes.constFind(node);
+    if (it != m_relatedNodeIndexes.cend())
+        return *it;
+    const int i = int(m_relatedNodes.size());
+    m_relatedNodes << node;
+    m_relatedNodeIndexes.insert(node, i);
     return i;
 }
 
@@ -995,7 +1044,7 @@ bool QDocIndexFiles::generateIndexSection(QXmlStreamWriter &writer, Node *node,
     if (node->hasDoc())
         writer.writeAttribute("documented", "true");
 
-    QStringList groups = m_qdb->groupNamesForNode(node);
+    QStringList groups = groupNamesForNode(node);
     if (!groups.isEmpty())
         writer.writeAttribute("groups", groups.join(QLatin1Char(',')));
 
@@ -1430,6 +1479,19 @@ void QDocIndexFiles::generateFunctionSections(QXmlStreamWriter &writer, Aggregat
     }
 }
 
+/*!
+  Returns \c true if generateIndexSections() writes nothing for the
+  subtree of \a node. Note that groups, modules, and QML modules are
+  written after all the other nodes.
+ */
+static bool skipsIndexSubtree(const Node *node)
+{
+    if (node->isCollectionNode() || node->isGroup() || node->isModule() || node->isQmlModule()
+        || node->isJsModule())
+        return true;
+    return node->isInternal() && !Config::instance().showInternal();
+}
+
 /*!
   Generate index sections for the child nodes of the given \a node
   using the \a writer specified.
@@ -1437,15 +1499,7 @@ void QDocIndexFiles::generateFunctionSections(QXmlStreamWriter &writer, Aggregat
 void QDocIndexFiles::generateIndexSections(QXmlStreamWriter &writer, Node *node,
                                            IndexSectionWriter *post)
 {
-    /*
-      Note that groups, modules, and QML modules are written
-      after all the other nodes.
-     */
-    if (node->isCollectionNode() || node->isGroup() || node->isModule() || node->isQmlModule()
-        || node->isJsModule())
-        return;
-
-    if (node->isInternal() && !Config::instance().showInternal())
+    if (skipsIndexSubtree(node))
         return;
 
     if (generateIndexSection(writer, node, post)) {
@@ -1467,48 +1521,132 @@ void QDocIndexFiles::generateIndexSections(QXmlStreamWriter &writer, Node *node,
               create the group, module, or QML module element and add each member to
               its member list.
             */
-            const CNMap &groups = m_qdb->groups();
-            if (!groups.isEmpty()) {
-                for (auto it = groups.constBegin(); it != groups.constEnd(); ++it) {
-                    if (generateIndexSection(writer, it.value(), post))
-                        writer.writeEndElement();
-                }
-            }
+            generateCollectionSections(writer, post);
+        }
 
-            const CNMap &modules = m_qdb->modules();
-            if (!modules.isEmpty()) {
-                for (auto it = modules.constBegin(); it != modules.constEnd(); ++it) {
-                    if (generateIndexSection(writer, it.value(), post))
-                        writer.writeEndElement();
-                }
-            }
+        writer.writeEndElement();
+    }
+}
 
-            const CNMap &qmlModules = m_qdb->qmlModules();
-            if (!qmlModules.isEmpty()) {
-                for (auto it = qmlModules.constBegin(); it != qmlModules.constEnd(); ++it) {
-                    if (generateIndexSection(writer, it.value(), post))
-                        writer.writeEndElement();
-                }
-            }
+/*!
+  Generate the index sections for the groups, modules, and QML and
+  JavaScript modules using the \a writer specified.
+ */
+void QDocIndexFiles::generateCollectionSections(QXmlStreamWriter &writer,
+                                                IndexSectionWriter *post)
+{
+    for (const CNMap *map : { &m_qdb->groups(), &m_qdb->modules(), &m_qdb->qmlModules(),
+                              &m_qdb->jsModules() }) {
+        for (auto it = map->constBegin(); it != map->constEnd(); ++it) {
+            if (generateIndexSection(writer, it.value(), post))
+                writer.writeEndElement();
+        }
+    }
+}
+
+/*!
+  Returns the names of the groups \a node is a member of. While an
+  index is generated, the names come from a map of all group members
+  that is built once, instead of searching every group for every node.
+ */
+QStringList QDocIndexFiles::groupNamesForNode(Node *node)
+{
+    if (!m_groupNames)
+        return m_qdb->groupNamesForNode(node);
+    return m_groupNames->value(node);
+}
 
-            const CNMap &jsModules = m_qdb->jsModules();
-            if (!jsModules.isEmpty()) {
-                for (auto it = jsModules.constBegin(); it != jsModules.constEnd(); ++it) {
-                    if (generateIndexSection(writer, it.value(), post))
-                        writer.writeEndElement();
-                }
+/*!
+  Returns \c true if generateIndexSection() writes an element for
+  \a node.
+ */
+bool QDocIndexFiles::hasIndexSection(const Node *node) const
+{
+    if (node->isIndexNode())
+        return false;
+    switch (node->nodeType()) {
+    case Node::NoType:
+    case Node::Function:
+    case Node::Collection:
+        return false;
+    case Node::SharedComment:
+        if (!node->isPropertyGroup())
+            return false;
+        break;
+    default:
+        break;
+    }
+    return !node->name().isEmpty() || node == m_qdb->primaryTreeRoot();
+}
+
+/*!
+  Prepares the subtree of \a node for being written on several
+  threads, visiting the nodes in the order generateIndexSections()
+  writes them.
+
+  The indexes of the related non-members are assigned in that order,
+  so that the subtrees can be written in any order. The document
+  locations are computed here, as Generator::fileBase() stores the
+  file name bases in the nodes; the writers then only read them.
+ */
+void QDocIndexFiles::prepareIndexSections(Node *node)
+{
+    if (skipsIndexSubtree(node) || !hasIndexSection(node))
+        return;
+
+    if (node->isRelatedNonmember())
+        indexForNode(node);
+    if (!node->isExternalPage())
+        m_gen->fullDocumentLocation(node);
+    if (node->isAggregate()) {
+        auto *aggregate = static_cast<Aggregate *>(node);
+        const FunctionMap &functionMap = aggregate->functionMap();
+        for (auto it = functionMap.cbegin(); it != functionMap.cend(); ++it) {
+            for (FunctionNode *fn = it.value(); fn; fn = fn->nextOverload()) {
+                if (fn->isInternal() && !Config::instance().showInternal())
+                    continue;
+                if (fn->isRelatedNonmember())
+                    indexForNode(fn);
+                m_gen->fullDocumentLocation(fn);
             }
         }
-
-        writer.writeEndElement();
+        const auto &nonFunctionList = aggregate->nonfunctionList();
+        for (auto *child : nonFunctionList)
+            prepareIndexSections(child);
     }
 }
 
+/*!
+  Writes the index sections of \a nodes, which are children of the
+  root node, and returns them as they appear inside the root element
+  of the index.
+
+  The writer is put two elements deep first, so that the sections are
+  indented as if they were written by the writer of the index file.
+ */
+QByteArray QDocIndexFiles::generateIndexChunk(const NodeList &nodes)
+{
+    QByteArray data;
+    QXmlStreamWriter writer(&data);
+    writer.setAutoFormatting(true);
+    writer.writeStartElement("INDEX");
+    writer.writeStartElement("namespace");
+    const qsizetype start = data.size();
+    for (Node *node : nodes)
+        generateIndexSections(writer, node, nullptr);
+    // Drop the wrapper elements and the '>' that closes the last one.
+    return data.size() > start ? data.mid(start + 1) : QByteArray();
+}
+
 /*!
   Writes a qdoc module index in XML to a file named \a fileName.
   \a url is the \c url attribute of the <INDEX> element.
   \a title is the \c title attribute of the <INDEX> element.
   \a g is a pointer to the current Generator in use, stored for later use.
+
+  The subtrees of the children of the root node are written on worker
+  threads into separate buffers, which are then written to the file in
+  order. The rest of the index is written on the calling thread.
  */
 void QDocIndexFiles::generateIndex(const QString &fileName, const QString &url,
                                    const QString &title, Generator *g)
@@ -1519,9 +1657,24 @@ void QDocIndexFiles::generateIndex(const QString &fileName, const QString &url,
 
     qCDebug(lcQdoc) << "Writing index file:" << fileName;
 
-    m_gen = g;
+    m_gen = g ? g : Generator::currentGenerator();
     m_relatedNodes.clear();
-    QXmlStreamWriter writer(&file);
+    m_relatedNodeIndexes.clear();
+    root_ = m_qdb->primaryTreeRoot();
+
+    m_groupNames.emplace();
+    const CNMap &groups = m_qdb->groups();
+    for (auto it = groups.constBegin(); it != groups.constEnd(); ++it) {
+        for (const Node *member : it.value()->members()) {
+            QStringList &names = (*m_groupNames)[member];
+            if (names.isEmpty() || names.last() != it.key())
+                names << it.key();
+        }
+    }
+    prepareIndexSections(root_);
+
+    QByteArray data;
+    QXmlStreamWriter writer(&data);
     writer.setAutoFormatting(true);
     writer.writeStartDocument();
     writer.writeDTD("<!DOCTYPE QDOCINDEX>");
@@ -1532,16 +1685,56 @@ void QDocIndexFiles::generateIndex(const QString &fileName, const QString &url,
     writer.writeAttribute("version", m_qdb->version());
     writer.writeAttribute("project", Config::instance().getString(CONFIG_PROJECT));
 
-    root_ = m_qdb->primaryTreeRoot();
     if (!root_->tree()->indexTitle().isEmpty())
         writer.writeAttribute("indexTitle", root_->tree()->indexTitle());
 
-    generateIndexSections(writer, root_, nullptr);
-
+    generateIndexSection(writer, root_, nullptr);
+    auto *root = static_cast<Aggregate *>(root_);
+    generateFunctionSections(writer, root);
+
+    // An empty placeholder element marks where the children go. The
+    // writer finishes it when it writes what follows.
+    const qsizetype beforePlaceholder = data.size();
+    writer.writeEmptyElement("children");
+
+    const NodeList &children = root->nonfunctionList();
+    const qsizetype threadCount =
+            qBound(qsizetype(1), qsizetype(Utilities::threadCount()), children.size());
+    const qsizetype chunkCount = qMin(threadCount * 4, children.size());
+    std::vector<QByteArray> chunks(chunkCount);
+    std::atomic<qsizetype> next = 0;
+    const auto generate = [&] {
+        for (qsizetype i; (i = next++) < chunkCount;) {
+            const qsizetype begin = children.size() * i / chunkCount;
+            const qsizetype end = children.size() * (i + 1) / chunkCount;
+            chunks[i] = generateIndexChunk(children.mid(begin, end - begin));
+        }
+    };
+    std::vector<std::thread> workers;
+    for (qsizetype t = 1; t < threadCount; ++t)
+        workers.emplace_back(generate);
+    generate();
+    for (auto &worker : workers)
+        worker.join();
+
+    generateCollectionSections(writer, nullptr);
+    writer.writeEndElement(); // namespace
     writer.writeEndElement(); // INDEX
-    writer.writeEndElement(); // QDOCINDEX
     writer.writeEndDocument();
+    m_groupNames.reset();
+
+    const QByteArrayView placeholder("<children/>");
+    const qsizetype placeholderBegin = data.indexOf('\n', beforePlaceholder);
+    const qsizetype placeholderEnd = data.indexOf(placeholder, beforePlaceholder)
+            + placeholder.size();
+    file.write(data.constData(), placeholderBegin);
+    for (const QByteArray &chunk : chunks)
+        file.write(chunk);
+    file.write(data.constData() + placeholderEnd, data.size() - placeholderEnd);
     file.close();
+
+    if (!BinaryIndexReader::write(fileName))
+        qCDebug(lcQdoc) << "Could not write binary index for" << fileName;
 }
 
 QT_END_NAMESPACE
@@ -7,6 +7,8 @@
 #include "node.h"
 #include "tree.h"
 
+#include <optional>
+
 QT_BEGIN_NAMESPACE
 
 class Atom;
@@ -14,7 +16,7 @@ class FunctionNode;
 class Generator;
 class QDocDatabase;
 class WebXMLGenerator;
-class QXmlStreamReader;
+class IndexReader;
 class QXmlStreamWriter;
 class QXmlStreamAttributes;
 
@@ -40,7 +42,8 @@ private:
 
     void readIndexes(const QStringList &indexFiles);
     void readIndexFile(const QString &path);
-    void readIndexSection(QXmlStreamReader &reader, Node *current, const QString &indexUrl);
+    void readIndexFile(const QString &path, IndexReader &reader);
+    void readIndexSection(IndexReader &reader, Node *current, const QString &indexUrl);
     void insertTarget(TargetRec::TargetType type, const QXmlStreamAttributes &attributes,
                       Node *node);
     void resolveIndex();
@@ -49,6 +52,11 @@ private:
 
     void generateIndex(const QString &fileName, const QString &url, const QString &title,
                        Generator *g);
+    [[nodiscard]] bool hasIndexSection(const Node *node) const;
+    void prepareIndexSections(Node *node);
+    QByteArray generateIndexChunk(const NodeList &nodes);
+    QStringList groupNamesForNode(Node *node);
+    void generateCollectionSections(QXmlStreamWriter &writer, IndexSectionWriter *post);
     void generateFunctionSection(QXmlStreamWriter &writer, FunctionNode *fn);
     void generateFunctionSections(QXmlStreamWriter &writer, Aggregate *aggregate);
     bool generateIndexSection(QXmlStreamWriter &writer, Node *node,
@@ -63,6 +71,8 @@ private:
     QString m_project;
     QList<QPair<ClassNode *, QString>> m_basesList;
     NodeList m_relatedNodes;
+    QHash<const Node *, int> m_relatedNodeIndexes;
+    std::optional<QHash<const Node *, QStringList>> m_groupNames;
     bool m_storeLocationInfo;
 };
 
@@ -75,7 +75,9 @@ Atom::AtomType QmlCodeMarker::atomType() const
 QString QmlCodeMarker::markedUpCode(const QString &code, const Node *relative,
                                     const Location &location)
 {
-    return addMarkUp(code, relative, location);
+    return cachedMarkUp(code, [&](bool &complete) {
+        return addMarkUp(code, relative, location, &complete);
+    });
 }
 
 /*!
@@ -96,8 +98,13 @@ QString QmlCodeMarker::markedUpInclude(const QString &include)
     return addMarkUp("import " + include, nullptr, Location{});
 }
 
+/*!
+  Returns \a code marked up as QML. Sets \a complete, if given, to
+  \c false if the code could not be fully analyzed, in which case a
+  warning is reported at \a location.
+ */
 QString QmlCodeMarker::addMarkUp(const QString &code, const Node * /* relative */,
-                                 const Location &location)
+                                 const Location &location, bool *complete)
 {
 #ifndef QT_NO_DECLARATIVE
     QQmlJS::Engine engine;
@@ -117,12 +124,16 @@ QString QmlCodeMarker::addMarkUp(const QString &code, const Node * /* relative *
         QmlMarkupVisitor visitor(code, pragmas, &engine);
         QQmlJS::AST::Node::accept(ast, &visitor);
         if (visitor.hasError()) {
+            if (complete)
+                *complete = false;
             location.warning(
                     location.fileName()
                     + QStringLiteral("Unable to analyze QML snippet. The output is incomplete."));
         }
         output = visitor.markedUpCode();
     } else {
+        if (complete)
+            *complete = false;
         location.warning(QStringLiteral("Unable to parse QML snippet: \"%1\" at line %2, column %3")
                                  .arg(parser.errorMessage())
                                  .arg(parser.errorLineNumber())
@@ -133,6 +144,8 @@ QString QmlCodeMarker::addMarkUp(const QString &code, const Node * /* relative *
     return output;
 #else
     Q_UNUSED(code);
+    if (complete)
+        *complete = false;
     location.warning("QtDeclarative not installed; cannot parse QML or JS.");
     return QString();
 #endif
@@ -3,49 +3,95 @@
 
 #include "qmlcodeparser.h"
 
+#include "fileprefetcher.h"
 #include "node.h"
 #include "qmlvisitor.h"
+#include "utilities.h"
 
 #ifndef QT_NO_DECLARATIVE
 #    include <private/qqmljsast_p.h>
 #endif
 #include <qdebug.h>
 
+#include <QtCore/qfile.h>
+
+#include <algorithm>
+
 QT_BEGIN_NAMESPACE
 
+#ifndef QT_NO_DECLARATIVE
+// The number of threads that parse QML files ahead of the visitor.
+static const unsigned int kMaxQmlParserThreads = 8;
+
 /*!
-  Constructs the QML code parser.
+  \internal
+  \struct QmlParsedFile
+
+  A QML file with the engine, lexer, and parser it was parsed with. The
+  engine owns the syntax tree and the comments that QmlDocVisitor walks,
+  so they are kept together until the file is visited.
  */
-QmlCodeParser::QmlCodeParser()
-#ifndef QT_NO_DECLARATIVE
-    : m_lexer(nullptr), m_parser(nullptr)
-#endif
+struct QmlParsedFile
+{
+    QString code;
+    QQmlJS::Engine engine;
+    QQmlJS::Lexer lexer { &engine };
+    QQmlJS::Parser parser { &engine };
+    bool opened = false;
+    bool parsedOk = false;
+};
+
+/*!
+  \internal
+  \class QmlFilePrefetcher
+
+  Parses QML files ahead of QmlCodeParser::parseSourceFile(). Each file
+  gets its own engine, lexer, and parser.
+ */
+class QmlFilePrefetcher : public FilePrefetcher<std::unique_ptr<QmlParsedFile>>
+{
+public:
+    explicit QmlFilePrefetcher(const QStringList &filePaths);
+};
+
+/*!
+  Starts parsing the files in \a filePaths.
+ */
+QmlFilePrefetcher::QmlFilePrefetcher(const QStringList &filePaths)
+    // QML files are small; keep the workers busy while one is visited.
+    : FilePrefetcher(filePaths, std::min(Utilities::threadCount(), kMaxQmlParserThreads),
+                     4 * std::min(Utilities::threadCount(), kMaxQmlParserThreads),
+                     &QmlCodeParser::parseFile)
 {
 }
+#else
+class QmlFilePrefetcher
+{
+};
+#endif
+
+/*!
+  Constructs the QML code parser.
+ */
+QmlCodeParser::QmlCodeParser() = default;
+
+QmlCodeParser::~QmlCodeParser() = default;
 
 /*!
   Initializes the code parser base class.
-  Also creates a lexer and parser from QQmlJS.
  */
 void QmlCodeParser::initializeParser()
 {
     CodeParser::initializeParser();
-
-#ifndef QT_NO_DECLARATIVE
-    m_lexer = new QQmlJS::Lexer(&m_engine);
-    m_parser = new QQmlJS::Parser(&m_engine);
-#endif
 }
 
 /*!
-  Terminates the QML code parser. Deletes the lexer and parser
-  created by the constructor.
+  Terminates the QML code parser. Stops parsing files ahead.
  */
 void QmlCodeParser::terminateParser()
 {
 #ifndef QT_NO_DECLARATIVE
-    delete m_lexer;
-    delete m_parser;
+    m_prefetcher.reset();
 #endif
 }
 
@@ -66,6 +112,46 @@ QStringList QmlCodeParser::sourceFileNameFilter()
     return QStringList() << "*.qml";
 }
 
+/*!
+  Parses the QML files in \a filePaths on worker threads, ahead of the
+  calls to parseSourceFile() for them, which then only visit the parsed
+  files to insert their contents into the database. Files that are not
+  in the list are parsed by parseSourceFile() itself.
+ */
+void QmlCodeParser::parseSourceFilesAhead(const QStringList &filePaths)
+{
+#ifndef QT_NO_DECLARATIVE
+    m_prefetcher.reset();
+    if (filePaths.isEmpty() || Utilities::threadCount() == 1)
+        return;
+    m_prefetcher = std::make_unique<QmlFilePrefetcher>(filePaths);
+#else
+    Q_UNUSED(filePaths);
+#endif
+}
+
+#ifndef QT_NO_DECLARATIVE
+/*!
+  Reads and parses the QML file at \a filePath with an engine of its
+  own. This function is called from multiple threads.
+ */
+std::unique_ptr<QmlParsedFile> QmlCodeParser::parseFile(const QString &filePath)
+{
+    auto file = std::make_unique<QmlParsedFile>();
+    QFile in(filePath);
+    if (!in.open(QIODevice::ReadOnly))
+        return file;
+    file->opened = true;
+    file->code = in.readAll();
+    in.close();
+
+    extractPragmas(file->code);
+    file->lexer.setCode(file->code, 1);
+    file->parsedOk = file->parser.parse();
+    return file;
+}
+#endif
+
 /*!
   Parses the source file at \a filePath and inserts the contents
   into the database. The \a location is used for error reporting.
@@ -75,45 +161,46 @@ QStringList QmlCodeParser::sourceFileNameFilter()
  */
 void QmlCodeParser::parseSourceFile(const Location &location, const QString &filePath)
 {
-    QFile in(filePath);
     m_currentFile = filePath;
-    if (!in.open(QIODevice::ReadOnly)) {
+#ifndef QT_NO_DECLARATIVE
+    std::unique_ptr<QmlParsedFile> file;
+    if (m_prefetcher)
+        m_prefetcher->take(filePath, &file);
+    if (!file)
+        file = parseFile(filePath);
+    if (!file->opened) {
         location.error(QStringLiteral("Cannot open QML file '%1'").arg(filePath));
         m_currentFile.clear();
         return;
     }
 
-#ifndef QT_NO_DECLARATIVE
-    QString document = in.readAll();
-    in.close();
-
-    Location fileLocation(filePath);
-
-    QString newCode = document;
-    extractPragmas(newCode);
-    m_lexer->setCode(newCode, 1);
-
-    if (m_parser->parse()) {
-        QQmlJS::AST::UiProgram *ast = m_parser->ast();
-        QmlDocVisitor visitor(filePath, newCode, &m_engine, topicCommands() + commonMetaCommands(),
-                              topicCommands());
+    if (file->parsedOk) {
+        QQmlJS::AST::UiProgram *ast = file->parser.ast();
+        QmlDocVisitor visitor(filePath, file->code, &file->engine,
+                              topicCommands() + commonMetaCommands(), topicCommands());
         QQmlJS::AST::Node::accept(ast, &visitor);
         if (visitor.hasError()) {
             qDebug().nospace() << qPrintable(filePath) << ": Could not analyze QML file. "
                                << "The output is incomplete.";
         }
     }
-    const auto &messages = m_parser->diagnosticMessages();
+    const auto &messages = file->parser.diagnosticMessages();
     for (const auto &msg : messages) {
         qDebug().nospace() << qPrintable(filePath) << ':'
                            << msg.loc.startLine << ": QML syntax error at col "
                            << msg.loc.startColumn
                            << ": " << qPrintable(msg.message);
     }
-    m_currentFile.clear();
 #else
+    QFile in(filePath);
+    if (!in.open(QIODevice::ReadOnly)) {
+        location.error(QStringLiteral("Cannot open QML file '%1'").arg(filePath));
+        m_currentFile.clear();
+        return;
+    }
     location.warning("QtDeclarative not installed; cannot parse QML or JS.");
 #endif
+    m_currentFile.clear();
 }
 
 static QSet<QString> topicCommands_;
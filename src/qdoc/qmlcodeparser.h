@@ -8,6 +8,8 @@
 
 #include <QtCore/qset.h>
 
+#include <memory>
+
 #ifndef QT_NO_DECLARATIVE
 #    include <private/qqmljsengine_p.h>
 #    include <private/qqmljslexer_p.h>
@@ -18,22 +20,26 @@ QT_BEGIN_NAMESPACE
 
 class Node;
 class QString;
+class QmlFilePrefetcher;
+struct QmlParsedFile;
 
 class QmlCodeParser : public CodeParser
 {
 public:
     QmlCodeParser();
-    ~QmlCodeParser() override = default;
+    ~QmlCodeParser() override;
 
     void initializeParser() override;
     void terminateParser() override;
     QString language() override;
     QStringList sourceFileNameFilter() override;
     void parseSourceFile(const Location &location, const QString &filePath) override;
+    void parseSourceFilesAhead(const QStringList &filePaths);
 
 #ifndef QT_NO_DECLARATIVE
     /* Copied from src/declarative/qml/qdeclarativescriptparser.cpp */
-    void extractPragmas(QString &script);
+    static void extractPragmas(QString &script);
+    static std::unique_ptr<QmlParsedFile> parseFile(const QString &filePath);
 #endif
 
 protected:
@@ -41,9 +47,7 @@ protected:
 
 private:
 #ifndef QT_NO_DECLARATIVE
-    QQmlJS::Engine m_engine {};
-    QQmlJS::Lexer *m_lexer { nullptr };
-    QQmlJS::Parser *m_parser { nullptr };
+    std::unique_ptr<QmlFilePrefetcher> m_prefetcher;
 #endif
 };
 
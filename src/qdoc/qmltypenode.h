@@ -47,6 +47,7 @@ public:
     [[nodiscard]] const QString &qmlBaseName() const { return m_qmlBaseName; }
     void setQmlBaseName(const QString &name) { m_qmlBaseName = name; }
     [[nodiscard]] QmlTypeNode *qmlBaseNode() const override { return m_qmlBaseNode; }
+    void clearQmlBaseNode() { m_qmlBaseNode = nullptr; }
     void resolveInheritance(NodeMap &previousSearches);
     static void addInheritedBy(const Node *base, Node *sub);
     static void subclasses(const Node *base, NodeList &subs);
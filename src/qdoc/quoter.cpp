@@ -10,6 +10,7 @@
 QT_BEGIN_NAMESPACE
 
 QHash<QString, QString> Quoter::s_commentHash;
+QHash<QString, std::shared_ptr<const Quoter::QuotedFile>> Quoter::s_fileCache;
 
 static void replaceMultipleNewlines(QString &s)
 {
@@ -109,13 +110,19 @@ void Quoter::reset()
     m_plainLines.clear();
     m_markedLines.clear();
     m_codeLocation = Location();
+    m_file.reset();
+    m_lineIndex = 0;
 }
 
+/*
+  Quotes from \a plainCode, the contents of the file \a userFriendlyFilePath,
+  and \a markedCode, the same contents marked up. If \a cache is \c true,
+  the split lines are kept, so that quoteFromCachedFile() can quote from the
+  file again.
+*/
 void Quoter::quoteFromFile(const QString &userFriendlyFilePath, const QString &plainCode,
-                           const QString &markedCode)
+                           const QString &markedCode, bool cache)
 {
-    m_silent = false;
-
     /*
       Split the source code into logical lines. Empty lines are
       treated specially. Before:
@@ -137,24 +144,86 @@ void Quoter::quoteFromFile(const QString &userFriendlyFilePath, const QString &p
 
       Newlines are preserved because they affect codeLocation.
     */
-    m_codeLocation = Location(userFriendlyFilePath);
-
-    m_plainLines = splitLines(plainCode);
-    m_markedLines = splitLines(markedCode);
-    if (m_markedLines.count() != m_plainLines.count()) {
-        m_codeLocation.warning(
-                QStringLiteral("Something is wrong with qdoc's handling of marked code"));
-        m_markedLines = m_plainLines;
+    auto file = std::make_shared<QuotedFile>();
+    file->filePath = userFriendlyFilePath;
+    file->plainLines = splitLines(plainCode);
+    file->markedLines = splitLines(markedCode);
+    if (file->markedLines.count() != file->plainLines.count()) {
+        Location(userFriendlyFilePath)
+                .warning(QStringLiteral("Something is wrong with qdoc's handling of marked code"));
+        file->markedLines = file->plainLines;
     }
 
     /*
       Squeeze blanks (cat -s).
     */
-    for (auto &line : m_markedLines)
+    for (auto &line : file->markedLines)
         replaceMultipleNewlines(line);
+
+    /*
+      Index the first line of each snippet delimiter, as match() sees
+      it, so that quoteSnippet() does not have to match every line.
+    */
+    setFile(file);
+    const QString prefix = commentForCode() + QLatin1Char('[');
+    for (qsizetype i = 0; i < file->plainLines.size(); ++i) {
+        QString line = file->plainLines.at(i);
+        while (line.endsWith(QLatin1Char('\n')))
+            line.chop(1);
+        trimWhiteSpace(line);
+        for (qsizetype from = line.indexOf(prefix); from != -1;
+             from = line.indexOf(prefix, from + 1)) {
+            const qsizetype to = line.indexOf(QLatin1Char(']'), from + prefix.size());
+            if (to == -1)
+                break;
+            const QString delimiter = line.mid(from, to + 1 - from);
+            if (!file->snippetLines.contains(delimiter))
+                file->snippetLines.insert(delimiter, i);
+        }
+    }
+
+    if (cache)
+        s_fileCache.insert(userFriendlyFilePath, file);
+}
+
+/*
+  Quotes from the file \a filePath if it was quoted from before in this
+  run, and returns \c true; otherwise returns \c false.
+*/
+bool Quoter::quoteFromCachedFile(const QString &filePath)
+{
+    const auto it = s_fileCache.constFind(filePath);
+    if (it == s_fileCache.cend())
+        return false;
+    setFile(*it);
+    return true;
+}
+
+void Quoter::setFile(std::shared_ptr<const QuotedFile> file)
+{
+    m_silent = false;
+    m_file = std::move(file);
+    m_lineIndex = 0;
+    m_plainLines = m_file->plainLines;
+    m_markedLines = m_file->markedLines;
+    m_codeLocation = Location(m_file->filePath);
     m_codeLocation.start();
 }
 
+/*
+  Skips \a count lines, as \a count calls to getLine() would.
+*/
+void Quoter::skipLines(qsizetype count)
+{
+    int lines = 0;
+    for (qsizetype i = 0; i < count; ++i)
+        lines += m_markedLines.at(i).count(QLatin1Char('\n')) + 1;
+    m_plainLines.remove(0, count);
+    m_markedLines.remove(0, count);
+    m_lineIndex += count;
+    m_codeLocation.advanceLines(lines);
+}
+
 QString Quoter::quoteLine(const Location &docLocation, const QString &command,
                           const QString &pattern)
 {
@@ -186,6 +255,17 @@ QString Quoter::quoteSnippet(const Location &docLocation, const QString &identif
     QString t;
     int indent = 0;
 
+    if (m_file) {
+        // A delimiter with a ']' in the identifier may match where it is not indexed
+        QString key = delimiter;
+        trimWhiteSpace(key);
+        if (key.indexOf(QLatin1Char(']')) == key.size() - 1) {
+            const qsizetype line = m_file->snippetLines.value(key, m_file->plainLines.size());
+            if (line >= m_lineIndex)
+                skipLines(line - m_lineIndex);
+        }
+    }
+
     while (!m_plainLines.isEmpty()) {
         if (match(docLocation, delimiter, m_plainLines.first())) {
             QString startLine = getLine();
@@ -257,6 +337,7 @@ QString Quoter::getLine(int unindent)
         return QString();
 
     m_plainLines.removeFirst();
+    ++m_lineIndex;
 
     QString t = m_markedLines.takeFirst();
     int i = 0;
@@ -9,6 +9,8 @@
 #include <QtCore/qhash.h>
 #include <QtCore/qstringlist.h>
 
+#include <memory>
+
 QT_BEGIN_NAMESPACE
 
 class Quoter
@@ -18,15 +20,27 @@ public:
 
     void reset();
     void quoteFromFile(const QString &userFriendlyFileName, const QString &plainCode,
-                       const QString &markedCode);
+                       const QString &markedCode, bool cache = false);
+    bool quoteFromCachedFile(const QString &filePath);
     QString quoteLine(const Location &docLocation, const QString &command, const QString &pattern);
     QString quoteTo(const Location &docLocation, const QString &command, const QString &pattern);
     QString quoteUntil(const Location &docLocation, const QString &command, const QString &pattern);
     QString quoteSnippet(const Location &docLocation, const QString &identifier);
 
     static QStringList splitLines(const QString &line);
+    static void clearCache() { s_fileCache.clear(); }
 
 private:
+    struct QuotedFile
+    {
+        QString filePath;
+        QStringList plainLines;
+        QStringList markedLines;
+        QHash<QString, qsizetype> snippetLines;
+    };
+
+    void setFile(std::shared_ptr<const QuotedFile> file);
+    void skipLines(qsizetype count);
     QString getLine(int unindent = 0);
     void failedAtEnd(const Location &docLocation, const QString &command);
     bool match(const Location &docLocation, const QString &pattern, const QString &line);
@@ -37,7 +51,10 @@ private:
     QStringList m_plainLines {};
     QStringList m_markedLines {};
     Location m_codeLocation {};
+    std::shared_ptr<const QuotedFile> m_file {};
+    qsizetype m_lineIndex {};
     static QHash<QString, QString> s_commentHash;
+    static QHash<QString, std::shared_ptr<const QuotedFile>> s_fileCache;
 };
 
 QT_END_NAMESPACE
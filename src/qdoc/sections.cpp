@@ -32,6 +32,9 @@ QList<Section> Sections::s_sinceSections(15, Section(Section::Details, Section::
 QList<Section> Sections::s_allMembers(1, Section(Section::AllMembers, Section::Active));
 QList<Section> Sections::s_stdQmlTypeSummarySections(7, Section(Section::Summary, Section::Active));
 QList<Section> Sections::s_stdQmlTypeDetailsSections(7, Section(Section::Details, Section::Active));
+bool Sections::s_cacheEnabled = false;
+QHash<const Aggregate *, Sections::CachedSections> Sections::s_cache;
+QHash<const SectionVector *, SectionVector> Sections::s_blankSections;
 
 /*!
   \class Section
@@ -270,11 +273,24 @@ void Section::reduce()
 
 /*!
   This constructor builds the vectors of sections based on the
-  type of the \a aggregate node.
+  type of the \a aggregate node. If the cache is enabled and the
+  sections of \a aggregate were built before, they are taken from
+  the cache instead.
  */
 Sections::Sections(Aggregate *aggregate) : m_aggregate(aggregate)
 {
     initSections();
+    if (s_cacheEnabled) {
+        const auto it = s_cache.find(m_aggregate);
+        if (it != s_cache.end()) {
+            const auto [summarySections, detailsSections] = refPageSections();
+            *summarySections = std::move(it->summarySections);
+            *detailsSections = std::move(it->detailsSections);
+            s_allMembers = std::move(it->allMembers);
+            s_cache.erase(it);
+            return;
+        }
+    }
     initAggregate(s_allMembers, m_aggregate);
     switch (m_aggregate->nodeType()) {
     case Node::Class:
@@ -394,11 +410,21 @@ Sections::Sections(const NodeMultiMap &nsmap) : m_aggregate(nullptr)
   The behavior of the destructor depends on the type of the
   Aggregate node that was passed to the constructor. If the
   constructor was passed a multimap, the destruction is a
-  bit different because there was no Aggregate node.
+  bit different because there was no Aggregate node. If the
+  cache is enabled, the sections of the Aggregate node are moved
+  to the cache rather than cleared.
  */
 Sections::~Sections()
 {
-    if (m_aggregate) {
+    if (m_aggregate && s_cacheEnabled) {
+        const auto [summarySections, detailsSections] = refPageSections();
+        s_cache[m_aggregate] = CachedSections {
+            std::exchange(*summarySections, s_blankSections.value(summarySections)),
+            std::exchange(*detailsSections, s_blankSections.value(detailsSections)),
+            std::exchange(s_allMembers, s_blankSections.value(&s_allMembers))
+        };
+        m_aggregate = nullptr;
+    } else if (m_aggregate) {
         switch (m_aggregate->nodeType()) {
         case Node::Class:
         case Node::Struct:
@@ -427,6 +453,42 @@ Sections::~Sections()
     }
 }
 
+/*!
+  Enables or disables the cache of the sections built for each
+  Aggregate node. The cache is cleared when it is disabled.
+
+  With the cache enabled, the sections of an aggregate, including
+  the members it inherits, are built once however many generators
+  ask for them. It must be disabled before the nodes are deleted.
+ */
+void Sections::setCacheEnabled(bool enabled)
+{
+    s_cacheEnabled = enabled;
+    if (!enabled)
+        s_cache.clear();
+}
+
+/*!
+  Returns the summary and details vectors that are built for the
+  type of the aggregate node.
+ */
+std::pair<SectionVector *, SectionVector *> Sections::refPageSections() const
+{
+    switch (m_aggregate->nodeType()) {
+    case Node::Class:
+    case Node::Struct:
+    case Node::Union:
+        return { &s_stdCppClassSummarySections, &s_stdCppClassDetailsSections };
+    case Node::JsType:
+    case Node::JsBasicType:
+    case Node::QmlType:
+    case Node::QmlValueType:
+        return { &s_stdQmlTypeSummarySections, &s_stdQmlTypeDetailsSections };
+    default:
+        return { &s_stdSummarySections, &s_stdDetailsSections };
+    }
+}
+
 /*!
   Initialize the Aggregate in each Section of vector \a v with \a aggregate.
  */
@@ -547,6 +609,12 @@ void Sections::initSections()
         v[5].init("Method Documentation", "qmlmeth", "member", "members");
         v[6].init("Attached Method Documentation", "qmlattmeth", "member", "members");
     }
+
+    // The initialized vectors replace those moved to the cache.
+    for (const SectionVector *v : { &s_allMembers, &s_stdSummarySections, &s_stdDetailsSections,
+                                    &s_stdCppClassSummarySections, &s_stdCppClassDetailsSections,
+                                    &s_stdQmlTypeSummarySections, &s_stdQmlTypeDetailsSections })
+        s_blankSections.insert(v, *v);
 }
 
 /*!
@@ -6,8 +6,11 @@
 
 #include "node.h"
 
+#include <QtCore/qhash.h>
 #include <QtCore/qpair.h>
 
+#include <utility>
+
 QT_BEGIN_NAMESPACE
 
 class Aggregate;
@@ -194,6 +197,8 @@ public:
 
     bool hasObsoleteMembers(SectionPtrVector *summary_spv, SectionPtrVector *details_spv) const;
 
+    static void setCacheEnabled(bool enabled);
+
     static Section &allMembersSection() { return s_allMembers[0]; }
     SectionVector &sinceSections() { return s_sinceSections; }
     SectionVector &stdSummarySections() { return s_stdSummarySections; }
@@ -231,10 +236,22 @@ private:
     void distributeQmlNodeInDetailsVector(SectionVector &dv, Node *n);
     void distributeQmlNodeInSummaryVector(SectionVector &sv, Node *n, bool sharing = false);
     void initAggregate(SectionVector &v, Aggregate *aggregate);
+    [[nodiscard]] std::pair<SectionVector *, SectionVector *> refPageSections() const;
 
 private:
+    struct CachedSections
+    {
+        SectionVector summarySections {};
+        SectionVector detailsSections {};
+        SectionVector allMembers {};
+    };
+
     Aggregate *m_aggregate { nullptr };
 
+    static bool s_cacheEnabled;
+    static QHash<const Aggregate *, CachedSections> s_cache;
+    static QHash<const SectionVector *, SectionVector> s_blankSections;
+
     static SectionVector s_stdSummarySections;
     static SectionVector s_stdDetailsSections;
     static SectionVector s_stdCppClassSummarySections;
@@ -280,6 +280,7 @@ void TagFileWriter::generateTagFileMembers(QXmlStreamWriter &writer, const Aggre
  */
 void TagFileWriter::generateTagFile(const QString &fileName, Generator *g)
 {
+    m_generator = g;
     QFile file(fileName);
     QFileInfo fileInfo(fileName);
 
@@ -293,7 +294,6 @@ void TagFileWriter::generateTagFile(const QString &fileName, Generator *g)
         return;
     }
 
-    m_generator = g;
     QXmlStreamWriter writer(&file);
     writer.setAutoFormatting(true);
     writer.writeStartDocument();
@@ -0,0 +1,291 @@
+// Copyright (C) 2023 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
+
+#include "timings.h"
+
+#include "aggregate.h"
+#include "classnode.h"
+#include "collectionnode.h"
+#include "config.h"
+#include "enumnode.h"
+#include "examplenode.h"
+#include "externalpagenode.h"
+#include "functionnode.h"
+#include "headernode.h"
+#include "namespacenode.h"
+#include "propertynode.h"
+#include "proxynode.h"
+#include "qmlpropertynode.h"
+#include "qmltypenode.h"
+#include "sharedcommentnode.h"
+#include "typedefnode.h"
+#include "variablenode.h"
+
+#include <QtCore/qfile.h>
+#include <QtCore/qjsonarray.h>
+#include <QtCore/qjsondocument.h>
+#include <QtCore/qjsonobject.h>
+#include <QtCore/qmap.h>
+#include <QtCore/qset.h>
+
+#if defined(Q_OS_WIN)
+#    include <QtCore/qt_windows.h>
+#    include <psapi.h>
+#elif defined(Q_OS_UNIX)
+#    include <sys/resource.h>
+#endif
+
+QT_BEGIN_NAMESPACE
+
+/*!
+  \class Timings
+  \internal
+
+  \brief Records the wall time, CPU time and peak memory use of the
+  phases of a qdoc run.
+
+  Timings are only recorded when an output file is set, with the
+  \c -timings command line option. The records are written to that
+  file as JSON when qdoc exits, one per phase and project, in the order
+  the phases ended. Phases may be nested; the time of a nested phase is
+  also part of the time of the enclosing one.
+
+  The number of nodes of each type in the trees, with their memory use,
+  is recorded with recordNodes().
+ */
+
+/*!
+  \class Timings::Phase
+  \internal
+
+  \brief Records the phase \a name from its construction to its
+  destruction, if timings are enabled.
+ */
+Timings::Phase::Phase(const QString &name) : m_name(name)
+{
+    const Timings &timings = Timings::instance();
+    if (timings.isEnabled()) {
+        m_start = timings.m_timer.elapsed();
+        m_cpuStart = cpuTime();
+    }
+}
+
+Timings::Phase::~Phase()
+{
+    if (m_start < 0)
+        return;
+    Timings &timings = Timings::instance();
+    const Config &config = Config::instance();
+    const QString pass = config.preparing()
+            ? QStringLiteral("prepare")
+            : (config.generating() ? QStringLiteral("generate") : QStringLiteral("prepare+generate"));
+    timings.m_records.append({ timings.m_project, pass, m_name, m_start,
+                               timings.m_timer.elapsed() - m_start, cpuTime() - m_cpuStart,
+                               peakRss() });
+}
+
+/*!
+  Returns the size of the object of a node of type \a type.
+ */
+static qint64 nodeObjectSize(Node::NodeType type)
+{
+    switch (type) {
+    case Node::Namespace:
+        return sizeof(NamespaceNode);
+    case Node::Class:
+    case Node::Struct:
+    case Node::Union:
+        return sizeof(ClassNode);
+    case Node::HeaderFile:
+        return sizeof(HeaderNode);
+    case Node::Page:
+        return sizeof(PageNode);
+    case Node::Enum:
+        return sizeof(EnumNode);
+    case Node::Example:
+        return sizeof(ExampleNode);
+    case Node::ExternalPage:
+        return sizeof(ExternalPageNode);
+    case Node::Function:
+        return sizeof(FunctionNode);
+    case Node::Typedef:
+        return sizeof(TypedefNode);
+    case Node::TypeAlias:
+        return sizeof(TypeAliasNode);
+    case Node::Property:
+        return sizeof(PropertyNode);
+    case Node::Variable:
+        return sizeof(VariableNode);
+    case Node::Group:
+    case Node::Module:
+    case Node::QmlModule:
+    case Node::JsModule:
+    case Node::Collection:
+        return sizeof(CollectionNode);
+    case Node::QmlType:
+    case Node::JsType:
+        return sizeof(QmlTypeNode);
+    case Node::QmlValueType:
+    case Node::JsBasicType:
+        return sizeof(QmlValueTypeNode);
+    case Node::QmlProperty:
+    case Node::JsProperty:
+        return sizeof(QmlPropertyNode);
+    case Node::SharedComment:
+        return sizeof(SharedCommentNode);
+    case Node::Proxy:
+        return sizeof(ProxyNode);
+    case Node::NoType:
+        break;
+    }
+    return sizeof(Node);
+}
+
+/*!
+  Records the number of nodes of each type in the tree of \a module
+  under \a root, the size of their objects, and the size of the string
+  data of their names, paths, versions, briefs and locations.
+
+  Strings that share their data are counted once, for the first node
+  that refers to them, so interned strings hardly count. The other
+  data of the nodes, such as their documentation, is not included.
+ */
+void Timings::recordNodes(const QString &module, const Aggregate *root)
+{
+    if (!isEnabled() || !root)
+        return;
+
+    struct Counts
+    {
+        qint64 count = 0;
+        qint64 objectBytes = 0;
+        qint64 stringBytes = 0;
+    };
+    QMap<QString, Counts> counts;
+    QSet<const QChar *> seenStrings;
+    const auto stringSize = [&seenStrings](const QString &string) -> qint64 {
+        if (string.isEmpty() || seenStrings.contains(string.constData()))
+            return 0;
+        seenStrings.insert(string.constData());
+        return string.capacity() * qint64(sizeof(QChar));
+    };
+    const auto locationSize = [&stringSize](const Location &location) -> qint64 {
+        return location.isEmpty() ? 0 : stringSize(location.filePath());
+    };
+
+    QList<const Node *> pending { root };
+    while (!pending.isEmpty()) {
+        const Node *node = pending.takeLast();
+        Counts &c = counts[node->nodeTypeString()];
+        ++c.count;
+        c.objectBytes += nodeObjectSize(node->nodeType());
+        c.stringBytes += stringSize(node->name()) + stringSize(node->fileNameBase())
+                + stringSize(node->physicalModuleName()) + stringSize(node->url())
+                + stringSize(node->since()) + stringSize(node->templateDecl())
+                + stringSize(node->reconstitutedBrief()) + stringSize(node->outputSubdirectory())
+                + stringSize(node->deprecatedSince()) + locationSize(node->declLocation())
+                + locationSize(node->defLocation());
+        if (node->isAggregate()) {
+            const NodeList &children = static_cast<const Aggregate *>(node)->childNodes();
+            for (const Node *child : children)
+                pending.append(child);
+        }
+    }
+
+    for (auto it = counts.cbegin(); it != counts.cend(); ++it) {
+        m_nodeRecords.append({ m_project, module, it.key(), it->count, it->objectBytes,
+                               it->stringBytes });
+    }
+}
+
+/*!
+  Writes the records to the output file.
+ */
+void Timings::write() const
+{
+    if (!isEnabled())
+        return;
+
+    QJsonArray phases;
+    for (const Record &record : m_records) {
+        phases.append(QJsonObject { { "project", record.project },
+                                    { "pass", record.pass },
+                                    { "phase", record.phase },
+                                    { "startMs", record.start },
+                                    { "wallMs", record.wallTime },
+                                    { "cpuMs", record.cpuTime },
+                                    { "peakRssKiB", record.peakRss } });
+    }
+    QJsonArray nodes;
+    for (const NodeRecord &record : m_nodeRecords) {
+        nodes.append(QJsonObject { { "project", record.project },
+                                   { "module", record.module },
+                                   { "type", record.type },
+                                   { "count", record.count },
+                                   { "objectBytes", record.objectBytes },
+                                   { "stringBytes", record.stringBytes } });
+    }
+    const QJsonObject root { { "qdocVersion", QLatin1String(QT_VERSION_STR) },
+                             { "totalWallMs", m_timer.elapsed() },
+                             { "phases", phases },
+                             { "nodes", nodes } };
+
+    QFile file(m_outputFile);
+    if (!file.open(QFile::WriteOnly | QFile::Truncate)) {
+        qWarning("Cannot write timings to '%s'", qPrintable(m_outputFile));
+        return;
+    }
+    file.write(QJsonDocument(root).toJson());
+}
+
+/*!
+  Returns the CPU time used by all threads of the process so far, in
+  milliseconds, or 0 if it is not known.
+ */
+qint64 Timings::cpuTime()
+{
+#if defined(Q_OS_WIN)
+    FILETIME creation, exit, kernel, user;
+    if (!GetProcessTimes(GetCurrentProcess(), &creation, &exit, &kernel, &user))
+        return 0;
+    const auto toMs = [](const FILETIME &t) {
+        return qint64((quint64(t.dwHighDateTime) << 32 | t.dwLowDateTime) / 10000);
+    };
+    return toMs(kernel) + toMs(user);
+#elif defined(Q_OS_UNIX)
+    rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) != 0)
+        return 0;
+    return qint64(usage.ru_utime.tv_sec + usage.ru_stime.tv_sec) * 1000
+            + (usage.ru_utime.tv_usec + usage.ru_stime.tv_usec) / 1000;
+#else
+    return 0;
+#endif
+}
+
+/*!
+  Returns the peak resident set size of the process so far, in KiB, or
+  0 if it is not known.
+ */
+qint64 Timings::peakRss()
+{
+#if defined(Q_OS_WIN)
+    PROCESS_MEMORY_COUNTERS counters;
+    if (!K32GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters)))
+        return 0;
+    return qint64(counters.PeakWorkingSetSize / 1024);
+#elif defined(Q_OS_UNIX)
+    rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) != 0)
+        return 0;
+#    if defined(Q_OS_DARWIN)
+    return qint64(usage.ru_maxrss / 1024); // bytes
+#    else
+    return qint64(usage.ru_maxrss); // KiB
+#    endif
+#else
+    return 0;
+#endif
+}
+
+QT_END_NAMESPACE
@@ -0,0 +1,76 @@
+// Copyright (C) 2023 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
+
+#ifndef TIMINGS_H
+#define TIMINGS_H
+
+#include "singleton.h"
+
+#include <QtCore/qelapsedtimer.h>
+#include <QtCore/qlist.h>
+#include <QtCore/qstring.h>
+
+QT_BEGIN_NAMESPACE
+
+class Aggregate;
+
+class Timings : public Singleton<Timings>
+{
+public:
+    class Phase
+    {
+    public:
+        explicit Phase(const QString &name);
+        ~Phase();
+        Phase(const Phase &) = delete;
+        Phase &operator=(const Phase &) = delete;
+
+    private:
+        QString m_name;
+        qint64 m_start { -1 };
+        qint64 m_cpuStart { 0 };
+    };
+
+    Timings() { m_timer.start(); }
+
+    void setOutputFile(const QString &fileName) { m_outputFile = fileName; }
+    [[nodiscard]] bool isEnabled() const { return !m_outputFile.isEmpty(); }
+    void setProject(const QString &project) { m_project = project; }
+    void recordNodes(const QString &module, const Aggregate *root);
+    void write() const;
+
+private:
+    struct Record
+    {
+        QString project;
+        QString pass;
+        QString phase;
+        qint64 start;
+        qint64 wallTime;
+        qint64 cpuTime;
+        qint64 peakRss;
+    };
+
+    struct NodeRecord
+    {
+        QString project;
+        QString module;
+        QString type;
+        qint64 count;
+        qint64 objectBytes;
+        qint64 stringBytes;
+    };
+
+    static qint64 cpuTime();
+    static qint64 peakRss();
+
+    QElapsedTimer m_timer {};
+    QString m_outputFile {};
+    QString m_project {};
+    QList<Record> m_records {};
+    QList<NodeRecord> m_nodeRecords {};
+};
+
+QT_END_NAMESPACE
+
+#endif // TIMINGS_H
@@ -777,6 +777,15 @@ QString Tokenizer::lexeme() const
     return sourceDecoder(m_lex);
 }
 
+/*!
+  Decodes \a source with the source encoding, the way lexeme() decodes
+  the tokens.
+ */
+QString Tokenizer::decode(QByteArrayView source)
+{
+    return sourceDecoder(source);
+}
+
 QString Tokenizer::previousLexeme() const
 {
     return sourceDecoder(m_prevLex);
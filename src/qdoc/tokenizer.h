@@ -90,6 +90,7 @@ public:
     [[nodiscard]] const Location &location() const { return m_tokLoc; }
     [[nodiscard]] QString previousLexeme() const;
     [[nodiscard]] QString lexeme() const;
+    [[nodiscard]] static QString decode(QByteArrayView source);
     [[nodiscard]] QString version() const { return m_version; }
     [[nodiscard]] int parenDepth() const { return m_parenDepth; }
     [[nodiscard]] int bracketDepth() const { return m_bracketDepth; }
@@ -1233,11 +1233,23 @@ const FunctionNode *Tree::findFunctionNode(const QStringList &path, const Parame
   Search this tree recursively from \a parent to find a function
   node with the specified \a tag. If no function node is found
   with the required \a tag, return 0.
+
+  If \a parent is \nullptr, the function is looked up in an index
+  of the tags in the whole tree. The index is rebuilt by
+  indexFunctionTags() when the tag is not found in it, because
+  the tree may have grown since it was built.
  */
 FunctionNode *Tree::findFunctionNodeForTag(const QString &tag, Aggregate *parent)
 {
-    if (parent == nullptr)
-        parent = root();
+    if (parent == nullptr) {
+        FunctionNode *fn = m_functionsByTag.value(tag);
+        if (fn == nullptr || !fn->hasTag(tag)) {
+            m_functionsByTag.clear();
+            indexFunctionTags(root());
+            fn = m_functionsByTag.value(tag);
+        }
+        return fn;
+    }
     const NodeList &children = parent->childNodes();
     for (Node *n : children) {
         if (n != nullptr && n->isFunction() && n->hasTag(tag))
@@ -1253,6 +1265,27 @@ FunctionNode *Tree::findFunctionNodeForTag(const QString &tag, Aggregate *parent
     return nullptr;
 }
 
+/*!
+  Adds the tagged functions in the subtree of \a parent to the tag
+  index, in the order findFunctionNodeForTag() visits them, so that
+  the first function with a tag is the one found.
+ */
+void Tree::indexFunctionTags(Aggregate *parent)
+{
+    const NodeList &children = parent->childNodes();
+    for (Node *n : children) {
+        if (n != nullptr && n->isFunction()) {
+            auto *fn = static_cast<FunctionNode *>(n);
+            if (!fn->tag().isEmpty() && !m_functionsByTag.contains(fn->tag()))
+                m_functionsByTag.insert(fn->tag(), fn);
+        }
+    }
+    for (Node *n : children) {
+        if (n != nullptr && n->isAggregate())
+            indexFunctionTags(static_cast<Aggregate *>(n));
+    }
+}
+
 /*!
   There should only be one macro node for macro name \a t.
   The macro node is not built until the \macro command is seen.
@@ -161,8 +161,9 @@ private: // The rest of the class is private.
     void setIndexFileName(const QString &t) { m_indexFileName = t; }
 
     [[nodiscard]] bool treeHasBeenAnalyzed() const { return m_treeHasBeenAnalyzed; }
-    void setTreeHasBeenAnalyzed() { m_treeHasBeenAnalyzed = true; }
+    void setTreeHasBeenAnalyzed(bool analyzed = true) { m_treeHasBeenAnalyzed = analyzed; }
     FunctionNode *findFunctionNodeForTag(const QString &tag, Aggregate *parent = nullptr);
+    void indexFunctionTags(Aggregate *parent);
     FunctionNode *findMacroNode(const QString &t, const Aggregate *parent = nullptr);
 
 private:
@@ -185,6 +186,7 @@ private:
     ExampleNodeMap m_exampleNodeMap {};
     NodeList m_proxies {};
     NodeMap m_dontDocumentMap {};
+    QHash<QString, FunctionNode *> m_functionsByTag {};
 };
 
 QT_END_NAMESPACE
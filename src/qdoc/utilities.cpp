@@ -1,9 +1,14 @@
 // Copyright (C) 2021 The Qt Company Ltd.
 // SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
 
+#include <QtCore/qmutex.h>
 #include <QtCore/qprocess.h>
+#include <QtCore/qset.h>
 #include "utilities.h"
 
+#include <algorithm>
+#include <thread>
+
 QT_BEGIN_NAMESPACE
 
 Q_LOGGING_CATEGORY(lcQdoc, "qt.qdoc")
@@ -176,6 +181,51 @@ QStringList getInternalIncludePaths(const QString &compiler)
     return result;
 }
 
+/*!
+    \internal
+    Returns a string equal to \a string that shares its data with every
+    other string interned with the same text.
+
+    Use this for strings that are stored in many nodes and take few
+    distinct values, such as file paths, versions and module names, so
+    that the tree holds one copy of each. The pool is never shrunk.
+
+    This function is thread-safe.
+ */
+QString intern(const QString &string)
+{
+    if (string.isEmpty())
+        return string;
+    static QMutex mutex;
+    static QSet<QString> pool;
+    QMutexLocker locker(&mutex);
+    const auto it = pool.constFind(string);
+    if (it != pool.cend())
+        return *it;
+    return *pool.insert(string);
+}
+
+/*!
+    \internal
+    Returns the number of threads qdoc runs its parallel work on: the
+    number of hardware threads, or the value of the \c QDOC_THREADS
+    environment variable if that is a positive number.
+
+    With \c {QDOC_THREADS=1}, qdoc runs serially, which is how
+    benchmarks compare it with a parallel run.
+ */
+unsigned int threadCount()
+{
+    static const unsigned int count = [] {
+        bool ok = false;
+        const int value = qEnvironmentVariableIntValue("QDOC_THREADS", &ok);
+        if (ok && value > 0)
+            return unsigned(value);
+        return std::max(std::thread::hardware_concurrency(), 1u);
+    }();
+    return count;
+}
+
 } // namespace Utilities
 
 QT_END_NAMESPACE
@@ -20,6 +20,8 @@ bool debugging();
 QString separator(qsizetype wordPosition, qsizetype numberOfWords);
 QString comma(qsizetype wordPosition, qsizetype numberOfWords);
 QStringList getInternalIncludePaths(const QString &compiler);
+QString intern(const QString &string);
+unsigned int threadCount();
 }
 
 QT_END_NAMESPACE
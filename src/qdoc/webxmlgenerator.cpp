@@ -236,7 +236,7 @@ void WebXMLGenerator::generateDocumentation(Node *node)
     if (node->isInternal() && !m_showInternal)
         return;
 
-    if (node->parent()) {
+    if (node->parent() && isInShard(node)) {
         if (node->isNamespace() || node->isClassNode() || node->isHeader())
             generateCppReferencePage(static_cast<Aggregate *>(node), nullptr);
         else if (node->isCollectionNode()) {
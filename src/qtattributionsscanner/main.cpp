@@ -41,6 +41,16 @@ int main(int argc, char *argv[])
     QCommandLineOption filterOption(QStringLiteral("filter"),
                                     tr("Filter packages according to <filter> (e.g. QDocModule=qtcore)"),
                                     QStringLiteral("expression"));
+    QCommandLineOption excludeOption(QStringLiteral("exclude"),
+                                     tr("Do not scan directories matching <pattern>. A pattern "
+                                        "without a slash matches a directory name at any level, "
+                                        "one with a slash a path relative to the scanned "
+                                        "directory. Can be given multiple times."),
+                                     QStringLiteral("pattern"));
+    QCommandLineOption cacheOption(QStringLiteral("cache"),
+                                   tr("Reuse the results of the previous scan of the same "
+                                      "directory stored in <file>, and store the new ones."),
+                                   QStringLiteral("file"));
     QCommandLineOption baseDirOption(QStringLiteral("basedir"),
                                      tr("Paths in documentation are made relative to this "
                                         "directory."),
@@ -56,6 +66,8 @@ int main(int argc, char *argv[])
     parser.addOption(generatorOption);
     parser.addOption(inputFormatOption);
     parser.addOption(filterOption);
+    parser.addOption(excludeOption);
+    parser.addOption(cacheOption);
     parser.addOption(baseDirOption);
     parser.addOption(outputOption);
     parser.addOption(verboseOption);
@@ -99,7 +111,9 @@ int main(int argc, char *argv[])
         if (logLevel == VerboseLog)
             std::cerr << qPrintable(tr("Recursively scanning %1 for attribution files...").arg(
                                         QDir::toNativeSeparators(path))) << std::endl;
-        packages = Scanner::scanDirectory(path, formats, logLevel);
+        packages = Scanner::scanDirectory(path, formats, logLevel,
+                                          parser.values(excludeOption),
+                                          parser.value(cacheOption));
     } else if (pathInfo.isFile()) {
         packages = Scanner::readFile(path, logLevel);
     } else {
@@ -0,0 +1,103 @@
+// Copyright (C) 2023 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
+
+#include "scancache.h"
+
+#include <QtCore/qdatastream.h>
+#include <QtCore/qfile.h>
+#include <QtCore/qsavefile.h>
+
+// Package is not in the ScanCache namespace, so argument-dependent lookup
+// only finds its operators in the global one.
+static QDataStream &operator<<(QDataStream &out, const Package &p)
+{
+    return out << p.id << p.path << p.files << p.name << p.qdocModule << p.qtUsage << p.qtParts
+               << p.description << p.homepage << p.version << p.downloadLocation
+               << p.license << p.licenseId << p.licenseFiles
+               << p.copyright << p.copyrightFile << p.packageComment;
+}
+
+static QDataStream &operator>>(QDataStream &in, Package &p)
+{
+    return in >> p.id >> p.path >> p.files >> p.name >> p.qdocModule >> p.qtUsage >> p.qtParts
+              >> p.description >> p.homepage >> p.version >> p.downloadLocation
+              >> p.license >> p.licenseId >> p.licenseFiles
+              >> p.copyright >> p.copyrightFile >> p.packageComment;
+}
+
+namespace ScanCache {
+
+static const quint32 Magic = 0x51415343; // "QASC"
+static const quint32 Version = 1;
+
+static QDataStream &operator<<(QDataStream &out, const Directory &d)
+{
+    return out << d.modified << d.subdirectories << d.files;
+}
+
+static QDataStream &operator>>(QDataStream &in, Directory &d)
+{
+    return in >> d.modified >> d.subdirectories >> d.files;
+}
+
+static QDataStream &operator<<(QDataStream &out, const File &f)
+{
+    return out << f.modified << f.size << f.packages
+               << QByteArray::fromStdString(f.messages);
+}
+
+static QDataStream &operator>>(QDataStream &in, File &f)
+{
+    QByteArray messages;
+    in >> f.modified >> f.size >> f.packages >> messages;
+    f.messages = messages.toStdString();
+    return in;
+}
+
+/*
+    Reads the cache from \a fileName. Returns false if there is none or it
+    cannot be used, in which case \a data is left unchanged.
+*/
+bool read(const QString &fileName, Data *data)
+{
+    QFile file(fileName);
+    if (!file.open(QIODevice::ReadOnly))
+        return false;
+
+    QDataStream in(&file);
+    in.setVersion(QDataStream::Qt_6_0);
+    quint32 magic = 0;
+    quint32 version = 0;
+    in >> magic >> version;
+    if (magic != Magic || version != Version)
+        return false;
+
+    Data cached;
+    in >> cached.key >> cached.directories >> cached.files;
+    if (in.status() != QDataStream::Ok)
+        return false;
+
+    *data = std::move(cached);
+    return true;
+}
+
+bool write(const QString &fileName, const Data &data, QString *errorString)
+{
+    QSaveFile file(fileName);
+    if (!file.open(QIODevice::WriteOnly)) {
+        *errorString = file.errorString();
+        return false;
+    }
+
+    QDataStream out(&file);
+    out.setVersion(QDataStream::Qt_6_0);
+    out << Magic << Version << data.key << data.directories << data.files;
+
+    if (!file.commit()) {
+        *errorString = file.errorString();
+        return false;
+    }
+    return true;
+}
+
+} // namespace ScanCache
@@ -0,0 +1,46 @@
+// Copyright (C) 2023 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
+
+#ifndef SCANCACHE_H
+#define SCANCACHE_H
+
+#include "package.h"
+
+#include <QtCore/qhash.h>
+#include <QtCore/qlist.h>
+#include <QtCore/qstring.h>
+#include <QtCore/qstringlist.h>
+
+#include <string>
+
+namespace ScanCache {
+
+// A scanned directory. Its listing is reused while its modification time
+// does not change, as adding or removing an entry updates it.
+struct Directory {
+    qint64 modified = 0; // msecs since the epoch
+    QStringList subdirectories; // not excluded subdirectories
+    QStringList files; // attribution files
+};
+
+// An attribution file, with what reading it resulted in.
+struct File {
+    qint64 modified = 0; // msecs since the epoch
+    qint64 size = 0;
+    QList<Package> packages;
+    std::string messages; // diagnostics printed when reading the file
+};
+
+// The result of scanning a directory, keyed by paths relative to it.
+struct Data {
+    QStringList key; // the scanned directory and the scan options
+    QHash<QString, Directory> directories;
+    QHash<QString, File> files;
+};
+
+bool read(const QString &fileName, Data *data);
+bool write(const QString &fileName, const Data &data, QString *errorString);
+
+} // namespace ScanCache
+
+#endif // SCANCACHE_H
@@ -3,27 +3,36 @@
 
 #include "scanner.h"
 #include "logging.h"
+#include "scancache.h"
 
 #include <QtCore/qdir.h>
 #include <QtCore/qhash.h>
 #include <QtCore/qjsonarray.h>
 #include <QtCore/qjsondocument.h>
 #include <QtCore/qjsonobject.h>
+#include <QtCore/qmutex.h>
+#include <QtCore/qregularexpression.h>
 #include <QtCore/qtextstream.h>
+#include <QtCore/qthreadpool.h>
 #include <QtCore/qvariant.h>
 
+#include <algorithm>
 #include <iostream>
 #include <optional>
+#include <sstream>
+#include <string>
 
 namespace Scanner {
 
-static void missingPropertyWarning(const QString &filePath, const QString &property)
+static void missingPropertyWarning(const QString &filePath, const QString &property,
+                                   std::ostream &err)
 {
-    std::cerr << qPrintable(tr("File %1: Missing mandatory property '%2'.").arg(
-                                QDir::toNativeSeparators(filePath), property)) << std::endl;
+    err << qPrintable(tr("File %1: Missing mandatory property '%2'.").arg(
+                           QDir::toNativeSeparators(filePath), property)) << std::endl;
 }
 
-static void validatePackage(Package &p, const QString &filePath, LogLevel logLevel)
+static void validatePackage(Package &p, const QString &filePath, LogLevel logLevel,
+                            std::ostream &err)
 {
     if (p.qtParts.isEmpty())
         p.qtParts << QStringLiteral("libs");
@@ -33,19 +42,19 @@ static void validatePackage(Package &p, const QString &filePath, LogLevel logLev
             if (p.id.startsWith(QLatin1String("chromium-"))) // Ignore invalid README.chromium files
                 return;
 
-            missingPropertyWarning(filePath, QStringLiteral("Name"));
+            missingPropertyWarning(filePath, QStringLiteral("Name"), err);
         }
 
         if (p.id.isEmpty())
-            missingPropertyWarning(filePath, QStringLiteral("Id"));
+            missingPropertyWarning(filePath, QStringLiteral("Id"), err);
         if (p.license.isEmpty())
-            missingPropertyWarning(filePath, QStringLiteral("License"));
+            missingPropertyWarning(filePath, QStringLiteral("License"), err);
 
         if (!p.copyright.isEmpty() && !p.copyrightFile.isEmpty()) {
-            std::cerr << qPrintable(tr("File %1: Properties 'Copyright' and 'CopyrightFile' are "
-                                       "mutually exclusive.")
-                                            .arg(QDir::toNativeSeparators(filePath)))
-                      << std::endl;
+            err << qPrintable(tr("File %1: Properties 'Copyright' and 'CopyrightFile' are "
+                                  "mutually exclusive.")
+                                       .arg(QDir::toNativeSeparators(filePath)))
+                 << std::endl;
         }
 
         for (const QString &part : qAsConst(p.qtParts)) {
@@ -54,11 +63,11 @@ static void validatePackage(Package &p, const QString &filePath, LogLevel logLev
                     && part != QLatin1String("tools")
                     && part != QLatin1String("libs")
                     && logLevel != SilentLog) {
-                std::cerr << qPrintable(tr("File %1: Property 'QtPart' contains unknown element "
-                                           "'%2'. Valid entries are 'examples', 'tests', 'tools' "
-                                           "and 'libs'.").arg(
-                                            QDir::toNativeSeparators(filePath), part))
-                          << std::endl;
+                err << qPrintable(tr("File %1: Property 'QtPart' contains unknown element "
+                                      "'%2'. Valid entries are 'examples', 'tests', 'tools' "
+                                      "and 'libs'.").arg(
+                                       QDir::toNativeSeparators(filePath), part))
+                     << std::endl;
             }
         }
     }
@@ -78,7 +87,8 @@ static std::optional<QStringList> toStringList(const QJsonValue &value)
 }
 
 // Transforms a JSON object into a Package object
-static Package readPackage(const QJsonObject &object, const QString &filePath, LogLevel logLevel)
+static Package readPackage(const QJsonObject &object, const QString &filePath, LogLevel logLevel,
+                           std::ostream &err)
 {
     Package p;
     const QString directory = QFileInfo(filePath).absolutePath();
@@ -90,8 +100,8 @@ static Package readPackage(const QJsonObject &object, const QString &filePath, L
         if (!iter.value().isString() && key != QLatin1String("QtParts")
             && key != QLatin1String("LicenseFiles")) {
             if (logLevel != SilentLog)
-                std::cerr << qPrintable(tr("File %1: Expected JSON string as value of %2.").arg(
-                                            QDir::toNativeSeparators(filePath), key)) << std::endl;
+                err << qPrintable(tr("File %1: Expected JSON string as value of %2.").arg(
+                                       QDir::toNativeSeparators(filePath), key)) << std::endl;
             continue;
         }
         const QString value = iter.value().toString();
@@ -118,9 +128,9 @@ static Package readPackage(const QJsonObject &object, const QString &filePath, L
         } else if (key == QLatin1String("LicenseFiles")) {
             auto strings = toStringList(iter.value());
             if (!strings && (logLevel != SilentLog))
-                std::cerr << qPrintable(tr("File %1: Expected JSON array of strings in %2.")
-                                                .arg(QDir::toNativeSeparators(filePath), key))
-                          << std::endl;
+                err << qPrintable(tr("File %1: Expected JSON array of strings in %2.")
+                                           .arg(QDir::toNativeSeparators(filePath), key))
+                     << std::endl;
             const QDir dir(directory);
             for (auto iter : strings.value())
                 p.licenseFiles.push_back(dir.absoluteFilePath(iter));
@@ -139,24 +149,25 @@ static Package readPackage(const QJsonObject &object, const QString &filePath, L
         } else if (key == QLatin1String("QtParts")) {
             auto parts = toStringList(iter.value());
             if (!parts && (logLevel != SilentLog))
-                std::cerr << qPrintable(tr("File %1: Expected JSON array of strings in %2.")
-                                                .arg(QDir::toNativeSeparators(filePath), key))
-                          << std::endl;
+                err << qPrintable(tr("File %1: Expected JSON array of strings in %2.")
+                                           .arg(QDir::toNativeSeparators(filePath), key))
+                     << std::endl;
             p.qtParts = parts.value();
         } else {
             if (logLevel != SilentLog)
-                std::cerr << qPrintable(tr("File %1: Unknown key %2.").arg(
-                                            QDir::toNativeSeparators(filePath), key)) << std::endl;
+                err << qPrintable(tr("File %1: Unknown key %2.").arg(
+                                       QDir::toNativeSeparators(filePath), key)) << std::endl;
         }
     }
 
-    validatePackage(p, filePath, logLevel);
+    validatePackage(p, filePath, logLevel, err);
 
     return p;
 }
 
 // Parses a package's details from a README.chromium file
-static Package parseChromiumFile(QFile &file, const QString &filePath, LogLevel logLevel)
+static Package parseChromiumFile(QFile &file, const QString &filePath, LogLevel logLevel,
+                                 std::ostream &err)
 {
     const QString directory = QFileInfo(filePath).absolutePath();
 
@@ -225,24 +236,25 @@ static Package parseChromiumFile(QFile &file, const QString &filePath, LogLevel
             p.licenseFiles = QStringList(entries.at(0).absoluteFilePath());
     }
 
-    validatePackage(p, filePath, logLevel);
+    validatePackage(p, filePath, logLevel, err);
 
     return p;
 }
 
-QList<Package> readFile(const QString &filePath, LogLevel logLevel)
+// Reads the packages of an attribution file, writing diagnostics to \a err
+static QList<Package> readFile(const QString &filePath, LogLevel logLevel, std::ostream &err)
 {
     QList<Package> packages;
 
     if (logLevel == VerboseLog) {
-        std::cerr << qPrintable(tr("Reading file %1...").arg(
-                                    QDir::toNativeSeparators(filePath))) << std::endl;
+        err << qPrintable(tr("Reading file %1...").arg(
+                               QDir::toNativeSeparators(filePath))) << std::endl;
     }
     QFile file(filePath);
     if (!file.open(QIODevice::ReadOnly | QIODevice::Text)) {
         if (logLevel != SilentLog)
-            std::cerr << qPrintable(tr("Could not open file %1.").arg(
-                                        QDir::toNativeSeparators(file.fileName()))) << std::endl;
+            err << qPrintable(tr("Could not open file %1.").arg(
+                                   QDir::toNativeSeparators(file.fileName()))) << std::endl;
         return QList<Package>();
     }
 
@@ -251,52 +263,251 @@ QList<Package> readFile(const QString &filePath, LogLevel logLevel)
         const QJsonDocument document = QJsonDocument::fromJson(file.readAll(), &jsonParseError);
         if (document.isNull()) {
             if (logLevel != SilentLog)
-                std::cerr << qPrintable(tr("Could not parse file %1: %2").arg(
-                                            QDir::toNativeSeparators(file.fileName()),
-                                            jsonParseError.errorString()))
-                          << std::endl;
+                err << qPrintable(tr("Could not parse file %1: %2").arg(
+                                       QDir::toNativeSeparators(file.fileName()),
+                                       jsonParseError.errorString()))
+                     << std::endl;
             return QList<Package>();
         }
 
         if (document.isObject()) {
-            packages << readPackage(document.object(), file.fileName(), logLevel);
+            packages << readPackage(document.object(), file.fileName(), logLevel, err);
         } else if (document.isArray()) {
             QJsonArray array = document.array();
             for (int i = 0, size = array.size(); i < size; ++i) {
                 QJsonValue value = array.at(i);
                 if (value.isObject()) {
-                    packages << readPackage(value.toObject(), file.fileName(), logLevel);
+                    packages << readPackage(value.toObject(), file.fileName(), logLevel, err);
                 } else {
                     if (logLevel != SilentLog)
-                        std::cerr << qPrintable(tr("File %1: Expecting JSON object in array.")
-                                        .arg(QDir::toNativeSeparators(file.fileName())))
-                                  << std::endl;
+                        err << qPrintable(tr("File %1: Expecting JSON object in array.")
+                                   .arg(QDir::toNativeSeparators(file.fileName())))
+                             << std::endl;
                 }
             }
         } else {
             if (logLevel != SilentLog)
-                std::cerr << qPrintable(tr("File %1: Expecting JSON object in array.").arg(
-                                            QDir::toNativeSeparators(file.fileName()))) << std::endl;
+                err << qPrintable(tr("File %1: Expecting JSON object in array.").arg(
+                                       QDir::toNativeSeparators(file.fileName()))) << std::endl;
         }
     } else if (filePath.endsWith(QLatin1String(".chromium"))) {
-        Package chromiumPackage = parseChromiumFile(file, filePath, logLevel);
+        Package chromiumPackage = parseChromiumFile(file, filePath, logLevel, err);
         if (!chromiumPackage.name.isEmpty()) // Skip invalid README.chromium files
             packages << chromiumPackage;
     } else {
         if (logLevel != SilentLog)
-            std::cerr << qPrintable(tr("File %1: Unsupported file type.")
-                            .arg(QDir::toNativeSeparators(file.fileName())))
-                      << std::endl;
+            err << qPrintable(tr("File %1: Unsupported file type.")
+                       .arg(QDir::toNativeSeparators(file.fileName())))
+                 << std::endl;
     }
 
     return packages;
 }
 
-QList<Package> scanDirectory(const QString &directory, InputFormats inputFormats, LogLevel logLevel)
+QList<Package> readFile(const QString &filePath, LogLevel logLevel)
 {
-    QDir dir(directory);
-    QList<Package> packages;
+    return readFile(filePath, logLevel, std::cerr);
+}
+
+namespace {
+
+// An attribution file found while scanning, together with the packages and
+// the diagnostics of reading it.
+struct ScanResult
+{
+    QStringList components; // relative path, used to restore the sequential order
+    ScanCache::File file;
+};
+
+static qint64 modificationTime(const QFileInfo &info)
+{
+    return info.fileTime(QFileDevice::FileModificationTime).toMSecsSinceEpoch();
+}
+
+/*
+    Walks a directory tree on a thread pool. Every directory is listed by a
+    task of its own, which queues a task for each subdirectory and reads the
+    attribution files it finds, so that all threads stay busy while the tree
+    is wider than the pool.
+
+    With the data of a previous scan, directories are only listed again if
+    they were modified since, and files are only read again if they were
+    modified or their directory was.
+*/
+class DirectoryWalker
+{
+public:
+    DirectoryWalker(const QStringList &nameFilters, const QStringList &excludePatterns,
+                    LogLevel logLevel, const ScanCache::Data *previous);
+
+    QList<ScanResult> walk(const QString &directory);
+    QHash<QString, ScanCache::Directory> directories() const { return m_directories; }
+
+private:
+    void scan(const QString &directory, const QStringList &components);
+    bool isExcluded(const QString &name, const QStringList &components) const;
+    ScanCache::File readCached(const QString &filePath, const QString &relativePath,
+                               bool directoryUnchanged) const;
+
+    QThreadPool m_pool;
+    QMutex m_mutex;
+    QList<ScanResult> m_results;
+    QHash<QString, ScanCache::Directory> m_directories;
+    const ScanCache::Data *m_previous;
+    const QStringList m_nameFilters;
+    QList<QRegularExpression> m_namePatterns; // match the directory name
+    QList<QRegularExpression> m_pathPatterns; // match the path relative to the scanned directory
+    const LogLevel m_logLevel;
+};
+
+DirectoryWalker::DirectoryWalker(const QStringList &nameFilters,
+                                 const QStringList &excludePatterns, LogLevel logLevel,
+                                 const ScanCache::Data *previous)
+    : m_previous(previous), m_nameFilters(nameFilters), m_logLevel(logLevel)
+{
+    // Like in .gitignore, a pattern without a slash matches a directory at
+    // any level, and a pattern with one is relative to the scanned directory.
+    for (QString pattern : excludePatterns) {
+        while (pattern.endsWith(QLatin1Char('/')))
+            pattern.chop(1);
+        if (pattern.isEmpty())
+            continue;
+        if (pattern.contains(QLatin1Char('/'))) {
+            if (pattern.startsWith(QLatin1Char('/')))
+                pattern.remove(0, 1);
+            m_pathPatterns.append(QRegularExpression::fromWildcard(pattern, Qt::CaseSensitive));
+        } else {
+            m_namePatterns.append(QRegularExpression::fromWildcard(pattern, Qt::CaseSensitive));
+        }
+    }
+}
+
+bool DirectoryWalker::isExcluded(const QString &name, const QStringList &components) const
+{
+    for (const QRegularExpression &pattern : m_namePatterns) {
+        if (pattern.match(name).hasMatch())
+            return true;
+    }
+    if (m_pathPatterns.isEmpty())
+        return false;
+    const QString relativePath = components.join(QLatin1Char('/'));
+    for (const QRegularExpression &pattern : m_pathPatterns) {
+        if (pattern.match(relativePath).hasMatch())
+            return true;
+    }
+    return false;
+}
+
+QList<ScanResult> DirectoryWalker::walk(const QString &directory)
+{
+    m_pool.start([this, directory] { scan(directory, QStringList()); });
+    m_pool.waitForDone();
+    return std::move(m_results);
+}
 
+void DirectoryWalker::scan(const QString &directory, const QStringList &components)
+{
+    const QString relativePath = components.join(QLatin1Char('/'));
+    const QDir dir(directory);
+
+    ScanCache::Directory entry;
+    entry.modified = modificationTime(QFileInfo(directory));
+    bool unchanged = false;
+    if (m_previous) {
+        const auto cached = m_previous->directories.constFind(relativePath);
+        unchanged = cached != m_previous->directories.cend() && entry.modified != 0
+                && cached->modified == entry.modified;
+        if (unchanged)
+            entry = cached.value();
+    }
+
+    if (!unchanged) {
+        QDir listing(dir);
+        listing.setNameFilters(m_nameFilters);
+        listing.setFilter(QDir::AllDirs | QDir::NoDotAndDotDot | QDir::Files);
+        listing.setSorting(QDir::Unsorted);
+
+        const QFileInfoList entries = listing.entryInfoList();
+        for (const QFileInfo &info : entries) {
+            const QString name = info.fileName();
+            if (info.isDir()) {
+                if (!isExcluded(name, components + QStringList(name)))
+                    entry.subdirectories.append(name);
+            } else {
+                entry.files.append(name);
+            }
+        }
+    }
+
+    for (const QString &name : std::as_const(entry.subdirectories)) {
+        const QStringList entryComponents = components + QStringList(name);
+        m_pool.start([this, path = dir.filePath(name), entryComponents] {
+            scan(path, entryComponents);
+        });
+    }
+
+    QList<ScanResult> results;
+    for (const QString &name : std::as_const(entry.files)) {
+        ScanResult result;
+        result.components = components + QStringList(name);
+        result.file = readCached(dir.filePath(name), result.components.join(QLatin1Char('/')),
+                                 unchanged);
+        results.append(std::move(result));
+    }
+
+    QMutexLocker locker(&m_mutex);
+    m_results += std::move(results);
+    m_directories.insert(relativePath, std::move(entry));
+}
+
+ScanCache::File DirectoryWalker::readCached(const QString &filePath,
+                                            const QString &relativePath,
+                                            bool directoryUnchanged) const
+{
+    const QFileInfo info(filePath);
+    ScanCache::File file;
+    file.modified = modificationTime(info);
+    file.size = info.size();
+
+    // README.chromium files refer to license files found next to them, so
+    // their packages are only valid while the directory is unchanged.
+    if (directoryUnchanged) {
+        const auto cached = m_previous->files.constFind(relativePath);
+        if (cached != m_previous->files.cend() && file.modified != 0
+                && cached->modified == file.modified && cached->size == file.size) {
+            return cached.value();
+        }
+    }
+
+    std::ostringstream messages;
+    file.packages = readFile(filePath, m_logLevel, messages);
+    file.messages = messages.str();
+    return file;
+}
+
+// Orders paths like a depth-first walk listing each directory sorted by name
+// (QDir::Name | QDir::IgnoreCase) would.
+static bool scanOrder(const ScanResult &a, const ScanResult &b)
+{
+    const qsizetype count = qMin(a.components.size(), b.components.size());
+    for (qsizetype i = 0; i < count; ++i) {
+        const QString &first = a.components.at(i);
+        const QString &second = b.components.at(i);
+        int r = first.compare(second, Qt::CaseInsensitive);
+        if (r == 0)
+            r = first.compare(second);
+        if (r != 0)
+            return r < 0;
+    }
+    return a.components.size() < b.components.size();
+}
+
+} // unnamed namespace
+
+QList<Package> scanDirectory(const QString &directory, InputFormats inputFormats,
+                             LogLevel logLevel, const QStringList &excludePatterns,
+                             const QString &cacheFile)
+{
     QStringList nameFilters = QStringList();
     if (inputFormats & InputFormat::QtAttributions)
         nameFilters << QStringLiteral("qt_attribution.json");
@@ -308,15 +519,49 @@ QList<Package> scanDirectory(const QString &directory, InputFormats inputFormats
                 << QStringLiteral("README_test.chromium");
     }
 
-    dir.setNameFilters(nameFilters);
-    dir.setFilter(QDir::AllDirs | QDir::NoDotAndDotDot | QDir::Files);
+    // The cached results are only valid for the same scan
+    ScanCache::Data cache;
+    cache.key << QDir(directory).absolutePath() << QString::number(logLevel)
+              << nameFilters.join(QLatin1Char(',')) << excludePatterns;
+
+    ScanCache::Data previous;
+    bool usePrevious = false;
+    if (!cacheFile.isEmpty()) {
+        usePrevious = ScanCache::read(cacheFile, &previous) && previous.key == cache.key;
+        if (logLevel == VerboseLog) {
+            std::cerr << qPrintable(usePrevious
+                                    ? tr("Using cached scan results from %1.")
+                                              .arg(QDir::toNativeSeparators(cacheFile))
+                                    : tr("No usable cached scan results in %1.")
+                                              .arg(QDir::toNativeSeparators(cacheFile)))
+                      << std::endl;
+        }
+    }
 
-    const QFileInfoList entries = dir.entryInfoList();
-    for (const QFileInfo &info : entries) {
-        if (info.isDir()) {
-            packages += scanDirectory(info.filePath(), inputFormats, logLevel);
-        } else {
-            packages += readFile(info.filePath(), logLevel);
+    DirectoryWalker walker(nameFilters, excludePatterns, logLevel,
+                           usePrevious ? &previous : nullptr);
+    QList<ScanResult> results = walker.walk(directory);
+
+    // Report in the order of a sequential scan, so that the output does not
+    // depend on the scheduling.
+    std::sort(results.begin(), results.end(), scanOrder);
+
+    QList<Package> packages;
+    for (const ScanResult &result : std::as_const(results)) {
+        std::cerr << result.file.messages;
+        packages += result.file.packages;
+    }
+
+    if (!cacheFile.isEmpty()) {
+        cache.directories = walker.directories();
+        for (ScanResult &result : results)
+            cache.files.insert(result.components.join(QLatin1Char('/')), std::move(result.file));
+        QString errorString;
+        if (!ScanCache::write(cacheFile, cache, &errorString) && logLevel != SilentLog) {
+            std::cerr << qPrintable(tr("Cannot write cache file %1: %2")
+                                            .arg(QDir::toNativeSeparators(cacheFile),
+                                                 errorString))
+                      << std::endl;
         }
     }
 
@@ -9,6 +9,7 @@
 
 #include <QtCore/qstring.h>
 #include <QtCore/qlist.h>
+#include <QtCore/qstringlist.h>
 
 namespace Scanner {
 
@@ -20,7 +21,9 @@ Q_DECLARE_FLAGS(InputFormats, InputFormat)
 Q_DECLARE_OPERATORS_FOR_FLAGS(InputFormats)
 
 QList<Package> readFile(const QString &filePath, LogLevel logLevel);
-QList<Package> scanDirectory(const QString &directory, InputFormats inputFormats, LogLevel logLevel);
+QList<Package> scanDirectory(const QString &directory, InputFormats inputFormats,
+                             LogLevel logLevel, const QStringList &excludePatterns = {},
+                             const QString &cacheFile = QString());
 
 }
 
@@ -26,12 +26,14 @@ int main(int argc, char **argv)
     const QCommandLineOption fontOption(QStringLiteral("fonts"), QStringLiteral("Output list of fonts"));
     const QCommandLineOption noVkOption(QStringLiteral("no-vulkan"), QStringLiteral("Do not output Vulkan information"));
     const QCommandLineOption noRhiOption(QStringLiteral("no-rhi"), QStringLiteral("Do not output RHI information"));
+    const QCommandLineOption benchOption(QStringLiteral("bench"), QStringLiteral("Output the startup times of fonts, GL and RHI backends as JSON"));
     commandLineParser.setApplicationDescription(QStringLiteral("Prints diagnostic output about the Qt library."));
     commandLineParser.addOption(noGlOption);
     commandLineParser.addOption(glExtensionOption);
     commandLineParser.addOption(fontOption);
     commandLineParser.addOption(noVkOption);
     commandLineParser.addOption(noRhiOption);
+    commandLineParser.addOption(benchOption);
     commandLineParser.addHelpOption();
     commandLineParser.process(app);
     unsigned flags = commandLineParser.isSet(noGlOption) ? 0u : unsigned(QtDiagGl);
@@ -44,6 +46,12 @@ int main(int argc, char **argv)
     if (!commandLineParser.isSet(noRhiOption))
         flags |= QtDiagRhi;
 
+    if (commandLineParser.isSet(benchOption)) {
+        std::cout << qtDiagBench(flags).toStdString();
+        std::cout.flush();
+        return 0;
+    }
+
     std::wcout << qtDiag(flags).toStdWString();
     std::wcout.flush();
     return 0;
@@ -41,6 +41,10 @@
 #include <QtCore/QFileSelector>
 #include <QtCore/QDebug>
 #include <QtCore/QVersionNumber>
+#include <QtCore/QElapsedTimer>
+#include <QtCore/QJsonArray>
+#include <QtCore/QJsonDocument>
+#include <QtCore/QJsonObject>
 
 #include <private/qsimd_p.h>
 #include <private/qguiapplication_p.h>
@@ -71,6 +75,7 @@
 #endif
 
 #include <algorithm>
+#include <functional>
 
 QT_BEGIN_NAMESPACE
 
@@ -382,15 +387,17 @@ void dumpRhiBackendInfo(QTextStream &str, const char *name, QRhi::Implementation
     }
 }
 
-void dumpRhiInfo(QTextStream &str)
-{
-    str << "Qt Rendering Hardware Interface supported backends:\n";
+using RhiBackendFunction = std::function<void(const char *name, QRhi::Implementation impl,
+                                               QRhiInitParams *initParams)>;
 
+// Calls \a f with the init parameters of each backend supported on the platform.
+static void forEachRhiBackend(const RhiBackendFunction &f)
+{
 #if QT_CONFIG(opengl)
     {
         QRhiGles2InitParams params;
         params.fallbackSurface = QRhiGles2InitParams::newFallbackSurface();
-        dumpRhiBackendInfo(str, "OpenGL (with default QSurfaceFormat)", QRhi::OpenGLES2, &params);
+        f("OpenGL (with default QSurfaceFormat)", QRhi::OpenGLES2, &params);
         delete params.fallbackSurface;
     }
 #endif
@@ -401,7 +408,7 @@ void dumpRhiInfo(QTextStream &str)
         vulkanInstance.create();
         QRhiVulkanInitParams params;
         params.inst = &vulkanInstance;
-        dumpRhiBackendInfo(str, "Vulkan", QRhi::Vulkan, &params);
+        f("Vulkan", QRhi::Vulkan, &params);
         vulkanInstance.destroy();
     }
 #endif
@@ -409,18 +416,119 @@ void dumpRhiInfo(QTextStream &str)
 #ifdef Q_OS_WIN
     {
         QRhiD3D11InitParams params;
-        dumpRhiBackendInfo(str, "Direct3D 11", QRhi::D3D11, &params);
+        f("Direct3D 11", QRhi::D3D11, &params);
     }
 #endif
 
 #if defined(Q_OS_MACOS) || defined(Q_OS_IOS)
     {
         QRhiMetalInitParams params;
-        dumpRhiBackendInfo(str, "Metal", QRhi::Metal, &params);
+        f("Metal", QRhi::Metal, &params);
     }
 #endif
 }
 
+void dumpRhiInfo(QTextStream &str)
+{
+    str << "Qt Rendering Hardware Interface supported backends:\n";
+    forEachRhiBackend([&str](const char *name, QRhi::Implementation impl, QRhiInitParams *initParams) {
+        dumpRhiBackendInfo(str, name, impl, initParams);
+    });
+}
+
+static double elapsedMs(const QElapsedTimer &timer)
+{
+    return double(timer.nsecsElapsed()) / 1000000.0;
+}
+
+static QJsonObject benchFonts()
+{
+    QElapsedTimer timer;
+    timer.start();
+    const QStringList families = QFontDatabase::families();
+    QJsonObject result;
+    result.insert(QStringLiteral("populateMs"), elapsedMs(timer));
+    result.insert(QStringLiteral("families"), families.size());
+    return result;
+}
+
+#ifndef QT_NO_OPENGL
+static QJsonObject benchGl()
+{
+    QJsonObject result;
+    QElapsedTimer timer;
+    timer.start();
+    QOpenGLContext context;
+    const bool created = context.create();
+    result.insert(QStringLiteral("contextCreateMs"), elapsedMs(timer));
+    result.insert(QStringLiteral("created"), created);
+    if (!created)
+        return result;
+
+    QOffscreenSurface surface;
+    surface.setFormat(context.format());
+    surface.create();
+    timer.restart();
+    const bool current = context.makeCurrent(&surface);
+    result.insert(QStringLiteral("makeCurrentMs"), elapsedMs(timer));
+    if (current) {
+        timer.restart();
+        context.functions()->glFinish();
+        result.insert(QStringLiteral("firstFinishMs"), elapsedMs(timer));
+        context.doneCurrent();
+    }
+    return result;
+}
+#endif // !QT_NO_OPENGL
+
+static QJsonObject benchRhiBackend(const char *name, QRhi::Implementation impl, QRhiInitParams *initParams)
+{
+    QJsonObject result;
+    result.insert(QStringLiteral("backend"), QString::fromLatin1(name));
+    QElapsedTimer timer;
+    timer.start();
+    QScopedPointer<QRhi> rhi(QRhi::create(impl, initParams, QRhi::Flags(), nullptr));
+    result.insert(QStringLiteral("initMs"), elapsedMs(timer));
+    result.insert(QStringLiteral("created"), !rhi.isNull());
+    if (!rhi)
+        return result;
+
+    result.insert(QStringLiteral("device"), QString::fromUtf8(rhi->driverInfo().deviceName));
+    // An offscreen frame is submitted and waited for like the first frame
+    // of a window, without presenting it.
+    QRhiCommandBuffer *cb = nullptr;
+    timer.restart();
+    if (rhi->beginOffscreenFrame(&cb) == QRhi::FrameOpSuccess
+        && rhi->endOffscreenFrame() == QRhi::FrameOpSuccess) {
+        result.insert(QStringLiteral("firstFrameMs"), elapsedMs(timer));
+    }
+    return result;
+}
+
+QString qtDiagBench(unsigned flags)
+{
+    QJsonObject result;
+    result.insert(QStringLiteral("qtVersion"), QString::fromLatin1(qVersion()));
+    result.insert(QStringLiteral("platform"), QGuiApplication::platformName());
+    // First, as the graphics backends may use fonts.
+    result.insert(QStringLiteral("fonts"), benchFonts());
+
+#ifndef QT_NO_OPENGL
+    if (flags & QtDiagGl)
+        result.insert(QStringLiteral("gl"), benchGl());
+#endif // !QT_NO_OPENGL
+
+    if (flags & QtDiagRhi) {
+        QJsonArray rhi;
+        forEachRhiBackend([&rhi](const char *name, QRhi::Implementation impl, QRhiInitParams *initParams) {
+            rhi.append(benchRhiBackend(name, impl, initParams));
+        });
+        result.insert(QStringLiteral("rhi"), rhi);
+    }
+
+    return QString::fromUtf8(QJsonDocument(result).toJson());
+}
+
 #define DUMP_CAPABILITY(str, integration, capability) \
     if (platformIntegration->hasCapability(QPlatformIntegration::capability)) \
         str << ' ' << #capability;
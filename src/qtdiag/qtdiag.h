@@ -17,6 +17,8 @@ enum QtDiagFlags {
 };
 
 QString qtDiag(unsigned flags = 0);
+// Times the startup of the font database and the graphics backends, as JSON
+QString qtDiagBench(unsigned flags = 0);
 
 QT_END_NAMESPACE
 
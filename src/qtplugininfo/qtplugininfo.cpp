@@ -5,12 +5,16 @@
 #include <QCommandLineParser>
 #include <QCoreApplication>
 #include <QDir>
+#include <QDirIterator>
 #include <QFile>
+#include <QFileInfo>
+#include <QJsonArray>
 #include <QJsonDocument>
 #include <QJsonObject>
 #include <QLibrary>
 #include <QPluginLoader>
 #include <QStringList>
+#include <QThreadPool>
 
 #include <iostream>
 
@@ -23,6 +27,71 @@ enum PrintOption {
 Q_DECLARE_FLAGS(PrintOptions, PrintOption)
 Q_DECLARE_OPERATORS_FOR_FLAGS(PrintOptions)
 
+struct PluginInfo
+{
+    QString fileName;
+    QJsonObject metaData;
+    QString error; // why the plug-in was rejected
+};
+
+// Replaces the directories by the libraries found in them.
+static QStringList pluginFiles(const QStringList &arguments)
+{
+    QStringList files;
+    for (const QString &argument : arguments) {
+        if (!QFileInfo(argument).isDir()) {
+            files.append(argument);
+            continue;
+        }
+        QStringList directoryFiles;
+        QDirIterator it(argument, QDir::Files, QDirIterator::Subdirectories);
+        while (it.hasNext()) {
+            const QString file = it.next();
+            if (QLibrary::isLibrary(file))
+                directoryFiles.append(file);
+        }
+        directoryFiles.sort();
+        files += directoryFiles;
+    }
+    return files;
+}
+
+static void readPluginInfo(PluginInfo *info)
+{
+    if (!QFile::exists(info->fileName)) {
+        info->error = QStringLiteral("No such file or directory.");
+        return;
+    }
+    if (!QLibrary::isLibrary(info->fileName)) {
+        info->error = QStringLiteral("Not a plug-in.");
+        return;
+    }
+
+    // The meta-data is read from the file, the library is not loaded.
+    QPluginLoader loader(info->fileName);
+    info->metaData = loader.metaData();
+    if (info->metaData.isEmpty()) {
+        info->error = QStringLiteral("No plug-in meta-data found: ") + loader.errorString();
+        return;
+    }
+
+    const int version = info->metaData.value("version").toInt();
+    if ((version >> 16) != (QT_VERSION >> 16)) {
+        info->error = QStringLiteral("Qt version mismatch - got major version %1, expected %2")
+                              .arg(version >> 16).arg(QT_VERSION >> 16);
+        return;
+    }
+    QString missing;
+    if (info->metaData.value("IID").toString().isEmpty())
+        missing += QStringLiteral(" iid");
+    if (info->metaData.value("className").toString().isEmpty())
+        missing += QStringLiteral(" className");
+    if (info->metaData.value("debug").isNull())
+        missing += QStringLiteral(" debug");
+    if (!missing.isEmpty())
+        info->error = QStringLiteral("invalid metadata, missing required fields:") + missing;
+}
+
 int main(int argc, char** argv)
 {
     QCoreApplication app(argc, argv);
@@ -35,6 +104,8 @@ int main(int argc, char** argv)
                                         QStringLiteral("Print JSON data as: indented, compact"), QStringLiteral("format"));
     QCommandLineOption fullJsonOption("full-json",
                                       QStringLiteral("Print the plugin metadata in JSON format"));
+    QCommandLineOption jsonReportOption("json-report",
+                                        QStringLiteral("Print the metadata or error of all plug-ins as one JSON array"));
     QCommandLineOption printOption(QStringList() << "p" << QStringLiteral("print"),
                                    QStringLiteral("Print detail (iid, classname, qtinfo, userdata)"), QStringLiteral("detail"));
     jsonFormatOption.setDefaultValue(QStringLiteral("indented"));
@@ -42,10 +113,11 @@ int main(int argc, char** argv)
 
     parser.addOption(fullJsonOption);
     parser.addOption(jsonFormatOption);
+    parser.addOption(jsonReportOption);
     parser.addOption(printOption);
     parser.addHelpOption();
     parser.addVersionOption();
-    parser.addPositionalArgument(QStringLiteral("plugin"), QStringLiteral("Plug-in of which to read the meta data."), QStringLiteral("<plugin>"));
+    parser.addPositionalArgument(QStringLiteral("plugin"), QStringLiteral("Plug-in of which to read the meta data, or directory to scan for plug-ins."), QStringLiteral("<plugin>"));
     parser.process(app);
 
     if (parser.positionalArguments().isEmpty())
@@ -64,57 +136,57 @@ int main(int argc, char** argv)
     if (printOptionList.contains("userdata"))
         print |= PrintUserData;
 
+    const QStringList plugins = pluginFiles(parser.positionalArguments());
+    QList<PluginInfo> infos(plugins.size());
+    PluginInfo *infoData = infos.data();
+    for (qsizetype i = 0, size = plugins.size(); i < size; ++i)
+        infoData[i].fileName = plugins.at(i);
+    if (plugins.size() > 1) {
+        QThreadPool pool;
+        for (qsizetype i = 0, size = plugins.size(); i < size; ++i)
+            pool.start([infoData, i] { readPluginInfo(infoData + i); });
+        pool.waitForDone();
+    } else if (!plugins.isEmpty()) {
+        readPluginInfo(infoData);
+    }
+
     int retval = 0;
-    const QStringList positionalArguments = parser.positionalArguments();
-    for (const QString &plugin : positionalArguments) {
-        QByteArray pluginNativeName = QFile::encodeName(QDir::toNativeSeparators(plugin));
-        if (!QFile::exists(plugin)) {
-            std::cerr << "qtplugininfo: " << pluginNativeName.constData() << ": No such file or directory." << std::endl;
-            retval = 1;
-            continue;
-        }
-        if (!QLibrary::isLibrary(plugin)) {
-            std::cerr << "qtplugininfo: " << pluginNativeName.constData() << ": Not a plug-in." << std::endl;
-            retval = 1;
-            continue;
+    if (parser.isSet(jsonReportOption)) {
+        QJsonArray report;
+        for (const PluginInfo &info : std::as_const(infos)) {
+            QJsonObject entry;
+            entry.insert("file", QDir::toNativeSeparators(info.fileName));
+            if (info.error.isEmpty()) {
+                entry.insert("metaData", info.metaData);
+            } else {
+                entry.insert("error", info.error);
+                retval = 1;
+            }
+            report.append(entry);
         }
+        std::cout << QJsonDocument(report).toJson(jsonFormat).constData();
+        if (jsonFormat == QJsonDocument::Compact)
+            std::cout << std::endl;
+        return retval;
+    }
 
-        QPluginLoader loader(plugin);
-        QJsonObject metaData = loader.metaData();
-        if (metaData.isEmpty()) {
-            std::cerr << "qtplugininfo: " << pluginNativeName.constData() << ": No plug-in meta-data found: "
-                      << qPrintable(loader.errorString()) << std::endl;
+    for (const PluginInfo &info : std::as_const(infos)) {
+        QByteArray pluginNativeName = QFile::encodeName(QDir::toNativeSeparators(info.fileName));
+        if (!info.error.isEmpty()) {
+            std::cerr << "qtplugininfo: " << pluginNativeName.constData() << ": "
+                      << qPrintable(info.error) << std::endl;
             retval = 1;
             continue;
         }
 
+        const QJsonObject &metaData = info.metaData;
         QString iid = metaData.value("IID").toString();
         QString className = metaData.value("className").toString();
         QJsonValue debug = metaData.value("debug");
         int version = metaData.value("version").toInt();
         QJsonValue userData = metaData.value("MetaData");
 
-        if ((version >> 16) != (QT_VERSION >> 16)) {
-            std::cerr << "qtplugininfo: " << pluginNativeName.constData()
-                      << ": Qt version mismatch - got major version " << (version >> 16)
-                      << ", expected " << (QT_VERSION >> 16) << std::endl;
-            retval = 1;
-            continue;
-        }
-        if (iid.isEmpty() || className.isEmpty() || debug.isNull()) {
-            std::cerr << "qtplugininfo: " << pluginNativeName.constData() << ": invalid metadata, missing required fields:";
-            if (iid.isEmpty())
-                std::cerr << " iid";
-            if (className.isEmpty())
-                std::cerr << " className";
-            if (debug.isNull())
-                std::cerr << " debug";
-            std::cerr << std::endl;
-            retval = 1;
-            continue;
-        }
-
-        if (parser.positionalArguments().size() != 1)
+        if (infos.size() != 1)
             std::cout << pluginNativeName.constData() << ": ";
         if (fullJson) {
             std::cout << QJsonDocument(metaData).toJson(jsonFormat).constData();
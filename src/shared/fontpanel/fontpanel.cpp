@@ -9,10 +9,89 @@
 #include <QtWidgets/QSpacerItem>
 #include <QtWidgets/QFontComboBox>
 #include <QtCore/QTimer>
+#include <QtCore/QHash>
 #include <QtWidgets/QLineEdit>
+#include <QtGui/QGuiApplication>
+
+#include <utility>
 
 QT_BEGIN_NAMESPACE
 
+namespace {
+// The tables of the font database shown by the panels. Querying them is
+// slow with many fonts installed, so they are kept until the database
+// changes, for example when application fonts are added.
+class FontDatabaseCache
+{
+    Q_DISABLE_COPY_MOVE(FontDatabaseCache)
+public:
+    static FontDatabaseCache &instance();
+
+    const QList<QFontDatabase::WritingSystem> &writingSystems();
+    const QStringList &styles(const QString &family);
+    const QList<int> &pointSizes(const QString &family, const QString &style);
+
+private:
+    FontDatabaseCache();
+    void clear();
+
+    bool m_hasWritingSystems = false;
+    QList<QFontDatabase::WritingSystem> m_writingSystems;
+    QHash<QString, QStringList> m_styles;
+    QHash<std::pair<QString, QString>, QList<int>> m_pointSizes;
+};
+
+FontDatabaseCache::FontDatabaseCache()
+{
+    QObject::connect(qGuiApp, &QGuiApplication::fontDatabaseChanged,
+                     qGuiApp, [this] { clear(); });
+}
+
+FontDatabaseCache &FontDatabaseCache::instance()
+{
+    static FontDatabaseCache rc;
+    return rc;
+}
+
+void FontDatabaseCache::clear()
+{
+    m_hasWritingSystems = false;
+    m_writingSystems.clear();
+    m_styles.clear();
+    m_pointSizes.clear();
+}
+
+const QList<QFontDatabase::WritingSystem> &FontDatabaseCache::writingSystems()
+{
+    if (!m_hasWritingSystems) {
+        m_writingSystems = QFontDatabase::writingSystems();
+        m_hasWritingSystems = true;
+    }
+    return m_writingSystems;
+}
+
+const QStringList &FontDatabaseCache::styles(const QString &family)
+{
+    auto it = m_styles.find(family);
+    if (it == m_styles.end())
+        it = m_styles.insert(family, QFontDatabase::styles(family));
+    return it.value();
+}
+
+const QList<int> &FontDatabaseCache::pointSizes(const QString &family, const QString &style)
+{
+    const std::pair<QString, QString> key(family, style);
+    auto it = m_pointSizes.find(key);
+    if (it == m_pointSizes.end()) {
+        auto sizes = QFontDatabase::pointSizes(family, style);
+        if (sizes.isEmpty())
+            sizes = QFontDatabase::standardSizes();
+        it = m_pointSizes.insert(key, sizes);
+    }
+    return it.value();
+}
+} // namespace
+
 FontPanel::FontPanel(QWidget *parentWidget) :
     QGroupBox(parentWidget),
     m_previewLineEdit(new QLineEdit),
@@ -28,9 +107,9 @@ FontPanel::FontPanel(QWidget *parentWidget) :
     // writing systems
     m_writingSystemComboBox->setEditable(false);
 
-    auto writingSystems = QFontDatabase::writingSystems();
-    writingSystems.push_front(QFontDatabase::Any);
-    for (QFontDatabase::WritingSystem ws : qAsConst(writingSystems))
+    m_writingSystemComboBox->addItem(QFontDatabase::writingSystemName(QFontDatabase::Any),
+                                     QVariant(QFontDatabase::Any));
+    for (QFontDatabase::WritingSystem ws : FontDatabaseCache::instance().writingSystems())
         m_writingSystemComboBox->addItem(QFontDatabase::writingSystemName(ws), QVariant(ws));
     connect(m_writingSystemComboBox, &QComboBox::currentIndexChanged,
             this, &FontPanel::slotWritingSystemChanged);
@@ -172,7 +251,7 @@ void FontPanel::updateFamily(const QString &family)
     // Try to maintain selection or select normal
     const QString &oldStyleString = styleString();
 
-    const QStringList &styles = QFontDatabase::styles(family);
+    const QStringList styles = FontDatabaseCache::instance().styles(family);
     const bool hasStyles = !styles.isEmpty();
 
     m_styleComboBox->setCurrentIndex(-1);
@@ -229,9 +308,7 @@ void FontPanel::updatePointSizes(const QString &family, const QString &styleStri
 {
     const int oldPointSize = pointSize();
 
-    auto pointSizes =  QFontDatabase::pointSizes(family, styleString);
-    if (pointSizes.isEmpty())
-        pointSizes = QFontDatabase::standardSizes();
+    const QList<int> pointSizes = FontDatabaseCache::instance().pointSizes(family, styleString);
 
     const bool hasSizes = !pointSizes.isEmpty();
     m_pointSizeComboBox->clear();
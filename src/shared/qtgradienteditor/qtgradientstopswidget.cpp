@@ -8,6 +8,7 @@
 #include <QtCore/QMimeData>
 #include <QtGui/QImage>
 #include <QtGui/QPainter>
+#include <QtGui/QPixmap>
 #include <QtWidgets/QScrollBar>
 #include <QtGui/QMouseEvent>
 #include <QtWidgets/QRubberBand>
@@ -49,6 +50,9 @@ public:
     void ensureVisible(double x); // x = stop position
     void ensureVisible(QtGradientStop *stop);
     QtGradientStop *newStop(const QPoint &viewportPos);
+    QRect handleRect(QtGradientStop *stop) const;
+    const QPixmap &gradientPixmap(QtGradientStopsModel *model);
+    void invalidateGradient() { m_gradientPixmap = QPixmap(); }
 
     bool m_backgroundCheckered;
     QtGradientStopsModel *m_model;
@@ -79,6 +83,14 @@ public:
     StopPositionMap m_moveStops;
 
     PositionColorMap m_moveOriginal;
+
+    // The background and the gradient of the visible part of the model, at
+    // the device pixel ratio of the viewport. The handles are painted on top
+    // of it, so that selecting stops does not render the gradient again.
+    QPixmap m_gradientPixmap;
+    QtGradientStopsModel *m_gradientModel = nullptr;
+    int m_gradientScrollValue = 0;
+    int m_gradientScrollMaximum = 0;
 };
 
 void QtGradientStopsWidgetPrivate::setGradientStopsModel(QtGradientStopsModel *model)
@@ -106,6 +118,7 @@ void QtGradientStopsWidgetPrivate::setGradientStopsModel(QtGradientStopsModel *m
     }
 
     m_model = model;
+    invalidateGradient();
 
     if (m_model) {
         connect(m_model, &QtGradientStopsModel::stopAdded,
@@ -244,15 +257,90 @@ QtGradientStop *QtGradientStopsWidgetPrivate::newStop(const QPoint &viewportPos)
     return stop;
 }
 
+QRect QtGradientStopsWidgetPrivate::handleRect(QtGradientStop *stop) const
+{
+    const QSize size = q_ptr->viewport()->size();
+    const int max = q_ptr->horizontalScrollBar()->maximum();
+    const double viewBegin = double(size.width()) * q_ptr->horizontalScrollBar()->value() / m_scaleFactor;
+    const double viewX = stop->position() * size.width() * (m_scaleFactor + max) / m_scaleFactor - viewBegin;
+    // The handle and the line below it, with room for the antialiasing
+    return QRectF(viewX - m_handleSize / 2, 0, m_handleSize, size.height())
+            .toAlignedRect().adjusted(-1, 0, 1, 0);
+}
+
+const QPixmap &QtGradientStopsWidgetPrivate::gradientPixmap(QtGradientStopsModel *model)
+{
+    QWidget *viewport = q_ptr->viewport();
+    const QSize size = viewport->size();
+    const qreal dpr = viewport->devicePixelRatio();
+    const int val = q_ptr->horizontalScrollBar()->value();
+    const int max = q_ptr->horizontalScrollBar()->maximum();
+    if (!m_gradientPixmap.isNull() && m_gradientModel == model
+        && m_gradientScrollValue == val && m_gradientScrollMaximum == max
+        && m_gradientPixmap.devicePixelRatio() == dpr
+        && m_gradientPixmap.deviceIndependentSize() == QSizeF(size)) {
+        return m_gradientPixmap;
+    }
+
+    m_gradientModel = model;
+    m_gradientScrollValue = val;
+    m_gradientScrollMaximum = max;
+    m_gradientPixmap = QPixmap(size * dpr);
+    m_gradientPixmap.setDevicePixelRatio(dpr);
+    m_gradientPixmap.fill(Qt::transparent);
+
+    QPainter p(&m_gradientPixmap);
+    if (m_backgroundCheckered) {
+        int pixSize = 20;
+        QPixmap pm(2 * pixSize, 2 * pixSize);
+        QPainter pmp(&pm);
+        pmp.fillRect(0, 0, pixSize, pixSize, Qt::white);
+        pmp.fillRect(pixSize, pixSize, pixSize, pixSize, Qt::white);
+        pmp.fillRect(0, pixSize, pixSize, pixSize, Qt::black);
+        pmp.fillRect(pixSize, 0, pixSize, pixSize, Qt::black);
+        pmp.end();
+
+        p.setBrushOrigin((size.width() % pixSize + pixSize) / 2, (size.height() % pixSize + pixSize) / 2);
+        p.fillRect(viewport->rect(), pm);
+        p.setBrushOrigin(0, 0);
+    }
+
+    const int w = size.width();
+    const double h = size.height() - m_handleSize;
+    const double begin = double(val) / (m_scaleFactor + max);
+    const double end = double(val + m_scaleFactor) / (m_scaleFactor + max);
+    const double width = end - begin;
+
+    if (h > 0) {
+        QLinearGradient lg(0, 0, w, 0);
+        const QMap<qreal, QtGradientStop *> stops = model->stops();
+        for (auto itStop = stops.cbegin(), send = stops.cend(); itStop != send; ++itStop) {
+            QtGradientStop *stop = itStop.value();
+            double pos = stop->position();
+            if (pos >= begin && pos <= end) {
+                double gradPos = (pos - begin) / width;
+                QColor c = stop->color();
+                lg.setColorAt(gradPos, c);
+            }
+        }
+        lg.setColorAt(0, model->color(begin));
+        lg.setColorAt(1, model->color(end));
+        p.fillRect(QRectF(0, m_handleSize, w, h), lg);
+    }
+    return m_gradientPixmap;
+}
+
 void QtGradientStopsWidgetPrivate::slotStopAdded(QtGradientStop *stop)
 {
     m_stops.append(stop);
+    invalidateGradient();
     q_ptr->viewport()->update();
 }
 
 void QtGradientStopsWidgetPrivate::slotStopRemoved(QtGradientStop *stop)
 {
     m_stops.removeAll(stop);
+    invalidateGradient();
     q_ptr->viewport()->update();
 }
 
@@ -260,6 +348,7 @@ void QtGradientStopsWidgetPrivate::slotStopMoved(QtGradientStop *stop, qreal new
 {
     Q_UNUSED(stop);
     Q_UNUSED(newPos);
+    invalidateGradient();
     q_ptr->viewport()->update();
 }
 
@@ -267,6 +356,7 @@ void QtGradientStopsWidgetPrivate::slotStopsSwapped(QtGradientStop *stop1, QtGra
 {
     Q_UNUSED(stop1);
     Q_UNUSED(stop2);
+    invalidateGradient();
     q_ptr->viewport()->update();
 }
 
@@ -274,14 +364,15 @@ void QtGradientStopsWidgetPrivate::slotStopChanged(QtGradientStop *stop, const Q
 {
     Q_UNUSED(stop);
     Q_UNUSED(newColor);
+    invalidateGradient();
     q_ptr->viewport()->update();
 }
 
 void QtGradientStopsWidgetPrivate::slotStopSelected(QtGradientStop *stop, bool selected)
 {
-    Q_UNUSED(stop);
     Q_UNUSED(selected);
-    q_ptr->viewport()->update();
+    // Only the look of the handle changes
+    q_ptr->viewport()->update(handleRect(stop));
 }
 
 void QtGradientStopsWidgetPrivate::slotCurrentStopChanged(QtGradientStop *stop)
@@ -417,6 +508,7 @@ void QtGradientStopsWidget::setBackgroundCheckered(bool checkered)
     if (d_ptr->m_backgroundCheckered == checkered)
         return;
     d_ptr->m_backgroundCheckered = checkered;
+    d_ptr->invalidateGradient();
     update();
 }
 
@@ -727,25 +819,8 @@ void QtGradientStopsWidget::paintEvent(QPaintEvent *e)
     if (w <= 0)
         return;
 
-    QPixmap pix(size);
-    QPainter p;
-
-    if (d_ptr->m_backgroundCheckered) {
-        int pixSize = 20;
-        QPixmap pm(2 * pixSize, 2 * pixSize);
-        QPainter pmp(&pm);
-        pmp.fillRect(0, 0, pixSize, pixSize, Qt::white);
-        pmp.fillRect(pixSize, pixSize, pixSize, pixSize, Qt::white);
-        pmp.fillRect(0, pixSize, pixSize, pixSize, Qt::black);
-        pmp.fillRect(pixSize, 0, pixSize, pixSize, Qt::black);
-
-        p.begin(&pix);
-        p.setBrushOrigin((size.width() % pixSize + pixSize) / 2, (size.height() % pixSize + pixSize) / 2);
-        p.fillRect(viewport()->rect(), pm);
-        p.setBrushOrigin(0, 0);
-    } else {
-        p.begin(viewport());
-    }
+    QPainter p(viewport());
+    p.drawPixmap(0, 0, d_ptr->gradientPixmap(model));
 
     const double viewBegin = double(w) * horizontalScrollBar()->value() / d_ptr->m_scaleFactor;
 
@@ -754,38 +829,6 @@ void QtGradientStopsWidget::paintEvent(QPaintEvent *e)
 
     const double begin = double(val) / (d_ptr->m_scaleFactor + max);
     const double end = double(val + d_ptr->m_scaleFactor) / (d_ptr->m_scaleFactor + max);
-    double width = end - begin;
-
-    if (h > 0) {
-        QLinearGradient lg(0, 0, w, 0);
-        QMap<qreal, QtGradientStop *> stops = model->stops();
-        for (auto itStop = stops.cbegin(), send = stops.cend(); itStop != send; ++itStop) {
-            QtGradientStop *stop = itStop.value();
-            double pos = stop->position();
-            if (pos >= begin && pos <= end) {
-                double gradPos = (pos - begin) / width;
-                QColor c = stop->color();
-                lg.setColorAt(gradPos, c);
-            }
-            //lg.setColorAt(stop->position(), stop->color());
-        }
-        lg.setColorAt(0, model->color(begin));
-        lg.setColorAt(1, model->color(end));
-        QImage img(w, 1, QImage::Format_ARGB32_Premultiplied);
-        QPainter p1(&img);
-        p1.setCompositionMode(QPainter::CompositionMode_Source);
-
-        /*
-        if (viewBegin != 0)
-            p1.translate(-viewBegin, 0);
-        if (d_ptr->m_zoom != 1)
-            p1.scale(d_ptr->m_zoom, 1);
-            */
-        p1.fillRect(0, 0, w, 1, lg);
-
-        p.fillRect(QRectF(0, d_ptr->m_handleSize, w, h), QPixmap::fromImage(img));
-    }
-
 
     double handleWidth = d_ptr->m_handleSize * d_ptr->m_scaleFactor / (w * (d_ptr->m_scaleFactor + max));
 
@@ -869,12 +912,6 @@ void QtGradientStopsWidget::paintEvent(QPaintEvent *e)
             p.restore();
         }
     }
-    if (d_ptr->m_backgroundCheckered) {
-        p.end();
-        p.begin(viewport());
-        p.drawPixmap(0, 0, pix);
-    }
-    p.end();
 }
 
 void QtGradientStopsWidget::focusInEvent(QFocusEvent *e)
@@ -971,6 +1008,7 @@ void QtGradientStopsWidget::dragEnterEvent(QDragEnterEvent *event)
     d_ptr->m_dragModel = d_ptr->m_model->clone();
 
     d_ptr->m_dragColor = qvariant_cast<QColor>(mime->colorData());
+    d_ptr->invalidateGradient();
     update();
 }
 
@@ -999,6 +1037,7 @@ void QtGradientStopsWidget::dragMoveEvent(QDragMoveEvent *event)
         d_ptr->restoreChangedStop();
     }
 
+    d_ptr->invalidateGradient();
     update();
 }
 
@@ -1006,6 +1045,7 @@ void QtGradientStopsWidget::dragLeaveEvent(QDragLeaveEvent *event)
 {
     event->accept();
     d_ptr->clearDrag();
+    d_ptr->invalidateGradient();
     update();
 }
 
@@ -1021,6 +1061,7 @@ void QtGradientStopsWidget::dropEvent(QDropEvent *event)
         d_ptr->m_model->addStop(d_ptr->m_clonedStop->position(), d_ptr->m_dragColor);
 
     d_ptr->clearDrag();
+    d_ptr->invalidateGradient();
     update();
 }
 
@@ -5,6 +5,7 @@
 #include <QtCore/QMap>
 #include <QtGui/QImage>
 #include <QtGui/QPainter>
+#include <QtGui/QPixmap>
 #include <QtWidgets/QScrollBar>
 #include <QtGui/QMouseEvent>
 #include <QtGui/QRegion>
@@ -34,6 +35,9 @@ public:
 
     void paintPoint(QPainter *painter, const QPointF &point, double size) const;
 
+    const QPixmap &backgroundPixmap();
+    const QPixmap &gradientPixmap();
+
     double m_handleSize;
     bool m_backgroundCheckered;
 
@@ -66,6 +70,13 @@ public:
     double m_dragRadius;
     double m_angleOffset;
     double m_dragAngle;
+
+    // The checkerboard and the gradient drawn onto it, at the device pixel
+    // ratio of the widget. The handles are painted on top of them, so that
+    // just highlighting a handle does not render the gradient again. The
+    // gradient is reset whenever it changes.
+    QPixmap m_backgroundPixmap;
+    QPixmap m_gradientPixmap;
 };
 
 double QtGradientWidgetPrivate::correctAngle(double angle) const
@@ -159,6 +170,82 @@ void QtGradientWidgetPrivate::paintPoint(QPainter *painter, const QPointF &point
     painter->restore();
 }
 
+static QPixmap createPixmap(const QWidget *widget)
+{
+    const qreal dpr = widget->devicePixelRatio();
+    QPixmap pixmap(widget->size() * dpr);
+    pixmap.setDevicePixelRatio(dpr);
+    return pixmap;
+}
+
+static bool isCurrent(const QPixmap &pixmap, const QWidget *widget)
+{
+    return !pixmap.isNull() && pixmap.devicePixelRatio() == widget->devicePixelRatio()
+        && pixmap.deviceIndependentSize() == QSizeF(widget->size());
+}
+
+const QPixmap &QtGradientWidgetPrivate::backgroundPixmap()
+{
+    if (isCurrent(m_backgroundPixmap, q_ptr))
+        return m_backgroundPixmap;
+
+    m_backgroundPixmap = createPixmap(q_ptr);
+    if (!m_backgroundCheckered) {
+        m_backgroundPixmap.fill(Qt::transparent);
+        return m_backgroundPixmap;
+    }
+
+    int pixSize = 40;
+    QPixmap pm(2 * pixSize, 2 * pixSize);
+
+    QPainter pmp(&pm);
+    pmp.fillRect(0, 0, pixSize, pixSize, Qt::white);
+    pmp.fillRect(pixSize, pixSize, pixSize, pixSize, Qt::white);
+    pmp.fillRect(0, pixSize, pixSize, pixSize, Qt::black);
+    pmp.fillRect(pixSize, 0, pixSize, pixSize, Qt::black);
+    pmp.end();
+
+    const QSize size = q_ptr->size();
+    QPainter p(&m_backgroundPixmap);
+    p.setBrushOrigin((size.width() % pixSize + pixSize) / 2, (size.height() % pixSize + pixSize) / 2);
+    p.fillRect(q_ptr->rect(), pm);
+    return m_backgroundPixmap;
+}
+
+const QPixmap &QtGradientWidgetPrivate::gradientPixmap()
+{
+    if (isCurrent(m_gradientPixmap, q_ptr))
+        return m_gradientPixmap;
+
+    m_gradientPixmap = backgroundPixmap();
+
+    QGradient *gradient = nullptr;
+    switch (m_gradientType) {
+        case QGradient::LinearGradient:
+            gradient = new QLinearGradient(m_startLinear, m_endLinear);
+            break;
+        case QGradient::RadialGradient:
+            gradient = new QRadialGradient(m_centralRadial, m_radiusRadial, m_focalRadial);
+            break;
+        case QGradient::ConicalGradient:
+            gradient = new QConicalGradient(m_centralConical, m_angleConical);
+            break;
+        default:
+            break;
+    }
+    if (!gradient)
+        return m_gradientPixmap;
+
+    gradient->setStops(m_gradientStops);
+    gradient->setSpread(m_gradientSpread);
+
+    QPainter p(&m_gradientPixmap);
+    p.scale(q_ptr->size().width(), q_ptr->size().height());
+    p.fillRect(QRect(0, 0, 1, 1), *gradient);
+    delete gradient;
+    return m_gradientPixmap;
+}
+
 /*
 void QtGradientWidgetPrivate::setupDrag(QtGradientStop *stop, int x)
 {
@@ -230,6 +317,8 @@ void QtGradientWidget::setBackgroundCheckered(bool checkered)
     if (d_ptr->m_backgroundCheckered == checkered)
         return;
     d_ptr->m_backgroundCheckered = checkered;
+    d_ptr->m_backgroundPixmap = QPixmap();
+    d_ptr->m_gradientPixmap = QPixmap();
     update();
 }
 
@@ -431,6 +520,7 @@ void QtGradientWidget::mouseMoveEvent(QMouseEvent *e)
             d_ptr->setAngleConical(angle);
         }
     }
+    d_ptr->m_gradientPixmap = QPixmap();
     update();
 }
 
@@ -444,46 +534,16 @@ void QtGradientWidget::paintEvent(QPaintEvent *e)
     Q_UNUSED(e);
 
     QPainter p(this);
+    p.drawPixmap(0, 0, d_ptr->gradientPixmap());
 
-    if (d_ptr->m_backgroundCheckered) {
-        int pixSize = 40;
-        QPixmap pm(2 * pixSize, 2 * pixSize);
-
-        QPainter pmp(&pm);
-        pmp.fillRect(0, 0, pixSize, pixSize, Qt::white);
-        pmp.fillRect(pixSize, pixSize, pixSize, pixSize, Qt::white);
-        pmp.fillRect(0, pixSize, pixSize, pixSize, Qt::black);
-        pmp.fillRect(pixSize, 0, pixSize, pixSize, Qt::black);
-
-        p.setBrushOrigin((size().width() % pixSize + pixSize) / 2, (size().height() % pixSize + pixSize) / 2);
-        p.fillRect(rect(), pm);
-        p.setBrushOrigin(0, 0);
-    }
-
-    QGradient *gradient = nullptr;
     switch (d_ptr->m_gradientType) {
         case QGradient::LinearGradient:
-            gradient = new QLinearGradient(d_ptr->m_startLinear, d_ptr->m_endLinear);
-            break;
         case QGradient::RadialGradient:
-            gradient = new QRadialGradient(d_ptr->m_centralRadial, d_ptr->m_radiusRadial, d_ptr->m_focalRadial);
-            break;
         case QGradient::ConicalGradient:
-            gradient = new QConicalGradient(d_ptr->m_centralConical, d_ptr->m_angleConical);
             break;
         default:
-            break;
+            return;
     }
-    if (!gradient)
-        return;
-
-    gradient->setStops(d_ptr->m_gradientStops);
-    gradient->setSpread(d_ptr->m_gradientSpread);
-
-    p.save();
-    p.scale(size().width(), size().height());
-    p.fillRect(QRect(0, 0, 1, 1), *gradient);
-    p.restore();
 
     p.setRenderHint(QPainter::Antialiasing);
 
@@ -610,13 +670,12 @@ void QtGradientWidget::paintEvent(QPaintEvent *e)
         p.restore();
 
     }
-
-    delete gradient;
 }
 
 void QtGradientWidget::setGradientStops(const QGradientStops &stops)
 {
     d_ptr->m_gradientStops = stops;
+    d_ptr->m_gradientPixmap = QPixmap();
     update();
 }
 
@@ -633,6 +692,7 @@ void QtGradientWidget::setGradientType(QGradient::Type type)
         return;
 
     d_ptr->m_gradientType = type;
+    d_ptr->m_gradientPixmap = QPixmap();
     update();
 }
 
@@ -647,6 +707,7 @@ void QtGradientWidget::setGradientSpread(QGradient::Spread spread)
         return;
 
     d_ptr->m_gradientSpread = spread;
+    d_ptr->m_gradientPixmap = QPixmap();
     update();
 }
 
@@ -661,6 +722,7 @@ void QtGradientWidget::setStartLinear(const QPointF &point)
         return;
 
     d_ptr->m_startLinear = d_ptr->checkRange(point);
+    d_ptr->m_gradientPixmap = QPixmap();
     update();
 }
 
@@ -675,6 +737,7 @@ void QtGradientWidget::setEndLinear(const QPointF &point)
         return;
 
     d_ptr->m_endLinear = d_ptr->checkRange(point);
+    d_ptr->m_gradientPixmap = QPixmap();
     update();
 }
 
@@ -689,6 +752,7 @@ void QtGradientWidget::setCentralRadial(const QPointF &point)
         return;
 
     d_ptr->m_centralRadial = point;
+    d_ptr->m_gradientPixmap = QPixmap();
     update();
 }
 
@@ -703,6 +767,7 @@ void QtGradientWidget::setFocalRadial(const QPointF &point)
         return;
 
     d_ptr->m_focalRadial = point;
+    d_ptr->m_gradientPixmap = QPixmap();
     update();
 }
 
@@ -717,6 +782,7 @@ void QtGradientWidget::setRadiusRadial(qreal radius)
         return;
 
     d_ptr->m_radiusRadial = radius;
+    d_ptr->m_gradientPixmap = QPixmap();
     update();
 }
 
@@ -731,6 +797,7 @@ void QtGradientWidget::setCentralConical(const QPointF &point)
         return;
 
     d_ptr->m_centralConical = point;
+    d_ptr->m_gradientPixmap = QPixmap();
     update();
 }
 
@@ -745,6 +812,7 @@ void QtGradientWidget::setAngleConical(qreal angle)
         return;
 
     d_ptr->m_angleConical = angle;
+    d_ptr->m_gradientPixmap = QPixmap();
     update();
 }
 
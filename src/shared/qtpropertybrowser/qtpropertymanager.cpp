@@ -5,6 +5,7 @@
 #include "qtpropertybrowserutils_p.h"
 #include <QtCore/QDateTime>
 #include <QtCore/QLocale>
+#include <QtCore/QHash>
 #include <QtCore/QMap>
 #include <QtCore/QTimer>
 #include <QtCore/QRegularExpression>
@@ -149,7 +150,7 @@ void orderBorders(QSizeF &minVal, QSizeF &maxVal)
 ////////
 
 template <class Value, class PrivateData>
-static Value getData(const QMap<const QtProperty *, PrivateData> &propertyMap,
+static Value getData(const QHash<const QtProperty *, PrivateData> &propertyMap,
             Value PrivateData::*data,
             const QtProperty *property, const Value &defaultValue = Value())
 {
@@ -160,28 +161,28 @@ static Value getData(const QMap<const QtProperty *, PrivateData> &propertyMap,
 }
 
 template <class Value, class PrivateData>
-static Value getValue(const QMap<const QtProperty *, PrivateData> &propertyMap,
+static Value getValue(const QHash<const QtProperty *, PrivateData> &propertyMap,
             const QtProperty *property, const Value &defaultValue = Value())
 {
     return getData<Value>(propertyMap, &PrivateData::val, property, defaultValue);
 }
 
 template <class Value, class PrivateData>
-static Value getMinimum(const QMap<const QtProperty *, PrivateData> &propertyMap,
+static Value getMinimum(const QHash<const QtProperty *, PrivateData> &propertyMap,
             const QtProperty *property, const Value &defaultValue = Value())
 {
     return getData<Value>(propertyMap, &PrivateData::minVal, property, defaultValue);
 }
 
 template <class Value, class PrivateData>
-static Value getMaximum(const QMap<const QtProperty *, PrivateData> &propertyMap,
+static Value getMaximum(const QHash<const QtProperty *, PrivateData> &propertyMap,
             const QtProperty *property, const Value &defaultValue = Value())
 {
     return getData<Value>(propertyMap, &PrivateData::maxVal, property, defaultValue);
 }
 
 template <class ValueChangeParameter, class Value, class PropertyManager>
-static void setSimpleValue(QMap<const QtProperty *, Value> &propertyMap,
+static void setSimpleValue(QHash<const QtProperty *, Value> &propertyMap,
             PropertyManager *manager,
             void (PropertyManager::*propertyChangedSignal)(QtProperty *),
             void (PropertyManager::*valueChangedSignal)(QtProperty *, ValueChangeParameter),
@@ -200,6 +201,13 @@ static void setSimpleValue(QMap<const QtProperty *, Value> &propertyMap,
     emit (manager->*valueChangedSignal)(property, val);
 }
 
+/*
+    The helpers below copy the values of a property out of its data before
+    they update its sub-properties or emit signals. The slots may add
+    properties to the manager, which rehashes m_values and leaves the
+    reference to the data dangling.
+*/
+
 template <class ValueChangeParameter, class PropertyManagerPrivate, class PropertyManager, class Value>
 static void setValueInRange(PropertyManager *manager, PropertyManagerPrivate *managerPrivate,
             void (PropertyManager::*propertyChangedSignal)(QtProperty *),
@@ -223,11 +231,38 @@ static void setValueInRange(PropertyManager *manager, PropertyManagerPrivate *ma
     if (data.val == oldVal)
         return;
 
+    const Value newVal = data.val;
+
     if (setSubPropertyValue)
-        (managerPrivate->*setSubPropertyValue)(property, data.val);
+        (managerPrivate->*setSubPropertyValue)(property, newVal);
+
+    emit (manager->*propertyChangedSignal)(property);
+    emit (manager->*valueChangedSignal)(property, newVal);
+}
+
+template <class ValueChangeParameter, class PropertyManagerPrivate, class PropertyManager, class Value, class PrivateData>
+static void emitRangeChanged(PropertyManager *manager, PropertyManagerPrivate *managerPrivate,
+            void (PropertyManager::*propertyChangedSignal)(QtProperty *),
+            void (PropertyManager::*valueChangedSignal)(QtProperty *, ValueChangeParameter),
+            void (PropertyManager::*rangeChangedSignal)(QtProperty *, ValueChangeParameter, ValueChangeParameter),
+            QtProperty *property, const PrivateData &data, const Value &oldVal,
+            void (PropertyManagerPrivate::*setSubPropertyRange)(QtProperty *,
+                    ValueChangeParameter, ValueChangeParameter, ValueChangeParameter))
+{
+    const Value newMinVal = data.minVal;
+    const Value newMaxVal = data.maxVal;
+    const Value newVal = data.val;
+
+    emit (manager->*rangeChangedSignal)(property, newMinVal, newMaxVal);
+
+    if (setSubPropertyRange)
+        (managerPrivate->*setSubPropertyRange)(property, newMinVal, newMaxVal, newVal);
+
+    if (newVal == oldVal)
+        return;
 
     emit (manager->*propertyChangedSignal)(property);
-    emit (manager->*valueChangedSignal)(property, data.val);
+    emit (manager->*valueChangedSignal)(property, newVal);
 }
 
 template <class ValueChangeParameter, class PropertyManagerPrivate, class PropertyManager, class Value>
@@ -257,16 +292,8 @@ static void setBorderValues(PropertyManager *manager, PropertyManagerPrivate *ma
     data.setMinimumValue(fromVal);
     data.setMaximumValue(toVal);
 
-    emit (manager->*rangeChangedSignal)(property, data.minVal, data.maxVal);
-
-    if (setSubPropertyRange)
-        (managerPrivate->*setSubPropertyRange)(property, data.minVal, data.maxVal, data.val);
-
-    if (data.val == oldVal)
-        return;
-
-    emit (manager->*propertyChangedSignal)(property);
-    emit (manager->*valueChangedSignal)(property, data.val);
+    emitRangeChanged<ValueChangeParameter>(manager, managerPrivate, propertyChangedSignal,
+            valueChangedSignal, rangeChangedSignal, property, data, oldVal, setSubPropertyRange);
 }
 
 template <class ValueChangeParameter, class PropertyManagerPrivate, class PropertyManager, class Value, class PrivateData>
@@ -293,16 +320,8 @@ static void setBorderValue(PropertyManager *manager, PropertyManagerPrivate *man
 
     (data.*setRangeVal)(borderVal);
 
-    emit (manager->*rangeChangedSignal)(property, data.minVal, data.maxVal);
-
-    if (setSubPropertyRange)
-        (managerPrivate->*setSubPropertyRange)(property, data.minVal, data.maxVal, data.val);
-
-    if (data.val == oldVal)
-        return;
-
-    emit (manager->*propertyChangedSignal)(property);
-    emit (manager->*valueChangedSignal)(property, data.val);
+    emitRangeChanged<ValueChangeParameter>(manager, managerPrivate, propertyChangedSignal,
+            valueChangedSignal, rangeChangedSignal, property, data, oldVal, setSubPropertyRange);
 }
 
 template <class ValueChangeParameter, class PropertyManagerPrivate, class PropertyManager, class Value, class PrivateData>
@@ -560,7 +579,7 @@ public:
         void setMaximumValue(int newMaxVal) { setSimpleMaximumData(this, newMaxVal); }
     };
 
-    typedef QMap<const QtProperty *, Data> PropertyValueMap;
+    typedef QHash<const QtProperty *, Data> PropertyValueMap;
     PropertyValueMap m_values;
 };
 
@@ -837,7 +856,7 @@ public:
         void setMaximumValue(double newMaxVal) { setSimpleMaximumData(this, newMaxVal); }
     };
 
-    typedef QMap<const QtProperty *, Data> PropertyValueMap;
+    typedef QHash<const QtProperty *, Data> PropertyValueMap;
     PropertyValueMap m_values;
 };
 
@@ -1160,8 +1179,8 @@ public:
         QRegularExpression regExp;
     };
 
-    typedef QMap<const QtProperty *, Data> PropertyValueMap;
-    QMap<const QtProperty *, Data> m_values;
+    typedef QHash<const QtProperty *, Data> PropertyValueMap;
+    QHash<const QtProperty *, Data> m_values;
 };
 
 /*!
@@ -1372,7 +1391,7 @@ class QtBoolPropertyManagerPrivate
 public:
     QtBoolPropertyManagerPrivate();
 
-    QMap<const QtProperty *, bool> m_values;
+    QHash<const QtProperty *, bool> m_values;
     const QIcon m_checkedIcon;
     const QIcon m_uncheckedIcon;
 };
@@ -1444,7 +1463,7 @@ bool QtBoolPropertyManager::value(const QtProperty *property) const
 */
 QString QtBoolPropertyManager::valueText(const QtProperty *property) const
 {
-    const QMap<const QtProperty *, bool>::const_iterator it = d_ptr->m_values.constFind(property);
+    const QHash<const QtProperty *, bool>::const_iterator it = d_ptr->m_values.constFind(property);
     if (it == d_ptr->m_values.constEnd())
         return QString();
 
@@ -1458,7 +1477,7 @@ QString QtBoolPropertyManager::valueText(const QtProperty *property) const
 */
 QIcon QtBoolPropertyManager::valueIcon(const QtProperty *property) const
 {
-    const QMap<const QtProperty *, bool>::const_iterator it = d_ptr->m_values.constFind(property);
+    const QHash<const QtProperty *, bool>::const_iterator it = d_ptr->m_values.constFind(property);
     if (it == d_ptr->m_values.constEnd())
         return QIcon();
 
@@ -1518,8 +1537,8 @@ public:
 
     QString m_format;
 
-    typedef QMap<const QtProperty *, Data> PropertyValueMap;
-    QMap<const QtProperty *, Data> m_values;
+    typedef QHash<const QtProperty *, Data> PropertyValueMap;
+    QHash<const QtProperty *, Data> m_values;
 };
 
 QtDatePropertyManagerPrivate::QtDatePropertyManagerPrivate(QtDatePropertyManager *q) :
@@ -1740,7 +1759,7 @@ public:
 
     const QString m_format;
 
-    typedef QMap<const QtProperty *, QTime> PropertyValueMap;
+    typedef QHash<const QtProperty *, QTime> PropertyValueMap;
     PropertyValueMap m_values;
 };
 
@@ -1860,7 +1879,7 @@ public:
 
     const QString m_format;
 
-    typedef QMap<const QtProperty *, QDateTime> PropertyValueMap;
+    typedef QHash<const QtProperty *, QDateTime> PropertyValueMap;
     PropertyValueMap m_values;
 };
 
@@ -1975,7 +1994,7 @@ public:
 
     QString m_format;
 
-    typedef QMap<const QtProperty *, QKeySequence> PropertyValueMap;
+    typedef QHash<const QtProperty *, QKeySequence> PropertyValueMap;
     PropertyValueMap m_values;
 };
 
@@ -2084,7 +2103,7 @@ class QtCharPropertyManagerPrivate
     Q_DECLARE_PUBLIC(QtCharPropertyManager)
 public:
 
-    typedef QMap<const QtProperty *, QChar> PropertyValueMap;
+    typedef QHash<const QtProperty *, QChar> PropertyValueMap;
     PropertyValueMap m_values;
 };
 
@@ -2199,16 +2218,16 @@ public:
     void slotEnumChanged(QtProperty *property, int value);
     void slotPropertyDestroyed(QtProperty *property);
 
-    typedef QMap<const QtProperty *, QLocale> PropertyValueMap;
+    typedef QHash<const QtProperty *, QLocale> PropertyValueMap;
     PropertyValueMap m_values;
 
     QtEnumPropertyManager *m_enumPropertyManager;
 
-    QMap<const QtProperty *, QtProperty *> m_propertyToLanguage;
-    QMap<const QtProperty *, QtProperty *> m_propertyToTerritory;
+    QHash<const QtProperty *, QtProperty *> m_propertyToLanguage;
+    QHash<const QtProperty *, QtProperty *> m_propertyToTerritory;
 
-    QMap<const QtProperty *, QtProperty *> m_languageToProperty;
-    QMap<const QtProperty *, QtProperty *> m_territoryToProperty;
+    QHash<const QtProperty *, QtProperty *> m_languageToProperty;
+    QHash<const QtProperty *, QtProperty *> m_territoryToProperty;
 };
 
 QtLocalePropertyManagerPrivate::QtLocalePropertyManagerPrivate()
@@ -2455,16 +2474,16 @@ public:
     void slotIntChanged(QtProperty *property, int value);
     void slotPropertyDestroyed(QtProperty *property);
 
-    typedef QMap<const QtProperty *, QPoint> PropertyValueMap;
+    typedef QHash<const QtProperty *, QPoint> PropertyValueMap;
     PropertyValueMap m_values;
 
     QtIntPropertyManager *m_intPropertyManager;
 
-    QMap<const QtProperty *, QtProperty *> m_propertyToX;
-    QMap<const QtProperty *, QtProperty *> m_propertyToY;
+    QHash<const QtProperty *, QtProperty *> m_propertyToX;
+    QHash<const QtProperty *, QtProperty *> m_propertyToY;
 
-    QMap<const QtProperty *, QtProperty *> m_xToProperty;
-    QMap<const QtProperty *, QtProperty *> m_yToProperty;
+    QHash<const QtProperty *, QtProperty *> m_xToProperty;
+    QHash<const QtProperty *, QtProperty *> m_yToProperty;
 };
 
 void QtPointPropertyManagerPrivate::slotIntChanged(QtProperty *property, int value)
@@ -2674,16 +2693,16 @@ public:
     void slotDoubleChanged(QtProperty *property, double value);
     void slotPropertyDestroyed(QtProperty *property);
 
-    typedef QMap<const QtProperty *, Data> PropertyValueMap;
+    typedef QHash<const QtProperty *, Data> PropertyValueMap;
     PropertyValueMap m_values;
 
     QtDoublePropertyManager *m_doublePropertyManager;
 
-    QMap<const QtProperty *, QtProperty *> m_propertyToX;
-    QMap<const QtProperty *, QtProperty *> m_propertyToY;
+    QHash<const QtProperty *, QtProperty *> m_propertyToX;
+    QHash<const QtProperty *, QtProperty *> m_propertyToY;
 
-    QMap<const QtProperty *, QtProperty *> m_xToProperty;
-    QMap<const QtProperty *, QtProperty *> m_yToProperty;
+    QHash<const QtProperty *, QtProperty *> m_xToProperty;
+    QHash<const QtProperty *, QtProperty *> m_yToProperty;
 };
 
 void QtPointFPropertyManagerPrivate::slotDoubleChanged(QtProperty *property, double value)
@@ -2958,16 +2977,16 @@ public:
         void setMaximumValue(const QSize &newMaxVal) { setSizeMaximumData(this, newMaxVal); }
     };
 
-    typedef QMap<const QtProperty *, Data> PropertyValueMap;
+    typedef QHash<const QtProperty *, Data> PropertyValueMap;
     PropertyValueMap m_values;
 
     QtIntPropertyManager *m_intPropertyManager;
 
-    QMap<const QtProperty *, QtProperty *> m_propertyToW;
-    QMap<const QtProperty *, QtProperty *> m_propertyToH;
+    QHash<const QtProperty *, QtProperty *> m_propertyToW;
+    QHash<const QtProperty *, QtProperty *> m_propertyToH;
 
-    QMap<const QtProperty *, QtProperty *> m_wToProperty;
-    QMap<const QtProperty *, QtProperty *> m_hToProperty;
+    QHash<const QtProperty *, QtProperty *> m_wToProperty;
+    QHash<const QtProperty *, QtProperty *> m_hToProperty;
 };
 
 void QtSizePropertyManagerPrivate::slotIntChanged(QtProperty *property, int value)
@@ -3303,16 +3322,16 @@ public:
         void setMaximumValue(const QSizeF &newMaxVal) { setSizeMaximumData(this, newMaxVal); }
     };
 
-    typedef QMap<const QtProperty *, Data> PropertyValueMap;
+    typedef QHash<const QtProperty *, Data> PropertyValueMap;
     PropertyValueMap m_values;
 
     QtDoublePropertyManager *m_doublePropertyManager;
 
-    QMap<const QtProperty *, QtProperty *> m_propertyToW;
-    QMap<const QtProperty *, QtProperty *> m_propertyToH;
+    QHash<const QtProperty *, QtProperty *> m_propertyToW;
+    QHash<const QtProperty *, QtProperty *> m_propertyToH;
 
-    QMap<const QtProperty *, QtProperty *> m_wToProperty;
-    QMap<const QtProperty *, QtProperty *> m_hToProperty;
+    QHash<const QtProperty *, QtProperty *> m_wToProperty;
+    QHash<const QtProperty *, QtProperty *> m_hToProperty;
 };
 
 void QtSizeFPropertyManagerPrivate::slotDoubleChanged(QtProperty *property, double value)
@@ -3695,20 +3714,20 @@ public:
         QRect constraint;
     };
 
-    typedef QMap<const QtProperty *, Data> PropertyValueMap;
+    typedef QHash<const QtProperty *, Data> PropertyValueMap;
     PropertyValueMap m_values;
 
     QtIntPropertyManager *m_intPropertyManager;
 
-    QMap<const QtProperty *, QtProperty *> m_propertyToX;
-    QMap<const QtProperty *, QtProperty *> m_propertyToY;
-    QMap<const QtProperty *, QtProperty *> m_propertyToW;
-    QMap<const QtProperty *, QtProperty *> m_propertyToH;
+    QHash<const QtProperty *, QtProperty *> m_propertyToX;
+    QHash<const QtProperty *, QtProperty *> m_propertyToY;
+    QHash<const QtProperty *, QtProperty *> m_propertyToW;
+    QHash<const QtProperty *, QtProperty *> m_propertyToH;
 
-    QMap<const QtProperty *, QtProperty *> m_xToProperty;
-    QMap<const QtProperty *, QtProperty *> m_yToProperty;
-    QMap<const QtProperty *, QtProperty *> m_wToProperty;
-    QMap<const QtProperty *, QtProperty *> m_hToProperty;
+    QHash<const QtProperty *, QtProperty *> m_xToProperty;
+    QHash<const QtProperty *, QtProperty *> m_yToProperty;
+    QHash<const QtProperty *, QtProperty *> m_wToProperty;
+    QHash<const QtProperty *, QtProperty *> m_hToProperty;
 };
 
 void QtRectPropertyManagerPrivate::slotIntChanged(QtProperty *property, int value)
@@ -4104,20 +4123,20 @@ public:
         int decimals{2};
     };
 
-    typedef QMap<const QtProperty *, Data> PropertyValueMap;
+    typedef QHash<const QtProperty *, Data> PropertyValueMap;
     PropertyValueMap m_values;
 
     QtDoublePropertyManager *m_doublePropertyManager;
 
-    QMap<const QtProperty *, QtProperty *> m_propertyToX;
-    QMap<const QtProperty *, QtProperty *> m_propertyToY;
-    QMap<const QtProperty *, QtProperty *> m_propertyToW;
-    QMap<const QtProperty *, QtProperty *> m_propertyToH;
+    QHash<const QtProperty *, QtProperty *> m_propertyToX;
+    QHash<const QtProperty *, QtProperty *> m_propertyToY;
+    QHash<const QtProperty *, QtProperty *> m_propertyToW;
+    QHash<const QtProperty *, QtProperty *> m_propertyToH;
 
-    QMap<const QtProperty *, QtProperty *> m_xToProperty;
-    QMap<const QtProperty *, QtProperty *> m_yToProperty;
-    QMap<const QtProperty *, QtProperty *> m_wToProperty;
-    QMap<const QtProperty *, QtProperty *> m_hToProperty;
+    QHash<const QtProperty *, QtProperty *> m_xToProperty;
+    QHash<const QtProperty *, QtProperty *> m_yToProperty;
+    QHash<const QtProperty *, QtProperty *> m_wToProperty;
+    QHash<const QtProperty *, QtProperty *> m_hToProperty;
 };
 
 void QtRectFPropertyManagerPrivate::slotDoubleChanged(QtProperty *property, double value)
@@ -4570,7 +4589,7 @@ public:
         QMap<int, QIcon> enumIcons;
     };
 
-    typedef QMap<const QtProperty *, Data> PropertyValueMap;
+    typedef QHash<const QtProperty *, Data> PropertyValueMap;
     PropertyValueMap m_values;
 };
 
@@ -4841,14 +4860,14 @@ public:
         QStringList flagNames;
     };
 
-    typedef QMap<const QtProperty *, Data> PropertyValueMap;
+    typedef QHash<const QtProperty *, Data> PropertyValueMap;
     PropertyValueMap m_values;
 
     QtBoolPropertyManager *m_boolPropertyManager;
 
-    QMap<const QtProperty *, QList<QtProperty *> > m_propertyToFlags;
+    QHash<const QtProperty *, QList<QtProperty *> > m_propertyToFlags;
 
-    QMap<const QtProperty *, QtProperty *> m_flagToProperty;
+    QHash<const QtProperty *, QtProperty *> m_flagToProperty;
 };
 
 void QtFlagPropertyManagerPrivate::slotBoolChanged(QtProperty *property, bool value)
@@ -5139,16 +5158,13 @@ void QtFlagPropertyManager::initializeProperty(QtProperty *property)
 */
 void QtFlagPropertyManager::uninitializeProperty(QtProperty *property)
 {
-    const auto it = d_ptr->m_propertyToFlags.find(property);
-    if (it != d_ptr->m_propertyToFlags.end()) {
-        for (QtProperty *prop : qAsConst(it.value()))  {
-            if (prop) {
-                d_ptr->m_flagToProperty.remove(prop);
-                delete prop;
-            }
+    const QList<QtProperty *> flags = d_ptr->m_propertyToFlags.take(property);
+    for (QtProperty *prop : flags)  {
+        if (prop) {
+            d_ptr->m_flagToProperty.remove(prop);
+            delete prop;
         }
     }
-    d_ptr->m_propertyToFlags.erase(it);
 
     d_ptr->m_values.remove(property);
 }
@@ -5167,21 +5183,21 @@ public:
     void slotEnumChanged(QtProperty *property, int value);
     void slotPropertyDestroyed(QtProperty *property);
 
-    typedef QMap<const QtProperty *, QSizePolicy> PropertyValueMap;
+    typedef QHash<const QtProperty *, QSizePolicy> PropertyValueMap;
     PropertyValueMap m_values;
 
     QtIntPropertyManager *m_intPropertyManager;
     QtEnumPropertyManager *m_enumPropertyManager;
 
-    QMap<const QtProperty *, QtProperty *> m_propertyToHPolicy;
-    QMap<const QtProperty *, QtProperty *> m_propertyToVPolicy;
-    QMap<const QtProperty *, QtProperty *> m_propertyToHStretch;
-    QMap<const QtProperty *, QtProperty *> m_propertyToVStretch;
+    QHash<const QtProperty *, QtProperty *> m_propertyToHPolicy;
+    QHash<const QtProperty *, QtProperty *> m_propertyToVPolicy;
+    QHash<const QtProperty *, QtProperty *> m_propertyToHStretch;
+    QHash<const QtProperty *, QtProperty *> m_propertyToVStretch;
 
-    QMap<const QtProperty *, QtProperty *> m_hPolicyToProperty;
-    QMap<const QtProperty *, QtProperty *> m_vPolicyToProperty;
-    QMap<const QtProperty *, QtProperty *> m_hStretchToProperty;
-    QMap<const QtProperty *, QtProperty *> m_vStretchToProperty;
+    QHash<const QtProperty *, QtProperty *> m_hPolicyToProperty;
+    QHash<const QtProperty *, QtProperty *> m_vPolicyToProperty;
+    QHash<const QtProperty *, QtProperty *> m_hStretchToProperty;
+    QHash<const QtProperty *, QtProperty *> m_vStretchToProperty;
 };
 
 QtSizePolicyPropertyManagerPrivate::QtSizePolicyPropertyManagerPrivate()
@@ -5496,28 +5512,28 @@ public:
 
     QStringList m_familyNames;
 
-    typedef QMap<const QtProperty *, QFont> PropertyValueMap;
+    typedef QHash<const QtProperty *, QFont> PropertyValueMap;
     PropertyValueMap m_values;
 
     QtIntPropertyManager *m_intPropertyManager;
     QtEnumPropertyManager *m_enumPropertyManager;
     QtBoolPropertyManager *m_boolPropertyManager;
 
-    QMap<const QtProperty *, QtProperty *> m_propertyToFamily;
-    QMap<const QtProperty *, QtProperty *> m_propertyToPointSize;
-    QMap<const QtProperty *, QtProperty *> m_propertyToBold;
-    QMap<const QtProperty *, QtProperty *> m_propertyToItalic;
-    QMap<const QtProperty *, QtProperty *> m_propertyToUnderline;
-    QMap<const QtProperty *, QtProperty *> m_propertyToStrikeOut;
-    QMap<const QtProperty *, QtProperty *> m_propertyToKerning;
-
-    QMap<const QtProperty *, QtProperty *> m_familyToProperty;
-    QMap<const QtProperty *, QtProperty *> m_pointSizeToProperty;
-    QMap<const QtProperty *, QtProperty *> m_boldToProperty;
-    QMap<const QtProperty *, QtProperty *> m_italicToProperty;
-    QMap<const QtProperty *, QtProperty *> m_underlineToProperty;
-    QMap<const QtProperty *, QtProperty *> m_strikeOutToProperty;
-    QMap<const QtProperty *, QtProperty *> m_kerningToProperty;
+    QHash<const QtProperty *, QtProperty *> m_propertyToFamily;
+    QHash<const QtProperty *, QtProperty *> m_propertyToPointSize;
+    QHash<const QtProperty *, QtProperty *> m_propertyToBold;
+    QHash<const QtProperty *, QtProperty *> m_propertyToItalic;
+    QHash<const QtProperty *, QtProperty *> m_propertyToUnderline;
+    QHash<const QtProperty *, QtProperty *> m_propertyToStrikeOut;
+    QHash<const QtProperty *, QtProperty *> m_propertyToKerning;
+
+    QHash<const QtProperty *, QtProperty *> m_familyToProperty;
+    QHash<const QtProperty *, QtProperty *> m_pointSizeToProperty;
+    QHash<const QtProperty *, QtProperty *> m_boldToProperty;
+    QHash<const QtProperty *, QtProperty *> m_italicToProperty;
+    QHash<const QtProperty *, QtProperty *> m_underlineToProperty;
+    QHash<const QtProperty *, QtProperty *> m_strikeOutToProperty;
+    QHash<const QtProperty *, QtProperty *> m_kerningToProperty;
 
     bool m_settingValue;
     QTimer *m_fontDatabaseChangeTimer;
@@ -5618,7 +5634,7 @@ void  QtFontPropertyManagerPrivate::slotFontDatabaseChanged()
 
 void QtFontPropertyManagerPrivate::slotFontDatabaseDelayedChange()
 {
-    typedef QMap<const QtProperty *, QtProperty *> PropertyPropertyMap;
+    typedef QHash<const QtProperty *, QtProperty *> PropertyPropertyMap;
     // rescan available font names
     const QStringList oldFamilies = m_familyNames;
     m_familyNames = QFontDatabase::families();
@@ -5962,20 +5978,20 @@ public:
     void slotIntChanged(QtProperty *property, int value);
     void slotPropertyDestroyed(QtProperty *property);
 
-    typedef QMap<const QtProperty *, QColor> PropertyValueMap;
+    typedef QHash<const QtProperty *, QColor> PropertyValueMap;
     PropertyValueMap m_values;
 
     QtIntPropertyManager *m_intPropertyManager;
 
-    QMap<const QtProperty *, QtProperty *> m_propertyToR;
-    QMap<const QtProperty *, QtProperty *> m_propertyToG;
-    QMap<const QtProperty *, QtProperty *> m_propertyToB;
-    QMap<const QtProperty *, QtProperty *> m_propertyToA;
+    QHash<const QtProperty *, QtProperty *> m_propertyToR;
+    QHash<const QtProperty *, QtProperty *> m_propertyToG;
+    QHash<const QtProperty *, QtProperty *> m_propertyToB;
+    QHash<const QtProperty *, QtProperty *> m_propertyToA;
 
-    QMap<const QtProperty *, QtProperty *> m_rToProperty;
-    QMap<const QtProperty *, QtProperty *> m_gToProperty;
-    QMap<const QtProperty *, QtProperty *> m_bToProperty;
-    QMap<const QtProperty *, QtProperty *> m_aToProperty;
+    QHash<const QtProperty *, QtProperty *> m_rToProperty;
+    QHash<const QtProperty *, QtProperty *> m_gToProperty;
+    QHash<const QtProperty *, QtProperty *> m_bToProperty;
+    QHash<const QtProperty *, QtProperty *> m_aToProperty;
 };
 
 void QtColorPropertyManagerPrivate::slotIntChanged(QtProperty *property, int value)
@@ -6259,7 +6275,7 @@ class QtCursorPropertyManagerPrivate
     QtCursorPropertyManager *q_ptr;
     Q_DECLARE_PUBLIC(QtCursorPropertyManager)
 public:
-    typedef QMap<const QtProperty *, QCursor> PropertyValueMap;
+    typedef QHash<const QtProperty *, QCursor> PropertyValueMap;
     PropertyValueMap m_values;
 };
 
@@ -2,6 +2,7 @@
 // SPDX-License-Identifier: LicenseRef-Qt-Commercial OR LGPL-3.0-only OR GPL-2.0-only OR GPL-3.0-only
 
 #include "qttreepropertybrowser.h"
+#include <QtCore/QList>
 #include <QtCore/QSet>
 #include <QtCore/QMap>
 #include <QtGui/QIcon>
@@ -58,8 +59,12 @@ public:
 
     QTreeWidgetItem *editedItem() const;
 
+    void beginUpdate();
+    void endUpdate();
+
 private:
     void updateItem(QTreeWidgetItem *item);
+    void scheduleUpdate(QTreeWidgetItem *item);
 
     QMap<QtBrowserItem *, QTreeWidgetItem *> m_indexToItem;
     QMap<QTreeWidgetItem *, QtBrowserItem *> m_itemToIndex;
@@ -74,6 +79,12 @@ private:
     bool m_markPropertiesWithoutValue;
     bool m_browserChangedBlocked;
     QIcon m_expandIcon;
+
+    // Items inserted or changed while updates are batched, in the order
+    // they were scheduled so that parents are updated before their children.
+    int m_updateLevel = 0;
+    QList<QTreeWidgetItem *> m_pendingItems;
+    QSet<QTreeWidgetItem *> m_pendingItemSet;
 };
 
 // ------------ QtPropertyEditorView
@@ -517,7 +528,7 @@ void QtTreePropertyBrowserPrivate::propertyInserted(QtBrowserItem *index, QtBrow
     newItem->setFlags(newItem->flags() | Qt::ItemIsEditable);
     newItem->setExpanded(true);
 
-    updateItem(newItem);
+    scheduleUpdate(newItem);
 }
 
 void QtTreePropertyBrowserPrivate::propertyRemoved(QtBrowserItem *index)
@@ -528,6 +539,9 @@ void QtTreePropertyBrowserPrivate::propertyRemoved(QtBrowserItem *index)
         m_treeWidget->setCurrentItem(0);
     }
 
+    if (m_pendingItemSet.remove(item))
+        m_pendingItems.removeOne(item);
+
     delete item;
 
     m_indexToItem.remove(index);
@@ -539,7 +553,39 @@ void QtTreePropertyBrowserPrivate::propertyChanged(QtBrowserItem *index)
 {
     QTreeWidgetItem *item = m_indexToItem.value(index);
 
-    updateItem(item);
+    scheduleUpdate(item);
+}
+
+void QtTreePropertyBrowserPrivate::scheduleUpdate(QTreeWidgetItem *item)
+{
+    if (m_updateLevel == 0)
+        updateItem(item);
+    else if (!m_pendingItemSet.contains(item)) {
+        m_pendingItemSet.insert(item);
+        m_pendingItems.append(item);
+    }
+}
+
+void QtTreePropertyBrowserPrivate::beginUpdate()
+{
+    if (m_updateLevel++ == 0)
+        m_treeWidget->setUpdatesEnabled(false);
+}
+
+void QtTreePropertyBrowserPrivate::endUpdate()
+{
+    if (m_updateLevel == 0 || --m_updateLevel > 0)
+        return;
+
+    // The items are removed from the pending list when they are deleted.
+    const QList<QTreeWidgetItem *> pendingItems = m_pendingItems;
+    m_pendingItems.clear();
+    m_pendingItemSet.clear();
+    for (QTreeWidgetItem *item : pendingItems)
+        updateItem(item);
+    m_treeWidget->setUpdatesEnabled(true);
+    m_treeWidget->doItemsLayout();
+    m_treeWidget->viewport()->update();
 }
 
 void QtTreePropertyBrowserPrivate::updateItem(QTreeWidgetItem *item)
@@ -580,7 +626,8 @@ void QtTreePropertyBrowserPrivate::updateItem(QTreeWidgetItem *item)
         else
             disableItem(item);
     }
-    m_treeWidget->viewport()->update();
+    if (m_updateLevel == 0)
+        m_treeWidget->viewport()->update();
 }
 
 QColor QtTreePropertyBrowserPrivate::calculatedBackgroundColor(QtBrowserItem *item) const
@@ -988,6 +1035,34 @@ void QtTreePropertyBrowser::itemChanged(QtBrowserItem *item)
     d_ptr->propertyChanged(item);
 }
 
+/*!
+    Starts a batch of changes to the browser, for example populating it
+    with many properties.
+
+    Until the matching endUpdate() call, the browser does not repaint and
+    the items of inserted and changed properties are updated only once,
+    at the end of the batch. Calls can be nested.
+
+    \since 6.5
+    \sa endUpdate()
+*/
+void QtTreePropertyBrowser::beginUpdate()
+{
+    d_ptr->beginUpdate();
+}
+
+/*!
+    Ends a batch of changes started by beginUpdate(), updates the items
+    that were inserted or changed and lays out the tree once.
+
+    \since 6.5
+    \sa beginUpdate()
+*/
+void QtTreePropertyBrowser::endUpdate()
+{
+    d_ptr->endUpdate();
+}
+
 /*!
     Sets the current item to \a item and opens the relevant editor for it.
 */
@@ -68,6 +68,9 @@ public:
 
     void editItem(QtBrowserItem *item);
 
+    void beginUpdate();
+    void endUpdate();
+
 Q_SIGNALS:
 
     void collapsed(QtBrowserItem *item);
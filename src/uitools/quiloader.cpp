@@ -16,6 +16,7 @@
 #include <QtWidgets/qlayout.h>
 #include <QtWidgets/qwidget.h>
 #include <QtWidgets/qtabwidget.h>
+#include <QtWidgets/qstackedwidget.h>
 #include <QtWidgets/qtreewidget.h>
 #include <QtWidgets/qlistwidget.h>
 #include <QtWidgets/qtablewidget.h>
@@ -26,10 +27,14 @@
 #include <QtGui/qaction.h>
 #include <QtGui/qactiongroup.h>
 
+#include <QtCore/qbuffer.h>
 #include <QtCore/qdebug.h>
 #include <QtCore/qdatastream.h>
 #include <QtCore/qmap.h>
 #include <QtCore/qdir.h>
+#include <QtCore/qfile.h>
+#include <QtCore/qsavefile.h>
+#include <QtCore/qsharedpointer.h>
 #include <QtCore/qlibraryinfo.h>
 
 QT_BEGIN_NAMESPACE
@@ -284,6 +289,21 @@ private:
     bool m_idBased;
 };
 
+class LazyPageCreator;
+
+// The state of the load of a form that is needed to create the contents of
+// its lazy pages later on.
+struct LazyPageContext
+{
+    QPointer<QWidget> form;
+    QPointer<TranslationWatcher> translationWatcher;
+    QByteArray className;
+    bool idBased = false;
+    // The custom widgets, the layout default, the connections and the tab
+    // stops of the form
+    QByteArray formData;
+};
+
 class FormBuilderPrivate: public QFormBuilder
 {
     friend class QT_PREPEND_NAMESPACE(QUiLoader);
@@ -295,6 +315,7 @@ public:
 
     bool dynamicTr = false;
     bool trEnabled = true;
+    bool lazyPages = false;
 
     FormBuilderPrivate() = default;
 
@@ -363,12 +384,377 @@ public:
     QWidget *create(DomWidget *ui_widget, QWidget *parentWidget) override;
     bool addItem(DomWidget *ui_widget, QWidget *widget, QWidget *parentWidget) override;
 
+    void applyTabStops(QWidget *widget, DomTabStops *tabStops) override;
+
+    QWidget *loadCached(QIODevice *dev, QWidget *parentWidget, const QString &cacheDirectory);
+    void createPageContents(QWidget *page, const QByteArray &contents,
+                            const QSharedPointer<LazyPageContext> &context);
+
 private:
+    QWidget *createNow(DomWidget *ui_widget, QWidget *parentWidget);
+    bool isLazyPage(QWidget *parentWidget);
+    QWidget *createLazyPage(DomWidget *ui_widget, QWidget *parentWidget);
+    void startLazyPages();
+
     QByteArray m_class;
     TranslationWatcher *m_trwatch = nullptr;
     bool m_idBased = false;
+
+    // The current page and the number of pages created so far of the
+    // widgets being created
+    struct PageCount {
+        int current;
+        int count;
+    };
+    QList<PageCount> m_pageCounts;
+    QSharedPointer<LazyPageContext> m_lazyPageContext;
+    QList<QPointer<LazyPageCreator>> m_lazyPageCreators;
 };
 
+static bool isPageContainer(const QWidget *widget)
+{
+    return false
+#if QT_CONFIG(tabwidget)
+        || qobject_cast<const QTabWidget *>(widget)
+#endif
+#if QT_CONFIG(stackedwidget)
+        || qobject_cast<const QStackedWidget *>(widget)
+#endif
+#if QT_CONFIG(toolbox)
+        || qobject_cast<const QToolBox *>(widget)
+#endif
+        ;
+}
+
+// Creates the contents of the pages of a container other than the current
+// one when they are first shown, see QUiLoader::setLazyPageCreationEnabled().
+class LazyPageCreator : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit LazyPageCreator(QWidget *container, FormBuilderPrivate *builder,
+                             const QSharedPointer<LazyPageContext> &context) :
+        QObject(container),
+        m_container(container),
+        m_builder(builder),
+        m_loader(builder->loader),
+        m_context(context)
+    {
+    }
+
+    QWidget *container() const { return m_container; }
+
+    void addPage(QWidget *page, const QByteArray &contents)
+    {
+        m_pages.insert(page, contents);
+        connect(page, &QObject::destroyed, this, [this, page] { m_pages.remove(page); });
+    }
+
+    void start()
+    {
+        if (0) {
+#if QT_CONFIG(tabwidget)
+        } else if (auto *tabWidget = qobject_cast<QTabWidget *>(m_container)) {
+            connect(tabWidget, &QTabWidget::currentChanged, this, &LazyPageCreator::createPage);
+            createPage(tabWidget->currentIndex());
+#endif
+#if QT_CONFIG(stackedwidget)
+        } else if (auto *stackedWidget = qobject_cast<QStackedWidget *>(m_container)) {
+            connect(stackedWidget, &QStackedWidget::currentChanged, this, &LazyPageCreator::createPage);
+            createPage(stackedWidget->currentIndex());
+#endif
+#if QT_CONFIG(toolbox)
+        } else if (auto *toolBox = qobject_cast<QToolBox *>(m_container)) {
+            connect(toolBox, &QToolBox::currentChanged, this, &LazyPageCreator::createPage);
+            createPage(toolBox->currentIndex());
+#endif
+        }
+    }
+
+    void createPage(int index)
+    {
+        QWidget *page = pageAt(index);
+        if (!page || !m_pages.contains(page))
+            return;
+        const QByteArray contents = m_pages.take(page);
+        if (m_loader.isNull()) {
+            uiLibWarning(QCoreApplication::translate("QUiLoader",
+                                                     "The page '%1' cannot be created since its loader was destroyed.")
+                                                     .arg(page->objectName()));
+            return;
+        }
+        m_builder->createPageContents(page, contents, m_context);
+    }
+
+private:
+    QWidget *pageAt(int index) const
+    {
+        if (0) {
+#if QT_CONFIG(tabwidget)
+        } else if (auto *tabWidget = qobject_cast<QTabWidget *>(m_container)) {
+            return tabWidget->widget(index);
+#endif
+#if QT_CONFIG(stackedwidget)
+        } else if (auto *stackedWidget = qobject_cast<QStackedWidget *>(m_container)) {
+            return stackedWidget->widget(index);
+#endif
+#if QT_CONFIG(toolbox)
+        } else if (auto *toolBox = qobject_cast<QToolBox *>(m_container)) {
+            return toolBox->widget(index);
+#endif
+        }
+        return nullptr;
+    }
+
+    QWidget *m_container;
+    FormBuilderPrivate *m_builder;
+    QPointer<QUiLoader> m_loader;
+    QSharedPointer<LazyPageContext> m_context;
+    QHash<QWidget *, QByteArray> m_pages;
+};
+
+template <class T>
+static void writeFormPart(QDataStream &stream, const T *part)
+{
+    stream << (part != nullptr);
+    if (part)
+        part->write(stream);
+}
+
+template <class T>
+static T *readFormPart(QDataStream &stream)
+{
+    bool present = false;
+    stream >> present;
+    if (!present || stream.status() != QDataStream::Ok)
+        return nullptr;
+    T *part = new T;
+    part->read(stream);
+    return part;
+}
+
+static int currentPageIndex(const DomWidget *ui_widget)
+{
+    const QString &currentIndexProperty = QFormBuilderStrings::instance().currentIndexProperty;
+    const auto &properties = ui_widget->elementProperty();
+    for (const DomProperty *p : properties) {
+        if (p->attributeName() == currentIndexProperty)
+            return p->elementNumber();
+    }
+    return 0;
+}
+
+bool FormBuilderPrivate::isLazyPage(QWidget *parentWidget)
+{
+    if (m_pageCounts.isEmpty() || !isPageContainer(parentWidget)
+        || !d->customWidgetAddPageMethod(QLatin1String(parentWidget->metaObject()->className())).isEmpty()) {
+        return false;
+    }
+    PageCount &pageCount = m_pageCounts.last();
+    return pageCount.count++ != pageCount.current;
+}
+
+// Creates the page itself, so that it is added to its container with its
+// title, and keeps its contents for later.
+QWidget *FormBuilderPrivate::createLazyPage(DomWidget *ui_widget, QWidget *parentWidget)
+{
+    QByteArray contents;
+    {
+        QDataStream stream(&contents, QIODevice::WriteOnly);
+        ui_widget->write(stream);
+    }
+
+    const auto actions = ui_widget->elementAction();
+    const auto actionGroups = ui_widget->elementActionGroup();
+    const auto widgets = ui_widget->elementWidget();
+    const auto layouts = ui_widget->elementLayout();
+    ui_widget->setElementAction({});
+    ui_widget->setElementActionGroup({});
+    ui_widget->setElementWidget({});
+    ui_widget->setElementLayout({});
+    QWidget *page = createNow(ui_widget, parentWidget);
+    ui_widget->setElementAction(actions);
+    ui_widget->setElementActionGroup(actionGroups);
+    ui_widget->setElementWidget(widgets);
+    ui_widget->setElementLayout(layouts);
+    if (!page)
+        return nullptr;
+
+    if (m_lazyPageContext.isNull())
+        m_lazyPageContext.reset(new LazyPageContext);
+    LazyPageCreator *creator = nullptr;
+    for (LazyPageCreator *c : std::as_const(m_lazyPageCreators)) {
+        if (c && c->container() == parentWidget)
+            creator = c;
+    }
+    if (!creator) {
+        creator = new LazyPageCreator(parentWidget, this, m_lazyPageContext);
+        m_lazyPageCreators.append(creator);
+    }
+    creator->addPage(page, contents);
+    return page;
+}
+
+// Lets the containers created since the last call create their current page.
+void FormBuilderPrivate::startLazyPages()
+{
+    const auto creators = std::exchange(m_lazyPageCreators, {});
+    for (LazyPageCreator *creator : creators) {
+        if (creator)
+            creator->start();
+    }
+}
+
+void FormBuilderPrivate::createPageContents(QWidget *page, const QByteArray &contents,
+                                            const QSharedPointer<LazyPageContext> &context)
+{
+    if (context->form.isNull())
+        return;
+    QWidget *form = context->form;
+
+    DomUI formData;
+    QDataStream formStream(context->formData);
+    if (auto *customWidgets = readFormPart<DomCustomWidgets>(formStream))
+        formData.setElementCustomWidgets(customWidgets);
+    if (auto *layoutDefault = readFormPart<DomLayoutDefault>(formStream))
+        formData.setElementLayoutDefault(layoutDefault);
+    if (auto *connections = readFormPart<DomConnections>(formStream))
+        formData.setElementConnections(connections);
+    if (auto *tabStops = readFormPart<DomTabStops>(formStream))
+        formData.setElementTabStops(tabStops);
+
+    DomWidget ui_widget;
+    QDataStream stream(contents);
+    ui_widget.read(stream);
+
+    // Restore the state the builder had while loading the form
+    m_class = context->className;
+    m_trwatch = context->translationWatcher;
+    m_idBased = context->idBased;
+    setTextBuilder(new TranslatingTextBuilder(m_idBased, trEnabled, m_class));
+    m_lazyPageContext = context;
+
+    d->clear();
+    d->setParentWidget(form);
+    if (const DomLayoutDefault *def = formData.elementLayoutDefault()) {
+        d->m_defaultMargin = def->hasAttributeMargin() ? def->attributeMargin() : INT_MIN;
+        d->m_defaultSpacing = def->hasAttributeSpacing() ? def->attributeSpacing() : INT_MIN;
+    }
+    initialize(&formData);
+    const auto formActions = form->findChildren<QAction *>();
+    for (QAction *action : formActions)
+        d->m_actions.insert(action->objectName(), action);
+    const auto formActionGroups = form->findChildren<QActionGroup *>();
+    for (QActionGroup *actionGroup : formActionGroups)
+        d->m_actionGroups.insert(actionGroup->objectName(), actionGroup);
+
+    m_pageCounts.append(PageCount{currentPageIndex(&ui_widget), 0});
+    const auto &elementAction = ui_widget.elementAction();
+    for (DomAction *ui_action : elementAction)
+        create(ui_action, page);
+    const auto &elementActionGroup = ui_widget.elementActionGroup();
+    for (DomActionGroup *ui_action_group : elementActionGroup)
+        create(ui_action_group, page);
+    const auto &elementWidget = ui_widget.elementWidget();
+    for (DomWidget *ui_child : elementWidget)
+        create(ui_child, page);
+    const auto &elementLayout = ui_widget.elementLayout();
+    for (DomLayout *ui_lay : elementLayout)
+        create(ui_lay, nullptr, page);
+    m_pageCounts.removeLast();
+
+    // Only the connections of the new widgets, the others exist already
+    if (DomConnections *connections = formData.elementConnections()) {
+        QList<DomConnection *> pageConnections;
+        QList<DomConnection *> otherConnections;
+        const auto &elementConnection = connections->elementConnection();
+        for (DomConnection *c : elementConnection) {
+            if (page->findChild<QObject *>(c->elementSender())
+                || page->findChild<QObject *>(c->elementReceiver())) {
+                pageConnections.append(c);
+            } else {
+                otherConnections.append(c);
+            }
+        }
+        connections->setElementConnection(pageConnections);
+        qDeleteAll(otherConnections);
+        createConnections(connections, form);
+    }
+    applyTabStops(form, formData.elementTabStops());
+    d->applyInternalProperties();
+    reset();
+    d->clear();
+    startLazyPages();
+
+    // Widgets created on a visible page are hidden unless they are shown.
+    if (page->isVisible()) {
+        const auto children = page->findChildren<QWidget *>(Qt::FindDirectChildrenOnly);
+        for (QWidget *child : children) {
+            if (!child->testAttribute(Qt::WA_WState_ExplicitShowHide))
+                child->show();
+        }
+    }
+}
+
+// Widgets on pages that are not created yet cannot be found, they get their
+// place in the tab order when their page is created.
+void FormBuilderPrivate::applyTabStops(QWidget *widget, DomTabStops *tabStops)
+{
+    if (m_lazyPageContext.isNull() || !tabStops) {
+        ParentClass::applyTabStops(widget, tabStops);
+        return;
+    }
+
+    const QStringList &names = tabStops->elementTabStop();
+    QWidgetList widgets;
+    widgets.reserve(names.size());
+    for (const QString &name : names) {
+        if (QWidget *child = widget->findChild<QWidget*>(name))
+            widgets.append(child);
+    }
+
+    for (int i = 1, count = widgets.size(); i < count; ++i)
+        QWidget::setTabOrder(widgets.at(i - 1), widgets.at(i));
+}
+
+// Creates the form from its compiled form in the cache directory, parsing
+// and compiling it on a miss.
+QWidget *FormBuilderPrivate::loadCached(QIODevice *dev, QWidget *parentWidget,
+                                        const QString &cacheDirectory)
+{
+    const QByteArray contents = dev->readAll();
+    const QString cacheFileName = cacheDirectory + u'/'
+        + QFormBuilderExtra::compiledUiFileName(contents);
+
+    DomArena arena;
+    QScopedPointer<DomUI> ui;
+    {
+        const DomArena::Scope arenaScope(&arena);
+        QFile cacheFile(cacheFileName);
+        if (cacheFile.open(QIODevice::ReadOnly))
+            ui.reset(d->readCompiledUi(&cacheFile));
+        if (ui.isNull()) {
+            QBuffer buffer;
+            buffer.setData(contents);
+            buffer.open(QIODevice::ReadOnly);
+            ui.reset(d->readUi(&buffer));
+            if (ui.isNull())
+                return nullptr;
+            // The cache may well be read-only, for example in the resources.
+            QSaveFile compiledFile(cacheFileName);
+            if (QDir().mkpath(cacheDirectory) && compiledFile.open(QIODevice::WriteOnly)
+                && QFormBuilderExtra::writeCompiledUi(ui.data(), &compiledFile)) {
+                compiledFile.commit();
+            }
+        }
+    }
+    QWidget *widget = create(ui.data(), parentWidget);
+    if (!widget && d->m_errorString.isEmpty())
+        d->m_errorString = QFormBuilderExtra::msgInvalidUiFile();
+    return widget;
+}
+
 static QString convertTranslatable(const DomProperty *p, const QByteArray &className,
                                    bool idBased, QUiTranslatableStringValue *strVal)
 {
@@ -427,10 +813,41 @@ QWidget *FormBuilderPrivate::create(DomUI *ui, QWidget *parentWidget)
     m_trwatch = nullptr;
     m_idBased = ui->attributeIdbasedtr();
     setTextBuilder(new TranslatingTextBuilder(m_idBased, trEnabled, m_class));
-    return QFormBuilder::create(ui, parentWidget);
+    m_lazyPageContext.reset();
+    QWidget *widget = QFormBuilder::create(ui, parentWidget);
+    if (m_lazyPageCreators.isEmpty())
+        return widget;
+
+    if (widget) {
+        m_lazyPageContext->form = widget;
+        m_lazyPageContext->translationWatcher = m_trwatch;
+        m_lazyPageContext->className = m_class;
+        m_lazyPageContext->idBased = m_idBased;
+        QDataStream stream(&m_lazyPageContext->formData, QIODevice::WriteOnly);
+        writeFormPart(stream, ui->elementCustomWidgets());
+        writeFormPart(stream, ui->elementLayoutDefault());
+        writeFormPart(stream, ui->elementConnections());
+        writeFormPart(stream, ui->elementTabStops());
+        startLazyPages();
+    }
+    m_lazyPageCreators.clear();
+    return widget;
 }
 
 QWidget *FormBuilderPrivate::create(DomWidget *ui_widget, QWidget *parentWidget)
+{
+    if (!lazyPages)
+        return createNow(ui_widget, parentWidget);
+    if (isLazyPage(parentWidget))
+        return createLazyPage(ui_widget, parentWidget);
+
+    m_pageCounts.append(PageCount{currentPageIndex(ui_widget), 0});
+    QWidget *w = createNow(ui_widget, parentWidget);
+    m_pageCounts.removeLast();
+    return w;
+}
+
+QWidget *FormBuilderPrivate::createNow(DomWidget *ui_widget, QWidget *parentWidget)
 {
     QWidget *w = QFormBuilder::create(ui_widget, parentWidget);
     if (w == nullptr)
@@ -532,6 +949,7 @@ public:
 #else
     FormBuilderPrivate builder;
 #endif
+    QString formCacheDirectory;
 
     void setupWidgetMap() const;
 };
@@ -645,15 +1063,22 @@ QUiLoader::~QUiLoader() = default;
     Loads a form from the given \a device and creates a new widget with the
     given \a parentWidget to hold its contents.
 
-    \sa createWidget(), errorString()
+    The device may contain a UI file or, since Qt 6.5, a compiled form as
+    written to the form cache.
+
+    \sa createWidget(), errorString(), setFormCacheDirectory()
 */
 QWidget *QUiLoader::load(QIODevice *device, QWidget *parentWidget)
 {
     Q_D(QUiLoader);
-    // QXmlStreamReader will report errors on open failure.
+    // QXmlStreamReader will report errors on open failure. Compiled forms are
+    // binary, so the device is not opened in text mode; QXmlStreamReader
+    // normalizes line endings itself.
     if (!device->isOpen())
-        device->open(QIODevice::ReadOnly|QIODevice::Text);
-    return d->builder.load(device, parentWidget);
+        device->open(QIODevice::ReadOnly);
+    if (d->formCacheDirectory.isEmpty() || QFormBuilderExtra::isCompiledUi(device))
+        return d->builder.load(device, parentWidget);
+    return d->builder.loadCached(device, parentWidget, d->formCacheDirectory);
 }
 
 /*!
@@ -832,6 +1257,47 @@ QDir QUiLoader::workingDirectory() const
     Q_D(const QUiLoader);
     return d->builder.workingDirectory();
 }
+
+/*!
+    \since 6.5
+
+    Sets the directory in which load() caches compiled forms to \a directory.
+
+    A compiled form is a binary representation of a UI file that is much
+    faster to read than the XML. When a form cache directory is set, load()
+    looks up the compiled form of the contents of the device in it, and
+    compiles the form and stores it there if it is not found. The cache is
+    keyed on the contents of the UI file, so changed forms are compiled
+    anew. The cache directory may also be read-only, for example a directory
+    in the resources populated when building the application.
+
+    Compiled forms written by a different version of the format are
+    ignored. Property values such as enumerations are still resolved when
+    the form is created.
+
+    An empty \a directory, the default, disables the cache.
+
+    \sa formCacheDirectory(), load()
+*/
+void QUiLoader::setFormCacheDirectory(const QString &directory)
+{
+    Q_D(QUiLoader);
+    d->formCacheDirectory = directory;
+}
+
+/*!
+    \since 6.5
+
+    Returns the directory in which load() caches compiled forms.
+
+    \sa setFormCacheDirectory()
+*/
+QString QUiLoader::formCacheDirectory() const
+{
+    Q_D(const QUiLoader);
+    return d->formCacheDirectory;
+}
+
 /*!
     \since 4.5
 
@@ -896,6 +1362,47 @@ bool QUiLoader::isTranslationEnabled() const
     return d->builder.trEnabled;
 }
 
+/*!
+    \since 6.5
+
+    If \a enabled is true, load() creates the contents of the pages of
+    QTabWidget, QStackedWidget and QToolBox containers other than the
+    current one only when the page is first shown. This speeds up loading
+    forms with many pages, such as settings dialogs.
+
+    The pages themselves are created when loading the form, with their
+    titles and icons, so that they can be found by name. Their child
+    widgets, layouts and actions do not exist until the page becomes the
+    current one. The connections and the tab order of the form involving
+    them are set up at that point, button groups are not supported. The
+    loader must still exist when a page is shown for the first time.
+
+    Lazy page creation is disabled by default.
+
+    \sa isLazyPageCreationEnabled()
+*/
+
+void QUiLoader::setLazyPageCreationEnabled(bool enabled)
+{
+    Q_D(QUiLoader);
+    d->builder.lazyPages = enabled;
+}
+
+/*!
+    \since 6.5
+
+    Returns true if the contents of pages are created when they are first
+    shown; returns false otherwise.
+
+    \sa setLazyPageCreationEnabled()
+*/
+
+bool QUiLoader::isLazyPageCreationEnabled() const
+{
+    Q_D(const QUiLoader);
+    return d->builder.lazyPages;
+}
+
 /*!
     Returns a human-readable description of the last error occurred in load().
 
@@ -42,12 +42,18 @@ public:
     void setWorkingDirectory(const QDir &dir);
     QDir workingDirectory() const;
 
+    void setFormCacheDirectory(const QString &directory);
+    QString formCacheDirectory() const;
+
     void setLanguageChangeEnabled(bool enabled);
     bool isLanguageChangeEnabled() const;
 
     void setTranslationEnabled(bool enabled);
     bool isTranslationEnabled() const;
 
+    void setLazyPageCreationEnabled(bool enabled);
+    bool isLazyPageCreationEnabled() const;
+
     QString errorString() const;
 
 private:
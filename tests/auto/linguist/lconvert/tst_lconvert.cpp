@@ -3,6 +3,8 @@
 
 #include <QtTest/QtTest>
 #include <QtCore/QFile>
+#include <QtCore/QTemporaryDir>
+#include <QtCore/QTextStream>
 
 class tst_lconvert : public QObject
 {
@@ -24,6 +26,9 @@ private slots:
     void chains_data();
     void chains();
     void merge();
+    void streams_data();
+    void streams();
+    void readXliffBenchmark();
 
 private:
     void doWait(QProcess *cvt, int stage);
@@ -317,6 +322,100 @@ void tst_lconvert::merge()
         doCompare(&cvt, dataDir + "idxmerge.ts.out");
 }
 
+void tst_lconvert::streams_data()
+{
+    QTest::addColumn<QString>("fileName");
+    QTest::addColumn<QStringList>("args");
+
+    QTest::newRow("ts") << "test20.ts" << QStringList();
+    QTest::newRow("message ids") << "msgid.ts" << QStringList();
+    QTest::newRow("length variants") << "variants.ts" << QStringList();
+    QTest::newRow("relative locations") << "relative.ts" << QStringList();
+    QTest::newRow("absolute locations") << "relative.ts" << QStringList({"-locations", "absolute"});
+    QTest::newRow("no-untranslated") << "untranslated.ts" << QStringList("-no-untranslated");
+    QTest::newRow("target language") << "test20.ts" << QStringList({"-target-language", "ru"});
+}
+
+// A TS to TS conversion of a named file is done context by context. Its
+// output must not differ from the one of the regular code path.
+void tst_lconvert::streams()
+{
+    QFETCH(QString, fileName);
+    QFETCH(QStringList, args);
+
+    QProcess streamed;
+    streamed.start(lconvert, QStringList(args) << (dataDir + fileName) << "-of" << "ts");
+    QVERIFY2(streamed.waitForStarted(), qPrintable(streamed.errorString()));
+    QVERIFY(streamed.waitForFinished(10000));
+
+    QProcess regular;
+    regular.setStandardInputFile(dataDir + fileName);
+    regular.start(lconvert, QStringList(args) << "-if" << "ts" << "-i" << "-" << "-of" << "ts");
+    QVERIFY2(regular.waitForStarted(), qPrintable(regular.errorString()));
+    QVERIFY(regular.waitForFinished(10000));
+
+    QCOMPARE(streamed.exitCode(), regular.exitCode());
+    QCOMPARE(streamed.readAllStandardError(), regular.readAllStandardError());
+    QCOMPARE(streamed.readAllStandardOutput(), regular.readAllStandardOutput());
+}
+
+// Measures how fast a large XLIFF file is read. The file is produced from a
+// synthetic TS file by lconvert itself.
+void tst_lconvert::readXliffBenchmark()
+{
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    const QString tsFileName = dir.filePath("large_de.ts");
+    const QString xlfFileName = dir.filePath("large_de.xlf");
+    const QString outFileName = dir.filePath("out_de.ts");
+
+    QFile tsFile(tsFileName);
+    QVERIFY(tsFile.open(QIODevice::WriteOnly | QIODevice::Text));
+    QTextStream ts(&tsFile);
+    ts << "<?xml version=\"1.0\" encoding=\"utf-8\"?>\n<!DOCTYPE TS>\n"
+          "<TS version=\"2.1\" language=\"de\">\n";
+    for (int c = 0; c < 200; ++c) {
+        ts << "<context>\n    <name>Context" << c << "</name>\n";
+        for (int m = 0; m < 100; ++m) {
+            const bool plural = m % 10 == 0;
+            ts << "    <message" << (plural ? " numerus=\"yes\"" : "") << ">\n"
+               << "        <location filename=\"src/file" << c << ".cpp\" line=\"" << m + 1
+               << "\"/>\n"
+               << "        <source>Source text number " << m << " in context " << c
+               << "</source>\n"
+               << "        <comment>Comment " << m << "</comment>\n"
+               << "        <extracomment>Extra comment " << m << "</extracomment>\n";
+            if (plural) {
+                ts << "        <translation>\n"
+                      "            <numerusform>Einzahl " << m << "</numerusform>\n"
+                      "            <numerusform>Mehrzahl " << m << "</numerusform>\n"
+                      "        </translation>\n";
+            } else {
+                ts << "        <translation>Übersetzung " << m << "</translation>\n";
+            }
+            ts << "    </message>\n";
+        }
+        ts << "</context>\n";
+    }
+    ts << "</TS>\n";
+    ts.flush();
+    tsFile.close();
+
+    QProcess toXliff;
+    toXliff.start(lconvert, QStringList() << tsFileName << "-o" << xlfFileName);
+    QVERIFY2(toXliff.waitForStarted(), qPrintable(toXliff.errorString()));
+    QVERIFY(toXliff.waitForFinished(60000));
+    QCOMPARE(toXliff.exitCode(), 0);
+
+    QBENCHMARK {
+        QProcess cvt;
+        cvt.start(lconvert, QStringList() << xlfFileName << "-o" << outFileName);
+        QVERIFY2(cvt.waitForStarted(), qPrintable(cvt.errorString()));
+        QVERIFY(cvt.waitForFinished(60000));
+        QCOMPARE(cvt.exitCode(), 0);
+    }
+}
+
 QTEST_APPLESS_MAIN(tst_lconvert)
 
 #include "tst_lconvert.moc"
@@ -27,6 +27,7 @@ private slots:
     void markuntranslated();
     void dupes();
     void noTranslations();
+    void parallel();
 
 private:
     void doCompare(const QStringList &actual, const QString &expectedFn);
@@ -194,5 +195,27 @@ void tst_lrelease::noTranslations()
     QVERIFY(stderrOutput.contains("lrelease warning: Met no 'TRANSLATIONS' entry in project file"));
 }
 
+void tst_lrelease::parallel()
+{
+    const QStringList tsFiles = { dataDir + "translate.ts", dataDir + "compressed.ts",
+                                  dataDir + "dupes.ts", dataDir + "idbased.ts" };
+
+    QProcess serial;
+    serial.start(lrelease, tsFiles);
+    QVERIFY(serial.waitForFinished());
+    QCOMPARE(serial.exitStatus(), QProcess::NormalExit);
+    QCOMPARE(serial.exitCode(), 0);
+
+    QProcess parallel;
+    parallel.start(lrelease, QStringList() << "-j" << "3" << tsFiles);
+    QVERIFY(parallel.waitForFinished());
+    QCOMPARE(parallel.exitStatus(), QProcess::NormalExit);
+    QCOMPARE(parallel.exitCode(), 0);
+
+    // The output is printed in the order of the files.
+    QCOMPARE(parallel.readAllStandardOutput(), serial.readAllStandardOutput());
+    QCOMPARE(parallel.readAllStandardError(), serial.readAllStandardError());
+}
+
 QTEST_MAIN(tst_lrelease)
 #include "tst_lrelease.moc"
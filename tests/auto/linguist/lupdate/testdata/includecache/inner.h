@@ -0,0 +1,9 @@
+// Copyright (C) 2023 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
+
+class Inner : public QObject
+{
+    Q_OBJECT
+public:
+    QString innerText() { return tr("inner message"); }
+};
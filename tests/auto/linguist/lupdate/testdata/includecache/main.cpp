@@ -0,0 +1,11 @@
+// Copyright (C) 2023 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
+
+#include "outer.h"
+
+class Main : public Outer
+{
+    Q_OBJECT
+public:
+    QString mainText() { return tr("main message"); }
+};
@@ -0,0 +1,11 @@
+// Copyright (C) 2023 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
+
+#include "inner.h"
+
+class Outer : public Inner
+{
+    Q_OBJECT
+public:
+    QString outerText() { return tr("outer message"); }
+};
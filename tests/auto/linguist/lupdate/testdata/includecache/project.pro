@@ -0,0 +1,4 @@
+SOURCES = main.cpp
+HEADERS = outer.h inner.h
+
+TRANSLATIONS = project.ts
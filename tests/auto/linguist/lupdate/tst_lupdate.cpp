@@ -11,6 +11,7 @@
 #include <QtCore/QFile>
 #include <QtCore/private/qconfig_p.h>
 #include <QtCore/QSet>
+#include <QtCore/QTemporaryDir>
 
 #include <QtTest/QtTest>
 #include <QtTools/private/qttools-config_p.h>
@@ -23,9 +24,18 @@ class tst_lupdate : public QObject
 public:
     tst_lupdate();
 
+    // How lupdate is run for a test row
+    enum RunMode {
+        Serial,
+        Parallel,   // with -j 4
+        Incremental // twice with the same -incremental manifest
+    };
+    Q_ENUM(RunMode)
+
 private slots:
     void good_data();
     void good();
+    void includeCache();
 #if CHECK_SIMTEXTH
     void simtexth();
     void simtexth_data();
@@ -37,6 +47,7 @@ private:
 
     void doCompare(QStringList actual, const QString &expectedFn, bool err);
     void doCompare(const QString &actualFn, const QString &expectedFn, bool err);
+    void runLupdate(const QString &workDir, const QStringList &arguments, QString *output);
 };
 
 
@@ -193,10 +204,29 @@ void tst_lupdate::doCompare(const QString &actualFn, const QString &expectedFn,
     doCompare(actual, expectedFn, err);
 }
 
+void tst_lupdate::runLupdate(const QString &workDir, const QStringList &arguments,
+                             QString *output)
+{
+    QProcess proc;
+    proc.setWorkingDirectory(workDir);
+    proc.setProcessChannelMode(QProcess::MergedChannels);
+    const QString command = m_cmdLupdate + ' ' + arguments.join(' ');
+    proc.start(m_cmdLupdate, arguments, QIODevice::ReadWrite | QIODevice::Text);
+    QVERIFY2(proc.waitForStarted(), qPrintable(command + QLatin1String(" :") + proc.errorString()));
+    QVERIFY2(proc.waitForFinished(30000), qPrintable(command));
+    *output = QString::fromLocal8Bit(proc.readAll());
+    QVERIFY2(proc.exitStatus() == QProcess::NormalExit,
+             qPrintable(QLatin1Char('"') + command + "\" crashed\n" + *output));
+    QVERIFY2(!proc.exitCode(),
+             qPrintable(QLatin1Char('"') + command + "\" exited with code " +
+             QString::number(proc.exitCode()) + '\n' + *output));
+}
+
 void tst_lupdate::good_data()
 {
     QTest::addColumn<QString>("directory");
     QTest::addColumn<bool>("useClangCpp");
+    QTest::addColumn<RunMode>("mode");
 
     QDir parsingDir(m_basePath + "good");
     QStringList dirs = parsingDir.entryList(QDir::Dirs | QDir::NoDotAndDotDot, QDir::Name);
@@ -216,7 +246,16 @@ void tst_lupdate::good_data()
     for (const QString &dir : dirs) {
         if (ignoredTests.contains(dir))
             continue;
-        QTest::newRow(dir.toLocal8Bit()) << dir << false;
+        QTest::newRow(dir.toLocal8Bit()) << dir << false << Serial;
+    }
+
+    // The built-in parsers must produce the same TS files in parallel and
+    // incrementally, also when the manifest of the previous run is reused.
+    for (const QString &dir : dirs) {
+        if (ignoredTests.contains(dir))
+            continue;
+        QTest::newRow("j4-" + dir.toLocal8Bit()) << dir << false << Parallel;
+        QTest::newRow("incremental-" + dir.toLocal8Bit()) << dir << false << Incremental;
     }
 
 #if QT_CONFIG(clangcpp) && QT_CONFIG(widgets)
@@ -237,7 +276,7 @@ void tst_lupdate::good_data()
     for (const QString &dir : dirs) {
         if (ignoredTests.contains(dir))
             continue;
-        QTest::newRow("clang-" + dir.toLocal8Bit()) << dir << true;
+        QTest::newRow("clang-" + dir.toLocal8Bit()) << dir << true << Serial;
     }
 #endif
 }
@@ -246,6 +285,7 @@ void tst_lupdate::good()
 {
     QFETCH(QString, directory);
     QFETCH(bool, useClangCpp);
+    QFETCH(RunMode, mode);
 
     QString dir = m_basePath + "good/" + directory;
     QString workDir = dir;
@@ -278,13 +318,18 @@ void tst_lupdate::good()
         file.close();
     }
 
-    for (const QString &ts : qAsConst(generatedtsfiles)) {
-        QString genTs = workDir + QLatin1Char('/') + ts;
-        QFile::remove(genTs);
-        QString beforetsfile = dir + QLatin1Char('/') + ts + QLatin1String(".before");
-        if (QFile::exists(beforetsfile))
-            QVERIFY2(QFile::copy(beforetsfile, genTs), qPrintable(beforetsfile));
-    }
+    const auto resetTsFiles = [&] {
+        for (const QString &ts : qAsConst(generatedtsfiles)) {
+            QString genTs = workDir + QLatin1Char('/') + ts;
+            QFile::remove(genTs);
+            QString beforetsfile = dir + QLatin1Char('/') + ts + QLatin1String(".before");
+            if (QFile::exists(beforetsfile))
+                QVERIFY2(QFile::copy(beforetsfile, genTs), qPrintable(beforetsfile));
+        }
+    };
+    resetTsFiles();
+    if (QTest::currentTestFailed())
+        return;
 
     file.setFileName(workDir + QStringLiteral("/.qmake.cache"));
     QVERIFY(file.open(QIODevice::WriteOnly));
@@ -296,41 +341,102 @@ void tst_lupdate::good()
     if (useClangCpp)
         lupdateArguments.append("-clang-parser");
 
-    QProcess proc;
-    proc.setWorkingDirectory(workDir);
-    proc.setProcessChannelMode(QProcess::MergedChannels);
-    const QString command = m_cmdLupdate + ' ' + lupdateArguments.join(' ');
-    proc.start(m_cmdLupdate, lupdateArguments, QIODevice::ReadWrite | QIODevice::Text);
-    QVERIFY2(proc.waitForStarted(), qPrintable(command + QLatin1String(" :") + proc.errorString()));
-    QVERIFY2(proc.waitForFinished(30000), qPrintable(command));
-    const QString output = QString::fromLocal8Bit(proc.readAll());
-    QVERIFY2(proc.exitStatus() == QProcess::NormalExit,
-             qPrintable(QLatin1Char('"') + command + "\" crashed\n" + output));
-    QVERIFY2(!proc.exitCode(),
-             qPrintable(QLatin1Char('"') + command + "\" exited with code " +
-             QString::number(proc.exitCode()) + '\n' + output));
-
-    // If the file expectedoutput.txt exists, compare the
-    // console output with the content of that file
-    QFile outfile(dir + "/expectedoutput.txt");
-    if (outfile.exists()) {
-        QStringList errslist = output.split(QLatin1Char('\n'));
-        doCompare(errslist, outfile.fileName(), true);
+    QTemporaryDir manifestDir;
+    int runs = 1;
+    if (mode == Parallel) {
+        lupdateArguments << QLatin1String("-j") << QLatin1String("4");
+    } else if (mode == Incremental) {
+        QVERIFY(manifestDir.isValid());
+        lupdateArguments << QLatin1String("-incremental")
+                         << manifestDir.filePath(QLatin1String("manifest"));
+        runs = 2;
+    }
+
+    for (int run = 0; run < runs; ++run) {
+        // The second incremental run starts from the same TS files, and takes
+        // the messages of the unchanged files from the manifest.
+        if (run > 0) {
+            resetTsFiles();
+            if (QTest::currentTestFailed())
+                return;
+        }
+
+        QString output;
+        runLupdate(workDir, lupdateArguments, &output);
         if (QTest::currentTestFailed())
             return;
-    }
 
-    for (const QString &ts : qAsConst(generatedtsfiles)) {
-        if (dir.endsWith("preprocess_clang_parser")) {
-            doCompare(workDir + QLatin1Char('/') + ts,
-                      dir + QLatin1Char('/') + ts + QLatin1String(".result"), true);
-        } else {
-        doCompare(workDir + QLatin1Char('/') + ts,
-                  dir + QLatin1Char('/') + ts + QLatin1String(".result"), false);
+        // If the file expectedoutput.txt exists, compare the
+        // console output with the content of that file. Messages about the
+        // files that are not parsed again, or are parsed in parallel, may
+        // come in another order or not at all in the other modes.
+        QFile outfile(dir + "/expectedoutput.txt");
+        if (mode == Serial && outfile.exists()) {
+            QStringList errslist = output.split(QLatin1Char('\n'));
+            doCompare(errslist, outfile.fileName(), true);
+            if (QTest::currentTestFailed())
+                return;
+        }
+
+        for (const QString &ts : qAsConst(generatedtsfiles)) {
+            if (dir.endsWith("preprocess_clang_parser")) {
+                doCompare(workDir + QLatin1Char('/') + ts,
+                          dir + QLatin1Char('/') + ts + QLatin1String(".result"), true);
+            } else {
+                doCompare(workDir + QLatin1Char('/') + ts,
+                          dir + QLatin1Char('/') + ts + QLatin1String(".result"), false);
+            }
+            if (QTest::currentTestFailed())
+                return;
         }
     }
 }
 
+/*
+    Runs lupdate twice with the same -include-cache on a copy of
+    testdata/includecache, where main.cpp includes outer.h, which
+    includes inner.h. inner.h is edited between the runs, so the cached
+    entries of both headers must not be used in the second run.
+*/
+void tst_lupdate::includeCache()
+{
+    QTemporaryDir tmp;
+    QVERIFY(tmp.isValid());
+    const QString dataDir = m_basePath + QLatin1String("includecache/");
+    const QString workDir = tmp.filePath(QLatin1String("project"));
+    QVERIFY(QDir().mkpath(workDir));
+    for (const QString &name : { QLatin1String("project.pro"), QLatin1String("main.cpp"),
+                                 QLatin1String("outer.h"), QLatin1String("inner.h") }) {
+        QVERIFY2(QFile::copy(dataDir + name, workDir + QLatin1Char('/') + name),
+                 qPrintable(dataDir + name));
+    }
+    QFile file(workDir + QStringLiteral("/.qmake.cache"));
+    QVERIFY(file.open(QIODevice::WriteOnly));
+    file.close();
+
+    const QStringList arguments = { QLatin1String("-silent"), QLatin1String("project.pro"),
+                                    QLatin1String("-include-cache"),
+                                    tmp.filePath(QLatin1String("cache")) };
+    const QString tsFile = workDir + QLatin1String("/project.ts");
+    QString output;
+    runLupdate(workDir, arguments, &output);
+    if (QTest::currentTestFailed())
+        return;
+    doCompare(tsFile, dataDir + QLatin1String("project.ts.result"), false);
+    if (QTest::currentTestFailed())
+        return;
+    QVERIFY(!QDir(tmp.filePath(QLatin1String("cache"))).isEmpty());
+
+    const QString innerHeader = workDir + QLatin1String("/inner.h");
+    QVERIFY(QFile::remove(innerHeader));
+    QVERIFY(QFile::copy(dataDir + QLatin1String("inner.h.changed"), innerHeader));
+    QVERIFY(QFile::remove(tsFile));
+    runLupdate(workDir, arguments, &output);
+    if (QTest::currentTestFailed())
+        return;
+    doCompare(tsFile, dataDir + QLatin1String("project.ts.changed.result"), false);
+}
+
 #if CHECK_SIMTEXTH
 void tst_lupdate::simtexth()
 {
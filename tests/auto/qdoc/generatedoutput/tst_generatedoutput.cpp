@@ -48,6 +48,7 @@ private slots:
     void singleExec();
     void preparePhase();
     void generatePhase();
+    void shardedGenerate();
     void noAutoList();
     void nestedMacro();
     void headerFile();
@@ -66,6 +67,7 @@ private:
 
     void runQDocProcess(const QStringList &arguments);
     void compareLineByLine(const QStringList &expectedFiles);
+    void compareDirectories(const QString &expectedPath, const QString &actualPath);
     void testAndCompare(const char *input, const char *outNames, const char *extraParams = nullptr,
                         const char *outputPathPrefix = nullptr);
     void copyIndexFiles();
@@ -185,6 +187,30 @@ void tst_generatedOutput::testAndCompare(const char *input, const char *outNames
     compareLineByLine(expectedOuts);
 }
 
+// Compare the files in actualPath, but not the hidden ones, with those in expectedPath
+void tst_generatedOutput::compareDirectories(const QString &expectedPath, const QString &actualPath)
+{
+    const auto listFiles = [](const QString &path) {
+        QStringList files;
+        QDirIterator it(path, QDir::Files, QDirIterator::Subdirectories);
+        while (it.hasNext())
+            files << QDir(path).relativeFilePath(it.next());
+        files.sort();
+        return files;
+    };
+    const QStringList files = listFiles(expectedPath);
+    QVERIFY(!files.isEmpty());
+    QCOMPARE(listFiles(actualPath), files);
+    for (const QString &file : files) {
+        QFile expectedFile(QDir(expectedPath).filePath(file));
+        QVERIFY2(expectedFile.open(QIODevice::ReadOnly), qPrintable(expectedFile.fileName()));
+        QFile actualFile(QDir(actualPath).filePath(file));
+        QVERIFY2(actualFile.open(QIODevice::ReadOnly), qPrintable(actualFile.fileName()));
+        QVERIFY2(actualFile.readAll() == expectedFile.readAll(),
+                 qPrintable(QStringLiteral("%1 differs from the unsharded output").arg(file)));
+    }
+}
+
 // Copy <project>.index to <project>/<project>.index in the outputdir
 void tst_generatedOutput::copyIndexFiles()
 {
@@ -465,6 +491,34 @@ void tst_generatedOutput::generatePhase()
                    "-generate");
 }
 
+void tst_generatedOutput::shardedGenerate()
+{
+    const QString config = QFINDTESTDATA("testdata/configs/testcpp.qdocconf");
+    QTemporaryDir unsharded;
+    QVERIFY(unsharded.isValid());
+    runQDocProcess({ "-outputdir", unsharded.path(), config, "-generate" });
+    if (QTest::currentTestFailed())
+        return;
+
+    // The second incremental run checks that no shard removes the pages
+    // of the other one, which are not in its own page manifest.
+    for (int run = 0; run < 2; ++run) {
+        for (const QString &shard : { QStringLiteral("0/2"), QStringLiteral("1/2") }) {
+            runQDocProcess({ "-outputdir", m_outputDir->path(), config, "-generate",
+                             "-incremental", "-shard", shard });
+            if (QTest::currentTestFailed())
+                return;
+        }
+        runQDocProcess({ "-outputdir", m_outputDir->path(), config, "-generate", "-incremental",
+                         "-merge-shards", "2" });
+        if (QTest::currentTestFailed())
+            return;
+        compareDirectories(unsharded.path(), m_outputDir->path());
+        if (QTest::currentTestFailed())
+            return;
+    }
+}
+
 void tst_generatedOutput::noAutoList()
 {
     testAndCompare("testdata/configs/noautolist.qdocconf",
@@ -330,3 +330,25 @@ TEST_CASE(
         QFileInfo{greatest_lower_bound.value() + "/" + relative_path}.canonicalFilePath()
     );
 }
+
+TEST_CASE(
+    "A query that is not in a canonical form is resolved to the file it represents",
+    "[ResolvingFiles][File][Path][Validation][SpecialCase]"
+) {
+    QTemporaryDir working_directory{};
+    REQUIRE(working_directory.isValid());
+
+    REQUIRE(QDir{working_directory.path()}.mkpath("foo/bar"));
+    REQUIRE(QFile{working_directory.path() + "/foo/file.txt"}.open(QIODeviceBase::ReadWrite | QIODeviceBase::NewOnly));
+
+    FileResolver file_resolver{std::vector{*DirectoryPath::refine(working_directory.path())}};
+
+    QString query = GENERATE(QString("foo/file.txt"), QString("./foo/file.txt"), QString("foo//file.txt"), QString("foo/bar/../file.txt"));
+    CAPTURE(query);
+
+    auto maybe_resolved_file{file_resolver.resolve(query)};
+
+    REQUIRE(maybe_resolved_file);
+    REQUIRE(maybe_resolved_file->get_query() == query);
+    REQUIRE(maybe_resolved_file->get_path() == QFileInfo{working_directory.path() + "/foo/file.txt"}.canonicalFilePath());
+}
@@ -25,6 +25,8 @@ private slots:
     void namespaceName();
     void registeredDocumentations();
     void registerDocumentation();
+    void registerDocumentations();
+    void registerDocumentationsFails();
     void unregisterDocumentation();
     void documentationFileName();
 
@@ -208,6 +210,75 @@ void tst_QHelpEngineCore::registerDocumentation()
     QSqlDatabase::removeDatabase("testdb");
 }
 
+void tst_QHelpEngineCore::registerDocumentations()
+{
+    if (QFile::exists(m_colFile))
+        QDir::current().remove(m_colFile);
+    {
+        QHelpEngineCore c(m_colFile);
+        c.setReadOnly(false);
+        QCOMPARE(c.setupData(), true);
+        QCOMPARE(c.registerDocumentations({ m_path + "/data/qmake-3.3.8.qch",
+                                            m_path + "/data/linguist-3.3.8.qch",
+                                            m_path + "/data/qmake-4.3.0.qch",
+                                            m_path + "/data/test.qch" }), true);
+        QStringList docs = c.registeredDocumentations();
+        docs.sort();
+        QCOMPARE(docs, QStringList({ "trolltech.com.1.0.0.test", "trolltech.com.3-3-8.linguist",
+                                     "trolltech.com.3-3-8.qmake", "trolltech.com.4-3-0.qmake" }));
+        QCOMPARE(c.documentationFileName("trolltech.com.4-3-0.qmake"),
+                 QFileInfo(m_path + "/data/qmake-4.3.0.qch").absoluteFilePath());
+
+        // The keywords of the files are registered with them.
+        QCOMPARE(c.documentsForKeyword("foobar").count(), 1);
+        QCOMPARE(c.documentsForKeyword("qmake Tutorial").count(), 1);
+
+        // A namespace that is registered already fails the registration.
+        QCOMPARE(c.registerDocumentations({ m_path + "/data/test.qch" }), false);
+        QCOMPARE(c.registeredDocumentations().count(), 4);
+    }
+
+    {
+        QSqlDatabase db = QSqlDatabase::addDatabase("QSQLITE", "testdb");
+        db.setDatabaseName(m_colFile);
+        if (!db.open()) {
+            QSqlDatabase::removeDatabase("testdb");
+            QFAIL("Created database seems to be corrupt!");
+        }
+        QSqlQuery query(db);
+        query.exec("SELECT FilePath FROM NamespaceTable WHERE "
+            "Name=\'trolltech.com.3-3-8.linguist\'");
+        if (query.next())
+            QCOMPARE(query.value(0).toString(),
+                QString("linguist-3.3.8.qch"));
+        else
+            QFAIL("Query error!");
+    }
+    QSqlDatabase::removeDatabase("testdb");
+}
+
+void tst_QHelpEngineCore::registerDocumentationsFails()
+{
+    if (QFile::exists(m_colFile))
+        QDir::current().remove(m_colFile);
+
+    QHelpEngineCore c(m_colFile);
+    c.setReadOnly(false);
+    QCOMPARE(c.setupData(), true);
+
+    // None of the files is registered if one of them cannot be.
+    QCOMPARE(c.registerDocumentations({ m_path + "/data/qmake-3.3.8.qch",
+                                        m_path + "/data/nonexisting.qch",
+                                        m_path + "/data/test.qch" }), false);
+    QVERIFY(!c.error().isEmpty());
+    QCOMPARE(c.registeredDocumentations().count(), 0);
+    QCOMPARE(c.documentsForKeyword("foobar").count(), 0);
+
+    QCOMPARE(c.registerDocumentations({ m_path + "/data/qmake-3.3.8.qch",
+                                        m_path + "/data/test.qch" }), true);
+    QCOMPARE(c.registeredDocumentations().count(), 2);
+}
+
 void tst_QHelpEngineCore::unregisterDocumentation()
 {
     QHelpEngineCore c(m_colFile);
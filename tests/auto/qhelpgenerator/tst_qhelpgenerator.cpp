@@ -3,11 +3,15 @@
 #include <QtTest/QtTest>
 
 #include <QtCore/QFileInfo>
+#include <QtCore/QRandomGenerator>
+#include <QtCore/QTemporaryDir>
+#include <QtHelp/QHelpEngineCore>
 #include <QtSql/QSqlDatabase>
 #include <QtSql/QSqlQuery>
 
 #include "../../../src/assistant/qhelpgenerator/qhelpprojectdata_p.h"
 #include "../../../src/assistant/qhelpgenerator/helpgenerator.h"
+#include "../shared/helpprojectwriter.h"
 
 class tst_QHelpGenerator : public QObject
 {
@@ -18,6 +22,8 @@ private slots:
     void generateHelp();
     // Check that two runs of the generator creates the same file twice
     void generateTwice();
+    void storeIncompressible_data();
+    void storeIncompressible();
 
 private:
     void checkNamespace();
@@ -196,5 +202,78 @@ void tst_QHelpGenerator::generateTwice()
     QCOMPARE(arr1, arr2);
 }
 
+void tst_QHelpGenerator::storeIncompressible_data()
+{
+    QTest::addColumn<bool>("storeIncompressible");
+
+    QTest::newRow("compressed") << false;
+    QTest::newRow("stored") << true;
+}
+
+// Files are read back the same whether they are stored compressed or as they are.
+void tst_QHelpGenerator::storeIncompressible()
+{
+    QFETCH(bool, storeIncompressible);
+
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    const QString path = dir.path();
+
+    QByteArray page = "<html><head><title>Page</title></head><body>\n";
+    for (int i = 0; i < 200; ++i)
+        page += "<p>The same paragraph, again and again.</p>\n";
+    page += "</body></html>\n";
+    QByteArray noise(64 * 1024, Qt::Uninitialized);
+    QRandomGenerator random(42);
+    for (char &c : noise)
+        c = char(random.bounded(256));
+
+    const QString projectFile =
+            writeHelpProject(path, QLatin1String("store"), QLatin1String("org.qt-project.storetest"),
+                             { { QLatin1String("page.html"), page },
+                               { QLatin1String("noise.bin"), noise } });
+    QVERIFY(!projectFile.isEmpty());
+
+    QHelpProjectData data;
+    QVERIFY(data.readData(projectFile));
+    const QString outputFile = path + QLatin1String("/store.qch");
+    HelpGenerator generator;
+    generator.setStoreIncompressibleFiles(storeIncompressible);
+    QVERIFY(generator.generate(&data, outputFile));
+
+    {
+        QSqlDatabase db = QSqlDatabase::addDatabase("QSQLITE", "storedb");
+        db.setDatabaseName(outputFile);
+        QVERIFY(db.open());
+        QSqlQuery query(db);
+        QVERIFY(query.exec("SELECT Value FROM MetaDataTable WHERE Name='qchVersion'"));
+        QVERIFY(query.next());
+        QCOMPARE(query.value(0).toString(),
+                 QLatin1String(storeIncompressible ? "1.1" : "1.0"));
+
+        // Only the file that does not get smaller is stored as it is.
+        const bool hasColumn = query.exec("SELECT a.Name, b.Compression FROM FileNameTable a, "
+                                          "FileDataTable b WHERE a.FileId=b.Id");
+        QCOMPARE(hasColumn, storeIncompressible);
+        if (hasColumn) {
+            QMap<QString, int> compression;
+            while (query.next())
+                compression.insert(query.value(0).toString(), query.value(1).toInt());
+            QCOMPARE(compression.value("page.html", -1), 0);
+            QCOMPARE(compression.value("noise.bin", -1), 1);
+        }
+    }
+    QSqlDatabase::removeDatabase("storedb");
+
+    QHelpEngineCore help(path + QLatin1String("/collection.qhc"));
+    help.setReadOnly(false);
+    QVERIFY(help.setupData());
+    QVERIFY2(help.registerDocumentation(outputFile), qPrintable(help.error()));
+    for (const auto &file : files) {
+        const QUrl url(QLatin1String("qthelp://org.qt-project.storetest/doc/") + file.first);
+        QCOMPARE(help.fileData(url), file.second);
+    }
+}
+
 QTEST_MAIN(tst_QHelpGenerator)
 #include "tst_qhelpgenerator.moc"
@@ -51,8 +51,16 @@ private slots:
 
     void setupIndex();
     void filter();
+    void filterMatchesScan_data();
+    void filterMatchesScan();
+    void filterUpdatesRows();
+    void bestMatch_data();
+    void bestMatch();
+    void wildcardFilter();
 
 private:
+    bool createIndex(QHelpEngine *helpEngine);
+
     QString m_colFile;
 };
 
@@ -128,5 +136,139 @@ void tst_QHelpIndexModel::filter()
     QCOMPARE(m->stringList().count(), 11);
 }
 
+bool tst_QHelpIndexModel::createIndex(QHelpEngine *helpEngine)
+{
+    helpEngine->setReadOnly(false);
+    QSignalSpy spy(helpEngine->indexModel(), &QHelpIndexModel::indexCreated);
+    helpEngine->setupData();
+    return spy.wait(5000);
+}
+
+void tst_QHelpIndexModel::filterMatchesScan_data()
+{
+    QTest::addColumn<QString>("filter");
+
+    QTest::newRow("short") << "fo";
+    QTest::newRow("prefix") << "foo";
+    QTest::newRow("inside") << "ake";
+    QTest::newRow("case") << "QMAKE";
+    QTest::newRow("words") << "qmake re";
+    QTest::newRow("apostrophe") << "qmake's";
+    QTest::newRow("single") << "e";
+    QTest::newRow("none") << "xyz";
+}
+
+// The keywords found with the search table are those a scan of all of them finds.
+void tst_QHelpIndexModel::filterMatchesScan()
+{
+    QFETCH(QString, filter);
+
+    QHelpEngine h(m_colFile, 0);
+    QVERIFY(createIndex(&h));
+    QHelpIndexModel *m = h.indexModel();
+    const QStringList all = m->stringList();
+    QCOMPARE(all.count(), 19);
+
+    QStringList expected;
+    for (const QString &keyword : all) {
+        if (keyword.contains(filter, Qt::CaseInsensitive))
+            expected.append(keyword);
+    }
+
+    m->filter(filter);
+    QCOMPARE(m->stringList(), expected);
+    QCOMPARE(m->rowCount(), expected.count());
+
+    m->filter(QString());
+    QCOMPARE(m->stringList(), all);
+}
+
+// Narrowing and widening the filter removes and inserts rows rather than resetting the model.
+void tst_QHelpIndexModel::filterUpdatesRows()
+{
+    QHelpEngine h(m_colFile, 0);
+    QVERIFY(createIndex(&h));
+    QHelpIndexModel *m = h.indexModel();
+    const QStringList all = m->stringList();
+
+    QSignalSpy resetSpy(m, &QAbstractItemModel::modelReset);
+    QSignalSpy removedSpy(m, &QAbstractItemModel::rowsRemoved);
+    QSignalSpy insertedSpy(m, &QAbstractItemModel::rowsInserted);
+
+    m->filter("fo");
+    QCOMPARE(m->stringList().count(), 3);
+    const QStringList fo = m->stringList();
+    QVERIFY(!removedSpy.isEmpty());
+    QVERIFY(insertedSpy.isEmpty());
+
+    removedSpy.clear();
+    m->filter("foo");
+    QCOMPARE(m->stringList().count(), 2);
+    QVERIFY(!removedSpy.isEmpty());
+    QVERIFY(insertedSpy.isEmpty());
+
+    removedSpy.clear();
+    m->filter("fo");
+    QCOMPARE(m->stringList(), fo);
+    QVERIFY(removedSpy.isEmpty());
+    QVERIFY(!insertedSpy.isEmpty());
+
+    insertedSpy.clear();
+    m->filter(QString());
+    QCOMPARE(m->stringList(), all);
+    QVERIFY(removedSpy.isEmpty());
+    QVERIFY(!insertedSpy.isEmpty());
+
+    QVERIFY(resetSpy.isEmpty());
+
+    // Replacing the rows by others resets the model.
+    m->filter("foo");
+    m->filter("qmake");
+    QCOMPARE(m->stringList().count(), 11);
+    QCOMPARE(resetSpy.count(), 1);
+}
+
+void tst_QHelpIndexModel::bestMatch_data()
+{
+    QTest::addColumn<QString>("filter");
+    QTest::addColumn<QString>("match");
+
+    QTest::newRow("equal") << "foo" << "foo";
+    QTest::newRow("case") << "FOO" << "foo";
+    QTest::newRow("prefix") << "foob" << "foobar";
+    QTest::newRow("words") << "qmake tutorial" << "qmake Tutorial";
+    QTest::newRow("inside") << "tutorial" << "qmake Tutorial";
+}
+
+void tst_QHelpIndexModel::bestMatch()
+{
+    QFETCH(QString, filter);
+    QFETCH(QString, match);
+
+    QHelpEngine h(m_colFile, 0);
+    QVERIFY(createIndex(&h));
+    QHelpIndexModel *m = h.indexModel();
+
+    const QModelIndex index = m->filter(filter);
+    QVERIFY(index.isValid());
+    QCOMPARE(index.data().toString(), match);
+}
+
+void tst_QHelpIndexModel::wildcardFilter()
+{
+    QHelpEngine h(m_colFile, 0);
+    QVERIFY(createIndex(&h));
+    QHelpIndexModel *m = h.indexModel();
+
+    m->filter("qmake", "*Reference");
+    QStringList keywords = m->stringList();
+    keywords.sort();
+    QCOMPARE(keywords, QStringList({ "qmake Function Reference", "qmake Reference",
+                                     "qmake Variable Reference" }));
+
+    m->filter("foo", "f*bar");
+    QCOMPARE(m->stringList(), QStringList("foobar"));
+}
+
 QTEST_MAIN(tst_QHelpIndexModel)
 #include "tst_qhelpindexmodel.moc"
@@ -0,0 +1,249 @@
+// Copyright (C) 2023 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
+#include <QtTest/QtTest>
+
+#include <QtCore/QFileInfo>
+#include <QtCore/QScopedPointer>
+#include <QtCore/QSet>
+#include <QtCore/QTemporaryDir>
+
+#include <QtHelp/QHelpEngineCore>
+#include <QtHelp/QHelpSearchEngine>
+#include <QtHelp/QHelpSearchResult>
+
+#include "../../../src/assistant/qhelpgenerator/qhelpprojectdata_p.h"
+#include "../../../src/assistant/qhelpgenerator/helpgenerator.h"
+#include "../shared/helpprojectwriter.h"
+
+class tst_QHelpSearchEngine : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+    void init();
+
+    void shardedSearch();
+    void shardedMatchesShared();
+    void cancelShardedSearch();
+    void replaceBrokenIndex();
+    void extractText_data();
+    void extractText();
+
+private:
+    QList<QHelpSearchResult> search(QHelpSearchEngine &engine, const QString &input);
+    bool reindex(QHelpSearchEngine &engine, bool sharded);
+
+    QTemporaryDir m_dir;
+    QString m_colFile;
+
+    QTemporaryDir m_extractDir;
+    QScopedPointer<QHelpEngineCore> m_extractHelp;
+    QScopedPointer<QHelpSearchEngine> m_extractEngine;
+};
+
+/*
+    Indexes, once for all rows of extractText(), a page with scripts,
+    entities and broken markup.
+*/
+void tst_QHelpSearchEngine::initTestCase()
+{
+    QVERIFY(m_extractDir.isValid());
+    const QString path = m_extractDir.path();
+
+    const QByteArray page =
+            "<html><head><title>Extraction &amp; Title</title>\n"
+            "<style>.styleword { color: red; }</style>\n"
+            "<script type=\"text/javascript\">var scriptword = 1 < 2;</script>\n"
+            "</head><body>\n"
+            "<p>plainword<!-- commentword --></p>\n"
+            "<p class=\"attributeword\" title='a > quotedword'>strayword < end</p>\n"
+            "<p>&#100;ecimalword &#x68;exword soft&shy;hyphenword a&nbsp;nbspword</p>\n"
+            "<p>&bogus; unknownword<b>bold <i unclosedtagword</p>\n"
+            "<p>afterword</p>\n"
+            "<p>last words <!-- unclosedcommentword\n"
+            "</body></html>\n";
+    const QString projectFile =
+            writeHelpProject(path, QLatin1String("extract"),
+                             QLatin1String("org.qt-project.extracttest"),
+                             { { QLatin1String("page.html"), page } });
+    QVERIFY(!projectFile.isEmpty());
+
+    QHelpProjectData data;
+    QVERIFY(data.readData(projectFile));
+    const QString qchFile = path + QLatin1String("/extract.qch");
+    HelpGenerator generator;
+    QVERIFY(generator.generate(&data, qchFile));
+
+    m_extractHelp.reset(new QHelpEngineCore(path + QLatin1String("/extract.qhc"), 0));
+    m_extractHelp->setReadOnly(false);
+    QVERIFY(m_extractHelp->setupData());
+    QVERIFY2(m_extractHelp->registerDocumentation(qchFile), qPrintable(m_extractHelp->error()));
+    m_extractEngine.reset(new QHelpSearchEngine(m_extractHelp.data()));
+    QVERIFY(reindex(*m_extractEngine, false));
+}
+
+void tst_QHelpSearchEngine::init()
+{
+    // defined in profile
+    const QString path = QFileInfo(QLatin1String(SRCDIR)).absoluteFilePath() + QLatin1String("/data/");
+
+    // The collection refers to its documentation files as "../data/<file>.qch"
+    // and the search index is written next to it, so work on a copy.
+    QVERIFY(m_dir.isValid());
+    const QString dataPath = m_dir.path() + QLatin1String("/data/");
+    QVERIFY(QDir().mkpath(dataPath));
+    m_colFile = dataPath + QLatin1String("col.qhc");
+    const QStringList files = { QLatin1String("qmake-3.3.8.qch"), QLatin1String("qmake-4.3.0.qch"),
+                                QLatin1String("test.qch") };
+    for (const QString &file : files) {
+        if (!QFile::exists(dataPath + file))
+            QVERIFY(QFile::copy(path + file, dataPath + file));
+    }
+    if (QFile::exists(m_colFile))
+        QVERIFY(QFile::remove(m_colFile));
+    if (!QFile::copy(path + QLatin1String("collection.qhc"), m_colFile))
+        QFAIL("Cannot copy file!");
+    QFile f(m_colFile);
+    f.setPermissions(QFile::WriteUser|QFile::ReadUser);
+}
+
+bool tst_QHelpSearchEngine::reindex(QHelpSearchEngine &engine, bool sharded)
+{
+    QSignalSpy spy(&engine, &QHelpSearchEngine::indexingFinished);
+    engine.setShardedIndexEnabled(sharded);
+    engine.reindexDocumentation();
+    return spy.wait(30000);
+}
+
+QList<QHelpSearchResult> tst_QHelpSearchEngine::search(QHelpSearchEngine &engine,
+                                                       const QString &input)
+{
+    QSignalSpy spy(&engine, &QHelpSearchEngine::searchingFinished);
+    engine.search(input);
+    if (!spy.wait(30000))
+        return {};
+    return engine.searchResults(0, engine.searchResultCount());
+}
+
+void tst_QHelpSearchEngine::shardedSearch()
+{
+    QHelpEngineCore help(m_colFile, 0);
+    QVERIFY(help.setupData());
+    QHelpSearchEngine engine(&help);
+    QVERIFY(reindex(engine, true));
+
+    const QList<QHelpSearchResult> results = search(engine, QLatin1String("qmake"));
+    QVERIFY(!results.isEmpty());
+
+    // Every page is listed once, even when both its title and its contents match,
+    // and the hits of all shards are merged.
+    QSet<QUrl> urls;
+    QSet<QString> namespaces;
+    for (const QHelpSearchResult &result : results) {
+        QVERIFY2(!urls.contains(result.url()), qPrintable(result.url().toString()));
+        urls.insert(result.url());
+        namespaces.insert(result.url().authority());
+    }
+    QVERIFY(namespaces.contains(QLatin1String("trolltech.com.3-3-8.qmake")));
+    QVERIFY(namespaces.contains(QLatin1String("trolltech.com.4-3-0.qmake")));
+}
+
+void tst_QHelpSearchEngine::shardedMatchesShared()
+{
+    QHelpEngineCore help(m_colFile, 0);
+    QVERIFY(help.setupData());
+    QHelpSearchEngine engine(&help);
+
+    QVERIFY(reindex(engine, false));
+    QSet<QUrl> shared;
+    for (const QHelpSearchResult &result : search(engine, QLatin1String("qmake")))
+        shared.insert(result.url());
+    QVERIFY(!shared.isEmpty());
+
+    QVERIFY(reindex(engine, true));
+    QSet<QUrl> sharded;
+    for (const QHelpSearchResult &result : search(engine, QLatin1String("qmake")))
+        sharded.insert(result.url());
+    QCOMPARE(sharded, shared);
+}
+
+void tst_QHelpSearchEngine::cancelShardedSearch()
+{
+    QHelpEngineCore help(m_colFile, 0);
+    QVERIFY(help.setupData());
+    QHelpSearchEngine engine(&help);
+    QVERIFY(reindex(engine, true));
+
+    // Depending on how far the search got, cancelling it may or may not end
+    // it with searchingFinished(), but a later search is never affected.
+    engine.search(QLatin1String("qmake"));
+    engine.cancelSearching();
+    QVERIFY(!search(engine, QLatin1String("qmake")).isEmpty());
+}
+
+void tst_QHelpSearchEngine::replaceBrokenIndex()
+{
+    QHelpEngineCore help(m_colFile, 0);
+    QVERIFY(help.setupData());
+    QHelpSearchEngine engine(&help);
+    QVERIFY(reindex(engine, false));
+
+    // An index file that cannot be read is built again, even though the
+    // collection still lists its namespaces as indexed, and so is a new
+    // index left behind by an indexing that did not finish.
+    const QString indexPath = m_dir.path() + QLatin1String("/data/.col/fts");
+    for (const QString &fileName : { indexPath, indexPath + QLatin1String(".new") }) {
+        QFile f(fileName);
+        QVERIFY(f.open(QIODevice::WriteOnly | QIODevice::Truncate));
+        f.write(QByteArray(8192, 'x'));
+    }
+    QSignalSpy spy(&engine, &QHelpSearchEngine::indexingFinished);
+    engine.scheduleIndexDocumentation();
+    QVERIFY(spy.wait(30000));
+
+    QVERIFY(!search(engine, QLatin1String("qmake")).isEmpty());
+    QVERIFY(!QFile::exists(indexPath + QLatin1String(".new")));
+}
+
+void tst_QHelpSearchEngine::extractText_data()
+{
+    QTest::addColumn<QString>("word");
+    QTest::addColumn<bool>("found");
+
+    QTest::newRow("text") << "plainword" << true;
+    QTest::newRow("script") << "scriptword" << false;
+    QTest::newRow("style") << "styleword" << false;
+    QTest::newRow("comment") << "commentword" << false;
+    QTest::newRow("attribute") << "attributeword" << false;
+    QTest::newRow("quoted >") << "quotedword" << false;
+    QTest::newRow("stray <") << "strayword" << true;
+    QTest::newRow("decimal entity") << "decimalword" << true;
+    QTest::newRow("hex entity") << "hexword" << true;
+    QTest::newRow("soft hyphen") << "softhyphenword" << true;
+    QTest::newRow("nbsp") << "nbspword" << true;
+    QTest::newRow("unknown entity") << "unknownword" << true;
+    QTest::newRow("unclosed tag") << "unclosedtagword" << false;
+    QTest::newRow("after unclosed tag") << "afterword" << true;
+    QTest::newRow("unclosed comment") << "unclosedcommentword" << false;
+}
+
+/*
+    Checks which words of the page indexed in initTestCase() can be found:
+    those of its text, and none of its tags, attribute values, scripts,
+    style sheets and comments. A tag that is not closed runs up to the
+    next greater-than sign.
+*/
+void tst_QHelpSearchEngine::extractText()
+{
+    QFETCH(QString, word);
+    QFETCH(bool, found);
+
+    const QList<QHelpSearchResult> results = search(*m_extractEngine, word);
+    QCOMPARE(!results.isEmpty(), found);
+    if (found)
+        QCOMPARE(results.constFirst().title(), QLatin1String("Extraction &amp; Title"));
+}
+
+QTEST_MAIN(tst_QHelpSearchEngine)
+#include "tst_qhelpsearchengine.moc"
@@ -5,9 +5,12 @@
 #include <QtCore/qdebug.h>
 #include <QtCore/qfile.h>
 #include <QtCore/qbytearray.h>
+#include <QtCore/qjsonarray.h>
 #include <QtCore/qjsondocument.h>
+#include <QtCore/qjsonobject.h>
 #include <QtCore/qlibraryinfo.h>
 #include <QtCore/qprocess.h>
+#include <QtCore/qtemporarydir.h>
 
 #include <QtTest/qtest.h>
 
@@ -23,6 +26,8 @@ private slots:
 
 private:
     void readExpectedFile(const QString &baseDir, const QString &fileName, QByteArray *content);
+    void scan(const QString &dir, const QStringList &arguments, const QString &stdout_file,
+              const QString &stderr_file, const QStringList &excluded);
 
     QString m_cmd;
     QString m_basePath;
@@ -42,26 +47,48 @@ void tst_qtattributionsscanner::test_data()
     QTest::addColumn<QString>("input");
     QTest::addColumn<QString>("stdout_file");
     QTest::addColumn<QString>("stderr_file");
+    // Extra arguments; %{CACHE} is replaced with a file in a temporary directory
+    QTest::addColumn<QStringList>("extra_arguments");
+    // Directories below input whose packages are removed from the expected output
+    QTest::addColumn<QStringList>("excluded");
+    // Number of times the scanner is run with the same arguments
+    QTest::addColumn<int>("runs");
 
     QTest::newRow("good")
             << QStringLiteral("good")
             << QStringLiteral("good/expected.json")
-            << QStringLiteral("good/expected.error");
+            << QStringLiteral("good/expected.error") << QStringList() << QStringList() << 1;
     QTest::newRow("warnings (incomplete)")
             << QStringLiteral("warnings/incomplete")
             << QStringLiteral("warnings/incomplete/expected.json")
-            << QStringLiteral("warnings/incomplete/expected.error");
+            << QStringLiteral("warnings/incomplete/expected.error") << QStringList()
+            << QStringList() << 1;
     QTest::newRow("warnings (unknown attribute)")
             << QStringLiteral("warnings/unknown")
             << QStringLiteral("warnings/unknown/expected.json")
-            << QStringLiteral("warnings/unknown/expected.error");
+            << QStringLiteral("warnings/unknown/expected.error") << QStringList()
+            << QStringList() << 1;
     QTest::newRow("singlefile")
             << QStringLiteral("good/minimal/qt_attribution_test.json")
             << QStringLiteral("good/minimal/expected.json")
-            << QStringLiteral("good/minimal/expected.error");
+            << QStringLiteral("good/minimal/expected.error") << QStringList() << QStringList()
+            << 1;
     QTest::newRow("variants") << QStringLiteral("good/variants/qt_attribution_test.json")
                               << QStringLiteral("good/variants/expected.json")
-                              << QStringLiteral("good/variants/expected.error");
+                              << QStringLiteral("good/variants/expected.error")
+                              << QStringList() << QStringList() << 1;
+    QTest::newRow("exclude")
+            << QStringLiteral("good")
+            << QStringLiteral("good/expected.json")
+            << QStringLiteral("good/expected.error")
+            << QStringList{ "--exclude", "chromium", "--exclude", "complete" }
+            << QStringList{ "chromium", "complete" } << 1;
+    // The second run takes the results of the unchanged files from the cache
+    QTest::newRow("cache")
+            << QStringLiteral("good")
+            << QStringLiteral("good/expected.json")
+            << QStringLiteral("good/expected.error")
+            << QStringList{ "--cache", "%{CACHE}" } << QStringList() << 2;
 }
 
 void tst_qtattributionsscanner::readExpectedFile(const QString &baseDir, const QString &fileName, QByteArray *content)
@@ -77,13 +104,33 @@ void tst_qtattributionsscanner::test()
     QFETCH(QString, input);
     QFETCH(QString, stdout_file);
     QFETCH(QString, stderr_file);
+    QFETCH(QStringList, extra_arguments);
+    QFETCH(QStringList, excluded);
+    QFETCH(int, runs);
 
     QString dir = QDir(m_basePath).absoluteFilePath(input);
     if (QFileInfo(dir).isFile())
         dir = QFileInfo(dir).absolutePath();
 
+    QTemporaryDir cacheDir;
+    QVERIFY(cacheDir.isValid());
+    QStringList arguments{dir, "--output-format", "json"};
+    for (const QString &argument : qAsConst(extra_arguments)) {
+        arguments << QString(argument).replace(QLatin1String("%{CACHE}"),
+                                               cacheDir.filePath(QLatin1String("cache")));
+    }
+    for (int run = 0; run < runs; ++run) {
+        scan(dir, arguments, stdout_file, stderr_file, excluded);
+        if (QTest::currentTestFailed())
+            return;
+    }
+}
+
+void tst_qtattributionsscanner::scan(const QString &dir, const QStringList &arguments,
+                                     const QString &stdout_file, const QString &stderr_file,
+                                     const QStringList &excluded)
+{
     QProcess proc;
-    const QStringList arguments{dir, "--output-format", "json"};
     QString command = m_cmd + ' ' + arguments.join(' ');
     QProcessEnvironment env = QProcessEnvironment::systemEnvironment();
     env.insert("QT_ATTRIBUTIONSSCANNER_TEST", "1");
@@ -119,6 +166,19 @@ void tst_qtattributionsscanner::test()
         QByteArray expectedOutput;
         readExpectedFile(dir, stdout_file, &expectedOutput);
         QJsonDocument expectedJson = QJsonDocument::fromJson(expectedOutput);
+        if (!excluded.isEmpty()) {
+            QJsonArray packages = expectedJson.array();
+            for (qsizetype i = packages.size() - 1; i >= 0; --i) {
+                const QString path = packages.at(i).toObject().value(QLatin1String("Path")).toString();
+                for (const QString &excludedDir : excluded) {
+                    if (path == dir + QLatin1Char('/') + excludedDir) {
+                        packages.removeAt(i);
+                        break;
+                    }
+                }
+            }
+            expectedJson.setArray(packages);
+        }
 
         if (!QTest::qCompare(actualJson, expectedJson, "actualJson", "expectedJson", __FILE__, __LINE__)) {
             qWarning() << "Actual (actualJson)    :" << actualJson;
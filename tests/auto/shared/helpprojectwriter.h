@@ -0,0 +1,54 @@
+// Copyright (C) 2023 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
+#ifndef HELPPROJECTWRITER_H
+#define HELPPROJECTWRITER_H
+
+#include <QtCore/QByteArray>
+#include <QtCore/QFile>
+#include <QtCore/QList>
+#include <QtCore/QPair>
+#include <QtCore/QString>
+
+QT_BEGIN_NAMESPACE
+
+using HelpProjectFiles = QList<QPair<QString, QByteArray>>;
+
+/*
+    Writes \a files into \a dir, and a help project \a projectName.qhp
+    with the namespace \a nameSpace that lists them in one filter section.
+    Returns the path of the help project, or an empty string if a file
+    cannot be written.
+*/
+inline QString writeHelpProject(const QString &dir, const QString &projectName,
+                                const QString &nameSpace, const HelpProjectFiles &files)
+{
+    QByteArray fileList;
+    for (const auto &file : files) {
+        QFile f(dir + QLatin1Char('/') + file.first);
+        if (!f.open(QIODevice::WriteOnly) || f.write(file.second) != file.second.size())
+            return QString();
+        fileList += "            <file>" + file.first.toUtf8() + "</file>\n";
+    }
+
+    const QString projectFile = dir + QLatin1Char('/') + projectName + QLatin1String(".qhp");
+    QFile f(projectFile);
+    if (!f.open(QIODevice::WriteOnly))
+        return QString();
+    const QByteArray project = "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+                               "<QtHelpProject version=\"1.0\">\n"
+                               "    <namespace>" + nameSpace.toUtf8() + "</namespace>\n"
+                               "    <virtualFolder>doc</virtualFolder>\n"
+                               "    <filterSection>\n"
+                               "        <files>\n"
+                               + fileList +
+                               "        </files>\n"
+                               "    </filterSection>\n"
+                               "</QtHelpProject>\n";
+    if (f.write(project) != project.size())
+        return QString();
+    return projectFile;
+}
+
+QT_END_NAMESPACE
+
+#endif // HELPPROJECTWRITER_H
@@ -0,0 +1,299 @@
+// Copyright (C) 2023 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
+
+#include <QtTest/QtTest>
+#include <QtCore/QBuffer>
+#include <QtCore/QHash>
+#include <QtCore/QXmlStreamWriter>
+
+#include <QtDesigner/QDesignerComponents>
+#include <QtDesigner/QFormBuilder>
+#include <QtDesigner/abstractformeditor.h>
+#include <QtDesigner/abstractformwindow.h>
+#include <QtDesigner/abstractformwindowmanager.h>
+#include <QtDesigner/abstractobjectinspector.h>
+#include <QtDesigner/abstractwidgetbox.h>
+#include <QtDesigner/propertysheet.h>
+#include <QtDesigner/qextensionmanager.h>
+
+#include <QtUiTools/QUiLoader>
+
+#include <QtWidgets/QWidget>
+
+/*
+    Measures loading forms with QFormBuilder and QUiLoader, loading and
+    saving them in a Designer form window, creating the property sheets
+    of their widgets and populating the object inspector with them.
+
+    The forms are generated and have 100, 1000 and 10000 widgets. Set
+    QT_DESIGNER_TRACE_LOAD to see how a load in the form window is split
+    between its phases.
+*/
+class tst_bench_designer : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+    void cleanupTestCase();
+    void formBuilderLoad_data();
+    void formBuilderLoad();
+    void uiLoaderLoad_data();
+    void uiLoaderLoad();
+    void designerLoad_data();
+    void designerLoad();
+    void designerSave_data();
+    void designerSave();
+    void propertySheets_data();
+    void propertySheets();
+    void objectInspector_data();
+    void objectInspector();
+
+private:
+    const QByteArray &form(int widgetCount);
+    void loadFormWindow(int widgetCount);
+
+    QDesignerFormEditorInterface *core = nullptr;
+    QDesignerFormWindowInterface *formWindow = nullptr;
+    QHash<int, QByteArray> forms;
+};
+
+// The classes the group boxes of a form are filled with
+static const char *const widgetClasses[] = {
+    "QLabel", "QLineEdit", "QPushButton", "QCheckBox", "QComboBox",
+    "QSpinBox", "QRadioButton", "QSlider", "QTextEdit"
+};
+static const int widgetsPerGroup = int(sizeof(widgetClasses) / sizeof(widgetClasses[0]));
+
+static void addWidgetCounts()
+{
+    QTest::addColumn<int>("widgetCount");
+    QTest::newRow("100") << 100;
+    QTest::newRow("1000") << 1000;
+    QTest::newRow("10000") << 10000;
+}
+
+static void writeProperty(QXmlStreamWriter &xml, const char *name, const char *type,
+                          const QString &value)
+{
+    xml.writeStartElement(QLatin1StringView("property"));
+    xml.writeAttribute(QLatin1StringView("name"), QLatin1StringView(name));
+    xml.writeTextElement(QLatin1StringView(type), value);
+    xml.writeEndElement();
+}
+
+// A form of about \a widgetCount widgets: group boxes in a vertical layout,
+// each holding one widget of every class above in a grid layout.
+static QByteArray generateForm(int widgetCount)
+{
+    QByteArray data;
+    QXmlStreamWriter xml(&data);
+    xml.setAutoFormatting(true);
+    xml.writeStartDocument();
+    xml.writeStartElement(QLatin1StringView("ui"));
+    xml.writeAttribute(QLatin1StringView("version"), QLatin1StringView("4.0"));
+    xml.writeTextElement(QLatin1StringView("class"), QLatin1StringView("Form"));
+    xml.writeStartElement(QLatin1StringView("widget"));
+    xml.writeAttribute(QLatin1StringView("class"), QLatin1StringView("QWidget"));
+    xml.writeAttribute(QLatin1StringView("name"), QLatin1StringView("Form"));
+    xml.writeStartElement(QLatin1StringView("layout"));
+    xml.writeAttribute(QLatin1StringView("class"), QLatin1StringView("QVBoxLayout"));
+    xml.writeAttribute(QLatin1StringView("name"), QLatin1StringView("verticalLayout"));
+
+    const int groupCount = qMax(1, widgetCount / (widgetsPerGroup + 1));
+    for (int group = 0; group < groupCount; ++group) {
+        xml.writeStartElement(QLatin1StringView("item"));
+        xml.writeStartElement(QLatin1StringView("widget"));
+        xml.writeAttribute(QLatin1StringView("class"), QLatin1StringView("QGroupBox"));
+        xml.writeAttribute(QLatin1StringView("name"), QString::fromLatin1("groupBox%1").arg(group));
+        writeProperty(xml, "title", "string", QString::fromLatin1("Group %1").arg(group));
+        xml.writeStartElement(QLatin1StringView("layout"));
+        xml.writeAttribute(QLatin1StringView("class"), QLatin1StringView("QGridLayout"));
+        xml.writeAttribute(QLatin1StringView("name"), QString::fromLatin1("gridLayout%1").arg(group));
+        for (int i = 0; i < widgetsPerGroup; ++i) {
+            xml.writeStartElement(QLatin1StringView("item"));
+            xml.writeAttribute(QLatin1StringView("row"), QString::number(i / 3));
+            xml.writeAttribute(QLatin1StringView("column"), QString::number(i % 3));
+            xml.writeStartElement(QLatin1StringView("widget"));
+            xml.writeAttribute(QLatin1StringView("class"), QLatin1StringView(widgetClasses[i]));
+            xml.writeAttribute(QLatin1StringView("name"),
+                               QString::fromLatin1("widget%1_%2").arg(group).arg(i));
+            writeProperty(xml, "toolTip", "string",
+                          QString::fromLatin1("Widget %1 of group %2").arg(i).arg(group));
+            xml.writeEndElement(); // widget
+            xml.writeEndElement(); // item
+        }
+        xml.writeEndElement(); // layout
+        xml.writeEndElement(); // widget
+        xml.writeEndElement(); // item
+    }
+
+    xml.writeEndElement(); // layout
+    xml.writeEndElement(); // widget
+    xml.writeEmptyElement(QLatin1StringView("resources"));
+    xml.writeEmptyElement(QLatin1StringView("connections"));
+    xml.writeEndElement(); // ui
+    xml.writeEndDocument();
+    return data;
+}
+
+const QByteArray &tst_bench_designer::form(int widgetCount)
+{
+    auto it = forms.find(widgetCount);
+    if (it == forms.end())
+        it = forms.insert(widgetCount, generateForm(widgetCount));
+    return it.value();
+}
+
+void tst_bench_designer::loadFormWindow(int widgetCount)
+{
+    QBuffer buffer;
+    buffer.setData(form(widgetCount));
+    QVERIFY(buffer.open(QIODevice::ReadOnly));
+    QString errorMessage;
+    QVERIFY2(formWindow->setContents(&buffer, &errorMessage), qPrintable(errorMessage));
+}
+
+void tst_bench_designer::initTestCase()
+{
+    QDesignerComponents::initializeResources();
+    core = QDesignerComponents::createFormEditor(this);
+    (void) QDesignerComponents::createTaskMenu(core, this);
+    QDesignerComponents::initializePlugins(core);
+
+    // Tool windows the form window reports to, as in Designer
+    core->setWidgetBox(QDesignerComponents::createWidgetBox(core, nullptr));
+    core->setObjectInspector(QDesignerComponents::createObjectInspector(core, nullptr));
+
+    formWindow = core->formWindowManager()->createFormWindow(nullptr, Qt::WindowFlags());
+    QVERIFY(formWindow);
+}
+
+void tst_bench_designer::cleanupTestCase()
+{
+    delete formWindow;
+    formWindow = nullptr;
+    delete core->objectInspector();
+    delete core->widgetBox();
+}
+
+void tst_bench_designer::formBuilderLoad_data()
+{
+    addWidgetCounts();
+}
+
+void tst_bench_designer::formBuilderLoad()
+{
+    QFETCH(int, widgetCount);
+    QBuffer buffer;
+    buffer.setData(form(widgetCount));
+    QVERIFY(buffer.open(QIODevice::ReadOnly));
+
+    QFormBuilder builder;
+    QBENCHMARK {
+        buffer.seek(0);
+        QWidget *widget = builder.load(&buffer);
+        QVERIFY2(widget, qPrintable(builder.errorString()));
+        delete widget;
+    }
+}
+
+void tst_bench_designer::uiLoaderLoad_data()
+{
+    addWidgetCounts();
+}
+
+void tst_bench_designer::uiLoaderLoad()
+{
+    QFETCH(int, widgetCount);
+    QBuffer buffer;
+    buffer.setData(form(widgetCount));
+    QVERIFY(buffer.open(QIODevice::ReadOnly));
+
+    QUiLoader loader;
+    QBENCHMARK {
+        buffer.seek(0);
+        QWidget *widget = loader.load(&buffer);
+        QVERIFY2(widget, qPrintable(loader.errorString()));
+        delete widget;
+    }
+}
+
+void tst_bench_designer::designerLoad_data()
+{
+    addWidgetCounts();
+}
+
+void tst_bench_designer::designerLoad()
+{
+    QFETCH(int, widgetCount);
+    QBENCHMARK {
+        loadFormWindow(widgetCount);
+    }
+}
+
+void tst_bench_designer::designerSave_data()
+{
+    addWidgetCounts();
+}
+
+void tst_bench_designer::designerSave()
+{
+    QFETCH(int, widgetCount);
+    loadFormWindow(widgetCount);
+
+    QString contents;
+    QBENCHMARK {
+        contents = formWindow->contents();
+    }
+    QVERIFY(!contents.isEmpty());
+}
+
+void tst_bench_designer::propertySheets_data()
+{
+    addWidgetCounts();
+}
+
+// The sheets are cached per object, so only the first query for each widget
+// of a freshly loaded form creates one.
+void tst_bench_designer::propertySheets()
+{
+    QFETCH(int, widgetCount);
+    QBuffer buffer;
+    buffer.setData(form(widgetCount));
+    QVERIFY(buffer.open(QIODevice::ReadOnly));
+    QFormBuilder builder;
+    QScopedPointer<QWidget> widget(builder.load(&buffer));
+    QVERIFY2(widget, qPrintable(builder.errorString()));
+    const QList<QWidget *> widgets = widget->findChildren<QWidget *>();
+
+    QExtensionManager *manager = core->extensionManager();
+    int count = 0;
+    QBENCHMARK_ONCE {
+        for (QWidget *child : widgets) {
+            if (qt_extension<QDesignerPropertySheetExtension *>(manager, child))
+                ++count;
+        }
+    }
+    QCOMPARE(count, int(widgets.size()));
+}
+
+void tst_bench_designer::objectInspector_data()
+{
+    addWidgetCounts();
+}
+
+void tst_bench_designer::objectInspector()
+{
+    QFETCH(int, widgetCount);
+    loadFormWindow(widgetCount);
+
+    QDesignerObjectInspectorInterface *objectInspector = core->objectInspector();
+    QBENCHMARK {
+        objectInspector->setFormWindow(nullptr);
+        objectInspector->setFormWindow(formWindow);
+    }
+}
+
+QTEST_MAIN(tst_bench_designer)
+#include "tst_bench_designer.moc"
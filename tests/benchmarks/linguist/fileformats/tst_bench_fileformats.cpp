@@ -0,0 +1,290 @@
+// Copyright (C) 2023 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
+
+#include "translator.h"
+
+#include <QtTest/QtTest>
+#include <QtCore/QBuffer>
+#include <QtCore/QFile>
+#include <QtCore/QLibraryInfo>
+#include <QtCore/QProcess>
+#include <QtCore/QTemporaryDir>
+#include <QtCore/QTextStream>
+
+/*
+    Measures loading, saving, releasing and merging of synthetic catalogs.
+
+    The catalogs have 10k and 100k messages, set QT_LINGUIST_BENCHMARK_HUGE
+    to add 1M. On Linux the peak memory of each in-process benchmark is
+    printed as well.
+*/
+class tst_bench_fileformats : public QObject
+{
+    Q_OBJECT
+
+public:
+    tst_bench_fileformats()
+        : binDir(QLibraryInfo::path(QLibraryInfo::BinariesPath)) {}
+
+private slots:
+    void initTestCase();
+    void load_data();
+    void load();
+    void save_data();
+    void save();
+    void release_data();
+    void release();
+    void merge_data();
+    void merge();
+
+private:
+    void addSizes();
+    void addFormatsAndSizes();
+    QString catalogFile(int messageCount, const QString &format);
+
+    QTemporaryDir workDir;
+    const QString binDir;
+    QHash<int, Translator> catalogs;
+    QSet<QString> writtenFiles;
+};
+
+static const char *const formats[] = { "ts", "qm", "po", "xlf", "qph" };
+
+static void resetPeakMemory()
+{
+#ifdef Q_OS_LINUX
+    // Writing 5 resets the peak resident set size of the process.
+    QFile clearRefs(QStringLiteral("/proc/self/clear_refs"));
+    if (clearRefs.open(QIODevice::WriteOnly))
+        clearRefs.write("5");
+#endif
+}
+
+static void reportPeakMemory()
+{
+#ifdef Q_OS_LINUX
+    QFile status(QStringLiteral("/proc/self/status"));
+    if (!status.open(QIODevice::ReadOnly | QIODevice::Text))
+        return;
+    while (!status.atEnd()) {
+        const QByteArray line = status.readLine();
+        if (line.startsWith("VmHWM:")) {
+            qInfo("Peak memory: %s", line.mid(6).trimmed().constData());
+            return;
+        }
+    }
+#endif
+}
+
+// One context per 100 messages. Every tenth message has plural forms, every
+// third one a comment, and all have an extra comment and a location.
+static Translator makeCatalog(int messageCount)
+{
+    Translator tor;
+    tor.setLanguageCode(QStringLiteral("de"));
+    for (int i = 0; i < messageCount; ++i) {
+        const int context = i / 100;
+        const bool plural = i % 10 == 0;
+        QStringList translations;
+        translations << QStringLiteral("Übersetzung %1").arg(i);
+        if (plural)
+            translations << QStringLiteral("Übersetzungen %1").arg(i);
+        TranslatorMessage msg(QStringLiteral("Context%1").arg(context),
+                              QStringLiteral("Source text number %1 with %n item(s)").arg(i),
+                              i % 3 == 0 ? QStringLiteral("Comment %1").arg(i) : QString(),
+                              QString(),
+                              QStringLiteral("src/file%1.cpp").arg(context), i % 100 + 1,
+                              translations,
+                              i % 7 == 0 ? TranslatorMessage::Unfinished
+                                         : TranslatorMessage::Finished,
+                              plural);
+        msg.setExtraComment(QStringLiteral("Extra comment %1").arg(i));
+        tor.append(msg);
+    }
+    return tor;
+}
+
+void tst_bench_fileformats::initTestCase()
+{
+    QVERIFY(workDir.isValid());
+}
+
+void tst_bench_fileformats::addSizes()
+{
+    QTest::addColumn<int>("messageCount");
+
+    QList<int> sizes = { 10000, 100000 };
+    if (qEnvironmentVariableIsSet("QT_LINGUIST_BENCHMARK_HUGE"))
+        sizes << 1000000;
+    for (int size : qAsConst(sizes))
+        QTest::addRow("%dk", size / 1000) << size;
+}
+
+void tst_bench_fileformats::addFormatsAndSizes()
+{
+    QTest::addColumn<QString>("format");
+    QTest::addColumn<int>("messageCount");
+
+    QList<int> sizes = { 10000, 100000 };
+    if (qEnvironmentVariableIsSet("QT_LINGUIST_BENCHMARK_HUGE"))
+        sizes << 1000000;
+    for (const char *format : formats) {
+        for (int size : qAsConst(sizes))
+            QTest::addRow("%s-%dk", format, size / 1000) << QString::fromLatin1(format) << size;
+    }
+}
+
+// Returns a file with the catalog of the given size in the given format,
+// writing it on first use.
+QString tst_bench_fileformats::catalogFile(int messageCount, const QString &format)
+{
+    const QString fileName = workDir.filePath(QStringLiteral("catalog%1_de.%2")
+                                              .arg(messageCount).arg(format));
+    if (writtenFiles.contains(fileName))
+        return fileName;
+
+    if (!catalogs.contains(messageCount))
+        catalogs.insert(messageCount, makeCatalog(messageCount));
+    ConversionData cd;
+    if (!catalogs[messageCount].save(fileName, cd, format)) {
+        qWarning("Cannot write %s: %s", qPrintable(fileName), qPrintable(cd.error()));
+        return QString();
+    }
+    writtenFiles.insert(fileName);
+    return fileName;
+}
+
+void tst_bench_fileformats::load_data()
+{
+    addFormatsAndSizes();
+}
+
+void tst_bench_fileformats::load()
+{
+    QFETCH(QString, format);
+    QFETCH(int, messageCount);
+
+    const QString fileName = catalogFile(messageCount, format);
+    QVERIFY(!fileName.isEmpty());
+
+    resetPeakMemory();
+    QBENCHMARK {
+        Translator tor;
+        ConversionData cd;
+        QVERIFY2(tor.load(fileName, cd, format), qPrintable(cd.error()));
+    }
+    reportPeakMemory();
+}
+
+void tst_bench_fileformats::save_data()
+{
+    addFormatsAndSizes();
+}
+
+void tst_bench_fileformats::save()
+{
+    QFETCH(QString, format);
+    QFETCH(int, messageCount);
+
+    Translator tor;
+    ConversionData cd;
+    QVERIFY2(tor.load(catalogFile(messageCount, QStringLiteral("ts")), cd, QStringLiteral("ts")),
+             qPrintable(cd.error()));
+
+    resetPeakMemory();
+    QBENCHMARK {
+        QBuffer buffer;
+        buffer.open(QIODevice::WriteOnly);
+        QVERIFY2(tor.save(buffer, QString(), cd, format), qPrintable(cd.error()));
+    }
+    reportPeakMemory();
+}
+
+void tst_bench_fileformats::release_data()
+{
+    addSizes();
+}
+
+// What lrelease does: reading a TS file and writing a stripped QM file.
+void tst_bench_fileformats::release()
+{
+    QFETCH(int, messageCount);
+
+    const QString fileName = catalogFile(messageCount, QStringLiteral("ts"));
+    QVERIFY(!fileName.isEmpty());
+
+    resetPeakMemory();
+    QBENCHMARK {
+        Translator tor;
+        ConversionData cd;
+        cd.m_saveMode = SaveStripped;
+        QVERIFY2(tor.load(fileName, cd, QStringLiteral("ts")), qPrintable(cd.error()));
+        tor.resolveDuplicates();
+        tor.normalizeTranslations(cd);
+        QBuffer buffer;
+        buffer.open(QIODevice::WriteOnly);
+        QVERIFY2(tor.save(buffer, QString(), cd, QStringLiteral("qm")), qPrintable(cd.error()));
+    }
+    reportPeakMemory();
+}
+
+void tst_bench_fileformats::merge_data()
+{
+    addSizes();
+}
+
+/*
+    Runs lupdate on a Python source against an existing TS file, so that the
+    time is mostly spent in merging. A tenth of the source texts changed
+    since the TS file was written, which exercises the merge heuristics.
+*/
+void tst_bench_fileformats::merge()
+{
+    QFETCH(int, messageCount);
+
+    const QString lupdate = binDir + QLatin1String("/lupdate");
+    if (!QFile::exists(lupdate) && !QFile::exists(lupdate + QLatin1String(".exe")))
+        QSKIP("lupdate is not installed");
+
+    const QString sourceFile = workDir.filePath(QStringLiteral("merge%1.py").arg(messageCount));
+    const QString baseTsFile = workDir.filePath(QStringLiteral("merge%1_de.ts").arg(messageCount));
+    const QString tsFile = workDir.filePath(QStringLiteral("merged%1_de.ts").arg(messageCount));
+    {
+        QFile source(sourceFile);
+        QVERIFY(source.open(QIODevice::WriteOnly | QIODevice::Text));
+        QTextStream out(&source);
+        Translator base;
+        base.setLanguageCode(QStringLiteral("de"));
+        for (int i = 0; i < messageCount; ++i) {
+            const int context = i / 100;
+            if (i % 100 == 0) {
+                out << "class Context" << context << ":\n"
+                    << "    def retranslate(self):\n";
+            }
+            const QString text = QStringLiteral("Source text number %1").arg(i);
+            out << "        self.tr(\"" << text << (i % 10 == 0 ? " (changed)" : "")
+                << "\")\n";
+            base.append(TranslatorMessage(QStringLiteral("Context%1").arg(context), text,
+                                          QString(), QString(), sourceFile, -1,
+                                          QStringList(QStringLiteral("Übersetzung %1").arg(i)),
+                                          TranslatorMessage::Finished));
+        }
+        ConversionData cd;
+        QVERIFY2(base.save(baseTsFile, cd, QStringLiteral("ts")), qPrintable(cd.error()));
+    }
+
+    QBENCHMARK {
+        QFile::remove(tsFile);
+        QVERIFY(QFile::copy(baseTsFile, tsFile));
+        QProcess proc;
+        proc.start(lupdate, { QStringLiteral("-silent"), sourceFile, QStringLiteral("-ts"),
+                              tsFile });
+        QVERIFY2(proc.waitForStarted(), qPrintable(proc.errorString()));
+        QVERIFY(proc.waitForFinished(-1));
+        QCOMPARE(proc.exitCode(), 0);
+    }
+}
+
+QTEST_MAIN(tst_bench_fileformats)
+
+#include "tst_bench_fileformats.moc"
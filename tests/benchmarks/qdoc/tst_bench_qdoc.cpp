@@ -0,0 +1,222 @@
+// Copyright (C) 2023 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
+
+#include <QtTest/QtTest>
+#include <QtCore/QDirIterator>
+#include <QtCore/QFile>
+#include <QtCore/QJsonArray>
+#include <QtCore/QJsonDocument>
+#include <QtCore/QJsonObject>
+#include <QtCore/QLibraryInfo>
+#include <QtCore/QProcess>
+#include <QtCore/QTemporaryDir>
+#include <QtCore/QTextStream>
+
+/*
+    Measures qdoc on synthetic modules with N classes of M functions each,
+    QML types with properties, and links between all of them.
+
+    Each module is documented in a serial run, with QDOC_THREADS=1, and in a
+    parallel one. The time of each phase, as recorded with -timings, and the
+    number of pages generated per second are printed after each run. Set
+    QT_QDOC_BENCHMARK_HUGE to add a module with 5000 classes.
+*/
+class tst_bench_qdoc : public QObject
+{
+    Q_OBJECT
+
+public:
+    tst_bench_qdoc()
+        : qdoc(QLibraryInfo::path(QLibraryInfo::BinariesPath) + QLatin1String("/qdoc")
+               + QLatin1String(QSysInfo::productType() == QLatin1String("windows") ? ".exe" : ""))
+    {}
+
+private slots:
+    void initTestCase();
+    void generate_data();
+    void generate();
+
+private:
+    QString moduleConfig(int classCount, int functionCount, int qmlTypeCount);
+    void reportTimings(const QString &timingsFile, const QString &outputDir);
+
+    QTemporaryDir workDir;
+    const QString qdoc;
+    QHash<QString, QString> configs;
+};
+
+static void writeFile(const QString &fileName, const QString &text)
+{
+    QFile file(fileName);
+    QVERIFY2(file.open(QIODevice::WriteOnly | QIODevice::Text), qPrintable(file.errorString()));
+    file.write(text.toUtf8());
+}
+
+void tst_bench_qdoc::initTestCase()
+{
+    QVERIFY(workDir.isValid());
+    if (!QFileInfo::exists(qdoc))
+        QSKIP("qdoc was not found");
+}
+
+// Every class links to the next one and every function to the next function,
+// so that link resolution is part of the work.
+QString tst_bench_qdoc::moduleConfig(int classCount, int functionCount, int qmlTypeCount)
+{
+    const QString name = QString::asprintf("synth_%d_%d_%d", classCount, functionCount,
+                                           qmlTypeCount);
+    if (configs.contains(name))
+        return configs.value(name);
+
+    const QString dir = workDir.filePath(name);
+    QDir().mkpath(dir);
+
+    QString header;
+    QTextStream h(&header);
+    QString source;
+    QTextStream cpp(&source);
+    h << "namespace Synth {\n";
+    cpp << "#include \"synth.h\"\n\n";
+    for (int c = 0; c < classCount; ++c) {
+        const int next = (c + 1) % classCount;
+        h << "class Class" << c << "\n{\npublic:\n";
+        cpp << "/*!\n    \\class Synth::Class" << c << "\n    \\inmodule Synth\n"
+            << "    \\brief Class " << c << " of the synthetic module.\n\n"
+            << "    It is used together with \\l {Synth::Class" << next << "}.\n*/\n\n";
+        for (int f = 0; f < functionCount; ++f) {
+            h << "    int function" << f << "(int value, const Class" << c
+              << " *other = nullptr) const;\n";
+            cpp << "/*!\n    Returns \\a value processed by step " << f << ", see also \\a other.\n";
+            if (functionCount > 1)
+                cpp << "\n    \\sa function" << (f + 1) % functionCount << "()\n";
+            cpp << "*/\nint Synth::Class" << c << "::function" << f
+                << "(int value, const Class" << c
+                << " *other) const\n{\n    return other ? value : -value;\n}\n\n";
+        }
+        h << "};\n\n";
+    }
+    h << "} // namespace Synth\n";
+    cpp.flush();
+    h.flush();
+
+    QString qdocText;
+    QTextStream q(&qdocText);
+    q << "/*!\n    \\module Synth\n    \\title Synth C++ Classes\n"
+      << "    \\brief A synthetic module for benchmarking qdoc.\n\n"
+      << "    \\generatelist classesbymodule Synth\n*/\n\n"
+      << "/*!\n    \\qmlmodule Synth.Qml\n    \\title Synth QML Types\n"
+      << "    \\brief The QML types of the synthetic module.\n*/\n\n";
+    for (int t = 0; t < qmlTypeCount; ++t) {
+        q << "/*!\n    \\qmltype Type" << t << "\n    \\inqmlmodule Synth.Qml\n"
+          << "    \\brief QML type " << t << ", see also \\l Type" << (t + 1) % qmlTypeCount
+          << ".\n*/\n\n";
+        for (int p = 0; p < 5; ++p) {
+            q << "/*!\n    \\qmlproperty int Type" << t << "::property" << p
+              << "\n    Property " << p << ", see also \\l {Synth::Class" << t % classCount
+              << "}.\n*/\n\n";
+        }
+    }
+    q.flush();
+
+    writeFile(dir + QLatin1String("/synth.h"), header);
+    writeFile(dir + QLatin1String("/synth.cpp"), source);
+    writeFile(dir + QLatin1String("/synth.qdoc"), qdocText);
+    writeFile(dir + QLatin1String("/synth.qdocconf"),
+              QLatin1String("project = Synth\n"
+                            "moduleheader = synth.h\n"
+                            "includepaths = -I.\n"
+                            "headerdirs = .\n"
+                            "sourcedirs = .\n"
+                            "headers.fileextensions = \"*.h\"\n"
+                            "sources.fileextensions = \"*.cpp *.qdoc\"\n"
+                            "locationinfo = false\n"));
+    const QString config = dir + QLatin1String("/synth.qdocconf");
+    configs.insert(name, config);
+    return config;
+}
+
+void tst_bench_qdoc::generate_data()
+{
+    QTest::addColumn<int>("classCount");
+    QTest::addColumn<int>("functionCount");
+    QTest::addColumn<int>("qmlTypeCount");
+    QTest::addColumn<bool>("serial");
+
+    QList<std::tuple<int, int, int>> sizes = { { 100, 10, 20 }, { 1000, 20, 200 } };
+    if (qEnvironmentVariableIsSet("QT_QDOC_BENCHMARK_HUGE"))
+        sizes.append({ 5000, 20, 1000 });
+    for (const auto &[classCount, functionCount, qmlTypeCount] : qAsConst(sizes)) {
+        for (bool serial : { true, false }) {
+            QTest::addRow("%d classes, %d functions, %d QML types, %s", classCount,
+                          functionCount, qmlTypeCount, serial ? "serial" : "parallel")
+                    << classCount << functionCount << qmlTypeCount << serial;
+        }
+    }
+}
+
+void tst_bench_qdoc::generate()
+{
+    QFETCH(int, classCount);
+    QFETCH(int, functionCount);
+    QFETCH(int, qmlTypeCount);
+    QFETCH(bool, serial);
+
+    const QString config = moduleConfig(classCount, functionCount, qmlTypeCount);
+    QVERIFY(!QTest::currentTestFailed());
+    const QString outputDir = workDir.filePath(QLatin1String("html"));
+    const QString timingsFile = workDir.filePath(QLatin1String("timings.json"));
+
+    QProcessEnvironment env = QProcessEnvironment::systemEnvironment();
+    if (serial)
+        env.insert(QLatin1String("QDOC_THREADS"), QLatin1String("1"));
+    else
+        env.remove(QLatin1String("QDOC_THREADS"));
+
+    QBENCHMARK {
+        QDir(outputDir).removeRecursively();
+        QProcess proc;
+        proc.setProcessEnvironment(env);
+        proc.setWorkingDirectory(QFileInfo(config).path());
+        proc.start(qdoc, { config, QLatin1String("-outputdir"), outputDir,
+                           QLatin1String("-timings"), timingsFile });
+        QVERIFY2(proc.waitForFinished(-1), qPrintable(proc.errorString()));
+        QVERIFY2(proc.exitStatus() == QProcess::NormalExit && proc.exitCode() == 0,
+                 proc.readAllStandardError().constData());
+    }
+    reportTimings(timingsFile, outputDir);
+}
+
+/*
+    Prints the time of each phase of the last run and the number of HTML
+    pages written per second of the generate phase.
+*/
+void tst_bench_qdoc::reportTimings(const QString &timingsFile, const QString &outputDir)
+{
+    QFile file(timingsFile);
+    QVERIFY2(file.open(QIODevice::ReadOnly), qPrintable(file.errorString()));
+    const QJsonArray phases = QJsonDocument::fromJson(file.readAll())
+                                      .object().value(QLatin1String("phases")).toArray();
+    qint64 generateMs = 0;
+    for (const QJsonValue &value : phases) {
+        const QJsonObject phase = value.toObject();
+        const QString name = phase.value(QLatin1String("phase")).toString();
+        const qint64 wallMs = phase.value(QLatin1String("wallMs")).toInteger();
+        qInfo("%-24s %8lld ms wall %8lld ms cpu", qPrintable(name), wallMs,
+              phase.value(QLatin1String("cpuMs")).toInteger());
+        if (name == QLatin1String("generate HTML"))
+            generateMs = wallMs;
+    }
+
+    int pageCount = 0;
+    QDirIterator it(outputDir, { QStringLiteral("*.html") }, QDir::Files,
+                    QDirIterator::Subdirectories);
+    while (it.hasNext()) {
+        it.next();
+        ++pageCount;
+    }
+    if (generateMs > 0)
+        qInfo("%d pages, %.0f pages/s", pageCount, pageCount * 1000.0 / generateMs);
+}
+
+QTEST_GUILESS_MAIN(tst_bench_qdoc)
+#include "tst_bench_qdoc.moc"
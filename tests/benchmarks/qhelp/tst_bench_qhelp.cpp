@@ -0,0 +1,319 @@
+// Copyright (C) 2023 The Qt Company Ltd.
+// SPDX-License-Identifier: LicenseRef-Qt-Commercial OR GPL-3.0-only WITH Qt-GPL-exception-1.0
+
+#include "helpgenerator.h"
+#include "qhelpprojectdata_p.h"
+
+#include <QtTest/QtTest>
+#include <QtCore/QElapsedTimer>
+#include <QtCore/QFile>
+#include <QtCore/QTemporaryDir>
+#include <QtCore/QTextStream>
+
+#include <QtHelp/QHelpEngineCore>
+#include <QtHelp/QHelpSearchEngine>
+#include <QtHelp/private/qhelpcollectionhandler_p.h>
+
+#include <algorithm>
+
+/*
+    Measures the help engine against a synthetic collection: setting it up,
+    registering documentation, reading the index, the contents and the
+    files, building the full text search index and searching it.
+
+    The collection has 4 documentations of 1000 pages each, set
+    QT_HELP_BENCHMARK_HUGE for 10000 pages each.
+*/
+class tst_bench_qhelp : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+    void setupCollection();
+    void registerDocumentation();
+    void indicesForFilter();
+    void contentsForFilter();
+    void fileData();
+    void buildSearchIndex_data();
+    void buildSearchIndex();
+    void searchLatency_data();
+    void searchLatency();
+
+private:
+    QString writeProject(int documentation);
+    QString collectionFile(const QString &name);
+    bool registerAll(QHelpEngineCore *engine);
+
+    QTemporaryDir workDir;
+    QStringList qchFiles;
+    QString collection;
+    int pageCount = 1000;
+};
+
+static const int DocumentationCount = 4;
+static const int KeywordsPerPage = 5;
+
+static const char *const words[] = {
+    "widget", "layout", "signal", "slot", "model", "view", "delegate", "painter",
+    "thread", "timer", "socket", "property", "animation", "shader", "buffer", "codec"
+};
+static const int wordCount = int(sizeof(words) / sizeof(words[0]));
+
+static QString namespaceName(int documentation)
+{
+    return QStringLiteral("org.qt-project.bench%1.600").arg(documentation);
+}
+
+// A page with some text made of the words above, so that searches for
+// them find many pages.
+static QByteArray page(int documentation, int number)
+{
+    QByteArray html = "<html><head><title>Class" + QByteArray::number(number)
+            + " of bench" + QByteArray::number(documentation) + "</title></head><body>";
+    for (int paragraph = 0; paragraph < 10; ++paragraph) {
+        html += "<p>";
+        for (int i = 0; i < 40; ++i) {
+            html += words[(number * 7 + paragraph * 3 + i) % wordCount];
+            html += ' ';
+        }
+        html += "</p>";
+    }
+    return html + "</body></html>";
+}
+
+// Writes the project of the given documentation with its pages and
+// returns its file name.
+QString tst_bench_qhelp::writeProject(int documentation)
+{
+    const QString dir = workDir.filePath(QStringLiteral("bench%1").arg(documentation));
+    if (!QDir().mkpath(dir))
+        return QString();
+
+    const QString projectFile = dir + QLatin1String("/bench.qhp");
+    QFile project(projectFile);
+    if (!project.open(QIODevice::WriteOnly | QIODevice::Text))
+        return QString();
+    QTextStream out(&project);
+    out << "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+        << "<QtHelpProject version=\"1.0\">\n"
+        << "<namespace>" << namespaceName(documentation) << "</namespace>\n"
+        << "<virtualFolder>bench" << documentation << "</virtualFolder>\n"
+        << "<filterSection>\n"
+        << "<filterAttribute>bench" << documentation << "</filterAttribute>\n"
+        << "<toc><section title=\"Bench " << documentation << "\" ref=\"index.html\">\n";
+    for (int i = 0; i < pageCount; ++i) {
+        out << "<section title=\"Class" << i << "\" ref=\"class" << i << ".html\">"
+            << "<section title=\"Details\" ref=\"class" << i << ".html#details\"/>"
+            << "</section>\n";
+    }
+    out << "</section></toc>\n<keywords>\n";
+    for (int i = 0; i < pageCount; ++i) {
+        for (int k = 0; k < KeywordsPerPage; ++k) {
+            out << "<keyword name=\"" << words[(i + k) % wordCount] << i << "\" id=\"Class"
+                << i << "::" << words[(i + k) % wordCount] << "\" ref=\"class" << i
+                << ".html#" << k << "\"/>\n";
+        }
+    }
+    out << "</keywords>\n<files>\n<file>index.html</file>\n";
+    for (int i = 0; i < pageCount; ++i)
+        out << "<file>class" << i << ".html</file>\n";
+    out << "</files>\n</filterSection>\n</QtHelpProject>\n";
+
+    QFile index(dir + QLatin1String("/index.html"));
+    if (!index.open(QIODevice::WriteOnly))
+        return QString();
+    index.write(page(documentation, -1));
+    for (int i = 0; i < pageCount; ++i) {
+        QFile file(dir + QStringLiteral("/class%1.html").arg(i));
+        if (!file.open(QIODevice::WriteOnly))
+            return QString();
+        file.write(page(documentation, i));
+    }
+    return projectFile;
+}
+
+QString tst_bench_qhelp::collectionFile(const QString &name)
+{
+    const QString fileName = workDir.filePath(name + QLatin1String(".qhc"));
+    QFile::remove(fileName);
+    QDir(workDir.filePath(QLatin1Char('.') + name)).removeRecursively();
+    return fileName;
+}
+
+bool tst_bench_qhelp::registerAll(QHelpEngineCore *engine)
+{
+    for (const QString &qchFile : std::as_const(qchFiles)) {
+        if (!engine->registerDocumentation(qchFile)) {
+            qWarning("Cannot register %s: %s", qPrintable(qchFile), qPrintable(engine->error()));
+            return false;
+        }
+    }
+    return true;
+}
+
+void tst_bench_qhelp::initTestCase()
+{
+    QVERIFY(workDir.isValid());
+    if (qEnvironmentVariableIsSet("QT_HELP_BENCHMARK_HUGE"))
+        pageCount = 10000;
+
+    for (int i = 0; i < DocumentationCount; ++i) {
+        const QString projectFile = writeProject(i);
+        QVERIFY(!projectFile.isEmpty());
+        QHelpProjectData data;
+        QVERIFY2(data.readData(projectFile), qPrintable(data.errorMessage()));
+        const QString qchFile = workDir.filePath(QStringLiteral("bench%1.qch").arg(i));
+        HelpGenerator generator(true);
+        QVERIFY2(generator.generate(&data, qchFile), qPrintable(generator.error()));
+        qchFiles << qchFile;
+    }
+
+    collection = collectionFile(QStringLiteral("collection"));
+    QHelpEngineCore engine(collection);
+    engine.setReadOnly(false);
+    QVERIFY(engine.setupData());
+    QVERIFY(registerAll(&engine));
+}
+
+// What opening a collection with all documentation registered costs.
+void tst_bench_qhelp::setupCollection()
+{
+    QBENCHMARK {
+        QHelpEngineCore engine(collection);
+        QVERIFY(engine.setupData());
+    }
+}
+
+void tst_bench_qhelp::registerDocumentation()
+{
+    QBENCHMARK {
+        QHelpEngineCore engine(collectionFile(QStringLiteral("register")));
+        engine.setReadOnly(false);
+        QVERIFY(engine.setupData());
+        QVERIFY(registerAll(&engine));
+    }
+}
+
+void tst_bench_qhelp::indicesForFilter()
+{
+    QHelpCollectionHandler handler(collection);
+    QVERIFY(handler.openCollectionFile());
+    QStringList indices;
+    QBENCHMARK {
+        indices = handler.indicesForFilter(QString());
+    }
+    QVERIFY(indices.count() >= pageCount * KeywordsPerPage);
+}
+
+void tst_bench_qhelp::contentsForFilter()
+{
+    QHelpCollectionHandler handler(collection);
+    QVERIFY(handler.openCollectionFile());
+    QList<QHelpCollectionHandler::ContentsData> contents;
+    QBENCHMARK {
+        contents = handler.contentsForFilter(QString());
+    }
+    QCOMPARE(contents.count(), DocumentationCount);
+}
+
+// Reads all pages, printing how many megabytes a second that is.
+void tst_bench_qhelp::fileData()
+{
+    QHelpEngineCore engine(collection);
+    QVERIFY(engine.setupData());
+    QList<QUrl> urls;
+    for (int i = 0; i < DocumentationCount; ++i)
+        urls += engine.files(namespaceName(i), QString(), QStringLiteral("html"));
+    QVERIFY(urls.count() > pageCount * DocumentationCount);
+
+    qint64 bytes = 0;
+    QElapsedTimer timer;
+    timer.start();
+    QBENCHMARK {
+        for (const QUrl &url : std::as_const(urls))
+            bytes += engine.fileData(url).size();
+    }
+    const qint64 elapsed = timer.nsecsElapsed();
+    if (elapsed > 0)
+        qInfo("Throughput: %.1f MB/s", bytes * 1000.0 / elapsed);
+}
+
+void tst_bench_qhelp::buildSearchIndex_data()
+{
+    QTest::addColumn<bool>("sharded");
+
+    QTest::newRow("shared") << false;
+    QTest::newRow("sharded") << true;
+}
+
+void tst_bench_qhelp::buildSearchIndex()
+{
+    QFETCH(bool, sharded);
+
+    QHelpEngineCore engine(collection);
+    QVERIFY(engine.setupData());
+    QHelpSearchEngine searchEngine(&engine);
+    searchEngine.setShardedIndexEnabled(sharded);
+    QSignalSpy finished(&searchEngine, &QHelpSearchEngine::indexingFinished);
+
+    QBENCHMARK {
+        finished.clear();
+        searchEngine.reindexDocumentation();
+        QVERIFY(finished.wait(600000));
+    }
+}
+
+void tst_bench_qhelp::searchLatency_data()
+{
+    buildSearchIndex_data();
+}
+
+/*
+    Runs each search a few times on the index and prints the median and
+    the 99th percentile of the time until the search finished.
+*/
+void tst_bench_qhelp::searchLatency()
+{
+    QFETCH(bool, sharded);
+
+    QHelpEngineCore engine(collection);
+    QVERIFY(engine.setupData());
+    QHelpSearchEngine searchEngine(&engine);
+    searchEngine.setShardedIndexEnabled(sharded);
+    QSignalSpy indexed(&searchEngine, &QHelpSearchEngine::indexingFinished);
+    searchEngine.reindexDocumentation();
+    QVERIFY(indexed.wait(600000));
+
+    QSignalSpy finished(&searchEngine, &QHelpSearchEngine::searchingFinished);
+    const auto search = [&](const QString &input) {
+        finished.clear();
+        searchEngine.search(input);
+        return finished.wait(60000);
+    };
+
+    QList<qint64> latencies;
+    QElapsedTimer timer;
+    for (int round = 0; round < 10; ++round) {
+        for (int i = 0; i < wordCount; ++i) {
+            const QString input = QString::fromLatin1(words[i])
+                    + QLatin1Char(' ') + QString::fromLatin1(words[(i + 5) % wordCount]);
+            timer.start();
+            QVERIFY(search(input));
+            latencies.append(timer.nsecsElapsed());
+        }
+    }
+    std::sort(latencies.begin(), latencies.end());
+    qInfo("Search latency: p50 %.2f ms, p99 %.2f ms",
+          latencies.at(latencies.count() / 2) / 1e6,
+          latencies.at(latencies.count() * 99 / 100) / 1e6);
+
+    QBENCHMARK {
+        QVERIFY(search(QStringLiteral("widget")));
+    }
+    QVERIFY(searchEngine.searchResultCount() > 0);
+}
+
+QTEST_MAIN(tst_bench_qhelp)
+
+#include "tst_bench_qhelp.moc"